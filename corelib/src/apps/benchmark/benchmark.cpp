@@ -0,0 +1,526 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#include "benchmark.h"
+
+#include "SireMaths/multifloat.h"
+
+#include "SireError/errors.h"
+
+#include "sire_version.h"
+
+#include <QElapsedTimer>
+#include <QDateTime>
+#include <QSysInfo>
+#include <QThread>
+#include <QRegExp>
+#include <QFile>
+#include <QTextStream>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace SireBenchmark;
+
+/////////
+///////// Implementation of Benchmark
+/////////
+
+/** Construct a benchmark with the passed name, whose throughput
+    is measured in 'units' (e.g. "atoms", "pairs", "moves") */
+Benchmark::Benchmark(const QString &name, const QString &units)
+          : nme(name), unts(units)
+{}
+
+/** Destructor */
+Benchmark::~Benchmark()
+{}
+
+/** Return the name of this benchmark */
+QString Benchmark::name() const
+{
+    return nme;
+}
+
+/** Return the units of the items processed by each iteration */
+QString Benchmark::units() const
+{
+    return unts;
+}
+
+/** Prepare the data used by the benchmark. This is not timed */
+void Benchmark::setUp()
+{}
+
+/** Release the data used by the benchmark. This is not timed */
+void Benchmark::tearDown()
+{}
+
+/////////
+///////// Implementation of BenchmarkResult
+/////////
+
+/** Constructor */
+BenchmarkResult::BenchmarkResult() : nitems(0), baseline_ns(0)
+{}
+
+/** Destructor */
+BenchmarkResult::~BenchmarkResult()
+{}
+
+/** Return whether or not there is a baseline for this benchmark */
+bool BenchmarkResult::hasBaseline() const
+{
+    return baseline_ns > 0;
+}
+
+/** Return the median time per iteration (in nanoseconds). The median
+    is used for comparisons as it is robust to the occasional slow
+    iteration caused by other processes on the machine */
+double BenchmarkResult::medianTime() const
+{
+    if (samples.isEmpty())
+        return 0;
+
+    QVector<double> sorted = samples;
+    std::sort(sorted.begin(), sorted.end());
+    
+    const int n = sorted.count();
+    
+    if (n % 2 == 1)
+        return sorted.at(n/2);
+    else
+        return 0.5 * (sorted.at(n/2 - 1) + sorted.at(n/2));
+}
+
+/** Return the fastest time per iteration (in nanoseconds) */
+double BenchmarkResult::minimumTime() const
+{
+    if (samples.isEmpty())
+        return 0;
+    else
+        return *(std::min_element(samples.constBegin(), samples.constEnd()));
+}
+
+/** Return the mean time per iteration (in nanoseconds) */
+double BenchmarkResult::meanTime() const
+{
+    if (samples.isEmpty())
+        return 0;
+
+    double sum = 0;
+    
+    foreach (double sample, samples)
+    {
+        sum += sample;
+    }
+    
+    return sum / samples.count();
+}
+
+/** Return the standard deviation of the time per iteration (in nanoseconds) */
+double BenchmarkResult::stdevTime() const
+{
+    if (samples.count() < 2)
+        return 0;
+
+    const double mean = this->meanTime();
+    
+    double sum = 0;
+    
+    foreach (double sample, samples)
+    {
+        sum += (sample - mean) * (sample - mean);
+    }
+    
+    return std::sqrt( sum / (samples.count() - 1) );
+}
+
+/** Return the number of items processed per second, 
+    based on the median time */
+double BenchmarkResult::throughput() const
+{
+    const double t = this->medianTime();
+    
+    if (t <= 0)
+        return 0;
+    else
+        return nitems / (1e-9 * t);
+}
+
+/** Return the ratio of the median time to the baseline median time
+    (greater than 1 means slower than the baseline). This returns 0
+    if there is no baseline */
+double BenchmarkResult::baselineRatio() const
+{
+    if (baseline_ns <= 0)
+        return 0;
+    else
+        return this->medianTime() / baseline_ns;
+}
+
+/////////
+///////// Implementation of BenchmarkRunner
+/////////
+
+/** Constructor */
+BenchmarkRunner::BenchmarkRunner()
+                : min_time(1.0), min_iterations(5), max_iterations(1000),
+                  thres(0.1)
+{}
+
+/** Destructor */
+BenchmarkRunner::~BenchmarkRunner()
+{}
+
+/** Add a benchmark to the runner. The runner takes ownership of the benchmark */
+void BenchmarkRunner::add(Benchmark *benchmark)
+{
+    if (benchmark)
+        benchmarks.append( BenchmarkPtr(benchmark) );
+}
+
+/** Return the names of all of the benchmarks */
+QStringList BenchmarkRunner::names() const
+{
+    QStringList n;
+    
+    foreach (BenchmarkPtr benchmark, benchmarks)
+    {
+        n.append( benchmark->name() );
+    }
+    
+    return n;
+}
+
+/** Only run the benchmarks whose names match the passed regular expression */
+void BenchmarkRunner::setFilter(const QString &pattern)
+{
+    filter = pattern;
+}
+
+/** Set the minimum amount of time to spend timing each benchmark */
+void BenchmarkRunner::setMinimumTime(double seconds)
+{
+    min_time = std::max(0.0, seconds);
+}
+
+/** Set the minimum number of timed iterations of each benchmark */
+void BenchmarkRunner::setMinimumIterations(int n)
+{
+    min_iterations = std::max(1, n);
+    max_iterations = std::max(min_iterations, max_iterations);
+}
+
+/** Set the maximum number of timed iterations of each benchmark */
+void BenchmarkRunner::setMaximumIterations(int n)
+{
+    max_iterations = std::max(1, n);
+    min_iterations = std::min(min_iterations, max_iterations);
+}
+
+/** Set the fractional increase in the median time, relative to
+    the baseline, that is counted as a regression (e.g. 0.1 means
+    that a benchmark that is more than 10% slower is a regression) */
+void BenchmarkRunner::setThreshold(double threshold)
+{
+    thres = std::max(0.0, threshold);
+}
+
+/** Return the regression threshold */
+double BenchmarkRunner::threshold() const
+{
+    return thres;
+}
+
+/** Load the baseline results from the passed JSON file, which
+    should have been written by a previous run (via saveJSON)
+    
+    \throw SireError::file_error
+    \throw SireError::io_error
+*/
+void BenchmarkRunner::loadBaseline(const QString &filename)
+{
+    QFile f(filename);
+    
+    if (not f.open(QIODevice::ReadOnly))
+        throw SireError::file_error(f, CODELOC);
+    
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJson(f.readAll(), &error);
+    
+    if (doc.isNull() or not doc.isObject())
+        throw SireError::io_error( QObject::tr(
+                "Could not read the baseline benchmark results from \"%1\": %2")
+                    .arg(filename).arg(error.errorString()), CODELOC );
+
+    baseline.clear();
+    
+    foreach (const QJsonValue &value, doc.object().value("benchmarks").toArray())
+    {
+        const QJsonObject result = value.toObject();
+        
+        const double t = result.value("median_ns").toDouble();
+        
+        if (t > 0)
+            baseline.insert( result.value("name").toString(), t );
+    }
+    
+    baseline_file = filename;
+}
+
+/** Run and time a single benchmark */
+BenchmarkResult BenchmarkRunner::run(Benchmark &benchmark) const
+{
+    BenchmarkResult result;
+    result.name = benchmark.name();
+    result.units = benchmark.units();
+    result.baseline_ns = baseline.value(benchmark.name(), 0);
+
+    try
+    {
+        benchmark.setUp();
+
+        //one untimed iteration to warm up the caches
+        result.nitems = benchmark.run();
+
+        QElapsedTimer total;
+        total.start();
+        
+        QElapsedTimer t;
+        
+        while (result.samples.count() < max_iterations)
+        {
+            if (result.samples.count() >= min_iterations and
+                total.nsecsElapsed() > 1e9 * min_time)
+                break;
+        
+            t.start();
+            result.nitems = benchmark.run();
+            result.samples.append( t.nsecsElapsed() );
+        }
+        
+        benchmark.tearDown();
+    }
+    catch(const SireError::exception &e)
+    {
+        result.samples.clear();
+        result.error = e.why();
+    }
+    catch(const std::exception &e)
+    {
+        result.samples.clear();
+        result.error = QString::fromLocal8Bit(e.what());
+    }
+    
+    return result;
+}
+
+/** Run all of the benchmarks that match the filter */
+void BenchmarkRunner::runAll()
+{
+    reslts.clear();
+    
+    QRegExp regexp(filter);
+    
+    QTextStream out(stdout);
+    
+    foreach (BenchmarkPtr benchmark, benchmarks)
+    {
+        if (not filter.isEmpty() and regexp.indexIn(benchmark->name()) == -1)
+            continue;
+        
+        out << benchmark->name() << "... ";
+        out.flush();
+        
+        BenchmarkResult result = this->run(*benchmark);
+        
+        if (result.error.isEmpty())
+            out << QString("%1 ms").arg(1e-6 * result.medianTime(), 0, 'f', 3) << endl;
+        else
+            out << "FAILED: " << result.error << endl;
+        
+        reslts.append(result);
+    }
+}
+
+/** Return the results of the benchmarks that have been run */
+QList<BenchmarkResult> BenchmarkRunner::results() const
+{
+    return reslts;
+}
+
+/** Return the number of benchmarks that are slower than the 
+    baseline by more than the threshold */
+int BenchmarkRunner::nRegressions() const
+{
+    int n = 0;
+    
+    foreach (const BenchmarkResult &result, reslts)
+    {
+        if (result.hasBaseline() and result.baselineRatio() > 1.0 + thres)
+            n += 1;
+    }
+    
+    return n;
+}
+
+/** Return a human-readable table of the results */
+QString BenchmarkRunner::report() const
+{
+    QStringList lines;
+    
+    lines.append( QString("%1 %2 %3 %4 %5")
+                    .arg("benchmark", -45).arg("median / ms", 14)
+                    .arg("min / ms", 14).arg("throughput", 24)
+                    .arg(baseline.isEmpty() ? QString() : QString("vs. baseline")) );
+
+    foreach (const BenchmarkResult &result, reslts)
+    {
+        if (not result.error.isEmpty())
+        {
+            lines.append( QString("%1 FAILED: %2").arg(result.name, -45).arg(result.error) );
+            continue;
+        }
+    
+        QString compare;
+        
+        if (result.hasBaseline())
+        {
+            const double ratio = result.baselineRatio();
+            
+            compare = QString("%1x").arg(ratio, 0, 'f', 3);
+            
+            if (ratio > 1.0 + thres)
+                compare += "  SLOWER";
+            else if (ratio < 1.0 / (1.0 + thres))
+                compare += "  faster";
+        }
+        else if (not baseline.isEmpty())
+            compare = "new";
+    
+        lines.append( QString("%1 %2 %3 %4 %5")
+                        .arg(result.name, -45)
+                        .arg(1e-6 * result.medianTime(), 14, 'f', 3)
+                        .arg(1e-6 * result.minimumTime(), 14, 'f', 3)
+                        .arg( QString("%1 %2/s").arg(result.throughput(), 0, 'g', 4)
+                                                .arg(result.units), 24 )
+                        .arg(compare) );
+    }
+    
+    if (not baseline.isEmpty())
+        lines.append( QObject::tr("\n%1 benchmark(s) slower than the baseline \"%2\" "
+                                  "by more than %3%.")
+                            .arg(this->nRegressions()).arg(baseline_file)
+                            .arg(100*thres) );
+    
+    return lines.join("\n");
+}
+
+/** Return the results as a JSON document. This records the machine and
+    version of Sire, together with the timings of each benchmark and,
+    if a baseline was loaded, the comparison against the baseline */
+QString BenchmarkRunner::toJSON() const
+{
+    QJsonObject machine;
+    machine.insert( "cpu_architecture", QSysInfo::currentCpuArchitecture() );
+    machine.insert( "os", QSysInfo::prettyProductName() );
+    machine.insert( "nthreads", QThread::idealThreadCount() );
+    machine.insert( "multifloat_size", SireMaths::MultiFloat::count() );
+
+    QJsonArray results;
+    
+    foreach (const BenchmarkResult &result, reslts)
+    {
+        QJsonObject r;
+        r.insert( "name", result.name );
+        r.insert( "units", result.units );
+        
+        if (not result.error.isEmpty())
+        {
+            r.insert( "error", result.error );
+        }
+        else
+        {
+            r.insert( "iterations", result.samples.count() );
+            r.insert( "items", double(result.nitems) );
+            r.insert( "median_ns", result.medianTime() );
+            r.insert( "min_ns", result.minimumTime() );
+            r.insert( "mean_ns", result.meanTime() );
+            r.insert( "stdev_ns", result.stdevTime() );
+            r.insert( "items_per_second", result.throughput() );
+            
+            if (result.hasBaseline())
+            {
+                r.insert( "baseline_median_ns", result.baseline_ns );
+                r.insert( "baseline_ratio", result.baselineRatio() );
+                r.insert( "regression", result.baselineRatio() > 1.0 + thres );
+            }
+        }
+        
+        results.append(r);
+    }
+    
+    QJsonObject json;
+    json.insert( "format", "sire-benchmark" );
+    json.insert( "format_version", 1 );
+    json.insert( "sire_version", QString("%1.%2.%3").arg(SIRE_VERSION_MAJOR)
+                                                    .arg(SIRE_VERSION_MINOR)
+                                                    .arg(SIRE_VERSION_PATCH) );
+    json.insert( "sire_repository_version", QString(SIRE_REPOSITORY_VERSION) );
+    json.insert( "compile_flags", QString(SIRE_COMPILE_FLAGS) );
+    json.insert( "date", QDateTime::currentDateTime().toString(Qt::ISODate) );
+    json.insert( "machine", machine );
+    json.insert( "benchmarks", results );
+    
+    if (not baseline_file.isEmpty())
+    {
+        json.insert( "baseline", baseline_file );
+        json.insert( "threshold", thres );
+        json.insert( "nregressions", this->nRegressions() );
+    }
+    
+    return QString::fromUtf8( QJsonDocument(json).toJson() );
+}
+
+/** Save the results as JSON to the file 'filename'
+    
+    \throw SireError::file_error
+*/
+void BenchmarkRunner::saveJSON(const QString &filename) const
+{
+    QFile f(filename);
+    
+    if (not f.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        throw SireError::file_error(f, CODELOC);
+    
+    f.write( this->toJSON().toUtf8() );
+}
@@ -0,0 +1,187 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#ifndef SIRE_BENCHMARK_H
+#define SIRE_BENCHMARK_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QList>
+#include <QHash>
+
+#include <boost/shared_ptr.hpp>
+
+namespace SireBenchmark
+{
+
+/** This is the base class of all of the benchmarks. Each benchmark
+    prepares its data in setUp (which is not timed), and then 
+    performs a single iteration of the benchmarked operation in 
+    run, returning the number of items processed (e.g. the number
+    of atoms or pair interactions) so that a throughput can be
+    reported. Iterations must leave the benchmark in a state from
+    which run can be called again
+    
+    @author Christopher Woods
+*/
+class Benchmark
+{
+public:
+    Benchmark(const QString &name, const QString &units);
+
+    virtual ~Benchmark();
+
+    QString name() const;
+    QString units() const;
+
+    virtual void setUp();
+    virtual qint64 run()=0;
+    virtual void tearDown();
+
+private:
+    /** The name of the benchmark, e.g. "CLJCalculator/water_8000" */
+    QString nme;
+    
+    /** The units of the items returned by run, e.g. "atoms" */
+    QString unts;
+};
+
+typedef boost::shared_ptr<Benchmark> BenchmarkPtr;
+
+/** This holds the timing of a single benchmark */
+class BenchmarkResult
+{
+public:
+    BenchmarkResult();
+    
+    ~BenchmarkResult();
+
+    QString name;
+    QString units;
+    
+    /** The time of each iteration, in nanoseconds */
+    QVector<double> samples;
+    
+    /** The number of items processed per iteration */
+    qint64 nitems;
+    
+    /** The median time of the same benchmark in the baseline,
+        or 0 if it is not in the baseline */
+    double baseline_ns;
+
+    /** Set if the benchmark could not be run */
+    QString error;
+
+    bool hasBaseline() const;
+
+    double medianTime() const;
+    double minimumTime() const;
+    double meanTime() const;
+    double stdevTime() const;
+
+    double throughput() const;
+    
+    double baselineRatio() const;
+};
+
+/** This runs a set of benchmarks, writes the results in a 
+    machine-readable (JSON) format, and compares them against
+    the results of a previous (baseline) run
+    
+    @author Christopher Woods
+*/
+class BenchmarkRunner
+{
+public:
+    BenchmarkRunner();
+    
+    ~BenchmarkRunner();
+
+    void add(Benchmark *benchmark);
+
+    QStringList names() const;
+
+    void setFilter(const QString &pattern);
+    
+    void setMinimumTime(double seconds);
+    void setMinimumIterations(int n);
+    void setMaximumIterations(int n);
+
+    void setThreshold(double threshold);
+    double threshold() const;
+
+    void loadBaseline(const QString &filename);
+
+    void runAll();
+
+    QList<BenchmarkResult> results() const;
+
+    int nRegressions() const;
+
+    QString report() const;
+    QString toJSON() const;
+
+    void saveJSON(const QString &filename) const;
+
+private:
+    BenchmarkResult run(Benchmark &benchmark) const;
+
+    /** All of the benchmarks */
+    QList<BenchmarkPtr> benchmarks;
+
+    /** The results of the benchmarks that have been run */
+    QList<BenchmarkResult> reslts;
+
+    /** The median time of each benchmark in the baseline run */
+    QHash<QString,double> baseline;
+
+    /** The name of the baseline file */
+    QString baseline_file;
+
+    /** Only benchmarks whose names match this pattern are run */
+    QString filter;
+
+    /** The minimum amount of time to spend timing each benchmark */
+    double min_time;
+
+    /** The minimum and maximum number of timed iterations */
+    int min_iterations;
+    int max_iterations;
+
+    /** The fractional increase in median time (relative to
+        the baseline) that is counted as a regression */
+    double thres;
+};
+
+void addCLJBenchmarks(BenchmarkRunner &runner);
+void addSystemBenchmarks(BenchmarkRunner &runner, const QString &datadir);
+
+}
+
+#endif
@@ -0,0 +1,421 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#include "benchmark.h"
+
+#include "SireMM/cljatoms.h"
+#include "SireMM/cljboxes.h"
+#include "SireMM/cljshiftfunction.h"
+#include "SireMM/cljrffunction.h"
+#include "SireMM/cljcalculator.h"
+#include "SireMM/cljpairlist.h"
+#include "SireMM/ljparameter.h"
+
+#include "SireVol/periodicbox.h"
+#include "SireVol/cartesian.h"
+
+#include "SireMaths/rangenerator.h"
+#include "SireMaths/vector.h"
+#include "SireMaths/constants.h"
+
+#include "SireStream/streamdata.hpp"
+
+#include "SireUnits/units.h"
+
+#include <cmath>
+
+using namespace SireBenchmark;
+using namespace SireMM;
+using namespace SireVol;
+using namespace SireMaths;
+using namespace SireUnits;
+using namespace SireUnits::Dimension;
+
+/////////
+///////// Generated systems
+/////////
+
+/** Generate a box of 'nwaters' TIP3P waters on a cubic lattice, 
+    with random orientations. The waters are numbered from 1, so 
+    each water has its own ID. The dimensions of the box
+    are returned in 'box' */
+static CLJAtoms generateWaterBox(int nwaters, Vector &box)
+{
+    RanGenerator rangen(1234567);
+
+    //the lattice spacing gives the density of liquid water
+    const double spacing = 3.104;
+    const int nside = int( std::ceil( std::pow(double(nwaters), 1.0/3.0) ) );
+    
+    box = Vector(nside * spacing);
+    
+    const double r_oh = 0.9572;
+    const double theta = 104.52 * SireMaths::pi / 180.0;
+    
+    const LJParameter lj_o(3.15061*angstrom, 0.1521*kcal_per_mol);
+    const LJParameter lj_h;
+    
+    QVector<Vector> coords;
+    QVector<Charge> charges;
+    QVector<LJParameter> ljs;
+    QVector<qint32> ids;
+    
+    coords.reserve(3*nwaters);
+    charges.reserve(3*nwaters);
+    ljs.reserve(3*nwaters);
+    ids.reserve(3*nwaters);
+    
+    for (int i=0; i<nwaters; ++i)
+    {
+        const Vector o( spacing * (0.5 + (i % nside)),
+                        spacing * (0.5 + ((i / nside) % nside)),
+                        spacing * (0.5 + (i / (nside*nside))) );
+        
+        const Vector u = rangen.vectorOnSphere();
+        const Vector v = Vector::cross(u, rangen.vectorOnSphere()).normalise();
+        
+        coords.append(o);
+        coords.append(o + r_oh * u);
+        coords.append(o + r_oh * (std::cos(theta)*u + std::sin(theta)*v));
+        
+        charges.append( -0.834 * mod_electron );
+        charges.append( 0.417 * mod_electron );
+        charges.append( 0.417 * mod_electron );
+        
+        ljs.append(lj_o);
+        ljs.append(lj_h);
+        ljs.append(lj_h);
+        
+        ids.append(i+1);
+        ids.append(i+1);
+        ids.append(i+1);
+    }
+    
+    return CLJAtoms(coords, charges, ljs, ids);
+}
+
+/** Generate a protein-like globule of 'natoms' atoms. The atoms
+    are placed as a random walk with 1.5 A steps that is confined
+    to a sphere, at roughly the atom density of a protein. The atoms
+    have a mixture of C, N, O and H LJ parameters and partial charges */
+static CLJAtoms generateProtein(int natoms)
+{
+    RanGenerator rangen(7654321);
+    
+    //proteins have roughly 0.1 atoms per cubic angstrom
+    const double radius = std::pow( (3.0*natoms) / (4.0*SireMaths::pi*0.1), 1.0/3.0 );
+    
+    const LJParameter lj_types[4] = { LJParameter(3.39967*angstrom, 0.0860*kcal_per_mol),
+                                      LJParameter(3.25000*angstrom, 0.1700*kcal_per_mol),
+                                      LJParameter(2.95992*angstrom, 0.2100*kcal_per_mol),
+                                      LJParameter(1.06908*angstrom, 0.0157*kcal_per_mol) };
+
+    QVector<Vector> coords;
+    QVector<Charge> charges;
+    QVector<LJParameter> ljs;
+    
+    coords.reserve(natoms);
+    charges.reserve(natoms);
+    ljs.reserve(natoms);
+    
+    Vector position(0);
+    
+    for (int i=0; i<natoms; ++i)
+    {
+        Vector next = position + rangen.vectorOnSphere(1.5);
+        
+        //reflect the walk back into the sphere
+        if (next.length() > radius)
+            next = position - (next - position);
+        
+        position = next;
+        
+        coords.append(position);
+        charges.append( rangen.rand(-0.5, 0.5) * mod_electron );
+        ljs.append( lj_types[i % 4] );
+    }
+    
+    return CLJAtoms(coords, charges, ljs);
+}
+
+/////////
+///////// The benchmarks
+/////////
+
+namespace SireBenchmark
+{
+
+/** Benchmark the construction of CLJBoxes from a water box */
+class CLJBoxesConstruct : public Benchmark
+{
+public:
+    CLJBoxesConstruct(int n) 
+        : Benchmark(QString("CLJBoxes/construct/water_%1").arg(n), "atoms"), nwaters(n)
+    {}
+    
+    void setUp()
+    {
+        Vector box;
+        atoms = generateWaterBox(nwaters, box);
+    }
+    
+    qint64 run()
+    {
+        CLJBoxes boxes(atoms);
+        return boxes.nAtoms();
+    }
+    
+    void tearDown()
+    {
+        atoms = CLJAtoms();
+    }
+
+private:
+    int nwaters;
+    CLJAtoms atoms;
+};
+
+/** Benchmark finding the pairs of boxes within the cutoff */
+class CLJBoxesGetDistances : public Benchmark
+{
+public:
+    CLJBoxesGetDistances(int n) 
+        : Benchmark(QString("CLJBoxes/getDistances/water_%1").arg(n), "box pairs"), 
+          nwaters(n)
+    {}
+    
+    void setUp()
+    {
+        Vector box;
+        boxes = CLJBoxes( generateWaterBox(nwaters, box) );
+        space = PeriodicBox(box);
+    }
+    
+    qint64 run()
+    {
+        return CLJBoxes::getDistances(space, boxes, 10*angstrom).count();
+    }
+    
+    void tearDown()
+    {
+        boxes = CLJBoxes();
+    }
+
+private:
+    int nwaters;
+    CLJBoxes boxes;
+    PeriodicBox space;
+};
+
+/** Benchmark the CLJFunction kernel between two groups of atoms,
+    with no boxing, so that every pair is calculated */
+class CLJFunctionKernel : public Benchmark
+{
+public:
+    CLJFunctionKernel(const QString &name, const CLJFunction &function, int n)
+        : Benchmark(QString("%1/kernel/protein_%2_water").arg(name).arg(n), "pairs"),
+          func(function), natoms(n)
+    {}
+    
+    void setUp()
+    {
+        Vector box;
+        atoms0 = generateProtein(natoms);
+        atoms1 = generateWaterBox(natoms / 3, box);
+    }
+    
+    qint64 run()
+    {
+        double cnrg, ljnrg;
+        func.read()(atoms0, atoms1, cnrg, ljnrg);
+        return qint64(atoms0.count()) * qint64(atoms1.count());
+    }
+    
+    void tearDown()
+    {
+        atoms0 = CLJAtoms();
+        atoms1 = CLJAtoms();
+    }
+
+private:
+    CLJFunctionPtr func;
+    int natoms;
+    CLJAtoms atoms0, atoms1;
+};
+
+/** Benchmark the serial CLJFunction energy of a boxed water box */
+class CLJFunctionBoxes : public Benchmark
+{
+public:
+    CLJFunctionBoxes(const QString &name, const CLJFunction &function, int n)
+        : Benchmark(QString("%1/boxes/water_%2").arg(name).arg(n), "atoms"),
+          func(function), nwaters(n)
+    {}
+    
+    void setUp()
+    {
+        Vector box;
+        boxes = CLJBoxes( generateWaterBox(nwaters, box) );
+        func.edit().setSpace( PeriodicBox(box) );
+    }
+    
+    qint64 run()
+    {
+        double cnrg, ljnrg;
+        func.read()(boxes, cnrg, ljnrg);
+        return boxes.nAtoms();
+    }
+    
+    void tearDown()
+    {
+        boxes = CLJBoxes();
+    }
+
+private:
+    CLJFunctionPtr func;
+    int nwaters;
+    CLJBoxes boxes;
+};
+
+/** Benchmark the parallel CLJCalculator total energy of a water box,
+    optionally using a Verlet pair list */
+class CLJCalculatorTotal : public Benchmark
+{
+public:
+    CLJCalculatorTotal(int n, bool pairlist)
+        : Benchmark(QString("CLJCalculator/%1/water_%2")
+                        .arg(pairlist ? "pairlist" : "total").arg(n), "atoms"),
+          nwaters(n), use_pairlist(pairlist)
+    {}
+    
+    void setUp()
+    {
+        Vector box;
+        boxes = CLJBoxes( generateWaterBox(nwaters, box) );
+        func = CLJShiftFunction( PeriodicBox(box), 10*angstrom );
+        pairlist = CLJPairList();
+    }
+    
+    qint64 run()
+    {
+        if (use_pairlist)
+            calc.calculate(func, boxes, pairlist);
+        else
+            calc.calculate(func, boxes);
+
+        return boxes.nAtoms();
+    }
+    
+    void tearDown()
+    {
+        boxes = CLJBoxes();
+        pairlist = CLJPairList();
+    }
+
+private:
+    int nwaters;
+    bool use_pairlist;
+    CLJBoxes boxes;
+    CLJShiftFunction func;
+    CLJCalculator calc;
+    CLJPairList pairlist;
+};
+
+/** Benchmark saving and loading CLJBoxes using SireStream */
+class CLJBoxesStream : public Benchmark
+{
+public:
+    CLJBoxesStream(int n, bool load)
+        : Benchmark(QString("SireStream/%1/CLJBoxes_water_%2")
+                        .arg(load ? "load" : "save").arg(n), "bytes"),
+          nwaters(n), do_load(load)
+    {}
+    
+    void setUp()
+    {
+        Vector box;
+        boxes = CLJBoxes( generateWaterBox(nwaters, box) );
+        data = SireStream::save(boxes);
+    }
+    
+    qint64 run()
+    {
+        if (do_load)
+            SireStream::loadType<CLJBoxes>(data);
+        else
+            data = SireStream::save(boxes);
+        
+        return data.count();
+    }
+    
+    void tearDown()
+    {
+        boxes = CLJBoxes();
+        data = QByteArray();
+    }
+
+private:
+    int nwaters;
+    bool do_load;
+    CLJBoxes boxes;
+    QByteArray data;
+};
+
+/** Add the benchmarks of the CLJ functions and CLJBoxes, which
+    run on generated water boxes and protein-like systems */
+void addCLJBenchmarks(BenchmarkRunner &runner)
+{
+    const int sizes[2] = { 1000, 8000 };
+
+    for (int i=0; i<2; ++i)
+    {
+        runner.add( new CLJBoxesConstruct(sizes[i]) );
+        runner.add( new CLJBoxesGetDistances(sizes[i]) );
+    }
+    
+    runner.add( new CLJFunctionKernel("CLJShiftFunction", 
+                                      CLJShiftFunction(1000*angstrom), 3000) );
+    runner.add( new CLJFunctionKernel("CLJRFFunction", 
+                                      CLJRFFunction(1000*angstrom), 3000) );
+
+    for (int i=0; i<2; ++i)
+    {
+        runner.add( new CLJFunctionBoxes("CLJShiftFunction",
+                                         CLJShiftFunction(10*angstrom), sizes[i]) );
+        runner.add( new CLJFunctionBoxes("CLJRFFunction",
+                                         CLJRFFunction(10*angstrom), sizes[i]) );
+
+        runner.add( new CLJCalculatorTotal(sizes[i], false) );
+        runner.add( new CLJCalculatorTotal(sizes[i], true) );
+    }
+    
+    runner.add( new CLJBoxesStream(8000, false) );
+    runner.add( new CLJBoxesStream(8000, true) );
+}
+
+}
@@ -0,0 +1,358 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#include "benchmark.h"
+
+#include "SireIO/amber.h"
+
+#include "SireMM/interff.h"
+#include "SireMM/internalff.h"
+
+#include "SireMol/moleculegroup.h"
+#include "SireMol/molecule.h"
+#include "SireMol/viewsofmol.h"
+#include "SireMol/mover.hpp"
+
+#include "SireMove/rigidbodymc.h"
+
+#include "SireMaths/rangenerator.h"
+#include "SireMaths/vector.h"
+
+#include "SireSystem/system.h"
+
+#include "SireVol/space.h"
+
+#include "SireStream/streamdata.hpp"
+
+#include "SireError/errors.h"
+
+#include <QDir>
+#include <QFile>
+
+using namespace SireBenchmark;
+using namespace SireIO;
+using namespace SireMM;
+using namespace SireMaths;
+using namespace SireMol;
+using namespace SireMove;
+using namespace SireSystem;
+using namespace SireVol;
+
+/** Load the Amber crd/top pair called 'name' from 'datadir'
+
+    \throw SireError::file_error
+*/
+static tuple<MoleculeGroup,SpacePtr> loadCrdTop(const QString &datadir,
+                                                const QString &name)
+{
+    QDir dir(datadir);
+    
+    const QString crdfile = dir.absoluteFilePath( QString("%1.crd").arg(name) );
+    const QString topfile = dir.absoluteFilePath( QString("%1.top").arg(name) );
+    
+    if (not (QFile::exists(crdfile) and QFile::exists(topfile)))
+        throw SireError::file_error( QObject::tr(
+                "Cannot find the benchmark input files \"%1\" and \"%2\". "
+                "Use --data to set the directory containing the test input files.")
+                    .arg(crdfile, topfile), CODELOC );
+    
+    return Amber().readCrdTop(crdfile, topfile);
+}
+
+/** Return the largest molecule in 'molgroup' */
+static Molecule largestMolecule(const MoleculeGroup &molgroup)
+{
+    Molecule largest;
+    
+    foreach (MolNum molnum, molgroup.molNums())
+    {
+        Molecule mol = molgroup[molnum].molecule();
+        
+        if (mol.nAtoms() > largest.nAtoms())
+            largest = mol;
+    }
+    
+    return largest;
+}
+
+/** Return the total number of atoms in 'molgroup' */
+static qint64 countAtoms(const MoleculeGroup &molgroup)
+{
+    qint64 natoms = 0;
+    
+    foreach (MolNum molnum, molgroup.molNums())
+    {
+        natoms += molgroup[molnum].molecule().nAtoms();
+    }
+    
+    return natoms;
+}
+
+/** Create a system of the passed waters, with an InterFF forcefield
+    using the passed space */
+static System createWaterSystem(const MoleculeGroup &waters, const SpacePtr &space)
+{
+    InterFF interff("interff");
+    interff.add(waters);
+    
+    System system;
+    system.add(interff);
+    system.add(waters);
+    system.setProperty("space", space);
+    
+    return system;
+}
+
+namespace SireBenchmark
+{
+
+/** Benchmark the from-scratch intramolecular energy of the protein
+    in SYSTEM.crd/top using InternalFF */
+class InternalFFEnergy : public Benchmark
+{
+public:
+    InternalFFEnergy(const QString &dir)
+        : Benchmark("InternalFF/energy/protein", "atoms"), datadir(dir), natoms(0)
+    {}
+    
+    void setUp()
+    {
+        Molecule protein = largestMolecule( loadCrdTop(datadir, "SYSTEM").get<0>() );
+        
+        internalff = InternalFF("internalff");
+        internalff.add(protein);
+        natoms = protein.nAtoms();
+    }
+    
+    qint64 run()
+    {
+        internalff.mustNowRecalculateFromScratch();
+        internalff.energy();
+        return natoms;
+    }
+    
+    void tearDown()
+    {
+        internalff = InternalFF();
+    }
+
+private:
+    QString datadir;
+    InternalFF internalff;
+    qint64 natoms;
+};
+
+/** Benchmark the from-scratch intermolecular energy of waterbox.crd/top
+    using InterFF */
+class InterFFEnergy : public Benchmark
+{
+public:
+    InterFFEnergy(const QString &dir)
+        : Benchmark("InterFF/energy/waterbox", "atoms"), datadir(dir), natoms(0)
+    {}
+    
+    void setUp()
+    {
+        tuple<MoleculeGroup,SpacePtr> waters = loadCrdTop(datadir, "waterbox");
+        
+        interff = InterFF("interff");
+        interff.add(waters.get<0>());
+        interff.setProperty("space", waters.get<1>());
+        natoms = countAtoms(waters.get<0>());
+    }
+    
+    qint64 run()
+    {
+        interff.mustNowRecalculateFromScratch();
+        interff.energy();
+        return natoms;
+    }
+    
+    void tearDown()
+    {
+        interff = InterFF();
+    }
+
+private:
+    QString datadir;
+    InterFF interff;
+    qint64 natoms;
+};
+
+/** Benchmark rigid body Monte Carlo moves of the waters in
+    waterbox.crd/top. Each iteration performs 'nmoves' moves,
+    each of which copies, updates and evaluates the energy of
+    the system before accepting or rejecting the move */
+class RigidBodyMCMove : public Benchmark
+{
+public:
+    RigidBodyMCMove(const QString &dir, int n)
+        : Benchmark("RigidBodyMC/move/waterbox", "moves"), datadir(dir), nmoves(n)
+    {}
+    
+    void setUp()
+    {
+        tuple<MoleculeGroup,SpacePtr> waters = loadCrdTop(datadir, "waterbox");
+        
+        system = createWaterSystem(waters.get<0>(), waters.get<1>());
+        system.energy();
+        
+        mc = RigidBodyMC(waters.get<0>());
+        mc.setGenerator( RanGenerator(42) );
+    }
+    
+    qint64 run()
+    {
+        mc.move(system, nmoves, false);
+        return nmoves;
+    }
+    
+    void tearDown()
+    {
+        system = System();
+    }
+
+private:
+    QString datadir;
+    System system;
+    RigidBodyMC mc;
+    int nmoves;
+};
+
+/** Benchmark the copy, update, energy and accept cycle of a System
+    that is at the heart of every move. Each iteration copies the 
+    system, moves one water, evaluates the (incremental) energy and
+    then accepts the new system */
+class SystemCopyAccept : public Benchmark
+{
+public:
+    SystemCopyAccept(const QString &dir)
+        : Benchmark("System/copy_update_accept/waterbox", "moves"), 
+          datadir(dir), imol(0)
+    {}
+    
+    void setUp()
+    {
+        tuple<MoleculeGroup,SpacePtr> waters = loadCrdTop(datadir, "waterbox");
+        
+        system = createWaterSystem(waters.get<0>(), waters.get<1>());
+        system.energy();
+        system.accept();
+        
+        molnums = waters.get<0>().molNums();
+        imol = 0;
+    }
+    
+    qint64 run()
+    {
+        System new_system(system);
+        
+        Molecule mol = new_system[ molnums[imol % molnums.count()] ].molecule();
+        
+        //move each water forwards on one pass through the waters and
+        //back on the next, so the system does not drift during the benchmark
+        const double delta = ((imol / molnums.count()) % 2 == 0) ? 0.05 : -0.05;
+        imol += 1;
+        
+        mol = mol.move().translate( Vector(delta,0,0) ).commit();
+        
+        new_system.update(mol.data());
+        new_system.energy();
+        new_system.accept();
+        
+        system = new_system;
+        
+        return 1;
+    }
+    
+    void tearDown()
+    {
+        system = System();
+        molnums.clear();
+    }
+
+private:
+    QString datadir;
+    System system;
+    QVector<MolNum> molnums;
+    qint64 imol;
+};
+
+/** Benchmark saving and loading a System using SireStream */
+class SystemStream : public Benchmark
+{
+public:
+    SystemStream(const QString &dir, bool load)
+        : Benchmark(QString("SireStream/%1/System_waterbox")
+                        .arg(load ? "load" : "save"), "bytes"),
+          datadir(dir), do_load(load)
+    {}
+    
+    void setUp()
+    {
+        tuple<MoleculeGroup,SpacePtr> waters = loadCrdTop(datadir, "waterbox");
+        system = createWaterSystem(waters.get<0>(), waters.get<1>());
+        data = SireStream::save(system);
+    }
+    
+    qint64 run()
+    {
+        if (do_load)
+            SireStream::loadType<System>(data);
+        else
+            data = SireStream::save(system);
+        
+        return data.count();
+    }
+    
+    void tearDown()
+    {
+        system = System();
+        data = QByteArray();
+    }
+
+private:
+    QString datadir;
+    System system;
+    QByteArray data;
+    bool do_load;
+};
+
+/** Add the benchmarks of the forcefields, moves and systems, which
+    run on the Amber input files in 'datadir' (the test/io directory) */
+void addSystemBenchmarks(BenchmarkRunner &runner, const QString &datadir)
+{
+    runner.add( new InternalFFEnergy(datadir) );
+    runner.add( new InterFFEnergy(datadir) );
+    runner.add( new RigidBodyMCMove(datadir, 100) );
+    runner.add( new SystemCopyAccept(datadir) );
+    runner.add( new SystemStream(datadir, false) );
+    runner.add( new SystemStream(datadir, true) );
+}
+
+}
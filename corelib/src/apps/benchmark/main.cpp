@@ -0,0 +1,238 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#include "benchmark.h"
+
+#include "SireError/errors.h"
+
+#include <QStringList>
+#include <QTextStream>
+#include <QRegExp>
+
+#include <cstdio>
+
+#ifndef SIRE_BENCHMARK_DATA
+    #define SIRE_BENCHMARK_DATA "test/io"
+#endif
+
+using namespace SireBenchmark;
+
+static void printHelp(QTextStream &ts)
+{
+    ts << "Usage: sire_benchmark [options]\n\n"
+       << "Runs the Sire benchmarks and writes the results as JSON.\n\n"
+       << "Options:\n"
+       << "  --list                  List the benchmarks and exit\n"
+       << "  --filter <regexp>       Only run benchmarks whose names match <regexp>\n"
+       << "  --min-time <seconds>    Minimum time to spend timing each benchmark (1)\n"
+       << "  --min-iterations <n>    Minimum number of timed iterations (5)\n"
+       << "  --max-iterations <n>    Maximum number of timed iterations (1000)\n"
+       << "  --output <file>         Write the results to <file> "
+          "(benchmark_results.json)\n"
+       << "  --baseline <file>       Compare against the results in <file>\n"
+       << "  --threshold <fraction>  Fractional slow-down counted as a regression (0.1)\n"
+       << "  --fail-on-regression    Exit with a non-zero status if any benchmark\n"
+       << "                          failed or has regressed against the baseline\n"
+       << "  --data <dir>            Directory containing the test input files\n"
+       << "  --help                  Print this help\n";
+}
+
+int main(int argc, char **argv)
+{
+    QTextStream ts(stdout);
+
+    QString filter;
+    QString output = "benchmark_results.json";
+    QString baseline;
+    QString datadir = SIRE_BENCHMARK_DATA;
+
+    double min_time = -1;
+    int min_iterations = -1;
+    int max_iterations = -1;
+    double threshold = -1;
+
+    bool list_only = false;
+    bool fail_on_regression = false;
+
+    QStringList args;
+    
+    for (int i=1; i<argc; ++i)
+    {
+        args.append( QString::fromLocal8Bit(argv[i]) );
+    }
+
+    try
+    {
+        for (int i=0; i<args.count(); ++i)
+        {
+            const QString arg = args[i];
+            
+            if (arg == "--help" or arg == "-h")
+            {
+                printHelp(ts);
+                return 0;
+            }
+            else if (arg == "--list")
+            {
+                list_only = true;
+                continue;
+            }
+            else if (arg == "--fail-on-regression")
+            {
+                fail_on_regression = true;
+                continue;
+            }
+            
+            if (i+1 >= args.count())
+                throw SireError::invalid_arg( QObject::tr(
+                        "Unrecognised option, or missing value for option, \"%1\". "
+                        "Use --help to see the available options.").arg(arg), CODELOC );
+            
+            const QString value = args[++i];
+            bool ok = true;
+            
+            if (arg == "--filter")
+                filter = value;
+            else if (arg == "--output")
+                output = value;
+            else if (arg == "--baseline")
+                baseline = value;
+            else if (arg == "--data")
+                datadir = value;
+            else if (arg == "--min-time")
+                min_time = value.toDouble(&ok);
+            else if (arg == "--min-iterations")
+                min_iterations = value.toInt(&ok);
+            else if (arg == "--max-iterations")
+                max_iterations = value.toInt(&ok);
+            else if (arg == "--threshold")
+                threshold = value.toDouble(&ok);
+            else
+                throw SireError::invalid_arg( QObject::tr(
+                        "Unrecognised option \"%1\". Use --help to see the "
+                        "available options.").arg(arg), CODELOC );
+            
+            if (not ok)
+                throw SireError::invalid_arg( QObject::tr(
+                        "Cannot interpret \"%1\" as the value of option \"%2\".")
+                            .arg(value, arg), CODELOC );
+        }
+
+        BenchmarkRunner runner;
+        
+        addCLJBenchmarks(runner);
+        addSystemBenchmarks(runner, datadir);
+
+        if (list_only)
+        {
+            QRegExp regexp(filter);
+
+            foreach (QString name, runner.names())
+            {
+                if (filter.isEmpty() or regexp.indexIn(name) != -1)
+                    ts << name << "\n";
+            }
+            
+            return 0;
+        }
+
+        if (not filter.isEmpty())
+            runner.setFilter(filter);
+        
+        if (min_time >= 0)
+            runner.setMinimumTime(min_time);
+        
+        if (min_iterations >= 0)
+            runner.setMinimumIterations(min_iterations);
+        
+        if (max_iterations >= 0)
+            runner.setMaximumIterations(max_iterations);
+        
+        if (threshold >= 0)
+            runner.setThreshold(threshold);
+        
+        if (not baseline.isEmpty())
+            runner.loadBaseline(baseline);
+        
+        runner.runAll();
+        
+        ts << runner.report();
+        ts.flush();
+        
+        if (not output.isEmpty())
+        {
+            runner.saveJSON(output);
+            ts << "\nWritten the results to " << output << "\n";
+        }
+
+        int nfailed = 0;
+        
+        foreach (const BenchmarkResult &result, runner.results())
+        {
+            if (not result.error.isEmpty())
+                nfailed += 1;
+        }
+        
+        if (nfailed > 0)
+        {
+            ts << nfailed << " benchmark(s) could not be run\n";
+            
+            if (fail_on_regression)
+                return 1;
+        }
+
+        if (not baseline.isEmpty())
+        {
+            const int nregressions = runner.nRegressions();
+        
+            if (nregressions > 0)
+            {
+                ts << nregressions << " benchmark(s) are more than "
+                   << 100.0 * runner.threshold() << "% slower than the baseline "
+                   << baseline << "\n";
+                
+                if (fail_on_regression)
+                    return 1;
+            }
+        }
+    }
+    catch(const SireError::exception &e)
+    {
+        ts.flush();
+        std::fprintf(stderr, "%s\n", qPrintable(e.toString()));
+        return -1;
+    }
+    catch(const std::exception &e)
+    {
+        ts.flush();
+        std::fprintf(stderr, "%s\n", e.what());
+        return -1;
+    }
+
+    return 0;
+}
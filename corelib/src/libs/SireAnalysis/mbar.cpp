@@ -0,0 +1,1262 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#include "mbar.h"
+
+#include "SireMaths/nvector.h"
+#include "SireMaths/errors.h"
+
+#include "SireUnits/units.h"
+#include "SireUnits/temperature.h"
+
+#include "SireError/errors.h"
+
+#include "SireStream/datastream.h"
+#include "SireStream/shareddatastream.h"
+
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
+#include <QDir>
+#include <QMutex>
+#include <QTemporaryFile>
+
+#include <boost/noncopyable.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "tostring.h"
+
+using namespace SireAnalysis;
+using namespace SireAnalysis::detail;
+using namespace SireMaths;
+using namespace SireBase;
+using namespace SireUnits;
+using namespace SireUnits::Dimension;
+using namespace SireStream;
+
+/** The number of samples held in each chunk */
+static const int MBAR_CHUNK_SIZE = 4096;
+
+namespace SireAnalysis
+{
+namespace detail
+{
+
+/** This is an append-only temporary file to which completed 
+    chunks of samples are written. Each chunk is memory-mapped
+    back in read-only as soon as it has been written. The file
+    is deleted once the last chunk that uses it is deleted */
+class MBARSpool : public boost::noncopyable
+{
+public:
+    MBARSpool();
+    ~MBARSpool();
+    
+    const float* append(const QVector<float> &values);
+    
+private:
+    /** Mutex to serialise appending to the file */
+    QMutex mutex;
+
+    /** The spool file */
+    QTemporaryFile f;
+};
+
+/** This is a completed, read-only chunk of the reduced energies
+    of the samples. The chunk is either held in memory, or is
+    memory-mapped from a spool file */
+class MBARChunk : public boost::noncopyable
+{
+public:
+    MBARChunk(const QVector<float> &values);
+    MBARChunk(const QVector<float> &values, 
+              const boost::shared_ptr<MBARSpool> &spool);
+    
+    ~MBARChunk();
+    
+    const float* constData() const
+    {
+        return data;
+    }
+    
+    int count() const
+    {
+        return nvals;
+    }
+    
+    bool isSpooled() const
+    {
+        return spool.get() != 0;
+    }
+    
+private:
+    /** The values, if they are held in memory */
+    QVector<float> vals;
+    
+    /** The spool file holding the values, if they are spooled */
+    boost::shared_ptr<MBARSpool> spool;
+    
+    /** Pointer to the values */
+    const float *data;
+    
+    /** The number of values */
+    int nvals;
+};
+
+/** A contiguous block of samples that is processed by a single
+    task of a pass over the samples */
+class MBARBlock
+{
+public:
+    MBARBlock(const float *d = 0, int n = 0) : data(d), nsamples(n)
+    {}
+    
+    /** The reduced energies of the samples (nsamples x nstates) */
+    const float *data;
+    
+    /** The number of samples in the block */
+    int nsamples;
+};
+
+/** This performs a single pass over the samples, calculating, for each 
+    block of samples, the sum of the log of the denominator of the 
+    MBAR weights (which is part of the MBAR objective function), the
+    sum of the weights of each state and (optionally) the sum of the
+    products of the weights of each pair of states */
+class MBARPass
+{
+public:
+    MBARPass(const MBARBlock *blocks, int nstates_,
+             const double *free_energies, const double *log_nsampled,
+             double *sum_logd, double *sum_w, double *sum_ww)
+        : blks(blocks), nstates(nstates_), f(free_energies), logn(log_nsampled),
+          logd(sum_logd), w(sum_w), ww(sum_ww)
+    {}
+
+    void operator()(const tbb::blocked_range<int> &range) const
+    {
+        const int K = nstates;
+        
+        QVector<double> a(K);
+        QVector<double> wn(K);
+        
+        double *a_data = a.data();
+        double *wn_data = wn.data();
+    
+        for (int b = range.begin(); b != range.end(); ++b)
+        {
+            const MBARBlock &block = blks[b];
+
+            double block_logd = 0;
+            double *block_w = w + b*K;
+            double *block_ww = (ww == 0) ? 0 : ww + b*K*K;
+            
+            for (int i=0; i<K; ++i)
+            {
+                block_w[i] = 0;
+            }
+            
+            if (block_ww)
+            {
+                for (int i=0; i<K*K; ++i)
+                {
+                    block_ww[i] = 0;
+                }
+            }
+        
+            for (int n=0; n<block.nsamples; ++n)
+            {
+                const float *u = block.data + n*K;
+                
+                //log of the denominator, using the log-sum-exp trick.
+                //States that were not sampled have logn == -infinity
+                double amax = -std::numeric_limits<double>::infinity();
+                
+                for (int k=0; k<K; ++k)
+                {
+                    a_data[k] = f[k] + logn[k] - u[k];
+                    amax = qMax(amax, a_data[k]);
+                }
+                
+                double sum = 0;
+                
+                for (int k=0; k<K; ++k)
+                {
+                    sum += std::exp(a_data[k] - amax);
+                }
+                
+                const double d = amax + std::log(sum);
+                
+                block_logd += d;
+                
+                for (int k=0; k<K; ++k)
+                {
+                    wn_data[k] = std::exp(f[k] - u[k] - d);
+                    block_w[k] += wn_data[k];
+                }
+                
+                if (block_ww)
+                {
+                    for (int i=0; i<K; ++i)
+                    {
+                        const double wi = wn_data[i];
+                        double *row = block_ww + i*K;
+                    
+                        for (int j=i; j<K; ++j)
+                        {
+                            row[j] += wi * wn_data[j];
+                        }
+                    }
+                }
+            }
+            
+            logd[b] = block_logd;
+        }
+    }
+
+private:
+    const MBARBlock *blks;
+    int nstates;
+    const double *f;
+    const double *logn;
+    double *logd;
+    double *w;
+    double *ww;
+};
+
+/** This holds the per-block sums calculated by a pass over the samples.
+    This is allocated once per solve and reused by every pass, as every
+    element is overwritten by each pass */
+struct MBARPassBuffers
+{
+    MBARPassBuffers(int nblocks, int nstates)
+        : block_logd(nblocks, 0), block_w(nblocks*nstates, 0),
+          block_ww(nblocks*nstates*nstates, 0)
+    {}
+
+    QVector<double> block_logd;
+    QVector<double> block_w;
+    QVector<double> block_ww;
+};
+
+} // end of namespace detail
+} // end of namespace SireAnalysis
+
+/////////
+///////// Implementation of MBARSpool and MBARChunk
+/////////
+
+/** Open a new spool file in the temporary directory
+
+    \throw SireError::file_error
+*/
+MBARSpool::MBARSpool() 
+          : boost::noncopyable(),
+            f( QDir(QDir::tempPath()).filePath("sire_mbar_XXXXXX.spool") )
+{
+    if (not f.open())
+        throw SireError::file_error( QObject::tr(
+                "Could not open a temporary file in \"%1\" to hold the MBAR samples.")
+                    .arg(QDir::tempPath()), CODELOC );
+}
+
+/** Destructor - this unmaps and deletes the file */
+MBARSpool::~MBARSpool()
+{}
+
+/** Append the passed values to the end of the file, returning
+    a pointer to the memory-mapped copy of the values
+
+    \throw SireError::file_error
+*/
+const float* MBARSpool::append(const QVector<float> &values)
+{
+    QMutexLocker lkr(&mutex);
+    
+    const qint64 offset = f.size();
+    const qint64 nbytes = values.count() * sizeof(float);
+    
+    if (not f.seek(offset) or
+        f.write(reinterpret_cast<const char*>(values.constData()), nbytes) != nbytes or
+        not f.flush())
+    {
+        throw SireError::file_error( QObject::tr(
+                "Could not write the MBAR samples to the temporary file \"%1\": %2")
+                    .arg(f.fileName()).arg(f.errorString()), CODELOC );
+    }
+    
+    uchar *data = f.map(offset, nbytes);
+    
+    if (data == 0)
+        throw SireError::file_error( QObject::tr(
+                "Could not memory-map the MBAR samples in the temporary file \"%1\": %2")
+                    .arg(f.fileName()).arg(f.errorString()), CODELOC );
+    
+    return reinterpret_cast<const float*>(data);
+}
+
+/** Construct a chunk that holds 'values' in memory */
+MBARChunk::MBARChunk(const QVector<float> &values)
+          : boost::noncopyable(), vals(values), data(0), nvals(values.count())
+{
+    data = vals.constData();
+}
+
+/** Construct a chunk that holds 'values' in the spool file 'spool' */
+MBARChunk::MBARChunk(const QVector<float> &values,
+                     const boost::shared_ptr<MBARSpool> &s)
+          : boost::noncopyable(), spool(s), data(0), nvals(values.count())
+{
+    data = spool->append(values);
+}
+
+/** Destructor */
+MBARChunk::~MBARChunk()
+{}
+
+/////////
+///////// Implementation of MBAR
+/////////
+
+static const RegisterMetaType<MBAR> r_mbar;
+
+QDataStream SIREANALYSIS_EXPORT &operator<<(QDataStream &ds, const MBAR &mbar)
+{
+    writeHeader(ds, r_mbar, 1);
+    
+    SharedDataStream sds(ds);
+    
+    sds << mbar.lamvals << mbar.temp.to(kelvin) << mbar.nsampled
+        << mbar.tol << mbar.max_iterations << mbar.max_memory;
+    
+    //write the reduced energies as raw 32 bit values, as there 
+    //could be a lot of them
+    qint64 nvals = mbar.current.count();
+    
+    foreach (const boost::shared_ptr<const MBARChunk> &chunk, mbar.chunks)
+    {
+        nvals += chunk->count();
+    }
+    
+    sds << nvals;
+    
+    foreach (const boost::shared_ptr<const MBARChunk> &chunk, mbar.chunks)
+    {
+        const float *data = chunk->constData();
+    
+        for (int i=0; i<chunk->count(); ++i)
+        {
+            quint32 val;
+            std::memcpy(&val, data + i, sizeof(float));
+            ds << val;
+        }
+    }
+    
+    for (int i=0; i<mbar.current.count(); ++i)
+    {
+        quint32 val;
+        std::memcpy(&val, mbar.current.constData() + i, sizeof(float));
+        ds << val;
+    }
+    
+    return ds;
+}
+
+QDataStream SIREANALYSIS_EXPORT &operator>>(QDataStream &ds, MBAR &mbar)
+{
+    VersionID v = readHeader(ds, r_mbar);
+    
+    if (v == 1)
+    {
+        SharedDataStream sds(ds);
+        
+        MBAR m;
+        
+        double t;
+        qint64 nvals;
+        
+        sds >> m.lamvals >> t >> m.nsampled 
+            >> m.tol >> m.max_iterations >> m.max_memory >> nvals;
+        
+        m.temp = t * kelvin;
+        
+        const int nstates = m.lamvals.count();
+        
+        for (qint64 i=0; i<nvals; ++i)
+        {
+            quint32 val;
+            ds >> val;
+            
+            float fval;
+            std::memcpy(&fval, &val, sizeof(float));
+            
+            m.current.append(fval);
+            
+            if (m.current.count() == MBAR_CHUNK_SIZE * nstates)
+                m.addChunk();
+        }
+        
+        mbar = m;
+    }
+    else
+        throw version_error(v, "1", r_mbar, CODELOC);
+    
+    return ds;
+}
+
+/** Constructor */
+MBAR::MBAR() 
+     : ConcreteProperty<MBAR,Property>(),
+       temp(25*celsius), tol(1e-7), max_iterations(1000), 
+       max_memory(qint64(512) * 1024 * 1024)
+{}
+
+/** Construct to analyse samples collected at room temperature (25 C) 
+    whose energies have been evaluated at all of the passed lambda values */
+MBAR::MBAR(const QList<double> &lambda_values)
+     : ConcreteProperty<MBAR,Property>(),
+       lamvals(lambda_values), temp(25*celsius), tol(1e-7), max_iterations(1000),
+       max_memory(qint64(512) * 1024 * 1024)
+{
+    qSort(lamvals);
+    nsampled = QVector<qint64>(lamvals.count(), 0);
+    assertSane();
+}
+
+/** Construct to analyse samples collected at the passed temperature, 
+    whose energies have been evaluated at all of the passed lambda values */
+MBAR::MBAR(const QList<double> &lambda_values, const Temperature &temperature)
+     : ConcreteProperty<MBAR,Property>(),
+       lamvals(lambda_values), temp(temperature), tol(1e-7), max_iterations(1000),
+       max_memory(qint64(512) * 1024 * 1024)
+{
+    qSort(lamvals);
+    nsampled = QVector<qint64>(lamvals.count(), 0);
+    assertSane();
+}
+
+/** Copy constructor - this shares the completed chunks of samples */
+MBAR::MBAR(const MBAR &other)
+     : ConcreteProperty<MBAR,Property>(other),
+       lamvals(other.lamvals), temp(other.temp), nsampled(other.nsampled),
+       chunks(other.chunks), current(other.current), spool(other.spool),
+       tol(other.tol), max_iterations(other.max_iterations),
+       max_memory(other.max_memory)
+{}
+
+/** Destructor */
+MBAR::~MBAR()
+{}
+
+/** Copy assignment operator */
+MBAR& MBAR::operator=(const MBAR &other)
+{
+    if (this != &other)
+    {
+        lamvals = other.lamvals;
+        temp = other.temp;
+        nsampled = other.nsampled;
+        chunks = other.chunks;
+        current = other.current;
+        spool = other.spool;
+        tol = other.tol;
+        max_iterations = other.max_iterations;
+        max_memory = other.max_memory;
+    }
+    
+    return *this;
+}
+
+/** Return all of the samples as a list of blocks */
+static QList<MBARBlock> getBlocks(const QList< boost::shared_ptr<const MBARChunk> > &chunks,
+                                  const QVector<float> &current, int nstates)
+{
+    QList<MBARBlock> blocks;
+    
+    if (nstates == 0)
+        return blocks;
+    
+    foreach (const boost::shared_ptr<const MBARChunk> &chunk, chunks)
+    {
+        blocks.append( MBARBlock(chunk->constData(), chunk->count() / nstates) );
+    }
+    
+    if (not current.isEmpty())
+        blocks.append( MBARBlock(current.constData(), current.count() / nstates) );
+    
+    return blocks;
+}
+
+/** Comparison operator */
+bool MBAR::operator==(const MBAR &other) const
+{
+    if (this == &other)
+        return true;
+
+    if (lamvals != other.lamvals or temp != other.temp or nsampled != other.nsampled or
+        tol != other.tol or max_iterations != other.max_iterations or
+        max_memory != other.max_memory)
+    {
+        return false;
+    }
+    
+    if (chunks == other.chunks and current == other.current)
+        return true;
+    
+    //the samples may be chunked differently, so compare them
+    //sample by sample
+    const int nstates = lamvals.count();
+    
+    QList<MBARBlock> blocks = getBlocks(chunks, current, nstates);
+    QList<MBARBlock> other_blocks = getBlocks(other.chunks, other.current, nstates);
+    
+    int b = 0;
+    int n = 0;
+    
+    foreach (const MBARBlock &other_block, other_blocks)
+    {
+        for (int i=0; i<other_block.nsamples; ++i)
+        {
+            while (b < blocks.count() and n == blocks.at(b).nsamples)
+            {
+                ++b;
+                n = 0;
+            }
+            
+            if (b == blocks.count())
+                return false;
+            
+            if (std::memcmp(blocks.at(b).data + n*nstates, 
+                            other_block.data + i*nstates,
+                            nstates * sizeof(float)) != 0)
+            {
+                return false;
+            }
+            
+            ++n;
+        }
+    }
+    
+    return true;
+}
+
+/** Comparison operator */
+bool MBAR::operator!=(const MBAR &other) const
+{
+    return not operator==(other);
+}
+
+const char* MBAR::what() const
+{
+    return MBAR::typeName();
+}
+
+const char* MBAR::typeName()
+{
+    return QMetaType::typeName( qMetaTypeId<MBAR>() );
+}
+
+QString MBAR::toString() const
+{
+    return QObject::tr("MBAR( nLambdaValues() == %1, nSamples() == %2, temperature() == %3 )")
+                .arg(nLambdaValues()).arg(nSamples()).arg(temperature().toString());
+}
+
+/** Check that there are no duplicate lambda values */
+void MBAR::assertSane() const
+{
+    for (int i=0; i<lamvals.count()-1; ++i)
+    {
+        if (lamvals[i] == lamvals[i+1])
+            throw SireError::invalid_arg( QObject::tr(
+                    "You cannot have duplicate lambda values in MBAR. %1")
+                        .arg(Sire::toString(lamvals)), CODELOC );
+    }
+    
+    if (temp.value() <= 0)
+        throw SireError::invalid_arg( QObject::tr(
+                "The temperature used for MBAR must be positive (%1).")
+                    .arg(temp.toString()), CODELOC );
+}
+
+/** Return whether or not there are no samples */
+bool MBAR::isEmpty() const
+{
+    return nSamples() == 0;
+}
+
+/** Move the current samples into a completed chunk, spooling the chunk
+    to disk if the completed chunks in memory would exceed the maximum
+    amount of memory */
+void MBAR::addChunk()
+{
+    if (current.isEmpty())
+        return;
+
+    qint64 nbytes = current.count() * sizeof(float);
+    
+    foreach (const boost::shared_ptr<const MBARChunk> &chunk, chunks)
+    {
+        if (not chunk->isSpooled())
+            nbytes += chunk->count() * sizeof(float);
+    }
+    
+    if (nbytes > max_memory)
+    {
+        if (spool.get() == 0)
+            spool.reset( new MBARSpool() );
+    
+        chunks.append( boost::shared_ptr<const MBARChunk>(new MBARChunk(current, spool)) );
+    }
+    else
+    {
+        chunks.append( boost::shared_ptr<const MBARChunk>(new MBARChunk(current)) );
+    }
+    
+    current = QVector<float>();
+}
+
+/** Add a sample that was collected at lambda value 'lambda', with 'energies'
+    containing the energy of the sample evaluated at each of the lambda values 
+    (in the same order as lambdaValues()). The energies must be in internal
+    units (kcal mol-1). Energies at lambda values other than 'lambda' may be 
+    infinite (e.g. because of an overlap of atoms)
+    
+    \throw SireError::invalid_arg
+*/
+void MBAR::add(double lambda, const QVector<double> &energies)
+{
+    const int nstates = lamvals.count();
+    
+    const int idx = lamvals.indexOf(lambda);
+    
+    if (idx == -1)
+        throw SireError::invalid_arg( QObject::tr(
+                "Cannot add a sample collected at lambda %1 as this is not one "
+                "of the lambda values of this MBAR (%2).")
+                    .arg(lambda).arg(Sire::toString(lamvals)), CODELOC );
+    
+    if (energies.count() != nstates)
+        throw SireError::invalid_arg( QObject::tr(
+                "Cannot add a sample as the number of energies (%1) is not equal "
+                "to the number of lambda values of this MBAR (%2).")
+                    .arg(energies.count()).arg(nstates), CODELOC );
+    
+    const double ref = energies.constData()[idx];
+    
+    if (not std::isfinite(ref))
+        throw SireError::invalid_arg( QObject::tr(
+                "Cannot add a sample whose energy at the lambda value at which "
+                "it was sampled (%1) is not finite (%2).")
+                    .arg(lambda).arg(ref), CODELOC );
+    
+    //the samples are held as reduced energies relative to the energy at the 
+    //sampled lambda value, as this doesn't change the MBAR equations, and
+    //means that the values can be held accurately in single precision
+    const double beta = 1.0 / (k_boltz * temp.to(kelvin));
+    
+    if (current.isEmpty())
+        current.reserve(MBAR_CHUNK_SIZE * nstates);
+    
+    const double *e = energies.constData();
+    
+    for (int i=0; i<nstates; ++i)
+    {
+        current.append( float(beta * (e[i] - ref)) );
+    }
+    
+    nsampled[idx] += 1;
+    
+    if (current.count() >= MBAR_CHUNK_SIZE * nstates)
+        this->addChunk();
+}
+
+/** Add all of the samples from 'other' to this MBAR. The two must 
+    use the same lambda values and temperature. The completed chunks
+    of samples of 'other' are shared, not copied
+    
+    \throw SireError::incompatible_error
+*/
+void MBAR::add(const MBAR &other)
+{
+    if (other.isEmpty())
+        return;
+    
+    else if (lamvals.isEmpty())
+    {
+        this->operator=(other);
+        return;
+    }
+    
+    if (lamvals != other.lamvals)
+        throw SireError::incompatible_error( QObject::tr(
+                "Cannot add together these two MBARs as the lambda values are different. "
+                "%1 vs. %2.")
+                    .arg(Sire::toString(lamvals)).arg(Sire::toString(other.lamvals)),
+                        CODELOC );
+    
+    if (temp != other.temp)
+        throw SireError::incompatible_error( QObject::tr(
+                "Cannot add together these two MBARs as the temperature at which they "
+                "were collected are different. %1 vs. %2")
+                    .arg(temp.toString()).arg(other.temp.toString()), CODELOC );
+    
+    //complete the current chunk, so that the chunks from 'other' follow it
+    this->addChunk();
+    
+    chunks += other.chunks;
+    current = other.current;
+    
+    for (int i=0; i<nsampled.count(); ++i)
+    {
+        nsampled[i] += other.nsampled[i];
+    }
+    
+    if (current.count() >= MBAR_CHUNK_SIZE * lamvals.count())
+        this->addChunk();
+}
+
+/** Return the temperature at which the samples were collected */
+Temperature MBAR::temperature() const
+{
+    return temp;
+}
+
+/** Return the lambda values */
+QList<double> MBAR::lambdaValues() const
+{
+    return lamvals;
+}
+
+/** Return the number of lambda values */
+int MBAR::nLambdaValues() const
+{
+    return lamvals.count();
+}
+
+/** Return the total number of samples */
+qint64 MBAR::nSamples() const
+{
+    qint64 n = 0;
+    
+    foreach (qint64 nsamples, nsampled)
+    {
+        n += nsamples;
+    }
+    
+    return n;
+}
+
+/** Return the number of samples collected at lambda value 'lambda' */
+qint64 MBAR::nSamples(double lambda) const
+{
+    const int idx = lamvals.indexOf(lambda);
+    
+    if (idx == -1)
+        return 0;
+    else
+        return nsampled.at(idx);
+}
+
+/** Set the convergence tolerance of the solver. The MBAR equations
+    are converged once the largest change in any reduced free energy
+    in an iteration is less than this value */
+void MBAR::setTolerance(double tolerance)
+{
+    if (tolerance > 0)
+        tol = tolerance;
+}
+
+/** Return the convergence tolerance of the solver */
+double MBAR::tolerance() const
+{
+    return tol;
+}
+
+/** Set the maximum number of iterations of the solver */
+void MBAR::setMaximumIterations(int niterations)
+{
+    if (niterations > 0)
+        max_iterations = niterations;
+}
+
+/** Return the maximum number of iterations of the solver */
+int MBAR::maximumIterations() const
+{
+    return max_iterations;
+}
+
+/** Set the maximum amount of memory (in bytes) used to hold the 
+    samples. Samples added once this limit has been reached are
+    written to a temporary spool file. Setting this to zero 
+    spools all of the samples to disk */
+void MBAR::setMaximumMemory(qint64 nbytes)
+{
+    max_memory = qMax(qint64(0), nbytes);
+}
+
+/** Return the maximum amount of memory (in bytes) used to hold the samples */
+qint64 MBAR::maximumMemory() const
+{
+    return max_memory;
+}
+
+/** Remove all of the samples */
+void MBAR::clear()
+{
+    nsampled = QVector<qint64>(lamvals.count(), 0);
+    chunks.clear();
+    current = QVector<float>();
+    spool.reset();
+}
+
+/** Perform a pass over the samples using the reduced free energies 'f',
+    using 'buffers' to hold the sums of each block of samples.
+    This returns the MBAR objective function, and fills 'w' with the
+    sum over the samples of the weight of each state, and (if it is not
+    null) 'ww' with the sum of the product of the weights of each
+    pair of states */
+static double mbarPass(const QVector<MBARBlock> &blocks, int nstates,
+                       const QVector<double> &f, const QVector<double> &logn,
+                       const QVector<qint64> &nsampled,
+                       MBARPassBuffers &buffers,
+                       QVector<double> &w, NMatrix *ww)
+{
+    const int nblocks = blocks.count();
+    const int K = nstates;
+
+    const QVector<double> &block_logd = buffers.block_logd;
+    const QVector<double> &block_w = buffers.block_w;
+    const QVector<double> &block_ww = buffers.block_ww;
+    
+    tbb::parallel_for( tbb::blocked_range<int>(0,nblocks),
+                       MBARPass(blocks.constData(), K, f.constData(), logn.constData(),
+                                buffers.block_logd.data(), buffers.block_w.data(),
+                                ww ? buffers.block_ww.data() : 0) );
+    
+    //sum the results of the blocks in order, so that the result
+    //doesn't depend on the number of threads
+    double obj = 0;
+    
+    w = QVector<double>(K, 0);
+    
+    if (ww)
+        *ww = NMatrix(K, K, 0);
+    
+    for (int b=0; b<nblocks; ++b)
+    {
+        obj += block_logd[b];
+        
+        const double *bw = block_w.constData() + b*K;
+        
+        for (int i=0; i<K; ++i)
+        {
+            w[i] += bw[i];
+        }
+        
+        if (ww)
+        {
+            const double *bww = block_ww.constData() + b*K*K;
+        
+            for (int i=0; i<K; ++i)
+            {
+                for (int j=i; j<K; ++j)
+                {
+                    (*ww)(i,j) += bww[i*K+j];
+                }
+            }
+        }
+    }
+    
+    if (ww)
+    {
+        for (int i=0; i<K; ++i)
+        {
+            for (int j=0; j<i; ++j)
+            {
+                (*ww)(i,j) = (*ww)(j,i);
+            }
+        }
+    }
+    
+    for (int k=0; k<K; ++k)
+    {
+        obj -= nsampled[k] * f[k];
+    }
+    
+    return obj;
+}
+
+/** Solve the MBAR equations, returning the reduced free energies of all 
+    of the lambda values (relative to the first) in 'free_energies'. If 
+    'errors' is not null then this is filled with the asymptotic 
+    uncertainties of the reduced free energies relative to the first lambda 
+    value, and if 'overlap' is not null then this is filled with 
+    the overlap matrix
+    
+    \throw SireError::invalid_state
+    \throw SireMaths::math_error
+*/
+void MBAR::solve(QVector<double> &free_energies, 
+                 QVector<double> *errors, NMatrix *overlap) const
+{
+    const int K = lamvals.count();
+
+    if (this->isEmpty())
+        throw SireError::invalid_state( QObject::tr(
+                "Cannot solve the MBAR equations as there are no samples."), CODELOC );
+
+    QVector<MBARBlock> blocks = getBlocks(chunks, current, K).toVector();
+
+    MBARPassBuffers buffers(blocks.count(), K);
+
+    QVector<double> logn(K);
+    QVector<int> sampled;
+    
+    for (int k=0; k<K; ++k)
+    {
+        if (nsampled[k] > 0)
+        {
+            logn[k] = std::log( double(nsampled[k]) );
+            sampled.append(k);
+        }
+        else
+            logn[k] = -std::numeric_limits<double>::infinity();
+    }
+    
+    //the free energy of the first sampled state is fixed at zero, and
+    //the free energies of the other sampled states are found by minimising 
+    //the convex MBAR objective function
+    //
+    //  F(f) = sum_n ln sum_k N_k exp(f_k - u_kn)  -  sum_k N_k f_k
+    //
+    //using Newton's method with a backtracking line search. The gradient
+    //is g_i = N_i (W_i - 1) and the hessian is 
+    //H_ij = N_i W_i delta_ij - N_i N_j WW_ij, where W_i is the sum over the
+    //samples of the weights of state i, and WW_ij is the sum of the products
+    //of the weights of states i and j
+    const int nfree = sampled.count() - 1;
+    
+    QVector<double> f(K, 0);
+    QVector<double> w;
+    NMatrix ww;
+    
+    double obj = mbarPass(blocks, K, f, logn, nsampled, buffers, w, &ww);
+    
+    bool converged = (nfree == 0);
+    
+    for (int iter=0; iter<max_iterations and not converged; ++iter)
+    {
+        NVector g(nfree);
+        NMatrix h(nfree, nfree);
+        
+        for (int a=0; a<nfree; ++a)
+        {
+            const int i = sampled[a+1];
+            const double ni = nsampled[i];
+        
+            g[a] = ni * (w[i] - 1);
+            
+            for (int b=0; b<nfree; ++b)
+            {
+                const int j = sampled[b+1];
+            
+                h(a,b) = -ni * nsampled[j] * ww(i,j);
+            }
+            
+            h(a,a) += ni * w[i];
+        }
+        
+        QVector<double> new_f;
+        QVector<double> new_w;
+        NMatrix new_ww;
+        double new_obj = 0;
+        bool accepted = false;
+        
+        try
+        {
+            NVector step = h.inverse() * (-g);
+            
+            double gstep = 0;
+            
+            for (int a=0; a<nfree; ++a)
+            {
+                gstep += g[a] * step[a];
+            }
+            
+            //only use the Newton step if it is a descent direction
+            double alpha = 1;
+            
+            for (int i=0; i<30 and gstep < 0; ++i)
+            {
+                new_f = f;
+                
+                for (int a=0; a<nfree; ++a)
+                {
+                    new_f[ sampled[a+1] ] += alpha * step[a];
+                }
+                
+                new_obj = mbarPass(blocks, K, new_f, logn, nsampled, buffers, new_w, &new_ww);
+                
+                if (new_obj <= obj + 1e-4 * alpha * gstep)
+                {
+                    accepted = true;
+                    break;
+                }
+                
+                alpha *= 0.5;
+            }
+        }
+        catch(const SireMaths::domain_error&)
+        {
+            //the hessian is singular
+            accepted = false;
+        }
+        
+        if (not accepted)
+        {
+            //fall back to a self-consistent iteration, f_i = f_i - ln W_i
+            new_f = f;
+            
+            foreach (int i, sampled)
+            {
+                new_f[i] = f[i] - std::log(w[i]);
+            }
+            
+            const double f0 = new_f[sampled[0]];
+            
+            for (int k=0; k<K; ++k)
+            {
+                new_f[k] -= f0;
+            }
+            
+            new_obj = mbarPass(blocks, K, new_f, logn, nsampled, buffers, new_w, &new_ww);
+        }
+        
+        double max_delta = 0;
+        
+        for (int k=0; k<K; ++k)
+        {
+            max_delta = qMax(max_delta, std::abs(new_f[k] - f[k]));
+        }
+        
+        f = new_f;
+        w = new_w;
+        ww = new_ww;
+        obj = new_obj;
+        
+        converged = (max_delta < tol);
+    }
+    
+    if (not converged)
+        throw SireMaths::math_error( QObject::tr(
+                "The MBAR equations did not converge to within a tolerance of %1 "
+                "within %2 iterations. Increase the maximum number of iterations "
+                "(setMaximumIterations) or the tolerance (setTolerance), or "
+                "collect more samples to improve the overlap between the lambda values.")
+                    .arg(tol).arg(max_iterations), CODELOC );
+    
+    //now calculate the free energies of all of the states, including
+    //those that were not sampled, f_i = -ln sum_n exp(-u_in) / D_n
+    for (int k=0; k<K; ++k)
+    {
+        f[k] -= std::log(w[k]);
+    }
+    
+    const double f0 = f[0];
+    
+    for (int k=0; k<K; ++k)
+    {
+        f[k] -= f0;
+    }
+    
+    free_energies = f;
+    
+    if (errors == 0 and overlap == 0)
+        return;
+    
+    //recalculate the weights using the free energies of all of the states
+    mbarPass(blocks, K, f, logn, nsampled, buffers, w, &ww);
+    
+    if (overlap)
+    {
+        //O_ij = sum_n W_ni W_nj N_j
+        *overlap = NMatrix(K, K, 0);
+        
+        for (int i=0; i<K; ++i)
+        {
+            for (int j=0; j<K; ++j)
+            {
+                (*overlap)(i,j) = ww(i,j) * nsampled[j];
+            }
+        }
+    }
+    
+    if (errors)
+    {
+        //the asymptotic covariance is Theta = W^T (I - W N W^T)^+ W (eqn. 8 of
+        //Shirts and Chodera). This is evaluated in the space of the states by
+        //diagonalising W^T W = V S^2 V^T, so that
+        //Theta = V S (I - S V^T N V S)^+ S V^T
+        std::pair<NVector,NMatrix> eig = ww.diagonalise();
+        
+        const NVector &lam = eig.first;
+        const NMatrix &v = eig.second;
+        
+        double max_lam = 0;
+        
+        for (int i=0; i<K; ++i)
+        {
+            max_lam = qMax(max_lam, lam[i]);
+        }
+        
+        QVector<double> s(K, 0);
+        
+        for (int i=0; i<K; ++i)
+        {
+            if (lam[i] > 1e-12 * max_lam)
+                s[i] = std::sqrt(lam[i]);
+        }
+        
+        NMatrix b(K, K, 0);
+        
+        for (int i=0; i<K; ++i)
+        {
+            for (int j=0; j<K; ++j)
+            {
+                double vnv = 0;
+                
+                for (int k=0; k<K; ++k)
+                {
+                    vnv += v(k,i) * nsampled[k] * v(k,j);
+                }
+                
+                b(i,j) = -s[i] * vnv * s[j];
+            }
+            
+            b(i,i) += 1;
+        }
+        
+        //pseudo-inverse of the symmetric matrix b
+        std::pair<NVector,NMatrix> beig = b.diagonalise();
+        
+        const NVector &blam = beig.first;
+        const NMatrix &bv = beig.second;
+        
+        double max_blam = 0;
+        
+        for (int i=0; i<K; ++i)
+        {
+            max_blam = qMax(max_blam, std::abs(blam[i]));
+        }
+        
+        NMatrix binv(K, K, 0);
+        
+        for (int c=0; c<K; ++c)
+        {
+            if (std::abs(blam[c]) > 1e-10 * max_blam)
+            {
+                for (int i=0; i<K; ++i)
+                {
+                    for (int j=0; j<K; ++j)
+                    {
+                        binv(i,j) += bv(i,c) * bv(j,c) / blam[c];
+                    }
+                }
+            }
+        }
+        
+        //vs = V S
+        NMatrix vs(K, K, 0);
+        
+        for (int i=0; i<K; ++i)
+        {
+            for (int j=0; j<K; ++j)
+            {
+                vs(i,j) = v(i,j) * s[j];
+            }
+        }
+        
+        NMatrix theta = vs * binv * vs.transpose();
+        
+        *errors = QVector<double>(K, 0);
+        
+        for (int k=0; k<K; ++k)
+        {
+            const double var = theta(k,k) + theta(0,0) - 2*theta(k,0);
+            (*errors)[k] = std::sqrt( qMax(0.0, var) );
+        }
+    }
+}
+
+/** Solve the MBAR equations and return the free energy of each lambda value
+    relative to the first lambda value (in kcal mol-1), together with the
+    estimated (one standard deviation) error
+    
+    \throw SireError::invalid_state
+    \throw SireMaths::math_error
+*/
+PMF MBAR::pmf() const
+{
+    QVector<double> f;
+    QVector<double> errors;
+    
+    this->solve(f, &errors, 0);
+    
+    const double kt = k_boltz * temp.to(kelvin);
+    
+    QVector<DataPoint> points;
+    
+    for (int i=0; i<lamvals.count(); ++i)
+    {
+        points.append( DataPoint(lamvals[i], kt*f[i], 0, kt*errors[i]) );
+    }
+    
+    return PMF(points);
+}
+
+/** Solve the MBAR equations and return the overlap matrix. Element (i,j)
+    is the average probability that a sample from lambda value i could
+    have come from lambda value j. Small off-diagonal elements between
+    neighbouring lambda values show that more lambda values are needed
+    
+    \throw SireError::invalid_state
+    \throw SireMaths::math_error
+*/
+NMatrix MBAR::overlapMatrix() const
+{
+    QVector<double> f;
+    NMatrix overlap;
+    
+    this->solve(f, 0, &overlap);
+    
+    return overlap;
+}
@@ -0,0 +1,188 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#ifndef SIREANALYSIS_MBAR_H
+#define SIREANALYSIS_MBAR_H
+
+#include "fep.h"
+
+#include "SireMaths/nmatrix.h"
+
+#include <boost/shared_ptr.hpp>
+
+SIRE_BEGIN_HEADER
+
+namespace SireAnalysis
+{
+class MBAR;
+}
+
+QDataStream& operator<<(QDataStream&, const SireAnalysis::MBAR&);
+QDataStream& operator>>(QDataStream&, SireAnalysis::MBAR&);
+
+namespace SireAnalysis
+{
+
+namespace detail
+{
+class MBARChunk;
+class MBARSpool;
+}
+
+using SireMaths::NMatrix;
+
+/** This class implements the multistate Bennetts acceptance ratio (MBAR)
+    estimator, which uses the energies of every sample evaluated at
+    every lambda value to calculate the free energies of all of the
+    lambda values (including lambda values that were not sampled).
+    
+    Each sample is added with the lambda value at which it was sampled,
+    together with its energies at all of the lambda values. The samples
+    are held as single precision reduced energies relative to the sampled
+    lambda value, in chunks of a fixed number of samples. Once the chunks
+    held in memory exceed maximumMemory(), new chunks are written to a 
+    temporary spool file and are memory-mapped back in, so that very large 
+    numbers of samples can be analysed without holding them all in memory. 
+    Copies of an MBAR share the completed chunks.
+    
+    The MBAR equations are solved using Newton's method (with a
+    backtracking line search) on the convex MBAR objective function,
+    with each iteration being a single, multithreaded pass over the
+    samples. The uncertainties are the asymptotic uncertainties
+    of Shirts and Chodera, J. Chem. Phys., 129, 124105, 2008.
+    A SireMaths::math_error is raised if the equations do not
+    converge within maximumIterations() iterations.
+    
+    Each call to pmf() or overlapMatrix() solves the MBAR equations,
+    so the result should be kept if it is needed more than once.
+    
+    @author Christopher Woods
+*/
+class SIREANALYSIS_EXPORT MBAR : public SireBase::ConcreteProperty<MBAR,SireBase::Property>
+{
+
+friend QDataStream& ::operator<<(QDataStream&, const MBAR&);
+friend QDataStream& ::operator>>(QDataStream&, MBAR&);
+
+public:
+    MBAR();
+    MBAR(const QList<double> &lambda_values);
+    MBAR(const QList<double> &lambda_values,
+         const SireUnits::Dimension::Temperature &temperature);
+    
+    MBAR(const MBAR &other);
+    
+    ~MBAR();
+    
+    MBAR& operator=(const MBAR &other);
+    
+    bool operator==(const MBAR &other) const;
+    bool operator!=(const MBAR &other) const;
+    
+    const char* what() const;
+    static const char* typeName();
+    
+    QString toString() const;
+    
+    bool isEmpty() const;
+    
+    void add(double lambda, const QVector<double> &energies);
+    void add(const MBAR &other);
+    
+    SireUnits::Dimension::Temperature temperature() const;
+    
+    QList<double> lambdaValues() const;
+    int nLambdaValues() const;
+    
+    qint64 nSamples() const;
+    qint64 nSamples(double lambda) const;
+    
+    void setTolerance(double tolerance);
+    double tolerance() const;
+    
+    void setMaximumIterations(int niterations);
+    int maximumIterations() const;
+    
+    void setMaximumMemory(qint64 nbytes);
+    qint64 maximumMemory() const;
+    
+    PMF pmf() const;
+    
+    NMatrix overlapMatrix() const;
+    
+    void clear();
+    
+private:
+    void assertSane() const;
+
+    void addChunk();
+
+    void solve(QVector<double> &free_energies, 
+               QVector<double> *errors, NMatrix *overlap) const;
+
+    /** The lambda values */
+    QList<double> lamvals;
+    
+    /** The temperature at which the samples were collected */
+    SireUnits::Dimension::Temperature temp;
+    
+    /** The number of samples collected at each lambda value */
+    QVector<qint64> nsampled;
+    
+    /** The completed (read-only) chunks of samples. These are 
+        shared between copies of this object */
+    QList< boost::shared_ptr<const detail::MBARChunk> > chunks;
+    
+    /** The reduced energies of the samples in the current, 
+        incomplete chunk */
+    QVector<float> current;
+    
+    /** The spool file to which chunks are written once the 
+        memory limit is reached */
+    boost::shared_ptr<detail::MBARSpool> spool;
+    
+    /** The convergence tolerance on the reduced free energies */
+    double tol;
+    
+    /** The maximum number of iterations of the solver */
+    qint32 max_iterations;
+    
+    /** The maximum amount of memory (in bytes) used to hold
+        the completed chunks before they are spooled to disk */
+    qint64 max_memory;
+};
+
+}
+
+Q_DECLARE_METATYPE( SireAnalysis::MBAR )
+
+SIRE_EXPOSE_CLASS( SireAnalysis::MBAR )
+
+SIRE_END_HEADER
+
+#endif
@@ -67,15 +67,15 @@ QDataStream SIREBASE_EXPORT &operator>>(QDataStream &ds, CPUID &cpuid)
     return ds;
 }
 
-#ifdef SIRE_FOUND_CPUID
-    static QString trueFalse(bool val)
-    {
-        if (val)
-            return "true";
-        else
-            return "false";
-    }
+static QString trueFalse(bool val)
+{
+    if (val)
+        return "true";
+    else
+        return "false";
+}
 
+#ifdef SIRE_FOUND_CPUID
     /** Return the list of all searchable supportable features */
     QStringList CPUID::supportableFeatures() const
     {
@@ -141,7 +141,22 @@ QDataStream SIREBASE_EXPORT &operator>>(QDataStream &ds, CPUID &cpuid)
 #else
     static QHash<QString,QString> getCPUInfo()
     {
-        return QHash<QString,QString>();
+        QHash<QString,QString> data;
+
+        #if (defined(__GNUC__) or defined(__clang__)) and \
+            (defined(__x86_64__) or defined(__i386__))
+            //without libcpuid we can still ask the compiler runtime which
+            //vector instruction sets are available, which is all that is
+            //needed to choose between the vectorised kernels
+            __builtin_cpu_init();
+            data.insert("sse2", trueFalse(__builtin_cpu_supports("sse2")));
+            data.insert("avx", trueFalse(__builtin_cpu_supports("avx")));
+            data.insert("avx2", trueFalse(__builtin_cpu_supports("avx2")));
+            data.insert("fma3", trueFalse(__builtin_cpu_supports("fma")));
+            data.insert("avx512f", trueFalse(__builtin_cpu_supports("avx512f")));
+        #endif
+
+        return data;
     }
 
     /** Return the list of all searchable supportable features */
@@ -281,3 +296,54 @@ bool CPUID::supportsAVX() const
 {
     return supports("avx");
 }
+
+/** Return whether or not this processor supports AVX2 vector instructions */
+bool CPUID::supportsAVX2() const
+{
+    return supports("avx2");
+}
+
+/** Return whether or not this processor supports the AVX-512 foundation
+    vector instructions */
+bool CPUID::supportsAVX512F() const
+{
+    return supports("avx512f");
+}
+
+/** Return the name of the vector instruction set that this copy
+    of Sire was compiled to use. If the vectorised kernels are chosen
+    at run time (SIRE_VECTOR_DISPATCH) then this is the baseline instruction
+    set, and faster kernels are used if the processor supports them */
+QString CPUID::compiledVectorisation() const
+{
+    #ifdef SIRE_USE_AVX512
+        return "avx512f";
+    #else
+    #ifdef SIRE_USE_AVX2
+        return "avx2";
+    #else
+    #ifdef SIRE_USE_AVX
+        return "avx";
+    #else
+    #if defined(SIRE_USE_SSE) or defined(SIRE_VECTOR_DISPATCH)
+        return "sse2";
+    #else
+        return QString();
+    #endif
+    #endif
+    #endif
+    #endif
+}
+
+/** Return whether or not this processor supports the vector instructions
+    that this copy of Sire was compiled to use. This returns true if
+    the capabilities of the processor could not be determined */
+bool CPUID::supportsCompiledVectorisation() const
+{
+    const QString vectorisation = compiledVectorisation();
+
+    if (vectorisation.isEmpty() or props.isEmpty())
+        return true;
+    else
+        return supports(vectorisation);
+}
@@ -89,6 +89,11 @@ public:
     
     bool supportsSSE2() const;
     bool supportsAVX() const;
+    bool supportsAVX2() const;
+    bool supportsAVX512F() const;
+
+    QString compiledVectorisation() const;
+    bool supportsCompiledVectorisation() const;
     
 private:
     QHash<QString,QString>* getCPUID();
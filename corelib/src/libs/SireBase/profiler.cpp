@@ -0,0 +1,705 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#include "profiler.h"
+
+#include "SireError/errors.h"
+
+#include <QAtomicInteger>
+#include <QHash>
+#include <QMap>
+#include <QPair>
+#include <QVector>
+#include <QList>
+#include <QMutex>
+#include <QThreadStorage>
+#include <QElapsedTimer>
+#include <QCoreApplication>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QFile>
+
+#include <boost/shared_ptr.hpp>
+
+#include <cstdlib>
+#include <limits>
+
+using namespace SireBase;
+
+/** The maximum number of trace events recorded for each thread */
+static const int max_events_per_thread = 1 << 20;
+
+namespace SireBase
+{
+namespace detail
+{
+
+/** The statistics of a single timer (a name under a particular parent
+    timer) or counter. These are shared by all threads and are updated
+    atomically. Slots are never deleted, so pointers to them remain
+    valid for the lifetime of the program */
+class ProfileSlot
+{
+public:
+    ProfileSlot(const char *n = 0, ProfileSlot *p = 0)
+         : name(n), parent(p), ncalls(0), total_ns(0),
+           min_ns(std::numeric_limits<qint64>::max()), max_ns(0)
+    {}
+    
+    void clear()
+    {
+        ncalls.store(0);
+        total_ns.store(0);
+        min_ns.store(std::numeric_limits<qint64>::max());
+        max_ns.store(0);
+    }
+    
+    /** The name of the timer */
+    const char *name;
+    
+    /** The parent timer (null for a top-level timer or a counter) */
+    ProfileSlot *parent;
+    
+    /** The number of times this timer has been stopped 
+        (or the value of the counter) */
+    QAtomicInteger<qint64> ncalls;
+    
+    /** The total, minimum and maximum times (in ns) */
+    QAtomicInteger<qint64> total_ns, min_ns, max_ns;
+};
+
+/** A single timed event, recorded when tracing */
+class ProfileEvent
+{
+public:
+    ProfileEvent(ProfileSlot *s = 0, qint64 start = 0, qint64 dur = 0)
+          : slot(s), start_ns(start), dur_ns(dur)
+    {}
+
+    ProfileSlot *slot;
+    qint64 start_ns, dur_ns;
+};
+
+typedef QPair<ProfileSlot*,const char*> ProfileKey;
+
+/** The state of the timers of a single thread. The mutex protects
+    the recorded events, and is only contended while a trace is 
+    being generated */
+class ThreadProfile
+{
+public:
+    ThreadProfile(int index) : thread_index(index), current(0)
+    {}
+
+    QMutex mutex;
+    
+    /** The index of this thread in the registry */
+    int thread_index;
+    
+    /** The slot of the currently running timer */
+    ProfileSlot *current;
+    
+    /** The slots already used by this thread, indexed by 
+        parent and name. This is only used by this thread */
+    QHash<ProfileKey,ProfileSlot*> slots;
+    
+    /** The recorded events (only when tracing) */
+    QVector<ProfileEvent> events;
+};
+
+/** The merged statistics of a timer */
+class ProfileStats
+{
+public:
+    ProfileStats() : ncalls(0), total_ns(0), 
+                     min_ns(std::numeric_limits<qint64>::max()), max_ns(0)
+    {}
+    
+    void add(const ProfileSlot &slot)
+    {
+        ncalls += slot.ncalls.load();
+        total_ns += slot.total_ns.load();
+        min_ns = qMin(min_ns, qint64(slot.min_ns.load()));
+        max_ns = qMax(max_ns, qint64(slot.max_ns.load()));
+    }
+    
+    qint64 ncalls, total_ns, min_ns, max_ns;
+};
+
+typedef boost::shared_ptr<ThreadProfile> ThreadProfilePtr;
+
+/** The registry of all of the slots and thread profiles. The slots
+    are deliberately never deleted, as they are cached by call sites */
+class ProfileRegistry
+{
+public:
+    ProfileRegistry()
+    {}
+
+    QMutex mutex;
+    
+    /** All of the timer slots, in the order they were created */
+    QList<ProfileSlot*> timers;
+    
+    /** The timer slots indexed by parent and name */
+    QHash<ProfileKey,ProfileSlot*> timer_index;
+    
+    /** All of the counter slots */
+    QList<ProfileSlot*> counters;
+    
+    /** The counter slots indexed by name */
+    QHash<const char*,ProfileSlot*> counter_index;
+    
+    /** The profiles of all of the threads */
+    QList<ThreadProfilePtr> threads;
+};
+
+} // end of namespace detail
+} // end of namespace SireBase
+
+using namespace SireBase::detail;
+
+/** The clock used for all of the timers */
+class ProfileClock
+{
+public:
+    ProfileClock()
+    {
+        clock.start();
+    }
+    
+    QElapsedTimer clock;
+};
+
+Q_GLOBAL_STATIC( ProfileClock, profileClock );
+Q_GLOBAL_STATIC( ProfileRegistry, profileRegistry );
+Q_GLOBAL_STATIC( QThreadStorage<ThreadProfilePtr>, localProfiles );
+
+/** Return the profile of the current thread, registering it if necessary */
+static ThreadProfile* localProfile()
+{
+    QThreadStorage<ThreadProfilePtr> *local = localProfiles();
+    
+    if (not local->hasLocalData())
+    {
+        ProfileRegistry *registry = profileRegistry();
+    
+        QMutexLocker lkr( &(registry->mutex) );
+        
+        ThreadProfilePtr profile( new ThreadProfile(registry->threads.count()) );
+        registry->threads.append(profile);
+        
+        local->setLocalData(profile);
+    }
+    
+    return local->localData().get();
+}
+
+/** Return the slot of the timer 'name' under the timer 'parent',
+    creating it if necessary. This takes the registry lock, so 
+    is only called the first time a thread uses the timer */
+static ProfileSlot* getTimerSlot(ProfileSlot *parent, const char *name)
+{
+    ProfileRegistry *registry = profileRegistry();
+    
+    QMutexLocker lkr( &(registry->mutex) );
+    
+    const ProfileKey key(parent, name);
+    
+    ProfileSlot *slot = registry->timer_index.value(key, 0);
+    
+    if (slot == 0)
+    {
+        slot = new ProfileSlot(name, parent);
+        registry->timers.append(slot);
+        registry->timer_index.insert(key, slot);
+    }
+    
+    return slot;
+}
+
+/** Return the slot of the counter 'name', creating it if necessary */
+static ProfileSlot* getCounterSlot(const char *name)
+{
+    ProfileRegistry *registry = profileRegistry();
+    
+    QMutexLocker lkr( &(registry->mutex) );
+    
+    ProfileSlot *slot = registry->counter_index.value(name, 0);
+    
+    if (slot == 0)
+    {
+        slot = new ProfileSlot(name);
+        registry->counters.append(slot);
+        registry->counter_index.insert(name, slot);
+    }
+    
+    return slot;
+}
+
+/** Atomically set 'value' to the minimum of itself and 'v' */
+static void atomicMin(QAtomicInteger<qint64> &value, qint64 v)
+{
+    qint64 old = value.load();
+    
+    while (v < old and not value.testAndSetRelaxed(old, v, old))
+    {}
+}
+
+/** Atomically set 'value' to the maximum of itself and 'v' */
+static void atomicMax(QAtomicInteger<qint64> &value, qint64 v)
+{
+    qint64 old = value.load();
+    
+    while (v > old and not value.testAndSetRelaxed(old, v, old))
+    {}
+}
+
+/** Return the time in ns since the profiler started */
+static qint64 now()
+{
+    return profileClock()->clock.nsecsElapsed();
+}
+
+static bool initiallyEnabled()
+{
+    const char *env = std::getenv("SIRE_PROFILE");
+    
+    if (env == 0)
+        return true;
+    else
+        return QString::fromLocal8Bit(env).trimmed() != "0";
+}
+
+bool Profiler::_pvt_enabled = ::initiallyEnabled();
+
+static bool tracing_enabled = false;
+
+/////////
+///////// Implementation of ScopedTimer
+/////////
+
+/** Start the timer. If 'site' is not null then the slot it cached is
+    used if it is for the same parent and name */
+void ScopedTimer::start(ProfileSite *site, const char *name)
+{
+    thread = localProfile();
+    
+    ProfileSlot *parent = thread->current;
+    
+    slot = (site == 0) ? 0 : site->last.loadAcquire();
+    
+    if (slot == 0 or slot->parent != parent or slot->name != name)
+    {
+        const ProfileKey key(parent, name);
+    
+        slot = thread->slots.value(key, 0);
+        
+        if (slot == 0)
+        {
+            slot = ::getTimerSlot(parent, name);
+            thread->slots.insert(key, slot);
+        }
+        
+        if (site)
+            site->last.storeRelease(slot);
+    }
+    
+    thread->current = slot;
+    
+    start_ns = now();
+}
+
+/** Stop the timer, recording the time since it was started. This
+    is called automatically when the timer is destroyed */
+void ScopedTimer::stop()
+{
+    if (slot == 0)
+        return;
+
+    const qint64 dur_ns = now() - start_ns;
+    
+    slot->ncalls.fetchAndAddRelaxed(1);
+    slot->total_ns.fetchAndAddRelaxed(dur_ns);
+    ::atomicMin(slot->min_ns, dur_ns);
+    ::atomicMax(slot->max_ns, dur_ns);
+    
+    thread->current = slot->parent;
+    
+    if (tracing_enabled)
+    {
+        QMutexLocker lkr( &(thread->mutex) );
+        
+        if (thread->events.count() < max_events_per_thread)
+            thread->events.append( ProfileEvent(slot, start_ns, dur_ns) );
+    }
+    
+    slot = 0;
+}
+
+/////////
+///////// Implementation of Profiler
+/////////
+
+/** Switch profiling on or off */
+void Profiler::setEnabled(bool on)
+{
+    _pvt_enabled = on;
+}
+
+/** Return whether or not profiling is switched on */
+bool Profiler::isEnabled()
+{
+    return _pvt_enabled;
+}
+
+/** Switch on or off the recording of every timed event, so that
+    the run can be exported as a Chrome trace. Up to 
+    1048576 events are recorded for each thread */
+void Profiler::setTracing(bool on)
+{
+    tracing_enabled = on;
+}
+
+/** Return whether or not every timed event is being recorded */
+bool Profiler::isTracing()
+{
+    return tracing_enabled;
+}
+
+/** Clear all of the timers, counters and trace events */
+void Profiler::clear()
+{
+    ProfileRegistry *registry = profileRegistry();
+
+    QMutexLocker lkr( &(registry->mutex) );
+    
+    foreach (ProfileSlot *slot, registry->timers)
+    {
+        slot->clear();
+    }
+    
+    foreach (ProfileSlot *slot, registry->counters)
+    {
+        slot->clear();
+    }
+    
+    foreach (ThreadProfilePtr profile, registry->threads)
+    {
+        QMutexLocker lkr2( &(profile->mutex) );
+        profile->events.clear();
+    }
+}
+
+/** Add 'n' to the counter called 'name'. As for ScopedTimer, the name 
+    is not copied, so must exist for the lifetime of the program */
+void Profiler::addCount(const char *name, qint64 n)
+{
+    if (not _pvt_enabled)
+        return;
+
+    ::getCounterSlot(name)->ncalls.fetchAndAddRelaxed(n);
+}
+
+/** Add 'n' to the counter called 'name', using the slot cached
+    in 'site' if it is for the same name. This is used by SIRE_COUNT */
+void Profiler::addCount(ProfileSite &site, const char *name, qint64 n)
+{
+    if (not _pvt_enabled)
+        return;
+
+    ProfileSlot *slot = site.last.loadAcquire();
+    
+    if (slot == 0 or slot->name != name)
+    {
+        slot = ::getCounterSlot(name);
+        site.last.storeRelease(slot);
+    }
+    
+    slot->ncalls.fetchAndAddRelaxed(n);
+}
+
+/** Return the full (hierarchical) name of the timer 'slot' */
+static QString getPath(const ProfileSlot *slot)
+{
+    QStringList parts;
+    
+    while (slot != 0)
+    {
+        parts.prepend( QString::fromLatin1(slot->name) );
+        slot = slot->parent;
+    }
+    
+    return parts.join("/");
+}
+
+/** Merge the timers with the same full name */
+static QMap<QString,ProfileStats> getTimers()
+{
+    QMap<QString,ProfileStats> timers;
+
+    ProfileRegistry *registry = profileRegistry();
+
+    QMutexLocker lkr( &(registry->mutex) );
+    
+    foreach (const ProfileSlot *slot, registry->timers)
+    {
+        if (slot->ncalls.load() > 0)
+            timers[ getPath(slot) ].add(*slot);
+    }
+    
+    return timers;
+}
+
+/** Merge the counters with the same name */
+static QMap<QString,qint64> getCounters()
+{
+    QMap<QString,qint64> counters;
+
+    ProfileRegistry *registry = profileRegistry();
+
+    QMutexLocker lkr( &(registry->mutex) );
+    
+    foreach (const ProfileSlot *slot, registry->counters)
+    {
+        counters[ QString::fromLatin1(slot->name) ] += slot->ncalls.load();
+    }
+    
+    return counters;
+}
+
+/** Return the full names of all of the timers that have been called */
+QStringList Profiler::timerNames()
+{
+    return getTimers().keys();
+}
+
+/** Return the names of all of the counters */
+QStringList Profiler::counterNames()
+{
+    return getCounters().keys();
+}
+
+/** Return the number of times that the timer with full name 'name'
+    has been called (summed over all threads) */
+qint64 Profiler::nCalls(const QString &name)
+{
+    return getTimers().value(name).ncalls;
+}
+
+/** Return the total time (in milliseconds) spent in the timer with
+    full name 'name' (summed over all threads) */
+double Profiler::totalTime(const QString &name)
+{
+    return 1e-6 * getTimers().value(name).total_ns;
+}
+
+/** Return the minimum time (in milliseconds) of a single call of the
+    timer with full name 'name' */
+double Profiler::minimumTime(const QString &name)
+{
+    ProfileStats stats = getTimers().value(name);
+    
+    if (stats.ncalls == 0)
+        return 0;
+    else
+        return 1e-6 * stats.min_ns;
+}
+
+/** Return the maximum time (in milliseconds) of a single call of the
+    timer with full name 'name' */
+double Profiler::maximumTime(const QString &name)
+{
+    return 1e-6 * getTimers().value(name).max_ns;
+}
+
+/** Return the value of the counter called 'name' (summed over all threads) */
+qint64 Profiler::count(const QString &name)
+{
+    return getCounters().value(name);
+}
+
+/** Return a human-readable report of all of the timers and counters */
+QString Profiler::report()
+{
+    const QMap<QString,ProfileStats> timers = getTimers();
+    const QMap<QString,qint64> counters = getCounters();
+
+    QStringList lines;
+    
+    lines.append( QString("%1 %2 %3 %4 %5 %6")
+                    .arg("timer", -60).arg("calls", 12).arg("total / ms", 14)
+                    .arg("mean / ms", 12).arg("min / ms", 12).arg("max / ms", 12) );
+    
+    for (QMap<QString,ProfileStats>::const_iterator it = timers.constBegin();
+         it != timers.constEnd();
+         ++it)
+    {
+        //indent each timer under its parent
+        const QStringList parts = it.key().split("/");
+        const QString name = QString(2*(parts.count()-1), ' ') + parts.last();
+        
+        const ProfileStats &stats = it.value();
+        
+        lines.append( QString("%1 %2 %3 %4 %5 %6")
+                        .arg(name, -60).arg(stats.ncalls, 12)
+                        .arg(1e-6*stats.total_ns, 14, 'f', 3)
+                        .arg(1e-6*stats.total_ns / stats.ncalls, 12, 'f', 4)
+                        .arg(1e-6*stats.min_ns, 12, 'f', 4)
+                        .arg(1e-6*stats.max_ns, 12, 'f', 4) );
+    }
+    
+    if (not counters.isEmpty())
+    {
+        lines.append( QString() );
+        lines.append( QString("%1 %2").arg("counter", -60).arg("count", 12) );
+        
+        for (QMap<QString,qint64>::const_iterator it = counters.constBegin();
+             it != counters.constEnd();
+             ++it)
+        {
+            lines.append( QString("%1 %2").arg(it.key(), -60).arg(it.value(), 12) );
+        }
+    }
+    
+    return lines.join("\n");
+}
+
+/** Return all of the timers and counters as a JSON document */
+QString Profiler::toJSON()
+{
+    const QMap<QString,ProfileStats> timers = getTimers();
+    const QMap<QString,qint64> counters = getCounters();
+
+    QJsonArray json_timers;
+    
+    for (QMap<QString,ProfileStats>::const_iterator it = timers.constBegin();
+         it != timers.constEnd();
+         ++it)
+    {
+        QJsonObject timer;
+        timer["name"] = it.key();
+        timer["calls"] = double(it.value().ncalls);
+        timer["total_ms"] = 1e-6 * it.value().total_ns;
+        timer["min_ms"] = 1e-6 * it.value().min_ns;
+        timer["max_ms"] = 1e-6 * it.value().max_ns;
+        
+        json_timers.append(timer);
+    }
+    
+    QJsonObject json_counters;
+    
+    for (QMap<QString,qint64>::const_iterator it = counters.constBegin();
+         it != counters.constEnd();
+         ++it)
+    {
+        json_counters[it.key()] = double(it.value());
+    }
+    
+    QJsonObject json;
+    json["timers"] = json_timers;
+    json["counters"] = json_counters;
+    
+    return QString::fromUtf8( QJsonDocument(json).toJson() );
+}
+
+/** Return all of the recorded trace events in the Chrome trace
+    event format. This is empty unless tracing was switched on */
+QString Profiler::toChromeTrace()
+{
+    QJsonArray events;
+    
+    const qint64 pid = QCoreApplication::applicationPid();
+    
+    ProfileRegistry *registry = profileRegistry();
+    
+    QMutexLocker lkr( &(registry->mutex) );
+    
+    foreach (ThreadProfilePtr profile, registry->threads)
+    {
+        QMutexLocker lkr2( &(profile->mutex) );
+        
+        foreach (const ProfileEvent &event, profile->events)
+        {
+            QJsonObject e;
+            e["name"] = QString::fromLatin1( event.slot->name );
+            e["cat"] = QString("sire");
+            e["ph"] = QString("X");
+            e["ts"] = 1e-3 * event.start_ns;
+            e["dur"] = 1e-3 * event.dur_ns;
+            e["pid"] = double(pid);
+            e["tid"] = profile->thread_index;
+            
+            events.append(e);
+        }
+    }
+    
+    lkr.unlock();
+    
+    QJsonObject json;
+    json["traceEvents"] = events;
+    json["displayTimeUnit"] = QString("ms");
+    
+    return QString::fromUtf8( QJsonDocument(json).toJson(QJsonDocument::Compact) );
+}
+
+/** Write the string 'contents' to the file 'filename' */
+static void writeFile(const QString &filename, const QString &contents)
+{
+    QFile f(filename);
+    
+    if (not f.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        throw SireError::file_error(f, CODELOC);
+    
+    const QByteArray data = contents.toUtf8();
+    
+    if (f.write(data) != data.count())
+        throw SireError::file_error(f, CODELOC);
+    
+    f.close();
+}
+
+/** Save the timers and counters as JSON to the file 'filename'
+    
+    \throw SireError::file_error
+*/
+void Profiler::saveJSON(const QString &filename)
+{
+    ::writeFile(filename, Profiler::toJSON());
+}
+
+/** Save the recorded trace events in the Chrome trace event format
+    to the file 'filename'
+    
+    \throw SireError::file_error
+*/
+void Profiler::saveChromeTrace(const QString &filename)
+{
+    ::writeFile(filename, Profiler::toChromeTrace());
+}
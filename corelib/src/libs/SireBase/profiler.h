@@ -0,0 +1,201 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#ifndef SIREBASE_PROFILER_H
+#define SIREBASE_PROFILER_H
+
+#include "sireglobal.h"
+
+#include <QString>
+#include <QStringList>
+#include <QAtomicPointer>
+
+SIRE_BEGIN_HEADER
+
+namespace SireBase
+{
+
+class ProfileSite;
+
+namespace detail
+{
+class ProfileSlot;
+class ThreadProfile;
+}
+
+/** This is the registry of the scoped timers and event counters that are
+    compiled into Sire. It collects the number of calls and the total, 
+    minimum and maximum time of each timed scope. The timers are 
+    hierarchical - a timer that is started while another timer is 
+    running on the same thread is recorded under that timer, using a
+    name such as "SireFF::ForceFields::energy/SireMM::InterFF".
+    
+    Each timer (a name under a particular parent) has a single slot that
+    is shared by all threads, and which is updated atomically. Each
+    SIRE_PROFILE or SIRE_COUNT call site caches the slot it used last, 
+    so the overhead of a timer is normally a clock read and a few atomic 
+    operations on entry and exit. A lock is only taken the first time
+    that a thread starts a timer under a new parent or name.
+    
+    Profiling is always on, but can be switched off by calling
+    Profiler::setEnabled(false), or by setting the environment variable 
+    SIRE_PROFILE to 0. If tracing is switched on then every timed
+    scope is also recorded as an event, so that the run can be exported
+    in the Chrome trace format (viewable in chrome://tracing).
+    
+    @author Christopher Woods
+*/
+class SIREBASE_EXPORT Profiler
+{
+public:
+    static void setEnabled(bool on);
+    static bool isEnabled();
+    
+    static void setTracing(bool on);
+    static bool isTracing();
+    
+    static void clear();
+    
+    static void addCount(const char *name, qint64 n = 1);
+    static void addCount(ProfileSite &site, const char *name, qint64 n);
+    
+    static QStringList timerNames();
+    static QStringList counterNames();
+    
+    static qint64 nCalls(const QString &name);
+    static double totalTime(const QString &name);
+    static double minimumTime(const QString &name);
+    static double maximumTime(const QString &name);
+    
+    static qint64 count(const QString &name);
+    
+    static QString report();
+    
+    static QString toJSON();
+    static QString toChromeTrace();
+    
+    static void saveJSON(const QString &filename);
+    static void saveChromeTrace(const QString &filename);
+
+    static bool _pvt_enabled;
+};
+
+/** This is the cache of the slot last used by a SIRE_PROFILE or 
+    SIRE_COUNT call site. The macros create one as a function-local
+    static, so that the slot of the timer or counter is normally 
+    found without a lock or hash lookup. The cached slot is only 
+    replaced, never deleted, so the cache is safe to read from
+    any thread
+    
+    @author Christopher Woods
+*/
+class SIREBASE_EXPORT ProfileSite
+{
+public:
+    ProfileSite() : last(0)
+    {}
+
+    /** The slot used the last time this site was reached */
+    QAtomicPointer<detail::ProfileSlot> last;
+};
+
+/** This is a timer that records the time between its construction
+    and destruction under the name 'name' in the Profiler. The name must 
+    be a string that lives for the lifetime of the program (e.g. a string 
+    literal, or the result of what()), as it is not copied. Use the
+    SIRE_PROFILE(name) macro to time the rest of the current scope.
+    
+    @author Christopher Woods
+*/
+class SIREBASE_EXPORT ScopedTimer
+{
+public:
+    ScopedTimer(const char *name)
+    {
+        if (Profiler::_pvt_enabled)
+            this->start(0, name);
+        else
+            slot = 0;
+    }
+
+    ScopedTimer(ProfileSite &site, const char *name)
+    {
+        if (Profiler::_pvt_enabled)
+            this->start(&site, name);
+        else
+            slot = 0;
+    }
+    
+    ~ScopedTimer()
+    {
+        if (slot != 0)
+            this->stop();
+    }
+
+    void stop();
+
+private:
+    ScopedTimer(const ScopedTimer&);
+    ScopedTimer& operator=(const ScopedTimer&);
+
+    void start(ProfileSite *site, const char *name);
+
+    /** The slot of the timer being timed */
+    detail::ProfileSlot *slot;
+    
+    /** The profile of the thread on which the timer was started */
+    detail::ThreadProfile *thread;
+    
+    /** The time at which the timer started (ns since the program started) */
+    qint64 start_ns;
+};
+
+}
+
+#define SIRE_PROFILE_CONCAT_PVT(a,b) a##b
+#define SIRE_PROFILE_CONCAT(a,b) SIRE_PROFILE_CONCAT_PVT(a,b)
+
+/** Time the rest of the current scope under the name 'name' */
+#define SIRE_PROFILE(name) \
+            static SireBase::ProfileSite SIRE_PROFILE_CONCAT(sire_profile_site_, __LINE__); \
+            SireBase::ScopedTimer SIRE_PROFILE_CONCAT(sire_scoped_timer_, __LINE__)( \
+                                    SIRE_PROFILE_CONCAT(sire_profile_site_, __LINE__), name)
+
+/** Add 'n' to the profiling counter called 'name' */
+#define SIRE_COUNT(name, n) \
+            do \
+            { \
+                static SireBase::ProfileSite sire_count_site; \
+                SireBase::Profiler::addCount(sire_count_site, name, n); \
+            } while (0)
+
+SIRE_EXPOSE_CLASS( SireBase::Profiler )
+
+SIRE_END_HEADER
+
+#endif
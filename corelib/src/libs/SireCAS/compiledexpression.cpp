@@ -0,0 +1,766 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#include "compiledexpression.h"
+#include "expressionbase.h"
+#include "values.h"
+
+#include "constant.h"
+#include "sum.h"
+#include "product.h"
+#include "power.h"
+#include "powerconstant.h"
+#include "exp.h"
+#include "abs.h"
+#include "minmax.h"
+#include "trigfuncs.h"
+#include "invtrigfuncs.h"
+#include "hyperbolicfuncs.h"
+#include "function.h"
+
+#include "SireMaths/maths.h"
+
+#include "SireStream/datastream.h"
+#include "SireStream/shareddatastream.h"
+
+#include <QVarLengthArray>
+
+#include <cmath>
+
+using namespace SireCAS;
+using namespace SireStream;
+
+/** The operations that can appear on the tape */
+enum TAPE_OPS { LOAD_SYMBOL = 1,  // reg = values[arg0]
+                LOAD_PARAM = 2,   // reg = params[arg0]
+                ADD = 3,          // reg = reg[arg0] + reg[arg1]
+                SUB = 4,          // reg = reg[arg0] - reg[arg1]
+                MUL = 5,          // reg = reg[arg0] * reg[arg1]
+                DIV = 6,          // reg = reg[arg0] / reg[arg1]
+                POW = 7,          // reg = reg[arg0] ^ reg[arg1] (as Power)
+                POWC = 8,         // reg = reg[arg0] ^ reg[arg1] (as ConstantPower)
+                POWI = 9,         // reg = reg[arg0] ^ arg1
+                MIN = 10,         // reg = min( reg[arg0], reg[arg1] )
+                MAX = 11,         // reg = max( reg[arg0], reg[arg1] )
+                FUNC = 12         // reg = func[arg1]( reg[arg0] )
+              };
+
+/** The single-argument functions that can be compiled */
+enum TAPE_FUNCS { FUNC_COS = 1, FUNC_SIN = 2, FUNC_TAN = 3,
+                  FUNC_SEC = 4, FUNC_CSC = 5, FUNC_COT = 6,
+                  FUNC_ARCTAN = 7,
+                  FUNC_COSH = 8, FUNC_SINH = 9, FUNC_TANH = 10,
+                  FUNC_EXP = 11, FUNC_LN = 12, FUNC_ABS = 13 };
+
+/** The number of values processed together by each instruction
+    during batched evaluation */
+static const int TAPE_CHUNK = 32;
+
+static const RegisterMetaType<CompiledExpression> r_compiledex(NO_ROOT);
+
+/** Serialise to a binary datastream */
+QDataStream SIRECAS_EXPORT &operator<<(QDataStream &ds, const CompiledExpression &compiled)
+{
+    writeHeader(ds, r_compiledex, 1);
+
+    SharedDataStream sds(ds);
+
+    sds << compiled.ex << compiled.syms;
+
+    return ds;
+}
+
+/** Extract from a binary datastream */
+QDataStream SIRECAS_EXPORT &operator>>(QDataStream &ds, CompiledExpression &compiled)
+{
+    VersionID v = readHeader(ds, r_compiledex);
+
+    if (v == 1)
+    {
+        SharedDataStream sds(ds);
+
+        sds >> compiled.ex >> compiled.syms;
+
+        compiled.compile();
+    }
+    else
+        throw version_error(v, "1", r_compiledex, CODELOC);
+
+    return ds;
+}
+
+/** Constructor */
+CompiledExpression::CompiledExpression() : form_hash(0)
+{}
+
+/** Compile the passed expression, using 'symbols' to give the
+    order of the slots used to pass in the values of the symbols.
+    Any symbol in the expression that is not in 'symbols' is
+    assumed to be equal to zero (as in Expression::evaluate) */
+CompiledExpression::CompiledExpression(const Expression &expression,
+                                       const QList<Symbol> &symbols)
+                   : ex(expression), syms(symbols), form_hash(0)
+{
+    this->compile();
+}
+
+/** Copy constructor */
+CompiledExpression::CompiledExpression(const CompiledExpression &other)
+                   : ex(other.ex), syms(other.syms),
+                     tape(other.tape), params(other.params),
+                     form_hash(other.form_hash)
+{}
+
+/** Destructor */
+CompiledExpression::~CompiledExpression()
+{}
+
+/** Copy assignment operator */
+CompiledExpression& CompiledExpression::operator=(const CompiledExpression &other)
+{
+    if (this != &other)
+    {
+        ex = other.ex;
+        syms = other.syms;
+        tape = other.tape;
+        params = other.params;
+        form_hash = other.form_hash;
+    }
+
+    return *this;
+}
+
+/** Comparison operator */
+bool CompiledExpression::operator==(const CompiledExpression &other) const
+{
+    return ex == other.ex and syms == other.syms;
+}
+
+/** Comparison operator */
+bool CompiledExpression::operator!=(const CompiledExpression &other) const
+{
+    return not CompiledExpression::operator==(other);
+}
+
+const char* CompiledExpression::typeName()
+{
+    return QMetaType::typeName( qMetaTypeId<CompiledExpression>() );
+}
+
+/** Return a string representation of this compiled expression */
+QString CompiledExpression::toString() const
+{
+    if (this->isCompiled())
+        return QObject::tr("CompiledExpression( %1, nInstructions() == %2, "
+                           "nParameters() == %3 )")
+                    .arg(ex.toString()).arg(tape.count()).arg(params.count());
+    else
+        return QObject::tr("CompiledExpression( %1, not compiled )")
+                    .arg(ex.toString());
+}
+
+/** Return whether or not this has the same functional form as 'other',
+    i.e. the two tapes are identical and differ only in their
+    parameters. Expressions with the same form can be evaluated together
+    using the same tape */
+bool CompiledExpression::hasSameForm(const CompiledExpression &other) const
+{
+    if (not (this->isCompiled() and other.isCompiled()))
+        return false;
+
+    return form_hash == other.form_hash and
+           params.count() == other.params.count() and
+           tape == other.tape and syms == other.syms;
+}
+
+/** Add an instruction onto the tape, returning the index of
+    the register that will hold its result */
+int CompiledExpression::addInstruction(qint32 op, qint32 arg0, qint32 arg1)
+{
+    Instruction instruction;
+    instruction.op = op;
+    instruction.arg0 = arg0;
+    instruction.arg1 = arg1;
+
+    tape.append(instruction);
+
+    return tape.count() - 1;
+}
+
+/** Add a constant parameter, returning the index of the register
+    that will hold its value */
+int CompiledExpression::addParameter(double value)
+{
+    params.append(value);
+    return addInstruction(LOAD_PARAM, params.count() - 1);
+}
+
+/** Compile the passed expression (factor multiplied by base), returning
+    the register holding the result, or -1 if this cannot be compiled */
+int CompiledExpression::compile(const Expression &expression)
+{
+    if (expression.base().isA<Constant>())
+        return addParameter(expression.factor());
+
+    int base = compileBase(expression.base());
+
+    if (base < 0)
+        return -1;
+
+    //the factor is always a parameter, so that expressions with
+    //different factors (e.g. force constants) have the same form
+    int fac = addParameter(expression.factor());
+
+    return addInstruction(MUL, fac, base);
+}
+
+/** Compile the passed base of an expression, returning the register
+    holding the result, or -1 if this cannot be compiled */
+int CompiledExpression::compileBase(const ExpressionBase &base)
+{
+    if (base.isA<Function>())
+    {
+        //functions are not compiled
+        return -1;
+    }
+    else if (base.isA<Symbol>())
+    {
+        int slot = syms.indexOf( base.asA<Symbol>() );
+
+        if (slot < 0)
+            //missing symbols are equal to zero
+            return addParameter(0);
+        else
+            return addInstruction(LOAD_SYMBOL, slot);
+    }
+    else if (base.isA<Constant>())
+    {
+        return addParameter(1);
+    }
+    else if (base.isA<Sum>())
+    {
+        const Sum &sum = base.asA<Sum>();
+
+        int reg = addParameter(sum.strtval);
+
+        for (QHash<ExpressionBase,Expression>::const_iterator it = sum.posparts.constBegin();
+             it != sum.posparts.constEnd();
+             ++it)
+        {
+            int part = compile(*it);
+
+            if (part < 0)
+                return -1;
+
+            reg = addInstruction(ADD, reg, part);
+        }
+
+        for (QHash<ExpressionBase,Expression>::const_iterator it = sum.negparts.constBegin();
+             it != sum.negparts.constEnd();
+             ++it)
+        {
+            int part = compile(*it);
+
+            if (part < 0)
+                return -1;
+
+            reg = addInstruction(SUB, reg, part);
+        }
+
+        return reg;
+    }
+    else if (base.isA<Product>())
+    {
+        const Product &product = base.asA<Product>();
+
+        int reg = addParameter(product.strtval);
+
+        for (QHash<Expression,Expression>::const_iterator it = product.numparts.constBegin();
+             it != product.numparts.constEnd();
+             ++it)
+        {
+            int part = compile(*it);
+
+            if (part < 0)
+                return -1;
+
+            reg = addInstruction(MUL, reg, part);
+        }
+
+        if (not product.denomparts.isEmpty())
+        {
+            int denom = -1;
+
+            for (QHash<Expression,Expression>::const_iterator
+                                            it = product.denomparts.constBegin();
+                 it != product.denomparts.constEnd();
+                 ++it)
+            {
+                int part = compile(*it);
+
+                if (part < 0)
+                    return -1;
+
+                if (denom < 0)
+                    denom = part;
+                else
+                    denom = addInstruction(MUL, denom, part);
+            }
+
+            reg = addInstruction(DIV, reg, denom);
+        }
+
+        return reg;
+    }
+    else if (base.isA<Exp>())
+    {
+        int power = compile( base.asA<Exp>().power() );
+
+        if (power < 0)
+            return -1;
+
+        return addInstruction(FUNC, power, FUNC_EXP);
+    }
+    else if (base.isA<IntegerPower>())
+    {
+        const IntegerPower &power = base.asA<IntegerPower>();
+
+        int core = compile( power.core() );
+
+        if (core < 0)
+            return -1;
+
+        int n = int( power.power().evaluate(Values()) );
+
+        return addInstruction(POWI, core, n);
+    }
+    else if (base.isA<RationalPower>() or base.isA<RealPower>())
+    {
+        const ConstantPower &power = base.asA<ConstantPower>();
+
+        int core = compile( power.core() );
+
+        if (core < 0)
+            return -1;
+
+        int pwr = addParameter( power.power().evaluate(Values()) );
+
+        return addInstruction(POWC, core, pwr);
+    }
+    else if (base.isA<PowerConstant>())
+    {
+        const PowerConstant &power = base.asA<PowerConstant>();
+
+        int core = addParameter( power.core().evaluate(Values()) );
+        int pwr = compile( power.power() );
+
+        if (pwr < 0)
+            return -1;
+
+        return addInstruction(POWC, core, pwr);
+    }
+    else if (base.isA<Power>())
+    {
+        const Power &power = base.asA<Power>();
+
+        int core = compile( power.core() );
+
+        if (core < 0)
+            return -1;
+
+        int pwr = compile( power.power() );
+
+        if (pwr < 0)
+            return -1;
+
+        return addInstruction(POW, core, pwr);
+    }
+    else if (base.isA<Min>() or base.isA<Max>())
+    {
+        const DoubleFunc &func = base.asA<DoubleFunc>();
+
+        int x = compile( func.x() );
+
+        if (x < 0)
+            return -1;
+
+        int y = compile( func.y() );
+
+        if (y < 0)
+            return -1;
+
+        return addInstruction( base.isA<Min>() ? MIN : MAX, x, y );
+    }
+    else if (base.isA<SingleFunc>())
+    {
+        int func = 0;
+
+        if (base.isA<Cos>())
+            func = FUNC_COS;
+        else if (base.isA<Sin>())
+            func = FUNC_SIN;
+        else if (base.isA<Tan>())
+            func = FUNC_TAN;
+        else if (base.isA<Sec>())
+            func = FUNC_SEC;
+        else if (base.isA<Csc>())
+            func = FUNC_CSC;
+        else if (base.isA<Cot>())
+            func = FUNC_COT;
+        else if (base.isA<ArcTan>())
+            func = FUNC_ARCTAN;
+        else if (base.isA<Cosh>())
+            func = FUNC_COSH;
+        else if (base.isA<Sinh>())
+            func = FUNC_SINH;
+        else if (base.isA<Tanh>())
+            func = FUNC_TANH;
+        else if (base.isA<Ln>())
+            func = FUNC_LN;
+        else if (base.isA<Abs>())
+            func = FUNC_ABS;
+        else
+            //this function has not been compiled (e.g. may have a complex result)
+            return -1;
+
+        int x = compile( base.asA<SingleFunc>().x() );
+
+        if (x < 0)
+            return -1;
+
+        return addInstruction(FUNC, x, func);
+    }
+    else
+        //we don't know how to compile this part of the expression
+        return -1;
+}
+
+/** Compile the expression into the tape */
+void CompiledExpression::compile()
+{
+    tape.clear();
+    params.clear();
+    form_hash = 0;
+
+    if (ex.isComplex() or this->compile(ex) < 0)
+    {
+        //we cannot compile this expression
+        tape.clear();
+        params.clear();
+        return;
+    }
+
+    tape.squeeze();
+    params.squeeze();
+
+    uint h = tape.count();
+
+    for (int i=0; i<tape.count(); ++i)
+    {
+        const Instruction &instruction = tape.constData()[i];
+        h = 31*h + uint(instruction.op);
+        h = 31*h + uint(instruction.arg0);
+        h = 31*h + uint(instruction.arg1);
+    }
+
+    form_hash = h;
+}
+
+/** Evaluate the function 'func' on 'x' */
+static inline double evalFunc(int func, double x)
+{
+    switch (func)
+    {
+    case FUNC_COS:
+        return std::cos(x);
+    case FUNC_SIN:
+        return std::sin(x);
+    case FUNC_TAN:
+        return std::tan(x);
+    case FUNC_SEC:
+        return double(1.0) / std::cos(x);
+    case FUNC_CSC:
+        return double(1.0) / std::sin(x);
+    case FUNC_COT:
+        return double(1.0) / std::tan(x);
+    case FUNC_ARCTAN:
+        return std::atan(x);
+    case FUNC_COSH:
+        return std::cosh(x);
+    case FUNC_SINH:
+        return std::sinh(x);
+    case FUNC_TANH:
+        return std::tanh(x);
+    case FUNC_EXP:
+        return std::exp(x);
+    case FUNC_LN:
+        return std::log(x);
+    case FUNC_ABS:
+        return std::abs(x);
+    default:
+        return 0;
+    }
+}
+
+/** Evaluate a generic power, using the same rules as Power::evaluate */
+static inline double evalPower(double x, double n)
+{
+    if (SireMaths::isZero(n))
+        return 1.0;
+    else if (SireMaths::isZero(x))
+        return x;
+    else
+        return SireMaths::pow(x, n);
+}
+
+/** Evaluate the expression, using the passed values for the symbols
+    (in slot order) and the passed parameters (which must be for an
+    expression with the same form as this expression) */
+double CompiledExpression::evaluate(const double *values, const double *p) const
+{
+    if (tape.isEmpty())
+    {
+        //fall back to evaluating the expression directly
+        Values vals;
+
+        for (int i=0; i<syms.count(); ++i)
+        {
+            vals.set(syms.at(i), values[i]);
+        }
+
+        return ex.evaluate(vals);
+    }
+
+    const int ninstructions = tape.count();
+    const Instruction *instructions = tape.constData();
+
+    QVarLengthArray<double,64> regs(ninstructions);
+    double *reg = regs.data();
+
+    for (int i=0; i<ninstructions; ++i)
+    {
+        const Instruction &ins = instructions[i];
+
+        switch (ins.op)
+        {
+        case LOAD_SYMBOL:
+            reg[i] = values[ins.arg0];
+            break;
+        case LOAD_PARAM:
+            reg[i] = p[ins.arg0];
+            break;
+        case ADD:
+            reg[i] = reg[ins.arg0] + reg[ins.arg1];
+            break;
+        case SUB:
+            reg[i] = reg[ins.arg0] - reg[ins.arg1];
+            break;
+        case MUL:
+            reg[i] = reg[ins.arg0] * reg[ins.arg1];
+            break;
+        case DIV:
+            reg[i] = reg[ins.arg0] / reg[ins.arg1];
+            break;
+        case POW:
+            reg[i] = evalPower(reg[ins.arg0], reg[ins.arg1]);
+            break;
+        case POWC:
+            reg[i] = SireMaths::pow(reg[ins.arg0], reg[ins.arg1]);
+            break;
+        case POWI:
+            reg[i] = SireMaths::pow(reg[ins.arg0], int(ins.arg1));
+            break;
+        case MIN:
+            reg[i] = qMin(reg[ins.arg0], reg[ins.arg1]);
+            break;
+        case MAX:
+            reg[i] = qMax(reg[ins.arg0], reg[ins.arg1]);
+            break;
+        case FUNC:
+            reg[i] = evalFunc(ins.arg1, reg[ins.arg0]);
+            break;
+        }
+    }
+
+    return reg[ninstructions-1];
+}
+
+/** Evaluate the expression, using the passed values for the symbols,
+    which must be in the same order as the symbols passed to the constructor */
+double CompiledExpression::evaluate(const double *values) const
+{
+    return this->evaluate(values, params.constData());
+}
+
+/** Evaluate 'n' terms that all have the same form as this expression,
+    placing the results into 'result'. The values and parameters are
+    passed in structure-of-arrays format, so that 'values[i][j]' is
+    the value of the ith symbol for the jth term, and 'params[i][j]'
+    is the ith parameter of the jth term. This evaluates each instruction
+    across a chunk of terms at a time, so that the inner loops are simple
+    and can be vectorised by the compiler */
+void CompiledExpression::evaluate(const double * const *values,
+                                  const double * const *p,
+                                  int n, double *result) const
+{
+    if (n <= 0)
+        return;
+
+    if (tape.isEmpty())
+    {
+        //fall back to evaluating the expression directly
+        Values vals;
+
+        for (int j=0; j<n; ++j)
+        {
+            for (int i=0; i<syms.count(); ++i)
+            {
+                vals.set(syms.at(i), values[i][j]);
+            }
+
+            result[j] = ex.evaluate(vals);
+        }
+
+        return;
+    }
+
+    const int ninstructions = tape.count();
+    const Instruction *instructions = tape.constData();
+
+    QVarLengthArray<double, 64*TAPE_CHUNK> regs(ninstructions * TAPE_CHUNK);
+
+    for (int start=0; start<n; start += TAPE_CHUNK)
+    {
+        const int m = qMin(TAPE_CHUNK, n - start);
+
+        for (int i=0; i<ninstructions; ++i)
+        {
+            const Instruction &ins = instructions[i];
+
+            //the registers used as input (loads read from the arguments,
+            //while POWI and FUNC only use the first register)
+            const bool is_load = (ins.op == LOAD_SYMBOL or ins.op == LOAD_PARAM);
+            const bool is_unary = (ins.op == POWI or ins.op == FUNC);
+
+            double *out = regs.data() + i*TAPE_CHUNK;
+            const double *a = is_load ? 0 : regs.constData() + ins.arg0*TAPE_CHUNK;
+            const double *b = (is_load or is_unary) ? 0
+                                    : regs.constData() + ins.arg1*TAPE_CHUNK;
+
+            switch (ins.op)
+            {
+            case LOAD_SYMBOL:
+                a = values[ins.arg0] + start;
+                for (int j=0; j<m; ++j){ out[j] = a[j]; }
+                break;
+            case LOAD_PARAM:
+                a = p[ins.arg0] + start;
+                for (int j=0; j<m; ++j){ out[j] = a[j]; }
+                break;
+            case ADD:
+                for (int j=0; j<m; ++j){ out[j] = a[j] + b[j]; }
+                break;
+            case SUB:
+                for (int j=0; j<m; ++j){ out[j] = a[j] - b[j]; }
+                break;
+            case MUL:
+                for (int j=0; j<m; ++j){ out[j] = a[j] * b[j]; }
+                break;
+            case DIV:
+                for (int j=0; j<m; ++j){ out[j] = a[j] / b[j]; }
+                break;
+            case POW:
+                for (int j=0; j<m; ++j){ out[j] = evalPower(a[j], b[j]); }
+                break;
+            case POWC:
+                for (int j=0; j<m; ++j){ out[j] = SireMaths::pow(a[j], b[j]); }
+                break;
+            case POWI:
+                if (ins.arg1 == 2)
+                {
+                    for (int j=0; j<m; ++j){ out[j] = a[j] * a[j]; }
+                }
+                else
+                {
+                    const int power = ins.arg1;
+                    for (int j=0; j<m; ++j){ out[j] = SireMaths::pow(a[j], power); }
+                }
+                break;
+            case MIN:
+                for (int j=0; j<m; ++j){ out[j] = qMin(a[j], b[j]); }
+                break;
+            case MAX:
+                for (int j=0; j<m; ++j){ out[j] = qMax(a[j], b[j]); }
+                break;
+            case FUNC:
+                switch (ins.arg1)
+                {
+                case FUNC_COS:
+                    for (int j=0; j<m; ++j){ out[j] = std::cos(a[j]); }
+                    break;
+                case FUNC_SIN:
+                    for (int j=0; j<m; ++j){ out[j] = std::sin(a[j]); }
+                    break;
+                case FUNC_EXP:
+                    for (int j=0; j<m; ++j){ out[j] = std::exp(a[j]); }
+                    break;
+                default:
+                    for (int j=0; j<m; ++j){ out[j] = evalFunc(ins.arg1, a[j]); }
+                    break;
+                }
+                break;
+            }
+        }
+
+        const double *res = regs.constData() + (ninstructions-1)*TAPE_CHUNK;
+
+        for (int j=0; j<m; ++j)
+        {
+            result[start+j] = res[j];
+        }
+    }
+}
+
+/** Evaluate 'n' terms that all have the same form as this expression,
+    returning the sum of the results. The values and parameters are
+    passed in the same structure-of-arrays format as used by 'evaluate' */
+double CompiledExpression::sum(const double * const *values,
+                               const double * const *p, int n) const
+{
+    QVarLengthArray<double, 256> result(n);
+    this->evaluate(values, p, n, result.data());
+
+    double total = 0;
+
+    for (int i=0; i<n; ++i)
+    {
+        total += result[i];
+    }
+
+    return total;
+}
@@ -0,0 +1,239 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#ifndef SIRECAS_COMPILEDEXPRESSION_H
+#define SIRECAS_COMPILEDEXPRESSION_H
+
+#include <QVector>
+#include <QList>
+
+#include "expression.h"
+#include "symbol.h"
+
+SIRE_BEGIN_HEADER
+
+namespace SireCAS
+{
+class CompiledExpression;
+}
+
+QDataStream& operator<<(QDataStream&, const SireCAS::CompiledExpression&);
+QDataStream& operator>>(QDataStream&, SireCAS::CompiledExpression&);
+
+namespace SireCAS
+{
+
+/** This class holds a compiled form of an Expression. The expression
+    tree is flattened into a tape of register-based instructions, with
+    each of the symbols assigned to a fixed slot (so no Values hash
+    is needed to evaluate the expression), and with all of the
+    numerical constants pulled out of the tape into a separate
+    array of parameters.
+
+    Because the constants are held separately, two expressions that
+    have the same functional form (e.g. two harmonic bonds with
+    different force constants and equilibrium lengths) produce
+    identical tapes (see hasSameForm). This allows a single tape
+    to be used to evaluate many terms in a single, batched pass over
+    structure-of-arrays input, e.g. as used by InternalFF.
+
+    Not all expressions can be compiled (e.g. those containing
+    complex numbers or user-defined functions). In these cases
+    isCompiled() returns false, and evaluation falls back to
+    the slower Expression::evaluate
+
+    @author Christopher Woods
+*/
+class SIRECAS_EXPORT CompiledExpression
+{
+
+friend QDataStream& ::operator<<(QDataStream&, const CompiledExpression&);
+friend QDataStream& ::operator>>(QDataStream&, CompiledExpression&);
+
+public:
+    CompiledExpression();
+
+    CompiledExpression(const Expression &expression,
+                       const QList<Symbol> &symbols);
+
+    CompiledExpression(const CompiledExpression &other);
+
+    ~CompiledExpression();
+
+    CompiledExpression& operator=(const CompiledExpression &other);
+
+    bool operator==(const CompiledExpression &other) const;
+    bool operator!=(const CompiledExpression &other) const;
+
+    static const char* typeName();
+
+    const char* what() const
+    {
+        return CompiledExpression::typeName();
+    }
+
+    QString toString() const;
+
+    bool isEmpty() const;
+    bool isCompiled() const;
+
+    const Expression& expression() const;
+
+    const QList<Symbol>& symbols() const;
+
+    int nSymbols() const;
+    int nParameters() const;
+    int nInstructions() const;
+
+    const QVector<double>& parameters() const;
+
+    uint formHash() const;
+    bool hasSameForm(const CompiledExpression &other) const;
+
+    double evaluate(const double *values) const;
+    double evaluate(const double *values, const double *params) const;
+
+    void evaluate(const double * const *values, const double * const *params,
+                  int n, double *result) const;
+
+    double sum(const double * const *values, const double * const *params,
+               int n) const;
+
+private:
+    void compile();
+    int compile(const Expression &ex);
+    int compileBase(const ExpressionBase &base);
+
+    int addInstruction(qint32 op, qint32 arg0=0, qint32 arg1=0);
+    int addParameter(double value);
+
+    /** A single instruction on the tape. Each instruction
+        writes its result into its own register (the register
+        with the same index as the instruction) */
+    struct Instruction
+    {
+        /** The operation code */
+        qint32 op;
+        /** The first argument (register, slot, parameter or function) */
+        qint32 arg0;
+        /** The second argument (register or integer power) */
+        qint32 arg1;
+
+        bool operator==(const Instruction &other) const
+        {
+            return op == other.op and arg0 == other.arg0 and arg1 == other.arg1;
+        }
+    };
+
+    /** The expression that has been compiled */
+    Expression ex;
+
+    /** The symbols, in slot order */
+    QList<Symbol> syms;
+
+    /** The tape of instructions. The result is held in the
+        register of the last instruction */
+    QVector<Instruction> tape;
+
+    /** The constants that were pulled out of the expression */
+    QVector<double> params;
+
+    /** Hash of the instructions on the tape, used to quickly
+        find expressions with the same functional form */
+    uint form_hash;
+};
+
+#ifndef SIRE_SKIP_INLINE_FUNCTIONS
+
+/** Return whether or not this is empty (contains no expression) */
+inline bool CompiledExpression::isEmpty() const
+{
+    return syms.isEmpty() and tape.isEmpty() and ex.isZero();
+}
+
+/** Return whether or not the expression was compiled. If not,
+    then evaluation will use the (slower) Expression::evaluate */
+inline bool CompiledExpression::isCompiled() const
+{
+    return not tape.isEmpty();
+}
+
+/** Return the expression that has been compiled */
+inline const Expression& CompiledExpression::expression() const
+{
+    return ex;
+}
+
+/** Return the symbols of the expression, in the order of the slots
+    used to pass their values */
+inline const QList<Symbol>& CompiledExpression::symbols() const
+{
+    return syms;
+}
+
+/** Return the number of symbol slots */
+inline int CompiledExpression::nSymbols() const
+{
+    return syms.count();
+}
+
+/** Return the number of constant parameters pulled out of the expression */
+inline int CompiledExpression::nParameters() const
+{
+    return params.count();
+}
+
+/** Return the number of instructions on the tape */
+inline int CompiledExpression::nInstructions() const
+{
+    return tape.count();
+}
+
+/** Return the constant parameters that were pulled out
+    of the expression during compilation */
+inline const QVector<double>& CompiledExpression::parameters() const
+{
+    return params;
+}
+
+/** Return a hash of the functional form of this expression. Expressions
+    with the same functional form have the same hash */
+inline uint CompiledExpression::formHash() const
+{
+    return form_hash;
+}
+
+#endif // SIRE_SKIP_INLINE_FUNCTIONS
+
+}
+
+Q_DECLARE_METATYPE( SireCAS::CompiledExpression )
+
+SIRE_END_HEADER
+
+#endif
@@ -113,6 +113,7 @@ public:
     QList<Factor> expand(const Symbol &symbol) const;
 
 private:
+    friend class CompiledExpression;
 
     void rebuild();
 
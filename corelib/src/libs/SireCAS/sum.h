@@ -112,6 +112,7 @@ public:
 
 private:
     friend class Product;
+    friend class CompiledExpression;
 
     void add(const Expression &ex);
 
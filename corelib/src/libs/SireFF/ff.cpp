@@ -43,6 +43,8 @@
 
 #include "SireMol/mover.hpp"
 
+#include "SireBase/profiler.h"
+
 #include "SireFF/errors.h"
 #include "SireError/errors.h"
 
@@ -171,6 +173,51 @@ const Values& FF::currentEnergies() const
     return nrg_components;
 }
 
+/** Return whether or not this forcefield is able to restore its 
+    energies using restoreEnergies */
+bool FF::canRestoreEnergies() const
+{
+    return this->_pvt_canDiscardChanges();
+}
+
+/** Restore the cached energies and version of this forcefield to 
+    'energies' and 'version'. These must be the energies and version
+    of this forcefield when it last held the current versions of its
+    molecules, e.g. after the molecules changed during a rejected move
+    have been put back. The changes recorded since then are discarded,
+    so the energies are restored exactly, without being recalculated
+    
+    \throw SireError::unsupported
+*/
+void FF::restoreEnergies(const Values &energies, quint64 version)
+{
+    if (not this->_pvt_canDiscardChanges())
+        throw SireError::unsupported( QObject::tr(
+                "The forcefield %1 (a %2) cannot restore its energies.")
+                    .arg(this->name()).arg(this->what()), CODELOC );
+
+    this->_pvt_discardChanges();
+    
+    nrg_components = energies;
+    versn = version;
+    
+    this->setClean();
+}
+
+/** Virtual function used to return whether or not this forcefield
+    can discard the changes recorded since the energy was last 
+    evaluated. This is false unless the forcefield overrides it */
+bool FF::_pvt_canDiscardChanges() const
+{
+    return false;
+}
+
+/** Virtual function used to discard the changes recorded since the
+    energy was last evaluated, as the molecules have been restored to
+    the versions they had at that evaluation */
+void FF::_pvt_discardChanges()
+{}
+
 /** Return the unique ID for this forcefield */
 const QUuid& FF::UID() const
 {
@@ -260,6 +307,7 @@ SireUnits::Dimension::MolarEnergy FF::energy(const Symbol &component)
 {
     if (this->isDirty())
     {
+        SIRE_PROFILE( this->what() );
         this->recalculateEnergy();
     }
                   
@@ -283,7 +331,10 @@ SireUnits::Dimension::MolarEnergy FF::energy()
 Values FF::energies(const QSet<Symbol> &components)
 {
     if (this->isDirty())
+    {
+        SIRE_PROFILE( this->what() );
         this->recalculateEnergy();
+    }
         
     Values vals;
     
@@ -306,7 +357,10 @@ Values FF::energies(const QSet<Symbol> &components)
 Values FF::energies()
 {
     if (this->isDirty())
+    {
+        SIRE_PROFILE( this->what() );
         this->recalculateEnergy();
+    }
         
     return nrg_components;
 }
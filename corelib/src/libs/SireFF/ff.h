@@ -265,6 +265,11 @@ public:
     bool isDirty() const;
     bool isClean() const;
 
+    const Values& currentEnergies() const;
+
+    bool canRestoreEnergies() const;
+    void restoreEnergies(const Values &energies, quint64 version);
+
     static const NullFF& null();
 
 protected:
@@ -283,8 +288,6 @@ protected:
     void setDirty();
     void setClean();
 
-    const Values& currentEnergies() const;
-
     /** Virtual function used to trigger a recalculation of the total energy
         and of all of the component energies */
     virtual void recalculateEnergy()=0;
@@ -344,6 +347,9 @@ protected:
 
     virtual void _pvt_updateName()=0;
 
+    virtual bool _pvt_canDiscardChanges() const;
+    virtual void _pvt_discardChanges();
+
 private:
 
     /** The unique ID for this forcefield - this uniquely identifies
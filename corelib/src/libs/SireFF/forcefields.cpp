@@ -27,6 +27,7 @@
 \*********************************************/
 
 #include <QSet>
+#include <QMap>
 
 #include "forcefields.h"
 
@@ -50,6 +51,7 @@
 
 #include "SireBase/linktoproperty.h"
 #include "SireBase/combineproperties.h"
+#include "SireBase/profiler.h"
 
 #include "tostring.h"
 
@@ -63,6 +65,9 @@
 
 #include <boost/shared_ptr.hpp>
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 #include <QDebug>
 #include <QTime>
 
@@ -79,6 +84,39 @@ namespace SireFF
 namespace detail
 {
 
+/** This is a single call to a forcefield that is needed to 
+    evaluate an energy component. This is either a call for 
+    the total energy of the forcefield, or for one of its components,
+    scaled by 'scale' */
+class FFTask
+{
+public:
+    FFTask() : ffidx(-1), is_total(true), scale(0)
+    {}
+    
+    FFTask(int idx, double scl) : ffidx(idx), is_total(true), scale(scl)
+    {}
+    
+    FFTask(int idx, const Symbol &comp, double scl)
+         : ffidx(idx), component(comp), is_total(false), scale(scl)
+    {}
+    
+    ~FFTask()
+    {}
+    
+    /** The index of the forcefield */
+    int ffidx;
+    
+    /** The component of the forcefield (if this is not the total) */
+    Symbol component;
+    
+    /** Whether or not this is the total energy of the forcefield */
+    bool is_total;
+    
+    /** The scaling factor for the component */
+    double scale;
+};
+
 /** This is a private hierarchy of classes that is used just by ForceFields
     to relate a symbol to an energy component, forcefield expression or
     constant */
@@ -111,6 +149,10 @@ public:
     virtual MolarEnergy energy(QVector<FFPtr> &forcefields,
                           const QHash<Symbol,FFSymbolPtr> &ffsymbols,
                           double scale_energy=1) const=0;
+    
+    virtual void getTasks(QVector<FFTask> &tasks,
+                          const QHash<Symbol,FFSymbolPtr> &ffsymbols,
+                          int nforcefields, double scale=1) const=0;
                           
     virtual void force(ForceTable &forcetable,
                        QVector<FFPtr> &forcefields,
@@ -195,6 +237,10 @@ public:
                        const QHash<Symbol,FFSymbolPtr> &ffsymbols,
                        double scale_energy=1) const;
     
+    void getTasks(QVector<FFTask> &tasks,
+                  const QHash<Symbol,FFSymbolPtr> &ffsymbols,
+                  int nforcefields, double scale=1) const;
+    
     void force(ForceTable &forcetable,
                QVector<FFPtr> &forcefields,
                const QHash<Symbol,FFSymbolPtr> &ffsymbols,
@@ -258,6 +304,10 @@ public:
                        const QHash<Symbol,FFSymbolPtr> &ffsymbols,
                        double scale_energy=1) const;
     
+    void getTasks(QVector<FFTask> &tasks,
+                  const QHash<Symbol,FFSymbolPtr> &ffsymbols,
+                  int nforcefields, double scale=1) const;
+    
     void force(ForceTable &forcetable,
                QVector<FFPtr> &forcefields,
                const QHash<Symbol,FFSymbolPtr> &ffsymbols,
@@ -320,6 +370,10 @@ public:
     MolarEnergy energy(QVector<FFPtr> &forcefields,
                        const QHash<Symbol,FFSymbolPtr> &ffsymbols,
                        double scale_energy=1) const;
+    
+    void getTasks(QVector<FFTask> &tasks,
+                  const QHash<Symbol,FFSymbolPtr> &ffsymbols,
+                  int nforcefields, double scale=1) const;
                   
     void force(ForceTable &forcetable, QVector<FFPtr> &forcefields,
                const QHash<Symbol,FFSymbolPtr> &ffsymbols,
@@ -384,6 +438,10 @@ public:
     MolarEnergy energy(QVector<FFPtr> &forcefields,
                        const QHash<Symbol,FFSymbolPtr> &ffsymbols,
                        double scale_energy=1) const;
+    
+    void getTasks(QVector<FFTask> &tasks,
+                  const QHash<Symbol,FFSymbolPtr> &ffsymbols,
+                  int nforcefields, double scale=1) const;
                   
     void force(ForceTable &forcetable, QVector<FFPtr> &forcefields,
                const QHash<Symbol,FFSymbolPtr> &ffsymbols,
@@ -477,6 +535,10 @@ public:
     MolarEnergy energy(QVector<FFPtr> &forcefields,
                        const QHash<Symbol,FFSymbolPtr> &ffsymbols,
                        double scale_energy=1) const;
+    
+    void getTasks(QVector<FFTask> &tasks,
+                  const QHash<Symbol,FFSymbolPtr> &ffsymbols,
+                  int nforcefields, double scale=1) const;
                   
     void force(ForceTable &forcetable, QVector<FFPtr> &forcefields,
                const QHash<Symbol,FFSymbolPtr> &ffsymbols,
@@ -663,6 +725,13 @@ MolarEnergy FFConstantValue::energy(QVector<FFPtr> &forcefields,
     return MolarEnergy();
 }
 
+void FFConstantValue::getTasks(QVector<FFTask>&,
+                               const QHash<Symbol,FFSymbolPtr>&,
+                               int, double) const
+{
+    //constants don't need any forcefield to be evaluated
+}
+
 void FFConstantValue::force(ForceTable &forcetable,
                           QVector<FFPtr> &forcefields,
                           const QHash<Symbol,FFSymbolPtr> &ffsymbols,
@@ -812,6 +881,13 @@ MolarEnergy FFConstantExpression::energy(QVector<FFPtr> &forcefields,
     return MolarEnergy();
 }
 
+void FFConstantExpression::getTasks(QVector<FFTask>&,
+                                    const QHash<Symbol,FFSymbolPtr>&,
+                                    int, double) const
+{
+    //constants don't need any forcefield to be evaluated
+}
+
 void FFConstantExpression::force(ForceTable &forcetable,
                                  QVector<FFPtr> &forcefields,
                                  const QHash<Symbol,FFSymbolPtr> &ffsymbols,
@@ -922,6 +998,14 @@ MolarEnergy FFSymbolFF::energy(QVector<FFPtr> &forcefields,
         return MolarEnergy(0);
 }
 
+void FFSymbolFF::getTasks(QVector<FFTask> &tasks,
+                          const QHash<Symbol,FFSymbolPtr>&,
+                          int, double scale) const
+{
+    if (scale != 0)
+        tasks.append( FFTask(ffidx, this->symbol(), scale) );
+}
+
 void FFSymbolFF::force(ForceTable &forcetable, QVector<FFPtr> &forcefields,
                        const QHash<Symbol,FFSymbolPtr> &ffsymbols,
                        double scale_force) const
@@ -1209,6 +1293,39 @@ MolarEnergy FFSymbolExpression::energy(QVector<FFPtr> &forcefields,
     return nrg;
 }
 
+void FFSymbolExpression::getTasks(QVector<FFTask> &tasks,
+                                  const QHash<Symbol,FFSymbolPtr> &ffsymbols,
+                                  int nforcefields, double scale) const
+{
+    if (scale == 0)
+        return;
+
+    int ncomponents = components.count();
+    const Component *components_array = components.constData();
+    
+    Values values;
+    
+    for (int i=0; i<ncomponents; ++i)
+    {
+        const Component &component = components_array[i];
+        
+        //evaluate all of the dependent symbols...
+        int ndeps = component.nDependents();
+        const Symbol *deps_array = component.dependents().constData();
+        
+        for (int j=0; j<ndeps; ++j)
+        {
+            const Symbol &symbol = deps_array[j];
+
+            if (not values.contains(symbol))
+                values.set( symbol, ffsymbols[symbol]->value(ffsymbols) );
+        }
+        
+        ffsymbols[component.symbol()]->getTasks(tasks, ffsymbols, nforcefields,
+                                                scale * component.scalingFactor(values));
+    }
+}
+
 void FFSymbolExpression::force(ForceTable &forcetable,
                                QVector<FFPtr> &forcefields,
                                const QHash<Symbol,FFSymbolPtr> &ffsymbols,
@@ -1442,6 +1559,19 @@ MolarEnergy FFTotalExpression::energy(QVector<FFPtr> &forcefields,
     return nrg * scale_energy;
 }
 
+void FFTotalExpression::getTasks(QVector<FFTask> &tasks,
+                                 const QHash<Symbol,FFSymbolPtr>&,
+                                 int nforcefields, double scale) const
+{
+    if (scale == 0)
+        return;
+
+    for (int i=0; i<nforcefields; ++i)
+    {
+        tasks.append( FFTask(i, scale) );
+    }
+}
+
 void FFTotalExpression::force(ForceTable &forcetable,
                               QVector<FFPtr> &forcefields,
                               const QHash<Symbol,FFSymbolPtr> &ffsymbols,
@@ -1538,7 +1668,7 @@ static const RegisterMetaType<ForceFields> r_ffields;
 /** Serialise to a binary datastream */
 QDataStream SIREFF_EXPORT &operator<<(QDataStream &ds, const ForceFields &ffields)
 {
-    writeHeader(ds, r_ffields, 2);
+    writeHeader(ds, r_ffields, 3);
     
     SharedDataStream sds(ds);
     
@@ -1547,7 +1677,8 @@ QDataStream SIREFF_EXPORT &operator<<(QDataStream &ds, const ForceFields &ffield
         << ffields.ffsymbols
         << ffields.additional_properties
         << ffields.property_aliases
-        << ffields.combined_properties;
+        << ffields.combined_properties
+        << ffields.parallel_calc;
     
     return ds;
 }
@@ -1557,7 +1688,27 @@ QDataStream SIREFF_EXPORT &operator>>(QDataStream &ds, ForceFields &ffields)
 {
     VersionID v = readHeader(ds, r_ffields);
     
-    if (v == 2)
+    if (v == 3)
+    {
+        SharedDataStream sds(ds);
+
+        //read into a new object, as a lot can go wrong!
+        ForceFields new_ffields;
+
+        //read in the forcefields
+        sds >> new_ffields.ffields_by_idx
+            >> new_ffields.ffsymbols
+            >> new_ffields.additional_properties
+            >> new_ffields.property_aliases
+            >> new_ffields.combined_properties
+            >> new_ffields.parallel_calc;
+
+        //rebuild the index
+        new_ffields.rebuildIndex();
+        
+        ffields = new_ffields;
+    }
+    else if (v == 2)
     {
         SharedDataStream sds(ds);
 
@@ -1593,7 +1744,7 @@ QDataStream SIREFF_EXPORT &operator>>(QDataStream &ds, ForceFields &ffields)
         ffields = new_ffields;
     }
     else
-        throw version_error(v, "1,2", r_ffields, CODELOC);
+        throw version_error(v, "1,2,3", r_ffields, CODELOC);
 
     return ds;
 }
@@ -1607,7 +1758,8 @@ const Symbol& ForceFields::totalComponent()
 }
 
 /** Constructor */
-ForceFields::ForceFields() : ConcreteProperty<ForceFields,MolGroupsBase>()
+ForceFields::ForceFields() : ConcreteProperty<ForceFields,MolGroupsBase>(),
+                             parallel_calc(false)
 {}
 
 /** Internal function used to return the ith forcefield
@@ -1827,7 +1979,7 @@ void ForceFields::rebuildIndex()
 
 /** Construct a group that holds just a single forcefield */
 ForceFields::ForceFields(const FF& forcefield)
-            : ConcreteProperty<ForceFields,MolGroupsBase>()
+            : ConcreteProperty<ForceFields,MolGroupsBase>(), parallel_calc(false)
 {
     ffields_by_idx.append(forcefield);
     this->rebuildIndex();
@@ -1835,7 +1987,7 @@ ForceFields::ForceFields(const FF& forcefield)
 
 /** Construct a group that holds lots of forcefields */
 ForceFields::ForceFields(const QList<FFPtr> &forcefields)
-            : ConcreteProperty<ForceFields,MolGroupsBase>()
+            : ConcreteProperty<ForceFields,MolGroupsBase>(), parallel_calc(false)
 {
     ffields_by_idx = forcefields.toVector();
     
@@ -1860,7 +2012,7 @@ ForceFields::ForceFields(const QList<FFPtr> &forcefields)
 /** Construct a group that holds lots of forcefields */
 ForceFields::ForceFields(const QVector<FFPtr> &forcefields)
             : ConcreteProperty<ForceFields,MolGroupsBase>(),
-              ffields_by_idx(forcefields)
+              ffields_by_idx(forcefields), parallel_calc(false)
 {
     this->rebuildIndex();
 }
@@ -1874,7 +2026,8 @@ ForceFields::ForceFields(const ForceFields &other)
               ffsymbols(other.ffsymbols),
               additional_properties(other.additional_properties),
               property_aliases(other.property_aliases),
-              combined_properties(other.combined_properties)
+              combined_properties(other.combined_properties),
+              parallel_calc(other.parallel_calc)
 {}
 
 /** Destructor */
@@ -1893,6 +2046,7 @@ ForceFields& ForceFields::operator=(const ForceFields &other)
         additional_properties = other.additional_properties;
         property_aliases = other.property_aliases;
         combined_properties = other.combined_properties;
+        parallel_calc = other.parallel_calc;
         
         MolGroupsBase::operator=(other);
     }
@@ -2224,6 +2378,294 @@ QString ForceFields::toString() const
 {
     return QObject::tr("FFPtr( nForceFields() == %1 )").arg(this->nForceFields());
 }
+
+/** Internal function used to return all of the forcefield calls
+    needed to evaluate the energy component 'component'. This returns
+    an empty list if the component does not exist */
+QVector<FFTask> ForceFields::getTasks(const Symbol &component) const
+{
+    QVector<FFTask> tasks;
+    
+    FFSymbolPtr comp = ffsymbols.value(component);
+    
+    if (comp.get() != 0)
+        comp->getTasks(tasks, ffsymbols, ffields_by_idx.count());
+    
+    return tasks;
+}
+
+/** Internal function used to return all of the forcefield calls
+    needed to evaluate all of the energy components in 'components' */
+QVector<FFTask> ForceFields::getTasks(const QSet<Symbol> &components) const
+{
+    QVector<FFTask> tasks;
+    
+    foreach (const Symbol &component, components)
+    {
+        FFSymbolPtr comp = ffsymbols.value(component);
+        
+        if (comp.get() != 0)
+            comp->getTasks(tasks, ffsymbols, ffields_by_idx.count());
+    }
+    
+    return tasks;
+}
+
+namespace SireFF
+{
+namespace detail
+{
+
+/** Save the current exception into 'error' - this must be called
+    from within a catch block */
+static void saveError(boost::shared_ptr<SireError::exception> &error)
+{
+    try
+    {
+        throw;
+    }
+    catch(const SireError::exception &e)
+    {
+        error.reset( e.clone() );
+    }
+    catch(const std::exception &e)
+    {
+        error.reset( new SireError::std_exception(e) );
+    }
+    catch(...)
+    {
+        error.reset( new SireError::unknown_exception( QObject::tr(
+                "An unknown error occured while evaluating a forcefield."),
+                    CODELOC ) );
+    }
+}
+
+/** Rethrow the first error in 'errors', if there is one */
+static void rethrowFirstError(const QVector< boost::shared_ptr<SireError::exception> > &errors)
+{
+    for (int i=0; i<errors.count(); ++i)
+    {
+        if (errors.at(i).get() != 0)
+            errors.at(i)->throwSelf();
+    }
+}
+
+/** Functor used to recalculate the energies of a set of 
+    dirty forcefields in parallel */
+class FFEnergyCalculator
+{
+public:
+    FFEnergyCalculator(FF **forcefields,
+                       boost::shared_ptr<SireError::exception> *errors)
+                : ffields(forcefields), errs(errors)
+    {}
+    
+    void operator()(const tbb::blocked_range<int> &range) const
+    {
+        for (int i=range.begin(); i<range.end(); ++i)
+        {
+            try
+            {
+                ffields[i]->energy();
+            }
+            catch(...)
+            {
+                saveError(errs[i]);
+            }
+        }
+    }
+
+private:
+    FF **ffields;
+    boost::shared_ptr<SireError::exception> *errs;
+};
+
+/** The forcefield calls for a single forcefield that are needed
+    to evaluate a force, together with the table into which 
+    the forces are added */
+class FFForceJob
+{
+public:
+    FFForceJob() : ffield(0)
+    {}
+    
+    ~FFForceJob()
+    {}
+
+    FF3D *ffield;
+    QVector<FFTask> tasks;
+    ForceTable forcetable;
+    boost::shared_ptr<SireError::exception> error;
+};
+
+/** Functor used to calculate the forces of a set of forcefields
+    in parallel, with each forcefield writing into its own
+    force table */
+class FFForceCalculator
+{
+public:
+    FFForceCalculator(FFForceJob *forcejobs, double scale)
+                : jobs(forcejobs), scale_force(scale)
+    {}
+    
+    void operator()(const tbb::blocked_range<int> &range) const
+    {
+        for (int i=range.begin(); i<range.end(); ++i)
+        {
+            FFForceJob &job = jobs[i];
+        
+            try
+            {
+                for (int j=0; j<job.tasks.count(); ++j)
+                {
+                    const FFTask &task = job.tasks.at(j);
+                    
+                    if (task.is_total)
+                        job.ffield->force(job.forcetable, scale_force * task.scale);
+                    else
+                        job.ffield->force(job.forcetable, task.component,
+                                          scale_force * task.scale);
+                }
+            }
+            catch(...)
+            {
+                saveError(job.error);
+            }
+        }
+    }
+
+private:
+    FFForceJob *jobs;
+    double scale_force;
+};
+
+} // end of namespace detail
+} // end of namespace SireFF
+
+/** Internal function used to recalculate, in parallel, the energies
+    of all of the dirty forcefields that are needed by 'tasks'. The
+    energies are cached in the forcefields, so the serial walk over
+    the energy expression that follows will give exactly the same
+    result as a fully serial calculation */
+void ForceFields::parallelEnergies(const QVector<FFTask> &tasks)
+{
+    QVector<FF*> dirty;
+    QSet<int> seen;
+    
+    for (int i=0; i<tasks.count(); ++i)
+    {
+        int ffidx = tasks.at(i).ffidx;
+        
+        if (seen.contains(ffidx))
+            continue;
+            
+        seen.insert(ffidx);
+        
+        if (ffields_by_idx.at(ffidx)->isDirty())
+            //must detach the forcefield here, before we go parallel
+            dirty.append( &(ffields_by_idx[ffidx].edit()) );
+    }
+    
+    if (dirty.count() < 2)
+        //nothing to gain from running in parallel
+        return;
+
+    QVector< boost::shared_ptr<SireError::exception> > errors(dirty.count());
+    
+    tbb::parallel_for( tbb::blocked_range<int>(0, dirty.count(), 1),
+                       FFEnergyCalculator(dirty.data(), errors.data()) );
+
+    rethrowFirstError(errors);
+}
+
+/** Internal function used to calculate the forces for the forcefield calls
+    in 'tasks', scaled by 'scale_force', in parallel. Each forcefield
+    adds its forces into its own copy of 'forcetable', and these are
+    then summed into 'forcetable' in forcefield index order, so that the 
+    result does not depend on the order in which the forcefields finished */
+void ForceFields::parallelForce(ForceTable &forcetable, const QVector<FFTask> &tasks,
+                                double scale_force)
+{
+    //group the tasks together by forcefield
+    QMap< int, QVector<FFTask> > tasks_by_ff;
+    
+    for (int i=0; i<tasks.count(); ++i)
+    {
+        const FFTask &task = tasks.at(i);
+        
+        if (not ffields_by_idx.at(task.ffidx)->isA<FF3D>())
+        {
+            if (task.is_total)
+                //this forcefield doesn't contribute to the total force
+                continue;
+            else
+                throw SireFF::missing_derivative( QObject::tr(
+                    "The forcefield of type %1 does not inherit from FF3D so does "
+                    "not provide a force function.")
+                        .arg(ffields_by_idx.at(task.ffidx)->what()), CODELOC );
+        }
+        
+        tasks_by_ff[task.ffidx].append(task);
+    }
+    
+    if (tasks_by_ff.isEmpty())
+        return;
+    
+    QVector<FFForceJob> jobs(tasks_by_ff.count());
+    FFForceJob *jobs_array = jobs.data();
+
+    int i = 0;
+    
+    for (QMap< int,QVector<FFTask> >::const_iterator it = tasks_by_ff.constBegin();
+         it != tasks_by_ff.constEnd();
+         ++it)
+    {
+        FFForceJob &job = jobs_array[i];
+        ++i;
+    
+        //must detach the forcefield here, before we go parallel
+        job.ffield = &(ffields_by_idx[it.key()].edit().asA<FF3D>());
+        job.tasks = it.value();
+        
+        if (jobs.count() > 1)
+        {
+            job.forcetable = forcetable;
+            job.forcetable.initialiseTables();
+        }
+    }
+    
+    if (jobs.count() == 1)
+    {
+        //only one forcefield, so it can write directly into 'forcetable'
+        FFForceJob &job = jobs_array[0];
+        
+        for (int j=0; j<job.tasks.count(); ++j)
+        {
+            const FFTask &task = job.tasks.at(j);
+        
+            if (task.is_total)
+                job.ffield->force(forcetable, scale_force * task.scale);
+            else
+                job.ffield->force(forcetable, task.component, scale_force * task.scale);
+        }
+        
+        return;
+    }
+    
+    tbb::parallel_for( tbb::blocked_range<int>(0, jobs.count(), 1),
+                       FFForceCalculator(jobs_array, scale_force) );
+    
+    for (int j=0; j<jobs.count(); ++j)
+    {
+        if (jobs_array[j].error.get() != 0)
+            jobs_array[j].error->throwSelf();
+    }
+    
+    for (int j=0; j<jobs.count(); ++j)
+    {
+        forcetable.add( jobs_array[j].forcetable );
+    }
+}
     
 /** Return the energy associated with the symbol 'component'. This component 
     may either be a component of one of the constituent forcefields,
@@ -2233,6 +2675,8 @@ QString ForceFields::toString() const
 */
 SireUnits::Dimension::MolarEnergy ForceFields::energy(const Symbol &component)
 {
+    SIRE_PROFILE("SireFF::ForceFields::energy");
+
     FFSymbolPtr comp = ffsymbols.value(component);
 
     if (comp.get() == 0)
@@ -2249,6 +2693,9 @@ SireUnits::Dimension::MolarEnergy ForceFields::energy(const Symbol &component)
                     .arg(component.toString(),
                          Sire::toString(energySymbols())), CODELOC );
 
+    if (parallel_calc)
+        this->parallelEnergies( this->getTasks(component) );
+
     return comp->energy(ffields_by_idx, ffsymbols);
 }
 
@@ -2270,7 +2717,12 @@ double ForceFields::componentValue(const Symbol &component)
     if (comp->isConstant())
         return comp->value(ffsymbols);
     else
+    {
+        if (parallel_calc)
+            this->parallelEnergies( this->getTasks(component) );
+    
         return comp->energy(ffields_by_idx, ffsymbols).value();
+    }
     
 }
 
@@ -2281,6 +2733,9 @@ double ForceFields::componentValue(const Symbol &component)
 */
 Values ForceFields::componentValues(const QSet<Symbol> &components)
 {
+    if (parallel_calc)
+        this->parallelEnergies( this->getTasks(components) );
+
     Values vals;
     
     foreach (const Symbol &component, components)
@@ -2294,6 +2749,9 @@ Values ForceFields::componentValues(const QSet<Symbol> &components)
 /** Return the values of all energy and constant components */
 Values ForceFields::componentValues()
 {
+    if (parallel_calc)
+        this->parallelEnergies( this->getTasks(this->energySymbols()) );
+
     Values vals;
     vals.reserve(ffsymbols.count());
     
@@ -2325,6 +2783,11 @@ SireUnits::Dimension::MolarEnergy ForceFields::energy()
     constants and expressions */
 Values ForceFields::energies()
 {
+    SIRE_PROFILE("SireFF::ForceFields::energies");
+
+    if (parallel_calc)
+        this->parallelEnergies( this->getTasks(this->energySymbols()) );
+
     Values vals;
     
     for (QHash<Symbol,FFSymbolPtr>::const_iterator it = ffsymbols.constBegin();
@@ -2345,6 +2808,11 @@ Values ForceFields::energies()
 */
 Values ForceFields::energies(const QSet<Symbol> &components)
 {
+    SIRE_PROFILE("SireFF::ForceFields::energies");
+
+    if (parallel_calc)
+        this->parallelEnergies( this->getTasks(components) );
+
     Values vals;
     vals.reserve(components.count());
     
@@ -2874,6 +3342,8 @@ QHash<Symbol,Expression> ForceFields::componentExpressions() const
 void ForceFields::force(ForceTable &forcetable, const Symbol &component,
                         double scale_force)
 {
+    SIRE_PROFILE("SireFF::ForceFields::force");
+
     FFSymbolPtr comp = ffsymbols.value(component);
 
     if (comp.get() == 0)
@@ -2890,8 +3360,11 @@ void ForceFields::force(ForceTable &forcetable, const Symbol &component,
                     .arg(component.toString(),
                          Sire::toString(energySymbols())), CODELOC );
 
-    comp->force(forcetable, ffields_by_idx, 
-                ffsymbols, scale_force);
+    if (parallel_calc)
+        this->parallelForce(forcetable, this->getTasks(component), scale_force);
+    else
+        comp->force(forcetable, ffields_by_idx, 
+                    ffsymbols, scale_force);
 }
 
 /** Add the forces due to the forcefields in this set to the molecules
@@ -4113,6 +4586,37 @@ void ForceFields::mustNowRecalculateFromScratch()
     }
 }
 
+/** Set whether or not to evaluate the independent forcefields in
+    parallel. If this is on, then the energies of all of the dirty 
+    forcefields needed by an energy component are calculated at the same time,
+    and each forcefield adds its forces into its own copy of the force table.
+    The energies are identical to those calculated in serial. The forces
+    are summed in forcefield order, so are reproducible */
+void ForceFields::setUseParallelCalculation(bool on)
+{
+    parallel_calc = on;
+}
+
+/** Turn on the parallel evaluation of independent forcefields. 
+    This is off by default, and is worthwhile if there are several
+    expensive forcefields that each use only a few cores */
+void ForceFields::enableParallelCalculation()
+{
+    this->setUseParallelCalculation(true);
+}
+
+/** Turn off the parallel evaluation of independent forcefields */
+void ForceFields::disableParallelCalculation()
+{
+    this->setUseParallelCalculation(false);
+}
+
+/** Return whether or not the independent forcefields are evaluated in parallel */
+bool ForceFields::usesParallelCalculation() const
+{
+    return parallel_calc;
+}
+
 /** Return whether or not any of the forcefields in this set are dirty
     (the molecules have changed since the last energy calculation) */
 bool ForceFields::isDirty() const
@@ -4260,6 +4764,41 @@ void ForceFields::removeAllForceFields()
     }
 }
 
+/** Restore the cached energies and version of the forcefield at index
+    'ffidx' to 'energies' and 'version' (see FF::restoreEnergies)
+    
+    \throw SireError::invalid_index
+    \throw SireError::unsupported
+*/
+void ForceFields::restoreEnergies(const FFIdx &ffidx, const Values &energies,
+                                  quint64 version)
+{
+    this->_pvt_forceField( ffidx.map(ffields_by_idx.count()) )
+                .restoreEnergies(energies, version);
+}
+
+/** Restore the forcefield at index 'ffidx' to 'forcefield', which must
+    be an earlier version of that forcefield that contains the same groups
+    of molecules. This is used to undo the changes made to forcefields
+    that cannot restore their energies
+    
+    \throw SireError::invalid_index
+    \throw SireError::incompatible_error
+*/
+void ForceFields::restoreForceField(const FFIdx &ffidx, const FF &forcefield)
+{
+    int i = ffidx.map(ffields_by_idx.count());
+    
+    const FF &ffield = ffields_by_idx.at(i).read();
+    
+    if (ffield.UID() != forcefield.UID() or ffield.name() != forcefield.name())
+        throw SireError::incompatible_error( QObject::tr(
+                "Cannot restore the forcefield %1 using a different forcefield (%2).")
+                    .arg(ffield.toString(), forcefield.toString()), CODELOC );
+    
+    ffields_by_idx[i] = forcefield;
+}
+
 /** Return the molecule group that has number 'mgnum'
 
     \throw SireMol::missing_group
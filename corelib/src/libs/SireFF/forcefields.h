@@ -66,6 +66,7 @@ using SireCAS::Symbols;
 namespace detail
 {
 class FFSymbol;
+class FFTask;
 typedef boost::shared_ptr<FFSymbol> FFSymbolPtr;
 }
 
@@ -256,6 +257,11 @@ public:
     
     void mustNowRecalculateFromScratch();
     
+    void enableParallelCalculation();
+    void disableParallelCalculation();
+    void setUseParallelCalculation(bool on);
+    bool usesParallelCalculation() const;
+    
     bool isDirty() const;
     bool isClean() const;
     
@@ -271,6 +277,9 @@ public:
 
     void removeAllForceFields();
 
+    void restoreEnergies(const FFIdx &ffidx, const Values &energies, quint64 version);
+    void restoreForceField(const FFIdx &ffidx, const FF &forcefield);
+
     //overloading MolGroupsBase virtual functions
     const MoleculeGroup& at(MGNum mgnum) const;
 
@@ -374,6 +383,13 @@ private:
 
     void _pvt_remove(int i);
 
+    QVector<detail::FFTask> getTasks(const Symbol &component) const;
+    QVector<detail::FFTask> getTasks(const QSet<Symbol> &components) const;
+    
+    void parallelEnergies(const QVector<detail::FFTask> &tasks);
+    void parallelForce(ForceTable &forcetable, const QVector<detail::FFTask> &tasks,
+                       double scale_force);
+
     /** The global symbol used to refer to the total energy of a collection
         of forcefields */
     static Symbol total_component;
@@ -402,6 +418,10 @@ private:
     
     /** All of the combined properties, indexed by their name */
     QHash<QString, PropertyPtr> combined_properties;
+    
+    /** Whether or not to evaluate the independent forcefields
+        in parallel */
+    bool parallel_calc;
 };
 
 }
@@ -109,6 +109,9 @@ protected:
 
     bool recordingChanges() const;
 
+    bool _pvt_canDiscardChanges() const;
+    void _pvt_discardChanges();
+
     void recordChange(quint32 groupid, const ChangedMolecule &change);
 
     const FFComponent& _pvt_components() const;
@@ -328,6 +331,28 @@ void Inter2B2GFF<Potential>::mustNowRecalculateFromScratch()
     }
 }
 
+/** This forcefield can discard the changes recorded since the last
+    energy evaluation, so can restore its energies when a move is undone */
+template<class Potential>
+SIRE_OUTOFLINE_TEMPLATE
+bool Inter2B2GFF<Potential>::_pvt_canDiscardChanges() const
+{
+    return true;
+}
+
+/** Discard the changes recorded since the last energy evaluation. This
+    is called when the molecules have been restored to the versions they
+    had at that evaluation, so there is no change in energy */
+template<class Potential>
+SIRE_OUTOFLINE_TEMPLATE
+void Inter2B2GFF<Potential>::_pvt_discardChanges()
+{
+    for (int i=0; i<2; ++i)
+    {
+        changed_mols[i].clear();
+    }
+}
+
 /** Return whether or not we need to record the changes to this   
     forcefield (not necessary if the energy has to be recalculated
     from scratch) */
@@ -110,6 +110,9 @@ protected:
 
     bool recordingChanges() const;
 
+    bool _pvt_canDiscardChanges() const;
+    void _pvt_discardChanges();
+
     void recordChange(const ChangedMolecule &change);
 
     void recalculateEnergy();
@@ -320,6 +323,26 @@ void Inter2BFF<Potential>::mustNowRecalculateFromScratch()
     removed_mols.clear();
 }
 
+/** This forcefield can discard the changes recorded since the last
+    energy evaluation, so can restore its energies when a move is undone */
+template<class Potential>
+SIRE_OUTOFLINE_TEMPLATE
+bool Inter2BFF<Potential>::_pvt_canDiscardChanges() const
+{
+    return true;
+}
+
+/** Discard the changes recorded since the last energy evaluation. This
+    is called when the molecules have been restored to the versions they
+    had at that evaluation, so there is no change in energy */
+template<class Potential>
+SIRE_OUTOFLINE_TEMPLATE
+void Inter2BFF<Potential>::_pvt_discardChanges()
+{
+    changed_mols.clear();
+    removed_mols.clear();
+}
+
 /** Return whether or not we need to record the changes to this   
     forcefield (not necessary if the energy has to be recalculated
     from scratch) */
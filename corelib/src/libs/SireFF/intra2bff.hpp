@@ -113,6 +113,9 @@ protected:
 
     bool recordingChanges() const;
 
+    bool _pvt_canDiscardChanges() const;
+    void _pvt_discardChanges();
+
     void recordChange(const ChangedMolecule &change);
 
     const FFComponent& _pvt_components() const;
@@ -318,6 +321,25 @@ void Intra2BFF<Potential>::mustNowRecalculateFromScratch()
     changed_mols.clear();
 }
 
+/** This forcefield can discard the changes recorded since the last
+    energy evaluation, so can restore its energies when a move is undone */
+template<class Potential>
+SIRE_OUTOFLINE_TEMPLATE
+bool Intra2BFF<Potential>::_pvt_canDiscardChanges() const
+{
+    return true;
+}
+
+/** Discard the changes recorded since the last energy evaluation. This
+    is called when the molecules have been restored to the versions they
+    had at that evaluation, so there is no change in energy */
+template<class Potential>
+SIRE_OUTOFLINE_TEMPLATE
+void Intra2BFF<Potential>::_pvt_discardChanges()
+{
+    changed_mols.clear();
+}
+
 /** Return whether or not we need to record the changes to this   
     forcefield (not necessary if the energy has to be recalculated
     from scratch) */
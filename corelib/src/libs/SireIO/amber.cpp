@@ -62,6 +62,7 @@
 
 #include "SireVol/cartesian.h"
 #include "SireVol/periodicbox.h"
+#include "SireVol/triclinicbox.h"
 
 #include "SireMaths/maths.h"
 #include "SireUnits/units.h"
@@ -2078,10 +2079,11 @@ tuple<MoleculeGroup,SpacePtr> Amber::_pvt_readCrdTop(const QString &crdfile,
     }
     else if ( pointers[IFBOX] == 2 )
     {
-        /** Truncated Octahedral box*/
-        throw SireError::incompatible_error( QObject::tr(
-                "Sire does not yet support a truncated octahedral box"),
-                                             CODELOC );
+        /** Truncated Octahedral box, described by the lengths of the
+            lattice vectors and the angles between them (in degrees) */
+        spce = TriclinicBox( crd_box[0], crd_box[1], crd_box[2],
+                             crd_box[3]*degrees, crd_box[4]*degrees,
+                             crd_box[5]*degrees );
     }
     else
     {
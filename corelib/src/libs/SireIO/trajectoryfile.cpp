@@ -0,0 +1,1038 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#include <QFile>
+#include <QFileInfo>
+#include <QtEndian>
+
+#include <cmath>
+#include <cstring>
+
+#include <boost/noncopyable.hpp>
+
+#include "trajectoryfile.h"
+#include "errors.h"
+
+#include "SireMol/atomcoords.h"
+#include "SireMol/molecule.h"
+#include "SireMol/moleditor.h"
+#include "SireMol/viewsofmol.h"
+#include "SireMol/molidx.h"
+
+#include "SireVol/cartesian.h"
+#include "SireVol/periodicbox.h"
+#include "SireVol/triclinicbox.h"
+
+#include "SireID/index.h"
+
+#include "SireError/errors.h"
+
+#include <QDebug>
+
+using namespace SireIO;
+using namespace SireIO::detail;
+using namespace SireMol;
+using namespace SireVol;
+using namespace SireMaths;
+using namespace SireBase;
+
+/////////
+///////// Description of the file format
+/////////
+///////// All numbers are little-endian
+/////////
+///////// Header:  "SIRETRJ1" | quint32 version | double precision
+/////////
+///////// Frame:   "FRME" | quint32 natoms | quint8 has_box |
+/////////          (if has_box) 9 x double box vectors |
+/////////          quint32 nbytes | nbytes of compressed coordinates
+/////////
+///////// Index:   "INDX" | quint32 nframes | nframes x quint64 frame offsets |
+/////////          quint64 offset of "INDX" | "SIRETRJI"
+/////////
+///////// The index is only written when the file is closed. The
+///////// coordinates are rounded to the nearest multiple of 'precision',
+///////// and each atom is stored as the difference from the previous atom
+///////// as zig-zag encoded, variable-length (7 bits per byte) integers
+/////////
+
+static const char FILE_MAGIC[] = "SIRETRJ1";
+static const char FRAME_MAGIC[] = "FRME";
+static const char INDEX_MAGIC[] = "INDX";
+static const char TRAILER_MAGIC[] = "SIRETRJI";
+
+static const quint32 FILE_VERSION = 1;
+
+static const qint64 HEADER_SIZE = 8 + 4 + 8;
+static const qint64 TRAILER_SIZE = 8 + 8;
+
+static void appendUInt32(QByteArray &data, quint32 value)
+{
+    uchar buffer[4];
+    qToLittleEndian<quint32>(value, buffer);
+    data.append( reinterpret_cast<const char*>(buffer), 4 );
+}
+
+static void appendUInt64(QByteArray &data, quint64 value)
+{
+    uchar buffer[8];
+    qToLittleEndian<quint64>(value, buffer);
+    data.append( reinterpret_cast<const char*>(buffer), 8 );
+}
+
+static void appendDouble(QByteArray &data, double value)
+{
+    quint64 bits;
+    std::memcpy(&bits, &value, 8);
+    appendUInt64(data, bits);
+}
+
+static quint32 readUInt32(const uchar *data)
+{
+    return qFromLittleEndian<quint32>(data);
+}
+
+static quint64 readUInt64(const uchar *data)
+{
+    return qFromLittleEndian<quint64>(data);
+}
+
+static double readDouble(const uchar *data)
+{
+    quint64 bits = readUInt64(data);
+    double value;
+    std::memcpy(&value, &bits, 8);
+    return value;
+}
+
+/** Append the zig-zag, variable-length encoding of 'value' to 'data' */
+static void appendVarInt(QByteArray &data, qint64 value)
+{
+    quint64 v = (quint64(value) << 1) ^ quint64(value >> 63);
+
+    while (v >= 0x80)
+    {
+        data.append( char( (v & 0x7F) | 0x80 ) );
+        v >>= 7;
+    }
+
+    data.append( char(v) );
+}
+
+/** Read a zig-zag, variable-length encoded integer from 'data',
+    advancing 'pos', which must stay below 'end' */
+static qint64 readVarInt(const uchar *data, qint64 &pos, qint64 end)
+{
+    quint64 v = 0;
+    int shift = 0;
+
+    while (true)
+    {
+        if (pos >= end or shift > 63)
+            throw SireIO::parse_error( QObject::tr(
+                    "The compressed coordinates in the trajectory file are corrupt."),
+                        CODELOC );
+
+        const uchar byte = data[pos];
+        ++pos;
+
+        v |= quint64(byte & 0x7F) << shift;
+
+        if ((byte & 0x80) == 0)
+            break;
+
+        shift += 7;
+    }
+
+    return qint64(v >> 1) ^ -qint64(v & 1);
+}
+
+/** Return the size of the frame starting at 'offset' in the passed
+    data, or -1 if this is not a complete frame */
+static qint64 getFrameSize(const uchar *data, qint64 offset, qint64 size)
+{
+    if (offset + 13 > size or std::memcmp(data + offset, FRAME_MAGIC, 4) != 0)
+        return -1;
+
+    qint64 pos = offset + 8;
+
+    const bool has_box = data[pos] != 0;
+    pos += 1;
+
+    if (has_box)
+        pos += 9*8;
+
+    if (pos + 4 > size)
+        return -1;
+
+    const quint32 nbytes = readUInt32(data + pos);
+    pos += 4 + nbytes;
+
+    if (pos > size)
+        return -1;
+
+    return pos - offset;
+}
+
+/** Find the offsets of all of the frames in the file, using the index
+    if it is present, or otherwise by scanning through the file. This
+    returns the offset of the end of the last complete frame */
+static qint64 findFrames(const uchar *data, qint64 size, QVector<qint64> &offsets)
+{
+    offsets.clear();
+
+    //is there a valid index?
+    if (size >= HEADER_SIZE + TRAILER_SIZE + 8 and
+        std::memcmp(data + size - 8, TRAILER_MAGIC, 8) == 0)
+    {
+        const qint64 index_offset = readUInt64(data + size - TRAILER_SIZE);
+
+        if (index_offset >= HEADER_SIZE and index_offset + 8 <= size - TRAILER_SIZE and
+            std::memcmp(data + index_offset, INDEX_MAGIC, 4) == 0)
+        {
+            const quint32 nframes = readUInt32(data + index_offset + 4);
+
+            if (index_offset + 8 + 8*qint64(nframes) == size - TRAILER_SIZE)
+            {
+                offsets.reserve(nframes);
+
+                bool valid = true;
+
+                for (quint32 i=0; i<nframes; ++i)
+                {
+                    const quint64 offset = readUInt64(data + index_offset + 8 + 8*i);
+
+                    //each frame must be complete and lie before the index
+                    if (offset < quint64(HEADER_SIZE) or offset >= quint64(index_offset) or
+                        getFrameSize(data, offset, index_offset) <= 0)
+                    {
+                        valid = false;
+                        break;
+                    }
+
+                    offsets.append(offset);
+                }
+
+                if (valid)
+                    return index_offset;
+
+                //the index is corrupt, so ignore it
+                offsets.clear();
+            }
+        }
+    }
+
+    //no (valid) index, so scan through the frames
+    qint64 pos = HEADER_SIZE;
+
+    while (pos < size)
+    {
+        const qint64 frame_size = getFrameSize(data, pos, size);
+
+        if (frame_size <= 0)
+            break;
+
+        offsets.append(pos);
+        pos += frame_size;
+    }
+
+    return pos;
+}
+
+/** Read and check the header of the file, returning the precision */
+static double readHeader(const uchar *data, qint64 size, const QString &filename)
+{
+    if (size < HEADER_SIZE or std::memcmp(data, FILE_MAGIC, 8) != 0)
+        throw SireIO::parse_error( QObject::tr(
+                "The file \"%1\" is not a Sire binary trajectory file.")
+                    .arg(filename), CODELOC );
+
+    const quint32 version = readUInt32(data + 8);
+
+    if (version != FILE_VERSION)
+        throw SireIO::parse_error( QObject::tr(
+                "Cannot read version %1 of the binary trajectory format "
+                "from file \"%2\". Only version %3 is supported.")
+                    .arg(version).arg(filename).arg(FILE_VERSION), CODELOC );
+
+    return readDouble(data + 12);
+}
+
+/** Return the box vectors for the passed space, returning false
+    if this space has no box */
+static bool getBoxVectors(const Space &space, Vector &v0, Vector &v1, Vector &v2)
+{
+    if (space.isA<PeriodicBox>())
+    {
+        const Vector &dimensions = space.asA<PeriodicBox>().dimensions();
+        v0 = Vector(dimensions.x(), 0, 0);
+        v1 = Vector(0, dimensions.y(), 0);
+        v2 = Vector(0, 0, dimensions.z());
+        return true;
+    }
+    else if (space.isA<TriclinicBox>())
+    {
+        const TriclinicBox &box = space.asA<TriclinicBox>();
+        v0 = box.vector0();
+        v1 = box.vector1();
+        v2 = box.vector2();
+        return true;
+    }
+    else
+        return false;
+}
+
+/** Extract the coordinates of the molecules in 'molgroup', in the
+    order that they appear in the group */
+static QVector<Vector> getCoordinates(const MoleculeGroup &molgroup,
+                                      const PropertyMap &map)
+{
+    const PropertyName coords_property = map["coordinates"];
+
+    QVector<Vector> coords;
+
+    const int nmols = molgroup.nMolecules();
+
+    for (MolIdx i(0); i<nmols; ++i)
+    {
+        const ViewsOfMol &mol = molgroup[i];
+
+        coords += mol.data().property(coords_property)
+                            .asA<AtomCoords>().toVector(mol.selection());
+    }
+
+    return coords;
+}
+
+namespace SireIO
+{
+namespace detail
+{
+
+/** The private implementation of TrajectoryWriter, holding
+    the open file and the index of frames */
+class TrajectoryWriterData : public boost::noncopyable
+{
+public:
+    TrajectoryWriterData(const QString &filename, double precision);
+    ~TrajectoryWriterData();
+
+    void write(const QVector<Vector> &coords, const Space *space);
+
+    void close();
+
+    /** The file being written */
+    QFile f;
+
+    /** The offsets of each frame in the file */
+    QVector<qint64> offsets;
+
+    /** The offset at which the next frame will be written */
+    qint64 end;
+
+    /** The precision to which coordinates are rounded */
+    double precision;
+
+    /** The number of atoms in each frame (-1 if no frames have been written) */
+    int natoms;
+};
+
+/** The private implementation of TrajectoryReader, holding
+    the memory-mapped file and the index of frames */
+class TrajectoryReaderData : public boost::noncopyable
+{
+public:
+    TrajectoryReaderData(const QString &filename);
+    ~TrajectoryReaderData();
+
+    qint64 frameOffset(int i) const;
+
+    /** The mapped file */
+    QFile f;
+
+    /** Pointer to the mapped data */
+    uchar *data;
+
+    /** The size of the mapped data */
+    qint64 size;
+
+    /** The offsets of each frame in the file */
+    QVector<qint64> offsets;
+
+    /** The precision to which coordinates were rounded */
+    double precision;
+};
+
+} // end of namespace detail
+} // end of namespace SireIO
+
+/** Open the file 'filename', appending to it if it already exists */
+TrajectoryWriterData::TrajectoryWriterData(const QString &filename, double prec)
+                     : f(filename), end(0), precision(prec), natoms(-1)
+{
+    if (precision <= 0)
+        throw SireError::invalid_arg( QObject::tr(
+                "The precision used to compress a trajectory must be "
+                "positive (%1 is not valid).").arg(precision), CODELOC );
+
+    if (not f.open(QIODevice::ReadWrite))
+        throw SireError::file_error(f, CODELOC);
+
+    if (f.size() == 0)
+    {
+        //this is a new file - write the header
+        QByteArray header(FILE_MAGIC, 8);
+        appendUInt32(header, FILE_VERSION);
+        appendDouble(header, precision);
+
+        if (f.write(header) != header.count())
+            throw SireError::file_error(f, CODELOC);
+
+        end = HEADER_SIZE;
+    }
+    else
+    {
+        //this is an existing file - find the existing frames
+        //so that we can append to it
+        const qint64 size = f.size();
+        uchar *data = f.map(0, size);
+
+        if (data == 0)
+            throw SireError::file_error(f, CODELOC);
+
+        try
+        {
+            precision = readHeader(data, size, filename);
+            end = findFrames(data, size, offsets);
+
+            if (not offsets.isEmpty())
+                natoms = readUInt32(data + offsets.last() + 4);
+        }
+        catch(...)
+        {
+            f.unmap(data);
+            throw;
+        }
+
+        f.unmap(data);
+
+        //remove the index (or any incomplete frame) - this will
+        //be rewritten when the file is closed
+        if (end != size)
+        {
+            if (not f.resize(end))
+                throw SireError::file_error(f, CODELOC);
+        }
+    }
+}
+
+/** Destructor - this closes the file, writing the index */
+TrajectoryWriterData::~TrajectoryWriterData()
+{
+    try
+    {
+        this->close();
+    }
+    catch(...)
+    {}
+}
+
+/** Write the passed coordinates and (optional) space as a new frame */
+void TrajectoryWriterData::write(const QVector<Vector> &coords, const Space *space)
+{
+    if (not f.isOpen())
+        throw SireError::file_error( QObject::tr(
+                "Cannot write to the trajectory file \"%1\" as it has been closed.")
+                    .arg(f.fileName()), CODELOC );
+
+    if (natoms != -1 and coords.count() != natoms)
+        throw SireError::incompatible_error( QObject::tr(
+                "Cannot write a frame containing %1 atoms to the trajectory file "
+                "\"%2\", as the existing frames contain %3 atoms.")
+                    .arg(coords.count()).arg(f.fileName()).arg(natoms), CODELOC );
+
+    Vector v0, v1, v2;
+    const bool has_box = (space != 0) and ::getBoxVectors(*space, v0, v1, v2);
+
+    //compress the coordinates
+    QByteArray compressed;
+    compressed.reserve( 4 * 3 * coords.count() );
+
+    const double inv_precision = 1.0 / precision;
+
+    qint64 last[3] = { 0, 0, 0 };
+
+    for (int i=0; i<coords.count(); ++i)
+    {
+        const Vector &coord = coords.constData()[i];
+
+        for (int j=0; j<3; ++j)
+        {
+            const qint64 q = qint64( std::floor(coord[j] * inv_precision + 0.5) );
+            appendVarInt(compressed, q - last[j]);
+            last[j] = q;
+        }
+    }
+
+    QByteArray frame(FRAME_MAGIC, 4);
+    appendUInt32(frame, coords.count());
+    frame.append( char(has_box ? 1 : 0) );
+
+    if (has_box)
+    {
+        for (int j=0; j<3; ++j) appendDouble(frame, v0[j]);
+        for (int j=0; j<3; ++j) appendDouble(frame, v1[j]);
+        for (int j=0; j<3; ++j) appendDouble(frame, v2[j]);
+    }
+
+    appendUInt32(frame, compressed.count());
+    frame.append(compressed);
+
+    if (not f.seek(end))
+        throw SireError::file_error(f, CODELOC);
+
+    if (f.write(frame) != frame.count())
+        throw SireError::file_error( QObject::tr(
+                "There was a problem writing the trajectory frame to \"%1\". "
+                "Maybe the disk is full?").arg(f.fileName()), CODELOC );
+
+    offsets.append(end);
+    end += frame.count();
+    natoms = coords.count();
+}
+
+/** Close the file, writing the index of frames to the end of the file */
+void TrajectoryWriterData::close()
+{
+    if (not f.isOpen())
+        return;
+
+    QByteArray index(INDEX_MAGIC, 4);
+    appendUInt32(index, offsets.count());
+
+    foreach (qint64 offset, offsets)
+    {
+        appendUInt64(index, offset);
+    }
+
+    appendUInt64(index, end);
+    index.append(TRAILER_MAGIC, 8);
+
+    if (not f.seek(end))
+        throw SireError::file_error(f, CODELOC);
+
+    if (f.write(index) != index.count())
+        throw SireError::file_error(f, CODELOC);
+
+    f.close();
+}
+
+/** Memory-map the file 'filename' and find the frames */
+TrajectoryReaderData::TrajectoryReaderData(const QString &filename)
+                     : f(filename), data(0), size(0), precision(0)
+{
+    if (not f.open(QIODevice::ReadOnly))
+        throw SireError::file_error(f, CODELOC);
+
+    size = f.size();
+
+    if (size > 0)
+        data = f.map(0, size);
+
+    if (data == 0)
+        throw SireIO::parse_error( QObject::tr(
+                "Could not map the trajectory file \"%1\" into memory. "
+                "Is it empty?").arg(filename), CODELOC );
+
+    precision = readHeader(data, size, filename);
+    findFrames(data, size, offsets);
+}
+
+/** Destructor */
+TrajectoryReaderData::~TrajectoryReaderData()
+{
+    if (data != 0)
+        f.unmap(data);
+}
+
+/** Return the offset of the ith frame in the file
+
+    \throw SireError::invalid_index
+*/
+qint64 TrajectoryReaderData::frameOffset(int i) const
+{
+    return offsets.at( SireID::Index(i).map(offsets.count()) );
+}
+
+////////
+//////// Implementation of TrajectoryWriter
+////////
+
+/** Construct a null writer */
+TrajectoryWriter::TrajectoryWriter()
+{}
+
+/** Construct a writer that writes to the file 'filename', rounding
+    coordinates to 'precision' angstroms. If the file already exists then
+    new frames are appended to it (using the precision of the existing file)
+
+    \throw SireError::file_error
+    \throw SireIO::parse_error
+*/
+TrajectoryWriter::TrajectoryWriter(const QString &filename, double precision)
+                 : d( new TrajectoryWriterData(filename, precision) )
+{}
+
+/** Copy constructor - copies share the same file */
+TrajectoryWriter::TrajectoryWriter(const TrajectoryWriter &other)
+                 : d(other.d)
+{}
+
+/** Destructor - the file is closed when the last copy is deleted */
+TrajectoryWriter::~TrajectoryWriter()
+{}
+
+/** Copy assignment operator */
+TrajectoryWriter& TrajectoryWriter::operator=(const TrajectoryWriter &other)
+{
+    d = other.d;
+    return *this;
+}
+
+/** Comparison operator - writers are equal if they share the same file */
+bool TrajectoryWriter::operator==(const TrajectoryWriter &other) const
+{
+    return d == other.d;
+}
+
+/** Comparison operator */
+bool TrajectoryWriter::operator!=(const TrajectoryWriter &other) const
+{
+    return d != other.d;
+}
+
+const char* TrajectoryWriter::typeName()
+{
+    return "SireIO::TrajectoryWriter";
+}
+
+/** Return a string representation of this writer */
+QString TrajectoryWriter::toString() const
+{
+    if (isNull())
+        return QObject::tr("TrajectoryWriter::null");
+    else
+        return QObject::tr("TrajectoryWriter( %1, nFrames() == %2 )")
+                    .arg(filename()).arg(nFrames());
+}
+
+/** Return whether or not this is a null writer */
+bool TrajectoryWriter::isNull() const
+{
+    return d.get() == 0;
+}
+
+/** Return the name of the file being written */
+QString TrajectoryWriter::filename() const
+{
+    if (isNull())
+        return QString::null;
+    else
+        return d->f.fileName();
+}
+
+/** Return the precision (in angstroms) to which coordinates are rounded */
+double TrajectoryWriter::precision() const
+{
+    if (isNull())
+        return 0;
+    else
+        return d->precision;
+}
+
+/** Return the number of frames in the file */
+int TrajectoryWriter::nFrames() const
+{
+    if (isNull())
+        return 0;
+    else
+        return d->offsets.count();
+}
+
+/** Return the number of atoms in each frame (0 if no frames have
+    yet been written) */
+int TrajectoryWriter::nAtoms() const
+{
+    if (isNull())
+        return 0;
+    else
+        return qMax(0, d->natoms);
+}
+
+static void assertNotNull(const TrajectoryWriter &writer)
+{
+    if (writer.isNull())
+        throw SireError::nullptr_error( QObject::tr(
+                "Cannot write to a null TrajectoryWriter."), CODELOC );
+}
+
+/** Write a frame containing the passed coordinates, without
+    any periodic box
+
+    \throw SireError::incompatible_error
+    \throw SireError::file_error
+*/
+void TrajectoryWriter::write(const QVector<Vector> &coordinates)
+{
+    assertNotNull(*this);
+    d->write(coordinates, 0);
+}
+
+/** Write a frame containing the passed coordinates and the box vectors
+    of the passed space (only PeriodicBox and TriclinicBox spaces have
+    box vectors)
+
+    \throw SireError::incompatible_error
+    \throw SireError::file_error
+*/
+void TrajectoryWriter::write(const QVector<Vector> &coordinates, const Space &space)
+{
+    assertNotNull(*this);
+    d->write(coordinates, &space);
+}
+
+/** Write a frame containing the coordinates of the molecules in 'molgroup',
+    using the passed property map to find the coordinates property
+
+    \throw SireError::incompatible_error
+    \throw SireError::file_error
+*/
+void TrajectoryWriter::write(const MoleculeGroup &molgroup, const PropertyMap &map)
+{
+    assertNotNull(*this);
+    d->write( ::getCoordinates(molgroup, map), 0 );
+}
+
+/** Write a frame containing the coordinates of the molecules in 'molgroup'
+    and the box vectors of 'space', using the passed property map to find
+    the coordinates property
+
+    \throw SireError::incompatible_error
+    \throw SireError::file_error
+*/
+void TrajectoryWriter::write(const MoleculeGroup &molgroup, const Space &space,
+                             const PropertyMap &map)
+{
+    assertNotNull(*this);
+    d->write( ::getCoordinates(molgroup, map), &space );
+}
+
+/** Flush all written frames to disk */
+void TrajectoryWriter::flush()
+{
+    if (not isNull())
+        d->f.flush();
+}
+
+/** Close the file, writing the index of frames. No more frames
+    can be written after the file is closed */
+void TrajectoryWriter::close()
+{
+    if (not isNull())
+        d->close();
+}
+
+////////
+//////// Implementation of TrajectoryReader
+////////
+
+/** Construct a null reader */
+TrajectoryReader::TrajectoryReader()
+{}
+
+/** Construct a reader for the trajectory in 'filename'
+
+    \throw SireError::file_error
+    \throw SireIO::parse_error
+*/
+TrajectoryReader::TrajectoryReader(const QString &filename)
+                 : d( new TrajectoryReaderData(filename) )
+{}
+
+/** Copy constructor */
+TrajectoryReader::TrajectoryReader(const TrajectoryReader &other)
+                 : d(other.d)
+{}
+
+/** Destructor */
+TrajectoryReader::~TrajectoryReader()
+{}
+
+/** Copy assignment operator */
+TrajectoryReader& TrajectoryReader::operator=(const TrajectoryReader &other)
+{
+    d = other.d;
+    return *this;
+}
+
+/** Comparison operator */
+bool TrajectoryReader::operator==(const TrajectoryReader &other) const
+{
+    return d == other.d;
+}
+
+/** Comparison operator */
+bool TrajectoryReader::operator!=(const TrajectoryReader &other) const
+{
+    return d != other.d;
+}
+
+const char* TrajectoryReader::typeName()
+{
+    return "SireIO::TrajectoryReader";
+}
+
+/** Return a string representation of this reader */
+QString TrajectoryReader::toString() const
+{
+    if (isNull())
+        return QObject::tr("TrajectoryReader::null");
+    else
+        return QObject::tr("TrajectoryReader( %1, nFrames() == %2 )")
+                    .arg(filename()).arg(nFrames());
+}
+
+/** Return whether or not this is a null reader */
+bool TrajectoryReader::isNull() const
+{
+    return d.get() == 0;
+}
+
+/** Return the name of the file being read */
+QString TrajectoryReader::filename() const
+{
+    if (isNull())
+        return QString::null;
+    else
+        return d->f.fileName();
+}
+
+/** Return the precision (in angstroms) to which the coordinates were rounded */
+double TrajectoryReader::precision() const
+{
+    if (isNull())
+        return 0;
+    else
+        return d->precision;
+}
+
+/** Return the number of frames in the trajectory */
+int TrajectoryReader::nFrames() const
+{
+    if (isNull())
+        return 0;
+    else
+        return d->offsets.count();
+}
+
+/** Return the number of frames in the trajectory */
+int TrajectoryReader::count() const
+{
+    return nFrames();
+}
+
+/** Return the number of frames in the trajectory */
+int TrajectoryReader::size() const
+{
+    return nFrames();
+}
+
+/** Return the number of atoms in each frame */
+int TrajectoryReader::nAtoms() const
+{
+    if (nFrames() == 0)
+        return 0;
+    else
+        return readUInt32( d->data + d->offsets.at(0) + 4 );
+}
+
+/** Return the coordinates of the ith frame
+
+    \throw SireError::invalid_index
+    \throw SireIO::parse_error
+*/
+QVector<Vector> TrajectoryReader::coordinates(int i) const
+{
+    if (isNull())
+        throw SireError::invalid_index( QObject::tr(
+                "Cannot read frame %1 from a null TrajectoryReader.").arg(i), CODELOC );
+
+    const uchar *data = d->data;
+    qint64 pos = d->frameOffset(i);
+
+    const quint32 nats = readUInt32(data + pos + 4);
+    const bool has_box = data[pos+8] != 0;
+
+    pos += 9;
+
+    if (has_box)
+        pos += 9*8;
+
+    const quint32 nbytes = readUInt32(data + pos);
+    pos += 4;
+
+    const qint64 end = pos + nbytes;
+
+    if (end > d->size)
+        throw SireIO::parse_error( QObject::tr(
+                "Frame %1 of the trajectory file \"%2\" is truncated.")
+                    .arg(i).arg(filename()), CODELOC );
+
+    QVector<Vector> coords(nats);
+    Vector *coords_array = coords.data();
+
+    const double precision = d->precision;
+
+    qint64 last[3] = { 0, 0, 0 };
+
+    for (quint32 j=0; j<nats; ++j)
+    {
+        for (int k=0; k<3; ++k)
+        {
+            last[k] += readVarInt(data, pos, end);
+        }
+
+        coords_array[j] = Vector( last[0]*precision, last[1]*precision,
+                                  last[2]*precision );
+    }
+
+    return coords;
+}
+
+/** Return the coordinates of the ith frame */
+QVector<Vector> TrajectoryReader::operator[](int i) const
+{
+    return coordinates(i);
+}
+
+/** Return the coordinates of the ith frame */
+QVector<Vector> TrajectoryReader::at(int i) const
+{
+    return coordinates(i);
+}
+
+/** Return whether or not the ith frame has a periodic box */
+bool TrajectoryReader::hasSpace(int i) const
+{
+    if (isNull())
+        throw SireError::invalid_index( QObject::tr(
+                "Cannot read frame %1 from a null TrajectoryReader.").arg(i), CODELOC );
+
+    return d->data[ d->frameOffset(i) + 8 ] != 0;
+}
+
+/** Return the space of the ith frame. This is a PeriodicBox if the
+    box vectors lie along the x, y and z axes, a TriclinicBox if they
+    do not, and an infinite Cartesian space if the frame has no box */
+SpacePtr TrajectoryReader::space(int i) const
+{
+    if (not hasSpace(i))
+        return Cartesian();
+
+    const uchar *data = d->data + d->frameOffset(i) + 9;
+
+    Vector v[3];
+
+    for (int j=0; j<3; ++j)
+    {
+        v[j] = Vector( readDouble(data), readDouble(data+8), readDouble(data+16) );
+        data += 24;
+    }
+
+    if (v[0].y() == 0 and v[0].z() == 0 and
+        v[1].x() == 0 and v[1].z() == 0 and
+        v[2].x() == 0 and v[2].y() == 0)
+    {
+        return PeriodicBox( Vector(v[0].x(), v[1].y(), v[2].z()) );
+    }
+    else
+        return TriclinicBox(v[0], v[1], v[2]);
+}
+
+/** Return a copy of 'molgroup' where the coordinates of the molecules
+    are set equal to those in the ith frame. This assumes that 'molgroup'
+    contains the same molecules (in the same order) as the group that
+    was used to write the trajectory
+
+    \throw SireError::invalid_index
+    \throw SireError::incompatible_error
+*/
+MoleculeGroup TrajectoryReader::frame(int i, const MoleculeGroup &molgroup,
+                                      const PropertyMap &map) const
+{
+    const QVector<Vector> coords = this->coordinates(i);
+
+    const PropertyName coords_property = map["coordinates"];
+
+    MoleculeGroup new_group(molgroup);
+
+    const int nmols = molgroup.nMolecules();
+    int offset = 0;
+
+    for (MolIdx j(0); j<nmols; ++j)
+    {
+        const ViewsOfMol &mol = molgroup[j];
+        const AtomSelection selection = mol.selection();
+        const int nats = selection.nSelected();
+
+        if (offset + nats > coords.count())
+            throw SireError::incompatible_error( QObject::tr(
+                    "The molecule group %1 contains more atoms than there are "
+                    "in frame %2 of the trajectory (%3).")
+                        .arg(molgroup.toString()).arg(i).arg(coords.count()), CODELOC );
+
+        AtomCoords mol_coords = mol.data().property(coords_property).asA<AtomCoords>();
+        mol_coords.copyFrom( coords.mid(offset, nats), selection );
+        offset += nats;
+
+        Molecule new_mol = mol.molecule().edit()
+                                .setProperty(coords_property, mol_coords)
+                                .commit();
+
+        new_group.update(new_mol);
+    }
+
+    if (offset != coords.count())
+        throw SireError::incompatible_error( QObject::tr(
+                "The molecule group %1 contains %2 atoms, while frame %3 of the "
+                "trajectory contains %4 atoms.")
+                    .arg(molgroup.toString()).arg(offset).arg(i).arg(coords.count()),
+                        CODELOC );
+
+    return new_group;
+}
@@ -0,0 +1,201 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#ifndef SIREIO_TRAJECTORYFILE_H
+#define SIREIO_TRAJECTORYFILE_H
+
+#include <QString>
+#include <QVector>
+
+#include <boost/shared_ptr.hpp>
+
+#include "SireMaths/vector.h"
+
+#include "SireVol/space.h"
+
+#include "SireMol/moleculegroup.h"
+
+#include "SireBase/propertymap.h"
+
+SIRE_BEGIN_HEADER
+
+namespace SireIO
+{
+
+namespace detail
+{
+class TrajectoryWriterData;
+class TrajectoryReaderData;
+}
+
+using SireMaths::Vector;
+
+using SireMol::MoleculeGroup;
+
+using SireBase::PropertyMap;
+
+/** This class writes a binary, compressed trajectory file. Each frame
+    holds the coordinates of a fixed number of atoms, together with the
+    (optional) periodic box vectors. Frames are appended one at a time to
+    a single file, so this is suitable for streaming very long trajectories
+    to disk during a simulation.
+
+    The coordinates are compressed by rounding them to a fixed precision
+    (by default 0.001 A), and then storing the difference between
+    consecutive atoms as variable-length integers. This typically uses
+    less than half of the space of single precision floats, and
+    a tiny fraction of the space of a PDB file.
+
+    An index of the frames is written to the end of the file when
+    the writer is closed, allowing fast random access by TrajectoryReader.
+    Opening an existing file will append new frames to it.
+
+    Copies of a writer share the same file (so this is explicitly shared).
+    The file is closed when the last copy is deleted.
+
+    @author Christopher Woods
+*/
+class SIREIO_EXPORT TrajectoryWriter
+{
+public:
+    TrajectoryWriter();
+    TrajectoryWriter(const QString &filename, double precision=0.001);
+
+    TrajectoryWriter(const TrajectoryWriter &other);
+
+    ~TrajectoryWriter();
+
+    TrajectoryWriter& operator=(const TrajectoryWriter &other);
+
+    bool operator==(const TrajectoryWriter &other) const;
+    bool operator!=(const TrajectoryWriter &other) const;
+
+    static const char* typeName();
+
+    const char* what() const
+    {
+        return TrajectoryWriter::typeName();
+    }
+
+    QString toString() const;
+
+    bool isNull() const;
+
+    QString filename() const;
+
+    double precision() const;
+
+    int nFrames() const;
+    int nAtoms() const;
+
+    void write(const QVector<Vector> &coordinates);
+    void write(const QVector<Vector> &coordinates, const SireVol::Space &space);
+
+    void write(const MoleculeGroup &molgroup,
+               const PropertyMap &map = PropertyMap());
+
+    void write(const MoleculeGroup &molgroup, const SireVol::Space &space,
+               const PropertyMap &map = PropertyMap());
+
+    void flush();
+    void close();
+
+private:
+    /** Shared pointer to the open file */
+    boost::shared_ptr<detail::TrajectoryWriterData> d;
+};
+
+/** This class reads a binary trajectory file written by
+    TrajectoryWriter. The file is memory-mapped, and the index
+    at the end of the file is used to give constant-time random
+    access to any frame. If the file does not have an index (e.g.
+    because the simulation writing it was killed) then the frames
+    are found by scanning through the file.
+
+    @author Christopher Woods
+*/
+class SIREIO_EXPORT TrajectoryReader
+{
+public:
+    TrajectoryReader();
+    TrajectoryReader(const QString &filename);
+
+    TrajectoryReader(const TrajectoryReader &other);
+
+    ~TrajectoryReader();
+
+    TrajectoryReader& operator=(const TrajectoryReader &other);
+
+    bool operator==(const TrajectoryReader &other) const;
+    bool operator!=(const TrajectoryReader &other) const;
+
+    static const char* typeName();
+
+    const char* what() const
+    {
+        return TrajectoryReader::typeName();
+    }
+
+    QString toString() const;
+
+    bool isNull() const;
+
+    QString filename() const;
+
+    double precision() const;
+
+    int count() const;
+    int size() const;
+
+    int nFrames() const;
+    int nAtoms() const;
+
+    QVector<Vector> operator[](int i) const;
+    QVector<Vector> at(int i) const;
+
+    QVector<Vector> coordinates(int i) const;
+
+    bool hasSpace(int i) const;
+    SireVol::SpacePtr space(int i) const;
+
+    MoleculeGroup frame(int i, const MoleculeGroup &molgroup,
+                        const PropertyMap &map = PropertyMap()) const;
+
+private:
+    /** Shared pointer to the mapped file */
+    boost::shared_ptr<detail::TrajectoryReaderData> d;
+};
+
+}
+
+SIRE_EXPOSE_CLASS( SireIO::TrajectoryWriter )
+SIRE_EXPOSE_CLASS( SireIO::TrajectoryReader )
+
+SIRE_END_HEADER
+
+#endif
@@ -148,7 +148,7 @@ static QPair< QString,shared_ptr<QTemporaryFile> >
 QDataStream SIREIO_EXPORT &operator<<(QDataStream &ds, 
                                       const TrajectoryMonitor &trajmon)
 {
-    writeHeader(ds, r_trajmon, 2);
+    writeHeader(ds, r_trajmon, 3);
     
     SharedDataStream sds(ds);
     
@@ -171,6 +171,7 @@ QDataStream SIREIO_EXPORT &operator<<(QDataStream &ds,
     }
    
     sds << trajmon.space_frames
+        << trajmon.traj_file << trajmon.traj_precision
         << static_cast<const SystemMonitor&>(trajmon);
         
     return ds;
@@ -181,7 +182,7 @@ QDataStream SIREIO_EXPORT &operator>>(QDataStream &ds, TrajectoryMonitor &trajmo
 {
     VersionID v = readHeader(ds, r_trajmon);
     
-    if (v == 1 or v == 2)
+    if (v == 1 or v == 2 or v == 3)
     {
         SharedDataStream sds(ds);
         
@@ -189,7 +190,7 @@ QDataStream SIREIO_EXPORT &operator>>(QDataStream &ds, TrajectoryMonitor &trajmo
         
         sds >> new_monitor.io_writer;
         
-        if (v == 2)
+        if (v >= 2)
         {
             sds >> new_monitor.mgid;
         }
@@ -216,20 +217,25 @@ QDataStream SIREIO_EXPORT &operator>>(QDataStream &ds, TrajectoryMonitor &trajmo
             new_monitor.traj_frames.append( ::writeToDisk(data, new_monitor.temp_dir) );
         }
             
-        sds >> new_monitor.space_frames
-            >> static_cast<SystemMonitor&>(new_monitor);
+        sds >> new_monitor.space_frames;
+        
+        if (v == 3)
+            sds >> new_monitor.traj_file >> new_monitor.traj_precision;
+            
+        sds >> static_cast<SystemMonitor&>(new_monitor);
         
         trajmon = new_monitor;
     }
     else
-        throw version_error(v, "1,2", r_trajmon, CODELOC);
+        throw version_error(v, "1,2,3", r_trajmon, CODELOC);
         
     return ds;
 }
 
 /** Null constructor */
 TrajectoryMonitor::TrajectoryMonitor()
-                  : ConcreteProperty<TrajectoryMonitor,SystemMonitor>()
+                  : ConcreteProperty<TrajectoryMonitor,SystemMonitor>(),
+                    traj_precision(0.001)
 {}
 
 /** Construct a monitor that monitors the trajectory of the molecules  
@@ -240,7 +246,7 @@ TrajectoryMonitor::TrajectoryMonitor(const MoleculeGroup &molgroup,
                                      const PropertyMap &map)
                   : ConcreteProperty<TrajectoryMonitor,SystemMonitor>(),
                     io_writer( PDB() ), mgid(molgroup.number()),
-                    mol_properties(map)
+                    mol_properties(map), traj_precision(0.001)
 {}
 
 /** Construct a monitor that monitors the trajectory of the molecules in 
@@ -251,7 +257,8 @@ TrajectoryMonitor::TrajectoryMonitor(const MoleculeGroup &molgroup,
                                      const IOBase &writer,
                                      const PropertyMap &map)
                   : ConcreteProperty<TrajectoryMonitor,SystemMonitor>(),
-                    io_writer(writer), mgid(molgroup.number()), mol_properties(map)
+                    io_writer(writer), mgid(molgroup.number()), mol_properties(map),
+                    traj_precision(0.001)
 {}
 
 /** Construct a monitor that monitors the trajectory of the molecules  
@@ -262,7 +269,7 @@ TrajectoryMonitor::TrajectoryMonitor(const MGID &mg_id,
                                      const PropertyMap &map)
                   : ConcreteProperty<TrajectoryMonitor,SystemMonitor>(),
                     io_writer( PDB() ), mgid(mg_id),
-                    mol_properties(map)
+                    mol_properties(map), traj_precision(0.001)
 {}
 
 /** Construct a monitor that monitors the trajectory of the molecules in 
@@ -273,7 +280,8 @@ TrajectoryMonitor::TrajectoryMonitor(const MGID &mg_id,
                                      const IOBase &writer,
                                      const PropertyMap &map)
                   : ConcreteProperty<TrajectoryMonitor,SystemMonitor>(),
-                    io_writer(writer), mgid(mg_id), mol_properties(map)
+                    io_writer(writer), mgid(mg_id), mol_properties(map),
+                    traj_precision(0.001)
 {}
 
 /** Copy constructor */
@@ -281,7 +289,9 @@ TrajectoryMonitor::TrajectoryMonitor(const TrajectoryMonitor &other)
                   : ConcreteProperty<TrajectoryMonitor,SystemMonitor>(other),
                     io_writer(other.io_writer), mgid(other.mgid),
                     traj_frames(other.traj_frames), space_frames(other.space_frames),
-                    mol_properties(other.mol_properties), temp_dir(other.temp_dir)
+                    mol_properties(other.mol_properties), temp_dir(other.temp_dir),
+                    traj_file(other.traj_file), traj_precision(other.traj_precision),
+                    traj_writer(other.traj_writer)
 {}
 
 /** Destructor */
@@ -299,6 +309,9 @@ TrajectoryMonitor& TrajectoryMonitor::operator=(const TrajectoryMonitor &other)
     mol_properties = other.mol_properties;
     space_frames = other.space_frames;
     temp_dir = other.temp_dir;
+    traj_file = other.traj_file;
+    traj_precision = other.traj_precision;
+    traj_writer = other.traj_writer;
     
     return *this;
 }
@@ -311,6 +324,8 @@ bool TrajectoryMonitor::operator==(const TrajectoryMonitor &other) const
             mgid == other.mgid and
             mol_properties == other.mol_properties and
             temp_dir == other.temp_dir and
+            traj_file == other.traj_file and
+            traj_precision == other.traj_precision and
             traj_frames == other.traj_frames and
             space_frames == other.space_frames and 
             SystemMonitor::operator==(other));
@@ -329,6 +344,29 @@ void TrajectoryMonitor::setTempDir(const QString &tempdir)
     temp_dir = tempdir;
 }
 
+/** Tell this monitor to write each frame directly to the binary
+    trajectory file 'filename', rounding the coordinates to 'precision'
+    angstroms. This is much quicker, and uses much less space, than
+    writing each frame using a molecule writer. Frames are appended
+    to the file if it already exists. Pass an empty filename to
+    switch back to writing frames using the molecule writer */
+void TrajectoryMonitor::setTrajectoryFile(const QString &filename, double precision)
+{
+    if (filename != traj_file or precision != traj_precision)
+    {
+        traj_writer = TrajectoryWriter();
+        traj_file = filename;
+        traj_precision = precision;
+    }
+}
+
+/** Return the name of the binary trajectory file to which frames
+    are written (this is empty if the molecule writer is used) */
+QString TrajectoryMonitor::trajectoryFile() const
+{
+    return traj_file;
+}
+
 static QString getFrameNumber(int i, int n)
 {
     if (n == 1)
@@ -363,9 +401,33 @@ static int nColumns(int n)
 
 /** Write the trajectory to disk, using the file template 'file_template'. 
     This writes each frame to a separate file, numbering them sequentially
-    from 0, replacing "XXXXXX" with the frame number */
+    from 0, replacing "XXXXXX" with the frame number. If a binary 
+    trajectory file is being used, then this closes the file (writing
+    the frame index) and then copies it to 'file_template' */
 void TrajectoryMonitor::writeToDisk(const QString &file_template) const
 {
+    if (not traj_file.isEmpty())
+    {
+        //closing the writer writes the index - any further frames
+        //will be appended when the file is next opened
+        traj_writer.close();
+        traj_writer = TrajectoryWriter();
+        
+        if (QFileInfo(file_template).absoluteFilePath() != 
+                                QFileInfo(traj_file).absoluteFilePath())
+        {
+            if (QFile::exists(file_template))
+                QFile::remove(file_template);
+                
+            if (not QFile::copy(traj_file, file_template))
+                throw SireError::file_error( QObject::tr(
+                    "Could not copy the trajectory file \"%1\" to \"%2\".")
+                        .arg(traj_file, file_template), CODELOC );
+        }
+        
+        return;
+    }
+
     int nframes = traj_frames.count();
     int i = 0;
     int n = nColumns(nframes);
@@ -449,13 +511,19 @@ void TrajectoryMonitor::clearStatistics()
 {
     traj_frames.clear();
     space_frames.clear();
+    
+    if (not traj_file.isEmpty())
+    {
+        traj_writer = TrajectoryWriter();
+        QFile::remove(traj_file);
+    }
 }
 
 /** Monitor the system, writing an additional frame of the trajectory
     to this monitor */
 void TrajectoryMonitor::monitor(System &system)
 {
-    if (io_writer.isNull())
+    if (io_writer.isNull() and traj_file.isEmpty())
         //there is nothing to write
         return;
 
@@ -463,6 +531,34 @@ void TrajectoryMonitor::monitor(System &system)
     {
         const MoleculeGroup &new_group = system[mgid];
         
+        if (not traj_file.isEmpty())
+        {
+            //append the coordinates and box directly to the binary trajectory
+            SpacePtr space;
+            
+            const PropertyName &space_property = mol_properties["space"];
+            
+            if (space_property.hasSource())
+            {
+                if (system.containsProperty(space_property.source()))
+                    space = system.property(space_property.source());
+            }
+            else if (space_property.hasValue())
+                space = space_property.value();
+        
+            if (traj_writer.isNull())
+                traj_writer = TrajectoryWriter(traj_file, traj_precision);
+                
+            if (space.isNull())
+                traj_writer.write(new_group, mol_properties);
+            else
+                traj_writer.write(new_group, space.read(), mol_properties);
+                
+            traj_writer.flush();
+            
+            return;
+        }
+        
         //write a new frame
         QByteArray frame_data = io_writer->write(new_group, mol_properties);
             
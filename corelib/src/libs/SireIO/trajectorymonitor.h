@@ -42,6 +42,7 @@
 #include "SireBase/propertymap.h"
 
 #include "iobase.h"
+#include "trajectoryfile.h"
 
 SIRE_BEGIN_HEADER
 
@@ -67,7 +68,13 @@ using SireMol::MGID;
 using SireBase::PropertyMap;
 
 /** This is a monitor that can be used to save a trajectory
-    of an arbitrary collection of molecules from the system
+    of an arbitrary collection of molecules from the system.
+    
+    By default each frame is written using a molecule writer (e.g. PDB)
+    and saved to a temporary file until writeToDisk is called. Call
+    setTrajectoryFile to instead stream the coordinates and box vectors
+    directly to a single, compressed binary trajectory file
+    (see TrajectoryWriter)
     
     @author Christopher Woods
 */
@@ -109,6 +116,10 @@ public:
     
     void setTempDir(const QString &tempdir);
     
+    void setTrajectoryFile(const QString &filename, double precision=0.001);
+    
+    QString trajectoryFile() const;
+    
     void writeToDisk(const QString &file_template) const;
     
 private:
@@ -131,6 +142,18 @@ private:
     
     /** Name of the directory in which to save the temporary files */
     QString temp_dir;
+    
+    /** Name of the binary trajectory file to which frames are
+        written directly (empty if frames are written using 'io_writer') */
+    QString traj_file;
+    
+    /** The precision with which coordinates are written to 'traj_file' */
+    double traj_precision;
+    
+    /** The writer that is used to append frames to 'traj_file'. This
+        is mutable as the const writeToDisk() closes the writer so that
+        the frame index is written, which doesn't change the trajectory */
+    mutable TrajectoryWriter traj_writer;
 };
 
 }
@@ -0,0 +1,872 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#include "bondedterms.h"
+
+#include "SireCAS/expressionbase.h"
+#include "SireCAS/constant.h"
+#include "SireCAS/sum.h"
+#include "SireCAS/product.h"
+#include "SireCAS/powerconstant.h"
+#include "SireCAS/trigfuncs.h"
+#include "SireCAS/function.h"
+#include "SireCAS/values.h"
+
+#include "SireMaths/maths.h"
+
+#include "SireError/errors.h"
+
+#include "tostring.h"
+
+#include <QVarLengthArray>
+#include <QObject>
+
+#include <cmath>
+
+using namespace SireMM;
+using namespace SireCAS;
+
+/** The maximum degree of polynomial that is recognised */
+static const int MAX_BONDED_POLY_DEGREE = BondedTerms::MAX_DEGREE;
+
+/** A single cosine, k cos(n x + phase) */
+class CosineTerm
+{
+public:
+    double k;
+    double n;
+    double phase;
+};
+
+/////////
+///////// Functions used to recognise the functional forms
+/////////
+
+/** Return whether or not 'base' is the symbol 'x' (and not a function of x) */
+static bool isSymbol(const ExpressionBase &base, const Symbol &x)
+{
+    return base.isA<Symbol>() and (not base.isA<Function>()) and
+           base.asA<Symbol>() == x;
+}
+
+/** Return the constant part of 'sum' (the part that is not
+    in any of its children). This is found by evaluating the sum
+    and its children with all symbols equal to zero */
+static double getConstant(const Sum &sum)
+{
+    Values zero;
+
+    double v = sum.evaluate(zero);
+
+    foreach (const Expression &child, sum.children())
+    {
+        v -= child.evaluate(zero);
+    }
+
+    return v;
+}
+
+/** Return the constant factor of 'product' (the part that is not
+    in any of its children). This is found by evaluating the product
+    and its children with the symbol 'x' equal to 'val' */
+static bool getConstant(const Product &product, const Symbol &x, double val,
+                        double &constant)
+{
+    Values vals;
+    vals.set(x, val);
+
+    double denom = 1;
+
+    foreach (const Expression &child, product.children())
+    {
+        denom *= child.evaluate(vals);
+    }
+
+    if (denom == 0)
+        return false;
+
+    constant = product.evaluate(vals) / denom;
+    return true;
+}
+
+/** Recognise 'ex' as being a linear function of 'x', adding the
+    coefficients onto 'a' and 'b' for a x + b */
+static bool getLinear(const Expression &ex, const Symbol &x, double &a, double &b)
+{
+    const ExpressionBase &base = ex.base();
+    const double fac = ex.factor();
+
+    if (base.isA<Constant>())
+    {
+        b += fac;
+        return true;
+    }
+    else if (isSymbol(base, x))
+    {
+        a += fac;
+        return true;
+    }
+    else if (base.isA<Sum>())
+    {
+        const Sum &sum = base.asA<Sum>();
+
+        double sum_a = 0;
+        double sum_b = getConstant(sum);
+
+        foreach (const Expression &child, sum.children())
+        {
+            if (not getLinear(child, x, sum_a, sum_b))
+                return false;
+        }
+
+        a += fac * sum_a;
+        b += fac * sum_b;
+
+        return true;
+    }
+    else
+        return false;
+}
+
+/** Recognise 'ex' as a cosine of a linear function of 'x', returning
+    the cosine in 'cosine'. Sines are also recognised, as
+    sin(y) == cos(y - pi/2) */
+static bool getCosine(const Expression &ex, const Symbol &x, CosineTerm &cosine)
+{
+    const ExpressionBase &base = ex.base();
+
+    double a = 0;
+    double b = 0;
+
+    if (base.isA<Cos>())
+    {
+        if (not getLinear(base.asA<Cos>().x(), x, a, b))
+            return false;
+    }
+    else if (base.isA<Sin>())
+    {
+        if (not getLinear(base.asA<Sin>().x(), x, a, b))
+            return false;
+
+        b -= SireMaths::pi_over_two;
+    }
+    else
+        return false;
+
+    cosine.k = ex.factor();
+    cosine.n = a;
+    cosine.phase = b;
+
+    return true;
+}
+
+/** Recognise 'ex' as a cosine series in 'x', adding the constant
+    part onto 'v0' and the cosines onto 'terms' (each scaled by 'scale') */
+static bool getCosineSeries(const Expression &ex, const Symbol &x, double scale,
+                            double &v0, QVector<CosineTerm> &terms)
+{
+    const ExpressionBase &base = ex.base();
+    const double fac = scale * ex.factor();
+
+    if (base.isA<Constant>())
+    {
+        v0 += fac;
+        return true;
+    }
+    else if (base.isA<Cos>() or base.isA<Sin>())
+    {
+        CosineTerm cosine;
+
+        if (not getCosine(ex, x, cosine))
+            return false;
+
+        cosine.k *= scale;
+        terms.append(cosine);
+        return true;
+    }
+    else if (base.isA<Sum>())
+    {
+        const Sum &sum = base.asA<Sum>();
+
+        foreach (const Expression &child, sum.children())
+        {
+            if (not getCosineSeries(child, x, fac, v0, terms))
+                return false;
+        }
+
+        v0 += fac * getConstant(sum);
+
+        return true;
+    }
+    else
+        return false;
+}
+
+/** The variable of a polynomial - this is either the symbol 'x'
+    itself, or a cosine of a linear function of 'x' */
+class PolynomialVariable
+{
+public:
+    PolynomialVariable(const Symbol &symbol, bool cosine)
+          : x(symbol), is_cosine(cosine), has_cosine(false), a(0), b(0)
+    {}
+
+    bool matches(const Expression &ex)
+    {
+        if (not is_cosine)
+            return isSymbol(ex.base(), x);
+
+        CosineTerm cosine;
+
+        if (not (ex.base().isA<Cos>() and getCosine(ex, x, cosine)))
+            return false;
+
+        if (not has_cosine)
+        {
+            has_cosine = true;
+            a = cosine.n;
+            b = cosine.phase;
+            return true;
+        }
+        else
+            //all of the cosines must have the same argument
+            return a == cosine.n and b == cosine.phase;
+    }
+
+    Symbol x;
+    bool is_cosine;
+    bool has_cosine;
+    double a;
+    double b;
+};
+
+/** Multiply the polynomial 'p' by 'q' */
+static bool multiply(QVector<double> &p, const QVector<double> &q)
+{
+    if (p.count() + q.count() - 1 > MAX_BONDED_POLY_DEGREE + 1)
+        return false;
+
+    QVector<double> r(p.count() + q.count() - 1, 0.0);
+
+    for (int i=0; i<p.count(); ++i)
+    {
+        for (int j=0; j<q.count(); ++j)
+        {
+            r[i+j] += p[i] * q[j];
+        }
+    }
+
+    p = r;
+    return true;
+}
+
+/** Add 'scale' times the polynomial 'q' onto 'p' */
+static void add(QVector<double> &p, const QVector<double> &q, double scale)
+{
+    if (q.count() > p.count())
+        p.resize(q.count());
+
+    for (int i=0; i<q.count(); ++i)
+    {
+        p[i] += scale * q[i];
+    }
+}
+
+/** Recognise 'ex' as a polynomial in the variable 'var', returning the
+    coefficients in 'coeffs' */
+static bool getPolynomial(const Expression &ex, PolynomialVariable &var,
+                          QVector<double> &coeffs)
+{
+    const ExpressionBase &base = ex.base();
+    const double fac = ex.factor();
+
+    coeffs.clear();
+
+    if (base.isA<Constant>())
+    {
+        coeffs.append(fac);
+        return true;
+    }
+    else if (var.matches( Expression(base) ))
+    {
+        coeffs.append(0);
+        coeffs.append(fac);
+        return true;
+    }
+    else if (base.isA<Sum>())
+    {
+        const Sum &sum = base.asA<Sum>();
+
+        coeffs.append( fac * getConstant(sum) );
+
+        foreach (const Expression &child, sum.children())
+        {
+            QVector<double> part;
+
+            if (not getPolynomial(child, var, part))
+                return false;
+
+            add(coeffs, part, fac);
+        }
+
+        return true;
+    }
+    else if (base.isA<Product>())
+    {
+        const Product &product = base.asA<Product>();
+
+        //the product must only contain polynomials (so no denominator)
+        double constant;
+
+        if (not getConstant(product, var.x, 1.2345, constant))
+            return false;
+
+        coeffs.append(fac * constant);
+
+        foreach (const Expression &child, product.children())
+        {
+            QVector<double> part;
+
+            if (not getPolynomial(child, var, part))
+                return false;
+
+            if (not multiply(coeffs, part))
+                return false;
+        }
+
+        return true;
+    }
+    else if (base.isA<IntegerPower>())
+    {
+        const IntegerPower &power = base.asA<IntegerPower>();
+
+        int n = int( power.power().evaluate(Values()) );
+
+        if (n < 0 or n > MAX_BONDED_POLY_DEGREE)
+            return false;
+
+        QVector<double> core;
+
+        if (not getPolynomial(power.core(), var, core))
+            return false;
+
+        coeffs.append(fac);
+
+        for (int i=0; i<n; ++i)
+        {
+            if (not multiply(coeffs, core))
+                return false;
+        }
+
+        return true;
+    }
+    else
+        return false;
+}
+
+/** Return whether or not the expression is only a function of 'x' */
+static bool isFunctionOf(const Expression &ex, const Symbol &x)
+{
+    if (not ex.functions().isEmpty())
+        return false;
+
+    foreach (const Symbol &symbol, ex.symbols())
+    {
+        if (symbol != x)
+            return false;
+    }
+
+    return true;
+}
+
+/** Remove zero coefficients from the top of the polynomial */
+static void trim(QVector<double> &coeffs)
+{
+    while (coeffs.count() > 1 and coeffs.last() == 0)
+    {
+        coeffs.removeLast();
+    }
+}
+
+
+/////////
+///////// Implementation of BondedTerms
+/////////
+
+/** The parameters of a single recognised term */
+class BondedTerms::Recognised
+{
+public:
+    Recognised() : form(UNRECOGNISED), v0(0), a(0), b(0)
+    {}
+
+    /** The form of the term */
+    FORM form;
+
+    /** The coefficients of the polynomial (in either x or
+        cos(a x + b)). A harmonic term is held as the polynomial
+        coeffs[0] + coeffs[1] x + coeffs[2] x^2 */
+    QVector<double> coeffs;
+
+    /** The constant and cosines of a cosine series */
+    double v0;
+    QVector<CosineTerm> cosines;
+
+    /** The argument of a cosine power series, cos(a x + b) */
+    double a;
+    double b;
+};
+
+/** Constructor */
+BondedTerms::BondedTerms() : nslots(0), nrecognised(0)
+{}
+
+/** Copy constructor */
+BondedTerms::BondedTerms(const BondedTerms &other)
+            : forms(other.forms), harmonics(other.harmonics),
+              polynomials(other.polynomials), cosine_series(other.cosine_series),
+              cosine_powers(other.cosine_powers),
+              nslots(other.nslots), nrecognised(other.nrecognised)
+{}
+
+/** Destructor */
+BondedTerms::~BondedTerms()
+{}
+
+/** Copy assignment operator */
+BondedTerms& BondedTerms::operator=(const BondedTerms &other)
+{
+    if (this != &other)
+    {
+        forms = other.forms;
+        harmonics = other.harmonics;
+        polynomials = other.polynomials;
+        cosine_series = other.cosine_series;
+        cosine_powers = other.cosine_powers;
+        nslots = other.nslots;
+        nrecognised = other.nrecognised;
+    }
+
+    return *this;
+}
+
+const char* BondedTerms::typeName()
+{
+    return "SireMM::BondedTerms";
+}
+
+const char* BondedTerms::what() const
+{
+    return BondedTerms::typeName();
+}
+
+/** Return a string representation */
+QString BondedTerms::toString() const
+{
+    return QObject::tr("BondedTerms( count() == %1, nRecognised() == %2 : "
+                       "nHarmonic() == %3, nPolynomial() == %4, "
+                       "nCosineSeries() == %5, nCosinePowerSeries() == %6 )")
+                .arg(this->count()).arg(this->nRecognised())
+                .arg(this->nRecognised(HARMONIC))
+                .arg(this->nRecognised(POLYNOMIAL))
+                .arg(this->nRecognised(COSINE_SERIES))
+                .arg(this->nRecognised(COSINE_POWER_SERIES));
+}
+
+/** Return the number of terms that were recognised as having
+    the functional form 'form' */
+int BondedTerms::nRecognised(FORM form) const
+{
+    switch (form)
+    {
+    case HARMONIC:
+        return harmonics.term.count();
+    case POLYNOMIAL:
+        return polynomials.term.count();
+    case COSINE_SERIES:
+        return cosine_series.term.count();
+    case COSINE_POWER_SERIES:
+        return cosine_powers.term.count();
+    default:
+        return this->count() - this->nRecognised();
+    }
+}
+
+/** Clear all of the terms */
+void BondedTerms::clear()
+{
+    this->operator=( BondedTerms() );
+}
+
+/** Internal function used to add the recognised term 'term', whose
+    input value is in slot 'slot' */
+int BondedTerms::add(int slot, const Recognised &term)
+{
+    const qint32 i = forms.count();
+    const qint32 input = i*nslots + slot;
+
+    switch (term.form)
+    {
+    case HARMONIC:
+    {
+        //convert c0 + c1 x + c2 x^2 to k (x - x0)^2 + v0
+        const double k = term.coeffs[2];
+        const double x0 = -term.coeffs[1] / (2*k);
+
+        harmonics.term.append(i);
+        harmonics.input.append(input);
+        harmonics.k.append(k);
+        harmonics.x0.append(x0);
+        harmonics.v0.append(term.coeffs[0] - k*x0*x0);
+        break;
+    }
+    case POLYNOMIAL:
+    {
+        polynomials.term.append(i);
+        polynomials.input.append(input);
+
+        for (int j=0; j<=MAX_DEGREE; ++j)
+        {
+            polynomials.c[j].append( j < term.coeffs.count() ? term.coeffs[j] : 0.0 );
+        }
+
+        polynomials.degree = qMax(polynomials.degree, term.coeffs.count()-1);
+        break;
+    }
+    case COSINE_SERIES:
+    {
+        cosine_series.term.append(i);
+        cosine_series.v0.append(term.v0);
+
+        foreach (const CosineTerm &cosine, term.cosines)
+        {
+            cosine_series.cos_term.append(i);
+            cosine_series.cos_input.append(input);
+            cosine_series.k.append(cosine.k);
+            cosine_series.n.append(cosine.n);
+            cosine_series.phase.append(cosine.phase);
+        }
+
+        break;
+    }
+    case COSINE_POWER_SERIES:
+    {
+        cosine_powers.term.append(i);
+        cosine_powers.input.append(input);
+        cosine_powers.a.append(term.a);
+        cosine_powers.b.append(term.b);
+
+        for (int j=0; j<=MAX_DEGREE; ++j)
+        {
+            cosine_powers.c[j].append( j < term.coeffs.count() ? term.coeffs[j] : 0.0 );
+        }
+
+        cosine_powers.degree = qMax(cosine_powers.degree, term.coeffs.count()-1);
+        break;
+    }
+    default:
+        break;
+    }
+
+    forms.append(term.form);
+
+    if (term.form != UNRECOGNISED)
+        nrecognised += 1;
+
+    return i;
+}
+
+/** Add the function 'function', which should be a function of
+    one of the symbols in 'symbols'. This tries to recognise the
+    functional form of the function. The term is added whether or not
+    it is recognised (so that the indicies of the terms match those
+    of the functions). This returns the index of the added term
+
+    \throw SireError::incompatible_error
+*/
+int BondedTerms::add(const Expression &function, const QList<Symbol> &symbols)
+{
+    if (forms.isEmpty())
+        nslots = symbols.count();
+    else if (symbols.count() != nslots)
+        throw SireError::incompatible_error( QObject::tr(
+                "Cannot add the function %1 as it is a function of %2 symbols (%3), "
+                "while the other terms are functions of %4 symbols.")
+                    .arg(function.toString()).arg(symbols.count())
+                    .arg(Sire::toString(symbols)).arg(nslots), CODELOC );
+
+    for (int slot=0; slot<symbols.count(); ++slot)
+    {
+        const Symbol &x = symbols.at(slot);
+
+        if (not isFunctionOf(function, x))
+            continue;
+
+        Recognised term;
+
+        //is this a polynomial in x (e.g. a harmonic bond or angle)?
+        PolynomialVariable var(x, false);
+        QVector<double> coeffs;
+
+        if (getPolynomial(function, var, coeffs))
+        {
+            trim(coeffs);
+
+            term.coeffs = coeffs;
+
+            if (coeffs.count() == 3 and coeffs[2] != 0)
+                term.form = HARMONIC;
+            else
+                term.form = POLYNOMIAL;
+        }
+        else
+        {
+            //is this a cosine series (e.g. an amber dihedral)?
+            double v0 = 0;
+            QVector<CosineTerm> series;
+
+            if (getCosineSeries(function, x, 1.0, v0, series))
+            {
+                term.form = COSINE_SERIES;
+                term.v0 = v0;
+                term.cosines = series;
+            }
+            else
+            {
+                //is this a power series of a cosine (e.g. a Ryckaert-Bellemans dihedral)?
+                PolynomialVariable cosvar(x, true);
+
+                if (getPolynomial(function, cosvar, coeffs))
+                {
+                    trim(coeffs);
+
+                    term.form = COSINE_POWER_SERIES;
+                    term.coeffs = coeffs;
+                    term.a = cosvar.a;
+                    term.b = cosvar.b;
+                }
+            }
+        }
+
+        if (term.form == UNRECOGNISED)
+            continue;
+
+        //verify that the recognised form gives the same values as the
+        //original function, in case the function was misrecognised
+        BondedTerms test;
+        test.nslots = symbols.count();
+        test.add(slot, term);
+
+        bool ok = true;
+
+        for (int i=0; i<7; ++i)
+        {
+            QVector<double> values(symbols.count(), 0.0);
+            values[slot] = -2.3 + 0.83*i;
+
+            Values vals;
+            vals.set(x, values[slot]);
+
+            double v = function.evaluate(vals);
+            double t = test.sum(values.constData());
+
+            //(written so that NaNs are not recognised)
+            if (not (std::abs(v - t) <= 1e-8 * (1.0 + std::abs(v))))
+            {
+                ok = false;
+                break;
+            }
+        }
+
+        if (ok)
+            //this is a recognised function - add it to this set
+            return this->add(slot, term);
+    }
+
+    //this function is not recognised
+    return this->add(0, Recognised());
+}
+
+/** Evaluate all of the recognised terms, using the input values in 'values'
+    (nSlots() values per term, in the slot order of the symbols passed to 'add').
+    The value of each term is placed into 'results', which must have space
+    for count() values. Terms that were not recognised are given a value
+    of zero, so make sure that you check isRecognised.
+
+    The terms of each form are evaluated together in a single loop
+    over the parameter tables of that form */
+void BondedTerms::evaluate(const double *values, double *results) const
+{
+    const int nterms = forms.count();
+
+    for (int i=0; i<nterms; ++i)
+    {
+        results[i] = 0;
+    }
+
+    //harmonic terms
+    {
+        const int n = harmonics.term.count();
+        const qint32 *term = harmonics.term.constData();
+        const qint32 *input = harmonics.input.constData();
+        const double *k = harmonics.k.constData();
+        const double *x0 = harmonics.x0.constData();
+        const double *v0 = harmonics.v0.constData();
+
+        for (int i=0; i<n; ++i)
+        {
+            const double dx = values[input[i]] - x0[i];
+            results[term[i]] = k[i]*dx*dx + v0[i];
+        }
+    }
+
+    //polynomial terms, evaluated using Horner's method
+    {
+        const int n = polynomials.term.count();
+        const qint32 *term = polynomials.term.constData();
+        const qint32 *input = polynomials.input.constData();
+        const int degree = polynomials.degree;
+
+        const double *c[MAX_DEGREE+1];
+
+        for (int j=0; j<=MAX_DEGREE; ++j)
+        {
+            c[j] = polynomials.c[j].constData();
+        }
+
+        for (int i=0; i<n; ++i)
+        {
+            const double x = values[input[i]];
+
+            double v = c[degree][i];
+
+            for (int j=degree-1; j>=0; --j)
+            {
+                v = v*x + c[j][i];
+            }
+
+            results[term[i]] = v;
+        }
+    }
+
+    //cosine series - first the constants, then all of the cosines
+    {
+        const int n = cosine_series.term.count();
+        const qint32 *term = cosine_series.term.constData();
+        const double *v0 = cosine_series.v0.constData();
+
+        for (int i=0; i<n; ++i)
+        {
+            results[term[i]] = v0[i];
+        }
+
+        const int ncos = cosine_series.cos_term.count();
+        const qint32 *cos_term = cosine_series.cos_term.constData();
+        const qint32 *cos_input = cosine_series.cos_input.constData();
+        const double *k = cosine_series.k.constData();
+        const double *nfac = cosine_series.n.constData();
+        const double *phase = cosine_series.phase.constData();
+
+        for (int i=0; i<ncos; ++i)
+        {
+            results[cos_term[i]] += k[i] * std::cos(nfac[i]*values[cos_input[i]] + phase[i]);
+        }
+    }
+
+    //cosine power series, evaluated using Horner's method
+    {
+        const int n = cosine_powers.term.count();
+        const qint32 *term = cosine_powers.term.constData();
+        const qint32 *input = cosine_powers.input.constData();
+        const double *a = cosine_powers.a.constData();
+        const double *b = cosine_powers.b.constData();
+        const int degree = cosine_powers.degree;
+
+        const double *c[MAX_DEGREE+1];
+
+        for (int j=0; j<=MAX_DEGREE; ++j)
+        {
+            c[j] = cosine_powers.c[j].constData();
+        }
+
+        for (int i=0; i<n; ++i)
+        {
+            const double u = std::cos(a[i]*values[input[i]] + b[i]);
+
+            double v = c[degree][i];
+
+            for (int j=degree-1; j>=0; --j)
+            {
+                v = v*u + c[j][i];
+            }
+
+            results[term[i]] = v;
+        }
+    }
+}
+
+/** Return the sum of the values of all of the recognised terms, using
+    the input values in 'values' (laid out as for 'evaluate') */
+double BondedTerms::sum(const double *values) const
+{
+    QVarLengthArray<double, 128> results( forms.count() );
+
+    this->evaluate(values, results.data());
+
+    double total = 0;
+
+    for (int i=0; i<results.count(); ++i)
+    {
+        total += results[i];
+    }
+
+    return total;
+}
+
+/** Return the values of all of the terms, using the input values in 'values'
+    (nSlots() values per term). Terms that were not recognised have a
+    value of zero
+
+    \throw SireError::incompatible_error
+*/
+QVector<double> BondedTerms::evaluate(const QVector<double> &values) const
+{
+    if (values.count() != forms.count() * nslots)
+        throw SireError::incompatible_error( QObject::tr(
+                "Cannot evaluate the %1 terms as the number of input values (%2) "
+                "is not equal to the number needed (%1 x %3 == %4).")
+                    .arg(forms.count()).arg(values.count())
+                    .arg(nslots).arg(forms.count()*nslots), CODELOC );
+
+    QVector<double> results( forms.count() );
+
+    if (not results.isEmpty())
+        this->evaluate(values.constData(), results.data());
+
+    return results;
+}
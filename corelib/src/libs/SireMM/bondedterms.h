@@ -0,0 +1,247 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#ifndef SIREMM_BONDEDTERMS_H
+#define SIREMM_BONDEDTERMS_H
+
+#include "SireCAS/expression.h"
+#include "SireCAS/symbol.h"
+
+#include <QVector>
+#include <QList>
+
+SIRE_BEGIN_HEADER
+
+namespace SireMM
+{
+
+using SireCAS::Expression;
+using SireCAS::Symbol;
+
+/** This class recognises the standard functional forms of bonded
+    terms (harmonic, polynomial, cosine series and Ryckaert-Bellemans
+    style cosine power series) that are functions of a single internal
+    coordinate. The parameters of the recognised terms are grouped
+    by form into structure-of-arrays tables, so that all of the
+    terms of a form are evaluated together in a single loop, rather
+    than via the symbolic evaluator.
+
+    Terms are added in order, with the index of each term matching
+    the index of its function in the original array of functions.
+    All terms must be functions of the same list of symbols, and
+    the input values of term 'i' are held in slot order starting
+    at values[i * nSlots()]. Terms that are not recognised
+    must be evaluated using their original Expression
+
+    @author Christopher Woods
+*/
+class SIREMM_EXPORT BondedTerms
+{
+public:
+    enum FORM { UNRECOGNISED = 0,
+                HARMONIC = 1,
+                POLYNOMIAL = 2,
+                COSINE_SERIES = 3,
+                COSINE_POWER_SERIES = 4 };
+
+    /** The maximum degree of polynomial that is recognised */
+    enum { MAX_DEGREE = 6 };
+
+    BondedTerms();
+    BondedTerms(const BondedTerms &other);
+
+    ~BondedTerms();
+
+    BondedTerms& operator=(const BondedTerms &other);
+
+    static const char* typeName();
+    const char* what() const;
+
+    QString toString() const;
+
+    bool isEmpty() const;
+
+    int count() const;
+    int nRecognised() const;
+    int nRecognised(FORM form) const;
+
+    int nSlots() const;
+
+    int add(const Expression &function, const QList<Symbol> &symbols);
+
+    void clear();
+
+    bool isRecognised(int i) const;
+    FORM form(int i) const;
+
+    void evaluate(const double *values, double *results) const;
+    double sum(const double *values) const;
+
+    QVector<double> evaluate(const QVector<double> &values) const;
+
+private:
+    class Recognised;
+
+    int add(int slot, const Recognised &term);
+
+    /** The parameters of all harmonic terms,
+        V(x) = k (x - x0)^2 + v0 */
+    class HarmonicTerms
+    {
+    public:
+        QVector<qint32> term;
+        QVector<qint32> input;
+        QVector<double> k;
+        QVector<double> x0;
+        QVector<double> v0;
+    };
+
+    /** The parameters of all polynomial terms, V(x) = sum_j c[j] x^j.
+        The coefficients of all terms are padded with zeroes up
+        to the highest degree of any term */
+    class PolynomialTerms
+    {
+    public:
+        PolynomialTerms() : degree(0)
+        {}
+
+        QVector<qint32> term;
+        QVector<qint32> input;
+        QVector<double> c[MAX_DEGREE+1];
+        qint32 degree;
+    };
+
+    /** The parameters of all cosine series,
+        V(x) = v0 + sum_j k_j cos(n_j x + phase_j). Each individual
+        cosine is held separately, together with the index of its series */
+    class CosineSeriesTerms
+    {
+    public:
+        QVector<qint32> term;
+        QVector<double> v0;
+
+        QVector<qint32> cos_term;
+        QVector<qint32> cos_input;
+        QVector<double> k;
+        QVector<double> n;
+        QVector<double> phase;
+    };
+
+    /** The parameters of all series in powers of a cosine,
+        V(x) = sum_j c[j] cos^j(a x + b), e.g. a Ryckaert-Bellemans
+        dihedral (which has a = 1, b = -pi). The coefficients are padded
+        in the same way as for PolynomialTerms */
+    class CosinePowerTerms
+    {
+    public:
+        CosinePowerTerms() : degree(0)
+        {}
+
+        QVector<qint32> term;
+        QVector<qint32> input;
+        QVector<double> a;
+        QVector<double> b;
+        QVector<double> c[MAX_DEGREE+1];
+        qint32 degree;
+    };
+
+    /** The form of each term */
+    QVector<qint32> forms;
+
+    /** The harmonic terms */
+    HarmonicTerms harmonics;
+
+    /** The polynomial terms */
+    PolynomialTerms polynomials;
+
+    /** The cosine series */
+    CosineSeriesTerms cosine_series;
+
+    /** The cosine power series */
+    CosinePowerTerms cosine_powers;
+
+    /** The number of input values of each term */
+    qint32 nslots;
+
+    /** The number of recognised terms */
+    qint32 nrecognised;
+};
+
+#ifndef SIRE_SKIP_INLINE_FUNCTIONS
+
+/** Return the number of terms */
+inline int BondedTerms::count() const
+{
+    return forms.count();
+}
+
+/** Return the number of terms whose functional form was recognised */
+inline int BondedTerms::nRecognised() const
+{
+    return nrecognised;
+}
+
+/** Return the number of input values of each term (the number of
+    symbols passed to 'add') */
+inline int BondedTerms::nSlots() const
+{
+    return nslots;
+}
+
+/** Return whether or not this is empty */
+inline bool BondedTerms::isEmpty() const
+{
+    return forms.isEmpty();
+}
+
+/** Return whether or not the form of the ith term was recognised.
+    This returns false if 'i' is out of range */
+inline bool BondedTerms::isRecognised(int i) const
+{
+    return i >= 0 and i < forms.count() and
+           forms.constData()[i] != UNRECOGNISED;
+}
+
+/** Return the form of the ith term */
+inline BondedTerms::FORM BondedTerms::form(int i) const
+{
+    if (i < 0 or i >= forms.count())
+        return UNRECOGNISED;
+    else
+        return FORM( forms.constData()[i] );
+}
+
+#endif // SIRE_SKIP_INLINE_FUNCTIONS
+
+} // end of namespace SireMM
+
+SIRE_EXPOSE_CLASS( SireMM::BondedTerms )
+
+SIRE_END_HEADER
+
+#endif
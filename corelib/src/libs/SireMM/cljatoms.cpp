@@ -1937,6 +1937,68 @@ void CLJAtoms::copyIn(const CLJAtoms &other)
     std::memcpy( _id.data(), other._id.constData(), nelements * sizeof(MultiInt) );
 }
 
+/** Return a copy of the atoms at the passed indicies, in the order
+    in which they are given. Unlike constructing from a list of CLJAtom,
+    this copies the atoms exactly (including atoms that have no charge
+    or LJ parameters), so that the ith atom of the returned CLJAtoms
+    is the atom at indicies[i]. This is used to pack the atoms in
+    a neighbour list into compact blocks */
+CLJAtoms CLJAtoms::gather(const QVector<qint32> &indicies) const
+{
+    const int n = indicies.count();
+
+    if (n == 0)
+        return CLJAtoms();
+
+    QVector<float> xf(n);
+    QVector<float> yf(n);
+    QVector<float> zf(n);
+    
+    QVector<float> cf(n);
+    QVector<float> sf(n);
+    QVector<float> ef(n);
+    
+    QVector<qint32> idf(n);
+
+    const int natoms = this->count();
+    const qint32 *idx = indicies.constData();
+
+    for (int i=0; i<n; ++i)
+    {
+        const int atom = idx[i];
+        
+        if (atom < 0 or atom >= natoms)
+            throw SireError::invalid_index( QObject::tr(
+                    "Cannot gather atom %1 as the number of atoms is only %2.")
+                        .arg(atom).arg(natoms), CODELOC );
+    
+        const int j = atom / MultiFloat::count();
+        const int k = atom % MultiFloat::count();
+        
+        xf[i] = _x.constData()[j][k];
+        yf[i] = _y.constData()[j][k];
+        zf[i] = _z.constData()[j][k];
+        cf[i] = _q.constData()[j][k];
+        sf[i] = _sig.constData()[j][k];
+        ef[i] = _eps.constData()[j][k];
+        idf[i] = _id.constData()[j][k];
+    }
+
+    CLJAtoms ret;
+    
+    ret._x = MultiFloat::fromArray(xf.constData(), n);
+    ret._y = MultiFloat::fromArray(yf.constData(), n);
+    ret._z = MultiFloat::fromArray(zf.constData(), n);
+    
+    ret._q = MultiFloat::fromArray(cf.constData(), n);
+    ret._sig = MultiFloat::fromArray(sf.constData(), n);
+    ret._eps = MultiFloat::fromArray(ef.constData(), n);
+    
+    ret._id = MultiInt::fromArray(idf.constData(), n);
+
+    return ret;
+}
+
 /** Return a copy of these CLJAtoms where the charge and LJ epsilon parameters
     are negated. This will mean that the negative of the energy of these CLJAtoms
     will be calculated by the CLJFunctions (useful for calculating energy differences) */
@@ -1953,6 +2015,26 @@ CLJAtoms CLJAtoms::negate() const
     return ret;
 }
 
+/** Return a copy of these CLJAtoms where all of the atoms have been
+    translated by 'delta' (e.g. to give a periodic image of the atoms) */
+CLJAtoms CLJAtoms::translate(const Vector &delta) const
+{
+    CLJAtoms ret(*this);
+    
+    const MultiFloat dx( delta.x() );
+    const MultiFloat dy( delta.y() );
+    const MultiFloat dz( delta.z() );
+    
+    for (int i=0; i<_x.count(); ++i)
+    {
+        ret._x[i] = _x[i] + dx;
+        ret._y[i] = _y[i] + dy;
+        ret._z[i] = _z[i] + dz;
+    }
+    
+    return ret;
+}
+
 /** Return a squeezed copy of these CLJAtoms whereby all of the 
     dummy atoms are removed and atoms squeezed into a single, contiguous space */
 CLJAtoms CLJAtoms::squeeze() const
@@ -262,6 +262,9 @@ public:
     Vector maxCoords() const;
     
     CLJAtoms negate() const;
+    CLJAtoms translate(const Vector &delta) const;
+    
+    CLJAtoms gather(const QVector<qint32> &indicies) const;
     
     QVector<CLJAtom> atoms() const;
     
@@ -1620,6 +1620,18 @@ float CLJBoxes::getDistance(const Space &space, const CLJBoxIndex &box0,
                                   box1.box(l));
 }
 
+/** Return whether or not the distances between boxes in the space 'space'
+    can be calculated from their integer box indicies. This is only possible 
+    for infinite cartesian space and for a PeriodicBox. The distances in any
+    other space (e.g. a TriclinicBox) are calculated using the space itself */
+static bool canUseBoxIndicies(const Space &space)
+{
+    if (space.isPeriodic())
+        return space.isA<PeriodicBox>();
+    else
+        return space.isCartesian();
+}
+
 /** Return the distances between all of the occupied boxes in 'boxes'
     based on the space 'space' */
 QVector<CLJBoxDistance> CLJBoxes::getDistances(const Space &space, const CLJBoxes &boxes)
@@ -1681,7 +1693,7 @@ QVector<CLJBoxDistance> CLJBoxes::getDistances(const Space &space, const CLJBoxe
 
     dists.reserve((nboxes*nboxes) / 2);
 
-    if (space.isCartesian())
+    if (canUseBoxIndicies(space))
     {
         if (space.isPeriodic())
         {
@@ -1880,7 +1892,7 @@ QVector<CLJBoxDistance> CLJBoxes::getDistances(const Space &space, const CLJBoxe
     
     dists.reserve((n0*n1)/2);
 
-    if (space.isCartesian() and (boxes0.box_length == boxes1.box_length))
+    if (canUseBoxIndicies(space) and (boxes0.box_length == boxes1.box_length))
     {
         if (space.isPeriodic())
         {
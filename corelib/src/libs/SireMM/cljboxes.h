@@ -371,6 +371,8 @@ public:
     const_iterator find(const CLJBoxIndex &box) const;
     const_iterator constFind(const CLJBoxIndex &box) const;
     
+    int indexOf(const CLJBoxIndex &box) const;
+    
     const_iterator end() const;
     const_iterator constEnd() const;
 
@@ -601,6 +603,13 @@ inline CLJBoxes::const_iterator CLJBoxes::constFind(const CLJBoxIndex &box) cons
     return this->find(box);
 }
 
+/** Return the index in occupiedBoxes() of the box that contains the atom
+    at 'box', or -1 if this box is not occupied */
+inline int CLJBoxes::indexOf(const CLJBoxIndex &box) const
+{
+    return box_to_idx.value(box.boxOnly(), -1);
+}
+
 /** Return the iterator pointing to one space past the last occupied box */
 inline CLJBoxes::const_iterator CLJBoxes::end() const
 {
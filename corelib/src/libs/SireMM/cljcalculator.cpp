@@ -31,6 +31,11 @@
 #include "cljatoms.h"
 #include "cljdelta.h"
 #include "cljboxes.h"
+#include "cljforces.h"
+
+#include "SireBase/profiler.h"
+
+#include "SireError/errors.h"
 
 #include "tbb/blocked_range.h"
 #include "tbb/parallel_for.h"
@@ -195,6 +200,87 @@ namespace SireMM
             const float lj_cutoff;
         };
 
+        /** This is a private helper class that is used to calculate the
+            coulomb and LJ energy in parallel using Intel TBB, using
+            the compact blocks of atoms held in a CLJPairList */
+        class TotalPairList
+        {
+        public:
+            TotalPairList() : func(0), pairlist(0), boxes(0), coul_cutoff(0), lj_cutoff(0)
+            {}
+        
+            TotalPairList(const CLJFunction* const function,
+                          const CLJPairList* const list,
+                          const CLJBoxes::Container &cljboxes,
+                          const float coulomb_cutoff, const float lenj_cutoff,
+                          double *coulomb_energy, double *lj_energy)
+                : func(function), pairlist(list), boxes(&cljboxes),
+                  coul_nrg(coulomb_energy), lj_nrg(lj_energy),
+                  coul_cutoff(coulomb_cutoff), lj_cutoff(lenj_cutoff)
+            {}
+            
+            ~TotalPairList()
+            {}
+            
+            void operator()(const tbb::blocked_range<int> &range) const
+            {
+                const CLJBoxDistance* ptr = pairlist->boxPairs().constData() + range.begin();
+                const CLJBoxPtr* const b = boxes->constData();
+            
+                for (int i = range.begin(); i != range.end(); ++i)
+                {
+                    if (ptr->box0() == ptr->box1())
+                    {
+                        func->total(b[ptr->box0()].read().atoms(),
+                                    coul_nrg[i], lj_nrg[i]);
+                    }
+                    else if (ptr->distance() < coul_cutoff or ptr->distance() < lj_cutoff)
+                    {
+                        //gather the atoms in the list into compact blocks
+                        const CLJAtoms atoms0 = b[ptr->box0()].read().atoms()
+                                                        .gather(pairlist->atoms0(i));
+                        const CLJAtoms atoms1 = b[ptr->box1()].read().atoms()
+                                                        .gather(pairlist->atoms1(i));
+                    
+                        if (ptr->distance() < coul_cutoff and ptr->distance() < lj_cutoff)
+                        {
+                            func->total(atoms0, atoms1, coul_nrg[i], lj_nrg[i],
+                                        ptr->distance());
+                        }
+                        else if (ptr->distance() < coul_cutoff)
+                        {
+                            coul_nrg[i] = func->coulomb(atoms0, atoms1, ptr->distance());
+                            lj_nrg[i] = 0;
+                        }
+                        else
+                        {
+                            lj_nrg[i] = func->lj(atoms0, atoms1, ptr->distance());
+                            coul_nrg[i] = 0;
+                        }
+                    }
+                    else
+                    {
+                        //the boxes are within the skin, but not the cutoff
+                        coul_nrg[i] = 0;
+                        lj_nrg[i] = 0;
+                    }
+                    
+                    ptr += 1;
+                }
+            }
+            
+        private:
+            const CLJFunction* const func;
+            const CLJPairList* const pairlist;
+            const CLJBoxes::Container* const boxes;
+            
+            double *coul_nrg;
+            double *lj_nrg;
+            
+            const float coul_cutoff;
+            const float lj_cutoff;
+        };
+
         /** This is a private helper class that is used to calculate the
             coulomb and LJ energy in parallel using Intel TBB */
         class TotalWithoutCutoff
@@ -491,6 +577,8 @@ namespace SireMM
     the coulomb and LJ energy as a tuple (coulomb,lj) */
 tuple<double,double> CLJCalculator::calculate(const CLJFunction &func, const CLJBoxes &boxes) const
 {
+    SIRE_PROFILE("SireMM::CLJCalculator::calculate");
+
     //get the cutoffs for the function
     if (func.hasCutoff())
     {
@@ -583,12 +671,65 @@ tuple<double,double> CLJCalculator::calculate(const CLJFunction &func, const CLJ
     }
 }
 
+/** Calculate the energy between all of the atoms in the passed CLJBoxes
+    using the passed CLJFunction, returning the coulomb and LJ energy
+    as a tuple (coulomb,lj). This uses the neighbour list in 'pairlist',
+    which is rebuilt if the atoms have moved too far since it was last
+    built. This gives the same energy as calculate(func, boxes), but
+    avoids finding all of the pairs of boxes and atoms within the cutoff
+    on every call. The list is not used if the function has no cutoff */
+tuple<double,double> CLJCalculator::calculate(const CLJFunction &func, const CLJBoxes &boxes,
+                                              CLJPairList &pairlist) const
+{
+    if (not func.hasCutoff())
+        return this->calculate(func, boxes);
+
+    SIRE_PROFILE("SireMM::CLJCalculator::calculate");
+    
+    pairlist.update(func, boxes);
+    
+    const int npairs = pairlist.nBoxPairs();
+    
+    //now create the space to hold the calculated energies
+    QVarLengthArray<double> coul_nrgs( npairs );
+    QVarLengthArray<double> lj_nrgs( npairs );
+    
+    //now create the object that will be used by TBB to calculate the energies
+    detail::TotalPairList helper(&func, &pairlist, boxes.occupiedBoxes(),
+                                 func.coulombCutoff().value(), func.ljCutoff().value(),
+                                 coul_nrgs.data(), lj_nrgs.data());
+
+    //now perform the calculation in parallel
+    tbb::parallel_for(tbb::blocked_range<int>(0,npairs), helper);
+    
+    if (reproducible_sum)
+    {
+        //do a sorted sum of energies so that we get the same result no matter the order
+        //of calculation
+        qSort(coul_nrgs);
+        qSort(lj_nrgs);
+    }
+    
+    double cnrg = 0;
+    double ljnrg = 0;
+    
+    for (int i=0; i<npairs; ++i)
+    {
+        cnrg += coul_nrgs.constData()[i];
+        ljnrg += lj_nrgs.constData()[i];
+    }
+    
+    return tuple<double,double>(cnrg, ljnrg);
+}
+
 /** Calculate the energy between all of the atoms in the passed two CLJBoxes
     using the passed CLJFunction, returning
     the coulomb and LJ energy as a tuple (coulomb,lj) */
 tuple<double,double> CLJCalculator::calculate(const CLJFunction &func,
                                               const CLJBoxes &boxes0, const CLJBoxes &boxes1) const
 {
+    SIRE_PROFILE("SireMM::CLJCalculator::calculate");
+
     if (boxes0.nOccupiedBoxes() > boxes1.nOccupiedBoxes())
         return this->calculate(func, boxes1, boxes0);
 
@@ -730,6 +871,8 @@ tuple<double,double> CLJCalculator::calculate(const CLJFunction &func,
 tuple<double,double> CLJCalculator::calculate(const CLJFunction &func,
                                               const CLJAtoms &atoms0, const CLJBoxes &boxes1) const
 {
+    SIRE_PROFILE("SireMM::CLJCalculator::calculate");
+
     const int n1 = boxes1.nOccupiedBoxes();
 
     if (n1 == 0 or atoms0.count() == 0)
@@ -839,6 +982,8 @@ tuple< QVector<double>, QVector<double> > CLJCalculator::calculate(
                                 const QVector<CLJFunctionPtr> &funcs,
                                 const CLJBoxes &boxes) const
 {
+    SIRE_PROFILE("SireMM::CLJCalculator::calculate");
+
     QVector<double> cnrgs;
     QVector<double> ljnrgs;
     
@@ -868,6 +1013,8 @@ tuple< QVector<double>, QVector<double> > CLJCalculator::calculate(
                                 const QVector<CLJFunctionPtr> &funcs,
                                 const CLJBoxes &boxes0, const CLJBoxes &boxes1) const
 {
+    SIRE_PROFILE("SireMM::CLJCalculator::calculate");
+
     QVector<double> cnrgs;
     QVector<double> ljnrgs;
     
@@ -897,6 +1044,8 @@ tuple< QVector<double>, QVector<double> > CLJCalculator::calculate(
                                 const QVector<CLJFunctionPtr> &funcs,
                                 const CLJAtoms &atoms0, const CLJBoxes &boxes1) const
 {
+    SIRE_PROFILE("SireMM::CLJCalculator::calculate");
+
     QVector<double> cnrgs;
     QVector<double> ljnrgs;
     
@@ -918,3 +1067,482 @@ tuple< QVector<double>, QVector<double> > CLJCalculator::calculate(
     
     return tuple< QVector<double>,QVector<double> >(cnrgs, ljnrgs);
 }
+
+namespace SireMM
+{
+    namespace detail
+    {
+        /** This is a private helper class that is used to calculate the 
+            coulomb and/or LJ forces between pairs of boxes in parallel using 
+            Intel TBB. Each pair of boxes writes its forces into its own
+            workspace, which are then summed together in a fixed order,
+            so that the result does not depend on the number of threads */
+        class ForcePairs
+        {
+        public:
+            ForcePairs() : func(0), dists(0), boxes0(0), boxes1(0),
+                           forces0(0), forces1(0), scale_force(0),
+                           calc_coul(false), calc_lj(false)
+            {}
+            
+            ForcePairs(const CLJFunction* const function,
+                       const CLJBoxDistance* const distances,
+                       const CLJBoxes::Container &cljboxes0,
+                       const CLJBoxes::Container &cljboxes1,
+                       CLJForces *box_forces0, CLJForces *box_forces1,
+                       const double scale, const bool coul, const bool lj)
+                : func(function), dists(distances), boxes0(&cljboxes0), boxes1(&cljboxes1),
+                  forces0(box_forces0), forces1(box_forces1), scale_force(scale),
+                  calc_coul(coul), calc_lj(lj)
+            {}
+            
+            ~ForcePairs()
+            {}
+            
+            void operator()(const tbb::blocked_range<int> &range) const
+            {
+                const CLJBoxDistance* ptr = dists + range.begin();
+                const CLJBoxPtr* const b0 = boxes0->constData();
+                const CLJBoxPtr* const b1 = boxes1->constData();
+                
+                const bool self = (boxes0 == boxes1);
+            
+                for (int i = range.begin(); i != range.end(); ++i)
+                {
+                    const CLJAtoms &atoms0 = b0[ptr->box0()].read().atoms();
+                    const CLJAtoms &atoms1 = b1[ptr->box1()].read().atoms();
+                
+                    if (self and ptr->box0() == ptr->box1())
+                    {
+                        if (calc_coul and calc_lj)
+                            func->force(atoms0, forces0[i], scale_force);
+                        else if (calc_coul)
+                            func->coulombForce(atoms0, forces0[i], scale_force);
+                        else
+                            func->ljForce(atoms0, forces0[i], scale_force);
+                    }
+                    else
+                    {
+                        if (calc_coul and calc_lj)
+                            func->force(atoms0, atoms1, forces0[i], forces1[i],
+                                        scale_force);
+                        else if (calc_coul)
+                            func->coulombForce(atoms0, atoms1, forces0[i], forces1[i],
+                                               scale_force);
+                        else
+                            func->ljForce(atoms0, atoms1, forces0[i], forces1[i],
+                                          scale_force);
+                    }
+                    
+                    ptr += 1;
+                }
+            }
+            
+        private:
+            const CLJFunction* const func;
+            const CLJBoxDistance* const dists;
+            const CLJBoxes::Container* const boxes0;
+            const CLJBoxes::Container* const boxes1;
+            
+            CLJForces *forces0;
+            CLJForces *forces1;
+            
+            const double scale_force;
+            const bool calc_coul;
+            const bool calc_lj;
+        };
+        
+        /** This is a private helper class that is used to calculate the 
+            coulomb and/or LJ forces between the compact blocks of atoms
+            in a CLJPairList in parallel using Intel TBB. As with ForcePairs,
+            each pair writes its forces into its own workspace (one force
+            for each gathered atom), which are then scattered back onto
+            the boxes in a fixed order */
+        class ForcePairList
+        {
+        public:
+            ForcePairList() : func(0), pairlist(0), boxes(0),
+                              forces0(0), forces1(0), scale_force(0),
+                              calc_coul(false), calc_lj(false)
+            {}
+            
+            ForcePairList(const CLJFunction* const function,
+                          const CLJPairList* const list,
+                          const CLJBoxes::Container &cljboxes,
+                          CLJForces *pair_forces0, CLJForces *pair_forces1,
+                          const double scale, const bool coul, const bool lj)
+                : func(function), pairlist(list), boxes(&cljboxes),
+                  forces0(pair_forces0), forces1(pair_forces1), scale_force(scale),
+                  calc_coul(coul), calc_lj(lj)
+            {}
+            
+            ~ForcePairList()
+            {}
+            
+            void operator()(const tbb::blocked_range<int> &range) const
+            {
+                const CLJBoxDistance* ptr = pairlist->boxPairs().constData() + range.begin();
+                const CLJBoxPtr* const b = boxes->constData();
+            
+                for (int i = range.begin(); i != range.end(); ++i)
+                {
+                    if (ptr->box0() == ptr->box1())
+                    {
+                        const CLJAtoms &atoms0 = b[ptr->box0()].read().atoms();
+                    
+                        if (calc_coul and calc_lj)
+                            func->force(atoms0, forces0[i], scale_force);
+                        else if (calc_coul)
+                            func->coulombForce(atoms0, forces0[i], scale_force);
+                        else
+                            func->ljForce(atoms0, forces0[i], scale_force);
+                    }
+                    else
+                    {
+                        const CLJAtoms atoms0 = b[ptr->box0()].read().atoms()
+                                                        .gather(pairlist->atoms0(i));
+                        const CLJAtoms atoms1 = b[ptr->box1()].read().atoms()
+                                                        .gather(pairlist->atoms1(i));
+                    
+                        if (calc_coul and calc_lj)
+                            func->force(atoms0, atoms1, forces0[i], forces1[i],
+                                        scale_force);
+                        else if (calc_coul)
+                            func->coulombForce(atoms0, atoms1, forces0[i], forces1[i],
+                                               scale_force);
+                        else
+                            func->ljForce(atoms0, atoms1, forces0[i], forces1[i],
+                                          scale_force);
+                    }
+                    
+                    ptr += 1;
+                }
+            }
+            
+        private:
+            const CLJFunction* const func;
+            const CLJPairList* const pairlist;
+            const CLJBoxes::Container* const boxes;
+            
+            CLJForces *forces0;
+            CLJForces *forces1;
+            
+            const double scale_force;
+            const bool calc_coul;
+            const bool calc_lj;
+        };
+        
+        /** Internal function used to add the forces on the gathered atoms
+            in 'gathered' onto the atoms at indicies 'idxs' in 'forces' */
+        static void scatterForces(const CLJForces &gathered, const QVector<qint32> &idxs,
+                                  CLJForces &forces)
+        {
+            if (gathered.isEmpty())
+                return;
+        
+            const MultiFloat *gx = gathered.x().constData();
+            const MultiFloat *gy = gathered.y().constData();
+            const MultiFloat *gz = gathered.z().constData();
+            
+            MultiFloat *fx = forces.xData();
+            MultiFloat *fy = forces.yData();
+            MultiFloat *fz = forces.zData();
+            
+            for (int i=0; i<idxs.count(); ++i)
+            {
+                const int gi = i / MultiFloat::count();
+                const int gk = i % MultiFloat::count();
+            
+                const int j = idxs.constData()[i] / MultiFloat::count();
+                const int k = idxs.constData()[i] % MultiFloat::count();
+                
+                fx[j].quickSet(k, fx[j][k] + gx[gi][gk]);
+                fy[j].quickSet(k, fy[j][k] + gy[gi][gk]);
+                fz[j].quickSet(k, fz[j][k] + gz[gi][gk]);
+            }
+        }
+
+        /** Internal function used to make sure that 'forces' contains
+            a CLJForces for each of the occupied boxes in 'boxes' */
+        static void prepareForces(const CLJBoxes &boxes, QVector<CLJForces> &forces)
+        {
+            const CLJBoxes::Container &b = boxes.occupiedBoxes();
+        
+            if (forces.count() != b.count())
+            {
+                if (not forces.isEmpty())
+                    throw SireError::incompatible_error( QObject::tr(
+                            "Cannot calculate the forces on %1 boxes of atoms using an "
+                            "array of forces for %2 boxes.")
+                                .arg(b.count()).arg(forces.count()), CODELOC );
+                
+                forces = QVector<CLJForces>(b.count());
+            }
+            
+            CLJForces *f = forces.data();
+            
+            for (int i=0; i<b.count(); ++i)
+            {
+                if (f[i].isEmpty())
+                    f[i] = CLJForces(b.constData()[i].read().atoms());
+            }
+        }
+    } // end of namespace detail
+} // end of namespace SireMM
+
+/** Internal function that calculates the forces between all of the atoms
+    in 'boxes' in parallel, adding them onto 'forces' */
+void CLJCalculator::pvt_force(const CLJFunction &func, const CLJBoxes &boxes,
+                              QVector<CLJForces> &forces, double scale_force,
+                              bool calc_coul, bool calc_lj) const
+{
+    SIRE_PROFILE("SireMM::CLJCalculator::force");
+
+    detail::prepareForces(boxes, forces);
+    
+    if (scale_force == 0 or boxes.nOccupiedBoxes() == 0)
+        return;
+    
+    //get the list of box pairs that are within the cutoff distance
+    QVector<CLJBoxDistance> dists;
+    
+    if (func.hasCutoff())
+    {
+        Length coul_cutoff = func.coulombCutoff();
+        Length lj_cutoff = func.ljCutoff();
+        
+        Length max_cutoff( coul_cutoff.value() >= lj_cutoff.value() ?
+                           coul_cutoff : lj_cutoff );
+    
+        dists = CLJBoxes::getDistances(func.space(), boxes, max_cutoff);
+    }
+    else
+        dists = CLJBoxes::getDistances(func.space(), boxes);
+    
+    //create the workspace for the forces calculated for each pair of boxes
+    QVector<CLJForces> forces0( dists.count() );
+    QVector<CLJForces> forces1( dists.count() );
+    
+    detail::ForcePairs helper(&func, dists.constData(),
+                              boxes.occupiedBoxes(), boxes.occupiedBoxes(),
+                              forces0.data(), forces1.data(),
+                              scale_force, calc_coul, calc_lj);
+    
+    tbb::parallel_for(tbb::blocked_range<int>(0,dists.count()), helper);
+    
+    //now sum the forces back in the order of the box pairs
+    CLJForces *f = forces.data();
+    
+    for (int i=0; i<dists.count(); ++i)
+    {
+        const CLJBoxDistance &dist = dists.constData()[i];
+        
+        f[dist.box0()] += forces0.constData()[i];
+        
+        if (dist.box0() != dist.box1())
+            f[dist.box1()] += forces1.constData()[i];
+    }
+}
+
+/** Internal function that calculates the forces between all of the atoms
+    in 'boxes' in parallel using the neighbour list in 'pairlist', 
+    adding them onto 'forces' */
+void CLJCalculator::pvt_force(const CLJFunction &func, const CLJBoxes &boxes,
+                              QVector<CLJForces> &forces, CLJPairList &pairlist,
+                              double scale_force, bool calc_coul, bool calc_lj) const
+{
+    if (not func.hasCutoff())
+    {
+        this->pvt_force(func, boxes, forces, scale_force, calc_coul, calc_lj);
+        return;
+    }
+
+    SIRE_PROFILE("SireMM::CLJCalculator::force");
+
+    detail::prepareForces(boxes, forces);
+    
+    if (scale_force == 0 or boxes.nOccupiedBoxes() == 0)
+        return;
+    
+    pairlist.update(func, boxes);
+    
+    const int npairs = pairlist.nBoxPairs();
+    
+    //create the workspace for the forces calculated for each pair of blocks
+    QVector<CLJForces> forces0( npairs );
+    QVector<CLJForces> forces1( npairs );
+    
+    detail::ForcePairList helper(&func, &pairlist, boxes.occupiedBoxes(),
+                                 forces0.data(), forces1.data(),
+                                 scale_force, calc_coul, calc_lj);
+    
+    tbb::parallel_for(tbb::blocked_range<int>(0,npairs), helper);
+    
+    //now scatter the forces back in the order of the box pairs
+    CLJForces *f = forces.data();
+    const CLJBoxDistance *pairs = pairlist.boxPairs().constData();
+    
+    for (int i=0; i<npairs; ++i)
+    {
+        const CLJBoxDistance &pair = pairs[i];
+        
+        if (pair.box0() == pair.box1())
+        {
+            f[pair.box0()] += forces0.constData()[i];
+        }
+        else
+        {
+            detail::scatterForces(forces0.constData()[i], pairlist.atoms0(i),
+                                  f[pair.box0()]);
+            detail::scatterForces(forces1.constData()[i], pairlist.atoms1(i),
+                                  f[pair.box1()]);
+        }
+    }
+}
+
+/** Internal function that calculates the forces between all of the atoms
+    in 'boxes0' and 'boxes1' in parallel, adding them onto 'forces0' and 'forces1' */
+void CLJCalculator::pvt_force(const CLJFunction &func,
+                              const CLJBoxes &boxes0, const CLJBoxes &boxes1,
+                              QVector<CLJForces> &forces0, QVector<CLJForces> &forces1,
+                              double scale_force, bool calc_coul, bool calc_lj) const
+{
+    SIRE_PROFILE("SireMM::CLJCalculator::force");
+
+    detail::prepareForces(boxes0, forces0);
+    detail::prepareForces(boxes1, forces1);
+    
+    if (scale_force == 0 or boxes0.nOccupiedBoxes() == 0 or boxes1.nOccupiedBoxes() == 0)
+        return;
+    
+    //get the list of box pairs that are within the cutoff distance
+    QVector<CLJBoxDistance> dists;
+    
+    if (func.hasCutoff())
+    {
+        Length coul_cutoff = func.coulombCutoff();
+        Length lj_cutoff = func.ljCutoff();
+        
+        Length max_cutoff( coul_cutoff.value() >= lj_cutoff.value() ?
+                           coul_cutoff : lj_cutoff );
+    
+        dists = CLJBoxes::getDistances(func.space(), boxes0, boxes1, max_cutoff);
+    }
+    else
+        dists = CLJBoxes::getDistances(func.space(), boxes0, boxes1);
+    
+    //create the workspace for the forces calculated for each pair of boxes
+    QVector<CLJForces> pair_forces0( dists.count() );
+    QVector<CLJForces> pair_forces1( dists.count() );
+    
+    detail::ForcePairs helper(&func, dists.constData(),
+                              boxes0.occupiedBoxes(), boxes1.occupiedBoxes(),
+                              pair_forces0.data(), pair_forces1.data(),
+                              scale_force, calc_coul, calc_lj);
+    
+    tbb::parallel_for(tbb::blocked_range<int>(0,dists.count()), helper);
+    
+    //now sum the forces back in the order of the box pairs
+    CLJForces *f0 = forces0.data();
+    CLJForces *f1 = forces1.data();
+    
+    for (int i=0; i<dists.count(); ++i)
+    {
+        const CLJBoxDistance &dist = dists.constData()[i];
+        
+        f0[dist.box0()] += pair_forces0.constData()[i];
+        f1[dist.box1()] += pair_forces1.constData()[i];
+    }
+}
+
+/** Calculate the coulomb and LJ forces between all of the atoms in the passed
+    CLJBoxes using the passed CLJFunction, adding them (multiplied by 'scale_force')
+    onto 'forces'. The forces are held in a CLJForces object for each 
+    box in boxes.occupiedBoxes() */
+void CLJCalculator::force(const CLJFunction &func, const CLJBoxes &boxes,
+                          QVector<CLJForces> &forces, double scale_force) const
+{
+    this->pvt_force(func, boxes, forces, scale_force, true, true);
+}
+
+/** Calculate the coulomb and LJ forces between all of the atoms in the passed
+    two CLJBoxes using the passed CLJFunction, adding them (multiplied by 'scale_force')
+    onto 'forces0' and 'forces1' */
+void CLJCalculator::force(const CLJFunction &func,
+                          const CLJBoxes &boxes0, const CLJBoxes &boxes1,
+                          QVector<CLJForces> &forces0, QVector<CLJForces> &forces1,
+                          double scale_force) const
+{
+    this->pvt_force(func, boxes0, boxes1, forces0, forces1, scale_force, true, true);
+}
+
+/** Calculate the coulomb forces between all of the atoms in the passed
+    CLJBoxes using the passed CLJFunction, adding them (multiplied by 'scale_force')
+    onto 'forces' */
+void CLJCalculator::coulombForce(const CLJFunction &func, const CLJBoxes &boxes,
+                                 QVector<CLJForces> &forces, double scale_force) const
+{
+    this->pvt_force(func, boxes, forces, scale_force, true, false);
+}
+
+/** Calculate the coulomb forces between all of the atoms in the passed
+    two CLJBoxes using the passed CLJFunction, adding them (multiplied by 'scale_force')
+    onto 'forces0' and 'forces1' */
+void CLJCalculator::coulombForce(const CLJFunction &func,
+                                 const CLJBoxes &boxes0, const CLJBoxes &boxes1,
+                                 QVector<CLJForces> &forces0, QVector<CLJForces> &forces1,
+                                 double scale_force) const
+{
+    this->pvt_force(func, boxes0, boxes1, forces0, forces1, scale_force, true, false);
+}
+
+/** Calculate the LJ forces between all of the atoms in the passed
+    CLJBoxes using the passed CLJFunction, adding them (multiplied by 'scale_force')
+    onto 'forces' */
+void CLJCalculator::ljForce(const CLJFunction &func, const CLJBoxes &boxes,
+                            QVector<CLJForces> &forces, double scale_force) const
+{
+    this->pvt_force(func, boxes, forces, scale_force, false, true);
+}
+
+/** Calculate the LJ forces between all of the atoms in the passed
+    two CLJBoxes using the passed CLJFunction, adding them (multiplied by 'scale_force')
+    onto 'forces0' and 'forces1' */
+void CLJCalculator::ljForce(const CLJFunction &func,
+                            const CLJBoxes &boxes0, const CLJBoxes &boxes1,
+                            QVector<CLJForces> &forces0, QVector<CLJForces> &forces1,
+                            double scale_force) const
+{
+    this->pvt_force(func, boxes0, boxes1, forces0, forces1, scale_force, false, true);
+}
+
+/** Calculate the coulomb and LJ forces between all of the atoms in the passed
+    CLJBoxes using the passed CLJFunction and the neighbour list in 'pairlist', 
+    adding them (multiplied by 'scale_force') onto 'forces'. The list is 
+    rebuilt if the atoms have moved too far since it was last built */
+void CLJCalculator::force(const CLJFunction &func, const CLJBoxes &boxes,
+                          QVector<CLJForces> &forces, CLJPairList &pairlist,
+                          double scale_force) const
+{
+    this->pvt_force(func, boxes, forces, pairlist, scale_force, true, true);
+}
+
+/** Calculate the coulomb forces between all of the atoms in the passed
+    CLJBoxes using the passed CLJFunction and the neighbour list in 'pairlist',
+    adding them (multiplied by 'scale_force') onto 'forces' */
+void CLJCalculator::coulombForce(const CLJFunction &func, const CLJBoxes &boxes,
+                                 QVector<CLJForces> &forces, CLJPairList &pairlist,
+                                 double scale_force) const
+{
+    this->pvt_force(func, boxes, forces, pairlist, scale_force, true, false);
+}
+
+/** Calculate the LJ forces between all of the atoms in the passed
+    CLJBoxes using the passed CLJFunction and the neighbour list in 'pairlist',
+    adding them (multiplied by 'scale_force') onto 'forces' */
+void CLJCalculator::ljForce(const CLJFunction &func, const CLJBoxes &boxes,
+                            QVector<CLJForces> &forces, CLJPairList &pairlist,
+                            double scale_force) const
+{
+    this->pvt_force(func, boxes, forces, pairlist, scale_force, false, true);
+}
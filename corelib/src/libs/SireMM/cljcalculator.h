@@ -31,6 +31,7 @@
 
 #include "cljfunction.h"
 #include "cljboxes.h"
+#include "cljpairlist.h"
 
 #include <boost/tuple/tuple.hpp>
 
@@ -82,6 +83,10 @@ public:
             calculate( const QVector<CLJFunctionPtr> &funcs,
                        const CLJBoxes &boxes) const;
 
+    boost::tuple<double,double> calculate(const CLJFunction &func,
+                                          const CLJBoxes &boxes,
+                                          CLJPairList &pairlist) const;
+
     boost::tuple<double,double> calculate(const CLJFunction &func,
                                           const CLJBoxes &boxes0,
                                           const CLJBoxes &boxes1) const;
@@ -98,7 +103,56 @@ public:
             calculate( const QVector<CLJFunctionPtr> &funcs,
                        const CLJAtoms &atoms0, const CLJBoxes &boxes1) const;
 
+    void force(const CLJFunction &func, const CLJBoxes &boxes,
+               QVector<CLJForces> &forces, double scale_force=1) const;
+    
+    void force(const CLJFunction &func,
+               const CLJBoxes &boxes0, const CLJBoxes &boxes1,
+               QVector<CLJForces> &forces0, QVector<CLJForces> &forces1,
+               double scale_force=1) const;
+
+    void coulombForce(const CLJFunction &func, const CLJBoxes &boxes,
+                      QVector<CLJForces> &forces, double scale_force=1) const;
+    
+    void coulombForce(const CLJFunction &func,
+                      const CLJBoxes &boxes0, const CLJBoxes &boxes1,
+                      QVector<CLJForces> &forces0, QVector<CLJForces> &forces1,
+                      double scale_force=1) const;
+
+    void ljForce(const CLJFunction &func, const CLJBoxes &boxes,
+                 QVector<CLJForces> &forces, double scale_force=1) const;
+    
+    void ljForce(const CLJFunction &func,
+                 const CLJBoxes &boxes0, const CLJBoxes &boxes1,
+                 QVector<CLJForces> &forces0, QVector<CLJForces> &forces1,
+                 double scale_force=1) const;
+
+    void force(const CLJFunction &func, const CLJBoxes &boxes,
+               QVector<CLJForces> &forces, CLJPairList &pairlist,
+               double scale_force=1) const;
+
+    void coulombForce(const CLJFunction &func, const CLJBoxes &boxes,
+                      QVector<CLJForces> &forces, CLJPairList &pairlist,
+                      double scale_force=1) const;
+
+    void ljForce(const CLJFunction &func, const CLJBoxes &boxes,
+                 QVector<CLJForces> &forces, CLJPairList &pairlist,
+                 double scale_force=1) const;
+
 private:
+    void pvt_force(const CLJFunction &func, const CLJBoxes &boxes,
+                   QVector<CLJForces> &forces, double scale_force,
+                   bool calc_coul, bool calc_lj) const;
+
+    void pvt_force(const CLJFunction &func,
+                   const CLJBoxes &boxes0, const CLJBoxes &boxes1,
+                   QVector<CLJForces> &forces0, QVector<CLJForces> &forces1,
+                   double scale_force, bool calc_coul, bool calc_lj) const;
+
+    void pvt_force(const CLJFunction &func, const CLJBoxes &boxes,
+                   QVector<CLJForces> &forces, CLJPairList &pairlist,
+                   double scale_force, bool calc_coul, bool calc_lj) const;
+
     /** Whether or not the energy calculation should give the same
         result regardless of the order of summation (i.e. gives the same
         result even if different numbers of processors are used) */
@@ -0,0 +1,857 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#include "cljewaldfunction.h"
+
+#include "SireMaths/multifloat.h"
+#include "SireMaths/multidouble.h"
+#include "SireMaths/multiint.h"
+#include "SireMaths/constants.h"
+
+#include "SireBase/numberproperty.h"
+
+#include "SireUnits/units.h"
+
+#include "SireError/errors.h"
+
+#include "SireStream/datastream.h"
+#include "SireStream/shareddatastream.h"
+
+#include "detail/cljforcekernel.hpp"
+
+#include <cmath>
+
+#include <QDebug>
+
+using namespace SireMM;
+using namespace SireMaths;
+using namespace SireVol;
+using namespace SireBase;
+using namespace SireUnits;
+using namespace SireStream;
+
+/** The default tolerance of the Ewald sum */
+static const double default_ewald_tolerance = 1e-5;
+
+/** The number of points per angstrom used to tabulate erfc(beta r) */
+static const int ewald_points_per_angstrom = 1024;
+
+/** The maximum number of points in the erfc(beta r) table */
+static const int max_ewald_points = 1 << 20;
+
+namespace SireMM
+{
+    namespace detail
+    {
+        /** Return the value of the function tabulated in 'table', interpolated
+            linearly at the distances 'r'. 'scale' is the number of table points
+            per angstrom, and the distances are clamped to 'rmax' so that the
+            lookup never reads past the end of the table */
+        inline MultiFloat ewaldLookup(const float *table, const MultiFloat &r,
+                                      const MultiFloat &scale, const MultiFloat &rmax)
+        {
+            const MultiFloat x = r.min(rmax) * scale;
+            const MultiInt idx(x);
+            const MultiFloat frac = x - MultiFloat(idx);
+            
+            const MultiFloat f0(table, idx);
+            const MultiFloat f1(table + 1, idx);
+            
+            return f0 + frac * (f1 - f0);
+        }
+    
+        /** Functional form used by detail::cljForceKernel to calculate the
+            forces for the real-space Ewald electrostatics and cutoff LJ functions */
+        class EwaldForce
+        {
+        public:
+            EwaldForce(float coul_cutoff, float lj_cutoff, float table_scale,
+                       const float *erfc_table, const float *gauss_table,
+                       float scale_coul, float scale_lj)
+                 : Rc(coul_cutoff), Rlj2(lj_cutoff*lj_cutoff),
+                   tscale(table_scale),
+                   erfc_tab(erfc_table), gauss_tab(gauss_table),
+                   scl_coul(scale_coul), scl_lj(scale_lj),
+                   calc_coul(scale_coul != 0), calc_lj(scale_lj != 0)
+            {}
+            
+            bool hasCoulomb() const
+            {
+                return calc_coul;
+            }
+            
+            bool hasLJ() const
+            {
+                return calc_lj;
+            }
+            
+            /** E = q0q1 erfc(beta r) / r, so
+                -(dE/dr) / r = q0q1 * { erfc(beta r) / r^3 +
+                                        (2 beta / sqrt(pi)) exp(-beta^2 r^2) / r^2 } */
+            MultiFloat coulomb(const MultiFloat &r2, const MultiFloat &q0q1) const
+            {
+                const MultiFloat r = r2.sqrt();
+                const MultiFloat one_over_r = r.reciprocal();
+                const MultiFloat one_over_r2 = one_over_r * one_over_r;
+                
+                MultiFloat tmp = ewaldLookup(erfc_tab, r, tscale, Rc) * one_over_r;
+                tmp += ewaldLookup(gauss_tab, r, tscale, Rc);
+                tmp *= one_over_r2 * q0q1 * scl_coul;
+                
+                tmp &= r.compareLess(Rc);
+                
+                return tmp;
+            }
+            
+            /** E = eps * { (sig/r)^12 - (sig/r)^6 }, so
+                -(dE/dr) / r = eps * { 12 (sig/r)^12 - 6 (sig/r)^6 } / r^2 */
+            MultiFloat lj(const MultiFloat &r2, const MultiFloat &sigma,
+                          const MultiFloat &eps) const
+            {
+                const MultiFloat one_over_r2 = r2.reciprocal();
+                
+                MultiFloat sig6_over_r6 = sigma * sigma * one_over_r2;
+                sig6_over_r6 = sig6_over_r6 * sig6_over_r6 * sig6_over_r6;
+                
+                MultiFloat tmp = MultiFloat(12) * sig6_over_r6 * sig6_over_r6;
+                tmp -= MultiFloat(6) * sig6_over_r6;
+                tmp *= eps * one_over_r2 * scl_lj;
+                
+                tmp &= r2.compareLess(Rlj2);
+                
+                return tmp;
+            }
+            
+        private:
+            const MultiFloat Rc;
+            const MultiFloat Rlj2;
+            const MultiFloat tscale;
+            const float *erfc_tab;
+            const float *gauss_tab;
+            const MultiFloat scl_coul;
+            const MultiFloat scl_lj;
+            const bool calc_coul;
+            const bool calc_lj;
+        };
+        
+        /** Return the distance along one axis between 'x1' and 'x0'. If USE_BOX
+            is true then this is the minimum image distance in a periodic box
+            with side length 'box' */
+        template<bool USE_BOX>
+        inline MultiFloat ewaldDistance(const MultiFloat &x1, const MultiFloat &x0,
+                                        const MultiFloat &box, const MultiFloat &half_box)
+        {
+            MultiFloat tmp = x1 - x0;
+            tmp &= MULTIFLOAT_POS_MASK;  // this creates the absolute value :-)
+            
+            if (USE_BOX)
+                tmp -= box.logicalAnd( half_box.compareLess(tmp) );
+            
+            return tmp;
+        }
+        
+        /** This is the kernel used to calculate the real-space Ewald coulomb
+            and cutoff LJ energy between the atoms in 'atoms0' and 'atoms1'.
+            If IS_SELF is true then this calculates the energy within 'atoms0',
+            and 'atoms1' must be the same object as 'atoms0' */
+        template<bool USE_ARITHMETIC, bool USE_BOX, bool IS_SELF>
+        void ewaldEnergyKernel(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                               float coul_cutoff, float lj_cutoff,
+                               float table_scale, const float *erfc_table,
+                               const Vector &box_dimensions,
+                               double &cnrg, double &ljnrg)
+        {
+            const MultiFloat *x0 = atoms0.x().constData();
+            const MultiFloat *y0 = atoms0.y().constData();
+            const MultiFloat *z0 = atoms0.z().constData();
+            const MultiFloat *q0 = atoms0.q().constData();
+            const MultiFloat *sig0 = atoms0.sigma().constData();
+            const MultiFloat *eps0 = atoms0.epsilon().constData();
+            const MultiInt *id0 = atoms0.ID().constData();
+
+            const MultiFloat *x1 = atoms1.x().constData();
+            const MultiFloat *y1 = atoms1.y().constData();
+            const MultiFloat *z1 = atoms1.z().constData();
+            const MultiFloat *q1 = atoms1.q().constData();
+            const MultiFloat *sig1 = atoms1.sigma().constData();
+            const MultiFloat *eps1 = atoms1.epsilon().constData();
+            const MultiInt *id1 = atoms1.ID().constData();
+
+            const MultiFloat Rc(coul_cutoff);
+            const MultiFloat Rlj(lj_cutoff);
+            const MultiFloat tscale(table_scale);
+
+            const MultiFloat half(0.5);
+            const MultiInt dummy_id = CLJAtoms::idOfDummy();
+            const qint32 dummy_int = dummy_id[0];
+
+            MultiFloat tmp, r, r2, one_over_r, sigma, sig2_over_r2, sig6_over_r6;
+            MultiDouble icnrg(0), iljnrg(0);
+            MultiInt itmp;
+
+            const MultiFloat box_x( box_dimensions.x() );
+            const MultiFloat box_y( box_dimensions.y() );
+            const MultiFloat box_z( box_dimensions.z() );
+            
+            const MultiFloat half_box_x( 0.5 * box_dimensions.x() );
+            const MultiFloat half_box_y( 0.5 * box_dimensions.y() );
+            const MultiFloat half_box_z( 0.5 * box_dimensions.z() );
+
+            const int n0 = atoms0.x().count();
+            const int n1 = atoms1.x().count();
+
+            for (int i=0; i<n0; ++i)
+            {
+                for (int ii=0; ii<MultiFloat::count(); ++ii)
+                {
+                    if (id0[i][ii] == dummy_int)
+                        continue;
+
+                    const MultiInt id(id0[i][ii]);
+                    const MultiFloat x(x0[i][ii]);
+                    const MultiFloat y(y0[i][ii]);
+                    const MultiFloat z(z0[i][ii]);
+                    const MultiFloat q(q0[i][ii]);
+                    const MultiFloat sig( USE_ARITHMETIC ? sig0[i][ii] * sig0[i][ii]
+                                                         : sig0[i][ii] );
+                    const MultiFloat eps(eps0[i][ii]);
+
+                    for (int j = (IS_SELF ? i : 0); j<n1; ++j)
+                    {
+                        // if i == j then we double-calculate the energies, so must
+                        // scale them by 0.5
+                        const MultiFloat scale( (IS_SELF and i == j) ? 0.5 : 1.0 );
+                    
+                        tmp = ewaldDistance<USE_BOX>(x1[j], x, box_x, half_box_x);
+                        r2 = tmp * tmp;
+                        tmp = ewaldDistance<USE_BOX>(y1[j], y, box_y, half_box_y);
+                        r2.multiplyAdd(tmp, tmp);
+                        tmp = ewaldDistance<USE_BOX>(z1[j], z, box_z, half_box_z);
+                        r2.multiplyAdd(tmp, tmp);
+
+                        r = r2.sqrt();
+                        one_over_r = r.reciprocal();
+                
+                        // calculate the coulomb energy using
+                        // E = (q1 q2 / 4 pi eps_0) * erfc(beta r) / r
+                        tmp = ewaldLookup(erfc_table, r, tscale, Rc) * one_over_r;
+                        tmp *= q * q1[j];
+                    
+                        //apply the cutoff - compare r against Rc. This will
+                        //return 1 if r is less than Rc, or 0 otherwise. Logical
+                        //and will then remove all energies where r >= Rc
+                        tmp &= r.compareLess(Rc);
+
+                        //make sure that the ID of atoms1 is not zero, and is
+                        //also not the same as the atoms0. Intramolecular pairs
+                        //are removed from the reciprocal space sum by PMEFF
+                        itmp = id1[j].compareEqual(dummy_id);
+                        itmp |= id1[j].compareEqual(id);
+
+                        icnrg += scale * tmp.logicalAndNot(itmp);
+                        
+                        //now the LJ energy
+                        if (USE_ARITHMETIC)
+                        {
+                            sigma = sig + (sig1[j]*sig1[j]);
+                            sigma *= half;
+                        }
+                        else
+                        {
+                            sigma = sig * sig1[j];
+                        }
+                        
+                        sig2_over_r2 = sigma * one_over_r;
+                        sig2_over_r2 = sig2_over_r2*sig2_over_r2;
+                        sig6_over_r6 = sig2_over_r2*sig2_over_r2;
+                        sig6_over_r6 = sig6_over_r6*sig2_over_r2;
+
+                        tmp = sig6_over_r6 * sig6_over_r6;
+                        tmp -= sig6_over_r6;
+                        tmp *= eps;
+                        tmp *= eps1[j];
+                    
+                        tmp &= r.compareLess(Rlj);
+                        iljnrg += scale * tmp.logicalAndNot(itmp);
+                    }
+                }
+            }
+            
+            cnrg = icnrg.sum();
+            ljnrg = iljnrg.sum();
+        }
+    }
+}
+
+/////////
+///////// Implementation of CLJEwaldFunction
+/////////
+
+static const RegisterMetaType<CLJEwaldFunction> r_ewald;
+
+QDataStream SIREMM_EXPORT &operator<<(QDataStream &ds, const CLJEwaldFunction &func)
+{
+    writeHeader(ds, r_ewald, 1);
+    
+    ds << func.ewald_tol << static_cast<const CLJCutoffFunction&>(func);
+    
+    return ds;
+}
+
+QDataStream SIREMM_EXPORT &operator>>(QDataStream &ds, CLJEwaldFunction &func)
+{
+    VersionID v = readHeader(ds, r_ewald);
+    
+    if (v == 1)
+    {
+        ds >> func.ewald_tol >> static_cast<CLJCutoffFunction&>(func);
+        func.rebuildTables();
+    }
+    else
+        throw version_error(v, "1", r_ewald, CODELOC);
+    
+    return ds;
+}
+
+CLJEwaldFunction::CLJEwaldFunction()
+                 : ConcreteProperty<CLJEwaldFunction,CLJCutoffFunction>(),
+                   ewald_tol(default_ewald_tolerance)
+{
+    this->rebuildTables();
+}
+
+CLJFunctionPtr CLJEwaldFunction::defaultEwaldFunction()
+{
+    static CLJFunctionPtr ptr( new CLJEwaldFunction() );
+    return ptr;
+}
+
+CLJEwaldFunction::CLJEwaldFunction(Length cutoff)
+                 : ConcreteProperty<CLJEwaldFunction,CLJCutoffFunction>(cutoff),
+                   ewald_tol(default_ewald_tolerance)
+{
+    this->rebuildTables();
+}
+
+CLJEwaldFunction::CLJEwaldFunction(Length coul_cutoff, Length lj_cutoff)
+                 : ConcreteProperty<CLJEwaldFunction,CLJCutoffFunction>(coul_cutoff, lj_cutoff),
+                   ewald_tol(default_ewald_tolerance)
+{
+    this->rebuildTables();
+}
+
+CLJEwaldFunction::CLJEwaldFunction(const Space &space, Length cutoff)
+                 : ConcreteProperty<CLJEwaldFunction,CLJCutoffFunction>(space, cutoff),
+                   ewald_tol(default_ewald_tolerance)
+{
+    this->rebuildTables();
+}
+
+CLJEwaldFunction::CLJEwaldFunction(const Space &space, Length coul_cutoff, Length lj_cutoff)
+                 : ConcreteProperty<CLJEwaldFunction,CLJCutoffFunction>(space, coul_cutoff,
+                                                                        lj_cutoff),
+                   ewald_tol(default_ewald_tolerance)
+{
+    this->rebuildTables();
+}
+
+CLJEwaldFunction::CLJEwaldFunction(Length cutoff, COMBINING_RULES combining_rules)
+                 : ConcreteProperty<CLJEwaldFunction,CLJCutoffFunction>(cutoff, combining_rules),
+                   ewald_tol(default_ewald_tolerance)
+{
+    this->rebuildTables();
+}
+
+CLJEwaldFunction::CLJEwaldFunction(Length coul_cutoff, Length lj_cutoff,
+                                   COMBINING_RULES combining_rules)
+                 : ConcreteProperty<CLJEwaldFunction,CLJCutoffFunction>(
+                                   coul_cutoff, lj_cutoff, combining_rules),
+                   ewald_tol(default_ewald_tolerance)
+{
+    this->rebuildTables();
+}
+
+CLJEwaldFunction::CLJEwaldFunction(const Space &space, COMBINING_RULES combining_rules)
+                 : ConcreteProperty<CLJEwaldFunction,CLJCutoffFunction>(space, combining_rules),
+                   ewald_tol(default_ewald_tolerance)
+{
+    this->rebuildTables();
+}
+
+CLJEwaldFunction::CLJEwaldFunction(const Space &space, Length cutoff,
+                                   COMBINING_RULES combining_rules)
+                 : ConcreteProperty<CLJEwaldFunction,CLJCutoffFunction>(
+                                   space, cutoff, combining_rules),
+                   ewald_tol(default_ewald_tolerance)
+{
+    this->rebuildTables();
+}
+
+CLJEwaldFunction::CLJEwaldFunction(const Space &space, Length coul_cutoff, Length lj_cutoff,
+                                   COMBINING_RULES combining_rules)
+                 : ConcreteProperty<CLJEwaldFunction,CLJCutoffFunction>(
+                                   space, coul_cutoff, lj_cutoff, combining_rules),
+                   ewald_tol(default_ewald_tolerance)
+{
+    this->rebuildTables();
+}
+
+/** Copy constructor */
+CLJEwaldFunction::CLJEwaldFunction(const CLJEwaldFunction &other)
+                 : ConcreteProperty<CLJEwaldFunction,CLJCutoffFunction>(other),
+                   ewald_tol(other.ewald_tol), ewald_beta(other.ewald_beta),
+                   table_scale(other.table_scale),
+                   erfc_table(other.erfc_table), gauss_table(other.gauss_table)
+{}
+
+/** Destructor */
+CLJEwaldFunction::~CLJEwaldFunction()
+{}
+
+/** Copy assignment operator */
+CLJEwaldFunction& CLJEwaldFunction::operator=(const CLJEwaldFunction &other)
+{
+    ewald_tol = other.ewald_tol;
+    ewald_beta = other.ewald_beta;
+    table_scale = other.table_scale;
+    erfc_table = other.erfc_table;
+    gauss_table = other.gauss_table;
+    CLJCutoffFunction::operator=(other);
+    return *this;
+}
+
+/** Comparison operator */
+bool CLJEwaldFunction::operator==(const CLJEwaldFunction &other) const
+{
+    return ewald_tol == other.ewald_tol and CLJCutoffFunction::operator==(other);
+}
+
+/** Comparison operator */
+bool CLJEwaldFunction::operator!=(const CLJEwaldFunction &other) const
+{
+    return not operator==(other);
+}
+
+const char* CLJEwaldFunction::typeName()
+{
+    return QMetaType::typeName( qMetaTypeId<CLJEwaldFunction>() );
+}
+
+const char* CLJEwaldFunction::what() const
+{
+    return CLJEwaldFunction::typeName();
+}
+
+CLJEwaldFunction* CLJEwaldFunction::clone() const
+{
+    return new CLJEwaldFunction(*this);
+}
+
+QString CLJEwaldFunction::toString() const
+{
+    return QObject::tr("CLJEwaldFunction( ewaldTolerance() == %1, coulombCutoff() == %2 A, "
+                       "ljCutoff() == %3 A, space() == %4 )")
+            .arg(ewaldTolerance())
+            .arg(coulombCutoff().to(angstrom))
+            .arg(ljCutoff().to(angstrom))
+            .arg(space().toString());
+}
+
+/** Return the properties of this function */
+Properties CLJEwaldFunction::properties() const
+{
+    Properties props = CLJCutoffFunction::properties();
+    props.setProperty("ewaldTolerance", NumberProperty(ewaldTolerance()));
+    return props;
+}
+
+/** Return a copy of this function where the property 'name' has been set to the
+    value 'value' */
+CLJFunctionPtr CLJEwaldFunction::setProperty(const QString &name, const Property &value) const
+{
+    if (name == "ewaldTolerance")
+    {
+        CLJFunctionPtr ret(*this);
+        ret.edit().asA<CLJEwaldFunction>().setEwaldTolerance(
+                                                value.asA<NumberProperty>().value() );
+        return ret;
+    }
+    else
+        return CLJCutoffFunction::setProperty(name, value);
+}
+
+/** Return the value of the property with name 'name' */
+PropertyPtr CLJEwaldFunction::property(const QString &name) const
+{
+    if (name == "ewaldTolerance")
+    {
+        return NumberProperty(ewaldTolerance());
+    }
+    else
+    {
+        return CLJCutoffFunction::property(name);
+    }
+}
+
+/** Return whether or not this function contains a property called 'name' */
+bool CLJEwaldFunction::containsProperty(const QString &name) const
+{
+    return (name == "ewaldTolerance") or CLJCutoffFunction::containsProperty(name);
+}
+
+/** Set the coulomb and LJ cutoff distances to 'distance' */
+void CLJEwaldFunction::setCutoff(Length distance)
+{
+    CLJCutoffFunction::setCutoff(distance);
+    this->rebuildTables();
+}
+
+/** Set the coulomb and LJ cutoff distances to the specified values */
+void CLJEwaldFunction::setCutoff(Length coulomb, Length lj)
+{
+    CLJCutoffFunction::setCutoff(coulomb, lj);
+    this->rebuildTables();
+}
+
+/** Set the coulomb cutoff to the specified distance. This changes the
+    value of the Ewald splitting parameter */
+void CLJEwaldFunction::setCoulombCutoff(Length distance)
+{
+    CLJCutoffFunction::setCoulombCutoff(distance);
+    this->rebuildTables();
+}
+
+/** Set the Ewald tolerance. This is the value of erfc(beta r) at the
+    coulomb cutoff, and so sets the value of the Ewald splitting parameter.
+    Smaller tolerances give more accurate real-space energies, but require
+    a finer reciprocal space grid
+    
+    \throw SireError::invalid_arg
+*/
+void CLJEwaldFunction::setEwaldTolerance(double tolerance)
+{
+    if (tolerance <= 0 or tolerance >= 1)
+        throw SireError::invalid_arg( QObject::tr(
+                "The Ewald tolerance must lie between 0 and 1 (not including 0 or 1). "
+                "The value %1 is not valid.").arg(tolerance), CODELOC );
+
+    ewald_tol = tolerance;
+    this->rebuildTables();
+}
+
+/** Return the Ewald tolerance */
+double CLJEwaldFunction::ewaldTolerance() const
+{
+    return ewald_tol;
+}
+
+/** Return the Ewald splitting parameter, beta (in inverse angstroms) */
+double CLJEwaldFunction::beta() const
+{
+    return ewald_beta;
+}
+
+/** Return the Ewald splitting parameter, beta (in inverse angstroms), for which 
+    erfc(beta * cutoff) is equal to 'tolerance'. PMEFF uses this function so that
+    the reciprocal space sum uses the same value of beta as this function
+    
+    \throw SireError::invalid_arg
+*/
+double CLJEwaldFunction::calculateBeta(Length cutoff, double tolerance)
+{
+    const double rc = cutoff.to(angstrom);
+
+    if (rc <= 0)
+        throw SireError::invalid_arg( QObject::tr(
+                "Cannot calculate the Ewald splitting parameter using a cutoff "
+                "of %1 A.").arg(rc), CODELOC );
+
+    if (tolerance <= 0 or tolerance >= 1)
+        throw SireError::invalid_arg( QObject::tr(
+                "The Ewald tolerance must lie between 0 and 1 (not including 0 or 1). "
+                "The value %1 is not valid.").arg(tolerance), CODELOC );
+
+    //erfc(beta rc) decreases monotonically with beta, so find the
+    //value of beta by bisection
+    double lo = 0;
+    double hi = 1;
+
+    while (std::erfc(hi * rc) > tolerance)
+    {
+        hi *= 2;
+    }
+    
+    for (int i=0; i<100; ++i)
+    {
+        const double mid = 0.5 * (lo + hi);
+        
+        if (std::erfc(mid * rc) > tolerance)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    
+    return 0.5 * (lo + hi);
+}
+
+/** Internal function used to recalculate beta and to rebuild the tables
+    of erfc(beta r) and of the gaussian used for the forces */
+void CLJEwaldFunction::rebuildTables()
+{
+    if (coul_cutoff <= 0)
+    {
+        ewald_beta = 0;
+        table_scale = 1;
+        erfc_table = QVector<float>(2, 1.0);
+        gauss_table = QVector<float>(2, 0.0);
+        return;
+    }
+
+    ewald_beta = calculateBeta(coulombCutoff(), ewald_tol);
+    
+    table_scale = ewald_points_per_angstrom;
+    
+    if (coul_cutoff * table_scale > max_ewald_points)
+        table_scale = max_ewald_points / coul_cutoff;
+    
+    //the extra points allow the lookup at exactly r == Rc
+    const int npoints = int(coul_cutoff * table_scale) + 2;
+    
+    erfc_table = QVector<float>(npoints);
+    gauss_table = QVector<float>(npoints);
+    
+    float *erfc_array = erfc_table.data();
+    float *gauss_array = gauss_table.data();
+
+    const double two_beta_over_sqrt_pi = 2.0 * ewald_beta / std::sqrt(SireMaths::pi);
+    
+    for (int i=0; i<npoints; ++i)
+    {
+        const double r = i / double(table_scale);
+        const double beta_r = ewald_beta * r;
+
+        erfc_array[i] = std::erfc(beta_r);
+        gauss_array[i] = two_beta_over_sqrt_pi * std::exp(-beta_r*beta_r);
+    }
+}
+
+/** Calculate the coulomb and LJ intermolecular energy of all of the atoms in 'atoms',
+    returning the results in the arguments 'cnrg' and 'ljnrg' */
+void CLJEwaldFunction::calcVacEnergyGeo(const CLJAtoms &atoms,
+                                        double &cnrg, double &ljnrg) const
+{
+    detail::ewaldEnergyKernel<false,false,true>(atoms, atoms, coul_cutoff, lj_cutoff,
+                                                table_scale, erfc_table.constData(),
+                                                Vector(), cnrg, ljnrg);
+}
+
+/** Calculate the coulomb and LJ intermolecular energy of all of the atoms in 'atoms0'
+    with all of the atoms in 'atoms1', returning the results in the arguments 
+    'cnrg' and 'ljnrg' */
+void CLJEwaldFunction::calcVacEnergyGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                        double &cnrg, double &ljnrg, float min_distance) const
+{
+    detail::ewaldEnergyKernel<false,false,false>(atoms0, atoms1, coul_cutoff, lj_cutoff,
+                                                 table_scale, erfc_table.constData(),
+                                                 Vector(), cnrg, ljnrg);
+}
+
+/** Calculate the coulomb and LJ intermolecular energy of all of the atoms in 'atoms',
+    returning the results in the arguments 'cnrg' and 'ljnrg' */
+void CLJEwaldFunction::calcVacEnergyAri(const CLJAtoms &atoms,
+                                        double &cnrg, double &ljnrg) const
+{
+    detail::ewaldEnergyKernel<true,false,true>(atoms, atoms, coul_cutoff, lj_cutoff,
+                                               table_scale, erfc_table.constData(),
+                                               Vector(), cnrg, ljnrg);
+}
+
+/** Calculate the coulomb and LJ intermolecular energy of all of the atoms in 'atoms0'
+    with all of the atoms in 'atoms1', returning the results in the arguments 
+    'cnrg' and 'ljnrg' */
+void CLJEwaldFunction::calcVacEnergyAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                        double &cnrg, double &ljnrg, float min_distance) const
+{
+    detail::ewaldEnergyKernel<true,false,false>(atoms0, atoms1, coul_cutoff, lj_cutoff,
+                                                table_scale, erfc_table.constData(),
+                                                Vector(), cnrg, ljnrg);
+}
+
+/** Calculate the coulomb and LJ intermolecular energy of all of the atoms in 'atoms',
+    assuming periodic boundary conditions in a cubic box of size 'box_dimensions',
+    returning the results in the arguments 'cnrg' and 'ljnrg' */
+void CLJEwaldFunction::calcBoxEnergyGeo(const CLJAtoms &atoms, const Vector &box_dimensions,
+                                        double &cnrg, double &ljnrg) const
+{
+    detail::ewaldEnergyKernel<false,true,true>(atoms, atoms, coul_cutoff, lj_cutoff,
+                                               table_scale, erfc_table.constData(),
+                                               box_dimensions, cnrg, ljnrg);
+}
+
+/** Calculate the intermolecular energy between all atoms in 'atoms0' and all
+    atoms in 'atoms1', assuming periodic boundary conditions in a cubic box
+    of size 'box_dimensions, returning the result in the arguments 'cnrg' and 'ljnrg' */
+void CLJEwaldFunction::calcBoxEnergyGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                        const Vector &box_dimensions,
+                                        double &cnrg, double &ljnrg, float min_distance) const
+{
+    detail::ewaldEnergyKernel<false,true,false>(atoms0, atoms1, coul_cutoff, lj_cutoff,
+                                                table_scale, erfc_table.constData(),
+                                                box_dimensions, cnrg, ljnrg);
+}
+
+/** Calculate the coulomb and LJ intermolecular energy of all of the atoms in 'atoms',
+    assuming periodic boundary conditions in a cubic box of size 'box_dimensions',
+    returning the results in the arguments 'cnrg' and 'ljnrg' */
+void CLJEwaldFunction::calcBoxEnergyAri(const CLJAtoms &atoms, const Vector &box_dimensions,
+                                        double &cnrg, double &ljnrg) const
+{
+    detail::ewaldEnergyKernel<true,true,true>(atoms, atoms, coul_cutoff, lj_cutoff,
+                                              table_scale, erfc_table.constData(),
+                                              box_dimensions, cnrg, ljnrg);
+}
+
+/** Calculate the intermolecular energy between all atoms in 'atoms0' and all
+    atoms in 'atoms1', assuming periodic boundary conditions in a cubic box
+    of size 'box_dimensions, returning the result in the arguments 'cnrg' and 'ljnrg' */
+void CLJEwaldFunction::calcBoxEnergyAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                        const Vector &box_dimensions,
+                                        double &cnrg, double &ljnrg, float min_distance) const
+{
+    detail::ewaldEnergyKernel<true,true,false>(atoms0, atoms1, coul_cutoff, lj_cutoff,
+                                               table_scale, erfc_table.constData(),
+                                               box_dimensions, cnrg, ljnrg);
+}
+
+/** Return whether or not this function supports the calculation of forces */
+bool CLJEwaldFunction::supportsForceCalculation() const
+{
+    return true;
+}
+
+/** Calculate the coulomb and LJ forces between the passed atoms
+    in vacuum using arithmetic combining rules, adding them onto 'forces' */
+void CLJEwaldFunction::calcVacForceAri(const CLJAtoms &atoms, CLJForces &forces,
+                                       float scale_coul, float scale_lj) const
+{
+    const detail::EwaldForce func(coul_cutoff, lj_cutoff, table_scale,
+                                  erfc_table.constData(), gauss_table.constData(),
+                                  scale_coul, scale_lj);
+    detail::cljForce<true,false>(func, atoms, forces, Vector());
+}
+
+/** Calculate the coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in vacuum using arithmetic combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJEwaldFunction::calcVacForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                       CLJForces &forces0, CLJForces &forces1,
+                                       float scale_coul, float scale_lj) const
+{
+    const detail::EwaldForce func(coul_cutoff, lj_cutoff, table_scale,
+                                  erfc_table.constData(), gauss_table.constData(),
+                                  scale_coul, scale_lj);
+    detail::cljForce<true,false>(func, atoms0, atoms1, forces0, forces1,
+                                 Vector());
+}
+
+/** Calculate the coulomb and LJ forces between the passed atoms
+    in vacuum using geometric combining rules, adding them onto 'forces' */
+void CLJEwaldFunction::calcVacForceGeo(const CLJAtoms &atoms, CLJForces &forces,
+                                       float scale_coul, float scale_lj) const
+{
+    const detail::EwaldForce func(coul_cutoff, lj_cutoff, table_scale,
+                                  erfc_table.constData(), gauss_table.constData(),
+                                  scale_coul, scale_lj);
+    detail::cljForce<false,false>(func, atoms, forces, Vector());
+}
+
+/** Calculate the coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in vacuum using geometric combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJEwaldFunction::calcVacForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                       CLJForces &forces0, CLJForces &forces1,
+                                       float scale_coul, float scale_lj) const
+{
+    const detail::EwaldForce func(coul_cutoff, lj_cutoff, table_scale,
+                                  erfc_table.constData(), gauss_table.constData(),
+                                  scale_coul, scale_lj);
+    detail::cljForce<false,false>(func, atoms0, atoms1, forces0, forces1,
+                                  Vector());
+}
+
+/** Calculate the coulomb and LJ forces between the passed atoms
+    in a periodic box using arithmetic combining rules, adding them onto 'forces' */
+void CLJEwaldFunction::calcBoxForceAri(const CLJAtoms &atoms, const Vector &box_dimensions,
+                                       CLJForces &forces, float scale_coul, float scale_lj) const
+{
+    const detail::EwaldForce func(coul_cutoff, lj_cutoff, table_scale,
+                                  erfc_table.constData(), gauss_table.constData(),
+                                  scale_coul, scale_lj);
+    detail::cljForce<true,true>(func, atoms, forces, box_dimensions);
+}
+
+/** Calculate the coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in a periodic box using arithmetic combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJEwaldFunction::calcBoxForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                       const Vector &box_dimensions,
+                                       CLJForces &forces0, CLJForces &forces1,
+                                       float scale_coul, float scale_lj) const
+{
+    const detail::EwaldForce func(coul_cutoff, lj_cutoff, table_scale,
+                                  erfc_table.constData(), gauss_table.constData(),
+                                  scale_coul, scale_lj);
+    detail::cljForce<true,true>(func, atoms0, atoms1, forces0, forces1,
+                                box_dimensions);
+}
+
+/** Calculate the coulomb and LJ forces between the passed atoms
+    in a periodic box using geometric combining rules, adding them onto 'forces' */
+void CLJEwaldFunction::calcBoxForceGeo(const CLJAtoms &atoms, const Vector &box_dimensions,
+                                       CLJForces &forces, float scale_coul, float scale_lj) const
+{
+    const detail::EwaldForce func(coul_cutoff, lj_cutoff, table_scale,
+                                  erfc_table.constData(), gauss_table.constData(),
+                                  scale_coul, scale_lj);
+    detail::cljForce<false,true>(func, atoms, forces, box_dimensions);
+}
+
+/** Calculate the coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in a periodic box using geometric combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJEwaldFunction::calcBoxForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                       const Vector &box_dimensions,
+                                       CLJForces &forces0, CLJForces &forces1,
+                                       float scale_coul, float scale_lj) const
+{
+    const detail::EwaldForce func(coul_cutoff, lj_cutoff, table_scale,
+                                  erfc_table.constData(), gauss_table.constData(),
+                                  scale_coul, scale_lj);
+    detail::cljForce<false,true>(func, atoms0, atoms1, forces0, forces1,
+                                 box_dimensions);
+}
@@ -0,0 +1,202 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#ifndef SIREMM_CLJEWALDFUNCTION_H
+#define SIREMM_CLJEWALDFUNCTION_H
+
+#include "cljfunction.h"
+
+namespace SireMM
+{
+class CLJEwaldFunction;
+}
+
+QDataStream& operator<<(QDataStream&, const SireMM::CLJEwaldFunction&);
+QDataStream& operator>>(QDataStream&, SireMM::CLJEwaldFunction&);
+
+namespace SireMM
+{
+
+/** This CLJFunction calculates the real-space part of the Ewald sum
+    for the intermolecular coulomb energy of the passed CLJAtoms, together
+    with the LJ energy using a simple cutoff. The coulomb energy between
+    a pair of atoms is q0 q1 erfc(beta r) / r, where the Ewald splitting
+    parameter beta is chosen so that erfc(beta r) has decayed to the
+    Ewald tolerance at the coulomb cutoff.
+    
+    This function only provides the short-range part of the electrostatics.
+    It must be combined with the reciprocal space part (calculated using
+    a PMEFF that has the same cutoff and tolerance) to give the full
+    Ewald electrostatic energy of a periodic system.
+    
+    As MultiFloat does not provide exp or erfc, the values of erfc(beta r)
+    (and of the gaussian needed for the forces) are tabulated at 
+    construction, and are interpolated during the calculation
+    
+    @author Christopher Woods
+*/
+class SIREMM_EXPORT CLJEwaldFunction
+        : public SireBase::ConcreteProperty<CLJEwaldFunction,CLJCutoffFunction>
+{
+
+friend QDataStream& ::operator<<(QDataStream&, const CLJEwaldFunction&);
+friend QDataStream& ::operator>>(QDataStream&, CLJEwaldFunction&);
+
+public:
+    CLJEwaldFunction();
+    CLJEwaldFunction(Length cutoff);
+    CLJEwaldFunction(Length coul_cutoff, Length lj_cutoff);
+    
+    CLJEwaldFunction(const Space &space, Length cutoff);
+    CLJEwaldFunction(const Space &space, Length coul_cutoff, Length lj_cutoff);
+    
+    CLJEwaldFunction(Length cutoff, COMBINING_RULES combining_rules);
+    CLJEwaldFunction(Length coul_cutoff, Length lj_cutoff, COMBINING_RULES combining_rules);
+    
+    CLJEwaldFunction(const Space &space, COMBINING_RULES combining_rules);
+    CLJEwaldFunction(const Space &space, Length cutoff, COMBINING_RULES combining_rules);
+    CLJEwaldFunction(const Space &space, Length coul_cutoff, Length lj_cutoff,
+                     COMBINING_RULES combining_rules);
+    
+    CLJEwaldFunction(const CLJEwaldFunction &other);
+    
+    ~CLJEwaldFunction();
+    
+    CLJEwaldFunction& operator=(const CLJEwaldFunction &other);
+    
+    bool operator==(const CLJEwaldFunction &other) const;
+    bool operator!=(const CLJEwaldFunction &other) const;
+    
+    static const char* typeName();
+    const char* what() const;
+    
+    QString toString() const;
+    
+    CLJEwaldFunction* clone() const;
+
+    bool supportsForceCalculation() const;
+
+    Properties properties() const;
+    CLJFunctionPtr setProperty(const QString &name, const Property &value) const;
+    PropertyPtr property(const QString &name) const;
+    bool containsProperty(const QString &name) const;
+
+    void setCutoff(Length distance);
+    void setCutoff(Length coulomb_cutoff, Length lj_cutoff);
+    
+    void setCoulombCutoff(Length distance);
+
+    void setEwaldTolerance(double tolerance);
+    double ewaldTolerance() const;
+
+    double beta() const;
+
+    static double calculateBeta(Length cutoff, double tolerance);
+
+    static CLJFunctionPtr defaultEwaldFunction();
+
+protected:
+    void calcVacEnergyAri(const CLJAtoms &atoms,
+                          double &cnrg, double &ljnrg) const;
+    
+    void calcVacEnergyAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                          double &cnrg, double &ljnrg, float min_distance) const;
+
+    void calcVacEnergyGeo(const CLJAtoms &atoms,
+                          double &cnrg, double &ljnrg) const;
+    
+    void calcVacEnergyGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                          double &cnrg, double &ljnrg, float min_distance) const;
+
+    void calcBoxEnergyAri(const CLJAtoms &atoms, const Vector &box_dimensions,
+                          double &cnrg, double &ljnrg) const;
+    
+    void calcBoxEnergyAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                          const Vector &box_dimensions, double &cnrg, double &ljnrg,
+                          float min_distance) const;
+
+    void calcBoxEnergyGeo(const CLJAtoms &atoms, const Vector &box_dimensions,
+                          double &cnrg, double &ljnrg) const;
+    
+    void calcBoxEnergyGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                          const Vector &box_dimensions, double &cnrg, double &ljnrg,
+                          float min_distance) const;
+
+    void calcVacForceAri(const CLJAtoms &atoms, CLJForces &forces,
+                         float scale_coul, float scale_lj) const;
+    void calcVacForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
+
+    void calcVacForceGeo(const CLJAtoms &atoms, CLJForces &forces,
+                         float scale_coul, float scale_lj) const;
+    void calcVacForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
+
+    void calcBoxForceAri(const CLJAtoms &atoms, const Vector &box_dimensions,
+                         CLJForces &forces, float scale_coul, float scale_lj) const;
+    void calcBoxForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         const Vector &box_dimensions,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
+
+    void calcBoxForceGeo(const CLJAtoms &atoms, const Vector &box_dimensions,
+                         CLJForces &forces, float scale_coul, float scale_lj) const;
+    void calcBoxForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         const Vector &box_dimensions,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
+
+private:
+    void rebuildTables();
+
+    /** The Ewald tolerance - this is the value of erfc(beta r)
+        at the coulomb cutoff */
+    double ewald_tol;
+    
+    /** The Ewald splitting parameter (in inverse angstroms) */
+    double ewald_beta;
+    
+    /** The number of table points per angstrom */
+    float table_scale;
+    
+    /** Table of erfc(beta r) */
+    QVector<float> erfc_table;
+    
+    /** Table of (2 beta / sqrt(pi)) exp(-beta^2 r^2) */
+    QVector<float> gauss_table;
+};
+
+}
+
+Q_DECLARE_METATYPE( SireMM::CLJEwaldFunction )
+
+SIRE_EXPOSE_CLASS( SireMM::CLJEwaldFunction )
+
+#endif
@@ -34,6 +34,11 @@
 #include "SireMM/atomljs.h"
 #include "SireMol/mover.hpp"
 #include "SireMol/editor.hpp"
+#include "SireMol/selector.hpp"
+#include "SireMol/atom.h"
+#include "SireMol/moleculeinfodata.h"
+
+#include "SireFF/forcetable.h"
 
 #include "SireError/errors.h"
 
@@ -1009,3 +1014,162 @@ void CLJExtractor::initialise(CLJBoxes &boxes, CLJWorkspace &workspace)
         }
     }
 }
+
+/** Return the indicies of the atoms in 'view' that will have been placed
+    into the CLJAtoms created from this view, in the same order as those
+    atoms (this mirrors the logic in CLJAtoms::constructFrom, which skips
+    atoms that have neither a charge nor an LJ parameter) */
+static QVector<AtomIdx> getIncludedAtoms(const MoleculeView &view, const PropertyMap &map)
+{
+    QVector<AtomIdx> atomidxs;
+
+    if (view.isEmpty())
+        return atomidxs;
+    
+    const PropertyName chg_property = map["charge"];
+    const PropertyName lj_property = map["LJ"];
+
+    if (view.selectedAll())
+    {
+        const Molecule mol = view.molecule();
+        
+        const AtomCharges &chgs = mol.property(chg_property).asA<AtomCharges>();
+        const AtomLJs &ljs = mol.property(lj_property).asA<AtomLJs>();
+        
+        const MoleculeInfoData &molinfo = mol.data().info();
+        
+        atomidxs.reserve(mol.nAtoms());
+        
+        for (int i=0; i<chgs.nCutGroups(); ++i)
+        {
+            const CGIdx cgidx(i);
+            
+            const Charge *ichg = chgs.constData(cgidx);
+            const LJParameter *ilj = ljs.constData(cgidx);
+            
+            for (int j=0; j<chgs.nAtoms(cgidx); ++j)
+            {
+                if (ichg[j].value() != 0 or (not ilj[j].isDummy()))
+                {
+                    atomidxs.append( molinfo.atomIdx( CGAtomIdx(cgidx,Index(j)) ) );
+                }
+            }
+        }
+    }
+    else
+    {
+        Selector<Atom> atoms = view.atoms();
+        
+        QList<Charge> chgs = atoms.property<Charge>(chg_property);
+        QList<LJParameter> ljs = atoms.property<LJParameter>(lj_property);
+        
+        atomidxs.reserve(chgs.count());
+        
+        for (int i=0; i<chgs.count(); ++i)
+        {
+            if (chgs[i].value() != 0 or (not ljs[i].isDummy()))
+            {
+                atomidxs.append( atoms[i].index() );
+            }
+        }
+    }
+    
+    return atomidxs;
+}
+
+/** Add the forces in 'forces' (which must have been calculated for the
+    atoms in 'boxes', arranged in the same order as boxes.occupiedBoxes())
+    onto the atoms of this molecule in 'table', scaled by 'scale_force'. 
+    Note that this uses the committed version of the molecule, so 
+    this extractor must not have any uncommitted changes
+    
+    \throw SireError::invalid_state
+    \throw SireError::incompatible_error
+*/
+void CLJExtractor::addForces(const CLJBoxes &boxes, const QVector<CLJForces> &forces,
+                             SireFF::MolForceTable &table, double scale_force) const
+{
+    if (scale_force == 0 or cljidxs.isEmpty())
+        return;
+
+    if (this->needsCommitting())
+        throw SireError::invalid_state( QObject::tr(
+                "Cannot add the forces for molecule %1 as it contains changes "
+                "that have not yet been committed.")
+                    .arg(mol.toString()), CODELOC );
+    
+    const MoleculeInfoData &molinfo = mol.data().info();
+    
+    for (int i=0; i<cljidxs.count(); ++i)
+    {
+        const QVector<CLJBoxIndex> &idxs = cljidxs.at(i);
+        
+        if (idxs.isEmpty())
+            continue;
+        
+        QVector<AtomIdx> atomidxs;
+        
+        if (extractingByCutGroup())
+        {
+            if (selected_atoms.isNull() or selected_atoms.selectedAll(CGIdx(i)))
+                atomidxs = getIncludedAtoms(mol.cutGroup(CGIdx(i)), props);
+            else
+                atomidxs = getIncludedAtoms(PartialMolecule(mol,
+                                                 selected_atoms.mask(CGIdx(i))), props);
+        }
+        else if (extractingByResidue())
+        {
+            if (selected_atoms.isNull() or selected_atoms.selectedAll(ResIdx(i)))
+                atomidxs = getIncludedAtoms(mol.residue(ResIdx(i)), props);
+            else
+                atomidxs = getIncludedAtoms(PartialMolecule(mol,
+                                                 selected_atoms.mask(ResIdx(i))), props);
+        }
+        else
+        {
+            if (selected_atoms.isNull())
+                atomidxs = getIncludedAtoms(mol, props);
+            else
+                atomidxs = getIncludedAtoms(PartialMolecule(mol,selected_atoms), props);
+        }
+        
+        //the indicies are padded with null indicies up to a multiple of
+        //the vector size, so strip that padding before comparing
+        int nidxs = idxs.count();
+        
+        while (nidxs > atomidxs.count() and idxs.constData()[nidxs-1].isNull())
+        {
+            --nidxs;
+        }
+        
+        if (nidxs != atomidxs.count())
+            throw SireError::incompatible_error( QObject::tr(
+                    "Cannot add the forces for molecule %1 as the number of "
+                    "atoms in group %2 (%3) is not the same as the number "
+                    "of CLJ atoms extracted for the group (%4). Has the molecule "
+                    "been changed since the CLJ atoms were extracted?")
+                        .arg(mol.toString()).arg(i)
+                        .arg(atomidxs.count()).arg(nidxs), CODELOC );
+        
+        for (int j=0; j<nidxs; ++j)
+        {
+            const CLJBoxIndex &idx = idxs.constData()[j];
+            
+            if (idx.isNull())
+                continue;
+            
+            const int b = boxes.indexOf(idx);
+            
+            if (b < 0 or b >= forces.count())
+                continue;
+            
+            const CLJForces &box_forces = forces.constData()[b];
+            
+            if (idx.index() >= box_forces.count())
+                continue;
+            
+            table.add( molinfo.cgAtomIdx(atomidxs.constData()[j]),
+                       scale_force * box_forces.at(idx.index()) );
+        }
+    }
+}
@@ -32,6 +32,7 @@
 #include "cljatoms.h"
 #include "cljdelta.h"
 #include "cljworkspace.h"
+#include "cljforces.h"
 
 #include "SireMol/molecule.h"
 #include "SireMol/partialmolecule.h"
@@ -46,6 +47,11 @@ namespace SireMM
 class CLJExtractor;
 }
 
+namespace SireFF
+{
+class MolForceTable;
+}
+
 QDataStream& operator<<(QDataStream&, const SireMM::CLJExtractor&);
 QDataStream& operator>>(QDataStream&, SireMM::CLJExtractor&);
 
@@ -150,6 +156,9 @@ public:
     void commit(CLJBoxes &boxes, CLJWorkspace &workspace);
     void revert(CLJBoxes &boxes, CLJWorkspace &workspace);
 
+    void addForces(const CLJBoxes &boxes, const QVector<CLJForces> &forces,
+                   SireFF::MolForceTable &table, double scale_force=1) const;
+
 private:
     void initialise(CLJBoxes &boxes, CLJWorkspace &workspace);
 
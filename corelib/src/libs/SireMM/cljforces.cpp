@@ -0,0 +1,398 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2014  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#include "cljforces.h"
+
+#include "SireID/index.h"
+
+#include "SireError/errors.h"
+
+#include "SireStream/datastream.h"
+#include "SireStream/shareddatastream.h"
+
+using namespace SireMM;
+using namespace SireMaths;
+using namespace SireStream;
+
+static const RegisterMetaType<CLJForces> r_cljforces(NO_ROOT);
+
+QDataStream SIREMM_EXPORT &operator<<(QDataStream &ds, const CLJForces &forces)
+{
+    writeHeader(ds, r_cljforces, 1);
+    
+    SharedDataStream sds(ds);
+    
+    sds << MultiFloat::toArray(forces._fx)
+        << MultiFloat::toArray(forces._fy)
+        << MultiFloat::toArray(forces._fz);
+    
+    return ds;
+}
+
+QDataStream SIREMM_EXPORT &operator>>(QDataStream &ds, CLJForces &forces)
+{
+    VersionID v = readHeader(ds, r_cljforces);
+    
+    if (v == 1)
+    {
+        SharedDataStream sds(ds);
+        
+        QVector<float> fx, fy, fz;
+        
+        sds >> fx >> fy >> fz;
+        
+        forces._fx = MultiFloat::fromArray(fx);
+        forces._fy = MultiFloat::fromArray(fy);
+        forces._fz = MultiFloat::fromArray(fz);
+    }
+    else
+        throw version_error(v, "1", r_cljforces, CODELOC);
+    
+    return ds;
+}
+
+/** Null constructor */
+CLJForces::CLJForces()
+{}
+
+/** Construct space to hold the (zero) forces for 'natoms' atoms. Note that
+    the number of atoms will be padded up to a multiple of MultiFloat::count() */
+CLJForces::CLJForces(int natoms)
+{
+    if (natoms > 0)
+    {
+        const int nvecs = (natoms / MultiFloat::count()) +
+                          ( (natoms % MultiFloat::count() == 0) ? 0 : 1 );
+    
+        _fx = QVector<MultiFloat>(nvecs, MultiFloat(0));
+        _fy = _fx;
+        _fz = _fx;
+    }
+}
+
+/** Construct space to hold the (zero) forces acting on the passed atoms.
+    This uses exactly the same layout as 'atoms' */
+CLJForces::CLJForces(const CLJAtoms &atoms)
+{
+    if (not atoms.isEmpty())
+    {
+        _fx = QVector<MultiFloat>(atoms.x().count(), MultiFloat(0));
+        _fy = _fx;
+        _fz = _fx;
+    }
+}
+
+/** Copy constructor */
+CLJForces::CLJForces(const CLJForces &other)
+          : _fx(other._fx), _fy(other._fy), _fz(other._fz)
+{}
+
+/** Destructor */
+CLJForces::~CLJForces()
+{}
+
+/** Copy assignment operator */
+CLJForces& CLJForces::operator=(const CLJForces &other)
+{
+    _fx = other._fx;
+    _fy = other._fy;
+    _fz = other._fz;
+    return *this;
+}
+
+/** Comparison operator */
+bool CLJForces::operator==(const CLJForces &other) const
+{
+    return this == &other or
+           (_fx == other._fx and _fy == other._fy and _fz == other._fz);
+}
+
+/** Comparison operator */
+bool CLJForces::operator!=(const CLJForces &other) const
+{
+    return not operator==(other);
+}
+
+const char* CLJForces::typeName()
+{
+    return QMetaType::typeName( qMetaTypeId<CLJForces>() );
+}
+
+const char* CLJForces::what() const
+{
+    return CLJForces::typeName();
+}
+
+QString CLJForces::toString() const
+{
+    QStringList lines;
+    
+    foreach (Vector force, this->forces())
+    {
+        lines.append( force.toString() );
+    }
+    
+    return QObject::tr("CLJForces( %1 )").arg(lines.join(", "));
+}
+
+/** Return the number of forces in this set. Note that vectorisation
+    may mean that the array of forces has been padded */
+int CLJForces::count() const
+{
+    return MultiFloat::size() * _fx.count();
+}
+
+/** Return the number of forces in this set. Note that vectorisation
+    may mean that the array of forces has been padded */
+int CLJForces::size() const
+{
+    return count();
+}
+
+/** Return whether or not this set of forces is empty */
+bool CLJForces::isEmpty() const
+{
+    return _fx.isEmpty();
+}
+
+/** Return the force acting on the ith atom */
+Vector CLJForces::operator[](int i) const
+{
+    i = SireID::Index(i).map(count());
+    
+    const int idx = i / MultiFloat::count();
+    const int sub_idx = i % MultiFloat::count();
+    
+    return Vector( _fx.constData()[idx][sub_idx],
+                   _fy.constData()[idx][sub_idx],
+                   _fz.constData()[idx][sub_idx] );
+}
+
+/** Return the force acting on the ith atom */
+Vector CLJForces::at(int i) const
+{
+    return operator[](i);
+}
+
+/** Return the force acting on the ith atom */
+Vector CLJForces::getitem(int i) const
+{
+    return operator[](i);
+}
+
+/** Add the passed force onto the force acting on the ith atom */
+void CLJForces::add(int i, const Vector &force)
+{
+    i = SireID::Index(i).map(count());
+    
+    const int idx = i / MultiFloat::count();
+    const int sub_idx = i % MultiFloat::count();
+    
+    MultiFloat &fx = _fx.data()[idx];
+    MultiFloat &fy = _fy.data()[idx];
+    MultiFloat &fz = _fz.data()[idx];
+    
+    fx.set(sub_idx, fx[sub_idx] + force.x());
+    fy.set(sub_idx, fy[sub_idx] + force.y());
+    fz.set(sub_idx, fz[sub_idx] + force.z());
+}
+
+/** Set the force acting on the ith atom equal to 'force' */
+void CLJForces::set(int i, const Vector &force)
+{
+    i = SireID::Index(i).map(count());
+    
+    const int idx = i / MultiFloat::count();
+    const int sub_idx = i % MultiFloat::count();
+    
+    _fx.data()[idx].set(sub_idx, force.x());
+    _fy.data()[idx].set(sub_idx, force.y());
+    _fz.data()[idx].set(sub_idx, force.z());
+}
+
+/** Internal function used to assert that 'other' has the same layout as this */
+void CLJForces::assertSameSize(const CLJForces &other) const
+{
+    if (_fx.count() != other._fx.count())
+        throw SireError::incompatible_error( QObject::tr(
+                "Cannot combine together a set of %1 forces with a set of %2 forces.")
+                    .arg(count()).arg(other.count()), CODELOC );
+}
+
+/** Add the forces in 'other' onto these forces. Both sets of forces
+    must have the same size */
+CLJForces& CLJForces::operator+=(const CLJForces &other)
+{
+    if (isEmpty())
+    {
+        this->operator=(other);
+        return *this;
+    }
+    else if (other.isEmpty())
+        return *this;
+    
+    assertSameSize(other);
+    
+    MultiFloat *fx = _fx.data();
+    MultiFloat *fy = _fy.data();
+    MultiFloat *fz = _fz.data();
+    
+    const MultiFloat *ofx = other._fx.constData();
+    const MultiFloat *ofy = other._fy.constData();
+    const MultiFloat *ofz = other._fz.constData();
+    
+    for (int i=0; i<_fx.count(); ++i)
+    {
+        fx[i] += ofx[i];
+        fy[i] += ofy[i];
+        fz[i] += ofz[i];
+    }
+    
+    return *this;
+}
+
+/** Subtract the forces in 'other' from these forces. Both sets of forces
+    must have the same size */
+CLJForces& CLJForces::operator-=(const CLJForces &other)
+{
+    if (other.isEmpty())
+        return *this;
+    else if (isEmpty())
+    {
+        this->operator=(other);
+        this->operator*=(-1);
+        return *this;
+    }
+    
+    assertSameSize(other);
+    
+    MultiFloat *fx = _fx.data();
+    MultiFloat *fy = _fy.data();
+    MultiFloat *fz = _fz.data();
+    
+    const MultiFloat *ofx = other._fx.constData();
+    const MultiFloat *ofy = other._fy.constData();
+    const MultiFloat *ofz = other._fz.constData();
+    
+    for (int i=0; i<_fx.count(); ++i)
+    {
+        fx[i] -= ofx[i];
+        fy[i] -= ofy[i];
+        fz[i] -= ofz[i];
+    }
+    
+    return *this;
+}
+
+/** Scale all of the forces by 'scale' */
+CLJForces& CLJForces::operator*=(double scale)
+{
+    if (scale == 1 or isEmpty())
+        return *this;
+    
+    const MultiFloat s(scale);
+    
+    MultiFloat *fx = _fx.data();
+    MultiFloat *fy = _fy.data();
+    MultiFloat *fz = _fz.data();
+    
+    for (int i=0; i<_fx.count(); ++i)
+    {
+        fx[i] *= s;
+        fy[i] *= s;
+        fz[i] *= s;
+    }
+    
+    return *this;
+}
+
+/** Return the sum of these forces and 'other' */
+CLJForces CLJForces::operator+(const CLJForces &other) const
+{
+    CLJForces ret(*this);
+    ret += other;
+    return ret;
+}
+
+/** Return the difference of these forces and 'other' */
+CLJForces CLJForces::operator-(const CLJForces &other) const
+{
+    CLJForces ret(*this);
+    ret -= other;
+    return ret;
+}
+
+/** Return these forces scaled by 'scale' */
+CLJForces CLJForces::operator*(double scale) const
+{
+    CLJForces ret(*this);
+    ret *= scale;
+    return ret;
+}
+
+/** Set all of the forces to zero, without changing the layout */
+void CLJForces::zero()
+{
+    const MultiFloat z(0);
+
+    MultiFloat *fx = _fx.data();
+    MultiFloat *fy = _fy.data();
+    MultiFloat *fz = _fz.data();
+    
+    for (int i=0; i<_fx.count(); ++i)
+    {
+        fx[i] = z;
+        fy[i] = z;
+        fz[i] = z;
+    }
+}
+
+/** Return all of the forces as an array of vectors (including those
+    of any padded atoms) */
+QVector<Vector> CLJForces::forces() const
+{
+    QVector<Vector> f( count() );
+    Vector *fdata = f.data();
+    
+    int idx = 0;
+    
+    for (int i=0; i<_fx.count(); ++i)
+    {
+        const MultiFloat &fx = _fx.constData()[i];
+        const MultiFloat &fy = _fy.constData()[i];
+        const MultiFloat &fz = _fz.constData()[i];
+    
+        for (int j=0; j<MultiFloat::count(); ++j)
+        {
+            fdata[idx] = Vector(fx[j], fy[j], fz[j]);
+            ++idx;
+        }
+    }
+    
+    return f;
+}
@@ -0,0 +1,187 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2014  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#ifndef SIREMM_CLJFORCES_H
+#define SIREMM_CLJFORCES_H
+
+#include "cljatoms.h"
+
+SIRE_BEGIN_HEADER
+
+namespace SireMM
+{
+class CLJForces;
+}
+
+QDataStream& operator<<(QDataStream&, const SireMM::CLJForces&);
+QDataStream& operator>>(QDataStream&, SireMM::CLJForces&);
+
+namespace SireMM
+{
+
+using SireMaths::Vector;
+using SireMaths::MultiFloat;
+
+/** This class holds vectorised arrays of the forces acting on
+    a set of CLJAtoms. The forces are held in the same order
+    (and with the same padding) as the atoms in the CLJAtoms
+    from which this object was constructed, so that the force
+    on atom 'i' of the CLJAtoms is at index 'i' of this object.
+    
+    Like CLJAtoms, this class is intended to be used by the fast
+    functions used to calculate coulomb and LJ forces, and is not
+    intended for general use.
+    
+    @author Christopher Woods
+*/
+class SIREMM_EXPORT CLJForces
+{
+
+friend QDataStream& ::operator<<(QDataStream&, const CLJForces&);
+friend QDataStream& ::operator>>(QDataStream&, CLJForces&);
+
+public:
+    CLJForces();
+    CLJForces(int natoms);
+    CLJForces(const CLJAtoms &atoms);
+    
+    CLJForces(const CLJForces &other);
+    
+    ~CLJForces();
+    
+    CLJForces& operator=(const CLJForces &other);
+    
+    bool operator==(const CLJForces &other) const;
+    bool operator!=(const CLJForces &other) const;
+    
+    static const char* typeName();
+    const char* what() const;
+    
+    QString toString() const;
+    
+    int count() const;
+    int size() const;
+    
+    bool isEmpty() const;
+    
+    Vector operator[](int i) const;
+    Vector at(int i) const;
+    Vector getitem(int i) const;
+    
+    void add(int i, const Vector &force);
+    void set(int i, const Vector &force);
+    
+    CLJForces& operator+=(const CLJForces &other);
+    CLJForces& operator-=(const CLJForces &other);
+    
+    CLJForces& operator*=(double scale);
+    
+    CLJForces operator+(const CLJForces &other) const;
+    CLJForces operator-(const CLJForces &other) const;
+    
+    CLJForces operator*(double scale) const;
+    
+    void zero();
+    
+    QVector<Vector> forces() const;
+    
+    const QVector<MultiFloat>& x() const;
+    const QVector<MultiFloat>& y() const;
+    const QVector<MultiFloat>& z() const;
+    
+    MultiFloat* xData();
+    MultiFloat* yData();
+    MultiFloat* zData();
+
+private:
+    void assertSameSize(const CLJForces &other) const;
+
+    /** Vector of the x-components of the forces */
+    QVector<MultiFloat> _fx;
+    
+    /** Vector of the y-components of the forces */
+    QVector<MultiFloat> _fy;
+    
+    /** Vector of the z-components of the forces */
+    QVector<MultiFloat> _fz;
+};
+
+#ifndef SIRE_SKIP_INLINE_FUNCTIONS
+
+/** Return the vector of the vectorised x components of the forces */
+inline const QVector<MultiFloat>& CLJForces::x() const
+{
+    return _fx;
+}
+
+/** Return the vector of the vectorised y components of the forces */
+inline const QVector<MultiFloat>& CLJForces::y() const
+{
+    return _fy;
+}
+
+/** Return the vector of the vectorised z components of the forces */
+inline const QVector<MultiFloat>& CLJForces::z() const
+{
+    return _fz;
+}
+
+/** Return a modifiable pointer to the vectorised x components of the forces.
+    This is used by the CLJFunction force kernels to accumulate forces */
+inline MultiFloat* CLJForces::xData()
+{
+    return _fx.data();
+}
+
+/** Return a modifiable pointer to the vectorised y components of the forces.
+    This is used by the CLJFunction force kernels to accumulate forces */
+inline MultiFloat* CLJForces::yData()
+{
+    return _fy.data();
+}
+
+/** Return a modifiable pointer to the vectorised z components of the forces.
+    This is used by the CLJFunction force kernels to accumulate forces */
+inline MultiFloat* CLJForces::zData()
+{
+    return _fz.data();
+}
+
+#endif // SIRE_SKIP_INLINE_FUNCTIONS
+
+}
+
+Q_DECLARE_METATYPE(SireMM::CLJForces);
+
+Q_DECLARE_TYPEINFO(SireMM::CLJForces, Q_MOVABLE_TYPE);
+
+SIRE_EXPOSE_CLASS( SireMM::CLJForces )
+
+SIRE_END_HEADER
+
+#endif
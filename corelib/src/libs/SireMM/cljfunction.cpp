@@ -26,16 +26,29 @@
   *
 \*********************************************/
 
+#include "SireMaths/multifloat.h"
+#include "SireMaths/multidouble.h"
+#include "SireMaths/multiint.h"
+
+#include "detail/cljkernelviews.hpp"
+
+// Only the vectorised LJ grid kernel is compiled for each instruction
+// set (see detail/cljkernels.h). Everything else is compiled once, for
+// the baseline instruction set
+#ifndef SIRE_KERNEL_ISA
+
 #include <QElapsedTimer>
 
+#include <cstring>
+#include <new>
+
 #include "cljfunction.h"
 #include "cljboxes.h"
 #include "switchingfunction.h"
 
-#include "SireMaths/multidouble.h"
-
 #include "SireVol/cartesian.h"
 #include "SireVol/periodicbox.h"
+#include "SireVol/triclinicbox.h"
 #include "SireVol/gridinfo.h"
 
 #include "SireError/errors.h"
@@ -45,6 +58,7 @@
 #include "SireBase/numberproperty.h"
 #include "SireBase/lengthproperty.h"
 #include "SireBase/errors.h"
+#include "SireBase/cpuid.h"
 
 #include "SireStream/datastream.h"
 #include "SireStream/shareddatastream.h"
@@ -97,7 +111,8 @@ QDataStream SIREMM_EXPORT &operator>>(QDataStream &ds, CLJFunction &cljfunc)
 
 /** Constructor. By default we will use vacuum boundary conditions with
     arithmetic combining rules */
-CLJFunction::CLJFunction() : Property(), use_arithmetic(true), use_box(false)
+CLJFunction::CLJFunction()
+            : Property(), use_arithmetic(true), use_box(false), use_lattice(false)
 {}
 
 void CLJFunction::extractDetailsFromRules(SireMM::CLJFunction::COMBINING_RULES rules)
@@ -119,13 +134,15 @@ void CLJFunction::extractDetailsFromRules(SireMM::CLJFunction::COMBINING_RULES r
 
 /** Construct, using vacuum boundary conditions, but specifying the combining rules */
 CLJFunction::CLJFunction(COMBINING_RULES combining_rules)
-            : Property(), use_arithmetic(true), use_box(false)
+            : Property(), use_arithmetic(true), use_box(false), use_lattice(false)
 {
     extractDetailsFromRules(combining_rules);
 }
 
 void CLJFunction::extractDetailsFromSpace()
 {
+    use_lattice = false;
+
     if (spce.isNull())
     {
         use_box = false;
@@ -136,29 +153,41 @@ void CLJFunction::extractDetailsFromSpace()
         use_box = true;
         box_dimensions = spce.read().asA<PeriodicBox>().dimensions();
     }
-    else if (spce.read().isA<Cartesian>())
+    else if (spce.read().isA<TriclinicBox>())
     {
+        //the vacuum kernels are used with all of the periodic images 
+        //that are within the cutoff (see getLatticeImages)
+        use_box = false;
+        use_lattice = true;
+        box_dimensions = Vector(0);
+    }
+    else if (spce.read().isA<Cartesian>() and not spce.read().isPeriodic())
+    {
+        //other periodic spaces derived from Cartesian are not supported
+        //by the CLJ kernels, so must not be treated as vacuum
         use_box = false;
         box_dimensions = Vector(0);
     }
     else
         throw SireError::unsupported( QObject::tr(
                 "CLJFunction-based forcefields currently only support using either "
-                "periodic (cubic) boundary conditions, or vacuum boundary conditions. "
-                "They are not compatible with the passed space \"%1\".")
+                "periodic (cubic or triclinic) boundary conditions, or vacuum boundary "
+                "conditions. They are not compatible with the passed space \"%1\".")
                     .arg(spce.read().toString()), CODELOC );
 }
 
 /** Construct, using arithmetic combining rules, but specifying the space */
 CLJFunction::CLJFunction(const Space &space)
-            : Property(), spce(space), use_arithmetic(true), use_box(false)
+            : Property(), spce(space), use_arithmetic(true),
+              use_box(false), use_lattice(false)
 {
     extractDetailsFromSpace();
 }
 
 /** Construct, specifying both the combining rules and simulation space */
 CLJFunction::CLJFunction(const Space &space, COMBINING_RULES combining_rules)
-            : Property(), spce(space), use_arithmetic(true), use_box(false)
+            : Property(), spce(space), use_arithmetic(true),
+              use_box(false), use_lattice(false)
 {
     extractDetailsFromSpace();
     extractDetailsFromRules(combining_rules);
@@ -167,7 +196,8 @@ CLJFunction::CLJFunction(const Space &space, COMBINING_RULES combining_rules)
 /** Copy constructor */
 CLJFunction::CLJFunction(const CLJFunction &other)
             : Property(other), spce(other.spce), box_dimensions(other.box_dimensions),
-              use_arithmetic(other.use_arithmetic), use_box(other.use_box)
+              use_arithmetic(other.use_arithmetic), use_box(other.use_box),
+              use_lattice(other.use_lattice)
 {}
 
 /** Destructor */
@@ -183,6 +213,7 @@ CLJFunction& CLJFunction::operator=(const CLJFunction &other)
         box_dimensions = other.box_dimensions;
         use_arithmetic = other.use_arithmetic;
         use_box = other.use_box;
+        use_lattice = other.use_lattice;
         Property::operator=(other);
     }
     
@@ -394,7 +425,7 @@ const Space& CLJFunction::space() const
 /** Return whether or not the space of the function is periodic */
 bool CLJFunction::isPeriodic() const
 {
-    return use_box;
+    return use_box or use_lattice;
 }
 
 /** Set the space used by the function */
@@ -432,6 +463,12 @@ bool CLJFunction::supportsGridCalculation() const
     return false;
 }
 
+/** Return whether or not this function supports calculating forces */
+bool CLJFunction::supportsForceCalculation() const
+{
+    return false;
+}
+
 /** Dummy function that needs to be overridden to support grid calculations */
 void CLJFunction::calcBoxGrid(const CLJAtoms &atoms, const GridInfo &gridinfo,
                               const Vector &box_dimensions,
@@ -453,6 +490,389 @@ void CLJFunction::calcVacGrid(const CLJAtoms &atoms, const GridInfo &gridinfo,
     }
 }
 
+/////////
+///////// Selection of the vectorised kernels
+/////////
+
+namespace SireMM
+{
+namespace detail
+{
+
+/** Return the kernels compiled for the baseline instruction set */
+static CLJKernels baselineKernels()
+{
+    CLJKernels kernels;
+    kernels.isa = "baseline";
+    kernels.width = baseline::getKernelWidth();
+    baseline::getShiftKernels(kernels.shift);
+    baseline::getRFKernels(kernels.rf);
+    baseline::getLJGridKernel(kernels.lj_grid);
+    return kernels;
+}
+
+/** Choose the fastest set of kernels that is supported by this processor.
+    The choice can be limited by setting the environment variable
+    SIRE_VECTOR_ISA to "baseline", "avx2" or "avx512", e.g. to compare
+    the results of the different kernels */
+static CLJKernels selectKernels()
+{
+    #ifdef SIRE_VECTOR_DISPATCH
+        const QString wanted = QString::fromLocal8Bit( qgetenv("SIRE_VECTOR_ISA") )
+                                        .trimmed().toLower();
+
+        if (wanted == "baseline")
+            return baselineKernels();
+
+        CPUID cpuid;
+
+        #ifdef SIRE_HAVE_AVX512_KERNELS
+        if ( (wanted.isEmpty() or wanted == "avx512") and cpuid.supportsAVX512F() )
+        {
+            CLJKernels kernels;
+            kernels.isa = "avx512";
+            kernels.width = avx512::getKernelWidth();
+            avx512::getShiftKernels(kernels.shift);
+            avx512::getRFKernels(kernels.rf);
+            avx512::getLJGridKernel(kernels.lj_grid);
+            return kernels;
+        }
+        #endif
+
+        #ifdef SIRE_HAVE_AVX2_KERNELS
+        if ( cpuid.supportsAVX2() and cpuid.supports("fma3") )
+        {
+            CLJKernels kernels;
+            kernels.isa = "avx2";
+            kernels.width = avx2::getKernelWidth();
+            avx2::getShiftKernels(kernels.shift);
+            avx2::getRFKernels(kernels.rf);
+            avx2::getLJGridKernel(kernels.lj_grid);
+            return kernels;
+        }
+        #endif
+    #endif
+
+    return baselineKernels();
+}
+
+/** Return the vectorised kernels used on this processor. These are
+    chosen the first time that they are needed */
+const CLJKernels& cljKernels()
+{
+    static const CLJKernels kernels = selectKernels();
+    return kernels;
+}
+
+/** Construct the packed data of 'atoms' to pass to the chosen kernels */
+CLJKernelAtomsData::CLJKernelAtomsData(const CLJAtoms &atoms) : buffer(0)
+{
+    const int width = cljKernels().width;
+    const int align = width * sizeof(float);
+    const int n = atoms.count();
+
+    k.x = reinterpret_cast<const float*>( atoms.x().constData() );
+    k.y = reinterpret_cast<const float*>( atoms.y().constData() );
+    k.z = reinterpret_cast<const float*>( atoms.z().constData() );
+    k.q = reinterpret_cast<const float*>( atoms.q().constData() );
+    k.sig = reinterpret_cast<const float*>( atoms.sigma().constData() );
+    k.eps = reinterpret_cast<const float*>( atoms.epsilon().constData() );
+    k.id = reinterpret_cast<const qint32*>( atoms.ID().constData() );
+    k.count = n;
+    k.dummy_id = CLJAtoms::idOfDummy()[0];
+
+    if ( n % width == 0 and quintptr(k.x) % align == 0 and quintptr(k.y) % align == 0 and
+         quintptr(k.z) % align == 0 and quintptr(k.q) % align == 0 and
+         quintptr(k.sig) % align == 0 and quintptr(k.eps) % align == 0 and
+         quintptr(k.id) % align == 0 )
+    {
+        //the kernels can use the data of the CLJAtoms directly
+        return;
+    }
+
+    //copy the data into an aligned buffer, padding each array
+    //with dummy atoms up to a whole number of vectors
+    const int npadded = width * ((n + width - 1) / width);
+
+    buffer = qMallocAligned(7 * npadded * sizeof(float), align);
+
+    if (buffer == 0)
+        throw std::bad_alloc();
+
+    float *x = static_cast<float*>(buffer);
+    float *y = x + npadded;
+    float *z = y + npadded;
+    float *q = z + npadded;
+    float *sig = q + npadded;
+    float *eps = sig + npadded;
+    qint32 *id = reinterpret_cast<qint32*>(eps + npadded);
+
+    std::memcpy(x, k.x, n * sizeof(float));
+    std::memcpy(y, k.y, n * sizeof(float));
+    std::memcpy(z, k.z, n * sizeof(float));
+    std::memcpy(q, k.q, n * sizeof(float));
+    std::memcpy(sig, k.sig, n * sizeof(float));
+    std::memcpy(eps, k.eps, n * sizeof(float));
+    std::memcpy(id, k.id, n * sizeof(qint32));
+
+    for (int i=n; i<npadded; ++i)
+    {
+        x[i] = 0;
+        y[i] = 0;
+        z[i] = 0;
+        q[i] = 0;
+        sig[i] = 0;
+        eps[i] = 0;
+        id[i] = k.dummy_id;
+    }
+
+    k.x = x;
+    k.y = y;
+    k.z = z;
+    k.q = q;
+    k.sig = sig;
+    k.eps = eps;
+    k.id = id;
+    k.count = npadded;
+}
+
+/** Destructor */
+CLJKernelAtomsData::~CLJKernelAtomsData()
+{
+    if (buffer)
+        qFreeAligned(buffer);
+}
+
+/** Return 'vector' in the form passed to the kernels */
+CLJKernelVector cljKernelVector(const Vector &vector)
+{
+    CLJKernelVector k;
+
+    k.x = vector.x();
+    k.y = vector.y();
+    k.z = vector.z();
+
+    return k;
+}
+
+/** Return 'grid_info' in the form passed to the kernels */
+CLJKernelGrid cljKernelGrid(const GridInfo &grid_info)
+{
+    CLJKernelGrid k;
+
+    //the first grid point is the origin of the grid
+    const Vector origin = grid_info.point(0);
+
+    k.origin[0] = origin.x();
+    k.origin[1] = origin.y();
+    k.origin[2] = origin.z();
+    k.spacing = grid_info.spacing().value();
+    k.dimx = grid_info.dimX();
+    k.dimy = grid_info.dimY();
+    k.dimz = grid_info.dimZ();
+
+    return k;
+}
+
+} // end of namespace detail
+} // end of namespace SireMM
+
+#endif // #ifndef SIRE_KERNEL_ISA
+
+/////////
+///////// Vectorised LJ grid kernel. This is compiled once
+///////// for each instruction set - see detail/cljkernels.h
+/////////
+
+namespace SireMM
+{
+namespace detail
+{
+namespace SIRE_KERNEL_NAMESPACE
+{
+
+using SireMaths::MultiDouble;
+
+/** Internal function used to calculate the LJ repulsion and dispersion 
+    grids for the points from 'start' to 'end'. Using geometric combining 
+    rules the grids hold sum_j eps_j sig_j^12 / r^12 and sum_j eps_j sig_j^6 / r^6 
+    (with sig and eps the reduced parameters held in CLJAtoms), so that the energy 
+    of an atom is eps_i (sig_i^12 rep - sig_i^6 disp). Using arithmetic combining
+    rules the grids are for a probe atom with reduced sigma 'sigma', and hold
+    sum_j eps_j sig_ij^12 / r^12 and sum_j eps_j sig_ij^6 / r^6, so that the 
+    energy of an atom with that sigma is eps_i (rep - disp) */
+template<bool use_box>
+static void calcLJGridPotentials(const CLJAtomsView &atoms, const CLJGridView &grid_info,
+                                 const CLJVectorView &box_dimensions,
+                                 bool use_arithmetic, float sigma, float lj_cutoff,
+                                 const int start, const int end,
+                                 float *rep_array, float *disp_array)
+{
+    const MultiFloat* const x = atoms.x().constData();
+    const MultiFloat* const y = atoms.y().constData();
+    const MultiFloat* const z = atoms.z().constData();
+    const MultiFloat* const sig = atoms.sigma().constData();
+    const MultiFloat* const eps = atoms.epsilon().constData();
+    const MultiInt* const id = atoms.ID().constData();
+    
+    const MultiFloat Rlj2( lj_cutoff*lj_cutoff );
+    const MultiFloat min_r2( clj_grid_min_distance*clj_grid_min_distance );
+    const MultiFloat half(0.5);
+    const MultiFloat probe_sig2( sigma*sigma );
+    const MultiInt dummy_id = atoms.idOfDummy();
+
+    const MultiFloat box_x( box_dimensions.x() );
+    const MultiFloat box_y( box_dimensions.y() );
+    const MultiFloat box_z( box_dimensions.z() );
+    
+    const MultiFloat half_box_x( 0.5 * box_dimensions.x() );
+    const MultiFloat half_box_y( 0.5 * box_dimensions.y() );
+    const MultiFloat half_box_z( 0.5 * box_dimensions.z() );
+
+    MultiFloat tmp, r2, one_over_r2, sig2_over_r2, sig6_over_r6;
+    MultiFloat mask;
+
+    const int nats = atoms.x().count();
+
+    for (int i = start; i < end; ++i)
+    {
+        const CLJVectorView grid_point = grid_info.point(i);
+        
+        const MultiFloat px(grid_point.x());
+        const MultiFloat py(grid_point.y());
+        const MultiFloat pz(grid_point.z());
+        
+        MultiDouble rep(0), disp(0);
+        
+        for (int j=0; j<nats; ++j)
+        {
+            //calculate the distance between the atom and grid point
+            tmp = px - x[j];
+            
+            if (use_box)
+            {
+                tmp &= MULTIFLOAT_POS_MASK;
+                tmp -= box_x.logicalAnd( half_box_x.compareLess(tmp) );
+            }
+            
+            r2 = tmp * tmp;
+
+            tmp = py - y[j];
+            
+            if (use_box)
+            {
+                tmp &= MULTIFLOAT_POS_MASK;
+                tmp -= box_y.logicalAnd( half_box_y.compareLess(tmp) );
+            }
+            
+            r2.multiplyAdd(tmp, tmp);
+
+            tmp = pz - z[j];
+            
+            if (use_box)
+            {
+                tmp &= MULTIFLOAT_POS_MASK;
+                tmp -= box_z.logicalAnd( half_box_z.compareLess(tmp) );
+            }
+            
+            r2.multiplyAdd(tmp, tmp);
+
+            //remove atoms beyond the cutoff, and dummy atoms
+            mask = r2.compareLess(Rlj2);
+            mask = mask.logicalAndNot( id[j].compareEqual(dummy_id) );
+
+            one_over_r2 = r2.max(min_r2).reciprocal();
+            
+            if (use_arithmetic)
+            {
+                tmp = half * (probe_sig2 + sig[j]*sig[j]);
+                sig2_over_r2 = tmp * tmp * one_over_r2;
+            }
+            else
+            {
+                sig2_over_r2 = sig[j] * sig[j] * one_over_r2;
+            }
+            
+            sig6_over_r6 = sig2_over_r2 * sig2_over_r2;
+            sig6_over_r6 *= sig2_over_r2;
+            
+            tmp = eps[j].logicalAnd(mask);
+            
+            disp += tmp * sig6_over_r6;
+            rep += tmp * sig6_over_r6 * sig6_over_r6;
+        }
+        
+        *rep_array = rep.sum();
+        *disp_array = disp.sum();
+        ++rep_array;
+        ++disp_array;
+    }
+}
+
+/** Calculate the LJ repulsion and dispersion grids for the points from
+    'start' to 'end', in a periodic box if 'use_box' is true */
+static void ljGrid(const CLJKernelAtoms &atoms, const CLJKernelGrid &grid_info,
+                   const CLJKernelVector &box_dimensions,
+                   bool use_box, bool use_arithmetic, float sigma, float lj_cutoff,
+                   int start, int end, float *rep_array, float *disp_array)
+{
+    if (use_box)
+        calcLJGridPotentials<true>(atoms, grid_info, box_dimensions, use_arithmetic,
+                                   sigma, lj_cutoff, start, end, rep_array, disp_array);
+    else
+        calcLJGridPotentials<false>(atoms, grid_info, box_dimensions, use_arithmetic,
+                                    sigma, lj_cutoff, start, end, rep_array, disp_array);
+}
+
+/** Return the LJ grid kernel compiled for this instruction set */
+void getLJGridKernel(CLJLJGridKernel &kernel)
+{
+    kernel = &ljGrid;
+}
+
+/** Return the number of floats in each vector used by the kernels
+    compiled for this instruction set */
+int getKernelWidth()
+{
+    return MultiFloat::count();
+}
+
+} // end of namespace SIRE_KERNEL_NAMESPACE
+} // end of namespace detail
+} // end of namespace SireMM
+
+#ifndef SIRE_KERNEL_ISA
+
+/** Calculate the LJ repulsion and dispersion grids for the points from 
+    'start' to 'end' in vacuum. This uses the LJ cutoff of this function. Functions
+    that use a different form of the LJ potential should override this function */
+void CLJFunction::calcVacLJGrid(const CLJAtoms &atoms, const GridInfo &gridinfo,
+                                float sigma, const int start, const int end,
+                                float *repulsion, float *dispersion) const
+{
+    detail::cljKernels().lj_grid(detail::CLJKernelAtomsData(atoms),
+                                 detail::cljKernelGrid(gridinfo),
+                                 detail::cljKernelVector(Vector(0)),
+                                 false, use_arithmetic, sigma, this->ljCutoff().value(),
+                                 start, end, repulsion, dispersion);
+}
+
+/** Calculate the LJ repulsion and dispersion grids for the points from 
+    'start' to 'end' in a periodic box. This uses the LJ cutoff of this function.
+    Functions that use a different form of the LJ potential should override
+    this function */
+void CLJFunction::calcBoxLJGrid(const CLJAtoms &atoms, const GridInfo &gridinfo,
+                                const Vector &box_dimensions, float sigma,
+                                const int start, const int end,
+                                float *repulsion, float *dispersion) const
+{
+    detail::cljKernels().lj_grid(detail::CLJKernelAtomsData(atoms),
+                                 detail::cljKernelGrid(gridinfo),
+                                 detail::cljKernelVector(box_dimensions),
+                                 true, use_arithmetic, sigma, this->ljCutoff().value(),
+                                 start, end, repulsion, dispersion);
+}
+
 namespace SireMM
 {
     namespace detail
@@ -499,6 +919,59 @@ namespace SireMM
     }
 }
 
+namespace SireMM
+{
+    namespace detail
+    {
+        class CLJLJGridCalculator
+        {
+        public:
+            CLJLJGridCalculator()
+                : atoms(0), grid_info(0), cljfunc(0), sigma(0),
+                  reppot(0), disppot(0), use_box(false)
+            {}
+            
+            CLJLJGridCalculator(const CLJAtoms &_atoms, const GridInfo &_grid_info,
+                                const CLJFunction &_cljfunc, float _sigma,
+                                float *_reppot, float *_disppot)
+                : atoms(&_atoms), grid_info(&_grid_info), cljfunc(&_cljfunc),
+                  sigma(_sigma), reppot(_reppot), disppot(_disppot),
+                  use_box(_cljfunc.use_box)
+            {}
+            
+            ~CLJLJGridCalculator()
+            {}
+            
+            void operator()(const tbb::blocked_range<int> &range) const
+            {
+                if (use_box)
+                {
+                    cljfunc->calcBoxLJGrid(*atoms, *grid_info, cljfunc->box_dimensions,
+                                           sigma, range.begin(), range.end(),
+                                           &(reppot[range.begin()]),
+                                           &(disppot[range.begin()]));
+                }
+                else
+                {
+                    cljfunc->calcVacLJGrid(*atoms, *grid_info, sigma,
+                                           range.begin(), range.end(),
+                                           &(reppot[range.begin()]),
+                                           &(disppot[range.begin()]));
+                }
+            }
+            
+        private:
+            const CLJAtoms* const atoms;
+            const GridInfo* const grid_info;
+            const CLJFunction* const cljfunc;
+            const float sigma;
+            float *reppot;
+            float *disppot;
+            const bool use_box;
+        };
+    }
+}
+
 /** Return the potential on the described grid of the passed atoms using
     this function. This returns an empty grid if this function doesn't support
     grid calculations */
@@ -508,13 +981,48 @@ QVector<float> CLJFunction::calculate(const CLJAtoms &atoms, const GridInfo &gri
     
     if (this->supportsGridCalculation() and not gridinfo.isEmpty())
     {
-        SireMM::detail::CLJGridCalculator calc(atoms, gridinfo, *this, gridpot.data());
+        //in a TriclinicBox the potential is that of all of the periodic
+        //images of the atoms that are within the cutoff of the grid
+        const CLJAtoms grid_atoms = use_lattice ? 
+                        this->getLatticeImages(gridinfo.dimensions(), atoms, true) : atoms;
+    
+        SireMM::detail::CLJGridCalculator calc(grid_atoms, gridinfo, *this,
+                                               gridpot.data());
         tbb::parallel_for(tbb::blocked_range<int>(0,gridinfo.nPoints(),4096), calc);
     }
     
     return gridpot;
 }
 
+/** Return the LJ repulsion and dispersion grids of the passed atoms, on the 
+    described grid, using this function. If geometric combining rules are used
+    then the grids hold sum_j eps_j sig_j^12 / r^12 and sum_j eps_j sig_j^6 / r^6,
+    and 'sigma' is ignored. The LJ energy of an atom at a grid point is then
+    eps_i (sig_i^12 rep - sig_i^6 disp). If arithmetic combining rules are used
+    then the grids are specific to atoms with (reduced) sigma 'sigma', and
+    hold sum_j eps_j sig_ij^12 / r^12 and sum_j eps_j sig_ij^6 / r^6, so that
+    the LJ energy of an atom with that sigma at a grid point is eps_i (rep - disp).
+    Note that sig and eps are the reduced parameters held in CLJAtoms.
+    This returns empty grids if this function doesn't support grid calculations */
+boost::tuple< QVector<float>,QVector<float> >
+CLJFunction::calculateLJ(const CLJAtoms &atoms, const GridInfo &gridinfo, float sigma) const
+{
+    QVector<float> reppot( gridinfo.nPoints(), 0.0 );
+    QVector<float> disppot( gridinfo.nPoints(), 0.0 );
+    
+    if (this->supportsGridCalculation() and not gridinfo.isEmpty())
+    {
+        const CLJAtoms grid_atoms = use_lattice ? 
+                        this->getLatticeImages(gridinfo.dimensions(), atoms, true) : atoms;
+    
+        SireMM::detail::CLJLJGridCalculator calc(grid_atoms, gridinfo, *this, sigma,
+                                                 reppot.data(), disppot.data());
+        tbb::parallel_for(tbb::blocked_range<int>(0,gridinfo.nPoints(),4096), calc);
+    }
+    
+    return boost::tuple< QVector<float>,QVector<float> >(reppot, disppot);
+}
+
 /** Calculate the coulomb energy between all atoms in 'atoms' */
 double CLJFunction::calcVacCoulombEnergyAri(const CLJAtoms &atoms) const
 {
@@ -658,6 +1166,299 @@ double CLJFunction::calcBoxLJEnergyGeo(const CLJAtoms &atoms0, const CLJAtoms &a
     return ljnrg;
 }
 
+/** Calculate the forces between all atoms in 'atoms', adding them onto 'forces'.
+    This needs to be overridden by functions that support force calculations */
+void CLJFunction::calcVacForceAri(const CLJAtoms&, CLJForces&, float, float) const
+{
+    throw SireError::unsupported( QObject::tr(
+            "The CLJ function %1 does not support the calculation of forces.")
+                .arg(this->what()), CODELOC );
+}
+
+/** Calculate the forces between all atoms in 'atoms0' and 'atoms1', adding them
+    onto 'forces0' and 'forces1'. This needs to be overridden by functions that
+    support force calculations */
+void CLJFunction::calcVacForceAri(const CLJAtoms&, const CLJAtoms&,
+                                  CLJForces&, CLJForces&, float, float) const
+{
+    throw SireError::unsupported( QObject::tr(
+            "The CLJ function %1 does not support the calculation of forces.")
+                .arg(this->what()), CODELOC );
+}
+
+/** Calculate the forces between all atoms in 'atoms', adding them onto 'forces'.
+    This needs to be overridden by functions that support force calculations */
+void CLJFunction::calcVacForceGeo(const CLJAtoms&, CLJForces&, float, float) const
+{
+    throw SireError::unsupported( QObject::tr(
+            "The CLJ function %1 does not support the calculation of forces.")
+                .arg(this->what()), CODELOC );
+}
+
+/** Calculate the forces between all atoms in 'atoms0' and 'atoms1', adding them
+    onto 'forces0' and 'forces1'. This needs to be overridden by functions that
+    support force calculations */
+void CLJFunction::calcVacForceGeo(const CLJAtoms&, const CLJAtoms&,
+                                  CLJForces&, CLJForces&, float, float) const
+{
+    throw SireError::unsupported( QObject::tr(
+            "The CLJ function %1 does not support the calculation of forces.")
+                .arg(this->what()), CODELOC );
+}
+
+/** Calculate the forces between all atoms in 'atoms', adding them onto 'forces'.
+    This needs to be overridden by functions that support force calculations */
+void CLJFunction::calcBoxForceAri(const CLJAtoms&, const Vector&,
+                                  CLJForces&, float, float) const
+{
+    throw SireError::unsupported( QObject::tr(
+            "The CLJ function %1 does not support the calculation of forces.")
+                .arg(this->what()), CODELOC );
+}
+
+/** Calculate the forces between all atoms in 'atoms0' and 'atoms1', adding them
+    onto 'forces0' and 'forces1'. This needs to be overridden by functions that
+    support force calculations */
+void CLJFunction::calcBoxForceAri(const CLJAtoms&, const CLJAtoms&, const Vector&,
+                                  CLJForces&, CLJForces&, float, float) const
+{
+    throw SireError::unsupported( QObject::tr(
+            "The CLJ function %1 does not support the calculation of forces.")
+                .arg(this->what()), CODELOC );
+}
+
+/** Calculate the forces between all atoms in 'atoms', adding them onto 'forces'.
+    This needs to be overridden by functions that support force calculations */
+void CLJFunction::calcBoxForceGeo(const CLJAtoms&, const Vector&,
+                                  CLJForces&, float, float) const
+{
+    throw SireError::unsupported( QObject::tr(
+            "The CLJ function %1 does not support the calculation of forces.")
+                .arg(this->what()), CODELOC );
+}
+
+/** Calculate the forces between all atoms in 'atoms0' and 'atoms1', adding them
+    onto 'forces0' and 'forces1'. This needs to be overridden by functions that
+    support force calculations */
+void CLJFunction::calcBoxForceGeo(const CLJAtoms&, const CLJAtoms&, const Vector&,
+                                  CLJForces&, CLJForces&, float, float) const
+{
+    throw SireError::unsupported( QObject::tr(
+            "The CLJ function %1 does not support the calculation of forces.")
+                .arg(this->what()), CODELOC );
+}
+
+/** Internal function used to get the axis-aligned box that encloses
+    the (non-dummy) atoms in 'atoms'. This returns false if there are
+    no such atoms */
+static bool getAtomsBox(const CLJAtoms &atoms, AABox &box)
+{
+    if (atoms.isEmpty())
+        return false;
+
+    const Vector mincoords = atoms.minCoords();
+    const Vector maxcoords = atoms.maxCoords();
+    
+    if (mincoords.x() > maxcoords.x())
+        //all of the atoms are dummies
+        return false;
+    
+    box = AABox::from(mincoords, maxcoords);
+    return true;
+}
+
+/** Internal function used when the space is a TriclinicBox. This returns 
+    all of the periodic images of 'atoms1' that could have atoms within
+    the cutoff of the box 'box0', combined into a single CLJAtoms. The central
+    image (the atoms themselves) is only included if 'include_central' is true.
+    The cutoff cannot be more than half of the minimum image distance, so
+    only one image of each pair of atoms can be within the cutoff. This means 
+    that the energy calculated with the vacuum kernels (which apply the cutoff) 
+    between the atoms and these images is the minimum image energy */
+CLJAtoms CLJFunction::getLatticeImages(const AABox &box0, const CLJAtoms &atoms1,
+                                       bool include_central) const
+{
+    if (not this->hasCutoff())
+        throw SireError::unsupported( QObject::tr(
+                "The CLJ function %1 does not use a cutoff, so cannot be used "
+                "with the periodic space %2.")
+                    .arg(this->what()).arg(spce.read().toString()), CODELOC );
+    
+    const TriclinicBox &lattice = spce.read().asA<TriclinicBox>();
+    
+    const double cutoff = qMax( this->coulombCutoff().value(), this->ljCutoff().value() );
+    
+    if (2.0*cutoff > lattice.minimumImageDistance())
+        throw SireError::incompatible_error( QObject::tr(
+                "The cutoff of the CLJ function %1 (%2 A) is more than half of the "
+                "minimum image distance of the space %3 (%4 A).")
+                    .arg(this->what()).arg(cutoff)
+                    .arg(lattice.toString()).arg(lattice.minimumImageDistance()),
+                        CODELOC );
+    
+    CLJAtoms images;
+    
+    AABox box1;
+    
+    if (not getAtomsBox(atoms1, box1))
+        return images;
+    
+    const QVector<Vector> centers = lattice.getImagesWithin(box1.center(), box0.center(),
+                                              cutoff + box0.radius() + box1.radius());
+    
+    foreach (const Vector &center, centers)
+    {
+        const Vector delta = center - box1.center();
+        
+        if (delta.isZero())
+        {
+            if (include_central)
+                images += atoms1;
+        }
+        else
+            images += atoms1.translate(delta);
+    }
+    
+    return images;
+}
+
+/** Internal function used to calculate the energy between the atoms in 'atoms'
+    in a TriclinicBox. This is the energy within the central image plus half of
+    the energy with the other periodic images (as each pair of atoms is seen
+    twice, once from each atom) */
+void CLJFunction::calcLatticeEnergy(const CLJAtoms &atoms,
+                                    double &cnrg, double &ljnrg) const
+{
+    if (use_arithmetic)
+        this->calcVacEnergyAri(atoms, cnrg, ljnrg);
+    else
+        this->calcVacEnergyGeo(atoms, cnrg, ljnrg);
+
+    AABox box;
+    
+    if (not getAtomsBox(atoms, box))
+        return;
+    
+    const CLJAtoms images = this->getLatticeImages(box, atoms, false);
+    
+    if (not images.isEmpty())
+    {
+        double icnrg(0), iljnrg(0);
+        
+        if (use_arithmetic)
+            this->calcVacEnergyAri(atoms, images, icnrg, iljnrg, 0);
+        else
+            this->calcVacEnergyGeo(atoms, images, icnrg, iljnrg, 0);
+        
+        cnrg += 0.5 * icnrg;
+        ljnrg += 0.5 * iljnrg;
+    }
+}
+
+/** Internal function used to calculate the energy between the atoms in 'atoms0'
+    and the atoms in 'atoms1' in a TriclinicBox */
+void CLJFunction::calcLatticeEnergy(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                    double &cnrg, double &ljnrg) const
+{
+    cnrg = 0;
+    ljnrg = 0;
+    
+    AABox box0;
+    
+    if (not getAtomsBox(atoms0, box0))
+        return;
+    
+    const CLJAtoms images = this->getLatticeImages(box0, atoms1, true);
+    
+    if (images.isEmpty())
+        return;
+    
+    if (use_arithmetic)
+        this->calcVacEnergyAri(atoms0, images, cnrg, ljnrg, 0);
+    else
+        this->calcVacEnergyGeo(atoms0, images, cnrg, ljnrg, 0);
+}
+
+/** Internal function used to calculate the forces between the atoms in 'atoms'
+    in a TriclinicBox, adding them onto 'forces'. Every atom sees all of the
+    periodic images of the other atoms, so the forces on the images
+    are not needed */
+void CLJFunction::calcLatticeForce(const CLJAtoms &atoms, CLJForces &forces,
+                                   float scale_coul, float scale_lj) const
+{
+    if (use_arithmetic)
+        this->calcVacForceAri(atoms, forces, scale_coul, scale_lj);
+    else
+        this->calcVacForceGeo(atoms, forces, scale_coul, scale_lj);
+
+    AABox box;
+    
+    if (not getAtomsBox(atoms, box))
+        return;
+    
+    const CLJAtoms images = this->getLatticeImages(box, atoms, false);
+    
+    if (not images.isEmpty())
+    {
+        CLJForces image_forces(images);
+        
+        if (use_arithmetic)
+            this->calcVacForceAri(atoms, images, forces, image_forces,
+                                  scale_coul, scale_lj);
+        else
+            this->calcVacForceGeo(atoms, images, forces, image_forces,
+                                  scale_coul, scale_lj);
+    }
+}
+
+/** Internal function used to calculate the forces between the atoms in 'atoms0'
+    and the atoms in 'atoms1' in a TriclinicBox, adding them onto 'forces0'
+    and 'forces1'. The forces on each periodic image of 'atoms1' are
+    added back onto 'forces1' */
+void CLJFunction::calcLatticeForce(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                   CLJForces &forces0, CLJForces &forces1,
+                                   float scale_coul, float scale_lj) const
+{
+    AABox box0;
+    
+    if (not getAtomsBox(atoms0, box0))
+        return;
+    
+    const CLJAtoms images = this->getLatticeImages(box0, atoms1, true);
+    
+    if (images.isEmpty())
+        return;
+    
+    CLJForces image_forces(images);
+    
+    if (use_arithmetic)
+        this->calcVacForceAri(atoms0, images, forces0, image_forces, scale_coul, scale_lj);
+    else
+        this->calcVacForceGeo(atoms0, images, forces0, image_forces, scale_coul, scale_lj);
+
+    //each image is a translated copy of atoms1, so has the same layout
+    const int n1 = atoms1.x().count();
+    const int nimages = images.x().count() / n1;
+    
+    MultiFloat *fx = forces1.xData();
+    MultiFloat *fy = forces1.yData();
+    MultiFloat *fz = forces1.zData();
+    
+    const MultiFloat *ix = image_forces.x().constData();
+    const MultiFloat *iy = image_forces.y().constData();
+    const MultiFloat *iz = image_forces.z().constData();
+    
+    for (int image=0; image<nimages; ++image)
+    {
+        for (int i=0; i<n1; ++i)
+        {
+            fx[i] += ix[image*n1 + i];
+            fy[i] += iy[image*n1 + i];
+            fz[i] += iz[image*n1 + i];
+        }
+    }
+}
+
 /** Return the total energy between 'atoms', returning the coulomb part in 'cnrg'
     and the LJ part in 'ljnrg' */
 void CLJFunction::operator()(const CLJAtoms &atoms,
@@ -668,6 +1469,10 @@ void CLJFunction::operator()(const CLJAtoms &atoms,
         cnrg = 0;
         ljnrg = 0;
     }
+    else if (use_lattice)
+    {
+        this->calcLatticeEnergy(atoms, cnrg, ljnrg);
+    }
     else
     {
         if (use_arithmetic)
@@ -698,6 +1503,13 @@ void CLJFunction::operator()(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
         ljnrg = 0;
         return;
     }
+    else if (use_lattice)
+    {
+        if (atoms0.count() > atoms1.count())
+            this->calcLatticeEnergy(atoms1, atoms0, cnrg, ljnrg);
+        else
+            this->calcLatticeEnergy(atoms0, atoms1, cnrg, ljnrg);
+    }
     else if (atoms0.count() > atoms1.count())
     {
         if (use_arithmetic)
@@ -994,6 +1806,12 @@ double CLJFunction::coulomb(const CLJAtoms &atoms) const
     {
         return 0;
     }
+    else if (use_lattice)
+    {
+        double cnrg, ljnrg;
+        this->calcLatticeEnergy(atoms, cnrg, ljnrg);
+        return cnrg;
+    }
     else
     {
         if (use_arithmetic)
@@ -1027,6 +1845,17 @@ double CLJFunction::coulomb(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
     {
         return 0;
     }
+    else if (use_lattice)
+    {
+        double cnrg, ljnrg;
+        
+        if (atoms0.count() > atoms1.count())
+            this->calcLatticeEnergy(atoms1, atoms0, cnrg, ljnrg);
+        else
+            this->calcLatticeEnergy(atoms0, atoms1, cnrg, ljnrg);
+        
+        return cnrg;
+    }
     else if (atoms0.count() > atoms1.count())
     {
         if (use_arithmetic)
@@ -1076,6 +1905,12 @@ double CLJFunction::lj(const CLJAtoms &atoms) const
     {
         return 0;
     }
+    else if (use_lattice)
+    {
+        double cnrg, ljnrg;
+        this->calcLatticeEnergy(atoms, cnrg, ljnrg);
+        return ljnrg;
+    }
     else
     {
         if (use_arithmetic)
@@ -1109,6 +1944,17 @@ double CLJFunction::lj(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
     {
         return 0;
     }
+    else if (use_lattice)
+    {
+        double cnrg, ljnrg;
+        
+        if (atoms0.count() > atoms1.count())
+            this->calcLatticeEnergy(atoms1, atoms0, cnrg, ljnrg);
+        else
+            this->calcLatticeEnergy(atoms0, atoms1, cnrg, ljnrg);
+        
+        return ljnrg;
+    }
     else if (atoms0.count() > atoms1.count())
     {
         if (use_arithmetic)
@@ -1151,6 +1997,314 @@ double CLJFunction::lj(const CLJBoxes &atoms0, const CLJBoxes &atoms1) const
     return this->calculate(atoms0, atoms1).get<1>();
 }
 
+/** Internal function that calculates the forces between the atoms in 'atoms',
+    scaling the coulomb and LJ parts by 'scale_coul' and 'scale_lj', and adding
+    the result onto 'forces' */
+void CLJFunction::pvt_force(const CLJAtoms &atoms, CLJForces &forces,
+                            float scale_coul, float scale_lj) const
+{
+    if (atoms.isEmpty())
+        return;
+    
+    if (forces.isEmpty())
+        forces = CLJForces(atoms);
+    else if (forces.count() != atoms.count())
+        throw SireError::incompatible_error( QObject::tr(
+                "Cannot calculate the forces on %1 atoms using a force array of size %2.")
+                    .arg(atoms.count()).arg(forces.count()), CODELOC );
+
+    if (scale_coul == 0 and scale_lj == 0)
+        return;
+    
+    if (use_lattice)
+    {
+        this->calcLatticeForce(atoms, forces, scale_coul, scale_lj);
+    }
+    else if (use_arithmetic)
+    {
+        if (use_box)
+            this->calcBoxForceAri(atoms, box_dimensions, forces, scale_coul, scale_lj);
+        else
+            this->calcVacForceAri(atoms, forces, scale_coul, scale_lj);
+    }
+    else
+    {
+        if (use_box)
+            this->calcBoxForceGeo(atoms, box_dimensions, forces, scale_coul, scale_lj);
+        else
+            this->calcVacForceGeo(atoms, forces, scale_coul, scale_lj);
+    }
+}
+
+/** Internal function that calculates the forces between the atoms in 'atoms0'
+    and 'atoms1', scaling the coulomb and LJ parts by 'scale_coul' and 'scale_lj',
+    and adding the result onto 'forces0' and 'forces1' */
+void CLJFunction::pvt_force(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                            CLJForces &forces0, CLJForces &forces1,
+                            float scale_coul, float scale_lj) const
+{
+    if (atoms0.isEmpty() or atoms1.isEmpty())
+        return;
+    
+    if (forces0.isEmpty())
+        forces0 = CLJForces(atoms0);
+    
+    if (forces1.isEmpty())
+        forces1 = CLJForces(atoms1);
+    
+    if (forces0.count() != atoms0.count() or forces1.count() != atoms1.count())
+        throw SireError::incompatible_error( QObject::tr(
+                "Cannot calculate the forces on %1 and %2 atoms using force arrays "
+                "of size %3 and %4.")
+                    .arg(atoms0.count()).arg(atoms1.count())
+                    .arg(forces0.count()).arg(forces1.count()), CODELOC );
+
+    if (scale_coul == 0 and scale_lj == 0)
+        return;
+
+    //as with the energy, loop over the smaller set of atoms in the outer loop
+    const bool swap = atoms0.count() > atoms1.count();
+
+    const CLJAtoms &a0 = swap ? atoms1 : atoms0;
+    const CLJAtoms &a1 = swap ? atoms0 : atoms1;
+    CLJForces &f0 = swap ? forces1 : forces0;
+    CLJForces &f1 = swap ? forces0 : forces1;
+
+    if (use_lattice)
+    {
+        this->calcLatticeForce(a0, a1, f0, f1, scale_coul, scale_lj);
+    }
+    else if (use_arithmetic)
+    {
+        if (use_box)
+            this->calcBoxForceAri(a0, a1, box_dimensions, f0, f1, scale_coul, scale_lj);
+        else
+            this->calcVacForceAri(a0, a1, f0, f1, scale_coul, scale_lj);
+    }
+    else
+    {
+        if (use_box)
+            this->calcBoxForceGeo(a0, a1, box_dimensions, f0, f1, scale_coul, scale_lj);
+        else
+            this->calcVacForceGeo(a0, a1, f0, f1, scale_coul, scale_lj);
+    }
+}
+
+/** Internal function used to make sure that 'forces' has the right
+    size and layout to hold the forces on the atoms in 'boxes' */
+static void prepareBoxForces(const CLJBoxes &boxes, QVector<CLJForces> &forces)
+{
+    const CLJBoxes::Container &b = boxes.occupiedBoxes();
+
+    if (forces.count() != b.count())
+    {
+        if (not forces.isEmpty())
+            throw SireError::incompatible_error( QObject::tr(
+                    "Cannot calculate the forces on %1 boxes of atoms using an array "
+                    "of forces for %2 boxes.")
+                        .arg(b.count()).arg(forces.count()), CODELOC );
+    
+        forces = QVector<CLJForces>(b.count());
+    }
+    
+    CLJForces *f = forces.data();
+    
+    for (int i=0; i<b.count(); ++i)
+    {
+        if (f[i].isEmpty())
+            f[i] = CLJForces(b.constData()[i].read().atoms());
+    }
+}
+
+/** Internal function that calculates the forces between the atoms in 'atoms',
+    adding them onto 'forces'. The forces are arranged in the same order as
+    atoms.occupiedBoxes() */
+void CLJFunction::pvt_force(const CLJBoxes &atoms, QVector<CLJForces> &forces,
+                            float scale_coul, float scale_lj) const
+{
+    prepareBoxForces(atoms, forces);
+    
+    const CLJBoxes::Container &boxes = atoms.occupiedBoxes();
+    const CLJBoxPtr *boxes_array = boxes.constData();
+    CLJForces *forces_array = forces.data();
+    
+    const bool has_cutoff = this->hasCutoff();
+    const float min_cutoff = has_cutoff ? qMax( this->coulombCutoff(), this->ljCutoff() )
+                                        : 0;
+
+    for (int i=0; i<boxes.count(); ++i)
+    {
+        const CLJBox &box0 = boxes_array[i].read();
+    
+        //calculate the self-force of the box
+        this->pvt_force(box0.atoms(), forces_array[i], scale_coul, scale_lj);
+        
+        //now calculate its interaction with all other boxes
+        for (int j=i+1; j<boxes.count(); ++j)
+        {
+            const CLJBox &box1 = boxes_array[j].read();
+        
+            if (has_cutoff)
+            {
+                if (atoms.getDistance(spce.read(), box0.index(), box1.index()) >= min_cutoff)
+                    continue;
+            }
+            
+            this->pvt_force(box0.atoms(), box1.atoms(), forces_array[i], forces_array[j],
+                            scale_coul, scale_lj);
+        }
+    }
+}
+
+/** Internal function that calculates the forces between the atoms in 'atoms0' and
+    'atoms1', adding them onto 'forces0' and 'forces1'. The forces are arranged
+    in the same order as atoms0.occupiedBoxes() and atoms1.occupiedBoxes() */
+void CLJFunction::pvt_force(const CLJBoxes &atoms0, const CLJBoxes &atoms1,
+                            QVector<CLJForces> &forces0, QVector<CLJForces> &forces1,
+                            float scale_coul, float scale_lj) const
+{
+    prepareBoxForces(atoms0, forces0);
+    prepareBoxForces(atoms1, forces1);
+    
+    const CLJBoxes::Container &boxes0 = atoms0.occupiedBoxes();
+    const CLJBoxes::Container &boxes1 = atoms1.occupiedBoxes();
+    
+    CLJForces *forces0_array = forces0.data();
+    CLJForces *forces1_array = forces1.data();
+    
+    const bool has_cutoff = this->hasCutoff() and atoms0.length() == atoms1.length();
+    const float min_cutoff = has_cutoff ? qMax( this->coulombCutoff(), this->ljCutoff() )
+                                        : 0;
+    
+    for (int i=0; i<boxes0.count(); ++i)
+    {
+        const CLJBox &box0 = boxes0.constData()[i].read();
+    
+        for (int j=0; j<boxes1.count(); ++j)
+        {
+            const CLJBox &box1 = boxes1.constData()[j].read();
+            
+            if (has_cutoff)
+            {
+                if (atoms0.getDistance(spce.read(), box0.index(), box1.index()) >= min_cutoff)
+                    continue;
+            }
+            
+            this->pvt_force(box0.atoms(), box1.atoms(),
+                            forces0_array[i], forces1_array[j], scale_coul, scale_lj);
+        }
+    }
+}
+
+/** Calculate the coulomb and LJ forces acting between the atoms in 'atoms',
+    adding them (multiplied by 'scale_force') onto 'forces'. If 'forces' is empty,
+    then it is created with the same layout as 'atoms'. This raises an
+    exception if this function does not support force calculations */
+void CLJFunction::force(const CLJAtoms &atoms, CLJForces &forces, double scale_force) const
+{
+    this->pvt_force(atoms, forces, scale_force, scale_force);
+}
+
+/** Calculate the coulomb and LJ forces acting between the atoms in 'atoms0'
+    and 'atoms1', adding them (multiplied by 'scale_force') onto 'forces0'
+    and 'forces1' */
+void CLJFunction::force(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                        CLJForces &forces0, CLJForces &forces1, double scale_force) const
+{
+    this->pvt_force(atoms0, atoms1, forces0, forces1, scale_force, scale_force);
+}
+
+/** Calculate the coulomb and LJ forces acting between the atoms in 'atoms',
+    adding them (multiplied by 'scale_force') onto 'forces', which holds the 
+    forces for each box in atoms.occupiedBoxes() */
+void CLJFunction::force(const CLJBoxes &atoms, QVector<CLJForces> &forces,
+                        double scale_force) const
+{
+    this->pvt_force(atoms, forces, scale_force, scale_force);
+}
+
+/** Calculate the coulomb and LJ forces acting between the atoms in 'atoms0'
+    and 'atoms1', adding them (multiplied by 'scale_force') onto 'forces0'
+    and 'forces1', which hold the forces for each of the occupied boxes */
+void CLJFunction::force(const CLJBoxes &atoms0, const CLJBoxes &atoms1,
+                        QVector<CLJForces> &forces0, QVector<CLJForces> &forces1,
+                        double scale_force) const
+{
+    this->pvt_force(atoms0, atoms1, forces0, forces1, scale_force, scale_force);
+}
+
+/** Calculate the coulomb forces acting between the atoms in 'atoms',
+    adding them (multiplied by 'scale_force') onto 'forces' */
+void CLJFunction::coulombForce(const CLJAtoms &atoms, CLJForces &forces,
+                               double scale_force) const
+{
+    this->pvt_force(atoms, forces, scale_force, 0);
+}
+
+/** Calculate the coulomb forces acting between the atoms in 'atoms0'
+    and 'atoms1', adding them (multiplied by 'scale_force') onto 'forces0'
+    and 'forces1' */
+void CLJFunction::coulombForce(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                               CLJForces &forces0, CLJForces &forces1,
+                               double scale_force) const
+{
+    this->pvt_force(atoms0, atoms1, forces0, forces1, scale_force, 0);
+}
+
+/** Calculate the coulomb forces acting between the atoms in 'atoms',
+    adding them (multiplied by 'scale_force') onto 'forces' */
+void CLJFunction::coulombForce(const CLJBoxes &atoms, QVector<CLJForces> &forces,
+                               double scale_force) const
+{
+    this->pvt_force(atoms, forces, scale_force, 0);
+}
+
+/** Calculate the coulomb forces acting between the atoms in 'atoms0'
+    and 'atoms1', adding them (multiplied by 'scale_force') onto 'forces0'
+    and 'forces1' */
+void CLJFunction::coulombForce(const CLJBoxes &atoms0, const CLJBoxes &atoms1,
+                               QVector<CLJForces> &forces0, QVector<CLJForces> &forces1,
+                               double scale_force) const
+{
+    this->pvt_force(atoms0, atoms1, forces0, forces1, scale_force, 0);
+}
+
+/** Calculate the LJ forces acting between the atoms in 'atoms',
+    adding them (multiplied by 'scale_force') onto 'forces' */
+void CLJFunction::ljForce(const CLJAtoms &atoms, CLJForces &forces,
+                          double scale_force) const
+{
+    this->pvt_force(atoms, forces, 0, scale_force);
+}
+
+/** Calculate the LJ forces acting between the atoms in 'atoms0'
+    and 'atoms1', adding them (multiplied by 'scale_force') onto 'forces0'
+    and 'forces1' */
+void CLJFunction::ljForce(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                          CLJForces &forces0, CLJForces &forces1,
+                          double scale_force) const
+{
+    this->pvt_force(atoms0, atoms1, forces0, forces1, 0, scale_force);
+}
+
+/** Calculate the LJ forces acting between the atoms in 'atoms',
+    adding them (multiplied by 'scale_force') onto 'forces' */
+void CLJFunction::ljForce(const CLJBoxes &atoms, QVector<CLJForces> &forces,
+                          double scale_force) const
+{
+    this->pvt_force(atoms, forces, 0, scale_force);
+}
+
+/** Calculate the LJ forces acting between the atoms in 'atoms0'
+    and 'atoms1', adding them (multiplied by 'scale_force') onto 'forces0'
+    and 'forces1' */
+void CLJFunction::ljForce(const CLJBoxes &atoms0, const CLJBoxes &atoms1,
+                          QVector<CLJForces> &forces0, QVector<CLJForces> &forces1,
+                          double scale_force) const
+{
+    this->pvt_force(atoms0, atoms1, forces0, forces1, 0, scale_force);
+}
+
 tuple< QVector<double>,QVector<double> >
 CLJFunction::multiCalculate(const QVector<CLJFunctionPtr> &funcs, const CLJAtoms &atoms)
 {
@@ -1673,7 +2827,7 @@ QDataStream SIREMM_EXPORT &operator>>(QDataStream &ds, CLJIntraFunction &func)
     if (v == 1)
     {
         SharedDataStream sds(ds);
-        func.bond_matrix.clear();
+        func.excluded_pairs = detail::CLJExclusions();
         func.cty = Connectivity();
         
         Connectivity connectivity;
@@ -1735,7 +2889,7 @@ CLJIntraFunction::CLJIntraFunction(const Space &space, Length coul_cutoff,
 
 /** Copy constructor */
 CLJIntraFunction::CLJIntraFunction(const CLJIntraFunction &other)
-                 : CLJCutoffFunction(other), cty(other.cty), bond_matrix(other.bond_matrix)
+                 : CLJCutoffFunction(other), cty(other.cty), excluded_pairs(other.excluded_pairs)
 {}
 
 /** Destructor */
@@ -1753,7 +2907,7 @@ CLJIntraFunction& CLJIntraFunction::operator=(const CLJIntraFunction &other)
     if (this != &other)
     {
         cty = other.cty;
-        bond_matrix = other.bond_matrix;
+        excluded_pairs = other.excluded_pairs;
         CLJCutoffFunction::operator=(other);
     }
     
@@ -1824,23 +2978,7 @@ void CLJIntraFunction::setConnectivity(const Connectivity &c)
     if (cty != c)
     {
         cty = c;
-        bond_matrix = cty.getBondMatrix(1,4);
-
-        if (bond_matrix.count() > 0)
-        {
-            //we now need to pad this with zeroes, as we use AtomIdx(0) to mean a dummy atom
-            bond_matrix.prepend( QVector<bool>(bond_matrix.count() + 1, false) );
-
-            bond_matrix[0].squeeze();
-            
-            for (int i=1; i<bond_matrix.count(); ++i)
-            {
-                bond_matrix[i].prepend(false);
-                bond_matrix[i].squeeze();
-            }
-            
-            bond_matrix.squeeze();
-        }
+        excluded_pairs = detail::CLJExclusions(cty);
     }
 }
 
@@ -1854,52 +2992,7 @@ void CLJIntraFunction::setConnectivity(const MoleculeView &molecule, const Prope
 bool CLJIntraFunction::isNotBonded(const QVector<MultiInt> &ids0,
                                    const QVector<MultiInt> &ids1) const
 {
-    const int nats0 = ids0.count();
-    const int nats1 = ids1.count();
-    
-    const MultiInt *aid0 = ids0.constData();
-    const MultiInt *aid1 = ids1.constData();
-    
-    for (int i=0; i<nats0; ++i)
-    {
-        const MultiInt &id0 = aid0[i];
-    
-        for (int ii=0; ii<MultiInt::count(); ++ii)
-        {
-            const bool *row = bond_matrix.constData()[ id0[ii] ].constData();
-            
-            for (int j=0; j<nats1; ++j)
-            {
-                const MultiInt &id1 = aid1[j];
-                
-                for (int jj=0; jj<MultiInt::count(); ++jj)
-                {
-                    if (row[id1[jj]])
-                        return false;
-                }
-            }
-        }
-    
-        /*for (int j=0; j<nats1; ++j)
-        {
-            const MultiInt &id1 = aid1[j];
-            
-            for (int ii=0; ii<MultiInt::count(); ++ii)
-            {
-                const QVector<bool> &row = bond_matrix.constData()[ id0[ii] ];
-            
-                for (int jj=0; jj<MultiInt::count(); ++jj)
-                {
-                    if (row.constData()[ id1[jj] ])
-                    {
-                        return false;
-                    }
-                }
-            }
-        }*/
-    }
-    
-    return true;
+    return not excluded_pairs.anyExcluded(ids0, ids1);
 }
 
 /////////
@@ -2437,3 +3530,5 @@ void CLJSoftIntraFunction::setCoulombPower(float power)
 {
     pvt_set(alpha(), shiftDelta(), power);
 }
+
+#endif // #ifndef SIRE_KERNEL_ISA
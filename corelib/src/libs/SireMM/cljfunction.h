@@ -30,6 +30,9 @@
 #define SIREMM_CLJFUNCTION_H
 
 #include "cljatoms.h"
+#include "cljforces.h"
+
+#include "detail/cljexclusions.h"
 
 #include "SireMol/atomidx.h"
 #include "SireMol/moleculeview.h"
@@ -74,6 +77,7 @@ QDataStream& operator>>(QDataStream&, SireMM::CLJSoftIntraFunction&);
 
 namespace SireVol
 {
+class AABox;
 class GridInfo;
 }
 
@@ -87,13 +91,18 @@ using SireUnits::Dimension::Length;
 using SireMol::Connectivity;
 
 using SireVol::Space;
+using SireVol::AABox;
 using SireVol::GridInfo;
 
 using SireBase::Property;
 using SireBase::Properties;
 using SireBase::PropertyPtr;
 
-namespace detail { class CLJGridCalculator; }
+namespace detail
+{
+class CLJGridCalculator;
+class CLJLJGridCalculator;
+}
 
 typedef SireBase::PropPtr<CLJFunction> CLJFunctionPtr;
 
@@ -180,6 +189,9 @@ public:
                                const CLJAtoms &atoms0, const CLJBoxes &atoms1);
 
     QVector<float> calculate(const CLJAtoms &atoms, const GridInfo &gridinfo) const;
+    boost::tuple< QVector<float>,QVector<float> > calculateLJ(const CLJAtoms &atoms,
+                                                             const GridInfo &gridinfo,
+                                                             float sigma=0) const;
 
     void total(const CLJAtoms &atoms,
                double &cnrg, double &ljnrg) const;
@@ -208,11 +220,42 @@ public:
     double lj(const CLJBoxes &atoms) const;
     double lj(const CLJBoxes &atoms0, const CLJBoxes &atoms1) const;
 
+    void force(const CLJAtoms &atoms, CLJForces &forces, double scale_force=1) const;
+    void force(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+               CLJForces &forces0, CLJForces &forces1, double scale_force=1) const;
+    
+    void force(const CLJBoxes &atoms, QVector<CLJForces> &forces,
+               double scale_force=1) const;
+    void force(const CLJBoxes &atoms0, const CLJBoxes &atoms1,
+               QVector<CLJForces> &forces0, QVector<CLJForces> &forces1,
+               double scale_force=1) const;
+
+    void coulombForce(const CLJAtoms &atoms, CLJForces &forces, double scale_force=1) const;
+    void coulombForce(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                      CLJForces &forces0, CLJForces &forces1, double scale_force=1) const;
+    
+    void coulombForce(const CLJBoxes &atoms, QVector<CLJForces> &forces,
+                      double scale_force=1) const;
+    void coulombForce(const CLJBoxes &atoms0, const CLJBoxes &atoms1,
+                      QVector<CLJForces> &forces0, QVector<CLJForces> &forces1,
+                      double scale_force=1) const;
+
+    void ljForce(const CLJAtoms &atoms, CLJForces &forces, double scale_force=1) const;
+    void ljForce(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                 CLJForces &forces0, CLJForces &forces1, double scale_force=1) const;
+    
+    void ljForce(const CLJBoxes &atoms, QVector<CLJForces> &forces,
+                 double scale_force=1) const;
+    void ljForce(const CLJBoxes &atoms0, const CLJBoxes &atoms1,
+                 QVector<CLJForces> &forces0, QVector<CLJForces> &forces1,
+                 double scale_force=1) const;
+
     virtual CLJFunction* clone() const=0;
 
     static const NullCLJFunction& null();
 
     virtual bool supportsGridCalculation() const;
+    virtual bool supportsForceCalculation() const;
 
     virtual bool hasCutoff() const;
     
@@ -247,6 +290,7 @@ protected:
     bool operator==(const CLJFunction &other) const;
 
     friend class ::SireMM::detail::CLJGridCalculator;
+    friend class ::SireMM::detail::CLJLJGridCalculator;
 
     virtual void calcVacGrid(const CLJAtoms &atoms, const GridInfo &gridinfo,
                              const int start, const int end, float *potential) const;
@@ -255,6 +299,15 @@ protected:
                              const Vector &box_dimensions,
                              const int start, const int end, float *potential) const;
 
+    virtual void calcVacLJGrid(const CLJAtoms &atoms, const GridInfo &gridinfo,
+                               float sigma, const int start, const int end,
+                               float *repulsion, float *dispersion) const;
+
+    virtual void calcBoxLJGrid(const CLJAtoms &atoms, const GridInfo &gridinfo,
+                               const Vector &box_dimensions, float sigma,
+                               const int start, const int end,
+                               float *repulsion, float *dispersion) const;
+
     virtual void calcVacEnergyAri(const CLJAtoms &atoms,
                                   double &cnrg, double &ljnrg) const=0;
 
@@ -321,10 +374,63 @@ protected:
                                       const Vector &box,
                                       float min_distance) const;
 
+    virtual void calcVacForceAri(const CLJAtoms &atoms, CLJForces &forces,
+                                 float scale_coul, float scale_lj) const;
+    virtual void calcVacForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                 CLJForces &forces0, CLJForces &forces1,
+                                 float scale_coul, float scale_lj) const;
+
+    virtual void calcVacForceGeo(const CLJAtoms &atoms, CLJForces &forces,
+                                 float scale_coul, float scale_lj) const;
+    virtual void calcVacForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                 CLJForces &forces0, CLJForces &forces1,
+                                 float scale_coul, float scale_lj) const;
+
+    virtual void calcBoxForceAri(const CLJAtoms &atoms, const Vector &box,
+                                 CLJForces &forces,
+                                 float scale_coul, float scale_lj) const;
+    virtual void calcBoxForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                 const Vector &box,
+                                 CLJForces &forces0, CLJForces &forces1,
+                                 float scale_coul, float scale_lj) const;
+
+    virtual void calcBoxForceGeo(const CLJAtoms &atoms, const Vector &box,
+                                 CLJForces &forces,
+                                 float scale_coul, float scale_lj) const;
+    virtual void calcBoxForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                 const Vector &box,
+                                 CLJForces &forces0, CLJForces &forces1,
+                                 float scale_coul, float scale_lj) const;
+
 private:
     void extractDetailsFromRules(COMBINING_RULES rules);
     void extractDetailsFromSpace();
 
+    CLJAtoms getLatticeImages(const AABox &box0, const CLJAtoms &atoms1,
+                              bool include_central) const;
+
+    void calcLatticeEnergy(const CLJAtoms &atoms, double &cnrg, double &ljnrg) const;
+    void calcLatticeEnergy(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                           double &cnrg, double &ljnrg) const;
+
+    void calcLatticeForce(const CLJAtoms &atoms, CLJForces &forces,
+                          float scale_coul, float scale_lj) const;
+    void calcLatticeForce(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                          CLJForces &forces0, CLJForces &forces1,
+                          float scale_coul, float scale_lj) const;
+
+    void pvt_force(const CLJAtoms &atoms, CLJForces &forces,
+                   float scale_coul, float scale_lj) const;
+    void pvt_force(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                   CLJForces &forces0, CLJForces &forces1,
+                   float scale_coul, float scale_lj) const;
+
+    void pvt_force(const CLJBoxes &atoms, QVector<CLJForces> &forces,
+                   float scale_coul, float scale_lj) const;
+    void pvt_force(const CLJBoxes &atoms0, const CLJBoxes &atoms1,
+                   QVector<CLJForces> &forces0, QVector<CLJForces> &forces1,
+                   float scale_coul, float scale_lj) const;
+
     /** The space used by the function */
     SireVol::SpacePtr spce;
 
@@ -336,6 +442,9 @@ private:
     
     /** Whether or not to use a periodic box */
     bool use_box;
+    
+    /** Whether or not to use a general (triclinic) periodic lattice */
+    bool use_lattice;
 };
 
 /** This is a null (empty) CLJ function that calculates nothing */
@@ -500,7 +609,7 @@ protected:
     bool isNotBonded(const MultiInt &id0, const MultiInt &id1) const;
     bool isNotBonded(const QVector<MultiInt> &ids0, const QVector<MultiInt> &ids1) const;
 
-    const QVector< QVector<bool> >& bondMatrix() const;
+    const detail::CLJExclusions& exclusions() const;
 
 private:
     static qint64 getIndex(const SireMol::AtomIdx &atom0, const SireMol::AtomIdx &atom1);
@@ -510,9 +619,9 @@ private:
     /** The connectivity used to obtain the bonded matrix */
     Connectivity cty;
 
-    /** The matrix of which atoms are bonded, angled or dihedraled together
-        (and so should be excluded from the non-bonded calculation) */
-    QVector< QVector<bool> > bond_matrix;
+    /** The sparse lists of the atoms that are bonded, angled or dihedraled
+        together (and so should be excluded from the non-bonded calculation) */
+    detail::CLJExclusions excluded_pairs;
 };
 
 /** This is the base class of all soft-core CLJ functions that have a cutoff
@@ -682,38 +791,19 @@ inline qint64 CLJIntraFunction::getIndex(const SireMol::AtomIdx &atom0,
 /** Return whether or not all atom pairs with passed IDs are not bonded */
 inline bool CLJIntraFunction::isNotBonded(const MultiInt &id0, const MultiInt &id1) const
 {
-    for (int i=0; i<MultiInt::count(); ++i)
-    {
-        const bool *row = bond_matrix.constData()[id0[i]].constData();
-        
-        for (int j=0; j<MultiInt::count(); ++j)
-        {
-            if (row[id1[j]])
-                return false;
-        }
-    }
-    
-    return true;
+    return not excluded_pairs.anyExcluded(id0, id1);
 }
 
 /** Return whether or not all atom pairs with passed IDs are not bonded */
 inline bool CLJIntraFunction::isNotBonded(qint32 id0, const MultiInt &id1) const
 {
-    const bool *row = bond_matrix.constData()[id0].constData();
-
-    for (int i=0; i<MultiInt::count(); ++i)
-    {
-        if (row[id1[i]])
-            return false;
-    }
-
-    return true;
+    return not excluded_pairs.anyExcluded(id0, id1);
 }
 
-/** Return the bond matrix */
-inline const QVector< QVector<bool> >& CLJIntraFunction::bondMatrix() const
+/** Return the lists of excluded (bonded, angled or dihedraled) atom pairs */
+inline const detail::CLJExclusions& CLJIntraFunction::exclusions() const
 {
-    return bond_matrix;
+    return excluded_pairs;
 }
 
 #endif
@@ -53,14 +53,25 @@ static const RegisterMetaType<CLJGrid> r_grid(NO_ROOT);
 
 QDataStream SIREMM_EXPORT &operator<<(QDataStream &ds, const CLJGrid &grid)
 {
-    writeHeader(ds, r_grid, 2);
+    writeHeader(ds, r_grid, 3);
     
     SharedDataStream sds(ds);
     
+    //the LJ grids of all of the types are written one after another
+    QVector<float> lj_rep_pots, lj_disp_pots;
+    
+    for (int i=0; i<grid.lj_types.count(); ++i)
+    {
+        lj_rep_pots += grid.lj_rep_pots.at(i).toVector();
+        lj_disp_pots += grid.lj_disp_pots.at(i).toVector();
+    }
+    
     sds << grid.grid_info << grid.grid_buffer
-        << grid.cljfunc << grid.grid_pots << grid.cljboxes
+        << grid.cljfunc << grid.grid_pots.toVector() << grid.cljboxes
         << grid.close_atoms << grid.use_grid
-        << grid.parallel_calc << grid.repro_sum;
+        << grid.parallel_calc << grid.repro_sum
+        << grid.use_lj_grid << grid.use_tricubic
+        << grid.lj_types << lj_rep_pots << lj_disp_pots;
     
     return ds;
 }
@@ -69,14 +80,18 @@ QDataStream SIREMM_EXPORT &operator>>(QDataStream &ds, CLJGrid &grid)
 {
     VersionID v = readHeader(ds, r_grid);
     
-    if (v <= 2)
+    if (v <= 3)
     {
         SharedDataStream sds(ds);
         
+        QVector<float> grid_pots;
+        
         sds >> grid.grid_info >> grid.grid_buffer
-            >> grid.cljfunc >> grid.grid_pots >> grid.cljboxes
+            >> grid.cljfunc >> grid_pots >> grid.cljboxes
             >> grid.close_atoms >> grid.use_grid;
         
+        grid.grid_pots = detail::GridValues(grid_pots);
+        
         grid.checkIfGridSupported();
         
         if (grid.grid_info.nPoints() != grid.grid_pots.count())
@@ -90,7 +105,7 @@ QDataStream SIREMM_EXPORT &operator>>(QDataStream &ds, CLJGrid &grid)
             grid.setGrid(old);
         }
         
-        if (v == 2)
+        if (v >= 2)
         {
             sds >> grid.parallel_calc >> grid.repro_sum;
         }
@@ -99,9 +114,47 @@ QDataStream SIREMM_EXPORT &operator>>(QDataStream &ds, CLJGrid &grid)
             grid.parallel_calc = true;
             grid.repro_sum = false;
         }
+        
+        if (v == 3)
+        {
+            QVector<float> lj_rep_pots, lj_disp_pots;
+        
+            sds >> grid.use_lj_grid >> grid.use_tricubic
+                >> grid.lj_types >> lj_rep_pots >> lj_disp_pots;
+            
+            grid.lj_rep_pots.clear();
+            grid.lj_disp_pots.clear();
+            
+            const int npoints = grid.grid_info.nPoints();
+            
+            if (grid.grid_pots.isEmpty() or
+                lj_rep_pots.count() != npoints * grid.lj_types.count() or
+                lj_disp_pots.count() != npoints * grid.lj_types.count())
+            {
+                grid.lj_types.clear();
+            }
+            else
+            {
+                for (int i=0; i<grid.lj_types.count(); ++i)
+                {
+                    grid.lj_rep_pots.append( detail::GridValues(
+                                                lj_rep_pots.mid(i*npoints, npoints) ) );
+                    grid.lj_disp_pots.append( detail::GridValues(
+                                                lj_disp_pots.mid(i*npoints, npoints) ) );
+                }
+            }
+        }
+        else
+        {
+            grid.use_lj_grid = false;
+            grid.use_tricubic = false;
+            grid.lj_types.clear();
+            grid.lj_rep_pots.clear();
+            grid.lj_disp_pots.clear();
+        }
     }
     else
-        throw version_error(v, "1,2", r_grid, CODELOC);
+        throw version_error(v, "1,2,3", r_grid, CODELOC);
     
     return ds;
 }
@@ -124,6 +177,7 @@ void CLJGrid::checkIfGridSupported()
 /** Constructor */
 CLJGrid::CLJGrid() : grid_buffer(global_grid_buffer),
                      cljfunc(global_func), use_grid(true),
+                     use_lj_grid(false), use_tricubic(false),
                      parallel_calc(true), repro_sum(false)
 {
     checkIfGridSupported();
@@ -132,6 +186,7 @@ CLJGrid::CLJGrid() : grid_buffer(global_grid_buffer),
 /** Construct, specifying the dimensions of the grid */
 CLJGrid::CLJGrid(const AABox &grid_dimensions)
         : grid_buffer(global_grid_buffer), cljfunc(global_func), use_grid(true),
+          use_lj_grid(false), use_tricubic(false),
           parallel_calc(true), repro_sum(false)
 {
     setGrid( GridInfo(grid_dimensions, global_grid_spacing) );
@@ -141,6 +196,7 @@ CLJGrid::CLJGrid(const AABox &grid_dimensions)
 /** Construct, specifying the dimensions and spacing for the grid */
 CLJGrid::CLJGrid(const AABox &grid_dimensions, Length spacing)
         : grid_buffer(global_grid_buffer), cljfunc(global_func), use_grid(true),
+          use_lj_grid(false), use_tricubic(false),
           parallel_calc(true), repro_sum(false)
 {
     setGrid( GridInfo(grid_dimensions,spacing) );
@@ -150,6 +206,7 @@ CLJGrid::CLJGrid(const AABox &grid_dimensions, Length spacing)
 /** Construct, specifying the grid */
 CLJGrid::CLJGrid(const GridInfo &grid)
         : grid_buffer(global_grid_buffer), cljfunc(global_func), use_grid(true),
+          use_lj_grid(false), use_tricubic(false),
           parallel_calc(true), repro_sum(false)
 {
     setGrid(grid);
@@ -159,6 +216,7 @@ CLJGrid::CLJGrid(const GridInfo &grid)
 /** Construct, specifying the function to use to calculate the energy */
 CLJGrid::CLJGrid(const CLJFunction &func)
         : grid_buffer(global_grid_buffer), cljfunc(func), use_grid(true),
+          use_lj_grid(false), use_tricubic(false),
           parallel_calc(true), repro_sum(false)
 {
     checkIfGridSupported();
@@ -168,6 +226,7 @@ CLJGrid::CLJGrid(const CLJFunction &func)
     the grid dimensions */
 CLJGrid::CLJGrid(const CLJFunction &func, const AABox &grid_dimensions)
         : grid_buffer(global_grid_buffer), cljfunc(func), use_grid(true),
+          use_lj_grid(false), use_tricubic(false),
           parallel_calc(true), repro_sum(false)
 {
     setGrid( GridInfo(grid_dimensions,global_grid_spacing) );
@@ -178,6 +237,7 @@ CLJGrid::CLJGrid(const CLJFunction &func, const AABox &grid_dimensions)
     the grid dimensions and grid spacing */
 CLJGrid::CLJGrid(const CLJFunction &func, const AABox &grid_dimensions, Length spacing)
         : grid_buffer(global_grid_buffer), cljfunc(func), use_grid(true),
+          use_lj_grid(false), use_tricubic(false),
           parallel_calc(true), repro_sum(false)
 {
     setGrid( GridInfo(grid_dimensions,spacing) );
@@ -187,6 +247,7 @@ CLJGrid::CLJGrid(const CLJFunction &func, const AABox &grid_dimensions, Length s
 /** Construct, specifying the grid and the energy function */
 CLJGrid::CLJGrid(const CLJFunction &func, const GridInfo &grid)
         : grid_buffer(global_grid_buffer), cljfunc(func), use_grid(true),
+          use_lj_grid(false), use_tricubic(false),
           parallel_calc(true), repro_sum(false)
 {
     setGrid(grid);
@@ -198,7 +259,11 @@ CLJGrid::CLJGrid(const CLJGrid &other)
         : grid_info(other.grid_info),
           grid_buffer(other.grid_buffer), grid_pots(other.grid_pots),
           cljfunc(other.cljfunc), cljboxes(other.cljboxes), close_atoms(other.close_atoms),
-          use_grid(other.use_grid), cljfunc_supports_grid(other.cljfunc_supports_grid),
+          lj_types(other.lj_types), lj_rep_pots(other.lj_rep_pots),
+          lj_disp_pots(other.lj_disp_pots),
+          use_grid(other.use_grid), use_lj_grid(other.use_lj_grid),
+          use_tricubic(other.use_tricubic),
+          cljfunc_supports_grid(other.cljfunc_supports_grid),
           parallel_calc(other.parallel_calc), repro_sum(other.repro_sum)
 {}
 
@@ -217,7 +282,12 @@ CLJGrid& CLJGrid::operator=(const CLJGrid &other)
         cljfunc = other.cljfunc;
         cljboxes = other.cljboxes;
         close_atoms = other.close_atoms;
+        lj_types = other.lj_types;
+        lj_rep_pots = other.lj_rep_pots;
+        lj_disp_pots = other.lj_disp_pots;
         use_grid = other.use_grid;
+        use_lj_grid = other.use_lj_grid;
+        use_tricubic = other.use_tricubic;
         cljfunc_supports_grid = other.cljfunc_supports_grid;
         parallel_calc = other.parallel_calc;
         repro_sum = other.repro_sum;
@@ -232,6 +302,8 @@ bool CLJGrid::operator==(const CLJGrid &other) const
     return grid_info == other.grid_info and
            grid_buffer == other.grid_buffer and cljfunc == other.cljfunc and
            cljboxes == other.cljboxes and
+           use_lj_grid == other.use_lj_grid and
+           use_tricubic == other.use_tricubic and
            parallel_calc == other.parallel_calc and
            repro_sum == other.repro_sum;
 }
@@ -282,8 +354,11 @@ QString CLJGrid::toString() const
 
 void CLJGrid::clearGrid()
 {
-    grid_pots.clear();
+    grid_pots = detail::GridValues();
     close_atoms = CLJBoxes();
+    lj_types.clear();
+    lj_rep_pots.clear();
+    lj_disp_pots.clear();
 }
 
 /** Add the passed atoms onto the set of fixed atoms */
@@ -585,8 +660,91 @@ bool CLJGrid::functionSupportsGrid() const
     return cljfunc_supports_grid;
 }
 
+/** Switch on or off placing the LJ interactions with the fixed atoms onto grids.
+    If this is on, then the coulomb and LJ potentials of all of the fixed atoms
+    are held on grids, so no explicit calculation with the fixed atoms close
+    to the grid is needed. The LJ grids are built for each LJ type of the 
+    mobile atoms as they are needed (only one type is needed if geometric
+    combining rules are used). Note that the LJ grid is only used if the
+    grid itself is used */
+void CLJGrid::setUseLJGrid(bool on)
+{
+    if (use_lj_grid != on)
+    {
+        use_lj_grid = on;
+        clearGrid();
+    }
+}
+
+/** Enable placing the LJ interactions with the fixed atoms onto grids */
+void CLJGrid::enableLJGrid()
+{
+    setUseLJGrid(true);
+}
+
+/** Disable placing the LJ interactions with the fixed atoms onto grids, 
+    so that these are calculated explicitly */
+void CLJGrid::disableLJGrid()
+{
+    setUseLJGrid(false);
+}
+
+/** Return whether or not the LJ interactions with the fixed atoms
+    are calculated using grids */
+bool CLJGrid::usesLJGrid() const
+{
+    return use_lj_grid and usesGrid();
+}
+
+/** Enable use of tricubic interpolation of the grids. This gives
+    smoother energies than tri-linear interpolation, at the cost
+    of reading 64 rather than 8 grid points for each atom */
+void CLJGrid::enableTricubicInterpolation()
+{
+    setUseTricubicInterpolation(true);
+}
+
+/** Disable use of tricubic interpolation, so that tri-linear interpolation
+    of the grids is used instead */
+void CLJGrid::disableTricubicInterpolation()
+{
+    setUseTricubicInterpolation(false);
+}
+
+/** Switch on or off use of tricubic interpolation of the grids. Note that 
+    the interpolated value is limited to lie between the values on the corners 
+    of the grid box containing the atom, so that the interpolation cannot 
+    overshoot next to the steep LJ repulsion of the fixed atoms */
+void CLJGrid::setUseTricubicInterpolation(bool on)
+{
+    use_tricubic = on;
+}
+
+/** Return whether or not tricubic interpolation of the grids is used */
+bool CLJGrid::usesTricubicInterpolation() const
+{
+    return use_tricubic;
+}
+
 static QMutex const_update_mutex;
 
+/** Return the key used to hold the grid called 'grid_name' in the grid cache.
+    This is a hash of everything that determines the values on the grid */
+QString CLJGrid::cacheKey(const QString &grid_name) const
+{
+    QByteArray data;
+    
+    {
+        QDataStream ds(&data, QIODevice::WriteOnly);
+        SharedDataStream sds(ds);
+        
+        sds << this->fixedAtoms() << cljfunc << grid_info << grid_buffer
+            << use_lj_grid << grid_name;
+    }
+    
+    return CLJGridCache::createKey(data);
+}
+
 /** Function called to calculate the potential grid. Note that this is called by 
     a const function, so we must be thread-safe when we update the potential */
 void CLJGrid::calculateGrid()
@@ -621,6 +779,13 @@ void CLJGrid::calculateGrid()
                     if (mindist < lj_cutoff)
                     {
                         near_atms.append(atom);
+                        
+                        //the near atoms are added to the coulomb grid if
+                        //their LJ is also placed onto grids (the grid kernels
+                        //cap the distance between an atom and a grid point
+                        //at clj_grid_min_distance, so this does not overflow)
+                        if (use_lj_grid and atom.charge().value() != 0)
+                            far_atms.append(atom);
                     }
                     else if (mindist < coul_cutoff and atom.charge().value() != 0)
                     {
@@ -634,16 +799,32 @@ void CLJGrid::calculateGrid()
         far_atoms = CLJAtoms(far_atms);
     }
     
-    //now, go through any far atoms and add their potentials to the grid
-    //if (parallel_calc)
-    //{
-    //    write a parallel algorithm for calculating the grid - divide the entire
-    //    grid into boxes that can be evaluated in parallel
-    //}
-    //else
-    //{
-            QVector<float> pot = cljfunc.read().calculate(far_atoms, grid_info);
-    //}
+    //now see if this grid has already been calculated and saved to the cache
+    QString key;
+    detail::GridValues pot;
+    
+    if (CLJGridCache::isEnabled())
+    {
+        key = cacheKey("coulomb");
+        pot = CLJGridCache::load(key, grid_info.nPoints());
+    }
+    
+    if (pot.isEmpty())
+    {
+        //go through any far atoms and add their potentials to the grid
+        //if (parallel_calc)
+        //{
+        //    write a parallel algorithm for calculating the grid - divide the entire
+        //    grid into boxes that can be evaluated in parallel
+        //}
+        //else
+        //{
+                pot = cljfunc.read().calculate(far_atoms, grid_info);
+        //}
+        
+        if (not key.isEmpty())
+            CLJGridCache::save(key, pot.toVector());
+    }
     
     //update the object - note that because this is called from a const function
     //we have to be doubly sure that this has not been called twice from two
@@ -654,9 +835,130 @@ void CLJGrid::calculateGrid()
     {
         grid_pots = pot;
         close_atoms = CLJBoxes(near_atoms);
+        lj_types.clear();
+        lj_rep_pots.clear();
+        lj_disp_pots.clear();
     }
 }
 
+/** Function called to calculate the LJ grids of the close atoms for the 
+    LJ types with (reduced) sigma parameters in 'sigmas'. The grids
+    are appended onto the existing LJ grids. Only one type is needed
+    if geometric combining rules are used. Note that this is called by a 
+    const function, so we must be thread-safe when we update the grids */
+void CLJGrid::calculateLJGrids(const QVector<float> &sigmas)
+{
+    if (sigmas.isEmpty())
+        return;
+
+    const CLJAtoms near_atoms = close_atoms.atoms().squeeze();
+    const bool use_cache = CLJGridCache::isEnabled();
+    const int npoints = grid_info.nPoints();
+    
+    QVector<detail::GridValues> rep_pots, disp_pots;
+    
+    for (int i=0; i<sigmas.count(); ++i)
+    {
+        QString rep_key, disp_key;
+        detail::GridValues rep, disp;
+        
+        if (use_cache)
+        {
+            const QString sigma = QString::number(sigmas[i], 'g', 9);
+            rep_key = cacheKey( QString("lj-repulsion:%1").arg(sigma) );
+            disp_key = cacheKey( QString("lj-dispersion:%1").arg(sigma) );
+            
+            rep = CLJGridCache::load(rep_key, npoints);
+            disp = CLJGridCache::load(disp_key, npoints);
+        }
+        
+        if (rep.isEmpty() or disp.isEmpty())
+        {
+            tuple< QVector<float>,QVector<float> > pots = cljfunc.read().calculateLJ(
+                                                            near_atoms, grid_info, sigmas[i]);
+            
+            rep = pots.get<0>();
+            disp = pots.get<1>();
+            
+            if (use_cache)
+            {
+                CLJGridCache::save(rep_key, pots.get<0>());
+                CLJGridCache::save(disp_key, pots.get<1>());
+            }
+        }
+        
+        rep_pots.append(rep);
+        disp_pots.append(disp);
+    }
+    
+    //update the object - note that because this is called from a const function
+    //we have to be doubly sure that the grids have not been added by another thread
+    QMutexLocker lkr(&const_update_mutex);
+    
+    for (int i=0; i<sigmas.count(); ++i)
+    {
+        if (not lj_types.contains(sigmas[i]))
+        {
+            lj_types.append(sigmas[i]);
+            lj_rep_pots.append(rep_pots[i]);
+            lj_disp_pots.append(disp_pots[i]);
+        }
+    }
+}
+
+/** Internal function used to interpolate the values on the grid 'grid'
+    to the points with the passed grid corners and weights. This 
+    performs tri-linear interpolation if there are 8 corners, and tricubic 
+    interpolation if there are 64. The result of tricubic interpolation is 
+    limited to lie between the values at the eight corners of the box 
+    containing each point, so that the interpolation does not overshoot
+    where the potential is steep (e.g. close to the LJ repulsion of an atom) */
+static MultiFloat interpolate(const float *grid,
+                              const QVector<MultiInt> &corners,
+                              const QVector<MultiFloat> &weights)
+{
+    const MultiInt *c = corners.constData();
+    const MultiFloat *w = weights.constData();
+
+    MultiFloat val(0);
+
+    if (corners.count() == 8)
+    {
+        for (int j=0; j<8; ++j)
+        {
+            val += MultiFloat(grid, c[j]) * w[j];
+        }
+    }
+    else
+    {
+        for (int j=0; j<64; ++j)
+        {
+            val += MultiFloat(grid, c[j]) * w[j];
+        }
+        
+        //the corners of the box are at (a,b,c) where a, b and c are 1 or 2
+        MultiFloat minval( MultiFloat(grid, c[21]) );
+        MultiFloat maxval( minval );
+        
+        for (int a=1; a<3; ++a)
+        {
+            for (int b=1; b<3; ++b)
+            {
+                for (int k=1; k<3; ++k)
+                {
+                    const MultiFloat corner(grid, c[16*a + 4*b + k]);
+                    minval = minval.min(corner);
+                    maxval = maxval.max(corner);
+                }
+            }
+        }
+        
+        val = val.max(minval).min(maxval);
+    }
+    
+    return val;
+}
+
 /** Calculate the total energy of interaction between the passed atoms and
     all of the atoms added to the grid */
 void CLJGrid::total(const CLJBoxes &atoms, double &cnrg, double &ljnrg) const
@@ -677,10 +979,60 @@ void CLJGrid::total(const CLJBoxes &atoms, double &cnrg, double &ljnrg) const
             const_cast<CLJGrid*>(this)->calculateGrid();
         }
 
+        const qint32 dummy_id = CLJAtoms::idOfDummy()[0];
+        const qint32 grid_id = idOfFixedAtom();
+
+        const MultiInt m_dummy_id(dummy_id);
+        const MultiInt m_grid_id(grid_id);
+
+        const bool use_arithmetic = cljfunc.read().usingArithmeticCombiningRules();
+
         //calculate the energy between the atoms and the close atoms
-        tuple<double,double> nrgs;
+        tuple<double,double> nrgs(0,0);
         
-        if (parallel_calc)
+        if (use_lj_grid)
+        {
+            //the close atoms are on the LJ grids - make sure that we have
+            //a grid for each of the LJ types of the atoms
+            QVector<float> missing_types;
+            
+            if (use_arithmetic)
+            {
+                for (CLJBoxes::const_iterator it = atoms.constBegin();
+                     it != atoms.constEnd();
+                     ++it)
+                {
+                    const CLJAtoms &atms = it->read().atoms();
+                    const MultiFloat *sig = atms.sigma().constData();
+                    const MultiFloat *eps = atms.epsilon().constData();
+                    const MultiInt *id = atms.ID().constData();
+                    
+                    for (int i=0; i<atms.x().count(); ++i)
+                    {
+                        for (int j=0; j<MultiFloat::count(); ++j)
+                        {
+                            if (eps[i][j] != 0 and id[i][j] != dummy_id and
+                                id[i][j] != grid_id and
+                                not (lj_types.contains(sig[i][j]) or
+                                     missing_types.contains(sig[i][j])))
+                            {
+                                missing_types.append(sig[i][j]);
+                            }
+                        }
+                    }
+                }
+            }
+            else if (lj_types.isEmpty())
+            {
+                missing_types.append(0);
+            }
+            
+            if (not missing_types.isEmpty())
+            {
+                const_cast<CLJGrid*>(this)->calculateLJGrids(missing_types);
+            }
+        }
+        else if (parallel_calc)
         {
             CLJCalculator cljcalc(repro_sum);
             nrgs = cljcalc.calculate(cljfunc.read(), close_atoms, atoms);
@@ -691,7 +1043,11 @@ void CLJGrid::total(const CLJBoxes &atoms, double &cnrg, double &ljnrg) const
         }
 
         //now calculate the grid energy of each atom
+        const bool lj_on_grid = use_lj_grid and not lj_types.isEmpty();
+        
         const float *gridpot_array = grid_pots.constData();
+        
+        const int ncorners = use_tricubic ? 64 : 8;
 
         bool all_within_grid = true;
 
@@ -699,13 +1055,8 @@ void CLJGrid::total(const CLJBoxes &atoms, double &cnrg, double &ljnrg) const
         QVector<MultiFloat> grid_weights;
 
         MultiDouble grid_nrg(0);
+        MultiDouble grid_ljnrg(0);
     
-        const qint32 dummy_id = CLJAtoms::idOfDummy()[0];
-        const qint32 grid_id = idOfFixedAtom();
-
-        const MultiInt m_dummy_id(dummy_id);
-        const MultiInt m_grid_id(grid_id);
-
         for (CLJBoxes::const_iterator it = atoms.constBegin();
              it != atoms.constEnd();
              ++it)
@@ -716,14 +1067,22 @@ void CLJGrid::total(const CLJBoxes &atoms, double &cnrg, double &ljnrg) const
             const MultiFloat *y = atms.y().constData();
             const MultiFloat *z = atms.z().constData();
             const MultiFloat *q = atms.q().constData();
+            const MultiFloat *sig = atms.sigma().constData();
+            const MultiFloat *eps = atms.epsilon().constData();
             const MultiInt *id = atms.ID().constData();
             
             const int nats = atms.x().count();
 
             for (int i=0; i<nats; ++i)
             {
-
-                int n_in_grid = grid_info.pointToGridCorners(x[i], y[i], z[i],
+                int n_in_grid;
+                
+                if (use_tricubic)
+                    n_in_grid = grid_info.pointToTricubicGridCorners(x[i], y[i], z[i],
+                                                                     grid_corners,
+                                                                     grid_weights);
+                else
+                    n_in_grid = grid_info.pointToGridCorners(x[i], y[i], z[i],
                                                              grid_corners, grid_weights);
 
                 if (n_in_grid != MultiFloat::count())
@@ -739,7 +1098,7 @@ void CLJGrid::total(const CLJBoxes &atoms, double &cnrg, double &ljnrg) const
                             ndummies += 1;
                             
                             //put the dummy into the first grid box
-                            for (int k=0; k<8; ++k)
+                            for (int k=0; k<ncorners; ++k)
                             {
                                 grid_corners[k].set(j, 0);
                                 grid_weights[k].set(j, 0.0);
@@ -759,14 +1118,7 @@ void CLJGrid::total(const CLJBoxes &atoms, double &cnrg, double &ljnrg) const
                     }
                 }
 
-                MultiFloat phi(0);
-                
-                for (int j=0; j<8; ++j)
-                {
-                    phi += MultiFloat(gridpot_array, grid_corners.constData()[j]) *
-                                      grid_weights.constData()[j];
-                }
-
+                MultiFloat phi = interpolate(gridpot_array, grid_corners, grid_weights);
 
                 //add the energy of these atoms onto the total, taking care to ignore
                 //dummy atoms and to ignore atoms with IDs equal to the grid ID
@@ -775,6 +1127,67 @@ void CLJGrid::total(const CLJBoxes &atoms, double &cnrg, double &ljnrg) const
                 // is mobile)
                 grid_nrg += (q[i] * phi).logicalAndNot( id[i].compareEqual(m_dummy_id) )
                                         .logicalAndNot( id[i].compareEqual(m_grid_id) );
+                
+                if (lj_on_grid)
+                {
+                    MultiFloat lj;
+                
+                    if (use_arithmetic)
+                    {
+                        //find the LJ grid for each of the atoms
+                        //(atoms without a grid have no LJ, so can use any grid)
+                        int types[MULTIFLOAT_SIZE];
+                        
+                        for (int j=0; j<MultiFloat::count(); ++j)
+                        {
+                            types[j] = qMax(0, lj_types.indexOf(sig[i][j]));
+                        }
+                        
+                        //interpolate each of the grids that is used by these atoms
+                        //once, and pick out the result for the atoms that use it
+                        lj = MultiFloat(0);
+                        
+                        for (int j=0; j<MultiFloat::count(); ++j)
+                        {
+                            const int t = types[j];
+                        
+                            if (t < 0)
+                                continue;
+                            
+                            MultiFloat mask(0);
+                            
+                            for (int k=j; k<MultiFloat::count(); ++k)
+                            {
+                                if (types[k] == t)
+                                {
+                                    mask.set(k, 1.0);
+                                    types[k] = -1;
+                                }
+                            }
+                            
+                            MultiFloat val = interpolate(lj_rep_pots.at(t).constData(),
+                                                         grid_corners, grid_weights);
+                            val -= interpolate(lj_disp_pots.at(t).constData(),
+                                               grid_corners, grid_weights);
+                            
+                            lj += mask * val;
+                        }
+                    }
+                    else
+                    {
+                        const MultiFloat sig2 = sig[i] * sig[i];
+                        const MultiFloat sig6 = sig2 * sig2 * sig2;
+                        
+                        lj = sig6 * sig6 * interpolate(lj_rep_pots.at(0).constData(),
+                                                       grid_corners, grid_weights);
+                        lj -= sig6 * interpolate(lj_disp_pots.at(0).constData(),
+                                                 grid_corners, grid_weights);
+                    }
+                    
+                    grid_ljnrg += (eps[i] * lj)
+                                        .logicalAndNot( id[i].compareEqual(m_dummy_id) )
+                                        .logicalAndNot( id[i].compareEqual(m_grid_id) );
+                }
             }
             
             if (not all_within_grid)
@@ -784,7 +1197,7 @@ void CLJGrid::total(const CLJBoxes &atoms, double &cnrg, double &ljnrg) const
         if (all_within_grid)
         {
             cnrg = nrgs.get<0>() + grid_nrg.sum();
-            ljnrg = nrgs.get<1>();
+            ljnrg = nrgs.get<1>() + grid_ljnrg.sum();
             
             return;
         }
@@ -32,6 +32,7 @@
 #include "cljfunction.h"
 #include "cljatoms.h"
 #include "cljboxes.h"
+#include "cljgridcache.h"
 
 #include "SireVol/gridinfo.h"
 #include "SireVol/aabox.h"
@@ -56,7 +57,12 @@ using SireVol::GridInfo;
 
 /** This class holds a 3D grid of the coulomb potential
     at points in space created by a set of atoms, and calculates
-    the coulomb and LJ energies of atoms with that grid
+    the coulomb and LJ energies of atoms with that grid. Optionally,
+    the LJ repulsion and dispersion of the fixed atoms can also be
+    placed onto grids (one pair per LJ type of the mobile atoms), so
+    that the energy of each mobile atom with all of the fixed atoms
+    is found by interpolation, with either tri-linear or tricubic
+    interpolation
     
     @author Christopher Woods
 */
@@ -133,6 +139,18 @@ public:
     bool usesGrid() const;
     bool functionSupportsGrid() const;
     
+    void setUseLJGrid(bool on);
+    
+    void enableLJGrid();
+    void disableLJGrid();
+    
+    bool usesLJGrid() const;
+    
+    void enableTricubicInterpolation();
+    void disableTricubicInterpolation();
+    void setUseTricubicInterpolation(bool on);
+    bool usesTricubicInterpolation() const;
+    
     void enableParallelCalculation();
     void disableParallelCalculation();
     void setUseParallelCalculation(bool on);
@@ -160,6 +178,8 @@ public:
 private:
     void clearGrid();
     void calculateGrid();
+    void calculateLJGrids(const QVector<float> &sigmas);
+    QString cacheKey(const QString &grid_name) const;
     void checkIfGridSupported();
 
     /** Description of the grid */
@@ -169,7 +189,7 @@ private:
     float grid_buffer;
     
     /** The actual grid of potentials */
-    QVector<float> grid_pots;
+    detail::GridValues grid_pots;
     
     /** The CLJFunction used to calculate the potential */
     CLJFunctionPtr cljfunc;
@@ -181,9 +201,26 @@ private:
         of the grid points */
     CLJBoxes close_atoms;
     
+    /** The reduced sigma parameters of the LJ types that have
+        LJ grids. There is only one type if geometric combining rules
+        are used, as the grids are then the same for all LJ types */
+    QVector<float> lj_types;
+    
+    /** The LJ repulsion grids for each of the LJ types */
+    QVector<detail::GridValues> lj_rep_pots;
+    
+    /** The LJ dispersion grids for each of the LJ types */
+    QVector<detail::GridValues> lj_disp_pots;
+    
     /** Whether or not to use a grid */
     bool use_grid;
     
+    /** Whether or not to place the LJ of the close atoms onto grids */
+    bool use_lj_grid;
+    
+    /** Whether or not to use tricubic interpolation of the grids */
+    bool use_tricubic;
+    
     /** Whether or not the CLJFunction supports use of a grid */
     bool cljfunc_supports_grid;
     
@@ -0,0 +1,570 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#include "cljgridcache.h"
+
+#include "SireError/errors.h"
+
+#include <QFile>
+#include <QDir>
+#include <QHash>
+#include <QMutex>
+#include <QCryptographicHash>
+#include <QTemporaryFile>
+#include <QDebug>
+
+#include <boost/weak_ptr.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <cstdlib>
+#include <cstring>
+
+using namespace SireMM;
+using namespace SireMM::detail;
+
+/////////
+///////// Layout of a cache file
+/////////
+
+// Each file holds a 32 byte header, followed by the grid values
+// as native (endian) 32 bit floats (or 64 bit doubles), so that the 
+// values can be used directly from the memory-mapped file
+//
+// header:  8 bytes  - magic "SIREGRID"
+//          4 bytes  - file version
+//          4 bytes  - endian marker (0x01020304)
+//          8 bytes  - number of values
+//          4 bytes  - size of each value (4 or 8 - 0 means 4)
+//          4 bytes  - unused (pads the values to a 32 byte boundary)
+
+static const char GRID_FILE_MAGIC[] = "SIREGRID";
+static const quint32 GRID_FILE_VERSION = 1;
+static const quint32 GRID_FILE_ENDIAN = 0x01020304;
+static const qint64 GRID_HEADER_SIZE = 32;
+
+/** Write the header for a grid file of 'n' values that are each
+    'value_size' bytes into 'header' */
+static void writeGridHeader(char *header, qint64 n, quint32 value_size)
+{
+    std::memset(header, 0, GRID_HEADER_SIZE);
+
+    std::memcpy(header, GRID_FILE_MAGIC, 8);
+    std::memcpy(header + 8, &GRID_FILE_VERSION, 4);
+    std::memcpy(header + 12, &GRID_FILE_ENDIAN, 4);
+    std::memcpy(header + 16, &n, 8);
+    std::memcpy(header + 24, &value_size, 4);
+}
+
+/** Return whether or not 'header' is the header of a grid file written 
+    on this machine that holds 'nvalues' values that are each 'value_size' bytes */
+static bool isValidGridHeader(const uchar *header, qint64 nvalues, quint32 value_size)
+{
+    quint32 version, endian, size;
+    qint64 n;
+
+    std::memcpy(&version, header + 8, 4);
+    std::memcpy(&endian, header + 12, 4);
+    std::memcpy(&n, header + 16, 8);
+    std::memcpy(&size, header + 24, 4);
+
+    if (size == 0)
+        size = sizeof(float);
+
+    return std::memcmp(header, GRID_FILE_MAGIC, 8) == 0 and 
+           version == GRID_FILE_VERSION and endian == GRID_FILE_ENDIAN and 
+           n == nvalues and size == value_size;
+}
+
+namespace SireMM
+{
+namespace detail
+{
+
+/** This holds a read-only memory-mapped grid file from the cache */
+class MappedGridFile : public boost::noncopyable
+{
+public:
+    MappedGridFile(const QString &filename, int nvalues);
+    ~MappedGridFile();
+
+    const float* constData() const
+    {
+        return reinterpret_cast<const float*>(data + GRID_HEADER_SIZE);
+    }
+
+    int count() const
+    {
+        return nvals;
+    }
+
+private:
+    /** The mapped file */
+    QFile f;
+
+    /** Pointer to the mapped data */
+    uchar *data;
+
+    /** The number of values in the file */
+    int nvals;
+};
+
+} // end of namespace detail
+} // end of namespace SireMM
+
+/** Memory-map the cached grid in 'filename', checking that it holds
+    'nvalues' values
+
+    \throw SireError::file_error
+    \throw SireError::io_error
+*/
+MappedGridFile::MappedGridFile(const QString &filename, int nvalues)
+               : f(filename), data(0), nvals(nvalues)
+{
+    if (not f.open(QIODevice::ReadOnly))
+        throw SireError::file_error(f, CODELOC);
+
+    const qint64 size = f.size();
+
+    if (size != GRID_HEADER_SIZE + qint64(nvalues) * qint64(sizeof(float)))
+        throw SireError::io_error( QObject::tr(
+                "The cached grid file \"%1\" has the wrong size (%2 bytes) "
+                "to hold a grid of %3 points.")
+                    .arg(filename).arg(size).arg(nvalues), CODELOC );
+
+    data = f.map(0, size);
+
+    if (data == 0)
+        throw SireError::file_error(f, CODELOC);
+
+    if (not isValidGridHeader(data, nvalues, sizeof(float)))
+    {
+        f.unmap(data);
+        data = 0;
+
+        throw SireError::io_error( QObject::tr(
+                "The file \"%1\" is not a valid cached grid for this machine.")
+                    .arg(filename), CODELOC );
+    }
+}
+
+/** Destructor */
+MappedGridFile::~MappedGridFile()
+{
+    if (data != 0)
+        f.unmap(data);
+}
+
+/////////
+///////// Implementation of GridValues
+/////////
+
+/** Constructor */
+GridValues::GridValues()
+{}
+
+/** Construct from the passed in-memory values */
+GridValues::GridValues(const QVector<float> &values) : vals(values)
+{}
+
+/** Construct from the passed memory-mapped file */
+GridValues::GridValues(const boost::shared_ptr<const MappedGridFile> &file)
+           : mapped(file)
+{}
+
+/** Copy constructor */
+GridValues::GridValues(const GridValues &other)
+           : vals(other.vals), mapped(other.mapped)
+{}
+
+/** Destructor */
+GridValues::~GridValues()
+{}
+
+/** Copy assignment operator */
+GridValues& GridValues::operator=(const GridValues &other)
+{
+    vals = other.vals;
+    mapped = other.mapped;
+    return *this;
+}
+
+/** Return a pointer to the values */
+const float* GridValues::constData() const
+{
+    if (mapped)
+        return mapped->constData();
+    else
+        return vals.constData();
+}
+
+/** Return the number of values */
+int GridValues::count() const
+{
+    if (mapped)
+        return mapped->count();
+    else
+        return vals.count();
+}
+
+/** Return whether or not there are no values */
+bool GridValues::isEmpty() const
+{
+    return this->count() == 0;
+}
+
+/** Return whether or not the values are memory-mapped from the grid cache */
+bool GridValues::isMapped() const
+{
+    return mapped.get() != 0;
+}
+
+/** Return a copy of the values as a vector */
+QVector<float> GridValues::toVector() const
+{
+    if (mapped)
+    {
+        QVector<float> v(mapped->count());
+        std::memcpy(v.data(), mapped->constData(), mapped->count() * sizeof(float));
+        return v;
+    }
+    else
+        return vals;
+}
+
+/////////
+///////// Implementation of CLJGridCache
+/////////
+
+Q_GLOBAL_STATIC( QMutex, cacheMutex );
+
+/** The cache directory - this is null until it has been set, or
+    has been read from the environment */
+static QString *cache_dir = 0;
+
+/** The grid files that are already mapped into this process */
+typedef QHash< QString,boost::weak_ptr<const MappedGridFile> > MappedGridHash;
+
+Q_GLOBAL_STATIC( MappedGridHash, mappedGrids );
+
+/** Remove the grid files that are no longer used by any grid from
+    the hash of mapped grid files (cacheMutex must be held) */
+static void pruneMappedGrids()
+{
+    MappedGridHash *grids = mappedGrids();
+
+    MappedGridHash::iterator it = grids->begin();
+
+    while (it != grids->end())
+    {
+        if (it.value().expired())
+            it = grids->erase(it);
+        else
+            ++it;
+    }
+}
+
+/** Return the cache directory (cacheMutex must be held) */
+static QString getCacheDirectory()
+{
+    if (cache_dir == 0)
+    {
+        const char *dir = std::getenv("SIRE_GRID_CACHE");
+
+        if (dir != 0)
+            cache_dir = new QString( QString::fromLocal8Bit(dir) );
+        else
+            cache_dir = new QString();
+    }
+
+    return *cache_dir;
+}
+
+/** Set the directory used to hold the cached grids. The directory
+    is created if it doesn't exist. Passing an empty string disables
+    the cache */
+void CLJGridCache::setCacheDirectory(const QString &directory)
+{
+    QMutexLocker lkr( cacheMutex() );
+
+    getCacheDirectory();
+
+    if (directory.isEmpty())
+    {
+        *cache_dir = QString();
+    }
+    else
+    {
+        QDir dir(directory);
+
+        if (not dir.exists())
+        {
+            if (not dir.mkpath("."))
+                throw SireError::file_error( QObject::tr(
+                        "Could not create the grid cache directory \"%1\".")
+                            .arg(directory), CODELOC );
+        }
+
+        *cache_dir = dir.absolutePath();
+    }
+}
+
+/** Return the directory used to hold the cached grids. This is empty
+    if the cache is disabled */
+QString CLJGridCache::cacheDirectory()
+{
+    QMutexLocker lkr( cacheMutex() );
+    return getCacheDirectory();
+}
+
+/** Disable the grid cache */
+void CLJGridCache::disable()
+{
+    setCacheDirectory( QString() );
+}
+
+/** Return whether or not the grid cache is enabled */
+bool CLJGridCache::isEnabled()
+{
+    return not cacheDirectory().isEmpty();
+}
+
+/** Return the key used to identify the grid that is fully
+    described by 'data' */
+QString CLJGridCache::createKey(const QByteArray &data)
+{
+    return QString::fromLatin1( QCryptographicHash::hash(data,
+                                        QCryptographicHash::Sha1).toHex() );
+}
+
+/** Return the full name of the file holding the grid with key 'key' */
+static QString getFileName(const QString &dir, const QString &key)
+{
+    return QDir(dir).absoluteFilePath( QString("%1.grid").arg(key) );
+}
+
+/** Return whether or not the cache contains the grid with key 'key' */
+bool CLJGridCache::contains(const QString &key)
+{
+    const QString dir = cacheDirectory();
+
+    if (dir.isEmpty())
+        return false;
+    else
+        return QFile::exists( getFileName(dir,key) );
+}
+
+/** Load the grid with key 'key', which should contain 'nvalues' values.
+    The grid is memory-mapped read-only, and is shared with any other
+    grid that has loaded the same key. This returns an empty set of
+    values if the cache is disabled, or if it doesn't contain a valid
+    grid with this key */
+GridValues CLJGridCache::load(const QString &key, int nvalues)
+{
+    const QString dir = cacheDirectory();
+
+    if (dir.isEmpty() or nvalues <= 0)
+        return GridValues();
+
+    QMutexLocker lkr( cacheMutex() );
+
+    MappedGridHash::iterator it = mappedGrids()->find(key);
+
+    if (it != mappedGrids()->end())
+    {
+        boost::shared_ptr<const MappedGridFile> file = it.value().lock();
+    
+        if (file)
+        {
+            if (file->count() == nvalues)
+                return GridValues(file);
+            else
+                return GridValues();
+        }
+        
+        //the grid is no longer mapped
+        mappedGrids()->erase(it);
+    }
+
+    const QString filename = getFileName(dir, key);
+
+    if (not QFile::exists(filename))
+        return GridValues();
+
+    boost::shared_ptr<const MappedGridFile> file;
+
+    try
+    {
+        file.reset( new MappedGridFile(filename, nvalues) );
+    }
+    catch(const SireError::exception &e)
+    {
+        //an invalid cached grid is not fatal, as the grid can be recalculated
+        qWarning() << QObject::tr("WARNING: Ignoring the invalid cached grid %1: %2")
+                        .arg(filename, e.why());
+        return GridValues();
+    }
+
+    pruneMappedGrids();
+    mappedGrids()->insert(key, file);
+
+    return GridValues(file);
+}
+
+/** Load the double precision grid with key 'key', which should contain
+    'nvalues' values. The values are copied from the cache, rather than 
+    memory-mapped. This returns an empty vector if the cache is disabled, 
+    or if it doesn't contain a valid double precision grid with this key */
+QVector<double> CLJGridCache::loadDoubles(const QString &key, int nvalues)
+{
+    const QString dir = cacheDirectory();
+
+    if (dir.isEmpty() or nvalues <= 0)
+        return QVector<double>();
+
+    const QString filename = getFileName(dir, key);
+
+    QFile f(filename);
+
+    if (not f.exists())
+        return QVector<double>();
+
+    uchar header[GRID_HEADER_SIZE];
+    QVector<double> values(nvalues);
+    
+    const qint64 nbytes = qint64(nvalues) * qint64(sizeof(double));
+
+    if (not f.open(QIODevice::ReadOnly) or 
+        f.size() != GRID_HEADER_SIZE + nbytes or
+        f.read(reinterpret_cast<char*>(header), GRID_HEADER_SIZE) != GRID_HEADER_SIZE or
+        not isValidGridHeader(header, nvalues, sizeof(double)) or
+        f.read(reinterpret_cast<char*>(values.data()), nbytes) != nbytes)
+    {
+        //an invalid cached grid is not fatal, as the grid can be recalculated
+        qWarning() << QObject::tr("WARNING: Ignoring the invalid cached grid %1.")
+                        .arg(filename);
+        return QVector<double>();
+    }
+
+    return values;
+}
+
+/** Write the 'n' values in 'data', which are each 'value_size' bytes, into 
+    the cache file for the grid with key 'key'. This does nothing if the cache 
+    is disabled, or if the grid is already in the cache. The file is written 
+    under a temporary name and then renamed, so that other processes never see
+    a partially written grid. Failing to write the grid is not an error, as
+    the grid can always be recalculated, so this only prints a warning */
+static void saveGrid(const QString &key, const char *data, qint64 n, quint32 value_size)
+{
+    const QString dir = CLJGridCache::cacheDirectory();
+
+    if (dir.isEmpty() or n == 0)
+        return;
+
+    const QString filename = getFileName(dir, key);
+
+    if (QFile::exists(filename))
+        return;
+
+    QTemporaryFile f( QString("%1.XXXXXX").arg(filename) );
+    f.setAutoRemove(true);
+
+    if (not f.open())
+    {
+        qWarning() << QObject::tr("WARNING: Could not write the grid to the "
+                                  "grid cache in %1: %2").arg(dir, f.errorString());
+        return;
+    }
+
+    char header[GRID_HEADER_SIZE];
+    writeGridHeader(header, n, value_size);
+
+    const qint64 nbytes = n * value_size;
+
+    if (f.write(header, GRID_HEADER_SIZE) != GRID_HEADER_SIZE or
+        f.write(data, nbytes) != nbytes or
+        not f.flush())
+    {
+        qWarning() << QObject::tr("WARNING: Could not write the grid to the "
+                                  "grid cache file %1: %2")
+                                        .arg(f.fileName(), f.errorString());
+        return;
+    }
+
+    f.close();
+
+    //another process may have written the same grid in the meantime,
+    //in which case the rename fails and the temporary file is removed
+    if (f.rename(filename))
+    {
+        f.setAutoRemove(false);
+        f.setPermissions( QFile::ReadOwner | QFile::WriteOwner |
+                          QFile::ReadGroup | QFile::ReadOther );
+    }
+}
+
+/** Save the grid 'values' into the cache using the key 'key'. This
+    does nothing if the cache is disabled, or if the grid is already
+    in the cache. Failing to write the grid is not an error, as the grid
+    can always be recalculated, so this only prints a warning */
+void CLJGridCache::save(const QString &key, const QVector<float> &values)
+{
+    saveGrid(key, reinterpret_cast<const char*>(values.constData()),
+             values.count(), sizeof(float));
+}
+
+/** Save the double precision grid 'values' into the cache using the key 'key'.
+    This does nothing if the cache is disabled, or if the grid is already
+    in the cache. Failing to write the grid is not an error, as the grid
+    can always be recalculated, so this only prints a warning */
+void CLJGridCache::save(const QString &key, const QVector<double> &values)
+{
+    saveGrid(key, reinterpret_cast<const char*>(values.constData()),
+             values.count(), sizeof(double));
+}
+
+/** Remove all of the grids from the cache directory. Grids that are
+    already loaded remain valid until they are no longer used */
+void CLJGridCache::clear()
+{
+    const QString dir = cacheDirectory();
+
+    if (dir.isEmpty())
+        return;
+
+    QMutexLocker lkr( cacheMutex() );
+
+    mappedGrids()->clear();
+
+    QDir d(dir);
+
+    foreach (const QString &filename, d.entryList(QStringList("*.grid"), QDir::Files))
+    {
+        d.remove(filename);
+    }
+}
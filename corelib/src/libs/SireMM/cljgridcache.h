@@ -0,0 +1,138 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#ifndef SIREMM_CLJGRIDCACHE_H
+#define SIREMM_CLJGRIDCACHE_H
+
+#include <QString>
+#include <QVector>
+
+#include <boost/shared_ptr.hpp>
+
+#include "sireglobal.h"
+
+SIRE_BEGIN_HEADER
+
+namespace SireMM
+{
+
+namespace detail
+{
+
+class MappedGridFile;
+
+/** This is a read-only array of the values on a grid. The values
+    are either held in memory, or are memory-mapped from a file
+    in the grid cache (in which case the memory is shared with
+    every other grid, in this or any other process on the same
+    node, that has loaded the same file)
+
+    @author Christopher Woods
+*/
+class SIREMM_EXPORT GridValues
+{
+public:
+    GridValues();
+    GridValues(const QVector<float> &values);
+    GridValues(const boost::shared_ptr<const MappedGridFile> &file);
+
+    GridValues(const GridValues &other);
+
+    ~GridValues();
+
+    GridValues& operator=(const GridValues &other);
+
+    const float* constData() const;
+
+    int count() const;
+
+    bool isEmpty() const;
+    bool isMapped() const;
+
+    QVector<float> toVector() const;
+
+private:
+    /** The values, if they are held in memory */
+    QVector<float> vals;
+
+    /** The memory-mapped file holding the values, if they are cached */
+    boost::shared_ptr<const MappedGridFile> mapped;
+};
+
+} // end of namespace detail
+
+/** This class provides an on-disk cache of the grids of potentials
+    calculated by CLJGrid, GridFF and GridFF2. Building the grid for a 
+    large set of fixed atoms (e.g. a protein) at a fine grid spacing is 
+    expensive, and is often repeated for every job run against the same 
+    fixed atoms.
+
+    The cache is a directory of files, each holding the values of one grid.
+    The files are named using a hash of everything that determines the grid
+    (the fixed atoms, the CLJFunction, and the grid dimensions, spacing
+    and buffer). The single precision grids of CLJGrid are memory-mapped 
+    read-only when they are loaded, so that they are shared between all 
+    of the processes on a node that use the same grid. The double precision
+    grids of GridFF and GridFF2 are copied when they are loaded.
+
+    The cache is disabled unless a cache directory is set, either by
+    calling setCacheDirectory, or by setting the environment variable
+    SIRE_GRID_CACHE
+
+    @author Christopher Woods
+*/
+class SIREMM_EXPORT CLJGridCache
+{
+public:
+    static void setCacheDirectory(const QString &directory);
+    static QString cacheDirectory();
+
+    static void disable();
+
+    static bool isEnabled();
+
+    static QString createKey(const QByteArray &data);
+
+    static bool contains(const QString &key);
+
+    static detail::GridValues load(const QString &key, int nvalues);
+    static QVector<double> loadDoubles(const QString &key, int nvalues);
+
+    static void save(const QString &key, const QVector<float> &values);
+    static void save(const QString &key, const QVector<double> &values);
+
+    static void clear();
+};
+
+}
+
+SIRE_EXPOSE_CLASS( SireMM::CLJGridCache )
+
+SIRE_END_HEADER
+
+#endif
@@ -31,6 +31,8 @@
 #include "SireStream/datastream.h"
 #include "SireStream/shareddatastream.h"
 
+#include "SireFF/forcetable.h"
+
 #include "SireError/errors.h"
 
 #include <QElapsedTimer>
@@ -552,6 +554,32 @@ Molecules CLJGroup::changedMolecules() const
     }
 }
 
+/** Add the forces in 'forces', which must have been calculated for the atoms
+    in cljBoxes() (arranged in the same order as cljBoxes().occupiedBoxes()),
+    onto the molecules in 'table', scaled by 'scale_force'. Only molecules
+    that have a table in 'table' are affected. This group must have been 
+    accepted before the forces can be added */
+void CLJGroup::addForces(const QVector<CLJForces> &forces, SireFF::ForceTable &table,
+                         double scale_force) const
+{
+    if (scale_force == 0 or forces.isEmpty())
+        return;
+
+    if (this->needsAccepting())
+        throw SireError::invalid_state( QObject::tr(
+                "Cannot add the forces from a CLJGroup that needs accepting."),
+                    CODELOC );
+    
+    for (ChunkedHash<MolNum,CLJExtractor>::const_iterator it = cljexts.constBegin();
+         it != cljexts.constEnd(); ++it)
+    {
+        if (table.containsTable(it.key()))
+        {
+            it.value().addForces(cljboxes, forces, table.getTable(it.key()), scale_force);
+        }
+    }
+}
+
 /** Return whether or not this group needs to be accepted */
 bool CLJGroup::needsAccepting() const
 {
@@ -41,6 +41,11 @@ namespace SireMM
 class CLJGroup;
 }
 
+namespace SireFF
+{
+class ForceTable;
+}
+
 QDataStream& operator<<(QDataStream&, const SireMM::CLJGroup&);
 QDataStream& operator>>(QDataStream&, SireMM::CLJGroup&);
 
@@ -114,6 +119,9 @@ public:
     
     const CLJBoxes& cljBoxes() const;
     
+    void addForces(const QVector<CLJForces> &forces, SireFF::ForceTable &table,
+                   double scale_force=1) const;
+    
     CLJAtoms changedAtoms() const;
     CLJAtoms newAtoms() const;
     CLJAtoms oldAtoms() const;
@@ -0,0 +1,422 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#include "cljpairlist.h"
+#include "cljfunction.h"
+
+#include "SireBase/profiler.h"
+
+#include "SireUnits/units.h"
+
+#include "SireStream/datastream.h"
+
+#include <QVarLengthArray>
+
+using namespace SireMM;
+using namespace SireMaths;
+using namespace SireVol;
+using namespace SireBase;
+using namespace SireStream;
+
+static const RegisterMetaType<CLJPairList> r_pairlist(NO_ROOT);
+
+QDataStream SIREMM_EXPORT &operator<<(QDataStream &ds, const CLJPairList &list)
+{
+    writeHeader(ds, r_pairlist, 1);
+    ds << double(list.skn.value());
+    return ds;
+}
+
+QDataStream SIREMM_EXPORT &operator>>(QDataStream &ds, CLJPairList &list)
+{
+    VersionID v = readHeader(ds, r_pairlist);
+    
+    if (v == 1)
+    {
+        double skin;
+        ds >> skin;
+        
+        list = CLJPairList( Length(skin) );
+    }
+    else
+        throw version_error(v, "1", r_pairlist, CODELOC);
+    
+    return ds;
+}
+
+/** Return the default skin (2 angstrom) */
+Length CLJPairList::defaultSkin()
+{
+    return Length( 2 * SireUnits::angstrom );
+}
+
+/** Constructor */
+CLJPairList::CLJPairList()
+            : skn(CLJPairList::defaultSkin()), coul_cutoff(0), lj_cutoff(0), nrebuilds(0)
+{}
+
+/** Construct, specifying the skin that is added onto the cutoff
+    when building the list */
+CLJPairList::CLJPairList(Length skin)
+            : skn(skin), coul_cutoff(0), lj_cutoff(0), nrebuilds(0)
+{
+    if (skn.value() < 0)
+        skn = Length(0);
+}
+
+/** Copy constructor */
+CLJPairList::CLJPairList(const CLJPairList &other)
+            : skn(other.skn), coul_cutoff(other.coul_cutoff), lj_cutoff(other.lj_cutoff),
+              spce(other.spce), box_indicies(other.box_indicies), ref_atoms(other.ref_atoms),
+              pairs(other.pairs), idxs0(other.idxs0), idxs1(other.idxs1),
+              nrebuilds(other.nrebuilds)
+{}
+
+/** Destructor */
+CLJPairList::~CLJPairList()
+{}
+
+/** Copy assignment operator */
+CLJPairList& CLJPairList::operator=(const CLJPairList &other)
+{
+    if (this != &other)
+    {
+        skn = other.skn;
+        coul_cutoff = other.coul_cutoff;
+        lj_cutoff = other.lj_cutoff;
+        spce = other.spce;
+        box_indicies = other.box_indicies;
+        ref_atoms = other.ref_atoms;
+        pairs = other.pairs;
+        idxs0 = other.idxs0;
+        idxs1 = other.idxs1;
+        nrebuilds = other.nrebuilds;
+    }
+    
+    return *this;
+}
+
+/** Comparison operator - two lists are equal if they have the same
+    skin (the contents of the list are just a cache) */
+bool CLJPairList::operator==(const CLJPairList &other) const
+{
+    return skn == other.skn;
+}
+
+/** Comparison operator */
+bool CLJPairList::operator!=(const CLJPairList &other) const
+{
+    return not operator==(other);
+}
+
+const char* CLJPairList::typeName()
+{
+    return QMetaType::typeName( qMetaTypeId<CLJPairList>() );
+}
+
+const char* CLJPairList::what() const
+{
+    return CLJPairList::typeName();
+}
+
+QString CLJPairList::toString() const
+{
+    return QObject::tr("CLJPairList( skin() == %1 A, nBoxPairs() == %2 )")
+                .arg(skn.to(SireUnits::angstrom)).arg(pairs.count());
+}
+
+/** Set the skin that is added onto the cutoff when building the list.
+    This clears the list, so that it is rebuilt on next use */
+void CLJPairList::setSkin(Length skin)
+{
+    if (skin.value() < 0)
+        skin = Length(0);
+
+    if (skin != skn)
+    {
+        skn = skin;
+        this->clear();
+    }
+}
+
+/** Return the skin that is added onto the cutoff when building the list */
+Length CLJPairList::skin() const
+{
+    return skn;
+}
+
+/** Return whether or not the list is empty (e.g. has not yet been built) */
+bool CLJPairList::isEmpty() const
+{
+    return pairs.isEmpty();
+}
+
+/** Return the number of pairs of boxes in the list */
+int CLJPairList::nBoxPairs() const
+{
+    return pairs.count();
+}
+
+/** Return the number of times that this list has been built */
+int CLJPairList::nRebuilds() const
+{
+    return nrebuilds;
+}
+
+/** Clear the list, so that it is rebuilt on next use */
+void CLJPairList::clear()
+{
+    coul_cutoff = 0;
+    lj_cutoff = 0;
+    spce = SpacePtr();
+    box_indicies.clear();
+    ref_atoms.clear();
+    pairs.clear();
+    idxs0.clear();
+    idxs1.clear();
+}
+
+/** Return whether or not the list must be rebuilt before it can be used
+    to calculate the energy of 'boxes' using 'func'. This is the case
+    if the list has not been built, if the cutoffs or space of 'func'
+    have changed, if the occupied boxes or the atoms in those boxes
+    have changed, or if any atom has moved by more than half of the skin
+    since the list was built. A list is never needed for a function
+    without a cutoff */
+bool CLJPairList::needsRebuild(const CLJFunction &func, const CLJBoxes &boxes) const
+{
+    if (not func.hasCutoff())
+        return false;
+
+    const CLJBoxes::Container &b = boxes.occupiedBoxes();
+
+    if (box_indicies.isEmpty() and not b.isEmpty())
+        return true;
+
+    if (coul_cutoff != float(func.coulombCutoff().value()) or
+        lj_cutoff != float(func.ljCutoff().value()))
+        return true;
+    
+    if (b.count() != box_indicies.count())
+        return true;
+    
+    if (not spce.read().equals(func.space()))
+        return true;
+    
+    const float half_skin = 0.5 * skn.value();
+    const float max_disp2 = half_skin * half_skin;
+    
+    for (int i=0; i<b.count(); ++i)
+    {
+        const CLJBox &box = b.constData()[i].read();
+        
+        if (box.index() != box_indicies.constData()[i])
+            return true;
+        
+        const CLJAtoms &atoms = box.atoms();
+        const CLJAtoms &ref = ref_atoms.constData()[i];
+        
+        if (atoms.x().constData() == ref.x().constData() and
+            atoms.y().constData() == ref.y().constData() and
+            atoms.z().constData() == ref.z().constData() and
+            atoms.ID().constData() == ref.ID().constData())
+        {
+            //these are still the same atoms that were used to build the list
+            continue;
+        }
+        
+        if (atoms.x().count() != ref.x().count() or atoms.ID() != ref.ID())
+            return true;
+        
+        const MultiFloat *x = atoms.x().constData();
+        const MultiFloat *y = atoms.y().constData();
+        const MultiFloat *z = atoms.z().constData();
+
+        const MultiFloat *rx = ref.x().constData();
+        const MultiFloat *ry = ref.y().constData();
+        const MultiFloat *rz = ref.z().constData();
+        
+        MultiFloat d, r2, max_r2(0);
+        
+        for (int j=0; j<atoms.x().count(); ++j)
+        {
+            d = x[j] - rx[j];
+            r2 = d * d;
+            d = y[j] - ry[j];
+            r2.multiplyAdd(d, d);
+            d = z[j] - rz[j];
+            r2.multiplyAdd(d, d);
+            
+            max_r2 = max_r2.max(r2);
+        }
+        
+        if (max_r2.max() > max_disp2)
+            return true;
+    }
+    
+    return false;
+}
+
+/** Rebuild the list for the passed function and boxes */
+void CLJPairList::rebuild(const CLJFunction &func, const CLJBoxes &boxes)
+{
+    SIRE_PROFILE("SireMM::CLJPairList::rebuild");
+
+    this->clear();
+    
+    coul_cutoff = func.coulombCutoff().value();
+    lj_cutoff = func.ljCutoff().value();
+    spce = func.space();
+    
+    const Space &space = func.space();
+    
+    const float list_cutoff = qMax(coul_cutoff, lj_cutoff) + skn.value();
+    const double list_cutoff2 = double(list_cutoff) * double(list_cutoff);
+    
+    const CLJBoxes::Container &b = boxes.occupiedBoxes();
+    
+    box_indicies.reserve(b.count());
+    ref_atoms.reserve(b.count());
+    
+    for (int i=0; i<b.count(); ++i)
+    {
+        box_indicies.append( b.constData()[i].read().index() );
+        ref_atoms.append( b.constData()[i].read().atoms() );
+    }
+    
+    const QVector<CLJBoxDistance> dists = CLJBoxes::getDistances(space, boxes,
+                                                                 Length(list_cutoff));
+    
+    pairs.reserve(dists.count());
+    idxs0.reserve(dists.count());
+    idxs1.reserve(dists.count());
+    
+    const qint32 dummy_id = CLJAtoms::idOfDummy()[0];
+    
+    for (int i=0; i<dists.count(); ++i)
+    {
+        const CLJBoxDistance &dist = dists.constData()[i];
+    
+        if (dist.box0() == dist.box1())
+        {
+            //all of the atoms in a box interact with each other
+            pairs.append(dist);
+            idxs0.append( QVector<qint32>() );
+            idxs1.append( QVector<qint32>() );
+            continue;
+        }
+        
+        const CLJAtoms &atoms0 = ref_atoms.constData()[dist.box0()];
+        const CLJAtoms &atoms1 = ref_atoms.constData()[dist.box1()];
+        
+        const QVector<Vector> coords0 = atoms0.coordinates();
+        const QVector<Vector> coords1 = atoms1.coordinates();
+        const QVector<qint32> ids0 = atoms0.IDs();
+        const QVector<qint32> ids1 = atoms1.IDs();
+        
+        const int n0 = coords0.count();
+        const int n1 = coords1.count();
+        
+        QVarLengthArray<bool> in0(n0);
+        QVarLengthArray<bool> in1(n1);
+        
+        for (int j=0; j<n0; ++j)
+        {
+            in0[j] = false;
+        }
+        
+        for (int j=0; j<n1; ++j)
+        {
+            in1[j] = false;
+        }
+        
+        for (int j=0; j<n0; ++j)
+        {
+            if (ids0.constData()[j] == dummy_id)
+                continue;
+            
+            const Vector &c0 = coords0.constData()[j];
+            
+            for (int k=0; k<n1; ++k)
+            {
+                if ((in0[j] and in1[k]) or ids1.constData()[k] == dummy_id)
+                    continue;
+                
+                if (space.calcDist2(c0, coords1.constData()[k]) < list_cutoff2)
+                {
+                    in0[j] = true;
+                    in1[k] = true;
+                }
+            }
+        }
+        
+        QVector<qint32> block0, block1;
+        
+        for (int j=0; j<n0; ++j)
+        {
+            if (in0[j])
+                block0.append(j);
+        }
+        
+        if (block0.isEmpty())
+            continue;
+        
+        for (int k=0; k<n1; ++k)
+        {
+            if (in1[k])
+                block1.append(k);
+        }
+        
+        block0.squeeze();
+        block1.squeeze();
+        
+        pairs.append(dist);
+        idxs0.append(block0);
+        idxs1.append(block1);
+    }
+    
+    pairs.squeeze();
+    idxs0.squeeze();
+    idxs1.squeeze();
+    
+    nrebuilds += 1;
+}
+
+/** Update the list so that it can be used to calculate the energy 
+    of 'boxes' using 'func', rebuilding it if needed. This returns
+    whether or not the list was rebuilt */
+bool CLJPairList::update(const CLJFunction &func, const CLJBoxes &boxes)
+{
+    if (this->needsRebuild(func, boxes))
+    {
+        this->rebuild(func, boxes);
+        return true;
+    }
+    else
+        return false;
+}
@@ -0,0 +1,182 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#ifndef SIREMM_CLJPAIRLIST_H
+#define SIREMM_CLJPAIRLIST_H
+
+#include "cljboxes.h"
+
+#include "SireVol/space.h"
+
+SIRE_BEGIN_HEADER
+
+namespace SireMM
+{
+class CLJPairList;
+}
+
+QDataStream& operator<<(QDataStream&, const SireMM::CLJPairList&);
+QDataStream& operator>>(QDataStream&, SireMM::CLJPairList&);
+
+namespace SireMM
+{
+
+class CLJFunction;
+
+/** This class holds a persistent (Verlet) neighbour list for the atoms
+    in a set of CLJBoxes. The list is built using a cutoff that is
+    larger than the cutoff of the CLJFunction by the 'skin', and holds,
+    for every pair of boxes that are within this distance, the compact
+    blocks of the atoms in each box that have at least one atom of the
+    other box within the extended cutoff. The CLJCalculator then only
+    gathers and evaluates these blocks, rather than recalculating the
+    distances between all pairs of boxes, and all pairs of atoms within 
+    those boxes, on every call.
+
+    The list remains valid until any atom has moved by more than half 
+    of the skin since the list was built (or the boxes, the space or 
+    the cutoffs have changed), at which point it is rebuilt automatically.
+    This makes it most useful for consecutive steps of molecular 
+    dynamics, or small-step Monte Carlo moves of all of the atoms.
+    
+    Note that only the skin is streamed - the list itself is a 
+    cache that is rebuilt when needed
+
+    @author Christopher Woods
+*/
+class SIREMM_EXPORT CLJPairList
+{
+
+friend QDataStream& ::operator<<(QDataStream&, const CLJPairList&);
+friend QDataStream& ::operator>>(QDataStream&, CLJPairList&);
+
+public:
+    CLJPairList();
+    CLJPairList(Length skin);
+    
+    CLJPairList(const CLJPairList &other);
+    
+    ~CLJPairList();
+    
+    CLJPairList& operator=(const CLJPairList &other);
+    
+    bool operator==(const CLJPairList &other) const;
+    bool operator!=(const CLJPairList &other) const;
+    
+    static const char* typeName();
+    
+    const char* what() const;
+    
+    QString toString() const;
+    
+    static Length defaultSkin();
+    
+    void setSkin(Length skin);
+    Length skin() const;
+    
+    bool isEmpty() const;
+    
+    int nBoxPairs() const;
+    int nRebuilds() const;
+    
+    void clear();
+    
+    bool needsRebuild(const CLJFunction &func, const CLJBoxes &boxes) const;
+    bool update(const CLJFunction &func, const CLJBoxes &boxes);
+    
+    const QVector<CLJBoxDistance>& boxPairs() const;
+    
+    const QVector<qint32>& atoms0(int i) const;
+    const QVector<qint32>& atoms1(int i) const;
+    
+private:
+    void rebuild(const CLJFunction &func, const CLJBoxes &boxes);
+
+    /** The skin added onto the cutoff when building the list */
+    Length skn;
+    
+    /** The cutoffs of the function used to build the list */
+    float coul_cutoff, lj_cutoff;
+    
+    /** The space used to build the list */
+    SireVol::SpacePtr spce;
+    
+    /** The indicies of the occupied boxes when the list was built */
+    QVector<CLJBoxIndex> box_indicies;
+    
+    /** The atoms in each occupied box when the list was built - 
+        these are used to find how far the atoms have moved */
+    QVector<CLJAtoms> ref_atoms;
+    
+    /** The pairs of boxes in the list. The box numbers are
+        the indicies of the boxes in CLJBoxes::occupiedBoxes() */
+    QVector<CLJBoxDistance> pairs;
+    
+    /** The indicies of the atoms of the first and second box
+        of each pair that are in the list. These are empty
+        for the pair of a box with itself (in which case 
+        all atoms are used) */
+    QVector< QVector<qint32> > idxs0, idxs1;
+    
+    /** The number of times the list has been (re)built */
+    qint32 nrebuilds;
+};
+
+#ifndef SIRE_SKIP_INLINE_FUNCTIONS
+
+/** Return the pairs of boxes in the list */
+inline const QVector<CLJBoxDistance>& CLJPairList::boxPairs() const
+{
+    return pairs;
+}
+
+/** Return the indicies of the atoms in the first box of the ith
+    pair that are in the list. This is empty if all atoms should be used */
+inline const QVector<qint32>& CLJPairList::atoms0(int i) const
+{
+    return idxs0.constData()[i];
+}
+
+/** Return the indicies of the atoms in the second box of the ith
+    pair that are in the list. This is empty if all atoms should be used */
+inline const QVector<qint32>& CLJPairList::atoms1(int i) const
+{
+    return idxs1.constData()[i];
+}
+
+#endif // SIRE_SKIP_INLINE_FUNCTIONS
+
+}
+
+Q_DECLARE_METATYPE( SireMM::CLJPairList )
+
+SIRE_EXPOSE_CLASS( SireMM::CLJPairList )
+
+SIRE_END_HEADER
+
+#endif
@@ -26,12 +26,19 @@
   *
 \*********************************************/
 
-#include "cljrffunction.h"
-
 #include "SireMaths/multifloat.h"
 #include "SireMaths/multidouble.h"
 #include "SireMaths/multiint.h"
 
+#include "detail/cljkernelviews.hpp"
+
+// Only the vectorised kernels of CLJRFFunction are compiled for each
+// instruction set (see detail/cljkernels.h). Everything else is
+// compiled once, for the baseline instruction set
+#ifndef SIRE_KERNEL_ISA
+
+#include "cljrffunction.h"
+
 #include "SireBase/numberproperty.h"
 
 #include "SireUnits/units.h"
@@ -43,6 +50,8 @@
 
 #include "SireVol/gridinfo.h"
 
+#include "detail/cljforcekernel.hpp"
+
 #include <QElapsedTimer>
 #include <QDebug>
 
@@ -55,10 +64,171 @@ using namespace SireStream;
 
 const float default_dielectric = 1.0;
 
+namespace SireMM
+{
+    namespace detail
+    {
+        /** Functional form used by detail::cljForceKernel to calculate the 
+            forces for the reaction field electrostatics and cutoff LJ functions */
+        class RFForce
+        {
+        public:
+            RFForce(float coul_cutoff, float lj_cutoff, float dielectric,
+                    float scale_coul, float scale_lj)
+                 : Rc(coul_cutoff), Rlj2(lj_cutoff*lj_cutoff),
+                   two_k_rf( 2.0 * (1.0 / pow_3(coul_cutoff)) *
+                                   ( (dielectric-1) / (2*dielectric + 1) ) ),
+                   scl_coul(scale_coul), scl_lj(scale_lj),
+                   calc_coul(scale_coul != 0), calc_lj(scale_lj != 0)
+            {}
+            
+            bool hasCoulomb() const
+            {
+                return calc_coul;
+            }
+            
+            bool hasLJ() const
+            {
+                return calc_lj;
+            }
+            
+            /** E = q0q1 * { 1/r + k r^2 - c }, so
+                -(dE/dr) / r = q0q1 * { 1/r^3 - 2k } */
+            MultiFloat coulomb(const MultiFloat &r2, const MultiFloat &q0q1) const
+            {
+                const MultiFloat r = r2.sqrt();
+                const MultiFloat one_over_r = r.reciprocal();
+                
+                MultiFloat tmp = one_over_r * one_over_r * one_over_r;
+                tmp -= two_k_rf;
+                tmp *= q0q1 * scl_coul;
+                
+                tmp &= r.compareLess(Rc);
+                
+                return tmp;
+            }
+            
+            /** E = eps * { (sig/r)^12 - (sig/r)^6 }, so
+                -(dE/dr) / r = eps * { 12 (sig/r)^12 - 6 (sig/r)^6 } / r^2 */
+            MultiFloat lj(const MultiFloat &r2, const MultiFloat &sigma,
+                          const MultiFloat &eps) const
+            {
+                const MultiFloat one_over_r2 = r2.reciprocal();
+                
+                MultiFloat sig6_over_r6 = sigma * sigma * one_over_r2;
+                sig6_over_r6 = sig6_over_r6 * sig6_over_r6 * sig6_over_r6;
+                
+                MultiFloat tmp = MultiFloat(12) * sig6_over_r6 * sig6_over_r6;
+                tmp -= MultiFloat(6) * sig6_over_r6;
+                tmp *= eps * one_over_r2 * scl_lj;
+                
+                tmp &= r2.compareLess(Rlj2);
+                
+                return tmp;
+            }
+            
+        private:
+            const MultiFloat Rc;
+            const MultiFloat Rlj2;
+            const MultiFloat two_k_rf;
+            const MultiFloat scl_coul;
+            const MultiFloat scl_lj;
+            const bool calc_coul;
+            const bool calc_lj;
+        };
+        
+        /** Functional form used by detail::cljForceKernel to calculate the 
+            forces for the soft-core reaction field electrostatics and cutoff LJ functions */
+        class SoftRFForce
+        {
+        public:
+            SoftRFForce(float coul_cutoff, float lj_cutoff, float dielectric,
+                        float alpha, float one_minus_alpha_to_n,
+                        float alpha_times_shift_delta,
+                        float scale_coul, float scale_lj)
+                 : Rlj2(lj_cutoff*lj_cutoff),
+                   soft_Rc( std::sqrt(alpha + coul_cutoff*coul_cutoff) ),
+                   two_k_rf( 2.0 * (1.0 / pow_3(std::sqrt(alpha + coul_cutoff*coul_cutoff))) *
+                                   ( (dielectric-1) / (2*dielectric + 1) ) ),
+                   alfa(alpha), delta(alpha_times_shift_delta),
+                   scl_coul(scale_coul * one_minus_alpha_to_n), scl_lj(scale_lj),
+                   calc_coul(scale_coul != 0), calc_lj(scale_lj != 0)
+            {}
+            
+            bool hasCoulomb() const
+            {
+                return calc_coul;
+            }
+            
+            bool hasLJ() const
+            {
+                return calc_lj;
+            }
+            
+            /** E = (1-alpha)^n q0q1 * { 1/s + k s^2 - c } with s = sqrt(alpha + r^2),
+                so -(dE/dr) / r = (1-alpha)^n q0q1 * { 1/s^3 - 2k } */
+            MultiFloat coulomb(const MultiFloat &r2, const MultiFloat &q0q1) const
+            {
+                const MultiFloat soft_r = (r2 + alfa).sqrt();
+                const MultiFloat one_over_soft_r = soft_r.reciprocal();
+                
+                MultiFloat tmp = one_over_soft_r * one_over_soft_r * one_over_soft_r;
+                tmp -= two_k_rf;
+                tmp *= q0q1 * scl_coul;
+                
+                tmp &= soft_r.compareLess(soft_Rc);
+                
+                return tmp;
+            }
+            
+            /** E = eps * { sig^12 / D^6 - sig^6 / D^3 } with D = delta sig + r^2,
+                so -(dE/dr) / r = eps * { 12 sig^12 / D^6 - 6 sig^6 / D^3 } / D */
+            MultiFloat lj(const MultiFloat &r2, const MultiFloat &sigma,
+                          const MultiFloat &eps) const
+            {
+                const MultiFloat one_over_delta = (delta * sigma + r2).reciprocal();
+                
+                MultiFloat sig6_over_delta3 = sigma * sigma * one_over_delta;
+                sig6_over_delta3 = sig6_over_delta3 * sig6_over_delta3 * sig6_over_delta3;
+                
+                MultiFloat tmp = MultiFloat(12) * sig6_over_delta3 * sig6_over_delta3;
+                tmp -= MultiFloat(6) * sig6_over_delta3;
+                tmp *= eps * one_over_delta * scl_lj;
+                
+                tmp &= r2.compareLess(Rlj2);
+                
+                return tmp;
+            }
+            
+        private:
+            const MultiFloat Rlj2;
+            const MultiFloat soft_Rc;
+            const MultiFloat two_k_rf;
+            const MultiFloat alfa;
+            const MultiFloat delta;
+            const MultiFloat scl_coul;
+            const MultiFloat scl_lj;
+            const bool calc_coul;
+            const bool calc_lj;
+        };
+    }
+}
+
 /////////
 ///////// Implementation of CLJRFFunction
 /////////
 
+/** Return the parameters needed by the reaction field kernels */
+static detail::CLJKernelParams rfParams(float coul_cutoff, float lj_cutoff,
+                                        float dielectric)
+{
+    detail::CLJKernelParams params;
+    params.coul_cutoff = coul_cutoff;
+    params.lj_cutoff = lj_cutoff;
+    params.dielectric = dielectric;
+    return params;
+}
+
 static const RegisterMetaType<CLJRFFunction> r_shift;
 
 QDataStream SIREMM_EXPORT &operator<<(QDataStream &ds, const CLJRFFunction &func)
@@ -263,6 +433,239 @@ float CLJRFFunction::dielectric() const
     returning the results in the arguments 'cnrg' and 'ljnrg' */
 void CLJRFFunction::calcVacEnergyGeo(const CLJAtoms &atoms,
                                      double &cnrg, double &ljnrg) const
+{
+    detail::cljKernels().rf.vac_energy_geo(rfParams(coul_cutoff, lj_cutoff, dielectric()),
+                                           detail::CLJKernelAtomsData(atoms), cnrg, ljnrg);
+}
+
+/** Calculate the intermolecular energy between all atoms in 'atoms0' and all
+    atoms in 'atoms1', returning the result in the arguments 'cnrg' and 'ljnrg' */
+void CLJRFFunction::calcVacEnergyGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                     double &cnrg, double &ljnrg, float min_distance) const
+{
+    detail::cljKernels().rf.vac_energy_geo2(rfParams(coul_cutoff, lj_cutoff, dielectric()),
+                                            detail::CLJKernelAtomsData(atoms0),
+                                            detail::CLJKernelAtomsData(atoms1), cnrg, ljnrg);
+}
+
+/** Calculate the coulomb and LJ intermolecular energy of all of the atoms in 'atoms',
+    assuming periodic boundary conditions in a cubic box of size 'box_dimensions',
+    returning the results in 'cnrg' and 'ljnrg' */
+void CLJRFFunction::calcBoxEnergyGeo(const CLJAtoms &atoms, const Vector &box_dimensions,
+                                     double &cnrg, double &ljnrg) const
+{
+    detail::cljKernels().rf.box_energy_geo(rfParams(coul_cutoff, lj_cutoff, dielectric()),
+                                           detail::CLJKernelAtomsData(atoms),
+                                           detail::cljKernelVector(box_dimensions), cnrg,
+                                           ljnrg);
+}
+
+/** Calculate the intermolecular energy between all atoms in 'atoms0' and all
+    atoms in 'atoms1', assuming periodic boundary conditions in a cubic box
+    of size 'box_dimensions, returning the result in the arguments 'cnrg' and 'ljnrg' */
+void CLJRFFunction::calcBoxEnergyGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                     const Vector &box_dimensions,
+                                     double &cnrg, double &ljnrg, float min_distance) const
+{
+    detail::cljKernels().rf.box_energy_geo2(rfParams(coul_cutoff, lj_cutoff, dielectric()),
+                                            detail::CLJKernelAtomsData(atoms0),
+                                            detail::CLJKernelAtomsData(atoms1),
+                                            detail::cljKernelVector(box_dimensions), cnrg,
+                                            ljnrg);
+}
+
+/** Calculate the coulomb and LJ intermolecular energy of all of the atoms in 'atoms',
+    returning the results in the arguments 'cnrg' and 'ljnrg' */
+void CLJRFFunction::calcVacEnergyAri(const CLJAtoms &atoms,
+                                     double &cnrg, double &ljnrg) const
+{
+    detail::cljKernels().rf.vac_energy_ari(rfParams(coul_cutoff, lj_cutoff, dielectric()),
+                                           detail::CLJKernelAtomsData(atoms), cnrg, ljnrg);
+}
+
+/** Calculate the intermolecular energy between all atoms in 'atoms0' and all
+    atoms in 'atoms1', returning the result in the arguments 'cnrg' and 'ljnrg' */
+void CLJRFFunction::calcVacEnergyAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                     double &cnrg, double &ljnrg, float min_distance) const
+{
+    detail::cljKernels().rf.vac_energy_ari2(rfParams(coul_cutoff, lj_cutoff, dielectric()),
+                                            detail::CLJKernelAtomsData(atoms0),
+                                            detail::CLJKernelAtomsData(atoms1), cnrg, ljnrg);
+}
+
+/** Calculate the coulomb intermolecular energy of all atoms in 'atoms' */
+double CLJRFFunction::calcVacCoulombEnergyAri(const CLJAtoms &atoms) const
+{
+    return detail::cljKernels().rf.vac_coulomb_energy_ari(rfParams(coul_cutoff, lj_cutoff, dielectric()),
+                                                          detail::CLJKernelAtomsData(atoms));
+}
+
+/** Calculate the coulomb intermolecular energy between all atoms in 'atoms0'
+    and 'atoms1' */
+double CLJRFFunction::calcVacCoulombEnergyAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                              float min_distance) const
+{
+    return detail::cljKernels().rf.vac_coulomb_energy_ari2(rfParams(coul_cutoff, lj_cutoff, dielectric()),
+                                                           detail::CLJKernelAtomsData(atoms0),
+                                                           detail::CLJKernelAtomsData(atoms1));
+}
+
+/** Calculate the LJ intermolecular energy of all atoms in 'atoms' */
+double CLJRFFunction::calcVacLJEnergyAri(const CLJAtoms &atoms) const
+{
+    return detail::cljKernels().rf.vac_lj_energy_ari(rfParams(coul_cutoff, lj_cutoff, dielectric()),
+                                                     detail::CLJKernelAtomsData(atoms));
+}
+
+/** Calculate the LJ intermolecular energy between all atoms in 'atoms0'
+    and 'atoms1' */
+double CLJRFFunction::calcVacLJEnergyAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                         float min_distance) const
+{
+    return detail::cljKernels().rf.vac_lj_energy_ari2(rfParams(coul_cutoff, lj_cutoff, dielectric()),
+                                                      detail::CLJKernelAtomsData(atoms0),
+                                                      detail::CLJKernelAtomsData(atoms1));
+}
+
+/** Calculate the coulomb and LJ intermolecular energy of all of the atoms in 'atoms',
+    assuming periodic boundary conditions in a cubic box of size 'box_dimensions',
+    returning the results in 'cnrg' and 'ljnrg' */
+void CLJRFFunction::calcBoxEnergyAri(const CLJAtoms &atoms, const Vector &box_dimensions,
+                                     double &cnrg, double &ljnrg) const
+{
+    detail::cljKernels().rf.box_energy_ari(rfParams(coul_cutoff, lj_cutoff, dielectric()),
+                                           detail::CLJKernelAtomsData(atoms),
+                                           detail::cljKernelVector(box_dimensions), cnrg,
+                                           ljnrg);
+}
+
+/** Calculate the intermolecular energy between all atoms in 'atoms0' and all
+    atoms in 'atoms1', assuming periodic boundary conditions in a cubic box
+    of size 'box_dimensions, returning the result in the arguments 'cnrg' and 'ljnrg' */
+void CLJRFFunction::calcBoxEnergyAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                     const Vector &box_dimensions,
+                                     double &cnrg, double &ljnrg, float min_distance) const
+{
+    detail::cljKernels().rf.box_energy_ari2(rfParams(coul_cutoff, lj_cutoff, dielectric()),
+                                            detail::CLJKernelAtomsData(atoms0),
+                                            detail::CLJKernelAtomsData(atoms1),
+                                            detail::cljKernelVector(box_dimensions), cnrg,
+                                            ljnrg);
+}
+
+/** This function does support calculations using a grid */
+bool CLJRFFunction::supportsGridCalculation() const
+{
+    return true;
+}
+
+/** Calculate the energy on the grid from the passed atoms using vacuum boundary conditions */
+void CLJRFFunction::calcVacGrid(const CLJAtoms &atoms, const GridInfo &grid_info,
+                                const int start, const int end, float *gridpot_array) const
+{
+    detail::cljKernels().rf.vac_grid(rfParams(coul_cutoff, lj_cutoff, dielectric()),
+                                     detail::CLJKernelAtomsData(atoms),
+                                     detail::cljKernelGrid(grid_info), start, end,
+                                     gridpot_array);
+}
+
+/** Calculate the energy on the grid from the passed atoms using vacuum boundary conditions */
+void CLJRFFunction::calcBoxGrid(const CLJAtoms &atoms, const GridInfo &grid_info,
+                                const Vector &box_dimensions,
+                                const int start, const int end, float *gridpot_array) const
+{
+    detail::cljKernels().rf.box_grid(rfParams(coul_cutoff, lj_cutoff, dielectric()),
+                                     detail::CLJKernelAtomsData(atoms),
+                                     detail::cljKernelGrid(grid_info),
+                                     detail::cljKernelVector(box_dimensions), start, end,
+                                     gridpot_array);
+}
+
+#endif // #ifndef SIRE_KERNEL_ISA
+
+/////////
+///////// Vectorised kernels of CLJRFFunction. These are compiled
+///////// once for each instruction set - see detail/cljkernels.h
+/////////
+
+namespace SireMM
+{
+namespace detail
+{
+namespace SIRE_KERNEL_NAMESPACE
+{
+
+using SireMaths::MultiDouble;
+
+/** The vectorised energy and grid kernels of CLJRFFunction */
+class RFKernel
+{
+public:
+    RFKernel(const CLJKernelParams &params)
+        : coul_cutoff(params.coul_cutoff), lj_cutoff(params.lj_cutoff), diel(params.dielectric)
+    {}
+
+    void calcVacEnergyGeo(const CLJAtomsView &atoms, double &cnrg, double &ljnrg) const;
+
+    void calcVacEnergyGeo(const CLJAtomsView &atoms0, const CLJAtomsView &atoms1,
+                          double &cnrg, double &ljnrg) const;
+
+    void calcBoxEnergyGeo(const CLJAtomsView &atoms, const CLJVectorView &box_dimensions,
+                          double &cnrg, double &ljnrg) const;
+
+    void calcBoxEnergyGeo(const CLJAtomsView &atoms0, const CLJAtomsView &atoms1,
+                          const CLJVectorView &box_dimensions, double &cnrg,
+                          double &ljnrg) const;
+
+    void calcVacEnergyAri(const CLJAtomsView &atoms, double &cnrg, double &ljnrg) const;
+
+    void calcVacEnergyAri(const CLJAtomsView &atoms0, const CLJAtomsView &atoms1,
+                          double &cnrg, double &ljnrg) const;
+
+    double calcVacCoulombEnergyAri(const CLJAtomsView &atoms) const;
+
+    double calcVacCoulombEnergyAri(const CLJAtomsView &atoms0,
+                                   const CLJAtomsView &atoms1) const;
+
+    double calcVacLJEnergyAri(const CLJAtomsView &atoms) const;
+
+    double calcVacLJEnergyAri(const CLJAtomsView &atoms0,
+                              const CLJAtomsView &atoms1) const;
+
+    void calcBoxEnergyAri(const CLJAtomsView &atoms, const CLJVectorView &box_dimensions,
+                          double &cnrg, double &ljnrg) const;
+
+    void calcBoxEnergyAri(const CLJAtomsView &atoms0, const CLJAtomsView &atoms1,
+                          const CLJVectorView &box_dimensions, double &cnrg,
+                          double &ljnrg) const;
+
+    void calcVacGrid(const CLJAtomsView &atoms, const CLJGridView &grid_info,
+                     const int start, const int end, float *gridpot_array) const;
+
+    void calcBoxGrid(const CLJAtomsView &atoms, const CLJGridView &grid_info,
+                     const CLJVectorView &box_dimensions, const int start, const int end,
+                     float *gridpot_array) const;
+
+private:
+    float dielectric() const
+    {
+        return diel;
+    }
+
+    static float pow_3(float x)
+    {
+        return x*x*x;
+    }
+
+    const float coul_cutoff;
+    const float lj_cutoff;
+    const float diel;
+};
+
+/** Calculate the coulomb and LJ intermolecular energy of all of the atoms in 'atoms',
+    returning the results in the arguments 'cnrg' and 'ljnrg' */
+void RFKernel::calcVacEnergyGeo(const CLJAtomsView &atoms, double &cnrg,
+                                double &ljnrg) const
 {
     const MultiFloat *xa = atoms.x().constData();
     const MultiFloat *ya = atoms.y().constData();
@@ -281,7 +684,7 @@ void CLJRFFunction::calcVacEnergyGeo(const CLJAtoms &atoms,
                                                     (2*dielectric() + 1) ) );
 
     const MultiFloat half(0.5);
-    const MultiInt dummy_id = CLJAtoms::idOfDummy();
+    const MultiInt dummy_id = atoms.idOfDummy();
     const qint32 dummy_int = dummy_id[0];
 
     MultiFloat tmp, r, r2, one_over_r, sig2_over_r2, sig6_over_r6;
@@ -456,8 +859,8 @@ void CLJRFFunction::calcVacEnergyGeo(const CLJAtoms &atoms,
 
 /** Calculate the intermolecular energy between all atoms in 'atoms0' and all
     atoms in 'atoms1', returning the result in the arguments 'cnrg' and 'ljnrg' */
-void CLJRFFunction::calcVacEnergyGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
-                                     double &cnrg, double &ljnrg, float min_distance) const
+void RFKernel::calcVacEnergyGeo(const CLJAtomsView &atoms0, const CLJAtomsView &atoms1,
+                                double &cnrg, double &ljnrg) const
 {
     const MultiFloat *x0 = atoms0.x().constData();
     const MultiFloat *y0 = atoms0.y().constData();
@@ -484,7 +887,7 @@ void CLJRFFunction::calcVacEnergyGeo(const CLJAtoms &atoms0, const CLJAtoms &ato
                                                     (2*dielectric() + 1) ) );
 
     const MultiFloat half(0.5);
-    const MultiInt dummy_id = CLJAtoms::idOfDummy();
+    const MultiInt dummy_id = atoms0.idOfDummy();
     const qint32 dummy_int = dummy_id[0];
 
     MultiFloat tmp, r, r2, one_over_r, sig2_over_r2, sig6_over_r6;
@@ -658,8 +1061,9 @@ void CLJRFFunction::calcVacEnergyGeo(const CLJAtoms &atoms0, const CLJAtoms &ato
 /** Calculate the coulomb and LJ intermolecular energy of all of the atoms in 'atoms',
     assuming periodic boundary conditions in a cubic box of size 'box_dimensions',
     returning the results in 'cnrg' and 'ljnrg' */
-void CLJRFFunction::calcBoxEnergyGeo(const CLJAtoms &atoms, const Vector &box_dimensions,
-                                     double &cnrg, double &ljnrg) const
+void RFKernel::calcBoxEnergyGeo(const CLJAtomsView &atoms,
+                                const CLJVectorView &box_dimensions, double &cnrg,
+                                double &ljnrg) const
 {
     const MultiFloat *xa = atoms.x().constData();
     const MultiFloat *ya = atoms.y().constData();
@@ -678,7 +1082,7 @@ void CLJRFFunction::calcBoxEnergyGeo(const CLJAtoms &atoms, const Vector &box_di
                                                     (2*dielectric() + 1) ) );
 
     const MultiFloat half(0.5);
-    const MultiInt dummy_id = CLJAtoms::idOfDummy();
+    const MultiInt dummy_id = atoms.idOfDummy();
     const qint32 dummy_int = dummy_id[0];
 
     MultiFloat tmp, r, r2, one_over_r, sig2_over_r2, sig6_over_r6;
@@ -781,9 +1185,9 @@ void CLJRFFunction::calcBoxEnergyGeo(const CLJAtoms &atoms, const Vector &box_di
 /** Calculate the intermolecular energy between all atoms in 'atoms0' and all
     atoms in 'atoms1', assuming periodic boundary conditions in a cubic box
     of size 'box_dimensions, returning the result in the arguments 'cnrg' and 'ljnrg' */
-void CLJRFFunction::calcBoxEnergyGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
-                                     const Vector &box_dimensions,
-                                     double &cnrg, double &ljnrg, float min_distance) const
+void RFKernel::calcBoxEnergyGeo(const CLJAtomsView &atoms0, const CLJAtomsView &atoms1,
+                                const CLJVectorView &box_dimensions, double &cnrg,
+                                double &ljnrg) const
 {
     const MultiFloat *x0 = atoms0.x().constData();
     const MultiFloat *y0 = atoms0.y().constData();
@@ -810,7 +1214,7 @@ void CLJRFFunction::calcBoxEnergyGeo(const CLJAtoms &atoms0, const CLJAtoms &ato
                                                     (2*dielectric() + 1) ) );
 
     const MultiFloat half(0.5);
-    const MultiInt dummy_id = CLJAtoms::idOfDummy();
+    const MultiInt dummy_id = atoms0.idOfDummy();
     const qint32 dummy_int = dummy_id[0];
 
     MultiFloat tmp, r, r2, one_over_r, sig2_over_r2, sig6_over_r6;
@@ -913,8 +1317,8 @@ void CLJRFFunction::calcBoxEnergyGeo(const CLJAtoms &atoms0, const CLJAtoms &ato
 
 /** Calculate the coulomb and LJ intermolecular energy of all of the atoms in 'atoms',
     returning the results in the arguments 'cnrg' and 'ljnrg' */
-void CLJRFFunction::calcVacEnergyAri(const CLJAtoms &atoms,
-                                     double &cnrg, double &ljnrg) const
+void RFKernel::calcVacEnergyAri(const CLJAtomsView &atoms, double &cnrg,
+                                double &ljnrg) const
 {
     const MultiFloat *xa = atoms.x().constData();
     const MultiFloat *ya = atoms.y().constData();
@@ -933,7 +1337,7 @@ void CLJRFFunction::calcVacEnergyAri(const CLJAtoms &atoms,
                                                     (2*dielectric() + 1) ) );
 
     const MultiFloat half(0.5);
-    const MultiInt dummy_id = CLJAtoms::idOfDummy();
+    const MultiInt dummy_id = atoms.idOfDummy();
     const qint32 dummy_int = dummy_id[0];
 
     MultiFloat tmp, r, r2, one_over_r, sig2_over_r2, sig6_over_r6;
@@ -1114,8 +1518,8 @@ void CLJRFFunction::calcVacEnergyAri(const CLJAtoms &atoms,
 
 /** Calculate the intermolecular energy between all atoms in 'atoms0' and all
     atoms in 'atoms1', returning the result in the arguments 'cnrg' and 'ljnrg' */
-void CLJRFFunction::calcVacEnergyAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
-                                     double &cnrg, double &ljnrg, float min_distance) const
+void RFKernel::calcVacEnergyAri(const CLJAtomsView &atoms0, const CLJAtomsView &atoms1,
+                                double &cnrg, double &ljnrg) const
 {
     const MultiFloat *x0 = atoms0.x().constData();
     const MultiFloat *y0 = atoms0.y().constData();
@@ -1142,7 +1546,7 @@ void CLJRFFunction::calcVacEnergyAri(const CLJAtoms &atoms0, const CLJAtoms &ato
                                                     (2*dielectric() + 1) ) );
 
     const MultiFloat half(0.5);
-    const MultiInt dummy_id = CLJAtoms::idOfDummy();
+    const MultiInt dummy_id = atoms0.idOfDummy();
     const qint32 dummy_int = dummy_id[0];
 
     MultiFloat tmp, r, r2, one_over_r, sig2_over_r2, sig6_over_r6;
@@ -1320,7 +1724,7 @@ void CLJRFFunction::calcVacEnergyAri(const CLJAtoms &atoms0, const CLJAtoms &ato
 }
 
 /** Calculate the coulomb intermolecular energy of all atoms in 'atoms' */
-double CLJRFFunction::calcVacCoulombEnergyAri(const CLJAtoms &atoms) const
+double RFKernel::calcVacCoulombEnergyAri(const CLJAtomsView &atoms) const
 {
     const MultiFloat *xa = atoms.x().constData();
     const MultiFloat *ya = atoms.y().constData();
@@ -1336,7 +1740,7 @@ double CLJRFFunction::calcVacCoulombEnergyAri(const CLJAtoms &atoms) const
                                                     (2*dielectric() + 1) ) );
 
     const MultiFloat half(0.5);
-    const MultiInt dummy_id = CLJAtoms::idOfDummy();
+    const MultiInt dummy_id = atoms.idOfDummy();
     const qint32 dummy_int = dummy_id[0];
 
     MultiFloat tmp, r, r2, one_over_r;
@@ -1403,8 +1807,8 @@ double CLJRFFunction::calcVacCoulombEnergyAri(const CLJAtoms &atoms) const
 
 /** Calculate the coulomb intermolecular energy between all atoms in 'atoms0'
     and 'atoms1' */
-double CLJRFFunction::calcVacCoulombEnergyAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
-                                              float min_distance) const
+double RFKernel::calcVacCoulombEnergyAri(const CLJAtomsView &atoms0,
+                                         const CLJAtomsView &atoms1) const
 {
     const MultiFloat *x0 = atoms0.x().constData();
     const MultiFloat *y0 = atoms0.y().constData();
@@ -1426,7 +1830,7 @@ double CLJRFFunction::calcVacCoulombEnergyAri(const CLJAtoms &atoms0, const CLJA
                                                     (2*dielectric() + 1) ) );
 
     const MultiFloat half(0.5);
-    const MultiInt dummy_id = CLJAtoms::idOfDummy();
+    const MultiInt dummy_id = atoms0.idOfDummy();
     const qint32 dummy_int = dummy_id[0];
 
     MultiFloat tmp, r, r2, one_over_r;
@@ -1487,9 +1891,9 @@ double CLJRFFunction::calcVacCoulombEnergyAri(const CLJAtoms &atoms0, const CLJA
     
     return icnrg.sum();
 }
-    
+
 /** Calculate the LJ intermolecular energy of all atoms in 'atoms' */
-double CLJRFFunction::calcVacLJEnergyAri(const CLJAtoms &atoms) const
+double RFKernel::calcVacLJEnergyAri(const CLJAtomsView &atoms) const
 {
     const MultiFloat *xa = atoms.x().constData();
     const MultiFloat *ya = atoms.y().constData();
@@ -1501,7 +1905,7 @@ double CLJRFFunction::calcVacLJEnergyAri(const CLJAtoms &atoms) const
     const MultiFloat Rlj(lj_cutoff);
 
     const MultiFloat half(0.5);
-    const MultiInt dummy_id = CLJAtoms::idOfDummy();
+    const MultiInt dummy_id = atoms.idOfDummy();
     const qint32 dummy_int = dummy_id[0];
 
     MultiFloat tmp, r, one_over_r, sig2_over_r2, sig6_over_r6;
@@ -1569,8 +1973,8 @@ double CLJRFFunction::calcVacLJEnergyAri(const CLJAtoms &atoms) const
 
 /** Calculate the LJ intermolecular energy between all atoms in 'atoms0'
     and 'atoms1' */
-double CLJRFFunction::calcVacLJEnergyAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
-                                         float min_distance) const
+double RFKernel::calcVacLJEnergyAri(const CLJAtomsView &atoms0,
+                                    const CLJAtomsView &atoms1) const
 {
     const MultiFloat *x0 = atoms0.x().constData();
     const MultiFloat *y0 = atoms0.y().constData();
@@ -1588,7 +1992,7 @@ double CLJRFFunction::calcVacLJEnergyAri(const CLJAtoms &atoms0, const CLJAtoms
     
     const MultiFloat Rlj(lj_cutoff);
     const MultiFloat half(0.5);
-    const MultiInt dummy_id = CLJAtoms::idOfDummy();
+    const MultiInt dummy_id = atoms0.idOfDummy();
     const qint32 dummy_int = dummy_id[0];
 
     MultiFloat tmp, r, one_over_r, sig2_over_r2, sig6_over_r6;
@@ -1658,8 +2062,9 @@ double CLJRFFunction::calcVacLJEnergyAri(const CLJAtoms &atoms0, const CLJAtoms
 /** Calculate the coulomb and LJ intermolecular energy of all of the atoms in 'atoms',
     assuming periodic boundary conditions in a cubic box of size 'box_dimensions',
     returning the results in 'cnrg' and 'ljnrg' */
-void CLJRFFunction::calcBoxEnergyAri(const CLJAtoms &atoms, const Vector &box_dimensions,
-                                     double &cnrg, double &ljnrg) const
+void RFKernel::calcBoxEnergyAri(const CLJAtomsView &atoms,
+                                const CLJVectorView &box_dimensions, double &cnrg,
+                                double &ljnrg) const
 {
     const MultiFloat *xa = atoms.x().constData();
     const MultiFloat *ya = atoms.y().constData();
@@ -1678,7 +2083,7 @@ void CLJRFFunction::calcBoxEnergyAri(const CLJAtoms &atoms, const Vector &box_di
                                                     (2*dielectric() + 1) ) );
 
     const MultiFloat half(0.5);
-    const MultiInt dummy_id = CLJAtoms::idOfDummy();
+    const MultiInt dummy_id = atoms.idOfDummy();
     const qint32 dummy_int = dummy_id[0];
 
     MultiFloat tmp, r, r2, one_over_r, sig2_over_r2, sig6_over_r6;
@@ -1784,9 +2189,9 @@ void CLJRFFunction::calcBoxEnergyAri(const CLJAtoms &atoms, const Vector &box_di
 /** Calculate the intermolecular energy between all atoms in 'atoms0' and all
     atoms in 'atoms1', assuming periodic boundary conditions in a cubic box
     of size 'box_dimensions, returning the result in the arguments 'cnrg' and 'ljnrg' */
-void CLJRFFunction::calcBoxEnergyAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
-                                     const Vector &box_dimensions,
-                                     double &cnrg, double &ljnrg, float min_distance) const
+void RFKernel::calcBoxEnergyAri(const CLJAtomsView &atoms0, const CLJAtomsView &atoms1,
+                                const CLJVectorView &box_dimensions, double &cnrg,
+                                double &ljnrg) const
 {
     const MultiFloat *x0 = atoms0.x().constData();
     const MultiFloat *y0 = atoms0.y().constData();
@@ -1813,7 +2218,7 @@ void CLJRFFunction::calcBoxEnergyAri(const CLJAtoms &atoms0, const CLJAtoms &ato
                                                     (2*dielectric() + 1) ) );
 
     const MultiFloat half(0.5);
-    const MultiInt dummy_id = CLJAtoms::idOfDummy();
+    const MultiInt dummy_id = atoms0.idOfDummy();
     const qint32 dummy_int = dummy_id[0];
 
     MultiFloat tmp, r, r2, one_over_r, sig2_over_r2, sig6_over_r6;
@@ -1917,15 +2322,9 @@ void CLJRFFunction::calcBoxEnergyAri(const CLJAtoms &atoms0, const CLJAtoms &ato
     ljnrg = iljnrg.sum();
 }
 
-/** This function does support calculations using a grid */
-bool CLJRFFunction::supportsGridCalculation() const
-{
-    return true;
-}
-
 /** Calculate the energy on the grid from the passed atoms using vacuum boundary conditions */
-void CLJRFFunction::calcVacGrid(const CLJAtoms &atoms, const GridInfo &grid_info,
-                                const int start, const int end, float *gridpot_array) const
+void RFKernel::calcVacGrid(const CLJAtomsView &atoms, const CLJGridView &grid_info,
+                           const int start, const int end, float *gridpot_array) const
 {
     const MultiFloat* const x = atoms.x().constData();
     const MultiFloat* const y = atoms.y().constData();
@@ -1940,7 +2339,8 @@ void CLJRFFunction::calcVacGrid(const CLJAtoms &atoms, const GridInfo &grid_info
     const MultiFloat c_rf( (1.0 / coul_cutoff ) * ( (3*dielectric()) /
                                                     (2*dielectric() + 1) ) );
 
-    const MultiInt dummy_id = CLJAtoms::idOfDummy();
+    const MultiFloat min_r2( clj_grid_min_distance*clj_grid_min_distance );
+    const MultiInt dummy_id = atoms.idOfDummy();
 
     MultiFloat tmp, r, r2, one_over_r, itmp;
 
@@ -1948,7 +2348,7 @@ void CLJRFFunction::calcVacGrid(const CLJAtoms &atoms, const GridInfo &grid_info
 
     for (int i = start; i < end; ++i)
     {
-        const Vector grid_point = grid_info.point(i);
+        const CLJVectorView grid_point = grid_info.point(i);
         
         const MultiFloat px(grid_point.x());
         const MultiFloat py(grid_point.y());
@@ -1966,6 +2366,9 @@ void CLJRFFunction::calcVacGrid(const CLJAtoms &atoms, const GridInfo &grid_info
             tmp = pz - z[j];
             r2.multiplyAdd(tmp, tmp);
 
+            //don't let the grid point get closer to the atom than
+            //clj_grid_min_distance, so that 1/r does not overflow
+            r2 = r2.max(min_r2);
             r = r2.sqrt();
 
             one_over_r = r.reciprocal();
@@ -1991,9 +2394,9 @@ void CLJRFFunction::calcVacGrid(const CLJAtoms &atoms, const GridInfo &grid_info
 }
 
 /** Calculate the energy on the grid from the passed atoms using vacuum boundary conditions */
-void CLJRFFunction::calcBoxGrid(const CLJAtoms &atoms, const GridInfo &grid_info,
-                                const Vector &box_dimensions,
-                                const int start, const int end, float *gridpot_array) const
+void RFKernel::calcBoxGrid(const CLJAtomsView &atoms, const CLJGridView &grid_info,
+                           const CLJVectorView &box_dimensions, const int start,
+                           const int end, float *gridpot_array) const
 {
     const MultiFloat* const x = atoms.x().constData();
     const MultiFloat* const y = atoms.y().constData();
@@ -2008,7 +2411,8 @@ void CLJRFFunction::calcBoxGrid(const CLJAtoms &atoms, const GridInfo &grid_info
     const MultiFloat c_rf( (1.0 / coul_cutoff ) * ( (3*dielectric()) /
                                                     (2*dielectric() + 1) ) );
 
-    const MultiInt dummy_id = CLJAtoms::idOfDummy();
+    const MultiFloat min_r2( clj_grid_min_distance*clj_grid_min_distance );
+    const MultiInt dummy_id = atoms.idOfDummy();
 
     const MultiFloat box_x( box_dimensions.x() );
     const MultiFloat box_y( box_dimensions.y() );
@@ -2024,7 +2428,7 @@ void CLJRFFunction::calcBoxGrid(const CLJAtoms &atoms, const GridInfo &grid_info
 
     for (int i = start; i < end; ++i)
     {
-        const Vector grid_point = grid_info.point(i);
+        const CLJVectorView grid_point = grid_info.point(i);
         
         const MultiFloat px(grid_point.x());
         const MultiFloat py(grid_point.y());
@@ -2050,6 +2454,9 @@ void CLJRFFunction::calcBoxGrid(const CLJAtoms &atoms, const GridInfo &grid_info
             tmp -= box_z.logicalAnd( half_box_z.compareLess(tmp) );
             r2.multiplyAdd(tmp, tmp);
 
+            //don't let the grid point get closer to the atom than
+            //clj_grid_min_distance, so that 1/r does not overflow
+            r2 = r2.max(min_r2);
             r = r2.sqrt();
 
             one_over_r = r.reciprocal();
@@ -2074,6 +2481,215 @@ void CLJRFFunction::calcBoxGrid(const CLJAtoms &atoms, const GridInfo &grid_info
     }
 }
 
+static void vacEnergyGeo(const CLJKernelParams &params, const CLJKernelAtoms &atoms,
+                         double &cnrg, double &ljnrg)
+{
+    RFKernel(params).calcVacEnergyGeo(atoms, cnrg, ljnrg);
+}
+
+static void vacEnergyGeo2(const CLJKernelParams &params, const CLJKernelAtoms &atoms0,
+                          const CLJKernelAtoms &atoms1, double &cnrg, double &ljnrg)
+{
+    RFKernel(params).calcVacEnergyGeo(atoms0, atoms1, cnrg, ljnrg);
+}
+
+static void boxEnergyGeo(const CLJKernelParams &params, const CLJKernelAtoms &atoms,
+                         const CLJKernelVector &box_dimensions, double &cnrg,
+                         double &ljnrg)
+{
+    RFKernel(params).calcBoxEnergyGeo(atoms, box_dimensions, cnrg, ljnrg);
+}
+
+static void boxEnergyGeo2(const CLJKernelParams &params, const CLJKernelAtoms &atoms0,
+                          const CLJKernelAtoms &atoms1,
+                          const CLJKernelVector &box_dimensions, double &cnrg,
+                          double &ljnrg)
+{
+    RFKernel(params).calcBoxEnergyGeo(atoms0, atoms1, box_dimensions, cnrg, ljnrg);
+}
+
+static void vacEnergyAri(const CLJKernelParams &params, const CLJKernelAtoms &atoms,
+                         double &cnrg, double &ljnrg)
+{
+    RFKernel(params).calcVacEnergyAri(atoms, cnrg, ljnrg);
+}
+
+static void vacEnergyAri2(const CLJKernelParams &params, const CLJKernelAtoms &atoms0,
+                          const CLJKernelAtoms &atoms1, double &cnrg, double &ljnrg)
+{
+    RFKernel(params).calcVacEnergyAri(atoms0, atoms1, cnrg, ljnrg);
+}
+
+static double vacCoulombEnergyAri(const CLJKernelParams &params,
+                                  const CLJKernelAtoms &atoms)
+{
+    return RFKernel(params).calcVacCoulombEnergyAri(atoms);
+}
+
+static double vacCoulombEnergyAri2(const CLJKernelParams &params,
+                                   const CLJKernelAtoms &atoms0,
+                                   const CLJKernelAtoms &atoms1)
+{
+    return RFKernel(params).calcVacCoulombEnergyAri(atoms0, atoms1);
+}
+
+static double vacLJEnergyAri(const CLJKernelParams &params, const CLJKernelAtoms &atoms)
+{
+    return RFKernel(params).calcVacLJEnergyAri(atoms);
+}
+
+static double vacLJEnergyAri2(const CLJKernelParams &params, const CLJKernelAtoms &atoms0,
+                              const CLJKernelAtoms &atoms1)
+{
+    return RFKernel(params).calcVacLJEnergyAri(atoms0, atoms1);
+}
+
+static void boxEnergyAri(const CLJKernelParams &params, const CLJKernelAtoms &atoms,
+                         const CLJKernelVector &box_dimensions, double &cnrg,
+                         double &ljnrg)
+{
+    RFKernel(params).calcBoxEnergyAri(atoms, box_dimensions, cnrg, ljnrg);
+}
+
+static void boxEnergyAri2(const CLJKernelParams &params, const CLJKernelAtoms &atoms0,
+                          const CLJKernelAtoms &atoms1,
+                          const CLJKernelVector &box_dimensions, double &cnrg,
+                          double &ljnrg)
+{
+    RFKernel(params).calcBoxEnergyAri(atoms0, atoms1, box_dimensions, cnrg, ljnrg);
+}
+
+static void vacGrid(const CLJKernelParams &params, const CLJKernelAtoms &atoms,
+                    const CLJKernelGrid &grid_info, int start, int end,
+                    float *gridpot_array)
+{
+    RFKernel(params).calcVacGrid(atoms, grid_info, start, end, gridpot_array);
+}
+
+static void boxGrid(const CLJKernelParams &params, const CLJKernelAtoms &atoms,
+                    const CLJKernelGrid &grid_info, const CLJKernelVector &box_dimensions,
+                    int start, int end, float *gridpot_array)
+{
+    RFKernel(params).calcBoxGrid(atoms, grid_info, box_dimensions, start, end,
+                                 gridpot_array);
+}
+
+/** Return the kernels of CLJRFFunction compiled for this instruction set */
+void getRFKernels(CLJFunctionKernels &kernels)
+{
+    kernels.vac_energy_geo = &vacEnergyGeo;
+    kernels.vac_energy_geo2 = &vacEnergyGeo2;
+    kernels.box_energy_geo = &boxEnergyGeo;
+    kernels.box_energy_geo2 = &boxEnergyGeo2;
+    kernels.vac_energy_ari = &vacEnergyAri;
+    kernels.vac_energy_ari2 = &vacEnergyAri2;
+    kernels.vac_coulomb_energy_ari = &vacCoulombEnergyAri;
+    kernels.vac_coulomb_energy_ari2 = &vacCoulombEnergyAri2;
+    kernels.vac_lj_energy_ari = &vacLJEnergyAri;
+    kernels.vac_lj_energy_ari2 = &vacLJEnergyAri2;
+    kernels.box_energy_ari = &boxEnergyAri;
+    kernels.box_energy_ari2 = &boxEnergyAri2;
+    kernels.vac_grid = &vacGrid;
+    kernels.box_grid = &boxGrid;
+}
+
+} // end of namespace SIRE_KERNEL_NAMESPACE
+} // end of namespace detail
+} // end of namespace SireMM
+
+#ifndef SIRE_KERNEL_ISA
+
+/** Return whether or not this function supports calculating forces */
+bool CLJRFFunction::supportsForceCalculation() const
+{
+    return true;
+}
+
+/** Calculate the coulomb and LJ forces between the passed atoms
+    in vacuum using arithmetic combining rules, adding them onto 'forces' */
+void CLJRFFunction::calcVacForceAri(const CLJAtoms &atoms, CLJForces &forces,
+                                    float scale_coul, float scale_lj) const
+{
+    const detail::RFForce func(coul_cutoff, lj_cutoff, dielectric(), scale_coul, scale_lj);
+    detail::cljForce<true,false>(func, atoms, forces, Vector());
+}
+
+/** Calculate the coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in vacuum using arithmetic combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJRFFunction::calcVacForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                    CLJForces &forces0, CLJForces &forces1,
+                                    float scale_coul, float scale_lj) const
+{
+    const detail::RFForce func(coul_cutoff, lj_cutoff, dielectric(), scale_coul, scale_lj);
+    detail::cljForce<true,false>(func, atoms0, atoms1, forces0, forces1,
+                                 Vector());
+}
+
+/** Calculate the coulomb and LJ forces between the passed atoms
+    in vacuum using geometric combining rules, adding them onto 'forces' */
+void CLJRFFunction::calcVacForceGeo(const CLJAtoms &atoms, CLJForces &forces,
+                                    float scale_coul, float scale_lj) const
+{
+    const detail::RFForce func(coul_cutoff, lj_cutoff, dielectric(), scale_coul, scale_lj);
+    detail::cljForce<false,false>(func, atoms, forces, Vector());
+}
+
+/** Calculate the coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in vacuum using geometric combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJRFFunction::calcVacForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                    CLJForces &forces0, CLJForces &forces1,
+                                    float scale_coul, float scale_lj) const
+{
+    const detail::RFForce func(coul_cutoff, lj_cutoff, dielectric(), scale_coul, scale_lj);
+    detail::cljForce<false,false>(func, atoms0, atoms1, forces0, forces1,
+                                  Vector());
+}
+
+/** Calculate the coulomb and LJ forces between the passed atoms
+    in a periodic box using arithmetic combining rules, adding them onto 'forces' */
+void CLJRFFunction::calcBoxForceAri(const CLJAtoms &atoms, const Vector &box_dimensions,
+                                    CLJForces &forces, float scale_coul, float scale_lj) const
+{
+    const detail::RFForce func(coul_cutoff, lj_cutoff, dielectric(), scale_coul, scale_lj);
+    detail::cljForce<true,true>(func, atoms, forces, box_dimensions);
+}
+
+/** Calculate the coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in a periodic box using arithmetic combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJRFFunction::calcBoxForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                    const Vector &box_dimensions,
+                                    CLJForces &forces0, CLJForces &forces1,
+                                    float scale_coul, float scale_lj) const
+{
+    const detail::RFForce func(coul_cutoff, lj_cutoff, dielectric(), scale_coul, scale_lj);
+    detail::cljForce<true,true>(func, atoms0, atoms1, forces0, forces1,
+                                box_dimensions);
+}
+
+/** Calculate the coulomb and LJ forces between the passed atoms
+    in a periodic box using geometric combining rules, adding them onto 'forces' */
+void CLJRFFunction::calcBoxForceGeo(const CLJAtoms &atoms, const Vector &box_dimensions,
+                                    CLJForces &forces, float scale_coul, float scale_lj) const
+{
+    const detail::RFForce func(coul_cutoff, lj_cutoff, dielectric(), scale_coul, scale_lj);
+    detail::cljForce<false,true>(func, atoms, forces, box_dimensions);
+}
+
+/** Calculate the coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in a periodic box using geometric combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJRFFunction::calcBoxForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                    const Vector &box_dimensions,
+                                    CLJForces &forces0, CLJForces &forces1,
+                                    float scale_coul, float scale_lj) const
+{
+    const detail::RFForce func(coul_cutoff, lj_cutoff, dielectric(), scale_coul, scale_lj);
+    detail::cljForce<false,true>(func, atoms0, atoms1, forces0, forces1,
+                                 box_dimensions);
+}
 
 /////////
 ///////// Implementation of CLJSoftRFFunction
@@ -4077,6 +4693,114 @@ void CLJSoftRFFunction::calcBoxEnergyAri(const CLJAtoms &atoms0, const CLJAtoms
     ljnrg = iljnrg.sum();
 }
 
+/** Return whether or not this function supports calculating forces */
+bool CLJSoftRFFunction::supportsForceCalculation() const
+{
+    return true;
+}
+
+/** Calculate the soft-core coulomb and LJ forces between the passed atoms
+    in vacuum using arithmetic combining rules, adding them onto 'forces' */
+void CLJSoftRFFunction::calcVacForceAri(const CLJAtoms &atoms, CLJForces &forces,
+                                        float scale_coul, float scale_lj) const
+{
+    const detail::SoftRFForce func(coul_cutoff, lj_cutoff, dielectric(),
+                                   alpha(), oneMinusAlphaToN(), alphaTimesShiftDelta(),
+                                   scale_coul, scale_lj);
+    detail::cljForce<true,false>(func, atoms, forces, Vector());
+}
+
+/** Calculate the soft-core coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in vacuum using arithmetic combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJSoftRFFunction::calcVacForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                        CLJForces &forces0, CLJForces &forces1,
+                                        float scale_coul, float scale_lj) const
+{
+    const detail::SoftRFForce func(coul_cutoff, lj_cutoff, dielectric(),
+                                   alpha(), oneMinusAlphaToN(), alphaTimesShiftDelta(),
+                                   scale_coul, scale_lj);
+    detail::cljForce<true,false>(func, atoms0, atoms1, forces0, forces1,
+                                 Vector());
+}
+
+/** Calculate the soft-core coulomb and LJ forces between the passed atoms
+    in vacuum using geometric combining rules, adding them onto 'forces' */
+void CLJSoftRFFunction::calcVacForceGeo(const CLJAtoms &atoms, CLJForces &forces,
+                                        float scale_coul, float scale_lj) const
+{
+    const detail::SoftRFForce func(coul_cutoff, lj_cutoff, dielectric(),
+                                   alpha(), oneMinusAlphaToN(), alphaTimesShiftDelta(),
+                                   scale_coul, scale_lj);
+    detail::cljForce<false,false>(func, atoms, forces, Vector());
+}
+
+/** Calculate the soft-core coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in vacuum using geometric combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJSoftRFFunction::calcVacForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                        CLJForces &forces0, CLJForces &forces1,
+                                        float scale_coul, float scale_lj) const
+{
+    const detail::SoftRFForce func(coul_cutoff, lj_cutoff, dielectric(),
+                                   alpha(), oneMinusAlphaToN(), alphaTimesShiftDelta(),
+                                   scale_coul, scale_lj);
+    detail::cljForce<false,false>(func, atoms0, atoms1, forces0, forces1,
+                                  Vector());
+}
+
+/** Calculate the soft-core coulomb and LJ forces between the passed atoms
+    in a periodic box using arithmetic combining rules, adding them onto 'forces' */
+void CLJSoftRFFunction::calcBoxForceAri(const CLJAtoms &atoms, const Vector &box_dimensions,
+                                        CLJForces &forces, float scale_coul, float scale_lj) const
+{
+    const detail::SoftRFForce func(coul_cutoff, lj_cutoff, dielectric(),
+                                   alpha(), oneMinusAlphaToN(), alphaTimesShiftDelta(),
+                                   scale_coul, scale_lj);
+    detail::cljForce<true,true>(func, atoms, forces, box_dimensions);
+}
+
+/** Calculate the soft-core coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in a periodic box using arithmetic combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJSoftRFFunction::calcBoxForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                        const Vector &box_dimensions,
+                                        CLJForces &forces0, CLJForces &forces1,
+                                        float scale_coul, float scale_lj) const
+{
+    const detail::SoftRFForce func(coul_cutoff, lj_cutoff, dielectric(),
+                                   alpha(), oneMinusAlphaToN(), alphaTimesShiftDelta(),
+                                   scale_coul, scale_lj);
+    detail::cljForce<true,true>(func, atoms0, atoms1, forces0, forces1,
+                                box_dimensions);
+}
+
+/** Calculate the soft-core coulomb and LJ forces between the passed atoms
+    in a periodic box using geometric combining rules, adding them onto 'forces' */
+void CLJSoftRFFunction::calcBoxForceGeo(const CLJAtoms &atoms, const Vector &box_dimensions,
+                                        CLJForces &forces, float scale_coul, float scale_lj) const
+{
+    const detail::SoftRFForce func(coul_cutoff, lj_cutoff, dielectric(),
+                                   alpha(), oneMinusAlphaToN(), alphaTimesShiftDelta(),
+                                   scale_coul, scale_lj);
+    detail::cljForce<false,true>(func, atoms, forces, box_dimensions);
+}
+
+/** Calculate the soft-core coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in a periodic box using geometric combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJSoftRFFunction::calcBoxForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                        const Vector &box_dimensions,
+                                        CLJForces &forces0, CLJForces &forces1,
+                                        float scale_coul, float scale_lj) const
+{
+    const detail::SoftRFForce func(coul_cutoff, lj_cutoff, dielectric(),
+                                   alpha(), oneMinusAlphaToN(), alphaTimesShiftDelta(),
+                                   scale_coul, scale_lj);
+    detail::cljForce<false,true>(func, atoms0, atoms1, forces0, forces1,
+                                 box_dimensions);
+}
+
 /////////
 ///////// Implementation of CLJIntraRFFunction
 /////////
@@ -4320,7 +5044,7 @@ void CLJIntraRFFunction::calcVacEnergyGeo(const CLJAtoms &atoms,
                 const MultiFloat sig( siga[i][ii] );
                 const MultiFloat eps( epsa[i][ii] );
 
-                const bool *row = bondMatrix().constData()[id[0]].constData();
+                const detail::CLJExclusions::Row row = exclusions().row(id[0]);
 
                 for (int j=i; j<n; ++j)
                 {
@@ -4329,10 +5053,7 @@ void CLJIntraRFFunction::calcVacEnergyGeo(const CLJAtoms &atoms,
                     MultiFloat scale( i == j ? 0.5 : 1.0 );
                 
                     //get the bond mask to screen out bonded interactions
-                    for (int k=0; k<MultiFloat::count(); ++k)
-                    {
-                        bond_mask.quickSet(k, row[ida[j][k]] ? 0.0 : 1.0);
-                    }
+                    bond_mask = row.mask(ida[j]);
                 
                     scale *= bond_mask;
                 
@@ -4528,15 +5249,12 @@ void CLJIntraRFFunction::calcVacEnergyGeo(const CLJAtoms &atoms0, const CLJAtoms
                     const MultiFloat sig(sig0[i][ii]);
                     const MultiFloat eps(eps0[i][ii]);
 
-                    const bool *row = bondMatrix().constData()[id[0]].constData();
+                    const detail::CLJExclusions::Row row = exclusions().row(id[0]);
 
                     for (int j=0; j<n1; ++j)
                     {
                         //create a mask to cancel out calculations of bonded pairs
-                        for (int k=0; k<MultiInt::count(); ++k)
-                        {
-                            bonded_mask.quickSet(k, row[id1[j][k]] ? 0.0 : 1.0);
-                        }
+                        bonded_mask = row.mask(id1[j]);
 
                         //calculate the distance between the fixed and mobile atoms
                         tmp = x1[j] - x;
@@ -4648,7 +5366,7 @@ void CLJIntraRFFunction::calcBoxEnergyGeo(const CLJAtoms &atoms, const Vector &b
                 const MultiFloat sig( siga[i][ii] );
                 const MultiFloat eps( epsa[i][ii] );
 
-                const bool *row = bondMatrix().constData()[id[0]].constData();
+                const detail::CLJExclusions::Row row = exclusions().row(id[0]);
 
                 for (int j=i; j<n; ++j)
                 {
@@ -4657,10 +5375,7 @@ void CLJIntraRFFunction::calcBoxEnergyGeo(const CLJAtoms &atoms, const Vector &b
                     MultiFloat scale( i == j ? 0.5 : 1.0 );
                 
                     //get the bond mask to screen out bonded interactions
-                    for (int k=0; k<MultiFloat::count(); ++k)
-                    {
-                        bond_mask.quickSet(k, row[ida[j][k]] ? 0.0 : 1.0);
-                    }
+                    bond_mask = row.mask(ida[j]);
                 
                     scale *= bond_mask;
                 
@@ -4883,15 +5598,12 @@ void CLJIntraRFFunction::calcBoxEnergyGeo(const CLJAtoms &atoms0, const CLJAtoms
                     const MultiFloat sig(sig0[i][ii]);
                     const MultiFloat eps(eps0[i][ii]);
 
-                    const bool *row = bondMatrix().constData()[id[0]].constData();
+                    const detail::CLJExclusions::Row row = exclusions().row(id[0]);
 
                     for (int j=0; j<n1; ++j)
                     {
                         //create a mask to cancel out calculations of bonded pairs
-                        for (int k=0; k<MultiInt::count(); ++k)
-                        {
-                            bonded_mask.quickSet(k, row[id1[j][k]] ? 0.0 : 1.0);
-                        }
+                        bonded_mask = row.mask(id1[j]);
 
                         //calculate the distance between the fixed and mobile atoms
                         tmp = x1[j] - x;
@@ -5003,7 +5715,7 @@ void CLJIntraRFFunction::calcVacEnergyAri(const CLJAtoms &atoms,
                 const MultiFloat sig( siga[i][ii] * siga[i][ii] );
                 const MultiFloat eps( epsa[i][ii] );
 
-                const bool *row = bondMatrix().constData()[id[0]].constData();
+                const detail::CLJExclusions::Row row = exclusions().row(id[0]);
 
                 for (int j=i; j<n; ++j)
                 {
@@ -5012,10 +5724,7 @@ void CLJIntraRFFunction::calcVacEnergyAri(const CLJAtoms &atoms,
                     MultiFloat scale( i == j ? 0.5 : 1.0 );
                 
                     //get the bond mask to screen out bonded interactions
-                    for (int k=0; k<MultiFloat::count(); ++k)
-                    {
-                        bond_mask.quickSet(k, row[ida[j][k]] ? 0.0 : 1.0);
-                    }
+                    bond_mask = row.mask(ida[j]);
                 
                     scale *= bond_mask;
                 
@@ -5218,15 +5927,12 @@ void CLJIntraRFFunction::calcVacEnergyAri(const CLJAtoms &atoms0, const CLJAtoms
                     const MultiFloat sig(sig0[i][ii] * sig0[i][ii]);
                     const MultiFloat eps(eps0[i][ii]);
 
-                    const bool *row = bondMatrix().constData()[id[0]].constData();
+                    const detail::CLJExclusions::Row row = exclusions().row(id[0]);
 
                     for (int j=0; j<n1; ++j)
                     {
                         //create a mask to cancel out calculations of bonded pairs
-                        for (int k=0; k<MultiInt::count(); ++k)
-                        {
-                            bonded_mask.quickSet(k, row[id1[j][k]] ? 0.0 : 1.0);
-                        }
+                        bonded_mask = row.mask(id1[j]);
 
                         //calculate the distance between the fixed and mobile atoms
                         tmp = x1[j] - x;
@@ -5343,7 +6049,7 @@ void CLJIntraRFFunction::calcBoxEnergyAri(const CLJAtoms &atoms, const Vector &b
                 const MultiFloat sig( siga[i][ii] * siga[i][ii] );
                 const MultiFloat eps( epsa[i][ii] );
 
-                const bool *row = bondMatrix().constData()[id[0]].constData();
+                const detail::CLJExclusions::Row row = exclusions().row(id[0]);
 
                 for (int j=i; j<n; ++j)
                 {
@@ -5352,10 +6058,7 @@ void CLJIntraRFFunction::calcBoxEnergyAri(const CLJAtoms &atoms, const Vector &b
                     MultiFloat scale( i == j ? 0.5 : 1.0 );
                 
                     //get the bond mask to screen out bonded interactions
-                    for (int k=0; k<MultiFloat::count(); ++k)
-                    {
-                        bond_mask.quickSet(k, row[ida[j][k]] ? 0.0 : 1.0);
-                    }
+                    bond_mask = row.mask(ida[j]);
                 
                     scale *= bond_mask;
                 
@@ -5586,15 +6289,12 @@ void CLJIntraRFFunction::calcBoxEnergyAri(const CLJAtoms &atoms0, const CLJAtoms
                     const MultiFloat sig(sig0[i][ii] * sig0[i][ii]);
                     const MultiFloat eps(eps0[i][ii]);
 
-                    const bool *row = bondMatrix().constData()[id[0]].constData();
+                    const detail::CLJExclusions::Row row = exclusions().row(id[0]);
 
                     for (int j=0; j<n1; ++j)
                     {
                         //create a mask to cancel out calculations of bonded pairs
-                        for (int k=0; k<MultiInt::count(); ++k)
-                        {
-                            bonded_mask.quickSet(k, row[id1[j][k]] ? 0.0 : 1.0);
-                        }
+                        bonded_mask = row.mask(id1[j]);
 
                         //calculate the distance between the fixed and mobile atoms
                         tmp = x1[j] - x;
@@ -5664,6 +6364,98 @@ void CLJIntraRFFunction::calcBoxEnergyAri(const CLJAtoms &atoms0, const CLJAtoms
     ljnrg = iljnrg.sum();
 }
 
+/** Return whether or not this function supports calculating forces */
+bool CLJIntraRFFunction::supportsForceCalculation() const
+{
+    return true;
+}
+
+/** Calculate the intramolecular coulomb and LJ forces between the passed atoms
+    in vacuum using arithmetic combining rules, adding them onto 'forces' */
+void CLJIntraRFFunction::calcVacForceAri(const CLJAtoms &atoms, CLJForces &forces,
+                                         float scale_coul, float scale_lj) const
+{
+    const detail::RFForce func(coul_cutoff, lj_cutoff, dielectric(), scale_coul, scale_lj);
+    detail::cljForce<true,false>(func, atoms, forces, Vector(), &(exclusions()));
+}
+
+/** Calculate the intramolecular coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in vacuum using arithmetic combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJIntraRFFunction::calcVacForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                         CLJForces &forces0, CLJForces &forces1,
+                                         float scale_coul, float scale_lj) const
+{
+    const detail::RFForce func(coul_cutoff, lj_cutoff, dielectric(), scale_coul, scale_lj);
+    detail::cljForce<true,false>(func, atoms0, atoms1, forces0, forces1,
+                                 Vector(), &(exclusions()));
+}
+
+/** Calculate the intramolecular coulomb and LJ forces between the passed atoms
+    in vacuum using geometric combining rules, adding them onto 'forces' */
+void CLJIntraRFFunction::calcVacForceGeo(const CLJAtoms &atoms, CLJForces &forces,
+                                         float scale_coul, float scale_lj) const
+{
+    const detail::RFForce func(coul_cutoff, lj_cutoff, dielectric(), scale_coul, scale_lj);
+    detail::cljForce<false,false>(func, atoms, forces, Vector(), &(exclusions()));
+}
+
+/** Calculate the intramolecular coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in vacuum using geometric combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJIntraRFFunction::calcVacForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                         CLJForces &forces0, CLJForces &forces1,
+                                         float scale_coul, float scale_lj) const
+{
+    const detail::RFForce func(coul_cutoff, lj_cutoff, dielectric(), scale_coul, scale_lj);
+    detail::cljForce<false,false>(func, atoms0, atoms1, forces0, forces1,
+                                  Vector(), &(exclusions()));
+}
+
+/** Calculate the intramolecular coulomb and LJ forces between the passed atoms
+    in a periodic box using arithmetic combining rules, adding them onto 'forces' */
+void CLJIntraRFFunction::calcBoxForceAri(const CLJAtoms &atoms, const Vector &box_dimensions,
+                                         CLJForces &forces, float scale_coul, float scale_lj) const
+{
+    const detail::RFForce func(coul_cutoff, lj_cutoff, dielectric(), scale_coul, scale_lj);
+    detail::cljForce<true,true>(func, atoms, forces, box_dimensions, &(exclusions()));
+}
+
+/** Calculate the intramolecular coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in a periodic box using arithmetic combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJIntraRFFunction::calcBoxForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                         const Vector &box_dimensions,
+                                         CLJForces &forces0, CLJForces &forces1,
+                                         float scale_coul, float scale_lj) const
+{
+    const detail::RFForce func(coul_cutoff, lj_cutoff, dielectric(), scale_coul, scale_lj);
+    detail::cljForce<true,true>(func, atoms0, atoms1, forces0, forces1,
+                                box_dimensions, &(exclusions()));
+}
+
+/** Calculate the intramolecular coulomb and LJ forces between the passed atoms
+    in a periodic box using geometric combining rules, adding them onto 'forces' */
+void CLJIntraRFFunction::calcBoxForceGeo(const CLJAtoms &atoms, const Vector &box_dimensions,
+                                         CLJForces &forces, float scale_coul, float scale_lj) const
+{
+    const detail::RFForce func(coul_cutoff, lj_cutoff, dielectric(), scale_coul, scale_lj);
+    detail::cljForce<false,true>(func, atoms, forces, box_dimensions, &(exclusions()));
+}
+
+/** Calculate the intramolecular coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in a periodic box using geometric combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJIntraRFFunction::calcBoxForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                         const Vector &box_dimensions,
+                                         CLJForces &forces0, CLJForces &forces1,
+                                         float scale_coul, float scale_lj) const
+{
+    const detail::RFForce func(coul_cutoff, lj_cutoff, dielectric(), scale_coul, scale_lj);
+    detail::cljForce<false,true>(func, atoms0, atoms1, forces0, forces1,
+                                 box_dimensions, &(exclusions()));
+}
+
 /////////
 ///////// Implementation of CLJSoftIntraRFFunction
 /////////
@@ -5918,7 +6710,7 @@ void CLJSoftIntraRFFunction::calcVacEnergyGeo(const CLJAtoms &atoms,
                 const MultiFloat sig( siga[i][ii] );
                 const MultiFloat eps( epsa[i][ii] );
 
-                const bool *row = bondMatrix().constData()[id[0]].constData();
+                const detail::CLJExclusions::Row row = exclusions().row(id[0]);
 
                 for (int j=i; j<n; ++j)
                 {
@@ -5927,10 +6719,7 @@ void CLJSoftIntraRFFunction::calcVacEnergyGeo(const CLJAtoms &atoms,
                     MultiFloat scale( i == j ? 0.5 : 1.0 );
                 
                     //get the bond mask to screen out bonded interactions
-                    for (int k=0; k<MultiFloat::count(); ++k)
-                    {
-                        bond_mask.quickSet(k, row[ida[j][k]] ? 0.0 : 1.0);
-                    }
+                    bond_mask = row.mask(ida[j]);
                 
                     scale *= bond_mask;
                 
@@ -6144,15 +6933,12 @@ void CLJSoftIntraRFFunction::calcVacEnergyGeo(const CLJAtoms &atoms0, const CLJA
                     const MultiFloat sig(sig0[i][ii]);
                     const MultiFloat eps(eps0[i][ii]);
 
-                    const bool *row = bondMatrix().constData()[id[0]].constData();
+                    const detail::CLJExclusions::Row row = exclusions().row(id[0]);
 
                     for (int j=0; j<n1; ++j)
                     {
                         //create a mask to cancel out calculations of bonded pairs
-                        for (int k=0; k<MultiInt::count(); ++k)
-                        {
-                            bonded_mask.quickSet(k, row[id1[j][k]] ? 0.0 : 1.0);
-                        }
+                        bonded_mask = row.mask(id1[j]);
 
                         //calculate the distance^2 between the fixed and mobile atoms
                         tmp = x1[j] - x;
@@ -6279,7 +7065,7 @@ void CLJSoftIntraRFFunction::calcBoxEnergyGeo(const CLJAtoms &atoms,
                 const MultiFloat sig( siga[i][ii] );
                 const MultiFloat eps( epsa[i][ii] );
 
-                const bool *row = bondMatrix().constData()[id[0]].constData();
+                const detail::CLJExclusions::Row row = exclusions().row(id[0]);
 
                 for (int j=i; j<n; ++j)
                 {
@@ -6288,10 +7074,7 @@ void CLJSoftIntraRFFunction::calcBoxEnergyGeo(const CLJAtoms &atoms,
                     MultiFloat scale( i == j ? 0.5 : 1.0 );
                 
                     //get the bond mask to screen out bonded interactions
-                    for (int k=0; k<MultiFloat::count(); ++k)
-                    {
-                        bond_mask.quickSet(k, row[ida[j][k]] ? 0.0 : 1.0);
-                    }
+                    bond_mask = row.mask(ida[j]);
                 
                     scale *= bond_mask;
                 
@@ -6531,15 +7314,12 @@ void CLJSoftIntraRFFunction::calcBoxEnergyGeo(const CLJAtoms &atoms0, const CLJA
                     const MultiFloat sig(sig0[i][ii]);
                     const MultiFloat eps(eps0[i][ii]);
 
-                    const bool *row = bondMatrix().constData()[id[0]].constData();
+                    const detail::CLJExclusions::Row row = exclusions().row(id[0]);
 
                     for (int j=0; j<n1; ++j)
                     {
                         //create a mask to cancel out calculations of bonded pairs
-                        for (int k=0; k<MultiInt::count(); ++k)
-                        {
-                            bonded_mask.quickSet(k, row[id1[j][k]] ? 0.0 : 1.0);
-                        }
+                        bonded_mask = row.mask(id1[j]);
 
                         //calculate the distance^2
                         tmp = x1[j] - x;
@@ -6665,7 +7445,7 @@ void CLJSoftIntraRFFunction::calcVacEnergyAri(const CLJAtoms &atoms,
                 const MultiFloat sig( siga[i][ii] * siga[i][ii] );
                 const MultiFloat eps( epsa[i][ii] );
 
-                const bool *row = bondMatrix().constData()[id[0]].constData();
+                const detail::CLJExclusions::Row row = exclusions().row(id[0]);
 
                 for (int j=i; j<n; ++j)
                 {
@@ -6674,10 +7454,7 @@ void CLJSoftIntraRFFunction::calcVacEnergyAri(const CLJAtoms &atoms,
                     MultiFloat scale( i == j ? 0.5 : 1.0 );
                 
                     //get the bond mask to screen out bonded interactions
-                    for (int k=0; k<MultiFloat::count(); ++k)
-                    {
-                        bond_mask.quickSet(k, row[ida[j][k]] ? 0.0 : 1.0);
-                    }
+                    bond_mask = row.mask(ida[j]);
                 
                     scale *= bond_mask;
                 
@@ -6891,15 +7668,12 @@ void CLJSoftIntraRFFunction::calcVacEnergyAri(const CLJAtoms &atoms0, const CLJA
                     const MultiFloat sig(sig0[i][ii]*sig0[i][ii]);
                     const MultiFloat eps(eps0[i][ii]);
 
-                    const bool *row = bondMatrix().constData()[id[0]].constData();
+                    const detail::CLJExclusions::Row row = exclusions().row(id[0]);
 
                     for (int j=0; j<n1; ++j)
                     {
                         //create a mask to cancel out calculations of bonded pairs
-                        for (int k=0; k<MultiInt::count(); ++k)
-                        {
-                            bonded_mask.quickSet(k, row[id1[j][k]] ? 0.0 : 1.0);
-                        }
+                        bonded_mask = row.mask(id1[j]);
 
                         //calculate the distance^2 between the fixed and mobile atoms
                         tmp = x1[j] - x;
@@ -7026,7 +7800,7 @@ void CLJSoftIntraRFFunction::calcBoxEnergyAri(const CLJAtoms &atoms,
                 const MultiFloat sig( siga[i][ii]*siga[i][ii] );
                 const MultiFloat eps( epsa[i][ii] );
 
-                const bool *row = bondMatrix().constData()[id[0]].constData();
+                const detail::CLJExclusions::Row row = exclusions().row(id[0]);
 
                 for (int j=i; j<n; ++j)
                 {
@@ -7035,10 +7809,7 @@ void CLJSoftIntraRFFunction::calcBoxEnergyAri(const CLJAtoms &atoms,
                     MultiFloat scale( i == j ? 0.5 : 1.0 );
                 
                     //get the bond mask to screen out bonded interactions
-                    for (int k=0; k<MultiFloat::count(); ++k)
-                    {
-                        bond_mask.quickSet(k, row[ida[j][k]] ? 0.0 : 1.0);
-                    }
+                    bond_mask = row.mask(ida[j]);
                 
                     scale *= bond_mask;
                 
@@ -7278,15 +8049,12 @@ void CLJSoftIntraRFFunction::calcBoxEnergyAri(const CLJAtoms &atoms0, const CLJA
                     const MultiFloat sig(sig0[i][ii]*sig0[i][ii]);
                     const MultiFloat eps(eps0[i][ii]);
 
-                    const bool *row = bondMatrix().constData()[id[0]].constData();
+                    const detail::CLJExclusions::Row row = exclusions().row(id[0]);
 
                     for (int j=0; j<n1; ++j)
                     {
                         //create a mask to cancel out calculations of bonded pairs
-                        for (int k=0; k<MultiInt::count(); ++k)
-                        {
-                            bonded_mask.quickSet(k, row[id1[j][k]] ? 0.0 : 1.0);
-                        }
+                        bonded_mask = row.mask(id1[j]);
 
                         //calculate the distance^2
                         tmp = x1[j] - x;
@@ -7355,3 +8123,113 @@ void CLJSoftIntraRFFunction::calcBoxEnergyAri(const CLJAtoms &atoms0, const CLJA
     cnrg = icnrg.sum();
     ljnrg = iljnrg.sum();
 }
+
+/** Return whether or not this function supports calculating forces */
+bool CLJSoftIntraRFFunction::supportsForceCalculation() const
+{
+    return true;
+}
+
+/** Calculate the intramolecular soft-core coulomb and LJ forces between the passed atoms
+    in vacuum using arithmetic combining rules, adding them onto 'forces' */
+void CLJSoftIntraRFFunction::calcVacForceAri(const CLJAtoms &atoms, CLJForces &forces,
+                                             float scale_coul, float scale_lj) const
+{
+    const detail::SoftRFForce func(coul_cutoff, lj_cutoff, dielectric(),
+                                   alpha(), oneMinusAlphaToN(), alphaTimesShiftDelta(),
+                                   scale_coul, scale_lj);
+    detail::cljForce<true,false>(func, atoms, forces, Vector(), &(exclusions()));
+}
+
+/** Calculate the intramolecular soft-core coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in vacuum using arithmetic combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJSoftIntraRFFunction::calcVacForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                             CLJForces &forces0, CLJForces &forces1,
+                                             float scale_coul, float scale_lj) const
+{
+    const detail::SoftRFForce func(coul_cutoff, lj_cutoff, dielectric(),
+                                   alpha(), oneMinusAlphaToN(), alphaTimesShiftDelta(),
+                                   scale_coul, scale_lj);
+    detail::cljForce<true,false>(func, atoms0, atoms1, forces0, forces1,
+                                 Vector(), &(exclusions()));
+}
+
+/** Calculate the intramolecular soft-core coulomb and LJ forces between the passed atoms
+    in vacuum using geometric combining rules, adding them onto 'forces' */
+void CLJSoftIntraRFFunction::calcVacForceGeo(const CLJAtoms &atoms, CLJForces &forces,
+                                             float scale_coul, float scale_lj) const
+{
+    const detail::SoftRFForce func(coul_cutoff, lj_cutoff, dielectric(),
+                                   alpha(), oneMinusAlphaToN(), alphaTimesShiftDelta(),
+                                   scale_coul, scale_lj);
+    detail::cljForce<false,false>(func, atoms, forces, Vector(), &(exclusions()));
+}
+
+/** Calculate the intramolecular soft-core coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in vacuum using geometric combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJSoftIntraRFFunction::calcVacForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                             CLJForces &forces0, CLJForces &forces1,
+                                             float scale_coul, float scale_lj) const
+{
+    const detail::SoftRFForce func(coul_cutoff, lj_cutoff, dielectric(),
+                                   alpha(), oneMinusAlphaToN(), alphaTimesShiftDelta(),
+                                   scale_coul, scale_lj);
+    detail::cljForce<false,false>(func, atoms0, atoms1, forces0, forces1,
+                                  Vector(), &(exclusions()));
+}
+
+/** Calculate the intramolecular soft-core coulomb and LJ forces between the passed atoms
+    in a periodic box using arithmetic combining rules, adding them onto 'forces' */
+void CLJSoftIntraRFFunction::calcBoxForceAri(const CLJAtoms &atoms, const Vector &box_dimensions,
+                                             CLJForces &forces, float scale_coul, float scale_lj) const
+{
+    const detail::SoftRFForce func(coul_cutoff, lj_cutoff, dielectric(),
+                                   alpha(), oneMinusAlphaToN(), alphaTimesShiftDelta(),
+                                   scale_coul, scale_lj);
+    detail::cljForce<true,true>(func, atoms, forces, box_dimensions, &(exclusions()));
+}
+
+/** Calculate the intramolecular soft-core coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in a periodic box using arithmetic combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJSoftIntraRFFunction::calcBoxForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                             const Vector &box_dimensions,
+                                             CLJForces &forces0, CLJForces &forces1,
+                                             float scale_coul, float scale_lj) const
+{
+    const detail::SoftRFForce func(coul_cutoff, lj_cutoff, dielectric(),
+                                   alpha(), oneMinusAlphaToN(), alphaTimesShiftDelta(),
+                                   scale_coul, scale_lj);
+    detail::cljForce<true,true>(func, atoms0, atoms1, forces0, forces1,
+                                box_dimensions, &(exclusions()));
+}
+
+/** Calculate the intramolecular soft-core coulomb and LJ forces between the passed atoms
+    in a periodic box using geometric combining rules, adding them onto 'forces' */
+void CLJSoftIntraRFFunction::calcBoxForceGeo(const CLJAtoms &atoms, const Vector &box_dimensions,
+                                             CLJForces &forces, float scale_coul, float scale_lj) const
+{
+    const detail::SoftRFForce func(coul_cutoff, lj_cutoff, dielectric(),
+                                   alpha(), oneMinusAlphaToN(), alphaTimesShiftDelta(),
+                                   scale_coul, scale_lj);
+    detail::cljForce<false,true>(func, atoms, forces, box_dimensions, &(exclusions()));
+}
+
+/** Calculate the intramolecular soft-core coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in a periodic box using geometric combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJSoftIntraRFFunction::calcBoxForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                             const Vector &box_dimensions,
+                                             CLJForces &forces0, CLJForces &forces1,
+                                             float scale_coul, float scale_lj) const
+{
+    const detail::SoftRFForce func(coul_cutoff, lj_cutoff, dielectric(),
+                                   alpha(), oneMinusAlphaToN(), alphaTimesShiftDelta(),
+                                   scale_coul, scale_lj);
+    detail::cljForce<false,true>(func, atoms0, atoms1, forces0, forces1,
+                                 box_dimensions, &(exclusions()));
+}
+
+#endif // #ifndef SIRE_KERNEL_ISA
@@ -100,6 +100,8 @@ public:
     
     CLJRFFunction* clone() const;
 
+    bool supportsForceCalculation() const;
+
     Properties properties() const;
     CLJFunctionPtr setProperty(const QString &name, const Property &value) const;
     PropertyPtr property(const QString &name) const;
@@ -154,6 +156,32 @@ protected:
                      const Vector &box_dimensions,
                      const int start, const int end, float *gridpot) const;
 
+    void calcVacForceAri(const CLJAtoms &atoms, CLJForces &forces,
+                         float scale_coul, float scale_lj) const;
+    void calcVacForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
+
+    void calcVacForceGeo(const CLJAtoms &atoms, CLJForces &forces,
+                         float scale_coul, float scale_lj) const;
+    void calcVacForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
+
+    void calcBoxForceAri(const CLJAtoms &atoms, const Vector &box_dimensions,
+                         CLJForces &forces, float scale_coul, float scale_lj) const;
+    void calcBoxForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         const Vector &box_dimensions,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
+
+    void calcBoxForceGeo(const CLJAtoms &atoms, const Vector &box_dimensions,
+                         CLJForces &forces, float scale_coul, float scale_lj) const;
+    void calcBoxForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         const Vector &box_dimensions,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
+
 private:
     /** The dielectric constant */
     float diel;
@@ -201,6 +229,8 @@ public:
     
     CLJIntraRFFunction* clone() const;
 
+    bool supportsForceCalculation() const;
+
     Properties properties() const;
     CLJFunctionPtr setProperty(const QString &name, const Property &value) const;
     PropertyPtr property(const QString &name) const;
@@ -238,6 +268,32 @@ protected:
                           const Vector &box_dimensions, double &cnrg, double &ljnrg,
                           float min_distance) const;
 
+    void calcVacForceAri(const CLJAtoms &atoms, CLJForces &forces,
+                         float scale_coul, float scale_lj) const;
+    void calcVacForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
+
+    void calcVacForceGeo(const CLJAtoms &atoms, CLJForces &forces,
+                         float scale_coul, float scale_lj) const;
+    void calcVacForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
+
+    void calcBoxForceAri(const CLJAtoms &atoms, const Vector &box_dimensions,
+                         CLJForces &forces, float scale_coul, float scale_lj) const;
+    void calcBoxForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         const Vector &box_dimensions,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
+
+    void calcBoxForceGeo(const CLJAtoms &atoms, const Vector &box_dimensions,
+                         CLJForces &forces, float scale_coul, float scale_lj) const;
+    void calcBoxForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         const Vector &box_dimensions,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
+
 private:
     /** The dielectric constant */
     float diel;
@@ -289,6 +345,8 @@ public:
     
     CLJSoftRFFunction* clone() const;
 
+    bool supportsForceCalculation() const;
+
     Properties properties() const;
     CLJFunctionPtr setProperty(const QString &name, const Property &value) const;
     PropertyPtr property(const QString &name) const;
@@ -326,6 +384,32 @@ protected:
                           const Vector &box_dimensions, double &cnrg, double &ljnrg,
                           float min_distance) const;
 
+    void calcVacForceAri(const CLJAtoms &atoms, CLJForces &forces,
+                         float scale_coul, float scale_lj) const;
+    void calcVacForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
+
+    void calcVacForceGeo(const CLJAtoms &atoms, CLJForces &forces,
+                         float scale_coul, float scale_lj) const;
+    void calcVacForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
+
+    void calcBoxForceAri(const CLJAtoms &atoms, const Vector &box_dimensions,
+                         CLJForces &forces, float scale_coul, float scale_lj) const;
+    void calcBoxForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         const Vector &box_dimensions,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
+
+    void calcBoxForceGeo(const CLJAtoms &atoms, const Vector &box_dimensions,
+                         CLJForces &forces, float scale_coul, float scale_lj) const;
+    void calcBoxForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         const Vector &box_dimensions,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
+
 private:
     /** The dielectric constant */
     float diel;
@@ -375,6 +459,8 @@ public:
     
     CLJSoftIntraRFFunction* clone() const;
 
+    bool supportsForceCalculation() const;
+
     Properties properties() const;
     CLJFunctionPtr setProperty(const QString &name, const Property &value) const;
     PropertyPtr property(const QString &name) const;
@@ -412,6 +498,32 @@ protected:
                           const Vector &box_dimensions, double &cnrg, double &ljnrg,
                           float min_distance) const;
 
+    void calcVacForceAri(const CLJAtoms &atoms, CLJForces &forces,
+                         float scale_coul, float scale_lj) const;
+    void calcVacForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
+
+    void calcVacForceGeo(const CLJAtoms &atoms, CLJForces &forces,
+                         float scale_coul, float scale_lj) const;
+    void calcVacForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
+
+    void calcBoxForceAri(const CLJAtoms &atoms, const Vector &box_dimensions,
+                         CLJForces &forces, float scale_coul, float scale_lj) const;
+    void calcBoxForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         const Vector &box_dimensions,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
+
+    void calcBoxForceGeo(const CLJAtoms &atoms, const Vector &box_dimensions,
+                         CLJForces &forces, float scale_coul, float scale_lj) const;
+    void calcBoxForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         const Vector &box_dimensions,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
+
 private:
     /** The dielectric constant */
     float diel;
@@ -26,12 +26,19 @@
   *
 \*********************************************/
 
-#include "cljshiftfunction.h"
-
 #include "SireMaths/multifloat.h"
 #include "SireMaths/multidouble.h"
 #include "SireMaths/multiint.h"
 
+#include "detail/cljkernelviews.hpp"
+
+// Only the vectorised kernels of CLJShiftFunction are compiled for each
+// instruction set (see detail/cljkernels.h). Everything else is
+// compiled once, for the baseline instruction set
+#ifndef SIRE_KERNEL_ISA
+
+#include "cljshiftfunction.h"
+
 #include "SireUnits/units.h"
 
 #include "SireError/errors.h"
@@ -41,6 +48,8 @@
 
 #include "SireVol/gridinfo.h"
 
+#include "detail/cljforcekernel.hpp"
+
 #include <QElapsedTimer>
 #include <QDebug>
 
@@ -51,10 +60,171 @@ using namespace SireBase;
 using namespace SireUnits;
 using namespace SireStream;
 
+namespace SireMM
+{
+    namespace detail
+    {
+        /** Functional form used by detail::cljForceKernel to calculate the 
+            forces for the shifted electrostatics and cutoff LJ functions */
+        class ShiftForce
+        {
+        public:
+            ShiftForce(float coul_cutoff, float lj_cutoff,
+                       float scale_coul, float scale_lj)
+                 : Rc(coul_cutoff), Rlj2(lj_cutoff*lj_cutoff),
+                   one_over_Rc2( 1.0 / (coul_cutoff*coul_cutoff) ),
+                   scl_coul(scale_coul), scl_lj(scale_lj),
+                   calc_coul(scale_coul != 0), calc_lj(scale_lj != 0)
+            {}
+            
+            bool hasCoulomb() const
+            {
+                return calc_coul;
+            }
+            
+            bool hasLJ() const
+            {
+                return calc_lj;
+            }
+            
+            /** E = q0q1 * { 1/r - 1/Rc + 1/Rc^2 [r - Rc] }, so
+                -(dE/dr) / r = q0q1 * { 1/r^2 - 1/Rc^2 } / r */
+            MultiFloat coulomb(const MultiFloat &r2, const MultiFloat &q0q1) const
+            {
+                const MultiFloat r = r2.sqrt();
+                const MultiFloat one_over_r = r.reciprocal();
+                
+                MultiFloat tmp = one_over_r * one_over_r;
+                tmp -= one_over_Rc2;
+                tmp *= one_over_r;
+                tmp *= q0q1 * scl_coul;
+                
+                tmp &= r.compareLess(Rc);
+                
+                return tmp;
+            }
+            
+            /** E = eps * { (sig/r)^12 - (sig/r)^6 }, so
+                -(dE/dr) / r = eps * { 12 (sig/r)^12 - 6 (sig/r)^6 } / r^2 */
+            MultiFloat lj(const MultiFloat &r2, const MultiFloat &sigma,
+                          const MultiFloat &eps) const
+            {
+                const MultiFloat one_over_r2 = r2.reciprocal();
+                
+                MultiFloat sig6_over_r6 = sigma * sigma * one_over_r2;
+                sig6_over_r6 = sig6_over_r6 * sig6_over_r6 * sig6_over_r6;
+                
+                MultiFloat tmp = MultiFloat(12) * sig6_over_r6 * sig6_over_r6;
+                tmp -= MultiFloat(6) * sig6_over_r6;
+                tmp *= eps * one_over_r2 * scl_lj;
+                
+                tmp &= r2.compareLess(Rlj2);
+                
+                return tmp;
+            }
+            
+        private:
+            const MultiFloat Rc;
+            const MultiFloat Rlj2;
+            const MultiFloat one_over_Rc2;
+            const MultiFloat scl_coul;
+            const MultiFloat scl_lj;
+            const bool calc_coul;
+            const bool calc_lj;
+        };
+        
+        /** Functional form used by detail::cljForceKernel to calculate the 
+            forces for the soft-core shifted electrostatics and cutoff LJ functions */
+        class SoftShiftForce
+        {
+        public:
+            SoftShiftForce(float coul_cutoff, float lj_cutoff,
+                           float alpha, float one_minus_alpha_to_n,
+                           float alpha_times_shift_delta,
+                           float scale_coul, float scale_lj)
+                 : Rlj2(lj_cutoff*lj_cutoff),
+                   soft_Rc( std::sqrt(alpha + coul_cutoff*coul_cutoff) ),
+                   one_over_soft_Rc2( 1.0 / (alpha + coul_cutoff*coul_cutoff) ),
+                   alfa(alpha), delta(alpha_times_shift_delta),
+                   scl_coul(scale_coul * one_minus_alpha_to_n), scl_lj(scale_lj),
+                   calc_coul(scale_coul != 0), calc_lj(scale_lj != 0)
+            {}
+            
+            bool hasCoulomb() const
+            {
+                return calc_coul;
+            }
+            
+            bool hasLJ() const
+            {
+                return calc_lj;
+            }
+            
+            /** E = (1-alpha)^n q0q1 * { 1/s - 1/sRc + 1/sRc^2 [s - sRc] } with
+                s = sqrt(alpha + r^2), so -(dE/dr) / r = (1-alpha)^n q0q1 * 
+                { 1/s^2 - 1/sRc^2 } / s */
+            MultiFloat coulomb(const MultiFloat &r2, const MultiFloat &q0q1) const
+            {
+                const MultiFloat soft_r = (r2 + alfa).sqrt();
+                const MultiFloat one_over_soft_r = soft_r.reciprocal();
+                
+                MultiFloat tmp = one_over_soft_r * one_over_soft_r;
+                tmp -= one_over_soft_Rc2;
+                tmp *= one_over_soft_r;
+                tmp *= q0q1 * scl_coul;
+                
+                tmp &= soft_r.compareLess(soft_Rc);
+                
+                return tmp;
+            }
+            
+            /** E = eps * { sig^12 / D^6 - sig^6 / D^3 } with D = delta sig + r^2,
+                so -(dE/dr) / r = eps * { 12 sig^12 / D^6 - 6 sig^6 / D^3 } / D */
+            MultiFloat lj(const MultiFloat &r2, const MultiFloat &sigma,
+                          const MultiFloat &eps) const
+            {
+                const MultiFloat one_over_delta = (delta * sigma + r2).reciprocal();
+                
+                MultiFloat sig6_over_delta3 = sigma * sigma * one_over_delta;
+                sig6_over_delta3 = sig6_over_delta3 * sig6_over_delta3 * sig6_over_delta3;
+                
+                MultiFloat tmp = MultiFloat(12) * sig6_over_delta3 * sig6_over_delta3;
+                tmp -= MultiFloat(6) * sig6_over_delta3;
+                tmp *= eps * one_over_delta * scl_lj;
+                
+                tmp &= r2.compareLess(Rlj2);
+                
+                return tmp;
+            }
+            
+        private:
+            const MultiFloat Rlj2;
+            const MultiFloat soft_Rc;
+            const MultiFloat one_over_soft_Rc2;
+            const MultiFloat alfa;
+            const MultiFloat delta;
+            const MultiFloat scl_coul;
+            const MultiFloat scl_lj;
+            const bool calc_coul;
+            const bool calc_lj;
+        };
+    }
+}
+
 /////////
 ///////// Implementation of CLJShiftFunction
 /////////
 
+/** Return the parameters needed by the shift kernels */
+static detail::CLJKernelParams shiftParams(float coul_cutoff, float lj_cutoff)
+{
+    detail::CLJKernelParams params;
+    params.coul_cutoff = coul_cutoff;
+    params.lj_cutoff = lj_cutoff;
+    params.dielectric = 1;
+    return params;
+}
+
 static const RegisterMetaType<CLJShiftFunction> r_shift;
 
 QDataStream SIREMM_EXPORT &operator<<(QDataStream &ds, const CLJShiftFunction &func)
@@ -193,6 +363,230 @@ QString CLJShiftFunction::toString() const
     returning the results in the arguments 'cnrg' and 'ljnrg' */
 void CLJShiftFunction::calcVacEnergyGeo(const CLJAtoms &atoms,
                                         double &cnrg, double &ljnrg) const
+{
+    detail::cljKernels().shift.vac_energy_geo(shiftParams(coul_cutoff, lj_cutoff),
+                                              detail::CLJKernelAtomsData(atoms), cnrg, ljnrg);
+}
+
+/** Calculate the intermolecular energy between all atoms in 'atoms0' and all
+    atoms in 'atoms1', returning the result in the arguments 'cnrg' and 'ljnrg' */
+void CLJShiftFunction::calcVacEnergyGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                        double &cnrg, double &ljnrg, float min_distance) const
+{
+    detail::cljKernels().shift.vac_energy_geo2(shiftParams(coul_cutoff, lj_cutoff),
+                                               detail::CLJKernelAtomsData(atoms0),
+                                               detail::CLJKernelAtomsData(atoms1), cnrg,
+                                               ljnrg);
+}
+
+/** Calculate the coulomb and LJ intermolecular energy of all of the atoms in 'atoms',
+    assuming periodic boundary conditions in a cubic box of size 'box_dimensions',
+    returning the results in 'cnrg' and 'ljnrg' */
+void CLJShiftFunction::calcBoxEnergyGeo(const CLJAtoms &atoms, const Vector &box_dimensions,
+                                        double &cnrg, double &ljnrg) const
+{
+    detail::cljKernels().shift.box_energy_geo(shiftParams(coul_cutoff, lj_cutoff),
+                                              detail::CLJKernelAtomsData(atoms),
+                                              detail::cljKernelVector(box_dimensions),
+                                              cnrg, ljnrg);
+}
+
+/** Calculate the intermolecular energy between all atoms in 'atoms0' and all
+    atoms in 'atoms1', assuming periodic boundary conditions in a cubic box
+    of size 'box_dimensions, returning the result in the arguments 'cnrg' and 'ljnrg' */
+void CLJShiftFunction::calcBoxEnergyGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                        const Vector &box_dimensions,
+                                        double &cnrg, double &ljnrg, float min_distance) const
+{
+    detail::cljKernels().shift.box_energy_geo2(shiftParams(coul_cutoff, lj_cutoff),
+                                               detail::CLJKernelAtomsData(atoms0),
+                                               detail::CLJKernelAtomsData(atoms1),
+                                               detail::cljKernelVector(box_dimensions),
+                                               cnrg, ljnrg);
+}
+
+/** Calculate the coulomb and LJ intermolecular energy of all of the atoms in 'atoms',
+    returning the results in the arguments 'cnrg' and 'ljnrg' */
+void CLJShiftFunction::calcVacEnergyAri(const CLJAtoms &atoms,
+                                        double &cnrg, double &ljnrg) const
+{
+    detail::cljKernels().shift.vac_energy_ari(shiftParams(coul_cutoff, lj_cutoff),
+                                              detail::CLJKernelAtomsData(atoms), cnrg, ljnrg);
+}
+
+/** Calculate the intermolecular energy between all atoms in 'atoms0' and all
+    atoms in 'atoms1', returning the result in the arguments 'cnrg' and 'ljnrg' */
+void CLJShiftFunction::calcVacEnergyAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                        double &cnrg, double &ljnrg, float min_distance) const
+{
+    detail::cljKernels().shift.vac_energy_ari2(shiftParams(coul_cutoff, lj_cutoff),
+                                               detail::CLJKernelAtomsData(atoms0),
+                                               detail::CLJKernelAtomsData(atoms1), cnrg,
+                                               ljnrg);
+}
+
+/** Calculate the coulomb intermolecular energy of all atoms in 'atoms' */
+double CLJShiftFunction::calcVacCoulombEnergyAri(const CLJAtoms &atoms) const
+{
+    return detail::cljKernels().shift.vac_coulomb_energy_ari(shiftParams(coul_cutoff, lj_cutoff),
+                                                             detail::CLJKernelAtomsData(atoms));
+}
+
+/** Calculate the coulomb intermolecular energy between all atoms in 'atoms0'
+    and 'atoms1' */
+double CLJShiftFunction::calcVacCoulombEnergyAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                                 float min_distance) const
+{
+    return detail::cljKernels().shift.vac_coulomb_energy_ari2(shiftParams(coul_cutoff, lj_cutoff),
+                                                              detail::CLJKernelAtomsData(atoms0),
+                                                              detail::CLJKernelAtomsData(atoms1));
+}
+
+/** Calculate the LJ intermolecular energy of all atoms in 'atoms' */
+double CLJShiftFunction::calcVacLJEnergyAri(const CLJAtoms &atoms) const
+{
+    return detail::cljKernels().shift.vac_lj_energy_ari(shiftParams(coul_cutoff, lj_cutoff),
+                                                        detail::CLJKernelAtomsData(atoms));
+}
+
+/** Calculate the LJ intermolecular energy between all atoms in 'atoms0'
+    and 'atoms1' */
+double CLJShiftFunction::calcVacLJEnergyAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                            float min_distance) const
+{
+    return detail::cljKernels().shift.vac_lj_energy_ari2(shiftParams(coul_cutoff, lj_cutoff),
+                                                         detail::CLJKernelAtomsData(atoms0),
+                                                         detail::CLJKernelAtomsData(atoms1));
+}
+
+/** Calculate the coulomb and LJ intermolecular energy of all of the atoms in 'atoms',
+    assuming periodic boundary conditions in a cubic box of size 'box_dimensions',
+    returning the results in 'cnrg' and 'ljnrg' */
+void CLJShiftFunction::calcBoxEnergyAri(const CLJAtoms &atoms, const Vector &box_dimensions,
+                                        double &cnrg, double &ljnrg) const
+{
+    detail::cljKernels().shift.box_energy_ari(shiftParams(coul_cutoff, lj_cutoff),
+                                              detail::CLJKernelAtomsData(atoms),
+                                              detail::cljKernelVector(box_dimensions),
+                                              cnrg, ljnrg);
+}
+
+/** Calculate the intermolecular energy between all atoms in 'atoms0' and all
+    atoms in 'atoms1', assuming periodic boundary conditions in a cubic box
+    of size 'box_dimensions, returning the result in the arguments 'cnrg' and 'ljnrg' */
+void CLJShiftFunction::calcBoxEnergyAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                        const Vector &box_dimensions,
+                                        double &cnrg, double &ljnrg, float min_distance) const
+{
+    detail::cljKernels().shift.box_energy_ari2(shiftParams(coul_cutoff, lj_cutoff),
+                                               detail::CLJKernelAtomsData(atoms0),
+                                               detail::CLJKernelAtomsData(atoms1),
+                                               detail::cljKernelVector(box_dimensions),
+                                               cnrg, ljnrg);
+}
+
+/** This function does support calculations using a grid */
+bool CLJShiftFunction::supportsGridCalculation() const
+{
+    return true;
+}
+
+/** Calculate the energy on the grid from the passed atoms using vacuum boundary conditions */
+void CLJShiftFunction::calcVacGrid(const CLJAtoms &atoms, const GridInfo &grid_info,
+                                   const int start, const int end, float *gridpot_array) const
+{
+    detail::cljKernels().shift.vac_grid(shiftParams(coul_cutoff, lj_cutoff),
+                                        detail::CLJKernelAtomsData(atoms),
+                                        detail::cljKernelGrid(grid_info), start, end,
+                                        gridpot_array);
+}
+
+/** Calculate the energy on the grid from the passed atoms using vacuum boundary conditions */
+void CLJShiftFunction::calcBoxGrid(const CLJAtoms &atoms, const GridInfo &grid_info,
+                                   const Vector &box_dimensions,
+                                   const int start, const int end, float *gridpot_array) const
+{
+    detail::cljKernels().shift.box_grid(shiftParams(coul_cutoff, lj_cutoff),
+                                        detail::CLJKernelAtomsData(atoms),
+                                        detail::cljKernelGrid(grid_info),
+                                        detail::cljKernelVector(box_dimensions), start,
+                                        end, gridpot_array);
+}
+
+#endif // #ifndef SIRE_KERNEL_ISA
+
+/////////
+///////// Vectorised kernels of CLJShiftFunction. These are compiled
+///////// once for each instruction set - see detail/cljkernels.h
+/////////
+
+namespace SireMM
+{
+namespace detail
+{
+namespace SIRE_KERNEL_NAMESPACE
+{
+
+using SireMaths::MultiDouble;
+
+/** The vectorised energy and grid kernels of CLJShiftFunction */
+class ShiftKernel
+{
+public:
+    ShiftKernel(const CLJKernelParams &params)
+        : coul_cutoff(params.coul_cutoff), lj_cutoff(params.lj_cutoff)
+    {}
+
+    void calcVacEnergyGeo(const CLJAtomsView &atoms, double &cnrg, double &ljnrg) const;
+
+    void calcVacEnergyGeo(const CLJAtomsView &atoms0, const CLJAtomsView &atoms1,
+                          double &cnrg, double &ljnrg) const;
+
+    void calcBoxEnergyGeo(const CLJAtomsView &atoms, const CLJVectorView &box_dimensions,
+                          double &cnrg, double &ljnrg) const;
+
+    void calcBoxEnergyGeo(const CLJAtomsView &atoms0, const CLJAtomsView &atoms1,
+                          const CLJVectorView &box_dimensions, double &cnrg,
+                          double &ljnrg) const;
+
+    void calcVacEnergyAri(const CLJAtomsView &atoms, double &cnrg, double &ljnrg) const;
+
+    void calcVacEnergyAri(const CLJAtomsView &atoms0, const CLJAtomsView &atoms1,
+                          double &cnrg, double &ljnrg) const;
+
+    double calcVacCoulombEnergyAri(const CLJAtomsView &atoms) const;
+
+    double calcVacCoulombEnergyAri(const CLJAtomsView &atoms0,
+                                   const CLJAtomsView &atoms1) const;
+
+    double calcVacLJEnergyAri(const CLJAtomsView &atoms) const;
+
+    double calcVacLJEnergyAri(const CLJAtomsView &atoms0,
+                              const CLJAtomsView &atoms1) const;
+
+    void calcBoxEnergyAri(const CLJAtomsView &atoms, const CLJVectorView &box_dimensions,
+                          double &cnrg, double &ljnrg) const;
+
+    void calcBoxEnergyAri(const CLJAtomsView &atoms0, const CLJAtomsView &atoms1,
+                          const CLJVectorView &box_dimensions, double &cnrg,
+                          double &ljnrg) const;
+
+    void calcVacGrid(const CLJAtomsView &atoms, const CLJGridView &grid_info,
+                     const int start, const int end, float *gridpot_array) const;
+
+    void calcBoxGrid(const CLJAtomsView &atoms, const CLJGridView &grid_info,
+                     const CLJVectorView &box_dimensions, const int start, const int end,
+                     float *gridpot_array) const;
+
+private:
+    const float coul_cutoff;
+    const float lj_cutoff;
+};
+
+/** Calculate the coulomb and LJ intermolecular energy of all of the atoms in 'atoms',
+    returning the results in the arguments 'cnrg' and 'ljnrg' */
+void ShiftKernel::calcVacEnergyGeo(const CLJAtomsView &atoms, double &cnrg,
+                                   double &ljnrg) const
 {
     const MultiFloat *xa = atoms.x().constData();
     const MultiFloat *ya = atoms.y().constData();
@@ -208,7 +602,7 @@ void CLJShiftFunction::calcVacEnergyGeo(const CLJAtoms &atoms,
     const MultiFloat one_over_Rc( 1.0 / coul_cutoff );
     const MultiFloat one_over_Rc2( 1.0 / (coul_cutoff*coul_cutoff) );
     const MultiFloat half(0.5);
-    const MultiInt dummy_id = CLJAtoms::idOfDummy();
+    const MultiInt dummy_id = atoms.idOfDummy();
     const qint32 dummy_int = dummy_id[0];
 
     MultiFloat tmp, r, one_over_r, sig2_over_r2, sig6_over_r6;
@@ -385,8 +779,8 @@ void CLJShiftFunction::calcVacEnergyGeo(const CLJAtoms &atoms,
 
 /** Calculate the intermolecular energy between all atoms in 'atoms0' and all
     atoms in 'atoms1', returning the result in the arguments 'cnrg' and 'ljnrg' */
-void CLJShiftFunction::calcVacEnergyGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
-                                        double &cnrg, double &ljnrg, float min_distance) const
+void ShiftKernel::calcVacEnergyGeo(const CLJAtomsView &atoms0, const CLJAtomsView &atoms1,
+                                   double &cnrg, double &ljnrg) const
 {
     const MultiFloat *x0 = atoms0.x().constData();
     const MultiFloat *y0 = atoms0.y().constData();
@@ -409,7 +803,7 @@ void CLJShiftFunction::calcVacEnergyGeo(const CLJAtoms &atoms0, const CLJAtoms &
     const MultiFloat one_over_Rc( 1.0 / coul_cutoff );
     const MultiFloat one_over_Rc2( 1.0 / (coul_cutoff*coul_cutoff) );
     const MultiFloat half(0.5);
-    const MultiInt dummy_id = CLJAtoms::idOfDummy();
+    const MultiInt dummy_id = atoms0.idOfDummy();
     const qint32 dummy_int = dummy_id[0];
 
     MultiFloat tmp, r, one_over_r, sig2_over_r2, sig6_over_r6;
@@ -585,8 +979,9 @@ void CLJShiftFunction::calcVacEnergyGeo(const CLJAtoms &atoms0, const CLJAtoms &
 /** Calculate the coulomb and LJ intermolecular energy of all of the atoms in 'atoms',
     assuming periodic boundary conditions in a cubic box of size 'box_dimensions',
     returning the results in 'cnrg' and 'ljnrg' */
-void CLJShiftFunction::calcBoxEnergyGeo(const CLJAtoms &atoms, const Vector &box_dimensions,
-                                        double &cnrg, double &ljnrg) const
+void ShiftKernel::calcBoxEnergyGeo(const CLJAtomsView &atoms,
+                                   const CLJVectorView &box_dimensions, double &cnrg,
+                                   double &ljnrg) const
 {
     const MultiFloat *xa = atoms.x().constData();
     const MultiFloat *ya = atoms.y().constData();
@@ -602,7 +997,7 @@ void CLJShiftFunction::calcBoxEnergyGeo(const CLJAtoms &atoms, const Vector &box
     const MultiFloat one_over_Rc( 1.0 / coul_cutoff );
     const MultiFloat one_over_Rc2( 1.0 / (coul_cutoff*coul_cutoff) );
     const MultiFloat half(0.5);
-    const MultiInt dummy_id = CLJAtoms::idOfDummy();
+    const MultiInt dummy_id = atoms.idOfDummy();
     const qint32 dummy_int = dummy_id[0];
 
     MultiFloat tmp, r, one_over_r, sig2_over_r2, sig6_over_r6;
@@ -706,9 +1101,9 @@ void CLJShiftFunction::calcBoxEnergyGeo(const CLJAtoms &atoms, const Vector &box
 /** Calculate the intermolecular energy between all atoms in 'atoms0' and all
     atoms in 'atoms1', assuming periodic boundary conditions in a cubic box
     of size 'box_dimensions, returning the result in the arguments 'cnrg' and 'ljnrg' */
-void CLJShiftFunction::calcBoxEnergyGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
-                                        const Vector &box_dimensions,
-                                        double &cnrg, double &ljnrg, float min_distance) const
+void ShiftKernel::calcBoxEnergyGeo(const CLJAtomsView &atoms0, const CLJAtomsView &atoms1,
+                                   const CLJVectorView &box_dimensions, double &cnrg,
+                                   double &ljnrg) const
 {
     const MultiFloat *x0 = atoms0.x().constData();
     const MultiFloat *y0 = atoms0.y().constData();
@@ -731,7 +1126,7 @@ void CLJShiftFunction::calcBoxEnergyGeo(const CLJAtoms &atoms0, const CLJAtoms &
     const MultiFloat one_over_Rc( 1.0 / coul_cutoff );
     const MultiFloat one_over_Rc2( 1.0 / (coul_cutoff*coul_cutoff) );
     const MultiFloat half(0.5);
-    const MultiInt dummy_id = CLJAtoms::idOfDummy();
+    const MultiInt dummy_id = atoms0.idOfDummy();
     const qint32 dummy_int = dummy_id[0];
 
     MultiFloat tmp, r, one_over_r, sig2_over_r2, sig6_over_r6;
@@ -835,8 +1230,8 @@ void CLJShiftFunction::calcBoxEnergyGeo(const CLJAtoms &atoms0, const CLJAtoms &
 
 /** Calculate the coulomb and LJ intermolecular energy of all of the atoms in 'atoms',
     returning the results in the arguments 'cnrg' and 'ljnrg' */
-void CLJShiftFunction::calcVacEnergyAri(const CLJAtoms &atoms,
-                                        double &cnrg, double &ljnrg) const
+void ShiftKernel::calcVacEnergyAri(const CLJAtomsView &atoms, double &cnrg,
+                                   double &ljnrg) const
 {
     const MultiFloat *xa = atoms.x().constData();
     const MultiFloat *ya = atoms.y().constData();
@@ -852,7 +1247,7 @@ void CLJShiftFunction::calcVacEnergyAri(const CLJAtoms &atoms,
     const MultiFloat one_over_Rc( 1.0 / coul_cutoff );
     const MultiFloat one_over_Rc2( 1.0 / (coul_cutoff*coul_cutoff) );
     const MultiFloat half(0.5);
-    const MultiInt dummy_id = CLJAtoms::idOfDummy();
+    const MultiInt dummy_id = atoms.idOfDummy();
     const qint32 dummy_int = dummy_id[0];
 
     MultiFloat tmp, r, one_over_r, sig2_over_r2, sig6_over_r6;
@@ -1035,8 +1430,8 @@ void CLJShiftFunction::calcVacEnergyAri(const CLJAtoms &atoms,
 
 /** Calculate the intermolecular energy between all atoms in 'atoms0' and all
     atoms in 'atoms1', returning the result in the arguments 'cnrg' and 'ljnrg' */
-void CLJShiftFunction::calcVacEnergyAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
-                                        double &cnrg, double &ljnrg, float min_distance) const
+void ShiftKernel::calcVacEnergyAri(const CLJAtomsView &atoms0, const CLJAtomsView &atoms1,
+                                   double &cnrg, double &ljnrg) const
 {
     const MultiFloat *x0 = atoms0.x().constData();
     const MultiFloat *y0 = atoms0.y().constData();
@@ -1059,7 +1454,7 @@ void CLJShiftFunction::calcVacEnergyAri(const CLJAtoms &atoms0, const CLJAtoms &
     const MultiFloat one_over_Rc( 1.0 / coul_cutoff );
     const MultiFloat one_over_Rc2( 1.0 / (coul_cutoff*coul_cutoff) );
     const MultiFloat half(0.5);
-    const MultiInt dummy_id = CLJAtoms::idOfDummy();
+    const MultiInt dummy_id = atoms0.idOfDummy();
     const qint32 dummy_int = dummy_id[0];
 
     MultiFloat tmp, r, one_over_r, sig2_over_r2, sig6_over_r6;
@@ -1239,7 +1634,7 @@ void CLJShiftFunction::calcVacEnergyAri(const CLJAtoms &atoms0, const CLJAtoms &
 }
 
 /** Calculate the coulomb intermolecular energy of all atoms in 'atoms' */
-double CLJShiftFunction::calcVacCoulombEnergyAri(const CLJAtoms &atoms) const
+double ShiftKernel::calcVacCoulombEnergyAri(const CLJAtomsView &atoms) const
 {
     const MultiFloat *xa = atoms.x().constData();
     const MultiFloat *ya = atoms.y().constData();
@@ -1252,7 +1647,7 @@ double CLJShiftFunction::calcVacCoulombEnergyAri(const CLJAtoms &atoms) const
     const MultiFloat one_over_Rc( 1.0 / coul_cutoff );
     const MultiFloat one_over_Rc2( 1.0 / (coul_cutoff*coul_cutoff) );
     const MultiFloat half(0.5);
-    const MultiInt dummy_id = CLJAtoms::idOfDummy();
+    const MultiInt dummy_id = atoms.idOfDummy();
     const qint32 dummy_int = dummy_id[0];
 
     MultiFloat tmp, r, one_over_r;
@@ -1320,8 +1715,8 @@ double CLJShiftFunction::calcVacCoulombEnergyAri(const CLJAtoms &atoms) const
 
 /** Calculate the coulomb intermolecular energy between all atoms in 'atoms0'
     and 'atoms1' */
-double CLJShiftFunction::calcVacCoulombEnergyAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
-                                                 float min_distance) const
+double ShiftKernel::calcVacCoulombEnergyAri(const CLJAtomsView &atoms0,
+                                            const CLJAtomsView &atoms1) const
 {
     const MultiFloat *x0 = atoms0.x().constData();
     const MultiFloat *y0 = atoms0.y().constData();
@@ -1339,7 +1734,7 @@ double CLJShiftFunction::calcVacCoulombEnergyAri(const CLJAtoms &atoms0, const C
     const MultiFloat one_over_Rc( 1.0 / coul_cutoff );
     const MultiFloat one_over_Rc2( 1.0 / (coul_cutoff*coul_cutoff) );
     const MultiFloat half(0.5);
-    const MultiInt dummy_id = CLJAtoms::idOfDummy();
+    const MultiInt dummy_id = atoms0.idOfDummy();
     const qint32 dummy_int = dummy_id[0];
 
     MultiFloat tmp, r, one_over_r;
@@ -1401,9 +1796,9 @@ double CLJShiftFunction::calcVacCoulombEnergyAri(const CLJAtoms &atoms0, const C
     
     return icnrg.sum();
 }
-    
+
 /** Calculate the LJ intermolecular energy of all atoms in 'atoms' */
-double CLJShiftFunction::calcVacLJEnergyAri(const CLJAtoms &atoms) const
+double ShiftKernel::calcVacLJEnergyAri(const CLJAtomsView &atoms) const
 {
     const MultiFloat *xa = atoms.x().constData();
     const MultiFloat *ya = atoms.y().constData();
@@ -1415,7 +1810,7 @@ double CLJShiftFunction::calcVacLJEnergyAri(const CLJAtoms &atoms) const
     const MultiFloat Rlj(lj_cutoff);
 
     const MultiFloat half(0.5);
-    const MultiInt dummy_id = CLJAtoms::idOfDummy();
+    const MultiInt dummy_id = atoms.idOfDummy();
     const qint32 dummy_int = dummy_id[0];
 
     MultiFloat tmp, r, one_over_r, sig2_over_r2, sig6_over_r6;
@@ -1483,8 +1878,8 @@ double CLJShiftFunction::calcVacLJEnergyAri(const CLJAtoms &atoms) const
 
 /** Calculate the LJ intermolecular energy between all atoms in 'atoms0'
     and 'atoms1' */
-double CLJShiftFunction::calcVacLJEnergyAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
-                                            float min_distance) const
+double ShiftKernel::calcVacLJEnergyAri(const CLJAtomsView &atoms0,
+                                       const CLJAtomsView &atoms1) const
 {
     const MultiFloat *x0 = atoms0.x().constData();
     const MultiFloat *y0 = atoms0.y().constData();
@@ -1502,7 +1897,7 @@ double CLJShiftFunction::calcVacLJEnergyAri(const CLJAtoms &atoms0, const CLJAto
     
     const MultiFloat Rlj(lj_cutoff);
     const MultiFloat half(0.5);
-    const MultiInt dummy_id = CLJAtoms::idOfDummy();
+    const MultiInt dummy_id = atoms0.idOfDummy();
     const qint32 dummy_int = dummy_id[0];
 
     MultiFloat tmp, r, one_over_r, sig2_over_r2, sig6_over_r6;
@@ -1572,8 +1967,9 @@ double CLJShiftFunction::calcVacLJEnergyAri(const CLJAtoms &atoms0, const CLJAto
 /** Calculate the coulomb and LJ intermolecular energy of all of the atoms in 'atoms',
     assuming periodic boundary conditions in a cubic box of size 'box_dimensions',
     returning the results in 'cnrg' and 'ljnrg' */
-void CLJShiftFunction::calcBoxEnergyAri(const CLJAtoms &atoms, const Vector &box_dimensions,
-                                        double &cnrg, double &ljnrg) const
+void ShiftKernel::calcBoxEnergyAri(const CLJAtomsView &atoms,
+                                   const CLJVectorView &box_dimensions, double &cnrg,
+                                   double &ljnrg) const
 {
     const MultiFloat *xa = atoms.x().constData();
     const MultiFloat *ya = atoms.y().constData();
@@ -1589,7 +1985,7 @@ void CLJShiftFunction::calcBoxEnergyAri(const CLJAtoms &atoms, const Vector &box
     const MultiFloat one_over_Rc( 1.0 / coul_cutoff );
     const MultiFloat one_over_Rc2( 1.0 / (coul_cutoff*coul_cutoff) );
     const MultiFloat half(0.5);
-    const MultiInt dummy_id = CLJAtoms::idOfDummy();
+    const MultiInt dummy_id = atoms.idOfDummy();
     const qint32 dummy_int = dummy_id[0];
 
     MultiFloat tmp, r, one_over_r, sig2_over_r2, sig6_over_r6;
@@ -1696,9 +2092,9 @@ void CLJShiftFunction::calcBoxEnergyAri(const CLJAtoms &atoms, const Vector &box
 /** Calculate the intermolecular energy between all atoms in 'atoms0' and all
     atoms in 'atoms1', assuming periodic boundary conditions in a cubic box
     of size 'box_dimensions, returning the result in the arguments 'cnrg' and 'ljnrg' */
-void CLJShiftFunction::calcBoxEnergyAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
-                                        const Vector &box_dimensions,
-                                        double &cnrg, double &ljnrg, float min_distance) const
+void ShiftKernel::calcBoxEnergyAri(const CLJAtomsView &atoms0, const CLJAtomsView &atoms1,
+                                   const CLJVectorView &box_dimensions, double &cnrg,
+                                   double &ljnrg) const
 {
     const MultiFloat *x0 = atoms0.x().constData();
     const MultiFloat *y0 = atoms0.y().constData();
@@ -1721,7 +2117,7 @@ void CLJShiftFunction::calcBoxEnergyAri(const CLJAtoms &atoms0, const CLJAtoms &
     const MultiFloat one_over_Rc( 1.0 / coul_cutoff );
     const MultiFloat one_over_Rc2( 1.0 / (coul_cutoff*coul_cutoff) );
     const MultiFloat half(0.5);
-    const MultiInt dummy_id = CLJAtoms::idOfDummy();
+    const MultiInt dummy_id = atoms0.idOfDummy();
     const qint32 dummy_int = dummy_id[0];
 
     MultiFloat tmp, r, one_over_r, sig2_over_r2, sig6_over_r6;
@@ -1826,15 +2222,9 @@ void CLJShiftFunction::calcBoxEnergyAri(const CLJAtoms &atoms0, const CLJAtoms &
     ljnrg = iljnrg.sum();
 }
 
-/** This function does support calculations using a grid */
-bool CLJShiftFunction::supportsGridCalculation() const
-{
-    return true;
-}
-
 /** Calculate the energy on the grid from the passed atoms using vacuum boundary conditions */
-void CLJShiftFunction::calcVacGrid(const CLJAtoms &atoms, const GridInfo &grid_info,
-                                   const int start, const int end, float *gridpot_array) const
+void ShiftKernel::calcVacGrid(const CLJAtomsView &atoms, const CLJGridView &grid_info,
+                              const int start, const int end, float *gridpot_array) const
 {
     const MultiFloat* const x = atoms.x().constData();
     const MultiFloat* const y = atoms.y().constData();
@@ -1845,7 +2235,8 @@ void CLJShiftFunction::calcVacGrid(const CLJAtoms &atoms, const GridInfo &grid_i
     const MultiFloat Rc( coul_cutoff );
     const MultiFloat one_over_Rc( 1.0f / coul_cutoff );
     const MultiFloat one_over_Rc2( 1.0f / (coul_cutoff*coul_cutoff) );
-    const MultiInt dummy_id = CLJAtoms::idOfDummy();
+    const MultiFloat min_r2( clj_grid_min_distance*clj_grid_min_distance );
+    const MultiInt dummy_id = atoms.idOfDummy();
 
     MultiFloat tmp, r, one_over_r, itmp;
 
@@ -1853,7 +2244,7 @@ void CLJShiftFunction::calcVacGrid(const CLJAtoms &atoms, const GridInfo &grid_i
 
     for (int i = start; i < end; ++i)
     {
-        const Vector grid_point = grid_info.point(i);
+        const CLJVectorView grid_point = grid_info.point(i);
         
         const MultiFloat px(grid_point.x());
         const MultiFloat py(grid_point.y());
@@ -1871,7 +2262,9 @@ void CLJShiftFunction::calcVacGrid(const CLJAtoms &atoms, const GridInfo &grid_i
             tmp = pz - z[j];
             r.multiplyAdd(tmp, tmp);
 
-            r = r.sqrt();
+            //don't let the grid point get closer to the atom than
+            //clj_grid_min_distance, so that 1/r does not overflow
+            r = r.max(min_r2).sqrt();
 
             one_over_r = r.reciprocal();
     
@@ -1897,9 +2290,9 @@ void CLJShiftFunction::calcVacGrid(const CLJAtoms &atoms, const GridInfo &grid_i
 }
 
 /** Calculate the energy on the grid from the passed atoms using vacuum boundary conditions */
-void CLJShiftFunction::calcBoxGrid(const CLJAtoms &atoms, const GridInfo &grid_info,
-                                   const Vector &box_dimensions,
-                                   const int start, const int end, float *gridpot_array) const
+void ShiftKernel::calcBoxGrid(const CLJAtomsView &atoms, const CLJGridView &grid_info,
+                              const CLJVectorView &box_dimensions, const int start,
+                              const int end, float *gridpot_array) const
 {
     const MultiFloat* const x = atoms.x().constData();
     const MultiFloat* const y = atoms.y().constData();
@@ -1910,7 +2303,8 @@ void CLJShiftFunction::calcBoxGrid(const CLJAtoms &atoms, const GridInfo &grid_i
     const MultiFloat Rc( coul_cutoff );
     const MultiFloat one_over_Rc( 1.0f / coul_cutoff );
     const MultiFloat one_over_Rc2( 1.0f / (coul_cutoff*coul_cutoff) );
-    const MultiInt dummy_id = CLJAtoms::idOfDummy();
+    const MultiFloat min_r2( clj_grid_min_distance*clj_grid_min_distance );
+    const MultiInt dummy_id = atoms.idOfDummy();
 
     const MultiFloat box_x( box_dimensions.x() );
     const MultiFloat box_y( box_dimensions.y() );
@@ -1926,7 +2320,7 @@ void CLJShiftFunction::calcBoxGrid(const CLJAtoms &atoms, const GridInfo &grid_i
 
     for (int i = start; i < end; ++i)
     {
-        const Vector grid_point = grid_info.point(i);
+        const CLJVectorView grid_point = grid_info.point(i);
         
         const MultiFloat px(grid_point.x());
         const MultiFloat py(grid_point.y());
@@ -1952,7 +2346,9 @@ void CLJShiftFunction::calcBoxGrid(const CLJAtoms &atoms, const GridInfo &grid_i
             tmp -= box_z.logicalAnd( half_box_z.compareLess(tmp) );
             r.multiplyAdd(tmp, tmp);
 
-            r = r.sqrt();
+            //don't let the grid point get closer to the atom than
+            //clj_grid_min_distance, so that 1/r does not overflow
+            r = r.max(min_r2).sqrt();
 
             one_over_r = r.reciprocal();
     
@@ -1977,6 +2373,215 @@ void CLJShiftFunction::calcBoxGrid(const CLJAtoms &atoms, const GridInfo &grid_i
     }
 }
 
+static void vacEnergyGeo(const CLJKernelParams &params, const CLJKernelAtoms &atoms,
+                         double &cnrg, double &ljnrg)
+{
+    ShiftKernel(params).calcVacEnergyGeo(atoms, cnrg, ljnrg);
+}
+
+static void vacEnergyGeo2(const CLJKernelParams &params, const CLJKernelAtoms &atoms0,
+                          const CLJKernelAtoms &atoms1, double &cnrg, double &ljnrg)
+{
+    ShiftKernel(params).calcVacEnergyGeo(atoms0, atoms1, cnrg, ljnrg);
+}
+
+static void boxEnergyGeo(const CLJKernelParams &params, const CLJKernelAtoms &atoms,
+                         const CLJKernelVector &box_dimensions, double &cnrg,
+                         double &ljnrg)
+{
+    ShiftKernel(params).calcBoxEnergyGeo(atoms, box_dimensions, cnrg, ljnrg);
+}
+
+static void boxEnergyGeo2(const CLJKernelParams &params, const CLJKernelAtoms &atoms0,
+                          const CLJKernelAtoms &atoms1,
+                          const CLJKernelVector &box_dimensions, double &cnrg,
+                          double &ljnrg)
+{
+    ShiftKernel(params).calcBoxEnergyGeo(atoms0, atoms1, box_dimensions, cnrg, ljnrg);
+}
+
+static void vacEnergyAri(const CLJKernelParams &params, const CLJKernelAtoms &atoms,
+                         double &cnrg, double &ljnrg)
+{
+    ShiftKernel(params).calcVacEnergyAri(atoms, cnrg, ljnrg);
+}
+
+static void vacEnergyAri2(const CLJKernelParams &params, const CLJKernelAtoms &atoms0,
+                          const CLJKernelAtoms &atoms1, double &cnrg, double &ljnrg)
+{
+    ShiftKernel(params).calcVacEnergyAri(atoms0, atoms1, cnrg, ljnrg);
+}
+
+static double vacCoulombEnergyAri(const CLJKernelParams &params,
+                                  const CLJKernelAtoms &atoms)
+{
+    return ShiftKernel(params).calcVacCoulombEnergyAri(atoms);
+}
+
+static double vacCoulombEnergyAri2(const CLJKernelParams &params,
+                                   const CLJKernelAtoms &atoms0,
+                                   const CLJKernelAtoms &atoms1)
+{
+    return ShiftKernel(params).calcVacCoulombEnergyAri(atoms0, atoms1);
+}
+
+static double vacLJEnergyAri(const CLJKernelParams &params, const CLJKernelAtoms &atoms)
+{
+    return ShiftKernel(params).calcVacLJEnergyAri(atoms);
+}
+
+static double vacLJEnergyAri2(const CLJKernelParams &params, const CLJKernelAtoms &atoms0,
+                              const CLJKernelAtoms &atoms1)
+{
+    return ShiftKernel(params).calcVacLJEnergyAri(atoms0, atoms1);
+}
+
+static void boxEnergyAri(const CLJKernelParams &params, const CLJKernelAtoms &atoms,
+                         const CLJKernelVector &box_dimensions, double &cnrg,
+                         double &ljnrg)
+{
+    ShiftKernel(params).calcBoxEnergyAri(atoms, box_dimensions, cnrg, ljnrg);
+}
+
+static void boxEnergyAri2(const CLJKernelParams &params, const CLJKernelAtoms &atoms0,
+                          const CLJKernelAtoms &atoms1,
+                          const CLJKernelVector &box_dimensions, double &cnrg,
+                          double &ljnrg)
+{
+    ShiftKernel(params).calcBoxEnergyAri(atoms0, atoms1, box_dimensions, cnrg, ljnrg);
+}
+
+static void vacGrid(const CLJKernelParams &params, const CLJKernelAtoms &atoms,
+                    const CLJKernelGrid &grid_info, int start, int end,
+                    float *gridpot_array)
+{
+    ShiftKernel(params).calcVacGrid(atoms, grid_info, start, end, gridpot_array);
+}
+
+static void boxGrid(const CLJKernelParams &params, const CLJKernelAtoms &atoms,
+                    const CLJKernelGrid &grid_info, const CLJKernelVector &box_dimensions,
+                    int start, int end, float *gridpot_array)
+{
+    ShiftKernel(params).calcBoxGrid(atoms, grid_info, box_dimensions, start, end,
+                                    gridpot_array);
+}
+
+/** Return the kernels of CLJShiftFunction compiled for this instruction set */
+void getShiftKernels(CLJFunctionKernels &kernels)
+{
+    kernels.vac_energy_geo = &vacEnergyGeo;
+    kernels.vac_energy_geo2 = &vacEnergyGeo2;
+    kernels.box_energy_geo = &boxEnergyGeo;
+    kernels.box_energy_geo2 = &boxEnergyGeo2;
+    kernels.vac_energy_ari = &vacEnergyAri;
+    kernels.vac_energy_ari2 = &vacEnergyAri2;
+    kernels.vac_coulomb_energy_ari = &vacCoulombEnergyAri;
+    kernels.vac_coulomb_energy_ari2 = &vacCoulombEnergyAri2;
+    kernels.vac_lj_energy_ari = &vacLJEnergyAri;
+    kernels.vac_lj_energy_ari2 = &vacLJEnergyAri2;
+    kernels.box_energy_ari = &boxEnergyAri;
+    kernels.box_energy_ari2 = &boxEnergyAri2;
+    kernels.vac_grid = &vacGrid;
+    kernels.box_grid = &boxGrid;
+}
+
+} // end of namespace SIRE_KERNEL_NAMESPACE
+} // end of namespace detail
+} // end of namespace SireMM
+
+#ifndef SIRE_KERNEL_ISA
+
+/** Return whether or not this function supports calculating forces */
+bool CLJShiftFunction::supportsForceCalculation() const
+{
+    return true;
+}
+
+/** Calculate the coulomb and LJ forces between the passed atoms
+    in vacuum using arithmetic combining rules, adding them onto 'forces' */
+void CLJShiftFunction::calcVacForceAri(const CLJAtoms &atoms, CLJForces &forces,
+                                       float scale_coul, float scale_lj) const
+{
+    const detail::ShiftForce func(coul_cutoff, lj_cutoff, scale_coul, scale_lj);
+    detail::cljForce<true,false>(func, atoms, forces, Vector());
+}
+
+/** Calculate the coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in vacuum using arithmetic combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJShiftFunction::calcVacForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                       CLJForces &forces0, CLJForces &forces1,
+                                       float scale_coul, float scale_lj) const
+{
+    const detail::ShiftForce func(coul_cutoff, lj_cutoff, scale_coul, scale_lj);
+    detail::cljForce<true,false>(func, atoms0, atoms1, forces0, forces1,
+                                 Vector());
+}
+
+/** Calculate the coulomb and LJ forces between the passed atoms
+    in vacuum using geometric combining rules, adding them onto 'forces' */
+void CLJShiftFunction::calcVacForceGeo(const CLJAtoms &atoms, CLJForces &forces,
+                                       float scale_coul, float scale_lj) const
+{
+    const detail::ShiftForce func(coul_cutoff, lj_cutoff, scale_coul, scale_lj);
+    detail::cljForce<false,false>(func, atoms, forces, Vector());
+}
+
+/** Calculate the coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in vacuum using geometric combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJShiftFunction::calcVacForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                       CLJForces &forces0, CLJForces &forces1,
+                                       float scale_coul, float scale_lj) const
+{
+    const detail::ShiftForce func(coul_cutoff, lj_cutoff, scale_coul, scale_lj);
+    detail::cljForce<false,false>(func, atoms0, atoms1, forces0, forces1,
+                                  Vector());
+}
+
+/** Calculate the coulomb and LJ forces between the passed atoms
+    in a periodic box using arithmetic combining rules, adding them onto 'forces' */
+void CLJShiftFunction::calcBoxForceAri(const CLJAtoms &atoms, const Vector &box_dimensions,
+                                       CLJForces &forces, float scale_coul, float scale_lj) const
+{
+    const detail::ShiftForce func(coul_cutoff, lj_cutoff, scale_coul, scale_lj);
+    detail::cljForce<true,true>(func, atoms, forces, box_dimensions);
+}
+
+/** Calculate the coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in a periodic box using arithmetic combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJShiftFunction::calcBoxForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                       const Vector &box_dimensions,
+                                       CLJForces &forces0, CLJForces &forces1,
+                                       float scale_coul, float scale_lj) const
+{
+    const detail::ShiftForce func(coul_cutoff, lj_cutoff, scale_coul, scale_lj);
+    detail::cljForce<true,true>(func, atoms0, atoms1, forces0, forces1,
+                                box_dimensions);
+}
+
+/** Calculate the coulomb and LJ forces between the passed atoms
+    in a periodic box using geometric combining rules, adding them onto 'forces' */
+void CLJShiftFunction::calcBoxForceGeo(const CLJAtoms &atoms, const Vector &box_dimensions,
+                                       CLJForces &forces, float scale_coul, float scale_lj) const
+{
+    const detail::ShiftForce func(coul_cutoff, lj_cutoff, scale_coul, scale_lj);
+    detail::cljForce<false,true>(func, atoms, forces, box_dimensions);
+}
+
+/** Calculate the coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in a periodic box using geometric combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJShiftFunction::calcBoxForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                       const Vector &box_dimensions,
+                                       CLJForces &forces0, CLJForces &forces1,
+                                       float scale_coul, float scale_lj) const
+{
+    const detail::ShiftForce func(coul_cutoff, lj_cutoff, scale_coul, scale_lj);
+    detail::cljForce<false,true>(func, atoms0, atoms1, forces0, forces1,
+                                 box_dimensions);
+}
 
 /////////
 ///////// Implementation of CLJSoftShiftFunction
@@ -3904,6 +4509,106 @@ void CLJSoftShiftFunction::calcBoxEnergyAri(const CLJAtoms &atoms0, const CLJAto
     ljnrg = iljnrg.sum();
 }
 
+/** Return whether or not this function supports calculating forces */
+bool CLJSoftShiftFunction::supportsForceCalculation() const
+{
+    return true;
+}
+
+/** Calculate the soft-core coulomb and LJ forces between the passed atoms
+    in vacuum using arithmetic combining rules, adding them onto 'forces' */
+void CLJSoftShiftFunction::calcVacForceAri(const CLJAtoms &atoms, CLJForces &forces,
+                                           float scale_coul, float scale_lj) const
+{
+    const detail::SoftShiftForce func(coul_cutoff, lj_cutoff, alpha(), oneMinusAlphaToN(),
+                                      alphaTimesShiftDelta(), scale_coul, scale_lj);
+    detail::cljForce<true,false>(func, atoms, forces, Vector());
+}
+
+/** Calculate the soft-core coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in vacuum using arithmetic combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJSoftShiftFunction::calcVacForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                           CLJForces &forces0, CLJForces &forces1,
+                                           float scale_coul, float scale_lj) const
+{
+    const detail::SoftShiftForce func(coul_cutoff, lj_cutoff, alpha(), oneMinusAlphaToN(),
+                                      alphaTimesShiftDelta(), scale_coul, scale_lj);
+    detail::cljForce<true,false>(func, atoms0, atoms1, forces0, forces1,
+                                 Vector());
+}
+
+/** Calculate the soft-core coulomb and LJ forces between the passed atoms
+    in vacuum using geometric combining rules, adding them onto 'forces' */
+void CLJSoftShiftFunction::calcVacForceGeo(const CLJAtoms &atoms, CLJForces &forces,
+                                           float scale_coul, float scale_lj) const
+{
+    const detail::SoftShiftForce func(coul_cutoff, lj_cutoff, alpha(), oneMinusAlphaToN(),
+                                      alphaTimesShiftDelta(), scale_coul, scale_lj);
+    detail::cljForce<false,false>(func, atoms, forces, Vector());
+}
+
+/** Calculate the soft-core coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in vacuum using geometric combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJSoftShiftFunction::calcVacForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                           CLJForces &forces0, CLJForces &forces1,
+                                           float scale_coul, float scale_lj) const
+{
+    const detail::SoftShiftForce func(coul_cutoff, lj_cutoff, alpha(), oneMinusAlphaToN(),
+                                      alphaTimesShiftDelta(), scale_coul, scale_lj);
+    detail::cljForce<false,false>(func, atoms0, atoms1, forces0, forces1,
+                                  Vector());
+}
+
+/** Calculate the soft-core coulomb and LJ forces between the passed atoms
+    in a periodic box using arithmetic combining rules, adding them onto 'forces' */
+void CLJSoftShiftFunction::calcBoxForceAri(const CLJAtoms &atoms, const Vector &box_dimensions,
+                                           CLJForces &forces, float scale_coul, float scale_lj) const
+{
+    const detail::SoftShiftForce func(coul_cutoff, lj_cutoff, alpha(), oneMinusAlphaToN(),
+                                      alphaTimesShiftDelta(), scale_coul, scale_lj);
+    detail::cljForce<true,true>(func, atoms, forces, box_dimensions);
+}
+
+/** Calculate the soft-core coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in a periodic box using arithmetic combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJSoftShiftFunction::calcBoxForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                           const Vector &box_dimensions,
+                                           CLJForces &forces0, CLJForces &forces1,
+                                           float scale_coul, float scale_lj) const
+{
+    const detail::SoftShiftForce func(coul_cutoff, lj_cutoff, alpha(), oneMinusAlphaToN(),
+                                      alphaTimesShiftDelta(), scale_coul, scale_lj);
+    detail::cljForce<true,true>(func, atoms0, atoms1, forces0, forces1,
+                                box_dimensions);
+}
+
+/** Calculate the soft-core coulomb and LJ forces between the passed atoms
+    in a periodic box using geometric combining rules, adding them onto 'forces' */
+void CLJSoftShiftFunction::calcBoxForceGeo(const CLJAtoms &atoms, const Vector &box_dimensions,
+                                           CLJForces &forces, float scale_coul, float scale_lj) const
+{
+    const detail::SoftShiftForce func(coul_cutoff, lj_cutoff, alpha(), oneMinusAlphaToN(),
+                                      alphaTimesShiftDelta(), scale_coul, scale_lj);
+    detail::cljForce<false,true>(func, atoms, forces, box_dimensions);
+}
+
+/** Calculate the soft-core coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in a periodic box using geometric combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJSoftShiftFunction::calcBoxForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                           const Vector &box_dimensions,
+                                           CLJForces &forces0, CLJForces &forces1,
+                                           float scale_coul, float scale_lj) const
+{
+    const detail::SoftShiftForce func(coul_cutoff, lj_cutoff, alpha(), oneMinusAlphaToN(),
+                                      alphaTimesShiftDelta(), scale_coul, scale_lj);
+    detail::cljForce<false,true>(func, atoms0, atoms1, forces0, forces1,
+                                 box_dimensions);
+}
+
 /////////
 ///////// Implementation of CLJIntraShiftFunction
 /////////
@@ -4080,7 +4785,7 @@ void CLJIntraShiftFunction::calcVacEnergyGeo(const CLJAtoms &atoms,
                 const MultiFloat sig( siga[i][ii] );
                 const MultiFloat eps( epsa[i][ii] );
 
-                const bool *row = bondMatrix().constData()[id[0]].constData();
+                const detail::CLJExclusions::Row row = exclusions().row(id[0]);
 
                 for (int j=i; j<n; ++j)
                 {
@@ -4089,10 +4794,7 @@ void CLJIntraShiftFunction::calcVacEnergyGeo(const CLJAtoms &atoms,
                     MultiFloat scale( i == j ? 0.5 : 1.0 );
                 
                     //get the bond mask to screen out bonded interactions
-                    for (int k=0; k<MultiFloat::count(); ++k)
-                    {
-                        bond_mask.quickSet(k, row[ida[j][k]] ? 0.0 : 1.0);
-                    }
+                    bond_mask = row.mask(ida[j]);
                 
                     scale *= bond_mask;
                 
@@ -4287,15 +4989,12 @@ void CLJIntraShiftFunction::calcVacEnergyGeo(const CLJAtoms &atoms0, const CLJAt
                     const MultiFloat sig(sig0[i][ii]);
                     const MultiFloat eps(eps0[i][ii]);
 
-                    const bool *row = bondMatrix().constData()[id[0]].constData();
+                    const detail::CLJExclusions::Row row = exclusions().row(id[0]);
 
                     for (int j=0; j<n1; ++j)
                     {
                         //create a mask to cancel out calculations of bonded pairs
-                        for (int k=0; k<MultiInt::count(); ++k)
-                        {
-                            bonded_mask.quickSet(k, row[id1[j][k]] ? 0.0 : 1.0);
-                        }
+                        bonded_mask = row.mask(id1[j]);
 
                         //calculate the distance between the fixed and mobile atoms
                         tmp = x1[j] - x;
@@ -4406,7 +5105,7 @@ void CLJIntraShiftFunction::calcBoxEnergyGeo(const CLJAtoms &atoms, const Vector
                 const MultiFloat sig( siga[i][ii] );
                 const MultiFloat eps( epsa[i][ii] );
 
-                const bool *row = bondMatrix().constData()[id[0]].constData();
+                const detail::CLJExclusions::Row row = exclusions().row(id[0]);
 
                 for (int j=i; j<n; ++j)
                 {
@@ -4415,10 +5114,7 @@ void CLJIntraShiftFunction::calcBoxEnergyGeo(const CLJAtoms &atoms, const Vector
                     MultiFloat scale( i == j ? 0.5 : 1.0 );
                 
                     //get the bond mask to screen out bonded interactions
-                    for (int k=0; k<MultiFloat::count(); ++k)
-                    {
-                        bond_mask.quickSet(k, row[ida[j][k]] ? 0.0 : 1.0);
-                    }
+                    bond_mask = row.mask(ida[j]);
                 
                     scale *= bond_mask;
                 
@@ -4640,15 +5336,12 @@ void CLJIntraShiftFunction::calcBoxEnergyGeo(const CLJAtoms &atoms0, const CLJAt
                     const MultiFloat sig(sig0[i][ii]);
                     const MultiFloat eps(eps0[i][ii]);
 
-                    const bool *row = bondMatrix().constData()[id[0]].constData();
+                    const detail::CLJExclusions::Row row = exclusions().row(id[0]);
 
                     for (int j=0; j<n1; ++j)
                     {
                         //create a mask to cancel out calculations of bonded pairs
-                        for (int k=0; k<MultiInt::count(); ++k)
-                        {
-                            bonded_mask.quickSet(k, row[id1[j][k]] ? 0.0 : 1.0);
-                        }
+                        bonded_mask = row.mask(id1[j]);
 
                         //calculate the distance between the fixed and mobile atoms
                         tmp = x1[j] - x;
@@ -4759,7 +5452,7 @@ void CLJIntraShiftFunction::calcVacEnergyAri(const CLJAtoms &atoms,
                 const MultiFloat sig( siga[i][ii] * siga[i][ii] );
                 const MultiFloat eps( epsa[i][ii] );
 
-                const bool *row = bondMatrix().constData()[id[0]].constData();
+                const detail::CLJExclusions::Row row = exclusions().row(id[0]);
 
                 for (int j=i; j<n; ++j)
                 {
@@ -4768,10 +5461,7 @@ void CLJIntraShiftFunction::calcVacEnergyAri(const CLJAtoms &atoms,
                     MultiFloat scale( i == j ? 0.5 : 1.0 );
                 
                     //get the bond mask to screen out bonded interactions
-                    for (int k=0; k<MultiFloat::count(); ++k)
-                    {
-                        bond_mask.quickSet(k, row[ida[j][k]] ? 0.0 : 1.0);
-                    }
+                    bond_mask = row.mask(ida[j]);
                 
                     scale *= bond_mask;
                 
@@ -4973,15 +5663,12 @@ void CLJIntraShiftFunction::calcVacEnergyAri(const CLJAtoms &atoms0, const CLJAt
                     const MultiFloat sig(sig0[i][ii] * sig0[i][ii]);
                     const MultiFloat eps(eps0[i][ii]);
 
-                    const bool *row = bondMatrix().constData()[id[0]].constData();
+                    const detail::CLJExclusions::Row row = exclusions().row(id[0]);
 
                     for (int j=0; j<n1; ++j)
                     {
                         //create a mask to cancel out calculations of bonded pairs
-                        for (int k=0; k<MultiInt::count(); ++k)
-                        {
-                            bonded_mask.quickSet(k, row[id1[j][k]] ? 0.0 : 1.0);
-                        }
+                        bonded_mask = row.mask(id1[j]);
 
                         //calculate the distance between the fixed and mobile atoms
                         tmp = x1[j] - x;
@@ -5097,7 +5784,7 @@ void CLJIntraShiftFunction::calcBoxEnergyAri(const CLJAtoms &atoms, const Vector
                 const MultiFloat sig( siga[i][ii] * siga[i][ii] );
                 const MultiFloat eps( epsa[i][ii] );
 
-                const bool *row = bondMatrix().constData()[id[0]].constData();
+                const detail::CLJExclusions::Row row = exclusions().row(id[0]);
 
                 for (int j=i; j<n; ++j)
                 {
@@ -5106,10 +5793,7 @@ void CLJIntraShiftFunction::calcBoxEnergyAri(const CLJAtoms &atoms, const Vector
                     MultiFloat scale( i == j ? 0.5 : 1.0 );
                 
                     //get the bond mask to screen out bonded interactions
-                    for (int k=0; k<MultiFloat::count(); ++k)
-                    {
-                        bond_mask.quickSet(k, row[ida[j][k]] ? 0.0 : 1.0);
-                    }
+                    bond_mask = row.mask(ida[j]);
                 
                     scale *= bond_mask;
                 
@@ -5339,15 +6023,12 @@ void CLJIntraShiftFunction::calcBoxEnergyAri(const CLJAtoms &atoms0, const CLJAt
                     const MultiFloat sig(sig0[i][ii] * sig0[i][ii]);
                     const MultiFloat eps(eps0[i][ii]);
 
-                    const bool *row = bondMatrix().constData()[id[0]].constData();
+                    const detail::CLJExclusions::Row row = exclusions().row(id[0]);
 
                     for (int j=0; j<n1; ++j)
                     {
                         //create a mask to cancel out calculations of bonded pairs
-                        for (int k=0; k<MultiInt::count(); ++k)
-                        {
-                            bonded_mask.quickSet(k, row[id1[j][k]] ? 0.0 : 1.0);
-                        }
+                        bonded_mask = row.mask(id1[j]);
 
                         //calculate the distance between the fixed and mobile atoms
                         tmp = x1[j] - x;
@@ -5418,6 +6099,98 @@ void CLJIntraShiftFunction::calcBoxEnergyAri(const CLJAtoms &atoms0, const CLJAt
     ljnrg = iljnrg.sum();
 }
 
+/** Return whether or not this function supports calculating forces */
+bool CLJIntraShiftFunction::supportsForceCalculation() const
+{
+    return true;
+}
+
+/** Calculate the intramolecular coulomb and LJ forces between the passed atoms
+    in vacuum using arithmetic combining rules, adding them onto 'forces' */
+void CLJIntraShiftFunction::calcVacForceAri(const CLJAtoms &atoms, CLJForces &forces,
+                                            float scale_coul, float scale_lj) const
+{
+    const detail::ShiftForce func(coul_cutoff, lj_cutoff, scale_coul, scale_lj);
+    detail::cljForce<true,false>(func, atoms, forces, Vector(), &(exclusions()));
+}
+
+/** Calculate the intramolecular coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in vacuum using arithmetic combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJIntraShiftFunction::calcVacForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                            CLJForces &forces0, CLJForces &forces1,
+                                            float scale_coul, float scale_lj) const
+{
+    const detail::ShiftForce func(coul_cutoff, lj_cutoff, scale_coul, scale_lj);
+    detail::cljForce<true,false>(func, atoms0, atoms1, forces0, forces1,
+                                 Vector(), &(exclusions()));
+}
+
+/** Calculate the intramolecular coulomb and LJ forces between the passed atoms
+    in vacuum using geometric combining rules, adding them onto 'forces' */
+void CLJIntraShiftFunction::calcVacForceGeo(const CLJAtoms &atoms, CLJForces &forces,
+                                            float scale_coul, float scale_lj) const
+{
+    const detail::ShiftForce func(coul_cutoff, lj_cutoff, scale_coul, scale_lj);
+    detail::cljForce<false,false>(func, atoms, forces, Vector(), &(exclusions()));
+}
+
+/** Calculate the intramolecular coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in vacuum using geometric combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJIntraShiftFunction::calcVacForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                            CLJForces &forces0, CLJForces &forces1,
+                                            float scale_coul, float scale_lj) const
+{
+    const detail::ShiftForce func(coul_cutoff, lj_cutoff, scale_coul, scale_lj);
+    detail::cljForce<false,false>(func, atoms0, atoms1, forces0, forces1,
+                                  Vector(), &(exclusions()));
+}
+
+/** Calculate the intramolecular coulomb and LJ forces between the passed atoms
+    in a periodic box using arithmetic combining rules, adding them onto 'forces' */
+void CLJIntraShiftFunction::calcBoxForceAri(const CLJAtoms &atoms, const Vector &box_dimensions,
+                                            CLJForces &forces, float scale_coul, float scale_lj) const
+{
+    const detail::ShiftForce func(coul_cutoff, lj_cutoff, scale_coul, scale_lj);
+    detail::cljForce<true,true>(func, atoms, forces, box_dimensions, &(exclusions()));
+}
+
+/** Calculate the intramolecular coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in a periodic box using arithmetic combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJIntraShiftFunction::calcBoxForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                            const Vector &box_dimensions,
+                                            CLJForces &forces0, CLJForces &forces1,
+                                            float scale_coul, float scale_lj) const
+{
+    const detail::ShiftForce func(coul_cutoff, lj_cutoff, scale_coul, scale_lj);
+    detail::cljForce<true,true>(func, atoms0, atoms1, forces0, forces1,
+                                box_dimensions, &(exclusions()));
+}
+
+/** Calculate the intramolecular coulomb and LJ forces between the passed atoms
+    in a periodic box using geometric combining rules, adding them onto 'forces' */
+void CLJIntraShiftFunction::calcBoxForceGeo(const CLJAtoms &atoms, const Vector &box_dimensions,
+                                            CLJForces &forces, float scale_coul, float scale_lj) const
+{
+    const detail::ShiftForce func(coul_cutoff, lj_cutoff, scale_coul, scale_lj);
+    detail::cljForce<false,true>(func, atoms, forces, box_dimensions, &(exclusions()));
+}
+
+/** Calculate the intramolecular coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in a periodic box using geometric combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJIntraShiftFunction::calcBoxForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                            const Vector &box_dimensions,
+                                            CLJForces &forces0, CLJForces &forces1,
+                                            float scale_coul, float scale_lj) const
+{
+    const detail::ShiftForce func(coul_cutoff, lj_cutoff, scale_coul, scale_lj);
+    detail::cljForce<false,true>(func, atoms0, atoms1, forces0, forces1,
+                                 box_dimensions, &(exclusions()));
+}
+
 /////////
 ///////// Implementation of CLJSoftIntraShiftFunction
 /////////
@@ -5603,7 +6376,7 @@ void CLJSoftIntraShiftFunction::calcVacEnergyGeo(const CLJAtoms &atoms,
                 const MultiFloat sig( siga[i][ii] );
                 const MultiFloat eps( epsa[i][ii] );
 
-                const bool *row = bondMatrix().constData()[id[0]].constData();
+                const detail::CLJExclusions::Row row = exclusions().row(id[0]);
 
                 for (int j=i; j<n; ++j)
                 {
@@ -5612,10 +6385,7 @@ void CLJSoftIntraShiftFunction::calcVacEnergyGeo(const CLJAtoms &atoms,
                     MultiFloat scale( i == j ? 0.5 : 1.0 );
                 
                     //get the bond mask to screen out bonded interactions
-                    for (int k=0; k<MultiFloat::count(); ++k)
-                    {
-                        bond_mask.quickSet(k, row[ida[j][k]] ? 0.0 : 1.0);
-                    }
+                    bond_mask = row.mask(ida[j]);
                 
                     scale *= bond_mask;
                 
@@ -5828,15 +6598,12 @@ void CLJSoftIntraShiftFunction::calcVacEnergyGeo(const CLJAtoms &atoms0, const C
                     const MultiFloat sig(sig0[i][ii]);
                     const MultiFloat eps(eps0[i][ii]);
 
-                    const bool *row = bondMatrix().constData()[id[0]].constData();
+                    const detail::CLJExclusions::Row row = exclusions().row(id[0]);
 
                     for (int j=0; j<n1; ++j)
                     {
                         //create a mask to cancel out calculations of bonded pairs
-                        for (int k=0; k<MultiInt::count(); ++k)
-                        {
-                            bonded_mask.quickSet(k, row[id1[j][k]] ? 0.0 : 1.0);
-                        }
+                        bonded_mask = row.mask(id1[j]);
 
                         //calculate the distance^2 between the fixed and mobile atoms
                         tmp = x1[j] - x;
@@ -5961,7 +6728,7 @@ void CLJSoftIntraShiftFunction::calcBoxEnergyGeo(const CLJAtoms &atoms,
                 const MultiFloat sig( siga[i][ii] );
                 const MultiFloat eps( epsa[i][ii] );
 
-                const bool *row = bondMatrix().constData()[id[0]].constData();
+                const detail::CLJExclusions::Row row = exclusions().row(id[0]);
 
                 for (int j=i; j<n; ++j)
                 {
@@ -5970,10 +6737,7 @@ void CLJSoftIntraShiftFunction::calcBoxEnergyGeo(const CLJAtoms &atoms,
                     MultiFloat scale( i == j ? 0.5 : 1.0 );
                 
                     //get the bond mask to screen out bonded interactions
-                    for (int k=0; k<MultiFloat::count(); ++k)
-                    {
-                        bond_mask.quickSet(k, row[ida[j][k]] ? 0.0 : 1.0);
-                    }
+                    bond_mask = row.mask(ida[j]);
                 
                     scale *= bond_mask;
                 
@@ -6212,15 +6976,12 @@ void CLJSoftIntraShiftFunction::calcBoxEnergyGeo(const CLJAtoms &atoms0, const C
                     const MultiFloat sig(sig0[i][ii]);
                     const MultiFloat eps(eps0[i][ii]);
 
-                    const bool *row = bondMatrix().constData()[id[0]].constData();
+                    const detail::CLJExclusions::Row row = exclusions().row(id[0]);
 
                     for (int j=0; j<n1; ++j)
                     {
                         //create a mask to cancel out calculations of bonded pairs
-                        for (int k=0; k<MultiInt::count(); ++k)
-                        {
-                            bonded_mask.quickSet(k, row[id1[j][k]] ? 0.0 : 1.0);
-                        }
+                        bonded_mask = row.mask(id1[j]);
 
                         //calculate the distance^2
                         tmp = x1[j] - x;
@@ -6344,7 +7105,7 @@ void CLJSoftIntraShiftFunction::calcVacEnergyAri(const CLJAtoms &atoms,
                 const MultiFloat sig( siga[i][ii] * siga[i][ii] );
                 const MultiFloat eps( epsa[i][ii] );
 
-                const bool *row = bondMatrix().constData()[id[0]].constData();
+                const detail::CLJExclusions::Row row = exclusions().row(id[0]);
 
                 for (int j=i; j<n; ++j)
                 {
@@ -6353,10 +7114,7 @@ void CLJSoftIntraShiftFunction::calcVacEnergyAri(const CLJAtoms &atoms,
                     MultiFloat scale( i == j ? 0.5 : 1.0 );
                 
                     //get the bond mask to screen out bonded interactions
-                    for (int k=0; k<MultiFloat::count(); ++k)
-                    {
-                        bond_mask.quickSet(k, row[ida[j][k]] ? 0.0 : 1.0);
-                    }
+                    bond_mask = row.mask(ida[j]);
                 
                     scale *= bond_mask;
                 
@@ -6569,15 +7327,12 @@ void CLJSoftIntraShiftFunction::calcVacEnergyAri(const CLJAtoms &atoms0, const C
                     const MultiFloat sig(sig0[i][ii]*sig0[i][ii]);
                     const MultiFloat eps(eps0[i][ii]);
 
-                    const bool *row = bondMatrix().constData()[id[0]].constData();
+                    const detail::CLJExclusions::Row row = exclusions().row(id[0]);
 
                     for (int j=0; j<n1; ++j)
                     {
                         //create a mask to cancel out calculations of bonded pairs
-                        for (int k=0; k<MultiInt::count(); ++k)
-                        {
-                            bonded_mask.quickSet(k, row[id1[j][k]] ? 0.0 : 1.0);
-                        }
+                        bonded_mask = row.mask(id1[j]);
 
                         //calculate the distance^2 between the fixed and mobile atoms
                         tmp = x1[j] - x;
@@ -6702,7 +7457,7 @@ void CLJSoftIntraShiftFunction::calcBoxEnergyAri(const CLJAtoms &atoms,
                 const MultiFloat sig( siga[i][ii]*siga[i][ii] );
                 const MultiFloat eps( epsa[i][ii] );
 
-                const bool *row = bondMatrix().constData()[id[0]].constData();
+                const detail::CLJExclusions::Row row = exclusions().row(id[0]);
 
                 for (int j=i; j<n; ++j)
                 {
@@ -6711,10 +7466,7 @@ void CLJSoftIntraShiftFunction::calcBoxEnergyAri(const CLJAtoms &atoms,
                     MultiFloat scale( i == j ? 0.5 : 1.0 );
                 
                     //get the bond mask to screen out bonded interactions
-                    for (int k=0; k<MultiFloat::count(); ++k)
-                    {
-                        bond_mask.quickSet(k, row[ida[j][k]] ? 0.0 : 1.0);
-                    }
+                    bond_mask = row.mask(ida[j]);
                 
                     scale *= bond_mask;
                 
@@ -6953,15 +7705,12 @@ void CLJSoftIntraShiftFunction::calcBoxEnergyAri(const CLJAtoms &atoms0, const C
                     const MultiFloat sig(sig0[i][ii]*sig0[i][ii]);
                     const MultiFloat eps(eps0[i][ii]);
 
-                    const bool *row = bondMatrix().constData()[id[0]].constData();
+                    const detail::CLJExclusions::Row row = exclusions().row(id[0]);
 
                     for (int j=0; j<n1; ++j)
                     {
                         //create a mask to cancel out calculations of bonded pairs
-                        for (int k=0; k<MultiInt::count(); ++k)
-                        {
-                            bonded_mask.quickSet(k, row[id1[j][k]] ? 0.0 : 1.0);
-                        }
+                        bonded_mask = row.mask(id1[j]);
 
                         //calculate the distance^2
                         tmp = x1[j] - x;
@@ -7031,3 +7780,105 @@ void CLJSoftIntraShiftFunction::calcBoxEnergyAri(const CLJAtoms &atoms0, const C
     cnrg = icnrg.sum();
     ljnrg = iljnrg.sum();
 }
+
+/** Return whether or not this function supports calculating forces */
+bool CLJSoftIntraShiftFunction::supportsForceCalculation() const
+{
+    return true;
+}
+
+/** Calculate the intramolecular soft-core coulomb and LJ forces between the passed atoms
+    in vacuum using arithmetic combining rules, adding them onto 'forces' */
+void CLJSoftIntraShiftFunction::calcVacForceAri(const CLJAtoms &atoms, CLJForces &forces,
+                                                float scale_coul, float scale_lj) const
+{
+    const detail::SoftShiftForce func(coul_cutoff, lj_cutoff, alpha(), oneMinusAlphaToN(),
+                                      alphaTimesShiftDelta(), scale_coul, scale_lj);
+    detail::cljForce<true,false>(func, atoms, forces, Vector(), &(exclusions()));
+}
+
+/** Calculate the intramolecular soft-core coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in vacuum using arithmetic combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJSoftIntraShiftFunction::calcVacForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                                CLJForces &forces0, CLJForces &forces1,
+                                                float scale_coul, float scale_lj) const
+{
+    const detail::SoftShiftForce func(coul_cutoff, lj_cutoff, alpha(), oneMinusAlphaToN(),
+                                      alphaTimesShiftDelta(), scale_coul, scale_lj);
+    detail::cljForce<true,false>(func, atoms0, atoms1, forces0, forces1,
+                                 Vector(), &(exclusions()));
+}
+
+/** Calculate the intramolecular soft-core coulomb and LJ forces between the passed atoms
+    in vacuum using geometric combining rules, adding them onto 'forces' */
+void CLJSoftIntraShiftFunction::calcVacForceGeo(const CLJAtoms &atoms, CLJForces &forces,
+                                                float scale_coul, float scale_lj) const
+{
+    const detail::SoftShiftForce func(coul_cutoff, lj_cutoff, alpha(), oneMinusAlphaToN(),
+                                      alphaTimesShiftDelta(), scale_coul, scale_lj);
+    detail::cljForce<false,false>(func, atoms, forces, Vector(), &(exclusions()));
+}
+
+/** Calculate the intramolecular soft-core coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in vacuum using geometric combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJSoftIntraShiftFunction::calcVacForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                                CLJForces &forces0, CLJForces &forces1,
+                                                float scale_coul, float scale_lj) const
+{
+    const detail::SoftShiftForce func(coul_cutoff, lj_cutoff, alpha(), oneMinusAlphaToN(),
+                                      alphaTimesShiftDelta(), scale_coul, scale_lj);
+    detail::cljForce<false,false>(func, atoms0, atoms1, forces0, forces1,
+                                  Vector(), &(exclusions()));
+}
+
+/** Calculate the intramolecular soft-core coulomb and LJ forces between the passed atoms
+    in a periodic box using arithmetic combining rules, adding them onto 'forces' */
+void CLJSoftIntraShiftFunction::calcBoxForceAri(const CLJAtoms &atoms, const Vector &box_dimensions,
+                                                CLJForces &forces, float scale_coul, float scale_lj) const
+{
+    const detail::SoftShiftForce func(coul_cutoff, lj_cutoff, alpha(), oneMinusAlphaToN(),
+                                      alphaTimesShiftDelta(), scale_coul, scale_lj);
+    detail::cljForce<true,true>(func, atoms, forces, box_dimensions, &(exclusions()));
+}
+
+/** Calculate the intramolecular soft-core coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in a periodic box using arithmetic combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJSoftIntraShiftFunction::calcBoxForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                                const Vector &box_dimensions,
+                                                CLJForces &forces0, CLJForces &forces1,
+                                                float scale_coul, float scale_lj) const
+{
+    const detail::SoftShiftForce func(coul_cutoff, lj_cutoff, alpha(), oneMinusAlphaToN(),
+                                      alphaTimesShiftDelta(), scale_coul, scale_lj);
+    detail::cljForce<true,true>(func, atoms0, atoms1, forces0, forces1,
+                                box_dimensions, &(exclusions()));
+}
+
+/** Calculate the intramolecular soft-core coulomb and LJ forces between the passed atoms
+    in a periodic box using geometric combining rules, adding them onto 'forces' */
+void CLJSoftIntraShiftFunction::calcBoxForceGeo(const CLJAtoms &atoms, const Vector &box_dimensions,
+                                                CLJForces &forces, float scale_coul, float scale_lj) const
+{
+    const detail::SoftShiftForce func(coul_cutoff, lj_cutoff, alpha(), oneMinusAlphaToN(),
+                                      alphaTimesShiftDelta(), scale_coul, scale_lj);
+    detail::cljForce<false,true>(func, atoms, forces, box_dimensions, &(exclusions()));
+}
+
+/** Calculate the intramolecular soft-core coulomb and LJ forces between the atoms
+    in 'atoms0' and 'atoms1' in a periodic box using geometric combining rules,
+    adding them onto 'forces0' and 'forces1' */
+void CLJSoftIntraShiftFunction::calcBoxForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                                                const Vector &box_dimensions,
+                                                CLJForces &forces0, CLJForces &forces1,
+                                                float scale_coul, float scale_lj) const
+{
+    const detail::SoftShiftForce func(coul_cutoff, lj_cutoff, alpha(), oneMinusAlphaToN(),
+                                      alphaTimesShiftDelta(), scale_coul, scale_lj);
+    detail::cljForce<false,true>(func, atoms0, atoms1, forces0, forces1,
+                                 box_dimensions, &(exclusions()));
+}
+
+#endif // #ifndef SIRE_KERNEL_ISA
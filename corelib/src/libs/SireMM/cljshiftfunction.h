@@ -100,6 +100,8 @@ public:
     
     CLJShiftFunction* clone() const;
 
+    bool supportsForceCalculation() const;
+
     bool supportsGridCalculation() const;
 
     static CLJFunctionPtr defaultShiftFunction();
@@ -145,6 +147,32 @@ protected:
     void calcBoxGrid(const CLJAtoms &atoms, const GridInfo &gridinfo,
                      const Vector &box_dimensions,
                      const int start, const int end, float *gridpot) const;
+
+    void calcVacForceAri(const CLJAtoms &atoms, CLJForces &forces,
+                         float scale_coul, float scale_lj) const;
+    void calcVacForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
+
+    void calcVacForceGeo(const CLJAtoms &atoms, CLJForces &forces,
+                         float scale_coul, float scale_lj) const;
+    void calcVacForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
+
+    void calcBoxForceAri(const CLJAtoms &atoms, const Vector &box_dimensions,
+                         CLJForces &forces, float scale_coul, float scale_lj) const;
+    void calcBoxForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         const Vector &box_dimensions,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
+
+    void calcBoxForceGeo(const CLJAtoms &atoms, const Vector &box_dimensions,
+                         CLJForces &forces, float scale_coul, float scale_lj) const;
+    void calcBoxForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         const Vector &box_dimensions,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
 };
 
 /** This CLJFunction calculates the intramolecular coulomb and LJ energy of the passed
@@ -189,6 +217,8 @@ public:
     
     CLJIntraShiftFunction* clone() const;
 
+    bool supportsForceCalculation() const;
+
     static CLJFunctionPtr defaultShiftFunction();
 
 protected:
@@ -217,6 +247,32 @@ protected:
     void calcBoxEnergyGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
                           const Vector &box_dimensions, double &cnrg, double &ljnrg,
                           float min_distance) const;
+
+    void calcVacForceAri(const CLJAtoms &atoms, CLJForces &forces,
+                         float scale_coul, float scale_lj) const;
+    void calcVacForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
+
+    void calcVacForceGeo(const CLJAtoms &atoms, CLJForces &forces,
+                         float scale_coul, float scale_lj) const;
+    void calcVacForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
+
+    void calcBoxForceAri(const CLJAtoms &atoms, const Vector &box_dimensions,
+                         CLJForces &forces, float scale_coul, float scale_lj) const;
+    void calcBoxForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         const Vector &box_dimensions,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
+
+    void calcBoxForceGeo(const CLJAtoms &atoms, const Vector &box_dimensions,
+                         CLJForces &forces, float scale_coul, float scale_lj) const;
+    void calcBoxForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         const Vector &box_dimensions,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
 };
 
 
@@ -265,6 +321,8 @@ public:
     
     CLJSoftShiftFunction* clone() const;
 
+    bool supportsForceCalculation() const;
+
     static CLJFunctionPtr defaultShiftFunction();
 
 protected:
@@ -293,6 +351,32 @@ protected:
     void calcBoxEnergyGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
                           const Vector &box_dimensions, double &cnrg, double &ljnrg,
                           float min_distance) const;
+
+    void calcVacForceAri(const CLJAtoms &atoms, CLJForces &forces,
+                         float scale_coul, float scale_lj) const;
+    void calcVacForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
+
+    void calcVacForceGeo(const CLJAtoms &atoms, CLJForces &forces,
+                         float scale_coul, float scale_lj) const;
+    void calcVacForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
+
+    void calcBoxForceAri(const CLJAtoms &atoms, const Vector &box_dimensions,
+                         CLJForces &forces, float scale_coul, float scale_lj) const;
+    void calcBoxForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         const Vector &box_dimensions,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
+
+    void calcBoxForceGeo(const CLJAtoms &atoms, const Vector &box_dimensions,
+                         CLJForces &forces, float scale_coul, float scale_lj) const;
+    void calcBoxForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         const Vector &box_dimensions,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
 };
 
 /** This CLJFunction calculates the intramolecular coulomb and LJ energy of the passed
@@ -339,6 +423,8 @@ public:
     
     CLJSoftIntraShiftFunction* clone() const;
 
+    bool supportsForceCalculation() const;
+
     static CLJFunctionPtr defaultShiftFunction();
 
 protected:
@@ -367,6 +453,32 @@ protected:
     void calcBoxEnergyGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
                           const Vector &box_dimensions, double &cnrg, double &ljnrg,
                           float min_distance) const;
+
+    void calcVacForceAri(const CLJAtoms &atoms, CLJForces &forces,
+                         float scale_coul, float scale_lj) const;
+    void calcVacForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
+
+    void calcVacForceGeo(const CLJAtoms &atoms, CLJForces &forces,
+                         float scale_coul, float scale_lj) const;
+    void calcVacForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
+
+    void calcBoxForceAri(const CLJAtoms &atoms, const Vector &box_dimensions,
+                         CLJForces &forces, float scale_coul, float scale_lj) const;
+    void calcBoxForceAri(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         const Vector &box_dimensions,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
+
+    void calcBoxForceGeo(const CLJAtoms &atoms, const Vector &box_dimensions,
+                         CLJForces &forces, float scale_coul, float scale_lj) const;
+    void calcBoxForceGeo(const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                         const Vector &box_dimensions,
+                         CLJForces &forces0, CLJForces &forces1,
+                         float scale_coul, float scale_lj) const;
 };
 
 }
@@ -0,0 +1,190 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#include "cljexclusions.h"
+
+#include "SireMol/connectivity.h"
+#include "SireMol/moleculeinfodata.h"
+#include "SireMol/atomidx.h"
+
+#include <algorithm>
+
+using namespace SireMM;
+using namespace SireMM::detail;
+using namespace SireMol;
+
+/** Constructor */
+CLJExclusions::CLJExclusions()
+{}
+
+/** Construct the exclusions for the molecule with the passed connectivity.
+    The excluded atoms of each atom are found by walking out over the
+    bonds to a depth of three, which gives the same pairs as 
+    Connectivity::getBondMatrix(1,4), without ever building the 
+    (N x N) matrix */
+CLJExclusions::CLJExclusions(const Connectivity &connectivity)
+{
+    const int nats = connectivity.info().nAtoms();
+
+    if (nats == 0)
+        return;
+
+    //ID 0 is the dummy atom, so IDs run from 1 to nats
+    offsets = QVector<qint32>(nats + 2, 0);
+    excluded.reserve(16 * nats);
+
+    QVector<qint32> seen(nats, -1);
+    QVector<qint32> atoms, shell, next;
+
+    qint32 *offs = offsets.data();
+    qint32 *s = seen.data();
+
+    for (int i=0; i<nats; ++i)
+    {
+        atoms.clear();
+        shell.clear();
+
+        s[i] = i;
+        atoms.append(i);
+        shell.append(i);
+
+        for (int depth=0; depth<3; ++depth)
+        {
+            next.clear();
+
+            foreach (qint32 atom, shell)
+            {
+                foreach (const AtomIdx &bonded, connectivity.connectionsTo(AtomIdx(atom)))
+                {
+                    const qint32 j = bonded.value();
+
+                    if (s[j] != i)
+                    {
+                        s[j] = i;
+                        atoms.append(j);
+                        next.append(j);
+                    }
+                }
+            }
+
+            qSwap(shell, next);
+        }
+
+        std::sort(atoms.begin(), atoms.end());
+
+        foreach (qint32 atom, atoms)
+        {
+            excluded.append(atom + 1);
+        }
+
+        offs[i+2] = excluded.count();
+    }
+
+    excluded.squeeze();
+}
+
+/** Copy constructor */
+CLJExclusions::CLJExclusions(const CLJExclusions &other)
+              : offsets(other.offsets), excluded(other.excluded)
+{}
+
+/** Destructor */
+CLJExclusions::~CLJExclusions()
+{}
+
+/** Copy assignment operator */
+CLJExclusions& CLJExclusions::operator=(const CLJExclusions &other)
+{
+    offsets = other.offsets;
+    excluded = other.excluded;
+    return *this;
+}
+
+/** Comparison operator */
+bool CLJExclusions::operator==(const CLJExclusions &other) const
+{
+    return offsets == other.offsets and excluded == other.excluded;
+}
+
+/** Comparison operator */
+bool CLJExclusions::operator!=(const CLJExclusions &other) const
+{
+    return not operator==(other);
+}
+
+/** Return the number of atoms covered by these exclusions */
+int CLJExclusions::nAtoms() const
+{
+    return qMax(0, offsets.count() - 2);
+}
+
+/** Return the total number of excluded pairs (each pair is counted
+    twice, and each atom is excluded from itself) */
+int CLJExclusions::nExcluded() const
+{
+    return excluded.count();
+}
+
+/** Return whether or not any pair of atoms in 'ids0' and 'ids1' are excluded */
+bool CLJExclusions::anyExcluded(const QVector<MultiInt> &ids0,
+                                const QVector<MultiInt> &ids1) const
+{
+    if (this->isEmpty())
+        return false;
+
+    const int nats0 = ids0.count();
+    const int nats1 = ids1.count();
+    
+    const MultiInt *aid0 = ids0.constData();
+    const MultiInt *aid1 = ids1.constData();
+    
+    for (int i=0; i<nats0; ++i)
+    {
+        for (int ii=0; ii<MultiInt::count(); ++ii)
+        {
+            const Row r = this->row(aid0[i][ii]);
+
+            if (r.isEmpty())
+                continue;
+
+            for (int j=0; j<nats1; ++j)
+            {
+                if (r.overlaps(aid1[j]))
+                {
+                    for (int jj=0; jj<MultiInt::count(); ++jj)
+                    {
+                        if (r[aid1[j][jj]])
+                            return true;
+                    }
+                }
+            }
+        }
+    }
+    
+    return false;
+}
@@ -0,0 +1,240 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#ifndef SIREMM_DETAIL_CLJEXCLUSIONS_H
+#define SIREMM_DETAIL_CLJEXCLUSIONS_H
+
+#include "SireMaths/multifloat.h"
+#include "SireMaths/multiint.h"
+
+#include <QVector>
+
+#include <algorithm>
+
+SIRE_BEGIN_HEADER
+
+namespace SireMol
+{
+class Connectivity;
+}
+
+namespace SireMM
+{
+namespace detail
+{
+
+using SireMaths::MultiFloat;
+using SireMaths::MultiInt;
+
+/** This class holds the pairs of atoms in a molecule that are excluded
+    from the intramolecular CLJ calculation (the atom itself, plus all
+    atoms that are bonded, angled or dihedraled to it).
+
+    The exclusions are stored as a sorted list of excluded atoms
+    for each atom (compressed sparse row), so the memory scales with
+    the number of atoms rather than the square of the number of atoms.
+    As the kernels work with CLJAtoms, the atoms are identified using
+    their AtomIdx + 1, with ID 0 being used for dummy atoms (which
+    are never excluded)
+
+    @author Christopher Woods
+*/
+class SIREMM_EXPORT CLJExclusions
+{
+public:
+    /** This is a light-weight view of the exclusions of a single atom.
+        It stores the range of IDs of the excluded atoms, so that whole
+        blocks of atoms that lie outside this range (which is the
+        case for nearly all atoms of a large molecule) can be
+        tested with a single vector comparison */
+    class Row
+    {
+    public:
+        Row() : excl(0), n(0), lo(1), hi(0), lo_id(1), hi_id(0)
+        {}
+
+        Row(const qint32 *excluded, qint32 nexcluded)
+            : excl(excluded), n(nexcluded),
+              lo(excluded[0]), hi(excluded[nexcluded-1]),
+              lo_id(excluded[0]), hi_id(excluded[nexcluded-1])
+        {}
+
+        /** Return whether or not this atom has no exclusions */
+        bool isEmpty() const
+        {
+            return n == 0;
+        }
+
+        /** Return whether or not the atom with ID 'id' is excluded */
+        bool operator[](qint32 id) const
+        {
+            if (id < lo or id > hi)
+                return false;
+            else
+                return std::binary_search(excl, excl + n, id);
+        }
+
+        /** Return whether or not any of the atoms in 'ids' lies within
+            the range of the excluded atoms (and so may be excluded) */
+        bool overlaps(const MultiInt &ids) const
+        {
+            return n != 0 and
+                   not ( ids.compareGreaterEqual(lo_id) &
+                         ids.compareLessEqual(hi_id) ).isBinaryZero();
+        }
+
+        /** Return the mask for the atoms in 'ids', which is 0 for the
+            atoms that are excluded and 1 for all other atoms */
+        MultiFloat mask(const MultiInt &ids) const
+        {
+            MultiFloat m(1);
+
+            if (overlaps(ids))
+            {
+                for (int k=0; k<MultiInt::count(); ++k)
+                {
+                    if (this->operator[](ids[k]))
+                        m.quickSet(k, 0);
+                }
+            }
+
+            return m;
+        }
+
+    private:
+        /** Pointer to the sorted IDs of the excluded atoms */
+        const qint32 *excl;
+
+        /** The number of excluded atoms */
+        qint32 n;
+
+        /** The smallest and largest excluded IDs */
+        qint32 lo, hi;
+
+        /** The smallest and largest excluded IDs, broadcast
+            across a vector */
+        MultiInt lo_id, hi_id;
+    };
+
+    CLJExclusions();
+    CLJExclusions(const SireMol::Connectivity &connectivity);
+
+    CLJExclusions(const CLJExclusions &other);
+
+    ~CLJExclusions();
+
+    CLJExclusions& operator=(const CLJExclusions &other);
+
+    bool operator==(const CLJExclusions &other) const;
+    bool operator!=(const CLJExclusions &other) const;
+
+    bool isEmpty() const;
+
+    int nAtoms() const;
+    int nExcluded() const;
+
+    Row row(qint32 id) const;
+
+    bool areExcluded(qint32 id0, qint32 id1) const;
+    bool anyExcluded(qint32 id0, const MultiInt &id1) const;
+    bool anyExcluded(const MultiInt &id0, const MultiInt &id1) const;
+    bool anyExcluded(const QVector<MultiInt> &ids0,
+                     const QVector<MultiInt> &ids1) const;
+
+private:
+    /** The index into 'excluded' of the first excluded atom
+        of the atom with each ID */
+    QVector<qint32> offsets;
+
+    /** The sorted IDs of the excluded atoms of each atom */
+    QVector<qint32> excluded;
+};
+
+/** Return whether or not there are no exclusions */
+inline bool CLJExclusions::isEmpty() const
+{
+    return excluded.isEmpty();
+}
+
+/** Return the exclusions of the atom with ID 'id'. This is empty
+    for the dummy atom, or for any ID that is out of range */
+inline CLJExclusions::Row CLJExclusions::row(qint32 id) const
+{
+    if (id <= 0 or id >= offsets.count() - 1)
+        return Row();
+
+    const qint32 start = offsets.constData()[id];
+    const qint32 n = offsets.constData()[id+1] - start;
+
+    if (n == 0)
+        return Row();
+    else
+        return Row(excluded.constData() + start, n);
+}
+
+/** Return whether or not the atoms with IDs 'id0' and 'id1' are excluded */
+inline bool CLJExclusions::areExcluded(qint32 id0, qint32 id1) const
+{
+    return this->row(id0)[id1];
+}
+
+/** Return whether or not any of the atoms in 'id1' are excluded from 'id0' */
+inline bool CLJExclusions::anyExcluded(qint32 id0, const MultiInt &id1) const
+{
+    const Row r = this->row(id0);
+
+    if (r.overlaps(id1))
+    {
+        for (int i=0; i<MultiInt::count(); ++i)
+        {
+            if (r[id1[i]])
+                return true;
+        }
+    }
+
+    return false;
+}
+
+/** Return whether or not any pair of atoms in 'id0' and 'id1' are excluded */
+inline bool CLJExclusions::anyExcluded(const MultiInt &id0, const MultiInt &id1) const
+{
+    for (int i=0; i<MultiInt::count(); ++i)
+    {
+        if (this->anyExcluded(id0[i], id1))
+            return true;
+    }
+
+    return false;
+}
+
+} // end of namespace detail
+} // end of namespace SireMM
+
+SIRE_END_HEADER
+
+#endif
@@ -0,0 +1,299 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2014  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#ifndef SIREMM_DETAIL_CLJFORCEKERNEL_HPP
+#define SIREMM_DETAIL_CLJFORCEKERNEL_HPP
+
+#include "SireMM/cljatoms.h"
+#include "SireMM/cljforces.h"
+#include "SireMM/detail/cljexclusions.h"
+
+#include "SireMaths/multifloat.h"
+#include "SireMaths/multiint.h"
+
+SIRE_BEGIN_HEADER
+
+namespace SireMM
+{
+
+namespace detail
+{
+
+using SireMaths::MultiFloat;
+using SireMaths::MultiInt;
+using SireMaths::Vector;
+
+/** Return the (signed) separation x1 - x0 along one axis. If USE_BOX
+    is true then this is the minimum image separation in a periodic
+    box with side length 'box' */
+template<bool USE_BOX>
+inline MultiFloat cljSeparation(const MultiFloat &x1, const MultiFloat &x0,
+                                const MultiFloat &box, const MultiFloat &half_box)
+{
+    MultiFloat d = x1 - x0;
+    
+    if (USE_BOX)
+    {
+        d -= box.logicalAnd( half_box.compareLess(d) );
+        d += box.logicalAnd( d.compareLess(-half_box) );
+    }
+    
+    return d;
+}
+
+/** This is the kernel used by all of the CLJFunctions to calculate the 
+    coulomb and LJ forces between the atoms in 'atoms0' and 'atoms1'. This
+    follows the same loop structure as the energy kernels, i.e. the
+    atoms in 'atoms0' are broadcast one at a time and are compared against
+    the vectorised atoms in 'atoms1'.
+    
+    The actual functional form is supplied by FORCEFUNC, which must provide
+    the functions;
+    
+        bool hasCoulomb() const;
+        bool hasLJ() const;
+    
+        MultiFloat coulomb(const MultiFloat &r2, const MultiFloat &q0q1) const;
+        MultiFloat lj(const MultiFloat &r2, const MultiFloat &sigma,
+                      const MultiFloat &eps0eps1) const;
+    
+    which return -(dE/dr) / r for the pair of atoms (with any cutoff
+    already applied). The force on atom 1 is then this value multiplied
+    by the separation vector (r1 - r0), with an equal and opposite force on atom 0.
+    
+    If 'exclusions' is not null, then the atom IDs are assumed to be
+    AtomIdx + 1, and pairs that are excluded in the exclusion lists are
+    removed (this is used by the intramolecular functions).
+    
+    If IS_SELF is true then this calculates the forces within 'atoms0', and
+    'atoms1' and 'forces1' must be the same objects as 'atoms0' and 'forces0'.
+    
+    Forces are added onto the values already in 'forces0' and 'forces1'
+*/
+template<class FORCEFUNC, bool USE_ARITHMETIC, bool USE_BOX, bool IS_SELF>
+void cljForceKernel(const FORCEFUNC &func,
+                    const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+                    CLJForces &forces0, CLJForces &forces1,
+                    const Vector &box_dimensions,
+                    const CLJExclusions *exclusions)
+{
+    const MultiFloat *x0 = atoms0.x().constData();
+    const MultiFloat *y0 = atoms0.y().constData();
+    const MultiFloat *z0 = atoms0.z().constData();
+    const MultiFloat *q0 = atoms0.q().constData();
+    const MultiFloat *sig0 = atoms0.sigma().constData();
+    const MultiFloat *eps0 = atoms0.epsilon().constData();
+    const MultiInt *id0 = atoms0.ID().constData();
+
+    const MultiFloat *x1 = atoms1.x().constData();
+    const MultiFloat *y1 = atoms1.y().constData();
+    const MultiFloat *z1 = atoms1.z().constData();
+    const MultiFloat *q1 = atoms1.q().constData();
+    const MultiFloat *sig1 = atoms1.sigma().constData();
+    const MultiFloat *eps1 = atoms1.epsilon().constData();
+    const MultiInt *id1 = atoms1.ID().constData();
+
+    MultiFloat *fx0 = forces0.xData();
+    MultiFloat *fy0 = forces0.yData();
+    MultiFloat *fz0 = forces0.zData();
+    
+    MultiFloat *fx1 = forces1.xData();
+    MultiFloat *fy1 = forces1.yData();
+    MultiFloat *fz1 = forces1.zData();
+
+    const MultiFloat half(0.5);
+    const MultiFloat zero(0);
+    const MultiInt dummy_id = CLJAtoms::idOfDummy();
+    const qint32 dummy_int = dummy_id[0];
+
+    const MultiFloat box_x( box_dimensions.x() );
+    const MultiFloat box_y( box_dimensions.y() );
+    const MultiFloat box_z( box_dimensions.z() );
+    
+    const MultiFloat half_box_x( 0.5 * box_dimensions.x() );
+    const MultiFloat half_box_y( 0.5 * box_dimensions.y() );
+    const MultiFloat half_box_z( 0.5 * box_dimensions.z() );
+
+    const bool calc_coul = func.hasCoulomb();
+    const bool calc_lj = func.hasLJ();
+
+    MultiFloat dx, dy, dz, r2, sigma, fmag;
+    MultiFloat ifx, ify, ifz;
+    MultiInt itmp;
+
+    const int n0 = atoms0.x().count();
+    const int n1 = atoms1.x().count();
+
+    for (int i=0; i<n0; ++i)
+    {
+        for (int ii=0; ii<MultiFloat::count(); ++ii)
+        {
+            if (id0[i][ii] == dummy_int)
+                continue;
+
+            const bool has_coul = calc_coul and (q0[i][ii] != 0);
+            const bool has_lj = calc_lj and (eps0[i][ii] != 0);
+            
+            if (not (has_coul or has_lj))
+                continue;
+        
+            const MultiInt id(id0[i][ii]);
+            const MultiFloat x(x0[i][ii]);
+            const MultiFloat y(y0[i][ii]);
+            const MultiFloat z(z0[i][ii]);
+            const MultiFloat q(q0[i][ii]);
+            const MultiFloat sig( USE_ARITHMETIC ? sig0[i][ii] * sig0[i][ii]
+                                                 : sig0[i][ii] );
+            const MultiFloat eps(eps0[i][ii]);
+            
+            CLJExclusions::Row row;
+            
+            if (exclusions)
+                row = exclusions->row(id0[i][ii]);
+
+            ifx = zero;
+            ify = zero;
+            ifz = zero;
+
+            for (int j = (IS_SELF ? i : 0); j<n1; ++j)
+            {
+                //calculate the separation of the atoms
+                dx = cljSeparation<USE_BOX>(x1[j], x, box_x, half_box_x);
+                dy = cljSeparation<USE_BOX>(y1[j], y, box_y, half_box_y);
+                dz = cljSeparation<USE_BOX>(z1[j], z, box_z, half_box_z);
+                
+                r2 = dx * dx;
+                r2.multiplyAdd(dy, dy);
+                r2.multiplyAdd(dz, dz);
+
+                if (has_coul)
+                {
+                    fmag = func.coulomb(r2, q * q1[j]);
+                }
+                else
+                {
+                    fmag = zero;
+                }
+                
+                if (has_lj)
+                {
+                    if (USE_ARITHMETIC)
+                    {
+                        sigma = sig + (sig1[j]*sig1[j]);
+                        sigma *= half;
+                    }
+                    else
+                    {
+                        sigma = sig * sig1[j];
+                    }
+                    
+                    fmag += func.lj(r2, sigma, eps * eps1[j]);
+                }
+
+                //make sure that the ID of atoms1 is not zero, and is
+                //also not the same as the atoms0. This has to be a bitwise
+                //mask so that any NaNs from r == 0 are removed
+                itmp = id1[j].compareEqual(dummy_id);
+                itmp |= id1[j].compareEqual(id);
+                
+                fmag = fmag.logicalAndNot(itmp);
+                
+                if (row.overlaps(id1[j]))
+                {
+                    //remove the bonded pairs
+                    fmag *= row.mask(id1[j]);
+                }
+                
+                if (IS_SELF and i == j)
+                {
+                    //every pair in this block is seen twice
+                    fmag *= half;
+                }
+                
+                //the force on atom1 is along the separation vector,
+                //with the equal and opposite force on atom0
+                dx *= fmag;
+                dy *= fmag;
+                dz *= fmag;
+                
+                fx1[j] += dx;
+                fy1[j] += dy;
+                fz1[j] += dz;
+                
+                ifx -= dx;
+                ify -= dy;
+                ifz -= dz;
+            }
+            
+            fx0[i].quickSet(ii, fx0[i][ii] + ifx.sum());
+            fy0[i].quickSet(ii, fy0[i][ii] + ify.sum());
+            fz0[i].quickSet(ii, fz0[i][ii] + ifz.sum());
+        }
+    }
+}
+
+/** Calculate the forces between the atoms in 'atoms', adding them onto 'forces' */
+template<bool USE_ARITHMETIC, bool USE_BOX, class FORCEFUNC>
+void cljForce(const FORCEFUNC &func, const CLJAtoms &atoms, CLJForces &forces,
+              const Vector &box_dimensions,
+              const CLJExclusions *exclusions = 0)
+{
+    if (forces.isEmpty())
+        forces = CLJForces(atoms);
+
+    cljForceKernel<FORCEFUNC,USE_ARITHMETIC,USE_BOX,true>(func, atoms, atoms,
+                                                          forces, forces,
+                                                          box_dimensions, exclusions);
+}
+
+/** Calculate the forces between the atoms in 'atoms0' and 'atoms1', adding
+    them onto 'forces0' and 'forces1' */
+template<bool USE_ARITHMETIC, bool USE_BOX, class FORCEFUNC>
+void cljForce(const FORCEFUNC &func, const CLJAtoms &atoms0, const CLJAtoms &atoms1,
+              CLJForces &forces0, CLJForces &forces1,
+              const Vector &box_dimensions,
+              const CLJExclusions *exclusions = 0)
+{
+    if (forces0.isEmpty())
+        forces0 = CLJForces(atoms0);
+    
+    if (forces1.isEmpty())
+        forces1 = CLJForces(atoms1);
+
+    cljForceKernel<FORCEFUNC,USE_ARITHMETIC,USE_BOX,false>(func, atoms0, atoms1,
+                                                           forces0, forces1,
+                                                           box_dimensions, exclusions);
+}
+
+} // end of namespace detail
+
+} // end of namespace SireMM
+
+SIRE_END_HEADER
+
+#endif
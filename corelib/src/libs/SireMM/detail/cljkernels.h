@@ -0,0 +1,256 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#ifndef SIREMM_DETAIL_CLJKERNELS_H
+#define SIREMM_DETAIL_CLJKERNELS_H
+
+#include "sireglobal.h"
+
+/** The vectorised CLJ kernels in cljshiftfunction.cpp, cljrffunction.cpp
+    and cljfunction.cpp are compiled once for the baseline instruction set,
+    and, if SIRE_VECTOR_DISPATCH is set, again for each of the instruction
+    sets listed below (with SIRE_KERNEL_ISA set to the name of the
+    instruction set). The fastest set of kernels supported by the
+    processor is chosen when the kernels are first used.
+
+    Only the plain data structures in this file are passed between the
+    different compilations, as the vector classes (MultiFloat etc.) are
+    different types, with different widths, in each compilation. The
+    packed atoms are repacked to the width of the chosen kernels
+    if needed (see CLJKernelAtomsData) */
+#ifdef SIRE_KERNEL_ISA
+    #define SIRE_KERNEL_NAMESPACE SIRE_KERNEL_ISA
+#else
+    #define SIRE_KERNEL_NAMESPACE baseline
+#endif
+
+SIRE_BEGIN_HEADER
+
+#ifndef SIRE_KERNEL_ISA
+namespace SireMaths
+{
+class Vector;
+}
+
+namespace SireVol
+{
+class GridInfo;
+}
+#endif
+
+namespace SireMM
+{
+
+#ifndef SIRE_KERNEL_ISA
+class CLJAtoms;
+#endif
+
+namespace detail
+{
+
+/** The packed coordinates and parameters of a CLJAtoms object. Each
+    array holds 'count' values, where 'count' is a multiple of the
+    vector width of the kernels, and each array is aligned to that
+    vector width. 'dummy_id' is the ID used for dummy (padding) atoms */
+struct CLJKernelAtoms
+{
+    const float *x;
+    const float *y;
+    const float *z;
+    const float *q;
+    const float *sig;
+    const float *eps;
+    const qint32 *id;
+    int count;
+    qint32 dummy_id;
+};
+
+/** A point or the dimensions of a periodic box */
+struct CLJKernelVector
+{
+    double x;
+    double y;
+    double z;
+};
+
+/** The origin, spacing and dimensions of a GridInfo */
+struct CLJKernelGrid
+{
+    double origin[3];
+    float spacing;
+    qint32 dimx;
+    qint32 dimy;
+    qint32 dimz;
+};
+
+/** The closest distance between a grid point and an atom that is used
+    when building the coulomb and LJ grids. This stops the 1/r and r^-12 
+    terms from overflowing for grid points that sit on top of atoms */
+const float clj_grid_min_distance = 0.5;
+
+/** The parameters of the CLJFunction used by the kernels */
+struct CLJKernelParams
+{
+    float coul_cutoff;
+    float lj_cutoff;
+    float dielectric;
+};
+
+typedef void (*CLJEnergyKernel)(const CLJKernelParams &params,
+                                const CLJKernelAtoms &atoms,
+                                double &cnrg, double &ljnrg);
+
+typedef void (*CLJEnergyKernel2)(const CLJKernelParams &params,
+                                 const CLJKernelAtoms &atoms0,
+                                 const CLJKernelAtoms &atoms1,
+                                 double &cnrg, double &ljnrg);
+
+typedef void (*CLJBoxEnergyKernel)(const CLJKernelParams &params,
+                                   const CLJKernelAtoms &atoms,
+                                   const CLJKernelVector &box_dimensions,
+                                   double &cnrg, double &ljnrg);
+
+typedef void (*CLJBoxEnergyKernel2)(const CLJKernelParams &params,
+                                    const CLJKernelAtoms &atoms0,
+                                    const CLJKernelAtoms &atoms1,
+                                    const CLJKernelVector &box_dimensions,
+                                    double &cnrg, double &ljnrg);
+
+typedef double (*CLJPartEnergyKernel)(const CLJKernelParams &params,
+                                      const CLJKernelAtoms &atoms);
+
+typedef double (*CLJPartEnergyKernel2)(const CLJKernelParams &params,
+                                       const CLJKernelAtoms &atoms0,
+                                       const CLJKernelAtoms &atoms1);
+
+typedef void (*CLJGridKernel)(const CLJKernelParams &params,
+                              const CLJKernelAtoms &atoms,
+                              const CLJKernelGrid &grid_info,
+                              int start, int end, float *gridpot_array);
+
+typedef void (*CLJBoxGridKernel)(const CLJKernelParams &params,
+                                 const CLJKernelAtoms &atoms,
+                                 const CLJKernelGrid &grid_info,
+                                 const CLJKernelVector &box_dimensions,
+                                 int start, int end, float *gridpot_array);
+
+typedef void (*CLJLJGridKernel)(const CLJKernelAtoms &atoms,
+                                const CLJKernelGrid &grid_info,
+                                const CLJKernelVector &box_dimensions,
+                                bool use_box, bool use_arithmetic,
+                                float sigma, float lj_cutoff,
+                                int start, int end,
+                                float *rep_array, float *disp_array);
+
+/** The energy and grid kernels for one functional form */
+struct CLJFunctionKernels
+{
+    CLJEnergyKernel vac_energy_geo;
+    CLJEnergyKernel2 vac_energy_geo2;
+    CLJEnergyKernel vac_energy_ari;
+    CLJEnergyKernel2 vac_energy_ari2;
+
+    CLJBoxEnergyKernel box_energy_geo;
+    CLJBoxEnergyKernel2 box_energy_geo2;
+    CLJBoxEnergyKernel box_energy_ari;
+    CLJBoxEnergyKernel2 box_energy_ari2;
+
+    CLJPartEnergyKernel vac_coulomb_energy_ari;
+    CLJPartEnergyKernel2 vac_coulomb_energy_ari2;
+    CLJPartEnergyKernel vac_lj_energy_ari;
+    CLJPartEnergyKernel2 vac_lj_energy_ari2;
+
+    CLJGridKernel vac_grid;
+    CLJBoxGridKernel box_grid;
+};
+
+/** The complete set of kernels compiled for one instruction set */
+struct CLJKernels
+{
+    const char *isa;
+    int width;
+    CLJFunctionKernels shift;
+    CLJFunctionKernels rf;
+    CLJLJGridKernel lj_grid;
+};
+
+/** Each compilation of the kernels provides these functions, in a namespace
+    named after the instruction set */
+#define SIRE_DECLARE_CLJ_KERNELS(ISA) \
+    namespace ISA \
+    { \
+        void getShiftKernels(CLJFunctionKernels &kernels); \
+        void getRFKernels(CLJFunctionKernels &kernels); \
+        void getLJGridKernel(CLJLJGridKernel &kernel); \
+        int getKernelWidth(); \
+    }
+
+SIRE_DECLARE_CLJ_KERNELS(baseline)
+SIRE_DECLARE_CLJ_KERNELS(avx2)
+SIRE_DECLARE_CLJ_KERNELS(avx512)
+
+#undef SIRE_DECLARE_CLJ_KERNELS
+
+#ifndef SIRE_KERNEL_ISA
+const CLJKernels& cljKernels();
+
+/** The packed atoms of a CLJAtoms object in the form passed to the
+    chosen kernels. The data of the CLJAtoms object is used directly
+    if it already has the width and alignment of the kernels. Otherwise
+    (e.g. the SSE data of the baseline compilation is passed to the
+    AVX2 or AVX512 kernels) it is copied, padded with dummy atoms,
+    into an aligned buffer that is held by this object */
+class CLJKernelAtomsData
+{
+public:
+    CLJKernelAtomsData(const CLJAtoms &atoms);
+    ~CLJKernelAtomsData();
+
+    operator const CLJKernelAtoms&() const
+    {
+        return k;
+    }
+
+private:
+    Q_DISABLE_COPY(CLJKernelAtomsData)
+
+    CLJKernelAtoms k;
+    void *buffer;
+};
+
+CLJKernelVector cljKernelVector(const SireMaths::Vector &vector);
+CLJKernelGrid cljKernelGrid(const SireVol::GridInfo &grid_info);
+#endif
+
+} // end of namespace detail
+
+} // end of namespace SireMM
+
+SIRE_END_HEADER
+
+#endif
@@ -0,0 +1,218 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#ifndef SIREMM_DETAIL_CLJKERNELVIEWS_HPP
+#define SIREMM_DETAIL_CLJKERNELVIEWS_HPP
+
+#include "SireMM/detail/cljkernels.h"
+
+#include "SireMaths/multifloat.h"
+#include "SireMaths/multiint.h"
+
+// Make sure that each compilation of the kernels really uses the
+// intrinsics of its instruction set, rather than the portable code
+#ifdef SIRE_KERNEL_ISA
+    #ifdef SIRE_USE_AVX512
+        #ifndef MULTIFLOAT_AVX512F_IS_AVAILABLE
+            #error The AVX512 kernels are not using the AVX512 vector classes
+        #endif
+    #else
+    #ifdef SIRE_USE_AVX2
+        #ifndef MULTIFLOAT_AVX2_IS_AVAILABLE
+            #error The AVX2 kernels are not using the AVX2 vector classes
+        #endif
+    #else
+        #error The instruction set of these kernels has not been set
+    #endif
+    #endif
+#else
+#ifdef SIRE_VECTOR_DISPATCH
+    #ifndef MULTIFLOAT_SSE_IS_AVAILABLE
+        #error The baseline kernels are not using the SSE vector classes
+    #endif
+#endif
+#endif
+
+SIRE_BEGIN_HEADER
+
+namespace SireMM
+{
+
+namespace detail
+{
+
+/** The classes in this namespace wrap the plain data passed to the
+    kernels, providing the parts of the CLJAtoms, GridInfo and Vector
+    interfaces used by the kernels, in terms of the vector classes
+    of this compilation */
+namespace SIRE_KERNEL_NAMESPACE
+{
+
+using SireMaths::MultiFloat;
+using SireMaths::MultiInt;
+using SireMaths::MULTIFLOAT_POS_MASK;
+
+/** A read-only array of packed vectors */
+template<class T>
+class CLJKernelArray
+{
+public:
+    CLJKernelArray(const void *data, int count)
+        : d(static_cast<const T*>(data)), n(count)
+    {}
+
+    const T* constData() const
+    {
+        return d;
+    }
+
+    int count() const
+    {
+        return n;
+    }
+
+private:
+    const T *d;
+    int n;
+};
+
+/** View of the packed atoms of a CLJAtoms object */
+class CLJAtomsView
+{
+public:
+    CLJAtomsView(const CLJKernelAtoms &atoms) : a(atoms)
+    {}
+
+    CLJKernelArray<MultiFloat> x() const
+    {
+        return CLJKernelArray<MultiFloat>(a.x, a.count / MultiFloat::count());
+    }
+
+    CLJKernelArray<MultiFloat> y() const
+    {
+        return CLJKernelArray<MultiFloat>(a.y, a.count / MultiFloat::count());
+    }
+
+    CLJKernelArray<MultiFloat> z() const
+    {
+        return CLJKernelArray<MultiFloat>(a.z, a.count / MultiFloat::count());
+    }
+
+    CLJKernelArray<MultiFloat> q() const
+    {
+        return CLJKernelArray<MultiFloat>(a.q, a.count / MultiFloat::count());
+    }
+
+    CLJKernelArray<MultiFloat> sigma() const
+    {
+        return CLJKernelArray<MultiFloat>(a.sig, a.count / MultiFloat::count());
+    }
+
+    CLJKernelArray<MultiFloat> epsilon() const
+    {
+        return CLJKernelArray<MultiFloat>(a.eps, a.count / MultiFloat::count());
+    }
+
+    CLJKernelArray<MultiInt> ID() const
+    {
+        return CLJKernelArray<MultiInt>(a.id, a.count / MultiInt::count());
+    }
+
+    MultiInt idOfDummy() const
+    {
+        return MultiInt(a.dummy_id);
+    }
+
+private:
+    const CLJKernelAtoms &a;
+};
+
+/** View of a point or box dimensions */
+class CLJVectorView
+{
+public:
+    CLJVectorView(const CLJKernelVector &vector) : v(vector)
+    {}
+
+    double x() const
+    {
+        return v.x;
+    }
+
+    double y() const
+    {
+        return v.y;
+    }
+
+    double z() const
+    {
+        return v.z;
+    }
+
+private:
+    CLJKernelVector v;
+};
+
+/** View of a GridInfo */
+class CLJGridView
+{
+public:
+    CLJGridView(const CLJKernelGrid &grid) : g(grid)
+    {}
+
+    /** Return the point at the ith grid index. This is
+        calculated in the same way as GridInfo::point(int) */
+    CLJVectorView point(int i) const
+    {
+        const int ix = i / (g.dimy*g.dimz);
+        i -= ix*g.dimy*g.dimz;
+
+        const int iy = i / g.dimz;
+        i -= iy*g.dimz;
+
+        CLJKernelVector p;
+        p.x = g.origin[0] + double(ix * g.spacing);
+        p.y = g.origin[1] + double(iy * g.spacing);
+        p.z = g.origin[2] + double(i * g.spacing);
+
+        return CLJVectorView(p);
+    }
+
+private:
+    const CLJKernelGrid &g;
+};
+
+} // end of namespace SIRE_KERNEL_NAMESPACE
+
+} // end of namespace detail
+
+} // end of namespace SireMM
+
+SIRE_END_HEADER
+
+#endif
@@ -0,0 +1,165 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#ifndef SIREMM_DETAIL_GRIDINTERPOLATION_HPP
+#define SIREMM_DETAIL_GRIDINTERPOLATION_HPP
+
+#include "SireMaths/vector.h"
+
+#include <algorithm>
+
+SIRE_BEGIN_HEADER
+
+namespace SireMM
+{
+namespace detail
+{
+
+/** Internal function used to calculate the Catmull-Rom weights of the four
+    grid points along an axis, for the fractional coordinate 'u' of the
+    point within the box (see GridInfo::pointToTricubicGridCorners) */
+inline void getCatmullRomWeights(double u, double *w)
+{
+    const double u2 = u * u;
+    const double u3 = u2 * u;
+
+    w[0] = 0.5 * (2*u2 - u3 - u);
+    w[1] = 0.5 * (3*u3 - 5*u2 + 2);
+    w[2] = 0.5 * (4*u2 - 3*u3 + u);
+    w[3] = 0.5 * (u3 - u2);
+}
+
+/** Return the value at 'point' interpolated from the grid 'grid', which
+    has 'dimx' x 'dimy' x 'dimz' points spaced by 'spacing', with point
+    (i,j,k) at origin + (i,j,k)*spacing and held in grid[i*(dimy*dimz) + j*dimz + k].
+    The point must lie in the box with lower corner (i_0,j_0,k_0), which must
+    not lie on the upper edge of the grid.
+
+    This uses tri-linear interpolation, as described in
+
+    Davis, Madura and McCammon, Comp. Phys. Comm., 62, 187-197, 1991
+
+    phi(x,y,z) = phi(i  ,j  ,k  )*(1-R)(1-S)(1-T) +
+                 phi(i+1,j  ,k  )*(  R)(1-S)(1-T) +
+                 phi(i  ,j+1,k  )*(1-R)(  S)(1-T) +
+                 phi(i  ,j  ,k+1)*(1-R)(1-S)(  T) +
+                 phi(i+1,j+1,k  )*(  R)(  S)(1-T) +
+                 phi(i+1,j  ,k+1)*(  R)(1-S)(  T) +
+                 phi(i  ,j+1,k+1)*(1-R)(  S)(  T) +
+                 phi(i+1,j+1,k+1)*(  R)(  S)(  T) +
+
+    where R, S and T are the coordinates of the atom in
+    fractional grid coordinates from the point (i,j,k), e.g.
+    (0,0,0) is (i,j,k) and (1,1,1) is (i+1,j+1,k+1)
+
+    If 'tricubic' is true, then tensor-product Catmull-Rom interpolation
+    over the 4x4x4 points around the box is used instead. Stencil points
+    that fall off the edge of the grid are clamped to the edge, and the
+    result is limited to lie between the values on the corners of the box,
+    so that the interpolation cannot overshoot next to steep changes
+    in the value on the grid (e.g. the LJ repulsion of close atoms) */
+inline double interpolateGrid(const double *grid, const SireMaths::Vector &origin,
+                              double spacing, int dimx, int dimy, int dimz,
+                              int i_0, int j_0, int k_0,
+                              const SireMaths::Vector &point, bool tricubic)
+{
+    const SireMaths::Vector c000 = origin + SireMaths::Vector( i_0 * spacing,
+                                                                j_0 * spacing,
+                                                                k_0 * spacing );
+
+    const SireMaths::Vector RST = (point - c000) / spacing;
+    const double R = RST.x();
+    const double S = RST.y();
+    const double T = RST.z();
+
+    const int dimyz = dimy * dimz;
+
+    const int i000 = (i_0  ) * dimyz + (j_0  )*dimz + (k_0  );
+    const int i001 = (i_0  ) * dimyz + (j_0  )*dimz + (k_0+1);
+    const int i010 = (i_0  ) * dimyz + (j_0+1)*dimz + (k_0  );
+    const int i100 = (i_0+1) * dimyz + (j_0  )*dimz + (k_0  );
+    const int i011 = (i_0  ) * dimyz + (j_0+1)*dimz + (k_0+1);
+    const int i101 = (i_0+1) * dimyz + (j_0  )*dimz + (k_0+1);
+    const int i110 = (i_0+1) * dimyz + (j_0+1)*dimz + (k_0  );
+    const int i111 = (i_0+1) * dimyz + (j_0+1)*dimz + (k_0+1);
+
+    if (not tricubic)
+    {
+        return (grid[i000] * (1-R)*(1-S)*(1-T)) +
+               (grid[i001] * (1-R)*(1-S)*(  T)) +
+               (grid[i010] * (1-R)*(  S)*(1-T)) +
+               (grid[i100] * (  R)*(1-S)*(1-T)) +
+               (grid[i011] * (1-R)*(  S)*(  T)) +
+               (grid[i101] * (  R)*(1-S)*(  T)) +
+               (grid[i110] * (  R)*(  S)*(1-T)) +
+               (grid[i111] * (  R)*(  S)*(  T));
+    }
+
+    double wx[4], wy[4], wz[4];
+    getCatmullRomWeights(R, wx);
+    getCatmullRomWeights(S, wy);
+    getCatmullRomWeights(T, wz);
+
+    int ii[4], jj[4], kk[4];
+
+    for (int a=0; a<4; ++a)
+    {
+        ii[a] = std::min( std::max(i_0 + a - 1, 0), dimx-1 ) * dimyz;
+        jj[a] = std::min( std::max(j_0 + a - 1, 0), dimy-1 ) * dimz;
+        kk[a] = std::min( std::max(k_0 + a - 1, 0), dimz-1 );
+    }
+
+    double phi = 0;
+
+    for (int a=0; a<4; ++a)
+    {
+        for (int b=0; b<4; ++b)
+        {
+            const double wab = wx[a] * wy[b];
+            const double *row = grid + ii[a] + jj[b];
+
+            phi += wab * ( wz[0]*row[kk[0]] + wz[1]*row[kk[1]] +
+                           wz[2]*row[kk[2]] + wz[3]*row[kk[3]] );
+        }
+    }
+
+    const double corners[8] = { grid[i000], grid[i001], grid[i010], grid[i100],
+                                grid[i011], grid[i101], grid[i110], grid[i111] };
+
+    const double minval = *std::min_element(corners, corners+8);
+    const double maxval = *std::max_element(corners, corners+8);
+
+    return std::min( std::max(phi, minval), maxval );
+}
+
+}
+}
+
+SIRE_END_HEADER
+
+#endif
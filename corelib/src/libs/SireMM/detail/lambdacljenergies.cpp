@@ -0,0 +1,245 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#include "lambdacljenergies.h"
+
+#include "SireMaths/maths.h"
+
+#include "SireUnits/units.h"
+
+#include "SireBase/profiler.h"
+
+#include "SireError/errors.h"
+
+using namespace SireMM;
+using namespace SireMM::detail;
+using namespace SireMaths;
+using namespace SireMol;
+using namespace SireUnits;
+
+/** Constructor */
+LambdaCLJEnergies::LambdaCLJEnergies() : nats(0)
+{}
+
+/** Construct for the perturbed group of atoms with the passed coordinates,
+    charges and LJ parameters
+
+    \throw SireError::incompatible_error
+*/
+LambdaCLJEnergies::LambdaCLJEnergies(const QVector<Vector> &coords,
+                                     const QVector<Charge> &charges,
+                                     const QVector<LJParameter> &ljs)
+                  : nats(coords.count())
+{
+    if (charges.count() != nats or ljs.count() != nats)
+        throw SireError::incompatible_error( QObject::tr(
+                "The number of coordinates (%1), charges (%2) and LJ parameters (%3) "
+                "of the perturbed atoms must be the same.")
+                    .arg(nats).arg(charges.count()).arg(ljs.count()), CODELOC );
+
+    if (nats == 0)
+        return;
+
+    //the padding atoms have no charge or LJ, and are placed far away
+    //so that they never give an infinite (and thus NaN) energy
+    const int npad = MultiDouble::count() * ((nats + MultiDouble::count() - 1)
+                                                 / MultiDouble::count());
+
+    QVector<double> xa(npad, 1e10), ya(npad, 1e10), za(npad, 1e10);
+    QVector<double> qa(npad, 0), siga(npad, 0), epsa(npad, 0);
+
+    for (int i=0; i<nats; ++i)
+    {
+        const Vector &coord = coords.constData()[i];
+        xa[i] = coord.x();
+        ya[i] = coord.y();
+        za[i] = coord.z();
+
+        qa[i] = charges.constData()[i].value() * one_over_four_pi_eps0;
+
+        const LJParameter &lj = ljs.constData()[i];
+        siga[i] = 0.5 * lj.sigma().value();
+        epsa[i] = lj.sqrtEpsilon();
+    }
+
+    x = MultiDouble::fromArray(xa);
+    y = MultiDouble::fromArray(ya);
+    z = MultiDouble::fromArray(za);
+    q = MultiDouble::fromArray(qa);
+    half_sig = MultiDouble::fromArray(siga);
+    sqrt_eps = MultiDouble::fromArray(epsa);
+}
+
+/** Copy constructor */
+LambdaCLJEnergies::LambdaCLJEnergies(const LambdaCLJEnergies &other)
+                  : x(other.x), y(other.y), z(other.z), q(other.q),
+                    half_sig(other.half_sig), sqrt_eps(other.sqrt_eps),
+                    nats(other.nats)
+{}
+
+/** Destructor */
+LambdaCLJEnergies::~LambdaCLJEnergies()
+{}
+
+/** Copy assignment operator */
+LambdaCLJEnergies& LambdaCLJEnergies::operator=(const LambdaCLJEnergies &other)
+{
+    x = other.x;
+    y = other.y;
+    z = other.z;
+    q = other.q;
+    half_sig = other.half_sig;
+    sqrt_eps = other.sqrt_eps;
+    nats = other.nats;
+    return *this;
+}
+
+/** Return whether or not there are no perturbed atoms */
+bool LambdaCLJEnergies::isEmpty() const
+{
+    return nats == 0;
+}
+
+/** Return the number of perturbed atoms */
+int LambdaCLJEnergies::nAtoms() const
+{
+    return nats;
+}
+
+/** Calculate the soft-core coulomb and LJ energies between the passed atoms
+    and the perturbed atoms, at each of the soft-core values in 'alphas'.
+    The energies are returned in 'cnrgs' and 'ljnrgs', which are resized
+    to hold one energy per alpha value
+
+    \throw SireError::incompatible_error
+*/
+void LambdaCLJEnergies::calculate(const QVector<Vector> &coords,
+                                  const QVector<Charge> &charges,
+                                  const QVector<LJParameter> &ljs,
+                                  const QVector<double> &alphas,
+                                  double shift_delta, int coulomb_power,
+                                  QVector<double> &cnrgs, QVector<double> &ljnrgs) const
+{
+    const int nats0 = coords.count();
+    const int nalphas = alphas.count();
+
+    if (charges.count() != nats0 or ljs.count() != nats0)
+        throw SireError::incompatible_error( QObject::tr(
+                "The number of coordinates (%1), charges (%2) and LJ parameters (%3) "
+                "must be the same.")
+                    .arg(nats0).arg(charges.count()).arg(ljs.count()), CODELOC );
+
+    cnrgs = QVector<double>(nalphas, 0);
+    ljnrgs = QVector<double>(nalphas, 0);
+
+    if (nats0 == 0 or nats == 0 or nalphas == 0)
+        return;
+
+    SIRE_PROFILE("SireMM::LambdaCLJEnergies::calculate");
+
+    //the soft-core terms that are constant for each alpha
+    QVector<MultiDouble> salphas(nalphas);
+    QVector<MultiDouble> sdeltas(nalphas);
+
+    for (int k=0; k<nalphas; ++k)
+    {
+        salphas[k] = MultiDouble(alphas.constData()[k]);
+        sdeltas[k] = MultiDouble(shift_delta * alphas.constData()[k]);
+    }
+
+    QVector<MultiDouble> icnrgs(nalphas, MultiDouble(0));
+    QVector<MultiDouble> iljnrgs(nalphas, MultiDouble(0));
+
+    MultiDouble *icnrg = icnrgs.data();
+    MultiDouble *iljnrg = iljnrgs.data();
+
+    const MultiDouble *xa = x.constData();
+    const MultiDouble *ya = y.constData();
+    const MultiDouble *za = z.constData();
+    const MultiDouble *qa = q.constData();
+    const MultiDouble *siga = half_sig.constData();
+    const MultiDouble *epsa = sqrt_eps.constData();
+
+    const int nvecs = x.count();
+
+    for (int i=0; i<nats0; ++i)
+    {
+        const Vector &coord = coords.constData()[i];
+        const LJParameter &lj = ljs.constData()[i];
+
+        const MultiDouble x0(coord.x());
+        const MultiDouble y0(coord.y());
+        const MultiDouble z0(coord.z());
+        const MultiDouble q0(charges.constData()[i].value());
+        const MultiDouble sig0(0.5 * lj.sigma().value());
+        const MultiDouble eps0(4.0 * lj.sqrtEpsilon());
+
+        for (int j=0; j<nvecs; ++j)
+        {
+            //this work is shared by all of the alpha values
+            MultiDouble tmp = x0 - xa[j];
+            MultiDouble r2 = tmp * tmp;
+            tmp = y0 - ya[j];
+            r2.multiplyAdd(tmp, tmp);
+            tmp = z0 - za[j];
+            r2.multiplyAdd(tmp, tmp);
+
+            const MultiDouble qq = q0 * qa[j];
+            const MultiDouble sig = sig0 + siga[j];
+            const MultiDouble eps4 = eps0 * epsa[j];
+
+            MultiDouble sig6 = sig * sig;
+            sig6 = sig6 * sig6 * sig6;
+
+            //only the soft-core terms depend on alpha
+            for (int k=0; k<nalphas; ++k)
+            {
+                icnrg[k].multiplyAdd(qq, (salphas.constData()[k] + r2).rsqrt());
+
+                MultiDouble denom = r2 + sig * sdeltas.constData()[k];
+                denom = denom * denom * denom;
+
+                const MultiDouble sig6_over_denom = sig6 / denom;
+
+                iljnrg[k].multiplyAdd(eps4, sig6_over_denom * sig6_over_denom
+                                                - sig6_over_denom);
+            }
+        }
+    }
+
+    for (int k=0; k<nalphas; ++k)
+    {
+        double scl = 1;
+
+        if (coulomb_power != 0)
+            scl = SireMaths::pow(1 - alphas.constData()[k], coulomb_power);
+
+        cnrgs[k] = scl * icnrg[k].sum();
+        ljnrgs[k] = iljnrg[k].sum();
+    }
+}
@@ -0,0 +1,124 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#ifndef SIREMM_DETAIL_LAMBDACLJENERGIES_H
+#define SIREMM_DETAIL_LAMBDACLJENERGIES_H
+
+#include "SireMaths/multidouble.h"
+#include "SireMaths/vector.h"
+
+#include "SireMol/atomcharges.h"
+
+#include "SireMM/ljparameter.h"
+
+#include <QVector>
+
+SIRE_BEGIN_HEADER
+
+namespace SireMM
+{
+namespace detail
+{
+
+using SireMaths::MultiDouble;
+using SireMaths::Vector;
+
+/** This class calculates the soft-core coulomb and LJ interaction energy
+    between a set of atoms and a perturbed group of atoms at a whole
+    set of soft-core alpha values, in a single pass over the atom pairs.
+    This lets the energies at every lambda value needed for
+    finite-difference TI, FEP or MBAR be calculated for little more than the
+    cost of a single energy.
+
+    The soft-core potentials are those used by FreeEnergyMonitor
+    (Zacharias and McCammon, J. Chem. Phys., 1994, and Michel et al.,
+    JCTC, 2007)
+
+    V_{LJ}(r) = 4 epsilon [ ( sigma^12 / (delta*sigma + r^2)^6 ) -
+                            ( sigma^6  / (delta*sigma + r^2)^3 ) ]
+
+    delta = shift_delta * alpha
+
+    V_{coul}(r) = (1-alpha)^n q_i q_j / 4 pi eps_0 (alpha+r^2)^(1/2)
+
+    The perturbed group is held in vectorised (MultiDouble) form, so the
+    distances and combined parameters of each pair are calculated once,
+    and only the soft-core terms are recalculated for each alpha.
+    Double precision is used throughout, as the energies are used to
+    form small differences between neighbouring lambda values.
+    Arithmetic combining rules are used for the LJ parameters, and
+    no cutoff or periodic boundaries are applied (as in FreeEnergyMonitor)
+
+    @author Christopher Woods
+*/
+class SIREMM_EXPORT LambdaCLJEnergies
+{
+public:
+    LambdaCLJEnergies();
+    LambdaCLJEnergies(const QVector<Vector> &coords,
+                      const QVector<SireMol::Charge> &charges,
+                      const QVector<LJParameter> &ljs);
+
+    LambdaCLJEnergies(const LambdaCLJEnergies &other);
+
+    ~LambdaCLJEnergies();
+
+    LambdaCLJEnergies& operator=(const LambdaCLJEnergies &other);
+
+    bool isEmpty() const;
+
+    int nAtoms() const;
+
+    void calculate(const QVector<Vector> &coords,
+                   const QVector<SireMol::Charge> &charges,
+                   const QVector<LJParameter> &ljs,
+                   const QVector<double> &alphas,
+                   double shift_delta, int coulomb_power,
+                   QVector<double> &cnrgs, QVector<double> &ljnrgs) const;
+
+private:
+    /** The coordinates of the perturbed atoms */
+    QVector<MultiDouble> x, y, z;
+
+    /** The charges of the perturbed atoms, premultiplied by 1 / 4 pi eps_0 */
+    QVector<MultiDouble> q;
+
+    /** Half of the sigma, and the square root of epsilon,
+        of the perturbed atoms */
+    QVector<MultiDouble> half_sig, sqrt_eps;
+
+    /** The number of perturbed atoms */
+    int nats;
+};
+
+} // end of namespace detail
+} // end of namespace SireMM
+
+SIRE_END_HEADER
+
+#endif
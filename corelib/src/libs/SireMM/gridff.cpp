@@ -28,6 +28,7 @@
 
 #include "gridff.h"
 #include "cljpotential.h"
+#include "cljgridcache.h"
 
 #include "SireMol/atomcoords.h"
 #include "SireMol/atomcharges.h"
@@ -35,6 +36,9 @@
 
 #include "SireMaths/constants.h"
 
+#include "detail/cljkernels.h"
+#include "detail/gridinterpolation.hpp"
+
 #include "SireUnits/units.h"
 
 #include "SireStream/datastream.h"
@@ -63,10 +67,12 @@ static const RegisterMetaType<GridFF> r_gridff;
 
 QDataStream SIREMM_EXPORT &operator<<(QDataStream &ds, const GridFF &gridff)
 {
-    writeHeader(ds, r_gridff, 5);
+    writeHeader(ds, r_gridff, 6);
     
     SharedDataStream sds(ds);
     
+    sds << gridff.use_lj_grid << gridff.use_tricubic;
+    
     sds << gridff.gridbox << gridff.dimx << gridff.dimy << gridff.dimz
         << gridff.gridpot
         << gridff.buffer_size << gridff.grid_spacing
@@ -113,12 +119,15 @@ QDataStream SIREMM_EXPORT &operator>>(QDataStream &ds, GridFF &gridff)
 {
     VersionID v = readHeader(ds, r_gridff);
 
-    if (v == 5)
+    if (v == 5 or v == 6)
     {
         SharedDataStream sds(ds);
         
         gridff = GridFF();
         
+        if (v == 6)
+            sds >> gridff.use_lj_grid >> gridff.use_tricubic;
+        
         gridff.fixedatoms_coords.clear();
         gridff.fixedatoms_params.clear();
         
@@ -292,7 +301,7 @@ QDataStream SIREMM_EXPORT &operator>>(QDataStream &ds, GridFF &gridff)
             >> static_cast<InterGroupCLJFF&>(gridff);
     }
     else
-        throw version_error(v, "2,3,4,5", r_gridff, CODELOC);
+        throw version_error(v, "2,3,4,5,6", r_gridff, CODELOC);
         
     return ds;
 }
@@ -301,7 +310,8 @@ QDataStream SIREMM_EXPORT &operator>>(QDataStream &ds, GridFF &gridff)
 GridFF::GridFF() 
        : ConcreteProperty<GridFF,InterGroupCLJFF>(),
          buffer_size(2.5), grid_spacing(1.0), 
-         coul_cutoff(50), lj_cutoff(7.5)
+         coul_cutoff(50), lj_cutoff(7.5),
+         use_lj_grid(false), use_tricubic(false)
 {
     this->setSwitchingFunction(NoCutoff());
 }
@@ -310,7 +320,8 @@ GridFF::GridFF()
 GridFF::GridFF(const QString &name) 
        : ConcreteProperty<GridFF,InterGroupCLJFF>(name),
          buffer_size(2.5), grid_spacing(1.0), 
-         coul_cutoff(50), lj_cutoff(7.5)
+         coul_cutoff(50), lj_cutoff(7.5),
+         use_lj_grid(false), use_tricubic(false)
 {
     this->setSwitchingFunction(NoCutoff());
 }
@@ -323,6 +334,9 @@ GridFF::GridFF(const GridFF &other)
          coul_cutoff(other.coul_cutoff), lj_cutoff(other.lj_cutoff),
          dimx(other.dimx), dimy(other.dimy), dimz(other.dimz),
          gridpot(other.gridpot),
+         ljrep_grids(other.ljrep_grids), ljdisp_grids(other.ljdisp_grids),
+         use_lj_grid(other.use_lj_grid), use_tricubic(other.use_tricubic),
+         cache_key(other.cache_key),
          fixedatoms_coords(other.fixedatoms_coords),
          fixedatoms_params(other.fixedatoms_params),
          closemols_coords(other.closemols_coords),
@@ -360,6 +374,11 @@ GridFF& GridFF::operator=(const GridFF &other)
         dimy = other.dimy;
         dimz = other.dimz;
         gridpot = other.gridpot;
+        ljrep_grids = other.ljrep_grids;
+        ljdisp_grids = other.ljdisp_grids;
+        use_lj_grid = other.use_lj_grid;
+        use_tricubic = other.use_tricubic;
+        cache_key = other.cache_key;
         fixedatoms_coords = other.fixedatoms_coords;
         fixedatoms_params = other.fixedatoms_params;
         closemols_coords = other.closemols_coords;
@@ -377,6 +396,8 @@ bool GridFF::operator==(const GridFF &other) const
 {
     return buffer_size == other.buffer_size and
            grid_spacing == other.grid_spacing and
+           use_lj_grid == other.use_lj_grid and
+           use_tricubic == other.use_tricubic and
            InterGroupCLJFF::operator==(other);
 }
 
@@ -637,6 +658,47 @@ SireUnits::Dimension::Length GridFF::ljCutoff() const
     return SireUnits::Dimension::Length(lj_cutoff);
 }
 
+/** Switch on or off holding the coulomb and LJ potentials of the close
+    atoms (those within the LJ cutoff of the grid) on grids, so that
+    they don't need to be evaluated explicitly. The LJ grids are built
+    for each LJ type of the group 0 atoms as they are needed. The potentials
+    are evaluated using a minimum distance of 0.5 A from each close atom, 
+    so that the grids are not swamped by the repulsion at the atom centers */
+void GridFF::setUseLJGrid(bool on)
+{
+    if (use_lj_grid != on)
+    {
+        use_lj_grid = on;
+        this->mustNowRecalculateFromScratch();
+    }
+}
+
+/** Return whether or not the energies with the close atoms are
+    calculated using grids */
+bool GridFF::usesLJGrid() const
+{
+    return use_lj_grid;
+}
+
+/** Switch on or off use of tricubic interpolation of the grids. This gives
+    smoother energies than tri-linear interpolation, at the cost of reading
+    64 rather than 8 grid points for each atom. The interpolated value is limited
+    to lie between the values on the corners of the grid box containing the atom */
+void GridFF::setUseTricubicInterpolation(bool on)
+{
+    if (use_tricubic != on)
+    {
+        use_tricubic = on;
+        this->mustNowRecalculateFromScratch();
+    }
+}
+
+/** Return whether or not tricubic interpolation of the grids is used */
+bool GridFF::usesTricubicInterpolation() const
+{
+    return use_tricubic;
+}
+
 inline GridFF::Vector4::Vector4(const Vector &v, double chg)
               : x(v.x()), y(v.y()), z(v.z()), q(chg)
 {}
@@ -1540,6 +1602,25 @@ void GridFF::rebuildGrid()
     gridpot = QVector<double>(dimx*dimy*dimz, 0.0);
     gridpot.squeeze();
 
+    //see if this grid has already been calculated and saved to the cache
+    bool grid_from_cache = false;
+    cache_key = QString();
+    
+    if (CLJGridCache::isEnabled())
+    {
+        cache_key = this->createCacheKey();
+        
+        QVector<double> pot = CLJGridCache::loadDoubles(gridCacheKey("coulomb"),
+                                                        dimx*dimy*dimz);
+        
+        if (not pot.isEmpty())
+        {
+            qDebug() << "Loaded the potential grid from the grid cache.";
+            gridpot = pot;
+            grid_from_cache = true;
+        }
+    }
+
     closemols_coords.clear();
     closemols_params.clear();
     
@@ -1596,7 +1677,8 @@ void GridFF::rebuildGrid()
                 
                     if (far_mols.count() > 1023)
                     {
-                        addToGrid(far_mols);
+                        if (not grid_from_cache)
+                            addToGrid(far_mols);
                         gridcount += far_mols.count();
                         far_mols.clear();
                         //qDebug() << "Added" << i+1 << "of" << fixedatoms_coords.count()
@@ -1606,7 +1688,8 @@ void GridFF::rebuildGrid()
             }
         }
         
-        addToGrid(far_mols);
+        if (not grid_from_cache)
+            addToGrid(far_mols);
         gridcount += far_mols.count();
         far_mols.clear();
         qDebug() << "Added all of the fixed atoms to the grid.";
@@ -1675,7 +1758,8 @@ void GridFF::rebuildGrid()
                 
                             if (far_mols.count() > 1023)
                             {
-                                addToGrid(far_mols);
+                                if (not grid_from_cache)
+                                    addToGrid(far_mols);
                                 gridcount += far_mols.count();
                                 far_mols.clear();
                                 qDebug() << "Added" << nmols << "of" << cljmols.count()
@@ -1687,7 +1771,8 @@ void GridFF::rebuildGrid()
             }
         }
         
-        addToGrid(far_mols);
+        if (not grid_from_cache)
+            addToGrid(far_mols);
         gridcount += far_mols.count();
         far_mols.clear();
         qDebug() << "Added all of the group 1 molecules to the grid.";
@@ -1708,6 +1793,288 @@ void GridFF::rebuildGrid()
     
     closemols_coords.squeeze();
     closemols_params.squeeze();
+    
+    if (not grid_from_cache)
+    {
+        if (use_lj_grid)
+        {
+            addCloseAtomsToGrid();
+            qDebug() << "Added the coulomb potential of the" << atomcount
+                     << "close atoms to the grid.";
+        }
+    
+        if (not cache_key.isEmpty())
+            CLJGridCache::save(gridCacheKey("coulomb"), gridpot);
+    }
+}
+
+/** Internal function that returns the key that identifies everything that 
+    determines the values on the grids (the fixed and group 1 atoms, the
+    space, the grid dimensions and the cutoffs and electrostatics
+    settings) in the grid cache */
+QString GridFF::createCacheKey() const
+{
+    QByteArray data;
+    
+    {
+        QDataStream ds(&data, QIODevice::WriteOnly);
+        SharedDataStream sds(ds);
+        
+        sds << QString(GridFF::typeName())
+            << gridbox << dimx << dimy << dimz << grid_spacing
+            << coul_cutoff << lj_cutoff << use_lj_grid
+            << shiftElectrostatics() << useReactionField()
+            << reactionFieldDielectric() << combiningRules()
+            << this->space();
+        
+        //the LJ IDs differ between processes, so write the LJ parameters
+        LJParameterDB::lock();
+        
+        try
+        {
+            for (int i=0; i<fixedatoms_coords.count(); ++i)
+            {
+                const detail::CLJParameter &param = fixedatoms_params.constData()[i];
+            
+                sds << fixedatoms_coords.constData()[i] << param.reduced_charge
+                    << LJParameterDB::_locked_getLJParameter(param.ljid);
+            }
+            
+            for (ChunkedVector<CLJMolecule>::const_iterator 
+                                    it = mols[1].moleculesByIndex().constBegin();
+                 it != mols[1].moleculesByIndex().constEnd();
+                 ++it)
+            {
+                const CoordGroupArray &coords = (*it).coordinates();
+                const CLJParameters::Array *params_array
+                                    = (*it).parameters().atomicParameters().constData();
+                
+                for (int igroup=0; igroup<coords.count(); ++igroup)
+                {
+                    const CoordGroup &group = coords.constData()[igroup];
+                    const CLJParameters::Array &params = params_array[igroup];
+                    
+                    for (int i=0; i<group.count(); ++i)
+                    {
+                        const detail::CLJParameter &param = params.constData()[i];
+                    
+                        sds << group.constData()[i] << param.reduced_charge
+                            << LJParameterDB::_locked_getLJParameter(param.ljid);
+                    }
+                }
+            }
+        }
+        catch(...)
+        {
+            LJParameterDB::unlock();
+            throw;
+        }
+        
+        LJParameterDB::unlock();
+    }
+    
+    return CLJGridCache::createKey(data);
+}
+
+/** Internal function that returns the key of the grid called 'grid_name'
+    in the grid cache */
+QString GridFF::gridCacheKey(const QString &grid_name) const
+{
+    return CLJGridCache::createKey( QString("%1:%2").arg(cache_key, grid_name).toUtf8() );
+}
+
+/** Internal function used to add the coulomb potential of the close atoms
+    onto the grid, used when the energies with the close atoms are held
+    on grids. The distance between each grid point and close atom is
+    limited to be no less than detail::clj_grid_min_distance */
+void GridFF::addCloseAtomsToGrid()
+{
+    const int nats = closemols_coords.count();
+
+    if (nats == 0)
+        return;
+
+    double *pot = gridpot.data();
+    const Vector *coords = closemols_coords.constData();
+    const detail::CLJParameter *params = closemols_params.constData();
+
+    const Vector minpoint = gridbox.minCoords();
+
+    const double Rc = coul_cutoff;
+    const double min_r = detail::clj_grid_min_distance;
+
+    const double one_over_Rc = double(1) / Rc;
+    const double one_over_Rc2 = double(1) / (Rc*Rc);
+
+    const double rf_dielectric = reactionFieldDielectric();
+    const double k_rf = (1.0 / pow_3(Rc)) * ( (rf_dielectric-1) /
+                                              (2*rf_dielectric + 1) );
+    const double c_rf = (1.0 / Rc) * ( (3*rf_dielectric) /
+                                       (2*rf_dielectric + 1) );
+
+    const bool use_shift = shiftElectrostatics();
+    const bool use_rf = useReactionField();
+
+    for (quint32 i=0; i<dimx; ++i)
+    {
+        for (quint32 j=0; j<dimy; ++j)
+        {
+            for (quint32 k=0; k<dimz; ++k)
+            {
+                const Vector gridpoint = minpoint + Vector( i * grid_spacing,
+                                                            j * grid_spacing,
+                                                            k * grid_spacing );
+                double total = 0;
+                
+                for (int iat=0; iat<nats; ++iat)
+                {
+                    const double q = params[iat].reduced_charge;
+                    
+                    if (q == 0)
+                        continue;
+                
+                    const double r = qMax( Vector::distance(coords[iat], gridpoint),
+                                           min_r );
+
+                    if (r < Rc)
+                    {
+                        const double one_over_r = double(1) / r;
+                    
+                        if (use_shift)
+                            total += q * (one_over_r - one_over_Rc +
+                                          one_over_Rc2*(r - Rc));
+                        else if (use_rf)
+                            total += q * (one_over_r + k_rf*r*r - c_rf);
+                        else
+                            total += q * one_over_r;
+                    }
+                }
+                
+                pot[i*(dimy*dimz) + j*dimz + k] += total;
+            }
+        }
+    }
+}
+
+/** Internal function used to build the grids of the repulsive and dispersion
+    LJ potentials of the close atoms acting on group 0 atoms with LJ ID 'ljid'.
+    The distance between each grid point and close atom is limited to be 
+    no less than detail::clj_grid_min_distance */
+void GridFF::buildLJGrid(quint32 ljid)
+{
+    const int npts = dimx*dimy*dimz;
+
+    //see if this grid has already been calculated and saved to the cache
+    QString rep_key, disp_key;
+    
+    if (not cache_key.isEmpty())
+    {
+        const LJParameter lj = LJParameterDB::getLJParameter(ljid);
+        const QString ljtype = QString("%1:%2").arg(lj.sigma(), 0, 'g', 17)
+                                               .arg(lj.epsilon(), 0, 'g', 17);
+    
+        rep_key = gridCacheKey( QString("lj-repulsion:%1").arg(ljtype) );
+        disp_key = gridCacheKey( QString("lj-dispersion:%1").arg(ljtype) );
+        
+        QVector<double> repgrid = CLJGridCache::loadDoubles(rep_key, npts);
+        QVector<double> dispgrid = CLJGridCache::loadDoubles(disp_key, npts);
+        
+        if (not (repgrid.isEmpty() or dispgrid.isEmpty()))
+        {
+            ljrep_grids.insert(ljid, repgrid);
+            ljdisp_grids.insert(ljid, dispgrid);
+            return;
+        }
+    }
+
+    QVector<double> repgrid(npts, 0.0);
+    QVector<double> dispgrid(npts, 0.0);
+
+    const int nats = closemols_coords.count();
+
+    //get the sigma and epsilon of each close atom's pair with 'ljid'
+    QVector<Vector> coords;
+    QVector<double> sigs;
+    QVector<double> epss;
+    
+    coords.reserve(nats);
+    sigs.reserve(nats);
+    epss.reserve(nats);
+    
+    for (int i=0; i<nats; ++i)
+    {
+        const detail::CLJParameter &param = closemols_params.constData()[i];
+        
+        if (param.ljid == 0)
+            continue;
+        
+        const LJPair &ljpair = ljpairs.constData()[ljpairs.map(ljid, param.ljid)];
+        
+        if (ljpair.epsilon() == 0)
+            continue;
+        
+        coords.append(closemols_coords.constData()[i]);
+        sigs.append(ljpair.sigma());
+        epss.append(ljpair.epsilon());
+    }
+
+    const int nlj = coords.count();
+
+    if (nlj > 0)
+    {
+        double *rep = repgrid.data();
+        double *disp = dispgrid.data();
+        
+        const Vector *coords_array = coords.constData();
+        const double *sigs_array = sigs.constData();
+        const double *epss_array = epss.constData();
+    
+        const Vector minpoint = gridbox.minCoords();
+        const double Rlj = lj_cutoff;
+        const double min_r = detail::clj_grid_min_distance;
+    
+        for (quint32 i=0; i<dimx; ++i)
+        {
+            for (quint32 j=0; j<dimy; ++j)
+            {
+                for (quint32 k=0; k<dimz; ++k)
+                {
+                    const Vector gridpoint = minpoint + Vector( i * grid_spacing,
+                                                                j * grid_spacing,
+                                                                k * grid_spacing );
+                    double rep_total = 0;
+                    double disp_total = 0;
+                    
+                    for (int iat=0; iat<nlj; ++iat)
+                    {
+                        const double r = qMax( Vector::distance(coords_array[iat],
+                                                                gridpoint), min_r );
+                        
+                        if (r < Rlj)
+                        {
+                            const double sig_over_dist6 = pow_6(sigs_array[iat] / r);
+                            
+                            rep_total += epss_array[iat] * pow_2(sig_over_dist6);
+                            disp_total += epss_array[iat] * sig_over_dist6;
+                        }
+                    }
+                    
+                    const int ipt = i*(dimy*dimz) + j*dimz + k;
+                    rep[ipt] = rep_total;
+                    disp[ipt] = disp_total;
+                }
+            }
+        }
+    }
+
+    if (not rep_key.isEmpty())
+    {
+        CLJGridCache::save(rep_key, repgrid);
+        CLJGridCache::save(disp_key, dispgrid);
+    }
+
+    ljrep_grids.insert(ljid, repgrid);
+    ljdisp_grids.insert(ljid, dispgrid);
 }
 
 void GridFF::calculateEnergy(const CoordGroup &coords0, 
@@ -1729,7 +2096,8 @@ void GridFF::calculateEnergy(const CoordGroup &coords0,
         
     BOOST_ASSERT( closemols_coords.count() == closemols_params.count() );
 
-    if (nats1 > 0)
+    //the energies with the close atoms are held on the grids if use_lj_grid is true
+    if (nats1 > 0 and not use_lj_grid)
     {
         if (shiftElectrostatics())
         {
@@ -2330,6 +2698,7 @@ void GridFF::calculateEnergy(const CoordGroup &coords0,
     }
 
     double gridnrg = 0;
+    double gridljnrg = 0;
     const double *gridpot_array = gridpot.constData();
 
     //now calculate the energy in the grid
@@ -2353,65 +2722,46 @@ void GridFF::calculateEnergy(const CoordGroup &coords0,
         }
         else
         {
-            //use tri-linear interpolation to get the potential at the atom
-            //
-            // This is described in 
-            //
-            // Davis, Madura and McCammon, Comp. Phys. Comm., 62, 187-197, 1991
-            //
-            // phi(x,y,z) = phi(i  ,j  ,k  )*(1-R)(1-S)(1-T) +
-            //              phi(i+1,j  ,k  )*(  R)(1-S)(1-T) +
-            //              phi(i  ,j+1,k  )*(1-R)(  S)(1-T) +
-            //              phi(i  ,j  ,k+1)*(1-R)(1-S)(  T) +
-            //              phi(i+1,j+1,k  )*(  R)(  S)(1-T) +
-            //              phi(i+1,j  ,k+1)*(  R)(1-S)(  T) +
-            //              phi(i  ,j+1,k+1)*(1-R)(  S)(  T) +
-            //              phi(i+1,j+1,k+1)*(  R)(  S)(  T) +
-            //
-            // where R, S and T are the coordinates of the atom in 
-            // fractional grid coordinates from the point (i,j,k), e.g.
-            // (0,0,0) is (i,j,k) and (1,1,1) is (i+1,j+1,k+1)
-            //
-            const Vector c000 = gridbox.minCoords() + 
-                                    Vector( i_0 * grid_spacing,
-                                            j_0 * grid_spacing,
-                                            k_0 * grid_spacing );
-
-            const Vector RST = (c0 - c000) / grid_spacing;
-            const double R = RST.x();
-            const double S = RST.y();
-            const double T = RST.z();
-            
-            int i000 = (i_0  ) * (dimy*dimz) + (j_0  )*dimz + (k_0  );
-            int i001 = (i_0  ) * (dimy*dimz) + (j_0  )*dimz + (k_0+1);
-            int i010 = (i_0  ) * (dimy*dimz) + (j_0+1)*dimz + (k_0  );
-            int i100 = (i_0+1) * (dimy*dimz) + (j_0  )*dimz + (k_0  );
-            int i011 = (i_0  ) * (dimy*dimz) + (j_0+1)*dimz + (k_0+1);
-            int i101 = (i_0+1) * (dimy*dimz) + (j_0  )*dimz + (k_0+1);
-            int i110 = (i_0+1) * (dimy*dimz) + (j_0+1)*dimz + (k_0  );
-            int i111 = (i_0+1) * (dimy*dimz) + (j_0+1)*dimz + (k_0+1);
-            
-            double phi = (gridpot_array[i000] * (1-R)*(1-S)*(1-T)) + 
-                         (gridpot_array[i001] * (1-R)*(1-S)*(  T)) +
-                         (gridpot_array[i010] * (1-R)*(  S)*(1-T)) +
-                         (gridpot_array[i100] * (  R)*(1-S)*(1-T)) +
-                         (gridpot_array[i011] * (1-R)*(  S)*(  T)) +
-                         (gridpot_array[i101] * (  R)*(1-S)*(  T)) +
-                         (gridpot_array[i110] * (  R)*(  S)*(1-T)) +
-                         (gridpot_array[i111] * (  R)*(  S)*(  T));                         
+            //interpolate the potential at the atom
+            double phi = detail::interpolateGrid(gridpot_array, gridbox.minCoords(),
+                                                 grid_spacing, dimx, dimy, dimz,
+                                                 i_0, j_0, k_0, c0, use_tricubic);
                               
             gridnrg += phi * p0.reduced_charge;
+            
+            if (use_lj_grid and p0.ljid != 0)
+            {
+                if (not ljrep_grids.contains(p0.ljid))
+                    buildLJGrid(p0.ljid);
+                
+                const double rep = detail::interpolateGrid(
+                                        ljrep_grids.constFind(p0.ljid)->constData(),
+                                        gridbox.minCoords(), grid_spacing,
+                                        dimx, dimy, dimz, i_0, j_0, k_0,
+                                        c0, use_tricubic);
+
+                const double disp = detail::interpolateGrid(
+                                        ljdisp_grids.constFind(p0.ljid)->constData(),
+                                        gridbox.minCoords(), grid_spacing,
+                                        dimx, dimy, dimz, i_0, j_0, k_0,
+                                        c0, use_tricubic);
+                
+                gridljnrg += rep - disp;
+            }
         }
     }
 
     cnrg = icnrg + gridnrg;
-    ljnrg = 4.0*iljnrg;  // 4 epsilon (....)
+    ljnrg = 4.0*(iljnrg + gridljnrg);  // 4 epsilon (....)
 }
 
 /** Ensure that the next energy evaluation is from scratch */
 void GridFF::mustNowRecalculateFromScratch()
 {
     gridpot.clear();
+    ljrep_grids.clear();
+    ljdisp_grids.clear();
+    cache_key = QString();
     closemols_coords.clear();
     closemols_params.clear();
     oldnrgs.clear();
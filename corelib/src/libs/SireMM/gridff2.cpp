@@ -28,6 +28,7 @@
 
 #include "gridff2.h"
 #include "cljpotential.h"
+#include "cljgridcache.h"
 
 #include "SireMol/atomcoords.h"
 #include "SireMol/atomcharges.h"
@@ -37,6 +38,9 @@
 #include "SireMaths/multifloat.h"
 #include "SireMaths/multidouble.h"
 
+#include "detail/cljkernels.h"
+#include "detail/gridinterpolation.hpp"
+
 #include "SireUnits/units.h"
 
 #include "SireStream/datastream.h"
@@ -65,10 +69,18 @@ static const RegisterMetaType<GridFF2> r_gridff2;
 
 QDataStream SIREMM_EXPORT &operator<<(QDataStream &ds, const GridFF2 &gridff2)
 {
-    writeHeader(ds, r_gridff2, 1);
+    writeHeader(ds, r_gridff2, 2);
     
     SharedDataStream sds(ds);
     
+    sds << gridff2.use_lj_grid << gridff2.use_tricubic
+        << MultiFloat::toArray(gridff2.close_mols_x)
+        << MultiFloat::toArray(gridff2.close_mols_y)
+        << MultiFloat::toArray(gridff2.close_mols_z)
+        << MultiFloat::toArray(gridff2.close_mols_q)
+        << MultiFloat::toArray(gridff2.close_mols_sig)
+        << MultiFloat::toArray(gridff2.close_mols_eps);
+    
     sds << gridff2.gridbox << gridff2.dimx << gridff2.dimy << gridff2.dimz
         << gridff2.gridpot
         << gridff2.buffer_size << gridff2.grid_spacing
@@ -115,12 +127,27 @@ QDataStream SIREMM_EXPORT &operator>>(QDataStream &ds, GridFF2 &gridff2)
 {
     VersionID v = readHeader(ds, r_gridff2);
 
-    if (v == 1)
+    if (v == 1 or v == 2)
     {
         SharedDataStream sds(ds);
         
         gridff2 = GridFF2();
         
+        if (v == 2)
+        {
+            QVector<float> x, y, z, q, sig, eps;
+            
+            sds >> gridff2.use_lj_grid >> gridff2.use_tricubic
+                >> x >> y >> z >> q >> sig >> eps;
+            
+            gridff2.close_mols_x = MultiFloat::fromArray(x);
+            gridff2.close_mols_y = MultiFloat::fromArray(y);
+            gridff2.close_mols_z = MultiFloat::fromArray(z);
+            gridff2.close_mols_q = MultiFloat::fromArray(q);
+            gridff2.close_mols_sig = MultiFloat::fromArray(sig);
+            gridff2.close_mols_eps = MultiFloat::fromArray(eps);
+        }
+        
         gridff2.fixedatoms_coords.clear();
         gridff2.fixedatoms_params.clear();
         
@@ -191,7 +218,7 @@ QDataStream SIREMM_EXPORT &operator>>(QDataStream &ds, GridFF2 &gridff2)
         gridff2.need_update_ljpairs = true;
     }
     else
-        throw version_error(v, "1", r_gridff2, CODELOC);
+        throw version_error(v, "1,2", r_gridff2, CODELOC);
         
     return ds;
 }
@@ -200,7 +227,8 @@ QDataStream SIREMM_EXPORT &operator>>(QDataStream &ds, GridFF2 &gridff2)
 GridFF2::GridFF2() 
        : ConcreteProperty<GridFF2,InterGroupCLJFF>(),
          buffer_size(2.5), grid_spacing(1.0), 
-         coul_cutoff(50), lj_cutoff(7.5)
+         coul_cutoff(50), lj_cutoff(7.5),
+         use_lj_grid(false), use_tricubic(false)
 {
     this->setSwitchingFunction(NoCutoff());
 }
@@ -209,7 +237,8 @@ GridFF2::GridFF2()
 GridFF2::GridFF2(const QString &name) 
        : ConcreteProperty<GridFF2,InterGroupCLJFF>(name),
          buffer_size(2.5), grid_spacing(1.0), 
-         coul_cutoff(50), lj_cutoff(7.5)
+         coul_cutoff(50), lj_cutoff(7.5),
+         use_lj_grid(false), use_tricubic(false)
 {
     this->setSwitchingFunction(NoCutoff());
 }
@@ -222,10 +251,16 @@ GridFF2::GridFF2(const GridFF2 &other)
          coul_cutoff(other.coul_cutoff), lj_cutoff(other.lj_cutoff),
          dimx(other.dimx), dimy(other.dimy), dimz(other.dimz),
          gridpot(other.gridpot),
+         ljrep_grids(other.ljrep_grids), ljdisp_grids(other.ljdisp_grids),
+         use_lj_grid(other.use_lj_grid), use_tricubic(other.use_tricubic),
+         cache_key(other.cache_key),
          fixedatoms_coords(other.fixedatoms_coords),
          fixedatoms_params(other.fixedatoms_params),
          closemols_coords(other.closemols_coords),
          closemols_params(other.closemols_params),
+         close_mols_x(other.close_mols_x), close_mols_y(other.close_mols_y),
+         close_mols_z(other.close_mols_z), close_mols_q(other.close_mols_q),
+         close_mols_sig(other.close_mols_sig), close_mols_eps(other.close_mols_eps),
          oldnrgs(other.oldnrgs)
 {
     this->setSwitchingFunction(NoCutoff());
@@ -259,10 +294,21 @@ GridFF2& GridFF2::operator=(const GridFF2 &other)
         dimy = other.dimy;
         dimz = other.dimz;
         gridpot = other.gridpot;
+        ljrep_grids = other.ljrep_grids;
+        ljdisp_grids = other.ljdisp_grids;
+        use_lj_grid = other.use_lj_grid;
+        use_tricubic = other.use_tricubic;
+        cache_key = other.cache_key;
         fixedatoms_coords = other.fixedatoms_coords;
         fixedatoms_params = other.fixedatoms_params;
         closemols_coords = other.closemols_coords;
         closemols_params = other.closemols_params;
+        close_mols_x = other.close_mols_x;
+        close_mols_y = other.close_mols_y;
+        close_mols_z = other.close_mols_z;
+        close_mols_q = other.close_mols_q;
+        close_mols_sig = other.close_mols_sig;
+        close_mols_eps = other.close_mols_eps;
         oldnrgs = other.oldnrgs;
     
         InterGroupCLJFF::operator=(other);
@@ -276,6 +322,8 @@ bool GridFF2::operator==(const GridFF2 &other) const
 {
     return buffer_size == other.buffer_size and
            grid_spacing == other.grid_spacing and
+           use_lj_grid == other.use_lj_grid and
+           use_tricubic == other.use_tricubic and
            InterGroupCLJFF::operator==(other);
 }
 
@@ -536,6 +584,47 @@ SireUnits::Dimension::Length GridFF2::ljCutoff() const
     return SireUnits::Dimension::Length(lj_cutoff);
 }
 
+/** Switch on or off holding the coulomb and LJ potentials of the close
+    atoms (those within the LJ cutoff of the grid) on grids, so that
+    they don't need to be evaluated explicitly. The LJ grids are built
+    for each LJ type of the group 0 atoms as they are needed. The potentials
+    are evaluated using a minimum distance of 0.5 A from each close atom, 
+    so that the grids are not swamped by the repulsion at the atom centers */
+void GridFF2::setUseLJGrid(bool on)
+{
+    if (use_lj_grid != on)
+    {
+        use_lj_grid = on;
+        this->mustNowRecalculateFromScratch();
+    }
+}
+
+/** Return whether or not the energies with the close atoms are
+    calculated using grids */
+bool GridFF2::usesLJGrid() const
+{
+    return use_lj_grid;
+}
+
+/** Switch on or off use of tricubic interpolation of the grids. This gives
+    smoother energies than tri-linear interpolation, at the cost of reading
+    64 rather than 8 grid points for each atom. The interpolated value is limited
+    to lie between the values on the corners of the grid box containing the atom */
+void GridFF2::setUseTricubicInterpolation(bool on)
+{
+    if (use_tricubic != on)
+    {
+        use_tricubic = on;
+        this->mustNowRecalculateFromScratch();
+    }
+}
+
+/** Return whether or not tricubic interpolation of the grids is used */
+bool GridFF2::usesTricubicInterpolation() const
+{
+    return use_tricubic;
+}
+
 inline GridFF2::Vector4::Vector4(const Vector &v, double chg)
               : x(v.x()), y(v.y()), z(v.z()), q(chg)
 {}
@@ -586,13 +675,6 @@ static void arrayIndexToGridIndex(int ipt, int dimx, int dimy, int dimz,
     iz = ipt % dimz;*/
 }
 
-/** Convert the indicies ix, iy, iz for the 3-dimensional array of dimension
-    dimx, dimy, dimz into the returned index into the corresponding 1-dimensional array */
-static int gridIndexToArrayIndex(int ix, int iy, int iz, int dimx, int dimy, int dimz)
-{
-    return ix*(dimy*dimz) + iy*dimz + iz;
-}
-
 static void getGridPoint(int ipt, const Vector &min, int dimx, int dimy, int dimz,
                          double grid_spacing, MultiDouble &x, MultiDouble &y, MultiDouble &z)
 {
@@ -615,7 +697,9 @@ static void getGridPoint(int ipt, const Vector &min, int dimx, int dimy, int dim
     z = MultiFloat( min.z() + iz*grid_spacing );
 }
 
-/** Function used to add the potential from the passed points to the grid */
+/** Function used to add the potential from the passed points to the grid. The
+    distance between each point and grid point is limited to be no less than
+    detail::clj_grid_min_distance, so that close atoms can be added to the grid */
 void GridFF2::addToGrid(const QVector<float> &vx,
                         const QVector<float> &vy,
                         const QVector<float> &vz,
@@ -641,6 +725,8 @@ void GridFF2::addToGrid(const QVector<float> &vx,
     const MultiFloat *aq = mq.constData();
     
     const MultiFloat Rc( coul_cutoff );
+    const MultiFloat min_r( detail::clj_grid_min_distance );
+    const MultiFloat min_r2( detail::clj_grid_min_distance * detail::clj_grid_min_distance );
     MultiFloat r, tmp;
     MultiFloat gx, gy, gz;
     MultiDouble cnrg;
@@ -666,7 +752,7 @@ void GridFF2::addToGrid(const QVector<float> &vx,
                 r.multiplyAdd(tmp, tmp);
                 tmp = az[ivec] - gz;
                 r.multiplyAdd(tmp, tmp);
-                r = r.sqrt();
+                r = r.sqrt().max(min_r);
                 
                 //calculate the coulomb energy using shift-electrostatics
                 // energy = q * { 1/r - 1/Rc + 1/Rc^2 [r - Rc] }
@@ -714,6 +800,7 @@ void GridFF2::addToGrid(const QVector<float> &vx,
                 // energy = q * { 1/r - c_rf + k_rf * r^2 }
                 // where k_rf = (1 / r_c^3) * (eps - 1)/(2 eps + 1)
                 // c_rf = (1/r_c) * (3 eps)/(2 eps + 1)
+                r = r.max(min_r2);
                 tmp = r;
                 r = r.sqrt();
                 tmp *= k_rf;
@@ -750,7 +837,7 @@ void GridFF2::addToGrid(const QVector<float> &vx,
                 r.multiplyAdd(tmp, tmp);
                 tmp = az[ivec] - gz;
                 r.multiplyAdd(tmp, tmp);
-                r = r.sqrt();
+                r = r.sqrt().max(min_r);
                 
                 //calculate the coulomb energy using coulomb's law
                 // energy = q * { 1/r }
@@ -966,6 +1053,25 @@ void GridFF2::rebuildGrid()
     gridpot = QVector<double>(dimx*dimy*dimz, 0.0);
     gridpot.squeeze();
 
+    //see if this grid has already been calculated and saved to the cache
+    bool grid_from_cache = false;
+    cache_key = QString();
+    
+    if (CLJGridCache::isEnabled())
+    {
+        cache_key = this->createCacheKey();
+        
+        QVector<double> pot = CLJGridCache::loadDoubles(gridCacheKey("coulomb"),
+                                                        dimx*dimy*dimz);
+        
+        if (not pot.isEmpty())
+        {
+            qDebug() << "Loaded the potential grid from the grid cache.";
+            gridpot = pot;
+            grid_from_cache = true;
+        }
+    }
+
     closemols_coords.clear();
     closemols_params.clear();
 
@@ -1038,7 +1144,8 @@ void GridFF2::rebuildGrid()
                     
                         if (far_mols_x.count() > 1023)
                         {
-                            addToGrid(far_mols_x, far_mols_y, far_mols_z, far_mols_q);
+                            if (not grid_from_cache)
+                                addToGrid(far_mols_x, far_mols_y, far_mols_z, far_mols_q);
                             gridcount += far_mols_x.count();
                             far_mols_x.clear();
                             far_mols_y.clear();
@@ -1052,7 +1159,8 @@ void GridFF2::rebuildGrid()
             }
         }
         
-        addToGrid(far_mols_x, far_mols_y, far_mols_z, far_mols_q);
+        if (not grid_from_cache)
+            addToGrid(far_mols_x, far_mols_y, far_mols_z, far_mols_q);
         gridcount += far_mols_x.count();
         far_mols_x.clear();
         far_mols_y.clear();
@@ -1132,7 +1240,8 @@ void GridFF2::rebuildGrid()
                     
                                 if (far_mols_x.count() > 1023)
                                 {
-                                    addToGrid(far_mols_x, far_mols_y, far_mols_z, far_mols_q);
+                                    if (not grid_from_cache)
+                                        addToGrid(far_mols_x, far_mols_y, far_mols_z, far_mols_q);
                                     gridcount += far_mols_x.count();
                                     far_mols_x.clear();
                                     far_mols_y.clear();
@@ -1148,7 +1257,8 @@ void GridFF2::rebuildGrid()
             }
         }
         
-        addToGrid(far_mols_x, far_mols_y, far_mols_z, far_mols_q);
+        if (not grid_from_cache)
+            addToGrid(far_mols_x, far_mols_y, far_mols_z, far_mols_q);
         gridcount += far_mols_x.count();
         far_mols_x.clear();
         far_mols_y.clear();
@@ -1159,6 +1269,20 @@ void GridFF2::rebuildGrid()
         qDebug() << "The number of grid evaluated atoms is now" << gridcount;
     }
  
+    if (not grid_from_cache)
+    {
+        if (use_lj_grid)
+        {
+            //the coulomb potential of the close atoms is also held on the grid
+            addToGrid(cmols_x, cmols_y, cmols_z, cmols_q);
+            qDebug() << "Added the coulomb potential of the" << atomcount
+                     << "close atoms to the grid.";
+        }
+        
+        if (not cache_key.isEmpty())
+            CLJGridCache::save(gridCacheKey("coulomb"), gridpot);
+    }
+ 
     // convert the QVector<float> arrays into QVector<MultiFloat>
     close_mols_x = MultiFloat::fromArray(cmols_x);
     close_mols_y = MultiFloat::fromArray(cmols_y);
@@ -1187,6 +1311,194 @@ void GridFF2::rebuildGrid()
     }
 }
 
+/** Internal function used to build the grids of the repulsive and dispersion
+    LJ potentials of the close atoms acting on group 0 atoms with LJ ID 'ljid'.
+    The grids are scaled by the square root of epsilon of 'ljid', so that
+    the LJ energy of an atom is 4 * (repulsion - dispersion). The distance 
+    between each grid point and close atom is limited to be no less than
+    detail::clj_grid_min_distance */
+void GridFF2::buildLJGrid(quint32 ljid)
+{
+    const int npts = dimx*dimy*dimz;
+
+    const LJParameter lj = LJParameterDB::getLJParameter(ljid);
+
+    //see if this grid has already been calculated and saved to the cache
+    QString rep_key, disp_key;
+    
+    if (not cache_key.isEmpty())
+    {
+        const QString ljtype = QString("%1:%2").arg(lj.sigma(), 0, 'g', 17)
+                                               .arg(lj.epsilon(), 0, 'g', 17);
+    
+        rep_key = gridCacheKey( QString("lj-repulsion:%1").arg(ljtype) );
+        disp_key = gridCacheKey( QString("lj-dispersion:%1").arg(ljtype) );
+        
+        QVector<double> repgrid = CLJGridCache::loadDoubles(rep_key, npts);
+        QVector<double> dispgrid = CLJGridCache::loadDoubles(disp_key, npts);
+        
+        if (not (repgrid.isEmpty() or dispgrid.isEmpty()))
+        {
+            ljrep_grids.insert(ljid, repgrid);
+            ljdisp_grids.insert(ljid, dispgrid);
+            return;
+        }
+    }
+
+    QVector<double> repgrid(npts, 0.0);
+    QVector<double> dispgrid(npts, 0.0);
+
+    const int nvecs = close_mols_x.count();
+
+    if (nvecs > 0 and lj.epsilon() != 0)
+    {
+        double *rep = repgrid.data();
+        double *disp = dispgrid.data();
+    
+        const MultiFloat *ax = close_mols_x.constData();
+        const MultiFloat *ay = close_mols_y.constData();
+        const MultiFloat *az = close_mols_z.constData();
+        const MultiFloat *asig = close_mols_sig.constData();
+        const MultiFloat *aeps = close_mols_eps.constData();
+    
+        const Vector minpoint = gridbox.minCoords();
+    
+        const MultiFloat Rlj( lj_cutoff );
+        const MultiFloat min_r( detail::clj_grid_min_distance );
+        const MultiFloat half(0.5);
+        const MultiFloat sig( lj.sigma() );
+        const MultiFloat sqrt_eps( std::sqrt(lj.epsilon()) );
+        
+        MultiFloat r, tmp, sig2_over_r2, sig6_over_r6;
+        MultiFloat gx, gy, gz;
+        MultiDouble irep, idisp;
+    
+        //loop over each grid point
+        for (int ipt=0; ipt<npts; ++ipt)
+        {
+            getGridPoint(ipt, minpoint, dimx, dimy, dimz, grid_spacing, gx, gy, gz);
+            
+            irep = 0;
+            idisp = 0;
+            
+            for (int ivec=0; ivec<nvecs; ++ivec)
+            {
+                //calculate the distance between the atom and grid point (r)
+                tmp = ax[ivec] - gx;
+                r = tmp * tmp;
+                tmp = ay[ivec] - gy;
+                r.multiplyAdd(tmp, tmp);
+                tmp = az[ivec] - gz;
+                r.multiplyAdd(tmp, tmp);
+                r = r.sqrt().max(min_r);
+
+                //arithmetic combining rules
+                tmp = sig + (asig[ivec]*asig[ivec]);
+                tmp *= half;
+                
+                sig2_over_r2 = tmp / r;
+                sig2_over_r2 = sig2_over_r2*sig2_over_r2;
+                sig6_over_r6 = sig2_over_r2*sig2_over_r2;
+                sig6_over_r6 = sig6_over_r6*sig2_over_r2;
+                
+                //epsilon of the pair, with the cutoff applied - compare r against 
+                //Rlj. This will return 1 if r is less than Rlj, or 0 otherwise
+                tmp = sqrt_eps * aeps[ivec];
+                tmp = tmp.logicalAnd( r.compareLess(Rlj) );
+                
+                irep += tmp * (sig6_over_r6 * sig6_over_r6);
+                idisp += tmp * sig6_over_r6;
+            }
+            
+            rep[ipt] = irep.sum();
+            disp[ipt] = idisp.sum();
+        }
+    }
+
+    if (not rep_key.isEmpty())
+    {
+        CLJGridCache::save(rep_key, repgrid);
+        CLJGridCache::save(disp_key, dispgrid);
+    }
+
+    ljrep_grids.insert(ljid, repgrid);
+    ljdisp_grids.insert(ljid, dispgrid);
+}
+
+/** Internal function that returns the key that identifies everything that 
+    determines the values on the grids (the fixed and group 1 atoms, the
+    space, the grid dimensions and the cutoffs and electrostatics
+    settings) in the grid cache */
+QString GridFF2::createCacheKey() const
+{
+    QByteArray data;
+    
+    {
+        QDataStream ds(&data, QIODevice::WriteOnly);
+        SharedDataStream sds(ds);
+        
+        sds << QString(GridFF2::typeName())
+            << gridbox << dimx << dimy << dimz << grid_spacing
+            << coul_cutoff << lj_cutoff << use_lj_grid
+            << shiftElectrostatics() << useReactionField()
+            << reactionFieldDielectric() << this->space();
+        
+        //the LJ IDs differ between processes, so write the LJ parameters
+        LJParameterDB::lock();
+        
+        try
+        {
+            for (int i=0; i<fixedatoms_coords.count(); ++i)
+            {
+                const detail::CLJParameter &param = fixedatoms_params.constData()[i];
+            
+                sds << fixedatoms_coords.constData()[i] << param.reduced_charge
+                    << LJParameterDB::_locked_getLJParameter(param.ljid);
+            }
+            
+            for (ChunkedVector<CLJMolecule>::const_iterator 
+                                    it = mols[1].moleculesByIndex().constBegin();
+                 it != mols[1].moleculesByIndex().constEnd();
+                 ++it)
+            {
+                const CoordGroupArray &coords = (*it).coordinates();
+                const CLJParameters::Array *params_array
+                                    = (*it).parameters().atomicParameters().constData();
+                
+                for (int igroup=0; igroup<coords.count(); ++igroup)
+                {
+                    const CoordGroup &group = coords.constData()[igroup];
+                    const CLJParameters::Array &params = params_array[igroup];
+                    
+                    for (int i=0; i<group.count(); ++i)
+                    {
+                        const detail::CLJParameter &param = params.constData()[i];
+                    
+                        sds << group.constData()[i] << param.reduced_charge
+                            << LJParameterDB::_locked_getLJParameter(param.ljid);
+                    }
+                }
+            }
+        }
+        catch(...)
+        {
+            LJParameterDB::unlock();
+            throw;
+        }
+        
+        LJParameterDB::unlock();
+    }
+    
+    return CLJGridCache::createKey(data);
+}
+
+/** Internal function that returns the key of the grid called 'grid_name'
+    in the grid cache */
+QString GridFF2::gridCacheKey(const QString &grid_name) const
+{
+    return CLJGridCache::createKey( QString("%1:%2").arg(cache_key, grid_name).toUtf8() );
+}
+
 GridFF2::CLJAtoms::CLJAtoms()
 {}
 
@@ -1446,6 +1758,7 @@ void GridFF2::calculateEnergy(const CoordGroup &coords0,
     double cnrg = 0;
     double ljnrg = 0;
     double gridnrg = 0;
+    double gridljnrg = 0;
 
     const int nats0 = coords0.count();
 
@@ -1457,16 +1770,20 @@ void GridFF2::calculateEnergy(const CoordGroup &coords0,
 
     BOOST_ASSERT( closemols_coords.count() == closemols_params.count() );
 
-    CLJAtoms atoms0(coords0, params0);
-    CLJAtoms atoms1;
-    atoms1.x = close_mols_x;
-    atoms1.y = close_mols_y;
-    atoms1.z = close_mols_z;
-    atoms1.q = close_mols_q;
-    atoms1.sig = close_mols_sig;
-    atoms1.eps = close_mols_eps;
-
-    calculateEnergy(atoms0, atoms1, cnrg, ljnrg);
+    //the energies with the close atoms are held on the grids if use_lj_grid is true
+    if (not use_lj_grid)
+    {
+        CLJAtoms atoms0(coords0, params0);
+        CLJAtoms atoms1;
+        atoms1.x = close_mols_x;
+        atoms1.y = close_mols_y;
+        atoms1.z = close_mols_z;
+        atoms1.q = close_mols_q;
+        atoms1.sig = close_mols_sig;
+        atoms1.eps = close_mols_eps;
+
+        calculateEnergy(atoms0, atoms1, cnrg, ljnrg);
+    }
 
     //now calculate the energy in the grid
     if (not gridpot.isEmpty())
@@ -1493,66 +1810,47 @@ void GridFF2::calculateEnergy(const CoordGroup &coords0,
             }
             else
             {
-                //use tri-linear interpolation to get the potential at the atom
-                //
-                // This is described in 
-                //
-                // Davis, Madura and McCammon, Comp. Phys. Comm., 62, 187-197, 1991
-                //
-                // phi(x,y,z) = phi(i  ,j  ,k  )*(1-R)(1-S)(1-T) +
-                //              phi(i+1,j  ,k  )*(  R)(1-S)(1-T) +
-                //              phi(i  ,j+1,k  )*(1-R)(  S)(1-T) +
-                //              phi(i  ,j  ,k+1)*(1-R)(1-S)(  T) +
-                //              phi(i+1,j+1,k  )*(  R)(  S)(1-T) +
-                //              phi(i+1,j  ,k+1)*(  R)(1-S)(  T) +
-                //              phi(i  ,j+1,k+1)*(1-R)(  S)(  T) +
-                //              phi(i+1,j+1,k+1)*(  R)(  S)(  T) +
-                //
-                // where R, S and T are the coordinates of the atom in 
-                // fractional grid coordinates from the point (i,j,k), e.g.
-                // (0,0,0) is (i,j,k) and (1,1,1) is (i+1,j+1,k+1)
-                //
-                const Vector c000 = gridbox.minCoords() + 
-                                        Vector( i_0 * grid_spacing,
-                                                j_0 * grid_spacing,
-                                                k_0 * grid_spacing );
-
-                const Vector RST = (c0 - c000) / grid_spacing;
-                const double R = RST.x();
-                const double S = RST.y();
-                const double T = RST.z();
-                
-                int i000 = gridIndexToArrayIndex(i_0  , j_0  , k_0  , dimx, dimy, dimz);
-                int i001 = gridIndexToArrayIndex(i_0  , j_0  , k_0+1, dimx, dimy, dimz);
-                int i010 = gridIndexToArrayIndex(i_0  , j_0+1, k_0  , dimx, dimy, dimz);
-                int i100 = gridIndexToArrayIndex(i_0+1, j_0  , k_0  , dimx, dimy, dimz);
-                int i011 = gridIndexToArrayIndex(i_0  , j_0+1, k_0+1, dimx, dimy, dimz);
-                int i101 = gridIndexToArrayIndex(i_0+1, j_0  , k_0+1, dimx, dimy, dimz);
-                int i110 = gridIndexToArrayIndex(i_0+1, j_0+1, k_0  , dimx, dimy, dimz);
-                int i111 = gridIndexToArrayIndex(i_0+1, j_0+1, k_0+1, dimx, dimy, dimz);
-                
-                double phi = (gridpot_array[i000] * (1-R)*(1-S)*(1-T)) + 
-                             (gridpot_array[i001] * (1-R)*(1-S)*(  T)) +
-                             (gridpot_array[i010] * (1-R)*(  S)*(1-T)) +
-                             (gridpot_array[i100] * (  R)*(1-S)*(1-T)) +
-                             (gridpot_array[i011] * (1-R)*(  S)*(  T)) +
-                             (gridpot_array[i101] * (  R)*(1-S)*(  T)) +
-                             (gridpot_array[i110] * (  R)*(  S)*(1-T)) +
-                             (gridpot_array[i111] * (  R)*(  S)*(  T));                         
+                //interpolate the potential at the atom
+                double phi = detail::interpolateGrid(gridpot_array, gridbox.minCoords(),
+                                                     grid_spacing, dimx, dimy, dimz,
+                                                     i_0, j_0, k_0, c0, use_tricubic);
                                   
                 gridnrg += phi * p0.reduced_charge;
+                
+                if (use_lj_grid and p0.ljid != 0)
+                {
+                    if (not ljrep_grids.contains(p0.ljid))
+                        buildLJGrid(p0.ljid);
+                    
+                    const double rep = detail::interpolateGrid(
+                                            ljrep_grids.constFind(p0.ljid)->constData(),
+                                            gridbox.minCoords(), grid_spacing,
+                                            dimx, dimy, dimz, i_0, j_0, k_0,
+                                            c0, use_tricubic);
+
+                    const double disp = detail::interpolateGrid(
+                                            ljdisp_grids.constFind(p0.ljid)->constData(),
+                                            gridbox.minCoords(), grid_spacing,
+                                            dimx, dimy, dimz, i_0, j_0, k_0,
+                                            c0, use_tricubic);
+                    
+                    gridljnrg += rep - disp;
+                }
             }
         }
     }
 
     return_cnrg = cnrg + gridnrg;
-    return_ljnrg = ljnrg;
+    return_ljnrg = ljnrg + 4.0*gridljnrg;
 }
 
 /** Ensure that the next energy evaluation is from scratch */
 void GridFF2::mustNowRecalculateFromScratch()
 {
     gridpot.clear();
+    ljrep_grids.clear();
+    ljdisp_grids.clear();
+    cache_key = QString();
     closemols_coords.clear();
     closemols_params.clear();
     oldnrgs.clear();
@@ -107,6 +107,12 @@ public:
     SireUnits::Dimension::Length coulombCutoff() const;
     SireUnits::Dimension::Length ljCutoff() const;
 
+    void setUseLJGrid(bool on);
+    bool usesLJGrid() const;
+
+    void setUseTricubicInterpolation(bool on);
+    bool usesTricubicInterpolation() const;
+
     void mustNowRecalculateFromScratch();    
 
 protected:
@@ -125,6 +131,9 @@ protected:
 private:
     void rebuildGrid();
 
+    QString createCacheKey() const;
+    QString gridCacheKey(const QString &grid_name) const;
+
     typedef InterGroupCLJFF::Parameters CLJParameters;
     typedef InterGroupCLJFF::Molecule CLJMolecule;
     typedef InterGroupCLJFF::Molecules CLJMolecules;
@@ -197,6 +206,8 @@ private:
     void addToGrid(const QVector<float> &vx, const QVector<float> &vy,
                    const QVector<float> &vz, const QVector<float> &vq);
 
+    void buildLJGrid(quint32 ljid);
+
     void calculateEnergy(const SireVol::CoordGroup &coords,
                          const CLJParameters::Array &params,
                          double &cnrg, double &ljnrg);
@@ -228,6 +239,23 @@ private:
 
     /** The grid of coulomb potentials */
     QVector<double> gridpot;
+
+    /** The grids of the repulsive and dispersion LJ potentials of the
+        close atoms, indexed by the LJ ID of the group 0 atoms that use them */
+    QHash<quint32,QVector<double> > ljrep_grids;
+    QHash<quint32,QVector<double> > ljdisp_grids;
+
+    /** Whether or not the LJ and coulomb energies with the close
+        atoms are held on the grids, rather than evaluated explicitly */
+    bool use_lj_grid;
+
+    /** Whether or not tricubic interpolation of the grids is used */
+    bool use_tricubic;
+
+    /** The key that identifies the atoms and settings used to build
+        the current grids in the grid cache (CLJGridCache). This is
+        empty if the cache is disabled, or the grids are not yet built */
+    QString cache_key;
     
     /** The set of coordinates and parameters for the fixed atoms.
         These are atoms which exist only in this GridFF, thereby
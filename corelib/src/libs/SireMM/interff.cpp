@@ -44,6 +44,12 @@
 #include "SireMol/atomselection.h"
 #include "SireMol/selector.hpp"
 
+#include "SireFF/errors.h"
+
+#include "SireCAS/symbols.h"
+
+#include "tostring.h"
+
 #include "SireStream/datastream.h"
 #include "SireStream/shareddatastream.h"
 
@@ -64,7 +70,7 @@ namespace SireMM
         {
         public:
             InterFFData() : QSharedData(), fixed_only(false),
-                            parallel_calc(true), repro_sum(false)
+                            parallel_calc(true), repro_sum(false), use_pairlist(false)
             {}
             
             InterFFData(const InterFFData &other)
@@ -75,7 +81,9 @@ namespace SireMM
                    props(other.props),
                    fixed_only(other.fixed_only),
                    parallel_calc(other.parallel_calc),
-                   repro_sum(other.repro_sum)
+                   repro_sum(other.repro_sum),
+                   use_pairlist(other.use_pairlist),
+                   pairlist(other.pairlist)
             {}
             
             ~InterFFData()
@@ -103,6 +111,13 @@ namespace SireMM
             
             /** Whether or not to sum energies using a reproducible sum */
             bool repro_sum;
+            
+            /** Whether or not to use a neighbour list for the energies
+                and forces of the default CLJFunction */
+            bool use_pairlist;
+            
+            /** The neighbour list used for the default CLJFunction */
+            CLJPairList pairlist;
         };
     }
 }
@@ -111,7 +126,7 @@ static RegisterMetaType<InterFF> r_interff;
 
 QDataStream SIREMM_EXPORT &operator<<(QDataStream &ds, const InterFF &interff)
 {
-    writeHeader(ds, r_interff, 3);
+    writeHeader(ds, r_interff, 4);
     
     SharedDataStream sds(ds);
     
@@ -121,6 +136,7 @@ QDataStream SIREMM_EXPORT &operator<<(QDataStream &ds, const InterFF &interff)
         << interff.d->fixed_atoms
         << interff.d->fixed_only << interff.d->parallel_calc
         << interff.d->repro_sum
+        << interff.d->use_pairlist << interff.d->pairlist
         << static_cast<const G1FF&>(interff);
 
     return ds;
@@ -130,7 +146,7 @@ QDataStream SIREMM_EXPORT &operator>>(QDataStream &ds, InterFF &interff)
 {
     VersionID v = readHeader(ds, r_interff);
     
-    if (v == 3)
+    if (v == 4)
     {
         SharedDataStream sds(ds);
         
@@ -139,13 +155,31 @@ QDataStream SIREMM_EXPORT &operator>>(QDataStream &ds, InterFF &interff)
             >> interff.d->fixed_atoms
             >> interff.d->fixed_only >> interff.d->parallel_calc
             >> interff.d->repro_sum
+            >> interff.d->use_pairlist >> interff.d->pairlist
             >> static_cast<G1FF&>(interff);
         
         interff.rebuildProps();
         interff._pvt_updateName();
     }
+    else if (v == 3)
+    {
+        SharedDataStream sds(ds);
+        
+        sds >> interff.cljgroup >> interff.needs_accepting
+            >> interff.d->cljfuncs >> interff.d->cljcomps
+            >> interff.d->fixed_atoms
+            >> interff.d->fixed_only >> interff.d->parallel_calc
+            >> interff.d->repro_sum
+            >> static_cast<G1FF&>(interff);
+        
+        interff.d->use_pairlist = false;
+        interff.d->pairlist = CLJPairList();
+        
+        interff.rebuildProps();
+        interff._pvt_updateName();
+    }
     else
-        throw version_error(v, "3", r_interff, CODELOC);
+        throw version_error(v, "3,4", r_interff, CODELOC);
     
     return ds;
 }
@@ -172,7 +206,7 @@ InterFF::InterFF(const QString &name)
 
 /** Copy constructor */
 InterFF::InterFF(const InterFF &other)
-        : ConcreteProperty<InterFF,G1FF>(other),
+        : ConcreteProperty<InterFF,G1FF>(other), FF3D(other),
           cljgroup(other.cljgroup), d(other.d),
           needs_accepting(other.needs_accepting)
 {}
@@ -398,11 +432,16 @@ void InterFF::rebuildProps()
     
     d->props.setProperty("cljFunction", this->cljFunction());
     d->props.setProperty("useGrid", BooleanProperty(d->fixed_atoms[0].usesGrid()));
+    d->props.setProperty("useLJGrid", BooleanProperty(d->fixed_atoms[0].usesLJGrid()));
+    d->props.setProperty("tricubicInterpolation",
+                         BooleanProperty(d->fixed_atoms[0].usesTricubicInterpolation()));
     d->props.setProperty("gridBuffer", LengthProperty(d->fixed_atoms[0].gridBuffer()));
     d->props.setProperty("gridSpacing", LengthProperty(d->fixed_atoms[0].gridSpacing()));
     d->props.setProperty("fixedOnly", BooleanProperty(d->fixed_only));
     d->props.setProperty("parallelCalculation", BooleanProperty(d->parallel_calc));
     d->props.setProperty("reproducibleCalculation", BooleanProperty(d->repro_sum));
+    d->props.setProperty("usePairList", BooleanProperty(d->use_pairlist));
+    d->props.setProperty("pairListSkin", LengthProperty(d->pairlist.skin()));
 
     for (int i=0; i<d->fixed_atoms.count(); ++i)
     {
@@ -443,6 +482,30 @@ bool InterFF::setProperty(const QString &name, const Property &property)
         else
             return false;
     }
+    else if (name == "useLJGrid")
+    {
+        bool use_lj_grid = property.asA<BooleanProperty>().value();
+        
+        if (use_lj_grid != this->usesLJGrid())
+        {
+            this->setUseLJGrid(use_lj_grid);
+            return true;
+        }
+        else
+            return false;
+    }
+    else if (name == "tricubicInterpolation")
+    {
+        bool use_tricubic = property.asA<BooleanProperty>().value();
+        
+        if (use_tricubic != this->usesTricubicInterpolation())
+        {
+            this->setUseTricubicInterpolation(use_tricubic);
+            return true;
+        }
+        else
+            return false;
+    }
     else if (name == "gridBuffer")
     {
         Length buffer = property.asA<LengthProperty>().value();
@@ -529,6 +592,30 @@ bool InterFF::setProperty(const QString &name, const Property &property)
         else
             return false;
     }
+    else if (name == "usePairList")
+    {
+        bool use_pairlist = property.asA<BooleanProperty>().value();
+        
+        if (use_pairlist != this->usesPairList())
+        {
+            this->setUsePairList(use_pairlist);
+            return true;
+        }
+        else
+            return false;
+    }
+    else if (name == "pairListSkin")
+    {
+        Length skin = property.asA<LengthProperty>().value();
+        
+        if (skin != this->pairListSkin())
+        {
+            this->setPairListSkin(skin);
+            return true;
+        }
+        else
+            return false;
+    }
     else
     {
         bool found_property = false;
@@ -705,6 +792,84 @@ bool InterFF::usesGrid() const
     return false;
 }
 
+/** Set whether or not the LJ interactions with the fixed atoms are also
+    placed onto grids. This only has an effect if the grid is used */
+void InterFF::setUseLJGrid(bool on)
+{
+    if (this->usesLJGrid() != on)
+    {
+        for (int i=0; i<d->fixed_atoms.count(); ++i)
+        {
+            d->fixed_atoms[i].setUseLJGrid(on);
+        }
+        
+        this->mustNowRecalculateFromScratch();
+        d->props.setProperty("useLJGrid", BooleanProperty(this->usesLJGrid()));
+    }
+}
+
+/** Turn on placing the LJ interactions with the fixed atoms onto grids */
+void InterFF::enableLJGrid()
+{
+    this->setUseLJGrid(true);
+}
+
+/** Turn off placing the LJ interactions with the fixed atoms onto grids */
+void InterFF::disableLJGrid()
+{
+    this->setUseLJGrid(false);
+}
+
+/** Return whether or not the LJ interactions with the fixed atoms 
+    are calculated using grids */
+bool InterFF::usesLJGrid() const
+{
+    for (int i=0; i<d.constData()->fixed_atoms.count(); ++i)
+    {
+        if (d->fixed_atoms.at(i).usesLJGrid())
+            return true;
+    }
+
+    return false;
+}
+
+/** Set whether or not tricubic (rather than tri-linear) interpolation
+    of the grids is used */
+void InterFF::setUseTricubicInterpolation(bool on)
+{
+    if (this->usesTricubicInterpolation() != on)
+    {
+        for (int i=0; i<d->fixed_atoms.count(); ++i)
+        {
+            d->fixed_atoms[i].setUseTricubicInterpolation(on);
+        }
+        
+        this->mustNowRecalculateFromScratch();
+        d->props.setProperty("tricubicInterpolation", BooleanProperty(on));
+    }
+}
+
+/** Turn on tricubic interpolation of the grids */
+void InterFF::enableTricubicInterpolation()
+{
+    this->setUseTricubicInterpolation(true);
+}
+
+/** Turn off tricubic interpolation of the grids */
+void InterFF::disableTricubicInterpolation()
+{
+    this->setUseTricubicInterpolation(false);
+}
+
+/** Return whether or not tricubic interpolation of the grids is used */
+bool InterFF::usesTricubicInterpolation() const
+{
+    if (d.constData()->fixed_atoms.isEmpty())
+        return false;
+    else
+        return d.constData()->fixed_atoms.at(0).usesTricubicInterpolation();
+}
+
 /** Set whether or not to use a multicore parallel algorithm
     to calculate the energy */
 void InterFF::setUseParallelCalculation(bool on)
@@ -784,6 +949,59 @@ bool InterFF::usesReproducibleCalculation() const
     return d->repro_sum;
 }
 
+/** Switch on or off use of a neighbour list (CLJPairList) when calculating
+    the total energy and forces using the default CLJFunction. The list
+    is only rebuilt when an atom has moved by more than half of the skin,
+    so this speeds up repeated calculations on a system in which all 
+    of the atoms move by small amounts (e.g. molecular dynamics). 
+    The list is always calculated in parallel */
+void InterFF::setUsePairList(bool on)
+{
+    if (on != d.constData()->use_pairlist)
+    {
+        d->use_pairlist = on;
+        d->pairlist.clear();
+        d->props.setProperty("usePairList", BooleanProperty(on));
+    }
+}
+
+/** Turn on use of a neighbour list for the default CLJFunction */
+void InterFF::enablePairList()
+{
+    this->setUsePairList(true);
+}
+
+/** Turn off use of a neighbour list for the default CLJFunction */
+void InterFF::disablePairList()
+{
+    this->setUsePairList(false);
+}
+
+/** Return whether or not a neighbour list is used for the default CLJFunction */
+bool InterFF::usesPairList() const
+{
+    return d.constData()->use_pairlist;
+}
+
+/** Set the skin that is added onto the cutoff when building the
+    neighbour list. A larger skin means that the list is rebuilt less
+    often, but contains more pairs of atoms */
+void InterFF::setPairListSkin(Length skin)
+{
+    if (skin != d.constData()->pairlist.skin())
+    {
+        d->pairlist.setSkin(skin);
+        d->props.setProperty("pairListSkin", LengthProperty(d->pairlist.skin()));
+    }
+}
+
+/** Return the skin that is added onto the cutoff when building the
+    neighbour list */
+Length InterFF::pairListSkin() const
+{
+    return d.constData()->pairlist.skin();
+}
+
 /** Return whether or not only the energy between the mobile and fixed
     atoms is being calculated */
 bool InterFF::fixedOnly() const
@@ -887,6 +1105,22 @@ void InterFF::mustNowReallyRecalculateFromScratch()
     this->setDirty();
 }
 
+/** This forcefield can discard the changes made since the last energy
+    evaluation, so can restore its energies when a move is undone */
+bool InterFF::_pvt_canDiscardChanges() const
+{
+    return true;
+}
+
+/** Discard the changes made since the last energy evaluation. The molecules
+    have been restored to the versions used in that evaluation, so the changes
+    are committed to the CLJGroup without calculating the change in energy */
+void InterFF::_pvt_discardChanges()
+{
+    cljgroup.accept();
+    needs_accepting = false;
+}
+
 /** Recalculate the energy of this forcefield */
 void InterFF::recalculateEnergy()
 {
@@ -923,7 +1157,12 @@ void InterFF::recalculateEnergy()
             
             if (not d.constData()->fixed_only)
             {
-                if (d.constData()->parallel_calc)
+                if (d.constData()->use_pairlist)
+                {
+                    CLJCalculator calc(d.constData()->repro_sum);
+                    nrgs = calc.calculate(cljFunction(), cljgroup.cljBoxes(), d->pairlist);
+                }
+                else if (d.constData()->parallel_calc)
                 {
                     CLJCalculator calc(d->repro_sum);
                     nrgs = calc.calculate(cljFunction(), cljgroup.cljBoxes());
@@ -1317,3 +1556,203 @@ void InterFF::accept()
     
     G1FF::accept();
 }
+
+/** Internal function used to calculate the forces on the molecules in 
+    'forcetable' using the CLJFunction at index 'idx' (and its associated 
+    fixed atoms). The coulomb and/or LJ forces are calculated, scaled
+    by 'scale_force' and added onto the forcetable */
+void InterFF::calculateForces(ForceTable &forcetable, int idx, double scale_force,
+                              bool calc_coul, bool calc_lj)
+{
+    if (scale_force == 0 or not (calc_coul or calc_lj))
+        return;
+
+    //the forces must be calculated using the accepted state of the
+    //forcefield, as the CLJBoxes only hold the committed atoms
+    if (cljgroup.recalculatingFromScratch())
+        this->recalculateEnergy();
+    
+    if (cljgroup.needsAccepting() or needs_accepting)
+        throw SireError::invalid_state( QObject::tr(
+                "Cannot calculate the forces for forcefield %1 as it contains "
+                "a change that has not yet been accepted. Accept the change "
+                "by calling \"accept()\" before calculating the forces.")
+                    .arg(this->name().value()), CODELOC );
+    
+    if (cljgroup.isEmpty())
+        return;
+
+    const CLJFunction &func = d.constData()->cljfuncs.at(idx).read();
+    
+    if (not func.supportsForceCalculation())
+        throw SireError::unsupported( QObject::tr(
+                "Cannot calculate the forces for forcefield %1 as the CLJFunction "
+                "%2 does not support force calculations.")
+                    .arg(this->name().value()).arg(func.toString()), CODELOC );
+    
+    const CLJBoxes &boxes = cljgroup.cljBoxes();
+    
+    QVector<CLJForces> forces;
+    
+    if (not d.constData()->fixed_only)
+    {
+        if (idx == 0 and d.constData()->use_pairlist)
+        {
+            CLJCalculator calc(d.constData()->repro_sum);
+            CLJPairList &pairlist = d->pairlist;
+            
+            if (calc_coul and calc_lj)
+                calc.force(func, boxes, forces, pairlist, scale_force);
+            else if (calc_coul)
+                calc.coulombForce(func, boxes, forces, pairlist, scale_force);
+            else
+                calc.ljForce(func, boxes, forces, pairlist, scale_force);
+        }
+        else if (d.constData()->parallel_calc)
+        {
+            CLJCalculator calc(d.constData()->repro_sum);
+        
+            if (calc_coul and calc_lj)
+                calc.force(func, boxes, forces, scale_force);
+            else if (calc_coul)
+                calc.coulombForce(func, boxes, forces, scale_force);
+            else
+                calc.ljForce(func, boxes, forces, scale_force);
+        }
+        else
+        {
+            if (calc_coul and calc_lj)
+                func.force(boxes, forces, scale_force);
+            else if (calc_coul)
+                func.coulombForce(boxes, forces, scale_force);
+            else
+                func.ljForce(boxes, forces, scale_force);
+        }
+    }
+    
+    const CLJGrid &fixed_atoms = d.constData()->fixed_atoms.at(idx);
+    
+    if (not fixed_atoms.isEmpty())
+    {
+        //the fixed atoms do not move, so the forces on them are discarded
+        const CLJBoxes fixed_boxes(fixed_atoms.fixedAtoms(), boxes.length());
+        QVector<CLJForces> fixed_forces;
+        
+        if (calc_coul and calc_lj)
+            func.force(boxes, fixed_boxes, forces, fixed_forces, scale_force);
+        else if (calc_coul)
+            func.coulombForce(boxes, fixed_boxes, forces, fixed_forces, scale_force);
+        else
+            func.ljForce(boxes, fixed_boxes, forces, fixed_forces, scale_force);
+    }
+    
+    cljgroup.addForces(forces, forcetable);
+}
+
+/** Calculate the forces acting on the molecules in the passed forcetable  
+    and add them onto the forces present in the forcetable, optionally
+    scaled by 'scale_force'. This uses the default CLJFunction */
+void InterFF::force(ForceTable &forcetable, double scale_force)
+{
+    this->calculateForces(forcetable, 0, scale_force, true, true);
+}
+
+/** Calculate the forces acting on the molecules in the passed forcetable
+    caused by the component of the energy represented by 'symbol', and 
+    add them onto the forces present in the forcetable, optionally 
+    scaled by 'scale_force'
+    
+    \throw SireFF::missing_component
+*/
+void InterFF::force(ForceTable &forcetable, const Symbol &symbol, double scale_force)
+{
+    const MultiCLJComponent &comps = d.constData()->cljcomps;
+
+    foreach (QString key, comps.keys())
+    {
+        const int idx = comps.indexOf(key);
+        
+        if (symbol == comps.total(key))
+        {
+            this->calculateForces(forcetable, idx, scale_force, true, true);
+            return;
+        }
+        else if (symbol == comps.coulomb(key))
+        {
+            this->calculateForces(forcetable, idx, scale_force, true, false);
+            return;
+        }
+        else if (symbol == comps.lj(key))
+        {
+            this->calculateForces(forcetable, idx, scale_force, false, true);
+            return;
+        }
+    }
+    
+    throw SireFF::missing_component( QObject::tr(
+            "There is no forcefield component represented by %1 in the "
+            "forcefield %2. Available components are %3.")
+                .arg(symbol.toString(), this->toString(),
+                     Sire::toString(comps.symbols())), CODELOC );
+}
+
+void InterFF::field(FieldTable &fieldtable, double scale_field)
+{
+    throw SireError::incomplete_code( QObject::tr(
+                "The code to calculate the field of an InterFF has not "
+                "been written."), CODELOC );
+}
+
+void InterFF::field(FieldTable &fieldtable, const Symbol &component,
+                    double scale_field)
+{
+    throw SireError::incomplete_code( QObject::tr(
+                "The code to calculate the field of an InterFF has not "
+                "been written."), CODELOC );
+}
+
+void InterFF::potential(PotentialTable &potentialtable, double scale_potential)
+{
+    throw SireError::incomplete_code( QObject::tr(
+                "The code to calculate the potential of an InterFF has not "
+                "been written."), CODELOC );
+}
+
+void InterFF::potential(PotentialTable &potentialtable, const Symbol &component,
+                        double scale_potential)
+{
+    throw SireError::incomplete_code( QObject::tr(
+                "The code to calculate the potential of an InterFF has not "
+                "been written."), CODELOC );
+}
+
+void InterFF::field(FieldTable &fieldtable, const Probe &probe, double scale_field)
+{
+    throw SireError::incomplete_code( QObject::tr(
+                "The code to calculate the field of an InterFF has not "
+                "been written."), CODELOC );
+}
+
+void InterFF::field(FieldTable &fieldtable, const Symbol &component,
+                    const Probe &probe, double scale_field)
+{
+    throw SireError::incomplete_code( QObject::tr(
+                "The code to calculate the field of an InterFF has not "
+                "been written."), CODELOC );
+}
+
+void InterFF::potential(PotentialTable &potentialtable, const Probe &probe,
+                        double scale_potential)
+{
+    throw SireError::incomplete_code( QObject::tr(
+                "The code to calculate the potential of an InterFF has not "
+                "been written."), CODELOC );
+}
+
+void InterFF::potential(PotentialTable &potentialtable, const Symbol &component,
+                        const Probe &probe, double scale_potential)
+{
+    throw SireError::incomplete_code( QObject::tr(
+                "The code to calculate the potential of an InterFF has not "
+                "been written."), CODELOC );
+}
@@ -32,9 +32,11 @@
 #include "cljgrid.h"
 #include "cljfunction.h"
 #include "cljgroup.h"
+#include "cljpairlist.h"
 #include "multicljcomponent.h"
 
 #include "SireFF/g1ff.h"
+#include "SireFF/ff3d.h"
 
 SIRE_BEGIN_HEADER
 
@@ -52,6 +54,13 @@ namespace SireMM
 using SireBase::Property;
 using SireBase::Properties;
 
+using SireFF::ForceTable;
+using SireFF::FieldTable;
+using SireFF::PotentialTable;
+using SireFF::Probe;
+
+using SireCAS::Symbol;
+
 namespace detail
 {
     class InterFFData;
@@ -60,11 +69,13 @@ namespace detail
 /** This is a forcefield that calculates the intermolecular coulomb
     and Lennard Jones (LJ) energy of all contained molecule views.
     It also calculates the interactions with any fixed atoms added
-    to this forcefield
+    to this forcefield, and can calculate the forces on the 
+    molecules (using any CLJFunction that supports force calculations)
     
     @author Christopher Woods
 */
-class SIREMM_EXPORT InterFF : public SireBase::ConcreteProperty<InterFF,SireFF::G1FF>
+class SIREMM_EXPORT InterFF : public SireBase::ConcreteProperty<InterFF,SireFF::G1FF>,
+                               public SireFF::FF3D
 {
 
 friend QDataStream& ::operator<<(QDataStream&, const InterFF&);
@@ -121,6 +132,16 @@ public:
     void disableGrid();
     void setUseGrid(bool on);
     bool usesGrid() const;
+
+    void enableLJGrid();
+    void disableLJGrid();
+    void setUseLJGrid(bool on);
+    bool usesLJGrid() const;
+    
+    void enableTricubicInterpolation();
+    void disableTricubicInterpolation();
+    void setUseTricubicInterpolation(bool on);
+    bool usesTricubicInterpolation() const;
     
     void setGridBuffer(Length buffer);
     Length gridBuffer() const;
@@ -140,6 +161,14 @@ public:
     void setUseReproducibleCalculation(bool on);
     bool usesReproducibleCalculation() const;
 
+    void enablePairList();
+    void disablePairList();
+    void setUsePairList(bool on);
+    bool usesPairList() const;
+    
+    void setPairListSkin(Length skin);
+    Length pairListSkin() const;
+
     bool setProperty(const QString &name, const Property &property);
     const Property& property(const QString &name) const;
     bool containsProperty(const QString &name) const;
@@ -150,9 +179,38 @@ public:
     void accept();
     bool needsAccepting() const;
 
+    void force(ForceTable &forcetable, double scale_force=1);
+
+    void force(ForceTable &forcetable, const Symbol &symbol,
+               double scale_force=1);
+
+    void field(FieldTable &fieldtable, double scale_field=1);
+
+    void field(FieldTable &fieldtable, const Symbol &component,
+               double scale_field=1);
+
+    void potential(PotentialTable &potentialtable, double scale_potential=1);
+
+    void potential(PotentialTable &potentialtable, const Symbol &component,
+                   double scale_potential=1);
+
+    void field(FieldTable &fieldtable, const Probe &probe, double scale_field=1);
+
+    void field(FieldTable &fieldtable, const Symbol &component,
+               const Probe &probe, double scale_field=1);
+
+    void potential(PotentialTable &potentialtable, const Probe &probe,
+                   double scale_potential=1);
+
+    void potential(PotentialTable &potentialtable, const Symbol &component,
+                   const Probe &probe, double scale_potential=1);
+
 private:
     void mustNowReallyRecalculateFromScratch();
 
+    void calculateForces(ForceTable &forcetable, int idx, double scale_force,
+                         bool calc_coul, bool calc_lj);
+
     void recalculateEnergy();
     void rebuildProps();
     
@@ -173,6 +231,9 @@ private:
 
     void _pvt_updateName();
 
+    bool _pvt_canDiscardChanges() const;
+    void _pvt_discardChanges();
+
     /** The CLJGroup containing all of the extracted molecules */
     CLJGroup cljgroup;
 
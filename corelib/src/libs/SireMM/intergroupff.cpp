@@ -904,6 +904,23 @@ void InterGroupFF::mustNowReallyRecalculateFromScratch()
     this->setDirty();
 }
 
+/** This forcefield can discard the changes made since the last energy
+    evaluation, so can restore its energies when a move is undone */
+bool InterGroupFF::_pvt_canDiscardChanges() const
+{
+    return true;
+}
+
+/** Discard the changes made since the last energy evaluation. The molecules
+    have been restored to the versions used in that evaluation, so the changes
+    are committed to the CLJGroups without calculating the change in energy */
+void InterGroupFF::_pvt_discardChanges()
+{
+    cljgroup[0].accept();
+    cljgroup[1].accept();
+    needs_accepting = false;
+}
+
 /** Recalculate the energy of this forcefield */
 void InterGroupFF::recalculateEnergy()
 {
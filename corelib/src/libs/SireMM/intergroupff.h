@@ -178,6 +178,9 @@ private:
 
     void _pvt_updateName();
 
+    bool _pvt_canDiscardChanges() const;
+    void _pvt_discardChanges();
+
     /** The CLJGroups containing all of the extracted molecules */
     CLJGroup cljgroup[2];
 
@@ -27,11 +27,15 @@
 \*********************************************/
 
 #include "internalff.h"
+#include "bondedterms.h"
 
 #include "SireMaths/line.h"
 #include "SireMaths/triangle.h"
 #include "SireMaths/torsion.h"
 
+#include "SireCAS/compiledexpression.h"
+#include "SireCAS/values.h"
+
 #include "SireBase/property.h"
 #include "SireBase/stringproperty.h"
 
@@ -52,6 +56,10 @@
 #include "tostring.h"
 
 #include <QDebug>
+#include <QMutex>
+#include <QVarLengthArray>
+
+#include <boost/noncopyable.hpp>
 
 #include <cstdio>
 
@@ -65,6 +73,9 @@ using namespace SireUnits::Dimension;
 using namespace SireUnits;
 using namespace SireStream;
 
+using SireCAS::CompiledExpression;
+using SireCAS::Values;
+
 ////////
 //////// Fully instantiate template classes
 ////////
@@ -94,6 +105,471 @@ PropertyName BendBendParameterName::bb_param( "bend-bend", Property::null() );
 PropertyName StretchBendTorsionParameterName::sbt_param( "stretch-bend-torsion", 
                                                          Property::null() );
 
+////////
+//////// Implementation of the compiled energy terms
+////////
+
+namespace SireMM
+{
+namespace detail
+{
+
+/** The different types of internal term */
+enum INTERNAL_TERMS { BOND_TERM = 0, ANGLE_TERM = 1, DIHEDRAL_TERM = 2,
+                      IMPROPER_TERM = 3, UB_TERM = 4,
+                      SS_TERM = 5, SB_TERM = 6, BB_TERM = 7, SBT_TERM = 8,
+                      NUM_INTERNAL_TERMS = 9 };
+
+/** The different types of internal force term that are
+    evaluated using BondedTerms kernels */
+enum INTERNAL_FORCE_TERMS { BOND_FORCE = 0, ANGLE_FORCE = 1, DIHEDRAL_FORCE = 2,
+                            IMPROPER_THETA_FORCE = 3, IMPROPER_PHI_FORCE = 4,
+                            UB_FORCE = 5, NUM_INTERNAL_FORCE_TERMS = 6 };
+
+/** The maximum number of input values of any term
+    (stretch-bend-torsion terms use seven) */
+static const int MAX_TERM_VALUES = 7;
+
+/** The maximum number of groups whose compiled terms are cached */
+static const int MAX_CACHED_GROUPS = 65536;
+
+/** This class holds the compiled forms of all of the energy
+    functions in a single GroupInternalParameters
+    
+    @author Christopher Woods
+*/
+class InternalGroupTerms
+{
+public:
+    InternalGroupTerms()
+    {}
+    
+    ~InternalGroupTerms()
+    {}
+
+    /** The group whose functions have been compiled. This is held
+        so that its data (and so the cache key) remains valid */
+    GroupInternalParameters group;
+
+    /** The terms whose functional forms (e.g. harmonic or cosine
+        series) have been recognised, so can be evaluated using
+        specialised kernels */
+    BondedTerms kernels[NUM_INTERNAL_TERMS];
+    
+    /** The recognised terms of the force functions */
+    BondedTerms force_kernels[NUM_INTERNAL_FORCE_TERMS];
+
+    /** The index of the functional form of each term, or -1
+        if the function of that term was recognised by a kernel,
+        or could not be compiled */
+    QVector<qint32> forms[NUM_INTERNAL_TERMS];
+    
+    /** The offset into 'params' of the parameters of each term */
+    QVector<qint32> param_offsets[NUM_INTERNAL_TERMS];
+    
+    /** The parameters of all of the terms */
+    QVector<double> params[NUM_INTERNAL_TERMS];
+};
+
+/** This class caches the compiled energy functions of each group,
+    together with the table of the distinct functional forms
+    of each type of term. This is shared between copies of 
+    an InternalPotential, so is protected by a mutex
+    
+    @author Christopher Woods
+*/
+class InternalTermCache : public boost::noncopyable
+{
+public:
+    InternalTermCache();
+    ~InternalTermCache();
+    
+    boost::shared_ptr<const InternalGroupTerms> get(const GroupInternalParameters &group);
+    
+    QVector<CompiledExpression> forms(int term) const;
+    
+    const QList<Symbol>& symbols(int term) const
+    {
+        return term_symbols[term];
+    }
+
+private:
+    template<class T>
+    void compile(int term, const QVector<T> &functions, InternalGroupTerms &terms);
+
+    template<class T>
+    void compileForces(int force_term, int term, const QVector<T> &functions,
+                       InternalGroupTerms &terms);
+
+    int getForm(int term, const CompiledExpression &compiled);
+
+    /** Mutex used to protect access to the cache */
+    mutable QMutex mutex;
+    
+    /** The symbols used by each type of term, in slot order */
+    QList<Symbol> term_symbols[NUM_INTERNAL_TERMS];
+    
+    /** The distinct functional forms of each type of term. Forms
+        are only ever added, so indicies into this table remain valid */
+    QVector<CompiledExpression> term_forms[NUM_INTERNAL_TERMS];
+    
+    /** Index of the forms of each type of term, by form hash */
+    QMultiHash<uint,int> forms_by_hash[NUM_INTERNAL_TERMS];
+    
+    /** The compiled terms of each group, indexed by the address
+        of the group's bond potential (which is unique to the 
+        implicitly shared data of the group) */
+    QHash< const void*, boost::shared_ptr<const InternalGroupTerms> > groups;
+};
+
+/** This class collects the input values and parameters of all of the
+    terms of each functional form, so that they can be evaluated 
+    together in a batch
+    
+    @author Christopher Woods
+*/
+class InternalTermBatches
+{
+public:
+    InternalTermBatches(const InternalTermCache &cache);
+    ~InternalTermBatches();
+    
+    template<class T>
+    void add(int term, const InternalGroupTerms &group_terms,
+             const double *values, const QVector<T> &functions);
+    
+    bool hasTerms(int term) const
+    {
+        return has_terms[term];
+    }
+    
+    double energy(int term) const;
+
+private:
+    void add(int term, const InternalGroupTerms &group_terms, int i,
+             const double *values, const Expression &function);
+
+    /** The values and parameters of all terms of a single form,
+        in structure-of-arrays format */
+    class FormBatch
+    {
+    public:
+        FormBatch() : n(0)
+        {}
+        
+        int n;
+        QVector<double> values[MAX_TERM_VALUES];
+        QVector< QVector<double> > params;
+    };
+
+    /** The cache holding the forms */
+    const InternalTermCache *cache;
+    
+    /** The batch for each form of each type of term */
+    QVector<FormBatch> batches[NUM_INTERNAL_TERMS];
+    
+    /** The energy of the terms evaluated by the BondedTerms kernels,
+        and of the terms that could not be compiled */
+    double nrgs[NUM_INTERNAL_TERMS];
+    
+    /** Whether or not any terms of each type have been added */
+    bool has_terms[NUM_INTERNAL_TERMS];
+};
+
+} // end of namespace detail
+} // end of namespace SireMM
+
+/** Constructor */
+InternalTermCache::InternalTermCache() : boost::noncopyable()
+{
+    const InternalSymbols &s = InternalPotential::symbols();
+
+    term_symbols[BOND_TERM] << s.bond().r();
+    term_symbols[ANGLE_TERM] << s.angle().theta();
+    term_symbols[DIHEDRAL_TERM] << s.dihedral().phi();
+    term_symbols[IMPROPER_TERM] << s.improper().theta() << s.improper().phi();
+    term_symbols[UB_TERM] << s.ureyBradley().r();
+    term_symbols[SS_TERM] << s.stretchStretch().r01() << s.stretchStretch().r21();
+    term_symbols[SB_TERM] << s.stretchBend().r01() << s.stretchBend().r21()
+                          << s.stretchBend().theta();
+    term_symbols[BB_TERM] << s.bendBend().theta012() << s.bendBend().theta213()
+                          << s.bendBend().theta310();
+    term_symbols[SBT_TERM] << s.stretchBendTorsion().phi()
+                           << s.stretchBendTorsion().r01()
+                           << s.stretchBendTorsion().r12()
+                           << s.stretchBendTorsion().r32()
+                           << s.stretchBendTorsion().r03()
+                           << s.stretchBendTorsion().theta012()
+                           << s.stretchBendTorsion().theta321();
+}
+
+/** Destructor */
+InternalTermCache::~InternalTermCache()
+{}
+
+/** Return the index of the form of the passed compiled function, 
+    adding it as a new form if it has not been seen before */
+int InternalTermCache::getForm(int term, const CompiledExpression &compiled)
+{
+    QList<int> candidates = forms_by_hash[term].values(compiled.formHash());
+    
+    foreach (int candidate, candidates)
+    {
+        if (term_forms[term].at(candidate).hasSameForm(compiled))
+            return candidate;
+    }
+    
+    term_forms[term].append(compiled);
+    int form = term_forms[term].count() - 1;
+    forms_by_hash[term].insert(compiled.formHash(), form);
+    
+    return form;
+}
+
+/** Compile all of the passed functions for the term 'term' */
+template<class T>
+void InternalTermCache::compile(int term, const QVector<T> &functions,
+                                InternalGroupTerms &terms)
+{
+    int nfuncs = functions.count();
+
+    QVector<qint32> forms(nfuncs);
+    QVector<qint32> offsets(nfuncs + 1);
+    QVector<double> params;
+    
+    offsets[0] = 0;
+    
+    BondedTerms &kernels = terms.kernels[term];
+    
+    for (int i=0; i<nfuncs; ++i)
+    {
+        //first see if this is a standard functional form
+        kernels.add(functions.at(i).function(), term_symbols[term]);
+    
+        if (kernels.isRecognised(i))
+        {
+            forms[i] = -1;
+            offsets[i+1] = params.count();
+            continue;
+        }
+    
+        CompiledExpression compiled(functions.at(i).function(), term_symbols[term]);
+        
+        if (compiled.isCompiled())
+        {
+            forms[i] = this->getForm(term, compiled);
+            params += compiled.parameters();
+        }
+        else
+            forms[i] = -1;
+        
+        offsets[i+1] = params.count();
+    }
+    
+    terms.forms[term] = forms;
+    terms.param_offsets[term] = offsets;
+    terms.params[term] = params;
+}
+
+/** Recognise the standard functional forms of the passed force functions */
+template<class T>
+void InternalTermCache::compileForces(int force_term, int term, 
+                                      const QVector<T> &functions,
+                                      InternalGroupTerms &terms)
+{
+    BondedTerms &kernels = terms.force_kernels[force_term];
+    
+    for (int i=0; i<functions.count(); ++i)
+    {
+        kernels.add(functions.at(i).function(), term_symbols[term]);
+    }
+}
+
+/** Return the compiled terms for the passed group, compiling them
+    if they have not been seen before */
+boost::shared_ptr<const InternalGroupTerms> 
+InternalTermCache::get(const GroupInternalParameters &group)
+{
+    const void *key = &(group.bondPotential());
+
+    QMutexLocker lkr(&mutex);
+    
+    QHash< const void*, boost::shared_ptr<const InternalGroupTerms> >::const_iterator
+                                                        it = groups.constFind(key);
+    
+    if (it != groups.constEnd())
+        return it.value();
+    
+    if (groups.count() >= MAX_CACHED_GROUPS)
+        //don't let the cache grow forever - forms are kept as
+        //there are few of them and their indicies must remain valid
+        groups.clear();
+        
+    boost::shared_ptr<InternalGroupTerms> terms( new InternalGroupTerms() );
+    
+    terms->group = group;
+    
+    this->compile(BOND_TERM, group.bondPotential(), *terms);
+    this->compile(ANGLE_TERM, group.anglePotential(), *terms);
+    this->compile(DIHEDRAL_TERM, group.dihedralPotential(), *terms);
+    this->compile(IMPROPER_TERM, group.improperPotential(), *terms);
+    this->compile(UB_TERM, group.ureyBradleyPotential(), *terms);
+    this->compile(SS_TERM, group.stretchStretchPotential(), *terms);
+    this->compile(SB_TERM, group.stretchBendPotential(), *terms);
+    this->compile(BB_TERM, group.bendBendPotential(), *terms);
+    this->compile(SBT_TERM, group.stretchBendTorsionPotential(), *terms);
+    
+    this->compileForces(BOND_FORCE, BOND_TERM, group.bondForces(), *terms);
+    this->compileForces(ANGLE_FORCE, ANGLE_TERM, group.angleForces(), *terms);
+    this->compileForces(DIHEDRAL_FORCE, DIHEDRAL_TERM, group.dihedralForces(), *terms);
+    this->compileForces(IMPROPER_THETA_FORCE, IMPROPER_TERM, 
+                        group.improper_Theta_Forces(), *terms);
+    this->compileForces(IMPROPER_PHI_FORCE, IMPROPER_TERM,
+                        group.improper_Phi_Forces(), *terms);
+    this->compileForces(UB_FORCE, UB_TERM, group.ureyBradleyForces(), *terms);
+    
+    groups.insert(key, terms);
+    
+    return terms;
+}
+
+/** Return the distinct forms of the term 'term' */
+QVector<CompiledExpression> InternalTermCache::forms(int term) const
+{
+    QMutexLocker lkr(&mutex);
+    return term_forms[term];
+}
+
+/** Construct the batches for forms held in 'cache' */
+InternalTermBatches::InternalTermBatches(const InternalTermCache &c) : cache(&c)
+{
+    for (int i=0; i<NUM_INTERNAL_TERMS; ++i)
+    {
+        nrgs[i] = 0;
+        has_terms[i] = false;
+    }
+}
+
+/** Destructor */
+InternalTermBatches::~InternalTermBatches()
+{}
+
+/** Add all of the terms of type 'term' from 'group_terms', which have
+    energy functions 'functions' and input values 'values' (in slot order,
+    with the values of the ith term starting at values[i * nslots]).
+    The terms with a standard functional form are evaluated immediately
+    by the BondedTerms kernels of the group, while the remainder are
+    added to the batch of their compiled form */
+template<class T>
+void InternalTermBatches::add(int term, const InternalGroupTerms &group_terms,
+                              const double *values, const QVector<T> &functions)
+{
+    if (functions.isEmpty())
+        return;
+
+    has_terms[term] = true;
+
+    const BondedTerms &kernels = group_terms.kernels[term];
+
+    if (kernels.nRecognised() > 0)
+        nrgs[term] += kernels.sum(values);
+
+    if (kernels.nRecognised() == functions.count())
+        return;
+
+    const int nslots = cache->symbols(term).count();
+
+    for (int i=0; i<functions.count(); ++i)
+    {
+        if (not kernels.isRecognised(i))
+            this->add(term, group_terms, i, values + i*nslots, functions.at(i).function());
+    }
+}
+
+/** Add the ith term of type 'term' from 'group_terms', which has input 
+    values 'values' (in slot order) and energy function 'function' */
+void InternalTermBatches::add(int term, const InternalGroupTerms &group_terms, int i,
+                              const double *values, const Expression &function)
+{
+    const int form = group_terms.forms[term].constData()[i];
+    const QList<Symbol> &symbols = cache->symbols(term);
+    
+    if (form < 0)
+    {
+        //this function could not be compiled, so evaluate it directly
+        Values vals;
+        
+        for (int j=0; j<symbols.count(); ++j)
+        {
+            vals.set(symbols.at(j), values[j]);
+        }
+        
+        nrgs[term] += function.evaluate(vals);
+        return;
+    }
+    
+    if (form >= batches[term].count())
+        batches[term].resize(form + 1);
+    
+    FormBatch &batch = batches[term][form];
+    
+    for (int j=0; j<symbols.count(); ++j)
+    {
+        batch.values[j].append(values[j]);
+    }
+    
+    const qint32 *offsets = group_terms.param_offsets[term].constData();
+    const double *params = group_terms.params[term].constData() + offsets[i];
+    const int nparams = offsets[i+1] - offsets[i];
+    
+    if (batch.params.count() < nparams)
+        batch.params.resize(nparams);
+    
+    for (int j=0; j<nparams; ++j)
+    {
+        batch.params[j].append(params[j]);
+    }
+    
+    batch.n += 1;
+}
+
+/** Evaluate and return the total energy of all terms of type 'term' */
+double InternalTermBatches::energy(int term) const
+{
+    double nrg = nrgs[term];
+    
+    if (batches[term].isEmpty())
+        return nrg;
+    
+    const QVector<CompiledExpression> forms = cache->forms(term);
+    const int nsyms = cache->symbols(term).count();
+    
+    for (int i=0; i<batches[term].count(); ++i)
+    {
+        const FormBatch &batch = batches[term].at(i);
+        
+        if (batch.n == 0)
+            continue;
+        
+        QVarLengthArray<const double*, MAX_TERM_VALUES> values(nsyms);
+        QVarLengthArray<const double*, 16> params(batch.params.count());
+        
+        for (int j=0; j<nsyms; ++j)
+        {
+            values[j] = batch.values[j].constData();
+        }
+        
+        for (int j=0; j<batch.params.count(); ++j)
+        {
+            params[j] = batch.params.at(j).constData();
+        }
+        
+        nrg += forms.at(i).sum(values.constData(), params.constData(), batch.n);
+    }
+    
+    return nrg;
+}
+
 ////////
 //////// Implementation of InternalPotential
 ////////
@@ -102,12 +578,13 @@ PropertyName StretchBendTorsionParameterName::sbt_param( "stretch-bend-torsion",
     the energies and forces of parameters that only involve selected
     atoms. If 'isstrict' is false, then parameters that involve
     at least one selected atom are used. */
-InternalPotential::InternalPotential(bool strict) : isstrict(strict)
+InternalPotential::InternalPotential(bool strict) 
+                  : isstrict(strict), term_cache( new InternalTermCache() )
 {}
 
 /** Copy constructor */
 InternalPotential::InternalPotential(const InternalPotential &other)
-                  : isstrict(other.isstrict)
+                  : isstrict(other.isstrict), term_cache(other.term_cache)
 {}
 
 /** Destructor */
@@ -118,9 +595,17 @@ InternalPotential::~InternalPotential()
 InternalPotential& InternalPotential::operator=(const InternalPotential &other)
 {
     isstrict = other.isstrict;
+    term_cache = other.term_cache;
     return *this;
 }
 
+/** Clear the cache of compiled energy functions. This is needed
+    if the energy functions may have changed */
+void InternalPotential::clearCompiledTerms()
+{
+    term_cache.reset( new InternalTermCache() );
+}
+
 InternalPotential::ParameterNames InternalPotential::param_names;
 InternalSymbols InternalPotential::internal_symbols;
 
@@ -337,23 +822,23 @@ static const Vector& getCoords(const CGAtomIdx &atom,
     return cgroup_array[ atom.cutGroup() ].constData()[ atom.atom() ];
 }
 
-/** Calculate the energy caused by the physical terms (bond, angle, dihedral) */
+/** Calculate the energy caused by the physical terms (bond, angle, dihedral).
+    The input values of all of the terms of each type in the group are
+    collected and added to 'batches', so that all of the terms that
+    share a functional form can be evaluated together */
 void InternalPotential::calculatePhysicalEnergy(
                                          const GroupInternalParameters &group_params,
+                                         const InternalGroupTerms &group_terms,
                                          const CoordGroup *cgroup_array,
-                                         InternalPotential::Energy &energy,
-                                         double scale_energy) const
+                                         InternalTermBatches &batches) const
 {
     if (not group_params.bondPotential().isEmpty())
     {
         //bonds only use the symbol 'r', representing the bond length
-        Values vals;
-        const Symbol &r = InternalPotential::symbols().bond().r();
-    
         int nbonds = group_params.bondPotential().count();
         const TwoAtomFunction *bonds_array = group_params.bondPotential().constData();
         
-        double bndnrg = 0;
+        QVarLengthArray<double, 128> r(nbonds);
         
         for (int i=0; i<nbonds; ++i)
         {
@@ -364,29 +849,20 @@ void InternalPotential::calculatePhysicalEnergy(
             const Vector &atom1 = getCoords(bond.atom1(), cgroup_array);
             
             //calculate the interatomic distance, r
-            double dist = Vector::distance(atom0, atom1);
-            
-            //substitute this distance into 'vals'
-            vals.set( r, dist );
-            
-            //calculate the energy
-            bndnrg += bond.function().evaluate(vals);
+            r[i] = Vector::distance(atom0, atom1);
         }
         
-        energy += BondEnergy( scale_energy * bndnrg );
+        batches.add(BOND_TERM, group_terms, r.constData(), group_params.bondPotential());
     }
     
     if (not group_params.anglePotential().isEmpty())
     {
         //angles use the symbol 'theta', representing the angle size
-        Values vals;
-        const Symbol &theta = InternalPotential::symbols().angle().theta();
-        
         int nangles = group_params.anglePotential().count();
         const ThreeAtomFunction *angles_array 
                                     = group_params.anglePotential().constData();
-         
-        double angnrg = 0;
+        
+        QVarLengthArray<double, 128> theta(nangles);
                                                               
         for (int i=0; i<nangles; ++i)
         {
@@ -396,25 +872,21 @@ void InternalPotential::calculatePhysicalEnergy(
                                        getCoords(angle.atom1(), cgroup_array),
                                        getCoords(angle.atom2(), cgroup_array) );
                            
-            vals.set(theta, ang.to(radians));
-            
-            angnrg += angle.function().evaluate(vals);
+            theta[i] = ang.to(radians);
         }
         
-        energy += AngleEnergy( scale_energy * angnrg );
+        batches.add(ANGLE_TERM, group_terms, theta.constData(),
+                    group_params.anglePotential());
     }
     
     if (not group_params.dihedralPotential().isEmpty())
     {
         //angles use the symbol 'phi', representing the torsion angle
-        Values vals;
-        const Symbol &phi = InternalPotential::symbols().dihedral().phi();
-        
         int ndihedrals = group_params.dihedralPotential().count();
         const FourAtomFunction *dihedrals_array 
                                     = group_params.dihedralPotential().constData();
-         
-        double dihnrg = 0;
+        
+        QVarLengthArray<double, 128> phi(ndihedrals);
                                                               
         for (int i=0; i<ndihedrals; ++i)
         {
@@ -425,33 +897,28 @@ void InternalPotential::calculatePhysicalEnergy(
                                           getCoords(dihedral.atom2(), cgroup_array),
                                           getCoords(dihedral.atom3(), cgroup_array) );
                            
-            vals.set(phi, ang.to(radians));
-            
-            dihnrg += dihedral.function().evaluate(vals);
+            phi[i] = ang.to(radians);
         }
         
-        energy += DihedralEnergy( scale_energy * dihnrg );
+        batches.add(DIHEDRAL_TERM, group_terms, phi.constData(),
+                    group_params.dihedralPotential());
     }
 }
 
 /** Calculate the energy caused by the non-physical terms (improper, Urey-Bradley) */
 void InternalPotential::calculateNonPhysicalEnergy(
                                          const GroupInternalParameters &group_params,
+                                         const InternalGroupTerms &group_terms,
                                          const CoordGroup *cgroup_array,
-                                         InternalPotential::Energy &energy,
-                                         double scale_energy) const
+                                         InternalTermBatches &batches) const
 {
     if (not group_params.improperPotential().isEmpty())
     {
-        Values vals;
-        const Symbol &theta = InternalPotential::symbols().improper().theta();
-        const Symbol &phi = InternalPotential::symbols().improper().phi();
-        
         int nimpropers = group_params.improperPotential().count();
         const FourAtomFunction *impropers_array 
                                     = group_params.improperPotential().constData();
-    
-        double impnrg = 0;
+        
+        QVarLengthArray<double, 256> values(2*nimpropers);
         
         for (int i=0; i<nimpropers; ++i)
         {
@@ -462,63 +929,51 @@ void InternalPotential::calculateNonPhysicalEnergy(
                              getCoords(improper.atom2(), cgroup_array),
                              getCoords(improper.atom3(), cgroup_array) );
                              
-            Angle theta_angle = torsion.improperAngle();
-            Angle phi_angle = torsion.angle();
-            
-            vals.set(theta, theta_angle);
-            vals.set(phi, phi_angle);
-            
-            impnrg += improper.function().evaluate(vals);
+            //values are in the order theta, phi
+            values[2*i] = torsion.improperAngle();
+            values[2*i+1] = torsion.angle();
         }
         
-        energy += ImproperEnergy( scale_energy * impnrg );
+        batches.add(IMPROPER_TERM, group_terms, values.constData(),
+                    group_params.improperPotential());
     }
     
     if (not group_params.ureyBradleyPotential().isEmpty())
     {
-        Values vals;
-        const Symbol &r = InternalPotential::symbols().ureyBradley().r();
-        
         int nubs = group_params.ureyBradleyPotential().count();
         const TwoAtomFunction *ub_array 
                                 = group_params.ureyBradleyPotential().constData();
-                                
-        double ubnrg = 0;
+        
+        QVarLengthArray<double, 128> r(nubs);
         
         for (int i=0; i<nubs; ++i)
         {
             const TwoAtomFunction &ub = ub_array[i];
             
-            double dist = Vector::distance( getCoords(ub.atom0(), cgroup_array),
-                                            getCoords(ub.atom1(), cgroup_array) );
-                                            
-            vals.set( r, dist );
-            
-            ubnrg += ub.function().evaluate(vals);
+            r[i] = Vector::distance( getCoords(ub.atom0(), cgroup_array),
+                                     getCoords(ub.atom1(), cgroup_array) );
         }
         
-        energy += UreyBradleyEnergy( scale_energy * ubnrg );
+        batches.add(UB_TERM, group_terms, r.constData(),
+                    group_params.ureyBradleyPotential());
     }
 }
 
-/** Calculate the energy caused by the cross terms (improper, Urey-Bradley) */
+/** Calculate the energy caused by the cross terms (stretch-stretch, stretch-bend,
+    bend-bend and stretch-bend-torsion) */
 void InternalPotential::calculateCrossEnergy(
                                          const GroupInternalParameters &group_params,
+                                         const InternalGroupTerms &group_terms,
                                          const CoordGroup *cgroup_array,
-                                         InternalPotential::Energy &energy,
-                                         double scale_energy) const
+                                         InternalTermBatches &batches) const
 {
     if (not group_params.stretchStretchPotential().isEmpty())
     {
-        Values vals;
-        const Symbol &r01 = InternalPotential::symbols().stretchStretch().r01();
-        const Symbol &r21 = InternalPotential::symbols().stretchStretch().r21();
-        
         int nss = group_params.stretchStretchPotential().count();
         const ThreeAtomFunction *ss_array 
                               = group_params.stretchStretchPotential().constData();
-                              
-        double ssnrg = 0;
+        
+        QVarLengthArray<double, 256> values(2*nss);
         
         for (int i=0; i<nss; ++i)
         {
@@ -527,28 +982,23 @@ void InternalPotential::calculateCrossEnergy(
             const Vector &atom0 = getCoords(ss.atom0(), cgroup_array);
             const Vector &atom1 = getCoords(ss.atom1(), cgroup_array);
             const Vector &atom2 = getCoords(ss.atom2(), cgroup_array);
-                           
-            vals.set( r01, Vector::distance(atom0, atom1) );
-            vals.set( r21, Vector::distance(atom2, atom1) );
             
-            ssnrg += ss.function().evaluate(vals);
+            //values are in the order r01, r21
+            values[2*i] = Vector::distance(atom0, atom1);
+            values[2*i+1] = Vector::distance(atom2, atom1);
         }
         
-        energy += StretchStretchEnergy( scale_energy * ssnrg );
+        batches.add(SS_TERM, group_terms, values.constData(),
+                    group_params.stretchStretchPotential());
     }
 
     if (not group_params.stretchBendPotential().isEmpty())
     {
-        Values vals;
-        const Symbol &r01 = InternalPotential::symbols().stretchBend().r01();
-        const Symbol &r21 = InternalPotential::symbols().stretchBend().r21();
-        const Symbol &theta = InternalPotential::symbols().stretchBend().theta();
-        
         int nsb = group_params.stretchBendPotential().count();
         const ThreeAtomFunction *sb_array 
                               = group_params.stretchBendPotential().constData();
-                              
-        double sbnrg = 0;
+        
+        QVarLengthArray<double, 384> values(3*nsb);
         
         for (int i=0; i<nsb; ++i)
         {
@@ -558,29 +1008,23 @@ void InternalPotential::calculateCrossEnergy(
             const Vector &atom1 = getCoords(sb.atom1(), cgroup_array);
             const Vector &atom2 = getCoords(sb.atom2(), cgroup_array);
             
-            vals.set( r01, Vector::distance(atom0, atom1) );
-            vals.set( r21, Vector::distance(atom2, atom1) );
-                
-            vals.set( theta, Vector::angle(atom0, atom1, atom2) );
-            
-            sbnrg += sb.function().evaluate(vals);
+            //values are in the order r01, r21, theta
+            values[3*i] = Vector::distance(atom0, atom1);
+            values[3*i+1] = Vector::distance(atom2, atom1);
+            values[3*i+2] = Vector::angle(atom0, atom1, atom2);
         }
         
-        energy += StretchBendEnergy( scale_energy * sbnrg );
+        batches.add(SB_TERM, group_terms, values.constData(),
+                    group_params.stretchBendPotential());
     }
 
     if (not group_params.bendBendPotential().isEmpty())
     {
-        Values vals;
-        const Symbol &theta012 = InternalPotential::symbols().bendBend().theta012();
-        const Symbol &theta213 = InternalPotential::symbols().bendBend().theta213();
-        const Symbol &theta310 = InternalPotential::symbols().bendBend().theta310();
-        
         int nbb = group_params.bendBendPotential().count();
         const FourAtomFunction *bb_array 
                               = group_params.bendBendPotential().constData();
-                              
-        double bbnrg = 0;
+        
+        QVarLengthArray<double, 384> values(3*nbb);
         
         for (int i=0; i<nbb; ++i)
         {
@@ -595,35 +1039,23 @@ void InternalPotential::calculateCrossEnergy(
             Vector v12 = atom2 - atom1;
             Vector v13 = atom3 - atom1;
         
-            vals.set( theta012, Vector::angle(v12,v10) );
-            vals.set( theta213, Vector::angle(v13,v12) );
-            vals.set( theta310, Vector::angle(v10,v13) );
-            
-            bbnrg += bb.function().evaluate(vals);
+            //values are in the order theta012, theta213, theta310
+            values[3*i] = Vector::angle(v12,v10);
+            values[3*i+1] = Vector::angle(v13,v12);
+            values[3*i+2] = Vector::angle(v10,v13);
         }
         
-        energy += BendBendEnergy( scale_energy * bbnrg );
+        batches.add(BB_TERM, group_terms, values.constData(),
+                    group_params.bendBendPotential());
     }
 
     if (not group_params.stretchBendTorsionPotential().isEmpty())
     {
-        Values vals;
-    
-        const Symbol &phi = InternalPotential::symbols().stretchBendTorsion().phi();
-        const Symbol &r01 = InternalPotential::symbols().stretchBendTorsion().r01();
-        const Symbol &r12 = InternalPotential::symbols().stretchBendTorsion().r12();
-        const Symbol &r32 = InternalPotential::symbols().stretchBendTorsion().r32();
-        const Symbol &r03 = InternalPotential::symbols().stretchBendTorsion().r03();
-        const Symbol &theta012 
-                = InternalPotential::symbols().stretchBendTorsion().theta012();
-        const Symbol &theta321
-                = InternalPotential::symbols().stretchBendTorsion().theta321();
-        
         int nsbt = group_params.stretchBendTorsionPotential().count();
         const FourAtomFunction *sbt_array 
                           = group_params.stretchBendTorsionPotential().constData();
-                              
-        double sbtnrg = 0;
+        
+        QVarLengthArray<double, 896> values(7*nsbt);
         
         for (int i=0; i<nsbt; ++i)
         {
@@ -634,25 +1066,32 @@ void InternalPotential::calculateCrossEnergy(
             const Vector &atom2 = getCoords(sbt.atom2(), cgroup_array);
             const Vector &atom3 = getCoords(sbt.atom3(), cgroup_array);
             
-            vals.set( phi, Vector::dihedral(atom0, atom1, atom2, atom3) );
+            //values are in the order phi, r01, r12, r32, r03, theta012, theta321
+            double *v = values.data() + 7*i;
+            v[0] = Vector::dihedral(atom0, atom1, atom2, atom3);
             
-            vals.set( r01, Vector::distance(atom0, atom1) );
-            vals.set( r12, Vector::distance(atom1, atom2) );
-            vals.set( r32, Vector::distance(atom2, atom3) );
-            vals.set( r03, Vector::distance(atom0, atom3) );
+            v[1] = Vector::distance(atom0, atom1);
+            v[2] = Vector::distance(atom1, atom2);
+            v[3] = Vector::distance(atom2, atom3);
+            v[4] = Vector::distance(atom0, atom3);
             
-            vals.set( theta012, Vector::angle(atom0, atom1, atom2) );
-            vals.set( theta321, Vector::angle(atom3, atom2, atom1) );   
-            
-            sbtnrg += sbt.function().evaluate(vals);
+            v[5] = Vector::angle(atom0, atom1, atom2);
+            v[6] = Vector::angle(atom3, atom2, atom1);
         }
         
-        energy += StretchBendTorsionEnergy( scale_energy * sbtnrg );
+        batches.add(SBT_TERM, group_terms, values.constData(),
+                    group_params.stretchBendTorsionPotential());
     }
 }
 
 /** Calculate the total intramolecular energy of 'molecule' and
-    add it onto 'energy', optionally mutiplying it by a scale factor */
+    add it onto 'energy', optionally mutiplying it by a scale factor.
+    
+    The energy functions are compiled (and cached) the first time
+    that they are seen. The geometry of each term is calculated
+    group by group, and then all of the terms that share the same
+    functional form (e.g. all of the harmonic bonds) are evaluated
+    together in a single batched pass */
 void InternalPotential::calculateEnergy(const InternalPotential::Molecule &molecule,
                                         InternalPotential::Energy &energy,
                                         double scale_energy) const
@@ -670,22 +1109,60 @@ void InternalPotential::calculateEnergy(const InternalPotential::Molecule &molec
     const CoordGroup *cgroup_array 
                              = molecule.parameters().atomicCoordinates().constData();
 
+    InternalTermBatches batches(*term_cache);
+
     for (int i=0; i<ngroups; ++i)
     {
         const GroupInternalParameters &group_params = params_array[i];
         
+        if (not (group_params.hasPhysicalParameters() or
+                 group_params.hasNonPhysicalParameters() or
+                 group_params.hasCrossTerms()))
+            continue;
+        
+        boost::shared_ptr<const InternalGroupTerms> group_terms 
+                                            = term_cache->get(group_params);
+        
         if (group_params.hasPhysicalParameters())
-            this->calculatePhysicalEnergy(group_params, cgroup_array, 
-                                          energy, scale_energy);
+            this->calculatePhysicalEnergy(group_params, *group_terms,
+                                          cgroup_array, batches);
             
         if (group_params.hasNonPhysicalParameters())
-            this->calculateNonPhysicalEnergy(group_params, cgroup_array,
-                                             energy, scale_energy);
+            this->calculateNonPhysicalEnergy(group_params, *group_terms,
+                                             cgroup_array, batches);
         
         if (group_params.hasCrossTerms())
-            this->calculateCrossEnergy(group_params, cgroup_array,
-                                       energy, scale_energy);
+            this->calculateCrossEnergy(group_params, *group_terms,
+                                       cgroup_array, batches);
     }
+    
+    //now evaluate the batches of terms
+    if (batches.hasTerms(BOND_TERM))
+        energy += BondEnergy( scale_energy * batches.energy(BOND_TERM) );
+    
+    if (batches.hasTerms(ANGLE_TERM))
+        energy += AngleEnergy( scale_energy * batches.energy(ANGLE_TERM) );
+    
+    if (batches.hasTerms(DIHEDRAL_TERM))
+        energy += DihedralEnergy( scale_energy * batches.energy(DIHEDRAL_TERM) );
+    
+    if (batches.hasTerms(IMPROPER_TERM))
+        energy += ImproperEnergy( scale_energy * batches.energy(IMPROPER_TERM) );
+    
+    if (batches.hasTerms(UB_TERM))
+        energy += UreyBradleyEnergy( scale_energy * batches.energy(UB_TERM) );
+    
+    if (batches.hasTerms(SS_TERM))
+        energy += StretchStretchEnergy( scale_energy * batches.energy(SS_TERM) );
+    
+    if (batches.hasTerms(SB_TERM))
+        energy += StretchBendEnergy( scale_energy * batches.energy(SB_TERM) );
+    
+    if (batches.hasTerms(BB_TERM))
+        energy += BendBendEnergy( scale_energy * batches.energy(BB_TERM) );
+    
+    if (batches.hasTerms(SBT_TERM))
+        energy += StretchBendTorsionEnergy( scale_energy * batches.energy(SBT_TERM) );
 }
 
 static void addForce(const Vector &force, const CGAtomIdx &atom,
@@ -699,6 +1176,39 @@ static void addForce(const Vector &force, const CGAtomIdx &atom,
     }
 }
 
+/** Evaluate all of the recognised force functions in 'kernels', using the
+    input values in 'values', placing the results into 'dvs' */
+static void evaluateKernels(const BondedTerms &kernels, const double *values,
+                            QVarLengthArray<double, 128> &dvs)
+{
+    dvs.resize(kernels.count());
+    
+    if (kernels.nRecognised() > 0)
+        kernels.evaluate(values, dvs.data());
+}
+
+/** Calculate the improper angles of the 'n' impropers in 'impropers', placing
+    them into 'values' in the order of the improper symbols (theta, phi) */
+static void getImproperAngles(const FourAtomFunction *impropers, int n,
+                              const CoordGroup *cgroup_array,
+                              QVarLengthArray<double, 256> &values)
+{
+    values.resize(2*n);
+    
+    for (int j=0; j<n; ++j)
+    {
+        const FourAtomFunction &improper = impropers[j];
+    
+        Torsion torsion( getCoords(improper.atom0(), cgroup_array),
+                         getCoords(improper.atom1(), cgroup_array),
+                         getCoords(improper.atom2(), cgroup_array),
+                         getCoords(improper.atom3(), cgroup_array) );
+        
+        values[2*j] = torsion.improperAngle().to(radians);
+        values[2*j+1] = torsion.angle().to(radians);
+    }
+}
+
 /** Calculate the total bond force acting on the molecule 'molecule', and add it
     to the forces in 'forces', optionally scaled by 'scale_force' */
 void InternalPotential::calculateBondForce(const InternalPotential::Molecule &molecule,
@@ -737,6 +1247,25 @@ void InternalPotential::calculateBondForce(const InternalPotential::Molecule &mo
         int nbonds = group_params.bondForces().count();
         const TwoAtomFunction *bonds_array = group_params.bondForces().constData();
         
+        //get the specialised kernels for the recognised force functions
+        boost::shared_ptr<const InternalGroupTerms> group_terms
+                                            = term_cache->get(group_params);
+        const BondedTerms &kernels = group_terms->force_kernels[BOND_FORCE];
+        
+        //calculate all of the bond lengths, so that the recognised
+        //force functions can be evaluated together
+        QVarLengthArray<double, 128> dists(nbonds);
+        
+        for (int j=0; j<nbonds; ++j)
+        {
+            const TwoAtomFunction &bond = bonds_array[j];
+            dists[j] = Vector::distance( getCoords(bond.atom0(), cgroup_array),
+                                         getCoords(bond.atom1(), cgroup_array) );
+        }
+        
+        QVarLengthArray<double, 128> dvs;
+        evaluateKernels(kernels, dists.constData(), dvs);
+        
         for (int j=0; j<nbonds; ++j)
         {
             const TwoAtomFunction &bond = bonds_array[j];
@@ -752,10 +1281,19 @@ void InternalPotential::calculateBondForce(const InternalPotential::Molecule &mo
                 continue;
             
             v01 /= dist;
-            vals.set( r, dist );
+
+            double dv_by_dr;
+            
+            if (kernels.isRecognised(j))
+                dv_by_dr = dvs[j];
+            else
+            {
+                vals.set( r, dist );
+                dv_by_dr = bond.function().evaluate(vals);
+            }
 
             //evaluate the force vector
-            Vector force = -scale_force * bond.function().evaluate(vals) * v01;
+            Vector force = -scale_force * dv_by_dr * v01;
 
             //add the force onto the forces array
             addForce(-force, bond.atom0(), forces);
@@ -866,6 +1404,27 @@ void InternalPotential::calculateAngleForce(const InternalPotential::Molecule &m
         int nangles = group_params.angleForces().count();
         const ThreeAtomFunction *angles_array = group_params.angleForces().constData();
         
+        //get the specialised kernels for the recognised force functions
+        boost::shared_ptr<const InternalGroupTerms> group_terms
+                                            = term_cache->get(group_params);
+        const BondedTerms &kernels = group_terms->force_kernels[ANGLE_FORCE];
+        
+        //calculate all of the angles, so that the recognised
+        //force functions can be evaluated together
+        QVarLengthArray<double, 128> thetas(nangles);
+        
+        for (int j=0; j<nangles; ++j)
+        {
+            const ThreeAtomFunction &angle = angles_array[j];
+            thetas[j] = Vector::angle( getCoords(angle.atom0(), cgroup_array),
+                                       getCoords(angle.atom1(), cgroup_array),
+                                       getCoords(angle.atom2(), cgroup_array) )
+                                                .to(radians);
+        }
+        
+        QVarLengthArray<double, 128> dvs;
+        evaluateKernels(kernels, thetas.constData(), dvs);
+        
         for (int j=0; j<nangles; ++j)
         {
             const ThreeAtomFunction &angle = angles_array[j];
@@ -886,8 +1445,15 @@ void InternalPotential::calculateAngleForce(const InternalPotential::Molecule &m
                           t, r01, r21);
                           
             //now calcualte -d V(theta) / d theta
-            vals.set(theta, t);
-            const double dv_by_dtheta = -scale_force * angle.function().evaluate(vals);
+            double dv_by_dtheta;
+            
+            if (kernels.isRecognised(j))
+                dv_by_dtheta = -scale_force * dvs[j];
+            else
+            {
+                vals.set(theta, t);
+                dv_by_dtheta = -scale_force * angle.function().evaluate(vals);
+            }
 
             //add the force onto the forces array
             addForce(dv_by_dtheta * dtheta_by_d0, angle.atom0(), forces);
@@ -1043,6 +1609,28 @@ void InternalPotential::calculateDihedralForce(
         const FourAtomFunction *dihedrals_array 
                                     = group_params.dihedralForces().constData();
         
+        //get the specialised kernels for the recognised force functions
+        boost::shared_ptr<const InternalGroupTerms> group_terms
+                                            = term_cache->get(group_params);
+        const BondedTerms &kernels = group_terms->force_kernels[DIHEDRAL_FORCE];
+        
+        //calculate all of the torsion angles, so that the recognised
+        //force functions can be evaluated together
+        QVarLengthArray<double, 128> phis(ndihedrals);
+        
+        for (int j=0; j<ndihedrals; ++j)
+        {
+            const FourAtomFunction &dihedral = dihedrals_array[j];
+            phis[j] = Vector::dihedral( getCoords(dihedral.atom0(), cgroup_array),
+                                        getCoords(dihedral.atom1(), cgroup_array),
+                                        getCoords(dihedral.atom2(), cgroup_array),
+                                        getCoords(dihedral.atom3(), cgroup_array) )
+                                                .to(radians);
+        }
+        
+        QVarLengthArray<double, 128> dvs;
+        evaluateKernels(kernels, phis.constData(), dvs);
+        
         for (int j=0; j<ndihedrals; ++j)
         {
             const FourAtomFunction &dihedral = dihedrals_array[j];
@@ -1061,8 +1649,15 @@ void InternalPotential::calculateDihedralForce(
                         dphi_by_d0, dphi_by_d1, dphi_by_d2, dphi_by_d3);
                           
             //now calcualte -d V(phi) / d phi
-            vals.set(phi, Vector::dihedral(atom0,atom1,atom2,atom3).to(radians));
-            double dv_by_dphi = -scale_force * dihedral.function().evaluate(vals);
+            double dv_by_dphi;
+            
+            if (kernels.isRecognised(j))
+                dv_by_dphi = -scale_force * dvs[j];
+            else
+            {
+                vals.set(phi, phis[j]);
+                dv_by_dphi = -scale_force * dihedral.function().evaluate(vals);
+            }
 
             //add the force onto the forces array
             addForce(dv_by_dphi * dphi_by_d0, dihedral.atom0(), forces);
@@ -1115,11 +1710,25 @@ void InternalPotential::calculateImproperForce(
             continue;
         }
                       
+        //get the specialised kernels for the recognised force functions
+        boost::shared_ptr<const InternalGroupTerms> group_terms
+                                            = term_cache->get(group_params);
+        
         //do the theta forces first...
+        const BondedTerms *kernels = &(group_terms->force_kernels[IMPROPER_THETA_FORCE]);
+        
         int nimpropers = group_params.improper_Theta_Forces().count();
         const FourAtomFunction *impropers_array 
                                  = group_params.improper_Theta_Forces().constData();
         
+        //calculate the angles of all of the impropers, so that the
+        //recognised force functions can be evaluated together
+        QVarLengthArray<double, 256> tvals;
+        QVarLengthArray<double, 128> dvs;
+        
+        getImproperAngles(impropers_array, nimpropers, cgroup_array, tvals);
+        evaluateKernels(*kernels, tvals.constData(), dvs);
+        
         for (int j=0; j<nimpropers; ++j)
         {
             const FourAtomFunction &improper = impropers_array[j];
@@ -1138,12 +1747,16 @@ void InternalPotential::calculateImproperForce(
                           dtheta_by_d0, dtheta_by_d1, dtheta_by_d2, dtheta_by_d3);
                           
             //now calculate d V(phi,theta) / d theta
-            Torsion torsion(atom0, atom1, atom2, atom3);
-                             
-            vals.set(theta, torsion.improperAngle());
-            vals.set(phi, torsion.angle());
-
-            double dv_by_dtheta = scale_force * improper.function().evaluate(vals);
+            double dv_by_dtheta;
+            
+            if (kernels->isRecognised(j))
+                dv_by_dtheta = scale_force * dvs[j];
+            else
+            {
+                vals.set(theta, tvals[2*j]);
+                vals.set(phi, tvals[2*j+1]);
+                dv_by_dtheta = scale_force * improper.function().evaluate(vals);
+            }
 
             //add the force onto the forces array
             addForce(dv_by_dtheta * dtheta_by_d0, improper.atom0(), forces);
@@ -1153,9 +1766,14 @@ void InternalPotential::calculateImproperForce(
         }
         
         //now do the phi forces
+        kernels = &(group_terms->force_kernels[IMPROPER_PHI_FORCE]);
+        
         nimpropers = group_params.improper_Phi_Forces().count();
         impropers_array = group_params.improper_Phi_Forces().constData();
         
+        getImproperAngles(impropers_array, nimpropers, cgroup_array, tvals);
+        evaluateKernels(*kernels, tvals.constData(), dvs);
+        
         for (int j=0; j<nimpropers; ++j)
         {
             const FourAtomFunction &improper = impropers_array[j];
@@ -1174,12 +1792,16 @@ void InternalPotential::calculateImproperForce(
                         dphi_by_d0, dphi_by_d1, dphi_by_d2, dphi_by_d3);
                           
             //now calculate d V(phi,theta) / d phi
-            Torsion torsion(atom0, atom1, atom2, atom3);
-                             
-            vals.set(theta, torsion.improperAngle());
-            vals.set(phi, torsion.angle());
-
-            double dv_by_dphi = scale_force * improper.function().evaluate(vals);
+            double dv_by_dphi;
+            
+            if (kernels->isRecognised(j))
+                dv_by_dphi = scale_force * dvs[j];
+            else
+            {
+                vals.set(theta, tvals[2*j]);
+                vals.set(phi, tvals[2*j+1]);
+                dv_by_dphi = scale_force * improper.function().evaluate(vals);
+            }
 
             //add the force onto the forces array
             addForce(dv_by_dphi * dphi_by_d0, improper.atom0(), forces);
@@ -1228,6 +1850,25 @@ void InternalPotential::calculateUBForce(const InternalPotential::Molecule &mole
         int nubs = group_params.ureyBradleyForces().count();
         const TwoAtomFunction *ubs_array = group_params.ureyBradleyForces().constData();
         
+        //get the specialised kernels for the recognised force functions
+        boost::shared_ptr<const InternalGroupTerms> group_terms
+                                            = term_cache->get(group_params);
+        const BondedTerms &kernels = group_terms->force_kernels[UB_FORCE];
+        
+        //calculate all of the distances, so that the recognised
+        //force functions can be evaluated together
+        QVarLengthArray<double, 128> dists(nubs);
+        
+        for (int j=0; j<nubs; ++j)
+        {
+            const TwoAtomFunction &ub = ubs_array[j];
+            dists[j] = Vector::distance( getCoords(ub.atom0(), cgroup_array),
+                                         getCoords(ub.atom1(), cgroup_array) );
+        }
+        
+        QVarLengthArray<double, 128> dvs;
+        evaluateKernels(kernels, dists.constData(), dvs);
+        
         for (int j=0; j<nubs; ++j)
         {
             const TwoAtomFunction &ub = ubs_array[j];
@@ -1243,10 +1884,19 @@ void InternalPotential::calculateUBForce(const InternalPotential::Molecule &mole
                 continue;
             
             v01 /= dist;
-            vals.set( r, dist );
+
+            double dv_by_dr;
+            
+            if (kernels.isRecognised(j))
+                dv_by_dr = dvs[j];
+            else
+            {
+                vals.set( r, dist );
+                dv_by_dr = ub.function().evaluate(vals);
+            }
 
             //evaluate the force vector
-            Vector force = scale_force * ub.function().evaluate(vals) * v01;
+            Vector force = scale_force * dv_by_dr * v01;
 
             //add the force onto the forces array
             addForce(force, ub.atom0(), forces);
@@ -2590,6 +3240,9 @@ void InternalFF::mustNowRecalculateFromScratch()
     //clear any delta information
     changed_mols.clear();
     
+    //the energy functions may have changed, so recompile them
+    InternalPotential::clearCompiledTerms();
+    
     for (QHash<MolNum,CLJ14Group>::iterator it = cljgroups.begin();
          it != cljgroups.end();
          ++it)
@@ -2598,6 +3251,22 @@ void InternalFF::mustNowRecalculateFromScratch()
     }
 }
 
+/** This forcefield can discard the changes recorded since the last
+    energy evaluation, unless it calculates the 1-4 energies (the CLJ14Groups
+    only hold the energy of their latest evaluation) */
+bool InternalFF::_pvt_canDiscardChanges() const
+{
+    return not calc_14_nrgs;
+}
+
+/** Discard the changes recorded since the last energy evaluation. This
+    is called when the molecules have been restored to the versions they
+    had at that evaluation, so there is no change in energy */
+void InternalFF::_pvt_discardChanges()
+{
+    changed_mols.clear();
+}
+
 /** Internal function used to get a handle on the forcefield components */
 const FFComponent& InternalFF::_pvt_components() const
 {
@@ -41,9 +41,18 @@
 #include "internalparameters.h"
 #include "clj14group.h"
 
+#include <boost/shared_ptr.hpp>
+
 namespace SireMM
 {
 class InternalFF;
+
+namespace detail
+{
+class InternalTermCache;
+class InternalTermBatches;
+class InternalGroupTerms;
+}
 }
 
 QDataStream &operator<<(QDataStream&, const SireMM::InternalFF&);
@@ -426,23 +435,29 @@ protected:
                         const Components &components,
                         double scale_force=1) const;
 
+    void clearCompiledTerms();
+
     bool isstrict;
 
 private:
     void calculatePhysicalEnergy(const GroupInternalParameters &group_params,
+                                 const detail::InternalGroupTerms &group_terms,
                                  const CoordGroup *cgroup_array,
-                                 InternalPotential::Energy &energy,
-                                 double scale_energy) const;
+                                 detail::InternalTermBatches &batches) const;
 
     void calculateNonPhysicalEnergy(const GroupInternalParameters &group_params,
+                                    const detail::InternalGroupTerms &group_terms,
                                     const CoordGroup *cgroup_array,
-                                    InternalPotential::Energy &energy,
-                                    double scale_energy) const;
+                                    detail::InternalTermBatches &batches) const;
 
     void calculateCrossEnergy(const GroupInternalParameters &group_params,
+                              const detail::InternalGroupTerms &group_terms,
                               const CoordGroup *cgroup_array,
-                              InternalPotential::Energy &energy,
-                              double scale_energy) const;
+                              detail::InternalTermBatches &batches) const;
+
+    /** Cache of the compiled forms of the energy functions, shared
+        between copies of this potential */
+    boost::shared_ptr<detail::InternalTermCache> term_cache;
 
     static ParameterNames param_names;
     static InternalSymbols internal_symbols;
@@ -556,6 +571,9 @@ protected:
 
     void _pvt_updateName();
 
+    bool _pvt_canDiscardChanges() const;
+    void _pvt_discardChanges();
+
 private:
     typedef InternalPotential::Molecule Molecule;
     typedef InternalPotential::Molecules Molecules;
@@ -45,11 +45,17 @@
 #include "SireMol/atomselection.h"
 #include "SireMol/selector.hpp"
 
+#include "SireFF/errors.h"
+
+#include "SireCAS/symbols.h"
+
 #include "SireUnits/units.h"
 
 #include "SireStream/datastream.h"
 #include "SireStream/shareddatastream.h"
 
+#include "tostring.h"
+
 #include <QElapsedTimer>
 #include <QDebug>
 
@@ -340,7 +346,7 @@ IntraFF::IntraFF(const QString &name)
 
 /** Copy constructor */
 IntraFF::IntraFF(const IntraFF &other)
-        : ConcreteProperty<IntraFF,G1FF>(other),
+        : ConcreteProperty<IntraFF,G1FF>(other), FF3D(other),
           moldata(other.moldata), d(other.d),
           needs_accepting(other.needs_accepting)
 {}
@@ -1151,3 +1157,183 @@ void IntraFF::accept()
     
     G1FF::accept();
 }
+
+/** Internal function used to calculate the forces on the molecules in 
+    'forcetable' using the CLJFunction at index 'idx'. The coulomb and/or 
+    LJ forces are calculated, scaled by 'scale_force' and added onto 
+    the forcetable */
+void IntraFF::calculateForces(ForceTable &forcetable, int idx, double scale_force,
+                              bool calc_coul, bool calc_lj)
+{
+    if (scale_force == 0 or not (calc_coul or calc_lj))
+        return;
+
+    //the forces must be calculated using the accepted state of the
+    //forcefield, as the CLJBoxes only hold the committed atoms
+    if (this->isDirty())
+        this->recalculateEnergy();
+    
+    if (needs_accepting)
+        throw SireError::invalid_state( QObject::tr(
+                "Cannot calculate the forces for forcefield %1 as it contains "
+                "a change that has not yet been accepted. Accept the change "
+                "by calling \"accept()\" before calculating the forces.")
+                    .arg(this->name().value()), CODELOC );
+
+    if (not d.constData()->cljfuncs.at(idx).read().supportsForceCalculation())
+        throw SireError::unsupported( QObject::tr(
+                "Cannot calculate the forces for forcefield %1 as the CLJFunction "
+                "%2 does not support force calculations.")
+                    .arg(this->name().value())
+                    .arg(d.constData()->cljfuncs.at(idx).read().toString()), CODELOC );
+    
+    for (MolData::const_iterator it = moldata.constBegin();
+         it != moldata.constEnd();
+         ++it)
+    {
+        if (not forcetable.containsTable(it.key()))
+            continue;
+        
+        const detail::IntraFFMolData &mol = *(it.value().constData());
+        
+        if (mol.cljgroup.isEmpty())
+            continue;
+        
+        //use the CLJ function that has been specialised for this molecule
+        const CLJFunction &func = mol.cljfuncs.at(idx).read();
+        const CLJBoxes &boxes = mol.cljgroup.cljBoxes();
+        
+        QVector<CLJForces> forces;
+        
+        if (usesParallelCalculation())
+        {
+            CLJCalculator calc( usesReproducibleCalculation() );
+            
+            if (calc_coul and calc_lj)
+                calc.force(func, boxes, forces, scale_force);
+            else if (calc_coul)
+                calc.coulombForce(func, boxes, forces, scale_force);
+            else
+                calc.ljForce(func, boxes, forces, scale_force);
+        }
+        else
+        {
+            if (calc_coul and calc_lj)
+                func.force(boxes, forces, scale_force);
+            else if (calc_coul)
+                func.coulombForce(boxes, forces, scale_force);
+            else
+                func.ljForce(boxes, forces, scale_force);
+        }
+        
+        mol.cljgroup.addForces(forces, forcetable);
+    }
+}
+
+/** Calculate the forces acting on the molecules in the passed forcetable  
+    and add them onto the forces present in the forcetable, optionally
+    scaled by 'scale_force'. This uses the default CLJFunction */
+void IntraFF::force(ForceTable &forcetable, double scale_force)
+{
+    this->calculateForces(forcetable, 0, scale_force, true, true);
+}
+
+/** Calculate the forces acting on the molecules in the passed forcetable
+    caused by the component of the energy represented by 'symbol', and 
+    add them onto the forces present in the forcetable, optionally 
+    scaled by 'scale_force'
+    
+    \throw SireFF::missing_component
+*/
+void IntraFF::force(ForceTable &forcetable, const Symbol &symbol, double scale_force)
+{
+    const MultiCLJComponent &comps = d.constData()->cljcomps;
+
+    foreach (QString key, comps.keys())
+    {
+        const int idx = comps.indexOf(key);
+        
+        if (symbol == comps.total(key))
+        {
+            this->calculateForces(forcetable, idx, scale_force, true, true);
+            return;
+        }
+        else if (symbol == comps.coulomb(key))
+        {
+            this->calculateForces(forcetable, idx, scale_force, true, false);
+            return;
+        }
+        else if (symbol == comps.lj(key))
+        {
+            this->calculateForces(forcetable, idx, scale_force, false, true);
+            return;
+        }
+    }
+    
+    throw SireFF::missing_component( QObject::tr(
+            "There is no forcefield component represented by %1 in the "
+            "forcefield %2. Available components are %3.")
+                .arg(symbol.toString(), this->toString(),
+                     Sire::toString(comps.symbols())), CODELOC );
+}
+
+void IntraFF::field(FieldTable &fieldtable, double scale_field)
+{
+    throw SireError::incomplete_code( QObject::tr(
+                "The code to calculate the field of an IntraFF has not "
+                "been written."), CODELOC );
+}
+
+void IntraFF::field(FieldTable &fieldtable, const Symbol &component,
+                    double scale_field)
+{
+    throw SireError::incomplete_code( QObject::tr(
+                "The code to calculate the field of an IntraFF has not "
+                "been written."), CODELOC );
+}
+
+void IntraFF::potential(PotentialTable &potentialtable, double scale_potential)
+{
+    throw SireError::incomplete_code( QObject::tr(
+                "The code to calculate the potential of an IntraFF has not "
+                "been written."), CODELOC );
+}
+
+void IntraFF::potential(PotentialTable &potentialtable, const Symbol &component,
+                        double scale_potential)
+{
+    throw SireError::incomplete_code( QObject::tr(
+                "The code to calculate the potential of an IntraFF has not "
+                "been written."), CODELOC );
+}
+
+void IntraFF::field(FieldTable &fieldtable, const Probe &probe, double scale_field)
+{
+    throw SireError::incomplete_code( QObject::tr(
+                "The code to calculate the field of an IntraFF has not "
+                "been written."), CODELOC );
+}
+
+void IntraFF::field(FieldTable &fieldtable, const Symbol &component,
+                    const Probe &probe, double scale_field)
+{
+    throw SireError::incomplete_code( QObject::tr(
+                "The code to calculate the field of an IntraFF has not "
+                "been written."), CODELOC );
+}
+
+void IntraFF::potential(PotentialTable &potentialtable, const Probe &probe,
+                        double scale_potential)
+{
+    throw SireError::incomplete_code( QObject::tr(
+                "The code to calculate the potential of an IntraFF has not "
+                "been written."), CODELOC );
+}
+
+void IntraFF::potential(PotentialTable &potentialtable, const Symbol &component,
+                        const Probe &probe, double scale_potential)
+{
+    throw SireError::incomplete_code( QObject::tr(
+                "The code to calculate the potential of an IntraFF has not "
+                "been written."), CODELOC );
+}
@@ -36,6 +36,7 @@
 #include "SireBase/chunkedhash.hpp"
 
 #include "SireFF/g1ff.h"
+#include "SireFF/ff3d.h"
 
 SIRE_BEGIN_HEADER
 
@@ -59,6 +60,13 @@ namespace detail
 class IntraFFData;
 }
 
+using SireFF::ForceTable;
+using SireFF::FieldTable;
+using SireFF::PotentialTable;
+using SireFF::Probe;
+
+using SireCAS::Symbol;
+
 /** This forcefield is used to calculate the intramolecular 
     coulomb and LJ energy of the contained molecules. Note
     that this is the coulomb and LJ energy of the non-bonded
@@ -68,7 +76,8 @@ class IntraFFData;
     
     @author Christopher Woods
 */
-class SIREMM_EXPORT IntraFF : public SireBase::ConcreteProperty<IntraFF,SireFF::G1FF>
+class SIREMM_EXPORT IntraFF : public SireBase::ConcreteProperty<IntraFF,SireFF::G1FF>,
+                               public SireFF::FF3D
 {
 
 friend QDataStream& ::operator<<(QDataStream&, const IntraFF&);
@@ -130,9 +139,38 @@ public:
     void accept();
     bool needsAccepting() const;
 
+    void force(ForceTable &forcetable, double scale_force=1);
+
+    void force(ForceTable &forcetable, const Symbol &symbol,
+               double scale_force=1);
+
+    void field(FieldTable &fieldtable, double scale_field=1);
+
+    void field(FieldTable &fieldtable, const Symbol &component,
+               double scale_field=1);
+
+    void potential(PotentialTable &potentialtable, double scale_potential=1);
+
+    void potential(PotentialTable &potentialtable, const Symbol &component,
+                   double scale_potential=1);
+
+    void field(FieldTable &fieldtable, const Probe &probe, double scale_field=1);
+
+    void field(FieldTable &fieldtable, const Symbol &component,
+               const Probe &probe, double scale_field=1);
+
+    void potential(PotentialTable &potentialtable, const Probe &probe,
+                   double scale_potential=1);
+
+    void potential(PotentialTable &potentialtable, const Symbol &component,
+                   const Probe &probe, double scale_potential=1);
+
 private:
     void mustNowReallyRecalculateFromScratch();
 
+    void calculateForces(ForceTable &forcetable, int idx, double scale_force,
+                         bool calc_coul, bool calc_lj);
+
     void recalculateEnergy();
     void rebuildProps();
     
@@ -0,0 +1,1429 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#include "pmeff.h"
+#include "cljewaldfunction.h"
+
+#include "SireVol/periodicbox.h"
+
+#include "SireBase/numberproperty.h"
+#include "SireBase/lengthproperty.h"
+
+#include "SireMaths/multifloat.h"
+#include "SireMaths/multiint.h"
+#include "SireMaths/constants.h"
+
+#include "SireMol/partialmolecule.h"
+#include "SireMol/molecule.h"
+
+#include "SireFF/errors.h"
+
+#include "SireError/errors.h"
+#include "SireBase/errors.h"
+
+#include "SireUnits/units.h"
+
+#include "tostring.h"
+
+#include "SireStream/datastream.h"
+#include "SireStream/shareddatastream.h"
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <complex>
+#include <cmath>
+
+#include <QHash>
+#include <QDebug>
+
+using namespace SireMM;
+using namespace SireMol;
+using namespace SireFF;
+using namespace SireVol;
+using namespace SireMaths;
+using namespace SireBase;
+using namespace SireUnits;
+using namespace SireStream;
+
+/** The default coulomb cutoff (matches the default CLJEwaldFunction) */
+static const double default_coul_cutoff = 10;
+
+/** The default Ewald tolerance (matches the default CLJEwaldFunction) */
+static const double default_ewald_tolerance = 1e-5;
+
+/** The default spacing of the PME grid (in angstroms) */
+static const double default_grid_spacing = 1.0;
+
+/** The default order of the B-splines */
+static const qint32 default_spline_order = 4;
+
+/** The minimum and maximum supported B-spline orders */
+static const qint32 min_spline_order = 3;
+static const qint32 max_spline_order = 12;
+
+namespace SireMM
+{
+    namespace detail
+    {
+        typedef std::complex<double> PMEComplex;
+
+        /** Return the smallest number that is greater than or equal to 'n'
+            and that has no prime factors other than 2, 3 and 5. These are
+            the grid sizes supported by PMEFFT */
+        static int pmeGridSize(int n)
+        {
+            if (n < 1)
+                n = 1;
+        
+            while (true)
+            {
+                int m = n;
+                
+                while (m % 2 == 0) m /= 2;
+                while (m % 3 == 0) m /= 3;
+                while (m % 5 == 0) m /= 5;
+                
+                if (m == 1)
+                    return n;
+                
+                ++n;
+            }
+        }
+
+        /** This is a simple mixed-radix (2, 3, 4 and 5) complex FFT that
+            is used to transform the PME grid. The transform is calculated 
+            using a recursive decimation in time, using a precalculated
+            table of the roots of unity. The transform is not normalised,
+            so a forwards followed by a backwards transform multiplies the
+            data by the number of points
+        */
+        class PMEFFT
+        {
+        public:
+            PMEFFT() : n(0)
+            {}
+            
+            PMEFFT(int size) : n(size)
+            {
+                int m = n;
+                
+                while (m % 4 == 0) { factors.append(4); m /= 4; }
+                while (m % 2 == 0) { factors.append(2); m /= 2; }
+                while (m % 3 == 0) { factors.append(3); m /= 3; }
+                while (m % 5 == 0) { factors.append(5); m /= 5; }
+                
+                if (m != 1)
+                    throw SireError::program_bug( QObject::tr(
+                            "The PME FFT only supports sizes with prime factors of "
+                            "2, 3 and 5. The size %1 is not supported.").arg(size),
+                                CODELOC );
+                
+                roots = QVector<PMEComplex>(n);
+                
+                for (int k=0; k<n; ++k)
+                {
+                    roots[k] = std::polar(1.0, -2.0 * SireMaths::pi * k / n);
+                }
+            }
+            
+            int size() const
+            {
+                return n;
+            }
+            
+            /** Transform the 'n' points in 'in' (separated by 'stride'),
+                placing the result into the contiguous array 'out' */
+            void transform(const PMEComplex *in, int stride, PMEComplex *out,
+                           bool inverse) const
+            {
+                this->recurse(in, out, n, stride, 0, inverse);
+            }
+            
+        private:
+            PMEComplex root(int k, bool inverse) const
+            {
+                return inverse ? std::conj(roots.constData()[k]) : roots.constData()[k];
+            }
+        
+            void recurse(const PMEComplex *in, PMEComplex *out,
+                         int size, int stride, int ifactor, bool inverse) const
+            {
+                if (size == 1)
+                {
+                    out[0] = in[0];
+                    return;
+                }
+                
+                const int p = factors.constData()[ifactor];
+                const int m = size / p;
+                
+                //transform each of the 'p' interleaved sub-sequences
+                for (int q=0; q<p; ++q)
+                {
+                    this->recurse(in + q*stride, out + q*m, m, stride*p,
+                                  ifactor+1, inverse);
+                }
+                
+                //now combine them using a size 'p' DFT - the roots of
+                //unity for this size are every 'rstride' root of the full size
+                const int rstride = n / size;
+                
+                PMEComplex tmp[5];
+                
+                for (int k=0; k<m; ++k)
+                {
+                    for (int q=0; q<p; ++q)
+                    {
+                        tmp[q] = out[q*m + k] * root( (q*k*rstride) % n, inverse );
+                    }
+                    
+                    for (int s=0; s<p; ++s)
+                    {
+                        PMEComplex sum = tmp[0];
+                        
+                        for (int q=1; q<p; ++q)
+                        {
+                            sum += tmp[q] * root( ((q*s*m) % size) * rstride, inverse );
+                        }
+                        
+                        out[k + s*m] = sum;
+                    }
+                }
+            }
+        
+            /** The number of points */
+            int n;
+            
+            /** The factors of n */
+            QVector<int> factors;
+            
+            /** The roots of unity, exp(-2 pi i k / n) */
+            QVector<PMEComplex> roots;
+        };
+        
+        /** Functor used to transform all of the lines of the 3D grid
+            along one axis in parallel */
+        class PMEFFTLines
+        {
+        public:
+            PMEFFTLines(PMEComplex *grid, const int *dims, int axis,
+                        const PMEFFT &fft, bool inverse)
+                 : g(grid), k1(dims[1]), k2(dims[2]), ax(axis), f(fft), inv(inverse)
+            {}
+            
+            void operator()(const tbb::blocked_range<int> &range) const
+            {
+                const int n = f.size();
+                
+                QVector<PMEComplex> line(n);
+                PMEComplex *out = line.data();
+                
+                int stride = 1;
+                
+                if (ax == 0)
+                    stride = k1 * k2;
+                else if (ax == 1)
+                    stride = k2;
+                
+                for (int l=range.begin(); l<range.end(); ++l)
+                {
+                    int start;
+                    
+                    if (ax == 0)
+                        start = l;
+                    else if (ax == 1)
+                        start = (l / k2) * k1 * k2 + (l % k2);
+                    else
+                        start = l * k2;
+                    
+                    PMEComplex *data = g + start;
+                    
+                    f.transform(data, stride, out, inv);
+                    
+                    for (int i=0; i<n; ++i)
+                    {
+                        data[i*stride] = out[i];
+                    }
+                }
+            }
+            
+        private:
+            PMEComplex *g;
+            const int k1, k2, ax;
+            const PMEFFT &f;
+            const bool inv;
+        };
+        
+        /** Calculate the (unnormalised) 3D FFT of 'grid', which has dimensions 
+            'dims' and is stored with z varying fastest */
+        static void pmeFFT3D(PMEComplex *grid, const int *dims,
+                             const PMEFFT *ffts, bool inverse)
+        {
+            for (int axis=0; axis<3; ++axis)
+            {
+                int nlines;
+                
+                if (axis == 0)
+                    nlines = dims[1] * dims[2];
+                else if (axis == 1)
+                    nlines = dims[0] * dims[2];
+                else
+                    nlines = dims[0] * dims[1];
+            
+                tbb::parallel_for( tbb::blocked_range<int>(0, nlines, 16),
+                                   PMEFFTLines(grid, dims, axis, ffts[axis], inverse) );
+            }
+        }
+        
+        /** Calculate the 'order' cardinal B-spline weights (in 'theta') and their
+            derivatives (in 'dtheta') of a point at fractional offset 'w' from
+            its grid point. The weight theta[k] applies to grid point 
+            floor(u) + k (this shifts the charges by a constant amount,
+            which does not affect the energy or forces) */
+        static void pmeBSpline(double w, int order, double *theta, double *dtheta)
+        {
+            theta[order-1] = 0;
+            theta[1] = w;
+            theta[0] = 1 - w;
+            
+            for (int j=3; j<order; ++j)
+            {
+                const double div = 1.0 / (j-1);
+                theta[j-1] = div * w * theta[j-2];
+                
+                for (int k=1; k<j-1; ++k)
+                {
+                    theta[j-k-1] = div * ( (w+k) * theta[j-k-2] + (j-k-w) * theta[j-k-1] );
+                }
+                
+                theta[0] = div * (1-w) * theta[0];
+            }
+            
+            //the derivatives come from the order-1 splines
+            dtheta[0] = -theta[0];
+            
+            for (int j=1; j<order; ++j)
+            {
+                dtheta[j] = theta[j-1] - theta[j];
+            }
+            
+            //one more recursion to get the order 'order' splines
+            const double div = 1.0 / (order-1);
+            theta[order-1] = div * w * theta[order-2];
+            
+            for (int k=1; k<order-1; ++k)
+            {
+                theta[order-k-1] = div * ( (w+k) * theta[order-k-2] + 
+                                           (order-k-w) * theta[order-k-1] );
+            }
+            
+            theta[0] = div * (1-w) * theta[0];
+        }
+        
+        /** Return the squared moduli of the B-spline structure factors, |b(m)|^2,
+            for a grid with 'k' points along one axis. This returns the
+            inverse, 1 / |b(m)|^2, as that is what is used in the energy */
+        static QVector<double> pmeBSplineModuli(int k, int order)
+        {
+            QVector<double> theta(order), dtheta(order);
+            pmeBSpline(0.0, order, theta.data(), dtheta.data());
+            
+            QVector<double> mods(k);
+            
+            for (int m=0; m<k; ++m)
+            {
+                PMEComplex sum(0,0);
+                
+                for (int j=0; j<order; ++j)
+                {
+                    sum += theta[j] * std::polar(1.0, 2.0 * SireMaths::pi * m * j / k);
+                }
+                
+                mods[m] = std::norm(sum);
+            }
+            
+            //odd-order splines have zero moduli at the Nyquist frequency,
+            //so interpolate these from their neighbours
+            for (int m=0; m<k; ++m)
+            {
+                if (mods[m] < 1e-7)
+                    mods[m] = 0.5 * ( mods[(m-1+k)%k] + mods[(m+1)%k] );
+            }
+            
+            for (int m=0; m<k; ++m)
+            {
+                mods[m] = 1.0 / mods[m];
+            }
+            
+            return mods;
+        }
+        
+        /** This holds the charged atoms that are used in the PME calculation */
+        class PMEAtoms
+        {
+        public:
+            PMEAtoms()
+            {}
+            
+            int count() const
+            {
+                return q.count();
+            }
+        
+            /** The coordinates of the atoms */
+            QVector<Vector> coords;
+            
+            /** The (reduced) charges of the atoms */
+            QVector<double> q;
+            
+            /** The ID (molecule number) of the atoms */
+            QVector<qint32> id;
+            
+            /** The index of the box in the CLJBoxes that contains each atom */
+            QVector<qint32> box;
+            
+            /** The index of each atom in its box */
+            QVector<qint32> atom;
+        };
+        
+        /** Functor used to calculate the B-spline weights of all of the atoms
+            in parallel */
+        class PMESplineCalculator
+        {
+        public:
+            PMESplineCalculator(const PMEAtoms &atoms, const int *dims,
+                                const Vector &box, int order,
+                                qint32 *indicies, double *theta, double *dtheta)
+                 : a(atoms), k(dims), b(box), n(order),
+                   idxs(indicies), th(theta), dth(dtheta)
+            {}
+            
+            void operator()(const tbb::blocked_range<int> &range) const
+            {
+                const Vector *coords = a.coords.constData();
+                
+                for (int i=range.begin(); i<range.end(); ++i)
+                {
+                    for (int ax=0; ax<3; ++ax)
+                    {
+                        //fractional coordinate, wrapped into the box
+                        double u = coords[i][ax] / b[ax];
+                        u = k[ax] * (u - std::floor(u));
+                        
+                        int idx = int(u);
+                        
+                        if (idx >= k[ax])
+                            idx = k[ax] - 1;
+                        
+                        idxs[3*i + ax] = idx;
+                        
+                        const int offset = (3*i + ax) * n;
+                        pmeBSpline(u - idx, n, th + offset, dth + offset);
+                    }
+                }
+            }
+            
+        private:
+            const PMEAtoms &a;
+            const int *k;
+            const Vector b;
+            const int n;
+            qint32 *idxs;
+            double *th;
+            double *dth;
+        };
+        
+        /** Functor used to spread the charges onto the grid in parallel. Each 
+            task only writes to the grid planes (first index) in its range, 
+            so no locking is needed */
+        class PMEChargeSpreader
+        {
+        public:
+            PMEChargeSpreader(const PMEAtoms &atoms, const int *dims, int order,
+                              const qint32 *indicies, const double *theta,
+                              PMEComplex *grid)
+                 : a(atoms), k(dims), n(order), idxs(indicies), th(theta), g(grid)
+            {}
+            
+            void operator()(const tbb::blocked_range<int> &range) const
+            {
+                const double *q = a.q.constData();
+                const int natoms = a.count();
+                
+                for (int i=0; i<natoms; ++i)
+                {
+                    const qint32 *idx = idxs + 3*i;
+                    const double *thx = th + (3*i) * n;
+                    const double *thy = thx + n;
+                    const double *thz = thy + n;
+                    
+                    for (int ix=0; ix<n; ++ix)
+                    {
+                        const int gx = (idx[0] + ix) % k[0];
+                        
+                        if (gx < range.begin() or gx >= range.end())
+                            continue;
+                        
+                        const double qx = q[i] * thx[ix];
+                        
+                        for (int iy=0; iy<n; ++iy)
+                        {
+                            const int gy = (idx[1] + iy) % k[1];
+                            const double qxy = qx * thy[iy];
+                            
+                            PMEComplex *row = g + (gx*k[1] + gy)*k[2];
+                            
+                            for (int iz=0; iz<n; ++iz)
+                            {
+                                const int gz = (idx[2] + iz) % k[2];
+                                row[gz] += qxy * thz[iz];
+                            }
+                        }
+                    }
+                }
+            }
+            
+        private:
+            const PMEAtoms &a;
+            const int *k;
+            const int n;
+            const qint32 *idxs;
+            const double *th;
+            PMEComplex *g;
+        };
+
+        /** Functor used to calculate the reciprocal space energy of each
+            plane of the transformed grid in parallel, and to multiply the
+            transformed grid by the reciprocal space influence function */
+        class PMEConvolver
+        {
+        public:
+            PMEConvolver(PMEComplex *grid, const int *dims, const Vector &box,
+                         double beta, const QVector<double> *bsp_mods,
+                         double *plane_energies)
+                 : g(grid), k(dims), b(box), bta(beta), mods(bsp_mods),
+                   nrgs(plane_energies)
+            {}
+            
+            void operator()(const tbb::blocked_range<int> &range) const
+            {
+                const double pi = SireMaths::pi;
+                const double volume = b.x() * b.y() * b.z();
+                const double prefactor = 1.0 / (pi * volume);
+                const double pi2_over_beta2 = pi * pi / (bta * bta);
+                
+                for (int ix=range.begin(); ix<range.end(); ++ix)
+                {
+                    const double mx = (ix <= k[0]/2 ? ix : ix - k[0]) / b.x();
+                    const double modx = mods[0].constData()[ix];
+                    
+                    double nrg = 0;
+                    
+                    for (int iy=0; iy<k[1]; ++iy)
+                    {
+                        const double my = (iy <= k[1]/2 ? iy : iy - k[1]) / b.y();
+                        const double modxy = modx * mods[1].constData()[iy];
+                        
+                        PMEComplex *row = g + (ix*k[1] + iy)*k[2];
+                        
+                        for (int iz=0; iz<k[2]; ++iz)
+                        {
+                            if (ix == 0 and iy == 0 and iz == 0)
+                            {
+                                row[iz] = 0;
+                                continue;
+                            }
+                        
+                            const double mz = (iz <= k[2]/2 ? iz : iz - k[2]) / b.z();
+                            const double m2 = mx*mx + my*my + mz*mz;
+                            
+                            const double theta = prefactor * std::exp(-pi2_over_beta2 * m2) 
+                                                    * modxy * mods[2].constData()[iz] / m2;
+                            
+                            nrg += theta * std::norm(row[iz]);
+                            row[iz] *= theta;
+                        }
+                    }
+                    
+                    nrgs[ix] = 0.5 * nrg;
+                }
+            }
+            
+        private:
+            PMEComplex *g;
+            const int *k;
+            const Vector b;
+            const double bta;
+            const QVector<double> *mods;
+            double *nrgs;
+        };
+        
+        /** Functor used to gather the forces on the atoms from the convolved
+            grid in parallel */
+        class PMEForceGatherer
+        {
+        public:
+            PMEForceGatherer(const PMEAtoms &atoms, const int *dims, const Vector &box,
+                             int order, const qint32 *indicies,
+                             const double *theta, const double *dtheta,
+                             const PMEComplex *grid, Vector *forces)
+                 : a(atoms), k(dims), b(box), n(order), idxs(indicies),
+                   th(theta), dth(dtheta), g(grid), f(forces)
+            {}
+            
+            void operator()(const tbb::blocked_range<int> &range) const
+            {
+                const double *q = a.q.constData();
+                
+                const double scale_x = k[0] / b.x();
+                const double scale_y = k[1] / b.y();
+                const double scale_z = k[2] / b.z();
+                
+                for (int i=range.begin(); i<range.end(); ++i)
+                {
+                    const qint32 *idx = idxs + 3*i;
+                    const double *thx = th + (3*i) * n;
+                    const double *thy = thx + n;
+                    const double *thz = thy + n;
+                    const double *dthx = dth + (3*i) * n;
+                    const double *dthy = dthx + n;
+                    const double *dthz = dthy + n;
+                    
+                    double fx(0), fy(0), fz(0);
+                    
+                    for (int ix=0; ix<n; ++ix)
+                    {
+                        const int gx = (idx[0] + ix) % k[0];
+                        
+                        for (int iy=0; iy<n; ++iy)
+                        {
+                            const int gy = (idx[1] + iy) % k[1];
+                            
+                            const PMEComplex *row = g + (gx*k[1] + gy)*k[2];
+                            
+                            for (int iz=0; iz<n; ++iz)
+                            {
+                                const int gz = (idx[2] + iz) % k[2];
+                                const double pot = row[gz].real();
+                                
+                                fx += pot * dthx[ix] * thy[iy] * thz[iz];
+                                fy += pot * thx[ix] * dthy[iy] * thz[iz];
+                                fz += pot * thx[ix] * thy[iy] * dthz[iz];
+                            }
+                        }
+                    }
+                    
+                    f[i] = Vector( -q[i] * fx * scale_x,
+                                   -q[i] * fy * scale_y,
+                                   -q[i] * fz * scale_z );
+                }
+            }
+            
+        private:
+            const PMEAtoms &a;
+            const int *k;
+            const Vector b;
+            const int n;
+            const qint32 *idxs;
+            const double *th;
+            const double *dth;
+            const PMEComplex *g;
+            Vector *f;
+        };
+        
+        /** Functor used to calculate, in parallel over molecules, the correction 
+            that removes the reciprocal space interaction between atoms in 
+            the same molecule, i.e. -q0 q1 erf(beta r) / r */
+        class PMEExclusionCorrector
+        {
+        public:
+            PMEExclusionCorrector(const PMEAtoms &atoms, const QVector< QVector<int> > &mols,
+                                  double beta, double *mol_energies, Vector *forces)
+                 : a(atoms), m(mols), bta(beta), nrgs(mol_energies), f(forces)
+            {}
+            
+            void operator()(const tbb::blocked_range<int> &range) const
+            {
+                const Vector *coords = a.coords.constData();
+                const double *q = a.q.constData();
+                
+                const double two_beta_over_sqrt_pi = 2.0 * bta / std::sqrt(SireMaths::pi);
+                
+                for (int imol=range.begin(); imol<range.end(); ++imol)
+                {
+                    const QVector<int> &atoms = m.constData()[imol];
+                    const int nats = atoms.count();
+                    
+                    double nrg = 0;
+                    
+                    for (int i=0; i<nats-1; ++i)
+                    {
+                        const int atom0 = atoms.constData()[i];
+                        
+                        for (int j=i+1; j<nats; ++j)
+                        {
+                            const int atom1 = atoms.constData()[j];
+                            
+                            const Vector delta = coords[atom1] - coords[atom0];
+                            const double r = delta.length();
+                            const double q0q1 = q[atom0] * q[atom1];
+                            
+                            if (r < 1e-6)
+                            {
+                                //limit of erf(beta r) / r as r -> 0
+                                nrg -= q0q1 * two_beta_over_sqrt_pi;
+                                continue;
+                            }
+                            
+                            const double one_over_r = 1.0 / r;
+                            const double erf_over_r = std::erf(bta * r) * one_over_r;
+                            
+                            nrg -= q0q1 * erf_over_r;
+                            
+                            if (f)
+                            {
+                                //dE/dr = -q0q1 { (2 beta / sqrt(pi)) exp(-beta^2 r^2) / r
+                                //                  - erf(beta r) / r^2 }
+                                const double dE_dr = -q0q1 * one_over_r *
+                                        ( two_beta_over_sqrt_pi * std::exp(-bta*bta*r*r)
+                                                    - erf_over_r );
+                                
+                                const Vector f1 = (-dE_dr * one_over_r) * delta;
+                                
+                                f[atom1] += f1;
+                                f[atom0] -= f1;
+                            }
+                        }
+                    }
+                    
+                    nrgs[imol] = nrg;
+                }
+            }
+        
+        private:
+            const PMEAtoms &a;
+            const QVector< QVector<int> > &m;
+            const double bta;
+            double *nrgs;
+            Vector *f;
+        };
+    }
+}
+
+/////////
+///////// Implementation of PMEFF
+/////////
+
+static RegisterMetaType<PMEFF> r_pmeff;
+
+QDataStream SIREMM_EXPORT &operator<<(QDataStream &ds, const PMEFF &pmeff)
+{
+    writeHeader(ds, r_pmeff, 1);
+    
+    SharedDataStream sds(ds);
+    
+    sds << pmeff.cljgroup << pmeff.spce
+        << pmeff.coul_cutoff << pmeff.ewald_tol
+        << pmeff.grid_spacing << pmeff.spline_order
+        << static_cast<const G1FF&>(pmeff);
+
+    return ds;
+}
+
+QDataStream SIREMM_EXPORT &operator>>(QDataStream &ds, PMEFF &pmeff)
+{
+    VersionID v = readHeader(ds, r_pmeff);
+    
+    if (v == 1)
+    {
+        SharedDataStream sds(ds);
+        
+        sds >> pmeff.cljgroup >> pmeff.spce
+            >> pmeff.coul_cutoff >> pmeff.ewald_tol
+            >> pmeff.grid_spacing >> pmeff.spline_order
+            >> static_cast<G1FF&>(pmeff);
+        
+        pmeff.ewald_beta = CLJEwaldFunction::calculateBeta( Length(pmeff.coul_cutoff),
+                                                            pmeff.ewald_tol );
+        
+        pmeff.rebuildProps();
+        pmeff._pvt_updateName();
+    }
+    else
+        throw version_error(v, "1", r_pmeff, CODELOC);
+    
+    return ds;
+}
+
+/** Constructor */
+PMEFF::PMEFF()
+      : ConcreteProperty<PMEFF,G1FF>(), FF3D(),
+        cljgroup(CLJExtractor::EXTRACT_BY_CUTGROUP),
+        coul_cutoff(default_coul_cutoff), ewald_tol(default_ewald_tolerance),
+        grid_spacing(default_grid_spacing), spline_order(default_spline_order)
+{
+    ewald_beta = CLJEwaldFunction::calculateBeta( Length(coul_cutoff), ewald_tol );
+    this->_pvt_updateName();
+    this->rebuildProps();
+}
+
+/** Construct, specifying the name of the forcefield */
+PMEFF::PMEFF(const QString &name)
+      : ConcreteProperty<PMEFF,G1FF>(), FF3D(),
+        cljgroup(CLJExtractor::EXTRACT_BY_CUTGROUP),
+        coul_cutoff(default_coul_cutoff), ewald_tol(default_ewald_tolerance),
+        grid_spacing(default_grid_spacing), spline_order(default_spline_order)
+{
+    ewald_beta = CLJEwaldFunction::calculateBeta( Length(coul_cutoff), ewald_tol );
+    G1FF::setName(name);
+    this->rebuildProps();
+}
+
+/** Copy constructor */
+PMEFF::PMEFF(const PMEFF &other)
+      : ConcreteProperty<PMEFF,G1FF>(other), FF3D(other),
+        cljgroup(other.cljgroup), ffcomponents(other.ffcomponents),
+        spce(other.spce), coul_cutoff(other.coul_cutoff),
+        ewald_tol(other.ewald_tol), ewald_beta(other.ewald_beta),
+        grid_spacing(other.grid_spacing), spline_order(other.spline_order),
+        props(other.props)
+{}
+
+/** Destructor */
+PMEFF::~PMEFF()
+{}
+
+const char* PMEFF::typeName()
+{
+    return QMetaType::typeName( qMetaTypeId<PMEFF>() );
+}
+
+const char* PMEFF::what() const
+{
+    return PMEFF::typeName();
+}
+
+/** Copy assignment operator */
+PMEFF& PMEFF::operator=(const PMEFF &other)
+{
+    if (this != &other)
+    {
+        cljgroup = other.cljgroup;
+        ffcomponents = other.ffcomponents;
+        spce = other.spce;
+        coul_cutoff = other.coul_cutoff;
+        ewald_tol = other.ewald_tol;
+        ewald_beta = other.ewald_beta;
+        grid_spacing = other.grid_spacing;
+        spline_order = other.spline_order;
+        props = other.props;
+        G1FF::operator=(other);
+    }
+    
+    return *this;
+}
+
+/** Comparison operator */
+bool PMEFF::operator==(const PMEFF &other) const
+{
+    return (this == &other) or
+           (G1FF::operator==(other) and spce == other.spce and
+            coul_cutoff == other.coul_cutoff and ewald_tol == other.ewald_tol and
+            grid_spacing == other.grid_spacing and spline_order == other.spline_order and
+            cljgroup == other.cljgroup);
+}
+
+/** Comparison operator */
+bool PMEFF::operator!=(const PMEFF &other) const
+{
+    return not operator==(other);
+}
+
+PMEFF* PMEFF::clone() const
+{
+    return new PMEFF(*this);
+}
+
+/** Internal function called when the name of the forcefield changes */
+void PMEFF::_pvt_updateName()
+{
+    ffcomponents = CoulombComponent(this->name());
+    G1FF::_pvt_updateName();
+}
+
+/** Return the energy components of this forcefield */
+const CoulombComponent& PMEFF::components() const
+{
+    return ffcomponents;
+}
+
+/** Internal function used to rebuild the properties of this forcefield */
+void PMEFF::rebuildProps()
+{
+    props = Properties();
+    
+    props.setProperty("space", spce);
+    props.setProperty("coulombCutoff", LengthProperty(Length(coul_cutoff)));
+    props.setProperty("ewaldTolerance", NumberProperty(ewald_tol));
+    props.setProperty("gridSpacing", LengthProperty(Length(grid_spacing)));
+    props.setProperty("splineOrder", NumberProperty(int(spline_order)));
+}
+
+/** Set the space used by this forcefield. The energy can only be
+    calculated if this is a PeriodicBox */
+void PMEFF::setSpace(const Space &space)
+{
+    if (spce.isNull() or not spce.read().equals(space))
+    {
+        spce = space;
+        this->rebuildProps();
+        this->mustNowRecalculateFromScratch();
+    }
+}
+
+/** Return the space used by this forcefield */
+const Space& PMEFF::space() const
+{
+    return spce.read();
+}
+
+/** Set the real-space coulomb cutoff. This must be the same as the
+    coulomb cutoff of the CLJEwaldFunction used for the real-space
+    sum, as it sets the value of the Ewald splitting parameter */
+void PMEFF::setCoulombCutoff(Length cutoff)
+{
+    const double new_beta = CLJEwaldFunction::calculateBeta(cutoff, ewald_tol);
+    
+    if (cutoff.to(angstrom) != coul_cutoff)
+    {
+        coul_cutoff = cutoff.to(angstrom);
+        ewald_beta = new_beta;
+        this->rebuildProps();
+        this->mustNowRecalculateFromScratch();
+    }
+}
+
+/** Return the real-space coulomb cutoff */
+Length PMEFF::coulombCutoff() const
+{
+    return Length(coul_cutoff);
+}
+
+/** Set the Ewald tolerance. This must be the same as the tolerance
+    of the CLJEwaldFunction used for the real-space sum */
+void PMEFF::setEwaldTolerance(double tolerance)
+{
+    const double new_beta = CLJEwaldFunction::calculateBeta(Length(coul_cutoff), tolerance);
+    
+    if (tolerance != ewald_tol)
+    {
+        ewald_tol = tolerance;
+        ewald_beta = new_beta;
+        this->rebuildProps();
+        this->mustNowRecalculateFromScratch();
+    }
+}
+
+/** Return the Ewald tolerance */
+double PMEFF::ewaldTolerance() const
+{
+    return ewald_tol;
+}
+
+/** Return the Ewald splitting parameter, beta (in inverse angstroms) */
+double PMEFF::beta() const
+{
+    return ewald_beta;
+}
+
+/** Set the target spacing of the PME grid. The actual spacing will be 
+    a little smaller than this, as the number of grid points along each
+    dimension is rounded up to a size supported by the FFT
+    
+    \throw SireError::invalid_arg
+*/
+void PMEFF::setGridSpacing(Length spacing)
+{
+    if (spacing.value() <= 0)
+        throw SireError::invalid_arg( QObject::tr(
+                "The PME grid spacing must be greater than zero (not %1 A).")
+                    .arg(spacing.to(angstrom)), CODELOC );
+
+    if (spacing.to(angstrom) != grid_spacing)
+    {
+        grid_spacing = spacing.to(angstrom);
+        this->rebuildProps();
+        this->mustNowRecalculateFromScratch();
+    }
+}
+
+/** Return the target spacing of the PME grid */
+Length PMEFF::gridSpacing() const
+{
+    return Length(grid_spacing);
+}
+
+/** Set the order of the B-splines used to spread the charges onto
+    the grid (4 is cubic B-splines). Higher orders are more accurate,
+    but more expensive
+    
+    \throw SireError::invalid_arg
+*/
+void PMEFF::setSplineOrder(int order)
+{
+    if (order < min_spline_order or order > max_spline_order)
+        throw SireError::invalid_arg( QObject::tr(
+                "The B-spline order must lie between %1 and %2 (not %3).")
+                    .arg(min_spline_order).arg(max_spline_order).arg(order),
+                        CODELOC );
+    
+    if (order != spline_order)
+    {
+        spline_order = order;
+        this->rebuildProps();
+        this->mustNowRecalculateFromScratch();
+    }
+}
+
+/** Return the order of the B-splines used to spread the charges */
+int PMEFF::splineOrder() const
+{
+    return spline_order;
+}
+
+/** Set the forcefield property called 'name' to the value 'property' */
+bool PMEFF::setProperty(const QString &name, const Property &property)
+{
+    PMEFF old(*this);
+    
+    if (name == "space")
+    {
+        this->setSpace( property.asA<Space>() );
+    }
+    else if (name == "coulombCutoff")
+    {
+        this->setCoulombCutoff( property.asA<LengthProperty>() );
+    }
+    else if (name == "ewaldTolerance")
+    {
+        this->setEwaldTolerance( property.asA<NumberProperty>().value() );
+    }
+    else if (name == "gridSpacing")
+    {
+        this->setGridSpacing( property.asA<LengthProperty>() );
+    }
+    else if (name == "splineOrder")
+    {
+        this->setSplineOrder( property.asA<NumberProperty>().toInt() );
+    }
+    else
+        throw SireBase::missing_property( QObject::tr(
+                "No property at the key '%1' in this forcefield. Available "
+                "properties are %2.").arg(name).arg(Sire::toString(props.propertyKeys())),
+                    CODELOC );
+    
+    return not (old == *this);
+}
+
+/** Return the value of the forcefield property with name 'name' */
+const Property& PMEFF::property(const QString &name) const
+{
+    return props.property(name);
+}
+
+/** Return whether or not this forcefield contains the property 'property' */
+bool PMEFF::containsProperty(const QString &name) const
+{
+    return props.hasProperty(name);
+}
+
+/** Return all of the properties of this forcefield */
+const Properties& PMEFF::properties() const
+{
+    return props;
+}
+
+/** Signal that this forcefield must now be recalculated from scratch */
+void PMEFF::mustNowRecalculateFromScratch()
+{
+    cljgroup.mustRecalculateFromScratch();
+    this->setDirty();
+}
+
+/** Internal function that calculates and returns the reciprocal space
+    energy (including the self and intramolecular corrections) of all 
+    of the atoms in this forcefield. If 'forces' is not null, then the 
+    forces on the atoms are also calculated, and are placed into 'forces'
+    in the same order as cljgroup.cljBoxes().occupiedBoxes()
+    
+    \throw SireError::incompatible_error
+*/
+double PMEFF::calculate(QVector<CLJForces> *forces)
+{
+    //the reciprocal sum is global, so the group must be up to date
+    if (cljgroup.needsAccepting() or cljgroup.recalculatingFromScratch())
+        cljgroup.accept();
+
+    if (cljgroup.isEmpty())
+        return 0;
+
+    if (spce.isNull() or not spce.read().isA<PeriodicBox>())
+        throw SireError::incompatible_error( QObject::tr(
+                "The particle mesh Ewald forcefield %1 can only be used with a "
+                "periodic box. Set the space using \"setSpace\".")
+                    .arg(this->name().value()), CODELOC );
+
+    const Vector box = spce.read().asA<PeriodicBox>().dimensions();
+    
+    //collect all of the charged atoms
+    const CLJBoxes::Container &boxes = cljgroup.cljBoxes().occupiedBoxes();
+    
+    detail::PMEAtoms atoms;
+    QHash< qint32,QVector<int> > mol_atoms;
+    
+    const qint32 dummy_id = CLJAtoms::idOfDummy()[0];
+    
+    if (forces)
+        *forces = QVector<CLJForces>(boxes.count());
+    
+    for (int ibox=0; ibox<boxes.count(); ++ibox)
+    {
+        const CLJAtoms &box_atoms = boxes.constData()[ibox].read().atoms();
+
+        if (forces)
+            (*forces)[ibox] = CLJForces(box_atoms);
+        
+        const MultiFloat *x = box_atoms.x().constData();
+        const MultiFloat *y = box_atoms.y().constData();
+        const MultiFloat *z = box_atoms.z().constData();
+        const MultiFloat *q = box_atoms.q().constData();
+        const MultiInt *id = box_atoms.ID().constData();
+        
+        for (int i=0; i<box_atoms.x().count(); ++i)
+        {
+            for (int ii=0; ii<MultiFloat::count(); ++ii)
+            {
+                if (id[i][ii] == dummy_id or q[i][ii] == 0)
+                    continue;
+                
+                mol_atoms[id[i][ii]].append(atoms.count());
+                
+                atoms.coords.append( Vector(x[i][ii], y[i][ii], z[i][ii]) );
+                atoms.q.append( q[i][ii] );
+                atoms.id.append( id[i][ii] );
+                atoms.box.append( ibox );
+                atoms.atom.append( i*MultiFloat::count() + ii );
+            }
+        }
+    }
+    
+    const int natoms = atoms.count();
+    
+    if (natoms == 0)
+        return 0;
+    
+    const int order = spline_order;
+
+    //work out the size of the grid
+    int dims[3];
+    
+    for (int i=0; i<3; ++i)
+    {
+        dims[i] = detail::pmeGridSize( qMax( int(std::ceil(box[i] / grid_spacing)),
+                                             2*order ) );
+    }
+    
+    //calculate the B-spline weights for each atom
+    QVector<qint32> idxs(3*natoms);
+    QVector<double> theta(3*natoms*order);
+    QVector<double> dtheta(3*natoms*order);
+    
+    tbb::parallel_for( tbb::blocked_range<int>(0, natoms, 256),
+                       detail::PMESplineCalculator(atoms, dims, box, order, idxs.data(),
+                                                   theta.data(), dtheta.data()) );
+    
+    //spread the charges onto the grid
+    QVector<detail::PMEComplex> grid(dims[0]*dims[1]*dims[2], detail::PMEComplex(0,0));
+    
+    tbb::parallel_for( tbb::blocked_range<int>(0, dims[0], order),
+                       detail::PMEChargeSpreader(atoms, dims, order, idxs.constData(),
+                                                 theta.constData(), grid.data()) );
+
+    //transform, and then convolve with the influence function
+    const detail::PMEFFT ffts[3] = { detail::PMEFFT(dims[0]),
+                                     detail::PMEFFT(dims[1]),
+                                     detail::PMEFFT(dims[2]) };
+
+    detail::pmeFFT3D(grid.data(), dims, ffts, false);
+    
+    const QVector<double> bsp_mods[3] = { detail::pmeBSplineModuli(dims[0], order),
+                                          detail::pmeBSplineModuli(dims[1], order),
+                                          detail::pmeBSplineModuli(dims[2], order) };
+    
+    QVector<double> plane_nrgs(dims[0], 0.0);
+    
+    tbb::parallel_for( tbb::blocked_range<int>(0, dims[0]),
+                       detail::PMEConvolver(grid.data(), dims, box, ewald_beta,
+                                            bsp_mods, plane_nrgs.data()) );
+    
+    double nrg = 0;
+    
+    for (int i=0; i<dims[0]; ++i)
+    {
+        nrg += plane_nrgs.constData()[i];
+    }
+    
+    //the self energy, and the correction for any net charge
+    double sum_q(0), sum_q2(0);
+    
+    for (int i=0; i<natoms; ++i)
+    {
+        const double q = atoms.q.constData()[i];
+        sum_q += q;
+        sum_q2 += q*q;
+    }
+    
+    const double volume = box.x() * box.y() * box.z();
+    
+    nrg -= (ewald_beta / std::sqrt(SireMaths::pi)) * sum_q2;
+    nrg -= (SireMaths::pi / (2 * volume * ewald_beta * ewald_beta)) * sum_q * sum_q;
+    
+    QVector<Vector> atom_forces;
+    
+    if (forces)
+    {
+        atom_forces = QVector<Vector>(natoms, Vector(0));
+    
+        //transform back to get the potential on the grid, and gather
+        //the forces from the grid
+        detail::pmeFFT3D(grid.data(), dims, ffts, true);
+        
+        tbb::parallel_for( tbb::blocked_range<int>(0, natoms, 256),
+                           detail::PMEForceGatherer(atoms, dims, box, order,
+                                                    idxs.constData(), theta.constData(),
+                                                    dtheta.constData(), grid.constData(),
+                                                    atom_forces.data()) );
+    }
+    
+    //remove the interactions within each molecule
+    const QVector< QVector<int> > mols = mol_atoms.values().toVector();
+    QVector<double> mol_nrgs(mols.count(), 0.0);
+    
+    tbb::parallel_for( tbb::blocked_range<int>(0, mols.count()),
+                       detail::PMEExclusionCorrector(atoms, mols, ewald_beta, mol_nrgs.data(),
+                                                     forces ? atom_forces.data() : 0) );
+    
+    for (int i=0; i<mols.count(); ++i)
+    {
+        nrg += mol_nrgs.constData()[i];
+    }
+    
+    if (forces)
+    {
+        CLJForces *f = forces->data();
+        
+        for (int i=0; i<natoms; ++i)
+        {
+            f[atoms.box.constData()[i]].add( atoms.atom.constData()[i],
+                                             atom_forces.constData()[i] );
+        }
+    }
+    
+    return nrg;
+}
+
+/** Recalculate the energy of this forcefield. The reciprocal space sum
+    is global, so this is always recalculated from scratch */
+void PMEFF::recalculateEnergy()
+{
+    ffcomponents.setEnergy(*this, CoulombEnergy( this->calculate(0) ));
+    this->setClean();
+}
+
+/** Function called to add a molecule to this forcefield */
+void PMEFF::_pvt_added(const SireMol::PartialMolecule &mol, const SireBase::PropertyMap &map)
+{
+    cljgroup.add(mol, map);
+    this->setDirty();
+}
+
+/** Function called to remove a molecule from this forcefield */
+void PMEFF::_pvt_removed(const SireMol::PartialMolecule &mol)
+{
+    cljgroup.remove(mol);
+    this->setDirty();
+}
+
+/** Function called to indicate that the passed molecule has changed */
+void PMEFF::_pvt_changed(const Molecule &molecule, bool auto_update)
+{
+    cljgroup.update(molecule);
+    this->setDirty();
+}
+
+/** Function called to indicate that a list of molecules in this forcefield have changed */
+void PMEFF::_pvt_changed(const QList<SireMol::Molecule> &molecules, bool auto_update)
+{
+    foreach (const Molecule &molecule, molecules)
+    {
+        cljgroup.update(molecule);
+    }
+    
+    this->setDirty();
+}
+
+/** Function called to indicate that all molecules in this forcefield have been removed */
+void PMEFF::_pvt_removedAll()
+{
+    cljgroup.removeAll();
+    this->setDirty();
+}
+
+/** Function called to query whether or not a change in source properties would
+    change the properties needed by this forcefield for the molecule with number 'molnum' */
+bool PMEFF::_pvt_wouldChangeProperties(SireMol::MolNum molnum,
+                                       const SireBase::PropertyMap &map) const
+{
+    return cljgroup.mapForMolecule(molnum) != map;
+}
+
+/** Return whether or not this forcefield is using a temporary workspace that 
+    needs to be accepted */
+bool PMEFF::needsAccepting() const
+{
+    return cljgroup.needsAccepting() or G1FF::needsAccepting();
+}
+
+/** Tell the forcefield that the last move was accepted */
+void PMEFF::accept()
+{
+    if (cljgroup.needsAccepting())
+        cljgroup.accept();
+    
+    G1FF::accept();
+}
+
+/** Calculate the forces acting on the molecules in the passed forcetable  
+    and add them onto the forces present in the forcetable, optionally
+    scaled by 'scale_force' */
+void PMEFF::force(ForceTable &forcetable, double scale_force)
+{
+    if (scale_force == 0)
+        return;
+
+    QVector<CLJForces> forces;
+    
+    const double nrg = this->calculate(&forces);
+    
+    //we have the energy for free, so save it
+    ffcomponents.setEnergy(*this, CoulombEnergy(nrg));
+    this->setClean();
+    
+    cljgroup.addForces(forces, forcetable, scale_force);
+}
+
+/** Calculate the forces acting on the molecules in the passed forcetable
+    caused by the component of the energy represented by 'symbol', and 
+    add them onto the forces present in the forcetable, optionally 
+    scaled by 'scale_force'
+    
+    \throw SireFF::missing_component
+*/
+void PMEFF::force(ForceTable &forcetable, const Symbol &symbol, double scale_force)
+{
+    if (symbol == ffcomponents.total())
+        this->force(forcetable, scale_force);
+    else
+        throw SireFF::missing_component( QObject::tr(
+            "There is no forcefield component represented by %1 in the "
+            "forcefield %2. The only available component is %3.")
+                .arg(symbol.toString(), this->toString(),
+                     ffcomponents.total().toString()), CODELOC );
+}
+
+void PMEFF::field(FieldTable &fieldtable, double scale_field)
+{
+    throw SireError::incomplete_code( QObject::tr(
+                "The code to calculate the field of a PMEFF has not "
+                "been written."), CODELOC );
+}
+
+void PMEFF::field(FieldTable &fieldtable, const Symbol &component,
+                  double scale_field)
+{
+    throw SireError::incomplete_code( QObject::tr(
+                "The code to calculate the field of a PMEFF has not "
+                "been written."), CODELOC );
+}
+
+void PMEFF::potential(PotentialTable &potentialtable, double scale_potential)
+{
+    throw SireError::incomplete_code( QObject::tr(
+                "The code to calculate the potential of a PMEFF has not "
+                "been written."), CODELOC );
+}
+
+void PMEFF::potential(PotentialTable &potentialtable, const Symbol &component,
+                      double scale_potential)
+{
+    throw SireError::incomplete_code( QObject::tr(
+                "The code to calculate the potential of a PMEFF has not "
+                "been written."), CODELOC );
+}
+
+void PMEFF::field(FieldTable &fieldtable, const Probe &probe, double scale_field)
+{
+    throw SireError::incomplete_code( QObject::tr(
+                "The code to calculate the field of a PMEFF has not "
+                "been written."), CODELOC );
+}
+
+void PMEFF::field(FieldTable &fieldtable, const Symbol &component,
+                  const Probe &probe, double scale_field)
+{
+    throw SireError::incomplete_code( QObject::tr(
+                "The code to calculate the field of a PMEFF has not "
+                "been written."), CODELOC );
+}
+
+void PMEFF::potential(PotentialTable &potentialtable, const Probe &probe,
+                      double scale_potential)
+{
+    throw SireError::incomplete_code( QObject::tr(
+                "The code to calculate the potential of a PMEFF has not "
+                "been written."), CODELOC );
+}
+
+void PMEFF::potential(PotentialTable &potentialtable, const Symbol &component,
+                      const Probe &probe, double scale_potential)
+{
+    throw SireError::incomplete_code( QObject::tr(
+                "The code to calculate the potential of a PMEFF has not "
+                "been written."), CODELOC );
+}
@@ -0,0 +1,232 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#ifndef SIREMM_PMEFF_H
+#define SIREMM_PMEFF_H
+
+#include "cljgroup.h"
+#include "cljcomponent.h"
+
+#include "SireFF/g1ff.h"
+#include "SireFF/ff3d.h"
+
+#include "SireVol/space.h"
+
+#include "SireBase/properties.h"
+
+#include "SireUnits/dimensions.h"
+
+SIRE_BEGIN_HEADER
+
+namespace SireMM
+{
+class PMEFF;
+}
+
+QDataStream& operator<<(QDataStream&, const SireMM::PMEFF&);
+QDataStream& operator>>(QDataStream&, SireMM::PMEFF&);
+
+namespace SireMM
+{
+
+using SireBase::Property;
+using SireBase::Properties;
+
+using SireFF::ForceTable;
+using SireFF::FieldTable;
+using SireFF::PotentialTable;
+using SireFF::Probe;
+
+using SireCAS::Symbol;
+
+using SireVol::Space;
+using SireVol::SpacePtr;
+
+using SireUnits::Dimension::Length;
+
+/** This is a forcefield that calculates the reciprocal space part of
+    the Ewald sum for the electrostatic energy of all of the contained
+    molecules in a periodic box, using the smooth particle mesh Ewald
+    (SPME) method of Essmann et al. (J. Chem. Phys., 103, 8577, 1995).
+    
+    The charges are spread onto a grid using cardinal B-splines, the
+    grid is transformed using a built-in 3D FFT, and the forces are
+    gathered back from the grid. Both the spreading and gathering
+    are parallelised using TBB.
+    
+    The energy also includes the Ewald self-energy, the correction
+    for a system with a net charge, and removes the reciprocal space
+    interaction of atoms in the same molecule. This means that adding 
+    this forcefield to an InterFF that uses a CLJEwaldFunction with the 
+    same coulomb cutoff and Ewald tolerance gives the full Ewald 
+    intermolecular electrostatic energy. The intramolecular electrostatic
+    energy is left to the intramolecular forcefields, as before.
+    
+    @author Christopher Woods
+*/
+class SIREMM_EXPORT PMEFF : public SireBase::ConcreteProperty<PMEFF,SireFF::G1FF>,
+                            public SireFF::FF3D
+{
+
+friend QDataStream& ::operator<<(QDataStream&, const PMEFF&);
+friend QDataStream& ::operator>>(QDataStream&, PMEFF&);
+
+public:
+    PMEFF();
+    PMEFF(const QString &name);
+    
+    PMEFF(const PMEFF &other);
+    
+    ~PMEFF();
+    
+    static const char* typeName();
+    
+    const char* what() const;
+    
+    PMEFF& operator=(const PMEFF &other);
+    
+    bool operator==(const PMEFF &other) const;
+    bool operator!=(const PMEFF &other) const;
+
+    PMEFF* clone() const;
+
+    const CoulombComponent& components() const;
+
+    void setSpace(const Space &space);
+    const Space& space() const;
+
+    void setCoulombCutoff(Length cutoff);
+    Length coulombCutoff() const;
+    
+    void setEwaldTolerance(double tolerance);
+    double ewaldTolerance() const;
+
+    double beta() const;
+
+    void setGridSpacing(Length spacing);
+    Length gridSpacing() const;
+    
+    void setSplineOrder(int order);
+    int splineOrder() const;
+
+    bool setProperty(const QString &name, const Property &property);
+    const Property& property(const QString &name) const;
+    bool containsProperty(const QString &name) const;
+    const Properties& properties() const;
+
+    void mustNowRecalculateFromScratch();    
+
+    void accept();
+    bool needsAccepting() const;
+
+    void force(ForceTable &forcetable, double scale_force=1);
+
+    void force(ForceTable &forcetable, const Symbol &symbol,
+               double scale_force=1);
+
+    void field(FieldTable &fieldtable, double scale_field=1);
+
+    void field(FieldTable &fieldtable, const Symbol &component,
+               double scale_field=1);
+
+    void potential(PotentialTable &potentialtable, double scale_potential=1);
+
+    void potential(PotentialTable &potentialtable, const Symbol &component,
+                   double scale_potential=1);
+
+    void field(FieldTable &fieldtable, const Probe &probe, double scale_field=1);
+
+    void field(FieldTable &fieldtable, const Symbol &component,
+               const Probe &probe, double scale_field=1);
+
+    void potential(PotentialTable &potentialtable, const Probe &probe,
+                   double scale_potential=1);
+
+    void potential(PotentialTable &potentialtable, const Symbol &component,
+                   const Probe &probe, double scale_potential=1);
+
+protected:
+    void recalculateEnergy();
+    
+    void _pvt_added(const SireMol::PartialMolecule &mol,
+                    const SireBase::PropertyMap &map);
+
+    void _pvt_removed(const SireMol::PartialMolecule &mol);
+
+    void _pvt_changed(const SireMol::Molecule &molecule, bool auto_update);
+    void _pvt_changed(const QList<SireMol::Molecule> &molecules, bool auto_update);
+    
+    void _pvt_removedAll();
+        
+    bool _pvt_wouldChangeProperties(SireMol::MolNum molnum,
+                                    const SireBase::PropertyMap &map) const;
+
+    void _pvt_updateName();
+
+private:
+    double calculate(QVector<CLJForces> *forces);
+
+    void rebuildProps();
+
+    /** The CLJGroup containing all of the extracted molecules */
+    CLJGroup cljgroup;
+    
+    /** The energy component of this forcefield */
+    CoulombComponent ffcomponents;
+
+    /** The space (must be a PeriodicBox) */
+    SpacePtr spce;
+    
+    /** The real-space coulomb cutoff */
+    double coul_cutoff;
+    
+    /** The Ewald tolerance */
+    double ewald_tol;
+    
+    /** The Ewald splitting parameter (derived from the cutoff and tolerance) */
+    double ewald_beta;
+    
+    /** The target spacing of the PME grid */
+    double grid_spacing;
+    
+    /** The order of the B-splines used to spread the charges */
+    qint32 spline_order;
+
+    /** All of the properties of this forcefield */
+    Properties props;
+};
+
+}
+
+Q_DECLARE_METATYPE( SireMM::PMEFF )
+
+SIRE_EXPOSE_CLASS( SireMM::PMEFF )
+
+SIRE_END_HEADER
+
+#endif
@@ -0,0 +1,434 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#include <cmath>
+
+#include "counterrangenerator.h"
+#include "rangenerator.h"
+#include "vector.h"
+
+#include "SireStream/datastream.h"
+
+using namespace SireMaths;
+using namespace SireStream;
+
+static const RegisterMetaType<CounterRanGenerator> r_crangen(NO_ROOT);
+
+/** Serialise to a binary datastream */
+QDataStream SIREMATHS_EXPORT &operator<<(QDataStream &ds, const CounterRanGenerator &rangen)
+{
+    writeHeader(ds, r_crangen, 1);
+
+    ds << rangen.key << rangen.strm << rangen.pos;
+
+    return ds;
+}
+
+/** Extract from a binary datastream */
+QDataStream SIREMATHS_EXPORT &operator>>(QDataStream &ds, CounterRanGenerator &rangen)
+{
+    VersionID v = readHeader(ds, r_crangen);
+
+    if (v == 1)
+    {
+        ds >> rangen.key >> rangen.strm >> rangen.pos;
+        rangen.have_block = false;
+    }
+    else
+        throw version_error(v, "1", r_crangen, CODELOC);
+
+    return ds;
+}
+
+/** Construct a generator with a random seed (taken from the
+    global RanGenerator), using stream 0 */
+CounterRanGenerator::CounterRanGenerator()
+                    : key( RanGenerator::global().randInt64() ), strm(0), pos(0),
+                      have_block(false)
+{}
+
+/** Construct a generator using the passed seed and stream ID. Generators
+    with the same seed and stream will produce identical sequences */
+CounterRanGenerator::CounterRanGenerator(quint64 seed, quint64 stream)
+                    : key(seed), strm(stream), pos(0), have_block(false)
+{}
+
+/** Construct a generator whose seed is drawn from 'generator'. This
+    is reproducible if 'generator' was seeded, so is a convenient way
+    to create parallel streams in code that already uses a RanGenerator */
+CounterRanGenerator::CounterRanGenerator(const RanGenerator &generator)
+                    : key( generator.randInt64() ), strm(0), pos(0), have_block(false)
+{}
+
+/** Copy constructor */
+CounterRanGenerator::CounterRanGenerator(const CounterRanGenerator &other)
+                    : key(other.key), strm(other.strm), pos(other.pos),
+                      have_block(other.have_block)
+{
+    for (int i=0; i<4; ++i)
+    {
+        block[i] = other.block[i];
+    }
+}
+
+/** Destructor */
+CounterRanGenerator::~CounterRanGenerator()
+{}
+
+/** Copy assignment operator */
+CounterRanGenerator& CounterRanGenerator::operator=(const CounterRanGenerator &other)
+{
+    if (this != &other)
+    {
+        key = other.key;
+        strm = other.strm;
+        pos = other.pos;
+        have_block = other.have_block;
+
+        for (int i=0; i<4; ++i)
+        {
+            block[i] = other.block[i];
+        }
+    }
+
+    return *this;
+}
+
+/** Comparison operator - two generators are equal if they
+    will generate the same sequence of random numbers */
+bool CounterRanGenerator::operator==(const CounterRanGenerator &other) const
+{
+    return key == other.key and strm == other.strm and pos == other.pos;
+}
+
+/** Comparison operator */
+bool CounterRanGenerator::operator!=(const CounterRanGenerator &other) const
+{
+    return not CounterRanGenerator::operator==(other);
+}
+
+const char* CounterRanGenerator::typeName()
+{
+    return QMetaType::typeName( qMetaTypeId<CounterRanGenerator>() );
+}
+
+/** Return a string representation of this generator */
+QString CounterRanGenerator::toString() const
+{
+    return QObject::tr("CounterRanGenerator( seed = %1, stream = %2, counter = %3 )")
+                .arg(key).arg(strm).arg(pos);
+}
+
+/** Return the seed (key) used by this generator */
+quint64 CounterRanGenerator::seed() const
+{
+    return key;
+}
+
+/** Return the ID of the stream of random numbers produced by this generator */
+quint64 CounterRanGenerator::stream() const
+{
+    return strm;
+}
+
+/** Return the position of this generator in its stream, i.e. the
+    number of 32bit random numbers that have been consumed */
+quint64 CounterRanGenerator::counter() const
+{
+    return pos;
+}
+
+/** Return a generator that uses the same seed as this generator,
+    but which produces the independent stream of random numbers with
+    ID 'stream'. The substream starts at the beginning of its stream */
+CounterRanGenerator CounterRanGenerator::substream(quint64 stream) const
+{
+    return CounterRanGenerator(key, stream);
+}
+
+/** Move this generator to position 'counter' in its stream */
+void CounterRanGenerator::setCounter(quint64 counter)
+{
+    pos = counter;
+    have_block = false;
+}
+
+/** Skip the next 'n' 32bit random numbers in the stream. This
+    is an O(1) operation */
+void CounterRanGenerator::skip(quint64 n)
+{
+    if (n > 0)
+        this->setCounter(pos + n);
+}
+
+/** Multiply 'a' and 'b', returning the high 32 bits and placing
+    the low 32 bits in 'lo' */
+static inline quint32 mulhilo(quint32 a, quint32 b, quint32 &lo)
+{
+    const quint64 product = quint64(a) * quint64(b);
+    lo = quint32(product);
+    return quint32(product >> 32);
+}
+
+/** Generate the block of four random numbers at index 'blockidx'
+    in the stream, using ten rounds of the Philox4x32 bijection */
+void CounterRanGenerator::generateBlock(quint64 blockidx)
+{
+    static const quint32 PHILOX_M0 = 0xD2511F53;
+    static const quint32 PHILOX_M1 = 0xCD9E8D57;
+    static const quint32 PHILOX_W0 = 0x9E3779B9;
+    static const quint32 PHILOX_W1 = 0xBB67AE85;
+
+    quint32 c0 = quint32(blockidx);
+    quint32 c1 = quint32(blockidx >> 32);
+    quint32 c2 = quint32(strm);
+    quint32 c3 = quint32(strm >> 32);
+
+    quint32 k0 = quint32(key);
+    quint32 k1 = quint32(key >> 32);
+
+    for (int round=0; round<10; ++round)
+    {
+        if (round > 0)
+        {
+            k0 += PHILOX_W0;
+            k1 += PHILOX_W1;
+        }
+
+        quint32 lo0, lo1;
+        const quint32 hi0 = mulhilo(PHILOX_M0, c0, lo0);
+        const quint32 hi1 = mulhilo(PHILOX_M1, c2, lo1);
+
+        c0 = hi1 ^ c1 ^ k0;
+        c1 = lo1;
+        c2 = hi0 ^ c3 ^ k1;
+        c3 = lo0;
+    }
+
+    block[0] = c0;
+    block[1] = c1;
+    block[2] = c2;
+    block[3] = c3;
+}
+
+/** Return the next 32bit random number from the stream */
+inline quint32 CounterRanGenerator::next()
+{
+    const quint32 i = quint32(pos & 3);
+
+    if (i == 0 or not have_block)
+    {
+        generateBlock(pos >> 2);
+        have_block = true;
+    }
+
+    ++pos;
+
+    return block[i];
+}
+
+/** Return a random 32bit unsigned integer in [0,2^32 - 1] */
+quint32 CounterRanGenerator::randInt()
+{
+    return next();
+}
+
+/** Return a random 32bit unsigned integer in [0,maxval] */
+quint32 CounterRanGenerator::randInt(quint32 maxval)
+{
+    //use the same algorithm as in MersenneTwister.h
+    quint32 used = maxval;
+    used |= used >> 1;
+    used |= used >> 2;
+    used |= used >> 4;
+    used |= used >> 8;
+    used |= used >> 16;
+
+    quint32 i;
+
+    do
+    {
+        i = next() & used;
+    } while (i > maxval);
+
+    return i;
+}
+
+/** Return a random 32bit integer in [minval,maxval] */
+qint32 CounterRanGenerator::randInt(qint32 minval, qint32 maxval)
+{
+    if (maxval == minval)
+        return maxval;
+    else if (maxval < minval)
+        qSwap(minval,maxval);
+
+    return minval + randInt( quint32(maxval-minval) );
+}
+
+/** Return a random 64bit unsigned integer on [0,2^64 - 1] */
+quint64 CounterRanGenerator::randInt64()
+{
+    quint64 ran0 = next();
+    quint64 ran1 = next();
+
+    return (ran0 << 32) | ran1;
+}
+
+/** Return a random true or false value */
+bool CounterRanGenerator::randBool()
+{
+    return next() & 0x0001;
+}
+
+/** Return a random real number on [0,1] */
+double CounterRanGenerator::rand()
+{
+    return double(next()) * (1.0 / 4294967295.0);
+}
+
+/** Return a random real number on [0,maxval] */
+double CounterRanGenerator::rand(double maxval)
+{
+    return maxval * rand();
+}
+
+/** Return a random real number on [minval,maxval] */
+double CounterRanGenerator::rand(double minval, double maxval)
+{
+    return minval + rand() * (maxval-minval);
+}
+
+/** Return a high-precision random real number on [0,1) */
+double CounterRanGenerator::rand53()
+{
+    const quint32 a = next() >> 5;
+    const quint32 b = next() >> 6;
+
+    return (a * 67108864.0 + b) * (1.0 / 9007199254740992.0);
+}
+
+/** Return a high-precision random real number on [0,maxval) */
+double CounterRanGenerator::rand53(double maxval)
+{
+    return maxval * rand53();
+}
+
+/** Return a high-precision random real number on [minval,maxval) */
+double CounterRanGenerator::rand53(double minval, double maxval)
+{
+    return minval + rand53()*(maxval-minval);
+}
+
+/** Return a high-precision random number from the normal distribution
+    with supplied mean and variance (this uses the same convention as
+    RanGenerator::randNorm, namely that 'variance' scales the
+    unit normal) */
+double CounterRanGenerator::randNorm(double mean, double variance)
+{
+    //Box-Muller - 1-rand53() is on (0,1], so the log is finite
+    const double r = std::sqrt( -2.0 * std::log(1.0 - rand53()) ) * variance;
+    const double phi = 2.0 * 3.14159265358979323846264338328 * rand53();
+
+    return mean + r * std::cos(phi);
+}
+
+/** Return a random vector on the unit sphere */
+Vector CounterRanGenerator::vectorOnSphere()
+{
+    while (true)
+    {
+        //use von Neumann acceptance/rejection method
+        Vector v( 1.0 - 2.0 * rand53(),
+                  1.0 - 2.0 * rand53(),
+                  1.0 - 2.0 * rand53() );
+
+        double lgth2 = v.length2();
+
+        if (lgth2 < 1 and lgth2 > 0)
+        {
+            v /= std::sqrt(lgth2);
+            return v;
+        }
+    }
+}
+
+/** Return a random vector on the sphere with radius 'radius' */
+Vector CounterRanGenerator::vectorOnSphere(double radius)
+{
+    return radius * this->vectorOnSphere();
+}
+
+/** Fill 'values' with random numbers on [0,1]. This gives
+    exactly the same numbers as calling rand() values.count() times */
+void CounterRanGenerator::fill(QVector<double> &values)
+{
+    const int n = values.count();
+    double *v = values.data();
+
+    for (int i=0; i<n; ++i)
+    {
+        v[i] = double(next()) * (1.0 / 4294967295.0);
+    }
+}
+
+/** Fill 'values' with random numbers on [minval,maxval]. This gives
+    exactly the same numbers as calling rand(minval,maxval)
+    values.count() times */
+void CounterRanGenerator::fill(QVector<double> &values, double minval, double maxval)
+{
+    const int n = values.count();
+    double *v = values.data();
+
+    const double scale = (maxval - minval) * (1.0 / 4294967295.0);
+
+    for (int i=0; i<n; ++i)
+    {
+        v[i] = minval + double(next()) * scale;
+    }
+}
+
+/** Fill 'values' with random numbers drawn from the normal distribution
+    with mean 'mean' and variance 'variance'. This uses both of the numbers
+    generated by each Box-Muller transform, so is twice as fast as
+    calling randNorm() for each value (but gives a different sequence) */
+void CounterRanGenerator::fillNorm(QVector<double> &values, double mean, double variance)
+{
+    const int n = values.count();
+    double *v = values.data();
+
+    for (int i=0; i<n; i+=2)
+    {
+        const double r = std::sqrt( -2.0 * std::log(1.0 - rand53()) ) * variance;
+        const double phi = 2.0 * 3.14159265358979323846264338328 * rand53();
+
+        v[i] = mean + r * std::cos(phi);
+
+        if (i+1 < n)
+            v[i+1] = mean + r * std::sin(phi);
+    }
+}
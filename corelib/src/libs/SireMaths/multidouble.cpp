@@ -36,6 +36,25 @@
 
 using namespace SireMaths;
 
+#ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+    static inline bool isAligned64(const void *pointer)
+    {
+        return (quintptr)pointer % size_t(64) == 0;
+    }
+
+    static void assertAligned64(const void *pointer, QString place)
+    {
+        if (not isAligned64(pointer))
+            throw SireError::program_bug( QObject::tr(
+                    "An unaligned MultiDouble has been created! %1")
+                        .arg((quintptr)pointer % size_t(64)), place );
+    }
+
+    static inline bool isAligned32(const void *pointer)
+    {
+        return (quintptr)pointer % size_t(32) == 0;
+    }
+#else
 #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
     static inline bool isAligned32(const void *pointer)
     {
@@ -78,6 +97,7 @@ using namespace SireMaths;
     }
 #endif
 #endif
+#endif
 
 void MultiDouble::assertAligned(const void *ptr, size_t size)
 {
@@ -94,6 +114,9 @@ void MultiDouble::assertAligned(const void *ptr, size_t size)
     this vector will be padded with zeroes */
 MultiDouble::MultiDouble(const double *array, int size)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        assertAligned64(this, CODELOC);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         assertAligned32(this, CODELOC);
     #else
@@ -103,6 +126,7 @@ MultiDouble::MultiDouble(const double *array, int size)
         assertAligned32(this, CODELOC);
     #endif
     #endif
+    #endif
 
     if (size > MULTIFLOAT_SIZE)
         throw SireError::unsupported( QObject::tr(
@@ -111,6 +135,10 @@ MultiDouble::MultiDouble(const double *array, int size)
 
     if (size <= 0)
     {
+        #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+            v.x[0] = _mm512_set1_pd(0);
+            v.x[1] = _mm512_set1_pd(0);
+        #else
         #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
             v.x[0] = _mm256_set1_pd(0);
             v.x[1] = _mm256_set1_pd(0);
@@ -125,9 +153,14 @@ MultiDouble::MultiDouble(const double *array, int size)
             }
         #endif
         #endif
+        #endif
     }
     else if (size == MULTIFLOAT_SIZE)
     {
+        #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+            v.x[0] = _mm512_loadu_pd(array);
+            v.x[1] = _mm512_loadu_pd(array+8);
+        #else
         #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
             v.x[0] = _mm256_set_pd(array[3], array[2], array[1], array[0]);
             v.x[1] = _mm256_set_pd(array[7], array[6], array[5], array[4]);
@@ -143,6 +176,7 @@ MultiDouble::MultiDouble(const double *array, int size)
             }
         #endif
         #endif
+        #endif
     }
     else
     {
@@ -158,6 +192,10 @@ MultiDouble::MultiDouble(const double *array, int size)
             tmp[i] = 0;
         }
         
+        #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+            v.x[0] = _mm512_loadu_pd(tmp);
+            v.x[1] = _mm512_loadu_pd(tmp+8);
+        #else
         #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
             v.x[0] = _mm256_set_pd(tmp[3], tmp[2], tmp[1], tmp[0]);
             v.x[1] = _mm256_set_pd(tmp[7], tmp[6], tmp[5], tmp[4]);
@@ -173,12 +211,16 @@ MultiDouble::MultiDouble(const double *array, int size)
             }
         #endif
         #endif
+        #endif
     }
 }
 
 /** Construct from the passed array - this must be the same size as the vector */
 MultiDouble::MultiDouble(const QVector<float> &array)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        assertAligned64(this, CODELOC);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         assertAligned32(this, CODELOC);
     #else
@@ -188,6 +230,7 @@ MultiDouble::MultiDouble(const QVector<float> &array)
         assertAligned32(this, CODELOC);
     #endif
     #endif
+    #endif
 
     QVector<double> darray;
     darray.reserve(array.count());
@@ -203,6 +246,9 @@ MultiDouble::MultiDouble(const QVector<float> &array)
 /** Construct from the passed array - this must be the same size as the vector */
 MultiDouble::MultiDouble(const QVector<double> &array)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        assertAligned64(this, CODELOC);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         assertAligned32(this, CODELOC);
     #else
@@ -212,6 +258,7 @@ MultiDouble::MultiDouble(const QVector<double> &array)
         assertAligned32(this, CODELOC);
     #endif
     #endif
+    #endif
 
     this->operator=( MultiDouble(array.constData(), array.size()) );
 }
@@ -220,6 +267,9 @@ MultiDouble::MultiDouble(const QVector<double> &array)
     then any SSE/AVX operations will fail */
 bool MultiDouble::isAligned() const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return isAligned64(this);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return isAligned32(this);
     #else
@@ -229,6 +279,7 @@ bool MultiDouble::isAligned() const
         return true;
     #endif
     #endif
+    #endif
 }
 
 QVector<MultiDouble> MultiDouble::fromArray(const double *array, int size)
@@ -327,6 +378,9 @@ QVector<MultiDouble> MultiDouble::fromArray(const double *array, int size)
         }
     #endif
 
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        assertAligned64(marray.constData(), CODELOC);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         assertAligned32(marray.constData(), CODELOC);
     #else
@@ -336,6 +390,7 @@ QVector<MultiDouble> MultiDouble::fromArray(const double *array, int size)
         assertAligned32(marray.constData(), CODELOC);
     #endif
     #endif
+    #endif
     
     return marray;
 }
@@ -388,6 +443,9 @@ QVector<MultiDouble> MultiDouble::fromArray(const float *array, int size)
         a[marray.count()-1] = MultiDouble((double*)(&tmp), nremain);
     }
     
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        assertAligned64(marray.constData(), CODELOC);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         assertAligned32(marray.constData(), CODELOC);
     #else
@@ -397,6 +455,7 @@ QVector<MultiDouble> MultiDouble::fromArray(const float *array, int size)
         assertAligned32(marray.constData(), CODELOC);
     #endif
     #endif
+    #endif
 
     return marray;
 }
@@ -35,10 +35,12 @@ SIRE_BEGIN_HEADER
 
 namespace SireMaths
 {
+SIRE_BEGIN_KERNEL_ISA
 
 /** This class provides a vectorised double. This represents
     two vectors of doubles on the compiled machine, e.g.
-    4 doubles if we use SSE2, 8 doubles for AVX. This
+    4 doubles if we use SSE2, 8 doubles for AVX and 16 doubles
+    for AVX-512. This
     is so that it matches up with MultiFloat, with both
     vectors providing the same number of elements.
     
@@ -167,6 +169,27 @@ private:
             void assertAligned(){}
         #endif
 
+        #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+            _ALIGNED(64) union
+            {
+                __m512d x[2];
+                double a[16];
+            } v;
+
+            MultiDouble(__m512d avx_val0, __m512d avx_val1)
+            {
+                v.x[0] = avx_val0;
+                v.x[1] = avx_val1;
+            }
+
+            #ifdef MULTIFLOAT_CHECK_ALIGNMENT
+                void assertAligned()
+                {
+                    if ((quintptr)this % 64 != 0)
+                        assertAligned(this, 64);
+                }
+            #endif
+        #else
         #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
             _ALIGNED(32) union
             {
@@ -230,6 +253,7 @@ private:
             #endif
         #endif
         #endif
+        #endif
     #endif // #ifndef SIRE_SKIP_INLINE_FUNCTIONS
 };
 
@@ -250,6 +274,10 @@ MultiDouble::MultiDouble(double val)
 {
     assertAligned();
 
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x[0] = _mm512_set1_pd(val);
+        v.x[1] = _mm512_set1_pd(val);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         v.x[0] = _mm256_set1_pd(val);
         v.x[1] = _mm256_set1_pd(val);
@@ -264,6 +292,7 @@ MultiDouble::MultiDouble(double val)
         }
     #endif
     #endif
+    #endif
 }
 
 /** Copy construct from a MultiFloat */
@@ -272,6 +301,12 @@ MultiDouble::MultiDouble(const MultiFloat &other)
 {
     assertAligned();
 
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        const __m256 *o = (const __m256*)&(other.v.x);
+
+        v.x[0] = _mm512_cvtps_pd( o[0] );
+        v.x[1] = _mm512_cvtps_pd( o[1] );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         const __m128 *o = (const __m128*)&(other.v.x);
     
@@ -288,6 +323,7 @@ MultiDouble::MultiDouble(const MultiFloat &other)
         }
     #endif
     #endif
+    #endif
 }
 
 /** Copy construct from a MultiDouble */
@@ -296,6 +332,12 @@ MultiFloat::MultiFloat(const MultiDouble &other)
 {
     assertAligned();
 
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        __m256 *o = (__m256*)&(v.x);
+
+        o[0] = _mm512_cvtpd_ps(other.v.x[0]);
+        o[1] = _mm512_cvtpd_ps(other.v.x[1]);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         __m128 *o = (__m128*)&(v.x);
     
@@ -312,6 +354,7 @@ MultiFloat::MultiFloat(const MultiDouble &other)
         }
     #endif
     #endif
+    #endif
 }
 
 /** Copy constructor */
@@ -320,6 +363,10 @@ MultiDouble::MultiDouble(const MultiDouble &other)
 {
     assertAligned();
 
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x[0] = other.v.x[0];
+        v.x[1] = other.v.x[1];
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         v.x[0] = other.v.x[0];
         v.x[1] = other.v.x[1];
@@ -334,6 +381,7 @@ MultiDouble::MultiDouble(const MultiDouble &other)
         }
     #endif
     #endif
+    #endif
 }
 
 /** Destructor */
@@ -354,6 +402,10 @@ MultiDouble& MultiDouble::operator=(const MultiDouble &other)
 {
     if (this != &other)
     {
+        #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+            v.x[0] = other.v.x[0];
+            v.x[1] = other.v.x[1];
+        #else
         #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
             v.x[0] = other.v.x[0];
             v.x[1] = other.v.x[1];
@@ -368,6 +420,7 @@ MultiDouble& MultiDouble::operator=(const MultiDouble &other)
             }
         #endif
         #endif
+        #endif
     }
     
     return *this;
@@ -377,6 +430,12 @@ MultiDouble& MultiDouble::operator=(const MultiDouble &other)
 inline
 MultiFloat& MultiFloat::operator=(const MultiDouble &other)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        __m256 *o = (__m256*)&(v.x);
+
+        o[0] = _mm512_cvtpd_ps(other.v.x[0]);
+        o[1] = _mm512_cvtpd_ps(other.v.x[1]);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         __m128 *o = (__m128*)&(v.x);
     
@@ -393,6 +452,7 @@ MultiFloat& MultiFloat::operator=(const MultiDouble &other)
         }
     #endif
     #endif
+    #endif
 
     return *this;
 }
@@ -401,6 +461,10 @@ MultiFloat& MultiFloat::operator=(const MultiDouble &other)
 inline
 MultiDouble& MultiDouble::operator=(double value)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x[0] = _mm512_set1_pd(value);
+        v.x[1] = _mm512_set1_pd(value);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         v.x[0] = _mm256_set1_pd(value);
         v.x[1] = _mm256_set1_pd(value);
@@ -415,6 +479,7 @@ MultiDouble& MultiDouble::operator=(double value)
         }
     #endif
     #endif
+    #endif
     
     return *this;
 }
@@ -423,6 +488,12 @@ MultiDouble& MultiDouble::operator=(double value)
 inline
 MultiDouble& MultiDouble::operator=(const MultiFloat &other)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        const __m256 *o = (const __m256*)&(other.v.x);
+
+        v.x[0] = _mm512_cvtps_pd( o[0] );
+        v.x[1] = _mm512_cvtps_pd( o[1] );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         const __m128 *o = (const __m128*)&(other.v.x);
     
@@ -439,6 +510,7 @@ MultiDouble& MultiDouble::operator=(const MultiFloat &other)
         }
     #endif
     #endif
+    #endif
 
     return *this;
 }
@@ -448,6 +520,13 @@ MultiDouble& MultiDouble::operator=(const MultiFloat &other)
 inline
 MultiDouble MultiDouble::compareEqual(const MultiDouble &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiDouble(
+                _mm512_castsi512_pd( _mm512_maskz_set1_epi64(_mm512_cmp_pd_mask(v.x[0],
+                                                                                other.v.x[0], _CMP_EQ_OQ), -1) ),
+                _mm512_castsi512_pd( _mm512_maskz_set1_epi64(_mm512_cmp_pd_mask(v.x[1],
+                                                                                other.v.x[1], _CMP_EQ_OQ), -1) ) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiDouble( _mm256_cmp_pd(v.x[0], other.v.x[0], _CMP_EQ_OQ),
                             _mm256_cmp_pd(v.x[1], other.v.x[1], _CMP_EQ_OQ) );
@@ -466,12 +545,20 @@ MultiDouble MultiDouble::compareEqual(const MultiDouble &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Not equals comparison operator */
 inline
 MultiDouble MultiDouble::compareNotEqual(const MultiDouble &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiDouble(
+                _mm512_castsi512_pd( _mm512_maskz_set1_epi64(_mm512_cmp_pd_mask(v.x[0],
+                                                                                other.v.x[0], _CMP_NEQ_OQ), -1) ),
+                _mm512_castsi512_pd( _mm512_maskz_set1_epi64(_mm512_cmp_pd_mask(v.x[1],
+                                                                                other.v.x[1], _CMP_NEQ_OQ), -1) ) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiDouble( _mm256_cmp_pd(v.x[0], other.v.x[0], _CMP_NEQ_OQ),
                             _mm256_cmp_pd(v.x[1], other.v.x[1], _CMP_NEQ_OQ) );
@@ -490,12 +577,20 @@ MultiDouble MultiDouble::compareNotEqual(const MultiDouble &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Less than comparison operator */
 inline
 MultiDouble MultiDouble::compareLess(const MultiDouble &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiDouble(
+                _mm512_castsi512_pd( _mm512_maskz_set1_epi64(_mm512_cmp_pd_mask(v.x[0],
+                                                                                other.v.x[0], _CMP_LT_OQ), -1) ),
+                _mm512_castsi512_pd( _mm512_maskz_set1_epi64(_mm512_cmp_pd_mask(v.x[1],
+                                                                                other.v.x[1], _CMP_LT_OQ), -1) ) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiDouble( _mm256_cmp_pd(v.x[0], other.v.x[0], _CMP_LT_OQ),
                             _mm256_cmp_pd(v.x[1], other.v.x[1], _CMP_LT_OQ) );
@@ -514,12 +609,20 @@ MultiDouble MultiDouble::compareLess(const MultiDouble &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Greater than comparison operator */
 inline
 MultiDouble MultiDouble::compareGreater(const MultiDouble &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiDouble(
+                _mm512_castsi512_pd( _mm512_maskz_set1_epi64(_mm512_cmp_pd_mask(v.x[0],
+                                                                                other.v.x[0], _CMP_GT_OQ), -1) ),
+                _mm512_castsi512_pd( _mm512_maskz_set1_epi64(_mm512_cmp_pd_mask(v.x[1],
+                                                                                other.v.x[1], _CMP_GT_OQ), -1) ) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiDouble( _mm256_cmp_pd(v.x[0], other.v.x[0], _CMP_GT_OQ),
                             _mm256_cmp_pd(v.x[1], other.v.x[1], _CMP_GT_OQ) );
@@ -538,12 +641,20 @@ MultiDouble MultiDouble::compareGreater(const MultiDouble &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Less than or equal comparison */
 inline
 MultiDouble MultiDouble::compareLessEqual(const MultiDouble &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiDouble(
+                _mm512_castsi512_pd( _mm512_maskz_set1_epi64(_mm512_cmp_pd_mask(v.x[0],
+                                                                                other.v.x[0], _CMP_LE_OQ), -1) ),
+                _mm512_castsi512_pd( _mm512_maskz_set1_epi64(_mm512_cmp_pd_mask(v.x[1],
+                                                                                other.v.x[1], _CMP_LE_OQ), -1) ) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiDouble( _mm256_cmp_pd(v.x[0], other.v.x[0], _CMP_LE_OQ),
                             _mm256_cmp_pd(v.x[1], other.v.x[1], _CMP_LE_OQ) );
@@ -562,12 +673,20 @@ MultiDouble MultiDouble::compareLessEqual(const MultiDouble &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Greater than or equal comparison */
 inline
 MultiDouble MultiDouble::compareGreaterEqual(const MultiDouble &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiDouble(
+                _mm512_castsi512_pd( _mm512_maskz_set1_epi64(_mm512_cmp_pd_mask(v.x[0],
+                                                                                other.v.x[0], _CMP_GE_OQ), -1) ),
+                _mm512_castsi512_pd( _mm512_maskz_set1_epi64(_mm512_cmp_pd_mask(v.x[1],
+                                                                                other.v.x[1], _CMP_GE_OQ), -1) ) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiDouble( _mm256_cmp_pd(v.x[0], other.v.x[0], _CMP_GE_OQ),
                             _mm256_cmp_pd(v.x[1], other.v.x[1], _CMP_GE_OQ) );
@@ -586,6 +705,7 @@ MultiDouble MultiDouble::compareGreaterEqual(const MultiDouble &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Return the number of values in the vector */
@@ -606,6 +726,10 @@ int MultiDouble::count()
 inline
 MultiDouble MultiDouble::operator+(const MultiDouble &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiDouble( _mm512_add_pd(v.x[0], other.v.x[0]),
+                            _mm512_add_pd(v.x[1], other.v.x[1]) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiDouble( _mm256_add_pd(v.x[0], other.v.x[0]),
                             _mm256_add_pd(v.x[1], other.v.x[1]) );
@@ -622,12 +746,17 @@ MultiDouble MultiDouble::operator+(const MultiDouble &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Subtraction operator */
 inline
 MultiDouble MultiDouble::operator-(const MultiDouble &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiDouble( _mm512_sub_pd(v.x[0], other.v.x[0]),
+                            _mm512_sub_pd(v.x[1], other.v.x[1]) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiDouble( _mm256_sub_pd(v.x[0], other.v.x[0]),
                             _mm256_sub_pd(v.x[1], other.v.x[1]) );
@@ -644,12 +773,17 @@ MultiDouble MultiDouble::operator-(const MultiDouble &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Multiplication operator */
 inline
 MultiDouble MultiDouble::operator*(const MultiDouble &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiDouble( _mm512_mul_pd(v.x[0], other.v.x[0]),
+                            _mm512_mul_pd(v.x[1], other.v.x[1]) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiDouble( _mm256_mul_pd(v.x[0], other.v.x[0]),
                             _mm256_mul_pd(v.x[1], other.v.x[1]) );
@@ -666,12 +800,17 @@ MultiDouble MultiDouble::operator*(const MultiDouble &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Division operator */
 inline
 MultiDouble MultiDouble::operator/(const MultiDouble &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiDouble( _mm512_div_pd(v.x[0], other.v.x[0]),
+                            _mm512_div_pd(v.x[1], other.v.x[1]) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiDouble( _mm256_div_pd(v.x[0], other.v.x[0]),
                             _mm256_div_pd(v.x[1], other.v.x[1]) );
@@ -688,12 +827,17 @@ MultiDouble MultiDouble::operator/(const MultiDouble &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** In-place addition operator */
 inline
 MultiDouble& MultiDouble::operator+=(const MultiDouble &other)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x[0] = _mm512_add_pd(v.x[0], other.v.x[0]);
+        v.x[1] = _mm512_add_pd(v.x[1], other.v.x[1]);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         v.x[0] = _mm256_add_pd(v.x[0], other.v.x[0]);
         v.x[1] = _mm256_add_pd(v.x[1], other.v.x[1]);
@@ -708,6 +852,7 @@ MultiDouble& MultiDouble::operator+=(const MultiDouble &other)
         }
     #endif
     #endif
+    #endif
 
     return *this;
 }
@@ -716,6 +861,10 @@ MultiDouble& MultiDouble::operator+=(const MultiDouble &other)
 inline
 MultiDouble& MultiDouble::operator-=(const MultiDouble &other)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x[0] = _mm512_sub_pd(v.x[0], other.v.x[0]);
+        v.x[1] = _mm512_sub_pd(v.x[1], other.v.x[1]);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         v.x[0] = _mm256_sub_pd(v.x[0], other.v.x[0]);
         v.x[1] = _mm256_sub_pd(v.x[1], other.v.x[1]);
@@ -730,6 +879,7 @@ MultiDouble& MultiDouble::operator-=(const MultiDouble &other)
         }
     #endif
     #endif
+    #endif
 
     return *this;
 }
@@ -738,6 +888,10 @@ MultiDouble& MultiDouble::operator-=(const MultiDouble &other)
 inline
 MultiDouble& MultiDouble::operator*=(const MultiDouble &other)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x[0] = _mm512_mul_pd(v.x[0], other.v.x[0]);
+        v.x[1] = _mm512_mul_pd(v.x[1], other.v.x[1]);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         v.x[0] = _mm256_mul_pd(v.x[0], other.v.x[0]);
         v.x[1] = _mm256_mul_pd(v.x[1], other.v.x[1]);
@@ -752,6 +906,7 @@ MultiDouble& MultiDouble::operator*=(const MultiDouble &other)
         }
     #endif
     #endif
+    #endif
 
     return *this;
 }
@@ -760,6 +915,10 @@ MultiDouble& MultiDouble::operator*=(const MultiDouble &other)
 inline
 MultiDouble& MultiDouble::operator/=(const MultiDouble &other)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x[0] = _mm512_div_pd(v.x[0], other.v.x[0]);
+        v.x[1] = _mm512_div_pd(v.x[1], other.v.x[1]);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         v.x[0] = _mm256_div_pd(v.x[0], other.v.x[0]);
         v.x[1] = _mm256_div_pd(v.x[1], other.v.x[1]);
@@ -774,6 +933,7 @@ MultiDouble& MultiDouble::operator/=(const MultiDouble &other)
         }
     #endif
     #endif
+    #endif
 
     return *this;
 }
@@ -782,6 +942,13 @@ MultiDouble& MultiDouble::operator/=(const MultiDouble &other)
 inline
 MultiDouble MultiDouble::logicalAnd(const MultiDouble &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiDouble(
+                _mm512_castsi512_pd( _mm512_and_si512(_mm512_castpd_si512(v.x[0]),
+                                                      _mm512_castpd_si512(other.v.x[0])) ),
+                _mm512_castsi512_pd( _mm512_and_si512(_mm512_castpd_si512(v.x[1]),
+                                                      _mm512_castpd_si512(other.v.x[1])) ) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiDouble( _mm256_and_pd(v.x[0], other.v.x[0]),
                             _mm256_and_pd(v.x[1], other.v.x[1]) );
@@ -808,12 +975,20 @@ MultiDouble MultiDouble::logicalAnd(const MultiDouble &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Bitwise logical "and not" */
 inline
 MultiDouble MultiDouble::logicalAndNot(const MultiDouble &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiDouble(
+                _mm512_castsi512_pd( _mm512_andnot_si512(_mm512_castpd_si512(v.x[0]),
+                                                         _mm512_castpd_si512(other.v.x[0])) ),
+                _mm512_castsi512_pd( _mm512_andnot_si512(_mm512_castpd_si512(v.x[1]),
+                                                         _mm512_castpd_si512(other.v.x[1])) ) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiDouble( _mm256_andnot_pd(v.x[0], other.v.x[0]),
                             _mm256_andnot_pd(v.x[1], other.v.x[1]) );
@@ -840,12 +1015,20 @@ MultiDouble MultiDouble::logicalAndNot(const MultiDouble &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Bitwise logical or operator */
 inline
 MultiDouble MultiDouble::logicalOr(const MultiDouble &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiDouble(
+                _mm512_castsi512_pd( _mm512_or_si512(_mm512_castpd_si512(v.x[0]),
+                                                     _mm512_castpd_si512(other.v.x[0])) ),
+                _mm512_castsi512_pd( _mm512_or_si512(_mm512_castpd_si512(v.x[1]),
+                                                     _mm512_castpd_si512(other.v.x[1])) ) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiDouble( _mm256_or_pd(v.x[0], other.v.x[0]),
                             _mm256_or_pd(v.x[1], other.v.x[1]) );
@@ -872,12 +1055,20 @@ MultiDouble MultiDouble::logicalOr(const MultiDouble &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Bitwise logical xor */
 inline
 MultiDouble MultiDouble::logicalXor(const MultiDouble &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiDouble(
+                _mm512_castsi512_pd( _mm512_xor_si512(_mm512_castpd_si512(v.x[0]),
+                                                      _mm512_castpd_si512(other.v.x[0])) ),
+                _mm512_castsi512_pd( _mm512_xor_si512(_mm512_castpd_si512(v.x[1]),
+                                                      _mm512_castpd_si512(other.v.x[1])) ) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiDouble( _mm256_xor_pd(v.x[0], other.v.x[0]),
                             _mm256_xor_pd(v.x[1], other.v.x[1]) );
@@ -904,6 +1095,7 @@ MultiDouble MultiDouble::logicalXor(const MultiDouble &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Logical not operator */
@@ -958,6 +1150,12 @@ MultiDouble MultiDouble::operator^(const MultiDouble &other) const
 inline
 MultiDouble& MultiDouble::operator&=(const MultiDouble &other)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x[0] = _mm512_castsi512_pd( _mm512_and_si512(_mm512_castpd_si512(v.x[0]),
+                                                       _mm512_castpd_si512(other.v.x[0])) );
+        v.x[1] = _mm512_castsi512_pd( _mm512_and_si512(_mm512_castpd_si512(v.x[1]),
+                                                       _mm512_castpd_si512(other.v.x[1])) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         v.x[0] = _mm256_and_pd(v.x[0], other.v.x[0]);
         v.x[1] = _mm256_and_pd(v.x[1], other.v.x[1]);
@@ -979,6 +1177,7 @@ MultiDouble& MultiDouble::operator&=(const MultiDouble &other)
         }
     #endif
     #endif
+    #endif
 
     return *this;
 }
@@ -987,6 +1186,12 @@ MultiDouble& MultiDouble::operator&=(const MultiDouble &other)
 inline
 MultiDouble& MultiDouble::operator|=(const MultiDouble &other)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x[0] = _mm512_castsi512_pd( _mm512_or_si512(_mm512_castpd_si512(v.x[0]),
+                                                      _mm512_castpd_si512(other.v.x[0])) );
+        v.x[1] = _mm512_castsi512_pd( _mm512_or_si512(_mm512_castpd_si512(v.x[1]),
+                                                      _mm512_castpd_si512(other.v.x[1])) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         v.x[0] = _mm256_or_pd(v.x[0], other.v.x[0]);
         v.x[1] = _mm256_or_pd(v.x[1], other.v.x[1]);
@@ -1008,6 +1213,7 @@ MultiDouble& MultiDouble::operator|=(const MultiDouble &other)
         }
     #endif
     #endif
+    #endif
 
     return *this;
 }
@@ -1016,6 +1222,12 @@ MultiDouble& MultiDouble::operator|=(const MultiDouble &other)
 inline
 MultiDouble& MultiDouble::operator^=(const MultiDouble &other)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x[0] = _mm512_castsi512_pd( _mm512_xor_si512(_mm512_castpd_si512(v.x[0]),
+                                                       _mm512_castpd_si512(other.v.x[0])) );
+        v.x[1] = _mm512_castsi512_pd( _mm512_xor_si512(_mm512_castpd_si512(v.x[1]),
+                                                       _mm512_castpd_si512(other.v.x[1])) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         v.x[0] = _mm256_xor_pd(v.x[0], other.v.x[0]);
         v.x[1] = _mm256_xor_pd(v.x[1], other.v.x[1]);
@@ -1037,6 +1249,7 @@ MultiDouble& MultiDouble::operator^=(const MultiDouble &other)
         }
     #endif
     #endif
+    #endif
 
     return *this;
 }
@@ -1045,6 +1258,10 @@ MultiDouble& MultiDouble::operator^=(const MultiDouble &other)
 inline
 MultiDouble& MultiDouble::multiplyAdd(const MultiDouble &v0, const MultiDouble &v1)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x[0] = _mm512_fmadd_pd(v0.v.x[0], v1.v.x[0], v.x[0]);
+        v.x[1] = _mm512_fmadd_pd(v0.v.x[1], v1.v.x[1], v.x[1]);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         v.x[0] = _mm256_add_pd(v.x[0], _mm256_mul_pd(v0.v.x[0], v1.v.x[0]));
         v.x[1] = _mm256_add_pd(v.x[1], _mm256_mul_pd(v0.v.x[1], v1.v.x[1]));
@@ -1059,6 +1276,7 @@ MultiDouble& MultiDouble::multiplyAdd(const MultiDouble &v0, const MultiDouble &
         }
     #endif
     #endif
+    #endif
 
     return *this;
 }
@@ -1067,6 +1285,10 @@ MultiDouble& MultiDouble::multiplyAdd(const MultiDouble &v0, const MultiDouble &
 inline
 MultiDouble MultiDouble::max(const MultiDouble &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiDouble( _mm512_max_pd(v.x[0], other.v.x[0]),
+                            _mm512_max_pd(v.x[1], other.v.x[1]) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiDouble( _mm256_max_pd(v.x[0], other.v.x[0]),
                             _mm256_max_pd(v.x[1], other.v.x[1]) );
@@ -1083,12 +1305,17 @@ MultiDouble MultiDouble::max(const MultiDouble &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Return the minimum vector between this and other */
 inline
 MultiDouble MultiDouble::min(const MultiDouble &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiDouble( _mm512_min_pd(v.x[0], other.v.x[0]),
+                            _mm512_min_pd(v.x[1], other.v.x[1]) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiDouble( _mm256_min_pd(v.x[0], other.v.x[0]),
                             _mm256_min_pd(v.x[1], other.v.x[1]) );
@@ -1105,6 +1332,7 @@ MultiDouble MultiDouble::min(const MultiDouble &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Return the reciprocal of this vector */
@@ -1118,6 +1346,10 @@ MultiDouble MultiDouble::reciprocal() const
 inline
 MultiDouble MultiDouble::sqrt() const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiDouble( _mm512_sqrt_pd(v.x[0]),
+                            _mm512_sqrt_pd(v.x[1]) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiDouble( _mm256_sqrt_pd(v.x[0]),
                             _mm256_sqrt_pd(v.x[1]) );
@@ -1134,6 +1366,7 @@ MultiDouble MultiDouble::sqrt() const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Return the recipical square root of this vector */
@@ -1164,6 +1397,9 @@ MultiDouble MultiDouble::rotate() const
 inline
 double MultiDouble::sum() const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return _mm512_reduce_add_pd( _mm512_add_pd(v.x[0], v.x[1]) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return v.a[0] + v.a[1] + v.a[2] + v.a[3] +
                v.a[4] + v.a[5] + v.a[6] + v.a[7];
@@ -1179,6 +1415,7 @@ double MultiDouble::sum() const
         return sum;
     #endif
     #endif
+    #endif
 }
 
 /** Return the sum of all elements of this vector, using doubles for the sum */
@@ -1190,6 +1427,7 @@ double MultiDouble::doubleSum() const
 
 #endif // #ifndef SIRE_SKIP_INLINE_FUNCTIONS
 
+SIRE_END_KERNEL_ISA
 }
 
 SIRE_EXPOSE_CLASS( SireMaths::MultiDouble )
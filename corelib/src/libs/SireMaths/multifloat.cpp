@@ -39,6 +39,25 @@
 
 using namespace SireMaths;
 
+#ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+    static inline bool isAligned64(const void *pointer)
+    {
+        return (quintptr)pointer % size_t(64) == 0;
+    }
+
+    static void assertAligned64(const void *pointer, QString place)
+    {
+        if (not isAligned64(pointer))
+            throw SireError::program_bug( QObject::tr(
+                    "An unaligned MultiFloat has been created! %1")
+                        .arg((quintptr)pointer % size_t(64)), place );
+    }
+
+    static inline bool isAligned32(const void *pointer)
+    {
+        return (quintptr)pointer % size_t(32) == 0;
+    }
+#else
 #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
     static inline bool isAligned32(const void *pointer)
     {
@@ -81,6 +100,7 @@ using namespace SireMaths;
     }
 #endif
 #endif
+#endif
 
 void MultiFloat::assertAligned(const void *ptr, size_t size)
 {
@@ -119,6 +139,9 @@ MultiFloat::MultiFloat(const float *array, int size)
 
     if (size <= 0)
     {
+        #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+            v.x = _mm512_set1_ps(0);
+        #else
         #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
             v.x = _mm256_set1_ps(0);
         #else
@@ -131,9 +154,13 @@ MultiFloat::MultiFloat(const float *array, int size)
             }
         #endif
         #endif
+        #endif
     }
     else if (size == MULTIFLOAT_SIZE)
     {
+        #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+            v.x = _mm512_loadu_ps(array);
+        #else
         #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
             v.x = _mm256_set_ps(array[7], array[6], array[5], array[4],
                                 array[3], array[2], array[1], array[0]);
@@ -148,6 +175,7 @@ MultiFloat::MultiFloat(const float *array, int size)
             }
         #endif
         #endif
+        #endif
     }
     else
     {
@@ -163,6 +191,9 @@ MultiFloat::MultiFloat(const float *array, int size)
             tmp[i] = 0;
         }
         
+        #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+            v.x = _mm512_loadu_ps(tmp);
+        #else
         #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
             v.x = _mm256_set_ps(tmp[7], tmp[6], tmp[5], tmp[4],
                                 tmp[3], tmp[2], tmp[1], tmp[0]);
@@ -177,6 +208,7 @@ MultiFloat::MultiFloat(const float *array, int size)
             }
         #endif
         #endif
+        #endif
     }
 }
 
@@ -227,6 +259,9 @@ MultiFloat& MultiFloat::operator=(const MultiInt &other)
     then any SSE operations will fail */
 bool MultiFloat::isAligned() const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return isAligned64(this);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return isAligned32(this);
     #else
@@ -236,6 +271,7 @@ bool MultiFloat::isAligned() const
         return true;
     #endif
     #endif
+    #endif
 }
 
 QVector<MultiFloat> MultiFloat::fromArray(const double *array, int size)
@@ -279,6 +315,9 @@ QVector<MultiFloat> MultiFloat::fromArray(const double *array, int size)
         a[marray.count()-1] = MultiFloat((float*)(&tmp), nremain);
     }
     
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        assertAligned64(marray.constData(), CODELOC);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         assertAligned32(marray.constData(), CODELOC);
     #else
@@ -288,6 +327,7 @@ QVector<MultiFloat> MultiFloat::fromArray(const double *array, int size)
         assertAligned32(marray.constData(), CODELOC);
     #endif
     #endif
+    #endif
 
     return marray;
 }
@@ -394,6 +434,9 @@ QVector<MultiFloat> MultiFloat::fromArray(const float *array, int size)
         }
     #endif
 
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        assertAligned64(marray.constData(), CODELOC);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         assertAligned32(marray.constData(), CODELOC);
     #else
@@ -403,6 +446,7 @@ QVector<MultiFloat> MultiFloat::fromArray(const float *array, int size)
         assertAligned32(marray.constData(), CODELOC);
     #endif
     #endif
+    #endif
     
     return marray;
 }
@@ -68,6 +68,14 @@
                 #define MULTIFLOAT_AVX2_IS_AVAILABLE 1
             #endif
         #endif
+
+        #undef MULTIFLOAT_AVX512F_IS_AVAILABLE
+
+        #ifdef SIRE_USE_AVX512
+            #ifdef __AVX512F__
+                #define MULTIFLOAT_AVX512F_IS_AVAILABLE 1
+            #endif
+        #endif
     #else
     #ifdef __SSE2__
         #ifdef SIRE_USE_SSE4
@@ -108,10 +116,25 @@
 #endif
 #endif
 
+#ifndef SIRE_BEGIN_KERNEL_ISA
+    #ifdef SIRE_KERNEL_ISA
+        // Each instruction-set specific compilation of the kernels places
+        // the vector classes in its own inline namespace, so that the inline
+        // functions compiled for one instruction set are never merged with
+        // those compiled for another
+        #define SIRE_BEGIN_KERNEL_ISA inline namespace SIRE_KERNEL_ISA {
+        #define SIRE_END_KERNEL_ISA }
+    #else
+        #define SIRE_BEGIN_KERNEL_ISA
+        #define SIRE_END_KERNEL_ISA
+    #endif
+#endif
+
 SIRE_BEGIN_HEADER
 
 namespace SireMaths
 {
+SIRE_BEGIN_KERNEL_ISA
 
 class MultiFixed;
 class MultiDouble;
@@ -120,7 +143,8 @@ class MultiInt;
 
 /** This class provides a vectorised float. This represents
     a single vector of floats on the compiled machine, e.g.
-    4 floats if we use SSE2, 8 floats for AVX
+    4 floats if we use SSE2, 8 floats for AVX and
+    16 floats for AVX-512
     
     @author Christopher Woods
 */
@@ -284,6 +308,26 @@ private:
             void assertAligned(){}
         #endif
 
+        #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+            _ALIGNED(64) union
+            {
+                __m512 x;
+                float a[16];
+            } v;
+            #define MULTIFLOAT_SIZE 16
+
+            MultiFloat(__m512 avx_val)
+            {
+                v.x = avx_val;
+            }
+            #ifdef MULTIFLOAT_CHECK_ALIGNMENT
+                void assertAligned()
+                {
+                    if (quintptr(this) % 64 != 0)
+                        assertAligned(this, 64);
+                }
+            #endif
+        #else
         #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
             _ALIGNED(32) union
             {
@@ -354,6 +398,7 @@ private:
             #endif
         #endif
         #endif
+        #endif
     #else
         #define MULTIFLOAT_SIZE 16
     #endif //#ifndef SIRE_SKIP_INLINE_FUNCTIONS
@@ -375,6 +420,9 @@ MultiFloat::MultiFloat()
 {
     assertAligned();
 
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x = _mm512_set1_ps(0);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         v.x = _mm256_set1_ps(0);
     #else
@@ -387,6 +435,7 @@ MultiFloat::MultiFloat()
         }
     #endif
     #endif
+    #endif
 }
 
 /** Construct a MultiFloat with all values equal to 'val' */
@@ -395,6 +444,9 @@ MultiFloat::MultiFloat(float val)
 {
     assertAligned();
 
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x = _mm512_set1_ps(val);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         v.x = _mm256_set1_ps(val);
     #else
@@ -407,12 +459,16 @@ MultiFloat::MultiFloat(float val)
         }
     #endif
     #endif
+    #endif
 }
 
 /** Copy constructor */
 inline
 MultiFloat::MultiFloat(const MultiFloat &other)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x = other.v.x;
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         v.x = other.v.x;
     #else
@@ -425,6 +481,7 @@ MultiFloat::MultiFloat(const MultiFloat &other)
        }
     #endif
     #endif
+    #endif
 }
 
 /** Assignment operator */
@@ -433,6 +490,9 @@ MultiFloat& MultiFloat::operator=(const MultiFloat &other)
 {
     if (this != &other)
     {
+        #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+            v.x = other.v.x;
+        #else
         #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
             v.x = other.v.x;
         #else
@@ -445,6 +505,7 @@ MultiFloat& MultiFloat::operator=(const MultiFloat &other)
             }
         #endif
         #endif
+        #endif
     }
     
     return *this;
@@ -454,6 +515,9 @@ MultiFloat& MultiFloat::operator=(const MultiFloat &other)
 inline
 MultiFloat& MultiFloat::operator=(float value)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x = _mm512_set1_ps(value);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         v.x = _mm256_set1_ps(value);
     #else
@@ -466,6 +530,7 @@ MultiFloat& MultiFloat::operator=(float value)
         }
     #endif
     #endif
+    #endif
     
     return *this;
 }
@@ -487,6 +552,10 @@ inline float MultiFloat::operator[](int i) const
 inline
 MultiFloat MultiFloat::compareEqual(const MultiFloat &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        const __mmask16 m = _mm512_cmp_ps_mask(v.x, other.v.x, _CMP_EQ_OQ);
+        return MultiFloat( _mm512_castsi512_ps(_mm512_maskz_set1_epi32(m, -1)) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiFloat( _mm256_cmp_ps(v.x, other.v.x, _CMP_EQ_OQ) );
     #else
@@ -503,12 +572,17 @@ MultiFloat MultiFloat::compareEqual(const MultiFloat &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Not equals comparison operator */
 inline
 MultiFloat MultiFloat::compareNotEqual(const MultiFloat &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        const __mmask16 m = _mm512_cmp_ps_mask(v.x, other.v.x, _CMP_NEQ_OQ);
+        return MultiFloat( _mm512_castsi512_ps(_mm512_maskz_set1_epi32(m, -1)) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiFloat( _mm256_cmp_ps(v.x, other.v.x, _CMP_NEQ_OQ) );
     #else
@@ -525,12 +599,17 @@ MultiFloat MultiFloat::compareNotEqual(const MultiFloat &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Less than comparison operator */
 inline
 MultiFloat MultiFloat::compareLess(const MultiFloat &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        const __mmask16 m = _mm512_cmp_ps_mask(v.x, other.v.x, _CMP_LT_OQ);
+        return MultiFloat( _mm512_castsi512_ps(_mm512_maskz_set1_epi32(m, -1)) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiFloat( _mm256_cmp_ps(v.x, other.v.x, _CMP_LT_OQ) );
     #else
@@ -547,12 +626,17 @@ MultiFloat MultiFloat::compareLess(const MultiFloat &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Greater than comparison operator */
 inline
 MultiFloat MultiFloat::compareGreater(const MultiFloat &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        const __mmask16 m = _mm512_cmp_ps_mask(v.x, other.v.x, _CMP_GT_OQ);
+        return MultiFloat( _mm512_castsi512_ps(_mm512_maskz_set1_epi32(m, -1)) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiFloat( _mm256_cmp_ps(v.x, other.v.x, _CMP_GT_OQ) );
     #else
@@ -569,12 +653,17 @@ MultiFloat MultiFloat::compareGreater(const MultiFloat &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Less than or equal comparison */
 inline
 MultiFloat MultiFloat::compareLessEqual(const MultiFloat &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        const __mmask16 m = _mm512_cmp_ps_mask(v.x, other.v.x, _CMP_LE_OQ);
+        return MultiFloat( _mm512_castsi512_ps(_mm512_maskz_set1_epi32(m, -1)) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiFloat( _mm256_cmp_ps(v.x, other.v.x, _CMP_LE_OQ) );
     #else
@@ -591,12 +680,17 @@ MultiFloat MultiFloat::compareLessEqual(const MultiFloat &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Greater than or equal comparison */
 inline
 MultiFloat MultiFloat::compareGreaterEqual(const MultiFloat &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        const __mmask16 m = _mm512_cmp_ps_mask(v.x, other.v.x, _CMP_GE_OQ);
+        return MultiFloat( _mm512_castsi512_ps(_mm512_maskz_set1_epi32(m, -1)) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiFloat( _mm256_cmp_ps(v.x, other.v.x, _CMP_GE_OQ) );
     #else
@@ -613,6 +707,7 @@ MultiFloat MultiFloat::compareGreaterEqual(const MultiFloat &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Return the number of values in the vector */
@@ -633,6 +728,9 @@ int MultiFloat::count()
 inline
 MultiFloat MultiFloat::operator+(const MultiFloat &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiFloat( _mm512_add_ps(v.x, other.v.x) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiFloat( _mm256_add_ps(v.x, other.v.x) );
     #else
@@ -647,12 +745,16 @@ MultiFloat MultiFloat::operator+(const MultiFloat &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Subtraction operator */
 inline
 MultiFloat MultiFloat::operator-(const MultiFloat &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiFloat( _mm512_sub_ps(v.x, other.v.x) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiFloat( _mm256_sub_ps(v.x, other.v.x) );
     #else
@@ -667,12 +769,16 @@ MultiFloat MultiFloat::operator-(const MultiFloat &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Multiplication operator */
 inline
 MultiFloat MultiFloat::operator*(const MultiFloat &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiFloat( _mm512_mul_ps(v.x, other.v.x) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiFloat( _mm256_mul_ps(v.x, other.v.x) );
     #else
@@ -687,12 +793,16 @@ MultiFloat MultiFloat::operator*(const MultiFloat &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Division operator */
 inline
 MultiFloat MultiFloat::operator/(const MultiFloat &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiFloat( _mm512_div_ps(v.x, other.v.x) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiFloat( _mm256_div_ps(v.x, other.v.x) );
     #else
@@ -707,12 +817,16 @@ MultiFloat MultiFloat::operator/(const MultiFloat &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** In-place addition operator */
 inline
 MultiFloat& MultiFloat::operator+=(const MultiFloat &other)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x = _mm512_add_ps(v.x, other.v.x);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         v.x = _mm256_add_ps(v.x, other.v.x);
     #else
@@ -725,6 +839,7 @@ MultiFloat& MultiFloat::operator+=(const MultiFloat &other)
         }
     #endif
     #endif
+    #endif
 
     return *this;
 }
@@ -733,6 +848,9 @@ MultiFloat& MultiFloat::operator+=(const MultiFloat &other)
 inline
 MultiFloat& MultiFloat::operator-=(const MultiFloat &other)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x = _mm512_sub_ps(v.x, other.v.x);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         v.x = _mm256_sub_ps(v.x, other.v.x);
     #else
@@ -745,6 +863,7 @@ MultiFloat& MultiFloat::operator-=(const MultiFloat &other)
         }
     #endif
     #endif
+    #endif
 
     return *this;
 }
@@ -753,6 +872,9 @@ MultiFloat& MultiFloat::operator-=(const MultiFloat &other)
 inline
 MultiFloat& MultiFloat::operator*=(const MultiFloat &other)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x = _mm512_mul_ps(v.x, other.v.x);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         v.x = _mm256_mul_ps(v.x, other.v.x);
     #else
@@ -765,6 +887,7 @@ MultiFloat& MultiFloat::operator*=(const MultiFloat &other)
         }
     #endif
     #endif
+    #endif
 
     return *this;
 }
@@ -773,6 +896,9 @@ MultiFloat& MultiFloat::operator*=(const MultiFloat &other)
 inline
 MultiFloat& MultiFloat::operator/=(const MultiFloat &other)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x = _mm512_div_ps(v.x, other.v.x);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         v.x = _mm256_div_ps(v.x, other.v.x);
     #else
@@ -785,6 +911,7 @@ MultiFloat& MultiFloat::operator/=(const MultiFloat &other)
         }
     #endif
     #endif
+    #endif
 
     return *this;
 }
@@ -799,6 +926,10 @@ inline MultiFloat MultiFloat::operator-() const
 inline
 MultiFloat MultiFloat::logicalAnd(const MultiFloat &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiFloat( _mm512_castsi512_ps( _mm512_and_si512(_mm512_castps_si512(v.x),
+                                                                 _mm512_castps_si512(other.v.x)) ) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiFloat( _mm256_and_ps(v.x, other.v.x) );
     #else
@@ -823,12 +954,17 @@ MultiFloat MultiFloat::logicalAnd(const MultiFloat &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Bitwise logical "and not" (this is *this and (not other)) */
 inline
 MultiFloat MultiFloat::logicalAndNot(const MultiFloat &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiFloat( _mm512_castsi512_ps( _mm512_andnot_si512(_mm512_castps_si512(other.v.x),
+                                                                    _mm512_castps_si512(v.x)) ) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiFloat( _mm256_andnot_ps(other.v.x, v.x) );
     #else
@@ -853,12 +989,17 @@ MultiFloat MultiFloat::logicalAndNot(const MultiFloat &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Bitwise logical or operator */
 inline
 MultiFloat MultiFloat::logicalOr(const MultiFloat &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiFloat( _mm512_castsi512_ps( _mm512_or_si512(_mm512_castps_si512(v.x),
+                                                                _mm512_castps_si512(other.v.x)) ) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiFloat( _mm256_or_ps(v.x, other.v.x) );
     #else
@@ -883,12 +1024,17 @@ MultiFloat MultiFloat::logicalOr(const MultiFloat &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Bitwise logical xor */
 inline
 MultiFloat MultiFloat::logicalXor(const MultiFloat &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiFloat( _mm512_castsi512_ps( _mm512_xor_si512(_mm512_castps_si512(v.x),
+                                                                 _mm512_castps_si512(other.v.x)) ) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiFloat( _mm256_xor_ps(v.x, other.v.x) );
     #else
@@ -913,6 +1059,7 @@ MultiFloat MultiFloat::logicalXor(const MultiFloat &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Logical not operator */
@@ -967,6 +1114,10 @@ MultiFloat MultiFloat::operator^(const MultiFloat &other) const
 inline
 MultiFloat& MultiFloat::operator&=(const MultiFloat &other)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x = _mm512_castsi512_ps( _mm512_and_si512(_mm512_castps_si512(v.x),
+                                                    _mm512_castps_si512(other.v.x)) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         v.x = _mm256_and_ps(v.x, other.v.x);
     #else
@@ -986,6 +1137,7 @@ MultiFloat& MultiFloat::operator&=(const MultiFloat &other)
         }
     #endif
     #endif
+    #endif
 
     return *this;
 }
@@ -994,6 +1146,10 @@ MultiFloat& MultiFloat::operator&=(const MultiFloat &other)
 inline
 MultiFloat& MultiFloat::operator|=(const MultiFloat &other)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x = _mm512_castsi512_ps( _mm512_or_si512(_mm512_castps_si512(v.x),
+                                                   _mm512_castps_si512(other.v.x)) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         v.x = _mm256_or_ps(v.x, other.v.x);
     #else
@@ -1013,6 +1169,7 @@ MultiFloat& MultiFloat::operator|=(const MultiFloat &other)
         }
     #endif
     #endif
+    #endif
 
     return *this;
 }
@@ -1021,6 +1178,10 @@ MultiFloat& MultiFloat::operator|=(const MultiFloat &other)
 inline
 MultiFloat& MultiFloat::operator^=(const MultiFloat &other)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x = _mm512_castsi512_ps( _mm512_xor_si512(_mm512_castps_si512(v.x),
+                                                    _mm512_castps_si512(other.v.x)) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         v.x = _mm256_xor_ps(v.x, other.v.x);
     #else
@@ -1040,6 +1201,7 @@ MultiFloat& MultiFloat::operator^=(const MultiFloat &other)
         }
     #endif
     #endif
+    #endif
 
     return *this;
 }
@@ -1048,6 +1210,9 @@ MultiFloat& MultiFloat::operator^=(const MultiFloat &other)
 inline
 MultiFloat& MultiFloat::multiplyAdd(const MultiFloat &v0, const MultiFloat &v1)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x = _mm512_fmadd_ps(v0.v.x, v1.v.x, v.x);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         v.x = _mm256_add_ps(v.x, _mm256_mul_ps(v0.v.x, v1.v.x));
     #else
@@ -1060,6 +1225,7 @@ MultiFloat& MultiFloat::multiplyAdd(const MultiFloat &v0, const MultiFloat &v1)
         }
     #endif
     #endif
+    #endif
 
     return *this;
 }
@@ -1068,6 +1234,9 @@ MultiFloat& MultiFloat::multiplyAdd(const MultiFloat &v0, const MultiFloat &v1)
 inline
 MultiFloat MultiFloat::max(const MultiFloat &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiFloat( _mm512_max_ps(v.x, other.v.x) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiFloat( _mm256_max_ps(v.x, other.v.x) );
     #else
@@ -1082,12 +1251,16 @@ MultiFloat MultiFloat::max(const MultiFloat &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Return the minimum vector between this and other */
 inline
 MultiFloat MultiFloat::min(const MultiFloat &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiFloat( _mm512_min_ps(v.x, other.v.x) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiFloat( _mm256_min_ps(v.x, other.v.x) );
     #else
@@ -1102,6 +1275,7 @@ MultiFloat MultiFloat::min(const MultiFloat &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Return the reciprocal of this vector */
@@ -1115,6 +1289,9 @@ MultiFloat MultiFloat::reciprocal() const
 inline
 MultiFloat MultiFloat::reciprocal_approx() const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiFloat( _mm512_rcp14_ps(v.x) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiFloat( _mm256_rcp_ps(v.x) );
     #else
@@ -1124,6 +1301,7 @@ MultiFloat MultiFloat::reciprocal_approx() const
         return this->reciprocal();
     #endif
     #endif
+    #endif
 }
 
 /** Return a good approximation of the reciprocal of the vector (the poor approximation
@@ -1131,6 +1309,19 @@ MultiFloat MultiFloat::reciprocal_approx() const
 inline
 MultiFloat MultiFloat::reciprocal_approx_nr() const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        //get the approximation
+        __m512 a = _mm512_rcp14_ps(v.x);
+
+        //now use one step of NR to refine the result
+        // 1/x = a[ 2 - a x ] where a is the approximation
+        __m512 tmp = _mm512_mul_ps(a, v.x);
+        __m512 two = _mm512_set1_ps(2.0);
+        tmp = _mm512_sub_ps(two, tmp);
+        a = _mm512_mul_ps(a, tmp);
+    
+        return MultiFloat(a);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         //get the approximation
         __m256 a = _mm256_rcp_ps(v.x);
@@ -1160,12 +1351,16 @@ MultiFloat MultiFloat::reciprocal_approx_nr() const
         return this->reciprocal();
     #endif
     #endif
+    #endif
 }
 
 /** Return the square root of this vector */
 inline
 MultiFloat MultiFloat::sqrt() const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiFloat( _mm512_sqrt_ps(v.x) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiFloat( _mm256_sqrt_ps(v.x) );
     #else
@@ -1180,6 +1375,7 @@ MultiFloat MultiFloat::sqrt() const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Return the approximate square root, highly approximated but very fast.
@@ -1187,6 +1383,10 @@ MultiFloat MultiFloat::sqrt() const
 inline
 MultiFloat MultiFloat::sqrt_approx() const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        __m512 r_sqrt = _mm512_rsqrt14_ps(v.x);
+        return MultiFloat( _mm512_mul_ps( v.x, r_sqrt ) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         __m256 r_sqrt = _mm256_rsqrt_ps(v.x);
         return MultiFloat( _mm256_mul_ps( v.x, r_sqrt ) );
@@ -1198,6 +1398,7 @@ MultiFloat MultiFloat::sqrt_approx() const
         return this->sqrt();
     #endif
     #endif
+    #endif
 }
 
 /** Return a good approximation of the square root (this is the poor approximation
@@ -1205,6 +1406,21 @@ MultiFloat MultiFloat::sqrt_approx() const
 inline
 MultiFloat MultiFloat::sqrt_approx_nr() const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        //calculate sqrt(x) as x * 1 / sqrt(x)
+        __m512 a = _mm512_rsqrt14_ps(v.x);
+        a = _mm512_mul_ps(v.x, a);
+
+        //now use one step of NR to refine the result
+        // sqrt(x) = a - [ (a^2 - x) / 2a ] where a is the approximation
+        __m512 tmp = _mm512_mul_ps(a, a);
+        tmp = _mm512_sub_ps(tmp, v.x);
+        __m512 two_a = _mm512_add_ps(a, a);
+        tmp = _mm512_div_ps(tmp, two_a);
+        a = _mm512_sub_ps(a, tmp);
+    
+        return MultiFloat(a);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         //calculate sqrt(x) as x * 1 / sqrt(x)
         __m256 a = _mm256_rsqrt_ps(v.x);
@@ -1238,6 +1454,7 @@ MultiFloat MultiFloat::sqrt_approx_nr() const
         return this->sqrt();
     #endif
     #endif
+    #endif
 }
 
 /** Return the recipical square root of this vector */
@@ -1252,6 +1469,9 @@ MultiFloat MultiFloat::rsqrt() const
 inline
 MultiFloat MultiFloat::rsqrt_approx() const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiFloat( _mm512_rsqrt14_ps(v.x) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return MultiFloat( _mm256_rsqrt_ps(v.x) );
     #else
@@ -1261,6 +1481,7 @@ MultiFloat MultiFloat::rsqrt_approx() const
         return MULTIFLOAT_ONE.operator/(this->sqrt());
     #endif
     #endif
+    #endif
 }
 
 /** Return a good approximation of the reciprical square root (this poor approximation
@@ -1268,6 +1489,22 @@ MultiFloat MultiFloat::rsqrt_approx() const
 inline
 MultiFloat MultiFloat::rsqrt_approx_nr() const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        //get the approximation
+        __m512 a = _mm512_rsqrt14_ps(v.x);
+
+        //now use one step of NR to refine the result
+        // 1/x = 0.5 a[ 3 - x a^2 ] where a is the approximation
+        __m512 tmp = _mm512_mul_ps(a, v.x);
+        tmp = _mm512_mul_ps(a, tmp);
+        __m512 three = _mm512_set1_ps(3.0);
+        tmp = _mm512_sub_ps(three, tmp);
+        a = _mm512_mul_ps(a, tmp);
+        __m512 half = _mm512_set1_ps(0.5);
+        a = _mm512_mul_ps(a, half);
+    
+        return MultiFloat(a);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         //get the approximation
         __m256 a = _mm256_rsqrt_ps(v.x);
@@ -1303,6 +1540,7 @@ MultiFloat MultiFloat::rsqrt_approx_nr() const
         return this->rsqrt();
     #endif
     #endif
+    #endif
 }
 
 /** Rotate this vector. This moves each element one space to the left, moving the
@@ -1310,6 +1548,10 @@ MultiFloat MultiFloat::rsqrt_approx_nr() const
 inline
 MultiFloat MultiFloat::rotate() const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        //move each element one space to the left using a full-width permute
+        return MultiFloat( _mm512_permutexvar_ps(_mm512_set_epi32(0,15,14,13,12,11,10,9,8,7,6,5,4,3,2,1), v.x) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         __m256 tmp =  _mm256_permute_ps(v.x, _MM_SHUFFLE ( 0,3,2,1 ));
         return MultiFloat( _mm256_blend_ps(tmp, _mm256_permute2f128_ps ( tmp,tmp,1 ), 136) );
@@ -1330,12 +1572,16 @@ MultiFloat MultiFloat::rotate() const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Return the sum of all elements of this vector */
 inline
 float MultiFloat::sum() const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return _mm512_reduce_add_ps(v.x);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return v.a[0] + v.a[1] + v.a[2] + v.a[3] +
                v.a[4] + v.a[5] + v.a[6] + v.a[7];
@@ -1351,12 +1597,21 @@ float MultiFloat::sum() const
         return sum;
     #endif
     #endif
+    #endif
 }
 
 /** Return the sum of all elements of this vector, using doubles for the sum */
 inline
 double MultiFloat::doubleSum() const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        double sum = 0;
+        for (int i=0; i<MULTIFLOAT_SIZE; ++i)
+        {
+            sum += double(v.a[i]);
+        }
+        return sum;
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return double(v.a[0]) + double(v.a[1]) + double(v.a[2]) + double(v.a[3]) +
                double(v.a[4]) + double(v.a[5]) + double(v.a[6]) + double(v.a[7]);
@@ -1372,11 +1627,18 @@ double MultiFloat::doubleSum() const
         return sum;
     #endif
     #endif
+    #endif
 }
 
 /** Return the absolute (positive) value of the floats */
 inline MultiFloat MultiFloat::abs() const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        MultiFloat ret;
+        ret.v.x = _mm512_castsi512_ps( _mm512_and_si512(_mm512_castps_si512(v.x),
+                                                        _mm512_castps_si512(MULTIFLOAT_POS_MASK.v.x)) );
+        return ret;
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         MultiFloat ret;
         ret.v.x = _mm256_and_ps(v.x, MULTIFLOAT_POS_MASK.v.x);
@@ -1397,6 +1659,7 @@ inline MultiFloat MultiFloat::abs() const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Quick function to set the value of the ith element */
@@ -1407,6 +1670,7 @@ inline void MultiFloat::quickSet(int i, float value)
 
 #endif // #ifndef SIRE_SKIP_INLINE_FUNCTIONS
 
+SIRE_END_KERNEL_ISA
 }
 
 Q_DECLARE_TYPEINFO( SireMaths::MultiFloat, Q_PRIMITIVE_TYPE );
@@ -36,6 +36,25 @@
 
 using namespace SireMaths;
 
+#ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+    static inline bool isAligned64(const void *pointer)
+    {
+        return (quintptr)pointer % size_t(64) == 0;
+    }
+
+    static void assertAligned64(const void *pointer, QString place)
+    {
+        if (not isAligned64(pointer))
+            throw SireError::program_bug( QObject::tr(
+                    "An unaligned MultiInt has been created! %1")
+                        .arg((quintptr)pointer % size_t(64)), place );
+    }
+
+    static inline bool isAligned32(const void *pointer)
+    {
+        return (quintptr)pointer % size_t(32) == 0;
+    }
+#else
 #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
     static inline bool isAligned32(const void *pointer)
     {
@@ -78,6 +97,7 @@ using namespace SireMaths;
     }
 #endif
 #endif
+#endif
 
 void MultiInt::assertAligned(const void *ptr, size_t size)
 {
@@ -123,6 +143,9 @@ MultiInt::MultiInt(const qint32 *array, int size)
 
     if (size <= 0)
     {
+        #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+            v.x = _mm512_set1_epi32(0);
+        #else
         #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
             #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
                 v.x = _mm256_set1_epi32(0);
@@ -140,9 +163,13 @@ MultiInt::MultiInt(const qint32 *array, int size)
             }
         #endif
         #endif
+        #endif
     }
     else if (size == MULTIFLOAT_SIZE)
     {
+        #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+            v.x = _mm512_loadu_si512(array);
+        #else
         #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
             #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
                 v.x = _mm256_set_epi32(array[7], array[6], array[5], array[4],
@@ -162,6 +189,7 @@ MultiInt::MultiInt(const qint32 *array, int size)
             }
         #endif
         #endif
+        #endif
     }
     else
     {
@@ -177,6 +205,9 @@ MultiInt::MultiInt(const qint32 *array, int size)
             tmp[i] = 0;
         }
         
+        #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+            v.x = _mm512_loadu_si512(tmp);
+        #else
         #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
             #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
                 v.x = _mm256_set_epi32(tmp[7], tmp[6], tmp[5], tmp[4],
@@ -196,6 +227,7 @@ MultiInt::MultiInt(const qint32 *array, int size)
             }
         #endif
         #endif
+        #endif
     }
 }
 
@@ -210,6 +242,9 @@ MultiInt::MultiInt(const QVector<qint32> &array)
     then any SSE operations will fail */
 bool MultiInt::isAligned() const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return isAligned64(this);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return isAligned32(this);
     #else
@@ -219,6 +254,7 @@ bool MultiInt::isAligned() const
         return true;
     #endif
     #endif
+    #endif
 }
 
 QVector<MultiInt> MultiInt::fromArray(const qint32 *array, int size)
@@ -316,6 +352,9 @@ QVector<MultiInt> MultiInt::fromArray(const qint32 *array, int size)
         }
     #endif
 
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        assertAligned64(marray.constData(), CODELOC);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         assertAligned32(marray.constData(), CODELOC);
     #else
@@ -325,6 +364,7 @@ QVector<MultiInt> MultiInt::fromArray(const qint32 *array, int size)
         assertAligned32(marray.constData(), CODELOC);
     #endif
     #endif
+    #endif
     
     return marray;
 }
@@ -35,6 +35,7 @@ SIRE_BEGIN_HEADER
 
 namespace SireMaths
 {
+SIRE_BEGIN_KERNEL_ISA
 
 /** This class provides a vectorised 32bit signed integer. This represents
     a single vector of integers on the compiled machine, e.g.
@@ -163,6 +164,34 @@ private:
             void assertAligned(){}
         #endif
 
+        #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+            _ALIGNED(64) union
+            {
+                __m512i x;
+                qint32 a[16];
+            } v;
+
+            MultiInt(__m512i val)
+            {
+                v.x = val;
+            }
+
+            #define MULTIINT_BINONE getBinaryOne()
+
+            static qint32 getBinaryOne()
+            {
+                const quint32 x = 0xFFFFFFFF;
+                return *(reinterpret_cast<const qint32*>(&x));
+            }
+
+            #ifdef MULTIFLOAT_CHECK_ALIGNMENT
+                void assertAligned()
+                {
+                    if (quintptr(this) % 64 != 0)
+                        assertAligned(this, 64);
+                }
+            #endif
+        #else
         #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
             #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
                 _ALIGNED(32) union
@@ -253,6 +282,7 @@ private:
             #endif
         #endif
         #endif
+        #endif
     #endif
 
 };
@@ -265,6 +295,9 @@ MultiInt::MultiInt()
 {
     assertAligned();
 
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x = _mm512_set1_epi32(0);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             v.x = _mm256_set1_epi32(0);
@@ -282,6 +315,7 @@ MultiInt::MultiInt()
         }
     #endif
     #endif
+    #endif
 }
 
 /** Construct a MultiFloat with all values equal to 'val' */
@@ -290,6 +324,9 @@ MultiInt::MultiInt(qint32 val)
 {
     assertAligned();
 
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x = _mm512_set1_epi32(val);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             v.x = _mm256_set1_epi32(val);
@@ -307,12 +344,16 @@ MultiInt::MultiInt(qint32 val)
         }
     #endif
     #endif
+    #endif
 }
 
 /** Copy constructor */
 inline
 MultiInt::MultiInt(const MultiInt &other)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x = other.v.x;
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             v.x = other.v.x;
@@ -330,6 +371,7 @@ MultiInt::MultiInt(const MultiInt &other)
        }
     #endif
     #endif
+    #endif
 }
 
 /** Return the ith value in the MultiInt - note that this is
@@ -345,6 +387,9 @@ MultiInt& MultiInt::operator=(const MultiInt &other)
 {
     if (this != &other)
     {
+        #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+            v.x = other.v.x;
+        #else
         #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
             #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
                 v.x = other.v.x;
@@ -362,6 +407,7 @@ MultiInt& MultiInt::operator=(const MultiInt &other)
             }
         #endif
         #endif
+        #endif
     }
     
     return *this;
@@ -371,6 +417,9 @@ MultiInt& MultiInt::operator=(const MultiInt &other)
 inline
 MultiInt& MultiInt::operator=(qint32 value)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x = _mm512_set1_epi32(value);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             v.x = _mm256_set1_epi32(value);
@@ -388,6 +437,7 @@ MultiInt& MultiInt::operator=(qint32 value)
         }
     #endif
     #endif
+    #endif
     
     return *this;
 }
@@ -402,6 +452,9 @@ MultiInt::~MultiInt()
 inline
 MultiInt MultiInt::compareEqual(const MultiInt &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiInt( _mm512_maskz_set1_epi32(_mm512_cmpeq_epi32_mask(v.x, other.v.x), -1) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             return MultiInt( _mm256_cmpeq_epi32(v.x, other.v.x) );
@@ -423,12 +476,16 @@ MultiInt MultiInt::compareEqual(const MultiInt &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Not equals comparison operator */
 inline
 MultiInt MultiInt::compareNotEqual(const MultiInt &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiInt( _mm512_maskz_set1_epi32(_mm512_cmpneq_epi32_mask(v.x, other.v.x), -1) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         MultiInt ret;
     
@@ -459,12 +516,16 @@ MultiInt MultiInt::compareNotEqual(const MultiInt &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Less than comparison operator */
 inline
 MultiInt MultiInt::compareLess(const MultiInt &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiInt( _mm512_maskz_set1_epi32(_mm512_cmplt_epi32_mask(v.x, other.v.x), -1) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             MultiInt ret;
@@ -492,6 +553,7 @@ MultiInt MultiInt::compareLess(const MultiInt &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Reintepret cast this MultiInt to a MultiFloat. This is only useful if you
@@ -499,6 +561,9 @@ MultiInt MultiInt::compareLess(const MultiInt &other) const
 inline
 MultiFloat MultiInt::reinterpretCastToFloat() const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiFloat( _mm512_castsi512_ps(v.x) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             return MultiFloat( *(reinterpret_cast<const __m256*>(&v.x)) );
@@ -520,12 +585,16 @@ MultiFloat MultiInt::reinterpretCastToFloat() const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Greater than comparison operator */
 inline
 MultiInt MultiInt::compareGreater(const MultiInt &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiInt( _mm512_maskz_set1_epi32(_mm512_cmpgt_epi32_mask(v.x, other.v.x), -1) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             return MultiInt( _mm256_cmpgt_epi32(v.x, other.v.x) );
@@ -547,12 +616,16 @@ MultiInt MultiInt::compareGreater(const MultiInt &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Less than or equal comparison */
 inline
 MultiInt MultiInt::compareLessEqual(const MultiInt &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiInt( _mm512_maskz_set1_epi32(_mm512_cmple_epi32_mask(v.x, other.v.x), -1) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         MultiInt ret;
     
@@ -583,12 +656,16 @@ MultiInt MultiInt::compareLessEqual(const MultiInt &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Greater than or equal comparison */
 inline
 MultiInt MultiInt::compareGreaterEqual(const MultiInt &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiInt( _mm512_maskz_set1_epi32(_mm512_cmpge_epi32_mask(v.x, other.v.x), -1) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         MultiInt ret;
     
@@ -619,6 +696,7 @@ MultiInt MultiInt::compareGreaterEqual(const MultiInt &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Return the number of values in the vector */
@@ -639,6 +717,9 @@ int MultiInt::count()
 inline
 MultiInt MultiInt::operator+(const MultiInt &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiInt( _mm512_add_epi32(v.x, other.v.x) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             return MultiInt( _mm256_add_epi32(v.x, other.v.x) );
@@ -658,12 +739,16 @@ MultiInt MultiInt::operator+(const MultiInt &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Subtraction operator */
 inline
 MultiInt MultiInt::operator-(const MultiInt &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiInt( _mm512_sub_epi32(v.x, other.v.x) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             return MultiInt( _mm256_sub_epi32(v.x, other.v.x) );
@@ -683,6 +768,7 @@ MultiInt MultiInt::operator-(const MultiInt &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Multiplication operator */
@@ -701,6 +787,9 @@ MultiInt MultiInt::operator*(const MultiInt &other) const
 inline
 MultiInt& MultiInt::operator+=(const MultiInt &other)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x = _mm512_add_epi32(v.x, other.v.x);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             v.x = _mm256_add_epi32(v.x, other.v.x);
@@ -718,6 +807,7 @@ MultiInt& MultiInt::operator+=(const MultiInt &other)
         }
     #endif
     #endif
+    #endif
 
     return *this;
 }
@@ -726,6 +816,9 @@ MultiInt& MultiInt::operator+=(const MultiInt &other)
 inline
 MultiInt& MultiInt::operator-=(const MultiInt &other)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x = _mm512_sub_epi32(v.x, other.v.x);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             v.x = _mm256_sub_epi32(v.x, other.v.x);
@@ -743,6 +836,7 @@ MultiInt& MultiInt::operator-=(const MultiInt &other)
         }
     #endif
     #endif
+    #endif
 
     return *this;
 }
@@ -763,6 +857,9 @@ MultiInt& MultiInt::operator*=(const MultiInt &other)
 inline
 MultiInt MultiInt::logicalAnd(const MultiInt &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiInt( _mm512_and_si512(v.x, other.v.x) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             return MultiInt( _mm256_and_si256(v.x, other.v.x) );
@@ -792,12 +889,17 @@ MultiInt MultiInt::logicalAnd(const MultiInt &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Bitwise logical "and" comparison */
 inline
 MultiFloat MultiFloat::logicalAnd(const MultiInt &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiFloat( _mm512_castsi512_ps( _mm512_and_si512(_mm512_castps_si512(v.x),
+                                                                 other.v.x) ) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             return MultiFloat(_mm256_and_ps(v.x,
@@ -829,12 +931,16 @@ MultiFloat MultiFloat::logicalAnd(const MultiInt &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Bitwise logical "and not" */
 inline
 MultiInt MultiInt::logicalAndNot(const MultiInt &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiInt( _mm512_andnot_si512(v.x, other.v.x) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             return MultiInt( _mm256_andnot_si256(v.x, other.v.x) );
@@ -864,12 +970,17 @@ MultiInt MultiInt::logicalAndNot(const MultiInt &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Bitwise logical "and not" (this is *this and (not other)) */
 inline
 MultiFloat MultiFloat::logicalAndNot(const MultiInt &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiFloat( _mm512_castsi512_ps( _mm512_andnot_si512(other.v.x,
+                                                                    _mm512_castps_si512(v.x)) ) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             const __m256 val = *(reinterpret_cast<const __m256*>(&other.v.x));
@@ -902,12 +1013,16 @@ MultiFloat MultiFloat::logicalAndNot(const MultiInt &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Bitwise logical or operator */
 inline
 MultiInt MultiInt::logicalOr(const MultiInt &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiInt( _mm512_or_si512(v.x, other.v.x) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             return MultiInt( _mm256_or_si256(v.x, other.v.x) );
@@ -937,12 +1052,16 @@ MultiInt MultiInt::logicalOr(const MultiInt &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Bitwise logical xor */
 inline
 MultiInt MultiInt::logicalXor(const MultiInt &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiInt( _mm512_xor_si512(v.x, other.v.x) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             return MultiInt( _mm256_xor_si256(v.x, other.v.x) );
@@ -972,6 +1091,7 @@ MultiInt MultiInt::logicalXor(const MultiInt &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Logical not operator */
@@ -1026,6 +1146,9 @@ MultiInt MultiInt::operator^(const MultiInt &other) const
 inline
 MultiInt& MultiInt::operator&=(const MultiInt &other)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x = _mm512_and_si512(v.x, other.v.x);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             v.x = _mm256_and_si256(v.x, other.v.x);
@@ -1050,6 +1173,7 @@ MultiInt& MultiInt::operator&=(const MultiInt &other)
         }
     #endif
     #endif
+    #endif
 
     return *this;
 }
@@ -1058,6 +1182,9 @@ MultiInt& MultiInt::operator&=(const MultiInt &other)
 inline
 MultiFloat& MultiFloat::operator&=(const MultiInt &other)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x = _mm512_castsi512_ps( _mm512_and_si512(_mm512_castps_si512(v.x), other.v.x) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             v.x = _mm256_and_ps( v.x, *(reinterpret_cast<const __m256*>(&(other.v.x))) );
@@ -1082,6 +1209,7 @@ MultiFloat& MultiFloat::operator&=(const MultiInt &other)
         }
     #endif
     #endif
+    #endif
 
     return *this;
 }
@@ -1090,6 +1218,9 @@ MultiFloat& MultiFloat::operator&=(const MultiInt &other)
 inline
 MultiInt& MultiInt::operator|=(const MultiInt &other)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x = _mm512_or_si512(v.x, other.v.x);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             v.x = _mm256_or_si256(v.x, other.v.x);
@@ -1114,6 +1245,7 @@ MultiInt& MultiInt::operator|=(const MultiInt &other)
         }
     #endif
     #endif
+    #endif
 
     return *this;
 }
@@ -1122,6 +1254,9 @@ MultiInt& MultiInt::operator|=(const MultiInt &other)
 inline
 MultiInt& MultiInt::operator^=(const MultiInt &other)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x = _mm512_xor_si512(v.x, other.v.x);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             v.x = _mm256_xor_si256(v.x, other.v.x);
@@ -1146,6 +1281,7 @@ MultiInt& MultiInt::operator^=(const MultiInt &other)
         }
     #endif
     #endif
+    #endif
 
     return *this;
 }
@@ -1154,6 +1290,9 @@ MultiInt& MultiInt::operator^=(const MultiInt &other)
 inline
 MultiInt MultiInt::max(const MultiInt &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiInt( _mm512_max_epi32(v.x, other.v.x) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         MultiInt ret;
         for (int i=0; i<MULTIFLOAT_SIZE; ++i)
@@ -1182,12 +1321,16 @@ MultiInt MultiInt::max(const MultiInt &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Return the minimum vector between this and other */
 inline
 MultiInt MultiInt::min(const MultiInt &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiInt( _mm512_min_epi32(v.x, other.v.x) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         MultiInt ret;
         for (int i=0; i<MULTIFLOAT_SIZE; ++i)
@@ -1216,6 +1359,7 @@ MultiInt MultiInt::min(const MultiInt &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Rotate this vector. This moves each element one space to the left, moving the
@@ -1223,6 +1367,9 @@ MultiInt MultiInt::min(const MultiInt &other) const
 inline
 MultiInt MultiInt::rotate() const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiInt( _mm512_permutexvar_epi32(_mm512_set_epi32(0,15,14,13,12,11,10,9,8,7,6,5,4,3,2,1), v.x) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         MultiInt ret;
         
@@ -1251,6 +1398,7 @@ MultiInt MultiInt::rotate() const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Return the sum of all elements of this vector */
@@ -1279,6 +1427,7 @@ qint64 MultiInt::doubleSum() const
 
 #endif // #ifndef SIRE_SKIP_INLINE_FUNCTIONS
 
+SIRE_END_KERNEL_ISA
 }
 
 Q_DECLARE_TYPEINFO( SireMaths::MultiInt, Q_PRIMITIVE_TYPE );
@@ -36,6 +36,25 @@
 
 using namespace SireMaths;
 
+#ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+    static inline bool isAligned64(const void *pointer)
+    {
+        return (quintptr)pointer % size_t(64) == 0;
+    }
+
+    static void assertAligned64(const void *pointer, QString place)
+    {
+        if (not isAligned64(pointer))
+            throw SireError::program_bug( QObject::tr(
+                    "An unaligned MultiUInt has been created! %1")
+                        .arg((quintptr)pointer % size_t(64)), place );
+    }
+
+    static inline bool isAligned32(const void *pointer)
+    {
+        return (quintptr)pointer % size_t(32) == 0;
+    }
+#else
 #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
     static inline bool isAligned32(const void *pointer)
     {
@@ -78,6 +97,7 @@ using namespace SireMaths;
     }
 #endif
 #endif
+#endif
 
 void MultiUInt::assertAligned(const void *ptr, size_t size)
 {
@@ -103,6 +123,9 @@ MultiUInt::MultiUInt(const quint32 *array, int size)
 
     if (size <= 0)
     {
+        #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+            v.x = _mm512_set1_epi32(0);
+        #else
         #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
             #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
                 v.x = _mm256_set1_epi32(0);
@@ -120,6 +143,7 @@ MultiUInt::MultiUInt(const quint32 *array, int size)
             }
         #endif
         #endif
+        #endif
     }
     else
     {
@@ -135,6 +159,9 @@ MultiUInt::MultiUInt(const quint32 *array, int size)
             tmp[i] = 0;
         }
         
+        #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+            v.x = _mm512_loadu_si512(tmp);
+        #else
         #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
             #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
                 v.x = _mm256_set_epi32(tmp[7], tmp[6], tmp[5], tmp[4],
@@ -154,6 +181,7 @@ MultiUInt::MultiUInt(const quint32 *array, int size)
             }
         #endif
         #endif
+        #endif
     }
 }
 
@@ -168,6 +196,9 @@ MultiUInt::MultiUInt(const QVector<quint32> &array)
     then any SSE operations will fail */
 bool MultiUInt::isAligned() const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return isAligned64(this);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         return isAligned32(this);
     #else
@@ -177,6 +208,7 @@ bool MultiUInt::isAligned() const
         return true;
     #endif
     #endif
+    #endif
 }
 
 QVector<MultiUInt> MultiUInt::fromArray(const quint32 *array, int size)
@@ -274,6 +306,9 @@ QVector<MultiUInt> MultiUInt::fromArray(const quint32 *array, int size)
         }
     #endif
 
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        assertAligned64(marray.constData(), CODELOC);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         assertAligned32(marray.constData(), CODELOC);
     #else
@@ -283,6 +318,7 @@ QVector<MultiUInt> MultiUInt::fromArray(const quint32 *array, int size)
         assertAligned32(marray.constData(), CODELOC);
     #endif
     #endif
+    #endif
     
     return marray;
 }
@@ -35,6 +35,7 @@ SIRE_BEGIN_HEADER
 
 namespace SireMaths
 {
+SIRE_BEGIN_KERNEL_ISA
 
 /** This class provides a vectorised 32bit unsigned integer. This represents
     a single vector of integers on the compiled machine, e.g.
@@ -157,6 +158,34 @@ private:
             void assertAligned(){}
         #endif
 
+        #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+            _ALIGNED(64) union
+            {
+                __m512i x;
+                quint32 a[16];
+            } v;
+
+            MultiUInt(__m512i val)
+            {
+                v.x = val;
+            }
+
+            #define MULTIUINT_BINONE getBinaryOne()
+
+            static quint32 getBinaryOne()
+            {
+                const quint32 x = 0xFFFFFFFF;
+                return x;
+            }
+
+            #ifdef MULTIFLOAT_CHECK_ALIGNMENT
+                void assertAligned()
+                {
+                    if (quintptr(this) % 64 != 0)
+                        assertAligned(this, 64);
+                }
+            #endif
+        #else
         #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
             #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
                 _ALIGNED(32) union
@@ -247,6 +276,7 @@ private:
             #endif
         #endif
         #endif
+        #endif
     #endif
 
 };
@@ -259,6 +289,9 @@ MultiUInt::MultiUInt()
 {
     assertAligned();
 
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x = _mm512_set1_epi32(0);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             v.x = _mm256_set1_epi32(0);
@@ -276,6 +309,7 @@ MultiUInt::MultiUInt()
         }
     #endif
     #endif
+    #endif
 }
 
 /** Construct a MultiFloat with all values equal to 'val' */
@@ -286,6 +320,9 @@ MultiUInt::MultiUInt(quint32 uval)
 
     qint32 val = *(reinterpret_cast<qint32*>(&uval));
 
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x = _mm512_set1_epi32(val);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             v.x = _mm256_set1_epi32(val);
@@ -303,12 +340,16 @@ MultiUInt::MultiUInt(quint32 uval)
         }
     #endif
     #endif
+    #endif
 }
 
 /** Copy constructor */
 inline
 MultiUInt::MultiUInt(const MultiUInt &other)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x = other.v.x;
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             v.x = other.v.x;
@@ -326,6 +367,7 @@ MultiUInt::MultiUInt(const MultiUInt &other)
        }
     #endif
     #endif
+    #endif
 }
 
 /** Return the ith value in the MultiUInt - note that this is
@@ -341,6 +383,9 @@ MultiUInt& MultiUInt::operator=(const MultiUInt &other)
 {
     if (this != &other)
     {
+        #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+            v.x = other.v.x;
+        #else
         #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
             #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
                 v.x = other.v.x;
@@ -358,6 +403,7 @@ MultiUInt& MultiUInt::operator=(const MultiUInt &other)
             }
         #endif
         #endif
+        #endif
     }
     
     return *this;
@@ -369,6 +415,9 @@ MultiUInt& MultiUInt::operator=(quint32 uvalue)
 {
     qint32 value = *(reinterpret_cast<qint32*>(&uvalue));
 
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x = _mm512_set1_epi32(value);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             v.x = _mm256_set1_epi32(value);
@@ -386,6 +435,7 @@ MultiUInt& MultiUInt::operator=(quint32 uvalue)
         }
     #endif
     #endif
+    #endif
     
     return *this;
 }
@@ -400,6 +450,9 @@ MultiUInt::~MultiUInt()
 inline
 MultiUInt MultiUInt::compareEqual(const MultiUInt &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiUInt( _mm512_maskz_set1_epi32(_mm512_cmpeq_epi32_mask(v.x, other.v.x), -1) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             return MultiUInt( _mm256_cmpeq_epi32(v.x, other.v.x) );
@@ -421,12 +474,16 @@ MultiUInt MultiUInt::compareEqual(const MultiUInt &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Not equals comparison operator */
 inline
 MultiUInt MultiUInt::compareNotEqual(const MultiUInt &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiUInt( _mm512_maskz_set1_epi32(_mm512_cmpneq_epi32_mask(v.x, other.v.x), -1) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         MultiUInt ret;
     
@@ -457,12 +514,16 @@ MultiUInt MultiUInt::compareNotEqual(const MultiUInt &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Less than comparison operator */
 inline
 MultiUInt MultiUInt::compareLess(const MultiUInt &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiUInt( _mm512_maskz_set1_epi32(_mm512_cmplt_epu32_mask(v.x, other.v.x), -1) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             MultiUInt ret;
@@ -501,6 +562,7 @@ MultiUInt MultiUInt::compareLess(const MultiUInt &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Reintepret cast this MultiInt to a MultiFloat. This is only useful if you
@@ -508,6 +570,9 @@ MultiUInt MultiUInt::compareLess(const MultiUInt &other) const
 inline
 MultiFloat MultiUInt::reinterpretCastToFloat() const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiFloat( _mm512_castsi512_ps(v.x) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             return MultiFloat( *(reinterpret_cast<const __m256*>(&v.x)) );
@@ -529,12 +594,16 @@ MultiFloat MultiUInt::reinterpretCastToFloat() const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Greater than comparison operator */
 inline
 MultiUInt MultiUInt::compareGreater(const MultiUInt &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiUInt( _mm512_maskz_set1_epi32(_mm512_cmpgt_epu32_mask(v.x, other.v.x), -1) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             MultiUInt ret;
@@ -576,12 +645,16 @@ MultiUInt MultiUInt::compareGreater(const MultiUInt &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Less than or equal comparison */
 inline
 MultiUInt MultiUInt::compareLessEqual(const MultiUInt &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiUInt( _mm512_maskz_set1_epi32(_mm512_cmple_epu32_mask(v.x, other.v.x), -1) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         MultiUInt ret;
     
@@ -612,12 +685,16 @@ MultiUInt MultiUInt::compareLessEqual(const MultiUInt &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Greater than or equal comparison */
 inline
 MultiUInt MultiUInt::compareGreaterEqual(const MultiUInt &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiUInt( _mm512_maskz_set1_epi32(_mm512_cmpge_epu32_mask(v.x, other.v.x), -1) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         MultiUInt ret;
     
@@ -648,6 +725,7 @@ MultiUInt MultiUInt::compareGreaterEqual(const MultiUInt &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Return the number of values in the vector */
@@ -668,6 +746,9 @@ int MultiUInt::count()
 inline
 MultiUInt MultiUInt::operator+(const MultiUInt &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiUInt( _mm512_add_epi32(v.x, other.v.x) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             return MultiUInt( _mm256_add_epi32(v.x, other.v.x) );
@@ -687,12 +768,16 @@ MultiUInt MultiUInt::operator+(const MultiUInt &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Subtraction operator */
 inline
 MultiUInt MultiUInt::operator-(const MultiUInt &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiUInt( _mm512_sub_epi32(v.x, other.v.x) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             return MultiUInt( _mm256_sub_epi32(v.x, other.v.x) );
@@ -712,12 +797,16 @@ MultiUInt MultiUInt::operator-(const MultiUInt &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** In-place addition operator */
 inline
 MultiUInt& MultiUInt::operator+=(const MultiUInt &other)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x = _mm512_add_epi32(v.x, other.v.x);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             v.x = _mm256_add_epi32(v.x, other.v.x);
@@ -735,6 +824,7 @@ MultiUInt& MultiUInt::operator+=(const MultiUInt &other)
         }
     #endif
     #endif
+    #endif
 
     return *this;
 }
@@ -743,6 +833,9 @@ MultiUInt& MultiUInt::operator+=(const MultiUInt &other)
 inline
 MultiUInt& MultiUInt::operator-=(const MultiUInt &other)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x = _mm512_sub_epi32(v.x, other.v.x);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             v.x = _mm256_sub_epi32(v.x, other.v.x);
@@ -760,6 +853,7 @@ MultiUInt& MultiUInt::operator-=(const MultiUInt &other)
         }
     #endif
     #endif
+    #endif
 
     return *this;
 }
@@ -768,6 +862,9 @@ MultiUInt& MultiUInt::operator-=(const MultiUInt &other)
 inline
 MultiUInt MultiUInt::logicalAnd(const MultiUInt &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiUInt( _mm512_and_si512(v.x, other.v.x) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             return MultiUInt( _mm256_and_si256(v.x, other.v.x) );
@@ -797,12 +894,17 @@ MultiUInt MultiUInt::logicalAnd(const MultiUInt &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Bitwise logical "and" comparison */
 inline
 MultiFloat MultiFloat::logicalAnd(const MultiUInt &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiFloat( _mm512_castsi512_ps( _mm512_and_si512(_mm512_castps_si512(v.x),
+                                                                 other.v.x) ) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             return MultiFloat(_mm256_and_ps(v.x,
@@ -834,12 +936,16 @@ MultiFloat MultiFloat::logicalAnd(const MultiUInt &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Bitwise logical "and not" */
 inline
 MultiUInt MultiUInt::logicalAndNot(const MultiUInt &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiUInt( _mm512_andnot_si512(v.x, other.v.x) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             return MultiUInt( _mm256_andnot_si256(v.x, other.v.x) );
@@ -869,12 +975,17 @@ MultiUInt MultiUInt::logicalAndNot(const MultiUInt &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Bitwise logical "and not" (this is *this and (not other)) */
 inline
 MultiFloat MultiFloat::logicalAndNot(const MultiUInt &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiFloat( _mm512_castsi512_ps( _mm512_andnot_si512(other.v.x,
+                                                                    _mm512_castps_si512(v.x)) ) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             const __m256 val = *(reinterpret_cast<const __m256*>(&other.v.x));
@@ -907,12 +1018,16 @@ MultiFloat MultiFloat::logicalAndNot(const MultiUInt &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Bitwise logical or operator */
 inline
 MultiUInt MultiUInt::logicalOr(const MultiUInt &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiUInt( _mm512_or_si512(v.x, other.v.x) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             return MultiUInt( _mm256_or_si256(v.x, other.v.x) );
@@ -942,12 +1057,16 @@ MultiUInt MultiUInt::logicalOr(const MultiUInt &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Bitwise logical xor */
 inline
 MultiUInt MultiUInt::logicalXor(const MultiUInt &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiUInt( _mm512_xor_si512(v.x, other.v.x) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             return MultiUInt( _mm256_xor_si256(v.x, other.v.x) );
@@ -977,6 +1096,7 @@ MultiUInt MultiUInt::logicalXor(const MultiUInt &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Logical not operator */
@@ -1031,6 +1151,9 @@ MultiUInt MultiUInt::operator^(const MultiUInt &other) const
 inline
 MultiUInt& MultiUInt::operator&=(const MultiUInt &other)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x = _mm512_and_si512(v.x, other.v.x);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             v.x = _mm256_and_si256(v.x, other.v.x);
@@ -1055,6 +1178,7 @@ MultiUInt& MultiUInt::operator&=(const MultiUInt &other)
         }
     #endif
     #endif
+    #endif
 
     return *this;
 }
@@ -1063,6 +1187,9 @@ MultiUInt& MultiUInt::operator&=(const MultiUInt &other)
 inline
 MultiFloat& MultiFloat::operator&=(const MultiUInt &other)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x = _mm512_castsi512_ps( _mm512_and_si512(_mm512_castps_si512(v.x), other.v.x) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             v.x = _mm256_and_ps( v.x, *(reinterpret_cast<const __m256*>(&(other.v.x))) );
@@ -1087,6 +1214,7 @@ MultiFloat& MultiFloat::operator&=(const MultiUInt &other)
         }
     #endif
     #endif
+    #endif
 
     return *this;
 }
@@ -1095,6 +1223,9 @@ MultiFloat& MultiFloat::operator&=(const MultiUInt &other)
 inline
 MultiUInt& MultiUInt::operator|=(const MultiUInt &other)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x = _mm512_or_si512(v.x, other.v.x);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             v.x = _mm256_or_si256(v.x, other.v.x);
@@ -1119,6 +1250,7 @@ MultiUInt& MultiUInt::operator|=(const MultiUInt &other)
         }
     #endif
     #endif
+    #endif
 
     return *this;
 }
@@ -1127,6 +1259,9 @@ MultiUInt& MultiUInt::operator|=(const MultiUInt &other)
 inline
 MultiUInt& MultiUInt::operator^=(const MultiUInt &other)
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        v.x = _mm512_xor_si512(v.x, other.v.x);
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         #ifdef MULTIFLOAT_AVX2_IS_AVAILABLE
             v.x = _mm256_xor_si256(v.x, other.v.x);
@@ -1151,6 +1286,7 @@ MultiUInt& MultiUInt::operator^=(const MultiUInt &other)
         }
     #endif
     #endif
+    #endif
 
     return *this;
 }
@@ -1159,6 +1295,9 @@ MultiUInt& MultiUInt::operator^=(const MultiUInt &other)
 inline
 MultiUInt MultiUInt::max(const MultiUInt &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiUInt( _mm512_max_epu32(v.x, other.v.x) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         MultiUInt ret;
         for (int i=0; i<MULTIFLOAT_SIZE; ++i)
@@ -1187,12 +1326,16 @@ MultiUInt MultiUInt::max(const MultiUInt &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Return the minimum vector between this and other */
 inline
 MultiUInt MultiUInt::min(const MultiUInt &other) const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiUInt( _mm512_min_epu32(v.x, other.v.x) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         MultiUInt ret;
         for (int i=0; i<MULTIFLOAT_SIZE; ++i)
@@ -1221,6 +1364,7 @@ MultiUInt MultiUInt::min(const MultiUInt &other) const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Rotate this vector. This moves each element one space to the left, moving the
@@ -1228,6 +1372,9 @@ MultiUInt MultiUInt::min(const MultiUInt &other) const
 inline
 MultiUInt MultiUInt::rotate() const
 {
+    #ifdef MULTIFLOAT_AVX512F_IS_AVAILABLE
+        return MultiUInt( _mm512_permutexvar_epi32(_mm512_set_epi32(0,15,14,13,12,11,10,9,8,7,6,5,4,3,2,1), v.x) );
+    #else
     #ifdef MULTIFLOAT_AVX_IS_AVAILABLE
         MultiUInt ret;
         
@@ -1256,6 +1403,7 @@ MultiUInt MultiUInt::rotate() const
         return ret;
     #endif
     #endif
+    #endif
 }
 
 /** Return the sum of all elements of this vector */
@@ -1284,6 +1432,7 @@ quint64 MultiUInt::doubleSum() const
 
 #endif // #ifndef SIRE_SKIP_INLINE_FUNCTIONS
 
+SIRE_END_KERNEL_ISA
 }
 
 SIRE_EXPOSE_CLASS( SireMaths::MultiUInt )
@@ -586,6 +586,53 @@ qint64 RanGenerator::randInt64(qint64 minval, qint64 maxval) const
     return minval + randInt(maxval-minval);
 }
 
+/** Fill 'values' with random numbers on [0,1]. This takes the
+    lock only once, so is much quicker than calling rand() for each value */
+void RanGenerator::fill(QVector<double> &values) const
+{
+    const int n = values.count();
+    double *v = values.data();
+
+    QMutexLocker lkr( &(nonconst_d().mutex) );
+    MTRand &mersenne_generator = nonconst_d().mersenne_generator;
+
+    for (int i=0; i<n; ++i)
+    {
+        v[i] = mersenne_generator.rand();
+    }
+}
+
+/** Fill 'values' with random numbers on [minval,maxval] */
+void RanGenerator::fill(QVector<double> &values, double minval, double maxval) const
+{
+    const int n = values.count();
+    double *v = values.data();
+
+    QMutexLocker lkr( &(nonconst_d().mutex) );
+    MTRand &mersenne_generator = nonconst_d().mersenne_generator;
+
+    for (int i=0; i<n; ++i)
+    {
+        v[i] = minval + mersenne_generator.rand() * (maxval-minval);
+    }
+}
+
+/** Fill 'values' with random numbers from the normal distribution
+    with supplied mean and variance. This takes the lock only once */
+void RanGenerator::fillNorm(QVector<double> &values, double mean, double variance) const
+{
+    const int n = values.count();
+    double *v = values.data();
+
+    QMutexLocker lkr( &(nonconst_d().mutex) );
+    MTRand &mersenne_generator = nonconst_d().mersenne_generator;
+
+    for (int i=0; i<n; ++i)
+    {
+        v[i] = mersenne_generator.randNorm(mean, variance);
+    }
+}
+
 /** Return the current state of the random number generator.
     Use this if you truly wish to get reproducible sequences
     of random numbers */
@@ -62,6 +62,11 @@ void seed_qrand();
     different random number sequences (thus the possibility
     of accidental repeat random numbers is removed).
 
+    Every call takes a lock on the shared generator. Use the "fill"
+    functions to generate many numbers under a single lock, or use
+    a CounterRanGenerator to give each thread its own lock-free,
+    reproducible stream of random numbers.
+
     @author Christopher Woods
 */
 class SIREMATHS_EXPORT RanGenerator
@@ -119,6 +124,10 @@ public:
     quint64 randInt64(quint64 maxval) const;
     qint64 randInt64(qint64 minval, qint64 maxval) const;
 
+    void fill(QVector<double> &values) const;
+    void fill(QVector<double> &values, double minval, double maxval) const;
+    void fillNorm(QVector<double> &values, double mean, double variance) const;
+
     QVector<quint32> getState() const;
     void setState(const QVector<quint32> &state);
     
@@ -62,6 +62,326 @@ extern "C"
 
 } // end of extern "C"
 
+#else // SIRE_DISABLE_FORTRAN
+
+#include <algorithm>
+
+#include <QVector>
+
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
+// Native implementation of the BLAS functions used by sire_blas, used
+// when the Fortran BLAS is not available. These follow the BLAS
+// conventions, i.e. all matrices are column-major, op(A) is
+// an M x K matrix, op(B) is K x N and C is M x N
+namespace SireMaths
+{
+namespace detail
+{
+
+/** Size of the register block of C computed by the micro-kernel.
+    MR doubles in a column fit into one or two SIMD registers, so
+    the compiler can vectorise the inner loop of the kernel */
+static const int GEMM_MR = 8;
+static const int GEMM_NR = 4;
+
+/** Size of the cache blocks - a KC x NC panel of B and an MC x KC
+    panel of A should fit comfortably in L2 cache */
+static const int GEMM_MC = 128;
+static const int GEMM_KC = 256;
+static const int GEMM_NC = 256;
+
+/** Below this number of multiply-adds the matrix multiplication
+    is not worth parallelising */
+static const double GEMM_MIN_PARALLEL_FLOPS = 64*64*64;
+
+/** Return element (i,k) of op(A), where A is column-major with
+    leading dimension 'lda' */
+inline double gemm_get(const double *a, bool trans, int lda, int i, int k)
+{
+    return trans ? a[k + i*lda] : a[i + k*lda];
+}
+
+/** Pack the mc x kc block of op(A) starting at (i0,k0) into 'packed',
+    in strips of GEMM_MR rows, with each strip stored k-major. The
+    last strip is zero-padded */
+static void gemm_packA(const double *a, bool trans, int lda,
+                       int i0, int k0, int mc, int kc, double *packed)
+{
+    for (int is=0; is<mc; is += GEMM_MR)
+    {
+        const int mr = std::min(GEMM_MR, mc-is);
+
+        for (int k=0; k<kc; ++k)
+        {
+            for (int i=0; i<mr; ++i)
+            {
+                packed[i] = gemm_get(a, trans, lda, i0+is+i, k0+k);
+            }
+
+            for (int i=mr; i<GEMM_MR; ++i)
+            {
+                packed[i] = 0;
+            }
+
+            packed += GEMM_MR;
+        }
+    }
+}
+
+/** Pack the kc x nc block of op(B) starting at (k0,j0) into 'packed',
+    in strips of GEMM_NR columns, with each strip stored k-major. The
+    last strip is zero-padded */
+static void gemm_packB(const double *b, bool trans, int ldb,
+                       int k0, int j0, int kc, int nc, double *packed)
+{
+    for (int js=0; js<nc; js += GEMM_NR)
+    {
+        const int nr = std::min(GEMM_NR, nc-js);
+
+        for (int k=0; k<kc; ++k)
+        {
+            for (int j=0; j<nr; ++j)
+            {
+                packed[j] = gemm_get(b, trans, ldb, k0+k, j0+js+j);
+            }
+
+            for (int j=nr; j<GEMM_NR; ++j)
+            {
+                packed[j] = 0;
+            }
+
+            packed += GEMM_NR;
+        }
+    }
+}
+
+/** The micro-kernel - this adds alpha * (packed A strip) * (packed B strip)
+    onto the mr x nr block of C at 'c' */
+static void gemm_kernel(int kc, double alpha, const double *pa, const double *pb,
+                        double *c, int ldc, int mr, int nr)
+{
+    double ab[GEMM_NR][GEMM_MR];
+
+    for (int j=0; j<GEMM_NR; ++j)
+    {
+        for (int i=0; i<GEMM_MR; ++i)
+        {
+            ab[j][i] = 0;
+        }
+    }
+
+    for (int k=0; k<kc; ++k)
+    {
+        for (int j=0; j<GEMM_NR; ++j)
+        {
+            const double bj = pb[j];
+
+            for (int i=0; i<GEMM_MR; ++i)
+            {
+                ab[j][i] += pa[i] * bj;
+            }
+        }
+
+        pa += GEMM_MR;
+        pb += GEMM_NR;
+    }
+
+    for (int j=0; j<nr; ++j)
+    {
+        for (int i=0; i<mr; ++i)
+        {
+            c[i + j*ldc] += alpha * ab[j][i];
+        }
+    }
+}
+
+/** Calculate the mc x nc tile of C starting at (i0,j0), looping over
+    all of the K dimension in blocks of GEMM_KC */
+static void gemm_tile(bool transa, bool transb, int K, double alpha,
+                      const double *a, int lda, const double *b, int ldb,
+                      double *c, int ldc, int i0, int j0, int mc, int nc,
+                      double *packa, double *packb)
+{
+    for (int k0=0; k0<K; k0 += GEMM_KC)
+    {
+        const int kc = std::min(GEMM_KC, K-k0);
+
+        gemm_packB(b, transb, ldb, k0, j0, kc, nc, packb);
+        gemm_packA(a, transa, lda, i0, k0, mc, kc, packa);
+
+        for (int js=0; js<nc; js += GEMM_NR)
+        {
+            const int nr = std::min(GEMM_NR, nc-js);
+            const double *pb = packb + (js/GEMM_NR)*kc*GEMM_NR;
+
+            for (int is=0; is<mc; is += GEMM_MR)
+            {
+                const int mr = std::min(GEMM_MR, mc-is);
+                const double *pa = packa + (is/GEMM_MR)*kc*GEMM_MR;
+
+                gemm_kernel(kc, alpha, pa, pb, c + (i0+is) + (j0+js)*ldc, ldc, mr, nr);
+            }
+        }
+    }
+}
+
+/** TBB functor used to calculate tiles of C in parallel. Each
+    index in the range is one MC x NC tile of C */
+class GEMMTiles
+{
+public:
+    GEMMTiles(bool ta, bool tb, int m, int n, int k, double alph,
+              const double *pa, int la, const double *pb, int lb,
+              double *pc, int lc)
+         : transa(ta), transb(tb), M(m), N(n), K(k), alpha(alph),
+           a(pa), lda(la), b(pb), ldb(lb), c(pc), ldc(lc)
+    {
+        nmtiles = (M + GEMM_MC - 1) / GEMM_MC;
+    }
+
+    int nTiles() const
+    {
+        return nmtiles * ((N + GEMM_NC - 1) / GEMM_NC);
+    }
+
+    void operator()(const tbb::blocked_range<int> &range) const
+    {
+        QVector<double> packa( GEMM_MC * GEMM_KC + GEMM_MR*GEMM_KC );
+        QVector<double> packb( GEMM_KC * GEMM_NC + GEMM_NR*GEMM_KC );
+
+        for (int tile = range.begin(); tile != range.end(); ++tile)
+        {
+            const int i0 = (tile % nmtiles) * GEMM_MC;
+            const int j0 = (tile / nmtiles) * GEMM_NC;
+
+            gemm_tile(transa, transb, K, alpha, a, lda, b, ldb, c, ldc,
+                      i0, j0, std::min(GEMM_MC, M-i0), std::min(GEMM_NC, N-j0),
+                      packa.data(), packb.data());
+        }
+    }
+
+private:
+    bool transa, transb;
+    int M, N, K;
+    double alpha;
+    const double *a;
+    int lda;
+    const double *b;
+    int ldb;
+    double *c;
+    int ldc;
+    int nmtiles;
+};
+
+/** Native, cache-blocked and multithreaded implementation of BLAS dgemm, i.e.
+
+    C = alpha * op(A) * op(B) + beta * C
+*/
+static void native_dgemm(bool transa, bool transb, int M, int N, int K,
+                  double alpha, const double *a, int lda,
+                  const double *b, int ldb,
+                  double beta, double *c, int ldc)
+{
+    if (M <= 0 or N <= 0)
+        return;
+
+    //first scale C by beta
+    if (beta != 1)
+    {
+        for (int j=0; j<N; ++j)
+        {
+            double *cj = c + j*ldc;
+
+            if (beta == 0)
+            {
+                for (int i=0; i<M; ++i)
+                {
+                    cj[i] = 0;
+                }
+            }
+            else
+            {
+                for (int i=0; i<M; ++i)
+                {
+                    cj[i] *= beta;
+                }
+            }
+        }
+    }
+
+    if (K <= 0 or alpha == 0)
+        return;
+
+    GEMMTiles tiles(transa, transb, M, N, K, alpha, a, lda, b, ldb, c, ldc);
+
+    if (double(M)*double(N)*double(K) < GEMM_MIN_PARALLEL_FLOPS or tiles.nTiles() == 1)
+    {
+        tiles( tbb::blocked_range<int>(0, tiles.nTiles()) );
+    }
+    else
+    {
+        tbb::parallel_for( tbb::blocked_range<int>(0, tiles.nTiles(), 1), tiles );
+    }
+}
+
+/** Native implementation of BLAS dgemv, i.e.
+
+    y = alpha * op(A) * x + beta * y
+
+    where op(A) is M x N
+*/
+static void native_dgemv(bool transa, int M, int N, double alpha,
+                  const double *a, int lda, const double *x,
+                  double beta, double *y)
+{
+    if (beta != 1)
+    {
+        for (int i=0; i<M; ++i)
+        {
+            y[i] = (beta == 0) ? 0 : beta*y[i];
+        }
+    }
+
+    if (alpha == 0)
+        return;
+
+    if (transa)
+    {
+        //each element of y is the dot product of a column of A with x
+        for (int i=0; i<M; ++i)
+        {
+            const double *ai = a + i*lda;
+            double sum = 0;
+
+            for (int j=0; j<N; ++j)
+            {
+                sum += ai[j] * x[j];
+            }
+
+            y[i] += alpha * sum;
+        }
+    }
+    else
+    {
+        //add on each column of A scaled by the corresponding element of x
+        for (int j=0; j<N; ++j)
+        {
+            const double *aj = a + j*lda;
+            const double xj = alpha * x[j];
+
+            for (int i=0; i<M; ++i)
+            {
+                y[i] += aj[i] * xj;
+            }
+        }
+    }
+}
+
+} // end of namespace detail
+} // end of namespace SireMaths
+
 #endif // SIRE_DISABLE_FORTRAN
 
 namespace SireMaths
@@ -74,11 +394,19 @@ namespace SireMaths
 NVector SIREMATHS_EXPORT dgemv(const NMatrix &A, const NVector &X)
 {
     #ifdef SIRE_DISABLE_FORTRAN
-    throw SireError::unsupported( QObject::tr(
-            "dgemv not available as BLAS does not work with this version of Sire."),
-                    CODELOC );
-
-    return NVector();
+    A.assertNColumns( X.nRows() );
+    
+    //a transposed matrix is stored in row-major order
+    const int M = A.nRows();
+    const int N = A.nColumns();
+    
+    NVector Y(M);
+    
+    detail::native_dgemv( A.isTransposed(), M, N, 1, A.constData(),
+                          A.isTransposed() ? N : M,
+                          X.constData(), 0, Y.data() );
+    
+    return Y;
 
     #else
 
@@ -125,11 +453,19 @@ NVector SIREMATHS_EXPORT dgemv(double alpha, const NMatrix &A, const NVector &X,
                                double beta, const NVector &Y)
 {
     #ifdef SIRE_DISABLE_FORTRAN
-    throw SireError::unsupported( QObject::tr(
-            "dgemv not available as BLAS does not work with this version of Sire."),
-                    CODELOC );
-
-    return NVector();
+    A.assertNColumns( X.nRows() );
+    Y.assertNRows( A.nRows() );
+    
+    const int M = A.nRows();
+    const int N = A.nColumns();
+    
+    NVector RESULT( Y );
+    
+    detail::native_dgemv( A.isTransposed(), M, N, alpha, A.constData(),
+                          A.isTransposed() ? N : M,
+                          X.constData(), beta, RESULT.data() );
+    
+    return RESULT;
 
     #else
 
@@ -179,11 +515,21 @@ NVector SIREMATHS_EXPORT dgemv(double alpha, const NMatrix &A, const NVector &X,
 NMatrix SIREMATHS_EXPORT dgemm(const NMatrix &A, const NMatrix &B)
 {
     #ifdef SIRE_DISABLE_FORTRAN
-    throw SireError::unsupported( QObject::tr(
-            "dgemm not available as BLAS does not work with this version of Sire."),
-                    CODELOC );
-
-    return NMatrix();
+    B.assertNRows( A.nColumns() );
+    
+    //a transposed matrix is stored in row-major order
+    const int M = A.nRows();
+    const int K = A.nColumns();
+    const int N = B.nColumns();
+    
+    NMatrix C(M, N);
+    
+    detail::native_dgemm( A.isTransposed(), B.isTransposed(), M, N, K,
+                          1, A.constData(), A.isTransposed() ? K : M,
+                          B.constData(), B.isTransposed() ? N : K,
+                          0, C.data(), M );
+    
+    return C;
 
     #else
 
@@ -244,11 +590,26 @@ NMatrix dgemm(double alpha, const NMatrix &A, const NMatrix &B,
               double beta, const NMatrix &C)
 {
     #ifdef SIRE_DISABLE_FORTRAN
-    throw SireError::unsupported( QObject::tr(
-            "dgemm not available as BLAS does not work with this version of Sire."),
-                    CODELOC );
-
-    return NMatrix();
+    A.assertNColumns( B.nRows() );
+    C.assertNRows( A.nRows() );
+    C.assertNColumns( B.nColumns() );
+    
+    const int M = A.nRows();
+    const int K = A.nColumns();
+    const int N = B.nColumns();
+    
+    //the result must be in column-major order
+    NMatrix RESULT(C);
+    
+    if (RESULT.isTransposed())
+        RESULT = C.transpose().fullTranspose();
+    
+    detail::native_dgemm( A.isTransposed(), B.isTransposed(), M, N, K,
+                          alpha, A.constData(), A.isTransposed() ? K : M,
+                          B.constData(), B.isTransposed() ? N : K,
+                          beta, RESULT.data(), M );
+    
+    return RESULT;
 
     #else
  
@@ -55,6 +55,339 @@ extern "C"
 
 } // end of extern "C"
 
+#else // SIRE_DISABLE_FORTRAN
+
+#include <algorithm>
+
+// Native implementation of the symmetric eigensolver, used when
+// the Fortran LAPACK is not available
+namespace SireMaths
+{
+namespace detail
+{
+
+/** Householder reduction of the symmetric n x n matrix held
+    (column-major) in 'v' to tridiagonal form. On return 'd' holds the
+    diagonal, 'e' the sub-diagonal (in e[1..n-1]) and 'v' the
+    orthogonal transformation. This is the EISPACK tred2 algorithm */
+static void tred2(int n, double *v, double *d, double *e)
+{
+    #define V(i,j) v[(i) + (j)*n]
+
+    for (int j=0; j<n; ++j)
+    {
+        d[j] = V(n-1,j);
+    }
+
+    for (int i=n-1; i>0; --i)
+    {
+        double scale = 0;
+        double h = 0;
+
+        for (int k=0; k<i; ++k)
+        {
+            scale += std::abs(d[k]);
+        }
+
+        if (scale == 0)
+        {
+            e[i] = d[i-1];
+
+            for (int j=0; j<i; ++j)
+            {
+                d[j] = V(i-1,j);
+                V(i,j) = 0;
+                V(j,i) = 0;
+            }
+        }
+        else
+        {
+            for (int k=0; k<i; ++k)
+            {
+                d[k] /= scale;
+                h += d[k]*d[k];
+            }
+
+            double f = d[i-1];
+            double g = std::sqrt(h);
+
+            if (f > 0)
+                g = -g;
+
+            e[i] = scale * g;
+            h = h - f*g;
+            d[i-1] = f - g;
+
+            for (int j=0; j<i; ++j)
+            {
+                e[j] = 0;
+            }
+
+            for (int j=0; j<i; ++j)
+            {
+                f = d[j];
+                V(j,i) = f;
+                g = e[j] + V(j,j)*f;
+
+                for (int k=j+1; k<=i-1; ++k)
+                {
+                    g += V(k,j) * d[k];
+                    e[k] += V(k,j) * f;
+                }
+
+                e[j] = g;
+            }
+
+            f = 0;
+
+            for (int j=0; j<i; ++j)
+            {
+                e[j] /= h;
+                f += e[j] * d[j];
+            }
+
+            const double hh = f / (h+h);
+
+            for (int j=0; j<i; ++j)
+            {
+                e[j] -= hh * d[j];
+            }
+
+            for (int j=0; j<i; ++j)
+            {
+                f = d[j];
+                g = e[j];
+
+                for (int k=j; k<=i-1; ++k)
+                {
+                    V(k,j) -= (f*e[k] + g*d[k]);
+                }
+
+                d[j] = V(i-1,j);
+                V(i,j) = 0;
+            }
+        }
+
+        d[i] = h;
+    }
+
+    //accumulate the transformations
+    for (int i=0; i<n-1; ++i)
+    {
+        V(n-1,i) = V(i,i);
+        V(i,i) = 1;
+
+        const double h = d[i+1];
+
+        if (h != 0)
+        {
+            for (int k=0; k<=i; ++k)
+            {
+                d[k] = V(k,i+1) / h;
+            }
+
+            for (int j=0; j<=i; ++j)
+            {
+                double g = 0;
+
+                for (int k=0; k<=i; ++k)
+                {
+                    g += V(k,i+1) * V(k,j);
+                }
+
+                for (int k=0; k<=i; ++k)
+                {
+                    V(k,j) -= g * d[k];
+                }
+            }
+        }
+
+        for (int k=0; k<=i; ++k)
+        {
+            V(k,i+1) = 0;
+        }
+    }
+
+    for (int j=0; j<n; ++j)
+    {
+        d[j] = V(n-1,j);
+        V(n-1,j) = 0;
+    }
+
+    V(n-1,n-1) = 1;
+    e[0] = 0;
+
+    #undef V
+}
+
+/** Implicit QL diagonalisation of the symmetric tridiagonal matrix
+    produced by tred2, accumulating the eigenvectors into 'v' (if
+    'v' is not null). The eigenvalues are returned in 'd', sorted into
+    ascending order. This is the EISPACK tql2 algorithm. This returns
+    false if the algorithm did not converge */
+static bool tql2(int n, double *v, double *d, double *e)
+{
+    #define V(i,j) v[(i) + (j)*n]
+
+    for (int i=1; i<n; ++i)
+    {
+        e[i-1] = e[i];
+    }
+
+    e[n-1] = 0;
+
+    double f = 0;
+    double tst1 = 0;
+    const double eps = std::pow(2.0, -52.0);
+
+    for (int l=0; l<n; ++l)
+    {
+        //find a small sub-diagonal element
+        tst1 = std::max(tst1, std::abs(d[l]) + std::abs(e[l]));
+
+        int m = l;
+
+        while (m < n)
+        {
+            if (std::abs(e[m]) <= eps*tst1)
+                break;
+
+            ++m;
+        }
+
+        //if m == l, d[l] is already an eigenvalue, otherwise iterate
+        if (m > l)
+        {
+            int iter = 0;
+
+            do
+            {
+                ++iter;
+
+                if (iter > 30*n)
+                    return false;
+
+                //compute the implicit shift
+                double g = d[l];
+                double p = (d[l+1] - g) / (2.0 * e[l]);
+                double r = std::sqrt(p*p + 1.0);
+
+                if (p < 0)
+                    r = -r;
+
+                d[l] = e[l] / (p + r);
+                d[l+1] = e[l] * (p + r);
+
+                const double dl1 = d[l+1];
+                double h = g - d[l];
+
+                for (int i=l+2; i<n; ++i)
+                {
+                    d[i] -= h;
+                }
+
+                f += h;
+
+                //implicit QL transformation
+                p = d[m];
+
+                double c = 1;
+                double c2 = c;
+                double c3 = c;
+                const double el1 = e[l+1];
+                double s = 0;
+                double s2 = 0;
+
+                for (int i=m-1; i>=l; --i)
+                {
+                    c3 = c2;
+                    c2 = c;
+                    s2 = s;
+                    g = c * e[i];
+                    h = c * p;
+                    r = std::sqrt(p*p + e[i]*e[i]);
+                    e[i+1] = s * r;
+                    s = e[i] / r;
+                    c = p / r;
+                    p = c * d[i] - s * g;
+                    d[i+1] = h + s * (c * g + s * d[i]);
+
+                    //accumulate the transformation
+                    if (v)
+                    {
+                        for (int k=0; k<n; ++k)
+                        {
+                            h = V(k,i+1);
+                            V(k,i+1) = s * V(k,i) + c * h;
+                            V(k,i) = c * V(k,i) - s * h;
+                        }
+                    }
+                }
+
+                p = -s * s2 * c3 * el1 * e[l] / dl1;
+                e[l] = s * p;
+                d[l] = c * p;
+            }
+            while (std::abs(e[l]) > eps*tst1);
+        }
+
+        d[l] += f;
+        e[l] = 0;
+    }
+
+    //sort the eigenvalues (and eigenvectors) into ascending order
+    for (int i=0; i<n-1; ++i)
+    {
+        int k = i;
+        double p = d[i];
+
+        for (int j=i+1; j<n; ++j)
+        {
+            if (d[j] < p)
+            {
+                k = j;
+                p = d[j];
+            }
+        }
+
+        if (k != i)
+        {
+            d[k] = d[i];
+            d[i] = p;
+
+            if (v)
+            {
+                for (int j=0; j<n; ++j)
+                {
+                    std::swap( V(j,i), V(j,k) );
+                }
+            }
+        }
+    }
+
+    return true;
+
+    #undef V
+}
+
+/** Copy the upper (or lower) triangle of the n x n column-major
+    matrix 'a' into both triangles of 'v' */
+static void symmetrise(int n, const double *a, double *v, bool upper)
+{
+    for (int j=0; j<n; ++j)
+    {
+        for (int i=0; i<=j; ++i)
+        {
+            const double val = upper ? a[i + j*n] : a[j + i*n];
+            v[i + j*n] = val;
+            v[j + i*n] = val;
+        }
+    }
+}
+
+} // end of namespace detail
+} // end of namespace SireMaths
+
 #endif // SIRE_DISABLE_FORTRAN
 
 namespace SireMaths
@@ -63,11 +396,32 @@ namespace SireMaths
 std::pair<NVector,NMatrix> SIREMATHS_EXPORT dsyev(const NMatrix &A, bool upper)
 {
     #ifdef SIRE_DISABLE_FORTRAN
-    throw SireError::unsupported( QObject::tr(
-            "dsyev not available as LAPACK does not work with this version of Sire."),
-                    CODELOC );
-
-    return std::pair<NVector,NMatrix>();
+    if (A.isTransposed())
+    {
+        //we can only process a column-major ordered matrix...
+        return dsyev( A.transpose().fullTranspose(), upper );
+    }
+    
+    A.assertSquare();
+    
+    const int N = A.nRows();
+    
+    NVector EIGVAL(N);
+    NMatrix EIGVEC(N, N);
+    QVector<double> E(N);
+    
+    if (N == 0)
+        return std::pair<NVector,NMatrix>(EIGVAL, EIGVEC);
+    
+    detail::symmetrise(N, A.constData(), EIGVEC.data(), upper);
+    detail::tred2(N, EIGVEC.data(), EIGVAL.data(), E.data());
+    
+    if (not detail::tql2(N, EIGVEC.data(), EIGVAL.data(), E.data()))
+        throw SireMaths::domain_error( QObject::tr(
+                "The eigenvalues failed to converge in dsyev. A ==\n%1.")
+                    .arg(A.toString()), CODELOC );
+    
+    return std::pair<NVector,NMatrix>(EIGVAL, EIGVEC);
 
     #else
 
@@ -119,12 +473,34 @@ NVector SIREMATHS_EXPORT dsyev_eigenvalues(const NMatrix &A, bool upper)
 {
     #ifdef SIRE_DISABLE_FORTRAN
     
-    throw SireError::unsupported( QObject::tr(
-            "dsyev_eigenvalues not available as LAPACK does not work "
-            "with this version of Sire."),
-                    CODELOC );
-
-    return NVector();
+    if (A.isTransposed())
+    {
+        //we can only process a column-major ordered matrix...
+        return dsyev_eigenvalues( A.transpose().fullTranspose(), upper );
+    }
+    
+    A.assertSquare();
+    
+    const int N = A.nRows();
+    
+    NVector EIGVAL(N);
+    
+    if (N == 0)
+        return EIGVAL;
+    
+    QVector<double> WORK(N*N);
+    QVector<double> E(N);
+    
+    detail::symmetrise(N, A.constData(), WORK.data(), upper);
+    detail::tred2(N, WORK.data(), EIGVAL.data(), E.data());
+    
+    //don't accumulate the eigenvectors as they are not needed
+    if (not detail::tql2(N, 0, EIGVAL.data(), E.data()))
+        throw SireMaths::domain_error( QObject::tr(
+                "The eigenvalues failed to converge in dsyev. A ==\n%1.")
+                    .arg(A.toString()), CODELOC );
+    
+    return EIGVAL;
 
     #else
 
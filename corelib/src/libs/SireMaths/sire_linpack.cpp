@@ -57,6 +57,211 @@ extern "C"
 
 } // end of extern "C"
 
+#else // SIRE_DISABLE_FORTRAN
+
+#include <algorithm>
+
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
+// Native implementation of the LU factorisation, used when the 
+// Fortran LINPACK is not available. Note that the factors are not
+// stored in exactly the same format as LINPACK (the multipliers have
+// the opposite sign, and whole rows are swapped), so the output of
+// the native dgeco must only be passed to the native dgedi
+namespace SireMaths
+{
+namespace detail
+{
+
+/** LU factorisation with partial pivoting of the n x n column-major
+    matrix 'a' (in place). On return the strictly lower triangle
+    holds the multipliers of the unit lower triangular matrix L and
+    the upper triangle holds U. ipvt[k] is the (1-based, as in LINPACK)
+    index of the row that was swapped with row k at step k. This
+    returns false if the matrix is singular */
+static bool lu_factorise(int n, double *a, int *ipvt)
+{
+    #define A(i,j) a[(i) + (j)*n]
+
+    bool nonsingular = true;
+
+    for (int k=0; k<n; ++k)
+    {
+        //find the pivot
+        int l = k;
+        double maxval = std::abs(A(k,k));
+
+        for (int i=k+1; i<n; ++i)
+        {
+            if (std::abs(A(i,k)) > maxval)
+            {
+                l = i;
+                maxval = std::abs(A(i,k));
+            }
+        }
+
+        ipvt[k] = l + 1;
+
+        if (maxval == 0)
+        {
+            nonsingular = false;
+            continue;
+        }
+
+        if (l != k)
+        {
+            for (int j=0; j<n; ++j)
+            {
+                std::swap( A(k,j), A(l,j) );
+            }
+        }
+
+        //compute the multipliers
+        const double inv_pivot = 1.0 / A(k,k);
+
+        for (int i=k+1; i<n; ++i)
+        {
+            A(i,k) *= inv_pivot;
+        }
+
+        //update the trailing sub-matrix, column by column so that
+        //the inner loop is contiguous
+        for (int j=k+1; j<n; ++j)
+        {
+            const double akj = A(k,j);
+
+            if (akj != 0)
+            {
+                double *aj = &(A(0,j));
+                const double *ak = &(A(0,k));
+
+                for (int i=k+1; i<n; ++i)
+                {
+                    aj[i] -= ak[i] * akj;
+                }
+            }
+        }
+    }
+
+    return nonsingular;
+
+    #undef A
+}
+
+/** Solve A x = b for a single right hand side 'b' (in place), using the
+    factorisation from lu_factorise */
+static void lu_solve(int n, const double *a, const int *ipvt, double *b)
+{
+    #define A(i,j) a[(i) + (j)*n]
+
+    //apply the row swaps (the whole rows, including the multipliers,
+    //were swapped during the factorisation)
+    for (int k=0; k<n; ++k)
+    {
+        const int l = ipvt[k] - 1;
+
+        if (l != k)
+            std::swap(b[k], b[l]);
+    }
+
+    //forward substitute with L
+    for (int k=0; k<n; ++k)
+    {
+        const double bk = b[k];
+
+        if (bk != 0)
+        {
+            for (int i=k+1; i<n; ++i)
+            {
+                b[i] -= A(i,k) * bk;
+            }
+        }
+    }
+
+    //back substitute with U
+    for (int k=n-1; k>=0; --k)
+    {
+        b[k] /= A(k,k);
+
+        const double bk = b[k];
+
+        if (bk != 0)
+        {
+            for (int i=0; i<k; ++i)
+            {
+                b[i] -= A(i,k) * bk;
+            }
+        }
+    }
+
+    #undef A
+}
+
+/** TBB functor used to calculate the columns of the inverse in parallel */
+class LUInverseColumns
+{
+public:
+    LUInverseColumns(int size, const double *lu_factors, const int *pivots,
+                     double *inverse)
+          : n(size), lu(lu_factors), ipvt(pivots), inv(inverse)
+    {}
+
+    void operator()(const tbb::blocked_range<int> &range) const
+    {
+        for (int j=range.begin(); j != range.end(); ++j)
+        {
+            double *col = inv + j*n;
+
+            for (int i=0; i<n; ++i)
+            {
+                col[i] = 0;
+            }
+
+            col[j] = 1;
+
+            lu_solve(n, lu, ipvt, col);
+        }
+    }
+
+private:
+    int n;
+    const double *lu;
+    const int *ipvt;
+    double *inv;
+};
+
+/** Return the determinant of the matrix from its LU factorisation */
+static double lu_determinant(int n, const double *a, const int *ipvt)
+{
+    double det = 1;
+
+    for (int k=0; k<n; ++k)
+    {
+        det *= a[k + k*n];
+
+        if (ipvt[k]-1 != k)
+            det = -det;
+    }
+
+    return det;
+}
+
+/** Calculate the inverse of the matrix from its LU factorisation,
+    placing the result in 'inv' */
+static void lu_inverse(int n, const double *a, const int *ipvt, double *inv)
+{
+    LUInverseColumns columns(n, a, ipvt, inv);
+
+    if (n < 64)
+        columns( tbb::blocked_range<int>(0,n) );
+    else
+        tbb::parallel_for( tbb::blocked_range<int>(0,n,8), columns );
+}
+
+} // end of namespace detail
+} // end of namespace SireMaths
+
 #endif // SIRE_DISABLE_FORTRAN
 
 namespace SireMaths
@@ -66,11 +271,20 @@ std::pair< NMatrix,QVector<int> > SIREMATHS_EXPORT dgeco(const NMatrix &A)
 {
     #ifdef SIRE_DISABLE_FORTRAN
 
-    throw SireError::unsupported( QObject::tr(
-            "dgeco not available as LINPACK does not work with this version of Sire."),
-                    CODELOC );
-
-    return std::pair< NMatrix,QVector<int> >();
+    if (A.isTransposed())
+        return dgeco( A.transpose().fullTranspose() );
+    
+    A.assertSquare();
+    
+    const int N = A.nRows();
+    
+    QVector<int> IPVT(N);
+    NMatrix A_OUT(A);
+    
+    //as with LINPACK, a singular matrix is not an error here
+    detail::lu_factorise(N, A_OUT.data(), IPVT.data());
+    
+    return std::pair< NMatrix,QVector<int> >(A_OUT, IPVT);
 
     #else
 
@@ -102,12 +316,22 @@ NMatrix SIREMATHS_EXPORT dgedi_inverse(const NMatrix &A, const QVector<int> &IPV
 {
     #ifdef SIRE_DISABLE_FORTRAN
 
-    throw SireError::unsupported( QObject::tr(
-            "dgedi_inverse not available as LINPACK does not work "
-            "with this version of Sire."),
-                    CODELOC );
-
-    return NMatrix();
+    const int N = A.nRows();
+    BOOST_ASSERT( A.nColumns() == N );
+    BOOST_ASSERT( IPVT.count() == N );
+    
+    for (int i=0; i<N; ++i)
+    {
+        if (A.constData()[i + i*N] == 0)
+            throw SireMaths::domain_error( QObject::tr(
+                    "Cannot invert the matrix as it is singular."), CODELOC );
+    }
+    
+    NMatrix A_INV(N, N);
+    
+    detail::lu_inverse(N, A.constData(), IPVT.constData(), A_INV.data());
+    
+    return A_INV;
 
     #else
 
@@ -139,12 +363,11 @@ double SIREMATHS_EXPORT dgedi_determinant(const NMatrix &A, const QVector<int> &
 {
     #ifdef SIRE_DISABLE_FORTRAN
 
-    throw SireError::unsupported( QObject::tr(
-            "dgedi_determinant not available as LINPACK does not work "
-            "with this version of Sire."),
-                    CODELOC );
-
-    return 0;
+    const int N = A.nRows();
+    BOOST_ASSERT( A.nColumns() == N );
+    BOOST_ASSERT( IPVT.count() == N );
+    
+    return detail::lu_determinant(N, A.constData(), IPVT.constData());
 
     #else
     
@@ -178,11 +401,8 @@ std::pair<double,NMatrix> SIREMATHS_EXPORT dgedi(const NMatrix &A,
 {
     #ifdef SIRE_DISABLE_FORTRAN
     
-    throw SireError::unsupported( QObject::tr(
-            "dgedi not available as LINPACK does not work with this version of Sire."),
-                    CODELOC );
-
-    return std::pair<double,NMatrix>();
+    return std::pair<double,NMatrix>( dgedi_determinant(A, IPVT), 
+                                      dgedi_inverse(A, IPVT) );
 
     #else
 
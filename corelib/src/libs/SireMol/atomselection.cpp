@@ -50,7 +50,7 @@ RegisterMetaType<AtomSelection> r_selection;
 QDataStream SIREMOL_EXPORT &operator<<(QDataStream &ds,
                                        const AtomSelection &selection)
 {
-    writeHeader(ds, r_selection, 1);
+    writeHeader(ds, r_selection, 2);
     
     SharedDataStream sds(ds);
 
@@ -66,19 +66,105 @@ QDataStream SIREMOL_EXPORT &operator>>(QDataStream &ds,
 {
     VersionID v = readHeader(ds, r_selection);
     
-    if (v == 1)
+    if (v == 2)
     {
         SharedDataStream sds(ds);
         
         sds >> selection.d >> selection.selected_atoms
             >> selection.nselected;
     }
+    else if (v == 1)
+    {
+        SharedDataStream sds(ds);
+        
+        //version 1 stored the atoms of each partially selected
+        //CutGroup - any CutGroup not in the hash was fully selected
+        QHash< CGIdx,QSet<Index> > cg_atoms;
+        
+        sds >> selection.d >> cg_atoms >> selection.nselected;
+        
+        selection.selected_atoms.clear();
+        
+        if (selection.nselected > 0 and not cg_atoms.isEmpty())
+        {
+            selection._pvt_expand();
+        
+            for (QHash< CGIdx,QSet<Index> >::const_iterator it = cg_atoms.constBegin();
+                 it != cg_atoms.constEnd();
+                 ++it)
+            {
+                const QList<AtomIdx> &atoms = selection.info().getAtomsIn(it.key());
+                
+                for (int i=0; i<atoms.count(); ++i)
+                {
+                    if (not it.value().contains(Index(i)))
+                        selection._pvt_clearBit(atoms.at(i));
+                }
+            }
+            
+            selection._pvt_recount();
+            selection._pvt_compress();
+        }
+    }
     else
-        throw version_error(v, "1", r_selection, CODELOC);
+        throw version_error(v, "1,2", r_selection, CODELOC);
         
     return ds;
 }
 
+/** Return the number of 64 bit words needed to hold one bit per atom */
+static inline int nWords(int nats)
+{
+    return (nats + 63) / 64;
+}
+
+/** Return the mask of the valid bits in the last word of the bitset */
+static inline quint64 lastWordMask(int nats)
+{
+    const int nbits = nats % 64;
+
+    if (nbits == 0)
+        return ~quint64(0);
+    else
+        return (quint64(1) << nbits) - 1;
+}
+
+/** Return the number of set bits in 'word' */
+static inline int countBits(quint64 word)
+{
+    #ifdef __GNUC__
+        return __builtin_popcountll(word);
+    #else
+        int nbits = 0;
+        
+        while (word)
+        {
+            word &= word - 1;
+            ++nbits;
+        }
+        
+        return nbits;
+    #endif
+}
+
+/** Return the index of the lowest set bit in the (non-zero) 'word' */
+static inline int lowestBit(quint64 word)
+{
+    #ifdef __GNUC__
+        return __builtin_ctzll(word);
+    #else
+        int i = 0;
+        
+        while ((word & 1) == 0)
+        {
+            word >>= 1;
+            ++i;
+        }
+        
+        return i;
+    #endif
+}
+
 /** Null constructor */
 AtomSelection::AtomSelection() 
               : ConcreteProperty<AtomSelection,MoleculeProperty>(),
@@ -174,16 +260,105 @@ int AtomSelection::nSelected() const
     return nselected;
 }
 
+/** Return whether the bit for the atom at index 'atomidx' is set.
+    This must only be called when the bitset is populated */
+bool AtomSelection::_pvt_testBit(int atomidx) const
+{
+    return (selected_atoms.constData()[atomidx >> 6] >> (atomidx & 63)) & 1;
+}
+
+/** Set the bit for the atom at index 'atomidx', returning whether
+    or not this changed the selection */
+bool AtomSelection::_pvt_setBit(int atomidx)
+{
+    quint64 &word = selected_atoms[atomidx >> 6];
+    const quint64 bit = quint64(1) << (atomidx & 63);
+    
+    if (word & bit)
+        return false;
+        
+    word |= bit;
+    ++nselected;
+    
+    return true;
+}
+
+/** Clear the bit for the atom at index 'atomidx', returning whether
+    or not this changed the selection */
+bool AtomSelection::_pvt_clearBit(int atomidx)
+{
+    quint64 &word = selected_atoms[atomidx >> 6];
+    const quint64 bit = quint64(1) << (atomidx & 63);
+    
+    if ((word & bit) == 0)
+        return false;
+        
+    word &= ~bit;
+    --nselected;
+    
+    return true;
+}
+
+/** Populate the bitset from the "all" or "none" selected state
+    so that individual bits can be changed */
+void AtomSelection::_pvt_expand()
+{
+    if (not selected_atoms.isEmpty())
+        return;
+        
+    const int nats = info().nAtoms();
+    
+    if (nats == 0)
+        return;
+    
+    if (nselected == 0)
+    {
+        selected_atoms = QVector<quint64>(nWords(nats), 0);
+    }
+    else
+    {
+        selected_atoms = QVector<quint64>(nWords(nats), ~quint64(0));
+        selected_atoms.last() &= lastWordMask(nats);
+    }
+}
+
+/** Drop the bitset if all or none of the atoms are selected */
+void AtomSelection::_pvt_compress()
+{
+    if (nselected == 0 or nselected == info().nAtoms())
+        selected_atoms.clear();
+}
+
+/** Recount the number of selected atoms from the bitset */
+void AtomSelection::_pvt_recount()
+{
+    if (selected_atoms.isEmpty())
+        return;
+
+    const quint64 *words = selected_atoms.constData();
+    const int nwords = selected_atoms.count();
+
+    int nats = 0;
+    
+    for (int i=0; i<nwords; ++i)
+    {
+        nats += countBits(words[i]);
+    }
+    
+    nselected = nats;
+}
+
 bool AtomSelection::_pvt_selected(const CGAtomIdx &cgatomidx) const
 {
-    return nselected > 0 and 
-           ( (not selected_atoms.contains(cgatomidx.cutGroup())) or
-             (selected_atoms.find(cgatomidx.cutGroup())->contains(cgatomidx.atom())) );
+    return this->_pvt_selected( d->atomIdx(cgatomidx) );
 }
 
 bool AtomSelection::_pvt_selected(AtomIdx atomidx) const
 {
-    return this->_pvt_selected( d->cgAtomIdx(atomidx) );
+    if (selected_atoms.isEmpty())
+        return nselected > 0;
+    else
+        return this->_pvt_testBit(atomidx);
 }
 
 /** Return whether or not the atom at index 'cgatomidx' has
@@ -206,7 +381,7 @@ bool AtomSelection::selected(const CGAtomIdx &cgatomidx) const
 */
 bool AtomSelection::selected(AtomIdx atomidx) const
 {
-    return this->_pvt_selected( info().cgAtomIdx(atomidx) );
+    return this->_pvt_selected( AtomIdx(atomidx.map(info().nAtoms())) );
 }
 
 /** Return whether any of the atom(s) identified by the ID 'atomid'
@@ -235,7 +410,18 @@ bool AtomSelection::selected(CGIdx cgidx) const
 {
     cgidx = CGIdx( cgidx.map(info().nCutGroups()) );
     
-    return this->selectedAll(cgidx) or selected_atoms.value(cgidx).count() > 0;
+    if (selected_atoms.isEmpty())
+        return nselected > 0;
+    
+    const QList<AtomIdx> &atoms = d->getAtomsIn(cgidx);
+    
+    for (int i=0; i<atoms.count(); ++i)
+    {
+        if (this->_pvt_testBit(atoms.at(i)))
+            return true;
+    }
+    
+    return false;
 }
 
 /** Return whether or not any atoms in the residue
@@ -393,48 +579,15 @@ bool AtomSelection::selected(const AtomSelection &selection) const
     else if (this->selectedAll() or selection.selectedAll())
         return true;
             
-    //now do the hard stuff!
-    if (selection.selectedAllCutGroups())
-    {
-        for (CGIdx i(0); i < this->info().nCutGroups(); ++i)
-        {
-            if (this->selectedAll(i))
-                return true;
-            else if (selection.selectedAll(i) and not this->selectedNone(i))
-                return true;
-            else if (not this->selectedNone(i))
-            {
-                const QSet<Index> &atoms = *(selected_atoms.find(i));
-                
-                foreach (Index idx, selection.selectedAtoms(i))
-                {
-                    if (atoms.contains(idx))
-                        return true;
-                }
-            }
-        }
-    }
-    else
+    //both selections are partial, so compare the bitsets a word at a time
+    const quint64 *this_words = selected_atoms.constData();
+    const quint64 *other_words = selection.selected_atoms.constData();
+    const int nwords = selected_atoms.count();
+    
+    for (int i=0; i<nwords; ++i)
     {
-        QList<CGIdx> cgidxs = selection.selectedCutGroups();
-        
-        foreach (CGIdx i, cgidxs)
-        {
-            if (this->selectedAll(i))
-                return true;
-            else if (selection.selectedAll(i) and not this->selectedNone(i))
-                return true;
-            else if (not this->selectedNone(i))
-            {
-                const QSet<Index> &atoms = *(selected_atoms.find(i));
-                
-                foreach (Index idx, selection.selectedAtoms(i))
-                {
-                    if (atoms.contains(idx))
-                        return true;
-                }
-            }
-        }
+        if (this_words[i] & other_words[i])
+            return true;
     }
     
     return false;
@@ -450,14 +603,12 @@ bool AtomSelection::selectedAllAtoms() const
     one selected atom */
 bool AtomSelection::selectedAllCutGroups() const
 {
-    if (selected_atoms.isEmpty() and nselected > 0)
-        return true;
+    if (selected_atoms.isEmpty())
+        return nselected > 0;
     
     for (CGIdx i(0); i<info().nCutGroups(); ++i)
     {
-        QSet<Index> atoms = selected_atoms.value(i, QSet<Index>());
-        
-        if (atoms.count() < info().nAtoms(i))
+        if (not this->selected(i))
             return false;
     }
     
@@ -655,7 +806,18 @@ bool AtomSelection::selectedAll(AtomIdx atomidx) const
 
 bool AtomSelection::_pvt_selectedAll(CGIdx cgidx) const
 {
-    return nselected != 0 and not selected_atoms.contains(cgidx);
+    if (selected_atoms.isEmpty())
+        return nselected > 0;
+        
+    const QList<AtomIdx> &atoms = d->getAtomsIn(cgidx);
+    
+    for (int i=0; i<atoms.count(); ++i)
+    {
+        if (not this->_pvt_testBit(atoms.at(i)))
+            return false;
+    }
+    
+    return true;
 }
 
 /** Return whether or not all of the atoms in the CutGroup
@@ -787,23 +949,23 @@ QSet<Index> AtomSelection::selectedAtoms(CGIdx cgidx) const
 {
     cgidx = CGIdx( cgidx.map(info().nCutGroups()) );
     
-    if (this->_pvt_selectedAll(cgidx))
-    {
-        QSet<Index> ret;
+    QSet<Index> ret;
     
-        int nats = info().nAtoms(cgidx);
-        
-        ret.reserve(nats);
-        
-        for (Index i(0); i<nats; ++i)
-        {
-            ret.insert(i);
-        }
-        
+    if (nselected == 0)
         return ret;
+    
+    const QList<AtomIdx> &atoms = d->getAtomsIn(cgidx);
+    const bool selected_all = selected_atoms.isEmpty();
+    
+    ret.reserve(atoms.count());
+    
+    for (int i=0; i<atoms.count(); ++i)
+    {
+        if (selected_all or this->_pvt_testBit(atoms.at(i)))
+            ret.insert( Index(i) );
     }
-    else
-        return selected_atoms[cgidx];
+    
+    return ret;
 }
 
 /** Return the list of indicies of CutGroups that contain at least
@@ -825,7 +987,7 @@ QList<CGIdx> AtomSelection::selectedCutGroups() const
 
         for (CGIdx i(0); i<ncg; ++i)
         {
-            if (selectedAll(i) or selected_atoms.value(i).count() > 0)
+            if (this->selected(i))
                 selected_cgroups.append(i);
         }
         
@@ -970,58 +1132,19 @@ bool AtomSelection::selectedAll(const AtomSelection &selection) const
         return true;
     else if (selection.selectedAll())
         return false;
-    else if (selection.selectedAllCutGroups() and not this->selectedAllCutGroups())
+    else if (selection.nSelected() > this->nSelected())
         return false;
             
-    //now do the hard stuff!
-    if (selection.selectedAllCutGroups())
-    {
-        for (CGIdx i(0); i < this->info().nCutGroups(); ++i)
-        {
-            bool selected_all = this->selectedAll(i);
-        
-            if (selection.selectedAll(i) and not selected_all)
-                return false;
-            else if (selection.nSelected(i) > this->nSelected(i))
-                return false;
-            else if (not selected_all)
-            {
-                const QSet<Index> &atoms = *(selected_atoms.find(i));
-            
-                foreach (Index idx, selection.selectedAtoms(i))
-                {
-                    if (not atoms.contains(idx))
-                        return false;
-                }
-            }
-        }
-    }
-    else
+    //both selections are partial - check that no bit in 'selection'
+    //is missing from this selection
+    const quint64 *this_words = selected_atoms.constData();
+    const quint64 *other_words = selection.selected_atoms.constData();
+    const int nwords = selected_atoms.count();
+    
+    for (int i=0; i<nwords; ++i)
     {
-        QList<CGIdx> cgidxs = selection.selectedCutGroups();
-        
-        foreach (CGIdx i, cgidxs)
-        {
-            if (this->selectedNone(i))
-                return false;
-        
-            bool selected_all = this->selectedAll(i);
-            
-            if (selection.selectedAll(i) and not selected_all)
-                return false;
-            else if (selection.nSelected(i) > this->nSelected(i))
-                return false;
-            else
-            {
-                const QSet<Index> &atoms = *(selected_atoms.find(i));
-                
-                foreach (Index idx, selection.selectedAtoms(i))
-                {
-                    if (not atoms.contains(idx))
-                        return false;
-                }
-            }
-        }
+        if (other_words[i] & ~this_words[i])
+            return false;
     }
     
     return true;
@@ -1031,12 +1154,27 @@ bool AtomSelection::selectedAll(const AtomSelection &selection) const
     index 'cgidx' */
 int AtomSelection::nSelected(CGIdx cgidx) const
 {
-    if (this->selectedAll(cgidx))
-        return info().nAtoms(cgidx);
-    else
+    cgidx = CGIdx( cgidx.map(info().nCutGroups()) );
+
+    if (selected_atoms.isEmpty())
+    {
+        if (nselected > 0)
+            return info().nAtoms(cgidx);
+        else
+            return 0;
+    }
+    
+    const QList<AtomIdx> &atoms = d->getAtomsIn(cgidx);
+    
+    int nats = 0;
+    
+    for (int i=0; i<atoms.count(); ++i)
     {
-        return selected_atoms.value( CGIdx(cgidx.map(info().nCutGroups())) ).count();
+        if (this->_pvt_testBit(atoms.at(i)))
+            ++nats;
     }
+    
+    return nats;
 }
 
 /** Return whether the atom at index atomidx has been selected 
@@ -1235,47 +1373,15 @@ int AtomSelection::nSelected(const AtomSelection &selection) const
     else if (this->selectedAll())
         return selection.nSelected();
      
+    const quint64 *this_words = selected_atoms.constData();
+    const quint64 *other_words = selection.selected_atoms.constData();
+    const int nwords = selected_atoms.count();
+     
     int nats = 0;
-              
-    if (selection.selectedAllCutGroups())
+    
+    for (int i=0; i<nwords; ++i)
     {
-        for (CGIdx i(0); i < info().nCutGroups(); ++i)
-        {
-            if (this->selectedAll(i))
-                nats += selection.nSelected(i);
-            else if (selection.selectedAll(i))
-                nats += this->nSelected(i);
-            else if (not this->selectedNone(i))
-            {
-                const QSet<Index> &atoms = *(selected_atoms.find(i));
-            
-                foreach (Index idx, selection.selectedAtoms(i))
-                {
-                    if (atoms.contains(idx))
-                        ++nats;
-                }
-            }
-        }
-    }
-    else
-    {
-        foreach (CGIdx i, selection.selectedCutGroups())
-        {
-            if (this->selectedAll(i))
-                nats += selection.nSelected(i);
-            else if (selection.selectedAll(i))
-                nats += this->nSelected(i);
-            else if (not this->selectedNone(i))
-            {
-                const QSet<Index> &atoms = *(selected_atoms.find(i));
-            
-                foreach (Index idx, selection.selectedAtoms(i))
-                {
-                    if (atoms.contains(idx))
-                        ++nats;
-                }
-            }
-        }
+        nats += countBits(this_words[i] & other_words[i]);
     }
     
     return nats;
@@ -1304,7 +1410,7 @@ int AtomSelection::nSelectedCutGroups() const
         
         for (CGIdx i(0); i<ncgroups; ++i)
         {
-            if (this->_pvt_selectedAll(i) or selected_atoms.value(i).count() > 0)
+            if (this->selected(i))
                 ++nselected_cgroups;
         }
     
@@ -1439,41 +1545,7 @@ AtomSelection& AtomSelection::selectNone()
 
 void AtomSelection::_pvt_select(const CGAtomIdx &cgatomidx)
 {
-    if (this->_pvt_selected(cgatomidx))
-        return;
-        
-    if (this->selectedNone())
-    {
-        //we are selecting the first atom in the molecule...
-        int ncg = info().nCutGroups();
-        
-        //create space for all of the atoms in all of the CutGroups
-        selected_atoms.reserve(ncg);
-        
-        for (CGIdx i(0); i<ncg; ++i)
-        {
-            int nats = info().nAtoms(i);
-            
-            BOOST_ASSERT(nats > 0);
-        
-            selected_atoms.insert(i, QSet<Index>())
-                          .value().reserve( nats-1 );
-        }
-    }
-        
-    QSet<Index> &atoms = selected_atoms[cgatomidx.cutGroup()];
-        
-    if (atoms.count() == info().nAtoms(cgatomidx.cutGroup()) - 1)
-    {
-        //we've just selected the last atom in this CutGroup
-        selected_atoms.remove(cgatomidx.cutGroup());
-    }
-    else
-    {
-        selected_atoms[cgatomidx.cutGroup()].insert(cgatomidx.atom());
-    }
-    
-    ++nselected;
+    this->_pvt_select( info().atomIdx(cgatomidx) );
 }
 
 void AtomSelection::_pvt_select(const QVector<CGAtomIdx> &cgatomidxs)
@@ -1503,7 +1575,15 @@ void AtomSelection::_pvt_select(CGIdx cgidx, const QSet<Index> &atoms)
 
 void AtomSelection::_pvt_select(AtomIdx atomidx)
 {
-    this->_pvt_select( info().cgAtomIdx(atomidx) );
+    atomidx = AtomIdx( atomidx.map(info().nAtoms()) );
+
+    if (this->selectedAll())
+        return;
+        
+    this->_pvt_expand();
+    
+    if (this->_pvt_setBit(atomidx))
+        this->_pvt_compress();
 }
 
 /** Select the atom at index 'atomidx' 
@@ -1518,39 +1598,7 @@ AtomSelection& AtomSelection::select(AtomIdx atomidx)
 
 void AtomSelection::_pvt_deselect(const CGAtomIdx &cgatomidx)
 {
-    if (not this->selected(cgatomidx))
-        return;
-    
-    else if (nselected == 1)
-    {
-        //we have just removed the last selected atom
-        selected_atoms.clear();
-        nselected = 0;
-        return;
-    }
-    
-    if ( this->selectedAll(cgatomidx.cutGroup()) )
-    {
-        //we need to recreate space for this CutGroup
-        int nats = info().nAtoms(cgatomidx.cutGroup());
-        
-        QSet<Index> atoms;
-        atoms.reserve(nats-1);
-        
-        for (Index i(0); i<nats; ++i)
-        {
-            if (i != cgatomidx.atom())
-                atoms.insert(i);
-        }
-        
-        selected_atoms.insert(cgatomidx.cutGroup(), atoms);
-    }
-    else
-    {
-        selected_atoms[cgatomidx.cutGroup()].remove(cgatomidx.atom());
-    }
-    
-    --nselected;
+    this->_pvt_deselect( info().atomIdx(cgatomidx) );
 }
 
 void AtomSelection::_pvt_deselect(const QVector<CGAtomIdx> &cgatomidxs)
@@ -1569,7 +1617,15 @@ void AtomSelection::_pvt_deselect(const QVector<CGAtomIdx> &cgatomidxs)
 
 void AtomSelection::_pvt_deselect(AtomIdx atomidx)
 {
-    this->_pvt_deselect( info().cgAtomIdx(atomidx) );
+    atomidx = AtomIdx( atomidx.map(info().nAtoms()) );
+
+    if (this->selectedNone())
+        return;
+        
+    this->_pvt_expand();
+    
+    if (this->_pvt_clearBit(atomidx))
+        this->_pvt_compress();
 }
 
 /** Deselect the atom at index 'atomidx' 
@@ -1594,75 +1650,40 @@ AtomSelection& AtomSelection::selectOnly(AtomIdx atomidx)
 
 void AtomSelection::_pvt_select(CGIdx cgidx)
 {
-    if (this->selectedAll(cgidx))
+    cgidx = CGIdx( cgidx.map(info().nCutGroups()) );
+
+    if (this->selectedAll())
         return;
+        
+    this->_pvt_expand();
     
-    else if (this->selectedNone())
+    const QList<AtomIdx> &atoms = info().getAtomsIn(cgidx);
+    
+    for (int i=0; i<atoms.count(); ++i)
     {
-        if (info().nCutGroups() == 1)
-            nselected = info().nAtoms();
-            
-        else
-        {
-            //we are selecting the first CutGroup in the molecule...
-            int ncg = info().nCutGroups();
-        
-            //create space for all of the atoms in all of the CutGroups
-            selected_atoms.reserve(ncg);
-        
-            for (CGIdx i(0); i<ncg; ++i)
-            {
-                if (i != cgidx)
-                {
-                    int nats = info().nAtoms(i);
-            
-                    BOOST_ASSERT(nats > 0);
-        
-                    selected_atoms.insert(i, QSet<Index>())
-                                  .value().reserve( nats-1 );
-                }
-            }
-            
-            nselected = info().nAtoms(cgidx);
-        }
+        this->_pvt_setBit(atoms.at(i));
     }
-    else
-    {
-        QSet<Index> atoms = selected_atoms.take(cgidx);
     
-        if (selected_atoms.isEmpty())
-        {
-            selected_atoms.clear();
-            nselected = info().nAtoms();
-        }
-        else    
-            nselected += info().nAtoms(cgidx) - atoms.count();
-    }
+    this->_pvt_compress();
 }
 
 void AtomSelection::_pvt_deselect(CGIdx cgidx)
 {
-    if (this->selectedNone(cgidx))
+    cgidx = CGIdx( cgidx.map(info().nCutGroups()) );
+
+    if (this->selectedNone())
         return;
-    
-    else if (this->selectedAll(cgidx))
-    {
-        QSet<Index> atoms;
-        int nats = info().nAtoms(cgidx);
-        
-        atoms.reserve(nats-1);
-        selected_atoms.insert(cgidx, atoms);
         
-        nselected -= nats;
-    }
-    else
+    this->_pvt_expand();
+    
+    const QList<AtomIdx> &atoms = info().getAtomsIn(cgidx);
+    
+    for (int i=0; i<atoms.count(); ++i)
     {
-        QSet<Index> &atoms = selected_atoms[cgidx];
-        
-        nselected -= atoms.count();
-        
-        atoms.clear();
+        this->_pvt_clearBit(atoms.at(i));
     }
+    
+    this->_pvt_compress();
 }
 
 /** Select the CutGroup at index 'cgidx'
@@ -2380,47 +2401,27 @@ void AtomSelection::_pvt_select(const AtomSelection &selection)
 
     info().assertEqualTo(selection.info());
     
-    if (this->selectedAll())
+    if (this->selectedAll() or selection.selectedNone())
         return;
-    else if (selection.selectedAll())
+    else if (this->selectedNone() or selection.selectedAll())
     {
-        selected_atoms.clear();
-        nselected = info().nAtoms();
+        selected_atoms = selection.selected_atoms;
+        nselected = selection.nselected;
         return;
     }
     
-    if (selection.selectedAllCutGroups())
-    {
-        int ncg = info().nCutGroups();
-        
-        for (CGIdx i(0); i<ncg; ++i)
-        {
-            if (selection.selectedAll(i))
-                this->_pvt_select(i);
-            else if (not this->selectedAll(i))
-            {
-                foreach (Index idx, selection.selectedAtoms(i))
-                {
-                    this->_pvt_select( CGAtomIdx(i,idx) );
-                }
-            }
-        }
-    }
-    else
+    //both selections are partial, so unite the bitsets
+    quint64 *this_words = selected_atoms.data();
+    const quint64 *other_words = selection.selected_atoms.constData();
+    const int nwords = selected_atoms.count();
+    
+    for (int i=0; i<nwords; ++i)
     {
-        foreach (CGIdx i, selection.selectedCutGroups())
-        {
-            if (selection.selectedAll(i))
-                this->_pvt_select(i);
-            else if (this->selectedAll(i))
-            {
-                foreach(Index idx, selection.selectedAtoms(i))
-                {
-                    this->_pvt_select( CGAtomIdx(i,idx) );
-                }
-            }
-        }
+        this_words[i] |= other_words[i];
     }
+    
+    this->_pvt_recount();
+    this->_pvt_compress();
 }
 
 /** Select all of the atoms in 'selection'
@@ -2442,51 +2443,25 @@ AtomSelection& AtomSelection::deselect(const AtomSelection &selection)
 {
     info().assertEqualTo(selection.info());
     
-    if (this->selectedNone())
+    if (this->selectedNone() or selection.selectedNone())
         return *this;
     else if (selection.selectedAll())
-    {
-        this->deselectAll();
-        return *this;
-    }
+        return this->deselectAll();
     
-    if (selection.selectedAllCutGroups())
-    {
-        int ncg = info().nCutGroups();
-        
-        for (CGIdx i(0); i<ncg; ++i)
-        {
-            if (selection.selectedAll(i))
-            {
-                this->_pvt_deselect(i);
-            }
-            else if (not this->selectedNone(i))
-            {
-                foreach (Index idx, selection.selectedAtoms(i))
-                {
-                    this->_pvt_deselect( CGAtomIdx(i,idx) );
-                }
-            }
-        }
-    }
-    else
+    this->_pvt_expand();
+    
+    quint64 *this_words = selected_atoms.data();
+    const quint64 *other_words = selection.selected_atoms.constData();
+    const int nwords = selected_atoms.count();
+    
+    for (int i=0; i<nwords; ++i)
     {
-        foreach (CGIdx i, selection.selectedCutGroups())
-        {
-            if (selection.selectedAll(i))
-            {
-                this->_pvt_deselect(i);
-            }
-            else if (not this->selectedNone(i))
-            {
-                foreach (Index idx, selection.selectedAtoms(i))
-                {
-                    this->_pvt_deselect( CGAtomIdx(i,idx) );
-                }
-            }
-        }
+        this_words[i] &= ~other_words[i];
     }
     
+    this->_pvt_recount();
+    this->_pvt_compress();
+    
     return *this;
 }
 
@@ -2512,27 +2487,18 @@ AtomSelection& AtomSelection::invert()
     else if (this->selectedNone())
         return this->selectAll();
         
-    for (CGIdx i(0); i<info().nCutGroups(); ++i)
+    quint64 *words = selected_atoms.data();
+    const int nwords = selected_atoms.count();
+    
+    for (int i=0; i<nwords; ++i)
     {
-        if (this->selectedAll(i))
-            this->_pvt_deselect(i);
-        else if (this->selectedNone(i))
-            this->_pvt_select(i);
-        else
-        {
-            QSet<Index> atoms = this->selectedAtoms(i);
-            int nats = info().nAtoms(i);
-
-            this->_pvt_deselect(i);
-            
-            for (Index j(0); j<nats; ++j)
-            {
-                if (not atoms.contains(j))
-                    this->_pvt_select( CGAtomIdx(i,j) );
-            }
-        }
+        words[i] = ~words[i];
     }
     
+    words[nwords-1] &= lastWordMask(info().nAtoms());
+    
+    nselected = info().nAtoms() - nselected;
+    
     return *this;
 }
 
@@ -2776,95 +2742,30 @@ AtomSelection& AtomSelection::intersect(const AtomSelection &other)
     info().assertEqualTo(other.info());
 
     if (this->selectedNone() or other.selectedNone())
-    {
         return this->selectNone();
-    }
-    else if (this->selectedAll() and other.selectedAll())
+    else if (other.selectedAll())
+        return *this;
+    else if (this->selectedAll())
     {
+        selected_atoms = other.selected_atoms;
+        nselected = other.nselected;
         return *this;
     }
-    else
-    {
-        if (this->selectedAllCutGroups() and other.selectedAllCutGroups())
-        {
-            int ncg = info().nCutGroups();
-            
-            for (CGIdx i(0); i<ncg; ++i)
-            {
-                bool this_all = this->selectedAll(i);
-                bool other_all = other.selectedAll(i);
-            
-                if (this_all and other_all)
-                {
-                    //nothing to do
-                    continue;
-                }
-                else if (this_all)
-                {
-                    this->_pvt_deselect(i);
-                    this->_pvt_select(i, other.selectedAtoms(i));
-                }
-                else if (other_all)
-                {
-                    //nothing to do
-                    continue;
-                }
-                else
-                {
-                    QSet<Index> atoms = this->selectedAtoms(i);
-                    atoms.intersect(other.selectedAtoms(i));
 
-                    this->_pvt_deselect(i);
-                    this->_pvt_select(i, atoms);
-                } 
-            }
-        }
-        else
-        {
-            QSet<CGIdx> cgidxs = this->selectedCutGroups().toSet();
-            cgidxs.intersect( other.selectedCutGroups().toSet() );
-            
-            int ncg = info().nCutGroups();
-            
-            for (CGIdx i(0); i<ncg; ++i)
-            {
-                if (not cgidxs.contains(i))
-                {
-                    this->_pvt_deselect(i);
-                    continue;
-                }
-            
-                bool this_all = this->selectedAll(i);
-                bool other_all = other.selectedAll(i);
-            
-                if (this_all and other_all)
-                {
-                    //nothing to do
-                    continue;
-                }
-                else if (this_all)
-                {
-                    this->deselect(i);
-                    this->_pvt_select(i, other.selectedAtoms(i));
-                }
-                else if (other_all)
-                {
-                    //nothing to do
-                    continue;
-                }
-                else
-                {
-                    QSet<Index> atoms = this->selectedAtoms(i);
-                    atoms.intersect(other.selectedAtoms(i));
-                    
-                    this->_pvt_deselect(i);
-                    this->_pvt_select(i, atoms);
-                } 
-            }
-        }
-        
-        return *this;
+    //both selections are partial, so intersect the bitsets
+    quint64 *this_words = selected_atoms.data();
+    const quint64 *other_words = other.selected_atoms.constData();
+    const int nwords = selected_atoms.count();
+    
+    for (int i=0; i<nwords; ++i)
+    {
+        this_words[i] &= other_words[i];
     }
+    
+    this->_pvt_recount();
+    this->_pvt_compress();
+    
+    return *this;
 }
 
 /** Intersect this selection with the index 'atomidx'
@@ -3599,57 +3500,28 @@ QVector<AtomIdx> AtomSelection::selectedAtoms() const
             ret_array[i] = i;
         }
     }
-    else if (this->selectedAllCutGroups())
-    {
-        int count = 0;
-        
-        for (CGIdx i(0); i<info().nCutGroups(); ++i)
-        {
-            if (this->selectedAll(i))
-            {
-                for (Index j(0); j<info().nAtoms(i); ++i)
-                {
-                    ret_array[count] = info().atomIdx(CGAtomIdx(i,j));
-                    ++count;
-                }
-            }
-            else
-            {
-                foreach (Index j, this->selectedAtoms(i))
-                {
-                    ret_array[count] = info().atomIdx(CGAtomIdx(i,j));
-                    ++count;
-                }
-            }
-        }
-    }
     else
     {
+        //walk the set bits - this returns the atoms already sorted
+        const quint64 *words = selected_atoms.constData();
+        const int nwords = selected_atoms.count();
+        
         int count = 0;
-    
-        foreach (CGIdx i, this->selectedCutGroups())
+        
+        for (int i=0; i<nwords; ++i)
         {
-            if (this->selectedAll(i))
-            {
-                for (Index j(0); j<info().nAtoms(i); ++j)
-                {
-                    ret_array[count] = info().atomIdx(CGAtomIdx(i,j));
-                    ++count;
-                }
-            }
-            else
+            quint64 word = words[i];
+            
+            while (word)
             {
-                foreach (Index j, this->selectedAtoms(i))
-                {
-                    ret_array[count] = info().atomIdx(CGAtomIdx(i,j));
-                    ++count;
-                }
+                ret_array[count] = AtomIdx( 64*i + lowestBit(word) );
+                ++count;
+                
+                word &= word - 1;
             }
         }
     }
 
-    qSort(ret);
-    
     return ret;
 }
 
@@ -31,6 +31,7 @@
 
 #include <QSet>
 #include <QHash>
+#include <QVector>
 
 #include "molviewproperty.h"
 
@@ -480,8 +481,19 @@ private:
     template<class IDXS>
     void _pvt_deselectAtoms(const IDXS &atoms);
 
-    /** The indicies of selected atoms, arranged by CGIdx */
-    QHash< CGIdx, QSet<Index> > selected_atoms;
+    bool _pvt_testBit(int atomidx) const;
+    bool _pvt_setBit(int atomidx);
+    bool _pvt_clearBit(int atomidx);
+
+    void _pvt_expand();
+    void _pvt_compress();
+    void _pvt_recount();
+
+    /** Bitset of the selected atoms, indexed by AtomIdx (64 atoms
+        per word). This is empty if either all or none of the atoms
+        are selected (nselected distinguishes between the two), and
+        is only populated when part of the molecule is selected */
+    QVector<quint64> selected_atoms;
 
     /** The MoleculeInfo describing the molecule whose parts
         are being selected by this object */
@@ -28,9 +28,13 @@
 
 #include <QDataStream>
 #include <QElapsedTimer>
+#include <QMutex>
 
 #include <boost/assert.hpp>
 
+#include <algorithm>
+#include <vector>
+
 #include "atomselection.h"
 #include "connectivity.h"
 #include "moleculedata.h"
@@ -56,6 +60,212 @@ using namespace SireStream;
 using namespace SireMol;
 using namespace SireBase;
 
+/////////
+///////// Implementation of detail::ConnectivityTables
+/////////
+
+namespace SireMol
+{
+namespace detail
+{
+
+/** This is a compressed sparse row (CSR) table of the neighbours
+    of each atom. The neighbours of atom 'i' are held, in ascending
+    order, in atoms[offsets[i]] to atoms[offsets[i+1]-1] */
+class NeighbourTable
+{
+public:
+    NeighbourTable()
+    {}
+
+    ~NeighbourTable()
+    {}
+
+    /** Return the number of neighbours of atom 'atom' */
+    int count(int atom) const
+    {
+        return offsets.constData()[atom+1] - offsets.constData()[atom];
+    }
+
+    /** Return a pointer to the first neighbour of 'atom' */
+    const qint32* begin(int atom) const
+    {
+        return atoms.constData() + offsets.constData()[atom];
+    }
+
+    /** Return a pointer to one past the last neighbour of 'atom' */
+    const qint32* end(int atom) const
+    {
+        return atoms.constData() + offsets.constData()[atom+1];
+    }
+
+    /** Return whether or not 'atom1' is a neighbour of 'atom0' */
+    bool contains(int atom0, int atom1) const
+    {
+        return std::binary_search(this->begin(atom0), this->end(atom0), atom1);
+    }
+
+    /** Append the (unsorted, possibly duplicated) neighbours in 'neighbours'
+        as the neighbours of the next atom */
+    void append(std::vector<qint32> &neighbours)
+    {
+        std::sort(neighbours.begin(), neighbours.end());
+        
+        std::vector<qint32>::iterator last = std::unique(neighbours.begin(),
+                                                         neighbours.end());
+        
+        for (std::vector<qint32>::const_iterator it = neighbours.begin();
+             it != last;
+             ++it)
+        {
+            atoms.append(*it);
+        }
+        
+        offsets.append(atoms.count());
+    }
+
+    void squeeze()
+    {
+        offsets.squeeze();
+        atoms.squeeze();
+    }
+
+    /** The index into 'atoms' of the first neighbour of each atom */
+    QVector<qint32> offsets;
+    
+    /** The neighbours of all of the atoms */
+    QVector<qint32> atoms;
+};
+
+/** This class holds the 1-2, 1-3 and 1-4 neighbour tables of a
+    Connectivity, so that bonded/angled/dihedraled queries are a 
+    binary search over a few contiguous integers rather than a
+    walk over the connection sets. It also memoises the result
+    of splitting the molecule about each bond. A ConnectivityTables
+    is shared between copies of the (immutable) Connectivity
+    
+    @author Christopher Woods
+*/
+class ConnectivityTables
+{
+public:
+    ConnectivityTables(const QVector< QSet<AtomIdx> > &connected_atoms);
+    ~ConnectivityTables();
+
+    static quint64 splitKey(AtomIdx atom0, AtomIdx atom1);
+
+    /** The atoms that are bonded to each atom */
+    NeighbourTable bonded;
+    
+    /** The atoms that are angled to each atom (share a bonded atom) */
+    NeighbourTable angled;
+    
+    /** The atoms that are dihedraled to each atom */
+    NeighbourTable dihedraled;
+
+    /** Mutex used to protect access to the split cache */
+    QMutex split_mutex;
+
+    /** The cached results of splitting the molecule about each bond,
+        indexed by splitKey(atom0,atom1) with atom0 < atom1 */
+    QHash< quint64,tuple<AtomSelection,AtomSelection> > splits;
+};
+
+} // end of namespace detail
+} // end of namespace SireMol
+
+using namespace SireMol::detail;
+
+/** The maximum number of split bonds to cache. Each split holds two
+    AtomSelections, so this bounds the memory used for large molecules */
+static const int MAX_CACHED_SPLITS = 1024;
+
+/** Build the neighbour tables from the passed connections */
+ConnectivityTables::ConnectivityTables(const QVector< QSet<AtomIdx> > &connected_atoms)
+{
+    const int nats = connected_atoms.count();
+    const QSet<AtomIdx> *connected_atoms_array = connected_atoms.constData();
+
+    std::vector<qint32> neighbours;
+
+    //the 1-2 table comes straight from the connections
+    bonded.offsets.reserve(nats+1);
+    bonded.offsets.append(0);
+
+    for (int i=0; i<nats; ++i)
+    {
+        neighbours.clear();
+    
+        foreach (const AtomIdx &atom, connected_atoms_array[i])
+        {
+            neighbours.push_back(atom.value());
+        }
+        
+        bonded.append(neighbours);
+    }
+    
+    //the 1-3 table holds atoms k != i where i-j-k
+    angled.offsets.reserve(nats+1);
+    angled.offsets.append(0);
+    
+    for (int i=0; i<nats; ++i)
+    {
+        neighbours.clear();
+    
+        for (const qint32 *j = bonded.begin(i); j != bonded.end(i); ++j)
+        {
+            for (const qint32 *k = bonded.begin(*j); k != bonded.end(*j); ++k)
+            {
+                if (*k != i)
+                    neighbours.push_back(*k);
+            }
+        }
+        
+        angled.append(neighbours);
+    }
+    
+    //the 1-4 table holds atoms l where i-j-k-l, with k != i, l != j and l != i
+    dihedraled.offsets.reserve(nats+1);
+    dihedraled.offsets.append(0);
+    
+    for (int i=0; i<nats; ++i)
+    {
+        neighbours.clear();
+        
+        for (const qint32 *j = bonded.begin(i); j != bonded.end(i); ++j)
+        {
+            for (const qint32 *k = bonded.begin(*j); k != bonded.end(*j); ++k)
+            {
+                if (*k == i)
+                    continue;
+                    
+                for (const qint32 *l = bonded.begin(*k); l != bonded.end(*k); ++l)
+                {
+                    if (*l != *j and *l != i)
+                        neighbours.push_back(*l);
+                }
+            }
+        }
+        
+        dihedraled.append(neighbours);
+    }
+    
+    bonded.squeeze();
+    angled.squeeze();
+    dihedraled.squeeze();
+}
+
+/** Destructor */
+ConnectivityTables::~ConnectivityTables()
+{}
+
+/** Return the key used to cache the split about the bond atom0-atom1.
+    This requires that atom0 < atom1 */
+quint64 ConnectivityTables::splitKey(AtomIdx atom0, AtomIdx atom1)
+{
+    return (quint64(quint32(atom0.value())) << 32) | quint64(quint32(atom1.value()));
+}
+
 /////////
 ///////// Implementation of ConnectivityBase
 /////////
@@ -90,6 +300,8 @@ QDataStream SIREMOL_EXPORT &operator>>(QDataStream &ds,
         sds >> conbase.connected_atoms >> conbase.connected_res
             >> conbase.d
             >> static_cast<MolViewProperty&>(conbase);
+            
+        conbase.tables.reset();
     }
     else if (v == 1)
     {
@@ -98,6 +310,8 @@ QDataStream SIREMOL_EXPORT &operator>>(QDataStream &ds,
         sds >> conbase.connected_atoms >> conbase.connected_res
             >> conbase.d
             >> static_cast<Property&>(conbase);
+            
+        conbase.tables.reset();
     }
     else
         throw version_error(v, "1,2", r_conbase, CODELOC);
@@ -148,7 +362,7 @@ ConnectivityBase::ConnectivityBase(const ConnectivityBase &other)
                  : MolViewProperty(other),
                    connected_atoms(other.connected_atoms),
                    connected_res(other.connected_res),
-                   d(other.d)
+                   d(other.d), tables(other.tables)
 {}
 
 /** Destructor */
@@ -163,6 +377,7 @@ ConnectivityBase& ConnectivityBase::operator=(const ConnectivityBase &other)
         connected_atoms = other.connected_atoms;
         connected_res = other.connected_res;
         d = other.d;
+        tables = other.tables;
     }
     
     return *this;
@@ -200,6 +415,7 @@ PropertyPtr ConnectivityBase::_pvt_makeCompatibleWith(const MoleculeInfoData &mo
             ret.connected_atoms = connected_atoms;
             ret.connected_res = connected_res;
             ret.d = molinfo;
+            ret.buildTables();
             return ret;
         }
 
@@ -490,7 +706,15 @@ bool ConnectivityBase::areConnected(const AtomID &atom0, const AtomID &atom1) co
 /** Return whether or not the two atoms are bonded together */
 bool ConnectivityBase::areBonded(AtomIdx atom0, AtomIdx atom1) const
 {
-    return areConnected(atom0, atom1);
+    if (tables.get() != 0)
+    {
+        atom0 = AtomIdx( atom0.map(connected_atoms.count()) );
+        atom1 = AtomIdx( atom1.map(connected_atoms.count()) );
+        
+        return tables->bonded.contains(atom0, atom1);
+    }
+    else
+        return areConnected(atom0, atom1);
 }
 
 /** Return whether or not the two atoms are angled together */
@@ -502,6 +726,9 @@ bool ConnectivityBase::areAngled(AtomIdx atom0, AtomIdx atom2) const
     if (atom0 == atom2)
         return false;
 
+    if (tables.get() != 0)
+        return tables->angled.contains(atom0, atom2);
+
     foreach (const AtomIdx &atom1, connected_atoms[atom0.value()])
     {
         if (connected_atoms[atom2.value()].contains(atom1))
@@ -520,6 +747,9 @@ bool ConnectivityBase::areDihedraled(AtomIdx atom0, AtomIdx atom3) const
     if (atom0 == atom3)
         return false;
     
+    if (tables.get() != 0)
+        return tables->dihedraled.contains(atom0, atom3);
+    
     foreach (const AtomIdx &atom1, connected_atoms[atom0.value()])
     {
         if (atom1.value() != atom3.value())
@@ -648,20 +878,73 @@ QList< QList<AtomIdx> > ConnectivityBase::findPaths(AtomIdx atom0, AtomIdx atom1
     list if there is no bonded path between these two atoms */
 QList<AtomIdx> ConnectivityBase::findPath(AtomIdx atom0, AtomIdx atom1) const
 {
-    QList< QList<AtomIdx> > paths = findPaths(atom0, atom1);
+    const int nats = d->nAtoms();
+
+    atom0 = atom0.map(nats);
+    atom1 = atom1.map(nats);
+    
+    if (atom0 == atom1)
+        return QList<AtomIdx>();
+    
+    //breadth first search from atom0, recording the atom from which
+    //each atom was first reached - the first time atom1 is reached
+    //is along a shortest path
+    QVector<qint32> parent(nats, -1);
+    qint32 *parent_array = parent.data();
+    
+    QVector<qint32> queue;
+    queue.reserve(nats);
     
-    QList<AtomIdx> shortest;
+    queue.append(atom0);
+    parent_array[atom0] = atom0;
     
-    foreach (const QList<AtomIdx> &path, paths)
+    for (int head = 0; head < queue.count(); ++head)
     {
-        if (shortest.isEmpty())
-            shortest = path;
+        const qint32 atom = queue.at(head);
         
-        else if (shortest.count() > path.count())
-            shortest = path;
+        if (atom == atom1)
+            break;
+        
+        if (tables.get() != 0)
+        {
+            for (const qint32 *it = tables->bonded.begin(atom);
+                 it != tables->bonded.end(atom);
+                 ++it)
+            {
+                if (parent_array[*it] == -1)
+                {
+                    parent_array[*it] = atom;
+                    queue.append(*it);
+                }
+            }
+        }
+        else
+        {
+            foreach (const AtomIdx &bonded_atom, this->_pvt_connectedTo(AtomIdx(atom)))
+            {
+                if (parent_array[bonded_atom] == -1)
+                {
+                    parent_array[bonded_atom] = atom;
+                    queue.append(bonded_atom);
+                }
+            }
+        }
     }
     
-    return shortest;
+    QList<AtomIdx> path;
+    
+    if (parent_array[atom1] == -1)
+        //there is no path between the atoms
+        return path;
+    
+    for (qint32 atom = atom1; atom != atom0; atom = parent_array[atom])
+    {
+        path.prepend( AtomIdx(atom) );
+    }
+    
+    path.prepend(atom0);
+    
+    return path;
 }
 
 /** Return all possible bonded paths between two atoms. This returns an empty
@@ -922,6 +1205,63 @@ ConnectivityBase::selectGroups(const QSet<AtomIdx> &group0,
 */   
 tuple<AtomSelection,AtomSelection> 
 ConnectivityBase::split(AtomIdx atom0, AtomIdx atom1) const
+{
+    if (tables.get() == 0)
+        return this->_pvt_split(atom0, atom1);
+
+    int nats = d->nAtoms();
+    atom0 = atom0.map(nats);
+    atom1 = atom1.map(nats);
+
+    //the cache holds the split with the lower index atom first
+    const bool swapped = (atom1 < atom0);
+    
+    const quint64 key = swapped ? ConnectivityTables::splitKey(atom1, atom0) :
+                                  ConnectivityTables::splitKey(atom0, atom1);
+    
+    tuple<AtomSelection,AtomSelection> groups;
+    bool found = false;
+    
+    {
+        QMutexLocker lkr( &(tables->split_mutex) );
+        
+        QHash< quint64,tuple<AtomSelection,AtomSelection> >::const_iterator
+                                                it = tables->splits.constFind(key);
+        
+        if (it != tables->splits.constEnd())
+        {
+            groups = it.value();
+            found = true;
+        }
+    }
+    
+    if (not found)
+    {
+        //this bond has not been split before (ring_errors are
+        //not cached, so will be raised again the next time)
+        if (swapped)
+            groups = this->_pvt_split(atom1, atom0);
+        else
+            groups = this->_pvt_split(atom0, atom1);
+        
+        QMutexLocker lkr( &(tables->split_mutex) );
+        
+        if (tables->splits.count() >= MAX_CACHED_SPLITS)
+            tables->splits.clear();
+        
+        tables->splits.insert(key, groups);
+    }
+    
+    if (swapped)
+        return tuple<AtomSelection,AtomSelection>(groups.get<1>(), groups.get<0>());
+    else
+        return groups;
+}
+
+/** Internal function used to split the molecule about the bond
+    between atom0 and atom1, without using the split cache */
+tuple<AtomSelection,AtomSelection> 
+ConnectivityBase::_pvt_split(AtomIdx atom0, AtomIdx atom1) const
 {
     QSet<AtomIdx> group0, group1;
     QSet<AtomIdx> root0, root1;
@@ -1010,7 +1350,7 @@ ConnectivityBase::split(AtomIdx atom0, AtomIdx atom1) const
         group0 = group1 = root0 = root1 = QSet<AtomIdx>();
         
         //split the molecule again, with the ring bonds now broken
-        return editor.commit().split(atom0, atom1);
+        return editor.commit()._pvt_split(atom0, atom1);
     }
     else
     {
@@ -1174,7 +1514,7 @@ ConnectivityBase::split(AtomIdx atom0, AtomIdx atom1,
         group0 = group1 = root0 = root1 = QSet<AtomIdx>();
         
         //split the molecule again, with the ring bonds now broken
-        return editor.commit().split(atom0, atom1);
+        return editor.commit()._pvt_split(atom0, atom1);
     }
     else
         return this->selectGroups(group0, group1);
@@ -1971,23 +2311,23 @@ ConnectivityBase::split(const ImproperID &improper,
 /** Return the list of bonds present in this connectivity*/
 QList<BondID> ConnectivityBase::getBonds() const
 {
-  QList<BondID> bonds;
-  int nats = connected_atoms.count();
-  for (int i=0; i < nats; ++i)
+    QList<BondID> bonds;
+    int nats = connected_atoms.count();
+
+    for (int i=0; i < nats; ++i)
     {
-      AtomIdx atomidx = AtomIdx(i);
-      QSet<AtomIdx> neighbors = this->connectionsTo(atomidx);
-      foreach (AtomIdx neighbor, neighbors)
-	{
-	  // Do not add the bond to the list if already found. Note that we 
-	  // have to check if the bond has been defined in reverse order too
-	  // and we do that using the mirror() method
-	  BondID bond = BondID(atomidx, neighbor);
-	  if ( not ( bonds.contains(bond) or bonds.contains(bond.mirror()) ) )
-	    bonds.append(bond);
-	}
+        AtomIdx atomidx = AtomIdx(i);
+
+        foreach (AtomIdx neighbor, this->connectionsTo(atomidx))
+        {
+            // Only add each bond once, in the order in which it is
+            // first found (from the lower index atom)
+            if (atomidx < neighbor)
+                bonds.append( BondID(atomidx, neighbor) );
+        }
     }
-  return bonds;
+
+    return bonds;
 }
 /** Return the list of bonds in the connectivity containing atom */
 QList<BondID> ConnectivityBase::getBonds(const AtomID &atom) const
@@ -2012,25 +2352,26 @@ QList<BondID> ConnectivityBase::getBonds(const AtomID &atom) const
 /** Return a list of angles defined by the connectivity*/
 QList<AngleID> ConnectivityBase::getAngles() const
 {
-  QList<AngleID> angles;
-  int nats = connected_atoms.count();
-  for (int i=0; i < nats; ++i)
+    QList<AngleID> angles;
+    int nats = connected_atoms.count();
+
+    for (int i=0; i < nats; ++i)
     {
-      AtomIdx atom0idx = AtomIdx(i);
-      foreach (AtomIdx atom1idx, this->connectionsTo(atom0idx))
-	{
-	  foreach (AtomIdx atom2idx, this->connectionsTo(atom1idx))
-	    {
-	      if (atom2idx != atom0idx)
-		{
-		  AngleID angle = AngleID( atom0idx, atom1idx, atom2idx );
-		  if ( not ( angles.contains(angle) or angles.contains(angle.mirror()) ) ) 
-		    angles.append(angle);
-		}
-	    }
-	}
+        AtomIdx atom0idx = AtomIdx(i);
+
+        foreach (AtomIdx atom1idx, this->connectionsTo(atom0idx))
+        {
+            foreach (AtomIdx atom2idx, this->connectionsTo(atom1idx))
+            {
+                // Only add each angle once (the mirror angle is found
+                // from atom2, so keep the one with the lower index first atom)
+                if (atom0idx < atom2idx)
+                    angles.append( AngleID(atom0idx, atom1idx, atom2idx) );
+            }
+        }
     }
-  return angles;
+
+    return angles;
 }
 /** Return a list of angles defined by the connectivity that involve atom0 and atom1*/
 QList<AngleID> ConnectivityBase::getAngles(const AtomID &atom0, const AtomID &atom1) const
@@ -2094,31 +2435,39 @@ QList<AngleID> ConnectivityBase::getAngles(const AtomID &atom0) const
 /** Return a list of dihedrals defined by the connectivity*/
 QList<DihedralID> ConnectivityBase::getDihedrals() const
 {
-  QList<DihedralID> dihedrals;
-  int nats = connected_atoms.count();
-  for (int i=0; i < nats ; ++i)
+    QList<DihedralID> dihedrals;
+    int nats = connected_atoms.count();
+
+    for (int i=0; i < nats; ++i)
     {
-      AtomIdx atom0idx = AtomIdx(i);
-      foreach (AtomIdx atom1idx, this->connectionsTo(atom0idx))
-	{
-	  foreach (AtomIdx atom2idx, this->connectionsTo(atom1idx))
-	    {
-	      if (atom2idx != atom0idx)
-		{
-		  foreach (AtomIdx atom3idx, this->connectionsTo(atom2idx))
-		    {
-		      if (atom3idx != atom1idx)
-			{
-			  DihedralID dihedral = DihedralID( atom0idx, atom1idx, atom2idx, atom3idx);
-			  if ( not ( dihedrals.contains(dihedral) or dihedrals.contains(dihedral.mirror()) ) )
-			    dihedrals.append(dihedral);
-			}
-		    } 
-		}
-	    }
-	}
+        AtomIdx atom0idx = AtomIdx(i);
+
+        foreach (AtomIdx atom1idx, this->connectionsTo(atom0idx))
+        {
+            foreach (AtomIdx atom2idx, this->connectionsTo(atom1idx))
+            {
+                if (atom2idx == atom0idx)
+                    continue;
+
+                foreach (AtomIdx atom3idx, this->connectionsTo(atom2idx))
+                {
+                    // Only add each dihedral once - the mirror dihedral is 
+                    // found from atom3, so keep the one with the lower index
+                    // first atom (or, for three-membered rings where atom0 
+                    // and atom3 are the same, the lower index second atom)
+                    if ( atom3idx != atom1idx and
+                         ( atom0idx < atom3idx or 
+                           (atom0idx == atom3idx and atom1idx < atom2idx) ) )
+                    {
+                        dihedrals.append( DihedralID(atom0idx, atom1idx,
+                                                     atom2idx, atom3idx) );
+                    }
+                }
+            }
+        }
     }
-  return dihedrals;
+
+    return dihedrals;
 }
 /** Return a list of dihedrals defined by the connectivity that involve atom0, atom1 and atom2*/
 QList<DihedralID> ConnectivityBase::getDihedrals(const AtomID &atom0, const AtomID &atom1, const AtomID &atom2) const
@@ -2275,6 +2624,26 @@ QVector< QVector<bool> > ConnectivityBase::getBondMatrix(int start, int end) con
             }
         }
     
+        if (order >= 2 and order <= 4 and tables.get() != 0)
+        {
+            //read the bonded, angled or dihedraled atoms from the tables
+            const NeighbourTable &table = (order == 2) ? tables->bonded :
+                                          (order == 3) ? tables->angled :
+                                                         tables->dihedraled;
+        
+            for (int i=0; i<nats; ++i)
+            {
+                bool *row = ret.data()[i].data();
+                
+                for (const qint32 *it = table.begin(i); it != table.end(i); ++it)
+                {
+                    row[*it] = true;
+                }
+            }
+            
+            continue;
+        }
+    
         if (order == 2)
         {
             for (int i=0; i<nats; ++i)
@@ -2398,6 +2767,7 @@ QDataStream SIREMOL_EXPORT &operator>>(QDataStream &ds, Connectivity &conn)
     if (v == 1)
     {
         ds >> static_cast<ConnectivityBase&>(conn);
+        conn.buildTables();
     }
     else
         throw version_error(v, "1", r_connectivity, CODELOC);
@@ -2429,6 +2799,13 @@ void Connectivity::squeeze()
     }
 }
 
+/** Build the bonded, angled and dihedraled neighbour tables. This
+    also clears the cache of split bonds */
+void Connectivity::buildTables()
+{
+    tables.reset( new ConnectivityTables(connected_atoms) );
+}
+
 /** Null constructor */
 Connectivity::Connectivity() 
              : ConcreteProperty<Connectivity,ConnectivityBase>()
@@ -2438,7 +2815,9 @@ Connectivity::Connectivity()
     is in 'moldata' */
 Connectivity::Connectivity(const MoleculeData &moldata)
              : ConcreteProperty<Connectivity,ConnectivityBase>(moldata)
-{}
+{
+    this->buildTables();
+}
 
     
 /** Construct the connectivity for the molecule viewed in the 
@@ -2457,6 +2836,7 @@ Connectivity::Connectivity(const ConnectivityEditor &editor)
              : ConcreteProperty<Connectivity,ConnectivityBase>(editor)
 {
     this->squeeze();
+    this->buildTables();
 }
 
 /** Private constructor allowing a ConnectivityBase to become a Connectivity */
@@ -2485,6 +2865,7 @@ Connectivity& Connectivity::operator=(const ConnectivityEditor &editor)
 {
     ConnectivityBase::operator=(editor);
     this->squeeze();
+    this->buildTables();
     return *this;
 }
 
@@ -2549,7 +2930,10 @@ ConnectivityEditor::ConnectivityEditor()
     Connectivity object */
 ConnectivityEditor::ConnectivityEditor(const Connectivity &connectivity)
                    : ConcreteProperty<ConnectivityEditor,ConnectivityBase>(connectivity)
-{}
+{
+    //the tables would be invalidated by any edit
+    tables.reset();
+}
 
 /** Copy constructor */
 ConnectivityEditor::ConnectivityEditor(const ConnectivityEditor &other)
@@ -2564,6 +2948,7 @@ ConnectivityEditor::~ConnectivityEditor()
 ConnectivityEditor& ConnectivityEditor::operator=(const ConnectivityBase &other)
 {
     ConnectivityBase::operator=(other);
+    tables.reset();
     
     return *this;
 }
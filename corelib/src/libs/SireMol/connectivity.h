@@ -34,6 +34,7 @@
 #include <QSet>
 
 #include <boost/tuple/tuple.hpp>
+#include <boost/shared_ptr.hpp>
 
 #include "bondhunter.h"
 #include "molviewproperty.h"
@@ -82,6 +83,8 @@ class MoleculeInfoData;
 
 class ConnectivityEditor;
 
+namespace detail{ class ConnectivityTables; }
+
 /** The base class of Connectivity and ConnectivityEditor
 
     @author Christopher Woods
@@ -258,9 +261,18 @@ protected:
     /** The info object that describes the molecule */
     SireBase::SharedDataPointer<MoleculeInfoData> d;
 
+    /** Compressed sparse row tables of the atoms that are bonded,
+        angled and dihedraled to each atom, together with the cache
+        of split bonds. These are only built for Connectivity objects
+        (the tables would be invalidated by every edit), and are 
+        shared between copies */
+    boost::shared_ptr<detail::ConnectivityTables> tables;
+
 private:
     const QSet<AtomIdx>& _pvt_connectedTo(AtomIdx atomidx) const;
     
+    tuple<AtomSelection,AtomSelection> _pvt_split(AtomIdx atom0, AtomIdx atom1) const;
+    
     QList< QList<AtomIdx> > _pvt_findPaths(AtomIdx cursor, const AtomIdx end_atom,
                                            QSet<AtomIdx> &done) const;
     
@@ -328,6 +340,7 @@ protected:
 
 private:
     void squeeze();
+    void buildTables();
 };
 
 /** An editor that can be used to edit a Connectivity object
@@ -36,3 +36,10 @@ const char* zmatrix_error::typeName()
 }
 
 static const RegisterMetaType<zmatrix_error> r_zmatrix_error;
+
+const char* constraint_error::typeName()
+{
+    return QMetaType::typeName( qMetaTypeId<constraint_error>() );
+}
+
+static const RegisterMetaType<constraint_error> r_constraint_error;
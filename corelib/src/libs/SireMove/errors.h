@@ -97,9 +97,44 @@ public:
     }
 };
 
+/** This exception is thrown when the constraints on a molecule
+    cannot be satisfied during dynamics
+
+    @author Christopher Woods
+*/
+class SIREMOVE_EXPORT constraint_error : public siremove_error
+{
+public:
+    constraint_error() : siremove_error()
+    {}
+
+    constraint_error(QString err, QString place = QString::null)
+              : siremove_error(err,place)
+    {}
+
+    constraint_error(const constraint_error &other) : siremove_error(other)
+    {}
+
+    ~constraint_error() throw()
+    {}
+
+    static const char* typeName();
+
+    const char* what() const throw()
+    {
+        return constraint_error::typeName();
+    }
+    
+    void throwSelf() const
+    {
+        throw constraint_error(*this);
+    }
+};
+
 }
 
 Q_DECLARE_METATYPE(SireMove::zmatrix_error)
+Q_DECLARE_METATYPE(SireMove::constraint_error)
 
 SIRE_END_HEADER
 
@@ -633,10 +633,13 @@ void HybridMC::move(System &system, int nmoves, bool record_stats)
     if (nmoves <= 0 or nsteps == 0)
         return;
 
-    //save our, and the system's, current state
+    //save our current state
     HybridMC old_state(*this);
 
-    System old_system_state(system);
+    //record all of the changes made by these moves, so that they
+    //can be undone if an exception is thrown
+    const int depth = system.transactionDepth();
+    system.beginTransaction();
     
     HMCVelGen &gen = velgen.edit().asA<HMCVelGen>();
     
@@ -652,8 +655,8 @@ void HybridMC::move(System &system, int nmoves, bool record_stats)
             //get the old total energy of the system
             double old_nrg = system.energy( this->energyComponent() );
 
-            //save the old system
-            System old_system(system);
+            //start recording the changes to the system
+            system.beginTransaction();
         
             //regenerate random velocities for this temperature
             double old_bias = gen.generate(system, md);
@@ -682,19 +685,26 @@ void HybridMC::move(System &system, int nmoves, bool record_stats)
             if (not this->test(new_nrg, old_nrg, new_bias, old_bias))
             {
                 //the move has been rejected - reset the state
-                system = old_system;
+                system.rollbackTransaction();
                 md = old_md;
             }
+            else
+                system.commitTransaction();
 
             if (record_stats)
             {
                 system.collectStats();
             }
         }
+
+        system.commitTransaction();
     }
     catch(...)
     {
-        system = old_system_state;
+        while (system.transactionDepth() > depth)
+        {
+            system.rollbackTransaction();
+        }
         this->operator=(old_state);
 
         throw;
@@ -41,6 +41,9 @@
 #include "SireMol/atommasses.h"
 #include "SireMol/atomcoords.h"
 #include "SireMol/molidx.h"
+#include "SireMol/connectivity.h"
+
+#include "SireMaths/matrix.h"
 
 #include "SireBase/quickcopy.hpp"
 
@@ -49,10 +52,17 @@
 
 #include "SireMol/errors.h"
 
+#include "SireMove/errors.h"
+#include "SireError/errors.h"
+
+#include <cmath>
+
 using namespace SireMove;
+using namespace SireMove::detail;
 using namespace SireSystem;
 using namespace SireFF;
 using namespace SireMol;
+using namespace SireMaths;
 using namespace SireCAS;
 using namespace SireBase;
 using namespace SireStream;
@@ -545,11 +555,12 @@ static const RegisterMetaType<AtomicVelocityWorkspace> r_atvelws;
 QDataStream SIREMOVE_EXPORT &operator<<(QDataStream &ds, 
                                         const AtomicVelocityWorkspace &atvelws)
 {
-    writeHeader(ds, r_atvelws, 1);
+    writeHeader(ds, r_atvelws, 2);
     
     SharedDataStream sds(ds);
     
-    sds << static_cast<const IntegratorWorkspace&>(atvelws);
+    sds << atvelws.constraint_type
+        << static_cast<const IntegratorWorkspace&>(atvelws);
     
     return ds;
 }
@@ -559,12 +570,15 @@ QDataStream SIREMOVE_EXPORT &operator>>(QDataStream &ds,
 {
     VersionID v = readHeader(ds, r_atvelws);
     
-    if (v == 1)
+    if (v == 1 or v == 2)
     {
         SharedDataStream sds(ds);
         
         AtomicVelocityWorkspace ws;
         
+        if (v == 2)
+            sds >> ws.constraint_type;
+        
         sds >> static_cast<IntegratorWorkspace&>(ws);
         
         ws.rebuildFromScratch();
@@ -572,7 +586,7 @@ QDataStream SIREMOVE_EXPORT &operator>>(QDataStream &ds,
         atvelws = ws;
     }
     else
-        throw version_error(v, "1", r_atvelws, CODELOC);
+        throw version_error(v, "1,2", r_atvelws, CODELOC);
         
     return ds;
 }
@@ -693,6 +707,8 @@ void AtomicVelocityWorkspace::rebuildFromScratch()
     else
         vel_generator = NullVelocityGenerator();
     
+    this->updateVelocityGenerator(vel_generator.edit());
+    
     for (int i=0; i<nmols; ++i)
     {
         MolNum molnum = molgroup.molNumAt(i);
@@ -781,6 +797,8 @@ void AtomicVelocityWorkspace::rebuildFromScratch()
             atom_forces_array[i] = forcetable.getTable(molnum).toVector(selected_atoms);
         }
     }
+    
+    this->rebuildConstraints();
 }
 
 /** Calculate the forces caused by the passed energy component */
@@ -856,13 +874,15 @@ void AtomicVelocityWorkspace::regenerateVelocities(const VelocityGenerator &gene
 
 /** Construct an empty workspace */
 AtomicVelocityWorkspace::AtomicVelocityWorkspace(const PropertyMap &map)
-       : ConcreteProperty<AtomicVelocityWorkspace,IntegratorWorkspace>(map)
+       : ConcreteProperty<AtomicVelocityWorkspace,IntegratorWorkspace>(map),
+         constraint_type("none")
 {}
 
 /** Construct a workspace to operate on the passed molecule group */
 AtomicVelocityWorkspace::AtomicVelocityWorkspace(const MoleculeGroup &molgroup,
                                                  const PropertyMap &map)
-       : ConcreteProperty<AtomicVelocityWorkspace,IntegratorWorkspace>(molgroup, map)
+       : ConcreteProperty<AtomicVelocityWorkspace,IntegratorWorkspace>(molgroup, map),
+         constraint_type("none")
 {
     this->rebuildFromScratch();
 }
@@ -872,7 +892,8 @@ AtomicVelocityWorkspace::AtomicVelocityWorkspace(const AtomicVelocityWorkspace &
        : ConcreteProperty<AtomicVelocityWorkspace,IntegratorWorkspace>(other),
          atom_coords(other.atom_coords), atom_momenta(other.atom_momenta),
          atom_forces(other.atom_forces), atom_masses(other.atom_masses),
-         vel_generator(other.vel_generator)
+         vel_generator(other.vel_generator), constraint_type(other.constraint_type),
+         settle_waters(other.settle_waters), shake_bonds(other.shake_bonds)
 {}
 
 /** Destructor */
@@ -890,6 +911,9 @@ AtomicVelocityWorkspace::operator=(const AtomicVelocityWorkspace &other)
         atom_forces = other.atom_forces;
         atom_masses = other.atom_masses;
         vel_generator = other.vel_generator;
+        constraint_type = other.constraint_type;
+        settle_waters = other.settle_waters;
+        shake_bonds = other.shake_bonds;
         IntegratorWorkspace::operator=(other);
     }
     
@@ -899,7 +923,8 @@ AtomicVelocityWorkspace::operator=(const AtomicVelocityWorkspace &other)
 /** Comparison operator */
 bool AtomicVelocityWorkspace::operator==(const AtomicVelocityWorkspace &other) const
 {
-    return IntegratorWorkspace::operator==(other);
+    return constraint_type == other.constraint_type and
+           IntegratorWorkspace::operator==(other);
 }
 
 /** Comparison operator */
@@ -913,6 +938,12 @@ const char* AtomicVelocityWorkspace::typeName()
     return QMetaType::typeName( qMetaTypeId<AtomicVelocityWorkspace>() );
 }
 
+/** This is called to let derived workspaces update the generator
+    used to generate any missing initial velocities, e.g. to set
+    the random number generator it uses. By default this does nothing */
+void AtomicVelocityWorkspace::updateVelocityGenerator(VelocityGenerator&) const
+{}
+
 /** This is called whenever a property is changed */
 void AtomicVelocityWorkspace::changedProperty(const QString&)
 {
@@ -1252,3 +1283,802 @@ void AtomicVelocityWorkspace::commitCoordinatesAndVelocities()
     
     IntegratorWorkspace::pvt_update(changed_mols);
 }
+
+/** Return whether or not the atom with element 'element' and mass 'mass'
+    is a hydrogen. The mass is used if the element is not known */
+static bool isHydrogen(const Element &element, double mass)
+{
+    if (element.nProtons() > 0)
+        return element.nProtons() == 1;
+    else
+        return mass > 0 and mass < 1.5;
+}
+
+/** Internal function used to rebuild the list of constrained waters
+    and bonds from the current coordinates. The constrained lengths
+    are taken from the coordinates when the workspace is built, so the
+    molecules should have been minimised or equilibrated using the
+    geometry that is to be held fixed. Only fully-selected molecules
+    are constrained */
+void AtomicVelocityWorkspace::rebuildConstraints()
+{
+    settle_waters = QVector<SettleWater>();
+    shake_bonds = QVector< QVector<ShakeBond> >();
+
+    if (constraint_type == "none")
+        return;
+
+    const bool constrain_hbonds = (constraint_type == "hbonds");
+    const bool constrain_allbonds = (constraint_type == "allbonds");
+    
+    const MoleculeGroup &molgroup = this->moleculeGroup();
+    
+    PropertyName element_property = this->elementsProperty();
+    PropertyName connectivity_property = this->propertyMap()["connectivity"];
+    
+    const int nmols = molgroup.nMolecules();
+    
+    QVector< QVector<ShakeBond> > bonds;
+    bool have_bonds = false;
+    
+    if (constrain_hbonds or constrain_allbonds)
+        bonds = QVector< QVector<ShakeBond> >(nmols);
+    
+    for (int i=0; i<nmols; ++i)
+    {
+        const ViewsOfMol &mol = molgroup[molgroup.molNumAt(i)].data();
+        
+        if (not mol.selectedAll())
+            continue;
+        
+        const MoleculeData &moldata = mol.data();
+        
+        const QVector<Vector> &coords = atom_coords.at(i);
+        const QVector<double> &masses = atom_masses.at(i);
+        
+        const int nats = coords.count();
+        
+        QVector<Element> elements;
+        
+        if (moldata.hasProperty(element_property))
+            elements = moldata.property(element_property).asA<AtomElements>().toVector();
+        else
+            elements = QVector<Element>(nats);
+        
+        QVector<bool> is_hydrogen(nats);
+        
+        for (int j=0; j<nats; ++j)
+        {
+            is_hydrogen[j] = ::isHydrogen(elements.at(j), masses.at(j));
+        }
+        
+        //three-site waters are made rigid using SETTLE
+        if (nats == 3)
+        {
+            int o = -1;
+            int h1 = -1;
+            int h2 = -1;
+            
+            for (int j=0; j<3; ++j)
+            {
+                if (not is_hydrogen[j])
+                    o = (o == -1) ? j : 3;
+                else if (h1 == -1)
+                    h1 = j;
+                else
+                    h2 = j;
+            }
+            
+            if (o >= 0 and o < 3 and h1 != -1 and h2 != -1 and masses[o] > 0 and
+                masses[h1] > 0 and masses[h1] == masses[h2])
+            {
+                SettleWater water;
+                water.mol = i;
+                water.o = o;
+                water.h1 = h1;
+                water.h2 = h2;
+                water.mass_o = masses[o];
+                water.mass_h = masses[h1];
+                
+                const double doh = 0.5 * ( Vector::distance(coords[o], coords[h1]) +
+                                           Vector::distance(coords[o], coords[h2]) );
+                
+                water.rc = 0.5 * Vector::distance(coords[h1], coords[h2]);
+                
+                const double h = std::sqrt(doh*doh - water.rc*water.rc);
+                
+                water.ra = 2.0 * water.mass_h * h / (water.mass_o + 2.0*water.mass_h);
+                water.rb = h - water.ra;
+                
+                settle_waters.append(water);
+                continue;
+            }
+        }
+        
+        //otherwise constrain the bonds (or just those to hydrogen)
+        if (bonds.isEmpty() or not moldata.hasProperty(connectivity_property))
+            continue;
+        
+        const Connectivity &connectivity = moldata.property(connectivity_property)
+                                                  .asA<Connectivity>();
+        
+        QVector<ShakeBond> &molbonds = bonds[i];
+        
+        for (int j=0; j<nats; ++j)
+        {
+            if (masses[j] == 0)
+                continue;
+        
+            foreach (AtomIdx k, connectivity.connectionsTo(AtomIdx(j)))
+            {
+                //bonds to massless atoms (e.g. virtual sites) are not constrained
+                if (k.value() <= j or masses[k.value()] == 0)
+                    continue;
+                
+                if (constrain_allbonds or is_hydrogen[j] or is_hydrogen[k.value()])
+                {
+                    molbonds.append( ShakeBond(j, k.value(),
+                                               Vector::distance2(coords[j],
+                                                                 coords[k.value()]),
+                                               masses[j], masses[k.value()]) );
+                }
+            }
+        }
+        
+        if (not molbonds.isEmpty())
+            have_bonds = true;
+    }
+    
+    if (have_bonds)
+        shake_bonds = bonds;
+}
+
+/** Set the type of constraints that are applied to the molecules.
+    This can be;
+    
+    "none" : no constraints
+    "water" : three-site waters are held rigid using SETTLE
+    "hbonds" : as "water", plus bonds to hydrogen are constrained using SHAKE / RATTLE
+    "allbonds" : as "water", plus all bonds are constrained using SHAKE / RATTLE
+    
+    \throw SireError::invalid_arg
+*/
+void AtomicVelocityWorkspace::setConstraintType(const QString &type)
+{
+    const QString t = type.toLower();
+    
+    if (t != "none" and t != "water" and t != "hbonds" and t != "allbonds")
+        throw SireError::invalid_arg( QObject::tr(
+                "Cannot set the constraint type to \"%1\". Available types are "
+                "\"none\", \"water\", \"hbonds\" and \"allbonds\".")
+                    .arg(type), CODELOC );
+    
+    if (t != constraint_type)
+    {
+        constraint_type = t;
+        this->rebuildConstraints();
+    }
+}
+
+/** Return the type of constraints applied to the molecules */
+QString AtomicVelocityWorkspace::constraintType() const
+{
+    return constraint_type;
+}
+
+/** Return whether or not any of the molecules are constrained */
+bool AtomicVelocityWorkspace::hasConstraints() const
+{
+    return not (settle_waters.isEmpty() and shake_bonds.isEmpty());
+}
+
+/** Return a copy of the coordinates of all of the molecules. This is
+    used by integrators to save the coordinates before a step, so that
+    they can be passed to constrainCoordinates */
+QVector< QVector<Vector> > AtomicVelocityWorkspace::coordinates() const
+{
+    return atom_coords;
+}
+
+/** Apply SETTLE to the water 'water', moving the unconstrained
+    coordinates 'x' back onto the rigid geometry, using the constrained
+    coordinates from the start of the step in 'old'. The momenta
+    are corrected to match the displacement of each atom */
+static void settleCoordinates(const SettleWater &water, const Vector *old,
+                              Vector *x, Vector *p, double dt)
+{
+    const double inv_mass = 1.0 / (water.mass_o + 2.0*water.mass_h);
+    const double wo = water.mass_o * inv_mass;
+    const double wh = water.mass_h * inv_mass;
+    
+    const Vector &a3 = x[water.o];
+    const Vector &b3 = x[water.h1];
+    const Vector &c3 = x[water.h2];
+
+    //the center of mass is unaffected by the constraints
+    const Vector com = wo*a3 + wh*(b3 + c3);
+
+    const Vector a1 = a3 - com;
+    const Vector b1 = b3 - com;
+    const Vector c1 = c3 - com;
+
+    const Vector b0 = old[water.h1] - old[water.o];
+    const Vector c0 = old[water.h2] - old[water.o];
+
+    //build the frame with its z axis perpendicular to the old plane of 
+    //the water - the constraint forces lie in this plane, so the
+    //z coordinates of the atoms are not changed by the constraints
+    const Vector axz = Vector::cross(b0, c0).normalise();
+    const Vector axx = Vector::cross(a1, axz).normalise();
+    const Vector axy = Vector::cross(axz, axx);
+
+    const double xb0 = Vector::dot(axx, b0);
+    const double yb0 = Vector::dot(axy, b0);
+    const double xc0 = Vector::dot(axx, c0);
+    const double yc0 = Vector::dot(axy, c0);
+    
+    const double za1 = Vector::dot(axz, a1);
+    const double xb1 = Vector::dot(axx, b1);
+    const double yb1 = Vector::dot(axy, b1);
+    const double zb1 = Vector::dot(axz, b1);
+    const double xc1 = Vector::dot(axx, c1);
+    const double yc1 = Vector::dot(axy, c1);
+    const double zc1 = Vector::dot(axz, c1);
+    
+    const double sinphi = za1 / water.ra;
+    const double cosphi2 = 1.0 - sinphi*sinphi;
+    
+    if (cosphi2 <= 0)
+        throw SireMove::constraint_error( QObject::tr(
+                "SETTLE failed as the water has moved too far during the step. "
+                "Try using a smaller timestep."), CODELOC );
+    
+    const double cosphi = std::sqrt(cosphi2);
+    
+    const double sinpsi = (zb1 - zc1) / (2.0 * water.rc * cosphi);
+    const double cospsi = std::sqrt( qMax(0.0, 1.0 - sinpsi*sinpsi) );
+    
+    const double ya2 = water.ra * cosphi;
+    const double xb2 = -water.rc * cospsi;
+    const double t1 = -water.rb * cosphi;
+    const double t2 = water.rc * sinpsi * sinphi;
+    const double yb2 = t1 - t2;
+    const double yc2 = t1 + t2;
+    
+    //find the rotation in the plane that matches the old geometry
+    const double alpha = xb2*(xb0 - xc0) + yb0*yb2 + yc0*yc2;
+    const double beta = xb2*(yc0 - yb0) + xb0*yb2 + xc0*yc2;
+    const double gamma = xb0*yb1 - xb1*yb0 + xc0*yc1 - xc1*yc0;
+    
+    const double al2be2 = alpha*alpha + beta*beta;
+    
+    const double sintheta = (alpha*gamma - beta*std::sqrt( qMax(0.0,al2be2 - gamma*gamma) ))
+                                / al2be2;
+    const double costheta = std::sqrt( qMax(0.0, 1.0 - sintheta*sintheta) );
+    
+    const Vector a = com + (-ya2*sintheta)*axx + (ya2*costheta)*axy + za1*axz;
+    
+    const Vector b = com + (xb2*costheta - yb2*sintheta)*axx
+                         + (xb2*sintheta + yb2*costheta)*axy + zb1*axz;
+    
+    const Vector c = com + (-xb2*costheta - yc2*sintheta)*axx
+                         + (-xb2*sintheta + yc2*costheta)*axy + zc1*axz;
+
+    //correct the momenta using the displacements caused by the constraints
+    const double inv_dt = 1.0 / dt;
+    
+    p[water.o] += (water.mass_o * inv_dt) * (a - a3);
+    p[water.h1] += (water.mass_h * inv_dt) * (b - b3);
+    p[water.h2] += (water.mass_h * inv_dt) * (c - c3);
+
+    x[water.o] = a;
+    x[water.h1] = b;
+    x[water.h2] = c;
+}
+
+/** Remove the components of the velocities of the water 'water' that
+    would change the lengths of its three constraints. This solves the 
+    3x3 set of equations for the constraint impulses directly */
+static void settleMomenta(const SettleWater &water, const Vector *x, Vector *p)
+{
+    const int atoms[3] = { water.o, water.h1, water.h2 };
+    const double inv_mass[3] = { 1.0/water.mass_o, 1.0/water.mass_h, 1.0/water.mass_h };
+    
+    //the constraints are O-H1, O-H2 and H1-H2
+    const int c0[3] = { 0, 0, 1 };
+    const int c1[3] = { 1, 2, 2 };
+    
+    Vector e[3];
+    double rhs[3];
+    
+    for (int k=0; k<3; ++k)
+    {
+        const int a = atoms[c0[k]];
+        const int b = atoms[c1[k]];
+    
+        e[k] = (x[a] - x[b]).normalise();
+        rhs[k] = -Vector::dot(e[k], inv_mass[c0[k]]*p[a] - inv_mass[c1[k]]*p[b]);
+    }
+    
+    double m[3][3];
+    
+    for (int k=0; k<3; ++k)
+    {
+        for (int l=0; l<3; ++l)
+        {
+            //how the relative velocity along constraint k is changed by
+            //an impulse along constraint l
+            double w = 0;
+            
+            if (c0[k] == c0[l]) w += inv_mass[c0[k]];
+            if (c0[k] == c1[l]) w -= inv_mass[c0[k]];
+            if (c1[k] == c0[l]) w -= inv_mass[c1[k]];
+            if (c1[k] == c1[l]) w += inv_mass[c1[k]];
+            
+            m[k][l] = w * Vector::dot(e[k], e[l]);
+        }
+    }
+    
+    const Vector tau = Matrix( m[0][0], m[0][1], m[0][2],
+                               m[1][0], m[1][1], m[1][2],
+                               m[2][0], m[2][1], m[2][2] ).inverse()
+                          * Vector(rhs[0], rhs[1], rhs[2]);
+    
+    for (int k=0; k<3; ++k)
+    {
+        const Vector dp = tau[k] * e[k];
+        p[atoms[c0[k]]] += dp;
+        p[atoms[c1[k]]] -= dp;
+    }
+}
+
+/** The maximum number of SHAKE / RATTLE iterations */
+static const int MAX_SHAKE_ITERATIONS = 1000;
+
+/** Apply SHAKE to the bonds in 'bonds', moving the unconstrained 
+    coordinates 'x' back onto the constraints along the bond vectors
+    of the constrained coordinates from the start of the step in 'old'.
+    The momenta are corrected to match the displacement of each atom */
+static void shakeCoordinates(const QVector<ShakeBond> &bonds, const Vector *old,
+                             Vector *x, Vector *p, double dt, double tolerance)
+{
+    const ShakeBond *b = bonds.constData();
+    const int nbonds = bonds.count();
+    const double inv_dt = 1.0 / dt;
+
+    for (int iter=0; iter<MAX_SHAKE_ITERATIONS; ++iter)
+    {
+        bool converged = true;
+    
+        for (int i=0; i<nbonds; ++i)
+        {
+            const ShakeBond &bond = b[i];
+            
+            const double diff = bond.length2 - (x[bond.atom0] - x[bond.atom1]).length2();
+            
+            if (std::abs(diff) > 2.0 * tolerance * bond.length2)
+            {
+                converged = false;
+                
+                const Vector r0 = old[bond.atom0] - old[bond.atom1];
+                const double dot = Vector::dot(x[bond.atom0] - x[bond.atom1], r0);
+                
+                if (dot < 1e-6 * bond.length2)
+                    throw SireMove::constraint_error( QObject::tr(
+                            "SHAKE failed as the bond between atoms %1 and %2 has "
+                            "rotated too far during the step. Try using a smaller "
+                            "timestep.").arg(bond.atom0).arg(bond.atom1), CODELOC );
+                
+                const Vector delta = (diff / (2.0 * dot * (bond.inv_mass0 + bond.inv_mass1)))
+                                        * r0;
+                
+                x[bond.atom0] += bond.inv_mass0 * delta;
+                x[bond.atom1] -= bond.inv_mass1 * delta;
+                
+                p[bond.atom0] += inv_dt * delta;
+                p[bond.atom1] -= inv_dt * delta;
+            }
+        }
+        
+        if (converged)
+            return;
+    }
+    
+    throw SireMove::constraint_error( QObject::tr(
+            "SHAKE failed to converge to a tolerance of %1 after %2 iterations.")
+                .arg(tolerance).arg(MAX_SHAKE_ITERATIONS), CODELOC );
+}
+
+/** Apply RATTLE to the bonds in 'bonds', removing the components of 
+    the velocities that would change the constrained bond lengths */
+static void rattleMomenta(const QVector<ShakeBond> &bonds, const Vector *x,
+                         Vector *p, double tolerance)
+{
+    const ShakeBond *b = bonds.constData();
+    const int nbonds = bonds.count();
+
+    for (int iter=0; iter<MAX_SHAKE_ITERATIONS; ++iter)
+    {
+        bool converged = true;
+    
+        for (int i=0; i<nbonds; ++i)
+        {
+            const ShakeBond &bond = b[i];
+            
+            const Vector r = x[bond.atom0] - x[bond.atom1];
+            const Vector v = bond.inv_mass0 * p[bond.atom0] - bond.inv_mass1 * p[bond.atom1];
+            
+            const double dot = Vector::dot(r, v);
+            
+            if (std::abs(dot) > tolerance * bond.length2)
+            {
+                converged = false;
+                
+                const Vector delta = (-dot / ((bond.inv_mass0 + bond.inv_mass1) *
+                                              bond.length2)) * r;
+                
+                p[bond.atom0] += delta;
+                p[bond.atom1] -= delta;
+            }
+        }
+        
+        if (converged)
+            return;
+    }
+    
+    throw SireMove::constraint_error( QObject::tr(
+            "RATTLE failed to converge to a tolerance of %1 after %2 iterations.")
+                .arg(tolerance).arg(MAX_SHAKE_ITERATIONS), CODELOC );
+}
+
+/** Apply the constraints to the coordinates after a step, using the
+    coordinates from the start of the step in 'old_coords' (these 
+    must satisfy the constraints). The waters are made rigid using SETTLE,
+    while the bonds are constrained using SHAKE, to the relative tolerance
+    'tolerance'. The momenta are corrected so that they are consistent
+    with the constrained positions after the timestep 'dt'
+    
+    \throw SireMove::constraint_error
+*/
+void AtomicVelocityWorkspace::constrainCoordinates(
+                                    const QVector< QVector<Vector> > &old_coords,
+                                    double dt, double tolerance)
+{
+    if (not this->hasConstraints())
+        return;
+
+    BOOST_ASSERT( old_coords.count() == atom_coords.count() );
+
+    //all of the waters are processed in one pass
+    const SettleWater *waters = settle_waters.constData();
+    const int nwaters = settle_waters.count();
+    
+    for (int i=0; i<nwaters; ++i)
+    {
+        const SettleWater &water = waters[i];
+        
+        ::settleCoordinates(water, old_coords.at(water.mol).constData(),
+                            atom_coords[water.mol].data(), 
+                            atom_momenta[water.mol].data(), dt);
+    }
+    
+    for (int i=0; i<shake_bonds.count(); ++i)
+    {
+        const QVector<ShakeBond> &bonds = shake_bonds.at(i);
+        
+        if (not bonds.isEmpty())
+            ::shakeCoordinates(bonds, old_coords.at(i).constData(),
+                               atom_coords[i].data(), atom_momenta[i].data(),
+                               dt, tolerance);
+    }
+}
+
+/** Apply the constraints to the momenta, removing the components
+    that would change the constrained distances (to the relative
+    tolerance 'tolerance'). This should be called after the 
+    final velocity update of a step
+    
+    \throw SireMove::constraint_error
+*/
+void AtomicVelocityWorkspace::constrainMomenta(double tolerance)
+{
+    if (not this->hasConstraints())
+        return;
+
+    const SettleWater *waters = settle_waters.constData();
+    const int nwaters = settle_waters.count();
+    
+    for (int i=0; i<nwaters; ++i)
+    {
+        const SettleWater &water = waters[i];
+        
+        ::settleMomenta(water, atom_coords.at(water.mol).constData(),
+                        atom_momenta[water.mol].data());
+    }
+    
+    for (int i=0; i<shake_bonds.count(); ++i)
+    {
+        const QVector<ShakeBond> &bonds = shake_bonds.at(i);
+        
+        if (not bonds.isEmpty())
+            ::rattleMomenta(bonds, atom_coords.at(i).constData(),
+                            atom_momenta[i].data(), tolerance);
+    }
+}
+
+//////////
+////////// Implementation of LangevinWorkspace
+//////////
+
+static const RegisterMetaType<LangevinWorkspace> r_langevinws;
+
+QDataStream SIREMOVE_EXPORT &operator<<(QDataStream &ds, 
+                                        const LangevinWorkspace &langevinws)
+{
+    writeHeader(ds, r_langevinws, 1);
+    
+    SharedDataStream sds(ds);
+    
+    sds << langevinws.ran_generator
+        << static_cast<const AtomicVelocityWorkspace&>(langevinws);
+    
+    return ds;
+}
+
+QDataStream SIREMOVE_EXPORT &operator>>(QDataStream &ds,
+                                        LangevinWorkspace &langevinws)
+{
+    VersionID v = readHeader(ds, r_langevinws);
+    
+    if (v == 1)
+    {
+        SharedDataStream sds(ds);
+        
+        sds >> langevinws.ran_generator
+            >> static_cast<AtomicVelocityWorkspace&>(langevinws);
+        
+        langevinws.noise = QVector<double>();
+    }
+    else
+        throw version_error(v, "1", r_langevinws, CODELOC);
+        
+    return ds;
+}
+
+/** Construct an empty workspace */
+LangevinWorkspace::LangevinWorkspace(const PropertyMap &map)
+       : ConcreteProperty<LangevinWorkspace,AtomicVelocityWorkspace>(map)
+{}
+
+/** Construct a workspace to operate on the passed molecule group */
+LangevinWorkspace::LangevinWorkspace(const MoleculeGroup &molgroup,
+                                     const PropertyMap &map)
+       : ConcreteProperty<LangevinWorkspace,AtomicVelocityWorkspace>(molgroup, map)
+{}
+
+/** Copy constructor */
+LangevinWorkspace::LangevinWorkspace(const LangevinWorkspace &other)
+       : ConcreteProperty<LangevinWorkspace,AtomicVelocityWorkspace>(other),
+         ran_generator(other.ran_generator)
+{}
+
+/** Destructor */
+LangevinWorkspace::~LangevinWorkspace()
+{}
+
+/** Copy assignment operator */
+LangevinWorkspace& LangevinWorkspace::operator=(const LangevinWorkspace &other)
+{
+    if (this != &other)
+    {
+        ran_generator = other.ran_generator;
+        AtomicVelocityWorkspace::operator=(other);
+    }
+    
+    return *this;
+}
+
+/** Comparison operator */
+bool LangevinWorkspace::operator==(const LangevinWorkspace &other) const
+{
+    return AtomicVelocityWorkspace::operator==(other);
+}
+
+/** Comparison operator */
+bool LangevinWorkspace::operator!=(const LangevinWorkspace &other) const
+{
+    return not LangevinWorkspace::operator==(other);
+}
+
+const char* LangevinWorkspace::typeName()
+{
+    return QMetaType::typeName( qMetaTypeId<LangevinWorkspace>() );
+}
+
+/** Set the random number generator used for the stochastic part
+    of the dynamics, and to generate any missing initial velocities. 
+    Seed this generator to get a reproducible trajectory */
+void LangevinWorkspace::setGenerator(const RanGenerator &generator)
+{
+    ran_generator = generator;
+}
+
+/** Make the velocity generator use the random number generator of 
+    this workspace, so that the initial velocities are also reproducible */
+void LangevinWorkspace::updateVelocityGenerator(VelocityGenerator &generator) const
+{
+    generator.setGenerator(ran_generator);
+}
+
+/** Return the random number generator used for the stochastic part
+    of the dynamics */
+const RanGenerator& LangevinWorkspace::generator() const
+{
+    return ran_generator;
+}
+
+/** Generate a new set of gaussian random numbers (zero mean, unit variance),
+    three for each atom, returning a pointer to the first number. The 
+    numbers are in the same order as the atoms in the molecules, so the three
+    numbers for atom 'j' of molecule 'i' follow those of atom 'j-1'. The
+    numbers are generated in a single batch, so only lock the generator once */
+const double* LangevinWorkspace::generateNoise()
+{
+    int natoms = 0;
+    
+    for (int i=0; i<this->nMolecules(); ++i)
+    {
+        natoms += this->nAtoms(i);
+    }
+    
+    if (noise.count() != 3*natoms)
+        noise = QVector<double>(3*natoms);
+    
+    ran_generator.fillNorm(noise, 0, 1);
+    
+    return noise.constData();
+}
+
+//////////
+////////// Implementation of RESPAWorkspace
+//////////
+
+static const RegisterMetaType<RESPAWorkspace> r_respaws;
+
+QDataStream SIREMOVE_EXPORT &operator<<(QDataStream &ds, 
+                                        const RESPAWorkspace &respaws)
+{
+    writeHeader(ds, r_respaws, 1);
+    
+    SharedDataStream sds(ds);
+    
+    sds << static_cast<const AtomicVelocityWorkspace&>(respaws);
+    
+    return ds;
+}
+
+QDataStream SIREMOVE_EXPORT &operator>>(QDataStream &ds,
+                                        RESPAWorkspace &respaws)
+{
+    VersionID v = readHeader(ds, r_respaws);
+    
+    if (v == 1)
+    {
+        SharedDataStream sds(ds);
+        
+        sds >> static_cast<AtomicVelocityWorkspace&>(respaws);
+        
+        respaws.level_forces.clear();
+    }
+    else
+        throw version_error(v, "1", r_respaws, CODELOC);
+        
+    return ds;
+}
+
+/** Construct an empty workspace */
+RESPAWorkspace::RESPAWorkspace(const PropertyMap &map)
+       : ConcreteProperty<RESPAWorkspace,AtomicVelocityWorkspace>(map)
+{}
+
+/** Construct a workspace to operate on the passed molecule group */
+RESPAWorkspace::RESPAWorkspace(const MoleculeGroup &molgroup,
+                               const PropertyMap &map)
+       : ConcreteProperty<RESPAWorkspace,AtomicVelocityWorkspace>(molgroup, map)
+{}
+
+/** Copy constructor */
+RESPAWorkspace::RESPAWorkspace(const RESPAWorkspace &other)
+       : ConcreteProperty<RESPAWorkspace,AtomicVelocityWorkspace>(other),
+         level_forces(other.level_forces)
+{}
+
+/** Destructor */
+RESPAWorkspace::~RESPAWorkspace()
+{}
+
+/** Copy assignment operator */
+RESPAWorkspace& RESPAWorkspace::operator=(const RESPAWorkspace &other)
+{
+    if (this != &other)
+    {
+        level_forces = other.level_forces;
+        AtomicVelocityWorkspace::operator=(other);
+    }
+    
+    return *this;
+}
+
+/** Comparison operator */
+bool RESPAWorkspace::operator==(const RESPAWorkspace &other) const
+{
+    return AtomicVelocityWorkspace::operator==(other);
+}
+
+/** Comparison operator */
+bool RESPAWorkspace::operator!=(const RESPAWorkspace &other) const
+{
+    return not RESPAWorkspace::operator==(other);
+}
+
+const char* RESPAWorkspace::typeName()
+{
+    return QMetaType::typeName( qMetaTypeId<RESPAWorkspace>() );
+}
+
+/** Return the number of time levels for which forces have been calculated */
+int RESPAWorkspace::nLevels() const
+{
+    return level_forces.count();
+}
+
+/** Calculate the forces of the energy component 'nrg_component' for the 
+    current coordinates, and save them as the forces of time level 'level'.
+    The forces of the other levels are not changed
+    
+    \throw SireError::invalid_index
+*/
+void RESPAWorkspace::calculateLevelForces(int level, const Symbol &nrg_component)
+{
+    if (level < 0)
+        throw SireError::invalid_index( QObject::tr(
+                "Invalid time level (%1).").arg(level), CODELOC );
+
+    if (level >= level_forces.count())
+        level_forces.resize(level + 1);
+
+    AtomicVelocityWorkspace::calculateForces(nrg_component);
+    
+    const int nmols = this->nMolecules();
+    
+    QVector< QVector<Vector> > &forces = level_forces[level];
+    
+    if (forces.count() != nmols)
+        forces.resize(nmols);
+    
+    QVector<Vector> *forces_array = forces.data();
+    
+    for (int i=0; i<nmols; ++i)
+    {
+        const int nats = this->nAtoms(i);
+        
+        if (forces_array[i].count() != nats)
+            forces_array[i].resize(nats);
+        
+        const Vector *f = this->forceArray(i);
+        Vector *level_f = forces_array[i].data();
+        
+        for (int j=0; j<nats; ++j)
+        {
+            level_f[j] = f[j];
+        }
+    }
+}
+
+/** Return the array of forces of time level 'level' on the ith molecule.
+    This does not check that 'level' or 'i' are valid indicies - use of
+    an invalid index will lead to undefined results (e.g. crash or worse) */
+const Vector* RESPAWorkspace::levelForceArray(int level, int i) const
+{
+    return level_forces.constData()[level].constData()[i].constData();
+}
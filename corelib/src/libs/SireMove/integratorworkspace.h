@@ -55,6 +55,8 @@ namespace SireMove
 class IntegratorWorkspace;
 class NullIntegratorWorkspace;
 class AtomicVelocityWorkspace;
+class LangevinWorkspace;
+class RESPAWorkspace;
 }
 
 QDataStream& operator<<(QDataStream&, const SireMove::IntegratorWorkspace&);
@@ -66,6 +68,12 @@ QDataStream& operator>>(QDataStream&, SireMove::NullIntegratorWorkspace&);
 QDataStream& operator<<(QDataStream&, const SireMove::AtomicVelocityWorkspace&);
 QDataStream& operator>>(QDataStream&, SireMove::AtomicVelocityWorkspace&);
 
+QDataStream& operator<<(QDataStream&, const SireMove::LangevinWorkspace&);
+QDataStream& operator>>(QDataStream&, SireMove::LangevinWorkspace&);
+
+QDataStream& operator<<(QDataStream&, const SireMove::RESPAWorkspace&);
+QDataStream& operator>>(QDataStream&, SireMove::RESPAWorkspace&);
+
 namespace SireMol
 {
 class MoleculeView;
@@ -76,6 +84,59 @@ namespace SireMove
 
 class VelocityGenerator;
 
+namespace detail
+{
+
+/** This holds a single bond length constraint that is
+    satisfied using SHAKE / RATTLE */
+class ShakeBond
+{
+public:
+    ShakeBond() : atom0(0), atom1(0), length2(0), inv_mass0(0), inv_mass1(0)
+    {}
+    
+    ShakeBond(int a0, int a1, double len2, double m0, double m1)
+          : atom0(a0), atom1(a1), length2(len2),
+            inv_mass0(1.0/m0), inv_mass1(1.0/m1)
+    {}
+    
+    /** The indicies of the two constrained atoms */
+    qint32 atom0, atom1;
+    
+    /** The square of the constrained bond length */
+    double length2;
+    
+    /** The inverse masses of the two atoms */
+    double inv_mass0, inv_mass1;
+};
+
+/** This holds the geometry of a rigid three-site water
+    that is constrained using SETTLE */
+class SettleWater
+{
+public:
+    SettleWater() : mol(0), o(0), h1(0), h2(0), 
+                    mass_o(0), mass_h(0), ra(0), rb(0), rc(0)
+    {}
+
+    /** The index of the water molecule in the workspace */
+    qint32 mol;
+    
+    /** The indicies of the oxygen and the two hydrogens */
+    qint32 o, h1, h2;
+    
+    /** The masses of the oxygen and hydrogens */
+    double mass_o, mass_h;
+    
+    /** The canonical geometry of the water - the oxygen lies 'ra' 
+        from the center of mass, the line between the hydrogens lies 
+        'rb' from the center of mass, and 'rc' is half of the 
+        hydrogen-hydrogen distance */
+    double ra, rb, rc;
+};
+
+} // end of namespace detail
+
 using SireMol::MoleculeView;
 using SireMol::MoleculeGroup;
 using SireMol::MolGroupPtr;
@@ -294,11 +355,26 @@ public:
     
     void commitCoordinatesAndVelocities();
 
+    void setConstraintType(const QString &constraint_type);
+    QString constraintType() const;
+
+    bool hasConstraints() const;
+
+    QVector< QVector<Vector> > coordinates() const;
+
+    void constrainCoordinates(const QVector< QVector<Vector> > &old_coords,
+                              double dt, double tolerance);
+    
+    void constrainMomenta(double tolerance);
+
 protected:
     void changedProperty(const QString &property);
 
+    virtual void updateVelocityGenerator(VelocityGenerator &generator) const;
+
 private:
     void rebuildFromScratch();
+    void rebuildConstraints();
 
     /** All of the atomic coordinates */
     QVector< QVector<Vector> > atom_coords;
@@ -315,6 +391,107 @@ private:
     
     /** The generator used to get the initial velocities */
     VelGenPtr vel_generator;
+    
+    /** The type of constraints applied to the molecules
+        ("none", "water", "hbonds" or "allbonds") */
+    QString constraint_type;
+    
+    /** The rigid waters that are constrained using SETTLE */
+    QVector<detail::SettleWater> settle_waters;
+    
+    /** The bonds of each molecule that are constrained using
+        SHAKE / RATTLE. This is empty if no bonds are constrained */
+    QVector< QVector<detail::ShakeBond> > shake_bonds;
+};
+
+/** This class provides a workspace for stochastic integrators
+    (e.g. Langevin) that make use of atomic forces and velocities.
+    It holds the random number generator used for the stochastic
+    part of the dynamics, and generates the gaussian random numbers
+    for all of the atoms in a single batch
+    
+    @author Christopher Woods
+*/
+class SIREMOVE_EXPORT LangevinWorkspace
+       : public SireBase::ConcreteProperty<LangevinWorkspace,AtomicVelocityWorkspace>
+{
+
+friend QDataStream& ::operator<<(QDataStream&, const LangevinWorkspace&);
+friend QDataStream& ::operator>>(QDataStream&, LangevinWorkspace&);
+
+public:
+    LangevinWorkspace(const PropertyMap &map = PropertyMap());
+    LangevinWorkspace(const MoleculeGroup &molgroup,
+                      const PropertyMap &map = PropertyMap());
+    
+    LangevinWorkspace(const LangevinWorkspace &other);
+    
+    ~LangevinWorkspace();
+    
+    LangevinWorkspace& operator=(const LangevinWorkspace &other);
+    
+    bool operator==(const LangevinWorkspace &other) const;
+    bool operator!=(const LangevinWorkspace &other) const;
+    
+    static const char* typeName();
+
+    void setGenerator(const RanGenerator &generator);
+    const RanGenerator& generator() const;
+
+    const double* generateNoise();
+
+protected:
+    void updateVelocityGenerator(VelocityGenerator &generator) const;
+
+private:
+    /** The random number generator used for the stochastic dynamics */
+    RanGenerator ran_generator;
+    
+    /** Space for the gaussian random numbers (three per atom) */
+    QVector<double> noise;
+};
+
+/** This class provides a workspace for multiple-time-step integrators
+    (e.g. RESPA) that make use of atomic forces and velocities. As well
+    as the forces of the workspace, it holds a separate buffer of forces
+    for each time level, so that the forces of the slow levels can be
+    kept while the fast levels are recalculated. The buffers are reused
+    from step to step, so are only allocated once
+    
+    @author Christopher Woods
+*/
+class SIREMOVE_EXPORT RESPAWorkspace
+       : public SireBase::ConcreteProperty<RESPAWorkspace,AtomicVelocityWorkspace>
+{
+
+friend QDataStream& ::operator<<(QDataStream&, const RESPAWorkspace&);
+friend QDataStream& ::operator>>(QDataStream&, RESPAWorkspace&);
+
+public:
+    RESPAWorkspace(const PropertyMap &map = PropertyMap());
+    RESPAWorkspace(const MoleculeGroup &molgroup,
+                   const PropertyMap &map = PropertyMap());
+    
+    RESPAWorkspace(const RESPAWorkspace &other);
+    
+    ~RESPAWorkspace();
+    
+    RESPAWorkspace& operator=(const RESPAWorkspace &other);
+    
+    bool operator==(const RESPAWorkspace &other) const;
+    bool operator!=(const RESPAWorkspace &other) const;
+    
+    static const char* typeName();
+
+    int nLevels() const;
+
+    void calculateLevelForces(int level, const Symbol &nrg_component);
+
+    const Vector* levelForceArray(int level, int i) const;
+
+private:
+    /** The forces on the atoms of each molecule, for each time level */
+    QVector< QVector< QVector<Vector> > > level_forces;
 };
 
 typedef SireBase::PropPtr<IntegratorWorkspace> IntegratorWorkspacePtr;
@@ -323,6 +500,8 @@ typedef SireBase::PropPtr<IntegratorWorkspace> IntegratorWorkspacePtr;
 
 Q_DECLARE_METATYPE( SireMove::NullIntegratorWorkspace )
 Q_DECLARE_METATYPE( SireMove::AtomicVelocityWorkspace )
+Q_DECLARE_METATYPE( SireMove::LangevinWorkspace )
+Q_DECLARE_METATYPE( SireMove::RESPAWorkspace )
 
 SIRE_END_HEADER
 
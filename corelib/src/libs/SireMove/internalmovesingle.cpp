@@ -247,7 +247,11 @@ void InternalMoveSingle::move(System &system, int nmoves, bool record_stats)
         return;
 
     InternalMoveSingle old_state(*this);
-    System old_system_state(system);
+
+    //record all of the changes made by these moves, so that they
+    //can be undone if an exception is thrown
+    const int depth = system.transactionDepth();
+    system.beginTransaction();
 
     try
     {
@@ -257,7 +261,7 @@ void InternalMoveSingle::move(System &system, int nmoves, bool record_stats)
         for (int i=0; i<nmoves; ++i)
         {
             double old_nrg = system.energy( this->energyComponent() );
-            System old_system(system);
+            system.beginTransaction();
             SamplerPtr old_sampler(smplr);
       
             double old_bias = 1;
@@ -536,18 +540,25 @@ void InternalMoveSingle::move(System &system, int nmoves, bool record_stats)
             {
                 //the move has been rejected - reset the state
                 smplr = old_sampler;
-                system = old_system;
+                system.rollbackTransaction();
             }
+            else
+                system.commitTransaction();
 
             if (record_stats)
             {
                 system.collectStats();
             }
         }
+
+        system.commitTransaction();
     }
     catch(...)
     {
-        system = old_system_state;
+        while (system.transactionDepth() > depth)
+        {
+            system.rollbackTransaction();
+        }
         this->operator=(old_state);
         throw;
     }
@@ -0,0 +1,426 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#include "langevin.h"
+#include "ensemble.h"
+
+#include "SireMol/moleculegroup.h"
+#include "SireMol/partialmolecule.h"
+#include "SireMol/molecule.h"
+
+#include "SireSystem/system.h"
+
+#include "SireFF/forcetable.h"
+
+#include "SireMaths/rangenerator.h"
+
+#include "SireStream/datastream.h"
+#include "SireStream/shareddatastream.h"
+
+#include "SireUnits/units.h"
+#include "SireUnits/temperature.h"
+
+#include "SireError/errors.h"
+
+#include <cmath>
+
+using namespace SireMove;
+using namespace SireSystem;
+using namespace SireMol;
+using namespace SireFF;
+using namespace SireCAS;
+using namespace SireVol;
+using namespace SireBase;
+using namespace SireStream;
+using namespace SireUnits;
+using namespace SireUnits::Dimension;
+
+static const RegisterMetaType<Langevin> r_langevin;
+
+/** Serialise to a binary datastream */
+QDataStream SIREMOVE_EXPORT &operator<<(QDataStream &ds, const Langevin &langevin)
+{
+    writeHeader(ds, r_langevin, 1);
+    
+    SharedDataStream sds(ds);
+    
+    sds << langevin.temp.to(kelvin) << langevin.relax_time.to(picosecond)
+        << langevin.frequent_save_velocities
+        << langevin.constraint_type << langevin.constraint_tolerance
+        << static_cast<const Integrator&>(langevin);
+        
+    return ds;
+}
+
+/** Extract from a binary datastream */
+QDataStream SIREMOVE_EXPORT &operator>>(QDataStream &ds, Langevin &langevin)
+{
+    VersionID v = readHeader(ds, r_langevin);
+    
+    if (v == 1)
+    {
+        SharedDataStream sds(ds);
+        
+        double temp, relax_time;
+        
+        sds >> temp >> relax_time
+            >> langevin.frequent_save_velocities
+            >> langevin.constraint_type >> langevin.constraint_tolerance
+            >> static_cast<Integrator&>(langevin);
+            
+        langevin.temp = temp * kelvin;
+        langevin.relax_time = relax_time * picosecond;
+    }
+    else
+        throw version_error(v, "1", r_langevin, CODELOC);
+        
+    return ds;
+}
+
+/** Constructor - this integrates at 25 C with a relaxation time of 1 ps */
+Langevin::Langevin(bool frequent_save) 
+         : ConcreteProperty<Langevin,Integrator>(),
+           temp(25*celsius), relax_time(1*picosecond),
+           frequent_save_velocities(frequent_save),
+           constraint_type("none"), constraint_tolerance(1e-8)
+{}
+
+/** Construct to integrate at the passed temperature, 
+    with a relaxation time of 1 ps */
+Langevin::Langevin(Temperature temperature, bool frequent_save) 
+         : ConcreteProperty<Langevin,Integrator>(),
+           temp(temperature), relax_time(1*picosecond),
+           frequent_save_velocities(frequent_save),
+           constraint_type("none"), constraint_tolerance(1e-8)
+{}
+
+/** Construct to integrate at the passed temperature, coupled
+    to the heat bath with the passed relaxation time
+    
+    \throw SireError::invalid_arg
+*/
+Langevin::Langevin(Temperature temperature, Time relaxation_time, bool frequent_save) 
+         : ConcreteProperty<Langevin,Integrator>(),
+           temp(temperature), relax_time(1*picosecond),
+           frequent_save_velocities(frequent_save),
+           constraint_type("none"), constraint_tolerance(1e-8)
+{
+    this->setRelaxationTime(relaxation_time);
+}
+
+/** Copy constructor */
+Langevin::Langevin(const Langevin &other)
+         : ConcreteProperty<Langevin,Integrator>(other),
+           temp(other.temp), relax_time(other.relax_time),
+           frequent_save_velocities(other.frequent_save_velocities),
+           constraint_type(other.constraint_type),
+           constraint_tolerance(other.constraint_tolerance)
+{}
+
+/** Destructor */
+Langevin::~Langevin()
+{}
+
+/** Copy assignment operator */
+Langevin& Langevin::operator=(const Langevin &other)
+{
+    Integrator::operator=(other);
+    temp = other.temp;
+    relax_time = other.relax_time;
+    frequent_save_velocities = other.frequent_save_velocities;
+    constraint_type = other.constraint_type;
+    constraint_tolerance = other.constraint_tolerance;
+    
+    return *this;
+}
+
+/** Comparison operator */
+bool Langevin::operator==(const Langevin &other) const
+{
+    return temp == other.temp and relax_time == other.relax_time and
+           frequent_save_velocities == other.frequent_save_velocities and
+           constraint_type == other.constraint_type and
+           constraint_tolerance == other.constraint_tolerance and
+           Integrator::operator==(other);
+}
+
+/** Comparison operator */
+bool Langevin::operator!=(const Langevin &other) const
+{
+    return not Langevin::operator==(other);
+}
+
+/** Return a string representation of this integrator */
+QString Langevin::toString() const
+{
+    if (constraint_type == "none")
+        return QObject::tr("Langevin( temperature = %1 C, relaxation time = %2 ps )")
+                    .arg(temp.to(celsius)).arg(relax_time.to(picosecond));
+    else
+        return QObject::tr("Langevin( temperature = %1 C, relaxation time = %2 ps, "
+                           "constraints = %3 )")
+                    .arg(temp.to(celsius)).arg(relax_time.to(picosecond))
+                    .arg(constraint_type);
+}
+
+/** Set the temperature of the heat bath */
+void Langevin::setTemperature(Temperature temperature)
+{
+    temp = temperature;
+}
+
+/** Return the temperature of the heat bath */
+Temperature Langevin::temperature() const
+{
+    return temp;
+}
+
+/** Set the relaxation time of the heat bath. This is the inverse of
+    the friction coefficient, so smaller times couple the system more
+    strongly to the heat bath
+    
+    \throw SireError::invalid_arg
+*/
+void Langevin::setRelaxationTime(Time relaxation_time)
+{
+    if (relaxation_time.value() <= 0)
+        throw SireError::invalid_arg( QObject::tr(
+                "The relaxation time (%1 ps) must be greater than zero.")
+                    .arg(relaxation_time.to(picosecond)), CODELOC );
+
+    relax_time = relaxation_time;
+}
+
+/** Return the relaxation time of the heat bath (the inverse of
+    the friction coefficient) */
+Time Langevin::relaxationTime() const
+{
+    return relax_time;
+}
+
+/** Set the type of constraints to apply during the dynamics 
+    (see VelocityVerlet::setConstraintType)
+    
+    \throw SireError::invalid_arg
+*/
+void Langevin::setConstraintType(const QString &type)
+{
+    const QString t = type.toLower();
+    
+    if (t != "none" and t != "water" and t != "hbonds" and t != "allbonds")
+        throw SireError::invalid_arg( QObject::tr(
+                "Cannot set the constraint type to \"%1\". Available types are "
+                "\"none\", \"water\", \"hbonds\" and \"allbonds\".")
+                    .arg(type), CODELOC );
+    
+    constraint_type = t;
+}
+
+/** Return the type of constraints applied during the dynamics */
+QString Langevin::constraintType() const
+{
+    return constraint_type;
+}
+
+/** Set the relative tolerance to which the SHAKE / RATTLE constraints 
+    are satisfied
+    
+    \throw SireError::invalid_arg
+*/
+void Langevin::setConstraintTolerance(double tolerance)
+{
+    if (tolerance <= 0)
+        throw SireError::invalid_arg( QObject::tr(
+                "The constraint tolerance (%1) must be greater than zero.")
+                    .arg(tolerance), CODELOC );
+
+    constraint_tolerance = tolerance;
+}
+
+/** Return the relative tolerance to which the SHAKE / RATTLE constraints
+    are satisfied */
+double Langevin::constraintTolerance() const
+{
+    return constraint_tolerance;
+}
+                                                       
+/** Integrate the coordinates of the atoms in the molecules in the 
+    workspace using BAOAB Langevin dynamics
+    
+    \throw SireMol::missing_molecule
+    \throw SireBase::missing_property
+    \throw SireError:invalid_cast
+    \throw SireError::incompatible_error
+*/
+void Langevin::integrate(IntegratorWorkspace &workspace,
+                         const Symbol &nrg_component,
+                         SireUnits::Dimension::Time timestep,
+                         int nmoves, bool record_stats) const
+{
+    LangevinWorkspace &ws = workspace.asA<LangevinWorkspace>();
+    
+    if (ws.constraintType() != constraint_type)
+        ws.setConstraintType(constraint_type);
+    
+    const bool constrained = ws.hasConstraints();
+    
+    const double dt = timestep.value();
+    const double half_dt = 0.5 * dt;
+    
+    //the velocities are damped by c1 each step, and 
+    //the noise replaces the lost kinetic energy
+    const double c1 = std::exp( -dt / relax_time.value() );
+    const double c2 = std::sqrt( 1.0 - c1*c1 );
+    const double kT = temp.to(kelvin) * k_boltz;
+
+    const int nmols = ws.nMolecules();
+    
+    for (int imove=0; imove<nmoves; ++imove)
+    {
+        ws.calculateForces(nrg_component);
+        
+        QVector< QVector<Vector> > old_coords;
+        
+        if (constrained)
+            old_coords = ws.coordinates();
+        
+        const double *noise = ws.generateNoise();
+        
+        //B, A, O, A - loop over all molecules
+        for (int i=0; i<nmols; ++i)
+        {
+            const int nats = ws.nAtoms(i);
+        
+            Vector *x = ws.coordsArray(i);
+            const Vector *f = ws.forceArray(i);
+            Vector *p = ws.momentaArray(i);
+            const double *m = ws.massArray(i);
+
+            for (int j=0; j<nats; ++j)
+            {
+                if (m[j] != 0)
+                {
+                    // B : v(t + dt/2) = v(t) + (1/2) a(t) dt
+                    p[j] += (half_dt * f[j]);
+
+                    // A : r(t + dt/2) = r(t) + v(t + dt/2) dt/2
+                    x[j] += (half_dt / m[j]) * p[j];
+                    
+                    // O : v' = c1 v + c2 sqrt(kT / m) R
+                    const double sigma = c2 * std::sqrt(kT * m[j]);
+                    
+                    p[j] = c1 * p[j] + Vector( sigma * noise[3*j],
+                                               sigma * noise[3*j+1],
+                                               sigma * noise[3*j+2] );
+                    
+                    // A : r(t + dt) = r(t + dt/2) + v' dt/2
+                    x[j] += (half_dt / m[j]) * p[j];
+                }
+            }
+            
+            noise += 3*nats;
+        }
+        
+        //SETTLE / SHAKE the new coordinates back onto the constraints
+        if (constrained)
+            ws.constrainCoordinates(old_coords, dt, constraint_tolerance);
+
+        ws.commitCoordinates();
+        ws.calculateForces(nrg_component);
+        
+        //B : the final half-step velocity update
+        for (int i=0; i<nmols; ++i)
+        {
+            const int nats = ws.nAtoms(i);
+        
+            const Vector *f = ws.forceArray(i);
+            Vector *p = ws.momentaArray(i);
+            const double *m = ws.massArray(i);
+
+            for (int j=0; j<nats; ++j)
+            {
+                if (m[j] != 0)
+                    p[j] += (half_dt * f[j]);
+            }
+        }
+        
+        //RATTLE the velocities so that they are tangent to the constraints
+        if (constrained)
+            ws.constrainMomenta(constraint_tolerance);
+        
+        if (frequent_save_velocities)
+            ws.commitVelocities();
+        
+        if (record_stats)
+            ws.collectStatistics();
+    }
+    
+    if (not frequent_save_velocities)
+        ws.commitVelocities();
+}
+
+/** Create an empty workspace */
+IntegratorWorkspacePtr Langevin::createWorkspace(const PropertyMap &map) const
+{
+    LangevinWorkspace *ws = new LangevinWorkspace(map);
+    IntegratorWorkspacePtr wsptr(ws);
+    
+    ws->setConstraintType(constraint_type);
+    
+    return wsptr;
+}
+
+/** Create a workspace for this integrator for the molecule group 'molgroup' */
+IntegratorWorkspacePtr Langevin::createWorkspace(const MoleculeGroup &molgroup,
+                                                 const PropertyMap &map) const
+{
+    LangevinWorkspace *ws = new LangevinWorkspace(molgroup,map);
+    IntegratorWorkspacePtr wsptr(ws);
+    
+    ws->setConstraintType(constraint_type);
+    
+    return wsptr;
+}
+
+/** Return the ensemble of this integrator */
+Ensemble Langevin::ensemble() const
+{
+    return Ensemble::NVT(temp);
+}
+
+/** Return whether or not this integrator is time-reversible. The
+    stochastic dynamics are not time-reversible */
+bool Langevin::isTimeReversible() const
+{
+    return false;
+}
+
+const char* Langevin::typeName()
+{
+    return QMetaType::typeName( qMetaTypeId<Langevin>() );
+}
@@ -0,0 +1,148 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#ifndef SIREMOVE_LANGEVIN_H
+#define SIREMOVE_LANGEVIN_H
+
+#include "integrator.h"
+
+#include "SireUnits/temperature.h"
+
+SIRE_BEGIN_HEADER
+
+namespace SireMove
+{
+class Langevin;
+}
+
+QDataStream& operator<<(QDataStream&, const SireMove::Langevin&);
+QDataStream& operator>>(QDataStream&, SireMove::Langevin&);
+
+namespace SireMove
+{
+
+/** This class implements an atomistic Langevin (stochastic) dynamics
+    integrator, using the BAOAB splitting of Leimkuhler and Matthews
+    (Appl. Math. Res. Express, 2013, 34). Each step is a half-step velocity 
+    update from the forces (B), a half-step position update (A), an exact
+    Ornstein-Uhlenbeck update of the velocities (O), a second half-step 
+    position update (A), and a final half-step velocity update (B).
+    
+    This samples the canonical (NVT) ensemble, with configurational
+    averages that remain accurate at larger timesteps. The random 
+    numbers are taken from the generator of the LangevinWorkspace (set
+    via MolecularDynamics::setGenerator), so seeding that generator
+    gives a reproducible trajectory
+ 
+    @author Christopher Woods
+*/
+class SIREMOVE_EXPORT Langevin
+          : public SireBase::ConcreteProperty<Langevin,Integrator>
+{
+
+friend QDataStream& ::operator<<(QDataStream&, const Langevin&);
+friend QDataStream& ::operator>>(QDataStream&, Langevin&);
+
+public:
+    Langevin(bool frequent_save_velocities = false);
+    
+    Langevin(SireUnits::Dimension::Temperature temperature,
+             bool frequent_save_velocities = false);
+
+    Langevin(SireUnits::Dimension::Temperature temperature,
+             SireUnits::Dimension::Time relaxation_time,
+             bool frequent_save_velocities = false);
+    
+    Langevin(const Langevin &other);
+    
+    ~Langevin();
+    
+    Langevin& operator=(const Langevin &other);
+    
+    bool operator==(const Langevin &other) const;
+    bool operator!=(const Langevin &other) const;
+    
+    static const char* typeName();
+    
+    QString toString() const;
+    
+    Ensemble ensemble() const;
+    
+    bool isTimeReversible() const;
+    
+    void integrate(IntegratorWorkspace &workspace,
+                   const Symbol &nrg_component, 
+                   SireUnits::Dimension::Time timestep,
+                   int nmoves, bool record_stats) const;
+
+    IntegratorWorkspacePtr createWorkspace(const PropertyMap &map = PropertyMap()) const;
+    IntegratorWorkspacePtr createWorkspace(const MoleculeGroup &molgroup,
+                                           const PropertyMap &map = PropertyMap()) const;
+
+    void setTemperature(SireUnits::Dimension::Temperature temperature);
+    SireUnits::Dimension::Temperature temperature() const;
+
+    void setRelaxationTime(SireUnits::Dimension::Time relaxation_time);
+    SireUnits::Dimension::Time relaxationTime() const;
+
+    void setConstraintType(const QString &constraint_type);
+    QString constraintType() const;
+    
+    void setConstraintTolerance(double tolerance);
+    double constraintTolerance() const;
+
+private:
+    /** The temperature of the heat bath */
+    SireUnits::Dimension::Temperature temp;
+    
+    /** The relaxation time of the heat bath (the inverse 
+        of the friction coefficient) */
+    SireUnits::Dimension::Time relax_time;
+
+    /** Whether or not to save the velocities after every step, 
+        or to save them at the end of all of the steps */
+    bool frequent_save_velocities;
+    
+    /** The type of constraints applied during the dynamics
+        (see AtomicVelocityWorkspace::setConstraintType) */
+    QString constraint_type;
+    
+    /** The relative tolerance to which SHAKE / RATTLE
+        constraints are satisfied */
+    double constraint_tolerance;
+};
+
+}
+
+Q_DECLARE_METATYPE( SireMove::Langevin )
+
+SIRE_EXPOSE_CLASS( SireMove::Langevin )
+
+SIRE_END_HEADER
+
+#endif
@@ -56,12 +56,12 @@ static const RegisterMetaType<MolecularDynamics> r_moldyn;
 QDataStream SIREMOVE_EXPORT &operator<<(QDataStream &ds,
                                         const MolecularDynamics &moldyn)
 {
-    writeHeader(ds, r_moldyn, 1);
+    writeHeader(ds, r_moldyn, 2);
     
     SharedDataStream sds(ds);
     
     sds << moldyn.intgrator << moldyn.wspace << moldyn.timestep << moldyn.num_moves
-        << moldyn.total_time
+        << moldyn.total_time << moldyn.rangenerator
         << static_cast<const Dynamics&>(moldyn);
         
     return ds;
@@ -73,7 +73,15 @@ QDataStream SIREMOVE_EXPORT &operator>>(QDataStream &ds,
 {
     VersionID v = readHeader(ds, r_moldyn);
     
-    if (v == 1)
+    if (v == 2)
+    {
+        SharedDataStream sds(ds);
+    
+        sds >> moldyn.intgrator >> moldyn.wspace >> moldyn.timestep 
+            >> moldyn.num_moves >> moldyn.total_time >> moldyn.rangenerator
+            >> static_cast<Dynamics&>(moldyn);
+    }
+    else if (v == 1)
     {
         SharedDataStream sds(ds);
     
@@ -81,9 +89,10 @@ QDataStream SIREMOVE_EXPORT &operator>>(QDataStream &ds,
             >> moldyn.num_moves >> moldyn.total_time
             >> static_cast<Dynamics&>(moldyn);
              
+        moldyn.rangenerator = RanGenerator();
     }
     else
-        throw version_error(v, "1", r_moldyn, CODELOC);
+        throw version_error(v, "1, 2", r_moldyn, CODELOC);
         
     return ds;
 }
@@ -107,7 +116,7 @@ MolecularDynamics::MolecularDynamics(const MoleculeGroup &moleculegroup,
                     intgrator( VelocityVerlet() ), timestep(1*femtosecond), 
                     num_moves(0), total_time(0)
 {
-    wspace = intgrator.read().createWorkspace(moleculegroup, map);
+    this->createWorkspace(moleculegroup, map);
     Dynamics::setEnsemble( intgrator.read().ensemble() );
 }
     
@@ -120,7 +129,7 @@ MolecularDynamics::MolecularDynamics(const MoleculeGroup &moleculegroup,
                     intgrator(integrator), timestep(1*femtosecond), num_moves(0),
                     total_time(0)
 {
-    wspace = intgrator.read().createWorkspace(moleculegroup, map);
+    this->createWorkspace(moleculegroup, map);
     Dynamics::setEnsemble( intgrator.read().ensemble() );
 }
 
@@ -132,7 +141,7 @@ MolecularDynamics::MolecularDynamics(const MoleculeGroup &molgroup,
                     intgrator( VelocityVerlet() ), timestep(t), num_moves(0),
                     total_time(0)
 {
-    wspace = intgrator.read().createWorkspace(molgroup, map);
+    this->createWorkspace(molgroup, map);
     Dynamics::setEnsemble( intgrator.read().ensemble() );
 }
 
@@ -145,7 +154,7 @@ MolecularDynamics::MolecularDynamics(const MoleculeGroup &molgroup,
                     intgrator(integrator), timestep(t), num_moves(0),
                     total_time(0)
 {
-    wspace = intgrator.read().createWorkspace(molgroup, map);
+    this->createWorkspace(molgroup, map);
     Dynamics::setEnsemble( intgrator.read().ensemble() );
 }
 
@@ -154,13 +163,22 @@ MolecularDynamics::MolecularDynamics(const MolecularDynamics &other)
                   : ConcreteProperty<MolecularDynamics,Dynamics>(other),
                     intgrator(other.intgrator), wspace(other.wspace),
                     timestep(other.timestep), num_moves(other.num_moves),
-                    total_time(other.total_time)
+                    total_time(other.total_time), rangenerator(other.rangenerator)
 {}
 
 /** Destructor */
 MolecularDynamics::~MolecularDynamics()
 {}
 
+/** Internal function used to create a new workspace for the molecules
+    in 'molgroup', passing it the random number generator of this move */
+void MolecularDynamics::createWorkspace(const MoleculeGroup &molgroup,
+                                        const PropertyMap &map)
+{
+    wspace = intgrator.read().createWorkspace(molgroup, map);
+    wspace.edit().setGenerator(rangenerator);
+}
+
 /** Copy assignment operator */
 MolecularDynamics& MolecularDynamics::operator=(const MolecularDynamics &other)
 {
@@ -171,6 +189,7 @@ MolecularDynamics& MolecularDynamics::operator=(const MolecularDynamics &other)
         timestep = other.timestep;
         num_moves = other.num_moves;
         total_time = other.total_time;
+        rangenerator = other.rangenerator;
     
         Dynamics::operator=(other);
     }
@@ -186,6 +205,7 @@ bool MolecularDynamics::operator==(const MolecularDynamics &other) const
            timestep == other.timestep and
            num_moves == other.num_moves and 
            total_time == other.total_time and
+           rangenerator == other.rangenerator and
            Dynamics::operator==(other);
 }
 
@@ -234,7 +254,7 @@ void MolecularDynamics::setMoleculeGroup(const MoleculeGroup &new_molgroup)
 {
     if (new_molgroup.number() != this->moleculeGroup().number())
     {
-        wspace = intgrator.read().createWorkspace(new_molgroup, propertyMap());
+        this->createWorkspace(new_molgroup, propertyMap());
     }
 }
 
@@ -244,7 +264,7 @@ void MolecularDynamics::setMoleculeGroup(const MoleculeGroup &new_molgroup,
 {
     if (new_molgroup.number() != this->moleculeGroup().number())
     {
-        wspace = intgrator.read().createWorkspace(new_molgroup, map);
+        this->createWorkspace(new_molgroup, map);
     }
     else
     {
@@ -259,7 +279,7 @@ void MolecularDynamics::setIntegrator(const Integrator &integrator)
     if (intgrator != integrator)
     {
         intgrator = integrator;
-        wspace = intgrator.read().createWorkspace( moleculeGroup(), propertyMap() );
+        this->createWorkspace( moleculeGroup(), propertyMap() );
         Dynamics::setEnsemble( intgrator.read().ensemble() );
     }
 }
@@ -366,16 +386,18 @@ MolarEnergy MolecularDynamics::kineticEnergy() const
     velocities */
 void MolecularDynamics::clearStatistics()
 {
-    wspace = intgrator.read().createWorkspace( moleculeGroup(), propertyMap() );
+    this->createWorkspace( moleculeGroup(), propertyMap() );
     num_moves = 0;
     total_time = Time(0);
 }
 
 /** Set the random number generator used by this move
     (this move may be completely deterministic, so may not
-     use a generator) */
+     use a generator). This is also used by any workspace
+     that is created later, e.g. by clearStatistics() */
 void MolecularDynamics::setGenerator(const RanGenerator &generator)
 {
+    rangenerator = generator;
     wspace.edit().setGenerator(generator);
 }
 
@@ -154,6 +154,8 @@ public:
     void setGenerator(const RanGenerator &generator);
 
 private:
+    void createWorkspace(const MoleculeGroup &molgroup, const PropertyMap &map);
+
     /** The integrator used to solve Newton's laws */
     IntegratorPtr intgrator;
     
@@ -168,6 +170,11 @@ private:
     
     /** The total amount of time simulated using this move */
     SireUnits::Dimension::Time total_time;
+
+    /** The random number generator passed to every workspace that
+        is created, so that a new workspace (e.g. after clearStatistics()
+        or setIntegrator()) uses the same generator as the old one */
+    SireMaths::RanGenerator rangenerator;
 };
 
 }
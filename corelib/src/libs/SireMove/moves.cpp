@@ -34,6 +34,8 @@
 
 #include "SireMaths/rangenerator.h"
 
+#include "SireBase/profiler.h"
+
 #include "SireUnits/units.h"
 #include "SireUnits/temperature.h"
 #include "SireUnits/dimensions.h"
@@ -595,7 +597,10 @@ System SameMoves::move(const System &system, int nmoves, bool record_stats)
         this->preCheck(new_system);
 
         //perform the moves
-        mv.edit().move(new_system, nmoves, record_stats);
+        {
+            SIRE_PROFILE( mv.read().what() );
+            mv.edit().move(new_system, nmoves, record_stats);
+        }
         
         //ensure that the system has been placed into a sane state
         //after the moves
@@ -383,7 +383,11 @@ void MTSMC::move(System &system, int nmoves, bool record_stats)
         //nothing to do
         return;
 
-    System old_system_state(system);
+    //record all of the changes made by these moves, so that they
+    //can be undone if an exception is thrown
+    const int depth = system.transactionDepth();
+    system.beginTransaction();
+
     MTSMC old_state(*this);
     
     try
@@ -394,8 +398,10 @@ void MTSMC::move(System &system, int nmoves, bool record_stats)
             double old_slow_nrg = system.energy(this->slowEnergyComponent());
             double old_fast_nrg = system.energy(this->fastEnergyComponent());
     
-            //save the old system
-            System old_system = system;
+            //start recording the changes to the system, so that they
+            //can be undone if the move is rejected (the fast moves
+            //record their own changes in nested transactions)
+            system.beginTransaction();
             
             //now perform the moves (without recording statistics)
             system = fastmoves.edit().move(system, nfastmoves, false);
@@ -417,20 +423,27 @@ void MTSMC::move(System &system, int nmoves, bool record_stats)
             if (not MonteCarlo::test(new_nrg, old_nrg))
             {
                 //restore the old configuration
-                system = old_system;
+                system.rollbackTransaction();
                 slow_constraints = old_slow_constraints;
             }
+            else
+                system.commitTransaction();
 
             if (record_stats)
             {
                 system.collectStats();
             }
         }
+
+        system.commitTransaction();
     }
     catch(...)
     {
         this->operator=(old_state);
-        system = old_system_state;
+        while (system.transactionDepth() > depth)
+        {
+            system.rollbackTransaction();
+        }
         
         throw;
     }
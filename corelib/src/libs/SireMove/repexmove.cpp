@@ -502,7 +502,7 @@ static const RegisterMetaType<RepExMove> r_repexmove;
 /** Serialise to a binary datastream */
 QDataStream SIREMOVE_EXPORT &operator<<(QDataStream &ds, const RepExMove &repexmove)
 {
-    writeHeader(ds, r_repexmove, 3);
+    writeHeader(ds, r_repexmove, 4);
 
     SharedDataStream sds(ds);
     
@@ -511,6 +511,7 @@ QDataStream SIREMOVE_EXPORT &operator<<(QDataStream &ds, const RepExMove &repexm
         << repexmove.nreject
         << repexmove.swap_monitors
         << repexmove.disable_swaps
+        << repexmove.async_exchange
         << static_cast<const SupraMove&>(repexmove);
         
     return ds;
@@ -522,8 +523,21 @@ QDataStream SIREMOVE_EXPORT &operator>>(QDataStream &ds, RepExMove &repexmove)
     VersionID v = readHeader(ds, r_repexmove);
 
     repexmove.disable_swaps = false;
+    repexmove.async_exchange = false;
 
-    if (v == 3)
+    if (v == 4)
+    {
+        SharedDataStream sds(ds);
+        
+        sds >> repexmove.rangenerator
+            >> repexmove.naccept
+            >> repexmove.nreject
+            >> repexmove.swap_monitors
+            >> repexmove.disable_swaps
+            >> repexmove.async_exchange
+            >> static_cast<SupraMove&>(repexmove);
+    }
+    else if (v == 3)
     {
         SharedDataStream sds(ds);
         
@@ -558,7 +572,7 @@ QDataStream SIREMOVE_EXPORT &operator>>(QDataStream &ds, RepExMove &repexmove)
         repexmove.swap_monitors = false;
     }
     else
-        throw version_error(v, "1-3", r_repexmove, CODELOC);
+        throw version_error(v, "1-4", r_repexmove, CODELOC);
         
     return ds;
 }
@@ -566,7 +580,8 @@ QDataStream SIREMOVE_EXPORT &operator>>(QDataStream &ds, RepExMove &repexmove)
 /** Constructor */
 RepExMove::RepExMove()
           : ConcreteProperty<RepExMove,SupraMove>(),
-            naccept(0), nreject(0), swap_monitors(false), disable_swaps(false)
+            naccept(0), nreject(0), swap_monitors(false), disable_swaps(false),
+            async_exchange(false)
 {}
 
 /** Copy constructor */
@@ -574,7 +589,8 @@ RepExMove::RepExMove(const RepExMove &other)
           : ConcreteProperty<RepExMove,SupraMove>(other),
             naccept(other.naccept), nreject(other.nreject),
             swap_monitors(other.swap_monitors),
-            disable_swaps(other.disable_swaps)
+            disable_swaps(other.disable_swaps),
+            async_exchange(other.async_exchange)
 {}
 
 /** Destructor */
@@ -592,6 +608,7 @@ RepExMove& RepExMove::operator=(const RepExMove &other)
         nreject = other.nreject;
         swap_monitors = other.swap_monitors;
         disable_swaps = other.disable_swaps;
+        async_exchange = other.async_exchange;
     }
     
     return *this;
@@ -603,7 +620,8 @@ bool RepExMove::operator==(const RepExMove &other) const
     return (this == &other) or
            (naccept == other.naccept and nreject == other.nreject and
             swap_monitors == other.swap_monitors and
-            disable_swaps == other.disable_swaps and SupraMove::operator==(other));
+            disable_swaps == other.disable_swaps and
+            async_exchange == other.async_exchange and SupraMove::operator==(other));
 }
 
 /** Comparison operator */
@@ -642,6 +660,27 @@ void RepExMove::setDisableSwaps(bool disable)
     disable_swaps = disable;
 }
 
+/** Return whether or not pairs of replicas are tested and swapped
+    asynchronously, as soon as both replicas in the pair have finished
+    their block of sampling */
+bool RepExMove::isAsynchronous() const
+{
+    return async_exchange;
+}
+
+/** Switch on or off asynchronous replica exchange. In asynchronous
+    mode, the replicas are not run in lock-step. Instead, each
+    pair of neighbouring replicas is tested as soon as both replicas
+    have finished their block, and the pair is then immediately
+    resubmitted for their next block. This means that fast replicas
+    are not held up waiting for the slowest replica in the ensemble.
+    The pairing of neighbours alternates between even and odd pairs,
+    so each replica will still run exactly 'nmoves' blocks */
+void RepExMove::setAsynchronous(bool asynchronous)
+{
+    async_exchange = asynchronous;
+}
+
 /** Return the average acceptance ratio of the replica exchange
     tests over all replicas */
 double RepExMove::acceptanceRatio() const
@@ -829,10 +868,12 @@ static void waitUntilFinished(Nodes &nodes, QVector<SupraSubSim> &subsims, int m
     }
 }
 
-/** Internal function used to test the passed pair of replicas - 
-    this returns whether or not the test has passed */
+/** Internal function used to test the passed pair of replicas, using
+    the uniform random number 'ran' - this returns whether or not 
+    the test has passed */
 bool RepExMove::testPair(const Replica &replica_a, const RepExSubMove &move_a, 
-                         const Replica &replica_b, const RepExSubMove &move_b) const
+                         const Replica &replica_b, const RepExSubMove &move_b,
+                         double ran) const
 {
     //get the ensembles of the two replicas
     const Ensemble &ensemble_a = replica_a.ensemble();
@@ -890,7 +931,7 @@ bool RepExMove::testPair(const Replica &replica_a, const RepExSubMove &move_a,
         double delta = beta_b * ( H_b_i - H_b_j + p_b*(V_b_i - V_b_j) ) +
                        beta_a * ( H_a_i - H_a_j + p_a*(V_a_i - V_a_j) );
         
-        bool move_passed = ( delta > 0 or (std::exp(delta) >= rangenerator.rand()) );
+        bool move_passed = ( delta > 0 or (std::exp(delta) >= ran) );
                 
         return move_passed;
     }
@@ -906,6 +947,25 @@ bool RepExMove::testPair(const Replica &replica_a, const RepExSubMove &move_a,
     return false;
 }
 
+/** Internal function used to draw the random numbers used to test
+    each of the pairs of replicas that are tested in a block (the even
+    pairs if 'even_pairs' is true, else the odd pairs). A number is drawn
+    for every pair, in pair order, so that the numbers used do not 
+    depend on the order in which the pairs are tested */
+QVector<double> RepExMove::drawPairRandoms(int nreplicas, bool even_pairs) const
+{
+    const int start = even_pairs ? 0 : 1;
+
+    QVector<double> rands;
+    
+    for (int i=start; i<nreplicas-1; i+=2)
+    {
+        rands.append( rangenerator.rand() );
+    }
+    
+    return rands;
+}
+
 /** Internal function used to test and swap all pairs of replicas */
 void RepExMove::testAndSwap(Replicas &replicas, const QVector<RepExSubMove> &submoves,
                             bool even_pairs, bool record_stats)
@@ -918,12 +978,15 @@ void RepExMove::testAndSwap(Replicas &replicas, const QVector<RepExSubMove> &sub
         
         if (even_pairs)
             start = 0;
+        
+        const QVector<double> rands = this->drawPairRandoms(nreplicas, even_pairs);
             
         //loop over all pairs
         for (int i=start; i<nreplicas-1; i+=2)
         {
             if (this->testPair(replicas[i], submoves.at(i),
-                               replicas[i+1], submoves.at(i+1) ))
+                               replicas[i+1], submoves.at(i+1),
+                               rands.at((i-start)/2)))
             {
                 //swap the replicas
                 replicas.swapSystems(i, i+1, swap_monitors);
@@ -982,6 +1045,289 @@ void RepExMove::performMove(Nodes &nodes, Replicas &replicas, bool record_stats)
         replicas.collectSupraStats();
 }
 
+/** Internal function used to return the partner of replica 'i' (of
+    'nreplicas') when the even (or odd) pairs are being swapped. This
+    returns -1 if the replica does not have a partner */
+static int getPartner(int i, int nreplicas, bool even_pairs)
+{
+    int start = 1;
+    
+    if (even_pairs)
+        start = 0;
+        
+    if (i < start)
+        return -1;
+        
+    else if ( (i-start) % 2 == 0 )
+    {
+        if (i+1 < nreplicas)
+            return i+1;
+        else
+            return -1;
+    }
+    else
+        return i-1;
+}
+
+/** Internal function used to submit the next block of sampling for the
+    replica in slot 'i', whose current state is in 'system', and whose
+    partner for the exchange test at the end of this block is 'partner' */
+static SupraSubSim submitAsyncSimulation(Nodes &nodes, const Replicas &replicas,
+                                         const SupraSubSystem &system,
+                                         int i, int partner, bool record_stats)
+{
+    Node node = nodes.getNode();
+    
+    if (partner < 0)
+        return SupraSubSim::run( node, system, RepExSubMove(), 1, record_stats );
+    else
+        //the partner only provides the thermodynamic parameters of its
+        //slot, which do not change during sampling, so the (possibly
+        //stale) copy of the partner in 'replicas' can be used
+        return SupraSubSim::run( node, system,
+                                 RepExSubMove(replicas[i], replicas[partner]),
+                                 1, record_stats );
+}
+
+/** Internal function that performs 'nmoves' blocks of sampling on all
+    replicas, testing and swapping each pair of neighbouring replicas
+    as soon as both have completed the block. The replicas are not
+    synchronised, so fast replicas can start their next block straight away.
+    
+    The result of each block is kept only locally, and is used
+    directly as the input of the next block. The systems are only
+    copied back into 'replicas' when a pair are swapped, or when all
+    of the moves have finished.
+*/
+void RepExMove::performAsyncMoves(Nodes &nodes, Replicas &replicas,
+                                  int nmoves, bool record_stats)
+{
+    const int nreplicas = replicas.nReplicas();
+    const int max_tries = 5;
+
+    //choose in advance whether even or odd pairs are swapped in each
+    //block, and draw the random numbers for the test of each pair,
+    //so that the result is independent of the order in which the 
+    //replicas finish. These are drawn in the same order as performMove,
+    //so the same exchanges are made as by lock-step exchange
+    QVector<bool> even_pairs(nmoves, true);
+    QVector< QVector<double> > pair_rands(nmoves);
+    
+    for (int i=0; i<nmoves; ++i)
+    {
+        if (nreplicas > 2)
+            even_pairs[i] = rangenerator.randBool();
+        
+        if (not disable_swaps)
+            pair_rands[i] = this->drawPairRandoms(nreplicas, even_pairs[i]);
+    }
+
+    //the replica IDs in each slot at the end of each block. These
+    //are recorded as each slot completes the block, and are used to 
+    //collect the statistics of the block once all slots have completed it
+    QVector< QVector<quint32> > block_ids;
+    
+    if (record_stats)
+        block_ids = QVector< QVector<quint32> >(nmoves, QVector<quint32>(nreplicas, 0));
+
+    //the number of blocks completed by each replica
+    QVector<int> nblocks(nreplicas, 0);
+    
+    //the number of times each block has been retried
+    QVector<int> ntries(nreplicas, 0);
+    
+    //whether each replica has finished its current block and is 
+    //waiting for its partner
+    QVector<bool> waiting(nreplicas, false);
+    
+    //whether or not the system in 'replicas' is up to date
+    QVector<bool> synced(nreplicas, true);
+    
+    //the current system of each replica, and the energies
+    //calculated at the end of the last block
+    QVector<SupraSubSystemPtr> systems(nreplicas);
+    QVector<RepExSubMove> submoves(nreplicas);
+    
+    QVector<SupraSubSim> subsims(nreplicas);
+    
+    int nrunning = 0;
+    int nstats = 0;
+    
+    for (int i=0; i<nreplicas; ++i)
+    {
+        systems[i] = replicas[i];
+        subsims[i] = ::submitAsyncSimulation(nodes, replicas, *(systems[i]), i,
+                                             ::getPartner(i, nreplicas, even_pairs[0]),
+                                             record_stats);
+        ++nrunning;
+    }
+    
+    while (nrunning > 0)
+    {
+        //find a replica that has finished its block
+        int i = -1;
+        
+        for (int j=0; j<nreplicas; ++j)
+        {
+            if (nblocks[j] < nmoves and not waiting[j] and 
+                not subsims[j].isRunning())
+            {
+                i = j;
+                break;
+            }
+        }
+        
+        if (i == -1)
+        {
+            //nothing has finished - wait a little for the first running replica
+            for (int j=0; j<nreplicas; ++j)
+            {
+                if (nblocks[j] < nmoves and not waiting[j])
+                {
+                    subsims[j].wait(100);
+                    break;
+                }
+            }
+            
+            continue;
+        }
+        
+        SupraSubSim &subsim = subsims[i];
+        
+        if (subsim.isError() or subsim.wasAborted())
+        {
+            ++ntries[i];
+            
+            if (ntries[i] > max_tries)
+                subsim.throwError();
+                
+            //resubmit this calculation
+            Node node = nodes.getNode();
+            subsim = SupraSubSim::run(node, subsim.input());
+            continue;
+        }
+        else if (not subsim.hasFinished())
+        {
+            ++ntries[i];
+            
+            if (ntries[i] > max_tries)
+                throw SireError::unavailable_resource( QObject::tr(
+                        "Could not complete the block of sampling for replica %1 "
+                        "after %2 attempts.").arg(i).arg(max_tries), CODELOC );
+        
+            //continue the calculation from where it finished
+            SupraSubSimPacket simpacket = subsim.result();
+            
+            Node node = nodes.getNode();
+            subsim = SupraSubSim::run(node, simpacket);
+            continue;
+        }
+        
+        //the block has finished
+        ntries[i] = 0;
+        --nrunning;
+        
+        {
+            SupraSubSimPacket result = subsim.result();
+        
+            submoves[i] = result.subMoves().asA<SameSupraSubMoves>()[0]
+                                           .asA<RepExSubMove>();
+            systems[i] = result.subSystem();
+            synced[i] = false;
+        }
+        
+        //release the handle as it is no longer needed
+        subsim = SupraSubSim();
+        waiting[i] = true;
+        
+        const int block = nblocks[i];
+        const int partner = ::getPartner(i, nreplicas, even_pairs[block]);
+        
+        QList<int> ready;
+        
+        if (partner < 0)
+        {
+            ready.append(i);
+        }
+        else if (waiting[partner] and nblocks[partner] == block)
+        {
+            if (not disable_swaps)
+            {
+                const int a = qMin(i, partner);
+                const int b = qMax(i, partner);
+            
+                const int start = even_pairs[block] ? 0 : 1;
+            
+                if (this->testPair(replicas[a], submoves.at(a),
+                                   replicas[b], submoves.at(b),
+                                   pair_rands[block].at((a-start)/2)))
+                {
+                    //copy back the two systems so that they can be swapped
+                    replicas.setReplica(a, systems[a]->asA<Replica>());
+                    replicas.setReplica(b, systems[b]->asA<Replica>());
+                    
+                    replicas.swapSystems(a, b, swap_monitors);
+                    
+                    systems[a] = replicas[a];
+                    systems[b] = replicas[b];
+                    synced[a] = true;
+                    synced[b] = true;
+                    
+                    ++naccept;
+                }
+                else
+                    ++nreject;
+            }
+            
+            ready.append(i);
+            ready.append(partner);
+        }
+        
+        foreach (int j, ready)
+        {
+            if (record_stats)
+                block_ids[block][j] = replicas.replicaIDs().at(j);
+        
+            waiting[j] = false;
+            nblocks[j] += 1;
+            
+            if (nblocks[j] < nmoves)
+            {
+                subsims[j] = ::submitAsyncSimulation(nodes, replicas, *(systems[j]), j,
+                                          ::getPartner(j, nreplicas, even_pairs[nblocks[j]]),
+                                          record_stats);
+                ++nrunning;
+            }
+        }
+
+        //collect the statistics of each block once all of the replicas
+        //have completed it
+        if (record_stats)
+        {
+            int min_blocks = nblocks[0];
+            
+            for (int j=1; j<nreplicas; ++j)
+            {
+                min_blocks = qMin(min_blocks, nblocks[j]);
+            }
+            
+            while (nstats < min_blocks)
+            {
+                replicas.collectSupraStats(block_ids.at(nstats));
+                block_ids[nstats] = QVector<quint32>();
+                ++nstats;
+            }
+        }
+    }
+    
+    //finally copy all of the systems back into the replicas
+    for (int i=0; i<nreplicas; ++i)
+    {
+        if (not synced[i])
+            replicas.setReplica(i, systems[i]->asA<Replica>());
+    }
+}
+
 /** Perform 'nmoves' replica exchange moves (block of sampling for all
     replicas, then replica exchange test between all pairs),
     of the system 'system' (which must be a Replicas object), optionally
@@ -1008,9 +1354,16 @@ void RepExMove::move(SupraSystem &system, int nmoves, bool record_stats)
         {
             ThisThread this_thread = nodes.borrowThisThread();
         
-            for (int i=0; i<nmoves; ++i)
+            if (async_exchange and replicas.nReplicas() > 1)
             {
-                this->performMove(nodes, replicas, record_stats);
+                this->performAsyncMoves(nodes, replicas, nmoves, record_stats);
+            }
+            else
+            {
+                for (int i=0; i<nmoves; ++i)
+                {
+                    this->performMove(nodes, replicas, record_stats);
+                }
             }
 
             SupraMove::incrementNMoves(nmoves);
@@ -142,6 +142,13 @@ private:
     on each of the replicas, and then performing replice exchange swaps
     and tests between pairs.
     
+    By default all replicas run their block of sampling in lock-step,
+    so the slowest replica gates every exchange. If asynchronous
+    exchange is switched on (setAsynchronous) then each pair of
+    neighbouring replicas is tested as soon as both have finished
+    their block, and the replicas can then immediately start their
+    next block without waiting for the rest of the ensemble.
+    
     @author Christopher Woods
 */
 class SIREMOVE_EXPORT RepExMove 
@@ -178,6 +185,9 @@ public:
     bool swapMovesDisabled() const;
     void setDisableSwaps(bool disable);
     
+    bool isAsynchronous() const;
+    void setAsynchronous(bool asynchronous);
+    
     QString toString() const;
     
     void setGenerator(const RanGenerator &generator);
@@ -189,8 +199,14 @@ private:
     void performMove(SireCluster::Nodes &nodes, Replicas &replicas,
                      bool record_stats);
 
+    void performAsyncMoves(SireCluster::Nodes &nodes, Replicas &replicas,
+                           int nmoves, bool record_stats);
+
     bool testPair(const Replica &replica_a, const RepExSubMove &move_a,
-                  const Replica &replica_b, const RepExSubMove &move_b) const;
+                  const Replica &replica_b, const RepExSubMove &move_b,
+                  double ran) const;
+
+    QVector<double> drawPairRandoms(int nreplicas, bool even_pairs) const;
 
     void testAndSwap(Replicas &replicas, const QVector<RepExSubMove> &submoves,
                      bool even_pairs, bool record_stats);
@@ -211,6 +227,10 @@ private:
     /** Whether or not to disable RETI tests. This is useful when you want
         to just use this to RUN TI on a lot of replicas in parallel */
     bool disable_swaps;
+    
+    /** Whether or not to test and swap pairs of replicas as soon as
+        both have finished their block, rather than in lock-step */
+    bool async_exchange;
 };
 
 }
@@ -310,15 +310,35 @@ const QVector<quint32>& Replicas::replicaIDs() const
     This allows the lambda trajectory for each replica to be easily
     collected during a simulation */
 QVector<double> Replicas::lambdaTrajectory() const
+{
+    return this->lambdaTrajectory(replica_ids);
+}
+
+/** Return the lambda values for each of the replicas, in replica ID order,
+    if the replicas had the IDs 'replica_ids' (in order of replica index).
+    This is used to collect the lambda trajectory of a block of an
+    asynchronous replica exchange simulation, as the replicas may have
+    moved on to later blocks before all of the replicas have finished
+    that block
+    
+    \throw SireError::incompatible_error
+*/
+QVector<double> Replicas::lambdaTrajectory(const QVector<quint32> &ids) const
 {
     if (this->nReplicas() == 0)
         return QVector<double>();
 
+    if (ids.count() != this->nReplicas())
+        throw SireError::incompatible_error( QObject::tr(
+                "Cannot get the lambda trajectory using %1 replica IDs as "
+                "there are %2 replicas.")
+                    .arg(ids.count()).arg(this->nReplicas()), CODELOC );
+
     QVector<double> lamtraj( this->nReplicas() );
     
     for (int i=0; i<this->nReplicas(); ++i)
     {
-        lamtraj[ replica_ids[i] ] = this->at(i).lambdaValue();
+        lamtraj[ ids[i] ] = this->at(i).lambdaValue();
     }
     
     return lamtraj;
@@ -330,6 +350,13 @@ void Replicas::collectSupraStats()
     replica_history.append( lambdaTrajectory() );
 }
 
+/** Collect statistics - this records the lambdaTrajectory of the replicas
+    if they had the IDs 'replica_ids', and adds it to the history */
+void Replicas::collectSupraStats(const QVector<quint32> &ids)
+{
+    replica_history.append( lambdaTrajectory(ids) );
+}
+
 /** Return the history of lambda values sampled by each replica */
 QList< QVector<double> > Replicas::lambdaTrajectoryHistory() const
 {
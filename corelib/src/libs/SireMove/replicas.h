@@ -98,8 +98,10 @@ public:
     const QVector<quint32>& replicaIDs() const;
     
     void collectSupraStats();
+    void collectSupraStats(const QVector<quint32> &replica_ids);
     
     QVector<double> lambdaTrajectory() const;
+    QVector<double> lambdaTrajectory(const QVector<quint32> &replica_ids) const;
     
     QList< QVector<double> > lambdaTrajectoryHistory() const;
     
@@ -0,0 +1,476 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#include "respa.h"
+#include "ensemble.h"
+
+#include "SireMol/moleculegroup.h"
+#include "SireMol/partialmolecule.h"
+#include "SireMol/molecule.h"
+
+#include "SireSystem/system.h"
+
+#include "SireFF/forcetable.h"
+
+#include "SireMaths/rangenerator.h"
+
+#include "SireStream/datastream.h"
+#include "SireStream/shareddatastream.h"
+
+#include "SireUnits/units.h"
+
+#include "SireError/errors.h"
+
+using namespace SireMove;
+using namespace SireSystem;
+using namespace SireMol;
+using namespace SireFF;
+using namespace SireCAS;
+using namespace SireVol;
+using namespace SireBase;
+using namespace SireStream;
+using namespace SireUnits;
+using namespace SireUnits::Dimension;
+
+static const RegisterMetaType<RESPA> r_respa;
+
+/** Serialise to a binary datastream */
+QDataStream SIREMOVE_EXPORT &operator<<(QDataStream &ds, const RESPA &respa)
+{
+    writeHeader(ds, r_respa, 1);
+    
+    SharedDataStream sds(ds);
+    
+    sds << respa.level_components << respa.level_nsteps
+        << respa.frequent_save_velocities
+        << respa.constraint_type << respa.constraint_tolerance
+        << static_cast<const Integrator&>(respa);
+        
+    return ds;
+}
+
+/** Extract from a binary datastream */
+QDataStream SIREMOVE_EXPORT &operator>>(QDataStream &ds, RESPA &respa)
+{
+    VersionID v = readHeader(ds, r_respa);
+    
+    if (v == 1)
+    {
+        SharedDataStream sds(ds);
+        
+        sds >> respa.level_components >> respa.level_nsteps
+            >> respa.frequent_save_velocities
+            >> respa.constraint_type >> respa.constraint_tolerance
+            >> static_cast<Integrator&>(respa);
+    }
+    else
+        throw version_error(v, "1", r_respa, CODELOC);
+        
+    return ds;
+}
+
+/** Constructor - this has no time levels, so integrates the 
+    sampled energy component using velocity verlet */
+RESPA::RESPA(bool frequent_save) 
+      : ConcreteProperty<RESPA,Integrator>(),
+        frequent_save_velocities(frequent_save),
+        constraint_type("none"), constraint_tolerance(1e-8)
+{}
+
+/** Construct a two-level integrator, where the forces of 'fast_component'
+    are evaluated every inner step, and the forces of 'slow_component'
+    are evaluated once every 'nsubsteps' inner steps
+    
+    \throw SireError::invalid_arg
+*/
+RESPA::RESPA(const Symbol &fast_component, const Symbol &slow_component,
+             int nsubsteps, bool frequent_save)
+      : ConcreteProperty<RESPA,Integrator>(),
+        frequent_save_velocities(frequent_save),
+        constraint_type("none"), constraint_tolerance(1e-8)
+{
+    this->addLevel(fast_component);
+    this->addLevel(slow_component, nsubsteps);
+}
+
+/** Copy constructor */
+RESPA::RESPA(const RESPA &other)
+      : ConcreteProperty<RESPA,Integrator>(other),
+        level_components(other.level_components),
+        level_nsteps(other.level_nsteps),
+        frequent_save_velocities(other.frequent_save_velocities),
+        constraint_type(other.constraint_type),
+        constraint_tolerance(other.constraint_tolerance)
+{}
+
+/** Destructor */
+RESPA::~RESPA()
+{}
+
+/** Copy assignment operator */
+RESPA& RESPA::operator=(const RESPA &other)
+{
+    Integrator::operator=(other);
+    level_components = other.level_components;
+    level_nsteps = other.level_nsteps;
+    frequent_save_velocities = other.frequent_save_velocities;
+    constraint_type = other.constraint_type;
+    constraint_tolerance = other.constraint_tolerance;
+    
+    return *this;
+}
+
+/** Comparison operator */
+bool RESPA::operator==(const RESPA &other) const
+{
+    return level_components == other.level_components and
+           level_nsteps == other.level_nsteps and
+           frequent_save_velocities == other.frequent_save_velocities and
+           constraint_type == other.constraint_type and
+           constraint_tolerance == other.constraint_tolerance and
+           Integrator::operator==(other);
+}
+
+/** Comparison operator */
+bool RESPA::operator!=(const RESPA &other) const
+{
+    return not RESPA::operator==(other);
+}
+
+/** Return a string representation of this integrator */
+QString RESPA::toString() const
+{
+    QStringList levels;
+    
+    for (int i=0; i<level_components.count(); ++i)
+    {
+        if (i == 0)
+            levels.append( level_components.at(i).toString() );
+        else
+            levels.append( QString("%1 x %2").arg(level_components.at(i).toString())
+                                             .arg(level_nsteps.at(i)) );
+    }
+    
+    if (constraint_type == "none")
+        return QObject::tr("RESPA( %1 )").arg(levels.join(", "));
+    else
+        return QObject::tr("RESPA( %1, constraints = %2 )")
+                    .arg(levels.join(", ")).arg(constraint_type);
+}
+
+/** Add a new, slowest (outermost) time level, which integrates the forces
+    of the energy component 'component'. Each step of this level runs
+    'nsubsteps' steps of the level below. 'nsubsteps' is ignored for
+    the first (innermost) level
+    
+    \throw SireError::invalid_arg
+*/
+void RESPA::addLevel(const Symbol &component, int nsubsteps)
+{
+    if (component.isNull())
+        throw SireError::invalid_arg( QObject::tr(
+                "You must supply an energy component for each time level."), CODELOC );
+
+    if (level_components.isEmpty())
+        nsubsteps = 1;
+
+    else if (nsubsteps < 1)
+        throw SireError::invalid_arg( QObject::tr(
+                "The number of sub-steps of each time level (%1) must be "
+                "at least 1.").arg(nsubsteps), CODELOC );
+
+    level_components.append(component);
+    level_nsteps.append(nsubsteps);
+}
+
+/** Remove all of the time levels */
+void RESPA::clearLevels()
+{
+    level_components.clear();
+    level_nsteps.clear();
+}
+
+/** Return the number of time levels */
+int RESPA::nLevels() const
+{
+    return level_components.count();
+}
+
+/** Return the energy component integrated at time level 'level'
+    
+    \throw SireError::invalid_index
+*/
+Symbol RESPA::levelComponent(int level) const
+{
+    if (level < 0 or level >= level_components.count())
+        throw SireError::invalid_index( QObject::tr(
+                "Invalid time level (%1). The number of levels is %2.")
+                    .arg(level).arg(level_components.count()), CODELOC );
+
+    return level_components.at(level);
+}
+
+/** Return the number of steps of the level below that are run for 
+    each step of time level 'level'
+    
+    \throw SireError::invalid_index
+*/
+int RESPA::nSubSteps(int level) const
+{
+    if (level < 0 or level >= level_nsteps.count())
+        throw SireError::invalid_index( QObject::tr(
+                "Invalid time level (%1). The number of levels is %2.")
+                    .arg(level).arg(level_nsteps.count()), CODELOC );
+
+    return level_nsteps.at(level);
+}
+
+/** Set the type of constraints to apply during the dynamics 
+    (see VelocityVerlet::setConstraintType)
+    
+    \throw SireError::invalid_arg
+*/
+void RESPA::setConstraintType(const QString &type)
+{
+    const QString t = type.toLower();
+    
+    if (t != "none" and t != "water" and t != "hbonds" and t != "allbonds")
+        throw SireError::invalid_arg( QObject::tr(
+                "Cannot set the constraint type to \"%1\". Available types are "
+                "\"none\", \"water\", \"hbonds\" and \"allbonds\".")
+                    .arg(type), CODELOC );
+    
+    constraint_type = t;
+}
+
+/** Return the type of constraints applied during the dynamics */
+QString RESPA::constraintType() const
+{
+    return constraint_type;
+}
+
+/** Set the relative tolerance to which the SHAKE / RATTLE constraints 
+    are satisfied
+    
+    \throw SireError::invalid_arg
+*/
+void RESPA::setConstraintTolerance(double tolerance)
+{
+    if (tolerance <= 0)
+        throw SireError::invalid_arg( QObject::tr(
+                "The constraint tolerance (%1) must be greater than zero.")
+                    .arg(tolerance), CODELOC );
+
+    constraint_tolerance = tolerance;
+}
+
+/** Return the relative tolerance to which the SHAKE / RATTLE constraints
+    are satisfied */
+double RESPA::constraintTolerance() const
+{
+    return constraint_tolerance;
+}
+
+/** Kick the momenta using the forces of time level 'level' for time 'dt' */
+static void kick(RESPAWorkspace &ws, int level, double dt,
+                 bool constrained, double tolerance)
+{
+    const int nmols = ws.nMolecules();
+
+    for (int i=0; i<nmols; ++i)
+    {
+        const int nats = ws.nAtoms(i);
+    
+        const Vector *f = ws.levelForceArray(level, i);
+        Vector *p = ws.momentaArray(i);
+        const double *m = ws.massArray(i);
+
+        for (int j=0; j<nats; ++j)
+        {
+            if (m[j] != 0)
+                p[j] += (dt * f[j]);
+        }
+    }
+
+    //RATTLE the velocities so that they are tangent to the constraints
+    if (constrained)
+        ws.constrainMomenta(tolerance);
+}
+
+/** Run a single step of time level 'level', with timestep 'dt'. This
+    recursively runs the steps of the faster levels, and leaves the 
+    forces of this level evaluated at the new coordinates */
+static void step(RESPAWorkspace &ws, const QVector<Symbol> &components,
+                 const QVector<qint32> &nsteps, int level, double dt,
+                 bool constrained, double tolerance)
+{
+    // v = v + (1/2) a_level dt
+    kick(ws, level, 0.5*dt, constrained, tolerance);
+
+    if (level == 0)
+    {
+        QVector< QVector<Vector> > old_coords;
+        
+        if (constrained)
+            old_coords = ws.coordinates();
+    
+        const int nmols = ws.nMolecules();
+    
+        for (int i=0; i<nmols; ++i)
+        {
+            const int nats = ws.nAtoms(i);
+        
+            Vector *x = ws.coordsArray(i);
+            const Vector *p = ws.momentaArray(i);
+            const double *m = ws.massArray(i);
+
+            for (int j=0; j<nats; ++j)
+            {
+                // r(t + dt) = r(t) + v(t + dt/2) dt
+                if (m[j] != 0)
+                    x[j] += (dt / m[j]) * p[j];
+            }
+        }
+
+        //SETTLE / SHAKE the new coordinates back onto the constraints
+        if (constrained)
+            ws.constrainCoordinates(old_coords, dt, tolerance);
+        
+        ws.commitCoordinates();
+    }
+    else
+    {
+        const int n = nsteps.at(level);
+        const double inner_dt = dt / n;
+    
+        for (int i=0; i<n; ++i)
+        {
+            step(ws, components, nsteps, level-1, inner_dt, constrained, tolerance);
+        }
+    }
+
+    ws.calculateLevelForces(level, components.at(level));
+
+    // v = v + (1/2) a_level dt
+    kick(ws, level, 0.5*dt, constrained, tolerance);
+}
+                                                       
+/** Integrate the coordinates of the atoms in the molecules in the 
+    workspace using RESPA multiple-time-step dynamics. The timestep
+    is the timestep of the outermost (slowest) time level
+    
+    \throw SireMol::missing_molecule
+    \throw SireBase::missing_property
+    \throw SireError:invalid_cast
+    \throw SireError::incompatible_error
+*/
+void RESPA::integrate(IntegratorWorkspace &workspace,
+                      const Symbol &nrg_component,
+                      SireUnits::Dimension::Time timestep,
+                      int nmoves, bool record_stats) const
+{
+    RESPAWorkspace &ws = workspace.asA<RESPAWorkspace>();
+    
+    if (ws.constraintType() != constraint_type)
+        ws.setConstraintType(constraint_type);
+    
+    const bool constrained = ws.hasConstraints();
+    
+    const double dt = timestep.value();
+
+    QVector<Symbol> components = level_components;
+    QVector<qint32> nsteps = level_nsteps;
+    
+    if (components.isEmpty())
+    {
+        components.append(nrg_component);
+        nsteps.append(1);
+    }
+
+    const int outer = components.count() - 1;
+
+    //the forces of every level at the starting coordinates
+    for (int i=0; i<=outer; ++i)
+    {
+        ws.calculateLevelForces(i, components.at(i));
+    }
+    
+    for (int imove=0; imove<nmoves; ++imove)
+    {
+        step(ws, components, nsteps, outer, dt, constrained, constraint_tolerance);
+        
+        if (frequent_save_velocities)
+            ws.commitVelocities();
+        
+        if (record_stats)
+            ws.collectStatistics();
+    }
+    
+    if (not frequent_save_velocities)
+        ws.commitVelocities();
+}
+
+/** Create an empty workspace */
+IntegratorWorkspacePtr RESPA::createWorkspace(const PropertyMap &map) const
+{
+    RESPAWorkspace *ws = new RESPAWorkspace(map);
+    IntegratorWorkspacePtr wsptr(ws);
+    
+    ws->setConstraintType(constraint_type);
+    
+    return wsptr;
+}
+
+/** Create a workspace for this integrator for the molecule group 'molgroup' */
+IntegratorWorkspacePtr RESPA::createWorkspace(const MoleculeGroup &molgroup,
+                                              const PropertyMap &map) const
+{
+    RESPAWorkspace *ws = new RESPAWorkspace(molgroup,map);
+    IntegratorWorkspacePtr wsptr(ws);
+    
+    ws->setConstraintType(constraint_type);
+    
+    return wsptr;
+}
+
+/** Return the ensemble of this integrator */
+Ensemble RESPA::ensemble() const
+{
+    return Ensemble::NVE();
+}
+
+/** Return whether or not this integrator is time-reversible */
+bool RESPA::isTimeReversible() const
+{
+    return true;
+}
+
+const char* RESPA::typeName()
+{
+    return QMetaType::typeName( qMetaTypeId<RESPA>() );
+}
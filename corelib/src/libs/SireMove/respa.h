@@ -0,0 +1,154 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#ifndef SIREMOVE_RESPA_H
+#define SIREMOVE_RESPA_H
+
+#include "integrator.h"
+
+#include "SireCAS/symbol.h"
+
+SIRE_BEGIN_HEADER
+
+namespace SireMove
+{
+class RESPA;
+}
+
+QDataStream& operator<<(QDataStream&, const SireMove::RESPA&);
+QDataStream& operator>>(QDataStream&, SireMove::RESPA&);
+
+namespace SireMove
+{
+
+/** This class implements the reversible multiple-time-step (RESPA)
+    atomistic dynamics integrator of Tuckerman, Berne and Martyna
+    (J. Chem. Phys., 1992, 97, 1990). This is the molecular dynamics
+    equivalent of MTSMC.
+    
+    The energy is split into a set of components (e.g. the energy
+    components of different forcefields), each of which is assigned 
+    to a time level. Level 0 is the fastest (innermost) level, and
+    should hold the cheap, rapidly-varying terms (e.g. the bonded and
+    short-range CLJ terms). Higher levels hold slower and more expensive
+    terms (e.g. long-range, grid or QM terms). Each step of level 'i'
+    runs 'nSubSteps(i)' steps of level 'i-1', so the forces of the 
+    expensive components are evaluated less often. The timestep passed
+    to the integrator is the timestep of the outermost level.
+    
+    The components of the levels must together make up the energy
+    component that is being sampled. If no levels are added, then
+    this integrates the sampled energy component using a single
+    level, which is identical to velocity verlet
+ 
+    @author Christopher Woods
+*/
+class SIREMOVE_EXPORT RESPA
+          : public SireBase::ConcreteProperty<RESPA,Integrator>
+{
+
+friend QDataStream& ::operator<<(QDataStream&, const RESPA&);
+friend QDataStream& ::operator>>(QDataStream&, RESPA&);
+
+public:
+    RESPA(bool frequent_save_velocities = false);
+    
+    RESPA(const Symbol &fast_component, const Symbol &slow_component,
+          int nsubsteps = 2, bool frequent_save_velocities = false);
+    
+    RESPA(const RESPA &other);
+    
+    ~RESPA();
+    
+    RESPA& operator=(const RESPA &other);
+    
+    bool operator==(const RESPA &other) const;
+    bool operator!=(const RESPA &other) const;
+    
+    static const char* typeName();
+    
+    QString toString() const;
+    
+    Ensemble ensemble() const;
+    
+    bool isTimeReversible() const;
+    
+    void integrate(IntegratorWorkspace &workspace,
+                   const Symbol &nrg_component, 
+                   SireUnits::Dimension::Time timestep,
+                   int nmoves, bool record_stats) const;
+
+    IntegratorWorkspacePtr createWorkspace(const PropertyMap &map = PropertyMap()) const;
+    IntegratorWorkspacePtr createWorkspace(const MoleculeGroup &molgroup,
+                                           const PropertyMap &map = PropertyMap()) const;
+
+    void addLevel(const Symbol &component, int nsubsteps = 2);
+    void clearLevels();
+
+    int nLevels() const;
+    
+    Symbol levelComponent(int level) const;
+    int nSubSteps(int level) const;
+
+    void setConstraintType(const QString &constraint_type);
+    QString constraintType() const;
+    
+    void setConstraintTolerance(double tolerance);
+    double constraintTolerance() const;
+
+private:
+    /** The energy component integrated at each time level,
+        from the fastest (innermost) to the slowest (outermost) */
+    QVector<Symbol> level_components;
+    
+    /** The number of steps of the level below that are run
+        for each step of each level (this is always 1 for level 0) */
+    QVector<qint32> level_nsteps;
+
+    /** Whether or not to save the velocities after every step, 
+        or to save them at the end of all of the steps */
+    bool frequent_save_velocities;
+    
+    /** The type of constraints applied during the dynamics
+        (see AtomicVelocityWorkspace::setConstraintType) */
+    QString constraint_type;
+    
+    /** The relative tolerance to which SHAKE / RATTLE
+        constraints are satisfied */
+    double constraint_tolerance;
+};
+
+}
+
+Q_DECLARE_METATYPE( SireMove::RESPA )
+
+SIRE_EXPOSE_CLASS( SireMove::RESPA )
+
+SIRE_END_HEADER
+
+#endif
@@ -51,12 +51,13 @@
 
 #include "SireError/errors.h"
 
+#include "SireBase/profiler.h"
+
 #include "SireStream/datastream.h"
 #include "SireStream/shareddatastream.h"
 
 #include <QDebug>
 #include <QTime>
-#include <QElapsedTimer>
 
 using namespace SireMove;
 using namespace SireSystem;
@@ -1843,93 +1844,64 @@ void RigidBodyMC::move(System &system, int nmoves, bool record_stats)
     if (nmoves <= 0)
         return;
 
-    QElapsedTimer t, t2;
-    
-    qint64 old_ns = 0;
-    qint64 copy_ns = 0;
-    qint64 nrg_ns = 0;
-    qint64 move_ns = 0;
-    qint64 test_ns = 0;
-    qint64 reject_ns = 0;
-    qint64 accept_ns = 0;
-
     const PropertyMap &map = Move::propertyMap();
     
-    if (nmoves > 1)
-        t2.start();
-    
     for (int i=0; i<nmoves; ++i)
     {
         //get the old total energy of the system
-        if (nmoves > 1)
-            t.start();
+        double old_nrg;
 
-        double old_nrg = system.energy( this->energyComponent() );
-
-        if (nmoves > 1)
-            old_ns += t.nsecsElapsed();
-
-        //save the old system
-        if (nmoves > 1)
-            t.start();
-        
-        System old_system = system;
+        {
+            SIRE_PROFILE("old energy");
+            old_nrg = system.energy( this->energyComponent() );
+        }
 
-        if (nmoves > 1)
-            copy_ns += t.nsecsElapsed();
+        //start recording the changes to the system, so that they
+        //can be undone if the move is rejected
+        {
+            SIRE_PROFILE("begin transaction");
+            system.beginTransaction();
+        }
 
         double old_bias = 1;
         double new_bias = 1;
 
-        if (nmoves > 1)
-            t.start();
-
-        this->performMove(system, old_bias, new_bias, map);
-
-        if (nmoves > 1)
-            move_ns += t.nsecsElapsed();
+        {
+            SIRE_PROFILE("perform move");
+            this->performMove(system, old_bias, new_bias, map);
+        }
 
         //calculate the energy of the system
-        if (nmoves > 1)
-            t.start();
-
-        double new_nrg = system.energy( this->energyComponent() );
+        double new_nrg;
 
-        if (nmoves > 1)
-            nrg_ns += t.nsecsElapsed();
+        {
+            SIRE_PROFILE("new energy");
+            new_nrg = system.energy( this->energyComponent() );
+        }
 
         //accept or reject the move based on the change of energy
         //and the biasing factors
-        if (nmoves > 1)
-            t.start();
+        bool accept_move;
 
-        const bool accept_move = this->test(new_nrg, old_nrg, new_bias, old_bias);
-        
-        if (nmoves > 1)
-            test_ns += t.nsecsElapsed();
+        {
+            SIRE_PROFILE("test");
+            accept_move = this->test(new_nrg, old_nrg, new_bias, old_bias);
+        }
 
         if (accept_move)
         {
-            //the move has been rejected. Destroy the old state and accept the move
-            if (nmoves > 1)
-                t.start();
-            
-            old_system = System();
+            //the move has been accepted. Discard the undo log and accept the move
+            SIRE_PROFILE("accept");
+            SIRE_COUNT("SireMove::RigidBodyMC::accepted", 1);
+            system.commitTransaction();
             system.accept();
-            
-            if (nmoves > 1)
-                accept_ns += t.nsecsElapsed();
         }
         else
         {
             //the move has been rejected - reset the state
-            if (nmoves > 1)
-                t.start();
-            
-            system = old_system;
-            
-            if (nmoves > 1)
-                reject_ns += t.nsecsElapsed();
+            SIRE_PROFILE("reject");
+            SIRE_COUNT("SireMove::RigidBodyMC::rejected", 1);
+            system.rollbackTransaction();
         }
 
         if (record_stats)
@@ -1937,17 +1909,6 @@ void RigidBodyMC::move(System &system, int nmoves, bool record_stats)
             system.collectStats();
         }
     }
-    
-    qint64 ns = t2.nsecsElapsed();
-    
-    /*if (nmoves > 1)
-    {
-        qDebug() << "Timing for" << nmoves << "(" << (0.000001*ns) << ")";
-        qDebug() << "OLD:" << (0.000001*old_ns) << "COPY:" << (0.000001*copy_ns)
-                 << "MOVE:" << (0.000001*move_ns) << "ENERGY:" << (0.000001*nrg_ns)
-                 << "TEST:" << (0.000001*test_ns) << "ACCEPT:" << (0.000001*accept_ns)
-                 << "REJECT:" << (0.000001*reject_ns);
-    }*/
 }
 
 const char* RigidBodyMC::typeName()
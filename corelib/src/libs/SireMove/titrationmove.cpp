@@ -136,9 +136,13 @@ void TitrationMove::move(System &system, int nmoves, bool record_stats)
     if (nmoves <= 0)
         return;
  
-    //save our, and the system's, current state
+    //save our current state
     TitrationMove old_state(*this);
-    System old_system_state(system);
+
+    //record all of the changes made by these moves, so that they
+    //can be undone if an exception is thrown
+    const int depth = system.transactionDepth();
+    system.beginTransaction();
     
     try
     {
@@ -158,8 +162,8 @@ void TitrationMove::move(System &system, int nmoves, bool record_stats)
             //get the old total energy of the system
             double old_nrg = system.energy( this->energyComponent() );
 
-            //save the old system
-            System old_system(system);
+            //start recording the changes to the system
+            system.beginTransaction();
 
             double old_bias = 1;
             double new_bias = 1;
@@ -190,20 +194,27 @@ void TitrationMove::move(System &system, int nmoves, bool record_stats)
             if (not this->test(new_nrg + delta_zero, old_nrg, new_bias, old_bias))
             {
                 //the move has been rejected - reset the state
-                system = old_system;
+                system.rollbackTransaction();
                 titrator = system.property( map["titrator"] ).asA<Titrator>();
             }
+            else
+                system.commitTransaction();
 
             if (record_stats)
             {
                 system.collectStats();
             }
         }
+
+        system.commitTransaction();
     }
     catch(...)
     {
         this->operator=(old_state);
-        system = old_system_state;
+        while (system.transactionDepth() > depth)
+        {
+            system.rollbackTransaction();
+        }
         throw;
     }
 }
@@ -47,6 +47,8 @@
 
 #include "SireUnits/units.h"
 
+#include "SireError/errors.h"
+
 using namespace SireMove;
 using namespace SireSystem;
 using namespace SireMol;
@@ -63,11 +65,13 @@ static const RegisterMetaType<VelocityVerlet> r_velver;
 /** Serialise to a binary datastream */
 QDataStream SIREMOVE_EXPORT &operator<<(QDataStream &ds, const VelocityVerlet &velver)
 {
-    writeHeader(ds, r_velver, 1);
+    writeHeader(ds, r_velver, 2);
     
     SharedDataStream sds(ds);
     
-    sds << velver.frequent_save_velocities << static_cast<const Integrator&>(velver);
+    sds << velver.frequent_save_velocities
+        << velver.constraint_type << velver.constraint_tolerance
+        << static_cast<const Integrator&>(velver);
         
     return ds;
 }
@@ -77,14 +81,25 @@ QDataStream SIREMOVE_EXPORT &operator>>(QDataStream &ds, VelocityVerlet &velver)
 {
     VersionID v = readHeader(ds, r_velver);
     
-    if (v == 1)
+    if (v == 2)
+    {
+        SharedDataStream sds(ds);
+        
+        sds >> velver.frequent_save_velocities
+            >> velver.constraint_type >> velver.constraint_tolerance
+            >> static_cast<Integrator&>(velver);
+    }
+    else if (v == 1)
     {
         SharedDataStream sds(ds);
         
         sds >> velver.frequent_save_velocities >> static_cast<Integrator&>(velver);
+        
+        velver.constraint_type = "none";
+        velver.constraint_tolerance = 1e-8;
     }
     else
-        throw version_error(v, "1", r_velver, CODELOC);
+        throw version_error(v, "1,2", r_velver, CODELOC);
         
     return ds;
 }
@@ -92,13 +107,16 @@ QDataStream SIREMOVE_EXPORT &operator>>(QDataStream &ds, VelocityVerlet &velver)
 /** Constructor */
 VelocityVerlet::VelocityVerlet(bool frequent_save) 
                : ConcreteProperty<VelocityVerlet,Integrator>(),
-                 frequent_save_velocities(frequent_save)
+                 frequent_save_velocities(frequent_save),
+                 constraint_type("none"), constraint_tolerance(1e-8)
 {}
 
 /** Copy constructor */
 VelocityVerlet::VelocityVerlet(const VelocityVerlet &other)
                : ConcreteProperty<VelocityVerlet,Integrator>(other),
-                 frequent_save_velocities(other.frequent_save_velocities)
+                 frequent_save_velocities(other.frequent_save_velocities),
+                 constraint_type(other.constraint_type),
+                 constraint_tolerance(other.constraint_tolerance)
 {}
 
 /** Destructor */
@@ -110,6 +128,8 @@ VelocityVerlet& VelocityVerlet::operator=(const VelocityVerlet &other)
 {
     Integrator::operator=(other);
     frequent_save_velocities = other.frequent_save_velocities;
+    constraint_type = other.constraint_type;
+    constraint_tolerance = other.constraint_tolerance;
     
     return *this;
 }
@@ -118,6 +138,8 @@ VelocityVerlet& VelocityVerlet::operator=(const VelocityVerlet &other)
 bool VelocityVerlet::operator==(const VelocityVerlet &other) const
 {
     return frequent_save_velocities == other.frequent_save_velocities and
+           constraint_type == other.constraint_type and
+           constraint_tolerance == other.constraint_tolerance and
            Integrator::operator==(other);
 }
 
@@ -130,7 +152,64 @@ bool VelocityVerlet::operator!=(const VelocityVerlet &other) const
 /** Return a string representation of this integrator */
 QString VelocityVerlet::toString() const
 {
-    return QObject::tr("VelocityVerlet()");
+    if (constraint_type == "none")
+        return QObject::tr("VelocityVerlet()");
+    else
+        return QObject::tr("VelocityVerlet( constraints = %1 )").arg(constraint_type);
+}
+
+/** Set the type of constraints to apply during the dynamics. This can be;
+
+    "none" : no constraints
+    "water" : three-site waters are held rigid using SETTLE
+    "hbonds" : as "water", plus bonds to hydrogen are constrained using SHAKE / RATTLE
+    "allbonds" : as "water", plus all bonds are constrained using SHAKE / RATTLE
+    
+    Constraining the waters and bonds to hydrogen allows a timestep of
+    2 fs to be used. The constrained lengths are taken from the coordinates
+    of the molecules when the workspace is created
+    
+    \throw SireError::invalid_arg
+*/
+void VelocityVerlet::setConstraintType(const QString &type)
+{
+    const QString t = type.toLower();
+    
+    if (t != "none" and t != "water" and t != "hbonds" and t != "allbonds")
+        throw SireError::invalid_arg( QObject::tr(
+                "Cannot set the constraint type to \"%1\". Available types are "
+                "\"none\", \"water\", \"hbonds\" and \"allbonds\".")
+                    .arg(type), CODELOC );
+    
+    constraint_type = t;
+}
+
+/** Return the type of constraints applied during the dynamics */
+QString VelocityVerlet::constraintType() const
+{
+    return constraint_type;
+}
+
+/** Set the relative tolerance to which the SHAKE / RATTLE constraints 
+    are satisfied (SETTLE is analytical, so is exact)
+    
+    \throw SireError::invalid_arg
+*/
+void VelocityVerlet::setConstraintTolerance(double tolerance)
+{
+    if (tolerance <= 0)
+        throw SireError::invalid_arg( QObject::tr(
+                "The constraint tolerance (%1) must be greater than zero.")
+                    .arg(tolerance), CODELOC );
+
+    constraint_tolerance = tolerance;
+}
+
+/** Return the relative tolerance to which the SHAKE / RATTLE constraints
+    are satisfied */
+double VelocityVerlet::constraintTolerance() const
+{
+    return constraint_tolerance;
 }
                                                        
 /** Integrate the coordinates of the atoms in the molecules in 'molgroup'
@@ -149,6 +228,11 @@ void VelocityVerlet::integrate(IntegratorWorkspace &workspace,
 {
     AtomicVelocityWorkspace &ws = workspace.asA<AtomicVelocityWorkspace>();
     
+    if (ws.constraintType() != constraint_type)
+        ws.setConstraintType(constraint_type);
+    
+    const bool constrained = ws.hasConstraints();
+    
     const double dt = timestep.value();
 
     const int nmols = ws.nMolecules();
@@ -157,6 +241,11 @@ void VelocityVerlet::integrate(IntegratorWorkspace &workspace,
     {
         ws.calculateForces(nrg_component);
         
+        QVector< QVector<Vector> > old_coords;
+        
+        if (constrained)
+            old_coords = ws.coordinates();
+        
         //first integrate the coordinates - loop over all molecules
         for (int i=0; i<nmols; ++i)
         {
@@ -179,6 +268,10 @@ void VelocityVerlet::integrate(IntegratorWorkspace &workspace,
                 }
             }
         }
+        
+        //SETTLE / SHAKE the new coordinates back onto the constraints
+        if (constrained)
+            ws.constrainCoordinates(old_coords, dt, constraint_tolerance);
 
         ws.commitCoordinates();
         ws.calculateForces(nrg_component);
@@ -199,6 +292,10 @@ void VelocityVerlet::integrate(IntegratorWorkspace &workspace,
             }
         }
         
+        //RATTLE the velocities so that they are tangent to the constraints
+        if (constrained)
+            ws.constrainMomenta(constraint_tolerance);
+        
         if (frequent_save_velocities)
             ws.commitVelocities();
         
@@ -214,7 +311,12 @@ void VelocityVerlet::integrate(IntegratorWorkspace &workspace,
 IntegratorWorkspacePtr VelocityVerlet::createWorkspace(
                                                 const PropertyMap &map) const
 {
-    return IntegratorWorkspacePtr( new AtomicVelocityWorkspace(map) );
+    AtomicVelocityWorkspace *ws = new AtomicVelocityWorkspace(map);
+    IntegratorWorkspacePtr wsptr(ws);
+    
+    ws->setConstraintType(constraint_type);
+    
+    return wsptr;
 }
 
 /** Return the ensemble of this integrator */
@@ -234,7 +336,12 @@ IntegratorWorkspacePtr VelocityVerlet::createWorkspace(
                                                 const MoleculeGroup &molgroup,
                                                 const PropertyMap &map) const
 {
-    return IntegratorWorkspacePtr( new AtomicVelocityWorkspace(molgroup,map) );
+    AtomicVelocityWorkspace *ws = new AtomicVelocityWorkspace(molgroup,map);
+    IntegratorWorkspacePtr wsptr(ws);
+    
+    ws->setConstraintType(constraint_type);
+    
+    return wsptr;
 }
 
 const char* VelocityVerlet::typeName()
@@ -84,10 +84,24 @@ public:
     IntegratorWorkspacePtr createWorkspace(const MoleculeGroup &molgroup,
                                            const PropertyMap &map = PropertyMap()) const;
 
+    void setConstraintType(const QString &constraint_type);
+    QString constraintType() const;
+    
+    void setConstraintTolerance(double tolerance);
+    double constraintTolerance() const;
+
 private:
     /** Whether or not to save the velocities after every step, 
         or to save them at the end of all of the steps */
     bool frequent_save_velocities;
+    
+    /** The type of constraints applied during the dynamics
+        (see AtomicVelocityWorkspace::setConstraintType) */
+    QString constraint_type;
+    
+    /** The relative tolerance to which SHAKE / RATTLE
+        constraints are satisfied */
+    double constraint_tolerance;
 };
 
 }
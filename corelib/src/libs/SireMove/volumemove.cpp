@@ -254,7 +254,10 @@ void VolumeMove::move(System &system, int nmoves, bool record_stats)
     if (nmoves <= 0)
         return;
 
-    SaveState old_system_state = SaveState::save(system);
+    //record all of the changes made by these moves, so that they
+    //can be undone if an exception is thrown
+    const int depth = system.transactionDepth();
+    system.beginTransaction();
 
     VolumeMove old_state(*this);
     
@@ -264,7 +267,7 @@ void VolumeMove::move(System &system, int nmoves, bool record_stats)
 
         for (int i=0; i<nmoves; ++i)
         {
-            System old_system(system);
+            system.beginTransaction();
         
             //calculate the old energy and volume
             double old_nrg = this->energy(system);
@@ -286,18 +289,25 @@ void VolumeMove::move(System &system, int nmoves, bool record_stats)
                                new_bias, old_bias))
             {
                 //move failed - go back to the last step
-                system = old_system;
+                system.rollbackTransaction();
             }
+            else
+                system.commitTransaction();
             
             if (record_stats)
             {
                 system.collectStats();
             }
         }
+
+        system.commitTransaction();
     }
     catch(...)
     {
-        old_system_state.restore(system);
+        while (system.transactionDepth() > depth)
+        {
+            system.rollbackTransaction();
+        }
         this->operator=(old_state);
         throw;
     }
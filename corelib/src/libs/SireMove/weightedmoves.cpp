@@ -34,6 +34,8 @@
 
 #include "SireSystem/system.h"
 
+#include "SireBase/profiler.h"
+
 #include "SireStream/datastream.h"
 #include "SireStream/shareddatastream.h"
 
@@ -278,7 +280,10 @@ System WeightedMoves::move(const System &system, int nmoves, bool record_stats)
 
         if (n == 1)
         {
-            mvs_array[0].get<0>().edit().move(run_system, nmoves, record_stats);
+            {
+                SIRE_PROFILE( mvs_array[0].get<0>().read().what() );
+                mvs_array[0].get<0>().edit().move(run_system, nmoves, record_stats);
+            }
             
             Moves::postCheck(run_system);
             
@@ -302,6 +307,7 @@ System WeightedMoves::move(const System &system, int nmoves, bool record_stats)
                 if ( generator().rand(maxweight) <= move.get<1>() )
                 {
                     //use this move
+                    SIRE_PROFILE( move.get<0>().read().what() );
                     move.get<0>().edit().move(run_system, 1, record_stats);
                     break;
                 }
@@ -416,10 +416,13 @@ void ZMatMove::move(System &system, int nmoves, bool record_stats)
     if (nmoves <= 0)
         return;
       
-    //save our, and the system's, current state
+    //save our current state
     ZMatMove old_state(*this);
     
-    System old_system_state(system);
+    //record all of the changes made by these moves, so that they
+    //can be undone if an exception is thrown
+    const int depth = system.transactionDepth();
+    system.beginTransaction();
     
     try
     {
@@ -430,8 +433,8 @@ void ZMatMove::move(System &system, int nmoves, bool record_stats)
             //get the old energy of the system
             double old_nrg = system.energy( this->energyComponent() );
                 
-            //save the old system and sampler
-            System old_system(system);
+            //start recording the changes to the system, and save the sampler
+            system.beginTransaction();
             SamplerPtr old_sampler(smplr);
 
             QHash< AtomIdx,tuple<Length,Angle,Angle> > saved_deltas;
@@ -589,18 +592,25 @@ void ZMatMove::move(System &system, int nmoves, bool record_stats)
             {
                 //the move has been rejected - reset the state
                 smplr = old_sampler;
-                system = old_system;
+                system.rollbackTransaction();
             }
+            else
+                system.commitTransaction();
 
             if (record_stats)
             {
                 system.collectStats();
             }
         }
+
+        system.commitTransaction();
     }
     catch(...)
     {
-        system = old_system_state;
+        while (system.transactionDepth() > depth)
+        {
+            system.rollbackTransaction();
+        }
         this->operator=(old_state);
         throw;
     }
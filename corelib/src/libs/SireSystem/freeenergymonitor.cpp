@@ -34,6 +34,7 @@
 #include "SireMol/atomcharges.h"
 #include "SireMM/atomljs.h"
 #include "SireMM/ljpair.h"
+#include "SireMM/detail/lambdacljenergies.h"
 #include "SireMol/mgname.h"
 
 #include "SireUnits/units.h"
@@ -508,294 +509,66 @@ void FreeEnergyMonitor::clearStatistics()
     lj_nrgs = QVector<FreeEnergyAverage>();
 }
 
-inline pair<double,double> getCLJEnergy(
+/** Return the (coulomb,LJ) energy between the passed atoms and the perturbed
+    groups (group_a and group_b) at each of the lambda values in 'lamvals',
+
+    total_nrg(lam) = (1-lam) * group:group_A + lam * group:group_B
+
+    All of the lambda values are calculated in a single pass over the
+    pairs of atoms. If a soft-core potential is used, then the soft-core
+    alpha for group_A is lam, and for group_B is 1-lam. Otherwise the
+    energy against each group does not depend on lambda, so is only
+    calculated once */
+static QVector< pair<double,double> > getLambdaCLJEnergies(
                 const QVector<Vector> &coords, const QVector<Charge> &chgs,
                 const QVector<LJParameter> &ljs,
-                const QVector<Vector> &coords_a, const QVector<Charge> &chgs_a,
-                const QVector<LJParameter> &ljs_a,
-                const QVector<Vector> &coords_b, const QVector<Charge> &chgs_b,
-                const QVector<LJParameter> &ljs_b,
-                double lamval, double delta_lambda)
+                const SireMM::detail::LambdaCLJEnergies &group_a,
+                const SireMM::detail::LambdaCLJEnergies &group_b,
+                const QVector<double> &lamvals, bool use_soft_core,
+                double shift_delta, int coulomb_power)
 {
-    const int nats = coords.count();
-    const int nats_a = coords_a.count();
-    const int nats_b = coords_b.count();
-    
-    double cnrg = 0;
-    double ljnrg = 0;
-    double cnrg_f = 0;
-    double ljnrg_f = 0;
-    
-    if (lamval < 0)
-        lamval = 0;
-    
-    if (lamval+delta_lambda > 1)
-        lamval = 1 - delta_lambda;
-    
-    bool arithmetic_combining_rules = true;
-    
-    // total_nrg(lam) = (1-lam) * group:group_A + lam * group:group_B
-    // delta_nrg = total_nrg(lam+delta_lambda) - total_nrg(lam)
-    
-    for (int i=0; i<nats; ++i)
+    const int nlams = lamvals.count();
+
+    QVector<double> alphas_a, alphas_b;
+
+    if (use_soft_core)
     {
-        const Vector &coord0 = coords.at(i);
-        const Charge &chg0 = chgs.at(i);
-        const LJParameter &lj0 = ljs.at(i);
-        
-        double icnrg = 0;
-        double iljnrg = 0;
-        
-        for (int j=0; j<nats_a; ++j)
-        {
-            const Vector &coord1 = coords_a.at(j);
-            const Charge &chg1 = chgs_a.at(j);
-            const LJParameter &lj1 = ljs_a.at(j);
-            
-            LJPair ljpair;
+        alphas_a.reserve(nlams);
+        alphas_b.reserve(nlams);
 
-            if (arithmetic_combining_rules)
-                ljpair = LJPair::arithmetic(lj0, lj1);
-            else
-                ljpair = LJPair::geometric(lj0, lj1);
-            
-            double one_over_r2 = Vector::invDistance2(coord0, coord1);
-            double one_over_r = std::sqrt(one_over_r2);
-            double one_over_r6 = one_over_r2 * one_over_r2 * one_over_r2;
-            double one_over_r12 = one_over_r6 * one_over_r6;
-            
-            iljnrg += ljpair.A() * one_over_r12 - ljpair.B() * one_over_r6;
-            
-            icnrg += chg0.value() * chg1.value() * one_over_r
-                                  * one_over_four_pi_eps0;
-        }
-        
-        cnrg += (1-lamval) * icnrg;
-        cnrg_f += (1-lamval-delta_lambda) * icnrg;
-        ljnrg += (1-lamval) * iljnrg;
-        ljnrg_f += (1-lamval-delta_lambda) * iljnrg;
-        
-        icnrg = 0;
-        iljnrg = 0;
-        
-        for (int j=0; j<nats_b; ++j)
+        for (int i=0; i<nlams; ++i)
         {
-            const Vector &coord1 = coords_b.at(j);
-            const Charge &chg1 = chgs_b.at(j);
-            const LJParameter &lj1 = ljs_b.at(j);
-            
-            LJPair ljpair;
-
-            if (arithmetic_combining_rules)
-                ljpair = LJPair::arithmetic(lj0, lj1);
-            else
-                ljpair = LJPair::geometric(lj0, lj1);
-            
-            double one_over_r2 = Vector::invDistance2(coord0, coord1);
-            double one_over_r = std::sqrt(one_over_r2);
-            double one_over_r6 = one_over_r2 * one_over_r2 * one_over_r2;
-            double one_over_r12 = one_over_r6 * one_over_r6;
-            
-            iljnrg += ljpair.A() * one_over_r12 - ljpair.B() * one_over_r6;
-            
-            icnrg += chg0.value() * chg1.value() * one_over_r
-                                  * one_over_four_pi_eps0;
+            alphas_a.append( lamvals.at(i) );
+            alphas_b.append( 1 - lamvals.at(i) );
         }
-
-        cnrg += (lamval) * icnrg;
-        cnrg_f += (lamval+delta_lambda) * icnrg;
-        ljnrg += (lamval) * iljnrg;
-        ljnrg_f += (lamval+delta_lambda) * iljnrg;
     }
-    
-    return pair<double,double>(cnrg_f-cnrg,ljnrg_f-ljnrg);
-}
-
-inline pair<double,double> getSoftCLJEnergy(
-                const QVector<Vector> &coords, const QVector<Charge> &chgs,
-                const QVector<LJParameter> &ljs,
-                const QVector<Vector> &coords_a, const QVector<Charge> &chgs_a,
-                const QVector<LJParameter> &ljs_a,
-                const QVector<Vector> &coords_b, const QVector<Charge> &chgs_b,
-                const QVector<LJParameter> &ljs_b,
-                double lamval, double delta_lambda, double shift_delta, int coulomb_power)
-{
-    //this uses the following potentials
-    //           Zacharias and McCammon, J. Chem. Phys., 1994, and also,
-    //           Michel et al., JCTC, 2007
-    //
-    //  V_{LJ}(r) = 4 epsilon [ ( sigma^12 / (delta*sigma + r^2)^6 ) - 
-    //                          ( sigma^6  / (delta*sigma + r^2)^3 ) ]
-    //
-    //  delta = shift_delta * alpha
-    //
-    //  V_{coul}(r) = (1-alpha)^n q_i q_j / 4 pi eps_0 (alpha+r^2)^(1/2)
-    //
-    // This contrasts to Rich T's LJ softcore function, which was;
-    //
-    //  V_{LJ}(r) = 4 epsilon [ (sigma^12 / (alpha^m sigma^6 + r^6)^2) - 
-    //                          (sigma^6  / (alpha^m sigma^6 + r^6) ) ]
-
-    const int nats = coords.count();
-    const int nats_a = coords_a.count();
-    const int nats_b = coords_b.count();
-    
-    double cnrg = 0;
-    double ljnrg = 0;
-    double cnrg_f = 0;
-    double ljnrg_f = 0;
-    
-    if (lamval < 0)
-        lamval = 0;
-    
-    if (lamval+delta_lambda > 1)
-        lamval = 1 - delta_lambda;
-    
-    bool arithmetic_combining_rules = true;
-
-    const double alpha_a = lamval;
-    const double alpha_a_f = lamval + delta_lambda;
-    double one_minus_alpha_a_to_n = 1;
-    double one_minus_alpha_a_to_n_f = 1;
-    const double delta_a = shift_delta * alpha_a;
-    const double delta_a_f = shift_delta * alpha_a_f;
-
-    const double alpha_b = 1 - lamval;
-    const double alpha_b_f = 1 - lamval - delta_lambda;
-    double one_minus_alpha_b_to_n = 1;
-    double one_minus_alpha_b_to_n_f = 1;
-    const double delta_b = shift_delta * alpha_b;
-    const double delta_b_f = shift_delta * alpha_b_f;
-
-    if (coulomb_power != 0)
+    else
     {
-        one_minus_alpha_a_to_n = SireMaths::pow(1 - alpha_a, coulomb_power);
-        one_minus_alpha_a_to_n_f = SireMaths::pow(1 - alpha_a_f, coulomb_power);
-        one_minus_alpha_b_to_n = SireMaths::pow(1 - alpha_b, coulomb_power);
-        one_minus_alpha_b_to_n_f = SireMaths::pow(1 - alpha_b_f, coulomb_power);
+        alphas_a = QVector<double>(1, 0.0);
+        alphas_b = alphas_a;
+        shift_delta = 0;
+        coulomb_power = 0;
     }
-    
-    // total_nrg(lam) = (1-lam) * group:group_A + lam * group:group_B
-    // delta_nrg = total_nrg(lam+delta_lambda) - total_nrg(lam)
-    
-    for (int i=0; i<nats; ++i)
-    {
-        const Vector &coord0 = coords.at(i);
-        const Charge &chg0 = chgs.at(i);
-        const LJParameter &lj0 = ljs.at(i);
-        
-        double icnrg = 0;
-        double iljnrg = 0;
-        double icnrg_f = 0;
-        double iljnrg_f = 0;
-        
-        for (int j=0; j<nats_a; ++j)
-        {
-            const Vector &coord1 = coords_a.at(j);
-            const Charge &chg1 = chgs_a.at(j);
-            const LJParameter &lj1 = ljs_a.at(j);
-            
-            LJPair ljpair;
 
-            if (arithmetic_combining_rules)
-                ljpair = LJPair::arithmetic(lj0, lj1);
-            else
-                ljpair = LJPair::geometric(lj0, lj1);
-            
-            double r2 = Vector::distance2(coord0, coord1);
-
-            const double shift = ljpair.sigma() * delta_a;
-            const double shift_f = ljpair.sigma() * delta_a_f;
-            double lj_denom = r2 + shift;
-            lj_denom = lj_denom * lj_denom * lj_denom;
-
-            double lj_denom_f = r2 + shift_f;
-            lj_denom_f = lj_denom_f * lj_denom_f * lj_denom_f;
-
-            const double sig2 = ljpair.sigma() * ljpair.sigma();
-            const double sig6 = sig2 * sig2 * sig2;
-                        
-            const double sig6_over_denom = sig6 / lj_denom;
-            const double sig6_over_denom_f = sig6 / lj_denom_f;
-            const double sig12_over_denom2 = sig6_over_denom *
-                                             sig6_over_denom;
-            const double sig12_over_denom2_f = sig6_over_denom_f *
-                                               sig6_over_denom_f;
-            
-            iljnrg += 4 * ljpair.epsilon() * (sig12_over_denom2 - sig6_over_denom);
-            iljnrg_f += 4 * ljpair.epsilon() * (sig12_over_denom2_f - sig6_over_denom_f);
-            
-            icnrg += one_minus_alpha_a_to_n *
-                        chg0.value() * chg1.value() * one_over_four_pi_eps0 /
-                           std::sqrt(alpha_a + r2);
-            
-            icnrg_f += one_minus_alpha_a_to_n_f *
-                        chg0.value() * chg1.value() * one_over_four_pi_eps0 /
-                           std::sqrt(alpha_a_f + r2);
-        }
-        
-        cnrg += (1-lamval) * icnrg;
-        cnrg_f += (1-lamval-delta_lambda) * icnrg_f;
-        ljnrg += (1-lamval) * iljnrg;
-        ljnrg_f += (1-lamval-delta_lambda) * iljnrg_f;
-        
-        icnrg = 0;
-        iljnrg = 0;
-        icnrg_f = 0;
-        iljnrg_f = 0;
-        
-        for (int j=0; j<nats_b; ++j)
-        {
-            const Vector &coord1 = coords_b.at(j);
-            const Charge &chg1 = chgs_b.at(j);
-            const LJParameter &lj1 = ljs_b.at(j);
-            
-            LJPair ljpair;
+    QVector<double> cnrgs_a, ljnrgs_a, cnrgs_b, ljnrgs_b;
 
-            if (arithmetic_combining_rules)
-                ljpair = LJPair::arithmetic(lj0, lj1);
-            else
-                ljpair = LJPair::geometric(lj0, lj1);
-            
-            double r2 = Vector::distance2(coord0, coord1);
-
-            const double shift = ljpair.sigma() * delta_b;
-            const double shift_f = ljpair.sigma() * delta_b_f;
-            double lj_denom = r2 + shift;
-            lj_denom = lj_denom * lj_denom * lj_denom;
-
-            double lj_denom_f = r2 + shift_f;
-            lj_denom_f = lj_denom_f * lj_denom_f * lj_denom_f;
-
-            const double sig2 = ljpair.sigma() * ljpair.sigma();
-            const double sig6 = sig2 * sig2 * sig2;
-                        
-            const double sig6_over_denom = sig6 / lj_denom;
-            const double sig6_over_denom_f = sig6 / lj_denom_f;
-            const double sig12_over_denom2 = sig6_over_denom *
-                                             sig6_over_denom;
-            const double sig12_over_denom2_f = sig6_over_denom_f *
-                                               sig6_over_denom_f;
-            
-            iljnrg += 4 * ljpair.epsilon() * (sig12_over_denom2 - sig6_over_denom);
-            iljnrg_f += 4 * ljpair.epsilon() * (sig12_over_denom2_f - sig6_over_denom_f);
-            
-            icnrg += one_minus_alpha_b_to_n *
-                        chg0.value() * chg1.value() * one_over_four_pi_eps0 /
-                           std::sqrt(alpha_b + r2);
-            
-            icnrg_f += one_minus_alpha_b_to_n_f * 
-                        chg0.value() * chg1.value() * one_over_four_pi_eps0 /
-                           std::sqrt(alpha_b_f + r2);
-        }
+    group_a.calculate(coords, chgs, ljs, alphas_a, shift_delta, coulomb_power,
+                      cnrgs_a, ljnrgs_a);
+    group_b.calculate(coords, chgs, ljs, alphas_b, shift_delta, coulomb_power,
+                      cnrgs_b, ljnrgs_b);
 
-        cnrg += (lamval) * icnrg;
-        cnrg_f += (lamval+delta_lambda) * icnrg_f;
-        ljnrg += (lamval) * iljnrg;
-        ljnrg_f += (lamval+delta_lambda) * iljnrg_f;
+    QVector< pair<double,double> > nrgs(nlams);
+
+    for (int i=0; i<nlams; ++i)
+    {
+        const int k = use_soft_core ? i : 0;
+        const double lam = lamvals.at(i);
+
+        nrgs[i] = pair<double,double>( (1-lam) * cnrgs_a.at(k) + lam * cnrgs_b.at(k),
+                                       (1-lam) * ljnrgs_a.at(k) + lam * ljnrgs_b.at(k) );
     }
-    
-    return pair<double,double>(cnrg_f-cnrg,ljnrg_f-ljnrg);
+
+    return nrgs;
 }
 
 /** Return whether or not this monitor uses a soft-core potential to
@@ -1148,46 +921,39 @@ void FreeEnergyMonitor::monitor(System &system)
             }
         }
     
-        if (this->usesSoftCore())
+        //the energy difference is calculated using finite difference,
+        //so make sure that both lambda values lie between 0 and 1
+        double lam = lamval;
+
+        if (lam < 0)
+            lam = 0;
+
+        if (lam+delta_lambda > 1)
+            lam = 1 - delta_lambda;
+
+        QVector<double> lamvals(2);
+        lamvals[0] = lam;
+        lamvals[1] = lam + delta_lambda;
+
+        const SireMM::detail::LambdaCLJEnergies cljgroup_a(a_coords, a_chgs, a_ljs);
+        const SireMM::detail::LambdaCLJEnergies cljgroup_b(b_coords, b_chgs, b_ljs);
+
+        const bool use_soft_core = this->usesSoftCore();
+
+        //calculate the energy difference for each view against group_a and group_b
+        for (int i=0; i<nref; ++i)
         {
-            //calculate the energy difference for each view against group_a and group_b
-            for (int i=0; i<nref; ++i)
-            {
-                const QVector<Vector> &mol_coords = ref_coords.at(i);
-                const QVector<Charge> &mol_chgs = ref_chgs.at(i);
-                const QVector<LJParameter> &mol_ljs = ref_ljs.at(i);
-            
-                pair<double,double> delta_cljnrg = getSoftCLJEnergy(
-                            mol_coords, mol_chgs, mol_ljs,
-                            a_coords, a_chgs, a_ljs,
-                            b_coords, b_chgs, b_ljs,
-                            lamval, delta_lambda,
+            const QVector< pair<double,double> > nrgs = getLambdaCLJEnergies(
+                            ref_coords.at(i), ref_chgs.at(i), ref_ljs.at(i),
+                            cljgroup_a, cljgroup_b, lamvals, use_soft_core,
                             shift_delta, coulomb_power);
 
-                total_nrgs[i].accumulate(delta_cljnrg.first + delta_cljnrg.second);
-                coul_nrgs[i].accumulate(delta_cljnrg.first);
-                lj_nrgs[i].accumulate(delta_cljnrg.second);
-            }
-        }
-        else
-        {
-            //calculate the energy difference for each view against group_a and group_b
-            for (int i=0; i<nref; ++i)
-            {
-                const QVector<Vector> &mol_coords = ref_coords.at(i);
-                const QVector<Charge> &mol_chgs = ref_chgs.at(i);
-                const QVector<LJParameter> &mol_ljs = ref_ljs.at(i);
-            
-                pair<double,double> delta_cljnrg = getCLJEnergy(
-                            mol_coords, mol_chgs, mol_ljs,
-                            a_coords, a_chgs, a_ljs,
-                            b_coords, b_chgs, b_ljs,
-                            lamval, delta_lambda);
-
-                total_nrgs[i].accumulate(delta_cljnrg.first + delta_cljnrg.second);
-                coul_nrgs[i].accumulate(delta_cljnrg.first);
-                lj_nrgs[i].accumulate(delta_cljnrg.second);
-            }
+            const double delta_cnrg = nrgs.at(1).first - nrgs.at(0).first;
+            const double delta_ljnrg = nrgs.at(1).second - nrgs.at(0).second;
+
+            total_nrgs[i].accumulate(delta_cnrg + delta_ljnrg);
+            coul_nrgs[i].accumulate(delta_cnrg);
+            lj_nrgs[i].accumulate(delta_ljnrg);
         }
     }
     catch(...)
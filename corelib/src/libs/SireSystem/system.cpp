@@ -28,6 +28,7 @@
 
 #include <QHash>
 #include <QMutex>
+#include <QSharedData>
 
 #include "system.h"
 #include "delta.h"
@@ -51,6 +52,7 @@
 #include "SireMol/atomcoords.h"
 
 #include "SireBase/savestate.h"
+#include "SireBase/profiler.h"
 
 #include "SireMol/errors.h"
 #include "SireError/errors.h"
@@ -82,6 +84,156 @@ static VersionRegistry<QUuid>& systemRegistry()
     return *system_registry;
 }
 
+////////
+//////// Implementation of SystemTransaction
+////////
+
+namespace SireSystem
+{
+namespace detail
+{
+
+/** This is the undo log of a System that is in a transaction
+    (e.g. during a trial Monte Carlo move). Rather than holding 
+    a copy of the entire System (which forces the forcefields and
+    molecule groups to detach, and so deep-copy, as soon as anything
+    is changed), this records only the original versions of the 
+    molecules that are changed during the transaction, together with
+    the energies and version of each forcefield just before its
+    first change. Rolling back the transaction replays the original
+    molecules back into the forcefields and molecule groups, at a cost 
+    that scales with the number of changed atoms, and then restores 
+    the recorded energies and versions directly, so that nothing
+    is recalculated and the energies are restored exactly.
+    
+    Forcefields that cannot restore their energies (see
+    FF::canRestoreEnergies), or that were dirty when first changed,
+    are instead copied just before their first change, and the copy
+    is put back on rollback.
+    
+    Changes that cannot be recorded as a molecule change (e.g. changing
+    a property, or adding or removing a forcefield or molecule) cause
+    a copy of the System to be taken just before the change. Rolling
+    back then restores this copy, and replays the molecule changes 
+    that were recorded before it was taken.
+    
+    Transactions can be nested. The undo log of a nested transaction
+    is merged into that of its parent when it is committed
+    
+    @author Christopher Woods
+*/
+class SystemTransaction : public QSharedData
+{
+public:
+    SystemTransaction() 
+          : QSharedData(), snapshot(System::null()), has_snapshot(false)
+    {}
+    
+    SystemTransaction(const System &system)
+          : QSharedData(), sysname(system.name()), sysmonitors(system.monitors()),
+            snapshot(System::null()), has_snapshot(false)
+    {}
+    
+    SystemTransaction(const SystemTransaction &other)
+          : QSharedData(), old_mols(other.old_mols), 
+            ff_energies(other.ff_energies), old_ffields(other.old_ffields),
+            sysname(other.sysname), sysmonitors(other.sysmonitors), 
+            cons(other.cons), sysversion(other.sysversion),
+            snapshot(other.snapshot), has_snapshot(other.has_snapshot),
+            parent(other.parent)
+    {}
+    
+    ~SystemTransaction()
+    {}
+    
+    void merge(const SystemTransaction &child);
+    
+    /** The original versions of all of the molecules that
+        have been changed during the transaction */
+    Molecules old_mols;
+    
+    /** The energies and version of each forcefield that can restore
+        its energies, recorded just before its first change, indexed
+        by the index of the forcefield */
+    QHash< int,QPair<Values,quint64> > ff_energies;
+    
+    /** Copies of the forcefields that cannot restore their energies,
+        taken just before their first change, indexed by the index
+        of the forcefield */
+    QHash<int,FFPtr> old_ffields;
+    
+    /** The name of the system when the transaction started */
+    SysName sysname;
+    
+    /** The monitors of the system when the transaction started */
+    SystemMonitors sysmonitors;
+    
+    /** The constraints of the system when the transaction started */
+    Constraints cons;
+    
+    /** The version of the system when the transaction started */
+    MajorMinorVersion sysversion;
+    
+    /** Copy of the system taken just before the first change
+        that could not be recorded in the log */
+    System snapshot;
+    
+    /** Whether or not the snapshot has been taken */
+    bool has_snapshot;
+    
+    /** The transaction in which this transaction is nested (if any) */
+    QSharedDataPointer<SystemTransaction> parent;
+};
+
+/** Merge the undo log of the committed nested transaction 'child' into
+    this log. The log of a molecule or forcefield that this transaction 
+    has already recorded is kept, as it holds the earlier state. The child
+    only records changes made after this transaction started, so anything 
+    it has that is not recorded here was unchanged when this transaction 
+    started */
+void SystemTransaction::merge(const SystemTransaction &child)
+{
+    if (has_snapshot)
+        //this log already has everything needed to undo the changes
+        return;
+
+    for (Molecules::const_iterator it = child.old_mols.constBegin();
+         it != child.old_mols.constEnd();
+         ++it)
+    {
+        if (not old_mols.contains(it.key()))
+            old_mols.add(*it);
+    }
+    
+    for (QHash< int,QPair<Values,quint64> >::const_iterator 
+                                    it = child.ff_energies.constBegin();
+         it != child.ff_energies.constEnd();
+         ++it)
+    {
+        if (not (ff_energies.contains(it.key()) or old_ffields.contains(it.key())))
+            ff_energies.insert(it.key(), it.value());
+    }
+    
+    for (QHash<int,FFPtr>::const_iterator it = child.old_ffields.constBegin();
+         it != child.old_ffields.constEnd();
+         ++it)
+    {
+        if (not (ff_energies.contains(it.key()) or old_ffields.contains(it.key())))
+            old_ffields.insert(it.key(), it.value());
+    }
+    
+    if (child.has_snapshot)
+    {
+        snapshot = child.snapshot;
+        has_snapshot = true;
+    }
+}
+
+} // end of namespace detail
+} // end of namespace SireSystem
+
+using SireSystem::detail::SystemTransaction;
+
 ////////
 //////// Implementation of SystemData
 ////////
@@ -233,6 +385,9 @@ QDataStream SIRESYSTEM_EXPORT &operator>>(QDataStream &ds, System &system)
     }
     else
         throw version_error(v, "1,2", r_system, CODELOC);
+    
+    //a loaded system is not in a transaction
+    system.transaction = QSharedDataPointer<SystemTransaction>();
         
     return ds;
 }
@@ -282,7 +437,8 @@ System::System(const System &other)
          sysmonitors(other.sysmonitors),
          cons(other.cons),
          mgroups_by_num(other.mgroups_by_num),
-         subversion(other.subversion)
+         subversion(other.subversion),
+         transaction(other.transaction)
 {
     molgroups[0] = other.molgroups[0];
     molgroups[1] = other.molgroups[1];
@@ -306,6 +462,7 @@ System& System::operator=(const System &other)
         cons = other.cons;
         mgroups_by_num = other.mgroups_by_num;
         subversion = other.subversion;
+        transaction = other.transaction;
         
         MolGroupsBase::operator=(other);
     }
@@ -620,6 +777,7 @@ void System::setName(const QString &newname)
 /** Collect statistics about the current configuration */
 void System::collectStats()
 {
+    SIRE_PROFILE("SireSystem::System::collectStats");
     sysmonitors.monitor(*this);
     //sysversion.incrementMajor();
     //cons.committed(*this);
@@ -817,6 +975,8 @@ void System::setEnergyComponent(const Symbol &symbol,
             return;
     }
 
+    this->_pvt_logStructuralChange();
+    
     SaveState old_state = SaveState::save(*this);
     
     try
@@ -937,6 +1097,8 @@ void System::setConstantComponent(const Symbol &symbol,
             return;
     }
     
+    this->_pvt_logStructuralChange();
+    
     SaveState old_state = SaveState::save(*this);
     
     try
@@ -1180,6 +1342,7 @@ void System::potential(PotentialTable &pottable, const Symbol &component,
 */
 void System::setProperty(const QString &name, const Property &value)
 {
+    this->_pvt_logStructuralChange();
     this->_pvt_forceFields().setProperty(name, value);
     sysversion.incrementMajor();
     this->applyConstraints();
@@ -1194,6 +1357,7 @@ void System::setProperty(const QString &name, const Property &value)
 */
 void System::setProperty(const FFID &ffid, const QString &name, const Property &value)
 {
+    this->_pvt_logStructuralChange();
     this->_pvt_forceFields().setProperty(ffid, name, value);
     sysversion.incrementMajor();
     this->applyConstraints();
@@ -1205,6 +1369,7 @@ void System::setProperty(const FFID &ffid, const QString &name, const Property &
     property with this name */
 void System::removeProperty(const QString &name)
 {
+    this->_pvt_logStructuralChange();
     this->_pvt_forceFields().removeProperty(name);
     sysversion.incrementMajor();
     this->applyConstraints();
@@ -1441,6 +1606,34 @@ void System::mustNowRecalculateFromScratch()
     this->_pvt_forceFields().mustNowRecalculateFromScratch();
 }
 
+/** Set whether or not to evaluate the independent forcefields of this
+    system in parallel (see ForceFields::setUseParallelCalculation) */
+void System::setUseParallelCalculation(bool on)
+{
+    this->_pvt_forceFields().setUseParallelCalculation(on);
+}
+
+/** Turn on the parallel evaluation of the independent forcefields
+    of this system */
+void System::enableParallelCalculation()
+{
+    this->setUseParallelCalculation(true);
+}
+
+/** Turn off the parallel evaluation of the independent forcefields
+    of this system */
+void System::disableParallelCalculation()
+{
+    this->setUseParallelCalculation(false);
+}
+
+/** Return whether or not the independent forcefields of this system
+    are evaluated in parallel */
+bool System::usesParallelCalculation() const
+{
+    return this->_pvt_forceFields().usesParallelCalculation();
+}
+
 /** Return whether or not any part of the forcefield is using temporary
     workspaces that need to be accepted */
 bool System::needsAccepting() const
@@ -1453,10 +1646,207 @@ bool System::needsAccepting() const
     any cacheing or use of temporary workspaces to be committed */
 void System::accept()
 {
+    SIRE_PROFILE("SireSystem::System::accept");
     this->_pvt_forceFields().accept();
     this->_pvt_moleculeGroups().accept();
 }
 
+/** Start a transaction on this system. While the transaction is open,
+    the system records an undo log of the changes made to it, holding
+    only the original versions of the molecules that are changed, and
+    the energies of the forcefields before they were changed. 
+    This means that a trial move can be undone by calling 
+    rollbackTransaction, at a cost that scales with the number
+    of changed atoms, without having to make (and so detach from) 
+    a copy of the entire system. If a transaction is already open
+    then the new transaction is nested inside it */
+void System::beginTransaction()
+{
+    QSharedDataPointer<SystemTransaction> log( new SystemTransaction(*this) );
+    
+    log->cons = cons;
+    log->sysversion = sysversion;
+    log->parent = transaction;
+    
+    transaction = log;
+}
+
+/** Commit the currently open transaction, keeping all of the
+    changes made since it was started. If this transaction is nested
+    then its undo log is merged into that of the enclosing transaction,
+    so that the changes can still be undone by rolling that back.
+    This does nothing if there is no open transaction. Note that this 
+    does not accept the changes in the forcefields - you still need 
+    to call accept() for that */
+void System::commitTransaction()
+{
+    if (transaction.constData() == 0)
+        return;
+    
+    QSharedDataPointer<SystemTransaction> log = transaction;
+    transaction = log.constData()->parent;
+    
+    if (transaction.constData() != 0)
+        transaction->merge( *(log.constData()) );
+}
+
+/** Roll back the currently open transaction, restoring the system 
+    to the state it was in when beginTransaction was called. The
+    original versions of the changed molecules are replayed back into
+    the forcefields and molecule groups, and then the energies and
+    versions of the forcefields, and the version of the system,
+    are restored to the values they had before the changes. The
+    energies are not recalculated, so are restored exactly. If this
+    transaction is nested then the enclosing transaction becomes
+    the open transaction. This does nothing if there is no 
+    open transaction */
+void System::rollbackTransaction()
+{
+    if (transaction.constData() == 0)
+        return;
+
+    SIRE_PROFILE("SireSystem::System::rollbackTransaction");
+
+    //close the transaction so that the rollback is not itself logged
+    QSharedDataPointer<SystemTransaction> log = transaction;
+    transaction = QSharedDataPointer<SystemTransaction>();
+    
+    const SystemTransaction &undo = *(log.constData());
+    
+    if (undo.has_snapshot)
+    {
+        //a change was made that could not be logged, so restore
+        //the copy of the system taken just before that change
+        this->operator=(undo.snapshot);
+    }
+    
+    if (not undo.old_mols.isEmpty())
+    {
+        //replay the original versions of the changed molecules 
+        //directly into the forcefields and groups (the constraints were 
+        //satisfied by these versions, so do not need to be applied)
+        this->_pvt_forceFields().update(undo.old_mols);
+        this->_pvt_moleculeGroups().update(undo.old_mols);
+    }
+    
+    if (not (undo.ff_energies.isEmpty() and undo.old_ffields.isEmpty()))
+    {
+        ForceFields &ffields = this->_pvt_forceFields();
+
+        //restore the energies of the forcefields, discarding
+        //the changes recorded by the replay
+        for (QHash< int,QPair<Values,quint64> >::const_iterator 
+                                        it = undo.ff_energies.constBegin();
+             it != undo.ff_energies.constEnd();
+             ++it)
+        {
+            ffields.restoreEnergies( FFIdx(it.key()), 
+                                     it.value().first, it.value().second );
+        }
+    
+        //put back the forcefields that could not restore their energies
+        for (QHash<int,FFPtr>::const_iterator it = undo.old_ffields.constBegin();
+             it != undo.old_ffields.constEnd();
+             ++it)
+        {
+            ffields.restoreForceField( FFIdx(it.key()), it.value().read() );
+        }
+    }
+    
+    sysname = undo.sysname;
+    sysmonitors = undo.sysmonitors;
+    cons = undo.cons;
+    sysversion = undo.sysversion;
+    
+    transaction = undo.parent;
+}
+
+/** Return whether or not there is an open transaction on this system */
+bool System::inTransaction() const
+{
+    return transaction.constData() != 0;
+}
+
+/** Return the number of open transactions on this system (the 
+    depth to which the currently open transaction is nested) */
+int System::transactionDepth() const
+{
+    int depth = 0;
+    
+    const SystemTransaction *log = transaction.constData();
+    
+    while (log != 0)
+    {
+        ++depth;
+        log = log->parent.constData();
+    }
+    
+    return depth;
+}
+
+/** Internal function used to record the original version of the molecule
+    with number 'molnum' in the undo log of the open transaction,
+    just before the molecule is changed. This also records the energies
+    and version (or, if these cannot be restored, a copy) of each
+    forcefield that contains this molecule, if they have not already
+    been recorded */
+void System::_pvt_logMoleculeChange(MolNum molnum)
+{
+    const SystemTransaction *undo = transaction.constData();
+
+    if (undo == 0 or undo->has_snapshot or undo->old_mols.contains(molnum))
+        return;
+    
+    const QList<MGNum> &mgnums = this->groupsContaining(molnum);
+    
+    if (mgnums.isEmpty())
+        return;
+    
+    SystemTransaction &log = *transaction;
+    
+    log.old_mols.add( Molecule(this->at(mgnums.first()).molecule(molnum).data()) );
+    
+    const QVector<FFPtr> &ffields = this->_pvt_constForceFields().forceFields();
+    
+    for (int i=0; i<ffields.count(); ++i)
+    {
+        if (log.ff_energies.contains(i) or log.old_ffields.contains(i))
+            continue;
+
+        const FF &ffield = ffields.at(i).read();
+        
+        if (not ffield.contains(molnum))
+            continue;
+            
+        if (ffield.isClean() and ffield.canRestoreEnergies())
+        {
+            log.ff_energies.insert( i, QPair<Values,quint64>(ffield.currentEnergies(),
+                                                             ffield.version()) );
+        }
+        else
+        {
+            log.old_ffields.insert(i, ffields.at(i));
+        }
+    }
+}
+
+/** Internal function called just before a change is made to the system
+    that cannot be recorded as a change of molecules. This saves a copy
+    of the system in the undo log of the open transaction */
+void System::_pvt_logStructuralChange()
+{
+    const SystemTransaction *undo = transaction.constData();
+
+    if (undo == 0 or undo->has_snapshot)
+        return;
+    
+    System snapshot(*this);
+    snapshot.transaction = QSharedDataPointer<SystemTransaction>();
+    
+    transaction->snapshot = snapshot;
+    transaction->has_snapshot = true;
+}
+
 /** Return whether or not any of the forcefields are dirty */
 bool System::isDirty() const
 {
@@ -1536,6 +1926,8 @@ void System::add(const FF &forcefield)
     FFPtr ff( forcefield );
     ff.edit().update( this->matchToExistingVersion(forcefield.molecules()) );
 
+    this->_pvt_logStructuralChange();
+    
     SaveState old_state = SaveState::save(*this);
     
     try
@@ -1579,6 +1971,8 @@ void System::add(const MoleculeGroup &molgroup)
         MolGroupPtr mgroup(molgroup);
         mgroup.edit().update( this->matchToExistingVersion(molgroup.molecules()) );
 
+        this->_pvt_logStructuralChange();
+        
         SaveState old_state = SaveState::save(*this);
         
         try
@@ -1600,6 +1994,8 @@ void System::add(const MoleculeGroup &molgroup)
 /** Add the passed constraint to the system */
 void System::add(const Constraints &constraints)
 {
+    this->_pvt_logStructuralChange();
+    
     SaveState old_state = SaveState::save(*this);
     
     try
@@ -1633,6 +2029,8 @@ void System::setConstraints(const Constraints &constraints)
     if (cons == constraints)
         return;
 
+    this->_pvt_logStructuralChange();
+    
     SaveState old_state = SaveState::save(*this);
     
     try
@@ -1666,6 +2064,8 @@ void System::remove(const MonitorID &monid)
 */
 void System::remove(const FFID &ffid)
 {
+    this->_pvt_logStructuralChange();
+    
     SaveState old_state = SaveState::save(*this);
     
     try
@@ -1704,6 +2104,8 @@ bool System::remove(const MGID &mgid)
 {
     QList<MGNum> mgnums = mgid.map(*this);
     
+    this->_pvt_logStructuralChange();
+    
     SaveState old_state = SaveState::save(*this);
     
     try
@@ -1766,6 +2168,8 @@ bool System::remove(const MolID &molid)
 {
     QList<MolNum> molnums = molid.map(*this);
     
+    this->_pvt_logStructuralChange();
+    
     SaveState old_state = SaveState::save(*this);
     
     bool mols_removed = false;
@@ -1825,6 +2229,8 @@ bool System::removeAllMolecules()
     from this system */
 void System::removeAllMoleculeGroups()
 {
+    this->_pvt_logStructuralChange();
+    
     SaveState old_state = SaveState::save(*this);
     
     try
@@ -1870,6 +2276,8 @@ void System::removeAllForceFields()
     if (this->nForceFields() == 0)
         return;
 
+    this->_pvt_logStructuralChange();
+    
     SaveState old_state = SaveState::save(*this);
     
     try
@@ -1934,6 +2342,8 @@ void System::add(const MoleculeView &molview, const MGID &mgid,
     PartialMolecule view(molview);
     view.update( this->matchToExistingVersion(molview.data()) );
     
+    this->_pvt_logStructuralChange();
+    
     SaveState old_state = SaveState::save(*this);
     
     try
@@ -1979,6 +2389,8 @@ void System::add(const ViewsOfMol &molviews, const MGID &mgid,
     ViewsOfMol views(molviews);
     views.update( this->matchToExistingVersion(molviews.data()) );
     
+    this->_pvt_logStructuralChange();
+    
     SaveState old_state = SaveState::save(*this);
     
     try
@@ -2023,6 +2435,8 @@ void System::add(const Molecules &molecules, const MGID &mgid,
     
     Molecules mols = this->matchToExistingVersion(molecules);
     
+    this->_pvt_logStructuralChange();
+    
     SaveState old_state = SaveState::save(*this);
     
     try
@@ -2068,6 +2482,8 @@ void System::add(const MoleculeGroup &molgroup, const MGID &mgid,
     MolGroupPtr group(molgroup);
     group.edit().update( this->matchToExistingVersion(molgroup.molecules()) );
     
+    this->_pvt_logStructuralChange();
+    
     SaveState old_state = SaveState::save(*this);
     
     try
@@ -2115,6 +2531,8 @@ void System::addIfUnique(const MoleculeView &molview, const MGID &mgid,
     PartialMolecule view(molview);
     view.update( this->matchToExistingVersion(molview.data()) );
     
+    this->_pvt_logStructuralChange();
+    
     SaveState old_state = SaveState::save(*this);
     
     try
@@ -2162,6 +2580,8 @@ void System::addIfUnique(const ViewsOfMol &molviews, const MGID &mgid,
     ViewsOfMol views(molviews);
     views.update( this->matchToExistingVersion(molviews.data()) );
     
+    this->_pvt_logStructuralChange();
+    
     SaveState old_state = SaveState::save(*this);
     
     try
@@ -2208,6 +2628,8 @@ void System::addIfUnique(const Molecules &molecules, const MGID &mgid,
     
     Molecules mols = this->matchToExistingVersion(molecules);
     
+    this->_pvt_logStructuralChange();
+    
     SaveState old_state = SaveState::save(*this);
     
     try
@@ -2255,6 +2677,8 @@ void System::addIfUnique(const MoleculeGroup &molgroup, const MGID &mgid,
     MolGroupPtr group(molgroup);
     group.edit().update( this->matchToExistingVersion(molgroup.molecules()) );
     
+    this->_pvt_logStructuralChange();
+    
     SaveState old_state = SaveState::save(*this);
     
     try
@@ -2401,6 +2825,8 @@ bool System::removeAll(const MGID &mgid)
 {
     QList<MGNum> mgnums = mgid.map(*this);
     
+    this->_pvt_logStructuralChange();
+    
     SaveState old_state = SaveState::save(*this);
 
     bool mols_removed = false;
@@ -2442,6 +2868,8 @@ bool System::remove(const MoleculeView &molview, const MGID &mgid)
 {
     QList<MGNum> mgnums = mgid.map(*this);
     
+    this->_pvt_logStructuralChange();
+    
     SaveState old_state = SaveState::save(*this);
     
     bool mols_removed = false;
@@ -2486,6 +2914,8 @@ bool System::remove(const ViewsOfMol &molviews, const MGID &mgid)
 {
     QList<MGNum> mgnums = mgid.map(*this);
     
+    this->_pvt_logStructuralChange();
+    
     SaveState old_state = SaveState::save(*this);
     
     bool mols_removed = false;
@@ -2529,6 +2959,8 @@ bool System::remove(const Molecules &molecules, const MGID &mgid)
 {
     QList<MGNum> mgnums = mgid.map(*this);
     
+    this->_pvt_logStructuralChange();
+    
     SaveState old_state = SaveState::save(*this);
     
     bool mols_removed = false;
@@ -2591,6 +3023,8 @@ bool System::removeAll(const MoleculeView &molview, const MGID &mgid)
 {
     QList<MGNum> mgnums = mgid.map(*this);
     
+    this->_pvt_logStructuralChange();
+    
     SaveState old_state = SaveState::save(*this);
     
     bool mols_removed = false;
@@ -2632,6 +3066,8 @@ bool System::removeAll(const ViewsOfMol &molviews, const MGID &mgid)
 {
     QList<MGNum> mgnums = mgid.map(*this);
     
+    this->_pvt_logStructuralChange();
+    
     SaveState old_state = SaveState::save(*this);
     
     bool mols_removed = false;
@@ -2673,6 +3109,8 @@ bool System::removeAll(const Molecules &molecules, const MGID &mgid)
 {
     QList<MGNum> mgnums = mgid.map(*this);
     
+    this->_pvt_logStructuralChange();
+    
     SaveState old_state = SaveState::save(*this);
     
     bool mols_removed = false;
@@ -2733,6 +3171,8 @@ bool System::remove(MolNum molnum, const MGID &mgid)
 {
     QList<MGNum> mgnums = mgid.map(*this);
     
+    this->_pvt_logStructuralChange();
+    
     SaveState old_state = SaveState::save(*this);
     
     bool mols_removed = false;
@@ -2771,6 +3211,8 @@ bool System::remove(const QSet<MolNum> &molnums, const MGID &mgid)
 {
     QList<MGNum> mgnums = mgid.map(*this);
     
+    this->_pvt_logStructuralChange();
+    
     SaveState old_state = SaveState::save(*this);
     
     bool mols_removed = false;
@@ -2880,6 +3322,8 @@ void System::setContents(const MGID &mgid, const MoleculeView &molview,
     PartialMolecule view(molview);
     view.update( this->matchToExistingVersion(molview.data()) );
     
+    this->_pvt_logStructuralChange();
+    
     SaveState old_state = SaveState::save(*this);
     
     try
@@ -2926,6 +3370,8 @@ void System::setContents(const MGID &mgid, const ViewsOfMol &molviews,
     ViewsOfMol views(molviews);
     views.update( this->matchToExistingVersion(molviews.data()) );
     
+    this->_pvt_logStructuralChange();
+    
     SaveState old_state = SaveState::save(*this);
     
     try
@@ -2972,6 +3418,8 @@ void System::setContents(const MGID &mgid, const Molecules &molecules,
     
     Molecules mols = this->matchToExistingVersion(molecules);
     
+    this->_pvt_logStructuralChange();
+    
     SaveState old_state = SaveState::save(*this);
     
     try
@@ -3019,6 +3467,8 @@ void System::setContents(const MGID &mgid, const MoleculeGroup &molgroup,
     MolGroupPtr group(molgroup);
     group.edit().update( this->matchToExistingVersion(molgroup.molecules()) );
     
+    this->_pvt_logStructuralChange();
+    
     SaveState old_state = SaveState::save(*this);
     
     try
@@ -3103,6 +3553,7 @@ void System::setContents(const MGID &mgid, const MoleculeGroup &molgroup)
 
 bool System::deltaUpdate(const Symbol &component, double value)
 {
+    this->_pvt_logStructuralChange();
     this->_pvt_forceFields().setConstantComponent(component, value);
     ++subversion;
     return true;
@@ -3110,6 +3561,7 @@ bool System::deltaUpdate(const Symbol &component, double value)
 
 bool System::deltaUpdate(const QString &property, const Property &value)
 {
+    this->_pvt_logStructuralChange();
     this->_pvt_forceFields().setProperty(property, value);
     ++subversion;
     return true;
@@ -3118,6 +3570,7 @@ bool System::deltaUpdate(const QString &property, const Property &value)
 bool System::deltaUpdate(const QString &property, const FFID &ffid,
                          const Property &value)
 {
+    this->_pvt_logStructuralChange();
     this->_pvt_forceFields().setProperty(ffid, property, value);
     ++subversion;
     return true;
@@ -3129,7 +3582,9 @@ bool System::deltaUpdate(const QString &property, const QList<FFIdx> &ffidxs,
     if (ffidxs.isEmpty())
         return false;
     
-    else if (ffidxs.count() == 1)
+    this->_pvt_logStructuralChange();
+    
+    if (ffidxs.count() == 1)
     {
         this->_pvt_forceFields().setProperty(ffidxs.at(0), property, value);
         ++subversion;
@@ -3165,6 +3620,8 @@ bool System::deltaUpdate(const MoleculeData &moldata, bool auto_commit)
 
     if (in_molgroup or in_ffields)
     {
+        this->_pvt_logMoleculeChange(moldata.number());
+    
         if (in_molgroup)
             this->_pvt_moleculeGroups().update(moldata, auto_commit);
             
@@ -3215,6 +3672,11 @@ QList<MolNum> System::deltaUpdate(const Molecules &molecules, bool auto_commit)
     
     if (in_molgroup or in_ffields)
     {
+        foreach (MolNum molnum, changed_mols)
+        {
+            this->_pvt_logMoleculeChange(molnum);
+        }
+    
         if (in_ffields)
             this->_pvt_forceFields().update(molecules, auto_commit);
         
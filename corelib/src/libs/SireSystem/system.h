@@ -30,6 +30,7 @@
 #define SIRESYSTEM_SYSTEM_H
 
 #include <QUuid>
+#include <QSharedDataPointer>
 
 #include "sysname.h"
 #include "systemmonitors.h"
@@ -50,6 +51,11 @@ SIRE_BEGIN_HEADER
 namespace SireSystem
 {
 class System;
+
+namespace detail
+{
+class SystemTransaction;
+}
 }
 
 QDataStream& operator<<(QDataStream&, const SireSystem::System&);
@@ -309,9 +315,21 @@ public:
     
     void mustNowRecalculateFromScratch();
     
+    void enableParallelCalculation();
+    void disableParallelCalculation();
+    void setUseParallelCalculation(bool on);
+    bool usesParallelCalculation() const;
+    
     void accept();
     bool needsAccepting() const;
     
+    void beginTransaction();
+    void commitTransaction();
+    void rollbackTransaction();
+    
+    bool inTransaction() const;
+    int transactionDepth() const;
+    
     bool isDirty() const;
     bool isClean() const;
     
@@ -476,6 +494,9 @@ private:
     void _pvt_applyMoleculeConstraints(MolNum molnum);
     void _pvt_applyMoleculeConstraints(const Molecules &molecules);
 
+    void _pvt_logMoleculeChange(MolNum molnum);
+    void _pvt_logStructuralChange();
+
     /** The unique ID for this system */
     QUuid uid;
     
@@ -504,6 +525,10 @@ private:
         delta updates are being applied. A system with non-zero
         subversion is not guaranteed to be in a valid state */
     quint32 subversion;
+    
+    /** The undo log of the currently open transaction. This is
+        null if there is no open transaction */
+    QSharedDataPointer<detail::SystemTransaction> transaction;
 };
 
 #ifndef SIRE_SKIP_INLINE_FUNCTIONS
@@ -517,6 +517,138 @@ int GridInfo::pointToGridCorners(const MultiFloat &x, const MultiFloat &y,
     return n_in_box;
 }
 
+/** Internal function used to calculate the Catmull-Rom weights of the four
+    grid points along an axis, for the fractional coordinate 'u' of the 
+    point within the box, i.e.
+
+    w(-1) = 0.5 * (-u^3 + 2u^2 - u)
+    w( 0) = 0.5 * (3u^3 - 5u^2 + 2)
+    w(+1) = 0.5 * (-3u^3 + 4u^2 + u)
+    w(+2) = 0.5 * (u^3 - u^2)
+*/
+static void getCatmullRomWeights(const MultiFloat &u, MultiFloat *w)
+{
+    const MultiFloat half(0.5);
+    const MultiFloat two(2);
+    const MultiFloat three(3);
+    const MultiFloat four(4);
+    const MultiFloat five(5);
+
+    const MultiFloat u2 = u * u;
+    const MultiFloat u3 = u2 * u;
+    
+    w[0] = half * (two*u2 - u3 - u);
+    w[1] = half * (three*u3 - five*u2 + two);
+    w[2] = half * (four*u2 - three*u3 + u);
+    w[3] = half * (u3 - u2);
+}
+
+/** Return array indicies of the 64 grid points (4x4x4) that surround the
+    box that contains each of the points in (x,y,z), together with the 
+    weights needed to perform a tricubic interpolation of a value on the grid.
+    The indicies are ordered so that the index of point (a,b,c) of the 
+    stencil is in indicies[16*a + 4*b + c], where (1,1,1) is the lower
+    corner of the box containing the point. The eight corners of the 
+    box (the points used for tri-linear interpolation) are those with
+    a, b and c equal to 1 or 2.
+    
+    This uses tensor-product Catmull-Rom (cubic convolution) interpolation, 
+    which reproduces the values on the grid points and has a continuous first
+    derivative, without needing derivatives of the value to be stored on
+    the grid. Stencil points that fall off the edge of the grid are clamped
+    to the edge. This returns 64 '-1' values (and zero weights) for any point
+    that does not lie in the grid, and returns the number of points that
+    lie in the grid */
+int GridInfo::pointToTricubicGridCorners(const MultiFloat &x, const MultiFloat &y,
+                                         const MultiFloat &z, QVector<MultiInt> &indicies,
+                                         QVector<MultiFloat> &weights) const
+{
+    indicies.resize(64);
+    weights.resize(64);
+    
+    MultiInt *ia = indicies.data();
+    MultiFloat *wa = weights.data();
+    
+    const MultiFloat ox(grid_origin.x());
+    const MultiFloat oy(grid_origin.y());
+    const MultiFloat oz(grid_origin.z());
+    
+    const MultiFloat inv_spacing(inv_grid_spacing);
+    
+    MultiFloat dx = (x - ox) * inv_spacing;
+    MultiFloat dy = (y - oy) * inv_spacing;
+    MultiFloat dz = (z - oz) * inv_spacing;
+    
+    const MultiInt r = dx;
+    const MultiInt s = dy;
+    const MultiInt t = dz;
+    
+    dx -= r;
+    dy -= s;
+    dz -= t;
+
+    MultiFloat wx[4], wy[4], wz[4];
+    
+    getCatmullRomWeights(dx, wx);
+    getCatmullRomWeights(dy, wy);
+    getCatmullRomWeights(dz, wz);
+
+    //i*(dimy*dimz) + j*dimz + k;
+    const MultiInt zero(0);
+    const MultiInt idz(dimz);
+    const MultiInt idyz(dimz * dimy);
+    
+    const MultiInt max_i(dimx-1);
+    const MultiInt max_j(dimy-1);
+    const MultiInt max_k(dimz-1);
+    
+    MultiInt ii[4], jj[4], kk[4];
+    
+    for (int a=0; a<4; ++a)
+    {
+        const MultiInt offset(a-1);
+        ii[a] = (r + offset).max(zero).min(max_i) * idyz;
+        jj[a] = (s + offset).max(zero).min(max_j) * idz;
+        kk[a] = (t + offset).max(zero).min(max_k);
+    }
+    
+    for (int a=0; a<4; ++a)
+    {
+        for (int b=0; b<4; ++b)
+        {
+            const MultiInt iab = ii[a] + jj[b];
+            const MultiFloat wab = wx[a] * wy[b];
+        
+            for (int c=0; c<4; ++c)
+            {
+                ia[16*a + 4*b + c] = iab + kk[c];
+                wa[16*a + 4*b + c] = wab * wz[c];
+            }
+        }
+    }
+    
+    //now check that the points are in the box
+    int n_in_box = MultiFloat::count();
+    
+    for (int i=0; i<MultiInt::count(); ++i)
+    {
+        if (r[i] < 0 or r[i] >= (dimx-1) or
+            s[i] < 0 or s[i] >= (dimy-1) or
+            t[i] < 0 or t[i] >= (dimz-1))
+        {
+            for (int j=0; j<64; ++j)
+            {
+                ia[j].set(i, -1);
+                wa[j].set(i, 0);
+            }
+            
+            n_in_box -= 1;
+        }
+    }
+    
+    return n_in_box;
+}
+
 /** Return the array index of the grid box that contains the point 'point'. 
     Note that this returns -1 if the point is not in the grid */
 int GridInfo::pointToArrayIndex(const Vector &point) const
@@ -215,6 +215,10 @@ public:
     int pointToGridCorners(const MultiFloat &x, const MultiFloat &y, const MultiFloat &z,
                            QVector<MultiInt> &indicies, QVector<MultiFloat> &weights) const;
 
+    int pointToTricubicGridCorners(const MultiFloat &x, const MultiFloat &y,
+                                   const MultiFloat &z, QVector<MultiInt> &indicies,
+                                   QVector<MultiFloat> &weights) const;
+
     GridIndex arrayToGridIndex(int i) const;
     GridIndex pointToGridIndex(const Vector &point) const;
 
@@ -29,6 +29,7 @@
 #include "patching.h"
 
 #include "SireVol/periodicbox.h"
+#include "SireVol/triclinicbox.h"
 
 #include "SireStream/datastream.h"
 #include "SireStream/shareddatastream.h"
@@ -292,7 +293,9 @@ BoxPatching::BoxPatching()
     trying to construct a grid that divides space using a patch size of
     approximately "patch_size" 
     
-    Note that this patching is only compatible with cartesian spaces.
+    Note that this patching is only compatible with cartesian spaces
+    and triclinic boxes. For a triclinic box, the grid covers the
+    axis-aligned box that encloses the minimum images of all points
     
     \throw SireError::incompatible_error
 */
@@ -300,18 +303,26 @@ BoxPatching::BoxPatching(const Space &space, Length size, const Vector &center)
             : ConcreteProperty<BoxPatching,Patching>(space),
               patch_size(size), orgn(0), inv_gridvec(0), nx(0), ny(0), nz(0)
 {
-    if (not space.isCartesian())
+    if (not (space.isCartesian() or space.isA<TriclinicBox>()))
         throw SireError::incompatible_error( QObject::tr(
                 "BoxPatching is only compatible with cartesian spaces "
-                "(spaces for which space.isCartesian() is true). The passed "
-                "space (%1) is not a cartesian space.")
+                "(spaces for which space.isCartesian() is true) or triclinic "
+                "boxes. The passed space (%1) is not a cartesian space.")
                     .arg(space.toString()), CODELOC );
 
     if (space.isPeriodic())
     {
         //need a virtual function call here - as at the moment it
-        //depends on all cartesian periodic spaces being PeriodicBox...
-        Vector dimensions = space.asA<PeriodicBox>().dimensions();
+        //depends on all periodic spaces being PeriodicBox or TriclinicBox...
+        Vector dimensions;
+        
+        if (space.isA<TriclinicBox>())
+        {
+            const TriclinicBox &box = space.asA<TriclinicBox>();
+            dimensions = box.maxCoords() - box.minCoords();
+        }
+        else
+            dimensions = space.asA<PeriodicBox>().dimensions();
         
         nx = int( dimensions.x() / size.value() ) + 1;
         ny = int( dimensions.y() / size.value() ) + 1;
@@ -0,0 +1,1188 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#include <limits>
+#include <cmath>
+
+#include "triclinicbox.h"
+#include "coordgroup.h"
+
+#include "SireMaths/rangenerator.h"
+
+#include "SireUnits/units.h"
+
+#include "SireError/errors.h"
+#include "SireStream/datastream.h"
+
+#include <QDebug>
+
+using namespace SireVol;
+using namespace SireBase;
+using namespace SireMaths;
+using namespace SireStream;
+
+static const RegisterMetaType<TriclinicBox> r_tricbox;
+
+/** Serialise to a binary datastream */
+QDataStream SIREVOL_EXPORT &operator<<(QDataStream &ds, const TriclinicBox &box)
+{
+    writeHeader(ds, r_tricbox, 1)
+               << box.vec0 << box.vec1 << box.vec2
+               << static_cast<const Cartesian&>(box);
+
+               //no need to store anything else as it can be regenerated
+
+    return ds;
+}
+
+/** Deserialise from a binary datastream */
+QDataStream SIREVOL_EXPORT &operator>>(QDataStream &ds, TriclinicBox &box)
+{
+    VersionID v = readHeader(ds, r_tricbox);
+
+    if (v == 1)
+    {
+        Vector v0, v1, v2;
+
+        ds >> v0 >> v1 >> v2 >> static_cast<Cartesian&>(box);
+
+        box.setVectors(v0, v1, v2);
+    }
+    else
+        throw version_error(v, "1", r_tricbox, CODELOC);
+
+    return ds;
+}
+
+/** This is the maximum length of a lattice vector (so that .volume() doesn't overflow) */
+static const double max_length = std::pow(0.9 * std::numeric_limits<double>::max(),
+                                          1.0/3.0);
+
+/** Return the cross product of 'v0' and 'v1' (Vector::cross returns
+    the normalised cross product, which is not what we want here) */
+static Vector crossProduct(const Vector &v0, const Vector &v1)
+{
+    return Vector( v0.y()*v1.z() - v0.z()*v1.y(),
+                   v0.z()*v1.x() - v0.x()*v1.z(),
+                   v0.x()*v1.y() - v0.y()*v1.x() );
+}
+
+/** Round 'x' to the nearest integer */
+static inline double roundToInt(double x)
+{
+    return std::floor(x + 0.5);
+}
+
+/** Return the distance between two AABoxes with centers 'c0' and 'c1',
+    whose half-extents sum to 'halfext', ignoring periodic boundaries */
+static inline double boxDistance(const Vector &c0, const Vector &c1, const Vector &halfext)
+{
+    Vector delta = c1 - c0;
+
+    delta = Vector( std::abs(delta.x()), std::abs(delta.y()), std::abs(delta.z()) );
+    delta -= halfext;
+
+    return delta.max( Vector(0) ).length();
+}
+
+/** Return the half-extents of the axis-aligned box that encloses the
+    Wigner-Seitz cell of the lattice with the passed (reduced) vectors.
+    The cell is the set of points that satisfy p.t <= |t|^2/2 for all of
+    the lattice vectors t that neighbour the origin, so its vertices
+    are found by intersecting all triples of these planes */
+static Vector getCellExtents(const Vector &vec0, const Vector &vec1, const Vector &vec2)
+{
+    //work in scaled units to avoid overflowing for very large boxes
+    const double scl = qMax( vec0.length(), qMax(vec1.length(), vec2.length()) );
+    const Vector v0 = vec0 / scl;
+    const Vector v1 = vec1 / scl;
+    const Vector v2 = vec2 / scl;
+
+    QVector<Vector> t;
+    QVector<double> d;
+
+    for (int i=-1; i<=1; ++i)
+    {
+        for (int j=-1; j<=1; ++j)
+        {
+            for (int k=-1; k<=1; ++k)
+            {
+                if (i != 0 or j != 0 or k != 0)
+                {
+                    Vector l = double(i)*v0 + double(j)*v1 + double(k)*v2;
+                    t.append(l);
+                    d.append( 0.5 * l.length2() );
+                }
+            }
+        }
+    }
+
+    const int n = t.count();
+    Vector extents(0);
+
+    for (int a=0; a<n; ++a)
+    {
+        for (int b=a+1; b<n; ++b)
+        {
+            const Vector bxa = crossProduct(t[a], t[b]);
+
+            for (int c=b+1; c<n; ++c)
+            {
+                const double det = Vector::dot(t[c], bxa);
+
+                if (std::abs(det) < 1e-10)
+                    continue;
+
+                const Vector p = ( d[a] * crossProduct(t[b], t[c]) +
+                                   d[b] * crossProduct(t[c], t[a]) +
+                                   d[c] * bxa ) / det;
+
+                bool inside = true;
+
+                for (int i=0; i<n; ++i)
+                {
+                    if (Vector::dot(p, t[i]) > d[i] + 1e-8)
+                    {
+                        inside = false;
+                        break;
+                    }
+                }
+
+                if (inside)
+                {
+                    extents.setMax( Vector( std::abs(p.x()), std::abs(p.y()),
+                                            std::abs(p.z()) ) );
+                }
+            }
+        }
+    }
+
+    return scl * extents;
+}
+
+/** Set the lattice vectors of this box. The vectors are reduced so that
+    they are as short and as orthogonal as possible, which doesn't
+    change the lattice that they describe */
+void TriclinicBox::setVectors(const Vector &v0, const Vector &v1, const Vector &v2)
+{
+    Vector v[3] = { v0, v1, v2 };
+
+    for (int i=0; i<3; ++i)
+    {
+        if (v[i].length() > max_length)
+            v[i] = max_length * v[i].normalise();
+    }
+
+    double vol = Vector::dot( v[0], crossProduct(v[1], v[2]) );
+
+    if (vol == 0 or std::abs(vol) < 1e-6 * v[0].length() * v[1].length() * v[2].length())
+        throw SireError::invalid_arg( QObject::tr(
+                "Cannot create a triclinic box from the vectors %1, %2 and %3 "
+                "as they do not span three dimensions.")
+                    .arg(v0.toString(), v1.toString(), v2.toString()), CODELOC );
+
+    //reduce the vectors by subtracting integer multiples of each from the others,
+    //until none can be made any shorter
+    bool changed = true;
+
+    while (changed)
+    {
+        changed = false;
+
+        for (int i=0; i<3; ++i)
+        {
+            for (int j=0; j<3; ++j)
+            {
+                if (i == j)
+                    continue;
+
+                const double len2 = v[j].length2();
+                const double dot = Vector::dot(v[i], v[j]);
+
+                if (std::abs(dot) > (0.5 + 1e-9) * len2)
+                {
+                    v[i] -= roundToInt(dot / len2) * v[j];
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    vec0 = v[0];
+    vec1 = v[1];
+    vec2 = v[2];
+
+    vol = Vector::dot( vec0, crossProduct(vec1, vec2) );
+
+    rec0 = crossProduct(vec1, vec2) / vol;
+    rec1 = crossProduct(vec2, vec0) / vol;
+    rec2 = crossProduct(vec0, vec1) / vol;
+
+    face_dist = Vector( 1.0 / rec0.length(), 1.0 / rec1.length(), 1.0 / rec2.length() );
+
+    double min_length2 = std::numeric_limits<double>::max();
+
+    for (int i=-1; i<=1; ++i)
+    {
+        for (int j=-1; j<=1; ++j)
+        {
+            for (int k=-1; k<=1; ++k)
+            {
+                if (i != 0 or j != 0 or k != 0)
+                    min_length2 = qMin( min_length2, lattice(i,j,k).length2() );
+            }
+        }
+    }
+
+    half_min_length = 0.5 * std::sqrt(min_length2);
+
+    cell_extents = getCellExtents(vec0, vec1, vec2);
+}
+
+/** Construct a default TriclinicBox (a ridiculously large cubic box) */
+TriclinicBox::TriclinicBox() : ConcreteProperty<TriclinicBox,Cartesian>()
+{
+    this->setVectors( Vector(max_length,0,0), Vector(0,max_length,0),
+                      Vector(0,0,max_length) );
+}
+
+/** Construct a TriclinicBox whose unit cell is spanned by the three
+    lattice vectors 'v0', 'v1' and 'v2'
+
+    \throw SireError::invalid_arg
+*/
+TriclinicBox::TriclinicBox(const Vector &v0, const Vector &v1, const Vector &v2)
+             : ConcreteProperty<TriclinicBox,Cartesian>()
+{
+    this->setVectors(v0, v1, v2);
+}
+
+/** Construct a TriclinicBox from the lengths of the sides of its unit
+    cell (a, b and c) and the angles between them (alpha is the angle
+    between b and c, beta between a and c, and gamma between a and b).
+    This uses the standard (e.g. PDB and Amber) convention that
+    'a' lies along the x axis and 'b' lies in the xy plane
+
+    \throw SireError::invalid_arg
+*/
+TriclinicBox::TriclinicBox(double a, double b, double c,
+                           const SireUnits::Dimension::Angle &alpha,
+                           const SireUnits::Dimension::Angle &beta,
+                           const SireUnits::Dimension::Angle &gamma)
+             : ConcreteProperty<TriclinicBox,Cartesian>()
+{
+    const double cos_alpha = std::cos( alpha.value() );
+    const double cos_beta = std::cos( beta.value() );
+    const double cos_gamma = std::cos( gamma.value() );
+    const double sin_gamma = std::sin( gamma.value() );
+
+    if (sin_gamma == 0)
+        throw SireError::invalid_arg( QObject::tr(
+                "Cannot create a triclinic box with an angle of %1 degrees "
+                "between a and b.").arg(gamma.to(SireUnits::degrees)), CODELOC );
+
+    const double cx = c * cos_beta;
+    const double cy = c * (cos_alpha - cos_beta*cos_gamma) / sin_gamma;
+    const double cz2 = c*c - cx*cx - cy*cy;
+
+    if (cz2 <= 0)
+        throw SireError::invalid_arg( QObject::tr(
+                "Cannot create a triclinic box with angles %1, %2 and %3 degrees, "
+                "as these angles do not describe a three-dimensional unit cell.")
+                    .arg(alpha.to(SireUnits::degrees))
+                    .arg(beta.to(SireUnits::degrees))
+                    .arg(gamma.to(SireUnits::degrees)), CODELOC );
+
+    this->setVectors( Vector(a, 0, 0),
+                      Vector(b*cos_gamma, b*sin_gamma, 0),
+                      Vector(cx, cy, std::sqrt(cz2)) );
+}
+
+/** Copy constructor */
+TriclinicBox::TriclinicBox(const TriclinicBox &other)
+             : ConcreteProperty<TriclinicBox,Cartesian>(other),
+               vec0(other.vec0), vec1(other.vec1), vec2(other.vec2),
+               rec0(other.rec0), rec1(other.rec1), rec2(other.rec2),
+               face_dist(other.face_dist), cell_extents(other.cell_extents),
+               half_min_length(other.half_min_length)
+{}
+
+/** Destructor */
+TriclinicBox::~TriclinicBox()
+{}
+
+/** Copy assignment operator */
+TriclinicBox& TriclinicBox::operator=(const TriclinicBox &other)
+{
+    if (this != &other)
+    {
+        vec0 = other.vec0;
+        vec1 = other.vec1;
+        vec2 = other.vec2;
+        rec0 = other.rec0;
+        rec1 = other.rec1;
+        rec2 = other.rec2;
+        face_dist = other.face_dist;
+        cell_extents = other.cell_extents;
+        half_min_length = other.half_min_length;
+        Cartesian::operator=(other);
+    }
+
+    return *this;
+}
+
+/** Comparison operator */
+bool TriclinicBox::operator==(const TriclinicBox &other) const
+{
+    return vec0 == other.vec0 and vec1 == other.vec1 and vec2 == other.vec2;
+}
+
+/** Comparison operator */
+bool TriclinicBox::operator!=(const TriclinicBox &other) const
+{
+    return not TriclinicBox::operator==(other);
+}
+
+/** Return a cubic box whose periodic images are separated by 'd' */
+TriclinicBox TriclinicBox::cubic(double d)
+{
+    return TriclinicBox( Vector(d,0,0), Vector(0,d,0), Vector(0,0,d) );
+}
+
+/** Return a truncated octahedral box whose nearest periodic images are
+    separated by 'd'. This has a volume of about 77% of the cubic box
+    with the same image distance */
+TriclinicBox TriclinicBox::truncatedOctahedron(double d)
+{
+    return TriclinicBox( Vector(d, 0, 0),
+                         Vector(d/3.0, 2.0*std::sqrt(2.0)*d/3.0, 0),
+                         Vector(-d/3.0, std::sqrt(2.0)*d/3.0, std::sqrt(6.0)*d/3.0) );
+}
+
+/** Return a rhombic dodecahedral box (with a square cross-section
+    in the xy plane) whose nearest periodic images are separated by 'd'.
+    This has a volume of about 71% of the cubic box with the same
+    image distance */
+TriclinicBox TriclinicBox::rhombicDodecahedronSquare(double d)
+{
+    return TriclinicBox( Vector(d, 0, 0),
+                         Vector(0, d, 0),
+                         Vector(0.5*d, 0.5*d, 0.5*std::sqrt(2.0)*d) );
+}
+
+/** Return a rhombic dodecahedral box (with a hexagonal cross-section
+    in the xy plane) whose nearest periodic images are separated by 'd'.
+    This has a volume of about 71% of the cubic box with the same
+    image distance */
+TriclinicBox TriclinicBox::rhombicDodecahedronHexagon(double d)
+{
+    return TriclinicBox( Vector(d, 0, 0),
+                         Vector(0.5*d, 0.5*std::sqrt(3.0)*d, 0),
+                         Vector(0.5*d, std::sqrt(3.0)*d/6.0, std::sqrt(6.0)*d/3.0) );
+}
+
+/** A triclinic box is periodic! */
+bool TriclinicBox::isPeriodic() const
+{
+    return true;
+}
+
+/** A triclinic box is not cartesian, as the angles between the
+    lattice vectors need not be 90 degrees */
+bool TriclinicBox::isCartesian() const
+{
+    return false;
+}
+
+/** Return the first (reduced) lattice vector */
+const Vector& TriclinicBox::vector0() const
+{
+    return vec0;
+}
+
+/** Return the second (reduced) lattice vector */
+const Vector& TriclinicBox::vector1() const
+{
+    return vec1;
+}
+
+/** Return the third (reduced) lattice vector */
+const Vector& TriclinicBox::vector2() const
+{
+    return vec2;
+}
+
+/** Return the distance between a point and its nearest periodic image.
+    Any two points that are closer than half of this distance are
+    guaranteed to be minimum images of each other */
+double TriclinicBox::minimumImageDistance() const
+{
+    return 2.0 * half_min_length;
+}
+
+/** Return the minimum coordinates of the axis-aligned box that encloses
+    all of the minimum images of points about 'center' */
+Vector TriclinicBox::minCoords(const Vector &center) const
+{
+    return center - cell_extents;
+}
+
+/** Return the maximum coordinates of the axis-aligned box that encloses
+    all of the minimum images of points about 'center' */
+Vector TriclinicBox::maxCoords(const Vector &center) const
+{
+    return center + cell_extents;
+}
+
+/** Return a string representation of this space */
+QString TriclinicBox::toString() const
+{
+    return QObject::tr("TriclinicBox( %1, %2, %3 )")
+                .arg(vec0.toString(), vec1.toString(), vec2.toString());
+}
+
+/** Return the lattice vector that needs to be added to 'v0' to
+    move it to its closest periodic image to 'v1'. This first
+    finds the closest image in fractional coordinates, and then,
+    only if that could be beaten, searches the surrounding images */
+Vector TriclinicBox::wrapDelta(const Vector &v0, const Vector &v1) const
+{
+    const Vector delta = v1 - v0;
+
+    Vector t = roundToInt( Vector::dot(rec0,delta) ) * vec0 +
+               roundToInt( Vector::dot(rec1,delta) ) * vec1 +
+               roundToInt( Vector::dot(rec2,delta) ) * vec2;
+
+    double best = (delta - t).length2();
+
+    if (best <= half_min_length*half_min_length)
+        //this must be the minimum image
+        return t;
+
+    bool improved = true;
+
+    while (improved)
+    {
+        improved = false;
+        Vector best_t = t;
+
+        for (int i=-1; i<=1; ++i)
+        {
+            for (int j=-1; j<=1; ++j)
+            {
+                for (int k=-1; k<=1; ++k)
+                {
+                    if (i == 0 and j == 0 and k == 0)
+                        continue;
+
+                    const Vector test_t = t + lattice(i,j,k);
+                    const double dist2 = (delta - test_t).length2();
+
+                    if (dist2 < best)
+                    {
+                        best = dist2;
+                        best_t = test_t;
+                        improved = true;
+                    }
+                }
+            }
+        }
+
+        t = best_t;
+    }
+
+    return t;
+}
+
+/** Return the volume of the unit cell of this space */
+SireUnits::Dimension::Volume TriclinicBox::volume() const
+{
+    return SireUnits::Dimension::Volume( std::abs(
+                                Vector::dot(vec0, crossProduct(vec1,vec2)) ) );
+}
+
+/** Return a copy of this space with the volume of set to 'volume'
+    - this will scale the lattice vectors uniformly, keeping the
+    shape of the unit cell the same, to achieve this volume */
+SpacePtr TriclinicBox::setVolume(SireUnits::Dimension::Volume vol) const
+{
+    double old_volume = this->volume();
+    double new_volume = vol;
+
+    if (new_volume < 0)
+        throw SireError::invalid_arg( QObject::tr(
+            "You cannot set the volume of a triclinic box to a negative value! (%1)")
+                .arg(new_volume), CODELOC );
+
+    if (old_volume == new_volume)
+        return *this;
+
+    double scl = std::pow( new_volume / old_volume, 1.0/3.0 );
+
+    return TriclinicBox( scl*vec0, scl*vec1, scl*vec2 );
+}
+
+/** Calculate the distance between two points */
+double TriclinicBox::calcDist(const Vector &point0, const Vector &point1) const
+{
+    return Vector::distance( point0 + wrapDelta(point0, point1), point1 );
+}
+
+/** Calculate the distance squared between two points */
+double TriclinicBox::calcDist2(const Vector &point0, const Vector &point1) const
+{
+    return Vector::distance2( point0 + wrapDelta(point0, point1), point1 );
+}
+
+/** Populate the matrix 'mat' with the distances between all of the
+    atoms of the two CoordGroups. Return the shortest distance between
+    the two CoordGroups. */
+double TriclinicBox::calcDist(const CoordGroup &group0, const CoordGroup &group1,
+                              DistMatrix &mat) const
+{
+    double mindist(std::numeric_limits<double>::max());
+
+    const int n0 = group0.count();
+    const int n1 = group1.count();
+
+    //redimension the matrix to hold all of the pairs
+    mat.redimension(n0, n1);
+
+    //see if we need to wrap the coordinates...
+    Vector wrapdelta = this->wrapDelta(group0.aaBox().center(), group1.aaBox().center());
+
+    //get raw pointers to the arrays - this provides more efficient access
+    const Vector *array0 = group0.constData();
+    const Vector *array1 = group1.constData();
+
+    for (int i=0; i<n0; ++i)
+    {
+        //add the delta to the coordinates of atom0
+        Vector point0 = array0[i] + wrapdelta;
+        mat.setOuterIndex(i);
+
+        for (int j=0; j<n1; ++j)
+        {
+            const double dist = Vector::distance(point0, array1[j]);
+            mindist = qMin(mindist, dist);
+            mat[j] = dist;
+        }
+    }
+
+    //return the minimum distance
+    return mindist;
+}
+
+/** Populate the matrix 'mat' with the distances between all of the
+    atoms of the passed CoordGroup to the passed point. Return the shortest
+    distance. */
+double TriclinicBox::calcDist(const CoordGroup &group, const Vector &point,
+                              DistMatrix &mat) const
+{
+    double mindist(std::numeric_limits<double>::max());
+
+    const int n = group.count();
+
+    //redimension the matrix to hold all of the pairs
+    mat.redimension(1, n);
+
+    //see if we need to wrap the coordinates...
+    Vector wrapped_point = point + this->wrapDelta(point, group.aaBox().center());
+
+    const Vector *array = group.constData();
+
+    mat.setOuterIndex(0);
+
+    for (int j=0; j<n; ++j)
+    {
+        const double dist = Vector::distance(wrapped_point, array[j]);
+        mindist = qMin(mindist, dist);
+        mat[j] = dist;
+    }
+
+    return mindist;
+}
+
+/** Populate the matrix 'mat' with the distances squared between all of the
+    atoms of the passed CoordGroup to the passed point. Return the shortest
+    distance. */
+double TriclinicBox::calcDist2(const CoordGroup &group, const Vector &point,
+                               DistMatrix &mat) const
+{
+    double mindist2(std::numeric_limits<double>::max());
+
+    const int n = group.count();
+
+    //redimension the matrix to hold all of the pairs
+    mat.redimension(1, n);
+
+    //see if we need to wrap the coordinates...
+    Vector wrapped_point = point + this->wrapDelta(point, group.aaBox().center());
+
+    const Vector *array = group.constData();
+
+    mat.setOuterIndex(0);
+
+    for (int j=0; j<n; ++j)
+    {
+        const double dist2 = Vector::distance2(wrapped_point, array[j]);
+        mindist2 = qMin(mindist2, dist2);
+        mat[j] = dist2;
+    }
+
+    return std::sqrt(mindist2);
+}
+
+/** Populate the matrix 'mat' with the distances^2 between all of the
+    atoms of the two CoordGroups. Return the shortest distance between the
+    two CoordGroups. */
+double TriclinicBox::calcDist2(const CoordGroup &group0, const CoordGroup &group1,
+                               DistMatrix &mat) const
+{
+    double mindist2(std::numeric_limits<double>::max());
+
+    const int n0 = group0.count();
+    const int n1 = group1.count();
+
+    //redimension the matrix to hold all of the pairs
+    mat.redimension(n0, n1);
+
+    //see if we need to wrap the coordinates...
+    Vector wrapdelta = this->wrapDelta(group0.aaBox().center(), group1.aaBox().center());
+
+    const Vector *array0 = group0.constData();
+    const Vector *array1 = group1.constData();
+
+    for (int i=0; i<n0; ++i)
+    {
+        Vector point0 = array0[i] + wrapdelta;
+        mat.setOuterIndex(i);
+
+        for (int j=0; j<n1; ++j)
+        {
+            const double dist2 = Vector::distance2(point0, array1[j]);
+            mindist2 = qMin(dist2, mindist2);
+            mat[j] = dist2;
+        }
+    }
+
+    return std::sqrt(mindist2);
+}
+
+/** Populate the matrix 'mat' with the inverse distances between all of the
+    atoms of the two CoordGroups. Return the shortest distance between the
+    two CoordGroups. */
+double TriclinicBox::calcInvDist(const CoordGroup &group0, const CoordGroup &group1,
+                                 DistMatrix &mat) const
+{
+    double maxinvdist(0);
+
+    const int n0 = group0.count();
+    const int n1 = group1.count();
+
+    //redimension the matrix to hold all of the pairs
+    mat.redimension(n0, n1);
+
+    //see if we need to wrap the coordinates...
+    Vector wrapdelta = this->wrapDelta(group0.aaBox().center(), group1.aaBox().center());
+
+    const Vector *array0 = group0.constData();
+    const Vector *array1 = group1.constData();
+
+    for (int i=0; i<n0; ++i)
+    {
+        Vector point0 = array0[i] + wrapdelta;
+        mat.setOuterIndex(i);
+
+        for (int j=0; j<n1; ++j)
+        {
+            const double invdist = Vector::invDistance(point0, array1[j]);
+            maxinvdist = qMax(invdist, maxinvdist);
+            mat[j] = invdist;
+        }
+    }
+
+    return 1.0 / maxinvdist;
+}
+
+/** Populate the matrix 'mat' with the inverse distances^2 between all of the
+    atoms of the two CoordGroups. Return the shortest distance between the
+    two CoordGroups. */
+double TriclinicBox::calcInvDist2(const CoordGroup &group0, const CoordGroup &group1,
+                                  DistMatrix &mat) const
+{
+    double maxinvdist2(0);
+
+    const int n0 = group0.count();
+    const int n1 = group1.count();
+
+    //redimension the matrix to hold all of the pairs
+    mat.redimension(n0, n1);
+
+    //see if we need to wrap the coordinates...
+    Vector wrapdelta = this->wrapDelta(group0.aaBox().center(), group1.aaBox().center());
+
+    const Vector *array0 = group0.constData();
+    const Vector *array1 = group1.constData();
+
+    for (int i=0; i<n0; ++i)
+    {
+        Vector point0 = array0[i] + wrapdelta;
+        mat.setOuterIndex(i);
+
+        for (int j=0; j<n1; ++j)
+        {
+            const double invdist2 = Vector::invDistance2(point0, array1[j]);
+            maxinvdist2 = qMax(invdist2, maxinvdist2);
+            mat[j] = invdist2;
+        }
+    }
+
+    return 1.0 / std::sqrt(maxinvdist2);
+}
+
+/** Calculate the distance vector between two points */
+DistVector TriclinicBox::calcDistVector(const Vector &point0,
+                                        const Vector &point1) const
+{
+    return point1 - (point0 + wrapDelta(point0, point1));
+}
+
+/** Populate the matrix 'distmat' between all the points of the two CoordGroups
+    'group1' and 'group2' - the returned matrix has the vectors pointing
+    from each point in 'group1' to each point in 'group2'. This returns
+    the shortest distance between two points in the group */
+double TriclinicBox::calcDistVectors(const CoordGroup &group0, const CoordGroup &group1,
+                                     DistVectorMatrix &mat) const
+{
+    double mindist(std::numeric_limits<double>::max());
+
+    const int n0 = group0.count();
+    const int n1 = group1.count();
+
+    //redimension the matrix to hold all of the pairs
+    mat.redimension(n0, n1);
+
+    //see if we need to wrap the coordinates...
+    Vector wrapdelta = this->wrapDelta(group0.aaBox().center(), group1.aaBox().center());
+
+    const Vector *array0 = group0.constData();
+    const Vector *array1 = group1.constData();
+
+    for (int i=0; i<n0; ++i)
+    {
+        Vector point0 = array0[i] + wrapdelta;
+        mat.setOuterIndex(i);
+
+        for (int j=0; j<n1; ++j)
+        {
+            mat[j] = (array1[j] - point0);
+            mindist = qMin(mat[j].length(), mindist);
+        }
+    }
+
+    return mindist;
+}
+
+/** Populate the matrix 'distmat' between all the points passed CoordGroup
+    to the point 'point' - the returned matrix has the vectors pointing
+    from the point to each point in 'group'. This returns
+    the shortest distance. */
+double TriclinicBox::calcDistVectors(const CoordGroup &group, const Vector &point,
+                                     DistVectorMatrix &mat) const
+{
+    double mindist(std::numeric_limits<double>::max());
+
+    const int n = group.count();
+
+    //redimension the matrix to hold all of the pairs
+    mat.redimension(1, n);
+
+    //see if we need to wrap the coordinates...
+    Vector wrapped_point = point + this->wrapDelta(point, group.aaBox().center());
+
+    const Vector *array = group.constData();
+
+    mat.setOuterIndex(0);
+
+    for (int j=0; j<n; ++j)
+    {
+        mat[j] = (array[j] - wrapped_point);
+        mindist = qMin(mat[j].length(), mindist);
+    }
+
+    return mindist;
+}
+
+/** Calculate the angle between the passed three points. This should return
+    the acute angle between the points, which should lie between 0 and 180 degrees */
+Angle TriclinicBox::calcAngle(const Vector &point0, const Vector &point1,
+                              const Vector &point2) const
+{
+    Vector p0 = this->getMinimumImage(point0, point1);
+    Vector p2 = this->getMinimumImage(point2, point1);
+
+    return Vector::angle(p0, point1, p2);
+}
+
+/** Calculate the torsion angle between the passed four points. This should
+    return the torsion angle measured clockwise when looking down the
+    torsion from point0-point1-point2-point3. This will lie between 0 and 360
+    degrees */
+Angle TriclinicBox::calcDihedral(const Vector &point0, const Vector &point1,
+                                 const Vector &point2, const Vector &point3) const
+{
+    Vector p0 = this->getMinimumImage(point0, point1);
+    Vector p2 = this->getMinimumImage(point2, point1);
+    Vector p3 = this->getMinimumImage(point3, point1);
+
+    return Vector::dihedral(p0, point1, p2, p3);
+}
+
+/** Return whether or not two groups enclosed by the AABoxes 'aabox0' and
+    'aabox1' are definitely beyond the cutoff distance 'dist' */
+bool TriclinicBox::beyond(double dist, const AABox &aabox0, const AABox &aabox1) const
+{
+    Vector wrapdelta = this->wrapDelta(aabox0.center(), aabox1.center());
+
+    const double sum = dist + aabox0.radius() + aabox1.radius();
+
+    return Vector::distance2( aabox0.center()+wrapdelta, aabox1.center() ) > sum*sum;
+}
+
+/** Return whether or not these two groups are definitely beyond the cutoff distance. */
+bool TriclinicBox::beyond(double dist, const CoordGroup &group0,
+                          const CoordGroup &group1) const
+{
+    return TriclinicBox::beyond(dist, group0.aaBox(), group1.aaBox());
+}
+
+/** Return the minimum distance between the two boxes, over all
+    of their periodic images */
+double TriclinicBox::minimumDistance(const AABox &box0, const AABox &box1) const
+{
+    const Vector halfext = box0.halfExtents() + box1.halfExtents();
+
+    const Vector c0 = box0.center() + wrapDelta(box0.center(), box1.center());
+
+    double mindist = boxDistance(c0, box1.center(), halfext);
+
+    //any other image of box0 has a center that is at least the shortest
+    //lattice vector away from c0, so can only be closer if the boxes
+    //are large compared to the box
+    const double dist = Vector::distance(c0, box1.center());
+
+    if (2.0*half_min_length - dist - box0.radius() - box1.radius() < mindist)
+    {
+        for (int i=-1; i<=1; ++i)
+        {
+            for (int j=-1; j<=1; ++j)
+            {
+                for (int k=-1; k<=1; ++k)
+                {
+                    if (i != 0 or j != 0 or k != 0)
+                        mindist = qMin( mindist, boxDistance(c0 + lattice(i,j,k),
+                                                             box1.center(), halfext) );
+                }
+            }
+        }
+    }
+
+    return mindist;
+}
+
+/** Return the minimum distance between the points in 'group0' and 'group1'.
+    This uses the minimum image convention (i.e. the minimum distance
+    between the closest periodic replicas are used) */
+double TriclinicBox::minimumDistance(const CoordGroup &group0,
+                                     const CoordGroup &group1) const
+{
+    double mindist2(std::numeric_limits<double>::max());
+
+    const int n0 = group0.count();
+    const int n1 = group1.count();
+
+    //see if we need to wrap the coordinates...
+    Vector wrapdelta = this->wrapDelta(group0.aaBox().center(), group1.aaBox().center());
+
+    const Vector *array0 = group0.constData();
+    const Vector *array1 = group1.constData();
+
+    for (int i=0; i<n0; ++i)
+    {
+        Vector point0 = array0[i] + wrapdelta;
+
+        for (int j=0; j<n1; ++j)
+        {
+            mindist2 = qMin( Vector::distance2(point0,array1[j]), mindist2 );
+        }
+    }
+
+    return std::sqrt(mindist2);
+}
+
+/** Return the closest periodic copy of 'group' to the point 'point',
+    according to the minimum image convention. The effect of this is
+    to move 'group' into the box which is now centered on 'point' */
+CoordGroup TriclinicBox::getMinimumImage(const CoordGroup &group,
+                                         const Vector &point) const
+{
+    Vector wrapdelta = wrapDelta(group.aaBox().center(), point);
+
+    if (wrapdelta.isZero())
+    {
+        //already got the minimum image
+        return group;
+    }
+    else
+    {
+        CoordGroupEditor editor = group.edit();
+        editor.translate(wrapdelta);
+
+        return editor.commit();
+    }
+}
+
+/** Return the closest periodic copy of each group in 'groups' to the
+    point 'point', according to the minimum image convention.
+    The effect of this is to move each 'group' into the box which is
+    now centered on 'point'. If 'translate_as_one' is true,
+    then this treats all groups as being part of one larger
+    group, and so it translates it together. This is useful
+    to get the minimum image of a molecule as a whole, rather
+    than breaking the molecule across a box boundary */
+CoordGroupArray TriclinicBox::getMinimumImage(const CoordGroupArray &groups,
+                                              const Vector &point,
+                                              bool translate_as_one) const
+{
+    if (translate_as_one or groups.nCoordGroups() == 1)
+    {
+        Vector wrapdelta = wrapDelta(groups.aaBox().center(), point);
+
+        if (wrapdelta.isZero())
+            return groups;
+        else
+        {
+            CoordGroupArray wrapped_groups( groups );
+            wrapped_groups.translate(wrapdelta);
+
+            return wrapped_groups;
+        }
+    }
+    else
+    {
+        const int ncg = groups.count();
+        const CoordGroup *group_array = groups.constData();
+
+        QVector<CoordGroup> moved_groups;
+
+        for (int i=0; i<ncg; ++i)
+        {
+            Vector wrapdelta = wrapDelta(group_array[i].aaBox().center(), point);
+
+            if (not wrapdelta.isZero())
+            {
+                if (moved_groups.isEmpty())
+                    //this is the first group that needs moving
+                    moved_groups = groups.toQVector();
+
+                CoordGroupEditor editor = group_array[i].edit();
+                editor.translate(wrapdelta);
+                moved_groups[i] = editor.commit();
+            }
+        }
+
+        if (moved_groups.isEmpty())
+            //all of the CoordGroups are in the box - just return the original array
+            return groups;
+        else
+            return CoordGroupArray(moved_groups);
+    }
+}
+
+/** Return the copy of the AABox which is the closest minimum image
+    to 'center' */
+AABox TriclinicBox::getMinimumImage(const AABox &aabox, const Vector &center) const
+{
+    Vector wrapdelta = wrapDelta(aabox.center(), center);
+
+    if (wrapdelta.isZero())
+        return aabox;
+    else
+    {
+        AABox ret(aabox);
+        ret.translate(wrapdelta);
+
+        return ret;
+    }
+}
+
+/** Return the copy of the point 'point' which is the closest minimum image
+    to 'center' */
+Vector TriclinicBox::getMinimumImage(const Vector &point, const Vector &center) const
+{
+    return point + wrapDelta(point, center);
+}
+
+/** Return all periodic images of 'point' with respect to 'center' within
+    'dist' distance of 'center' */
+QVector<Vector> TriclinicBox::getImagesWithin(const Vector &point, const Vector &center,
+                                              double dist) const
+{
+    QVector<Vector> points;
+
+    //first, get the minimum image...
+    Vector p = getMinimumImage(point, center);
+
+    if ( Vector::distance(p,center) < dist )
+    {
+        //both the minimum image and any other image in range are within 'dist'
+        //of 'center', so can be at most 2*dist apart. This limits the number
+        //of cells that we need to search along each lattice vector
+        const int ni = int( 2.0 * dist / face_dist.x() ) + 1;
+        const int nj = int( 2.0 * dist / face_dist.y() ) + 1;
+        const int nk = int( 2.0 * dist / face_dist.z() ) + 1;
+
+        for (int i = -ni; i <= ni; ++i)
+        {
+            for (int j = -nj; j <= nj; ++j)
+            {
+                for (int k = -nk; k <= nk; ++k)
+                {
+                    Vector p_image = p + lattice(i,j,k);
+
+                    if ( Vector::distance(center, p_image) < dist )
+                        points.append(p_image);
+                }
+            }
+        }
+    }
+
+    return points;
+}
+
+/** Return a list of copies of CoordGroup 'group' that are within
+    'distance' of the CoordGroup 'center', translating 'group' so that
+    it has the right coordinates to be around 'center'. The copies
+    of 'group' are returned together with the minimum distance
+    between that periodic replica and 'center'.
+
+    If there are no periodic replicas of 'group' that are within
+    'dist' of 'center', then an empty list is returned. */
+QList< tuple<double,CoordGroup> >
+TriclinicBox::getCopiesWithin(const CoordGroup &group, const CoordGroup &center,
+                              double dist) const
+{
+    if (dist > max_length)
+        throw SireError::invalid_arg( QObject::tr(
+            "You cannot use a distance (%1) that is greater than the "
+            "maximum box length (%2).")
+                .arg(dist).arg(max_length), CODELOC );
+
+    //are there any copies within range?
+    if (this->beyond(dist,group,center))
+        return QList< tuple<double,CoordGroup> >();
+
+    //move 'group' into the box that has its center at the
+    //center of the center group - this is the closest copy
+    CoordGroup minimum_image = this->getMinimumImage(group, center.aaBox().center());
+
+    const AABox &centerbox = center.aaBox();
+    const AABox &imagebox = minimum_image.aaBox();
+
+    const double sum_of_radii_and_distance = centerbox.radius() +
+                                             imagebox.radius() + dist;
+
+    const double sum_of_radii_and_distance2 = sum_of_radii_and_distance *
+                                              sum_of_radii_and_distance;
+
+    const int ni = int( 2.0 * sum_of_radii_and_distance / face_dist.x() ) + 1;
+    const int nj = int( 2.0 * sum_of_radii_and_distance / face_dist.y() ) + 1;
+    const int nk = int( 2.0 * sum_of_radii_and_distance / face_dist.z() ) + 1;
+
+    QList< tuple<double,CoordGroup> > neargroups;
+
+    for (int i = -ni; i <= ni; ++i)
+    {
+        for (int j = -nj; j <= nj; ++j)
+        {
+            for (int k = -nk; k <= nk; ++k)
+            {
+                const Vector delta = lattice(i,j,k);
+
+                if ( Vector::distance2(imagebox.center() + delta, centerbox.center())
+                                    <= sum_of_radii_and_distance2 )
+                {
+                    CoordGroupEditor editor = minimum_image.edit();
+                    editor.translate(delta);
+                    CoordGroup periodic_replica = editor.commit();
+
+                    //calculate the minimum distance... (using the cartesian space)
+                    double mindist = Cartesian::minimumDistance(periodic_replica, center);
+
+                    if (mindist <= dist)
+                    {
+                        neargroups.append(
+                                  tuple<double,CoordGroup>(mindist,periodic_replica) );
+                    }
+                }
+            }
+        }
+    }
+
+    return neargroups;
+}
+
+/** Return a random point within the unit cell (placing the center of the
+    cell at 'center') */
+Vector TriclinicBox::getRandomPoint(const Vector &center,
+                                    const RanGenerator &generator) const
+{
+    return center + generator.rand(-0.5, 0.5) * vec0
+                  + generator.rand(-0.5, 0.5) * vec1
+                  + generator.rand(-0.5, 0.5) * vec2;
+}
+
+/** Return the center of the box that contains the point 'p' assuming
+    that the center for the central box is located at the origin */
+Vector TriclinicBox::getBoxCenter(const Vector &p) const
+{
+    return wrapDelta( Vector(0), p );
+}
+
+/** Return the center of the box that contains the point 'p' assuming
+    that the center for the central box is located at 'center' */
+Vector TriclinicBox::getBoxCenter(const Vector &p, const Vector &center) const
+{
+    return center + wrapDelta( center, p );
+}
+
+const char* TriclinicBox::typeName()
+{
+    return QMetaType::typeName( qMetaTypeId<TriclinicBox>() );
+}
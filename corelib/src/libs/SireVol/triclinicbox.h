@@ -0,0 +1,230 @@
+/********************************************\
+  *
+  *  Sire - Molecular Simulation Framework
+  *
+  *  Copyright (C) 2015  Christopher Woods
+  *
+  *  This program is free software; you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation; either version 2 of the License, or
+  *  (at your option) any later version.
+  *
+  *  This program is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with this program; if not, write to the Free Software
+  *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+  *
+  *  For full details of the license please see the COPYING file
+  *  that should have come with this distribution.
+  *
+  *  You can contact the authors via the developer's mailing list
+  *  at http://siremol.org
+  *
+\*********************************************/
+
+#ifndef SIREVOL_TRICLINICBOX_H
+#define SIREVOL_TRICLINICBOX_H
+
+#include "cartesian.h"
+
+#include "SireMaths/vector.h"
+
+SIRE_BEGIN_HEADER
+
+namespace SireVol
+{
+class TriclinicBox;
+}
+
+QDataStream& operator<<(QDataStream&, const SireVol::TriclinicBox&);
+QDataStream& operator>>(QDataStream&, SireVol::TriclinicBox&);
+
+namespace SireVol
+{
+
+using SireMaths::Vector;
+
+/**
+A TriclinicBox is a volume that represents periodic boundary conditions
+using a general (triclinic) unit cell, defined by three lattice vectors.
+This can represent any periodic space, including the truncated octahedron
+and rhombic dodecahedron, which need far less solvent to surround
+a globular solute than a cubic box of the same minimum image distance.
+
+The lattice vectors are reduced on construction (by adding integer
+multiples of the vectors to each other) so that they are as short
+and as orthogonal as possible. This does not change the lattice,
+but means that the minimum image of a point is always one
+of the 27 images around its nearest fractional-coordinate image.
+
+@author Christopher Woods
+*/
+class SIREVOL_EXPORT TriclinicBox
+        : public SireBase::ConcreteProperty<TriclinicBox,Cartesian>
+{
+
+friend QDataStream& ::operator<<(QDataStream&, const TriclinicBox&);
+friend QDataStream& ::operator>>(QDataStream&, TriclinicBox&);
+
+public:
+    TriclinicBox();
+    TriclinicBox(const Vector &v0, const Vector &v1, const Vector &v2);
+    TriclinicBox(double a, double b, double c,
+                 const SireUnits::Dimension::Angle &alpha,
+                 const SireUnits::Dimension::Angle &beta,
+                 const SireUnits::Dimension::Angle &gamma);
+
+    TriclinicBox(const TriclinicBox &other);
+
+    ~TriclinicBox();
+
+    TriclinicBox& operator=(const TriclinicBox &other);
+
+    bool operator==(const TriclinicBox &other) const;
+    bool operator!=(const TriclinicBox &other) const;
+
+    static TriclinicBox cubic(double d);
+    static TriclinicBox truncatedOctahedron(double d);
+    static TriclinicBox rhombicDodecahedronSquare(double d);
+    static TriclinicBox rhombicDodecahedronHexagon(double d);
+
+    bool isPeriodic() const;
+    bool isCartesian() const;
+
+    QString toString() const;
+
+    SireUnits::Dimension::Volume volume() const;
+    SpacePtr setVolume(SireUnits::Dimension::Volume volume) const;
+
+    const Vector& vector0() const;
+    const Vector& vector1() const;
+    const Vector& vector2() const;
+
+    double minimumImageDistance() const;
+
+    Vector minCoords(const Vector &center = Vector(0)) const;
+    Vector maxCoords(const Vector &center = Vector(0)) const;
+
+    static const char* typeName();
+
+    double calcDist(const Vector &point0, const Vector &point1) const;
+    double calcDist2(const Vector &point0, const Vector &point1) const;
+
+    double calcDist(const CoordGroup &group1, const CoordGroup &group2,
+                    DistMatrix &distmat) const;
+
+    double calcDist(const CoordGroup &group, const Vector &point,
+                    DistMatrix &mat) const;
+
+    double calcDist2(const CoordGroup &group, const Vector &point,
+                     DistMatrix &mat) const;
+
+    double calcDist2(const CoordGroup &group1, const CoordGroup &group2,
+                     DistMatrix &distmat) const;
+
+    double calcInvDist(const CoordGroup &group1, const CoordGroup &group2,
+                       DistMatrix &distmat) const;
+
+    double calcInvDist2(const CoordGroup &group1, const CoordGroup &group2,
+                        DistMatrix &distmat) const;
+
+    DistVector calcDistVector(const Vector &point0, const Vector &point1) const;
+
+    double calcDistVectors(const CoordGroup &group1, const CoordGroup &group2,
+                           DistVectorMatrix &distmat) const;
+
+    double calcDistVectors(const CoordGroup &group, const Vector &point,
+                           DistVectorMatrix &distmat) const;
+
+    SireUnits::Dimension::Angle calcAngle(const Vector &point0,
+                                          const Vector &point1,
+                                          const Vector &point2) const;
+
+    SireUnits::Dimension::Angle calcDihedral(const Vector &point0,
+                                             const Vector &point1,
+                                             const Vector &point2,
+                                             const Vector &point3) const;
+
+    bool beyond(double dist, const AABox &aabox0, const AABox &aabox1) const;
+
+    bool beyond(double dist, const CoordGroup &group0,
+                const CoordGroup &group1) const;
+
+    double minimumDistance(const CoordGroup &group0, const CoordGroup &group1) const;
+
+    double minimumDistance(const AABox &box0, const AABox &box1) const;
+
+    Vector getRandomPoint(const Vector &center, const RanGenerator &generator) const;
+
+    Vector getBoxCenter(const Vector &p) const;
+    Vector getBoxCenter(const Vector &p, const Vector &center) const;
+
+    CoordGroup getMinimumImage(const CoordGroup &group, const Vector &center) const;
+
+    CoordGroupArray getMinimumImage(const CoordGroupArray &groups,
+                                    const Vector &center,
+                                    bool translate_as_one=false) const;
+
+    AABox getMinimumImage(const AABox &aabox, const Vector &center) const;
+
+    Vector getMinimumImage(const Vector &point, const Vector &center) const;
+
+    QVector<Vector> getImagesWithin(const Vector &point, const Vector &center,
+                                    double dist) const;
+
+    QList< boost::tuple<double,CoordGroup> >
+               getCopiesWithin(const CoordGroup &group,
+                               const CoordGroup &center, double dist) const;
+
+protected:
+    Vector wrapDelta(const Vector &v0, const Vector &v1) const;
+
+    Vector lattice(int i, int j, int k) const;
+
+private:
+    void setVectors(const Vector &v0, const Vector &v1, const Vector &v2);
+
+    /** The three (reduced) lattice vectors of the box */
+    Vector vec0, vec1, vec2;
+
+    /** The reciprocal vectors, used to convert a cartesian
+        vector into fractional coordinates */
+    Vector rec0, rec1, rec2;
+
+    /** The perpendicular distance between opposite faces of
+        the unit cell, along each lattice vector */
+    Vector face_dist;
+
+    /** The half-extents of the axis-aligned box that encloses
+        the Wigner-Seitz cell (the region of space closer to the
+        origin than to any of its periodic images) */
+    Vector cell_extents;
+
+    /** Half of the shortest lattice vector. Any vector shorter than
+        this is guaranteed to be a minimum image */
+    double half_min_length;
+};
+
+#ifndef SIRE_SKIP_INLINE_FUNCTIONS
+
+/** Return the lattice vector i*vector0 + j*vector1 + k*vector2 */
+inline Vector TriclinicBox::lattice(int i, int j, int k) const
+{
+    return double(i)*vec0 + double(j)*vec1 + double(k)*vec2;
+}
+
+#endif // SIRE_SKIP_INLINE_FUNCTIONS
+
+}
+
+Q_DECLARE_METATYPE(SireVol::TriclinicBox)
+
+SIRE_EXPOSE_CLASS( SireVol::TriclinicBox )
+
+SIRE_END_HEADER
+
+#endif
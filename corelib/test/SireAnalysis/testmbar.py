@@ -0,0 +1,90 @@
+
+import math
+import random
+
+from Sire.Analysis import *
+from Sire.Stream import *
+from Sire.Units import *
+
+# harmonic oscillators with (reduced) force constants 'ks', sampling
+# all but the last state. The exact free energy of state k relative
+# to state 0 is 0.5 ln(k / k0)
+ks = [1.0, 2.0, 4.0, 8.0]
+lamvals = [0.0, 0.25, 0.5, 1.0]
+nsamples = [5000, 5000, 5000, 0]
+
+temperature = 25 * celsius
+kt = k_boltz * temperature.value()
+
+def _create_mbar(max_memory=None):
+    rand = random.Random(42)
+
+    mbar = MBAR(lamvals, temperature)
+
+    if max_memory is not None:
+        mbar.setMaximumMemory(max_memory)
+
+    for i in range(0, len(ks)):
+        for j in range(0, nsamples[i]):
+            x = rand.gauss(0, 1.0 / math.sqrt(ks[i]))
+            mbar.add( lamvals[i], [ kt * 0.5 * k * x * x for k in ks ] )
+
+    return mbar
+
+def test_mbar(verbose=False):
+    mbar = _create_mbar()
+
+    assert( mbar.nSamples() == sum(nsamples) )
+
+    points = mbar.pmf().values()
+
+    for i in range(0, len(ks)):
+        exact = kt * 0.5 * math.log(ks[i] / ks[0])
+
+        if verbose:
+            print("%s : %s +/- %s  (exact %s)" % (lamvals[i], points[i].y(),
+                                                   points[i].yError(), exact))
+
+        assert( abs(points[i].y() - exact) < 4 * points[i].yError() + 0.001 )
+
+    if verbose:
+        print(mbar.overlapMatrix())
+
+def test_spooled(verbose=False):
+    points = _create_mbar().pmf().values()
+
+    mbar = _create_mbar(0)
+    spooled = mbar.pmf().values()
+
+    for i in range(0, len(ks)):
+        if verbose:
+            print("%s : %s vs. %s" % (lamvals[i], points[i].y(), spooled[i].y()))
+
+        assert( points[i].y() == spooled[i].y() )
+
+    mbar2 = load( save(mbar) )
+
+    assert( mbar2 == mbar )
+
+def test_not_converged(verbose=False):
+    mbar = _create_mbar()
+    mbar.setTolerance(1e-12)
+    mbar.setMaximumIterations(1)
+
+    # failing to converge must raise an error, not return a wrong PMF
+    try:
+        mbar.pmf()
+        converged = True
+    except UserWarning as error:
+        if verbose:
+            print("Not converged (expected): %s" % error)
+
+        assert( "SireMaths::math_error" in str(error) )
+        converged = False
+
+    assert( not converged )
+
+if __name__ == "__main__":
+    test_mbar(True)
+    test_spooled(True)
+    test_not_converged(True)
@@ -0,0 +1,59 @@
+
+import json
+
+from Sire.Base import *
+from Sire.IO import *
+from Sire.MM import *
+from Sire.Mol import *
+from Sire.System import *
+
+amber = Amber()
+
+(molecules, space) = amber.readCrdTop("test/io/waterbox.crd", "test/io/waterbox.top")
+
+waters = MoleculeGroup("waters")
+
+for molnum in molecules.molNums()[0:50]:
+    waters.add(molecules[molnum].molecule())
+
+def test_profiler(verbose=False):
+    cljff = InterCLJFF("cljff")
+    cljff.add(waters)
+
+    system = System()
+    system.add(waters)
+    system.add(cljff)
+    system.setProperty("space", space)
+
+    Profiler.clear()
+    Profiler.setTracing(True)
+
+    try:
+        nrg = system.energy()
+    finally:
+        Profiler.setTracing(False)
+
+    if verbose:
+        print(Profiler.report())
+
+    name = "SireFF::ForceFields::energy"
+
+    assert( name in Profiler.timerNames() )
+    assert( Profiler.nCalls(name) == 1 )
+    assert( Profiler.totalTime(name) >= 0 )
+
+    nested = [ timer for timer in Profiler.timerNames() if timer.startswith(name + "/") ]
+
+    assert( len(nested) > 0 )
+
+    for timer in nested:
+        assert( Profiler.totalTime(timer) <= Profiler.totalTime(name) )
+
+    report = json.loads( Profiler.toJSON() )
+    trace = json.loads( Profiler.toChromeTrace() )
+
+    assert( "timers" in report )
+    assert( len(trace["traceEvents"]) > 0 )
+
+if __name__ == "__main__":
+    test_profiler(True)
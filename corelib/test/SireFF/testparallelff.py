@@ -0,0 +1,101 @@
+
+from Sire.IO import *
+from Sire.MM import *
+from Sire.FF import *
+from Sire.Mol import *
+from Sire.Maths import *
+from Sire.CAS import *
+from Sire.System import *
+from Sire.Units import *
+
+from nose.tools import assert_almost_equal
+
+(waters, space) = Amber().readCrdTop("test/io/waterbox.crd", "test/io/waterbox.top")
+
+lam = Symbol("lambda")
+
+def _createSystem():
+    interff = InterFF("interff")
+    interff.add(waters)
+
+    intraff = IntraFF("intraff")
+    intraff.add(waters)
+
+    internalff = InternalFF("internalff")
+    internalff.add(waters)
+
+    system = System()
+    system.add(interff)
+    system.add(intraff)
+    system.add(internalff)
+    system.add(waters)
+    system.setProperty("space", space)
+
+    system.setConstant(lam, 0.5)
+    system.setComponent( Symbol("e_scaled"),
+                         lam * interff.components().total() + intraff.components().total() )
+
+    return system
+
+def test_energies(verbose=False):
+    serial = _createSystem()
+    parallel = _createSystem()
+    parallel.enableParallelCalculation()
+
+    assert( not serial.usesParallelCalculation() )
+    assert( parallel.usesParallelCalculation() )
+
+    serial_nrgs = serial.energies()
+    parallel_nrgs = parallel.energies()
+
+    for symbol in serial_nrgs.keys():
+        if verbose:
+            print("%s : %s  %s" % (symbol, serial_nrgs[symbol], parallel_nrgs[symbol]))
+
+        assert_almost_equal( serial_nrgs[symbol], parallel_nrgs[symbol], 8 )
+
+    # move a molecule and check that the energies still agree
+    mol = waters.moleculeAt(0).molecule()
+    mol = mol.move().translate( Vector(0.5,0,0) ).commit()
+
+    serial.update(mol)
+    parallel.update(mol)
+
+    e_scaled = Symbol("e_scaled")
+
+    if verbose:
+        print("After move: %s  %s" % (serial.energy(e_scaled), parallel.energy(e_scaled)))
+
+    assert_almost_equal( serial.energy(e_scaled).value(),
+                         parallel.energy(e_scaled).value(), 8 )
+
+    assert_almost_equal( serial.energy().value(), parallel.energy().value(), 8 )
+
+def test_forces(verbose=False):
+    serial = _createSystem()
+    parallel = _createSystem()
+    parallel.enableParallelCalculation()
+
+    for component in [ serial.totalComponent(), Symbol("e_scaled") ]:
+        serial_forces = ForceTable(waters)
+        parallel_forces = ForceTable(waters)
+
+        serial.force(serial_forces, component)
+        parallel.force(parallel_forces, component)
+
+        for molnum in waters.molNums():
+            s = serial_forces.getTable(molnum).toVector()
+            p = parallel_forces.getTable(molnum).toVector()
+
+            for i in range(0, len(s)):
+                for j in range(0,3):
+                    assert_almost_equal( s[i][j], p[i][j], 5 )
+
+        if verbose:
+            molnum = waters.molNums()[0]
+            print("%s : %s  %s" % (component, serial_forces.getTable(molnum).toVector()[0],
+                                   parallel_forces.getTable(molnum).toVector()[0]))
+
+if __name__ == "__main__":
+    test_energies(True)
+    test_forces(True)
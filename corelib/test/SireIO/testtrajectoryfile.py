@@ -0,0 +1,117 @@
+
+from Sire.IO import *
+from Sire.Mol import *
+from Sire.Vol import *
+from Sire.Maths import *
+
+import os
+import struct
+import tempfile
+
+(waters, space) = Amber().readCrdTop("test/io/waterbox.crd", "test/io/waterbox.top")
+
+def _get_coords(molgroup):
+    coords = []
+
+    for molnum in molgroup.molNums():
+        mol = molgroup[molnum].molecule()
+
+        for i in range(0, mol.nAtoms()):
+            coords.append( mol.atom(AtomIdx(i)).property("coordinates") )
+
+    return coords
+
+def test_roundtrip(verbose=False):
+    (fd, filename) = tempfile.mkstemp(suffix=".trj")
+    os.close(fd)
+
+    try:
+        writer = TrajectoryWriter(filename, 0.001)
+        writer.write(waters, space)
+
+        # move all of the waters and write a second frame
+        moved = MoleculeGroup(waters)
+
+        for molnum in moved.molNums():
+            mol = moved[molnum].molecule()
+            mol = mol.move().translate( Vector(1.5,-2.0,0.25) ).commit()
+            moved.update(mol)
+
+        writer.write(moved)
+        writer.close()
+
+        reader = TrajectoryReader(filename)
+
+        if verbose:
+            print(reader)
+            print("File size = %d bytes" % os.path.getsize(filename))
+
+        assert( reader.nFrames() == 2 )
+        assert( reader.nAtoms() == waters.nAtoms() )
+
+        assert( reader.hasSpace(0) )
+        assert( not reader.hasSpace(1) )
+
+        box = reader.space(0)
+        assert( abs(box.volume().value() - space.volume().value()) < 0.01 )
+
+        for (frame, group) in [(0, waters), (1, moved)]:
+            old_coords = _get_coords(group)
+            new_coords = _get_coords( reader.frame(frame, waters) )
+
+            assert( len(old_coords) == len(new_coords) )
+
+            for i in range(0, len(old_coords)):
+                assert( (old_coords[i] - new_coords[i]).length() < 0.001 )
+
+        # appending to the file should preserve the existing frames
+        writer = TrajectoryWriter(filename)
+        writer.write(waters, space)
+        writer.close()
+
+        reader = TrajectoryReader(filename)
+        assert( reader.nFrames() == 3 )
+    finally:
+        os.remove(filename)
+
+def test_corrupt_index(verbose=False):
+    (fd, filename) = tempfile.mkstemp(suffix=".trj")
+    os.close(fd)
+
+    try:
+        writer = TrajectoryWriter(filename, 0.001)
+        writer.write(waters, space)
+        writer.write(waters)
+        writer.close()
+
+        # overwrite the offset of the last frame in the index (which is
+        # just before the 16 byte trailer) with an invalid offset
+        size = os.path.getsize(filename)
+
+        with open(filename, "r+b") as f:
+            f.seek(size - 16 - 8)
+            f.write( struct.pack("<Q", 3) )
+
+        # the reader must ignore the index and scan the frames instead
+        reader = TrajectoryReader(filename)
+
+        if verbose:
+            print(reader)
+
+        assert( reader.nFrames() == 2 )
+
+        old_coords = _get_coords(waters)
+
+        for frame in range(0, 2):
+            new_coords = _get_coords( reader.frame(frame, waters) )
+
+            assert( len(old_coords) == len(new_coords) )
+
+            for i in range(0, len(old_coords)):
+                assert( (old_coords[i] - new_coords[i]).length() < 0.001 )
+    finally:
+        os.remove(filename)
+
+if __name__ == "__main__":
+    test_roundtrip(True)
+    test_corrupt_index(True)
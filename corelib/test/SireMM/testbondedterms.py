@@ -0,0 +1,207 @@
+from Sire.IO import *
+from Sire.MM import *
+from Sire.FF import *
+from Sire.Mol import *
+from Sire.CAS import *
+from Sire.Maths import *
+from Sire.Units import *
+
+from nose.tools import assert_equal, assert_almost_equal
+
+import math
+
+(molecules, space) = Amber().readCrdTop("test/io/SYSTEM.crd", "test/io/SYSTEM.top")
+
+solute = molecules.molecule(molecules.molNums()[0]).molecule()
+
+# the reference energies below only include bonds, angles and dihedrals
+if solute.hasProperty("improper"):
+    solute = solute.edit().removeProperty("improper").commit()
+
+internalff = InternalFF("internal")
+
+r = internalff.symbols().bond().r()
+theta = internalff.symbols().angle().theta()
+phi = internalff.symbols().dihedral().phi()
+
+# Ryckaert-Bellemans coefficients (kcal mol-1) of an alkane dihedral
+rb_coeffs = [ 2.2175, 2.9053, -3.1365, -0.7313, 0.0, 0.0 ]
+
+def _rb(coeffs, x=phi):
+    cospsi = Cos(x - math.pi)
+
+    f = coeffs[0] + coeffs[1]*cospsi
+
+    for i in range(2, len(coeffs)):
+        if coeffs[i] != 0:
+            f = f + coeffs[i] * (cospsi**i)
+
+    return f
+
+def _with_rb_dihedrals(mol):
+    dihedrals = FourAtomFunctions(mol)
+
+    for dihedral in mol.property("dihedral").potentials():
+        dihedrals.set( dihedral.atom0(), dihedral.atom1(),
+                       dihedral.atom2(), dihedral.atom3(), _rb(rb_coeffs) )
+
+    return mol.edit().setProperty("dihedral", dihedrals).commit()
+
+def _value(f, symbol, x):
+    vals = Values()
+    vals.set(symbol, x)
+    return f.evaluate(vals)
+
+def _coords(mol, atom):
+    return mol.atom(atom).property("coordinates")
+
+def _reference_energies(mol):
+    """Return the bond, angle and dihedral energies of 'mol' calculated
+       by evaluating each symbolic function directly"""
+    bndnrg = 0
+    angnrg = 0
+    dihnrg = 0
+
+    for bond in mol.property("bond").potentials():
+        x = Vector.distance( _coords(mol, bond.atom0()), _coords(mol, bond.atom1()) )
+        bndnrg += _value(bond.function(), r, x)
+
+    for angle in mol.property("angle").potentials():
+        x = Vector.angle( _coords(mol, angle.atom0()), _coords(mol, angle.atom1()),
+                          _coords(mol, angle.atom2()) ).value()
+        angnrg += _value(angle.function(), theta, x)
+
+    for dihedral in mol.property("dihedral").potentials():
+        x = Vector.dihedral( _coords(mol, dihedral.atom0()), _coords(mol, dihedral.atom1()),
+                             _coords(mol, dihedral.atom2()), _coords(mol, dihedral.atom3()) ).value()
+        dihnrg += _value(dihedral.function(), phi, x)
+
+    return (bndnrg, angnrg, dihnrg)
+
+def test_classification(verbose=False):
+    terms = BondedTerms()
+
+    funcs = [ (100 * (r - 1.5)**2, BondedTerms.HARMONIC),
+              (5 + 2*r - 3*r**2 + 0.5*r**4, BondedTerms.POLYNOMIAL),
+              (2 * (1 + Cos(3*r - 0.5)) + 0.7 * Sin(2*r), BondedTerms.COSINE_SERIES),
+              (_rb(rb_coeffs, r), BondedTerms.COSINE_POWER_SERIES),
+              (Exp(r) * r, BondedTerms.UNRECOGNISED) ]
+
+    for (f, form) in funcs:
+        i = terms.add(f, [r])
+
+        if verbose:
+            print("%s : %s (expected %s)" % (f, terms.form(i), form))
+
+        assert_equal( terms.form(i), form )
+
+    assert_equal( terms.count(), len(funcs) )
+    assert_equal( terms.nRecognised(), len(funcs) - 1 )
+
+    for form in [BondedTerms.HARMONIC, BondedTerms.POLYNOMIAL,
+                 BondedTerms.COSINE_SERIES, BondedTerms.COSINE_POWER_SERIES]:
+        assert_equal( terms.nRecognised(form), 1 )
+
+    # all of the terms are evaluated together, and must agree with
+    # the symbolic functions (the unrecognised term evaluates to zero)
+    for x in [0.3, 0.9, 1.5, 2.2, 3.1]:
+        values = terms.evaluate( [x] * terms.count() )
+
+        for i in range(0, terms.count()):
+            if terms.isRecognised(i):
+                expect = _value(funcs[i][0], r, x)
+            else:
+                expect = 0.0
+
+            if verbose:
+                print("%s : %s  %s" % (x, values[i], expect))
+
+            assert_almost_equal( values[i], expect, 8 )
+
+def test_solute_classification(verbose=False):
+    rb_solute = _with_rb_dihedrals(solute)
+
+    for (prop, symbol, form) in [ ("bond", r, BondedTerms.HARMONIC),
+                                  ("angle", theta, BondedTerms.HARMONIC),
+                                  ("dihedral", phi, BondedTerms.COSINE_SERIES) ]:
+        terms = BondedTerms()
+
+        for potential in solute.property(prop).potentials():
+            terms.add(potential.function(), [symbol])
+
+        if verbose:
+            print("%s : %s" % (prop, terms))
+
+        assert( terms.count() > 0 )
+        assert_equal( terms.nRecognised(form), terms.count() )
+
+    terms = BondedTerms()
+
+    for potential in rb_solute.property("dihedral").potentials():
+        terms.add(potential.function(), [phi])
+
+    if verbose:
+        print("RB dihedral : %s" % terms)
+
+    assert_equal( terms.nRecognised(BondedTerms.COSINE_POWER_SERIES), terms.count() )
+
+def _test_energies_and_forces(mol, verbose):
+    ff = InternalFF("internal")
+    ff.add(mol)
+
+    (bndnrg, angnrg, dihnrg) = _reference_energies(mol)
+
+    ff_bndnrg = ff.energy( ff.components().bond() ).value()
+    ff_angnrg = ff.energy( ff.components().angle() ).value()
+    ff_dihnrg = ff.energy( ff.components().dihedral() ).value()
+
+    if verbose:
+        print("Bond %s versus %s" % (ff_bndnrg, bndnrg))
+        print("Angle %s versus %s" % (ff_angnrg, angnrg))
+        print("Dihedral %s versus %s" % (ff_dihnrg, dihnrg))
+
+    assert_almost_equal( ff_bndnrg, bndnrg, 6 )
+    assert_almost_equal( ff_angnrg, angnrg, 6 )
+    assert_almost_equal( ff_dihnrg, dihnrg, 6 )
+
+    # compare the forces against a finite difference of the symbolic energies
+    group = MoleculeGroup("solute", mol)
+    forcetable = ForceTable(group)
+    ff.force(forcetable)
+
+    forces = forcetable.getTable(mol.number()).toVector()
+
+    delta = 1e-4
+
+    for i in range(0, min(8, mol.nAtoms())):
+        coords = mol.atom(AtomIdx(i)).property("coordinates")
+
+        for j in range(0, 3):
+            d = [0.0, 0.0, 0.0]
+            d[j] = delta
+            d = Vector(d[0], d[1], d[2])
+
+            plus = mol.edit().atom(AtomIdx(i)).setProperty("coordinates",
+                                          coords + d).molecule().commit()
+            minus = mol.edit().atom(AtomIdx(i)).setProperty("coordinates",
+                                          coords - d).molecule().commit()
+
+            fd_force = -( sum(_reference_energies(plus)) -
+                          sum(_reference_energies(minus)) ) / (2*delta)
+
+            if verbose:
+                print("%d %d : %s  %s" % (i, j, forces[i][j], fd_force))
+
+            assert( abs(forces[i][j] - fd_force) < 1e-4 * max(1.0, abs(fd_force)) )
+
+def test_amber_energies_and_forces(verbose=False):
+    _test_energies_and_forces(solute, verbose)
+
+def test_rb_energies_and_forces(verbose=False):
+    _test_energies_and_forces(_with_rb_dihedrals(solute), verbose)
+
+if __name__ == "__main__":
+    test_classification(True)
+    test_solute_classification(True)
+    test_amber_energies_and_forces(True)
+    test_rb_energies_and_forces(True)
@@ -0,0 +1,90 @@
+
+from Sire.IO import *
+from Sire.MM import *
+from Sire.FF import *
+from Sire.Mol import *
+from Sire.Maths import *
+from Sire.Vol import *
+from Sire.Units import *
+
+from nose.tools import assert_almost_equal
+
+(waters, space) = Amber().readCrdTop("test/io/waterbox.crd", "test/io/waterbox.top")
+
+delta = 0.001
+
+def _getEnergy(ff):
+    return ff.energy().value()
+
+def _test_force(cljfunc, verbose=False):
+    interff = InterFF("interff")
+    interff.setCLJFunction(cljfunc)
+    interff.add(waters)
+
+    forcetable = ForceTable(waters)
+
+    interff.energy()
+    interff.force(forcetable)
+
+    #the forces should obey Newton's third law
+    total = Vector(0)
+
+    for molnum in waters.molNums():
+        for force in forcetable.getTable(molnum).toVector():
+            total += force
+
+    if verbose:
+        print("Total force = %s" % total)
+
+    assert_almost_equal( total.length(), 0.0, 2 )
+
+    #compare the force on the first atom against a finite difference of the energy
+    mol = waters.moleculeAt(0).molecule()
+    molnum = mol.number()
+    force = forcetable.getTable(molnum).toVector()[0]
+
+    coords = mol.atom(AtomIdx(0)).property("coordinates")
+
+    for i in range(0,3):
+        d = [0.0, 0.0, 0.0]
+        d[i] = delta
+
+        plus = mol.edit().atom(AtomIdx(0)).setProperty("coordinates",
+                                      coords + Vector(d[0],d[1],d[2])).molecule().commit()
+        interff.update(plus)
+        nrg_plus = _getEnergy(interff)
+
+        minus = mol.edit().atom(AtomIdx(0)).setProperty("coordinates",
+                                       coords - Vector(d[0],d[1],d[2])).molecule().commit()
+        interff.update(minus)
+        nrg_minus = _getEnergy(interff)
+
+        interff.update(mol)
+        interff.accept()
+
+        fd_force = -(nrg_plus - nrg_minus) / (2*delta)
+
+        if verbose:
+            print("%d : %s  %s" % (i, force[i], fd_force))
+
+        assert_almost_equal( force[i], fd_force, 1 )
+
+def test_shift_force(verbose=False):
+    cljfunc = CLJShiftFunction(15*angstrom)
+    cljfunc.setSpace(space)
+    _test_force(cljfunc, verbose)
+
+def test_rf_force(verbose=False):
+    cljfunc = CLJRFFunction(15*angstrom)
+    cljfunc.setSpace(space)
+    _test_force(cljfunc, verbose)
+
+def test_ewald_force(verbose=False):
+    cljfunc = CLJEwaldFunction(15*angstrom)
+    cljfunc.setSpace(space)
+    _test_force(cljfunc, verbose)
+
+if __name__ == "__main__":
+    test_shift_force(True)
+    test_rf_force(True)
+    test_ewald_force(True)
@@ -0,0 +1,172 @@
+
+import os
+import shutil
+import struct
+import tempfile
+
+from Sire.IO import *
+from Sire.MM import *
+from Sire.Mol import *
+from Sire.Maths import *
+from Sire.Units import *
+from Sire.Vol import *
+
+from nose.tools import assert_equal
+
+coul_cutoff = 20 * angstrom
+lj_cutoff = 10 * angstrom
+
+amber = Amber()
+
+(molecules, space) = amber.readCrdTop("test/io/waterbox.crd", "test/io/waterbox.top")
+
+swapwaters = MoleculeGroup("swapwaters")
+waters = MoleculeGroup("waters")
+
+molnums = molecules.molNums()
+
+for molnum in molnums:
+    water = molecules[molnum].molecule()
+
+    if water.residue().number() == ResNum(2025):
+        center_water = water
+
+swapwaters.add(center_water)
+
+center_point = center_water.evaluate().center()
+
+for molnum in molnums:
+    if molnum != center_water.number():
+        water = molecules[molnum].molecule()
+
+        if Vector.distance(center_point, water.evaluate().center()) < 7.5:
+            swapwaters.add(water)
+        else:
+            waters.add(water)
+
+def _calculate(combining_rules, use_grid, use_lj_grid=False, use_tricubic=False):
+    func = CLJShiftFunction(coul_cutoff, lj_cutoff)
+    func.setCombiningRules(combining_rules)
+
+    grid = CLJGrid()
+    grid.setCLJFunction(func)
+    grid.setFixedAtoms( CLJAtoms(waters.molecules()) )
+
+    cljatoms = CLJAtoms(swapwaters.molecules())
+    grid.setGridDimensions( cljatoms, 0.5 * angstrom, 2 * angstrom )
+
+    grid.setUseGrid(use_grid)
+    grid.setUseLJGrid(use_lj_grid)
+    grid.setUseTricubicInterpolation(use_tricubic)
+
+    return grid.calculate( CLJBoxes(cljatoms) )
+
+def _test_ljgrid(combining_rules, verbose):
+    (cnrg, ljnrg) = _calculate(combining_rules, False)
+
+    if verbose:
+        print("Explicit: %s  %s" % (cnrg, ljnrg))
+
+    for use_tricubic in [False, True]:
+        (gcnrg, gljnrg) = _calculate(combining_rules, True, True, use_tricubic)
+
+        if verbose:
+            print("LJ grid (tricubic == %s): %s  %s" % (use_tricubic, gcnrg, gljnrg))
+
+        assert( abs(gcnrg - cnrg) < 0.05 * abs(cnrg) + 1.0 )
+        assert( abs(gljnrg - ljnrg) < 0.05 * abs(ljnrg) + 1.0 )
+
+def test_geometric_ljgrid(verbose=False):
+    _test_ljgrid(CLJFunction.GEOMETRIC, verbose)
+
+def test_arithmetic_ljgrid(verbose=False):
+    _test_ljgrid(CLJFunction.ARITHMETIC, verbose)
+
+def _cached_grids(cachedir):
+    """Return the keys of all of the grids saved in 'cachedir'"""
+    return [ f[:-5] for f in os.listdir(cachedir) if f.endswith(".grid") ]
+
+def _zero_cached_grid(cachedir, key):
+    """Overwrite the values of the cached grid 'key' with zeroes, keeping
+       the header. The number of values is the 64 bit integer at byte 16"""
+    filename = os.path.join(cachedir, "%s.grid" % key)
+
+    with open(filename, "r+b") as f:
+        data = f.read()
+        nvalues = struct.unpack("q", data[16:24])[0]
+        f.seek( len(data) - 4*nvalues )
+        f.write( struct.pack("%df" % nvalues, *([0.0]*nvalues)) )
+
+def test_grid_cache(verbose=False):
+    cachedir = tempfile.mkdtemp()
+
+    try:
+        CLJGridCache.setCacheDirectory(cachedir)
+        assert( CLJGridCache.isEnabled() )
+
+        for use_lj_grid in [False, True]:
+            CLJGridCache.clear()
+            assert_equal( len(_cached_grids(cachedir)), 0 )
+
+            (cnrg, ljnrg) = _calculate(CLJFunction.ARITHMETIC, True, use_lj_grid)
+
+            # building the grid must have saved it to the cache (the
+            # coulomb grid, plus a repulsion and dispersion grid for
+            # each LJ type if the LJ grid is used)
+            keys = _cached_grids(cachedir)
+
+            if verbose:
+                print("Cached grids: %s" % keys)
+
+            if use_lj_grid:
+                assert( len(keys) >= 3 )
+            else:
+                assert_equal( len(keys), 1 )
+
+            for key in keys:
+                assert( CLJGridCache.contains(key) )
+
+            # a second grid must load the same values from the cache
+            (ccnrg, cljnrg) = _calculate(CLJFunction.ARITHMETIC, True, use_lj_grid)
+
+            if verbose:
+                print("Calculated: %s  %s" % (cnrg, ljnrg))
+                print("Cached:     %s  %s" % (ccnrg, cljnrg))
+
+            assert( abs(ccnrg - cnrg) < 1e-6 )
+            assert( abs(cljnrg - ljnrg) < 1e-6 )
+            assert_equal( sorted(_cached_grids(cachedir)), sorted(keys) )
+
+            # zero the cached grids - a grid that loads from the cache
+            # now misses the energy of the far atoms, while a grid that
+            # was rebuilt would not
+            for key in keys:
+                _zero_cached_grid(cachedir, key)
+
+            (zcnrg, zljnrg) = _calculate(CLJFunction.ARITHMETIC, True, use_lj_grid)
+
+            if verbose:
+                print("Zeroed:     %s  %s" % (zcnrg, zljnrg))
+
+            assert( abs(zcnrg - cnrg) > 1e-3 )
+
+            if use_lj_grid:
+                assert( abs(zljnrg - ljnrg) > 1e-3 )
+
+            # clearing the cache forces the grids to be rebuilt
+            CLJGridCache.clear()
+
+            (rcnrg, rljnrg) = _calculate(CLJFunction.ARITHMETIC, True, use_lj_grid)
+
+            assert( abs(rcnrg - cnrg) < 1e-6 )
+            assert( abs(rljnrg - ljnrg) < 1e-6 )
+    finally:
+        CLJGridCache.disable()
+        shutil.rmtree(cachedir)
+
+    assert( not CLJGridCache.isEnabled() )
+
+if __name__ == "__main__":
+    test_geometric_ljgrid(True)
+    test_arithmetic_ljgrid(True)
+    test_grid_cache(True)
@@ -0,0 +1,82 @@
+from Sire.IO import *
+from Sire.MM import *
+from Sire.Mol import *
+from Sire.Maths import *
+from Sire.Vol import *
+from Sire.Units import *
+
+from nose.tools import assert_almost_equal
+
+(waters, space) = Amber().readCrdTop("test/io/waterbox.crd", "test/io/waterbox.top")
+
+dimensions = space.dimensions()
+
+# the cutoff must be less than half of the minimum image distance
+cutoff = min( 10.0, 0.45 * min(dimensions.x(), dimensions.y(), dimensions.z()) )
+
+def _atoms(shift_first=Vector(0)):
+    group = MoleculeGroup("waters")
+
+    for molnum in waters.molNums():
+        mol = waters[molnum].molecule()
+
+        if group.nMolecules() == 0:
+            mol = mol.move().translate(shift_first).commit()
+
+        group.add(mol)
+
+    return CLJAtoms(group.molecules())
+
+def _energies(space, atoms):
+    func = CLJShiftFunction(cutoff*angstrom)
+    func.setSpace(space)
+
+    (cnrg, ljnrg) = func.calculate(atoms)
+    (bcnrg, bljnrg) = func.calculate( CLJBoxes(atoms) )
+    (ccnrg, cljnrg) = CLJCalculator().calculate(func, CLJBoxes(atoms))
+
+    assert_almost_equal( cnrg, bcnrg, 2 )
+    assert_almost_equal( ljnrg, bljnrg, 2 )
+    assert_almost_equal( cnrg, ccnrg, 2 )
+    assert_almost_equal( ljnrg, cljnrg, 2 )
+
+    return (cnrg, ljnrg)
+
+def test_orthorhombic(verbose=False):
+    # a triclinic box with orthogonal lattice vectors must give
+    # the same energy as the equivalent PeriodicBox
+    tric = TriclinicBox( Vector(dimensions.x(),0,0), Vector(0,dimensions.y(),0),
+                         Vector(0,0,dimensions.z()) )
+
+    atoms = _atoms()
+
+    (cnrg, ljnrg) = _energies(space, atoms)
+    (tcnrg, tljnrg) = _energies(tric, atoms)
+
+    if verbose:
+        print("PeriodicBox %s %s  TriclinicBox %s %s" % (cnrg, ljnrg, tcnrg, tljnrg))
+
+    assert_almost_equal( cnrg, tcnrg, 2 )
+    assert_almost_equal( ljnrg, tljnrg, 2 )
+
+def test_lattice_translation(verbose=False):
+    # the energy in a truncated octahedron must not change when a
+    # molecule is moved by a lattice vector. The octahedron is large
+    # enough to hold the water box without any overlapping images
+    box = TriclinicBox.truncatedOctahedron( 1.75 * max(dimensions.x(), dimensions.y(),
+                                                       dimensions.z()) )
+
+    (cnrg, ljnrg) = _energies(box, _atoms())
+
+    for v in [box.vector0(), box.vector1(), box.vector0() - box.vector2()]:
+        (tcnrg, tljnrg) = _energies(box, _atoms(v))
+
+        if verbose:
+            print("%s : %s %s  vs.  %s %s" % (v, cnrg, ljnrg, tcnrg, tljnrg))
+
+        assert_almost_equal( cnrg, tcnrg, 2 )
+        assert_almost_equal( ljnrg, tljnrg, 2 )
+
+if __name__ == "__main__":
+    test_orthorhombic(True)
+    test_lattice_translation(True)
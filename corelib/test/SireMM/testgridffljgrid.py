@@ -0,0 +1,179 @@
+import os
+import shutil
+import struct
+import tempfile
+
+from Sire.IO import *
+from Sire.MM import *
+from Sire.Mol import *
+from Sire.Maths import *
+from Sire.Units import *
+from Sire.Vol import *
+
+import Sire.Stream
+
+from nose.tools import assert_equal
+
+coul_cutoff = 20 * angstrom
+lj_cutoff = 10 * angstrom
+
+amber = Amber()
+
+(molecules, space) = amber.readCrdTop("test/io/waterbox.crd", "test/io/waterbox.top")
+
+swapwaters = MoleculeGroup("swapwaters")
+waters = MoleculeGroup("waters")
+
+molnums = molecules.molNums()
+
+for molnum in molnums:
+    water = molecules[molnum].molecule()
+
+    if water.residue().number() == ResNum(2025):
+        center_water = water
+
+swapwaters.add(center_water)
+
+center_point = center_water.evaluate().center()
+
+for molnum in molnums:
+    if molnum != center_water.number():
+        water = molecules[molnum].molecule()
+
+        if Vector.distance(center_point, water.evaluate().center()) < 7.5:
+            swapwaters.add(water)
+        else:
+            waters.add(water)
+
+def _gridff(cls, use_lj_grid, use_tricubic):
+    ff = cls("gridff")
+    ff.setCombiningRules("arithmetic")
+    ff.setBuffer(2 * angstrom)
+    ff.setGridSpacing(0.5 * angstrom)
+    ff.setLJCutoff(lj_cutoff)
+    ff.setCoulombCutoff(coul_cutoff)
+    ff.setShiftElectrostatics(True)
+    ff.setUseLJGrid(use_lj_grid)
+    ff.setUseTricubicInterpolation(use_tricubic)
+
+    ff.add(swapwaters, MGIdx(0))
+    ff.addFixedAtoms(waters.molecules())
+    ff.setSpace( Cartesian() )
+
+    return ff
+
+def _energies(ff):
+    nrgs = ff.energies()
+    return (nrgs[ff.components().coulomb()], nrgs[ff.components().lj()])
+
+def _test_ljgrid(cls, verbose):
+    (cnrg, ljnrg) = _energies( _gridff(cls, False, False) )
+
+    if verbose:
+        print("Explicit: %s  %s" % (cnrg, ljnrg))
+
+    for use_tricubic in [False, True]:
+        ff = _gridff(cls, True, use_tricubic)
+
+        assert( ff.usesLJGrid() )
+        assert( ff.usesTricubicInterpolation() == use_tricubic )
+
+        (gcnrg, gljnrg) = _energies(ff)
+
+        if verbose:
+            print("LJ grid (tricubic == %s): %s  %s" % (use_tricubic, gcnrg, gljnrg))
+
+        assert( abs(gcnrg - cnrg) < 0.05 * abs(cnrg) + 1.0 )
+        assert( abs(gljnrg - ljnrg) < 0.05 * abs(ljnrg) + 1.0 )
+
+        # the LJ grid settings must survive streaming
+        ff2 = Sire.Stream.load( Sire.Stream.save(ff) )
+
+        assert( ff2.usesLJGrid() )
+        assert( ff2.usesTricubicInterpolation() == use_tricubic )
+
+        (scnrg, sljnrg) = _energies(ff2)
+
+        if verbose:
+            print("Streamed: %s  %s" % (scnrg, sljnrg))
+
+        assert( abs(scnrg - gcnrg) < 1e-3 )
+        assert( abs(sljnrg - gljnrg) < 1e-3 )
+
+def test_gridff_ljgrid(verbose=False):
+    _test_ljgrid(GridFF, verbose)
+
+def test_gridff2_ljgrid(verbose=False):
+    _test_ljgrid(GridFF2, verbose)
+
+def _cached_grids(cachedir):
+    """Return the keys of all of the grids saved in 'cachedir'"""
+    return [ f[:-5] for f in os.listdir(cachedir) if f.endswith(".grid") ]
+
+def _zero_cached_grid(cachedir, key):
+    """Overwrite the values of the cached grid 'key' with zeroes, keeping
+       the header. The number of values is the 64 bit integer at byte 16,
+       and the size of each value is the 32 bit integer at byte 24"""
+    filename = os.path.join(cachedir, "%s.grid" % key)
+
+    with open(filename, "r+b") as f:
+        data = f.read()
+        nvalues = struct.unpack("q", data[16:24])[0]
+        size = struct.unpack("i", data[24:28])[0]
+        f.seek( len(data) - size*nvalues )
+        f.write( b"\0" * (size*nvalues) )
+
+def _test_cache(cls, verbose):
+    cachedir = tempfile.mkdtemp()
+
+    try:
+        CLJGridCache.setCacheDirectory(cachedir)
+
+        (cnrg, ljnrg) = _energies( _gridff(cls, True, False) )
+
+        # the coulomb grid plus a repulsion and dispersion grid for
+        # each LJ type must have been saved
+        keys = _cached_grids(cachedir)
+
+        if verbose:
+            print("Cached grids: %s" % keys)
+
+        assert( len(keys) >= 3 )
+
+        # a second forcefield must load the same values from the cache
+        (ccnrg, cljnrg) = _energies( _gridff(cls, True, False) )
+
+        if verbose:
+            print("Calculated: %s  %s" % (cnrg, ljnrg))
+            print("Cached:     %s  %s" % (ccnrg, cljnrg))
+
+        assert( abs(ccnrg - cnrg) < 1e-6 )
+        assert( abs(cljnrg - ljnrg) < 1e-6 )
+        assert_equal( sorted(_cached_grids(cachedir)), sorted(keys) )
+
+        # check that the grids really are loaded from the cache
+        for key in keys:
+            _zero_cached_grid(cachedir, key)
+
+        (zcnrg, zljnrg) = _energies( _gridff(cls, True, False) )
+
+        if verbose:
+            print("Zeroed:     %s  %s" % (zcnrg, zljnrg))
+
+        assert( abs(zcnrg - cnrg) > 1e-3 )
+        assert( abs(zljnrg - ljnrg) > 1e-3 )
+    finally:
+        CLJGridCache.disable()
+        shutil.rmtree(cachedir)
+
+def test_gridff_cache(verbose=False):
+    _test_cache(GridFF, verbose)
+
+def test_gridff2_cache(verbose=False):
+    _test_cache(GridFF2, verbose)
+
+if __name__ == "__main__":
+    test_gridff_ljgrid(True)
+    test_gridff2_ljgrid(True)
+    test_gridff_cache(True)
+    test_gridff2_cache(True)
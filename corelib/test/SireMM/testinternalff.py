@@ -0,0 +1,65 @@
+
+from Sire.IO import *
+from Sire.MM import *
+from Sire.FF import *
+from Sire.Mol import *
+from Sire.Units import *
+
+from nose.tools import assert_almost_equal
+
+(molecules, space) = Amber().readCrdTop("test/io/SYSTEM.crd", "test/io/SYSTEM.top")
+
+molnums = molecules.molNums()
+
+solute = molecules.molecule(molnums[0]).molecule()
+protein = molecules.molecule(molnums[1]).molecule()
+
+# the angle and dihedral energies of the solute and protein, as calculated by sander
+sander_angle = 5310.2620
+sander_dihedral = 2922.5644
+
+def test_internal_energies(verbose=False):
+    internalff = InternalFF("internal")
+    internalff.add(solute)
+    internalff.add(protein)
+
+    angnrg = internalff.energy( internalff.components().angle() ).value()
+    dihnrg = internalff.energy( internalff.components().dihedral() ).value()
+
+    if verbose:
+        print("Angle energy: %s versus %s" % (angnrg, sander_angle))
+        print("Dihedral energy: %s versus %s" % (dihnrg, sander_dihedral))
+
+    assert_almost_equal( angnrg/1000.0, sander_angle/1000.0, 3 )
+    assert_almost_equal( dihnrg/1000.0, sander_dihedral/1000.0, 3 )
+
+def test_copied_energies(verbose=False):
+    internalff = InternalFF("internal")
+    internalff.add(solute)
+    internalff.add(protein)
+
+    nrg = internalff.energy().value()
+
+    # copies share the compiled energy functions, so must give the same energy
+    copyff = InternalFF(internalff)
+    copyff.mustNowRecalculateFromScratch()
+    copy_nrg = copyff.energy().value()
+
+    if verbose:
+        print("Energy %s, copy %s" % (nrg, copy_nrg))
+
+    assert_almost_equal( nrg, copy_nrg, 5 )
+
+    # removing and re-adding the solute should give the same energy
+    copyff.remove(solute)
+    copyff.add(solute)
+    copy_nrg = copyff.energy().value()
+
+    if verbose:
+        print("Energy %s, after re-adding %s" % (nrg, copy_nrg))
+
+    assert_almost_equal( nrg, copy_nrg, 5 )
+
+if __name__ == "__main__":
+    test_internal_energies(True)
+    test_copied_energies(True)
@@ -0,0 +1,153 @@
+
+from Sire.IO import *
+from Sire.MM import *
+from Sire.Maths import *
+from Sire.Mol import *
+from Sire.System import *
+from Sire.Units import *
+
+import math
+
+(waters, space) = Amber().readCrdTop("test/io/waterbox.crd", "test/io/waterbox.top")
+(molecules, protspace) = Amber().readCrdTop("test/io/SYSTEM.crd", "test/io/SYSTEM.top")
+
+protein = molecules[MolNum(2)].molecule()
+
+def test_water_exclusions(verbose=False):
+    # every pair of atoms in a water is bonded or angled, so
+    # all of the intramolecular energy must be excluded
+    intraff = IntraFF("intraff")
+    intraff.add(waters)
+
+    cnrg = intraff.energy(intraff.components().coulomb()).value()
+    ljnrg = intraff.energy(intraff.components().lj()).value()
+
+    if verbose:
+        print("Water intramolecular energy = %s  %s" % (cnrg, ljnrg))
+
+    assert( cnrg == 0 )
+    assert( ljnrg == 0 )
+
+def test_protein_exclusions(verbose=False):
+    # the energy must not depend on how the atoms are split
+    # into boxes, which checks the exclusions between blocks
+    # of atoms in different boxes
+    nrgs = []
+
+    for box_length in [ 3*angstrom, 7.5*angstrom, 100*angstrom ]:
+        func = CLJIntraShiftFunction(15*angstrom)
+        func.setConnectivity(protein)
+
+        cljboxes = CLJBoxes( CLJAtoms(protein, CLJAtoms.USE_ATOMIDX), box_length )
+
+        nrgs.append( CLJCalculator().calculate(func, cljboxes) )
+
+        if verbose:
+            print("Box length %s : %s" % (box_length, nrgs[-1]))
+
+    for (cnrg, ljnrg) in nrgs[1:]:
+        assert( abs(cnrg - nrgs[0][0]) < 1e-3 )
+        assert( abs(ljnrg - nrgs[0][1]) < 1e-3 )
+
+def _excluded_pairs(mol):
+    """Return the set of (i,j) AtomIdx pairs (i < j) that are bonded, angled
+       or dihedraled, which are the pairs that were true in the dense bond
+       matrix (Connectivity.getBondMatrix(1,4)) of CLJIntraFunction"""
+    connectivity = mol.property("connectivity")
+    nats = mol.nAtoms()
+
+    bonded = [ [ idx.value() for idx in connectivity.connectionsTo(AtomIdx(i)) ]
+                    for i in range(0, nats) ]
+
+    excluded = set()
+
+    for i in range(0, nats):
+        # all atoms within three bonds of atom i
+        visited = set([i])
+        front = [i]
+
+        for depth in range(0, 3):
+            new_front = []
+
+            for j in front:
+                for k in bonded[j]:
+                    if k not in visited:
+                        visited.add(k)
+                        new_front.append(k)
+
+            front = new_front
+
+        for j in visited:
+            if j > i:
+                excluded.add( (i,j) )
+
+    return excluded
+
+def _reference_energy(mol, cutoff):
+    """Return the (coulomb, LJ) intramolecular energy of 'mol' calculated
+       pair by pair, using shifted electrostatics, arithmetic combining rules
+       and excluding all 1-2, 1-3 and 1-4 pairs"""
+    atoms = []
+
+    for i in range(0, mol.nAtoms()):
+        atom = mol.atom(AtomIdx(i))
+        coords = atom.property("coordinates")
+        lj = atom.property("LJ")
+        atoms.append( (coords.x(), coords.y(), coords.z(),
+                       atom.property("charge").value(),
+                       lj.sigma().value(), lj.epsilon().value()) )
+
+    excluded = _excluded_pairs(mol)
+
+    one_over_rc = 1.0 / cutoff
+    one_over_rc2 = one_over_rc * one_over_rc
+
+    cnrg = 0
+    ljnrg = 0
+
+    for i in range(0, len(atoms)):
+        (x0, y0, z0, q0, sig0, eps0) = atoms[i]
+
+        for j in range(i+1, len(atoms)):
+            (x1, y1, z1, q1, sig1, eps1) = atoms[j]
+
+            dx = x1 - x0
+            dy = y1 - y0
+            dz = z1 - z0
+            r = math.sqrt(dx*dx + dy*dy + dz*dz)
+
+            if r >= cutoff or (i,j) in excluded:
+                continue
+
+            cnrg += q0 * q1 * (1.0/r - one_over_rc + one_over_rc2 * (r - cutoff))
+
+            sig = 0.5 * (sig0 + sig1)
+            sig6_over_r6 = (sig / r)**6
+            ljnrg += 4 * math.sqrt(eps0 * eps1) * (sig6_over_r6**2 - sig6_over_r6)
+
+    return (one_over_four_pi_eps0 * cnrg, ljnrg)
+
+def test_protein_reference(verbose=False):
+    # the energy using the sparse exclusion lists must match the
+    # energy using the dense bond matrix that they replaced
+    (ref_cnrg, ref_ljnrg) = _reference_energy(protein, 15.0)
+
+    func = CLJIntraShiftFunction(15*angstrom)
+    func.setCombiningRules(CLJFunction.ARITHMETIC)
+    func.setConnectivity(protein)
+
+    cljboxes = CLJBoxes( CLJAtoms(protein, CLJAtoms.USE_ATOMIDX), 7.5*angstrom )
+
+    (cnrg, ljnrg) = CLJCalculator().calculate(func, cljboxes)
+
+    if verbose:
+        print("Sparse exclusions: %s  %s" % (cnrg, ljnrg))
+        print("Dense reference:   %s  %s" % (ref_cnrg, ref_ljnrg))
+
+    assert( abs(cnrg - ref_cnrg) < 1e-4 * abs(ref_cnrg) + 0.05 )
+    assert( abs(ljnrg - ref_ljnrg) < 1e-4 * abs(ref_ljnrg) + 0.05 )
+
+if __name__ == "__main__":
+    test_water_exclusions(True)
+    test_protein_exclusions(True)
+    test_protein_reference(True)
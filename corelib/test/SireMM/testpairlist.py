@@ -0,0 +1,92 @@
+
+from Sire.IO import *
+from Sire.MM import *
+from Sire.Mol import *
+from Sire.Maths import *
+from Sire.Vol import *
+from Sire.Units import *
+
+from nose.tools import assert_equal, assert_almost_equal
+
+(waters, space) = Amber().readCrdTop("test/io/waterbox.crd", "test/io/waterbox.top")
+
+box_length = CLJBoxes().length()
+
+def _same_boxes(mol0, mol1):
+    """Return whether all of the atoms of 'mol0' and 'mol1' are in the same boxes"""
+    coords0 = mol0.property("coordinates").toVector()
+    coords1 = mol1.property("coordinates").toVector()
+
+    for i in range(0, len(coords0)):
+        if CLJBoxIndex.createWithBoxLength(coords0[i], box_length) != \
+           CLJBoxIndex.createWithBoxLength(coords1[i], box_length):
+            return False
+
+    return True
+
+def _translated(delta, keep_boxes=False):
+    """Return the boxes of the waters, with alternate waters translated
+       by 'delta'. If 'keep_boxes' is true then only the waters that stay
+       in the same boxes are translated"""
+    group = MoleculeGroup("waters")
+
+    i = 0
+    nmoved = 0
+
+    for molnum in waters.molNums():
+        i += 1
+        sign = 1.0 if (i % 2 == 0) else -1.0
+
+        mol = waters[molnum].molecule()
+        moved = mol.move().translate( Vector(sign*delta, 0, -sign*delta) ).commit()
+
+        if keep_boxes and not _same_boxes(mol, moved):
+            group.add(mol)
+        else:
+            group.add(moved)
+
+            if delta != 0:
+                nmoved += 1
+
+    if delta != 0:
+        assert( nmoved > 0 )
+
+    return CLJBoxes( CLJAtoms(group.molecules()) )
+
+def test_pairlist(verbose=False):
+    func = CLJShiftFunction(10*angstrom)
+    func.setSpace(space)
+
+    calc = CLJCalculator()
+    pairlist = CLJPairList(2*angstrom)
+
+    nrebuilds = 0
+
+    for (delta, keep_boxes) in [ (0.0, False), (0.0, False), (0.2, True), (1.5, False) ]:
+        boxes = _translated(delta, keep_boxes)
+
+        (cnrg, ljnrg) = calc.calculate(func, boxes)
+        (pcnrg, pljnrg) = calc.calculate(func, boxes, pairlist)
+
+        if verbose:
+            print("delta = %s : %s %s  vs.  %s %s  (%d rebuilds)" % \
+                     (delta, cnrg, ljnrg, pcnrg, pljnrg, pairlist.nRebuilds()))
+
+        assert_almost_equal( cnrg, pcnrg, 3 )
+        assert_almost_equal( ljnrg, pljnrg, 3 )
+
+        if delta == 0.0:
+            #the list is built once, and then reused for the same coordinates
+            assert_equal( pairlist.nRebuilds(), 1 )
+        elif keep_boxes:
+            #moving atoms by less than half the skin, without changing
+            #the atoms in each box, must reuse the list
+            assert_equal( pairlist.nRebuilds(), nrebuilds )
+        else:
+            #moving atoms by more than half the skin must rebuild the list
+            assert( pairlist.nRebuilds() > nrebuilds )
+
+        nrebuilds = pairlist.nRebuilds()
+
+if __name__ == "__main__":
+    test_pairlist(True)
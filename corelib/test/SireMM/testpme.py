@@ -0,0 +1,83 @@
+
+from Sire.IO import *
+from Sire.MM import *
+from Sire.FF import *
+from Sire.Mol import *
+from Sire.Maths import *
+from Sire.Vol import *
+from Sire.Units import *
+
+from nose.tools import assert_almost_equal
+
+(waters, space) = Amber().readCrdTop("test/io/waterbox.crd", "test/io/waterbox.top")
+
+delta = 0.001
+
+def _ewald_energy(cutoff, verbose=False):
+    cljfunc = CLJEwaldFunction(cutoff)
+    cljfunc.setSpace(space)
+
+    interff = InterFF("interff")
+    interff.setCLJFunction(cljfunc)
+    interff.add(waters)
+
+    pmeff = PMEFF("pmeff")
+    pmeff.setSpace(space)
+    pmeff.setCoulombCutoff(cutoff)
+    pmeff.add(waters)
+
+    real = interff.energy(interff.components().coulomb()).value()
+    recip = pmeff.energy().value()
+
+    if verbose:
+        print("Cutoff %s : real = %s, reciprocal = %s, total = %s" % \
+                   (cutoff, real, recip, real+recip))
+
+    return real + recip
+
+def test_pme_energy(verbose=False):
+    # the total Ewald energy should not depend on the real-space cutoff
+    nrg8 = _ewald_energy(8*angstrom, verbose)
+    nrg12 = _ewald_energy(12*angstrom, verbose)
+
+    assert( abs(nrg8 - nrg12) < 1e-3 * abs(nrg12) )
+
+def test_pme_force(verbose=False):
+    pmeff = PMEFF("pmeff")
+    pmeff.setSpace(space)
+    pmeff.add(waters)
+
+    forcetable = ForceTable(waters)
+    pmeff.force(forcetable)
+
+    mol = waters.moleculeAt(0).molecule()
+    force = forcetable.getTable(mol.number()).toVector()[0]
+
+    coords = mol.atom(AtomIdx(0)).property("coordinates")
+
+    for i in range(0,3):
+        d = [0.0, 0.0, 0.0]
+        d[i] = delta
+
+        plus = mol.edit().atom(AtomIdx(0)).setProperty("coordinates",
+                                      coords + Vector(d[0],d[1],d[2])).molecule().commit()
+        pmeff.update(plus)
+        nrg_plus = pmeff.energy().value()
+
+        minus = mol.edit().atom(AtomIdx(0)).setProperty("coordinates",
+                                       coords - Vector(d[0],d[1],d[2])).molecule().commit()
+        pmeff.update(minus)
+        nrg_minus = pmeff.energy().value()
+
+        pmeff.update(mol)
+
+        fd_force = -(nrg_plus - nrg_minus) / (2*delta)
+
+        if verbose:
+            print("%d : %s  %s" % (i, force[i], fd_force))
+
+        assert_almost_equal( force[i], fd_force, 1 )
+
+if __name__ == "__main__":
+    test_pme_energy(True)
+    test_pme_force(True)
@@ -0,0 +1,78 @@
+
+from Sire.Maths import *
+import Sire.Stream
+
+def test_reproducible(verbose=False):
+    rand0 = CounterRanGenerator(42)
+    rand1 = CounterRanGenerator(42)
+
+    for i in range(0,1000):
+        assert( rand0.randInt() == rand1.randInt() )
+
+    assert( rand0 == rand1 )
+
+    if verbose:
+        print(rand0)
+
+def test_substreams(verbose=False):
+    rand = CounterRanGenerator(42)
+
+    stream0 = rand.substream(0)
+    stream1 = rand.substream(1)
+
+    nsame = 0
+
+    for i in range(0,1000):
+        if stream0.randInt() == stream1.randInt():
+            nsame += 1
+
+    if verbose:
+        print("Number of identical numbers in independent streams: %d" % nsame)
+
+    assert( nsame < 5 )
+
+    # the numbers in a stream depend only on the seed, stream and
+    # position, so can be regenerated in any order
+    stream = CounterRanGenerator(42, 7)
+    values = [ stream.rand() for i in range(0,100) ]
+
+    for i in [99, 12, 57, 0, 4]:
+        stream.setCounter(i)
+        assert( stream.rand() == values[i] )
+
+def test_distribution(verbose=False):
+    rand = CounterRanGenerator(1234)
+
+    n = 100000
+    avg = 0.0
+    avg2 = 0.0
+
+    for i in range(0,n):
+        r = rand.rand()
+        assert( r >= 0 and r <= 1 )
+        avg += r
+        avg2 += r*r
+
+    avg /= n
+    avg2 /= n
+
+    if verbose:
+        print("Average %s, variance %s" % (avg, avg2-avg*avg))
+
+    assert( abs(avg - 0.5) < 0.01 )
+    assert( abs(avg2 - avg*avg - 1.0/12.0) < 0.01 )
+
+def test_stream(verbose=False):
+    rand = CounterRanGenerator(42, 3)
+    rand.skip(11)
+
+    rand2 = Sire.Stream.load( Sire.Stream.save(rand) )
+
+    assert( rand == rand2 )
+    assert( rand.rand() == rand2.rand() )
+
+if __name__ == "__main__":
+    test_reproducible(True)
+    test_substreams(True)
+    test_distribution(True)
+    test_stream(True)
@@ -0,0 +1,88 @@
+
+from Sire.Maths import *
+
+from nose.tools import assert_almost_equal
+
+rand = RanGenerator(42)
+
+def _random_matrix(nrows, ncolumns):
+    m = NMatrix(nrows, ncolumns)
+
+    for i in range(0,nrows):
+        for j in range(0,ncolumns):
+            m.set(i, j, rand.rand(-1,1))
+
+    return m
+
+def test_multiply(verbose=False):
+    a = _random_matrix(37, 53)
+    b = _random_matrix(53, 29)
+
+    for (x,y) in [ (a,b), (b.transpose(), a.transpose()) ]:
+        c = x * y
+
+        assert( c.nRows() == x.nRows() )
+        assert( c.nColumns() == y.nColumns() )
+
+        for i in range(0,c.nRows()):
+            for j in range(0,c.nColumns()):
+                s = 0
+                for k in range(0,x.nColumns()):
+                    s += x(i,k) * y(k,j)
+
+                assert_almost_equal( c(i,j), s, 10 )
+
+    if verbose:
+        print("Matrix multiplication OK")
+
+def test_inverse(verbose=False):
+    a = _random_matrix(40, 40)
+    inv = a.inverse()
+
+    ident = a * inv
+
+    for i in range(0,40):
+        for j in range(0,40):
+            if i == j:
+                assert_almost_equal( ident(i,j), 1.0, 8 )
+            else:
+                assert_almost_equal( ident(i,j), 0.0, 8 )
+
+    m = NMatrix(2,2)
+    m.set(0,0,1)
+    m.set(0,1,2)
+    m.set(1,0,3)
+    m.set(1,1,4)
+
+    assert_almost_equal( m.determinant(), -2.0, 10 )
+
+    if verbose:
+        print("Matrix inverse OK")
+
+def test_diagonalise(verbose=False):
+    n = 30
+    a = _random_matrix(n, n)
+
+    # make the matrix symmetric
+    a = a + a.transpose()
+
+    (evals, evecs) = a.diagonalise()
+
+    for k in range(0,n):
+        if k > 0:
+            assert( evals[k] >= evals[k-1] )
+
+        for i in range(0,n):
+            s = 0
+            for j in range(0,n):
+                s += a(i,j) * evecs(j,k)
+
+            assert_almost_equal( s, evals[k] * evecs(i,k), 8 )
+
+    if verbose:
+        print("Eigenvalues %s" % evals)
+
+if __name__ == "__main__":
+    test_multiply(True)
+    test_inverse(True)
+    test_diagonalise(True)
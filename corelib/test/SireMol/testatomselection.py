@@ -0,0 +1,88 @@
+
+from Sire.IO import *
+from Sire.Mol import *
+
+mol = PDB().readMolecule("test/io/p38.pdb")
+
+def _atoms(selection):
+    return set( [ atom.value() for atom in selection.selectedAtoms() ] )
+
+def _residue_selection(residxs):
+    s = mol.selection()
+    s = s.selectNone()
+
+    for residx in residxs:
+        s = s.select( ResIdx(residx) )
+
+    return s
+
+def test_select(verbose=False):
+    s = mol.selection()
+
+    assert( s.selectedAll() )
+    assert( s.nSelected() == mol.nAtoms() )
+
+    s = s.selectNone()
+
+    assert( s.selectedNone() )
+    assert( len(s.selectedAtoms()) == 0 )
+
+    s = s.select( AtomIdx(70) )
+    s = s.select( AtomIdx(3) )
+    s = s.select( AtomIdx(129) )
+
+    assert( s.nSelected() == 3 )
+    assert( _atoms(s) == set([3,70,129]) )
+    assert( [ atom.value() for atom in s.selectedAtoms() ] == [3,70,129] )
+
+    s = s.deselect( AtomIdx(70) )
+
+    assert( s.nSelected() == 2 )
+    assert( not s.selected( AtomIdx(70) ) )
+
+    if verbose:
+        print("Atom selection OK")
+
+def test_set_algebra(verbose=False):
+    a = _residue_selection( range(0,20) )
+    b = _residue_selection( range(10,35) )
+
+    a_atoms = _atoms(a)
+    b_atoms = _atoms(b)
+
+    assert( a.nSelected() == len(a_atoms) )
+    assert( b.nSelected() == len(b_atoms) )
+
+    assert( a.intersects(b) )
+    assert( a.nSelected(b) == len(a_atoms & b_atoms) )
+
+    u = a.unite(b)
+    assert( _atoms(u) == a_atoms | b_atoms )
+    assert( u.nSelected() == len(a_atoms | b_atoms) )
+    assert( u.contains(a) )
+    assert( u.contains(b) )
+
+    a = _residue_selection( range(0,20) )
+    i = a.intersect(b)
+    assert( _atoms(i) == a_atoms & b_atoms )
+    assert( b.contains(i) )
+
+    a = _residue_selection( range(0,20) )
+    d = a.subtract(b)
+    assert( _atoms(d) == a_atoms - b_atoms )
+    assert( not d.intersects(b) )
+
+    a = _residue_selection( range(0,20) )
+    inv = a.invert()
+    assert( inv.nSelected() == mol.nAtoms() - len(a_atoms) )
+    assert( _atoms(inv) == set(range(0,mol.nAtoms())) - a_atoms )
+
+    inv = inv.invert()
+    assert( _atoms(inv) == a_atoms )
+
+    if verbose:
+        print("Selection set algebra OK")
+
+if __name__ == "__main__":
+    test_select(True)
+    test_set_algebra(True)
@@ -0,0 +1,73 @@
+
+from Sire.IO import *
+from Sire.Mol import *
+
+mol = PDB().readMolecule("test/io/indole.pdb")
+connectivity = Connectivity(mol)
+
+nats = mol.nAtoms()
+
+def _bonded(i):
+    return set( [ atom.value() for atom in connectivity.connectionsTo(AtomIdx(i)) ] )
+
+def test_neighbours(verbose=False):
+    bonds = [ _bonded(i) for i in range(0,nats) ]
+
+    for i in range(0,nats):
+        angled = set()
+        dihedraled = set()
+
+        for j in bonds[i]:
+            for k in bonds[j]:
+                if k != i:
+                    angled.add(k)
+
+                    for l in bonds[k]:
+                        if l != j and l != i:
+                            dihedraled.add(l)
+
+        for l in range(0,nats):
+            assert( connectivity.areBonded(AtomIdx(i),AtomIdx(l)) == (l in bonds[i]) )
+            assert( connectivity.areAngled(AtomIdx(i),AtomIdx(l)) == (l in angled) )
+            assert( connectivity.areDihedraled(AtomIdx(i),AtomIdx(l)) == (l in dihedraled) )
+
+    if verbose:
+        print("Bonded, angled and dihedraled atoms OK")
+
+def test_paths(verbose=False):
+    for i in range(0,nats):
+        for j in range(i+1,nats):
+            path = connectivity.findPath(AtomIdx(i), AtomIdx(j))
+            paths = connectivity.findPaths(AtomIdx(i), AtomIdx(j))
+
+            shortest = min( [ len(p) for p in paths ] )
+
+            assert( len(path) == shortest )
+            assert( path[0] == AtomIdx(i) )
+            assert( path[-1] == AtomIdx(j) )
+
+            for k in range(1,len(path)):
+                assert( connectivity.areBonded(path[k-1], path[k]) )
+
+    if verbose:
+        print("Shortest paths OK")
+
+def test_split(verbose=False):
+    for bond in connectivity.getBonds():
+        if connectivity.inRing(bond):
+            continue
+
+        (g0, g1) = connectivity.split(bond)
+        (h1, h0) = connectivity.split(bond.atom1(), bond.atom0())
+
+        assert( g0 == h0 )
+        assert( g1 == h1 )
+        assert( g0.nSelected() + g1.nSelected() == nats )
+
+    if verbose:
+        print("Splitting OK")
+
+if __name__ == "__main__":
+    test_neighbours(True)
+    test_paths(True)
+    test_split(True)
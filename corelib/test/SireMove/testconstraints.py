@@ -0,0 +1,151 @@
+
+from Sire.IO import *
+from Sire.MM import *
+from Sire.Mol import *
+from Sire.Maths import *
+from Sire.Move import *
+from Sire.System import *
+from Sire.Units import *
+
+amber = Amber()
+
+(molecules, space) = amber.readCrdTop("test/io/waterbox.crd", "test/io/waterbox.top")
+
+waters = MoleculeGroup("waters")
+
+for molnum in molecules.molNums()[0:50]:
+    waters.add(molecules[molnum].molecule())
+
+(solutes, solute_space) = amber.readCrdTop("test/io/SYSTEM.crd", "test/io/SYSTEM.top")
+
+solute = solutes.molecule(solutes.molNums()[0]).molecule()
+
+def _geometry(mol):
+    coords = mol.property("coordinates").toVector()
+
+    return [ Vector.distance(coords[0], coords[1]),
+             Vector.distance(coords[0], coords[2]),
+             Vector.distance(coords[1], coords[2]) ]
+
+def test_settle(verbose=False):
+    cljff = InterCLJFF("cljff")
+    cljff.add(waters)
+
+    system = System()
+    system.add(waters)
+    system.add(cljff)
+    system.setProperty("space", space)
+
+    start = {}
+
+    for molnum in waters.molNums():
+        start[molnum] = _geometry(waters[molnum].molecule())
+
+    integrator = VelocityVerlet()
+    integrator.setConstraintType("water")
+
+    mdmove = MolecularDynamics(waters, integrator, 2*femtosecond,
+                               {"velocity generator":MaxwellBoltzmann(25*celsius)})
+
+    mdmove.move(system, 50)
+
+    maxdiff = 0
+
+    for molnum in waters.molNums():
+        geometry = _geometry(system[molnum].molecule())
+
+        for i in range(0,3):
+            maxdiff = max(maxdiff, abs(geometry[i] - start[molnum][i]))
+
+    if verbose:
+        print("Maximum change in water geometry = %s A" % maxdiff)
+
+    assert( maxdiff < 1e-6 )
+
+def _coords(mol, atom):
+    return mol.atom(atom).property("coordinates")
+
+def _is_hydrogen(mol, atom):
+    return mol.atom(atom).property("mass").value() < 1.5
+
+def _bonds(mol):
+    """Return the bonds of 'mol' as (atom0, atom1, is_hbond)"""
+    bonds = []
+
+    for bond in mol.property("bond").potentials():
+        bonds.append( (bond.atom0(), bond.atom1(),
+                       _is_hydrogen(mol, bond.atom0()) or _is_hydrogen(mol, bond.atom1())) )
+
+    return bonds
+
+def _test_shake(constraint_type, verbose):
+    internalff = InternalFF("internal")
+    internalff.add(solute)
+
+    solutes = MoleculeGroup("solutes")
+    solutes.add(solute)
+
+    system = System()
+    system.add(solutes)
+    system.add(internalff)
+
+    bonds = _bonds(solute)
+    assert( len(bonds) > 0 )
+
+    integrator = VelocityVerlet()
+    integrator.setConstraintType(constraint_type)
+
+    mdmove = MolecularDynamics(solutes, integrator, 2*femtosecond,
+                               {"velocity generator":MaxwellBoltzmann(25*celsius)})
+
+    mdmove.move(system, 50)
+
+    mol = system[solute.number()].molecule()
+
+    max_constrained = 0
+    max_flexible = 0
+    max_rattle = 0
+
+    for (atom0, atom1, is_hbond) in bonds:
+        d = Vector.distance( _coords(mol, atom0), _coords(mol, atom1) )
+        old_d = Vector.distance( _coords(solute, atom0), _coords(solute, atom1) )
+
+        if constraint_type == "allbonds" or is_hbond:
+            max_constrained = max(max_constrained, abs(d - old_d))
+
+            # RATTLE removes the relative velocity along each constrained bond
+            dr = _coords(mol, atom0) - _coords(mol, atom1)
+            v0 = mol.atom(atom0).property("velocity")
+            v1 = mol.atom(atom1).property("velocity")
+            dv = Vector( v0.x().value() - v1.x().value(),
+                         v0.y().value() - v1.y().value(),
+                         v0.z().value() - v1.z().value() )
+
+            if dv.length() > 0:
+                max_rattle = max(max_rattle, abs(Vector.dot(dr.normalise(), dv.normalise())))
+        else:
+            max_flexible = max(max_flexible, abs(d - old_d))
+
+    if verbose:
+        print("%s : maximum change in constrained bonds = %s A, in flexible bonds = %s A" % \
+                    (constraint_type, max_constrained, max_flexible))
+        print("%s : maximum relative velocity along a constrained bond = %s" % \
+                    (constraint_type, max_rattle))
+
+    assert( max_constrained < 1e-5 )
+    assert( max_rattle < 1e-4 )
+
+    # the bonds that are not constrained must still be flexible
+    if constraint_type == "hbonds":
+        assert( max_flexible > 1e-3 )
+
+def test_shake_hbonds(verbose=False):
+    _test_shake("hbonds", verbose)
+
+def test_shake_allbonds(verbose=False):
+    _test_shake("allbonds", verbose)
+
+if __name__ == "__main__":
+    test_settle(True)
+    test_shake_hbonds(True)
+    test_shake_allbonds(True)
@@ -0,0 +1,99 @@
+
+from Sire.IO import *
+from Sire.MM import *
+from Sire.Mol import *
+from Sire.Maths import *
+from Sire.Move import *
+from Sire.System import *
+from Sire.Units import *
+
+amber = Amber()
+
+(molecules, space) = amber.readCrdTop("test/io/waterbox.crd", "test/io/waterbox.top")
+
+waters = MoleculeGroup("waters")
+
+for molnum in molecules.molNums()[0:50]:
+    waters.add(molecules[molnum].molecule())
+
+def _run(seed, clear=False):
+    cljff = InterCLJFF("cljff")
+    cljff.add(waters)
+
+    system = System()
+    system.add(waters)
+    system.add(cljff)
+    system.setProperty("space", space)
+
+    integrator = Langevin(25*celsius, 0.1*picosecond)
+
+    mdmove = MolecularDynamics(waters, integrator, 1*femtosecond,
+                               {"velocity generator":MaxwellBoltzmann(25*celsius)})
+
+    mdmove.setGenerator( RanGenerator(seed) )
+
+    if clear:
+        # the new workspace must still use the seeded generator
+        mdmove.clearStatistics()
+        mdmove.setIntegrator( Langevin(25*celsius, 0.2*picosecond) )
+        mdmove.setIntegrator(integrator)
+
+    mdmove.move(system, 20)
+
+    return system
+
+def test_reproducible(verbose=False):
+    system0 = _run(42)
+    system1 = _run(42)
+    system2 = _run(7)
+
+    maxdiff = 0
+    seeddiff = 0
+
+    for molnum in waters.molNums():
+        coords0 = system0[molnum].molecule().property("coordinates").toVector()
+        coords1 = system1[molnum].molecule().property("coordinates").toVector()
+        coords2 = system2[molnum].molecule().property("coordinates").toVector()
+
+        for i in range(0,len(coords0)):
+            maxdiff = max(maxdiff, Vector.distance(coords0[i], coords1[i]))
+            seeddiff = max(seeddiff, Vector.distance(coords0[i], coords2[i]))
+
+    if verbose:
+        print("Same seed: maximum difference = %s A" % maxdiff)
+        print("Different seed: maximum difference = %s A" % seeddiff)
+
+    assert( maxdiff < 1e-6 )
+    assert( seeddiff > 1e-6 )
+
+def test_reproducible_after_clear(verbose=False):
+    system0 = _run(42)
+    system1 = _run(42, True)
+
+    maxdiff = 0
+
+    for molnum in waters.molNums():
+        coords0 = system0[molnum].molecule().property("coordinates").toVector()
+        coords1 = system1[molnum].molecule().property("coordinates").toVector()
+
+        for i in range(0,len(coords0)):
+            maxdiff = max(maxdiff, Vector.distance(coords0[i], coords1[i]))
+
+    if verbose:
+        print("After clearStatistics: maximum difference = %s A" % maxdiff)
+
+    assert( maxdiff < 1e-6 )
+
+def test_ensemble(verbose=False):
+    integrator = Langevin(300*kelvin)
+
+    if verbose:
+        print(integrator)
+
+    assert( integrator.ensemble().isNVT() )
+    assert( not integrator.isTimeReversible() )
+
+if __name__ == "__main__":
+    test_reproducible(True)
+    test_reproducible_after_clear(True)
+    test_ensemble(True)
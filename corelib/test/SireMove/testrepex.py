@@ -0,0 +1,92 @@
+
+from Sire.IO import *
+from Sire.MM import *
+from Sire.Mol import *
+from Sire.Maths import *
+from Sire.Move import *
+from Sire.System import *
+from Sire.CAS import *
+from Sire.Units import *
+
+from nose.tools import assert_equal
+
+(molecules, space) = Amber().readCrdTop("test/io/waterbox.crd", "test/io/waterbox.top")
+
+waters = MoleculeGroup("waters")
+
+for molnum in molecules.molNums()[0:10]:
+    waters.add(molecules[molnum].molecule())
+
+lam = Symbol("lambda")
+
+lambda_values = [ 0.0, 0.25, 0.5, 0.75, 1.0 ]
+
+def _run(asynchronous, seed=42, nmoves=10):
+    cljff = InterCLJFF("cljff")
+    cljff.add(waters)
+
+    system = System()
+    system.add(waters)
+    system.add(cljff)
+    system.setProperty("space", space)
+
+    system.setComponent(lam, 0.0)
+    system.setComponent(system.totalComponent(), lam * cljff.components().total())
+
+    replicas = Replicas(system, len(lambda_values))
+    replicas.setLambdaComponent(lam)
+
+    for i in range(0, len(lambda_values)):
+        replicas.setLambdaValue(i, lambda_values[i])
+
+    move = RigidBodyMC(waters)
+    move.setTemperature(25*celsius)
+
+    replicas.setSubMoves( SameMoves(move) )
+    replicas.setNSubMoves(5)
+    replicas.setGenerator( RanGenerator(seed) )
+
+    repexmove = RepExMove()
+    repexmove.setGenerator( RanGenerator(seed+1) )
+    repexmove.setAsynchronous(asynchronous)
+
+    sim = SupraSim.run(replicas, repexmove, nmoves, True)
+    sim.wait()
+
+    return (sim.system(), sim.moves()[0])
+
+def test_async_matches_lockstep(verbose=False):
+    # asynchronous exchange uses the same random numbers for the same
+    # pairs as lock-step exchange, so must make exactly the same swaps,
+    # and must record the statistics of each block in block order
+    (replicas, repexmove) = _run(False)
+    (async_replicas, async_repexmove) = _run(True)
+
+    if verbose:
+        print("Lock-step: %d accepted, %d rejected" % (repexmove.nAccepted(),
+                                                      repexmove.nRejected()))
+        print("Asynchronous: %d accepted, %d rejected" % (async_repexmove.nAccepted(),
+                                                         async_repexmove.nRejected()))
+
+    assert_equal( repexmove.nAccepted(), async_repexmove.nAccepted() )
+    assert_equal( repexmove.nRejected(), async_repexmove.nRejected() )
+
+    assert_equal( replicas.replicaIDs(), async_replicas.replicaIDs() )
+
+    history = replicas.lambdaTrajectoryHistory()
+    async_history = async_replicas.lambdaTrajectoryHistory()
+
+    assert_equal( len(history), len(async_history) )
+
+    for i in range(0, len(history)):
+        if verbose:
+            print("%d : %s  %s" % (i, history[i], async_history[i]))
+
+        assert_equal( history[i], async_history[i] )
+
+    for i in range(0, replicas.nReplicas()):
+        assert_equal( replicas[i].subSystem().energy().value(),
+                      async_replicas[i].subSystem().energy().value() )
+
+if __name__ == "__main__":
+    test_async_matches_lockstep(True)
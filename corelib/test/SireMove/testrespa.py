@@ -0,0 +1,105 @@
+
+from Sire.IO import *
+from Sire.MM import *
+from Sire.Mol import *
+from Sire.Maths import *
+from Sire.Move import *
+from Sire.System import *
+from Sire.Units import *
+
+amber = Amber()
+
+(molecules, space) = amber.readCrdTop("test/io/waterbox.crd", "test/io/waterbox.top")
+
+waters = MoleculeGroup("waters")
+
+for molnum in molecules.molNums()[0:50]:
+    waters.add(molecules[molnum].molecule())
+
+# the energy is split into two copies of the same forcefield, so that
+# one copy can be placed on each time level
+fastff = InterCLJFF("fastff")
+fastff.add(waters)
+
+slowff = InterCLJFF("slowff")
+slowff.add(waters)
+
+def _run(integrator, nmoves, timestep=1*femtosecond):
+    """Run 'nmoves' steps of 'integrator', returning the system together
+       with the change in total (potential plus kinetic) energy"""
+    system = System()
+    system.add(waters)
+    system.add(fastff)
+    system.add(slowff)
+    system.setProperty("space", space)
+
+    mdmove = MolecularDynamics(waters, integrator, timestep)
+
+    # the velocities start at zero, so there is no initial kinetic energy
+    nrg0 = system.energy().value()
+
+    mdmove.move(system, nmoves)
+
+    nrg1 = system.energy().value() + mdmove.kineticEnergy().value()
+
+    return (system, nrg1 - nrg0)
+
+def _maxdiff(system0, system1):
+    maxdiff = 0
+
+    for molnum in waters.molNums():
+        coords0 = system0[molnum].molecule().property("coordinates").toVector()
+        coords1 = system1[molnum].molecule().property("coordinates").toVector()
+
+        for i in range(0,len(coords0)):
+            maxdiff = max(maxdiff, Vector.distance(coords0[i], coords1[i]))
+
+    return maxdiff
+
+def test_single_step(verbose=False):
+    # with one sub-step, RESPA is velocity verlet with the forces split in two
+    (vv, vv_drift) = _run(VelocityVerlet(), 20)
+
+    (respa, respa_drift) = _run(RESPA(fastff.components().total(),
+                                      slowff.components().total(), 1), 20)
+
+    maxdiff = _maxdiff(vv, respa)
+
+    if verbose:
+        print("RESPA vs. VelocityVerlet: maximum difference = %s A" % maxdiff)
+
+    assert( maxdiff < 1e-6 )
+
+def test_multiple_steps(verbose=False):
+    integrator = RESPA(fastff.components().total(),
+                       slowff.components().total(), 2)
+
+    if verbose:
+        print(integrator)
+
+    assert( integrator.nLevels() == 2 )
+    assert( integrator.nSubSteps(1) == 2 )
+    assert( integrator.isTimeReversible() )
+
+    # 20 fs of dynamics, with the whole force evaluated every 1 fs, or
+    # with half of the force evaluated every 1 fs and half every 2 fs
+    (vv, vv_drift) = _run(VelocityVerlet(), 20)
+    (respa, respa_drift) = _run(integrator, 10, 2*femtosecond)
+
+    maxdiff = _maxdiff(vv, respa)
+
+    if verbose:
+        print("RESPA (2 fs / 2) vs. VelocityVerlet: maximum difference = %s A" % maxdiff)
+        print("Energy drift: RESPA %s, VelocityVerlet %s kcal mol-1" % \
+                    (respa_drift, vv_drift))
+
+    assert( maxdiff < 0.02 )
+
+    # the energy error grows with the square of the timestep, so the
+    # drift may be up to four times that of velocity verlet with the
+    # short step
+    assert( abs(respa_drift) < 0.5 + 4 * abs(vv_drift) )
+
+if __name__ == "__main__":
+    test_single_step(True)
+    test_multiple_steps(True)
@@ -0,0 +1,157 @@
+
+from Sire.IO import *
+from Sire.MM import *
+from Sire.Mol import *
+from Sire.Maths import *
+from Sire.CAS import *
+from Sire.System import *
+from Sire.Units import *
+
+import math
+
+(molecules, space) = Amber().readCrdTop("test/io/waterbox.crd", "test/io/waterbox.top")
+
+molnums = molecules.molNums()
+molnums.sort()
+
+lam = Symbol("lambda")
+
+def _group(name, nums):
+    group = MoleculeGroup(name)
+
+    for molnum in nums:
+        group.add( molecules[molnum].molecule() )
+
+    return group
+
+refgroup = _group("reference", molnums[0:5])
+group_a = _group("group_a", molnums[5:7])
+group_b = _group("group_b", molnums[7:9])
+
+def _atoms(group):
+    """Return the (coordinates, charge, LJ) of all atoms in 'group'"""
+    atoms = []
+
+    for molnum in group.molNums():
+        mol = group[molnum].molecule()
+
+        for i in range(0, mol.nAtoms()):
+            atom = mol.atom(AtomIdx(i))
+            atoms.append( (atom.property("coordinates"),
+                           atom.property("charge").value(),
+                           atom.property("LJ")) )
+
+    return atoms
+
+def _energy(atoms0, atoms1, alpha, shift_delta, coulomb_power, soft_core):
+    """Return the (coulomb, LJ) energy between 'atoms0' and 'atoms1', using
+       arithmetic combining rules and the soft-core potential of
+       FreeEnergyMonitor with soft-core parameter 'alpha' if 'soft_core'
+       is true, else the normal coulomb and LJ potentials"""
+    cnrg = 0
+    ljnrg = 0
+
+    delta = shift_delta * alpha
+    one_minus_alpha_to_n = (1 - alpha)**coulomb_power
+
+    for (coords0, chg0, lj0) in atoms0:
+        for (coords1, chg1, lj1) in atoms1:
+            r2 = Vector.distance2(coords0, coords1)
+
+            sig = 0.5 * (lj0.sigma().value() + lj1.sigma().value())
+            eps = math.sqrt(lj0.epsilon().value() * lj1.epsilon().value())
+
+            if soft_core:
+                sig6_over_denom = sig**6 / (r2 + sig*delta)**3
+                ljnrg += 4 * eps * (sig6_over_denom**2 - sig6_over_denom)
+                cnrg += one_minus_alpha_to_n * chg0 * chg1 * one_over_four_pi_eps0 / \
+                                math.sqrt(alpha + r2)
+            else:
+                sig6_over_r6 = sig**6 / r2**3
+                ljnrg += 4 * eps * (sig6_over_r6**2 - sig6_over_r6)
+                cnrg += chg0 * chg1 * one_over_four_pi_eps0 / math.sqrt(r2)
+
+    return (cnrg, ljnrg)
+
+def _reference_deltas(atoms, lamval, delta_lambda, shift_delta, coulomb_power):
+    """Return the (coulomb, LJ) energy difference between lamval+delta_lambda
+       and lamval of 'atoms', calculated by evaluating each lambda value
+       separately (as was done by FreeEnergyMonitor before the energies at
+       all lambda values were calculated together)"""
+    soft_core = (shift_delta != 0 or coulomb_power != 0)
+
+    atoms_a = _atoms(group_a)
+    atoms_b = _atoms(group_b)
+
+    lamval = max(0, lamval)
+
+    if lamval + delta_lambda > 1:
+        lamval = 1 - delta_lambda
+
+    nrgs = []
+
+    for l in [lamval, lamval + delta_lambda]:
+        (cnrg_a, ljnrg_a) = _energy(atoms, atoms_a, l, shift_delta, coulomb_power, soft_core)
+        (cnrg_b, ljnrg_b) = _energy(atoms, atoms_b, 1-l, shift_delta, coulomb_power, soft_core)
+
+        nrgs.append( ((1-l)*cnrg_a + l*cnrg_b, (1-l)*ljnrg_a + l*ljnrg_b) )
+
+    return (nrgs[1][0] - nrgs[0][0], nrgs[1][1] - nrgs[0][1])
+
+def _assert_close(value, ref):
+    assert( abs(value - ref) < 1e-8 + 1e-6 * abs(ref) )
+
+def _test_monitor(lamval, shift_delta, coulomb_power, verbose):
+    system = System()
+    system.add(refgroup)
+    system.add(group_a)
+    system.add(group_b)
+    system.setComponent(lam, lamval)
+
+    monitor = FreeEnergyMonitor( AssignerGroup(refgroup), AssignerGroup(group_a),
+                                 AssignerGroup(group_b) )
+
+    monitor.setLambdaComponent(lam)
+    monitor.setDeltaLambda(0.01)
+    monitor.setShiftDelta(shift_delta)
+    monitor.setCoulombPower(coulomb_power)
+
+    assert( monitor.usesSoftCore() == (shift_delta != 0 or coulomb_power != 0) )
+
+    monitor.monitor(system)
+
+    coul_nrgs = monitor.coulombFreeEnergies()
+    lj_nrgs = monitor.ljFreeEnergies()
+    total_nrgs = monitor.freeEnergies()
+
+    i = 0
+
+    for molnum in refgroup.molNums():
+        atoms = _atoms( MoleculeGroup("ref", refgroup[molnum].molecule()) )
+
+        (cnrg, ljnrg) = _reference_deltas(atoms, lamval, 0.01, shift_delta, coulomb_power)
+
+        if verbose:
+            print("lambda = %s, delta = %s, n = %s : %s %s  vs.  %s %s" % \
+                    (lamval, shift_delta, coulomb_power, coul_nrgs[i].average(),
+                     lj_nrgs[i].average(), cnrg, ljnrg))
+
+        # a single sample, so the free energy equals the energy difference
+        _assert_close( coul_nrgs[i].average(), cnrg )
+        _assert_close( lj_nrgs[i].average(), ljnrg )
+        _assert_close( total_nrgs[i].average(), cnrg + ljnrg )
+
+        i += 1
+
+def test_hard_core(verbose=False):
+    for lamval in [0.0, 0.3, 1.0]:
+        _test_monitor(lamval, 0.0, 0, verbose)
+
+def test_soft_core(verbose=False):
+    for (shift_delta, coulomb_power) in [ (1.1, 0), (2.0, 1), (1.5, 2), (0.0, 1) ]:
+        for lamval in [0.0, 0.25, 0.5, 0.95]:
+            _test_monitor(lamval, shift_delta, coulomb_power, verbose)
+
+if __name__ == "__main__":
+    test_hard_core(True)
+    test_soft_core(True)
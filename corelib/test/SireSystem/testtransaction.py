@@ -0,0 +1,179 @@
+
+from Sire.IO import *
+from Sire.MM import *
+from Sire.FF import *
+from Sire.Mol import *
+from Sire.Maths import *
+from Sire.System import *
+from Sire.Units import *
+
+from nose.tools import assert_equal, assert_almost_equal
+
+(molecules, space) = Amber().readCrdTop("test/io/SYSTEM.crd", "test/io/SYSTEM.top")
+
+molnums = molecules.molNums()
+molnums.sort()
+
+def _createSystem():
+    mols = MoleculeGroup("mols")
+
+    for molnum in molnums:
+        mols.add( molecules.molecule(molnum) )
+
+    cljff = InterCLJFF("cljff")
+    cljff.add(mols)
+
+    system = System()
+    system.add(cljff)
+    system.add(mols)
+    system.setProperty("space", space)
+
+    return system
+
+def _assert_restored(system, nrgs, version, mols, verbose):
+    """Assert that 'system' has exactly the energy components 'nrgs',
+       the version 'version' and the molecules 'mols' that it had before
+       the transaction was rolled back (the energies are restored, not
+       recalculated, so must be bit-identical)"""
+    new_nrgs = system.energies()
+
+    for symbol in nrgs.keys():
+        if verbose:
+            print("%s : %s versus %s" % (symbol, new_nrgs[symbol], nrgs[symbol]))
+
+        assert_equal( new_nrgs[symbol], nrgs[symbol] )
+
+    assert( new_nrgs == nrgs )
+    assert_equal( system.version(), version )
+
+    for mol in mols:
+        assert_equal( system[mol.number()].molecule().version(), mol.version() )
+        assert( system[mol.number()].molecule().property("coordinates") == \
+                        mol.property("coordinates") )
+
+def test_rollback(verbose=False):
+    system = _createSystem()
+
+    nrg = system.energy().value()
+    nrgs = system.energies()
+    version = system.version()
+    mol = system[molnums[0]].molecule()
+
+    system.beginTransaction()
+    assert( system.inTransaction() )
+
+    moved = mol.move().translate( Vector(1,0,0) ).commit()
+    system.update(moved)
+
+    new_nrg = system.energy().value()
+
+    system.rollbackTransaction()
+    assert( not system.inTransaction() )
+
+    old_nrg = system.energy().value()
+
+    if verbose:
+        print("Energy %s, after move %s, after rollback %s" % (nrg, new_nrg, old_nrg))
+
+    assert_equal( nrg, old_nrg )
+    _assert_restored(system, nrgs, version, [mol], verbose)
+
+def test_nested_rollback(verbose=False):
+    system = _createSystem()
+
+    nrgs = system.energies()
+    version = system.version()
+    mol0 = system[molnums[0]].molecule()
+    mol1 = system[molnums[1]].molecule()
+
+    system.beginTransaction()
+    system.update( mol0.move().translate( Vector(1,0,0) ).commit() )
+    system.energy()
+
+    # the inner transaction is committed into the outer transaction
+    system.beginTransaction()
+    assert_equal( system.transactionDepth(), 2 )
+    system.update( mol1.move().translate( Vector(0,1,0) ).commit() )
+    system.energy()
+    system.commitTransaction()
+    assert_equal( system.transactionDepth(), 1 )
+
+    # a second inner transaction is rolled back on its own
+    inner_nrgs = system.energies()
+    inner_version = system.version()
+    inner_mol0 = system[molnums[0]].molecule()
+
+    system.beginTransaction()
+    system.update( inner_mol0.move().translate( Vector(0,0,1) ).commit() )
+    system.energy()
+    system.rollbackTransaction()
+
+    _assert_restored(system, inner_nrgs, inner_version, [inner_mol0], verbose)
+
+    # rolling back the outer transaction undoes both moves
+    system.rollbackTransaction()
+    assert_equal( system.transactionDepth(), 0 )
+
+    _assert_restored(system, nrgs, version, [mol0, mol1], verbose)
+
+def test_commit(verbose=False):
+    system = _createSystem()
+    mol = system[molnums[0]].molecule()
+
+    system.beginTransaction()
+    moved = mol.move().translate( Vector(1,0,0) ).commit()
+    system.update(moved)
+    new_nrg = system.energy().value()
+    system.commitTransaction()
+    system.accept()
+
+    assert( not system.inTransaction() )
+
+    # rolling back after the commit should do nothing
+    system.rollbackTransaction()
+
+    # calculate the energy of the moved system from scratch
+    system.mustNowRecalculateFromScratch()
+    nrg = system.energy().value()
+
+    if verbose:
+        print("Energy after commit %s, from scratch %s" % (new_nrg, nrg))
+
+    assert_almost_equal( nrg, new_nrg, 5 )
+    assert( system[molnums[0]].molecule().property("coordinates") == \
+                    moved.property("coordinates") )
+
+def test_structural_rollback(verbose=False):
+    system = _createSystem()
+
+    nrg = system.energy().value()
+    nrgs = system.energies()
+    version = system.version()
+    nmols = system.nMolecules()
+    mol = system[molnums[0]].molecule()
+
+    system.beginTransaction()
+
+    # move one molecule, then remove another (which cannot be logged
+    # as a molecule change)
+    moved = mol.move().translate( Vector(1,0,0) ).commit()
+    system.update(moved)
+    system.remove( molnums[-1] )
+
+    assert( system.nMolecules() == nmols - 1 )
+
+    system.rollbackTransaction()
+
+    old_nrg = system.energy().value()
+
+    if verbose:
+        print("Energy %s, after rollback %s" % (nrg, old_nrg))
+
+    assert( system.nMolecules() == nmols )
+    _assert_restored(system, nrgs, version, [mol], verbose)
+
+if __name__ == "__main__":
+    test_rollback(True)
+    test_nested_rollback(True)
+    test_commit(True)
+    test_structural_rollback(True)
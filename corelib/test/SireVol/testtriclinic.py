@@ -0,0 +1,88 @@
+
+from Sire.Vol import *
+from Sire.Maths import *
+from Sire.Units import *
+
+from nose.tools import assert_almost_equal
+
+rangen = RanGenerator()
+
+def _randomPoint(size):
+    return Vector( rangen.rand(-size,size), rangen.rand(-size,size),
+                   rangen.rand(-size,size) )
+
+def test_cubic(verbose=False):
+    d = 25.0
+
+    tric = TriclinicBox.cubic(d)
+    box = PeriodicBox( Vector(d,d,d) )
+
+    assert_almost_equal( tric.volume().value(), box.volume().value(), 5 )
+
+    for i in range(0,1000):
+        p0 = _randomPoint(3*d)
+        p1 = _randomPoint(3*d)
+
+        if verbose and i == 0:
+            print("%s  %s" % (tric.calcDist(p0,p1), box.calcDist(p0,p1)))
+
+        assert_almost_equal( tric.calcDist(p0,p1), box.calcDist(p0,p1), 5 )
+
+def test_min_image(verbose=False):
+    d = 25.0
+
+    boxes = [ TriclinicBox.truncatedOctahedron(d),
+              TriclinicBox.rhombicDodecahedronSquare(d),
+              TriclinicBox.rhombicDodecahedronHexagon(d) ]
+
+    for box in boxes:
+        if verbose:
+            print("%s : volume %s, image distance %s" % (box, box.volume(),
+                                                         box.minimumImageDistance()))
+
+        assert_almost_equal( box.minimumImageDistance(), d, 5 )
+        assert( box.volume().value() < d*d*d )
+
+        for i in range(0,1000):
+            p0 = _randomPoint(3*d)
+            p1 = _randomPoint(3*d)
+
+            image = box.getMinimumImage(p0, p1)
+            dist = box.calcDist(p0, p1)
+
+            assert_almost_equal( dist, (image-p1).length(), 5 )
+
+            # no other periodic image can be closer than the minimum image
+            for v in [box.vector0(), box.vector1(), box.vector2(),
+                      box.vector0()+box.vector1(), box.vector0()-box.vector2(),
+                      box.vector1()+box.vector2()]:
+                assert( dist <= (image+v-p1).length() + 1e-6 )
+                assert( dist <= (image-v-p1).length() + 1e-6 )
+
+            # the minimum image must lie inside the enclosing box
+            mincoords = box.minCoords(p1)
+            maxcoords = box.maxCoords(p1)
+
+            for j in range(0,3):
+                assert( image[j] >= mincoords[j] - 1e-6 )
+                assert( image[j] <= maxcoords[j] + 1e-6 )
+
+def test_lengths_and_angles(verbose=False):
+    d = 25.0
+
+    box = TriclinicBox.truncatedOctahedron(d)
+
+    # this is how amber describes a truncated octahedral box
+    angle = 109.4712206 * degrees
+    amber = TriclinicBox(d, d, d, angle, angle, angle)
+
+    if verbose:
+        print("%s  %s" % (box.volume(), amber.volume()))
+
+    assert_almost_equal( box.volume().value(), amber.volume().value(), 3 )
+    assert_almost_equal( box.minimumImageDistance(), amber.minimumImageDistance(), 5 )
+
+if __name__ == "__main__":
+    test_cubic(True)
+    test_min_image(True)
+    test_lengths_and_angles(True)
@@ -0,0 +1,277 @@
+// This file has been generated by Py++.
+
+// (C) Christopher Woods, GPL >= 2 License
+
+#include "boost/python.hpp"
+#include "MBAR.pypp.hpp"
+
+namespace bp = boost::python;
+
+#include "SireError/errors.h"
+
+#include "SireMaths/errors.h"
+
+#include "SireMaths/nvector.h"
+
+#include "SireStream/datastream.h"
+
+#include "SireStream/shareddatastream.h"
+
+#include "SireUnits/temperature.h"
+
+#include "SireUnits/units.h"
+
+#include "mbar.h"
+
+#include "tostring.h"
+
+#include "mbar.h"
+
+SireAnalysis::MBAR __copy__(const SireAnalysis::MBAR &other){ return SireAnalysis::MBAR(other); }
+
+#include "Qt/qdatastream.hpp"
+
+#include "Helpers/str.hpp"
+
+void register_MBAR_class(){
+
+    { //::SireAnalysis::MBAR
+        typedef bp::class_< SireAnalysis::MBAR, bp::bases< SireBase::Property > > MBAR_exposer_t;
+        MBAR_exposer_t MBAR_exposer = MBAR_exposer_t( "MBAR", bp::init< >() );
+        bp::scope MBAR_scope( MBAR_exposer );
+        MBAR_exposer.def( bp::init< QList< double > const & >(( bp::arg("lambda_values") )) );
+        MBAR_exposer.def( bp::init< QList< double > const &, SireUnits::Dimension::Temperature const & >(( bp::arg("lambda_values"), bp::arg("temperature") )) );
+        MBAR_exposer.def( bp::init< SireAnalysis::MBAR const & >(( bp::arg("other") )) );
+        { //::SireAnalysis::MBAR::add
+        
+            typedef void ( ::SireAnalysis::MBAR::*add_function_type )( double,::QVector< double > const & ) ;
+            add_function_type add_function_value( &::SireAnalysis::MBAR::add );
+            
+            MBAR_exposer.def( 
+                "add"
+                , add_function_value
+                , ( bp::arg("lambda"), bp::arg("energies") ) );
+        
+        }
+        { //::SireAnalysis::MBAR::add
+        
+            typedef void ( ::SireAnalysis::MBAR::*add_function_type )( ::SireAnalysis::MBAR const & ) ;
+            add_function_type add_function_value( &::SireAnalysis::MBAR::add );
+            
+            MBAR_exposer.def( 
+                "add"
+                , add_function_value
+                , ( bp::arg("other") ) );
+        
+        }
+        { //::SireAnalysis::MBAR::clear
+        
+            typedef void ( ::SireAnalysis::MBAR::*clear_function_type )(  ) ;
+            clear_function_type clear_function_value( &::SireAnalysis::MBAR::clear );
+            
+            MBAR_exposer.def( 
+                "clear"
+                , clear_function_value );
+        
+        }
+        { //::SireAnalysis::MBAR::isEmpty
+        
+            typedef bool ( ::SireAnalysis::MBAR::*isEmpty_function_type )(  ) const;
+            isEmpty_function_type isEmpty_function_value( &::SireAnalysis::MBAR::isEmpty );
+            
+            MBAR_exposer.def( 
+                "isEmpty"
+                , isEmpty_function_value );
+        
+        }
+        { //::SireAnalysis::MBAR::lambdaValues
+        
+            typedef ::QList< double > ( ::SireAnalysis::MBAR::*lambdaValues_function_type )(  ) const;
+            lambdaValues_function_type lambdaValues_function_value( &::SireAnalysis::MBAR::lambdaValues );
+            
+            MBAR_exposer.def( 
+                "lambdaValues"
+                , lambdaValues_function_value );
+        
+        }
+        { //::SireAnalysis::MBAR::maximumIterations
+        
+            typedef int ( ::SireAnalysis::MBAR::*maximumIterations_function_type )(  ) const;
+            maximumIterations_function_type maximumIterations_function_value( &::SireAnalysis::MBAR::maximumIterations );
+            
+            MBAR_exposer.def( 
+                "maximumIterations"
+                , maximumIterations_function_value );
+        
+        }
+        { //::SireAnalysis::MBAR::maximumMemory
+        
+            typedef ::qint64 ( ::SireAnalysis::MBAR::*maximumMemory_function_type )(  ) const;
+            maximumMemory_function_type maximumMemory_function_value( &::SireAnalysis::MBAR::maximumMemory );
+            
+            MBAR_exposer.def( 
+                "maximumMemory"
+                , maximumMemory_function_value );
+        
+        }
+        { //::SireAnalysis::MBAR::nLambdaValues
+        
+            typedef int ( ::SireAnalysis::MBAR::*nLambdaValues_function_type )(  ) const;
+            nLambdaValues_function_type nLambdaValues_function_value( &::SireAnalysis::MBAR::nLambdaValues );
+            
+            MBAR_exposer.def( 
+                "nLambdaValues"
+                , nLambdaValues_function_value );
+        
+        }
+        { //::SireAnalysis::MBAR::nSamples
+        
+            typedef ::qint64 ( ::SireAnalysis::MBAR::*nSamples_function_type )(  ) const;
+            nSamples_function_type nSamples_function_value( &::SireAnalysis::MBAR::nSamples );
+            
+            MBAR_exposer.def( 
+                "nSamples"
+                , nSamples_function_value );
+        
+        }
+        { //::SireAnalysis::MBAR::nSamples
+        
+            typedef ::qint64 ( ::SireAnalysis::MBAR::*nSamples_function_type )( double ) const;
+            nSamples_function_type nSamples_function_value( &::SireAnalysis::MBAR::nSamples );
+            
+            MBAR_exposer.def( 
+                "nSamples"
+                , nSamples_function_value
+                , ( bp::arg("lambda") ) );
+        
+        }
+        MBAR_exposer.def( bp::self != bp::self );
+        { //::SireAnalysis::MBAR::operator=
+        
+            typedef ::SireAnalysis::MBAR & ( ::SireAnalysis::MBAR::*assign_function_type )( ::SireAnalysis::MBAR const & ) ;
+            assign_function_type assign_function_value( &::SireAnalysis::MBAR::operator= );
+            
+            MBAR_exposer.def( 
+                "assign"
+                , assign_function_value
+                , ( bp::arg("other") )
+                , bp::return_self< >() );
+        
+        }
+        MBAR_exposer.def( bp::self == bp::self );
+        { //::SireAnalysis::MBAR::overlapMatrix
+        
+            typedef ::SireMaths::NMatrix ( ::SireAnalysis::MBAR::*overlapMatrix_function_type )(  ) const;
+            overlapMatrix_function_type overlapMatrix_function_value( &::SireAnalysis::MBAR::overlapMatrix );
+            
+            MBAR_exposer.def( 
+                "overlapMatrix"
+                , overlapMatrix_function_value );
+        
+        }
+        { //::SireAnalysis::MBAR::pmf
+        
+            typedef ::SireAnalysis::PMF ( ::SireAnalysis::MBAR::*pmf_function_type )(  ) const;
+            pmf_function_type pmf_function_value( &::SireAnalysis::MBAR::pmf );
+            
+            MBAR_exposer.def( 
+                "pmf"
+                , pmf_function_value );
+        
+        }
+        { //::SireAnalysis::MBAR::setMaximumIterations
+        
+            typedef void ( ::SireAnalysis::MBAR::*setMaximumIterations_function_type )( int ) ;
+            setMaximumIterations_function_type setMaximumIterations_function_value( &::SireAnalysis::MBAR::setMaximumIterations );
+            
+            MBAR_exposer.def( 
+                "setMaximumIterations"
+                , setMaximumIterations_function_value
+                , ( bp::arg("niterations") ) );
+        
+        }
+        { //::SireAnalysis::MBAR::setMaximumMemory
+        
+            typedef void ( ::SireAnalysis::MBAR::*setMaximumMemory_function_type )( ::qint64 ) ;
+            setMaximumMemory_function_type setMaximumMemory_function_value( &::SireAnalysis::MBAR::setMaximumMemory );
+            
+            MBAR_exposer.def( 
+                "setMaximumMemory"
+                , setMaximumMemory_function_value
+                , ( bp::arg("nbytes") ) );
+        
+        }
+        { //::SireAnalysis::MBAR::setTolerance
+        
+            typedef void ( ::SireAnalysis::MBAR::*setTolerance_function_type )( double ) ;
+            setTolerance_function_type setTolerance_function_value( &::SireAnalysis::MBAR::setTolerance );
+            
+            MBAR_exposer.def( 
+                "setTolerance"
+                , setTolerance_function_value
+                , ( bp::arg("tolerance") ) );
+        
+        }
+        { //::SireAnalysis::MBAR::temperature
+        
+            typedef ::SireUnits::Dimension::Temperature ( ::SireAnalysis::MBAR::*temperature_function_type )(  ) const;
+            temperature_function_type temperature_function_value( &::SireAnalysis::MBAR::temperature );
+            
+            MBAR_exposer.def( 
+                "temperature"
+                , temperature_function_value );
+        
+        }
+        { //::SireAnalysis::MBAR::toString
+        
+            typedef ::QString ( ::SireAnalysis::MBAR::*toString_function_type )(  ) const;
+            toString_function_type toString_function_value( &::SireAnalysis::MBAR::toString );
+            
+            MBAR_exposer.def( 
+                "toString"
+                , toString_function_value );
+        
+        }
+        { //::SireAnalysis::MBAR::tolerance
+        
+            typedef double ( ::SireAnalysis::MBAR::*tolerance_function_type )(  ) const;
+            tolerance_function_type tolerance_function_value( &::SireAnalysis::MBAR::tolerance );
+            
+            MBAR_exposer.def( 
+                "tolerance"
+                , tolerance_function_value );
+        
+        }
+        { //::SireAnalysis::MBAR::typeName
+        
+            typedef char const * ( *typeName_function_type )(  );
+            typeName_function_type typeName_function_value( &::SireAnalysis::MBAR::typeName );
+            
+            MBAR_exposer.def( 
+                "typeName"
+                , typeName_function_value );
+        
+        }
+        { //::SireAnalysis::MBAR::what
+        
+            typedef char const * ( ::SireAnalysis::MBAR::*what_function_type )(  ) const;
+            what_function_type what_function_value( &::SireAnalysis::MBAR::what );
+            
+            MBAR_exposer.def( 
+                "what"
+                , what_function_value );
+        
+        }
+        MBAR_exposer.staticmethod( "typeName" );
+        MBAR_exposer.def( "__copy__", &__copy__);
+        MBAR_exposer.def( "__deepcopy__", &__copy__);
+        MBAR_exposer.def( "clone", &__copy__);
+        MBAR_exposer.def( "__rlshift__", &__rlshift__QDataStream< ::SireAnalysis::MBAR >,
+                            bp::return_internal_reference<1, bp::with_custodian_and_ward<1,2> >() );
+        MBAR_exposer.def( "__rrshift__", &__rrshift__QDataStream< ::SireAnalysis::MBAR >,
+                            bp::return_internal_reference<1, bp::with_custodian_and_ward<1,2> >() );
+        MBAR_exposer.def( "__str__", &__str__< ::SireAnalysis::MBAR > );
+        MBAR_exposer.def( "__repr__", &__str__< ::SireAnalysis::MBAR > );
+    }
+
+}
@@ -0,0 +1,10 @@
+// This file has been generated by Py++.
+
+// (C) Christopher Woods, GPL >= 2 License
+
+#ifndef MBAR_hpp__pyplusplus_wrapper
+#define MBAR_hpp__pyplusplus_wrapper
+
+void register_MBAR_class();
+
+#endif//MBAR_hpp__pyplusplus_wrapper
@@ -6,6 +6,7 @@
 #include "ticomponents.h"
 #include "bennetts.h"
 #include "fep.h"
+#include "mbar.h"
 #include "ti.h"
 
 #include "Helpers/objectregistry.hpp"
@@ -24,6 +25,7 @@ void register_SireAnalysis_objects()
     ObjectRegistry::registerConverterFor< SireAnalysis::Gradients >();
     ObjectRegistry::registerConverterFor< SireAnalysis::TI >();
     ObjectRegistry::registerConverterFor< SireAnalysis::TIPMF >();
+    ObjectRegistry::registerConverterFor< SireAnalysis::MBAR >();
 
 }
 
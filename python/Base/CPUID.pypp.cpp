@@ -49,6 +49,16 @@ void register_CPUID_class(){
                 "clockSpeed"
                 , clockSpeed_function_value );
         
+        }
+        { //::SireBase::CPUID::compiledVectorisation
+        
+            typedef ::QString ( ::SireBase::CPUID::*compiledVectorisation_function_type )(  ) const;
+            compiledVectorisation_function_type compiledVectorisation_function_value( &::SireBase::CPUID::compiledVectorisation );
+            
+            CPUID_exposer.def( 
+                "compiledVectorisation"
+                , compiledVectorisation_function_value );
+        
         }
         { //::SireBase::CPUID::numCores
         
@@ -114,6 +124,26 @@ void register_CPUID_class(){
                 "supportsAVX"
                 , supportsAVX_function_value );
         
+        }
+        { //::SireBase::CPUID::supportsAVX2
+        
+            typedef bool ( ::SireBase::CPUID::*supportsAVX2_function_type )(  ) const;
+            supportsAVX2_function_type supportsAVX2_function_value( &::SireBase::CPUID::supportsAVX2 );
+            
+            CPUID_exposer.def( 
+                "supportsAVX2"
+                , supportsAVX2_function_value );
+        
+        }
+        { //::SireBase::CPUID::supportsAVX512F
+        
+            typedef bool ( ::SireBase::CPUID::*supportsAVX512F_function_type )(  ) const;
+            supportsAVX512F_function_type supportsAVX512F_function_value( &::SireBase::CPUID::supportsAVX512F );
+            
+            CPUID_exposer.def( 
+                "supportsAVX512F"
+                , supportsAVX512F_function_value );
+        
         }
         { //::SireBase::CPUID::supportsSSE2
         
@@ -124,6 +154,16 @@ void register_CPUID_class(){
                 "supportsSSE2"
                 , supportsSSE2_function_value );
         
+        }
+        { //::SireBase::CPUID::supportsCompiledVectorisation
+        
+            typedef bool ( ::SireBase::CPUID::*supportsCompiledVectorisation_function_type )(  ) const;
+            supportsCompiledVectorisation_function_type supportsCompiledVectorisation_function_value( &::SireBase::CPUID::supportsCompiledVectorisation );
+            
+            CPUID_exposer.def( 
+                "supportsCompiledVectorisation"
+                , supportsCompiledVectorisation_function_value );
+        
         }
         { //::SireBase::CPUID::toString
         
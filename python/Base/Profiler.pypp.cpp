@@ -0,0 +1,262 @@
+// This file has been generated by Py++.
+
+// (C) Christopher Woods, GPL >= 2 License
+
+#include "boost/python.hpp"
+#include "Profiler.pypp.hpp"
+
+namespace bp = boost::python;
+
+#include "SireError/errors.h"
+
+#include "profiler.h"
+
+#include <QCoreApplication>
+
+#include <QElapsedTimer>
+
+#include <QFile>
+
+#include <QHash>
+
+#include <QJsonArray>
+
+#include <QJsonDocument>
+
+#include <QJsonObject>
+
+#include <QList>
+
+#include <QMap>
+
+#include <QMutex>
+
+#include <QThreadStorage>
+
+#include <QVector>
+
+#include <boost/shared_ptr.hpp>
+
+#include <cstdlib>
+
+#include <limits>
+
+#include "profiler.h"
+
+void register_Profiler_class(){
+
+    { //::SireBase::Profiler
+        typedef bp::class_< SireBase::Profiler > Profiler_exposer_t;
+        Profiler_exposer_t Profiler_exposer = Profiler_exposer_t( "Profiler", bp::init< >() );
+        bp::scope Profiler_scope( Profiler_exposer );
+        { //::SireBase::Profiler::addCount
+        
+            typedef void ( *addCount_function_type )( char const *, ::qint64 );
+            addCount_function_type addCount_function_value( &::SireBase::Profiler::addCount );
+            
+            Profiler_exposer.def( 
+                "addCount"
+                , addCount_function_value
+                , ( bp::arg("name"), bp::arg("n")=(::qint64)(1) ) );
+        
+        }
+        { //::SireBase::Profiler::clear
+        
+            typedef void ( *clear_function_type )(  );
+            clear_function_type clear_function_value( &::SireBase::Profiler::clear );
+            
+            Profiler_exposer.def( 
+                "clear"
+                , clear_function_value );
+        
+        }
+        { //::SireBase::Profiler::count
+        
+            typedef ::qint64 ( *count_function_type )( ::QString const & );
+            count_function_type count_function_value( &::SireBase::Profiler::count );
+            
+            Profiler_exposer.def( 
+                "count"
+                , count_function_value
+                , ( bp::arg("name") ) );
+        
+        }
+        { //::SireBase::Profiler::counterNames
+        
+            typedef ::QStringList ( *counterNames_function_type )(  );
+            counterNames_function_type counterNames_function_value( &::SireBase::Profiler::counterNames );
+            
+            Profiler_exposer.def( 
+                "counterNames"
+                , counterNames_function_value );
+        
+        }
+        { //::SireBase::Profiler::isEnabled
+        
+            typedef bool ( *isEnabled_function_type )(  );
+            isEnabled_function_type isEnabled_function_value( &::SireBase::Profiler::isEnabled );
+            
+            Profiler_exposer.def( 
+                "isEnabled"
+                , isEnabled_function_value );
+        
+        }
+        { //::SireBase::Profiler::isTracing
+        
+            typedef bool ( *isTracing_function_type )(  );
+            isTracing_function_type isTracing_function_value( &::SireBase::Profiler::isTracing );
+            
+            Profiler_exposer.def( 
+                "isTracing"
+                , isTracing_function_value );
+        
+        }
+        { //::SireBase::Profiler::maximumTime
+        
+            typedef double ( *maximumTime_function_type )( ::QString const & );
+            maximumTime_function_type maximumTime_function_value( &::SireBase::Profiler::maximumTime );
+            
+            Profiler_exposer.def( 
+                "maximumTime"
+                , maximumTime_function_value
+                , ( bp::arg("name") ) );
+        
+        }
+        { //::SireBase::Profiler::minimumTime
+        
+            typedef double ( *minimumTime_function_type )( ::QString const & );
+            minimumTime_function_type minimumTime_function_value( &::SireBase::Profiler::minimumTime );
+            
+            Profiler_exposer.def( 
+                "minimumTime"
+                , minimumTime_function_value
+                , ( bp::arg("name") ) );
+        
+        }
+        { //::SireBase::Profiler::nCalls
+        
+            typedef ::qint64 ( *nCalls_function_type )( ::QString const & );
+            nCalls_function_type nCalls_function_value( &::SireBase::Profiler::nCalls );
+            
+            Profiler_exposer.def( 
+                "nCalls"
+                , nCalls_function_value
+                , ( bp::arg("name") ) );
+        
+        }
+        { //::SireBase::Profiler::report
+        
+            typedef ::QString ( *report_function_type )(  );
+            report_function_type report_function_value( &::SireBase::Profiler::report );
+            
+            Profiler_exposer.def( 
+                "report"
+                , report_function_value );
+        
+        }
+        { //::SireBase::Profiler::saveChromeTrace
+        
+            typedef void ( *saveChromeTrace_function_type )( ::QString const & );
+            saveChromeTrace_function_type saveChromeTrace_function_value( &::SireBase::Profiler::saveChromeTrace );
+            
+            Profiler_exposer.def( 
+                "saveChromeTrace"
+                , saveChromeTrace_function_value
+                , ( bp::arg("filename") ) );
+        
+        }
+        { //::SireBase::Profiler::saveJSON
+        
+            typedef void ( *saveJSON_function_type )( ::QString const & );
+            saveJSON_function_type saveJSON_function_value( &::SireBase::Profiler::saveJSON );
+            
+            Profiler_exposer.def( 
+                "saveJSON"
+                , saveJSON_function_value
+                , ( bp::arg("filename") ) );
+        
+        }
+        { //::SireBase::Profiler::setEnabled
+        
+            typedef void ( *setEnabled_function_type )( bool );
+            setEnabled_function_type setEnabled_function_value( &::SireBase::Profiler::setEnabled );
+            
+            Profiler_exposer.def( 
+                "setEnabled"
+                , setEnabled_function_value
+                , ( bp::arg("on") ) );
+        
+        }
+        { //::SireBase::Profiler::setTracing
+        
+            typedef void ( *setTracing_function_type )( bool );
+            setTracing_function_type setTracing_function_value( &::SireBase::Profiler::setTracing );
+            
+            Profiler_exposer.def( 
+                "setTracing"
+                , setTracing_function_value
+                , ( bp::arg("on") ) );
+        
+        }
+        { //::SireBase::Profiler::timerNames
+        
+            typedef ::QStringList ( *timerNames_function_type )(  );
+            timerNames_function_type timerNames_function_value( &::SireBase::Profiler::timerNames );
+            
+            Profiler_exposer.def( 
+                "timerNames"
+                , timerNames_function_value );
+        
+        }
+        { //::SireBase::Profiler::toChromeTrace
+        
+            typedef ::QString ( *toChromeTrace_function_type )(  );
+            toChromeTrace_function_type toChromeTrace_function_value( &::SireBase::Profiler::toChromeTrace );
+            
+            Profiler_exposer.def( 
+                "toChromeTrace"
+                , toChromeTrace_function_value );
+        
+        }
+        { //::SireBase::Profiler::toJSON
+        
+            typedef ::QString ( *toJSON_function_type )(  );
+            toJSON_function_type toJSON_function_value( &::SireBase::Profiler::toJSON );
+            
+            Profiler_exposer.def( 
+                "toJSON"
+                , toJSON_function_value );
+        
+        }
+        { //::SireBase::Profiler::totalTime
+        
+            typedef double ( *totalTime_function_type )( ::QString const & );
+            totalTime_function_type totalTime_function_value( &::SireBase::Profiler::totalTime );
+            
+            Profiler_exposer.def( 
+                "totalTime"
+                , totalTime_function_value
+                , ( bp::arg("name") ) );
+        
+        }
+        Profiler_exposer.staticmethod( "addCount" );
+        Profiler_exposer.staticmethod( "clear" );
+        Profiler_exposer.staticmethod( "count" );
+        Profiler_exposer.staticmethod( "counterNames" );
+        Profiler_exposer.staticmethod( "isEnabled" );
+        Profiler_exposer.staticmethod( "isTracing" );
+        Profiler_exposer.staticmethod( "maximumTime" );
+        Profiler_exposer.staticmethod( "minimumTime" );
+        Profiler_exposer.staticmethod( "nCalls" );
+        Profiler_exposer.staticmethod( "report" );
+        Profiler_exposer.staticmethod( "saveChromeTrace" );
+        Profiler_exposer.staticmethod( "saveJSON" );
+        Profiler_exposer.staticmethod( "setEnabled" );
+        Profiler_exposer.staticmethod( "setTracing" );
+        Profiler_exposer.staticmethod( "timerNames" );
+        Profiler_exposer.staticmethod( "toChromeTrace" );
+        Profiler_exposer.staticmethod( "toJSON" );
+        Profiler_exposer.staticmethod( "totalTime" );
+    }
+
+}
@@ -0,0 +1,10 @@
+// This file has been generated by Py++.
+
+// (C) Christopher Woods, GPL >= 2 License
+
+#ifndef Profiler_hpp__pyplusplus_wrapper
+#define Profiler_hpp__pyplusplus_wrapper
+
+void register_Profiler_class();
+
+#endif//Profiler_hpp__pyplusplus_wrapper
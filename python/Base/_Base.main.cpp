@@ -63,6 +63,8 @@
 
 #include "Process.pypp.hpp"
 
+#include "Profiler.pypp.hpp"
+
 #include "Properties.pypp.hpp"
 
 #include "Property.pypp.hpp"
@@ -172,6 +174,8 @@ BOOST_PYTHON_MODULE(_Base){
 
     register_Process_class();
 
+    register_Profiler_class();
+
     register_Properties_class();
 
     register_PropertyList_class();
@@ -21,6 +21,7 @@
 #include "numberproperty.h"
 #include "packedarrays.h"
 #include "process.h"
+#include "profiler.h"
 #include "properties.h"
 #include "property.h"
 #include "propertylist.h"
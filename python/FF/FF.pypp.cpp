@@ -244,6 +244,16 @@ void register_FF_class(){
                 , addIfUnique_function_value
                 , ( bp::arg("molgroup"), bp::arg("mgid") ) );
         
+        }
+        { //::SireFF::FF::canRestoreEnergies
+        
+            typedef bool ( ::SireFF::FF::*canRestoreEnergies_function_type )(  ) const;
+            canRestoreEnergies_function_type canRestoreEnergies_function_value( &::SireFF::FF::canRestoreEnergies );
+            
+            FF_exposer.def( 
+                "canRestoreEnergies"
+                , canRestoreEnergies_function_value );
+        
         }
         { //::SireFF::FF::components
         
@@ -266,6 +276,17 @@ void register_FF_class(){
                 , containsProperty_function_value
                 , ( bp::arg("name") ) );
         
+        }
+        { //::SireFF::FF::currentEnergies
+        
+            typedef ::SireCAS::Values const & ( ::SireFF::FF::*currentEnergies_function_type )(  ) const;
+            currentEnergies_function_type currentEnergies_function_value( &::SireFF::FF::currentEnergies );
+            
+            FF_exposer.def( 
+                "currentEnergies"
+                , currentEnergies_function_value
+                , bp::return_value_policy< bp::copy_const_reference >() );
+        
         }
         { //::SireFF::FF::energies
         
@@ -516,6 +537,17 @@ void register_FF_class(){
                 , removeAll_function_value
                 , ( bp::arg("molgroup"), bp::arg("mgid") ) );
         
+        }
+        { //::SireFF::FF::restoreEnergies
+        
+            typedef void ( ::SireFF::FF::*restoreEnergies_function_type )( ::SireCAS::Values const &,::quint64 ) ;
+            restoreEnergies_function_type restoreEnergies_function_value( &::SireFF::FF::restoreEnergies );
+            
+            FF_exposer.def( 
+                "restoreEnergies"
+                , restoreEnergies_function_value
+                , ( bp::arg("energies"), bp::arg("version") ) );
+        
         }
         { //::SireFF::FF::setContents
         
@@ -568,6 +568,26 @@ void register_ForceFields_class(){
                 , containsProperty_function_value
                 , ( bp::arg("ffid"), bp::arg("name") ) );
         
+        }
+        { //::SireFF::ForceFields::disableParallelCalculation
+        
+            typedef void ( ::SireFF::ForceFields::*disableParallelCalculation_function_type )(  ) ;
+            disableParallelCalculation_function_type disableParallelCalculation_function_value( &::SireFF::ForceFields::disableParallelCalculation );
+            
+            ForceFields_exposer.def( 
+                "disableParallelCalculation"
+                , disableParallelCalculation_function_value );
+        
+        }
+        { //::SireFF::ForceFields::enableParallelCalculation
+        
+            typedef void ( ::SireFF::ForceFields::*enableParallelCalculation_function_type )(  ) ;
+            enableParallelCalculation_function_type enableParallelCalculation_function_value( &::SireFF::ForceFields::enableParallelCalculation );
+            
+            ForceFields_exposer.def( 
+                "enableParallelCalculation"
+                , enableParallelCalculation_function_value );
+        
         }
         { //::SireFF::ForceFields::energies
         
@@ -1437,6 +1457,28 @@ void register_ForceFields_class(){
                 , removeProperty_function_value
                 , ( bp::arg("name") ) );
         
+        }
+        { //::SireFF::ForceFields::restoreEnergies
+        
+            typedef void ( ::SireFF::ForceFields::*restoreEnergies_function_type )( ::SireFF::FFIdx const &,::SireCAS::Values const &,::quint64 ) ;
+            restoreEnergies_function_type restoreEnergies_function_value( &::SireFF::ForceFields::restoreEnergies );
+            
+            ForceFields_exposer.def( 
+                "restoreEnergies"
+                , restoreEnergies_function_value
+                , ( bp::arg("ffidx"), bp::arg("energies"), bp::arg("version") ) );
+        
+        }
+        { //::SireFF::ForceFields::restoreForceField
+        
+            typedef void ( ::SireFF::ForceFields::*restoreForceField_function_type )( ::SireFF::FFIdx const &,::SireFF::FF const & ) ;
+            restoreForceField_function_type restoreForceField_function_value( &::SireFF::ForceFields::restoreForceField );
+            
+            ForceFields_exposer.def( 
+                "restoreForceField"
+                , restoreForceField_function_value
+                , ( bp::arg("ffidx"), bp::arg("forcefield") ) );
+        
         }
         { //::SireFF::ForceFields::setComponent
         
@@ -1602,6 +1644,17 @@ void register_ForceFields_class(){
                 , setProperty_function_value
                 , ( bp::arg("ffid"), bp::arg("name"), bp::arg("value") ) );
         
+        }
+        { //::SireFF::ForceFields::setUseParallelCalculation
+        
+            typedef void ( ::SireFF::ForceFields::*setUseParallelCalculation_function_type )( bool ) ;
+            setUseParallelCalculation_function_type setUseParallelCalculation_function_value( &::SireFF::ForceFields::setUseParallelCalculation );
+            
+            ForceFields_exposer.def( 
+                "setUseParallelCalculation"
+                , setUseParallelCalculation_function_value
+                , ( bp::arg("on") ) );
+        
         }
         { //::SireFF::ForceFields::toString
         
@@ -1688,6 +1741,16 @@ void register_ForceFields_class(){
                 , ( bp::arg("name") )
                 , bp::return_value_policy<bp::clone_const_reference>() );
         
+        }
+        { //::SireFF::ForceFields::usesParallelCalculation
+        
+            typedef bool ( ::SireFF::ForceFields::*usesParallelCalculation_function_type )(  ) const;
+            usesParallelCalculation_function_type usesParallelCalculation_function_value( &::SireFF::ForceFields::usesParallelCalculation );
+            
+            ForceFields_exposer.def( 
+                "usesParallelCalculation"
+                , usesParallelCalculation_function_value );
+        
         }
         ForceFields_exposer.staticmethod( "totalComponent" );
         ForceFields_exposer.staticmethod( "typeName" );
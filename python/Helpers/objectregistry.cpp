@@ -7,6 +7,8 @@
 
 #include "SireStream/streamdata.hpp"
 
+#include "SireBase/profiler.h"
+
 #include "SireError/errors.h"
 
 using boost::python::object;
@@ -72,11 +74,13 @@ object ObjectRegistry::getObjects(
 
 object ObjectRegistry::load(const QByteArray &data)
 {
+    SIRE_PROFILE("SireStream::load");
     return ObjectRegistry::getObjects( SireStream::load(data) );
 }
 
 object ObjectRegistry::load(const QString &filename)
 {
+    SIRE_PROFILE("SireStream::load");
     return ObjectRegistry::getObjects( SireStream::load(filename) );
 }
 
@@ -143,6 +147,8 @@ ObjectRegistry::getObjectsFromPython(const object &obj)
 
 QByteArray ObjectRegistry::save(const object &obj)
 {
+    SIRE_PROFILE("SireStream::save");
+
     QList< boost::tuple<shared_ptr<void>,QString> > 
                                     objects_t = getObjectsFromPython(obj);
     
@@ -151,6 +157,8 @@ QByteArray ObjectRegistry::save(const object &obj)
 
 void ObjectRegistry::save(const object &obj, const QString &filename)
 {
+    SIRE_PROFILE("SireStream::save");
+
     QList< boost::tuple<shared_ptr<void>,QString> > 
                                     objects_t = getObjectsFromPython(obj);
     
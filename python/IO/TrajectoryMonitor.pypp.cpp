@@ -97,6 +97,27 @@ void register_TrajectoryMonitor_class(){
                 , setTempDir_function_value
                 , ( bp::arg("tempdir") ) );
         
+        }
+        { //::SireIO::TrajectoryMonitor::setTrajectoryFile
+        
+            typedef void ( ::SireIO::TrajectoryMonitor::*setTrajectoryFile_function_type )( ::QString const &,double ) ;
+            setTrajectoryFile_function_type setTrajectoryFile_function_value( &::SireIO::TrajectoryMonitor::setTrajectoryFile );
+            
+            TrajectoryMonitor_exposer.def( 
+                "setTrajectoryFile"
+                , setTrajectoryFile_function_value
+                , ( bp::arg("filename"), bp::arg("precision")=0.001 ) );
+        
+        }
+        { //::SireIO::TrajectoryMonitor::trajectoryFile
+        
+            typedef ::QString ( ::SireIO::TrajectoryMonitor::*trajectoryFile_function_type )(  ) const;
+            trajectoryFile_function_type trajectoryFile_function_value( &::SireIO::TrajectoryMonitor::trajectoryFile );
+            
+            TrajectoryMonitor_exposer.def( 
+                "trajectoryFile"
+                , trajectoryFile_function_value );
+        
         }
         { //::SireIO::TrajectoryMonitor::typeName
         
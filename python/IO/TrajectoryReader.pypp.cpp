@@ -0,0 +1,233 @@
+// This file has been generated by Py++.
+
+// (C) Christopher Woods, GPL >= 2 License
+
+#include "boost/python.hpp"
+#include "TrajectoryReader.pypp.hpp"
+
+namespace bp = boost::python;
+
+#include "SireError/errors.h"
+
+#include "SireMol/atomcoords.h"
+
+#include "SireMol/molecule.h"
+
+#include "SireMol/moleditor.h"
+
+#include "SireVol/cartesian.h"
+
+#include "SireVol/periodicbox.h"
+
+#include "SireVol/triclinicbox.h"
+
+#include <QFile>
+
+#include "trajectoryfile.h"
+
+#include "trajectoryfile.h"
+
+SireIO::TrajectoryReader __copy__(const SireIO::TrajectoryReader &other){ return SireIO::TrajectoryReader(other); }
+
+#include "Helpers/str.hpp"
+
+#include "Helpers/len.hpp"
+
+void register_TrajectoryReader_class(){
+
+    { //::SireIO::TrajectoryReader
+        typedef bp::class_< SireIO::TrajectoryReader > TrajectoryReader_exposer_t;
+        TrajectoryReader_exposer_t TrajectoryReader_exposer = TrajectoryReader_exposer_t( "TrajectoryReader", bp::init< >() );
+        bp::scope TrajectoryReader_scope( TrajectoryReader_exposer );
+        TrajectoryReader_exposer.def( bp::init< QString const & >(( bp::arg("filename") )) );
+        TrajectoryReader_exposer.def( bp::init< SireIO::TrajectoryReader const & >(( bp::arg("other") )) );
+        { //::SireIO::TrajectoryReader::at
+        
+            typedef ::QVector< SireMaths::Vector > ( ::SireIO::TrajectoryReader::*at_function_type )( int ) const;
+            at_function_type at_function_value( &::SireIO::TrajectoryReader::at );
+            
+            TrajectoryReader_exposer.def( 
+                "at"
+                , at_function_value
+                , ( bp::arg("i") ) );
+        
+        }
+        { //::SireIO::TrajectoryReader::coordinates
+        
+            typedef ::QVector< SireMaths::Vector > ( ::SireIO::TrajectoryReader::*coordinates_function_type )( int ) const;
+            coordinates_function_type coordinates_function_value( &::SireIO::TrajectoryReader::coordinates );
+            
+            TrajectoryReader_exposer.def( 
+                "coordinates"
+                , coordinates_function_value
+                , ( bp::arg("i") ) );
+        
+        }
+        { //::SireIO::TrajectoryReader::count
+        
+            typedef int ( ::SireIO::TrajectoryReader::*count_function_type )(  ) const;
+            count_function_type count_function_value( &::SireIO::TrajectoryReader::count );
+            
+            TrajectoryReader_exposer.def( 
+                "count"
+                , count_function_value );
+        
+        }
+        { //::SireIO::TrajectoryReader::filename
+        
+            typedef ::QString ( ::SireIO::TrajectoryReader::*filename_function_type )(  ) const;
+            filename_function_type filename_function_value( &::SireIO::TrajectoryReader::filename );
+            
+            TrajectoryReader_exposer.def( 
+                "filename"
+                , filename_function_value );
+        
+        }
+        { //::SireIO::TrajectoryReader::frame
+        
+            typedef ::SireMol::MoleculeGroup ( ::SireIO::TrajectoryReader::*frame_function_type )( int,::SireMol::MoleculeGroup const &,::SireBase::PropertyMap const & ) const;
+            frame_function_type frame_function_value( &::SireIO::TrajectoryReader::frame );
+            
+            TrajectoryReader_exposer.def( 
+                "frame"
+                , frame_function_value
+                , ( bp::arg("i"), bp::arg("molgroup"), bp::arg("map")=SireBase::PropertyMap() ) );
+        
+        }
+        { //::SireIO::TrajectoryReader::hasSpace
+        
+            typedef bool ( ::SireIO::TrajectoryReader::*hasSpace_function_type )( int ) const;
+            hasSpace_function_type hasSpace_function_value( &::SireIO::TrajectoryReader::hasSpace );
+            
+            TrajectoryReader_exposer.def( 
+                "hasSpace"
+                , hasSpace_function_value
+                , ( bp::arg("i") ) );
+        
+        }
+        { //::SireIO::TrajectoryReader::isNull
+        
+            typedef bool ( ::SireIO::TrajectoryReader::*isNull_function_type )(  ) const;
+            isNull_function_type isNull_function_value( &::SireIO::TrajectoryReader::isNull );
+            
+            TrajectoryReader_exposer.def( 
+                "isNull"
+                , isNull_function_value );
+        
+        }
+        { //::SireIO::TrajectoryReader::nAtoms
+        
+            typedef int ( ::SireIO::TrajectoryReader::*nAtoms_function_type )(  ) const;
+            nAtoms_function_type nAtoms_function_value( &::SireIO::TrajectoryReader::nAtoms );
+            
+            TrajectoryReader_exposer.def( 
+                "nAtoms"
+                , nAtoms_function_value );
+        
+        }
+        { //::SireIO::TrajectoryReader::nFrames
+        
+            typedef int ( ::SireIO::TrajectoryReader::*nFrames_function_type )(  ) const;
+            nFrames_function_type nFrames_function_value( &::SireIO::TrajectoryReader::nFrames );
+            
+            TrajectoryReader_exposer.def( 
+                "nFrames"
+                , nFrames_function_value );
+        
+        }
+        TrajectoryReader_exposer.def( bp::self != bp::self );
+        { //::SireIO::TrajectoryReader::operator=
+        
+            typedef ::SireIO::TrajectoryReader & ( ::SireIO::TrajectoryReader::*assign_function_type )( ::SireIO::TrajectoryReader const & ) ;
+            assign_function_type assign_function_value( &::SireIO::TrajectoryReader::operator= );
+            
+            TrajectoryReader_exposer.def( 
+                "assign"
+                , assign_function_value
+                , ( bp::arg("other") )
+                , bp::return_self< >() );
+        
+        }
+        TrajectoryReader_exposer.def( bp::self == bp::self );
+        { //::SireIO::TrajectoryReader::operator[]
+        
+            typedef ::QVector< SireMaths::Vector > ( ::SireIO::TrajectoryReader::*__getitem___function_type )( int ) const;
+            __getitem___function_type __getitem___function_value( &::SireIO::TrajectoryReader::operator[] );
+            
+            TrajectoryReader_exposer.def( 
+                "__getitem__"
+                , __getitem___function_value
+                , ( bp::arg("i") ) );
+        
+        }
+        { //::SireIO::TrajectoryReader::precision
+        
+            typedef double ( ::SireIO::TrajectoryReader::*precision_function_type )(  ) const;
+            precision_function_type precision_function_value( &::SireIO::TrajectoryReader::precision );
+            
+            TrajectoryReader_exposer.def( 
+                "precision"
+                , precision_function_value );
+        
+        }
+        { //::SireIO::TrajectoryReader::size
+        
+            typedef int ( ::SireIO::TrajectoryReader::*size_function_type )(  ) const;
+            size_function_type size_function_value( &::SireIO::TrajectoryReader::size );
+            
+            TrajectoryReader_exposer.def( 
+                "size"
+                , size_function_value );
+        
+        }
+        { //::SireIO::TrajectoryReader::space
+        
+            typedef ::SireVol::SpacePtr ( ::SireIO::TrajectoryReader::*space_function_type )( int ) const;
+            space_function_type space_function_value( &::SireIO::TrajectoryReader::space );
+            
+            TrajectoryReader_exposer.def( 
+                "space"
+                , space_function_value
+                , ( bp::arg("i") ) );
+        
+        }
+        { //::SireIO::TrajectoryReader::toString
+        
+            typedef ::QString ( ::SireIO::TrajectoryReader::*toString_function_type )(  ) const;
+            toString_function_type toString_function_value( &::SireIO::TrajectoryReader::toString );
+            
+            TrajectoryReader_exposer.def( 
+                "toString"
+                , toString_function_value );
+        
+        }
+        { //::SireIO::TrajectoryReader::typeName
+        
+            typedef char const * ( *typeName_function_type )(  );
+            typeName_function_type typeName_function_value( &::SireIO::TrajectoryReader::typeName );
+            
+            TrajectoryReader_exposer.def( 
+                "typeName"
+                , typeName_function_value );
+        
+        }
+        { //::SireIO::TrajectoryReader::what
+        
+            typedef char const * ( ::SireIO::TrajectoryReader::*what_function_type )(  ) const;
+            what_function_type what_function_value( &::SireIO::TrajectoryReader::what );
+            
+            TrajectoryReader_exposer.def( 
+                "what"
+                , what_function_value );
+        
+        }
+        TrajectoryReader_exposer.staticmethod( "typeName" );
+        TrajectoryReader_exposer.def( "__copy__", &__copy__);
+        TrajectoryReader_exposer.def( "__deepcopy__", &__copy__);
+        TrajectoryReader_exposer.def( "clone", &__copy__);
+        TrajectoryReader_exposer.def( "__str__", &__str__< ::SireIO::TrajectoryReader > );
+        TrajectoryReader_exposer.def( "__repr__", &__str__< ::SireIO::TrajectoryReader > );
+        TrajectoryReader_exposer.def( "__len__", &__len_size< ::SireIO::TrajectoryReader > );
+    }
+
+}
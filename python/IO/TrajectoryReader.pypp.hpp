@@ -0,0 +1,10 @@
+// This file has been generated by Py++.
+
+// (C) Christopher Woods, GPL >= 2 License
+
+#ifndef TrajectoryReader_hpp__pyplusplus_wrapper
+#define TrajectoryReader_hpp__pyplusplus_wrapper
+
+void register_TrajectoryReader_class();
+
+#endif//TrajectoryReader_hpp__pyplusplus_wrapper
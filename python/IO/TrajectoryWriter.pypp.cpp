@@ -0,0 +1,208 @@
+// This file has been generated by Py++.
+
+// (C) Christopher Woods, GPL >= 2 License
+
+#include "boost/python.hpp"
+#include "TrajectoryWriter.pypp.hpp"
+
+namespace bp = boost::python;
+
+#include "SireError/errors.h"
+
+#include "SireMol/atomcoords.h"
+
+#include "SireMol/molecule.h"
+
+#include "SireMol/moleditor.h"
+
+#include "SireVol/cartesian.h"
+
+#include "SireVol/periodicbox.h"
+
+#include "SireVol/triclinicbox.h"
+
+#include <QFile>
+
+#include "trajectoryfile.h"
+
+#include "trajectoryfile.h"
+
+SireIO::TrajectoryWriter __copy__(const SireIO::TrajectoryWriter &other){ return SireIO::TrajectoryWriter(other); }
+
+#include "Helpers/str.hpp"
+
+void register_TrajectoryWriter_class(){
+
+    { //::SireIO::TrajectoryWriter
+        typedef bp::class_< SireIO::TrajectoryWriter > TrajectoryWriter_exposer_t;
+        TrajectoryWriter_exposer_t TrajectoryWriter_exposer = TrajectoryWriter_exposer_t( "TrajectoryWriter", bp::init< >() );
+        bp::scope TrajectoryWriter_scope( TrajectoryWriter_exposer );
+        TrajectoryWriter_exposer.def( bp::init< QString const &, bp::optional< double > >(( bp::arg("filename"), bp::arg("precision")=0.001 )) );
+        TrajectoryWriter_exposer.def( bp::init< SireIO::TrajectoryWriter const & >(( bp::arg("other") )) );
+        { //::SireIO::TrajectoryWriter::close
+        
+            typedef void ( ::SireIO::TrajectoryWriter::*close_function_type )(  ) ;
+            close_function_type close_function_value( &::SireIO::TrajectoryWriter::close );
+            
+            TrajectoryWriter_exposer.def( 
+                "close"
+                , close_function_value );
+        
+        }
+        { //::SireIO::TrajectoryWriter::filename
+        
+            typedef ::QString ( ::SireIO::TrajectoryWriter::*filename_function_type )(  ) const;
+            filename_function_type filename_function_value( &::SireIO::TrajectoryWriter::filename );
+            
+            TrajectoryWriter_exposer.def( 
+                "filename"
+                , filename_function_value );
+        
+        }
+        { //::SireIO::TrajectoryWriter::flush
+        
+            typedef void ( ::SireIO::TrajectoryWriter::*flush_function_type )(  ) ;
+            flush_function_type flush_function_value( &::SireIO::TrajectoryWriter::flush );
+            
+            TrajectoryWriter_exposer.def( 
+                "flush"
+                , flush_function_value );
+        
+        }
+        { //::SireIO::TrajectoryWriter::isNull
+        
+            typedef bool ( ::SireIO::TrajectoryWriter::*isNull_function_type )(  ) const;
+            isNull_function_type isNull_function_value( &::SireIO::TrajectoryWriter::isNull );
+            
+            TrajectoryWriter_exposer.def( 
+                "isNull"
+                , isNull_function_value );
+        
+        }
+        { //::SireIO::TrajectoryWriter::nAtoms
+        
+            typedef int ( ::SireIO::TrajectoryWriter::*nAtoms_function_type )(  ) const;
+            nAtoms_function_type nAtoms_function_value( &::SireIO::TrajectoryWriter::nAtoms );
+            
+            TrajectoryWriter_exposer.def( 
+                "nAtoms"
+                , nAtoms_function_value );
+        
+        }
+        { //::SireIO::TrajectoryWriter::nFrames
+        
+            typedef int ( ::SireIO::TrajectoryWriter::*nFrames_function_type )(  ) const;
+            nFrames_function_type nFrames_function_value( &::SireIO::TrajectoryWriter::nFrames );
+            
+            TrajectoryWriter_exposer.def( 
+                "nFrames"
+                , nFrames_function_value );
+        
+        }
+        TrajectoryWriter_exposer.def( bp::self != bp::self );
+        { //::SireIO::TrajectoryWriter::operator=
+        
+            typedef ::SireIO::TrajectoryWriter & ( ::SireIO::TrajectoryWriter::*assign_function_type )( ::SireIO::TrajectoryWriter const & ) ;
+            assign_function_type assign_function_value( &::SireIO::TrajectoryWriter::operator= );
+            
+            TrajectoryWriter_exposer.def( 
+                "assign"
+                , assign_function_value
+                , ( bp::arg("other") )
+                , bp::return_self< >() );
+        
+        }
+        TrajectoryWriter_exposer.def( bp::self == bp::self );
+        { //::SireIO::TrajectoryWriter::precision
+        
+            typedef double ( ::SireIO::TrajectoryWriter::*precision_function_type )(  ) const;
+            precision_function_type precision_function_value( &::SireIO::TrajectoryWriter::precision );
+            
+            TrajectoryWriter_exposer.def( 
+                "precision"
+                , precision_function_value );
+        
+        }
+        { //::SireIO::TrajectoryWriter::toString
+        
+            typedef ::QString ( ::SireIO::TrajectoryWriter::*toString_function_type )(  ) const;
+            toString_function_type toString_function_value( &::SireIO::TrajectoryWriter::toString );
+            
+            TrajectoryWriter_exposer.def( 
+                "toString"
+                , toString_function_value );
+        
+        }
+        { //::SireIO::TrajectoryWriter::typeName
+        
+            typedef char const * ( *typeName_function_type )(  );
+            typeName_function_type typeName_function_value( &::SireIO::TrajectoryWriter::typeName );
+            
+            TrajectoryWriter_exposer.def( 
+                "typeName"
+                , typeName_function_value );
+        
+        }
+        { //::SireIO::TrajectoryWriter::what
+        
+            typedef char const * ( ::SireIO::TrajectoryWriter::*what_function_type )(  ) const;
+            what_function_type what_function_value( &::SireIO::TrajectoryWriter::what );
+            
+            TrajectoryWriter_exposer.def( 
+                "what"
+                , what_function_value );
+        
+        }
+        { //::SireIO::TrajectoryWriter::write
+        
+            typedef void ( ::SireIO::TrajectoryWriter::*write_function_type )( ::QVector< SireMaths::Vector > const & ) ;
+            write_function_type write_function_value( &::SireIO::TrajectoryWriter::write );
+            
+            TrajectoryWriter_exposer.def( 
+                "write"
+                , write_function_value
+                , ( bp::arg("coordinates") ) );
+        
+        }
+        { //::SireIO::TrajectoryWriter::write
+        
+            typedef void ( ::SireIO::TrajectoryWriter::*write_function_type )( ::QVector< SireMaths::Vector > const &,::SireVol::Space const & ) ;
+            write_function_type write_function_value( &::SireIO::TrajectoryWriter::write );
+            
+            TrajectoryWriter_exposer.def( 
+                "write"
+                , write_function_value
+                , ( bp::arg("coordinates"), bp::arg("space") ) );
+        
+        }
+        { //::SireIO::TrajectoryWriter::write
+        
+            typedef void ( ::SireIO::TrajectoryWriter::*write_function_type )( ::SireMol::MoleculeGroup const &,::SireBase::PropertyMap const & ) ;
+            write_function_type write_function_value( &::SireIO::TrajectoryWriter::write );
+            
+            TrajectoryWriter_exposer.def( 
+                "write"
+                , write_function_value
+                , ( bp::arg("molgroup"), bp::arg("map")=SireBase::PropertyMap() ) );
+        
+        }
+        { //::SireIO::TrajectoryWriter::write
+        
+            typedef void ( ::SireIO::TrajectoryWriter::*write_function_type )( ::SireMol::MoleculeGroup const &,::SireVol::Space const &,::SireBase::PropertyMap const & ) ;
+            write_function_type write_function_value( &::SireIO::TrajectoryWriter::write );
+            
+            TrajectoryWriter_exposer.def( 
+                "write"
+                , write_function_value
+                , ( bp::arg("molgroup"), bp::arg("space"), bp::arg("map")=SireBase::PropertyMap() ) );
+        
+        }
+        TrajectoryWriter_exposer.staticmethod( "typeName" );
+        TrajectoryWriter_exposer.def( "__copy__", &__copy__);
+        TrajectoryWriter_exposer.def( "__deepcopy__", &__copy__);
+        TrajectoryWriter_exposer.def( "clone", &__copy__);
+        TrajectoryWriter_exposer.def( "__str__", &__str__< ::SireIO::TrajectoryWriter > );
+        TrajectoryWriter_exposer.def( "__repr__", &__str__< ::SireIO::TrajectoryWriter > );
+    }
+
+}
@@ -0,0 +1,10 @@
+// This file has been generated by Py++.
+
+// (C) Christopher Woods, GPL >= 2 License
+
+#ifndef TrajectoryWriter_hpp__pyplusplus_wrapper
+#define TrajectoryWriter_hpp__pyplusplus_wrapper
+
+void register_TrajectoryWriter_class();
+
+#endif//TrajectoryWriter_hpp__pyplusplus_wrapper
@@ -39,6 +39,10 @@
 
 #include "TrajectoryMonitor.pypp.hpp"
 
+#include "TrajectoryReader.pypp.hpp"
+
+#include "TrajectoryWriter.pypp.hpp"
+
 #include "ZmatrixMaker.pypp.hpp"
 
 namespace bp = boost::python;
@@ -84,6 +88,10 @@ BOOST_PYTHON_MODULE(_IO){
 
     register_TrajectoryMonitor_class();
 
+    register_TrajectoryReader_class();
+
+    register_TrajectoryWriter_class();
+
     register_SireIO_properties();
 
     register_ZmatrixMaker_class();
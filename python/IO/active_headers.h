@@ -12,6 +12,7 @@
 #include "perturbationslibrary.h"
 #include "protoms.h"
 #include "tinker.h"
+#include "trajectoryfile.h"
 #include "trajectorymonitor.h"
 #include "zmatrixmaker.h"
 
@@ -0,0 +1,219 @@
+// This file has been generated by Py++.
+
+// (C) Christopher Woods, GPL >= 2 License
+
+#include "boost/python.hpp"
+#include "BondedTerms.pypp.hpp"
+
+namespace bp = boost::python;
+
+#include "SireCAS/constant.h"
+
+#include "SireCAS/expressionbase.h"
+
+#include "SireCAS/function.h"
+
+#include "SireCAS/powerconstant.h"
+
+#include "SireCAS/product.h"
+
+#include "SireCAS/sum.h"
+
+#include "SireCAS/trigfuncs.h"
+
+#include "SireCAS/values.h"
+
+#include "SireError/errors.h"
+
+#include "SireMaths/maths.h"
+
+#include "bondedterms.h"
+
+#include "tostring.h"
+
+#include <QObject>
+
+#include <QVarLengthArray>
+
+#include <cmath>
+
+#include "bondedterms.h"
+
+SireMM::BondedTerms __copy__(const SireMM::BondedTerms &other){ return SireMM::BondedTerms(other); }
+
+#include "Helpers/str.hpp"
+
+#include "Helpers/len.hpp"
+
+void register_BondedTerms_class(){
+
+    { //::SireMM::BondedTerms
+        typedef bp::class_< SireMM::BondedTerms > BondedTerms_exposer_t;
+        BondedTerms_exposer_t BondedTerms_exposer = BondedTerms_exposer_t( "BondedTerms", bp::init< >() );
+        bp::scope BondedTerms_scope( BondedTerms_exposer );
+        bp::enum_< SireMM::BondedTerms::FORM>("FORM")
+            .value("UNRECOGNISED", SireMM::BondedTerms::UNRECOGNISED)
+            .value("HARMONIC", SireMM::BondedTerms::HARMONIC)
+            .value("POLYNOMIAL", SireMM::BondedTerms::POLYNOMIAL)
+            .value("COSINE_SERIES", SireMM::BondedTerms::COSINE_SERIES)
+            .value("COSINE_POWER_SERIES", SireMM::BondedTerms::COSINE_POWER_SERIES)
+            .export_values()
+            ;
+        BondedTerms_exposer.def( bp::init< SireMM::BondedTerms const & >(( bp::arg("other") )) );
+        { //::SireMM::BondedTerms::add
+        
+            typedef int ( ::SireMM::BondedTerms::*add_function_type )( ::SireCAS::Expression const &,::QList< SireCAS::Symbol > const & ) ;
+            add_function_type add_function_value( &::SireMM::BondedTerms::add );
+            
+            BondedTerms_exposer.def( 
+                "add"
+                , add_function_value
+                , ( bp::arg("function"), bp::arg("symbols") ) );
+        
+        }
+        { //::SireMM::BondedTerms::clear
+        
+            typedef void ( ::SireMM::BondedTerms::*clear_function_type )(  ) ;
+            clear_function_type clear_function_value( &::SireMM::BondedTerms::clear );
+            
+            BondedTerms_exposer.def( 
+                "clear"
+                , clear_function_value );
+        
+        }
+        { //::SireMM::BondedTerms::count
+        
+            typedef int ( ::SireMM::BondedTerms::*count_function_type )(  ) const;
+            count_function_type count_function_value( &::SireMM::BondedTerms::count );
+            
+            BondedTerms_exposer.def( 
+                "count"
+                , count_function_value );
+        
+        }
+        { //::SireMM::BondedTerms::evaluate
+        
+            typedef ::QVector< double > ( ::SireMM::BondedTerms::*evaluate_function_type )( ::QVector< double > const & ) const;
+            evaluate_function_type evaluate_function_value( &::SireMM::BondedTerms::evaluate );
+            
+            BondedTerms_exposer.def( 
+                "evaluate"
+                , evaluate_function_value
+                , ( bp::arg("values") ) );
+        
+        }
+        { //::SireMM::BondedTerms::form
+        
+            typedef ::SireMM::BondedTerms::FORM ( ::SireMM::BondedTerms::*form_function_type )( int ) const;
+            form_function_type form_function_value( &::SireMM::BondedTerms::form );
+            
+            BondedTerms_exposer.def( 
+                "form"
+                , form_function_value
+                , ( bp::arg("i") ) );
+        
+        }
+        { //::SireMM::BondedTerms::isEmpty
+        
+            typedef bool ( ::SireMM::BondedTerms::*isEmpty_function_type )(  ) const;
+            isEmpty_function_type isEmpty_function_value( &::SireMM::BondedTerms::isEmpty );
+            
+            BondedTerms_exposer.def( 
+                "isEmpty"
+                , isEmpty_function_value );
+        
+        }
+        { //::SireMM::BondedTerms::isRecognised
+        
+            typedef bool ( ::SireMM::BondedTerms::*isRecognised_function_type )( int ) const;
+            isRecognised_function_type isRecognised_function_value( &::SireMM::BondedTerms::isRecognised );
+            
+            BondedTerms_exposer.def( 
+                "isRecognised"
+                , isRecognised_function_value
+                , ( bp::arg("i") ) );
+        
+        }
+        { //::SireMM::BondedTerms::nRecognised
+        
+            typedef int ( ::SireMM::BondedTerms::*nRecognised_function_type )(  ) const;
+            nRecognised_function_type nRecognised_function_value( &::SireMM::BondedTerms::nRecognised );
+            
+            BondedTerms_exposer.def( 
+                "nRecognised"
+                , nRecognised_function_value );
+        
+        }
+        { //::SireMM::BondedTerms::nRecognised
+        
+            typedef int ( ::SireMM::BondedTerms::*nRecognised_function_type )( ::SireMM::BondedTerms::FORM ) const;
+            nRecognised_function_type nRecognised_function_value( &::SireMM::BondedTerms::nRecognised );
+            
+            BondedTerms_exposer.def( 
+                "nRecognised"
+                , nRecognised_function_value
+                , ( bp::arg("form") ) );
+        
+        }
+        { //::SireMM::BondedTerms::nSlots
+        
+            typedef int ( ::SireMM::BondedTerms::*nSlots_function_type )(  ) const;
+            nSlots_function_type nSlots_function_value( &::SireMM::BondedTerms::nSlots );
+            
+            BondedTerms_exposer.def( 
+                "nSlots"
+                , nSlots_function_value );
+        
+        }
+        { //::SireMM::BondedTerms::operator=
+        
+            typedef ::SireMM::BondedTerms & ( ::SireMM::BondedTerms::*assign_function_type )( ::SireMM::BondedTerms const & ) ;
+            assign_function_type assign_function_value( &::SireMM::BondedTerms::operator= );
+            
+            BondedTerms_exposer.def( 
+                "assign"
+                , assign_function_value
+                , ( bp::arg("other") )
+                , bp::return_self< >() );
+        
+        }
+        { //::SireMM::BondedTerms::toString
+        
+            typedef ::QString ( ::SireMM::BondedTerms::*toString_function_type )(  ) const;
+            toString_function_type toString_function_value( &::SireMM::BondedTerms::toString );
+            
+            BondedTerms_exposer.def( 
+                "toString"
+                , toString_function_value );
+        
+        }
+        { //::SireMM::BondedTerms::typeName
+        
+            typedef char const * ( *typeName_function_type )(  );
+            typeName_function_type typeName_function_value( &::SireMM::BondedTerms::typeName );
+            
+            BondedTerms_exposer.def( 
+                "typeName"
+                , typeName_function_value );
+        
+        }
+        { //::SireMM::BondedTerms::what
+        
+            typedef char const * ( ::SireMM::BondedTerms::*what_function_type )(  ) const;
+            what_function_type what_function_value( &::SireMM::BondedTerms::what );
+            
+            BondedTerms_exposer.def( 
+                "what"
+                , what_function_value );
+        
+        }
+        BondedTerms_exposer.staticmethod( "typeName" );
+        BondedTerms_exposer.def( "__copy__", &__copy__);
+        BondedTerms_exposer.def( "__deepcopy__", &__copy__);
+        BondedTerms_exposer.def( "clone", &__copy__);
+        BondedTerms_exposer.def( "__str__", &__str__< ::SireMM::BondedTerms > );
+        BondedTerms_exposer.def( "__repr__", &__str__< ::SireMM::BondedTerms > );
+        BondedTerms_exposer.def( "__len__", &__len_count< ::SireMM::BondedTerms > );
+    }
+
+}
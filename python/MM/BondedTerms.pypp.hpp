@@ -0,0 +1,10 @@
+// This file has been generated by Py++.
+
+// (C) Christopher Woods, GPL >= 2 License
+
+#ifndef BondedTerms_hpp__pyplusplus_wrapper
+#define BondedTerms_hpp__pyplusplus_wrapper
+
+void register_BondedTerms_class();
+
+#endif//BondedTerms_hpp__pyplusplus_wrapper
@@ -190,6 +190,17 @@ void register_CLJAtoms_class(){
                 , epsilon_function_value
                 , bp::return_value_policy< bp::copy_const_reference >() );
         
+        }
+        { //::SireMM::CLJAtoms::gather
+        
+            typedef ::SireMM::CLJAtoms ( ::SireMM::CLJAtoms::*gather_function_type )( ::QVector< int > const & ) const;
+            gather_function_type gather_function_value( &::SireMM::CLJAtoms::gather );
+            
+            CLJAtoms_exposer.def( 
+                "gather"
+                , gather_function_value
+                , ( bp::arg("indicies") ) );
+        
         }
         { //::SireMM::CLJAtoms::getitem
         
@@ -512,6 +523,17 @@ void register_CLJAtoms_class(){
                 "toString"
                 , toString_function_value );
         
+        }
+        { //::SireMM::CLJAtoms::translate
+        
+            typedef ::SireMM::CLJAtoms ( ::SireMM::CLJAtoms::*translate_function_type )( ::SireMaths::Vector const & ) const;
+            translate_function_type translate_function_value( &::SireMM::CLJAtoms::translate );
+            
+            CLJAtoms_exposer.def( 
+                "translate"
+                , translate_function_value
+                , ( bp::arg("delta") ) );
+        
         }
         { //::SireMM::CLJAtoms::typeName
         
@@ -103,6 +103,17 @@ void register_CLJCalculator_class(){
                 , calculate_function_value
                 , ( bp::arg("funcs"), bp::arg("atoms0"), bp::arg("boxes1") ) );
         
+        }
+        { //::SireMM::CLJCalculator::calculate
+        
+            typedef ::boost::tuples::tuple< double, double, boost::tuples::null_type, boost::tuples::null_type, boost::tuples::null_type, boost::tuples::null_type, boost::tuples::null_type, boost::tuples::null_type, boost::tuples::null_type, boost::tuples::null_type > ( ::SireMM::CLJCalculator::*calculate_function_type )( ::SireMM::CLJFunction const &,::SireMM::CLJBoxes const &,::SireMM::CLJPairList & ) const;
+            calculate_function_type calculate_function_value( &::SireMM::CLJCalculator::calculate );
+            
+            CLJCalculator_exposer.def( 
+                "calculate"
+                , calculate_function_value
+                , ( bp::arg("func"), bp::arg("boxes"), bp::arg("pairlist") ) );
+        
         }
         CLJCalculator_exposer.def( bp::self != bp::self );
         { //::SireMM::CLJCalculator::operator=
@@ -0,0 +1,254 @@
+// This file has been generated by Py++.
+
+// (C) Christopher Woods, GPL >= 2 License
+
+#include "boost/python.hpp"
+#include "CLJEwaldFunction.pypp.hpp"
+
+namespace bp = boost::python;
+
+#include "SireBase/numberproperty.h"
+
+#include "SireError/errors.h"
+
+#include "SireMaths/constants.h"
+
+#include "SireMaths/multidouble.h"
+
+#include "SireMaths/multifloat.h"
+
+#include "SireMaths/multiint.h"
+
+#include "SireStream/datastream.h"
+
+#include "SireStream/shareddatastream.h"
+
+#include "SireUnits/units.h"
+
+#include "cljewaldfunction.h"
+
+#include <QDebug>
+
+#include <cmath>
+
+#include "cljewaldfunction.h"
+
+SireMM::CLJEwaldFunction __copy__(const SireMM::CLJEwaldFunction &other){ return SireMM::CLJEwaldFunction(other); }
+
+#include "Qt/qdatastream.hpp"
+
+#include "Helpers/str.hpp"
+
+void register_CLJEwaldFunction_class(){
+
+    { //::SireMM::CLJEwaldFunction
+        typedef bp::class_< SireMM::CLJEwaldFunction, bp::bases< SireMM::CLJCutoffFunction, SireMM::CLJFunction, SireBase::Property > > CLJEwaldFunction_exposer_t;
+        CLJEwaldFunction_exposer_t CLJEwaldFunction_exposer = CLJEwaldFunction_exposer_t( "CLJEwaldFunction", bp::init< >() );
+        bp::scope CLJEwaldFunction_scope( CLJEwaldFunction_exposer );
+        CLJEwaldFunction_exposer.def( bp::init< SireUnits::Dimension::Length >(( bp::arg("cutoff") )) );
+        CLJEwaldFunction_exposer.def( bp::init< SireUnits::Dimension::Length, SireUnits::Dimension::Length >(( bp::arg("coul_cutoff"), bp::arg("lj_cutoff") )) );
+        CLJEwaldFunction_exposer.def( bp::init< SireVol::Space const &, SireUnits::Dimension::Length >(( bp::arg("space"), bp::arg("cutoff") )) );
+        CLJEwaldFunction_exposer.def( bp::init< SireVol::Space const &, SireUnits::Dimension::Length, SireUnits::Dimension::Length >(( bp::arg("space"), bp::arg("coul_cutoff"), bp::arg("lj_cutoff") )) );
+        CLJEwaldFunction_exposer.def( bp::init< SireUnits::Dimension::Length, SireMM::CLJFunction::COMBINING_RULES >(( bp::arg("cutoff"), bp::arg("combining_rules") )) );
+        CLJEwaldFunction_exposer.def( bp::init< SireUnits::Dimension::Length, SireUnits::Dimension::Length, SireMM::CLJFunction::COMBINING_RULES >(( bp::arg("coul_cutoff"), bp::arg("lj_cutoff"), bp::arg("combining_rules") )) );
+        CLJEwaldFunction_exposer.def( bp::init< SireVol::Space const &, SireMM::CLJFunction::COMBINING_RULES >(( bp::arg("space"), bp::arg("combining_rules") )) );
+        CLJEwaldFunction_exposer.def( bp::init< SireVol::Space const &, SireUnits::Dimension::Length, SireMM::CLJFunction::COMBINING_RULES >(( bp::arg("space"), bp::arg("cutoff"), bp::arg("combining_rules") )) );
+        CLJEwaldFunction_exposer.def( bp::init< SireVol::Space const &, SireUnits::Dimension::Length, SireUnits::Dimension::Length, SireMM::CLJFunction::COMBINING_RULES >(( bp::arg("space"), bp::arg("coul_cutoff"), bp::arg("lj_cutoff"), bp::arg("combining_rules") )) );
+        CLJEwaldFunction_exposer.def( bp::init< SireMM::CLJEwaldFunction const & >(( bp::arg("other") )) );
+        { //::SireMM::CLJEwaldFunction::beta
+        
+            typedef double ( ::SireMM::CLJEwaldFunction::*beta_function_type )(  ) const;
+            beta_function_type beta_function_value( &::SireMM::CLJEwaldFunction::beta );
+            
+            CLJEwaldFunction_exposer.def( 
+                "beta"
+                , beta_function_value );
+        
+        }
+        { //::SireMM::CLJEwaldFunction::calculateBeta
+        
+            typedef double ( *calculateBeta_function_type )( ::SireUnits::Dimension::Length,double );
+            calculateBeta_function_type calculateBeta_function_value( &::SireMM::CLJEwaldFunction::calculateBeta );
+            
+            CLJEwaldFunction_exposer.def( 
+                "calculateBeta"
+                , calculateBeta_function_value
+                , ( bp::arg("cutoff"), bp::arg("tolerance") ) );
+        
+        }
+        { //::SireMM::CLJEwaldFunction::containsProperty
+        
+            typedef bool ( ::SireMM::CLJEwaldFunction::*containsProperty_function_type )( ::QString const & ) const;
+            containsProperty_function_type containsProperty_function_value( &::SireMM::CLJEwaldFunction::containsProperty );
+            
+            CLJEwaldFunction_exposer.def( 
+                "containsProperty"
+                , containsProperty_function_value
+                , ( bp::arg("name") ) );
+        
+        }
+        { //::SireMM::CLJEwaldFunction::defaultEwaldFunction
+        
+            typedef ::SireMM::CLJFunctionPtr ( *defaultEwaldFunction_function_type )(  );
+            defaultEwaldFunction_function_type defaultEwaldFunction_function_value( &::SireMM::CLJEwaldFunction::defaultEwaldFunction );
+            
+            CLJEwaldFunction_exposer.def( 
+                "defaultEwaldFunction"
+                , defaultEwaldFunction_function_value );
+        
+        }
+        CLJEwaldFunction_exposer.def( bp::self != bp::self );
+        { //::SireMM::CLJEwaldFunction::operator=
+        
+            typedef ::SireMM::CLJEwaldFunction & ( ::SireMM::CLJEwaldFunction::*assign_function_type )( ::SireMM::CLJEwaldFunction const & ) ;
+            assign_function_type assign_function_value( &::SireMM::CLJEwaldFunction::operator= );
+            
+            CLJEwaldFunction_exposer.def( 
+                "assign"
+                , assign_function_value
+                , ( bp::arg("other") )
+                , bp::return_self< >() );
+        
+        }
+        CLJEwaldFunction_exposer.def( bp::self == bp::self );
+        { //::SireMM::CLJEwaldFunction::ewaldTolerance
+        
+            typedef double ( ::SireMM::CLJEwaldFunction::*ewaldTolerance_function_type )(  ) const;
+            ewaldTolerance_function_type ewaldTolerance_function_value( &::SireMM::CLJEwaldFunction::ewaldTolerance );
+            
+            CLJEwaldFunction_exposer.def( 
+                "ewaldTolerance"
+                , ewaldTolerance_function_value );
+        
+        }
+        { //::SireMM::CLJEwaldFunction::properties
+        
+            typedef ::SireBase::Properties ( ::SireMM::CLJEwaldFunction::*properties_function_type )(  ) const;
+            properties_function_type properties_function_value( &::SireMM::CLJEwaldFunction::properties );
+            
+            CLJEwaldFunction_exposer.def( 
+                "properties"
+                , properties_function_value );
+        
+        }
+        { //::SireMM::CLJEwaldFunction::property
+        
+            typedef ::SireBase::PropertyPtr ( ::SireMM::CLJEwaldFunction::*property_function_type )( ::QString const & ) const;
+            property_function_type property_function_value( &::SireMM::CLJEwaldFunction::property );
+            
+            CLJEwaldFunction_exposer.def( 
+                "property"
+                , property_function_value
+                , ( bp::arg("name") ) );
+        
+        }
+        { //::SireMM::CLJEwaldFunction::setCoulombCutoff
+        
+            typedef void ( ::SireMM::CLJEwaldFunction::*setCoulombCutoff_function_type )( ::SireUnits::Dimension::Length ) ;
+            setCoulombCutoff_function_type setCoulombCutoff_function_value( &::SireMM::CLJEwaldFunction::setCoulombCutoff );
+            
+            CLJEwaldFunction_exposer.def( 
+                "setCoulombCutoff"
+                , setCoulombCutoff_function_value
+                , ( bp::arg("distance") ) );
+        
+        }
+        { //::SireMM::CLJEwaldFunction::setCutoff
+        
+            typedef void ( ::SireMM::CLJEwaldFunction::*setCutoff_function_type )( ::SireUnits::Dimension::Length ) ;
+            setCutoff_function_type setCutoff_function_value( &::SireMM::CLJEwaldFunction::setCutoff );
+            
+            CLJEwaldFunction_exposer.def( 
+                "setCutoff"
+                , setCutoff_function_value
+                , ( bp::arg("distance") ) );
+        
+        }
+        { //::SireMM::CLJEwaldFunction::setCutoff
+        
+            typedef void ( ::SireMM::CLJEwaldFunction::*setCutoff_function_type )( ::SireUnits::Dimension::Length,::SireUnits::Dimension::Length ) ;
+            setCutoff_function_type setCutoff_function_value( &::SireMM::CLJEwaldFunction::setCutoff );
+            
+            CLJEwaldFunction_exposer.def( 
+                "setCutoff"
+                , setCutoff_function_value
+                , ( bp::arg("coulomb_cutoff"), bp::arg("lj_cutoff") ) );
+        
+        }
+        { //::SireMM::CLJEwaldFunction::setEwaldTolerance
+        
+            typedef void ( ::SireMM::CLJEwaldFunction::*setEwaldTolerance_function_type )( double ) ;
+            setEwaldTolerance_function_type setEwaldTolerance_function_value( &::SireMM::CLJEwaldFunction::setEwaldTolerance );
+            
+            CLJEwaldFunction_exposer.def( 
+                "setEwaldTolerance"
+                , setEwaldTolerance_function_value
+                , ( bp::arg("tolerance") ) );
+        
+        }
+        { //::SireMM::CLJEwaldFunction::setProperty
+        
+            typedef ::SireMM::CLJFunctionPtr ( ::SireMM::CLJEwaldFunction::*setProperty_function_type )( ::QString const &,::SireBase::Property const & ) const;
+            setProperty_function_type setProperty_function_value( &::SireMM::CLJEwaldFunction::setProperty );
+            
+            CLJEwaldFunction_exposer.def( 
+                "setProperty"
+                , setProperty_function_value
+                , ( bp::arg("name"), bp::arg("value") ) );
+        
+        }
+        { //::SireMM::CLJEwaldFunction::supportsForceCalculation
+        
+            typedef bool ( ::SireMM::CLJEwaldFunction::*supportsForceCalculation_function_type )(  ) const;
+            supportsForceCalculation_function_type supportsForceCalculation_function_value( &::SireMM::CLJEwaldFunction::supportsForceCalculation );
+            
+            CLJEwaldFunction_exposer.def( 
+                "supportsForceCalculation"
+                , supportsForceCalculation_function_value );
+        
+        }
+        { //::SireMM::CLJEwaldFunction::toString
+        
+            typedef ::QString ( ::SireMM::CLJEwaldFunction::*toString_function_type )(  ) const;
+            toString_function_type toString_function_value( &::SireMM::CLJEwaldFunction::toString );
+            
+            CLJEwaldFunction_exposer.def( 
+                "toString"
+                , toString_function_value );
+        
+        }
+        { //::SireMM::CLJEwaldFunction::typeName
+        
+            typedef char const * ( *typeName_function_type )(  );
+            typeName_function_type typeName_function_value( &::SireMM::CLJEwaldFunction::typeName );
+            
+            CLJEwaldFunction_exposer.def( 
+                "typeName"
+                , typeName_function_value );
+        
+        }
+        { //::SireMM::CLJEwaldFunction::what
+        
+            typedef char const * ( ::SireMM::CLJEwaldFunction::*what_function_type )(  ) const;
+            what_function_type what_function_value( &::SireMM::CLJEwaldFunction::what );
+            
+            CLJEwaldFunction_exposer.def( 
+                "what"
+                , what_function_value );
+        
+        }
+        CLJEwaldFunction_exposer.staticmethod( "calculateBeta" );
+        CLJEwaldFunction_exposer.staticmethod( "defaultEwaldFunction" );
+        CLJEwaldFunction_exposer.staticmethod( "typeName" );
+        CLJEwaldFunction_exposer.def( "__copy__", &__copy__);
+        CLJEwaldFunction_exposer.def( "__deepcopy__", &__copy__);
+        CLJEwaldFunction_exposer.def( "clone", &__copy__);
+        CLJEwaldFunction_exposer.def( "__rlshift__", &__rlshift__QDataStream< ::SireMM::CLJEwaldFunction >,
+                            bp::return_internal_reference<1, bp::with_custodian_and_ward<1,2> >() );
+        CLJEwaldFunction_exposer.def( "__rrshift__", &__rrshift__QDataStream< ::SireMM::CLJEwaldFunction >,
+                            bp::return_internal_reference<1, bp::with_custodian_and_ward<1,2> >() );
+        CLJEwaldFunction_exposer.def( "__str__", &__str__< ::SireMM::CLJEwaldFunction > );
+        CLJEwaldFunction_exposer.def( "__repr__", &__str__< ::SireMM::CLJEwaldFunction > );
+    }
+
+}
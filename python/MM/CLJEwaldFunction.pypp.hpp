@@ -0,0 +1,10 @@
+// This file has been generated by Py++.
+
+// (C) Christopher Woods, GPL >= 2 License
+
+#ifndef CLJEwaldFunction_hpp__pyplusplus_wrapper
+#define CLJEwaldFunction_hpp__pyplusplus_wrapper
+
+void register_CLJEwaldFunction_class();
+
+#endif//CLJEwaldFunction_hpp__pyplusplus_wrapper
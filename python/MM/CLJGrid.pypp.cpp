@@ -127,6 +127,16 @@ void register_CLJGrid_class(){
                 "disableGrid"
                 , disableGrid_function_value );
         
+        }
+        { //::SireMM::CLJGrid::disableLJGrid
+        
+            typedef void ( ::SireMM::CLJGrid::*disableLJGrid_function_type )(  ) ;
+            disableLJGrid_function_type disableLJGrid_function_value( &::SireMM::CLJGrid::disableLJGrid );
+            
+            CLJGrid_exposer.def( 
+                "disableLJGrid"
+                , disableLJGrid_function_value );
+        
         }
         { //::SireMM::CLJGrid::disableParallelCalculation
         
@@ -147,6 +157,16 @@ void register_CLJGrid_class(){
                 "disableReproducibleCalculation"
                 , disableReproducibleCalculation_function_value );
         
+        }
+        { //::SireMM::CLJGrid::disableTricubicInterpolation
+        
+            typedef void ( ::SireMM::CLJGrid::*disableTricubicInterpolation_function_type )(  ) ;
+            disableTricubicInterpolation_function_type disableTricubicInterpolation_function_value( &::SireMM::CLJGrid::disableTricubicInterpolation );
+            
+            CLJGrid_exposer.def( 
+                "disableTricubicInterpolation"
+                , disableTricubicInterpolation_function_value );
+        
         }
         { //::SireMM::CLJGrid::enableGrid
         
@@ -157,6 +177,16 @@ void register_CLJGrid_class(){
                 "enableGrid"
                 , enableGrid_function_value );
         
+        }
+        { //::SireMM::CLJGrid::enableLJGrid
+        
+            typedef void ( ::SireMM::CLJGrid::*enableLJGrid_function_type )(  ) ;
+            enableLJGrid_function_type enableLJGrid_function_value( &::SireMM::CLJGrid::enableLJGrid );
+            
+            CLJGrid_exposer.def( 
+                "enableLJGrid"
+                , enableLJGrid_function_value );
+        
         }
         { //::SireMM::CLJGrid::enableParallelCalculation
         
@@ -177,6 +207,16 @@ void register_CLJGrid_class(){
                 "enableReproducibleCalculation"
                 , enableReproducibleCalculation_function_value );
         
+        }
+        { //::SireMM::CLJGrid::enableTricubicInterpolation
+        
+            typedef void ( ::SireMM::CLJGrid::*enableTricubicInterpolation_function_type )(  ) ;
+            enableTricubicInterpolation_function_type enableTricubicInterpolation_function_value( &::SireMM::CLJGrid::enableTricubicInterpolation );
+            
+            CLJGrid_exposer.def( 
+                "enableTricubicInterpolation"
+                , enableTricubicInterpolation_function_value );
+        
         }
         { //::SireMM::CLJGrid::fixedAtoms
         
@@ -424,6 +464,17 @@ void register_CLJGrid_class(){
                 , setUseGrid_function_value
                 , ( bp::arg("on") ) );
         
+        }
+        { //::SireMM::CLJGrid::setUseLJGrid
+        
+            typedef void ( ::SireMM::CLJGrid::*setUseLJGrid_function_type )( bool ) ;
+            setUseLJGrid_function_type setUseLJGrid_function_value( &::SireMM::CLJGrid::setUseLJGrid );
+            
+            CLJGrid_exposer.def( 
+                "setUseLJGrid"
+                , setUseLJGrid_function_value
+                , ( bp::arg("on") ) );
+        
         }
         { //::SireMM::CLJGrid::setUseParallelCalculation
         
@@ -446,6 +497,17 @@ void register_CLJGrid_class(){
                 , setUseReproducibleCalculation_function_value
                 , ( bp::arg("on") ) );
         
+        }
+        { //::SireMM::CLJGrid::setUseTricubicInterpolation
+        
+            typedef void ( ::SireMM::CLJGrid::*setUseTricubicInterpolation_function_type )( bool ) ;
+            setUseTricubicInterpolation_function_type setUseTricubicInterpolation_function_value( &::SireMM::CLJGrid::setUseTricubicInterpolation );
+            
+            CLJGrid_exposer.def( 
+                "setUseTricubicInterpolation"
+                , setUseTricubicInterpolation_function_value
+                , ( bp::arg("on") ) );
+        
         }
         { //::SireMM::CLJGrid::toString
         
@@ -498,6 +560,16 @@ void register_CLJGrid_class(){
                 "usesGrid"
                 , usesGrid_function_value );
         
+        }
+        { //::SireMM::CLJGrid::usesLJGrid
+        
+            typedef bool ( ::SireMM::CLJGrid::*usesLJGrid_function_type )(  ) const;
+            usesLJGrid_function_type usesLJGrid_function_value( &::SireMM::CLJGrid::usesLJGrid );
+            
+            CLJGrid_exposer.def( 
+                "usesLJGrid"
+                , usesLJGrid_function_value );
+        
         }
         { //::SireMM::CLJGrid::usesParallelCalculation
         
@@ -518,6 +590,16 @@ void register_CLJGrid_class(){
                 "usesReproducibleCalculation"
                 , usesReproducibleCalculation_function_value );
         
+        }
+        { //::SireMM::CLJGrid::usesTricubicInterpolation
+        
+            typedef bool ( ::SireMM::CLJGrid::*usesTricubicInterpolation_function_type )(  ) const;
+            usesTricubicInterpolation_function_type usesTricubicInterpolation_function_value( &::SireMM::CLJGrid::usesTricubicInterpolation );
+            
+            CLJGrid_exposer.def( 
+                "usesTricubicInterpolation"
+                , usesTricubicInterpolation_function_value );
+        
         }
         { //::SireMM::CLJGrid::what
         
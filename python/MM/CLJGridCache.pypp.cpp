@@ -0,0 +1,161 @@
+// This file has been generated by Py++.
+
+// (C) Christopher Woods, GPL >= 2 License
+
+#include "boost/python.hpp"
+#include "CLJGridCache.pypp.hpp"
+
+namespace bp = boost::python;
+
+#include "SireError/errors.h"
+
+#include "cljgridcache.h"
+
+#include <QCryptographicHash>
+
+#include <QDebug>
+
+#include <QDir>
+
+#include <QFile>
+
+#include <QHash>
+
+#include <QMutex>
+
+#include <QTemporaryFile>
+
+#include <boost/noncopyable.hpp>
+
+#include <boost/weak_ptr.hpp>
+
+#include <cstdlib>
+
+#include <cstring>
+
+#include "cljgridcache.h"
+
+void register_CLJGridCache_class(){
+
+    { //::SireMM::CLJGridCache
+        typedef bp::class_< SireMM::CLJGridCache > CLJGridCache_exposer_t;
+        CLJGridCache_exposer_t CLJGridCache_exposer = CLJGridCache_exposer_t( "CLJGridCache", bp::init< >() );
+        bp::scope CLJGridCache_scope( CLJGridCache_exposer );
+        { //::SireMM::CLJGridCache::cacheDirectory
+        
+            typedef ::QString ( *cacheDirectory_function_type )(  );
+            cacheDirectory_function_type cacheDirectory_function_value( &::SireMM::CLJGridCache::cacheDirectory );
+            
+            CLJGridCache_exposer.def( 
+                "cacheDirectory"
+                , cacheDirectory_function_value );
+        
+        }
+        { //::SireMM::CLJGridCache::clear
+        
+            typedef void ( *clear_function_type )(  );
+            clear_function_type clear_function_value( &::SireMM::CLJGridCache::clear );
+            
+            CLJGridCache_exposer.def( 
+                "clear"
+                , clear_function_value );
+        
+        }
+        { //::SireMM::CLJGridCache::contains
+        
+            typedef bool ( *contains_function_type )( ::QString const & );
+            contains_function_type contains_function_value( &::SireMM::CLJGridCache::contains );
+            
+            CLJGridCache_exposer.def( 
+                "contains"
+                , contains_function_value
+                , ( bp::arg("key") ) );
+        
+        }
+        { //::SireMM::CLJGridCache::createKey
+        
+            typedef ::QString ( *createKey_function_type )( ::QByteArray const & );
+            createKey_function_type createKey_function_value( &::SireMM::CLJGridCache::createKey );
+            
+            CLJGridCache_exposer.def( 
+                "createKey"
+                , createKey_function_value
+                , ( bp::arg("data") ) );
+        
+        }
+        { //::SireMM::CLJGridCache::disable
+        
+            typedef void ( *disable_function_type )(  );
+            disable_function_type disable_function_value( &::SireMM::CLJGridCache::disable );
+            
+            CLJGridCache_exposer.def( 
+                "disable"
+                , disable_function_value );
+        
+        }
+        { //::SireMM::CLJGridCache::isEnabled
+        
+            typedef bool ( *isEnabled_function_type )(  );
+            isEnabled_function_type isEnabled_function_value( &::SireMM::CLJGridCache::isEnabled );
+            
+            CLJGridCache_exposer.def( 
+                "isEnabled"
+                , isEnabled_function_value );
+        
+        }
+        { //::SireMM::CLJGridCache::loadDoubles
+        
+            typedef ::QVector< double > ( *loadDoubles_function_type )( ::QString const &,int );
+            loadDoubles_function_type loadDoubles_function_value( &::SireMM::CLJGridCache::loadDoubles );
+            
+            CLJGridCache_exposer.def( 
+                "loadDoubles"
+                , loadDoubles_function_value
+                , ( bp::arg("key"), bp::arg("nvalues") ) );
+        
+        }
+        { //::SireMM::CLJGridCache::save
+        
+            typedef void ( *save_function_type )( ::QString const &, ::QVector< float > const & );
+            save_function_type save_function_value( &::SireMM::CLJGridCache::save );
+            
+            CLJGridCache_exposer.def( 
+                "save"
+                , save_function_value
+                , ( bp::arg("key"), bp::arg("values") ) );
+        
+        }
+        { //::SireMM::CLJGridCache::save
+        
+            typedef void ( *save_function_type )( ::QString const &, ::QVector< double > const & );
+            save_function_type save_function_value( &::SireMM::CLJGridCache::save );
+            
+            CLJGridCache_exposer.def( 
+                "save"
+                , save_function_value
+                , ( bp::arg("key"), bp::arg("values") ) );
+        
+        }
+        { //::SireMM::CLJGridCache::setCacheDirectory
+        
+            typedef void ( *setCacheDirectory_function_type )( ::QString const & );
+            setCacheDirectory_function_type setCacheDirectory_function_value( &::SireMM::CLJGridCache::setCacheDirectory );
+            
+            CLJGridCache_exposer.def( 
+                "setCacheDirectory"
+                , setCacheDirectory_function_value
+                , ( bp::arg("directory") ) );
+        
+        }
+        CLJGridCache_exposer.staticmethod( "cacheDirectory" );
+        CLJGridCache_exposer.staticmethod( "clear" );
+        CLJGridCache_exposer.staticmethod( "contains" );
+        CLJGridCache_exposer.staticmethod( "createKey" );
+        CLJGridCache_exposer.staticmethod( "disable" );
+        CLJGridCache_exposer.staticmethod( "isEnabled" );
+        CLJGridCache_exposer.staticmethod( "loadDoubles" );
+        CLJGridCache_exposer.staticmethod( "save" );
+        CLJGridCache_exposer.staticmethod( "setCacheDirectory" );
+    }
+
+}
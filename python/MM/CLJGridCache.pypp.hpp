@@ -0,0 +1,10 @@
+// This file has been generated by Py++.
+
+// (C) Christopher Woods, GPL >= 2 License
+
+#ifndef CLJGridCache_hpp__pyplusplus_wrapper
+#define CLJGridCache_hpp__pyplusplus_wrapper
+
+void register_CLJGridCache_class();
+
+#endif//CLJGridCache_hpp__pyplusplus_wrapper
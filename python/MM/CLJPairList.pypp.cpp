@@ -0,0 +1,212 @@
+// This file has been generated by Py++.
+
+// (C) Christopher Woods, GPL >= 2 License
+
+#include "boost/python.hpp"
+#include "CLJPairList.pypp.hpp"
+
+namespace bp = boost::python;
+
+#include "SireBase/profiler.h"
+
+#include "SireStream/datastream.h"
+
+#include "SireUnits/units.h"
+
+#include "cljfunction.h"
+
+#include "cljpairlist.h"
+
+#include <QVarLengthArray>
+
+#include "cljpairlist.h"
+
+SireMM::CLJPairList __copy__(const SireMM::CLJPairList &other){ return SireMM::CLJPairList(other); }
+
+#include "Qt/qdatastream.hpp"
+
+#include "Helpers/str.hpp"
+
+void register_CLJPairList_class(){
+
+    { //::SireMM::CLJPairList
+        typedef bp::class_< SireMM::CLJPairList > CLJPairList_exposer_t;
+        CLJPairList_exposer_t CLJPairList_exposer = CLJPairList_exposer_t( "CLJPairList", bp::init< >() );
+        bp::scope CLJPairList_scope( CLJPairList_exposer );
+        CLJPairList_exposer.def( bp::init< SireUnits::Dimension::Length >(( bp::arg("skin") )) );
+        CLJPairList_exposer.def( bp::init< SireMM::CLJPairList const & >(( bp::arg("other") )) );
+        { //::SireMM::CLJPairList::atoms0
+        
+            typedef ::QVector< int > const & ( ::SireMM::CLJPairList::*atoms0_function_type )( int ) const;
+            atoms0_function_type atoms0_function_value( &::SireMM::CLJPairList::atoms0 );
+            
+            CLJPairList_exposer.def( 
+                "atoms0"
+                , atoms0_function_value
+                , ( bp::arg("i") )
+                , bp::return_value_policy< bp::copy_const_reference >() );
+        
+        }
+        { //::SireMM::CLJPairList::atoms1
+        
+            typedef ::QVector< int > const & ( ::SireMM::CLJPairList::*atoms1_function_type )( int ) const;
+            atoms1_function_type atoms1_function_value( &::SireMM::CLJPairList::atoms1 );
+            
+            CLJPairList_exposer.def( 
+                "atoms1"
+                , atoms1_function_value
+                , ( bp::arg("i") )
+                , bp::return_value_policy< bp::copy_const_reference >() );
+        
+        }
+        { //::SireMM::CLJPairList::clear
+        
+            typedef void ( ::SireMM::CLJPairList::*clear_function_type )(  ) ;
+            clear_function_type clear_function_value( &::SireMM::CLJPairList::clear );
+            
+            CLJPairList_exposer.def( 
+                "clear"
+                , clear_function_value );
+        
+        }
+        { //::SireMM::CLJPairList::defaultSkin
+        
+            typedef ::SireUnits::Dimension::Length ( *defaultSkin_function_type )(  );
+            defaultSkin_function_type defaultSkin_function_value( &::SireMM::CLJPairList::defaultSkin );
+            
+            CLJPairList_exposer.def( 
+                "defaultSkin"
+                , defaultSkin_function_value );
+        
+        }
+        { //::SireMM::CLJPairList::isEmpty
+        
+            typedef bool ( ::SireMM::CLJPairList::*isEmpty_function_type )(  ) const;
+            isEmpty_function_type isEmpty_function_value( &::SireMM::CLJPairList::isEmpty );
+            
+            CLJPairList_exposer.def( 
+                "isEmpty"
+                , isEmpty_function_value );
+        
+        }
+        { //::SireMM::CLJPairList::nBoxPairs
+        
+            typedef int ( ::SireMM::CLJPairList::*nBoxPairs_function_type )(  ) const;
+            nBoxPairs_function_type nBoxPairs_function_value( &::SireMM::CLJPairList::nBoxPairs );
+            
+            CLJPairList_exposer.def( 
+                "nBoxPairs"
+                , nBoxPairs_function_value );
+        
+        }
+        { //::SireMM::CLJPairList::nRebuilds
+        
+            typedef int ( ::SireMM::CLJPairList::*nRebuilds_function_type )(  ) const;
+            nRebuilds_function_type nRebuilds_function_value( &::SireMM::CLJPairList::nRebuilds );
+            
+            CLJPairList_exposer.def( 
+                "nRebuilds"
+                , nRebuilds_function_value );
+        
+        }
+        { //::SireMM::CLJPairList::needsRebuild
+        
+            typedef bool ( ::SireMM::CLJPairList::*needsRebuild_function_type )( ::SireMM::CLJFunction const &,::SireMM::CLJBoxes const & ) const;
+            needsRebuild_function_type needsRebuild_function_value( &::SireMM::CLJPairList::needsRebuild );
+            
+            CLJPairList_exposer.def( 
+                "needsRebuild"
+                , needsRebuild_function_value
+                , ( bp::arg("func"), bp::arg("boxes") ) );
+        
+        }
+        CLJPairList_exposer.def( bp::self != bp::self );
+        { //::SireMM::CLJPairList::operator=
+        
+            typedef ::SireMM::CLJPairList & ( ::SireMM::CLJPairList::*assign_function_type )( ::SireMM::CLJPairList const & ) ;
+            assign_function_type assign_function_value( &::SireMM::CLJPairList::operator= );
+            
+            CLJPairList_exposer.def( 
+                "assign"
+                , assign_function_value
+                , ( bp::arg("other") )
+                , bp::return_self< >() );
+        
+        }
+        CLJPairList_exposer.def( bp::self == bp::self );
+        { //::SireMM::CLJPairList::setSkin
+        
+            typedef void ( ::SireMM::CLJPairList::*setSkin_function_type )( ::SireUnits::Dimension::Length ) ;
+            setSkin_function_type setSkin_function_value( &::SireMM::CLJPairList::setSkin );
+            
+            CLJPairList_exposer.def( 
+                "setSkin"
+                , setSkin_function_value
+                , ( bp::arg("skin") ) );
+        
+        }
+        { //::SireMM::CLJPairList::skin
+        
+            typedef ::SireUnits::Dimension::Length ( ::SireMM::CLJPairList::*skin_function_type )(  ) const;
+            skin_function_type skin_function_value( &::SireMM::CLJPairList::skin );
+            
+            CLJPairList_exposer.def( 
+                "skin"
+                , skin_function_value );
+        
+        }
+        { //::SireMM::CLJPairList::toString
+        
+            typedef ::QString ( ::SireMM::CLJPairList::*toString_function_type )(  ) const;
+            toString_function_type toString_function_value( &::SireMM::CLJPairList::toString );
+            
+            CLJPairList_exposer.def( 
+                "toString"
+                , toString_function_value );
+        
+        }
+        { //::SireMM::CLJPairList::typeName
+        
+            typedef char const * ( *typeName_function_type )(  );
+            typeName_function_type typeName_function_value( &::SireMM::CLJPairList::typeName );
+            
+            CLJPairList_exposer.def( 
+                "typeName"
+                , typeName_function_value );
+        
+        }
+        { //::SireMM::CLJPairList::update
+        
+            typedef bool ( ::SireMM::CLJPairList::*update_function_type )( ::SireMM::CLJFunction const &,::SireMM::CLJBoxes const & ) ;
+            update_function_type update_function_value( &::SireMM::CLJPairList::update );
+            
+            CLJPairList_exposer.def( 
+                "update"
+                , update_function_value
+                , ( bp::arg("func"), bp::arg("boxes") ) );
+        
+        }
+        { //::SireMM::CLJPairList::what
+        
+            typedef char const * ( ::SireMM::CLJPairList::*what_function_type )(  ) const;
+            what_function_type what_function_value( &::SireMM::CLJPairList::what );
+            
+            CLJPairList_exposer.def( 
+                "what"
+                , what_function_value );
+        
+        }
+        CLJPairList_exposer.staticmethod( "defaultSkin" );
+        CLJPairList_exposer.staticmethod( "typeName" );
+        CLJPairList_exposer.def( "__copy__", &__copy__);
+        CLJPairList_exposer.def( "__deepcopy__", &__copy__);
+        CLJPairList_exposer.def( "clone", &__copy__);
+        CLJPairList_exposer.def( "__rlshift__", &__rlshift__QDataStream< ::SireMM::CLJPairList >,
+                            bp::return_internal_reference<1, bp::with_custodian_and_ward<1,2> >() );
+        CLJPairList_exposer.def( "__rrshift__", &__rrshift__QDataStream< ::SireMM::CLJPairList >,
+                            bp::return_internal_reference<1, bp::with_custodian_and_ward<1,2> >() );
+        CLJPairList_exposer.def( "__str__", &__str__< ::SireMM::CLJPairList > );
+        CLJPairList_exposer.def( "__repr__", &__str__< ::SireMM::CLJPairList > );
+    }
+
+}
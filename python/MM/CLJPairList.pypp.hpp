@@ -0,0 +1,10 @@
+// This file has been generated by Py++.
+
+// (C) Christopher Woods, GPL >= 2 License
+
+#ifndef CLJPairList_hpp__pyplusplus_wrapper
+#define CLJPairList_hpp__pyplusplus_wrapper
+
+void register_CLJPairList_class();
+
+#endif//CLJPairList_hpp__pyplusplus_wrapper
@@ -212,6 +212,17 @@ void register_GridFF_class(){
                 , setShiftElectrostatics_function_value
                 , ( bp::arg("on") ) );
         
+        }
+        { //::SireMM::GridFF::setUseLJGrid
+        
+            typedef void ( ::SireMM::GridFF::*setUseLJGrid_function_type )( bool ) ;
+            setUseLJGrid_function_type setUseLJGrid_function_value( &::SireMM::GridFF::setUseLJGrid );
+            
+            GridFF_exposer.def( 
+                "setUseLJGrid"
+                , setUseLJGrid_function_value
+                , ( bp::arg("on") ) );
+        
         }
         { //::SireMM::GridFF::setUseReactionField
         
@@ -223,6 +234,17 @@ void register_GridFF_class(){
                 , setUseReactionField_function_value
                 , ( bp::arg("on") ) );
         
+        }
+        { //::SireMM::GridFF::setUseTricubicInterpolation
+        
+            typedef void ( ::SireMM::GridFF::*setUseTricubicInterpolation_function_type )( bool ) ;
+            setUseTricubicInterpolation_function_type setUseTricubicInterpolation_function_value( &::SireMM::GridFF::setUseTricubicInterpolation );
+            
+            GridFF_exposer.def( 
+                "setUseTricubicInterpolation"
+                , setUseTricubicInterpolation_function_value
+                , ( bp::arg("on") ) );
+        
         }
         { //::SireMM::GridFF::spacing
         
@@ -243,6 +265,26 @@ void register_GridFF_class(){
                 "typeName"
                 , typeName_function_value );
         
+        }
+        { //::SireMM::GridFF::usesLJGrid
+        
+            typedef bool ( ::SireMM::GridFF::*usesLJGrid_function_type )(  ) const;
+            usesLJGrid_function_type usesLJGrid_function_value( &::SireMM::GridFF::usesLJGrid );
+            
+            GridFF_exposer.def( 
+                "usesLJGrid"
+                , usesLJGrid_function_value );
+        
+        }
+        { //::SireMM::GridFF::usesTricubicInterpolation
+        
+            typedef bool ( ::SireMM::GridFF::*usesTricubicInterpolation_function_type )(  ) const;
+            usesTricubicInterpolation_function_type usesTricubicInterpolation_function_value( &::SireMM::GridFF::usesTricubicInterpolation );
+            
+            GridFF_exposer.def( 
+                "usesTricubicInterpolation"
+                , usesTricubicInterpolation_function_value );
+        
         }
         { //::SireMM::GridFF::what
         
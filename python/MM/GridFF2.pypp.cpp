@@ -216,6 +216,17 @@ void register_GridFF2_class(){
                 , setShiftElectrostatics_function_value
                 , ( bp::arg("on") ) );
         
+        }
+        { //::SireMM::GridFF2::setUseLJGrid
+        
+            typedef void ( ::SireMM::GridFF2::*setUseLJGrid_function_type )( bool ) ;
+            setUseLJGrid_function_type setUseLJGrid_function_value( &::SireMM::GridFF2::setUseLJGrid );
+            
+            GridFF2_exposer.def( 
+                "setUseLJGrid"
+                , setUseLJGrid_function_value
+                , ( bp::arg("on") ) );
+        
         }
         { //::SireMM::GridFF2::setUseReactionField
         
@@ -227,6 +238,17 @@ void register_GridFF2_class(){
                 , setUseReactionField_function_value
                 , ( bp::arg("on") ) );
         
+        }
+        { //::SireMM::GridFF2::setUseTricubicInterpolation
+        
+            typedef void ( ::SireMM::GridFF2::*setUseTricubicInterpolation_function_type )( bool ) ;
+            setUseTricubicInterpolation_function_type setUseTricubicInterpolation_function_value( &::SireMM::GridFF2::setUseTricubicInterpolation );
+            
+            GridFF2_exposer.def( 
+                "setUseTricubicInterpolation"
+                , setUseTricubicInterpolation_function_value
+                , ( bp::arg("on") ) );
+        
         }
         { //::SireMM::GridFF2::spacing
         
@@ -247,6 +269,26 @@ void register_GridFF2_class(){
                 "typeName"
                 , typeName_function_value );
         
+        }
+        { //::SireMM::GridFF2::usesLJGrid
+        
+            typedef bool ( ::SireMM::GridFF2::*usesLJGrid_function_type )(  ) const;
+            usesLJGrid_function_type usesLJGrid_function_value( &::SireMM::GridFF2::usesLJGrid );
+            
+            GridFF2_exposer.def( 
+                "usesLJGrid"
+                , usesLJGrid_function_value );
+        
+        }
+        { //::SireMM::GridFF2::usesTricubicInterpolation
+        
+            typedef bool ( ::SireMM::GridFF2::*usesTricubicInterpolation_function_type )(  ) const;
+            usesTricubicInterpolation_function_type usesTricubicInterpolation_function_value( &::SireMM::GridFF2::usesTricubicInterpolation );
+            
+            GridFF2_exposer.def( 
+                "usesTricubicInterpolation"
+                , usesTricubicInterpolation_function_value );
+        
         }
         { //::SireMM::GridFF2::what
         
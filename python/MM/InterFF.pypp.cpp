@@ -179,6 +179,26 @@ void register_InterFF_class(){
                 "disableGrid"
                 , disableGrid_function_value );
         
+        }
+        { //::SireMM::InterFF::disableLJGrid
+        
+            typedef void ( ::SireMM::InterFF::*disableLJGrid_function_type )(  ) ;
+            disableLJGrid_function_type disableLJGrid_function_value( &::SireMM::InterFF::disableLJGrid );
+            
+            InterFF_exposer.def( 
+                "disableLJGrid"
+                , disableLJGrid_function_value );
+        
+        }
+        { //::SireMM::InterFF::disablePairList
+        
+            typedef void ( ::SireMM::InterFF::*disablePairList_function_type )(  ) ;
+            disablePairList_function_type disablePairList_function_value( &::SireMM::InterFF::disablePairList );
+            
+            InterFF_exposer.def( 
+                "disablePairList"
+                , disablePairList_function_value );
+        
         }
         { //::SireMM::InterFF::disableParallelCalculation
         
@@ -199,6 +219,16 @@ void register_InterFF_class(){
                 "disableReproducibleCalculation"
                 , disableReproducibleCalculation_function_value );
         
+        }
+        { //::SireMM::InterFF::disableTricubicInterpolation
+        
+            typedef void ( ::SireMM::InterFF::*disableTricubicInterpolation_function_type )(  ) ;
+            disableTricubicInterpolation_function_type disableTricubicInterpolation_function_value( &::SireMM::InterFF::disableTricubicInterpolation );
+            
+            InterFF_exposer.def( 
+                "disableTricubicInterpolation"
+                , disableTricubicInterpolation_function_value );
+        
         }
         { //::SireMM::InterFF::enableGrid
         
@@ -209,6 +239,26 @@ void register_InterFF_class(){
                 "enableGrid"
                 , enableGrid_function_value );
         
+        }
+        { //::SireMM::InterFF::enableLJGrid
+        
+            typedef void ( ::SireMM::InterFF::*enableLJGrid_function_type )(  ) ;
+            enableLJGrid_function_type enableLJGrid_function_value( &::SireMM::InterFF::enableLJGrid );
+            
+            InterFF_exposer.def( 
+                "enableLJGrid"
+                , enableLJGrid_function_value );
+        
+        }
+        { //::SireMM::InterFF::enablePairList
+        
+            typedef void ( ::SireMM::InterFF::*enablePairList_function_type )(  ) ;
+            enablePairList_function_type enablePairList_function_value( &::SireMM::InterFF::enablePairList );
+            
+            InterFF_exposer.def( 
+                "enablePairList"
+                , enablePairList_function_value );
+        
         }
         { //::SireMM::InterFF::enableParallelCalculation
         
@@ -229,6 +279,16 @@ void register_InterFF_class(){
                 "enableReproducibleCalculation"
                 , enableReproducibleCalculation_function_value );
         
+        }
+        { //::SireMM::InterFF::enableTricubicInterpolation
+        
+            typedef void ( ::SireMM::InterFF::*enableTricubicInterpolation_function_type )(  ) ;
+            enableTricubicInterpolation_function_type enableTricubicInterpolation_function_value( &::SireMM::InterFF::enableTricubicInterpolation );
+            
+            InterFF_exposer.def( 
+                "enableTricubicInterpolation"
+                , enableTricubicInterpolation_function_value );
+        
         }
         { //::SireMM::InterFF::fixedOnly
         
@@ -314,6 +374,16 @@ void register_InterFF_class(){
         
         }
         InterFF_exposer.def( bp::self == bp::self );
+        { //::SireMM::InterFF::pairListSkin
+        
+            typedef ::SireUnits::Dimension::Length ( ::SireMM::InterFF::*pairListSkin_function_type )(  ) const;
+            pairListSkin_function_type pairListSkin_function_value( &::SireMM::InterFF::pairListSkin );
+            
+            InterFF_exposer.def( 
+                "pairListSkin"
+                , pairListSkin_function_value );
+        
+        }
         { //::SireMM::InterFF::properties
         
             typedef ::SireBase::Properties const & ( ::SireMM::InterFF::*properties_function_type )(  ) const;
@@ -445,6 +515,17 @@ void register_InterFF_class(){
                 , setGridSpacing_function_value
                 , ( bp::arg("spacing") ) );
         
+        }
+        { //::SireMM::InterFF::setPairListSkin
+        
+            typedef void ( ::SireMM::InterFF::*setPairListSkin_function_type )( ::SireUnits::Dimension::Length ) ;
+            setPairListSkin_function_type setPairListSkin_function_value( &::SireMM::InterFF::setPairListSkin );
+            
+            InterFF_exposer.def( 
+                "setPairListSkin"
+                , setPairListSkin_function_value
+                , ( bp::arg("skin") ) );
+        
         }
         { //::SireMM::InterFF::setProperty
         
@@ -467,6 +548,28 @@ void register_InterFF_class(){
                 , setUseGrid_function_value
                 , ( bp::arg("on") ) );
         
+        }
+        { //::SireMM::InterFF::setUseLJGrid
+        
+            typedef void ( ::SireMM::InterFF::*setUseLJGrid_function_type )( bool ) ;
+            setUseLJGrid_function_type setUseLJGrid_function_value( &::SireMM::InterFF::setUseLJGrid );
+            
+            InterFF_exposer.def( 
+                "setUseLJGrid"
+                , setUseLJGrid_function_value
+                , ( bp::arg("on") ) );
+        
+        }
+        { //::SireMM::InterFF::setUsePairList
+        
+            typedef void ( ::SireMM::InterFF::*setUsePairList_function_type )( bool ) ;
+            setUsePairList_function_type setUsePairList_function_value( &::SireMM::InterFF::setUsePairList );
+            
+            InterFF_exposer.def( 
+                "setUsePairList"
+                , setUsePairList_function_value
+                , ( bp::arg("on") ) );
+        
         }
         { //::SireMM::InterFF::setUseParallelCalculation
         
@@ -489,6 +592,17 @@ void register_InterFF_class(){
                 , setUseReproducibleCalculation_function_value
                 , ( bp::arg("on") ) );
         
+        }
+        { //::SireMM::InterFF::setUseTricubicInterpolation
+        
+            typedef void ( ::SireMM::InterFF::*setUseTricubicInterpolation_function_type )( bool ) ;
+            setUseTricubicInterpolation_function_type setUseTricubicInterpolation_function_value( &::SireMM::InterFF::setUseTricubicInterpolation );
+            
+            InterFF_exposer.def( 
+                "setUseTricubicInterpolation"
+                , setUseTricubicInterpolation_function_value
+                , ( bp::arg("on") ) );
+        
         }
         { //::SireMM::InterFF::typeName
         
@@ -509,6 +623,26 @@ void register_InterFF_class(){
                 "usesGrid"
                 , usesGrid_function_value );
         
+        }
+        { //::SireMM::InterFF::usesLJGrid
+        
+            typedef bool ( ::SireMM::InterFF::*usesLJGrid_function_type )(  ) const;
+            usesLJGrid_function_type usesLJGrid_function_value( &::SireMM::InterFF::usesLJGrid );
+            
+            InterFF_exposer.def( 
+                "usesLJGrid"
+                , usesLJGrid_function_value );
+        
+        }
+        { //::SireMM::InterFF::usesPairList
+        
+            typedef bool ( ::SireMM::InterFF::*usesPairList_function_type )(  ) const;
+            usesPairList_function_type usesPairList_function_value( &::SireMM::InterFF::usesPairList );
+            
+            InterFF_exposer.def( 
+                "usesPairList"
+                , usesPairList_function_value );
+        
         }
         { //::SireMM::InterFF::usesParallelCalculation
         
@@ -529,6 +663,16 @@ void register_InterFF_class(){
                 "usesReproducibleCalculation"
                 , usesReproducibleCalculation_function_value );
         
+        }
+        { //::SireMM::InterFF::usesTricubicInterpolation
+        
+            typedef bool ( ::SireMM::InterFF::*usesTricubicInterpolation_function_type )(  ) const;
+            usesTricubicInterpolation_function_type usesTricubicInterpolation_function_value( &::SireMM::InterFF::usesTricubicInterpolation );
+            
+            InterFF_exposer.def( 
+                "usesTricubicInterpolation"
+                , usesTricubicInterpolation_function_value );
+        
         }
         { //::SireMM::InterFF::what
         
@@ -0,0 +1,428 @@
+// This file has been generated by Py++.
+
+// (C) Christopher Woods, GPL >= 2 License
+
+#include "boost/python.hpp"
+#include "Helpers/clone_const_reference.hpp"
+#include "PMEFF.pypp.hpp"
+
+namespace bp = boost::python;
+
+#include "SireBase/errors.h"
+
+#include "SireBase/lengthproperty.h"
+
+#include "SireBase/numberproperty.h"
+
+#include "SireError/errors.h"
+
+#include "SireFF/errors.h"
+
+#include "SireMaths/constants.h"
+
+#include "SireMaths/multifloat.h"
+
+#include "SireMaths/multiint.h"
+
+#include "SireMol/molecule.h"
+
+#include "SireMol/partialmolecule.h"
+
+#include "SireStream/datastream.h"
+
+#include "SireStream/shareddatastream.h"
+
+#include "SireUnits/units.h"
+
+#include "SireVol/periodicbox.h"
+
+#include "cljewaldfunction.h"
+
+#include "pmeff.h"
+
+#include <QDebug>
+
+#include <QHash>
+
+#include <cmath>
+
+#include <complex>
+
+#include "pmeff.h"
+
+SireMM::PMEFF __copy__(const SireMM::PMEFF &other){ return SireMM::PMEFF(other); }
+
+#include "Qt/qdatastream.hpp"
+
+#include "Helpers/str.hpp"
+
+#include "Helpers/len.hpp"
+
+void register_PMEFF_class(){
+
+    { //::SireMM::PMEFF
+        typedef bp::class_< SireMM::PMEFF, bp::bases< SireFF::FF3D, SireFF::G1FF, SireFF::FF, SireMol::MolGroupsBase, SireBase::Property > > PMEFF_exposer_t;
+        PMEFF_exposer_t PMEFF_exposer = PMEFF_exposer_t( "PMEFF", bp::init< >() );
+        bp::scope PMEFF_scope( PMEFF_exposer );
+        PMEFF_exposer.def( bp::init< QString const & >(( bp::arg("name") )) );
+        PMEFF_exposer.def( bp::init< SireMM::PMEFF const & >(( bp::arg("other") )) );
+        { //::SireMM::PMEFF::accept
+        
+            typedef void ( ::SireMM::PMEFF::*accept_function_type )(  ) ;
+            accept_function_type accept_function_value( &::SireMM::PMEFF::accept );
+            
+            PMEFF_exposer.def( 
+                "accept"
+                , accept_function_value );
+        
+        }
+        { //::SireMM::PMEFF::beta
+        
+            typedef double ( ::SireMM::PMEFF::*beta_function_type )(  ) const;
+            beta_function_type beta_function_value( &::SireMM::PMEFF::beta );
+            
+            PMEFF_exposer.def( 
+                "beta"
+                , beta_function_value );
+        
+        }
+        { //::SireMM::PMEFF::components
+        
+            typedef ::SireMM::CoulombComponent const & ( ::SireMM::PMEFF::*components_function_type )(  ) const;
+            components_function_type components_function_value( &::SireMM::PMEFF::components );
+            
+            PMEFF_exposer.def( 
+                "components"
+                , components_function_value
+                , bp::return_value_policy<bp::clone_const_reference>() );
+        
+        }
+        { //::SireMM::PMEFF::containsProperty
+        
+            typedef bool ( ::SireMM::PMEFF::*containsProperty_function_type )( ::QString const & ) const;
+            containsProperty_function_type containsProperty_function_value( &::SireMM::PMEFF::containsProperty );
+            
+            PMEFF_exposer.def( 
+                "containsProperty"
+                , containsProperty_function_value
+                , ( bp::arg("name") ) );
+        
+        }
+        { //::SireMM::PMEFF::coulombCutoff
+        
+            typedef ::SireUnits::Dimension::Length ( ::SireMM::PMEFF::*coulombCutoff_function_type )(  ) const;
+            coulombCutoff_function_type coulombCutoff_function_value( &::SireMM::PMEFF::coulombCutoff );
+            
+            PMEFF_exposer.def( 
+                "coulombCutoff"
+                , coulombCutoff_function_value );
+        
+        }
+        { //::SireMM::PMEFF::ewaldTolerance
+        
+            typedef double ( ::SireMM::PMEFF::*ewaldTolerance_function_type )(  ) const;
+            ewaldTolerance_function_type ewaldTolerance_function_value( &::SireMM::PMEFF::ewaldTolerance );
+            
+            PMEFF_exposer.def( 
+                "ewaldTolerance"
+                , ewaldTolerance_function_value );
+        
+        }
+        { //::SireMM::PMEFF::field
+        
+            typedef void ( ::SireMM::PMEFF::*field_function_type )( ::SireFF::FieldTable &,double ) ;
+            field_function_type field_function_value( &::SireMM::PMEFF::field );
+            
+            PMEFF_exposer.def( 
+                "field"
+                , field_function_value
+                , ( bp::arg("fieldtable"), bp::arg("scale_field")=1 ) );
+        
+        }
+        { //::SireMM::PMEFF::field
+        
+            typedef void ( ::SireMM::PMEFF::*field_function_type )( ::SireFF::FieldTable &,::SireCAS::Symbol const &,double ) ;
+            field_function_type field_function_value( &::SireMM::PMEFF::field );
+            
+            PMEFF_exposer.def( 
+                "field"
+                , field_function_value
+                , ( bp::arg("fieldtable"), bp::arg("component"), bp::arg("scale_field")=1 ) );
+        
+        }
+        { //::SireMM::PMEFF::field
+        
+            typedef void ( ::SireMM::PMEFF::*field_function_type )( ::SireFF::FieldTable &,::SireFF::Probe const &,double ) ;
+            field_function_type field_function_value( &::SireMM::PMEFF::field );
+            
+            PMEFF_exposer.def( 
+                "field"
+                , field_function_value
+                , ( bp::arg("fieldtable"), bp::arg("probe"), bp::arg("scale_field")=1 ) );
+        
+        }
+        { //::SireMM::PMEFF::field
+        
+            typedef void ( ::SireMM::PMEFF::*field_function_type )( ::SireFF::FieldTable &,::SireCAS::Symbol const &,::SireFF::Probe const &,double ) ;
+            field_function_type field_function_value( &::SireMM::PMEFF::field );
+            
+            PMEFF_exposer.def( 
+                "field"
+                , field_function_value
+                , ( bp::arg("fieldtable"), bp::arg("component"), bp::arg("probe"), bp::arg("scale_field")=1 ) );
+        
+        }
+        { //::SireMM::PMEFF::force
+        
+            typedef void ( ::SireMM::PMEFF::*force_function_type )( ::SireFF::ForceTable &,double ) ;
+            force_function_type force_function_value( &::SireMM::PMEFF::force );
+            
+            PMEFF_exposer.def( 
+                "force"
+                , force_function_value
+                , ( bp::arg("forcetable"), bp::arg("scale_force")=1 ) );
+        
+        }
+        { //::SireMM::PMEFF::force
+        
+            typedef void ( ::SireMM::PMEFF::*force_function_type )( ::SireFF::ForceTable &,::SireCAS::Symbol const &,double ) ;
+            force_function_type force_function_value( &::SireMM::PMEFF::force );
+            
+            PMEFF_exposer.def( 
+                "force"
+                , force_function_value
+                , ( bp::arg("forcetable"), bp::arg("symbol"), bp::arg("scale_force")=1 ) );
+        
+        }
+        { //::SireMM::PMEFF::gridSpacing
+        
+            typedef ::SireUnits::Dimension::Length ( ::SireMM::PMEFF::*gridSpacing_function_type )(  ) const;
+            gridSpacing_function_type gridSpacing_function_value( &::SireMM::PMEFF::gridSpacing );
+            
+            PMEFF_exposer.def( 
+                "gridSpacing"
+                , gridSpacing_function_value );
+        
+        }
+        { //::SireMM::PMEFF::mustNowRecalculateFromScratch
+        
+            typedef void ( ::SireMM::PMEFF::*mustNowRecalculateFromScratch_function_type )(  ) ;
+            mustNowRecalculateFromScratch_function_type mustNowRecalculateFromScratch_function_value( &::SireMM::PMEFF::mustNowRecalculateFromScratch );
+            
+            PMEFF_exposer.def( 
+                "mustNowRecalculateFromScratch"
+                , mustNowRecalculateFromScratch_function_value );
+        
+        }
+        PMEFF_exposer.def( bp::self != bp::self );
+        { //::SireMM::PMEFF::operator=
+        
+            typedef ::SireMM::PMEFF & ( ::SireMM::PMEFF::*assign_function_type )( ::SireMM::PMEFF const & ) ;
+            assign_function_type assign_function_value( &::SireMM::PMEFF::operator= );
+            
+            PMEFF_exposer.def( 
+                "assign"
+                , assign_function_value
+                , ( bp::arg("other") )
+                , bp::return_self< >() );
+        
+        }
+        PMEFF_exposer.def( bp::self == bp::self );
+        { //::SireMM::PMEFF::needsAccepting
+        
+            typedef bool ( ::SireMM::PMEFF::*needsAccepting_function_type )(  ) const;
+            needsAccepting_function_type needsAccepting_function_value( &::SireMM::PMEFF::needsAccepting );
+            
+            PMEFF_exposer.def( 
+                "needsAccepting"
+                , needsAccepting_function_value );
+        
+        }
+        { //::SireMM::PMEFF::potential
+        
+            typedef void ( ::SireMM::PMEFF::*potential_function_type )( ::SireFF::PotentialTable &,double ) ;
+            potential_function_type potential_function_value( &::SireMM::PMEFF::potential );
+            
+            PMEFF_exposer.def( 
+                "potential"
+                , potential_function_value
+                , ( bp::arg("potentialtable"), bp::arg("scale_potential")=1 ) );
+        
+        }
+        { //::SireMM::PMEFF::potential
+        
+            typedef void ( ::SireMM::PMEFF::*potential_function_type )( ::SireFF::PotentialTable &,::SireCAS::Symbol const &,double ) ;
+            potential_function_type potential_function_value( &::SireMM::PMEFF::potential );
+            
+            PMEFF_exposer.def( 
+                "potential"
+                , potential_function_value
+                , ( bp::arg("potentialtable"), bp::arg("component"), bp::arg("scale_potential")=1 ) );
+        
+        }
+        { //::SireMM::PMEFF::potential
+        
+            typedef void ( ::SireMM::PMEFF::*potential_function_type )( ::SireFF::PotentialTable &,::SireFF::Probe const &,double ) ;
+            potential_function_type potential_function_value( &::SireMM::PMEFF::potential );
+            
+            PMEFF_exposer.def( 
+                "potential"
+                , potential_function_value
+                , ( bp::arg("potentialtable"), bp::arg("probe"), bp::arg("scale_potential")=1 ) );
+        
+        }
+        { //::SireMM::PMEFF::potential
+        
+            typedef void ( ::SireMM::PMEFF::*potential_function_type )( ::SireFF::PotentialTable &,::SireCAS::Symbol const &,::SireFF::Probe const &,double ) ;
+            potential_function_type potential_function_value( &::SireMM::PMEFF::potential );
+            
+            PMEFF_exposer.def( 
+                "potential"
+                , potential_function_value
+                , ( bp::arg("potentialtable"), bp::arg("component"), bp::arg("probe"), bp::arg("scale_potential")=1 ) );
+        
+        }
+        { //::SireMM::PMEFF::properties
+        
+            typedef ::SireBase::Properties const & ( ::SireMM::PMEFF::*properties_function_type )(  ) const;
+            properties_function_type properties_function_value( &::SireMM::PMEFF::properties );
+            
+            PMEFF_exposer.def( 
+                "properties"
+                , properties_function_value
+                , bp::return_value_policy< bp::copy_const_reference >() );
+        
+        }
+        { //::SireMM::PMEFF::property
+        
+            typedef ::SireBase::Property const & ( ::SireMM::PMEFF::*property_function_type )( ::QString const & ) const;
+            property_function_type property_function_value( &::SireMM::PMEFF::property );
+            
+            PMEFF_exposer.def( 
+                "property"
+                , property_function_value
+                , ( bp::arg("name") )
+                , bp::return_value_policy<bp::clone_const_reference>() );
+        
+        }
+        { //::SireMM::PMEFF::setCoulombCutoff
+        
+            typedef void ( ::SireMM::PMEFF::*setCoulombCutoff_function_type )( ::SireUnits::Dimension::Length ) ;
+            setCoulombCutoff_function_type setCoulombCutoff_function_value( &::SireMM::PMEFF::setCoulombCutoff );
+            
+            PMEFF_exposer.def( 
+                "setCoulombCutoff"
+                , setCoulombCutoff_function_value
+                , ( bp::arg("cutoff") ) );
+        
+        }
+        { //::SireMM::PMEFF::setEwaldTolerance
+        
+            typedef void ( ::SireMM::PMEFF::*setEwaldTolerance_function_type )( double ) ;
+            setEwaldTolerance_function_type setEwaldTolerance_function_value( &::SireMM::PMEFF::setEwaldTolerance );
+            
+            PMEFF_exposer.def( 
+                "setEwaldTolerance"
+                , setEwaldTolerance_function_value
+                , ( bp::arg("tolerance") ) );
+        
+        }
+        { //::SireMM::PMEFF::setGridSpacing
+        
+            typedef void ( ::SireMM::PMEFF::*setGridSpacing_function_type )( ::SireUnits::Dimension::Length ) ;
+            setGridSpacing_function_type setGridSpacing_function_value( &::SireMM::PMEFF::setGridSpacing );
+            
+            PMEFF_exposer.def( 
+                "setGridSpacing"
+                , setGridSpacing_function_value
+                , ( bp::arg("spacing") ) );
+        
+        }
+        { //::SireMM::PMEFF::setProperty
+        
+            typedef bool ( ::SireMM::PMEFF::*setProperty_function_type )( ::QString const &,::SireBase::Property const & ) ;
+            setProperty_function_type setProperty_function_value( &::SireMM::PMEFF::setProperty );
+            
+            PMEFF_exposer.def( 
+                "setProperty"
+                , setProperty_function_value
+                , ( bp::arg("name"), bp::arg("property") ) );
+        
+        }
+        { //::SireMM::PMEFF::setSpace
+        
+            typedef bool ( ::SireMM::PMEFF::*setSpace_function_type )( ::SireVol::Space const & ) ;
+            setSpace_function_type setSpace_function_value( &::SireMM::PMEFF::setSpace );
+            
+            PMEFF_exposer.def( 
+                "setSpace"
+                , setSpace_function_value
+                , ( bp::arg("space") ) );
+        
+        }
+        { //::SireMM::PMEFF::setSplineOrder
+        
+            typedef void ( ::SireMM::PMEFF::*setSplineOrder_function_type )( int ) ;
+            setSplineOrder_function_type setSplineOrder_function_value( &::SireMM::PMEFF::setSplineOrder );
+            
+            PMEFF_exposer.def( 
+                "setSplineOrder"
+                , setSplineOrder_function_value
+                , ( bp::arg("order") ) );
+        
+        }
+        { //::SireMM::PMEFF::space
+        
+            typedef ::SireVol::Space const & ( ::SireMM::PMEFF::*space_function_type )(  ) const;
+            space_function_type space_function_value( &::SireMM::PMEFF::space );
+            
+            PMEFF_exposer.def( 
+                "space"
+                , space_function_value
+                , bp::return_value_policy<bp::clone_const_reference>() );
+        
+        }
+        { //::SireMM::PMEFF::splineOrder
+        
+            typedef int ( ::SireMM::PMEFF::*splineOrder_function_type )(  ) const;
+            splineOrder_function_type splineOrder_function_value( &::SireMM::PMEFF::splineOrder );
+            
+            PMEFF_exposer.def( 
+                "splineOrder"
+                , splineOrder_function_value );
+        
+        }
+        { //::SireMM::PMEFF::typeName
+        
+            typedef char const * ( *typeName_function_type )(  );
+            typeName_function_type typeName_function_value( &::SireMM::PMEFF::typeName );
+            
+            PMEFF_exposer.def( 
+                "typeName"
+                , typeName_function_value );
+        
+        }
+        { //::SireMM::PMEFF::what
+        
+            typedef char const * ( ::SireMM::PMEFF::*what_function_type )(  ) const;
+            what_function_type what_function_value( &::SireMM::PMEFF::what );
+            
+            PMEFF_exposer.def( 
+                "what"
+                , what_function_value );
+        
+        }
+        PMEFF_exposer.staticmethod( "typeName" );
+        PMEFF_exposer.def( "__copy__", &__copy__);
+        PMEFF_exposer.def( "__deepcopy__", &__copy__);
+        PMEFF_exposer.def( "clone", &__copy__);
+        PMEFF_exposer.def( "__rlshift__", &__rlshift__QDataStream< ::SireMM::PMEFF >,
+                            bp::return_internal_reference<1, bp::with_custodian_and_ward<1,2> >() );
+        PMEFF_exposer.def( "__rrshift__", &__rrshift__QDataStream< ::SireMM::PMEFF >,
+                            bp::return_internal_reference<1, bp::with_custodian_and_ward<1,2> >() );
+        PMEFF_exposer.def( "__str__", &__str__< ::SireMM::PMEFF > );
+        PMEFF_exposer.def( "__repr__", &__str__< ::SireMM::PMEFF > );
+        PMEFF_exposer.def( "__len__", &__len_count< ::SireMM::PMEFF > );
+    }
+
+}
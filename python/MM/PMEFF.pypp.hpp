@@ -0,0 +1,10 @@
+// This file has been generated by Py++.
+
+// (C) Christopher Woods, GPL >= 2 License
+
+#ifndef PMEFF_hpp__pyplusplus_wrapper
+#define PMEFF_hpp__pyplusplus_wrapper
+
+void register_PMEFF_class();
+
+#endif//PMEFF_hpp__pyplusplus_wrapper
@@ -17,6 +17,7 @@
 #include "cljboxes.h"
 #include "interljff.h"
 #include "cljnbpairs.h"
+#include "cljpairlist.h"
 #include "cljprobe.h"
 #include "intrasoftcljff.h"
 #include "switchingfunction.h"
@@ -53,6 +54,8 @@
 #include "restraint.h"
 #include "cljgroup.h"
 #include "gridff2.h"
+#include "cljewaldfunction.h"
+#include "pmeff.h"
 
 #include "Helpers/objectregistry.hpp"
 
@@ -60,6 +63,8 @@ void register_SireMM_objects()
 {
 
     ObjectRegistry::registerConverterFor< SireMM::CLJRFFunction >();
+    ObjectRegistry::registerConverterFor< SireMM::CLJEwaldFunction >();
+    ObjectRegistry::registerConverterFor< SireMM::PMEFF >();
     ObjectRegistry::registerConverterFor< SireMM::CLJIntraRFFunction >();
     ObjectRegistry::registerConverterFor< SireMM::CLJSoftRFFunction >();
     ObjectRegistry::registerConverterFor< SireMM::CLJSoftIntraRFFunction >();
@@ -91,6 +96,7 @@ void register_SireMM_objects()
     ObjectRegistry::registerConverterFor< SireMM::LJScaleFactor >();
     ObjectRegistry::registerConverterFor< SireMM::CLJScaleFactor >();
     ObjectRegistry::registerConverterFor< SireMM::CLJNBPairs >();
+    ObjectRegistry::registerConverterFor< SireMM::CLJPairList >();
     ObjectRegistry::registerConverterFor< SireMM::CoulombNBPairs >();
     ObjectRegistry::registerConverterFor< SireMM::LJNBPairs >();
     ObjectRegistry::registerConverterFor< SireMM::CoulombProbe >();
@@ -39,6 +39,8 @@
 
 #include "BondSymbols.pypp.hpp"
 
+#include "BondedTerms.pypp.hpp"
+
 #include "CHARMMSwitchingFunction.pypp.hpp"
 
 #include "CLJ14Group.pypp.hpp"
@@ -63,12 +65,16 @@
 
 #include "CLJDelta.pypp.hpp"
 
+#include "CLJEwaldFunction.pypp.hpp"
+
 #include "CLJExtractor.pypp.hpp"
 
 #include "CLJFunction.pypp.hpp"
 
 #include "CLJGrid.pypp.hpp"
 
+#include "CLJGridCache.pypp.hpp"
+
 #include "CLJGroup.pypp.hpp"
 
 #include "CLJIntraFunction.pypp.hpp"
@@ -79,6 +85,8 @@
 
 #include "CLJNBPairs.pypp.hpp"
 
+#include "CLJPairList.pypp.hpp"
+
 #include "CLJParameterNames.pypp.hpp"
 
 #include "CLJParameterNames3D.pypp.hpp"
@@ -285,6 +293,8 @@
 
 #include "NullRestraint.pypp.hpp"
 
+#include "PMEFF.pypp.hpp"
+
 #include "Restraint.pypp.hpp"
 
 #include "Restraint3D.pypp.hpp"
@@ -484,6 +494,8 @@ BOOST_PYTHON_MODULE(_MM){
 
     register_BondSymbols_class();
 
+    register_BondedTerms_class();
+
     register_SwitchingFunction_class();
 
     register_CHARMMSwitchingFunction_class();
@@ -512,10 +524,14 @@ BOOST_PYTHON_MODULE(_MM){
 
     register_CLJDelta_class();
 
+    register_CLJEwaldFunction_class();
+
     register_CLJExtractor_class();
 
     register_CLJGrid_class();
 
+    register_CLJGridCache_class();
+
     register_CLJGroup_class();
 
     register_CLJIntraFunction_class();
@@ -526,6 +542,8 @@ BOOST_PYTHON_MODULE(_MM){
 
     register_CLJNBPairs_class();
 
+    register_CLJPairList_class();
+
     register_ChargeParameterName_class();
 
     register_LJParameterName_class();
@@ -652,6 +670,8 @@ BOOST_PYTHON_MODULE(_MM){
 
     register_NullRestraint_class();
 
+    register_PMEFF_class();
+
     register_RestraintComponent_class();
 
     register_RestraintFF_class();
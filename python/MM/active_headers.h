@@ -6,15 +6,18 @@
 #include "anglerestraint.h"
 #include "atomfunctions.h"
 #include "atomljs.h"
+#include "bondedterms.h"
 #include "clj14group.h"
 #include "cljatoms.h"
 #include "cljboxes.h"
 #include "cljcalculator.h"
 #include "cljcomponent.h"
 #include "cljdelta.h"
+#include "cljewaldfunction.h"
 #include "cljextractor.h"
 #include "cljfunction.h"
 #include "cljgrid.h"
+#include "cljgridcache.h"
 #include "cljgroup.h"
 #include "cljnbpairs.h"
 #include "cljparam.h"
@@ -50,6 +53,7 @@
 #include "ljperturbation.h"
 #include "ljpotential.h"
 #include "multicljcomponent.h"
+#include "pmeff.h"
 #include "restraint.h"
 #include "restraintcomponent.h"
 #include "restraintff.h"
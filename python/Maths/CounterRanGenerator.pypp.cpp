@@ -0,0 +1,337 @@
+// This file has been generated by Py++.
+
+// (C) Christopher Woods, GPL >= 2 License
+
+#include "boost/python.hpp"
+#include "CounterRanGenerator.pypp.hpp"
+
+namespace bp = boost::python;
+
+#include "SireStream/datastream.h"
+
+#include "counterrangenerator.h"
+
+#include "rangenerator.h"
+
+#include "vector.h"
+
+#include <cmath>
+
+#include "counterrangenerator.h"
+
+SireMaths::CounterRanGenerator __copy__(const SireMaths::CounterRanGenerator &other){ return SireMaths::CounterRanGenerator(other); }
+
+#include "Qt/qdatastream.hpp"
+
+#include "Helpers/str.hpp"
+
+void register_CounterRanGenerator_class(){
+
+    { //::SireMaths::CounterRanGenerator
+        typedef bp::class_< SireMaths::CounterRanGenerator > CounterRanGenerator_exposer_t;
+        CounterRanGenerator_exposer_t CounterRanGenerator_exposer = CounterRanGenerator_exposer_t( "CounterRanGenerator", bp::init< >() );
+        bp::scope CounterRanGenerator_scope( CounterRanGenerator_exposer );
+        CounterRanGenerator_exposer.def( bp::init< quint64, bp::optional< quint64 > >(( bp::arg("seed"), bp::arg("stream")=(quint64)(0) )) );
+        CounterRanGenerator_exposer.def( bp::init< SireMaths::RanGenerator const & >(( bp::arg("generator") )) );
+        CounterRanGenerator_exposer.def( bp::init< SireMaths::CounterRanGenerator const & >(( bp::arg("other") )) );
+        { //::SireMaths::CounterRanGenerator::counter
+        
+            typedef ::quint64 ( ::SireMaths::CounterRanGenerator::*counter_function_type )(  ) const;
+            counter_function_type counter_function_value( &::SireMaths::CounterRanGenerator::counter );
+            
+            CounterRanGenerator_exposer.def( 
+                "counter"
+                , counter_function_value );
+        
+        }
+        { //::SireMaths::CounterRanGenerator::fill
+        
+            typedef void ( ::SireMaths::CounterRanGenerator::*fill_function_type )( ::QVector< double > & ) ;
+            fill_function_type fill_function_value( &::SireMaths::CounterRanGenerator::fill );
+            
+            CounterRanGenerator_exposer.def( 
+                "fill"
+                , fill_function_value
+                , ( bp::arg("values") ) );
+        
+        }
+        { //::SireMaths::CounterRanGenerator::fill
+        
+            typedef void ( ::SireMaths::CounterRanGenerator::*fill_function_type )( ::QVector< double > &,double,double ) ;
+            fill_function_type fill_function_value( &::SireMaths::CounterRanGenerator::fill );
+            
+            CounterRanGenerator_exposer.def( 
+                "fill"
+                , fill_function_value
+                , ( bp::arg("values"), bp::arg("minval"), bp::arg("maxval") ) );
+        
+        }
+        { //::SireMaths::CounterRanGenerator::fillNorm
+        
+            typedef void ( ::SireMaths::CounterRanGenerator::*fillNorm_function_type )( ::QVector< double > &,double,double ) ;
+            fillNorm_function_type fillNorm_function_value( &::SireMaths::CounterRanGenerator::fillNorm );
+            
+            CounterRanGenerator_exposer.def( 
+                "fillNorm"
+                , fillNorm_function_value
+                , ( bp::arg("values"), bp::arg("mean"), bp::arg("variance") ) );
+        
+        }
+        CounterRanGenerator_exposer.def( bp::self != bp::self );
+        { //::SireMaths::CounterRanGenerator::operator=
+        
+            typedef ::SireMaths::CounterRanGenerator & ( ::SireMaths::CounterRanGenerator::*assign_function_type )( ::SireMaths::CounterRanGenerator const & ) ;
+            assign_function_type assign_function_value( &::SireMaths::CounterRanGenerator::operator= );
+            
+            CounterRanGenerator_exposer.def( 
+                "assign"
+                , assign_function_value
+                , ( bp::arg("other") )
+                , bp::return_self< >() );
+        
+        }
+        CounterRanGenerator_exposer.def( bp::self == bp::self );
+        { //::SireMaths::CounterRanGenerator::rand
+        
+            typedef double ( ::SireMaths::CounterRanGenerator::*rand_function_type )(  ) ;
+            rand_function_type rand_function_value( &::SireMaths::CounterRanGenerator::rand );
+            
+            CounterRanGenerator_exposer.def( 
+                "rand"
+                , rand_function_value );
+        
+        }
+        { //::SireMaths::CounterRanGenerator::rand
+        
+            typedef double ( ::SireMaths::CounterRanGenerator::*rand_function_type )( double ) ;
+            rand_function_type rand_function_value( &::SireMaths::CounterRanGenerator::rand );
+            
+            CounterRanGenerator_exposer.def( 
+                "rand"
+                , rand_function_value
+                , ( bp::arg("maxval") ) );
+        
+        }
+        { //::SireMaths::CounterRanGenerator::rand
+        
+            typedef double ( ::SireMaths::CounterRanGenerator::*rand_function_type )( double,double ) ;
+            rand_function_type rand_function_value( &::SireMaths::CounterRanGenerator::rand );
+            
+            CounterRanGenerator_exposer.def( 
+                "rand"
+                , rand_function_value
+                , ( bp::arg("minval"), bp::arg("maxval") ) );
+        
+        }
+        { //::SireMaths::CounterRanGenerator::rand53
+        
+            typedef double ( ::SireMaths::CounterRanGenerator::*rand53_function_type )(  ) ;
+            rand53_function_type rand53_function_value( &::SireMaths::CounterRanGenerator::rand53 );
+            
+            CounterRanGenerator_exposer.def( 
+                "rand53"
+                , rand53_function_value );
+        
+        }
+        { //::SireMaths::CounterRanGenerator::rand53
+        
+            typedef double ( ::SireMaths::CounterRanGenerator::*rand53_function_type )( double ) ;
+            rand53_function_type rand53_function_value( &::SireMaths::CounterRanGenerator::rand53 );
+            
+            CounterRanGenerator_exposer.def( 
+                "rand53"
+                , rand53_function_value
+                , ( bp::arg("maxval") ) );
+        
+        }
+        { //::SireMaths::CounterRanGenerator::rand53
+        
+            typedef double ( ::SireMaths::CounterRanGenerator::*rand53_function_type )( double,double ) ;
+            rand53_function_type rand53_function_value( &::SireMaths::CounterRanGenerator::rand53 );
+            
+            CounterRanGenerator_exposer.def( 
+                "rand53"
+                , rand53_function_value
+                , ( bp::arg("minval"), bp::arg("maxval") ) );
+        
+        }
+        { //::SireMaths::CounterRanGenerator::randBool
+        
+            typedef bool ( ::SireMaths::CounterRanGenerator::*randBool_function_type )(  ) ;
+            randBool_function_type randBool_function_value( &::SireMaths::CounterRanGenerator::randBool );
+            
+            CounterRanGenerator_exposer.def( 
+                "randBool"
+                , randBool_function_value );
+        
+        }
+        { //::SireMaths::CounterRanGenerator::randInt
+        
+            typedef ::quint32 ( ::SireMaths::CounterRanGenerator::*randInt_function_type )(  ) ;
+            randInt_function_type randInt_function_value( &::SireMaths::CounterRanGenerator::randInt );
+            
+            CounterRanGenerator_exposer.def( 
+                "randInt"
+                , randInt_function_value );
+        
+        }
+        { //::SireMaths::CounterRanGenerator::randInt
+        
+            typedef ::quint32 ( ::SireMaths::CounterRanGenerator::*randInt_function_type )( ::quint32 ) ;
+            randInt_function_type randInt_function_value( &::SireMaths::CounterRanGenerator::randInt );
+            
+            CounterRanGenerator_exposer.def( 
+                "randInt"
+                , randInt_function_value
+                , ( bp::arg("maxval") ) );
+        
+        }
+        { //::SireMaths::CounterRanGenerator::randInt
+        
+            typedef ::qint32 ( ::SireMaths::CounterRanGenerator::*randInt_function_type )( ::qint32,::qint32 ) ;
+            randInt_function_type randInt_function_value( &::SireMaths::CounterRanGenerator::randInt );
+            
+            CounterRanGenerator_exposer.def( 
+                "randInt"
+                , randInt_function_value
+                , ( bp::arg("minval"), bp::arg("maxval") ) );
+        
+        }
+        { //::SireMaths::CounterRanGenerator::randInt64
+        
+            typedef ::quint64 ( ::SireMaths::CounterRanGenerator::*randInt64_function_type )(  ) ;
+            randInt64_function_type randInt64_function_value( &::SireMaths::CounterRanGenerator::randInt64 );
+            
+            CounterRanGenerator_exposer.def( 
+                "randInt64"
+                , randInt64_function_value );
+        
+        }
+        { //::SireMaths::CounterRanGenerator::randNorm
+        
+            typedef double ( ::SireMaths::CounterRanGenerator::*randNorm_function_type )( double,double ) ;
+            randNorm_function_type randNorm_function_value( &::SireMaths::CounterRanGenerator::randNorm );
+            
+            CounterRanGenerator_exposer.def( 
+                "randNorm"
+                , randNorm_function_value
+                , ( bp::arg("mean"), bp::arg("variance") ) );
+        
+        }
+        { //::SireMaths::CounterRanGenerator::seed
+        
+            typedef ::quint64 ( ::SireMaths::CounterRanGenerator::*seed_function_type )(  ) const;
+            seed_function_type seed_function_value( &::SireMaths::CounterRanGenerator::seed );
+            
+            CounterRanGenerator_exposer.def( 
+                "seed"
+                , seed_function_value );
+        
+        }
+        { //::SireMaths::CounterRanGenerator::setCounter
+        
+            typedef void ( ::SireMaths::CounterRanGenerator::*setCounter_function_type )( ::quint64 ) ;
+            setCounter_function_type setCounter_function_value( &::SireMaths::CounterRanGenerator::setCounter );
+            
+            CounterRanGenerator_exposer.def( 
+                "setCounter"
+                , setCounter_function_value
+                , ( bp::arg("counter") ) );
+        
+        }
+        { //::SireMaths::CounterRanGenerator::skip
+        
+            typedef void ( ::SireMaths::CounterRanGenerator::*skip_function_type )( ::quint64 ) ;
+            skip_function_type skip_function_value( &::SireMaths::CounterRanGenerator::skip );
+            
+            CounterRanGenerator_exposer.def( 
+                "skip"
+                , skip_function_value
+                , ( bp::arg("n") ) );
+        
+        }
+        { //::SireMaths::CounterRanGenerator::stream
+        
+            typedef ::quint64 ( ::SireMaths::CounterRanGenerator::*stream_function_type )(  ) const;
+            stream_function_type stream_function_value( &::SireMaths::CounterRanGenerator::stream );
+            
+            CounterRanGenerator_exposer.def( 
+                "stream"
+                , stream_function_value );
+        
+        }
+        { //::SireMaths::CounterRanGenerator::substream
+        
+            typedef ::SireMaths::CounterRanGenerator ( ::SireMaths::CounterRanGenerator::*substream_function_type )( ::quint64 ) const;
+            substream_function_type substream_function_value( &::SireMaths::CounterRanGenerator::substream );
+            
+            CounterRanGenerator_exposer.def( 
+                "substream"
+                , substream_function_value
+                , ( bp::arg("stream") ) );
+        
+        }
+        { //::SireMaths::CounterRanGenerator::toString
+        
+            typedef ::QString ( ::SireMaths::CounterRanGenerator::*toString_function_type )(  ) const;
+            toString_function_type toString_function_value( &::SireMaths::CounterRanGenerator::toString );
+            
+            CounterRanGenerator_exposer.def( 
+                "toString"
+                , toString_function_value );
+        
+        }
+        { //::SireMaths::CounterRanGenerator::typeName
+        
+            typedef char const * ( *typeName_function_type )(  );
+            typeName_function_type typeName_function_value( &::SireMaths::CounterRanGenerator::typeName );
+            
+            CounterRanGenerator_exposer.def( 
+                "typeName"
+                , typeName_function_value );
+        
+        }
+        { //::SireMaths::CounterRanGenerator::vectorOnSphere
+        
+            typedef ::SireMaths::Vector ( ::SireMaths::CounterRanGenerator::*vectorOnSphere_function_type )(  ) ;
+            vectorOnSphere_function_type vectorOnSphere_function_value( &::SireMaths::CounterRanGenerator::vectorOnSphere );
+            
+            CounterRanGenerator_exposer.def( 
+                "vectorOnSphere"
+                , vectorOnSphere_function_value );
+        
+        }
+        { //::SireMaths::CounterRanGenerator::vectorOnSphere
+        
+            typedef ::SireMaths::Vector ( ::SireMaths::CounterRanGenerator::*vectorOnSphere_function_type )( double ) ;
+            vectorOnSphere_function_type vectorOnSphere_function_value( &::SireMaths::CounterRanGenerator::vectorOnSphere );
+            
+            CounterRanGenerator_exposer.def( 
+                "vectorOnSphere"
+                , vectorOnSphere_function_value
+                , ( bp::arg("radius") ) );
+        
+        }
+        { //::SireMaths::CounterRanGenerator::what
+        
+            typedef char const * ( ::SireMaths::CounterRanGenerator::*what_function_type )(  ) const;
+            what_function_type what_function_value( &::SireMaths::CounterRanGenerator::what );
+            
+            CounterRanGenerator_exposer.def( 
+                "what"
+                , what_function_value );
+        
+        }
+        CounterRanGenerator_exposer.staticmethod( "typeName" );
+        CounterRanGenerator_exposer.def( "__copy__", &__copy__);
+        CounterRanGenerator_exposer.def( "__deepcopy__", &__copy__);
+        CounterRanGenerator_exposer.def( "clone", &__copy__);
+        CounterRanGenerator_exposer.def( "__rlshift__", &__rlshift__QDataStream< ::SireMaths::CounterRanGenerator >,
+                            bp::return_internal_reference<1, bp::with_custodian_and_ward<1,2> >() );
+        CounterRanGenerator_exposer.def( "__rrshift__", &__rrshift__QDataStream< ::SireMaths::CounterRanGenerator >,
+                            bp::return_internal_reference<1, bp::with_custodian_and_ward<1,2> >() );
+        CounterRanGenerator_exposer.def( "__str__", &__str__< ::SireMaths::CounterRanGenerator > );
+        CounterRanGenerator_exposer.def( "__repr__", &__str__< ::SireMaths::CounterRanGenerator > );
+    }
+
+}
@@ -0,0 +1,10 @@
+// This file has been generated by Py++.
+
+// (C) Christopher Woods, GPL >= 2 License
+
+#ifndef CounterRanGenerator_hpp__pyplusplus_wrapper
+#define CounterRanGenerator_hpp__pyplusplus_wrapper
+
+void register_CounterRanGenerator_class();
+
+#endif//CounterRanGenerator_hpp__pyplusplus_wrapper
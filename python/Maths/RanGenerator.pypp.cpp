@@ -48,6 +48,39 @@ void register_RanGenerator_class(){
         RanGenerator_exposer.def( bp::init< quint32 >(( bp::arg("seed") )) );
         RanGenerator_exposer.def( bp::init< QVector< unsigned int > const & >(( bp::arg("seed") )) );
         RanGenerator_exposer.def( bp::init< SireMaths::RanGenerator const & >(( bp::arg("other") )) );
+        { //::SireMaths::RanGenerator::fill
+        
+            typedef void ( ::SireMaths::RanGenerator::*fill_function_type )( ::QVector< double > & ) const;
+            fill_function_type fill_function_value( &::SireMaths::RanGenerator::fill );
+            
+            RanGenerator_exposer.def( 
+                "fill"
+                , fill_function_value
+                , ( bp::arg("values") ) );
+        
+        }
+        { //::SireMaths::RanGenerator::fill
+        
+            typedef void ( ::SireMaths::RanGenerator::*fill_function_type )( ::QVector< double > &,double,double ) const;
+            fill_function_type fill_function_value( &::SireMaths::RanGenerator::fill );
+            
+            RanGenerator_exposer.def( 
+                "fill"
+                , fill_function_value
+                , ( bp::arg("values"), bp::arg("minval"), bp::arg("maxval") ) );
+        
+        }
+        { //::SireMaths::RanGenerator::fillNorm
+        
+            typedef void ( ::SireMaths::RanGenerator::*fillNorm_function_type )( ::QVector< double > &,double,double ) const;
+            fillNorm_function_type fillNorm_function_value( &::SireMaths::RanGenerator::fillNorm );
+            
+            RanGenerator_exposer.def( 
+                "fillNorm"
+                , fillNorm_function_value
+                , ( bp::arg("values"), bp::arg("mean"), bp::arg("variance") ) );
+        
+        }
         { //::SireMaths::RanGenerator::getState
         
             typedef ::QVector< unsigned int > ( ::SireMaths::RanGenerator::*getState_function_type )(  ) const;
@@ -21,6 +21,7 @@
 #include "trigmatrix.h"
 #include "torsion.h"
 #include "rangenerator.h"
+#include "counterrangenerator.h"
 #include "axisset.h"
 #include "plane.h"
 #include "complex.h"
@@ -55,6 +56,7 @@ void register_SireMaths_objects()
     ObjectRegistry::registerConverterFor< SireMaths::TrigMatrix >();
     ObjectRegistry::registerConverterFor< SireMaths::Torsion >();
     ObjectRegistry::registerConverterFor< SireMaths::RanGenerator >();
+    ObjectRegistry::registerConverterFor< SireMaths::CounterRanGenerator >();
     ObjectRegistry::registerConverterFor< SireMaths::AxisSet >();
     ObjectRegistry::registerConverterFor< SireMaths::Plane >();
     ObjectRegistry::registerConverterFor< SireMaths::Complex >();
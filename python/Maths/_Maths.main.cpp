@@ -27,6 +27,8 @@
 
 #include "Complex.pypp.hpp"
 
+#include "CounterRanGenerator.pypp.hpp"
+
 #include "DistVector.pypp.hpp"
 
 #include "ExpAverage.pypp.hpp"
@@ -176,6 +178,8 @@ BOOST_PYTHON_MODULE(_Maths){
 
     register_RanGenerator_class();
 
+    register_CounterRanGenerator_class();
+
     register_RecordValues_class();
 
     register_Sphere_class();
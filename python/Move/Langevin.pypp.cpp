@@ -0,0 +1,238 @@
+// This file has been generated by Py++.
+
+// (C) Christopher Woods, GPL >= 2 License
+
+#include "boost/python.hpp"
+#include "Langevin.pypp.hpp"
+
+namespace bp = boost::python;
+
+#include "SireError/errors.h"
+
+#include "SireFF/forcetable.h"
+
+#include "SireMaths/rangenerator.h"
+
+#include "SireMol/molecule.h"
+
+#include "SireMol/moleculegroup.h"
+
+#include "SireMol/partialmolecule.h"
+
+#include "SireStream/datastream.h"
+
+#include "SireStream/shareddatastream.h"
+
+#include "SireSystem/system.h"
+
+#include "SireUnits/temperature.h"
+
+#include "SireUnits/units.h"
+
+#include "ensemble.h"
+
+#include "langevin.h"
+
+#include <cmath>
+
+#include "langevin.h"
+
+SireMove::Langevin __copy__(const SireMove::Langevin &other){ return SireMove::Langevin(other); }
+
+#include "Qt/qdatastream.hpp"
+
+#include "Helpers/str.hpp"
+
+void register_Langevin_class(){
+
+    { //::SireMove::Langevin
+        typedef bp::class_< SireMove::Langevin, bp::bases< SireMove::Integrator, SireBase::Property > > Langevin_exposer_t;
+        Langevin_exposer_t Langevin_exposer = Langevin_exposer_t( "Langevin", bp::init< bp::optional< bool > >(( bp::arg("frequent_save_velocities")=(bool)(false) )) );
+        bp::scope Langevin_scope( Langevin_exposer );
+        Langevin_exposer.def( bp::init< SireUnits::Dimension::Temperature, bp::optional< bool > >(( bp::arg("temperature"), bp::arg("frequent_save_velocities")=(bool)(false) )) );
+        Langevin_exposer.def( bp::init< SireUnits::Dimension::Temperature, SireUnits::Dimension::Time, bp::optional< bool > >(( bp::arg("temperature"), bp::arg("relaxation_time"), bp::arg("frequent_save_velocities")=(bool)(false) )) );
+        Langevin_exposer.def( bp::init< SireMove::Langevin const & >(( bp::arg("other") )) );
+        { //::SireMove::Langevin::constraintTolerance
+        
+            typedef double ( ::SireMove::Langevin::*constraintTolerance_function_type )(  ) const;
+            constraintTolerance_function_type constraintTolerance_function_value( &::SireMove::Langevin::constraintTolerance );
+            
+            Langevin_exposer.def( 
+                "constraintTolerance"
+                , constraintTolerance_function_value );
+        
+        }
+        { //::SireMove::Langevin::constraintType
+        
+            typedef ::QString ( ::SireMove::Langevin::*constraintType_function_type )(  ) const;
+            constraintType_function_type constraintType_function_value( &::SireMove::Langevin::constraintType );
+            
+            Langevin_exposer.def( 
+                "constraintType"
+                , constraintType_function_value );
+        
+        }
+        { //::SireMove::Langevin::createWorkspace
+        
+            typedef ::SireMove::IntegratorWorkspacePtr ( ::SireMove::Langevin::*createWorkspace_function_type )( ::SireBase::PropertyMap const & ) const;
+            createWorkspace_function_type createWorkspace_function_value( &::SireMove::Langevin::createWorkspace );
+            
+            Langevin_exposer.def( 
+                "createWorkspace"
+                , createWorkspace_function_value
+                , ( bp::arg("map")=SireBase::PropertyMap() ) );
+        
+        }
+        { //::SireMove::Langevin::createWorkspace
+        
+            typedef ::SireMove::IntegratorWorkspacePtr ( ::SireMove::Langevin::*createWorkspace_function_type )( ::SireMol::MoleculeGroup const &,::SireBase::PropertyMap const & ) const;
+            createWorkspace_function_type createWorkspace_function_value( &::SireMove::Langevin::createWorkspace );
+            
+            Langevin_exposer.def( 
+                "createWorkspace"
+                , createWorkspace_function_value
+                , ( bp::arg("molgroup"), bp::arg("map")=SireBase::PropertyMap() ) );
+        
+        }
+        { //::SireMove::Langevin::ensemble
+        
+            typedef ::SireMove::Ensemble ( ::SireMove::Langevin::*ensemble_function_type )(  ) const;
+            ensemble_function_type ensemble_function_value( &::SireMove::Langevin::ensemble );
+            
+            Langevin_exposer.def( 
+                "ensemble"
+                , ensemble_function_value );
+        
+        }
+        { //::SireMove::Langevin::integrate
+        
+            typedef void ( ::SireMove::Langevin::*integrate_function_type )( ::SireMove::IntegratorWorkspace &,::SireCAS::Symbol const &,::SireUnits::Dimension::Time,int,bool ) const;
+            integrate_function_type integrate_function_value( &::SireMove::Langevin::integrate );
+            
+            Langevin_exposer.def( 
+                "integrate"
+                , integrate_function_value
+                , ( bp::arg("workspace"), bp::arg("nrg_component"), bp::arg("timestep"), bp::arg("nmoves"), bp::arg("record_stats") ) );
+        
+        }
+        { //::SireMove::Langevin::isTimeReversible
+        
+            typedef bool ( ::SireMove::Langevin::*isTimeReversible_function_type )(  ) const;
+            isTimeReversible_function_type isTimeReversible_function_value( &::SireMove::Langevin::isTimeReversible );
+            
+            Langevin_exposer.def( 
+                "isTimeReversible"
+                , isTimeReversible_function_value );
+        
+        }
+        Langevin_exposer.def( bp::self != bp::self );
+        { //::SireMove::Langevin::operator=
+        
+            typedef ::SireMove::Langevin & ( ::SireMove::Langevin::*assign_function_type )( ::SireMove::Langevin const & ) ;
+            assign_function_type assign_function_value( &::SireMove::Langevin::operator= );
+            
+            Langevin_exposer.def( 
+                "assign"
+                , assign_function_value
+                , ( bp::arg("other") )
+                , bp::return_self< >() );
+        
+        }
+        Langevin_exposer.def( bp::self == bp::self );
+        { //::SireMove::Langevin::relaxationTime
+        
+            typedef ::SireUnits::Dimension::Time ( ::SireMove::Langevin::*relaxationTime_function_type )(  ) const;
+            relaxationTime_function_type relaxationTime_function_value( &::SireMove::Langevin::relaxationTime );
+            
+            Langevin_exposer.def( 
+                "relaxationTime"
+                , relaxationTime_function_value );
+        
+        }
+        { //::SireMove::Langevin::setConstraintTolerance
+        
+            typedef void ( ::SireMove::Langevin::*setConstraintTolerance_function_type )( double ) ;
+            setConstraintTolerance_function_type setConstraintTolerance_function_value( &::SireMove::Langevin::setConstraintTolerance );
+            
+            Langevin_exposer.def( 
+                "setConstraintTolerance"
+                , setConstraintTolerance_function_value
+                , ( bp::arg("tolerance") ) );
+        
+        }
+        { //::SireMove::Langevin::setConstraintType
+        
+            typedef void ( ::SireMove::Langevin::*setConstraintType_function_type )( ::QString const & ) ;
+            setConstraintType_function_type setConstraintType_function_value( &::SireMove::Langevin::setConstraintType );
+            
+            Langevin_exposer.def( 
+                "setConstraintType"
+                , setConstraintType_function_value
+                , ( bp::arg("constraint_type") ) );
+        
+        }
+        { //::SireMove::Langevin::setRelaxationTime
+        
+            typedef void ( ::SireMove::Langevin::*setRelaxationTime_function_type )( ::SireUnits::Dimension::Time ) ;
+            setRelaxationTime_function_type setRelaxationTime_function_value( &::SireMove::Langevin::setRelaxationTime );
+            
+            Langevin_exposer.def( 
+                "setRelaxationTime"
+                , setRelaxationTime_function_value
+                , ( bp::arg("relaxation_time") ) );
+        
+        }
+        { //::SireMove::Langevin::setTemperature
+        
+            typedef void ( ::SireMove::Langevin::*setTemperature_function_type )( ::SireUnits::Dimension::Temperature ) ;
+            setTemperature_function_type setTemperature_function_value( &::SireMove::Langevin::setTemperature );
+            
+            Langevin_exposer.def( 
+                "setTemperature"
+                , setTemperature_function_value
+                , ( bp::arg("temperature") ) );
+        
+        }
+        { //::SireMove::Langevin::temperature
+        
+            typedef ::SireUnits::Dimension::Temperature ( ::SireMove::Langevin::*temperature_function_type )(  ) const;
+            temperature_function_type temperature_function_value( &::SireMove::Langevin::temperature );
+            
+            Langevin_exposer.def( 
+                "temperature"
+                , temperature_function_value );
+        
+        }
+        { //::SireMove::Langevin::toString
+        
+            typedef ::QString ( ::SireMove::Langevin::*toString_function_type )(  ) const;
+            toString_function_type toString_function_value( &::SireMove::Langevin::toString );
+            
+            Langevin_exposer.def( 
+                "toString"
+                , toString_function_value );
+        
+        }
+        { //::SireMove::Langevin::typeName
+        
+            typedef char const * ( *typeName_function_type )(  );
+            typeName_function_type typeName_function_value( &::SireMove::Langevin::typeName );
+            
+            Langevin_exposer.def( 
+                "typeName"
+                , typeName_function_value );
+        
+        }
+        Langevin_exposer.staticmethod( "typeName" );
+        Langevin_exposer.def( "__copy__", &__copy__);
+        Langevin_exposer.def( "__deepcopy__", &__copy__);
+        Langevin_exposer.def( "clone", &__copy__);
+        Langevin_exposer.def( "__rlshift__", &__rlshift__QDataStream< ::SireMove::Langevin >,
+                            bp::return_internal_reference<1, bp::with_custodian_and_ward<1,2> >() );
+        Langevin_exposer.def( "__rrshift__", &__rrshift__QDataStream< ::SireMove::Langevin >,
+                            bp::return_internal_reference<1, bp::with_custodian_and_ward<1,2> >() );
+        Langevin_exposer.def( "__str__", &__str__< ::SireMove::Langevin > );
+        Langevin_exposer.def( "__repr__", &__str__< ::SireMove::Langevin > );
+    }
+
+}
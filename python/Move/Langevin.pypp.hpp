@@ -0,0 +1,10 @@
+// This file has been generated by Py++.
+
+// (C) Christopher Woods, GPL >= 2 License
+
+#ifndef Langevin_hpp__pyplusplus_wrapper
+#define Langevin_hpp__pyplusplus_wrapper
+
+void register_Langevin_class();
+
+#endif//Langevin_hpp__pyplusplus_wrapper
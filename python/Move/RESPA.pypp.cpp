@@ -0,0 +1,244 @@
+// This file has been generated by Py++.
+
+// (C) Christopher Woods, GPL >= 2 License
+
+#include "boost/python.hpp"
+#include "RESPA.pypp.hpp"
+
+namespace bp = boost::python;
+
+#include "SireError/errors.h"
+
+#include "SireFF/forcetable.h"
+
+#include "SireMaths/rangenerator.h"
+
+#include "SireMol/molecule.h"
+
+#include "SireMol/moleculegroup.h"
+
+#include "SireMol/partialmolecule.h"
+
+#include "SireStream/datastream.h"
+
+#include "SireStream/shareddatastream.h"
+
+#include "SireSystem/system.h"
+
+#include "SireUnits/units.h"
+
+#include "ensemble.h"
+
+#include "respa.h"
+
+#include "respa.h"
+
+SireMove::RESPA __copy__(const SireMove::RESPA &other){ return SireMove::RESPA(other); }
+
+#include "Qt/qdatastream.hpp"
+
+#include "Helpers/str.hpp"
+
+void register_RESPA_class(){
+
+    { //::SireMove::RESPA
+        typedef bp::class_< SireMove::RESPA, bp::bases< SireMove::Integrator, SireBase::Property > > RESPA_exposer_t;
+        RESPA_exposer_t RESPA_exposer = RESPA_exposer_t( "RESPA", bp::init< bp::optional< bool > >(( bp::arg("frequent_save_velocities")=(bool)(false) )) );
+        bp::scope RESPA_scope( RESPA_exposer );
+        RESPA_exposer.def( bp::init< SireCAS::Symbol const &, SireCAS::Symbol const &, bp::optional< int, bool > >(( bp::arg("fast_component"), bp::arg("slow_component"), bp::arg("nsubsteps")=(int)(2), bp::arg("frequent_save_velocities")=(bool)(false) )) );
+        RESPA_exposer.def( bp::init< SireMove::RESPA const & >(( bp::arg("other") )) );
+        { //::SireMove::RESPA::addLevel
+        
+            typedef void ( ::SireMove::RESPA::*addLevel_function_type )( ::SireCAS::Symbol const &,int ) ;
+            addLevel_function_type addLevel_function_value( &::SireMove::RESPA::addLevel );
+            
+            RESPA_exposer.def( 
+                "addLevel"
+                , addLevel_function_value
+                , ( bp::arg("component"), bp::arg("nsubsteps")=(int)(2) ) );
+        
+        }
+        { //::SireMove::RESPA::clearLevels
+        
+            typedef void ( ::SireMove::RESPA::*clearLevels_function_type )(  ) ;
+            clearLevels_function_type clearLevels_function_value( &::SireMove::RESPA::clearLevels );
+            
+            RESPA_exposer.def( 
+                "clearLevels"
+                , clearLevels_function_value );
+        
+        }
+        { //::SireMove::RESPA::constraintTolerance
+        
+            typedef double ( ::SireMove::RESPA::*constraintTolerance_function_type )(  ) const;
+            constraintTolerance_function_type constraintTolerance_function_value( &::SireMove::RESPA::constraintTolerance );
+            
+            RESPA_exposer.def( 
+                "constraintTolerance"
+                , constraintTolerance_function_value );
+        
+        }
+        { //::SireMove::RESPA::constraintType
+        
+            typedef ::QString ( ::SireMove::RESPA::*constraintType_function_type )(  ) const;
+            constraintType_function_type constraintType_function_value( &::SireMove::RESPA::constraintType );
+            
+            RESPA_exposer.def( 
+                "constraintType"
+                , constraintType_function_value );
+        
+        }
+        { //::SireMove::RESPA::createWorkspace
+        
+            typedef ::SireMove::IntegratorWorkspacePtr ( ::SireMove::RESPA::*createWorkspace_function_type )( ::SireBase::PropertyMap const & ) const;
+            createWorkspace_function_type createWorkspace_function_value( &::SireMove::RESPA::createWorkspace );
+            
+            RESPA_exposer.def( 
+                "createWorkspace"
+                , createWorkspace_function_value
+                , ( bp::arg("map")=SireBase::PropertyMap() ) );
+        
+        }
+        { //::SireMove::RESPA::createWorkspace
+        
+            typedef ::SireMove::IntegratorWorkspacePtr ( ::SireMove::RESPA::*createWorkspace_function_type )( ::SireMol::MoleculeGroup const &,::SireBase::PropertyMap const & ) const;
+            createWorkspace_function_type createWorkspace_function_value( &::SireMove::RESPA::createWorkspace );
+            
+            RESPA_exposer.def( 
+                "createWorkspace"
+                , createWorkspace_function_value
+                , ( bp::arg("molgroup"), bp::arg("map")=SireBase::PropertyMap() ) );
+        
+        }
+        { //::SireMove::RESPA::ensemble
+        
+            typedef ::SireMove::Ensemble ( ::SireMove::RESPA::*ensemble_function_type )(  ) const;
+            ensemble_function_type ensemble_function_value( &::SireMove::RESPA::ensemble );
+            
+            RESPA_exposer.def( 
+                "ensemble"
+                , ensemble_function_value );
+        
+        }
+        { //::SireMove::RESPA::integrate
+        
+            typedef void ( ::SireMove::RESPA::*integrate_function_type )( ::SireMove::IntegratorWorkspace &,::SireCAS::Symbol const &,::SireUnits::Dimension::Time,int,bool ) const;
+            integrate_function_type integrate_function_value( &::SireMove::RESPA::integrate );
+            
+            RESPA_exposer.def( 
+                "integrate"
+                , integrate_function_value
+                , ( bp::arg("workspace"), bp::arg("nrg_component"), bp::arg("timestep"), bp::arg("nmoves"), bp::arg("record_stats") ) );
+        
+        }
+        { //::SireMove::RESPA::isTimeReversible
+        
+            typedef bool ( ::SireMove::RESPA::*isTimeReversible_function_type )(  ) const;
+            isTimeReversible_function_type isTimeReversible_function_value( &::SireMove::RESPA::isTimeReversible );
+            
+            RESPA_exposer.def( 
+                "isTimeReversible"
+                , isTimeReversible_function_value );
+        
+        }
+        RESPA_exposer.def( bp::self != bp::self );
+        { //::SireMove::RESPA::levelComponent
+        
+            typedef ::SireCAS::Symbol ( ::SireMove::RESPA::*levelComponent_function_type )( int ) const;
+            levelComponent_function_type levelComponent_function_value( &::SireMove::RESPA::levelComponent );
+            
+            RESPA_exposer.def( 
+                "levelComponent"
+                , levelComponent_function_value
+                , ( bp::arg("level") ) );
+        
+        }
+        { //::SireMove::RESPA::nLevels
+        
+            typedef int ( ::SireMove::RESPA::*nLevels_function_type )(  ) const;
+            nLevels_function_type nLevels_function_value( &::SireMove::RESPA::nLevels );
+            
+            RESPA_exposer.def( 
+                "nLevels"
+                , nLevels_function_value );
+        
+        }
+        { //::SireMove::RESPA::nSubSteps
+        
+            typedef int ( ::SireMove::RESPA::*nSubSteps_function_type )( int ) const;
+            nSubSteps_function_type nSubSteps_function_value( &::SireMove::RESPA::nSubSteps );
+            
+            RESPA_exposer.def( 
+                "nSubSteps"
+                , nSubSteps_function_value
+                , ( bp::arg("level") ) );
+        
+        }
+        { //::SireMove::RESPA::operator=
+        
+            typedef ::SireMove::RESPA & ( ::SireMove::RESPA::*assign_function_type )( ::SireMove::RESPA const & ) ;
+            assign_function_type assign_function_value( &::SireMove::RESPA::operator= );
+            
+            RESPA_exposer.def( 
+                "assign"
+                , assign_function_value
+                , ( bp::arg("other") )
+                , bp::return_self< >() );
+        
+        }
+        RESPA_exposer.def( bp::self == bp::self );
+        { //::SireMove::RESPA::setConstraintTolerance
+        
+            typedef void ( ::SireMove::RESPA::*setConstraintTolerance_function_type )( double ) ;
+            setConstraintTolerance_function_type setConstraintTolerance_function_value( &::SireMove::RESPA::setConstraintTolerance );
+            
+            RESPA_exposer.def( 
+                "setConstraintTolerance"
+                , setConstraintTolerance_function_value
+                , ( bp::arg("tolerance") ) );
+        
+        }
+        { //::SireMove::RESPA::setConstraintType
+        
+            typedef void ( ::SireMove::RESPA::*setConstraintType_function_type )( ::QString const & ) ;
+            setConstraintType_function_type setConstraintType_function_value( &::SireMove::RESPA::setConstraintType );
+            
+            RESPA_exposer.def( 
+                "setConstraintType"
+                , setConstraintType_function_value
+                , ( bp::arg("constraint_type") ) );
+        
+        }
+        { //::SireMove::RESPA::toString
+        
+            typedef ::QString ( ::SireMove::RESPA::*toString_function_type )(  ) const;
+            toString_function_type toString_function_value( &::SireMove::RESPA::toString );
+            
+            RESPA_exposer.def( 
+                "toString"
+                , toString_function_value );
+        
+        }
+        { //::SireMove::RESPA::typeName
+        
+            typedef char const * ( *typeName_function_type )(  );
+            typeName_function_type typeName_function_value( &::SireMove::RESPA::typeName );
+            
+            RESPA_exposer.def( 
+                "typeName"
+                , typeName_function_value );
+        
+        }
+        RESPA_exposer.staticmethod( "typeName" );
+        RESPA_exposer.def( "__copy__", &__copy__);
+        RESPA_exposer.def( "__deepcopy__", &__copy__);
+        RESPA_exposer.def( "clone", &__copy__);
+        RESPA_exposer.def( "__rlshift__", &__rlshift__QDataStream< ::SireMove::RESPA >,
+                            bp::return_internal_reference<1, bp::with_custodian_and_ward<1,2> >() );
+        RESPA_exposer.def( "__rrshift__", &__rrshift__QDataStream< ::SireMove::RESPA >,
+                            bp::return_internal_reference<1, bp::with_custodian_and_ward<1,2> >() );
+        RESPA_exposer.def( "__str__", &__str__< ::SireMove::RESPA > );
+        RESPA_exposer.def( "__repr__", &__str__< ::SireMove::RESPA > );
+    }
+
+}
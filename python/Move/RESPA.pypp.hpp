@@ -0,0 +1,10 @@
+// This file has been generated by Py++.
+
+// (C) Christopher Woods, GPL >= 2 License
+
+#ifndef RESPA_hpp__pyplusplus_wrapper
+#define RESPA_hpp__pyplusplus_wrapper
+
+void register_RESPA_class();
+
+#endif//RESPA_hpp__pyplusplus_wrapper
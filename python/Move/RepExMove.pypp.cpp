@@ -91,6 +91,16 @@ void register_RepExMove_class(){
                 , move_function_value
                 , ( bp::arg("system"), bp::arg("nmoves"), bp::arg("record_stats") ) );
         
+        }
+        { //::SireMove::RepExMove::isAsynchronous
+        
+            typedef bool ( ::SireMove::RepExMove::*isAsynchronous_function_type )(  ) const;
+            isAsynchronous_function_type isAsynchronous_function_value( &::SireMove::RepExMove::isAsynchronous );
+            
+            RepExMove_exposer.def( 
+                "isAsynchronous"
+                , isAsynchronous_function_value );
+        
         }
         { //::SireMove::RepExMove::nAccepted
         
@@ -136,6 +146,17 @@ void register_RepExMove_class(){
         
         }
         RepExMove_exposer.def( bp::self == bp::self );
+        { //::SireMove::RepExMove::setAsynchronous
+        
+            typedef void ( ::SireMove::RepExMove::*setAsynchronous_function_type )( bool ) ;
+            setAsynchronous_function_type setAsynchronous_function_value( &::SireMove::RepExMove::setAsynchronous );
+            
+            RepExMove_exposer.def( 
+                "setAsynchronous"
+                , setAsynchronous_function_value
+                , ( bp::arg("asynchronous") ) );
+        
+        }
         { //::SireMove::RepExMove::setDisableSwaps
         
             typedef void ( ::SireMove::RepExMove::*setDisableSwaps_function_type )( bool ) ;
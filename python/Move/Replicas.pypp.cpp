@@ -64,6 +64,17 @@ void register_Replicas_class(){
                 "collectSupraStats"
                 , collectSupraStats_function_value );
         
+        }
+        { //::SireMove::Replicas::collectSupraStats
+        
+            typedef void ( ::SireMove::Replicas::*collectSupraStats_function_type )( ::QVector< unsigned int > const & ) ;
+            collectSupraStats_function_type collectSupraStats_function_value( &::SireMove::Replicas::collectSupraStats );
+            
+            Replicas_exposer.def( 
+                "collectSupraStats"
+                , collectSupraStats_function_value
+                , ( bp::arg("replica_ids") ) );
+        
         }
         { //::SireMove::Replicas::lambdaTrajectory
         
@@ -74,6 +85,17 @@ void register_Replicas_class(){
                 "lambdaTrajectory"
                 , lambdaTrajectory_function_value );
         
+        }
+        { //::SireMove::Replicas::lambdaTrajectory
+        
+            typedef ::QVector< double > ( ::SireMove::Replicas::*lambdaTrajectory_function_type )( ::QVector< unsigned int > const & ) const;
+            lambdaTrajectory_function_type lambdaTrajectory_function_value( &::SireMove::Replicas::lambdaTrajectory );
+            
+            Replicas_exposer.def( 
+                "lambdaTrajectory"
+                , lambdaTrajectory_function_value
+                , ( bp::arg("replica_ids") ) );
+        
         }
         { //::SireMove::Replicas::lambdaTrajectoryHistory
         
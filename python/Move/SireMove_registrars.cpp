@@ -39,6 +39,8 @@
 #include "volumechanger.h"
 #include "suprasubsimpacket.h"
 #include "velocityverlet.h"
+#include "langevin.h"
+#include "respa.h"
 #include "ensemble.h"
 #include "getpoint.h"
 #include "moldeleter.h"
@@ -84,6 +86,8 @@ void register_SireMove_objects()
     ObjectRegistry::registerConverterFor< SireMove::SameSupraSubMoves >();
     ObjectRegistry::registerConverterFor< SireMove::NullIntegratorWorkspace >();
     ObjectRegistry::registerConverterFor< SireMove::AtomicVelocityWorkspace >();
+    ObjectRegistry::registerConverterFor< SireMove::LangevinWorkspace >();
+    ObjectRegistry::registerConverterFor< SireMove::RESPAWorkspace >();
     ObjectRegistry::registerConverterFor< SireMove::RepExMove >();
     ObjectRegistry::registerConverterFor< SireMove::RepExSubMove >();
     ObjectRegistry::registerConverterFor< SireMove::Titrator >();
@@ -97,6 +101,8 @@ void register_SireMove_objects()
     ObjectRegistry::registerConverterFor< SireMove::ScaleVolumeFromCenter >();
     ObjectRegistry::registerConverterFor< SireMove::SupraSubSimPacket >();
     ObjectRegistry::registerConverterFor< SireMove::VelocityVerlet >();
+    ObjectRegistry::registerConverterFor< SireMove::Langevin >();
+    ObjectRegistry::registerConverterFor< SireMove::RESPA >();
     ObjectRegistry::registerConverterFor< SireMove::Ensemble >();
     ObjectRegistry::registerConverterFor< SireMove::NullGetPoint >();
     ObjectRegistry::registerConverterFor< SireMove::GetCOMPoint >();
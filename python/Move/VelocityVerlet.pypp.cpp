@@ -7,6 +7,8 @@
 
 namespace bp = boost::python;
 
+#include "SireError/errors.h"
+
 #include "SireFF/forcetable.h"
 
 #include "SireMaths/rangenerator.h"
@@ -50,6 +52,26 @@ void register_VelocityVerlet_class(){
         VelocityVerlet_exposer_t VelocityVerlet_exposer = VelocityVerlet_exposer_t( "VelocityVerlet", bp::init< bp::optional< bool > >(( bp::arg("frequent_save_velocities")=(bool)(false) )) );
         bp::scope VelocityVerlet_scope( VelocityVerlet_exposer );
         VelocityVerlet_exposer.def( bp::init< SireMove::VelocityVerlet const & >(( bp::arg("other") )) );
+        { //::SireMove::VelocityVerlet::constraintTolerance
+        
+            typedef double ( ::SireMove::VelocityVerlet::*constraintTolerance_function_type )(  ) const;
+            constraintTolerance_function_type constraintTolerance_function_value( &::SireMove::VelocityVerlet::constraintTolerance );
+            
+            VelocityVerlet_exposer.def( 
+                "constraintTolerance"
+                , constraintTolerance_function_value );
+        
+        }
+        { //::SireMove::VelocityVerlet::constraintType
+        
+            typedef ::QString ( ::SireMove::VelocityVerlet::*constraintType_function_type )(  ) const;
+            constraintType_function_type constraintType_function_value( &::SireMove::VelocityVerlet::constraintType );
+            
+            VelocityVerlet_exposer.def( 
+                "constraintType"
+                , constraintType_function_value );
+        
+        }
         { //::SireMove::VelocityVerlet::createWorkspace
         
             typedef ::SireMove::IntegratorWorkspacePtr ( ::SireMove::VelocityVerlet::*createWorkspace_function_type )( ::SireBase::PropertyMap const & ) const;
@@ -117,6 +139,28 @@ void register_VelocityVerlet_class(){
         
         }
         VelocityVerlet_exposer.def( bp::self == bp::self );
+        { //::SireMove::VelocityVerlet::setConstraintTolerance
+        
+            typedef void ( ::SireMove::VelocityVerlet::*setConstraintTolerance_function_type )( double ) ;
+            setConstraintTolerance_function_type setConstraintTolerance_function_value( &::SireMove::VelocityVerlet::setConstraintTolerance );
+            
+            VelocityVerlet_exposer.def( 
+                "setConstraintTolerance"
+                , setConstraintTolerance_function_value
+                , ( bp::arg("tolerance") ) );
+        
+        }
+        { //::SireMove::VelocityVerlet::setConstraintType
+        
+            typedef void ( ::SireMove::VelocityVerlet::*setConstraintType_function_type )( ::QString const & ) ;
+            setConstraintType_function_type setConstraintType_function_value( &::SireMove::VelocityVerlet::setConstraintType );
+            
+            VelocityVerlet_exposer.def( 
+                "setConstraintType"
+                , setConstraintType_function_value
+                , ( bp::arg("constraint_type") ) );
+        
+        }
         { //::SireMove::VelocityVerlet::toString
         
             typedef ::QString ( ::SireMove::VelocityVerlet::*toString_function_type )(  ) const;
@@ -35,6 +35,8 @@
 
 #include "InternalMoveSingle.pypp.hpp"
 
+#include "Langevin.pypp.hpp"
+
 #include "MTSMC.pypp.hpp"
 
 #include "MaxwellBoltzmann.pypp.hpp"
@@ -71,6 +73,8 @@
 
 #include "PrefSampler.pypp.hpp"
 
+#include "RESPA.pypp.hpp"
+
 #include "RepExMove.pypp.hpp"
 
 #include "RepExSubMove.pypp.hpp"
@@ -198,6 +202,8 @@ BOOST_PYTHON_MODULE(_Move){
 
     register_InternalMoveSingle_class();
 
+    register_Langevin_class();
+
     register_MTSMC_class();
 
     register_MaxwellBoltzmann_class();
@@ -238,6 +244,8 @@ BOOST_PYTHON_MODULE(_Move){
 
     register_PrefSampler_class();
 
+    register_RESPA_class();
+
     register_RepExMove_class();
 
     register_RepExSubMove_class();
@@ -13,6 +13,7 @@
 #include "integratorworkspace.h"
 #include "internalmove.h"
 #include "internalmovesingle.h"
+#include "langevin.h"
 #include "moldeleter.h"
 #include "moleculardynamics.h"
 #include "molinserter.h"
@@ -23,6 +24,7 @@
 #include "prefsampler.h"
 #include "rbworkspace.h"
 #include "repexmove.h"
+#include "respa.h"
 #include "replica.h"
 #include "replicas.h"
 #include "rigidbodymc.h"
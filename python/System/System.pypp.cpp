@@ -397,6 +397,16 @@ void register_System_class(){
                 , ( bp::arg("mgnum") )
                 , bp::return_value_policy<bp::clone_const_reference>() );
         
+        }
+        { //::SireSystem::System::beginTransaction
+        
+            typedef void ( ::SireSystem::System::*beginTransaction_function_type )(  );
+            beginTransaction_function_type beginTransaction_function_value( &::SireSystem::System::beginTransaction );
+            
+            System_exposer.def( 
+                "beginTransaction"
+                , beginTransaction_function_value );
+        
         }
         { //::SireSystem::System::builtinProperties
         
@@ -450,6 +460,16 @@ void register_System_class(){
                 "collectStats"
                 , collectStats_function_value );
         
+        }
+        { //::SireSystem::System::commitTransaction
+        
+            typedef void ( ::SireSystem::System::*commitTransaction_function_type )(  );
+            commitTransaction_function_type commitTransaction_function_value( &::SireSystem::System::commitTransaction );
+            
+            System_exposer.def( 
+                "commitTransaction"
+                , commitTransaction_function_value );
+        
         }
         { //::SireSystem::System::componentExpression
         
@@ -685,6 +705,26 @@ void register_System_class(){
                 , containsProperty_function_value
                 , ( bp::arg("ffid"), bp::arg("name") ) );
         
+        }
+        { //::SireSystem::System::disableParallelCalculation
+        
+            typedef void ( ::SireSystem::System::*disableParallelCalculation_function_type )(  ) ;
+            disableParallelCalculation_function_type disableParallelCalculation_function_value( &::SireSystem::System::disableParallelCalculation );
+            
+            System_exposer.def( 
+                "disableParallelCalculation"
+                , disableParallelCalculation_function_value );
+        
+        }
+        { //::SireSystem::System::enableParallelCalculation
+        
+            typedef void ( ::SireSystem::System::*enableParallelCalculation_function_type )(  ) ;
+            enableParallelCalculation_function_type enableParallelCalculation_function_value( &::SireSystem::System::enableParallelCalculation );
+            
+            System_exposer.def( 
+                "enableParallelCalculation"
+                , enableParallelCalculation_function_value );
+        
         }
         { //::SireSystem::System::energies
         
@@ -947,6 +987,16 @@ void register_System_class(){
                 , hasEnergyComponent_function_value
                 , ( bp::arg("component") ) );
         
+        }
+        { //::SireSystem::System::inTransaction
+        
+            typedef bool ( ::SireSystem::System::*inTransaction_function_type )(  ) const;
+            inTransaction_function_type inTransaction_function_value( &::SireSystem::System::inTransaction );
+            
+            System_exposer.def( 
+                "inTransaction"
+                , inTransaction_function_value );
+        
         }
         { //::SireSystem::System::isBuiltinProperty
         
@@ -1591,6 +1641,16 @@ void register_System_class(){
                 , removeProperty_function_value
                 , ( bp::arg("name") ) );
         
+        }
+        { //::SireSystem::System::rollbackTransaction
+        
+            typedef void ( ::SireSystem::System::*rollbackTransaction_function_type )(  );
+            rollbackTransaction_function_type rollbackTransaction_function_value( &::SireSystem::System::rollbackTransaction );
+            
+            System_exposer.def( 
+                "rollbackTransaction"
+                , rollbackTransaction_function_value );
+        
         }
         { //::SireSystem::System::setComponent
         
@@ -1822,6 +1882,17 @@ void register_System_class(){
                 , setProperty_function_value
                 , ( bp::arg("ffid"), bp::arg("name"), bp::arg("value") ) );
         
+        }
+        { //::SireSystem::System::setUseParallelCalculation
+        
+            typedef void ( ::SireSystem::System::*setUseParallelCalculation_function_type )( bool ) ;
+            setUseParallelCalculation_function_type setUseParallelCalculation_function_value( &::SireSystem::System::setUseParallelCalculation );
+            
+            System_exposer.def( 
+                "setUseParallelCalculation"
+                , setUseParallelCalculation_function_value
+                , ( bp::arg("on") ) );
+        
         }
         { //::SireSystem::System::subVersion
         
@@ -1853,6 +1924,16 @@ void register_System_class(){
                 , totalComponent_function_value
                 , bp::return_value_policy<bp::clone_const_reference>() );
         
+        }
+        { //::SireSystem::System::transactionDepth
+        
+            typedef int ( ::SireSystem::System::*transactionDepth_function_type )(  ) const;
+            transactionDepth_function_type transactionDepth_function_value( &::SireSystem::System::transactionDepth );
+            
+            System_exposer.def( 
+                "transactionDepth"
+                , transactionDepth_function_value );
+        
         }
         { //::SireSystem::System::typeName
         
@@ -1918,6 +1999,16 @@ void register_System_class(){
                 , ( bp::arg("name") )
                 , bp::return_value_policy<bp::clone_const_reference>() );
         
+        }
+        { //::SireSystem::System::usesParallelCalculation
+        
+            typedef bool ( ::SireSystem::System::*usesParallelCalculation_function_type )(  ) const;
+            usesParallelCalculation_function_type usesParallelCalculation_function_value( &::SireSystem::System::usesParallelCalculation );
+            
+            System_exposer.def( 
+                "usesParallelCalculation"
+                , usesParallelCalculation_function_value );
+        
         }
         { //::SireSystem::System::version
         
@@ -50,6 +50,15 @@ grid_buffer = Parameter("grid buffer", 3*angstrom,
                            the larger the grid, but also the lower the chance that the grid
                            will need to be recalculated as the molecules in group 0 move.""")
 
+use_lj_grid = Parameter("lj grid", False,
+                        """Whether or not to hold the LJ and coulomb potentials of the atoms
+                           close to the grid on grids, rather than calculating their
+                           energies explicitly. This is faster, but less accurate.""")
+
+use_tricubic = Parameter("tricubic interpolation", False,
+                         """Whether or not to use tricubic, rather than tri-linear, interpolation
+                            of the grids. This gives smoother energies, but is slower.""")
+
 cutoff_scheme = Parameter("cutoff scheme", "group",
                           """The method used to apply the non-bonded cutoff. Choices are;
                              (1) shift_electrostatics : This should become the default, and uses an atomistic cutoff
@@ -953,6 +962,8 @@ def setupForcefields(system, space):
         gridff.setBuffer( grid_buffer.val )
         gridff.setCoulombCutoff( coul_cutoff.val )
         gridff.setLJCutoff( lj_cutoff.val )
+        gridff.setUseLJGrid( use_lj_grid.val )
+        gridff.setUseTricubicInterpolation( use_tricubic.val )
         gridff.setProperty("combiningRules", VariantProperty(combining_rules.val) )
         gridff.setProperty("space", Cartesian())
            
@@ -46,6 +46,15 @@ grid_buffer = Parameter("grid buffer", 2*angstrom,
                         """Buffer around the grid used to prevent recalculation
                            in the grid-based forcefields.""")
 
+use_lj_grid = Parameter("lj grid", False,
+                        """Whether or not to hold the LJ and coulomb potentials of the atoms
+                           close to the grid on grids, rather than calculating their
+                           energies explicitly. This is faster, but less accurate.""")
+
+use_tricubic = Parameter("tricubic interpolation", False,
+                         """Whether or not to use tricubic, rather than tri-linear, interpolation
+                            of the grids. This gives smoother energies, but is slower.""")
+
 disable_grid = Parameter("disable grid", False, """Whether or not to disable use of the grid""")
 
 temperature = Parameter("temperature", 25*celsius, """Simulation temperature""")
@@ -334,6 +343,8 @@ def setGridProperties(forcefield, extra_buffer=0*angstrom):
     forcefield.setBuffer(grid_buffer.val + extra_buffer)
     forcefield.setLJCutoff(lj_cutoff.val)
     forcefield.setCoulombCutoff(coul_cutoff.val)
+    forcefield.setUseLJGrid(use_lj_grid.val)
+    forcefield.setUseTricubicInterpolation(use_tricubic.val)
 
     return forcefield
 
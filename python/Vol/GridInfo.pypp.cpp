@@ -408,6 +408,17 @@ void register_GridInfo_class(){
                 , pointToGridCorners_function_value
                 , ( bp::arg("x"), bp::arg("y"), bp::arg("z"), bp::arg("indicies"), bp::arg("weights") ) );
         
+        }
+        { //::SireVol::GridInfo::pointToTricubicGridCorners
+        
+            typedef int ( ::SireVol::GridInfo::*pointToTricubicGridCorners_function_type )( ::SireMaths::MultiFloat const &,::SireMaths::MultiFloat const &,::SireMaths::MultiFloat const &,::QVector< SireMaths::MultiInt > &,::QVector< SireMaths::MultiFloat > & ) const;
+            pointToTricubicGridCorners_function_type pointToTricubicGridCorners_function_value( &::SireVol::GridInfo::pointToTricubicGridCorners );
+            
+            GridInfo_exposer.def( 
+                "pointToTricubicGridCorners"
+                , pointToTricubicGridCorners_function_value
+                , ( bp::arg("x"), bp::arg("y"), bp::arg("z"), bp::arg("indicies"), bp::arg("weights") ) );
+        
         }
         { //::SireVol::GridInfo::pointToGridIndex
         
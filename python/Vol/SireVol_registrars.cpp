@@ -12,6 +12,7 @@
 #include "coordgroup.h"
 #include "aabox.h"
 #include "grid.h"
+#include "triclinicbox.h"
 
 #include "Helpers/objectregistry.hpp"
 
@@ -33,6 +34,7 @@ void register_SireVol_objects()
     ObjectRegistry::registerConverterFor< SireVol::AABox >();
     ObjectRegistry::registerConverterFor< SireVol::NullGrid >();
     ObjectRegistry::registerConverterFor< SireVol::RegularGrid >();
+    ObjectRegistry::registerConverterFor< SireVol::TriclinicBox >();
 
 }
 
@@ -0,0 +1,531 @@
+// This file has been generated by Py++.
+
+// (C) Christopher Woods, GPL >= 2 License
+
+#include "boost/python.hpp"
+#include "TriclinicBox.pypp.hpp"
+
+namespace bp = boost::python;
+
+#include "SireError/errors.h"
+
+#include "SireMaths/rangenerator.h"
+
+#include "SireStream/datastream.h"
+
+#include "SireUnits/units.h"
+
+#include "coordgroup.h"
+
+#include "triclinicbox.h"
+
+#include <QDebug>
+
+#include <cmath>
+
+#include <limits>
+
+#include "triclinicbox.h"
+
+SireVol::TriclinicBox __copy__(const SireVol::TriclinicBox &other){ return SireVol::TriclinicBox(other); }
+
+#include "Qt/qdatastream.hpp"
+
+#include "Helpers/str.hpp"
+
+void register_TriclinicBox_class(){
+
+    { //::SireVol::TriclinicBox
+        typedef bp::class_< SireVol::TriclinicBox, bp::bases< SireVol::Cartesian, SireVol::Space, SireBase::Property > > TriclinicBox_exposer_t;
+        TriclinicBox_exposer_t TriclinicBox_exposer = TriclinicBox_exposer_t( "TriclinicBox", bp::init< >() );
+        bp::scope TriclinicBox_scope( TriclinicBox_exposer );
+        TriclinicBox_exposer.def( bp::init< SireMaths::Vector const &, SireMaths::Vector const &, SireMaths::Vector const & >(( bp::arg("v0"), bp::arg("v1"), bp::arg("v2") )) );
+        TriclinicBox_exposer.def( bp::init< double, double, double, SireUnits::Dimension::Angle const &, SireUnits::Dimension::Angle const &, SireUnits::Dimension::Angle const & >(( bp::arg("a"), bp::arg("b"), bp::arg("c"), bp::arg("alpha"), bp::arg("beta"), bp::arg("gamma") )) );
+        TriclinicBox_exposer.def( bp::init< SireVol::TriclinicBox const & >(( bp::arg("other") )) );
+        { //::SireVol::TriclinicBox::beyond
+        
+            typedef bool ( ::SireVol::TriclinicBox::*beyond_function_type )( double,::SireVol::AABox const &,::SireVol::AABox const & ) const;
+            beyond_function_type beyond_function_value( &::SireVol::TriclinicBox::beyond );
+            
+            TriclinicBox_exposer.def( 
+                "beyond"
+                , beyond_function_value
+                , ( bp::arg("dist"), bp::arg("aabox0"), bp::arg("aabox1") ) );
+        
+        }
+        { //::SireVol::TriclinicBox::beyond
+        
+            typedef bool ( ::SireVol::TriclinicBox::*beyond_function_type )( double,::SireVol::CoordGroup const &,::SireVol::CoordGroup const & ) const;
+            beyond_function_type beyond_function_value( &::SireVol::TriclinicBox::beyond );
+            
+            TriclinicBox_exposer.def( 
+                "beyond"
+                , beyond_function_value
+                , ( bp::arg("dist"), bp::arg("group0"), bp::arg("group1") ) );
+        
+        }
+        { //::SireVol::TriclinicBox::calcAngle
+        
+            typedef ::SireUnits::Dimension::Angle ( ::SireVol::TriclinicBox::*calcAngle_function_type )( ::SireMaths::Vector const &,::SireMaths::Vector const &,::SireMaths::Vector const & ) const;
+            calcAngle_function_type calcAngle_function_value( &::SireVol::TriclinicBox::calcAngle );
+            
+            TriclinicBox_exposer.def( 
+                "calcAngle"
+                , calcAngle_function_value
+                , ( bp::arg("point0"), bp::arg("point1"), bp::arg("point2") ) );
+        
+        }
+        { //::SireVol::TriclinicBox::calcDihedral
+        
+            typedef ::SireUnits::Dimension::Angle ( ::SireVol::TriclinicBox::*calcDihedral_function_type )( ::SireMaths::Vector const &,::SireMaths::Vector const &,::SireMaths::Vector const &,::SireMaths::Vector const & ) const;
+            calcDihedral_function_type calcDihedral_function_value( &::SireVol::TriclinicBox::calcDihedral );
+            
+            TriclinicBox_exposer.def( 
+                "calcDihedral"
+                , calcDihedral_function_value
+                , ( bp::arg("point0"), bp::arg("point1"), bp::arg("point2"), bp::arg("point3") ) );
+        
+        }
+        { //::SireVol::TriclinicBox::calcDist
+        
+            typedef double ( ::SireVol::TriclinicBox::*calcDist_function_type )( ::SireMaths::Vector const &,::SireMaths::Vector const & ) const;
+            calcDist_function_type calcDist_function_value( &::SireVol::TriclinicBox::calcDist );
+            
+            TriclinicBox_exposer.def( 
+                "calcDist"
+                , calcDist_function_value
+                , ( bp::arg("point0"), bp::arg("point1") ) );
+        
+        }
+        { //::SireVol::TriclinicBox::calcDist
+        
+            typedef double ( ::SireVol::TriclinicBox::*calcDist_function_type )( ::SireVol::CoordGroup const &,::SireVol::CoordGroup const &,::SireVol::DistMatrix & ) const;
+            calcDist_function_type calcDist_function_value( &::SireVol::TriclinicBox::calcDist );
+            
+            TriclinicBox_exposer.def( 
+                "calcDist"
+                , calcDist_function_value
+                , ( bp::arg("group1"), bp::arg("group2"), bp::arg("distmat") ) );
+        
+        }
+        { //::SireVol::TriclinicBox::calcDist
+        
+            typedef double ( ::SireVol::TriclinicBox::*calcDist_function_type )( ::SireVol::CoordGroup const &,::SireMaths::Vector const &,::SireVol::DistMatrix & ) const;
+            calcDist_function_type calcDist_function_value( &::SireVol::TriclinicBox::calcDist );
+            
+            TriclinicBox_exposer.def( 
+                "calcDist"
+                , calcDist_function_value
+                , ( bp::arg("group"), bp::arg("point"), bp::arg("mat") ) );
+        
+        }
+        { //::SireVol::TriclinicBox::calcDist2
+        
+            typedef double ( ::SireVol::TriclinicBox::*calcDist2_function_type )( ::SireMaths::Vector const &,::SireMaths::Vector const & ) const;
+            calcDist2_function_type calcDist2_function_value( &::SireVol::TriclinicBox::calcDist2 );
+            
+            TriclinicBox_exposer.def( 
+                "calcDist2"
+                , calcDist2_function_value
+                , ( bp::arg("point0"), bp::arg("point1") ) );
+        
+        }
+        { //::SireVol::TriclinicBox::calcDist2
+        
+            typedef double ( ::SireVol::TriclinicBox::*calcDist2_function_type )( ::SireVol::CoordGroup const &,::SireMaths::Vector const &,::SireVol::DistMatrix & ) const;
+            calcDist2_function_type calcDist2_function_value( &::SireVol::TriclinicBox::calcDist2 );
+            
+            TriclinicBox_exposer.def( 
+                "calcDist2"
+                , calcDist2_function_value
+                , ( bp::arg("group"), bp::arg("point"), bp::arg("mat") ) );
+        
+        }
+        { //::SireVol::TriclinicBox::calcDist2
+        
+            typedef double ( ::SireVol::TriclinicBox::*calcDist2_function_type )( ::SireVol::CoordGroup const &,::SireVol::CoordGroup const &,::SireVol::DistMatrix & ) const;
+            calcDist2_function_type calcDist2_function_value( &::SireVol::TriclinicBox::calcDist2 );
+            
+            TriclinicBox_exposer.def( 
+                "calcDist2"
+                , calcDist2_function_value
+                , ( bp::arg("group1"), bp::arg("group2"), bp::arg("distmat") ) );
+        
+        }
+        { //::SireVol::TriclinicBox::calcDistVector
+        
+            typedef ::SireMaths::DistVector ( ::SireVol::TriclinicBox::*calcDistVector_function_type )( ::SireMaths::Vector const &,::SireMaths::Vector const & ) const;
+            calcDistVector_function_type calcDistVector_function_value( &::SireVol::TriclinicBox::calcDistVector );
+            
+            TriclinicBox_exposer.def( 
+                "calcDistVector"
+                , calcDistVector_function_value
+                , ( bp::arg("point0"), bp::arg("point1") ) );
+        
+        }
+        { //::SireVol::TriclinicBox::calcDistVectors
+        
+            typedef double ( ::SireVol::TriclinicBox::*calcDistVectors_function_type )( ::SireVol::CoordGroup const &,::SireVol::CoordGroup const &,::SireVol::DistVectorMatrix & ) const;
+            calcDistVectors_function_type calcDistVectors_function_value( &::SireVol::TriclinicBox::calcDistVectors );
+            
+            TriclinicBox_exposer.def( 
+                "calcDistVectors"
+                , calcDistVectors_function_value
+                , ( bp::arg("group1"), bp::arg("group2"), bp::arg("distmat") ) );
+        
+        }
+        { //::SireVol::TriclinicBox::calcDistVectors
+        
+            typedef double ( ::SireVol::TriclinicBox::*calcDistVectors_function_type )( ::SireVol::CoordGroup const &,::SireMaths::Vector const &,::SireVol::DistVectorMatrix & ) const;
+            calcDistVectors_function_type calcDistVectors_function_value( &::SireVol::TriclinicBox::calcDistVectors );
+            
+            TriclinicBox_exposer.def( 
+                "calcDistVectors"
+                , calcDistVectors_function_value
+                , ( bp::arg("group"), bp::arg("point"), bp::arg("distmat") ) );
+        
+        }
+        { //::SireVol::TriclinicBox::calcInvDist
+        
+            typedef double ( ::SireVol::TriclinicBox::*calcInvDist_function_type )( ::SireVol::CoordGroup const &,::SireVol::CoordGroup const &,::SireVol::DistMatrix & ) const;
+            calcInvDist_function_type calcInvDist_function_value( &::SireVol::TriclinicBox::calcInvDist );
+            
+            TriclinicBox_exposer.def( 
+                "calcInvDist"
+                , calcInvDist_function_value
+                , ( bp::arg("group1"), bp::arg("group2"), bp::arg("distmat") ) );
+        
+        }
+        { //::SireVol::TriclinicBox::calcInvDist2
+        
+            typedef double ( ::SireVol::TriclinicBox::*calcInvDist2_function_type )( ::SireVol::CoordGroup const &,::SireVol::CoordGroup const &,::SireVol::DistMatrix & ) const;
+            calcInvDist2_function_type calcInvDist2_function_value( &::SireVol::TriclinicBox::calcInvDist2 );
+            
+            TriclinicBox_exposer.def( 
+                "calcInvDist2"
+                , calcInvDist2_function_value
+                , ( bp::arg("group1"), bp::arg("group2"), bp::arg("distmat") ) );
+        
+        }
+        { //::SireVol::TriclinicBox::cubic
+        
+            typedef ::SireVol::TriclinicBox ( *cubic_function_type )( double );
+            cubic_function_type cubic_function_value( &::SireVol::TriclinicBox::cubic );
+            
+            TriclinicBox_exposer.def( 
+                "cubic"
+                , cubic_function_value
+                , ( bp::arg("d") ) );
+        
+        }
+        { //::SireVol::TriclinicBox::getBoxCenter
+        
+            typedef ::SireMaths::Vector ( ::SireVol::TriclinicBox::*getBoxCenter_function_type )( ::SireMaths::Vector const & ) const;
+            getBoxCenter_function_type getBoxCenter_function_value( &::SireVol::TriclinicBox::getBoxCenter );
+            
+            TriclinicBox_exposer.def( 
+                "getBoxCenter"
+                , getBoxCenter_function_value
+                , ( bp::arg("p") ) );
+        
+        }
+        { //::SireVol::TriclinicBox::getBoxCenter
+        
+            typedef ::SireMaths::Vector ( ::SireVol::TriclinicBox::*getBoxCenter_function_type )( ::SireMaths::Vector const &,::SireMaths::Vector const & ) const;
+            getBoxCenter_function_type getBoxCenter_function_value( &::SireVol::TriclinicBox::getBoxCenter );
+            
+            TriclinicBox_exposer.def( 
+                "getBoxCenter"
+                , getBoxCenter_function_value
+                , ( bp::arg("p"), bp::arg("center") ) );
+        
+        }
+        { //::SireVol::TriclinicBox::getCopiesWithin
+        
+            typedef ::QList< boost::tuples::tuple< double, SireVol::CoordGroup, boost::tuples::null_type, boost::tuples::null_type, boost::tuples::null_type, boost::tuples::null_type, boost::tuples::null_type, boost::tuples::null_type, boost::tuples::null_type, boost::tuples::null_type > > ( ::SireVol::TriclinicBox::*getCopiesWithin_function_type )( ::SireVol::CoordGroup const &,::SireVol::CoordGroup const &,double ) const;
+            getCopiesWithin_function_type getCopiesWithin_function_value( &::SireVol::TriclinicBox::getCopiesWithin );
+            
+            TriclinicBox_exposer.def( 
+                "getCopiesWithin"
+                , getCopiesWithin_function_value
+                , ( bp::arg("group"), bp::arg("center"), bp::arg("dist") ) );
+        
+        }
+        { //::SireVol::TriclinicBox::getImagesWithin
+        
+            typedef ::QVector< SireMaths::Vector > ( ::SireVol::TriclinicBox::*getImagesWithin_function_type )( ::SireMaths::Vector const &,::SireMaths::Vector const &,double ) const;
+            getImagesWithin_function_type getImagesWithin_function_value( &::SireVol::TriclinicBox::getImagesWithin );
+            
+            TriclinicBox_exposer.def( 
+                "getImagesWithin"
+                , getImagesWithin_function_value
+                , ( bp::arg("point"), bp::arg("center"), bp::arg("dist") ) );
+        
+        }
+        { //::SireVol::TriclinicBox::getMinimumImage
+        
+            typedef ::SireVol::CoordGroup ( ::SireVol::TriclinicBox::*getMinimumImage_function_type )( ::SireVol::CoordGroup const &,::SireMaths::Vector const & ) const;
+            getMinimumImage_function_type getMinimumImage_function_value( &::SireVol::TriclinicBox::getMinimumImage );
+            
+            TriclinicBox_exposer.def( 
+                "getMinimumImage"
+                , getMinimumImage_function_value
+                , ( bp::arg("group"), bp::arg("center") ) );
+        
+        }
+        { //::SireVol::TriclinicBox::getMinimumImage
+        
+            typedef ::SireVol::CoordGroupArray ( ::SireVol::TriclinicBox::*getMinimumImage_function_type )( ::SireVol::CoordGroupArray const &,::SireMaths::Vector const &,bool ) const;
+            getMinimumImage_function_type getMinimumImage_function_value( &::SireVol::TriclinicBox::getMinimumImage );
+            
+            TriclinicBox_exposer.def( 
+                "getMinimumImage"
+                , getMinimumImage_function_value
+                , ( bp::arg("groups"), bp::arg("center"), bp::arg("translate_as_one")=(bool)(false) ) );
+        
+        }
+        { //::SireVol::TriclinicBox::getMinimumImage
+        
+            typedef ::SireVol::AABox ( ::SireVol::TriclinicBox::*getMinimumImage_function_type )( ::SireVol::AABox const &,::SireMaths::Vector const & ) const;
+            getMinimumImage_function_type getMinimumImage_function_value( &::SireVol::TriclinicBox::getMinimumImage );
+            
+            TriclinicBox_exposer.def( 
+                "getMinimumImage"
+                , getMinimumImage_function_value
+                , ( bp::arg("aabox"), bp::arg("center") ) );
+        
+        }
+        { //::SireVol::TriclinicBox::getMinimumImage
+        
+            typedef ::SireMaths::Vector ( ::SireVol::TriclinicBox::*getMinimumImage_function_type )( ::SireMaths::Vector const &,::SireMaths::Vector const & ) const;
+            getMinimumImage_function_type getMinimumImage_function_value( &::SireVol::TriclinicBox::getMinimumImage );
+            
+            TriclinicBox_exposer.def( 
+                "getMinimumImage"
+                , getMinimumImage_function_value
+                , ( bp::arg("point"), bp::arg("center") ) );
+        
+        }
+        { //::SireVol::TriclinicBox::getRandomPoint
+        
+            typedef ::SireMaths::Vector ( ::SireVol::TriclinicBox::*getRandomPoint_function_type )( ::SireMaths::Vector const &,::SireMaths::RanGenerator const & ) const;
+            getRandomPoint_function_type getRandomPoint_function_value( &::SireVol::TriclinicBox::getRandomPoint );
+            
+            TriclinicBox_exposer.def( 
+                "getRandomPoint"
+                , getRandomPoint_function_value
+                , ( bp::arg("center"), bp::arg("generator") ) );
+        
+        }
+        { //::SireVol::TriclinicBox::isCartesian
+        
+            typedef bool ( ::SireVol::TriclinicBox::*isCartesian_function_type )(  ) const;
+            isCartesian_function_type isCartesian_function_value( &::SireVol::TriclinicBox::isCartesian );
+            
+            TriclinicBox_exposer.def( 
+                "isCartesian"
+                , isCartesian_function_value );
+        
+        }
+        { //::SireVol::TriclinicBox::isPeriodic
+        
+            typedef bool ( ::SireVol::TriclinicBox::*isPeriodic_function_type )(  ) const;
+            isPeriodic_function_type isPeriodic_function_value( &::SireVol::TriclinicBox::isPeriodic );
+            
+            TriclinicBox_exposer.def( 
+                "isPeriodic"
+                , isPeriodic_function_value );
+        
+        }
+        { //::SireVol::TriclinicBox::maxCoords
+        
+            typedef ::SireMaths::Vector ( ::SireVol::TriclinicBox::*maxCoords_function_type )( ::SireMaths::Vector const & ) const;
+            maxCoords_function_type maxCoords_function_value( &::SireVol::TriclinicBox::maxCoords );
+            
+            TriclinicBox_exposer.def( 
+                "maxCoords"
+                , maxCoords_function_value
+                , ( bp::arg("center")=SireMaths::Vector(0.0) ) );
+        
+        }
+        { //::SireVol::TriclinicBox::minCoords
+        
+            typedef ::SireMaths::Vector ( ::SireVol::TriclinicBox::*minCoords_function_type )( ::SireMaths::Vector const & ) const;
+            minCoords_function_type minCoords_function_value( &::SireVol::TriclinicBox::minCoords );
+            
+            TriclinicBox_exposer.def( 
+                "minCoords"
+                , minCoords_function_value
+                , ( bp::arg("center")=SireMaths::Vector(0.0) ) );
+        
+        }
+        { //::SireVol::TriclinicBox::minimumDistance
+        
+            typedef double ( ::SireVol::TriclinicBox::*minimumDistance_function_type )( ::SireVol::CoordGroup const &,::SireVol::CoordGroup const & ) const;
+            minimumDistance_function_type minimumDistance_function_value( &::SireVol::TriclinicBox::minimumDistance );
+            
+            TriclinicBox_exposer.def( 
+                "minimumDistance"
+                , minimumDistance_function_value
+                , ( bp::arg("group0"), bp::arg("group1") ) );
+        
+        }
+        { //::SireVol::TriclinicBox::minimumDistance
+        
+            typedef double ( ::SireVol::TriclinicBox::*minimumDistance_function_type )( ::SireVol::AABox const &,::SireVol::AABox const & ) const;
+            minimumDistance_function_type minimumDistance_function_value( &::SireVol::TriclinicBox::minimumDistance );
+            
+            TriclinicBox_exposer.def( 
+                "minimumDistance"
+                , minimumDistance_function_value
+                , ( bp::arg("box0"), bp::arg("box1") ) );
+        
+        }
+        { //::SireVol::TriclinicBox::minimumImageDistance
+        
+            typedef double ( ::SireVol::TriclinicBox::*minimumImageDistance_function_type )(  ) const;
+            minimumImageDistance_function_type minimumImageDistance_function_value( &::SireVol::TriclinicBox::minimumImageDistance );
+            
+            TriclinicBox_exposer.def( 
+                "minimumImageDistance"
+                , minimumImageDistance_function_value );
+        
+        }
+        { //::SireVol::TriclinicBox::rhombicDodecahedronHexagon
+        
+            typedef ::SireVol::TriclinicBox ( *rhombicDodecahedronHexagon_function_type )( double );
+            rhombicDodecahedronHexagon_function_type rhombicDodecahedronHexagon_function_value( &::SireVol::TriclinicBox::rhombicDodecahedronHexagon );
+            
+            TriclinicBox_exposer.def( 
+                "rhombicDodecahedronHexagon"
+                , rhombicDodecahedronHexagon_function_value
+                , ( bp::arg("d") ) );
+        
+        }
+        { //::SireVol::TriclinicBox::rhombicDodecahedronSquare
+        
+            typedef ::SireVol::TriclinicBox ( *rhombicDodecahedronSquare_function_type )( double );
+            rhombicDodecahedronSquare_function_type rhombicDodecahedronSquare_function_value( &::SireVol::TriclinicBox::rhombicDodecahedronSquare );
+            
+            TriclinicBox_exposer.def( 
+                "rhombicDodecahedronSquare"
+                , rhombicDodecahedronSquare_function_value
+                , ( bp::arg("d") ) );
+        
+        }
+        TriclinicBox_exposer.def( bp::self != bp::self );
+        { //::SireVol::TriclinicBox::operator=
+        
+            typedef ::SireVol::TriclinicBox & ( ::SireVol::TriclinicBox::*assign_function_type )( ::SireVol::TriclinicBox const & ) ;
+            assign_function_type assign_function_value( &::SireVol::TriclinicBox::operator= );
+            
+            TriclinicBox_exposer.def( 
+                "assign"
+                , assign_function_value
+                , ( bp::arg("other") )
+                , bp::return_self< >() );
+        
+        }
+        TriclinicBox_exposer.def( bp::self == bp::self );
+        { //::SireVol::TriclinicBox::setVolume
+        
+            typedef ::SireVol::SpacePtr ( ::SireVol::TriclinicBox::*setVolume_function_type )( ::SireUnits::Dimension::Volume ) const;
+            setVolume_function_type setVolume_function_value( &::SireVol::TriclinicBox::setVolume );
+            
+            TriclinicBox_exposer.def( 
+                "setVolume"
+                , setVolume_function_value
+                , ( bp::arg("volume") ) );
+        
+        }
+        { //::SireVol::TriclinicBox::toString
+        
+            typedef ::QString ( ::SireVol::TriclinicBox::*toString_function_type )(  ) const;
+            toString_function_type toString_function_value( &::SireVol::TriclinicBox::toString );
+            
+            TriclinicBox_exposer.def( 
+                "toString"
+                , toString_function_value );
+        
+        }
+        { //::SireVol::TriclinicBox::truncatedOctahedron
+        
+            typedef ::SireVol::TriclinicBox ( *truncatedOctahedron_function_type )( double );
+            truncatedOctahedron_function_type truncatedOctahedron_function_value( &::SireVol::TriclinicBox::truncatedOctahedron );
+            
+            TriclinicBox_exposer.def( 
+                "truncatedOctahedron"
+                , truncatedOctahedron_function_value
+                , ( bp::arg("d") ) );
+        
+        }
+        { //::SireVol::TriclinicBox::typeName
+        
+            typedef char const * ( *typeName_function_type )(  );
+            typeName_function_type typeName_function_value( &::SireVol::TriclinicBox::typeName );
+            
+            TriclinicBox_exposer.def( 
+                "typeName"
+                , typeName_function_value );
+        
+        }
+        { //::SireVol::TriclinicBox::vector0
+        
+            typedef ::SireMaths::Vector const & ( ::SireVol::TriclinicBox::*vector0_function_type )(  ) const;
+            vector0_function_type vector0_function_value( &::SireVol::TriclinicBox::vector0 );
+            
+            TriclinicBox_exposer.def( 
+                "vector0"
+                , vector0_function_value
+                , bp::return_value_policy< bp::copy_const_reference >() );
+        
+        }
+        { //::SireVol::TriclinicBox::vector1
+        
+            typedef ::SireMaths::Vector const & ( ::SireVol::TriclinicBox::*vector1_function_type )(  ) const;
+            vector1_function_type vector1_function_value( &::SireVol::TriclinicBox::vector1 );
+            
+            TriclinicBox_exposer.def( 
+                "vector1"
+                , vector1_function_value
+                , bp::return_value_policy< bp::copy_const_reference >() );
+        
+        }
+        { //::SireVol::TriclinicBox::vector2
+        
+            typedef ::SireMaths::Vector const & ( ::SireVol::TriclinicBox::*vector2_function_type )(  ) const;
+            vector2_function_type vector2_function_value( &::SireVol::TriclinicBox::vector2 );
+            
+            TriclinicBox_exposer.def( 
+                "vector2"
+                , vector2_function_value
+                , bp::return_value_policy< bp::copy_const_reference >() );
+        
+        }
+        { //::SireVol::TriclinicBox::volume
+        
+            typedef ::SireUnits::Dimension::Volume ( ::SireVol::TriclinicBox::*volume_function_type )(  ) const;
+            volume_function_type volume_function_value( &::SireVol::TriclinicBox::volume );
+            
+            TriclinicBox_exposer.def( 
+                "volume"
+                , volume_function_value );
+        
+        }
+        TriclinicBox_exposer.staticmethod( "cubic" );
+        TriclinicBox_exposer.staticmethod( "rhombicDodecahedronHexagon" );
+        TriclinicBox_exposer.staticmethod( "rhombicDodecahedronSquare" );
+        TriclinicBox_exposer.staticmethod( "truncatedOctahedron" );
+        TriclinicBox_exposer.staticmethod( "typeName" );
+        TriclinicBox_exposer.def( "__copy__", &__copy__);
+        TriclinicBox_exposer.def( "__deepcopy__", &__copy__);
+        TriclinicBox_exposer.def( "clone", &__copy__);
+        TriclinicBox_exposer.def( "__rlshift__", &__rlshift__QDataStream< ::SireVol::TriclinicBox >,
+                            bp::return_internal_reference<1, bp::with_custodian_and_ward<1,2> >() );
+        TriclinicBox_exposer.def( "__rrshift__", &__rrshift__QDataStream< ::SireVol::TriclinicBox >,
+                            bp::return_internal_reference<1, bp::with_custodian_and_ward<1,2> >() );
+        TriclinicBox_exposer.def( "__str__", &__str__< ::SireVol::TriclinicBox > );
+        TriclinicBox_exposer.def( "__repr__", &__str__< ::SireVol::TriclinicBox > );
+    }
+
+}
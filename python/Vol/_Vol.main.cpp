@@ -45,6 +45,8 @@
 
 #include "Space.pypp.hpp"
 
+#include "TriclinicBox.pypp.hpp"
+
 namespace bp = boost::python;
 
 #include "SireVol_containers.h"
@@ -105,5 +107,7 @@ BOOST_PYTHON_MODULE(_Vol){
     bp::implicitly_convertible< QVector<SireMaths::Vector>, SireVol::CoordGroup >();
 
     register_RegularGrid_class();
+
+    register_TriclinicBox_class();
 }
 
@@ -84,6 +84,19 @@ int main(int argc, char **argv)
         CPUID cpuid;
         int ppn = cpuid.numCores();
 
+        // make sure that this processor can run the baseline vectorised code
+        // that Sire was compiled to use. Faster kernels (e.g. AVX-512) are
+        // chosen at run time when Sire is built with SIRE_VECTOR_DISPATCH,
+        // so this only fails if the baseline itself was raised
+        if (not cpuid.supportsCompiledVectorisation())
+            throw SireError::unsupported( QObject::tr(
+                "This copy of Sire was compiled to use %1 vector instructions "
+                "for all of its code, and these are not supported by this "
+                "processor (%2). Please use a version of Sire compiled with "
+                "SIRE_VECTOR_DISPATCH switched on (the default), which chooses "
+                "the vector instructions to use at run time.")
+                    .arg(cpuid.compiledVectorisation()).arg(cpuid.brand()), CODELOC );
+
         QList< std::wstring > warg_strings;
 
         for (int i=0; i<argc; ++i)